@@ -35,6 +35,8 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -155,6 +157,7 @@ namespace ord {
 using std::string;
 
 class dbVerilogNetwork;
+struct LazyTclCommands;
 
 // Only pointers to components so the header has no dependents.
 class OpenRoad
@@ -205,7 +208,8 @@ class OpenRoad
                const char* lib_name,
                const char* tech_name,
                bool make_tech,
-               bool make_library);
+               bool make_library,
+               const char* cache_dir = "");
 
   void readDef(const char* filename,
                odb::dbTech* tech,
@@ -247,6 +251,15 @@ class OpenRoad
   void addObserver(OpenRoadObserver* observer);
   void removeObserver(OpenRoadObserver* observer);
 
+  // Defer the Tcl registration of a tool until it is used, to keep it out
+  // of the startup time.  Each of commands is bound to a stub, and the
+  // first call of any of them runs tcl_init at the global level (e.g., the
+  // SWIG init and the Tcl scripts of the tool, which must define all the
+  // commands) and then the command itself.  The help of the commands is
+  // only available after the first use.
+  void addLazyTclCommands(const std::vector<std::string>& commands,
+                          std::function<void(Tcl_Interp*)> tcl_init);
+
  protected:
   ~OpenRoad();
 
@@ -282,6 +295,7 @@ class OpenRoad
   dft::Dft* dft_ = nullptr;
 
   std::set<OpenRoadObserver*> observers_;
+  std::vector<std::unique_ptr<LazyTclCommands>> lazy_tcl_commands_;
 
   int threads_ = 1;
 };
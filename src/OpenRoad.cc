@@ -35,6 +35,8 @@
 
 #include "ord/OpenRoad.hh"
 
+#include <tcl.h>
+
 #include <iostream>
 #include <thread>
 #ifdef ENABLE_PYTHON3
@@ -87,6 +89,7 @@
 #include "triton_route/MakeTritonRoute.h"
 #include "utl/Logger.h"
 #include "utl/MakeLogger.h"
+#include "utl/ThreadPool.h"
 
 namespace sta {
 extern const char* openroad_swig_tcl_inits[];
@@ -117,6 +120,45 @@ using sta::evalTclInit;
 
 using utl::ORD;
 
+// The stubs of the commands of a tool registered by addLazyTclCommands
+struct LazyTclCommands
+{
+  std::vector<std::string> commands;
+  std::function<void(Tcl_Interp*)> tcl_init;
+  // the command running tcl_init, called at the global level
+  std::string loader;
+};
+
+static int lazyTclLoader(ClientData client_data,
+                         Tcl_Interp* interp,
+                         int /* objc */,
+                         Tcl_Obj* const /* objv */[])
+{
+  const LazyTclCommands* lazy = static_cast<LazyTclCommands*>(client_data);
+  // tcl_init replaces the stubs with the real commands
+  for (const std::string& command : lazy->commands) {
+    Tcl_DeleteCommand(interp, command.c_str());
+  }
+  Tcl_DeleteCommand(interp, lazy->loader.c_str());
+  lazy->tcl_init(interp);
+  return TCL_OK;
+}
+
+static int lazyTclCommand(ClientData client_data,
+                          Tcl_Interp* interp,
+                          int objc,
+                          Tcl_Obj* const objv[])
+{
+  const LazyTclCommands* lazy = static_cast<LazyTclCommands*>(client_data);
+  // The scripts of the tool are evaluated as if they were sourced at
+  // startup, even if the command is called from a proc
+  if (Tcl_EvalEx(interp, lazy->loader.c_str(), -1, TCL_EVAL_GLOBAL)
+      != TCL_OK) {
+    return TCL_ERROR;
+  }
+  return Tcl_EvalObjv(interp, objc, objv, 0);
+}
+
 OpenRoad::OpenRoad()
 {
   db_ = dbDatabase::create();
@@ -225,6 +267,9 @@ void OpenRoad::init(Tcl_Interp* tcl_interp)
   evalTclInit(tcl_interp, sta::upf_tcl_inits);
   initInitFloorplan(this);
   initDbSta(this);
+  // Start STA and the shared thread pool from the same thread count.
+  sta_->setThreadCount(threads_);
+  utl::ThreadPool::setGlobalThreadCount(threads_);
   initResizer(this);
   initDbVerilogNetwork(this);
   initIoplacer(this);
@@ -266,13 +311,31 @@ void OpenRoad::init(Tcl_Interp* tcl_interp)
   }
 }
 
+void OpenRoad::addLazyTclCommands(const std::vector<std::string>& commands,
+                                  std::function<void(Tcl_Interp*)> tcl_init)
+{
+  auto lazy = std::make_unique<LazyTclCommands>();
+  lazy->commands = commands;
+  lazy->tcl_init = std::move(tcl_init);
+  lazy->loader = "::ord::load_lazy_tcl_commands_"
+                 + std::to_string(lazy_tcl_commands_.size());
+  Tcl_CreateObjCommand(
+      tcl_interp_, lazy->loader.c_str(), lazyTclLoader, lazy.get(), nullptr);
+  for (const std::string& command : commands) {
+    Tcl_CreateObjCommand(
+        tcl_interp_, command.c_str(), lazyTclCommand, lazy.get(), nullptr);
+  }
+  lazy_tcl_commands_.push_back(std::move(lazy));
+}
+
 ////////////////////////////////////////////////////////////////
 
 void OpenRoad::readLef(const char* filename,
                        const char* lib_name,
                        const char* tech_name,
                        bool make_tech,
-                       bool make_library)
+                       bool make_library,
+                       const char* cache_dir)
 {
   odb::lefin lef_reader(db_, logger_, false);
   dbLib* lib = nullptr;
@@ -291,7 +354,11 @@ void OpenRoad::readLef(const char* filename,
     if (!tech) {
       logger_->error(ORD, 51, "Technology {} not found", tech_name);
     }
-    lib = lef_reader.createLib(tech, lib_name, filename);
+    if (cache_dir[0] != '\0') {
+      lib = lef_reader.createLibCached(tech, lib_name, filename, cache_dir);
+    } else {
+      lib = lef_reader.createLib(tech, lib_name, filename);
+    }
   }
 
   // both are null on parser failure
@@ -376,6 +443,7 @@ void OpenRoad::writeDef(const char* filename, const string& version)
     if (block) {
       odb::defout def_writer(logger_);
       def_writer.setVersion(stringToDefVersion(version));
+      def_writer.setNumThreads(threads_);
       def_writer.writeBlock(block, filename);
     }
   }
@@ -466,12 +534,14 @@ void OpenRoad::readDb(const char* filename)
         ORD, 47, "You can't load a new db file as the db is already populated");
   }
 
-  std::ifstream stream;
-  stream.exceptions(std::ifstream::failbit | std::ifstream::badbit
-                    | std::ios::eofbit);
-  stream.open(filename, std::ios::binary);
+  if (!db_->readMapped(filename)) {
+    std::ifstream stream;
+    stream.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                      | std::ios::eofbit);
+    stream.open(filename, std::ios::binary);
 
-  db_->read(stream);
+    db_->read(stream);
+  }
 
   for (OpenRoadObserver* observer : observers_) {
     observer->postReadDb(db_);
@@ -586,6 +656,7 @@ void OpenRoad::setThreadCount(int threads, bool printInfo)
 
   // place limits on tools with threads
   sta_->setThreadCount(threads_);
+  utl::ThreadPool::setGlobalThreadCount(threads_);
 }
 
 void OpenRoad::setThreadCount(const char* threads, bool printInfo)
@@ -309,10 +309,12 @@ read_lef_cmd(const char *filename,
 	     const char *lib_name,
 	     const char *tech_name,
 	     bool make_tech,
-	     bool make_library)
+	     bool make_library,
+	     const char *cache_dir)
 {
   OpenRoad *ord = getOpenRoad();
-  ord->readLef(filename, lib_name, tech_name, make_tech, make_library);
+  ord->readLef(filename, lib_name, tech_name, make_tech, make_library,
+               cache_dir);
 }
 
 void
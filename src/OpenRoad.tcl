@@ -34,10 +34,12 @@
 ############################################################################
 
 # -library is the default
-sta::define_cmd_args "read_lef" {[-tech] [-library] [-tech_name name] filename}
+sta::define_cmd_args "read_lef" {[-tech] [-library] [-tech_name name]\
+                                  [-cache_dir dir] filename}
 
 proc read_lef { args } {
-  sta::parse_key_args "read_lef" args keys {-tech_name} flags {-tech -library}
+  sta::parse_key_args "read_lef" args keys {-tech_name -cache_dir} \
+    flags {-tech -library}
   sta::check_argc_eq1 "read_lef" $args
 
   set filename [file nativename [lindex $args 0]]
@@ -67,7 +69,16 @@ proc read_lef { args } {
     set tech_name $lib_name
   }
   
-  ord::read_lef_cmd $filename $lib_name $tech_name $make_tech $make_lib
+  set cache_dir ""
+  if { [info exists keys(-cache_dir)] } {
+    set cache_dir $keys(-cache_dir)
+    if { ![file isdirectory $cache_dir] } {
+      utl::error "ORD" 56 "-cache_dir $cache_dir is not a directory."
+    }
+  }
+
+  ord::read_lef_cmd $filename $lib_name $tech_name $make_tech $make_lib \
+    $cache_dir
 }
 
 sta::define_cmd_args "read_def" {[-floorplan_initialize|-incremental|-child]\
@@ -97,8 +97,15 @@ class AntennaChecker
   vector<Violation> getAntennaViolations(dbNet* net,
                                          odb::dbMTerm* diode_mterm,
                                          float ratio_margin);
+  // Checks only nets, in parallel. Nets without violations are left out
+  // of the result.
+  std::map<dbNet*, vector<Violation>> getAntennaViolations(
+      const vector<dbNet*>& nets,
+      odb::dbMTerm* diode_mterm,
+      float ratio_margin);
   void initAntennaRules();
   void setReportFileName(const char* file_name);
+  void setNumThreads(int threads);
 
  private:
   bool haveRoutedNets();
@@ -182,6 +189,8 @@ class AntennaChecker
                 // Return values.
                 int& net_violation_count,
                 int& pin_violation_count);
+  // Thread safe: reports nothing and only reads the db.
+  bool netHasViolation(dbNet* net);
   void checkGate(dbWireGraph::Node* gate,
                  vector<ARinfo>& CARtable,
                  vector<ARinfo>& VIA_CARtable,
@@ -192,6 +201,9 @@ class AntennaChecker
                  bool& violation,
                  std::unordered_set<dbWireGraph::Node*>& violated_gates);
   bool checkViolation(const PARinfo& par_info, dbTechLayer* layer);
+  vector<Violation> netAntennaViolations(dbNet* net,
+                                         odb::dbMTerm* diode_mterm,
+                                         double diode_diff_area);
   bool antennaRatioDiffDependent(dbTechLayer* layer);
 
   void findWireRootIterms(dbWireGraph::Node* node,
@@ -215,6 +227,7 @@ class AntennaChecker
   int net_violation_count_{0};
   float ratio_margin_{0};
   std::string report_file_name_;
+  int num_threads_{1};
 
   static constexpr int max_diode_count_per_gate = 10;
 };
@@ -1612,6 +1612,39 @@ void AntennaChecker::checkNet(dbNet* net,
   }
 }
 
+bool AntennaChecker::netHasViolation(dbNet* net)
+{
+  dbWire* wire = net->getWire();
+  if (!wire) {
+    return false;
+  }
+  vector<dbWireGraph::Node*> wire_roots;
+  vector<dbWireGraph::Node*> gate_nodes;
+  findWireRoots(wire, wire_roots, gate_nodes);
+
+  vector<PARinfo> PARtable = buildWireParTable(wire_roots);
+  vector<PARinfo> VIA_PARtable = buildViaParTable(wire_roots);
+  vector<ARinfo> CARtable
+      = buildWireCarTable(PARtable, VIA_PARtable, gate_nodes);
+  vector<ARinfo> VIA_CARtable
+      = buildViaCarTable(PARtable, VIA_PARtable, gate_nodes);
+
+  std::ofstream no_report;
+  bool violation = false;
+  unordered_set<dbWireGraph::Node*> violated_gates;
+  for (dbWireGraph::Node* gate : gate_nodes) {
+    checkGate(gate,
+              CARtable,
+              VIA_CARtable,
+              false,
+              false,
+              no_report,
+              violation,
+              violated_gates);
+  }
+  return violation;
+}
+
 void AntennaChecker::checkGate(
     dbWireGraph::Node* gate,
     vector<ARinfo>& CARtable,
@@ -1755,9 +1788,25 @@ int AntennaChecker::checkAntennas(dbNet* net, bool verbose)
           ANT, 14, "Skipped net {} because it is special.", net->getName());
     }
   } else {
+    vector<dbNet*> nets;
     for (dbNet* net : block_->getNets()) {
       if (!net->isSpecial()) {
-        checkNet(net,
+        nets.push_back(net);
+      }
+    }
+
+    // Few nets violate, so find them in parallel and only re-check those
+    // with reporting, in net order, to keep the output deterministic.
+    const int net_count = nets.size();
+    vector<char> violated(net_count, false);
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic, 64)
+    for (int i = 0; i < net_count; i++) {
+      violated[i] = netHasViolation(nets[i]);
+    }
+
+    for (int i = 0; i < net_count; i++) {
+      if (violated[i]) {
+        checkNet(nets[i],
                  false,
                  verbose,
                  report_file,
@@ -1963,7 +2012,41 @@ vector<Violation> AntennaChecker::getAntennaViolations(dbNet* net,
   if (diode_mterm) {
     diode_diff_area = diffArea(diode_mterm);
   }
+  return netAntennaViolations(net, diode_mterm, diode_diff_area);
+}
 
+std::map<dbNet*, vector<Violation>> AntennaChecker::getAntennaViolations(
+    const vector<dbNet*>& nets,
+    dbMTerm* diode_mterm,
+    float ratio_margin)
+{
+  ratio_margin_ = ratio_margin;
+  double diode_diff_area = 0.0;
+  if (diode_mterm) {
+    diode_diff_area = diffArea(diode_mterm);
+  }
+
+  const int net_count = nets.size();
+  vector<vector<Violation>> net_violations(net_count);
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic, 64)
+  for (int i = 0; i < net_count; i++) {
+    net_violations[i]
+        = netAntennaViolations(nets[i], diode_mterm, diode_diff_area);
+  }
+
+  std::map<dbNet*, vector<Violation>> violations;
+  for (int i = 0; i < net_count; i++) {
+    if (!net_violations[i].empty()) {
+      violations[nets[i]] = std::move(net_violations[i]);
+    }
+  }
+  return violations;
+}
+
+vector<Violation> AntennaChecker::netAntennaViolations(dbNet* net,
+                                                       dbMTerm* diode_mterm,
+                                                       double diode_diff_area)
+{
   vector<Violation> antenna_violations;
   if (net->isSpecial()) {
     return antenna_violations;
@@ -2184,4 +2267,9 @@ void AntennaChecker::setReportFileName(const char* file_name)
   report_file_name_ = file_name;
 }
 
+void AntennaChecker::setNumThreads(int threads)
+{
+  num_threads_ = threads;
+}
+
 }  // namespace ant
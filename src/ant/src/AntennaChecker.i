@@ -94,6 +94,12 @@ set_report_file_name(char* file_name)
   getAntennaChecker()->setReportFileName(file_name);
 }
 
+void
+set_num_threads(int threads)
+{
+  getAntennaChecker()->setNumThreads(threads);
+}
+
 } // namespace
 
 %} // inline
@@ -58,5 +58,6 @@ proc check_antennas { args } {
   if { [info exists flags(-report_violating_nets)] } {
     utl::warn ANT 11 "-report_violating_nets is deprecated."
   }
+  ant::set_num_threads [ord::thread_count]
   return [ant::check_antennas $net_name $verbose]
 }
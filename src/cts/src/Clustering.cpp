@@ -302,6 +302,8 @@ void Clustering::minCostFlow(const std::vector<std::pair<float, float>>& means,
 
   // collection of nodes in the flow
   std::vector<ListDigraph::Node> sink_nodes, cluster_nodes;
+  sink_nodes.reserve(sinks_.size());
+  cluster_nodes.reserve(means.size());
 
   // add nodes / edges to graph
   // nodes for sinks
@@ -369,16 +371,18 @@ void Clustering::minCostFlow(const std::vector<std::pair<float, float>>& means,
     }
   }
 
-  for (ListDigraph::ArcIt it(graph); it != INVALID; ++it) {
-    debugPrint(logger_,
-               CTS,
-               "tritoncts",
-               2,
-               "{}-{}",
-               graph.id(graph.source(it)),
-               graph.id(graph.target(it)));
-    debugPrint(logger_, CTS, "tritoncts", 2, " cost = ", edge_cost[it]);
-    debugPrint(logger_, CTS, "tritoncts", 2, " cap = ", edge_capacity[it]);
+  if (logger_->debugCheck(CTS, "tritoncts", 2)) {
+    for (ListDigraph::ArcIt it(graph); it != INVALID; ++it) {
+      debugPrint(logger_,
+                 CTS,
+                 "tritoncts",
+                 2,
+                 "{}-{}",
+                 graph.id(graph.source(it)),
+                 graph.id(graph.target(it)));
+      debugPrint(logger_, CTS, "tritoncts", 2, " cost = ", edge_cost[it]);
+      debugPrint(logger_, CTS, "tritoncts", 2, " cap = ", edge_capacity[it]);
+    }
   }
 
   NetworkSimplex<ListDigraph, int, int> flow(graph);
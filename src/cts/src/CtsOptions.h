@@ -112,6 +112,10 @@ class CtsOptions
   int getCapSteps() const { return capSteps_; }
   void setSlewSteps(int steps) { slewSteps_ = steps; }
   int getSlewSteps() const { return slewSteps_; }
+  void setCharCacheDir(const std::string& dir) { charCacheDir_ = dir; }
+  std::string getCharCacheDir() const { return charCacheDir_; }
+  void setNumThreads(int threads) { numThreads_ = threads; }
+  int getNumThreads() const { return numThreads_; }
   void setClockTreeMaxDepth(unsigned depth) { clockTreeMaxDepth_ = depth; }
   unsigned getClockTreeMaxDepth() const { return clockTreeMaxDepth_; }
   void setEnableFakeLutEntries(bool enable) { enableFakeLutEntries_ = enable; }
@@ -225,6 +229,7 @@ class CtsOptions
   std::string sinkBuffer_ = "";
   std::string treeBuffer_ = "";
   std::string metricFile_ = "";
+  std::string charCacheDir_ = "";
   int dbUnits_ = -1;
   unsigned wireSegmentUnit_ = 0;
   bool plotSolution_ = false;
@@ -244,6 +249,7 @@ class CtsOptions
   double sinkBufferInputCap_ = 0;
   int capSteps_ = 34;
   int slewSteps_ = 12;
+  int numThreads_ = 1;
   unsigned charWirelengthIterations_ = 4;
   unsigned clockTreeMaxDepth_ = 100;
   bool enableFakeLutEntries_ = true;
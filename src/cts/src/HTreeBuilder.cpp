@@ -591,7 +591,7 @@ void HTreeBuilder::legalize()
   legalizeDummy();
 }
 
-void HTreeBuilder::run()
+void HTreeBuilder::prepare()
 {
   logger_->info(
       CTS, 27, "Generating H-Tree topology for net {}.", clock_.getName());
@@ -618,7 +618,30 @@ void HTreeBuilder::run()
   minLengthSinkRegion_ = techChar_->getMinSegmentLength() * 2;
 
   initSinkRegion();
+}
+
+bool HTreeBuilder::needsFakeLutEntries() const
+{
+  if (!options_->isFakeLutEntriesEnabled()) {
+    return false;
+  }
+  // Same stop criteria as run(), which switches to the fake entries at the
+  // first sub-region that is too small.
+  for (int level = 1; level <= clockTreeMaxDepth_; ++level) {
+    double regionWidth, regionHeight;
+    computeSubRegionSize(level, regionWidth, regionHeight);
+    if (isSubRegionTooSmall(regionWidth, regionHeight)) {
+      return true;
+    }
+    if (isNumberOfSinksTooSmall(computeNumberOfSinksPerSubRegion(level))) {
+      return false;
+    }
+  }
+  return false;
+}
 
+void HTreeBuilder::run()
+{
   for (int level = 1; level <= clockTreeMaxDepth_; ++level) {
     const unsigned numSinksPerSubRegion
         = computeNumberOfSinksPerSubRegion(level);
@@ -627,9 +650,14 @@ void HTreeBuilder::run()
 
     if (isSubRegionTooSmall(regionWidth, regionHeight)) {
       if (options_->isFakeLutEntriesEnabled()) {
+        // The fake entries are created by TritonCTS before the tree is
+        // built (see needsFakeLutEntries()), so the LUT is not modified by
+        // the concurrent builders.
         const unsigned minIndex = 1;
-        techChar_->createFakeEntries(minLengthSinkRegion_, minIndex);
-        minLengthSinkRegion_ = 1;
+        if (minLengthSinkRegion_ != minIndex) {
+          logger_->warn(CTS, 45, "Creating fake entries in the LUT.");
+        }
+        minLengthSinkRegion_ = minIndex;
       } else {
         logger_->info(
             CTS,
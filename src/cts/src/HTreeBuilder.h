@@ -179,6 +179,8 @@ class HTreeBuilder : public TreeBuilder
   {
   }
 
+  void prepare() override;
+  bool needsFakeLutEntries() const override;
   void run() override;
   bool moveAlongBlockageBoundary(const Point<double>& parentPoint,
                                  Point<double>& branchPoint,
@@ -45,6 +45,7 @@
 
 #include "stt/SteinerTreeBuilder.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace cts {
 
@@ -178,18 +179,11 @@ void SinkClustering::run(const unsigned groupSize,
 
 void SinkClustering::findBestMatching(const unsigned groupSize)
 {
-  // Counts how many clusters are in each solution.
-  vector<unsigned> clusters(groupSize, 0);
   // Keeps track of the total cost of each solution.
   vector<double> costs(groupSize, 0);
-  vector<double> previousCosts(groupSize, 0);
-  // Has the points for each cluster of each solution.
-  vector<vector<vector<Point<double>>>> solutionPoints;
-  // Has the points index for each cluster of each solution.
-  // example: solutionsPointsIdx[solutionId][clusterIdx][pointIdx]
-  vector<vector<vector<unsigned>>> solutionPointsIdx;
   // Has the sink indexes for each cluster of each solution.
-  vector<vector<vector<unsigned>>> solutions;
+  // example: solutions[solutionId][clusterIdx][pointIdx]
+  vector<vector<vector<unsigned>>> solutions(groupSize);
 
   if (useMaxCapLimit_) {
     debugPrint(logger_,
@@ -199,153 +193,110 @@ void SinkClustering::findBestMatching(const unsigned groupSize)
                "Clustering with max cap limit of {:.3e}",
                options_->getSinkBufferInputCap() * max_cap__factor_);
   }
-  // Iterates over the theta vector.
-  for (unsigned i = 0; i < thetaIndexVector_.size(); ++i) {
-    // The - groupSize is because each solution will start on a different index.
-    // There is groupSize solutions.
-    for (unsigned j = 0; j < groupSize; ++j) {
-      if ((i + j) < thetaIndexVector_.size()) {
-        // Add vectors in case they are no allocated yet.
-        if (solutions.size() < (j + 1)) {
-          solutions.emplace_back();
-          solutionPoints.emplace_back();
-          solutionPointsIdx.emplace_back();
-        }
-        if (solutions[j].size() < (clusters[j] + 1)) {
-          solutions[j].emplace_back();
-          solutionPoints[j].emplace_back();
-          solutionPointsIdx[j].emplace_back();
-        }
-        // Get the current point
-        const unsigned idx = thetaIndexVector_[i + j].second;
+  // The limits only grow while a cluster is scanned, so the scan stops at
+  // the first violation unless the exact costs are being reported.
+  const bool exactCosts = logger_->debugCheck(CTS, "Stree", 4);
+  // There is groupSize solutions. Solution j walks the theta vector starting
+  // at index j and wraps around to the first j points. The solutions only
+  // share read-only data, so they are built concurrently.
+  const unsigned numPoints = thetaIndexVector_.size();
+  const int numSolutions = groupSize;
+  const int numThreads = options_->getNumThreads();
+  const bool parallel = numThreads > 1 && !exactCosts;
+  utl::ThreadException exception;
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic) if (parallel)
+  for (int j = 0; j < numSolutions; ++j) {
+    try {
+      vector<vector<unsigned>>& solution = solutions[j];
+      // Points of the cluster being grown and their bounding box. The box
+      // bounds the distance to the farthest member, so a point that cannot
+      // raise the cluster diameter skips the scan.
+      vector<Point<double>> clusterPoints;
+      double xMin = 0, xMax = 0, yMin = 0, yMax = 0;
+      // Highest distance found on the current cluster.
+      double previousCost = 0;
+      solution.emplace_back();
+      for (unsigned i = 0; i < numPoints; ++i) {
+        const unsigned idx = thetaIndexVector_[(i + j) % numPoints].second;
         const Point<double>& p = points_[idx];
+        const vector<unsigned>& cluster = solution.back();
         double distanceCost = 0;
         double capCost = pointsCap_[idx];
-        unsigned pointIdx = 0;
-        // Check the distance from the current point to others in the cluster,
-        // if there are any.
-        for (Point<double> comparisonPoint : solutionPoints[j][clusters[j]]) {
-          const double cost = p.computeDist(comparisonPoint);
-          if (useMaxCapLimit_) {
-            capCost
-                += cost * capPerUnit_
-                   + pointsCap_[solutionPointsIdx[j][clusters[j]][pointIdx]];
-          }
-          pointIdx++;
-          if (cost > distanceCost) {
-            distanceCost = cost;
+        bool exceeded = false;
+        const bool withinDiameter
+            = !useMaxCapLimit_ && !clusterPoints.empty()
+              && clusterPoints.size() < groupSize
+              && std::max(p.getX() - xMin, xMax - p.getX())
+                         + std::max(p.getY() - yMin, yMax - p.getY())
+                     <= previousCost;
+        if (!withinDiameter) {
+          // Check the distance from the current point to others in the
+          // cluster, if there are any.
+          for (unsigned k = 0; k < clusterPoints.size(); ++k) {
+            const double cost = p.computeDist(clusterPoints[k]);
+            if (useMaxCapLimit_) {
+              capCost += cost * capPerUnit_ + pointsCap_[cluster[k]];
+            }
+            if (cost > distanceCost) {
+              distanceCost = cost;
+            }
+            if (!exactCosts
+                && isLimitExceeded(
+                    clusterPoints.size(), distanceCost, capCost, groupSize)) {
+              break;
+            }
           }
+          // If the cluster size is higher than groupSize,
+          // or the distance is higher than maxInternalDiameter_
+          //-> start another cluster and save the cost of the current one.
+          exceeded = isLimitExceeded(
+              clusterPoints.size(), distanceCost, capCost, groupSize);
         }
-        // If the cluster size is higher than groupSize,
-        // or the distance is higher than maxInternalDiameter_
-        //-> start another cluster and save the cost of the current one.
-        if (isLimitExceeded(solutionPoints[j][clusters[j]].size(),
-                            distanceCost,
-                            capCost,
-                            groupSize)) {
+        if (exceeded) {
           debugPrint(logger_,
                      CTS,
                      "Stree",
                      4,
                      "Created cluster of size {}, dia {:.3}, cap {:.3e}",
-                     solutionPoints[j][clusters[j]].size(),
+                     clusterPoints.size(),
                      distanceCost,
                      capCost);
           // The cost is computed as the highest cost found on the current
           // cluster
-          if (previousCosts[j] == 0) {
-            previousCosts[j] = maxInternalDiameter_;
+          if (previousCost == 0) {
+            previousCost = maxInternalDiameter_;
           }
-          costs[j] += previousCosts[j];
+          costs[j] += previousCost;
           // A new cluster is defined
-          clusters[j] = clusters[j] + 1;
-          // The cost was already saved, so the same structure can be used for
-          // the next cluster.
-          previousCosts[j] = 0;
+          solution.emplace_back();
+          clusterPoints.clear();
+          previousCost = 0;
         } else {
           // Node will be a part of the current cluster, thus, save the highest
           // cost.
-          if (distanceCost > previousCosts[j]) {
-            previousCosts[j] = distanceCost;
+          if (distanceCost > previousCost) {
+            previousCost = distanceCost;
           }
         }
-        // Add vectors in case they are no allocated yet. (Depends if a new
-        // cluster was defined above)
-        if (solutions[j].size() < (clusters[j] + 1)) {
-          solutions[j].push_back({});
-          solutionPoints[j].push_back({});
-          solutionPointsIdx[j].push_back({});
-        }
         // Save the current Point in it's respective cluster. (Depends if a new
         // cluster was defined above)
-        solutionPoints[j][clusters[j]].push_back(p);
-        solutionPointsIdx[j][clusters[j]].push_back(idx);
-        solutions[j][clusters[j]].push_back(idx);
-      }
-    }
-  }
-
-  // Same computation as above, however, only for the first groupSize Points.
-  for (unsigned i = 0; i < groupSize; ++i) {
-    // This is because every solution after the first one skips a Point (starts
-    // one late).
-    for (unsigned j = (i + 1); j < groupSize; ++j) {
-      if (solutions[j].size() < (clusters[j] + 1)) {
-        solutions[j].push_back({});
-        solutionPoints[j].push_back({});
-        solutionPointsIdx[j].push_back({});
-      }
-      // Thus here we will assign the Points missing from those solutions.
-      const unsigned idx = thetaIndexVector_[i].second;
-      const Point<double>& p = points_[idx];
-      unsigned pointIdx = 0;
-      double distanceCost = 0;
-      double capCost = pointsCap_[idx];
-      for (Point<double> comparisonPoint : solutionPoints[j][clusters[j]]) {
-        const double cost = p.computeDist(comparisonPoint);
-        if (useMaxCapLimit_) {
-          capCost += cost * capPerUnit_
-                     + pointsCap_[solutionPointsIdx[j][clusters[j]][pointIdx]];
-        }
-        pointIdx++;
-        if (cost > distanceCost) {
-          distanceCost = cost;
-        }
-      }
-
-      if (isLimitExceeded(solutionPoints[j][clusters[j]].size(),
-                          distanceCost,
-                          capCost,
-                          groupSize)) {
-        debugPrint(logger_,
-                   CTS,
-                   "Stree",
-                   4,
-                   "Created cluster of size {}, dia {:.3}, cap {:.3e}",
-                   solutionPoints[j][clusters[j]].size(),
-                   distanceCost,
-                   capCost);
-        if (previousCosts[j] == 0) {
-          previousCosts[j] = maxInternalDiameter_;
-        }
-        costs[j] += previousCosts[j];
-        clusters[j] = clusters[j] + 1;
-        previousCosts[j] = 0;
-      } else {
-        if (distanceCost > previousCosts[j]) {
-          previousCosts[j] = distanceCost;
+        if (clusterPoints.empty()) {
+          xMin = xMax = p.getX();
+          yMin = yMax = p.getY();
+        } else {
+          xMin = std::min(xMin, p.getX());
+          xMax = std::max(xMax, p.getX());
+          yMin = std::min(yMin, p.getY());
+          yMax = std::max(yMax, p.getY());
         }
+        clusterPoints.push_back(p);
+        solution.back().push_back(idx);
       }
-      if (solutions[j].size() < (clusters[j] + 1)) {
-        solutions[j].push_back({});
-        solutionPoints[j].push_back({});
-        solutionPointsIdx[j].push_back({});
-      }
-      solutionPoints[j][clusters[j]].push_back(p);
-      solutionPointsIdx[j][clusters[j]].push_back(idx);
-      solutions[j][clusters[j]].push_back(idx);
+    } catch (...) {
+      exception.capture();
     }
   }
+  exception.rethrow();
 
   unsigned bestSolution = 0;
   double bestSolutionCost = costs[0];
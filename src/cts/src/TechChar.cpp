@@ -35,9 +35,13 @@
 
 #include "TechChar.h"
 
+#include <unistd.h>
+
 #include <algorithm>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <limits>
 #include <ostream>
 #include <sstream>
 
@@ -379,7 +383,6 @@ void TechChar::createFakeEntries(unsigned length, unsigned fakeLength)
     return;
   }
 
-  logger_->warn(CTS, 45, "Creating fake entries in the LUT.");
   for (unsigned load = 1; load <= getMaxCapacitance(); ++load) {
     for (unsigned outSlew = 1; outSlew <= getMaxSlew(); ++outSlew) {
       forEachWireSegment(
@@ -1059,10 +1062,8 @@ unsigned TechChar::normalizeCharResults(float value,
   return normVal;
 }
 
-void TechChar::create()
+void TechChar::characterizePatterns()
 {
-  // Setup of the attributes required to run the characterization.
-  initCharacterization();
   long unsigned int topologiesCreated = 0;
   for (unsigned setupWirelength : wirelengthsToTest_) {
     // Creates the topologies for the current wirelength.
@@ -1177,9 +1178,149 @@ void TechChar::create()
     openStaChar_.reset(nullptr);
   }
   logger_->info(CTS, 39, "Number of created patterns = {}.", topologiesCreated);
-  // Post-processing of the results.
-  const std::vector<ResultData> convertedSolutions
-      = characterizationPostProcess();
+}
+
+std::string TechChar::characterizationKey() const
+{
+  std::ostringstream key;
+  key << std::setprecision(std::numeric_limits<double>::max_digits10);
+  key << "v1";
+  // The Liberty models are identified by their file, so any edit to the
+  // library invalidates the cached results.
+  for (const std::string& name : masterNames_) {
+    key << " " << name;
+    const sta::LibertyCell* libertyCell
+        = db_network_->findLibertyCell(name.c_str());
+    const char* libFile = libertyCell->libertyLibrary()->filename();
+    key << " " << (libFile ? libFile : "");
+    std::error_code ec;
+    if (libFile && std::filesystem::exists(libFile, ec)) {
+      key << " " << std::filesystem::file_size(libFile, ec);
+      key << " "
+          << std::filesystem::last_write_time(libFile, ec)
+                 .time_since_epoch()
+                 .count();
+    }
+  }
+  key << " " << charBuf_->getName();
+  key << " " << resPerDBU_ << " " << capPerDBU_;
+  key << " " << lengthUnit_;
+  for (const std::vector<float>* values :
+       {&wirelengthsToTest_, &loadsToTest_, &slewsToTest_}) {
+    key << " " << values->size();
+    for (float value : *values) {
+      key << " " << value;
+    }
+  }
+  key << " " << charSlewStepSize_ << " " << charCapStepSize_;
+  return key.str();
+}
+
+std::string TechChar::cachePath(const std::string& key) const
+{
+  std::ostringstream name;
+  name << "cts_char_" << std::hex << std::hash<std::string>{}(key) << ".txt";
+  return (std::filesystem::path(options_->getCharCacheDir()) / name.str())
+      .string();
+}
+
+bool TechChar::readCache(const std::string& key,
+                         std::vector<ResultData>& results)
+{
+  if (options_->getCharCacheDir().empty()) {
+    return false;
+  }
+  const std::string path = cachePath(key);
+  std::ifstream in(path);
+  if (!in) {
+    return false;
+  }
+  // The full key is stored in the file so that a hash collision is a miss.
+  std::string fileKey;
+  std::getline(in, fileKey);
+  if (fileKey != key) {
+    return false;
+  }
+
+  size_t count = 0;
+  in >> minSlew_ >> maxSlew_ >> minCapacitance_ >> maxCapacitance_
+      >> minSegmentLength_ >> maxSegmentLength_ >> count;
+  std::vector<ResultData> cached(count);
+  for (ResultData& result : cached) {
+    size_t topologySize = 0;
+    in >> result.load >> result.inSlew >> result.wirelength >> result.pinSlew
+        >> result.pinArrival >> result.totalcap >> result.totalPower
+        >> result.isPureWire >> topologySize;
+    result.topology.resize(topologySize);
+    for (std::string& node : result.topology) {
+      in >> node;
+    }
+  }
+  if (!in) {
+    logger_->warn(
+        CTS, 117, "Ignoring unreadable characterization cache {}.", path);
+    return false;
+  }
+
+  results = std::move(cached);
+  logger_->info(CTS, 118, "Read characterization from cache {}.", path);
+  return true;
+}
+
+void TechChar::writeCache(const std::string& key,
+                          const std::vector<ResultData>& results) const
+{
+  if (options_->getCharCacheDir().empty()) {
+    return;
+  }
+  const std::string path = cachePath(key);
+  // Written under a temporary name and renamed so concurrent runs sharing
+  // the cache never read a partial file.
+  const std::string tmpPath = path + ".tmp" + std::to_string(getpid());
+  std::error_code ec;
+  std::filesystem::create_directories(options_->getCharCacheDir(), ec);
+  {
+    std::ofstream out(tmpPath);
+    out << std::setprecision(std::numeric_limits<float>::max_digits10);
+    out << key << "\n";
+    out << minSlew_ << " " << maxSlew_ << " " << minCapacitance_ << " "
+        << maxCapacitance_ << " " << minSegmentLength_ << " "
+        << maxSegmentLength_ << " " << results.size() << "\n";
+    for (const ResultData& result : results) {
+      out << result.load << " " << result.inSlew << " " << result.wirelength
+          << " " << result.pinSlew << " " << result.pinArrival << " "
+          << result.totalcap << " " << result.totalPower << " "
+          << result.isPureWire << " " << result.topology.size();
+      for (const std::string& node : result.topology) {
+        out << " " << node;
+      }
+      out << "\n";
+    }
+    if (!out) {
+      ec = std::make_error_code(std::errc::io_error);
+    }
+  }
+  if (!ec) {
+    std::filesystem::rename(tmpPath, path, ec);
+  }
+  if (ec) {
+    std::filesystem::remove(tmpPath, ec);
+    logger_->warn(CTS, 119, "Unable to write characterization cache {}.", path);
+  }
+}
+
+void TechChar::create()
+{
+  // Setup of the attributes required to run the characterization.
+  initCharacterization();
+  const std::string cacheKey = characterizationKey();
+  std::vector<ResultData> convertedSolutions;
+  if (!readCache(cacheKey, convertedSolutions)) {
+    characterizePatterns();
+    // Post-processing of the results.
+    convertedSolutions = characterizationPostProcess();
+    writeCache(cacheKey, convertedSolutions);
+  }
   compileLut(convertedSolutions);
   if (logger_->debugCheck(CTS, "characterization", 3)) {
     printCharacterization();
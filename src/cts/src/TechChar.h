@@ -168,6 +168,9 @@ class TechChar
   unsigned getActualMinInputCap() const { return actualMinInputCap_; }
   unsigned getLengthUnit() const { return lengthUnit_; }
 
+  // Copies the segments of the given length as segments of fakeLength.
+  // The LUT is read concurrently by the tree builders, so this must be
+  // called before the trees are built.
   void createFakeEntries(unsigned length, unsigned fakeLength);
 
   double getCapPerDBU() const { return capPerDBU_; }
@@ -262,6 +265,15 @@ class TechChar
                                     unsigned setupWirelength);
   void updateBufferTopologies(SolutionData& solution);
   std::vector<ResultData> characterizationPostProcess();
+  void characterizePatterns();
+  // The cache holds the post-processed results, which only depend on the
+  // buffer Liberty models, the clock wire RC and the characterization
+  // parameters collected in the key.
+  std::string characterizationKey() const;
+  std::string cachePath(const std::string& key) const;
+  bool readCache(const std::string& key, std::vector<ResultData>& results);
+  void writeCache(const std::string& key,
+                  const std::vector<ResultData>& results) const;
   unsigned normalizeCharResults(float value,
                                 float iter,
                                 unsigned* min,
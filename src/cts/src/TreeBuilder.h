@@ -71,6 +71,12 @@ class TreeBuilder
     }
   }
 
+  // Computes the sink region of the tree. The builders of different clocks
+  // may be prepared concurrently.
+  virtual void prepare() {}
+  // True when run() needs the fake LUT entries of the short segments. Only
+  // valid after prepare().
+  virtual bool needsFakeLutEntries() const { return false; }
   virtual void run() = 0;
   void initBlockages();
   void setTechChar(TechChar& techChar) { techChar_ = &techChar; }
@@ -40,6 +40,7 @@
 #include <fstream>
 #include <iterator>
 #include <unordered_set>
+#include <vector>
 
 #include "Clock.h"
 #include "CtsOptions.h"
@@ -55,6 +56,8 @@
 #include "sta/Liberty.hh"
 #include "sta/Sdc.hh"
 #include "utl/Logger.h"
+#include "utl/exception.h"
+#include "utl/trace.h"
 
 namespace cts {
 
@@ -86,6 +89,7 @@ TritonCTS::~TritonCTS()
 
 void TritonCTS::runTritonCts()
 {
+  utl::TraceSpan span("cts", "clock_tree_synthesis");
   setupCharacterization();
   findClockRoots();
   populateTritonCTS();
@@ -149,12 +153,68 @@ void TritonCTS::findClockRoots()
 
 void TritonCTS::buildClockTrees()
 {
+  // Trees of different clock nets are independent and only touch the
+  // database in writeDataToDb, so they can be built concurrently. The
+  // observer and the plot files are not thread safe.
+  const int numThreads = options_->getNumThreads();
+  const bool parallel = numThreads > 1 && builders_->size() > 1
+                        && !options_->getObserver()
+                        && !options_->getPlotSolution()
+                        && !logger_->debugCheck(CTS, "HTree", 2);
+  // The fake LUT entries used by the HTree builders for the small sink
+  // regions are created once, before the first tree that needs them is
+  // built, so the LUT is read-only while the trees are built.
+  bool fakeEntriesCreated = false;
+  auto createFakeEntries = [&](const TreeBuilder* builder) {
+    if (!fakeEntriesCreated && builder->needsFakeLutEntries()) {
+      techChar_->createFakeEntries(techChar_->getMinSegmentLength() * 2, 1);
+      fakeEntriesCreated = true;
+    }
+  };
   for (TreeBuilder* builder : *builders_) {
     builder->setTechChar(*techChar_);
     builder->setDb(db_);
     builder->setLogger(logger_);
     builder->initBlockages();
-    builder->run();
+    if (!parallel) {
+      builder->prepare();
+      createFakeEntries(builder);
+      builder->run();
+    }
+  }
+
+  if (parallel) {
+    // The messages of each builder are buffered and printed in the order of
+    // the builders, as in the serial build.
+    const int numBuilders = builders_->size();
+    std::vector<utl::Logger::MessageBuffer> messages(numBuilders);
+    auto forEachBuilder = [&](void (TreeBuilder::*step)()) {
+      utl::ThreadException exception;
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic)
+      for (int i = 0; i < numBuilders; ++i) {
+        utl::Logger::setThreadBuffer(&messages[i]);
+        try {
+          ((*builders_)[i]->*step)();
+        } catch (...) {
+          exception.capture();
+        }
+        utl::Logger::setThreadBuffer(nullptr);
+      }
+      if (exception.hasException()) {
+        for (utl::Logger::MessageBuffer& builderMessages : messages) {
+          logger_->printBuffer(builderMessages);
+        }
+        exception.rethrow();
+      }
+    };
+    forEachBuilder(&TreeBuilder::prepare);
+    for (const TreeBuilder* builder : *builders_) {
+      createFakeEntries(builder);
+    }
+    forEachBuilder(&TreeBuilder::run);
+    for (utl::Logger::MessageBuffer& builderMessages : messages) {
+      logger_->printBuffer(builderMessages);
+    }
   }
 
   if (options_->getBalanceLevels()) {
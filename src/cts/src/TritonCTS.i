@@ -114,6 +114,12 @@ set_cap_steps(int steps)
   getTritonCts()->getParms()->setCapSteps(steps);
 }
 
+void
+set_char_cache_dir(const char* dir)
+{
+  getTritonCts()->getParms()->setCharCacheDir(dir);
+}
+
 void
 set_metric_output(const char* file)
 {
@@ -224,6 +230,12 @@ set_obstruction_aware(bool obs)
   getTritonCts()->getParms()->setObstructionAware(obs);
 }
 
+void
+set_num_threads(int threads)
+{
+  getTritonCts()->getParms()->setNumThreads(threads);
+}
+
 void
 run_triton_cts()
 {
@@ -37,11 +37,13 @@ sta::define_cmd_args "configure_cts_characterization" {[-max_cap cap] \
                                                        [-max_slew slew] \
                                                        [-slew_steps slew_steps] \
                                                        [-cap_steps cap_steps] \
+                                                       [-cache_dir dir] \
                                                       }
 
 proc configure_cts_characterization { args } {
   sta::parse_key_args "configure_cts_characterization" args \
-    keys {-max_cap -max_slew -slew_steps -cap_steps} flags {}
+    keys {-max_cap -max_slew -slew_steps -cap_steps -cache_dir} \
+    flags {}
 
   sta::check_argc_eq0 "configure_cts_characterization" $args
 
@@ -66,6 +68,10 @@ proc configure_cts_characterization { args } {
     sta::check_cardinal "-cap_steps" $steps
     cts::set_cap_steps $cap
   }
+
+  if { [info exists keys(-cache_dir)] } {
+    cts::set_char_cache_dir $keys(-cache_dir)
+  }
 }
 
 sta::define_cmd_args "clock_tree_synthesis" {[-wire_unit unit]
@@ -201,6 +207,7 @@ proc clock_tree_synthesis { args } {
   if { [ord::get_db_block] == "NULL" } {
     utl::error CTS 103 "No design block found."
   }
+  cts::set_num_threads [ord::thread_count]
   cts::run_triton_cts
 }
 
@@ -177,6 +177,10 @@ class dbNetwork : public ConcreteNetwork
   InstanceChildIterator* childIterator(const Instance* instance) const override;
   InstancePinIterator* pinIterator(const Instance* instance) const override;
   InstanceNetIterator* netIterator(const Instance* instance) const override;
+  // Calls visitor(Pin*) on the pins pinIterator(instance) returns without
+  // allocating an iterator.
+  template <typename Visitor>
+  void visitPins(const Instance* instance, Visitor visitor) const;
 
   ////////////////////////////////////////////////////////////////
   // Pin functions
@@ -211,6 +215,10 @@ class dbNetwork : public ConcreteNetwork
   bool isGround(const Net* net) const override;
   NetPinIterator* pinIterator(const Net* net) const override;
   NetTermIterator* termIterator(const Net* net) const override;
+  // Calls visitor(Pin*) on the pins pinIterator(net) returns without
+  // allocating an iterator.
+  template <typename Visitor>
+  void visitPins(const Net* net, Visitor visitor) const;
   const Net* highestConnectedNet(Net* net) const override;
   bool isSpecial(Net* net);
 
@@ -272,4 +280,35 @@ class dbNetwork : public ConcreteNetwork
   std::set<dbNetworkObserver*> observers_;
 };
 
+template <typename Visitor>
+void dbNetwork::visitPins(const Instance* instance, Visitor visitor) const
+{
+  if (instance == top_instance_) {
+    for (dbBTerm* bterm : block_->getBTerms()) {
+      visitor(dbToSta(bterm));
+    }
+    return;
+  }
+  dbInst* db_inst;
+  dbModInst* mod_inst;  // has no inst pins in odb
+  staToDb(instance, db_inst, mod_inst);
+  if (db_inst) {
+    for (dbITerm* iterm : db_inst->getITerms()) {
+      if (!iterm->getSigType().isSupply()) {
+        visitor(dbToSta(iterm));
+      }
+    }
+  }
+}
+
+template <typename Visitor>
+void dbNetwork::visitPins(const Net* net, Visitor visitor) const
+{
+  for (dbITerm* iterm : staToDb(net)->getITerms()) {
+    if (!iterm->getSigType().isSupply()) {
+      visitor(dbToSta(iterm));
+    }
+  }
+}
+
 }  // namespace sta
@@ -522,6 +522,17 @@ Pin* dbNetwork::findPin(const Instance* instance, const char* port_name) const
 
 Pin* dbNetwork::findPin(const Instance* instance, const Port* port) const
 {
+  if (instance != top_instance_) {
+    // Index the instance terms by the master term instead of looking the
+    // port up by name.
+    dbInst* db_inst;
+    dbModInst* mod_inst;
+    staToDb(instance, db_inst, mod_inst);
+    dbMTerm* mterm = staToDb(port);
+    if (db_inst && mterm && mterm->getMaster() == db_inst->getMaster()) {
+      return dbToSta(db_inst->getITerm(mterm));
+    }
+  }
   const char* port_name = this->name(port);
   return findPin(instance, port_name);
 }
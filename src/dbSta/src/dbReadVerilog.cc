@@ -37,6 +37,7 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 
 #include "db_sta/dbNetwork.hh"
 #include "odb/db.h"
@@ -145,8 +146,11 @@ class Verilog2db
   dbIoType staToDb(PortDirection* dir);
   void recordBusPortsOrder();
   void makeDbNets(const Instance* inst);
+  void reserveDbNetlist();
+  int countNets(const Instance* inst) const;
   bool hasTerminals(Net* net) const;
   dbMaster* getMaster(Cell* cell);
+  dbMTerm* getMTerm(const Pin* pin, dbMaster* master);
   dbModule* makeUniqueDbModule(const char* name);
 
   Network* network_;
@@ -154,6 +158,10 @@ class Verilog2db
   dbBlock* block_ = nullptr;
   Logger* logger_;
   std::map<Cell*, dbMaster*> master_map_;
+  // Leaf instances and their ports resolved once so that connecting
+  // pins does not look them up by name.
+  std::unordered_map<const Instance*, dbInst*> inst_map_;
+  std::unordered_map<const Port*, dbMTerm*> mterm_map_;
   std::map<std::string, int> uniquify_id_;  // key: module name
 };
 
@@ -217,6 +225,7 @@ void Verilog2db::makeBlock()
 void Verilog2db::makeDbNetlist()
 {
   recordBusPortsOrder();
+  reserveDbNetlist();
   makeDbModule(network_->topInstance(), /* parent */ nullptr);
   makeDbNets(network_->topInstance());
 }
@@ -308,6 +317,7 @@ void Verilog2db::makeDbModule(Instance* inst, dbModule* parent)
         continue;
       }
       module->addInst(db_inst);
+      inst_map_[child] = db_inst;
     }
   }
   delete child_iter;
@@ -377,13 +387,10 @@ void Verilog2db::makeDbNets(const Instance* inst)
             bterm->setIoType(io_type);
           }
         } else if (network_->isLeaf(pin)) {
-          const char* port_name = network_->portName(pin);
-          Instance* inst = network_->instance(pin);
-          const char* inst_name = network_->pathName(inst);
-          dbInst* db_inst = block_->findInst(inst_name);
-          if (db_inst) {
-            dbMaster* master = db_inst->getMaster();
-            dbMTerm* mterm = master->findMTerm(block_, port_name);
+          auto inst_iter = inst_map_.find(network_->instance(pin));
+          if (inst_iter != inst_map_.end()) {
+            dbInst* db_inst = inst_iter->second;
+            dbMTerm* mterm = getMTerm(pin, db_inst->getMaster());
             if (mterm) {
               db_inst->getITerm(mterm)->connect(db_net);
             }
@@ -402,6 +409,44 @@ void Verilog2db::makeDbNets(const Instance* inst)
   delete child_iter;
 }
 
+// Sizes the odb name tables up front so that bulk creation of a large
+// netlist does not rehash them repeatedly.
+void Verilog2db::reserveDbNetlist()
+{
+  int leaf_count = 0;
+  LeafInstanceIterator* leaf_iter = network_->leafInstanceIterator();
+  while (leaf_iter->hasNext()) {
+    leaf_iter->next();
+    leaf_count++;
+  }
+  delete leaf_iter;
+  block_->reserveInsts(leaf_count);
+  block_->reserveNets(countNets(network_->topInstance()));
+  inst_map_.reserve(leaf_count);
+}
+
+// Upper bound on the nets makeDbNets creates under inst.
+int Verilog2db::countNets(const Instance* inst) const
+{
+  int count = 0;
+  NetIterator* net_iter = network_->netIterator(inst);
+  while (net_iter->hasNext()) {
+    net_iter->next();
+    count++;
+  }
+  delete net_iter;
+
+  InstanceChildIterator* child_iter = network_->childIterator(inst);
+  while (child_iter->hasNext()) {
+    const Instance* child = child_iter->next();
+    if (network_->isHierarchical(child)) {
+      count += countNets(child);
+    }
+  }
+  delete child_iter;
+  return count;
+}
+
 bool Verilog2db::hasTerminals(Net* net) const
 {
   NetTermIterator* term_iter = network_->termIterator(net);
@@ -436,4 +481,17 @@ dbMaster* Verilog2db::getMaster(Cell* cell)
   return nullptr;
 }
 
+dbMTerm* Verilog2db::getMTerm(const Pin* pin, dbMaster* master)
+{
+  // Each port belongs to a single cell and so to a single master.
+  const Port* port = network_->port(pin);
+  auto miter = mterm_map_.find(port);
+  if (miter != mterm_map_.end()) {
+    return miter->second;
+  }
+  dbMTerm* mterm = master->findMTerm(block_, network_->portName(pin));
+  mterm_map_[port] = mterm;
+  return mterm;
+}
+
 }  // namespace ord
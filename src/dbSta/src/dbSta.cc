@@ -177,6 +177,7 @@ std::unique_ptr<dbSta> dbSta::makeBlockSta(odb::dbBlock* block)
   clone->initVars(tclInterp(), db_, logger_);
   clone->getDbNetwork()->setBlock(block);
   clone->copyUnits(units());
+  clone->setThreadCount(threadCount());
   return clone;
 }
 
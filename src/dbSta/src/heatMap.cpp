@@ -97,6 +97,9 @@ bool PowerDensityDataSource::populateMap()
   const bool include_all
       = include_internal_ && include_leakage_ && include_switching_;
   for (auto* inst : getBlock()->getInsts()) {
+    if (isPopulateCancelled()) {
+      return false;
+    }
     if (!inst->getPlacementStatus().isPlaced()) {
       continue;
     }
@@ -0,0 +1,275 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace dpl {
+
+// Net bounding boxes over pin points that answer the hpwl change of
+// moving a few pins without visiting the other pins of their nets.
+// Each box edge keeps the number of pins on it, so a net is only
+// rescanned when every pin on an edge moves inward.
+// Coord is int for dbu points or double for half-site centers.
+template <typename Coord>
+class IncrementalHpwl
+{
+ public:
+  struct Move
+  {
+    int pin;
+    Coord x;
+    Coord y;
+  };
+
+  int addNet();
+  int addPin(int net, Coord x, Coord y);
+  int netCount() const { return boxes_.size(); }
+  int pinNet(int pin) const { return pin_net_[pin]; }
+  Coord pinX(int pin) const { return pin_x_[pin]; }
+  Coord pinY(int pin) const { return pin_y_[pin]; }
+  bool isEmpty(int net) const { return net_pins_[net].empty(); }
+  Coord xMin(int net) const { return boxes_[net].x_min; }
+  Coord xMax(int net) const { return boxes_[net].x_max; }
+  Coord yMin(int net) const { return boxes_[net].y_min; }
+  Coord yMax(int net) const { return boxes_[net].y_max; }
+  Coord hpwl(int net) const;
+  // New minus old hpwl of the nets of the moved pins.
+  Coord delta(const std::vector<Move>& moves);
+  void commit(const std::vector<Move>& moves);
+
+ private:
+  struct Box
+  {
+    Coord x_min = std::numeric_limits<Coord>::max();
+    Coord x_max = std::numeric_limits<Coord>::lowest();
+    Coord y_min = std::numeric_limits<Coord>::max();
+    Coord y_max = std::numeric_limits<Coord>::lowest();
+    int x_min_count = 0;
+    int x_max_count = 0;
+    int y_min_count = 0;
+    int y_max_count = 0;
+  };
+
+  static void addPoint(Box& box, Coord x, Coord y);
+  static void addMin(Coord v, Coord& min, int& count);
+  static void addMax(Coord v, Coord& max, int& count);
+  static Coord hpwl(const Box& box);
+  Box rescan(int net) const;
+  // Moves the pins and finds the boxes of their nets.
+  void movePins(const std::vector<Move>& moves);
+  void restorePins(const std::vector<Move>& moves);
+
+  std::vector<Box> boxes_;
+  std::vector<std::vector<int>> net_pins_;
+  std::vector<int> pin_net_;
+  std::vector<Coord> pin_x_;
+  std::vector<Coord> pin_y_;
+
+  // Scratch for movePins.
+  std::vector<int> net_mark_;
+  int mark_ = 0;
+  std::vector<int> moved_nets_;
+  std::vector<Box> moved_boxes_;
+  std::vector<Coord> old_x_;
+  std::vector<Coord> old_y_;
+};
+
+template <typename Coord>
+int IncrementalHpwl<Coord>::addNet()
+{
+  boxes_.emplace_back();
+  net_pins_.emplace_back();
+  net_mark_.push_back(0);
+  return boxes_.size() - 1;
+}
+
+template <typename Coord>
+int IncrementalHpwl<Coord>::addPin(int net, Coord x, Coord y)
+{
+  const int pin = pin_net_.size();
+  pin_net_.push_back(net);
+  pin_x_.push_back(x);
+  pin_y_.push_back(y);
+  net_pins_[net].push_back(pin);
+  addPoint(boxes_[net], x, y);
+  return pin;
+}
+
+template <typename Coord>
+Coord IncrementalHpwl<Coord>::hpwl(int net) const
+{
+  return isEmpty(net) ? 0 : hpwl(boxes_[net]);
+}
+
+template <typename Coord>
+Coord IncrementalHpwl<Coord>::hpwl(const Box& box)
+{
+  return (box.x_max - box.x_min) + (box.y_max - box.y_min);
+}
+
+template <typename Coord>
+Coord IncrementalHpwl<Coord>::delta(const std::vector<Move>& moves)
+{
+  movePins(moves);
+  Coord delta = 0;
+  for (size_t i = 0; i < moved_nets_.size(); i++) {
+    delta += hpwl(moved_boxes_[i]) - hpwl(boxes_[moved_nets_[i]]);
+  }
+  restorePins(moves);
+  return delta;
+}
+
+template <typename Coord>
+void IncrementalHpwl<Coord>::commit(const std::vector<Move>& moves)
+{
+  movePins(moves);
+  for (size_t i = 0; i < moved_nets_.size(); i++) {
+    boxes_[moved_nets_[i]] = moved_boxes_[i];
+  }
+}
+
+template <typename Coord>
+void IncrementalHpwl<Coord>::movePins(const std::vector<Move>& moves)
+{
+  mark_++;
+  moved_nets_.clear();
+  moved_boxes_.clear();
+  old_x_.clear();
+  old_y_.clear();
+  for (const Move& move : moves) {
+    const int net = pin_net_[move.pin];
+    if (net_mark_[net] != mark_) {
+      net_mark_[net] = mark_;
+      moved_nets_.push_back(net);
+    }
+    old_x_.push_back(pin_x_[move.pin]);
+    old_y_.push_back(pin_y_[move.pin]);
+    pin_x_[move.pin] = move.x;
+    pin_y_[move.pin] = move.y;
+  }
+
+  for (const int net : moved_nets_) {
+    const Box& old_box = boxes_[net];
+    Box box = old_box;
+    // Take the moved pins off the edges they were on.
+    for (size_t i = 0; i < moves.size(); i++) {
+      if (pin_net_[moves[i].pin] == net) {
+        box.x_min_count -= old_x_[i] == old_box.x_min;
+        box.x_max_count -= old_x_[i] == old_box.x_max;
+        box.y_min_count -= old_y_[i] == old_box.y_min;
+        box.y_max_count -= old_y_[i] == old_box.y_max;
+      }
+    }
+    // An edge with no pins left starts over from the moved pins. That
+    // is only right if they reach at least as far as the old edge.
+    if (box.x_min_count == 0) {
+      box.x_min = std::numeric_limits<Coord>::max();
+    }
+    if (box.x_max_count == 0) {
+      box.x_max = std::numeric_limits<Coord>::lowest();
+    }
+    if (box.y_min_count == 0) {
+      box.y_min = std::numeric_limits<Coord>::max();
+    }
+    if (box.y_max_count == 0) {
+      box.y_max = std::numeric_limits<Coord>::lowest();
+    }
+    for (const Move& move : moves) {
+      if (pin_net_[move.pin] == net) {
+        addPoint(box, move.x, move.y);
+      }
+    }
+    if (box.x_min > old_box.x_min || box.x_max < old_box.x_max
+        || box.y_min > old_box.y_min || box.y_max < old_box.y_max) {
+      box = rescan(net);
+    }
+    moved_boxes_.push_back(box);
+  }
+}
+
+template <typename Coord>
+void IncrementalHpwl<Coord>::restorePins(const std::vector<Move>& moves)
+{
+  for (size_t i = 0; i < moves.size(); i++) {
+    pin_x_[moves[i].pin] = old_x_[i];
+    pin_y_[moves[i].pin] = old_y_[i];
+  }
+}
+
+template <typename Coord>
+typename IncrementalHpwl<Coord>::Box IncrementalHpwl<Coord>::rescan(
+    int net) const
+{
+  Box box;
+  for (const int pin : net_pins_[net]) {
+    addPoint(box, pin_x_[pin], pin_y_[pin]);
+  }
+  return box;
+}
+
+template <typename Coord>
+void IncrementalHpwl<Coord>::addPoint(Box& box, Coord x, Coord y)
+{
+  addMin(x, box.x_min, box.x_min_count);
+  addMax(x, box.x_max, box.x_max_count);
+  addMin(y, box.y_min, box.y_min_count);
+  addMax(y, box.y_max, box.y_max_count);
+}
+
+template <typename Coord>
+void IncrementalHpwl<Coord>::addMin(Coord v, Coord& min, int& count)
+{
+  if (v < min) {
+    min = v;
+    count = 1;
+  } else if (v == min) {
+    count++;
+  }
+}
+
+template <typename Coord>
+void IncrementalHpwl<Coord>::addMax(Coord v, Coord& max, int& count)
+{
+  if (v > max) {
+    max = v;
+    count = 1;
+  } else if (v == max) {
+    count++;
+  }
+}
+
+}  // namespace dpl
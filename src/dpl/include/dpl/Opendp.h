@@ -43,6 +43,7 @@
 #include <boost/geometry/index/rtree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
@@ -52,7 +53,9 @@
 #include <utility>  // pair
 #include <vector>
 
+#include "dpl/IncrementalHpwl.h"
 #include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
 
 namespace utl {
 class Logger;
@@ -98,8 +101,14 @@ using RtreeBox
 // The "Grid" is now an array of 2D grids. The new dimension is to support
 // multi-height cells. Each unique row height creates a new grid that is used in
 // legalization. The first index is the grid index (corresponding to row
-// height), second index is the row index, and third index is the site index.
-using Grid = std::vector<std::vector<std::vector<Pixel>>>;
+// height). Each 2D grid is one row-major allocation of row_count * site_count
+// pixels; use gridPixel to index it.
+using Grid = std::vector<std::vector<Pixel>>;
+// One bit per site of each 2D grid, set when an ungrouped cell can use the
+// site. Each row starts on a word boundary.
+using FreeSiteGrid = std::vector<std::vector<uint64_t>>;
+// Sparse per grid data indexed by y * site_count + x.
+using PixelGroupMap = std::vector<unordered_map<int64_t, Group*>>;
 using dbMasterSeq = vector<dbMaster*>;
 // gap -> sequence of masters to fill the gap
 using GapFillers = vector<dbMasterSeq>;
@@ -137,11 +146,11 @@ struct Group
   double util = 0.0;
 };
 
+// Group membership is kept in Opendp::pixel_groups_ since few pixels
+// have one.
 struct Pixel
 {
   Cell* cell;
-  Group* group_;
-  double util;
   dbOrientType orient_;
   bool is_valid;     // false for dummy cells
   bool is_hopeless;  // too far from sites for diamond search
@@ -159,14 +168,11 @@ class NetBox
 {
  public:
   NetBox() = default;
-  NetBox(dbNet* net, Rect box, bool ignore);
-  int64_t hpwl();
-  void saveBox();
-  void restoreBox();
+  NetBox(dbNet* net, int index, bool ignore);
 
   dbNet* net_ = nullptr;
-  Rect box_;
-  Rect box_saved_;
+  // Net in Opendp::net_hpwl_.
+  int index_ = -1;
   bool ignore_ = false;
 };
 
@@ -185,7 +191,7 @@ class PixelPt
   Point pt;  // grid locataion
 };
 
-class Opendp
+class Opendp : public odb::dbBlockCallBackObj
 {
  public:
   Opendp();
@@ -214,6 +220,11 @@ class Opendp
   void setPadding(dbMaster* master, int left, int right);
   void setPadding(dbInst* inst, int left, int right);
   void setDebug(std::unique_ptr<dpl::DplObserver>& observer);
+  // Legalize insts that were created, moved or resized since the last
+  // legalization, leaving the rest of the placement where it is.
+  void incrementalPlacement(const set<dbInst*>& insts);
+  // Legalize single row cells in bands of rows concurrently when > 1.
+  void setNumThreads(int threads) { num_threads_ = threads; }
 
   // Global padding.
   int padGlobalLeft() const { return pad_left_; }
@@ -243,7 +254,7 @@ class Opendp
   void findDisplacementStats();
   void optimizeMirroring();
 
-  const vector<Cell>& getCells() const { return cells_; }
+  const std::deque<Cell>& getCells() const { return cells_; }
   Rect getCore() const { return core_; }
   int getRowHeight() const { return row_height_; }
   int getSiteWidth() const { return site_width_; }
@@ -282,6 +293,13 @@ class Opendp
                         // grid indices
                         int x,
                         int y) const;
+  // Search restricted to cell origins in rows [y_lo, y_hi].
+  PixelPt diamondSearch(const Cell* cell,
+                        // grid indices
+                        int x,
+                        int y,
+                        int y_lo,
+                        int y_hi) const;
   void diamondSearchSide(const Cell* cell,
                          int x,
                          int y,
@@ -334,6 +352,11 @@ class Opendp
   void prePlace();
   void prePlaceGroups();
   void place();
+  vector<Cell*> incrementalCells(const set<dbInst*>& insts);
+  vector<Cell*> importIncremental(const set<dbInst*>& insts);
+  bool paintInPlace(Cell* cell);
+  void inDbInstDestroy(dbInst* inst) override;
+  void placeBands(const vector<Cell*>& sorted_cells);
   void placeGroups2();
   void brickPlace1(const Group* group);
   void brickPlace2(const Group* group);
@@ -394,6 +417,11 @@ class Opendp
   void checkOneSiteDbMaster();
   void deleteGrid();
   Pixel* gridPixel(int grid_idx, int x, int y) const;
+  Group* pixelGroup(int grid_idx, int x, int y) const;
+  void setPixelGroup(int grid_idx, int x, int y, Group* group);
+  void initFreeSites();
+  void updateFreeSite(int grid_idx, int x, int y);
+  bool isFreeSiteRun(int grid_idx, int y, int x, int x_end) const;
   // Cell initial location wrt core origin.
   int getRowHeight(const Cell* cell) const;
   int getSiteWidth(const Cell* cell) const;
@@ -462,9 +490,8 @@ class Opendp
   int mirrorCandidates(vector<dbInst*>& mirror_candidates);
   // Sum of ITerm hpwl's.
   int64_t hpwl(dbInst* inst);
+  int64_t hpwl(const NetBox* net_box) const;
   void updateNetBoxes(dbInst* inst);
-  void saveNetBoxes(dbInst* inst);
-  void restoreNetBoxes(dbInst* inst);
 
   Logger* logger_ = nullptr;
   dbDatabase* db_ = nullptr;
@@ -474,7 +501,8 @@ class Opendp
   InstPaddingMap inst_padding_map_;
   MasterPaddingMap master_padding_map_;
 
-  vector<Cell> cells_;
+  // Deque so incremental placement can add cells without moving them.
+  std::deque<Cell> cells_;
   vector<Group> groups_;
 
   map<const dbMaster*, Master> db_master_map_;
@@ -491,10 +519,17 @@ class Opendp
   int max_displacement_x_ = 0;  // sites
   int max_displacement_y_ = 0;  // sites
   bool disallow_one_site_gaps_ = false;
+  int num_threads_ = 1;
+  // The grid holds the cells as last legalized.
+  bool incremental_ready_ = false;
   vector<Cell*> placement_failures_;
 
   // 3D pixel grid
   Grid grid_;
+  // Follows paintPixel/erasePixel; rebuilt by initFreeSites after bulk
+  // grid initialization.
+  FreeSiteGrid free_sites_;
+  PixelGroupMap pixel_groups_;
   Cell dummy_cell_;
   RtreeBox regions_rtree;
 
@@ -513,11 +548,16 @@ class Opendp
 
   // Optimiize mirroring.
   NetBoxMap net_box_map_;
+  IncrementalHpwl<int> net_hpwl_;
+  unordered_map<odb::dbITerm*, int> iterm_pins_;
 
   std::unique_ptr<DplObserver> debug_observer_;
 
   // Magic numbers
   static constexpr int bin_search_width_ = 10;
+  // Rows per band for parallel placement.  Fixed so results do not
+  // depend on the thread count.
+  static constexpr int band_row_count_ = 32;
   static constexpr double group_refine_percent_ = .05;
   static constexpr double refine_percent_ = .02;
   static constexpr int rand_seed_ = 777;
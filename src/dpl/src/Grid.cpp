@@ -92,33 +92,22 @@ void Opendp::initGrid()
   if (grid_info_map_.empty()) {
     initGridLayersMap();
   }
+  incremental_ready_ = false;
 
   // Make pixel grid
-  if (grid_.empty()) {
-    grid_.resize(grid_info_map_.size());
-
-    for (auto& [row_height, grid_info] : grid_info_map_) {
-      int layer_row_count = grid_info.row_count;
-      int index = grid_info.grid_index;
-      grid_[index].resize(layer_row_count);
-    }
-  }
+  grid_.resize(grid_info_map_.size());
+  pixel_groups_.clear();
+  pixel_groups_.resize(grid_info_map_.size());
 
   for (auto& [row_height, grid_info] : grid_info_map_) {
-    const int layer_row_count = grid_info.row_count;
-    const int layer_row_site_count = grid_info.site_count;
+    const int64_t pixel_count
+        = static_cast<int64_t>(grid_info.row_count) * grid_info.site_count;
     const int index = grid_info.grid_index;
-    grid_[index].resize(layer_row_count);
-    for (int j = 0; j < layer_row_count; j++) {
-      grid_[index][j].resize(layer_row_site_count);
-      for (int k = 0; k < layer_row_site_count; k++) {
-        Pixel& pixel = grid_[index][j][k];
-        pixel.cell = nullptr;
-        pixel.group_ = nullptr;
-        pixel.util = 0.0;
-        pixel.is_valid = false;
-        pixel.is_hopeless = false;
-      }
+    grid_[index].resize(pixel_count);
+    for (Pixel& pixel : grid_[index]) {
+      pixel.cell = nullptr;
+      pixel.is_valid = false;
+      pixel.is_hopeless = false;
     }
   }
 
@@ -184,17 +173,19 @@ void Opendp::initGrid()
     for (const auto& rect : rects) {
       for (int y = gtl::yl(rect); y < gtl::yh(rect); y++) {
         for (int x = gtl::xl(rect); x < gtl::xh(rect); x++) {
-          Pixel& pixel = grid_[h_index][y][x];
-          pixel.is_hopeless = true;
+          gridPixel(h_index, x, y)->is_hopeless = true;
         }
       }
     }
   }
+  initFreeSites();
 }
 
 void Opendp::deleteGrid()
 {
   grid_.clear();
+  free_sites_.clear();
+  pixel_groups_.clear();
 }
 
 Pixel* Opendp::gridPixel(int grid_idx, int grid_x, int grid_y) const
@@ -205,11 +196,97 @@ Pixel* Opendp::gridPixel(int grid_idx, int grid_x, int grid_y) const
   GridInfo* grid_info = grid_info_vector_[grid_idx];
   if (grid_x >= 0 && grid_x < grid_info->site_count && grid_y >= 0
       && grid_y < grid_info->row_count) {
-    return const_cast<Pixel*>(&grid_[grid_idx][grid_y][grid_x]);
+    const int64_t index
+        = static_cast<int64_t>(grid_y) * grid_info->site_count + grid_x;
+    return const_cast<Pixel*>(&grid_[grid_idx][index]);
   }
   return nullptr;
 }
 
+Group* Opendp::pixelGroup(int grid_idx, int grid_x, int grid_y) const
+{
+  const GridInfo* grid_info = grid_info_vector_[grid_idx];
+  const auto& groups = pixel_groups_[grid_idx];
+  auto group_iter = groups.find(static_cast<int64_t>(grid_y)
+                                    * grid_info->site_count
+                                + grid_x);
+  return group_iter == groups.end() ? nullptr : group_iter->second;
+}
+
+void Opendp::setPixelGroup(int grid_idx, int grid_x, int grid_y, Group* group)
+{
+  const GridInfo* grid_info = grid_info_vector_[grid_idx];
+  pixel_groups_[grid_idx]
+               [static_cast<int64_t>(grid_y) * grid_info->site_count + grid_x]
+      = group;
+  updateFreeSite(grid_idx, grid_x, grid_y);
+}
+
+////////////////////////////////////////////////////////////////
+
+static int freeSiteRowWords(const GridInfo* grid_info)
+{
+  return (grid_info->site_count + 63) / 64;
+}
+
+void Opendp::initFreeSites()
+{
+  free_sites_.resize(grid_info_vector_.size());
+  for (int grid_idx = 0; grid_idx < grid_info_vector_.size(); grid_idx++) {
+    const GridInfo* grid_info = grid_info_vector_[grid_idx];
+    free_sites_[grid_idx].assign(
+        static_cast<int64_t>(grid_info->row_count)
+            * freeSiteRowWords(grid_info),
+        0);
+    for (int y = 0; y < grid_info->row_count; y++) {
+      for (int x = 0; x < grid_info->site_count; x++) {
+        updateFreeSite(grid_idx, x, y);
+      }
+    }
+  }
+}
+
+void Opendp::updateFreeSite(int grid_idx, int grid_x, int grid_y)
+{
+  const GridInfo* grid_info = grid_info_vector_[grid_idx];
+  const Pixel* pixel = gridPixel(grid_idx, grid_x, grid_y);
+  const bool free = pixel->cell == nullptr && pixel->is_valid
+                    && pixelGroup(grid_idx, grid_x, grid_y) == nullptr;
+  uint64_t& word = free_sites_[grid_idx][static_cast<int64_t>(grid_y)
+                                             * freeSiteRowWords(grid_info)
+                                         + grid_x / 64];
+  const uint64_t bit = uint64_t(1) << (grid_x % 64);
+  if (free) {
+    word |= bit;
+  } else {
+    word &= ~bit;
+  }
+}
+
+// True if sites [x, x_end) of row y are all free, checking up to 64
+// sites at a time.
+bool Opendp::isFreeSiteRun(int grid_idx, int grid_y, int x, int x_end) const
+{
+  const GridInfo* grid_info = grid_info_vector_[grid_idx];
+  if (x < 0 || x_end > grid_info->site_count || grid_y < 0
+      || grid_y >= grid_info->row_count) {
+    return false;
+  }
+  const uint64_t* row = &free_sites_[grid_idx][static_cast<int64_t>(grid_y)
+                                               * freeSiteRowWords(grid_info)];
+  while (x < x_end) {
+    const int bit = x % 64;
+    const int count = min(64 - bit, x_end - x);
+    const uint64_t mask
+        = (count == 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1) << bit;
+    if ((row[x / 64] & mask) != mask) {
+      return false;
+    }
+    x += count;
+  }
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////
 
 void Opendp::findOverlapInRtree(bgBox& queryBox, vector<bgBox>& overlaps) const
@@ -396,12 +473,12 @@ void Opendp::setFixedGridCells()
           cell, true, [&](Pixel* pixel) { setGridCell(cell, pixel); });
     }
   }
+  initFreeSites();
 }
 
 void Opendp::setGridCell(Cell& cell, Pixel* pixel)
 {
   pixel->cell = &cell;
-  pixel->util = 1.0;
   if (isBlock(&cell)) {
     // Try the is_hopeless strategy to get off of a block
     pixel->is_hopeless = true;
@@ -424,7 +501,8 @@ void Opendp::groupAssignCellRegions()
       for (int x = 0; x < max_row_site_count; x++) {
         for (int y = 0; y < row_count; y++) {
           Pixel* pixel = gridPixel(grid_info.grid_index, x, y);
-          if (pixel->is_valid && pixel->group_ == &group) {
+          if (pixel->is_valid
+              && pixelGroup(grid_info.grid_index, x, y) == &group) {
             site_count++;
           }
         }
@@ -468,7 +546,6 @@ void Opendp::groupInitPixels2()
         for (Group& group : groups_) {
           for (Rect& rect : group.regions) {
             if (!isInside(sub, rect) && checkOverlap(sub, rect)) {
-              pixel->util = 0.0;
               pixel->cell = &dummy_cell_;
               pixel->is_valid = false;
             }
@@ -477,6 +554,7 @@ void Opendp::groupInitPixels2()
       }
     }
   }
+  initFreeSites();
 }
 
 /* static */
@@ -494,15 +572,14 @@ bool Opendp::checkOverlap(const Rect& cell, const Rect& box)
 
 void Opendp::groupInitPixels()
 {
-  for (const auto& layer : grid_info_map_) {
-    const GridInfo& grid_info = layer.second;
-    for (int x = 0; x < grid_info.site_count; x++) {
-      for (int y = 0; y < grid_info.row_count; y++) {
-        Pixel* pixel = gridPixel(grid_info.grid_index, x, y);
-        pixel->util = 0.0;
-      }
-    }
-  }
+  // Fraction of each site covered by group regions, sparse over the
+  // grids since only region sites are touched.
+  vector<unordered_map<int64_t, double>> utils(grid_info_vector_.size());
+  auto pixelUtil = [&](int grid_index, int x, int y) -> double& {
+    return utils[grid_index][static_cast<int64_t>(y)
+                                 * grid_info_vector_[grid_index]->site_count
+                             + x];
+  };
   for (Group& group : groups_) {
     if (group.cells_.empty()) {
       logger_->warn(DPL, 42, "No cells found in group {}. ", group.name);
@@ -531,18 +608,16 @@ void Opendp::groupInitPixels()
         int col_end = divFloor(rect.xMax(), site_width);
 
         for (int l = col_start; l < col_end; l++) {
-          Pixel* pixel = gridPixel(grid_index, l, k);
-          pixel->util += 1.0;
+          pixelUtil(grid_index, l, k) += 1.0;
         }
         if (rect.xMin() % site_width != 0) {
-          Pixel* pixel = gridPixel(grid_index, col_start, k);
-          pixel->util
+          pixelUtil(grid_index, col_start, k)
               -= (rect.xMin() % site_width) / static_cast<double>(site_width);
         }
         if (rect.xMax() % site_width != 0) {
-          Pixel* pixel = gridPixel(grid_index, col_end - 1, k);
-          pixel->util -= ((site_width - rect.xMax()) % site_width)
-                         / static_cast<double>(site_width);
+          pixelUtil(grid_index, col_end - 1, k)
+              -= ((site_width - rect.xMax()) % site_width)
+                 / static_cast<double>(site_width);
         }
       }
     }
@@ -557,14 +632,15 @@ void Opendp::groupInitPixels()
         // Assign group to each pixel.
         for (int l = col_start; l < col_end; l++) {
           Pixel* pixel = gridPixel(grid_index, l, k);
-          if (pixel->util == 1.0) {
-            pixel->group_ = &group;
+          double& util = pixelUtil(grid_index, l, k);
+          if (util == 1.0) {
             pixel->is_valid = true;
-            pixel->util = 1.0;
-          } else if (pixel->util > 0.0 && pixel->util < 1.0) {
+            setPixelGroup(grid_index, l, k, &group);
+          } else if (util > 0.0 && util < 1.0) {
             pixel->cell = &dummy_cell_;
-            pixel->util = 0.0;
+            util = 0.0;
             pixel->is_valid = false;
+            updateFreeSite(grid_index, l, k);
           }
         }
       }
@@ -597,7 +673,7 @@ void Opendp::erasePixel(Cell* cell)
             continue;
           }
           pixel->cell = nullptr;
-          pixel->util = 0;
+          updateFreeSite(grid_info.grid_index, x, y);
         }
       }
     }
@@ -634,7 +710,7 @@ void Opendp::paintPixel(Cell* cell, int grid_x, int grid_y)
             DPL, 13, "Cannot paint grid because it is already occupied.");
       } else {
         pixel->cell = cell;
-        pixel->util = 1.0;
+        updateFreeSite(index_in_grid, x, y);
       }
     }
   }
@@ -688,7 +764,7 @@ void Opendp::paintPixel(Cell* cell, int grid_x, int grid_y)
         }
 
         pixel->cell = cell;
-        pixel->util = 1.0;
+        updateFreeSite(layer.second.grid_index, x, y);
       }
     }
   }
@@ -48,6 +48,7 @@
 
 #include "DplObserver.h"
 #include "utl/Logger.h"
+#include "utl/trace.h"
 
 namespace dpl {
 
@@ -138,6 +139,7 @@ void Opendp::detailedPlacement(int max_displacement_x,
                                const std::string& report_file_name,
                                bool disallow_one_site_gaps)
 {
+  utl::TraceSpan span("dpl", "detailed_placement");
   importDb();
 
   if (have_fillers_) {
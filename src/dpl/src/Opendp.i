@@ -103,6 +103,13 @@ detailed_placement_cmd(int max_displacment_x,
   opendp->detailedPlacement(max_displacment_x, max_displacment_y, std::string(report_file_name), disallow_one_site_gaps);
 }
 
+void
+set_num_threads(int threads)
+{
+  dpl::Opendp *opendp = ord::OpenRoad::openRoad()->getOpendp();
+  opendp->setNumThreads(threads);
+}
+
 void
 report_legalization_stats()
 {
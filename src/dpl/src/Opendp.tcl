@@ -70,6 +70,7 @@ set disallow_one_site_gaps [info exists flags(-disallow_one_site_gaps)]
                               / [$site getWidth]]
     set max_displacement_y [expr [ord::microns_to_dbu $max_displacement_y] \
                               / [$site getHeight]]
+    dpl::set_num_threads [ord::thread_count]
     dpl::detailed_placement_cmd $max_displacement_x $max_displacement_y \
                                 $disallow_one_site_gaps $file_name 
     dpl::report_legalization_stats
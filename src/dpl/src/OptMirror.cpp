@@ -51,24 +51,11 @@ using odb::dbOrientType;
 
 static dbOrientType orientMirrorY(const dbOrientType& orient);
 
-NetBox::NetBox(dbNet* net, Rect box, bool ignore)
-    : net_(net), box_(box), ignore_(ignore)
-{
-}
-
-int64_t NetBox::hpwl()
-{
-  return box_.dy() + box_.dx();
-}
+static Point termPoint(dbITerm* iterm);
 
-void NetBox::saveBox()
+NetBox::NetBox(dbNet* net, int index, bool ignore)
+    : net_(net), index_(index), ignore_(ignore)
 {
-  box_saved_ = box_;
-}
-
-void NetBox::restoreBox()
-{
-  box_ = box_saved_;
 }
 
 ////////////////////////////////////////////////////////////////
@@ -86,8 +73,8 @@ void Opendp::optimizeMirroring()
   // Sort net boxes by net hpwl.
   sort(sorted_boxes.begin(),
        sorted_boxes.end(),
-       [](NetBox* net_box1, NetBox* net_box2) -> bool {
-         return net_box1->hpwl() > net_box2->hpwl();
+       [this](NetBox* net_box1, NetBox* net_box2) -> bool {
+         return hpwl(net_box1) > hpwl(net_box2);
        });
 
   vector<dbInst*> mirror_candidates = findMirrorCandidates(sorted_boxes);
@@ -111,6 +98,8 @@ void Opendp::optimizeMirroring()
 void Opendp::findNetBoxes()
 {
   net_box_map_.clear();
+  net_hpwl_ = IncrementalHpwl<int>();
+  iterm_pins_.clear();
   auto nets = block_->getNets();
   for (dbNet* net : nets) {
     bool ignore = net->getSigType().isSupply()
@@ -125,8 +114,41 @@ void Opendp::findNetBoxes()
       debugPrint(
           logger_, DPL, "opt_mirror", 2, "ignore {}", net->getConstName());
     }
-    net_box_map_[net] = NetBox(net, net->getTermBBox(), ignore);
+    int index = -1;
+    if (!ignore) {
+      // Same points as dbNet::getTermBBox.
+      index = net_hpwl_.addNet();
+      for (dbITerm* iterm : net->getITerms()) {
+        const Point pt = termPoint(iterm);
+        iterm_pins_[iterm] = net_hpwl_.addPin(index, pt.getX(), pt.getY());
+      }
+      for (odb::dbBTerm* bterm : net->getBTerms()) {
+        for (odb::dbBPin* bpin : bterm->getBPins()) {
+          if (bpin->getPlacementStatus().isPlaced()) {
+            const Rect pin_bbox = bpin->getBBox();
+            net_hpwl_.addPin(index, pin_bbox.xCenter(), pin_bbox.yCenter());
+          }
+        }
+      }
+    }
+    net_box_map_[net] = NetBox(net, index, ignore);
+  }
+}
+
+static Point termPoint(dbITerm* iterm)
+{
+  int x, y;
+  if (iterm->getAvgXY(&x, &y)) {
+    return Point(x, y);
   }
+  odb::dbBox* inst_box = iterm->getInst()->getBBox();
+  return Point((inst_box->xMin() + inst_box->xMax()) / 2,
+               (inst_box->yMin() + inst_box->yMax()) / 2);
+}
+
+int64_t Opendp::hpwl(const NetBox* net_box) const
+{
+  return net_box->ignore_ ? 0 : net_hpwl_.hpwl(net_box->index_);
 }
 
 vector<dbInst*> Opendp::findMirrorCandidates(NetBoxes& net_boxes)
@@ -137,13 +159,14 @@ vector<dbInst*> Opendp::findMirrorCandidates(NetBoxes& net_boxes)
   for (NetBox* net_box : net_boxes) {
     if (!net_box->ignore_) {
       dbNet* net = net_box->net_;
-      Rect& box = net_box->box_;
+      const int index = net_box->index_;
       for (dbITerm* iterm : net->getITerms()) {
         dbInst* inst = iterm->getInst();
         int x, y;
         if (inst->isCore() && !inst->isFixed() && iterm->getAvgXY(&x, &y)
-            && (x == box.xMin() || x == box.xMax() || y == box.yMin()
-                || y == box.yMax())) {
+            && (x == net_hpwl_.xMin(index) || x == net_hpwl_.xMax(index)
+                || y == net_hpwl_.yMin(index)
+                || y == net_hpwl_.yMax(index))) {
           dbInst* inst = iterm->getInst();
           if (existing.find(inst) == existing.end()) {
             mirror_candidates.push_back(inst);
@@ -169,7 +192,6 @@ int Opendp::mirrorCandidates(vector<dbInst*>& mirror_candidates)
     // Use hpwl of all nets connected to the instance terms
     // before/after to determine incremental change to total hpwl.
     int64_t hpwl_before = hpwl(inst);
-    saveNetBoxes(inst);
     dbOrientType orient = inst->getOrient();
     dbOrientType orient_my = orientMirrorY(orient);
     inst->setLocationOrient(orient_my);
@@ -178,7 +200,7 @@ int Opendp::mirrorCandidates(vector<dbInst*>& mirror_candidates)
     if (hpwl_after > hpwl_before) {
       // Undo mirroring if hpwl is worse.
       inst->setLocationOrient(orient);
-      restoreNetBoxes(inst);
+      updateNetBoxes(inst);
     } else {
       debugPrint(
           logger_, DPL, "opt_mirror", 1, "mirror {}", inst->getConstName());
@@ -220,46 +242,24 @@ int64_t Opendp::hpwl(dbInst* inst)
   for (dbITerm* iterm : inst->getITerms()) {
     dbNet* net = iterm->getNet();
     if (net) {
-      NetBox& net_box = net_box_map_[net];
-      if (!net_box.ignore_) {
-        inst_hpwl += net_box.hpwl();
-      }
+      inst_hpwl += hpwl(&net_box_map_[net]);
     }
   }
   return inst_hpwl;
 }
 
+// Move the inst's pins in net_hpwl_ to where the db has them.
 void Opendp::updateNetBoxes(dbInst* inst)
 {
+  vector<IncrementalHpwl<int>::Move> moves;
   for (dbITerm* iterm : inst->getITerms()) {
-    dbNet* net = iterm->getNet();
-    if (net) {
-      NetBox& net_box = net_box_map_[net];
-      if (!net_box.ignore_) {
-        net_box_map_[net].box_ = net->getTermBBox();
-      }
-    }
-  }
-}
-
-void Opendp::saveNetBoxes(dbInst* inst)
-{
-  for (dbITerm* iterm : inst->getITerms()) {
-    dbNet* net = iterm->getNet();
-    if (net) {
-      net_box_map_[net].saveBox();
-    }
-  }
-}
-
-void Opendp::restoreNetBoxes(dbInst* inst)
-{
-  for (dbITerm* iterm : inst->getITerms()) {
-    dbNet* net = iterm->getNet();
-    if (net) {
-      net_box_map_[net].restoreBox();
+    auto pin_iter = iterm_pins_.find(iterm);
+    if (pin_iter != iterm_pins_.end()) {
+      const Point pt = termPoint(iterm);
+      moves.push_back({pin_iter->second, pt.getX(), pt.getY()});
     }
   }
+  net_hpwl_.commit(moves);
 }
 
 }  // namespace dpl
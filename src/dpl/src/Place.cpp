@@ -89,6 +89,8 @@ void Opendp::detailedPlacement()
     placeGroups();
   }
   place();
+  incremental_ready_ = true;
+  addOwner(block_);
 
   if (debug_observer_) {
     debug_observer_->endPlacement();
@@ -331,8 +333,12 @@ void Opendp::place()
       }
     }
   }
+  if (num_threads_ > 1) {
+    placeBands(sorted_cells);
+  }
+  // Serially place whatever the bands could not.
   for (Cell* cell : sorted_cells) {
-    if (!isMultiRow(cell) && cellFitsInCore(cell)) {
+    if (!isMultiRow(cell) && !cell->is_placed_ && cellFitsInCore(cell)) {
       if (!mapMove(cell)) {
         shiftMove(cell);
       }
@@ -342,6 +348,193 @@ void Opendp::place()
   // anneal();
 }
 
+// Single row cells are split into bands of rows by their initial
+// location and each band is legalized by its own thread.  A cell only
+// looks for sites inside its band, less a halo row on shared edges when
+// one site gaps are checked against the neighboring rows, so no two
+// threads touch the same pixels.  Cells that do not find a site stay
+// unplaced for the serial pass.
+void Opendp::placeBands(const vector<Cell*>& sorted_cells)
+{
+  // Painting a cell on one layer marks the overlapping rows of the
+  // others, which would cross band boundaries.
+  if (grid_info_map_.size() != 1 || debug_observer_) {
+    return;
+  }
+  const int row_count = grid_info_map_.begin()->second.row_count;
+  const int band_count = divCeil(row_count, band_row_count_);
+  if (band_count < 2) {
+    return;
+  }
+
+  vector<vector<Cell*>> band_cells(band_count);
+  for (Cell* cell : sorted_cells) {
+    if (!isMultiRow(cell) && cellFitsInCore(cell)) {
+      const int y = legalGridPt(cell, true).getY();
+      band_cells[min(y / band_row_count_, band_count - 1)].push_back(cell);
+    }
+  }
+
+  const int halo = disallow_one_site_gaps_ ? 1 : 0;
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (int band = 0; band < band_count; band++) {
+    const int band_min = band * band_row_count_ + (band > 0 ? halo : 0);
+    const int band_max = min(row_count, (band + 1) * band_row_count_)
+                         - (band < band_count - 1 ? halo : 0);
+    for (Cell* cell : band_cells[band]) {
+      // Last row the cell can start on and stay inside the band.
+      const int y_hi = band_max - gridHeight(cell);
+      if (y_hi < band_min) {
+        continue;
+      }
+      const Point grid_pt = legalGridPt(cell, true);
+      const int grid_y = std::clamp(grid_pt.getY(), band_min, y_hi);
+      PixelPt pixel_pt
+          = diamondSearch(cell, grid_pt.getX(), grid_y, band_min, y_hi);
+      if (pixel_pt.pixel) {
+        paintPixel(cell, pixel_pt.pt.getX(), pixel_pt.pt.getY());
+      }
+    }
+  }
+}
+
+void Opendp::incrementalPlacement(const set<dbInst*>& insts)
+{
+  if (max_displacement_x_ == 0 || max_displacement_y_ == 0) {
+    // defaults as in detailedPlacement
+    max_displacement_x_ = 500;
+    max_displacement_y_ = 100;
+  }
+  placement_failures_.clear();
+  vector<Cell*> cells;
+  if (incremental_ready_ && block_ == db_->getChip()->getBlock()) {
+    cells = incrementalCells(insts);
+  } else {
+    cells = importIncremental(insts);
+  }
+  sort(cells.begin(), cells.end(), CellPlaceOrderLess(this));
+
+  // Multi-row cells first as in place().
+  for (const bool multi_row : {true, false}) {
+    for (Cell* cell : cells) {
+      if (isMultiRow(cell) == multi_row && !cell->is_placed_
+          && cellFitsInCore(cell)) {
+        if (!mapMove(cell)) {
+          shiftMove(cell);
+        }
+      }
+    }
+  }
+  // shiftMove may also move neighbors of the cells.
+  updateDbInstLocations();
+  incremental_ready_ = true;
+
+  debugPrint(logger_,
+             DPL,
+             "place",
+             1,
+             "Incremental placement of {} instances.",
+             cells.size());
+  if (!placement_failures_.empty()) {
+    logger_->warn(DPL,
+                  46,
+                  "Incremental placement failed on {} instances.",
+                  placement_failures_.size());
+  }
+}
+
+// Take insts off the grid and refresh them from the db.
+vector<Cell*> Opendp::incrementalCells(const set<dbInst*>& insts)
+{
+  vector<Cell*> cells;
+  for (dbInst* db_inst : insts) {
+    dbMaster* db_master = db_inst->getMaster();
+    if (!db_master->isCoreAutoPlaceable() || db_inst->isFixed()) {
+      continue;
+    }
+    Cell* cell;
+    auto cell_iter = db_inst_map_.find(db_inst);
+    if (cell_iter == db_inst_map_.end()) {
+      if (db_inst->getRegion()) {
+        // Group membership is only found by importDb.
+        return importIncremental(insts);
+      }
+      cells_.emplace_back();
+      cell = &cells_.back();
+      db_inst_map_[db_inst] = cell;
+    } else {
+      cell = cell_iter->second;
+      erasePixel(cell);
+    }
+    auto master_iter = db_master_map_.find(db_master);
+    if (master_iter == db_master_map_.end()) {
+      master_iter = db_master_map_.emplace(db_master, Master()).first;
+      makeMaster(&master_iter->second, db_master);
+    }
+    if (master_iter->second.is_multi_row && db_master->isCore()) {
+      have_multi_row_cells_ = true;
+    }
+    convertDbToCell(db_inst, *cell);
+    cells.push_back(cell);
+  }
+  return cells;
+}
+
+// Rebuild the grid with every other cell painted where it is.
+vector<Cell*> Opendp::importIncremental(const set<dbInst*>& insts)
+{
+  importDb();
+  initGrid();
+  setFixedGridCells();
+  groupInitPixels2();
+  groupInitPixels();
+
+  vector<Cell*> cells;
+  for (Cell& cell : cells_) {
+    if (!isFixed(&cell)
+        && (insts.find(cell.db_inst_) != insts.end() || !paintInPlace(&cell))) {
+      cells.push_back(&cell);
+    }
+  }
+  addOwner(block_);
+  return cells;
+}
+
+bool Opendp::paintInPlace(Cell* cell)
+{
+  const int site_width = getSiteWidth(cell);
+  const int row_height = getRowHeight(cell);
+  if (cell->x_ < 0 || cell->y_ < 0 || cell->x_ % site_width != 0
+      || cell->y_ % row_height != 0) {
+    return false;
+  }
+  // Gaps left by the existing placement are accepted.
+  const bool disallow_one_site_gaps = disallow_one_site_gaps_;
+  disallow_one_site_gaps_ = false;
+  const int x = gridPaddedX(cell, site_width);
+  const int y = gridY(cell, row_height);
+  const int y_end = gridEndY(cell, row_height);
+  const bool fits = x >= 0 && y_end <= getRowInfo(cell).second.row_count
+                    && checkPixels(cell,
+                                   x,
+                                   y,
+                                   gridPaddedEndX(cell, site_width),
+                                   y_end);
+  disallow_one_site_gaps_ = disallow_one_site_gaps;
+  if (fits) {
+    paintPixel(cell, x, y);
+  }
+  return fits;
+}
+
+void Opendp::inDbInstDestroy(dbInst* db_inst)
+{
+  // The grid and cells_ would refer to the destroyed inst.
+  if (db_inst_map_.find(db_inst) != db_inst_map_.end()) {
+    incremental_ready_ = false;
+  }
+}
+
 bool Opendp::cellFitsInCore(Cell* cell)
 {
   return gridPaddedWidth(cell) <= row_site_count_
@@ -700,6 +893,16 @@ PixelPt Opendp::diamondSearch(const Cell* cell,
                               // grid
                               int x,
                               int y) const
+{
+  return diamondSearch(cell, x, y, 0, numeric_limits<int>::max());
+}
+
+PixelPt Opendp::diamondSearch(const Cell* cell,
+                              // grid
+                              int x,
+                              int y,
+                              int y_lo,
+                              int y_hi) const
 {
   // Diamond search limits.
   int x_min = x - max_displacement_x_;
@@ -738,6 +941,9 @@ PixelPt Opendp::diamondSearch(const Cell* cell,
   y_min = max(0, y_min);
   x_max = min(grid_info.site_count, x_max);
   y_max = min(grid_info.row_count, y_max);
+  // Restrict search to the caller's rows.
+  y_min = max(y_lo, y_min);
+  y_max = min(y_hi, y_max);
   debugPrint(logger_,
              DPL,
              "place",
@@ -960,13 +1166,16 @@ bool Opendp::checkPixels(const Cell* cell,
 
   int layer = row_info.second.grid_index;
   for (int y1 = y; y1 < y_end; y1++) {
-    for (int x1 = x; x1 < x_end; x1++) {
-      Pixel* pixel = gridPixel(layer, x1, y1);
-      if (pixel == nullptr || pixel->cell || !pixel->is_valid
-          || (cell->inGroup() && pixel->group_ != cell->group_)
-          || (!cell->inGroup() && pixel->group_)) {
-        return false;
+    if (cell->inGroup()) {
+      for (int x1 = x; x1 < x_end; x1++) {
+        Pixel* pixel = gridPixel(layer, x1, y1);
+        if (pixel == nullptr || pixel->cell || !pixel->is_valid
+            || pixelGroup(layer, x1, y1) != cell->group_) {
+          return false;
+        }
       }
+    } else if (!isFreeSiteRun(layer, y1, x, x_end)) {
+      return false;
     }
     if (disallow_one_site_gaps_) {
       // here we need to check for abutting first, if there is an abutting cell
@@ -1161,7 +1370,8 @@ bool Opendp::moveHopeless(const Cell* cell, int& grid_x, int& grid_y) const
   // They will be checked in the checkPixels in the diamondSearch method after
   // this initialization
   for (int x = grid_x - 1; x >= 0; --x) {  // left
-    if (grid_[grid_index][grid_y][x].is_valid) {
+    const Pixel* pixel = gridPixel(grid_index, x, grid_y);
+    if (pixel && pixel->is_valid) {
       best_dist = (grid_x - x - 1) * site_width;
       best_x = x;
       best_y = grid_y;
@@ -1169,7 +1379,8 @@ bool Opendp::moveHopeless(const Cell* cell, int& grid_x, int& grid_y) const
     }
   }
   for (int x = grid_x + 1; x < layer_site_count; ++x) {  // right
-    if (grid_[grid_index][grid_y][x].is_valid) {
+    const Pixel* pixel = gridPixel(grid_index, x, grid_y);
+    if (pixel && pixel->is_valid) {
       const int dist = (x - grid_x) * site_width - cell->width_;
       if (dist < best_dist) {
         best_dist = dist;
@@ -1180,7 +1391,8 @@ bool Opendp::moveHopeless(const Cell* cell, int& grid_x, int& grid_y) const
     }
   }
   for (int y = grid_y - 1; y >= 0; --y) {  // below
-    if (grid_[grid_index][y][grid_x].is_valid) {
+    const Pixel* pixel = gridPixel(grid_index, grid_x, y);
+    if (pixel && pixel->is_valid) {
       const int dist = (grid_y - y - 1) * row_height;
       if (dist < best_dist) {
         best_dist = dist;
@@ -1191,7 +1403,8 @@ bool Opendp::moveHopeless(const Cell* cell, int& grid_x, int& grid_y) const
     }
   }
   for (int y = grid_y + 1; y < layer_row_count; ++y) {  // above
-    if (grid_[grid_index][y][grid_x].is_valid) {
+    const Pixel* pixel = gridPixel(grid_index, grid_x, y);
+    if (pixel && pixel->is_valid) {
       const int dist = (y - grid_y) * row_height - cell->height_;
       if (dist < best_dist) {
         best_dist = dist;
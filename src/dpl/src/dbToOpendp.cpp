@@ -78,6 +78,7 @@ void Opendp::importClear()
   groups_.clear();
   db_inst_map_.clear();
   deleteGrid();
+  incremental_ready_ = false;
   have_multi_row_cells_ = false;
 }
 
@@ -150,7 +151,6 @@ void Opendp::examineRows()
 void Opendp::makeCells()
 {
   auto db_insts = block_->getInsts();
-  cells_.reserve(db_insts.size());
   for (auto db_inst : db_insts) {
     dbMaster* db_master = db_inst->getMaster();
     if (db_master->isCoreAutoPlaceable()) {
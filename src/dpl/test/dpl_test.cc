@@ -2,6 +2,7 @@
 
 #include <memory>
 
+#include "dpl/IncrementalHpwl.h"
 #include "dpl/Opendp.h"
 #include "gtest/gtest.h"
 #include "odb/db.h"
@@ -59,4 +60,44 @@ TEST_F(OpendpTest, IsPlaced)
   ASSERT_TRUE(Opendp::isPlaced(&placed));
 }
 
+TEST(IncrementalHpwlTest, MoveAndCommit)
+{
+  IncrementalHpwl<int> hpwl;
+  const int net = hpwl.addNet();
+  const int pin1 = hpwl.addPin(net, 0, 0);
+  const int pin2 = hpwl.addPin(net, 10, 5);
+  hpwl.addPin(net, 10, 0);
+  EXPECT_EQ(hpwl.hpwl(net), 15);
+
+  // Growing the box.
+  EXPECT_EQ(hpwl.delta({{pin1, -5, 0}}), 5);
+  // Another pin still holds the right edge.
+  EXPECT_EQ(hpwl.delta({{pin2, 2, 5}}), 0);
+  // The only pin on the top edge moves inward.
+  EXPECT_EQ(hpwl.delta({{pin2, 10, 1}}), -4);
+  // Queries leave the boxes alone.
+  EXPECT_EQ(hpwl.hpwl(net), 15);
+
+  hpwl.commit({{pin1, 4, 3}, {pin2, 6, 1}});
+  EXPECT_EQ(hpwl.xMin(net), 4);
+  EXPECT_EQ(hpwl.xMax(net), 10);
+  EXPECT_EQ(hpwl.yMin(net), 0);
+  EXPECT_EQ(hpwl.yMax(net), 3);
+  EXPECT_EQ(hpwl.hpwl(net), 9);
+}
+
+TEST(IncrementalHpwlTest, Swap)
+{
+  IncrementalHpwl<double> hpwl;
+  const int net1 = hpwl.addNet();
+  const int net2 = hpwl.addNet();
+  const int pin1 = hpwl.addPin(net1, 0.5, 0);
+  hpwl.addPin(net1, 20, 0);
+  const int pin2 = hpwl.addPin(net2, 10, 0);
+  hpwl.addPin(net2, 0, 0);
+
+  // Swapping the two pins shortens both nets.
+  EXPECT_DOUBLE_EQ(hpwl.delta({{pin1, 10, 0}, {pin2, 0.5, 0}}), -19.0);
+}
+
 }  // namespace dpl
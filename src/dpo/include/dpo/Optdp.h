@@ -80,6 +80,7 @@ class Optdp
                         int max_displacement_x,
                         int max_displacement_y,
                         bool disallow_one_site_gaps = false);
+  void setNumThreads(int threads) { num_threads_ = threads; }
 
  private:
   void import();
@@ -119,6 +120,7 @@ class Optdp
 
   int64_t hpwlBefore_ = 0;
   int64_t hpwlAfter_ = 0;
+  int num_threads_ = 1;
 };
 
 }  // namespace dpo
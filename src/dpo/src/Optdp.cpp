@@ -110,6 +110,7 @@ void Optdp::improvePlacement(int seed,
     mgr.setSeed(seed);
     mgr.setMaxDisplacement(max_displacement_x, max_displacement_y);
     mgr.setDisallowOneSiteGaps(disallow_one_site_gaps);
+    mgr.setNumThreads(num_threads_);
 
     // Legalization.  Doesn't particularly do much.  It only
     // populates the data structures required for detailed
@@ -53,6 +53,12 @@
         seed, max_displacement_x, max_displacement_y, disallow_one_site_gaps);
   }
 
+  void set_num_threads(int threads)
+  {
+    dpo::Optdp* optdp = ord::OpenRoad::openRoad()->getOptdp();
+    optdp->setNumThreads(threads);
+  }
+
   }  // namespace dpo
 
 %}  // inline
@@ -65,6 +65,7 @@ proc improve_placement { args } {
   }
   
   sta::check_argc_eq0 "improve_placement" $args
+  dpo::set_num_threads [ord::thread_count]
   dpo::improve_placement_cmd $seed $max_displacement_x $max_displacement_y $disallow_one_site_gaps
 }
 
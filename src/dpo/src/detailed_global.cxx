@@ -188,6 +188,7 @@ void DetailedGlobalSwap::globalSwap()
 
     if (nextHpwl <= currHpwl) {
       mgr_->acceptMove();
+      hpwlObj.accept();
       currHpwl = nextHpwl;
     } else {
       mgr_->rejectMove();
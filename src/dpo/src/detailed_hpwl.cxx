@@ -70,6 +70,37 @@ void DetailedHPWL::init()
   traversal_ = 0;
   edgeMask_.resize(network_->getNumEdges());
   std::fill(edgeMask_.begin(), edgeMask_.end(), traversal_);
+
+  netBoxes_ = dpl::IncrementalHpwl<double>();
+  pinIndex_.clear();
+  for (int i = 0; i < network_->getNumEdges(); i++) {
+    const Edge* edi = network_->getEdge(i);
+
+    const int npins = edi->getNumPins();
+    if (npins <= 1 || npins >= skipNetsLargerThanThis_) {
+      continue;
+    }
+    const int net = netBoxes_.addNet();
+    for (const Pin* pinj : edi->getPins()) {
+      pinIndex_[pinj] = netBoxes_.addPin(net, pinX(pinj), pinY(pinj));
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+double DetailedHPWL::pinX(const Pin* pin) const
+{
+  const Node* nd = pin->getNode();
+  return nd->getLeft() + 0.5 * nd->getWidth() + pin->getOffsetX();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+double DetailedHPWL::pinY(const Pin* pin) const
+{
+  const Node* nd = pin->getNode();
+  return nd->getBottom() + 0.5 * nd->getHeight() + pin->getOffsetY();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -126,91 +157,25 @@ double DetailedHPWL::delta(const int n,
   // Given a list of nodes with their old positions and new positions, compute
   // the change in WL. Note that we need to know the orientation information and
   // might need to adjust pin information...
+  //
+  // Only the pins of the moved nodes are visited; the net boxes answer for
+  // the other pins.  The boxes are in step with curLeft/curBottom since they
+  // are updated when moves are accepted.
 
-  double x, y;
-  double old_wl = 0.;
-  double new_wl = 0.;
-  Rectangle old_box, new_box;
-
-  // Put cells into their "old positions and orientations".
-  for (int i = 0; i < n; i++) {
-    nodes[i]->setLeft(curLeft[i]);
-    nodes[i]->setBottom(curBottom[i]);
-    if (orientPtr_ != nullptr) {
-      orientPtr_->orientAdjust(nodes[i], curOri[i]);
-    }
-  }
-
-  ++traversal_;
+  // Find the pin locations at the "new positions and orientations".
+  moves_.clear();
   for (int i = 0; i < n; i++) {
     Node* ndi = nodes[i];
-    for (Pin* pini : ndi->getPins()) {
-      Edge* edi = pini->getEdge();
-
-      int npins = edi->getNumPins();
-      if (npins <= 1 || npins >= skipNetsLargerThanThis_) {
-        continue;
-      }
-      if (edgeMask_[edi->getId()] == traversal_) {
-        continue;
-      }
-      edgeMask_[edi->getId()] = traversal_;
-
-      old_box.reset();
-      for (int pj = 0; pj < edi->getNumPins(); pj++) {
-        Pin* pinj = edi->getPins()[pj];
-
-        Node* curr = pinj->getNode();
-
-        x = curr->getLeft() + 0.5 * curr->getWidth() + pinj->getOffsetX();
-        y = curr->getBottom() + 0.5 * curr->getHeight() + pinj->getOffsetY();
-
-        old_box.addPt(x, y);
-      }
-
-      old_wl += (old_box.getWidth() + old_box.getHeight());
-    }
-  }
-
-  // Put cells into their "new positions and orientations".
-  for (int i = 0; i < n; i++) {
-    nodes[i]->setLeft(newLeft[i]);
-    nodes[i]->setBottom(newBottom[i]);
+    ndi->setLeft(newLeft[i]);
+    ndi->setBottom(newBottom[i]);
     if (orientPtr_ != nullptr) {
-      orientPtr_->orientAdjust(nodes[i], newOri[i]);
+      orientPtr_->orientAdjust(ndi, newOri[i]);
     }
-  }
-
-  ++traversal_;
-  for (int i = 0; i < n; i++) {
-    Node* ndi = nodes[i];
-    for (int pi = 0; pi < ndi->getNumPins(); pi++) {
-      Pin* pini = ndi->getPins()[pi];
-
-      Edge* edi = pini->getEdge();
-
-      int npins = edi->getNumPins();
-      if (npins <= 1 || npins >= skipNetsLargerThanThis_) {
-        continue;
-      }
-      if (edgeMask_[edi->getId()] == traversal_) {
-        continue;
+    for (const Pin* pini : ndi->getPins()) {
+      auto it = pinIndex_.find(pini);
+      if (it != pinIndex_.end()) {
+        moves_.push_back({it->second, pinX(pini), pinY(pini)});
       }
-      edgeMask_[edi->getId()] = traversal_;
-
-      new_box.reset();
-      for (int pj = 0; pj < edi->getNumPins(); pj++) {
-        Pin* pinj = edi->getPins()[pj];
-
-        Node* curr = pinj->getNode();
-
-        x = curr->getLeft() + 0.5 * curr->getWidth() + pinj->getOffsetX();
-        y = curr->getBottom() + 0.5 * curr->getHeight() + pinj->getOffsetY();
-
-        new_box.addPt(x, y);
-      }
-
-      new_wl += (new_box.getWidth() + new_box.getHeight());
     }
   }
 
@@ -225,7 +190,14 @@ double DetailedHPWL::delta(const int n,
   }
 
   // +ve means improvement.
-  return old_wl - new_wl;
+  return -netBoxes_.delta(moves_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+void DetailedHPWL::accept()
+{
+  netBoxes_.commit(moves_);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -39,9 +39,11 @@
 ////////////////////////////////////////////////////////////////////////////////
 // Includes.
 ////////////////////////////////////////////////////////////////////////////////
+#include <unordered_map>
 #include <vector>
 
 #include "detailed_objective.h"
+#include "dpl/IncrementalHpwl.h"
 
 namespace dpo {
 
@@ -75,6 +77,7 @@ class DetailedHPWL : public DetailedObjective
                const std::vector<int>& newLeft,
                const std::vector<int>& newBottom,
                const std::vector<unsigned>& newOri) override;
+  void accept() override;
 
   void getCandidates(std::vector<Node*>& candidates);
 
@@ -92,6 +95,9 @@ class DetailedHPWL : public DetailedObjective
   ////////////////////////////////////////////////////////////////////////////////
 
  private:
+  double pinX(const Pin* pin) const;
+  double pinY(const Pin* pin) const;
+
   Network* network_;
 
   DetailedMgr* mgrPtr_;
@@ -101,6 +107,11 @@ class DetailedHPWL : public DetailedObjective
   int skipNetsLargerThanThis_;
   int traversal_;
   std::vector<int> edgeMask_;
+
+  // Boxes of the nets that are costed, kept in step with accepted moves.
+  dpl::IncrementalHpwl<double> netBoxes_;
+  std::unordered_map<const Pin*, int> pinIndex_;
+  std::vector<dpl::IncrementalHpwl<double>::Move> moves_;
 };
 
 }  // namespace dpo
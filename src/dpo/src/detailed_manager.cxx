@@ -84,6 +84,8 @@ DetailedMgr::DetailedMgr(Architecture* arch,
   // Utilization...
   targetUt_ = 1.0;
 
+  numThreads_ = 1;
+
   // For generating a move list...
   moveLimit_ = 100;
   nMoved_ = 0;
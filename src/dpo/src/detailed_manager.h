@@ -98,6 +98,8 @@ class DetailedMgr
   int getMaxDisplacementX() const { return maxDispX_; }
   int getMaxDisplacementY() const { return maxDispY_; }
   bool getDisallowOneSiteGaps() const { return disallowOneSiteGaps_; }
+  void setNumThreads(int numThreads) { numThreads_ = numThreads; }
+  int getNumThreads() const { return numThreads_; }
   double measureMaximumDisplacement(double& maxX,
                                     double& maxY,
                                     int& violatedX,
@@ -359,6 +361,7 @@ class DetailedMgr
   int maxDispX_;
   int maxDispY_;
   bool disallowOneSiteGaps_;
+  int numThreads_;
   std::vector<Node*> fixedCells_;  // Fixed; filler, macros, temporary, etc.
 
   // Blockages and segments.
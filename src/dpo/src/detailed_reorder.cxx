@@ -34,6 +34,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "detailed_reorder.h"
 
+#include <omp.h>
+
 #include <boost/tokenizer.hpp>
 
 #include "architecture.h"
@@ -53,8 +55,8 @@ DetailedReorderer::DetailedReorderer(Architecture* arch, Network* network)
       network_(network),
       mgrPtr_(nullptr),
       skipNetsLargerThanThis_(100),
-      traversal_(0),
-      windowSize_(3)
+      windowSize_(3),
+      windowRows_(10)
 {
 }
 
@@ -106,7 +108,11 @@ void DetailedReorderer::run(DetailedMgr* mgrPtr,
   for (int p = 1; p <= passes; p++) {
     const double last_hpwl = curr_hpwl;
 
-    reorder();
+    if (mgrPtr_->getNumThreads() > 1) {
+      reorderWindows();
+    } else {
+      reorder();
+    }
 
     curr_hpwl = Utility::hpwl(network_, hpwl_x, hpwl_y);
 
@@ -136,61 +142,110 @@ void DetailedReorderer::run(DetailedMgr* mgrPtr,
 ///////////////////////////////////////////////////////////////////////////////
 void DetailedReorderer::reorder()
 {
-  traversal_ = 0;
-  edgeMask_.resize(network_->getNumEdges());
-  std::fill(edgeMask_.begin(), edgeMask_.end(), traversal_);
+  CostState state;
+  state.edgeMask.resize(network_->getNumEdges(), state.traversal);
 
   // Loop over each segment; find single height cells and reorder.
   for (int s = 0; s < mgrPtr_->getNumSegments(); s++) {
-    DetailedSeg* segPtr = mgrPtr_->getSegment(s);
-    const int segId = segPtr->getSegId();
-    const int rowId = segPtr->getRowId();
+    reorder(mgrPtr_->getSegment(s), state);
+  }
+}
 
-    const std::vector<Node*>& nodes = mgrPtr_->getCellsInSeg(segId);
-    if (nodes.size() < 2) {
-      continue;
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+void DetailedReorderer::reorderWindows()
+{
+  // Windows are bands of rows.  Every other band is optimized concurrently
+  // so that windows running together are never adjacent.  A window sees the
+  // cells of other windows where they were when its color class started,
+  // which keeps the result independent of the thread count.
+  const int numWindows = (arch_->getNumRows() + windowRows_ - 1) / windowRows_;
+  std::vector<std::vector<DetailedSeg*>> segsInWindow(numWindows);
+  nodeWindow_.assign(network_->getNumNodes(), -1);
+  for (int s = 0; s < mgrPtr_->getNumSegments(); s++) {
+    DetailedSeg* segPtr = mgrPtr_->getSegment(s);
+    const int w = segPtr->getRowId() / windowRows_;
+    segsInWindow[w].push_back(segPtr);
+    for (const Node* ndi : mgrPtr_->getCellsInSeg(segPtr->getSegId())) {
+      if (arch_->isSingleHeightCell(ndi)) {
+        nodeWindow_[ndi->getId()] = w;
+      }
     }
-    mgrPtr_->sortCellsInSeg(segId);
+  }
 
-    int j = 0;
-    const int n = (int) nodes.size();
-    while (j < n) {
-      while (j < n && arch_->isMultiHeightCell(nodes[j])) {
-        ++j;
-      }
-      const int jstrt = j;
-      while (j < n && arch_->isSingleHeightCell(nodes[j])) {
-        ++j;
+  const int numThreads = mgrPtr_->getNumThreads();
+  std::vector<CostState> states(numThreads);
+  for (CostState& state : states) {
+    state.edgeMask.resize(network_->getNumEdges(), state.traversal);
+  }
+  windowLeft_.resize(network_->getNumNodes());
+  for (int color = 0; color < 2; color++) {
+    for (int i = 0; i < network_->getNumNodes(); i++) {
+      windowLeft_[i] = network_->getNode(i)->getLeft();
+    }
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic)
+    for (int w = color; w < numWindows; w += 2) {
+      CostState& state = states[omp_get_thread_num()];
+      state.window = w;
+      for (DetailedSeg* segPtr : segsInWindow[w]) {
+        reorder(segPtr, state);
       }
-      const int jstop = j - 1;
-
-      // Single height cells in [jstrt,jstop].
-      for (int i = jstrt; i + windowSize_ <= jstop; ++i) {
-        int istrt = i;
-        const int istop = std::min(jstop, istrt + windowSize_ - 1);
-        if (istop == jstop) {
-          istrt = std::max(jstrt, istop - windowSize_ + 1);
-        }
+    }
+  }
+}
 
-        const Node* nextPtr = (istop != n - 1) ? nodes[istop + 1] : nullptr;
-        int rightLimit = segPtr->getMaxX();
-        if (nextPtr != nullptr) {
-          int leftPadding, rightPadding;
-          arch_->getCellPadding(nextPtr, leftPadding, rightPadding);
-          rightLimit = std::min(
-              (int) std::floor(nextPtr->getLeft() - leftPadding), rightLimit);
-        }
-        const Node* prevPtr = (istrt != 0) ? nodes[istrt - 1] : nullptr;
-        int leftLimit = segPtr->getMinX();
-        if (prevPtr != nullptr) {
-          int leftPadding, rightPadding;
-          arch_->getCellPadding(prevPtr, leftPadding, rightPadding);
-          leftLimit = std::max(
-              (int) std::ceil(prevPtr->getRight() + rightPadding), leftLimit);
-        }
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+void DetailedReorderer::reorder(DetailedSeg* segPtr, CostState& state)
+{
+  const int segId = segPtr->getSegId();
+  const int rowId = segPtr->getRowId();
+
+  const std::vector<Node*>& nodes = mgrPtr_->getCellsInSeg(segId);
+  if (nodes.size() < 2) {
+    return;
+  }
+  mgrPtr_->sortCellsInSeg(segId);
+
+  int j = 0;
+  const int n = (int) nodes.size();
+  while (j < n) {
+    while (j < n && arch_->isMultiHeightCell(nodes[j])) {
+      ++j;
+    }
+    const int jstrt = j;
+    while (j < n && arch_->isSingleHeightCell(nodes[j])) {
+      ++j;
+    }
+    const int jstop = j - 1;
+
+    // Single height cells in [jstrt,jstop].
+    for (int i = jstrt; i + windowSize_ <= jstop; ++i) {
+      int istrt = i;
+      const int istop = std::min(jstop, istrt + windowSize_ - 1);
+      if (istop == jstop) {
+        istrt = std::max(jstrt, istop - windowSize_ + 1);
+      }
 
-        reorder(nodes, istrt, istop, leftLimit, rightLimit, segId, rowId);
+      const Node* nextPtr = (istop != n - 1) ? nodes[istop + 1] : nullptr;
+      int rightLimit = segPtr->getMaxX();
+      if (nextPtr != nullptr) {
+        int leftPadding, rightPadding;
+        arch_->getCellPadding(nextPtr, leftPadding, rightPadding);
+        rightLimit = std::min(
+            (int) std::floor(nextPtr->getLeft() - leftPadding), rightLimit);
       }
+      const Node* prevPtr = (istrt != 0) ? nodes[istrt - 1] : nullptr;
+      int leftLimit = segPtr->getMinX();
+      if (prevPtr != nullptr) {
+        int leftPadding, rightPadding;
+        arch_->getCellPadding(prevPtr, leftPadding, rightPadding);
+        leftLimit = std::max(
+            (int) std::ceil(prevPtr->getRight() + rightPadding), leftLimit);
+      }
+
+      reorder(
+          nodes, istrt, istop, leftLimit, rightLimit, segId, rowId, state);
     }
   }
 }
@@ -203,7 +258,8 @@ void DetailedReorderer::reorder(const std::vector<Node*>& nodes,
                                 int leftLimit,
                                 int rightLimit,
                                 int segId,
-                                int rowId)
+                                int rowId,
+                                CostState& state)
 {
   const int size = jstop - jstrt + 1;
 
@@ -267,7 +323,7 @@ void DetailedReorderer::reorder(const std::vector<Node*>& nodes,
   // might be different.  So, just consider the first permutation
   // like all the others.
 
-  double bestCost = cost(nodes, jstrt, jstop);
+  double bestCost = cost(nodes, jstrt, jstop, state);
   const double origCost = bestCost;
 
   std::vector<int> bestPosn(size, 0);  // Current positions.
@@ -296,7 +352,7 @@ void DetailedReorderer::reorder(const std::vector<Node*>& nodes,
       }
     }
     if (dispOkay) {
-      const double currCost = cost(nodes, jstrt, jstop);
+      const double currCost = cost(nodes, jstrt, jstop, state);
       if (currCost < bestCost) {
         bestPosn = currPosn;
         bestCost = currCost;
@@ -354,7 +410,7 @@ void DetailedReorderer::reorder(const std::vector<Node*>& nodes,
       // interval.  However, we might have shifted something.
       if (shifted) {
         // Recost.  The shifting might have changed the cost.
-        const double lastCost = cost(nodes, jstrt, jstop);
+        const double lastCost = cost(nodes, jstrt, jstop, state);
         if (lastCost >= origCost) {
           failed = true;
         }
@@ -376,11 +432,12 @@ void DetailedReorderer::reorder(const std::vector<Node*>& nodes,
 ////////////////////////////////////////////////////////////////////////////////
 double DetailedReorderer::cost(const std::vector<Node*>& nodes,
                                int istrt,
-                               int istop)
+                               int istop,
+                               CostState& state)
 {
   // Compute hpwl for the specified sequence of cells.
 
-  ++traversal_;
+  ++state.traversal;
 
   double cost = 0.;
   for (int i = istrt; i <= istop; i++) {
@@ -395,10 +452,10 @@ double DetailedReorderer::cost(const std::vector<Node*>& nodes,
       if (npins <= 1 || npins >= skipNetsLargerThanThis_) {
         continue;
       }
-      if (edgeMask_[edi->getId()] == traversal_) {
+      if (state.edgeMask[edi->getId()] == state.traversal) {
         continue;
       }
-      edgeMask_[edi->getId()] = traversal_;
+      state.edgeMask[edi->getId()] = state.traversal;
 
       double xmin = std::numeric_limits<double>::max();
       double xmax = -std::numeric_limits<double>::max();
@@ -407,8 +464,11 @@ double DetailedReorderer::cost(const std::vector<Node*>& nodes,
 
         const Node* ndj = pinj->getNode();
 
-        const double x
-            = ndj->getLeft() + 0.5 * ndj->getWidth() + pinj->getOffsetX();
+        const int left
+            = (state.window < 0 || nodeWindow_[ndj->getId()] == state.window)
+                  ? ndj->getLeft()
+                  : windowLeft_[ndj->getId()];
+        const double x = left + 0.5 * ndj->getWidth() + pinj->getOffsetX();
 
         xmin = std::min(xmin, x);
         xmax = std::max(xmax, x);
@@ -54,15 +54,30 @@ class DetailedReorderer
   void run(DetailedMgr* mgrPtr, const std::vector<std::string>& args);
 
  private:
+  // Per thread state for costing.
+  struct CostState
+  {
+    std::vector<int> edgeMask;
+    int traversal = 0;
+    // Window being optimized or -1 if not windowed.
+    int window = -1;
+  };
+
   void reorder();
+  void reorderWindows();
+  void reorder(DetailedSeg* segPtr, CostState& state);
   void reorder(const std::vector<Node*>& nodes,
                int jstrt,
                int jstop,
                int leftLimit,
                int rightLimit,
                int segId,
-               int rowId);
-  double cost(const std::vector<Node*>& nodes, int istrt, int istop);
+               int rowId,
+               CostState& state);
+  double cost(const std::vector<Node*>& nodes,
+              int istrt,
+              int istop,
+              CostState& state);
 
   // Standard stuff.
   Architecture* arch_;
@@ -73,9 +88,12 @@ class DetailedReorderer
 
   // Other.
   int skipNetsLargerThanThis_;
-  std::vector<int> edgeMask_;
-  int traversal_;
   int windowSize_;
+
+  // For windowed reordering.
+  int windowRows_;
+  std::vector<int> nodeWindow_;
+  std::vector<int> windowLeft_;
 };
 
 }  // namespace dpo
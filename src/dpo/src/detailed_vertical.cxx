@@ -193,6 +193,7 @@ void DetailedVerticalSwap::verticalSwap()
 
     if (nextHpwl <= currHpwl) {
       mgr_->acceptMove();
+      hpwlObj.accept();
 
       currHpwl = nextHpwl;
     } else {
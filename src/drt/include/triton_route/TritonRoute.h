@@ -36,10 +36,12 @@
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "odb/geom.h"
+#include "utl/MemoryUsage.h"
 namespace fr {
 class frDesign;
 class DesignCallBack;
@@ -50,6 +52,7 @@ struct frDebugSettings;
 class FlexDR;
 struct FlexDRViaData;
 class frMarker;
+class frNet;
 }  // namespace fr
 
 namespace odb {
@@ -95,6 +98,9 @@ struct ParamStruct
   int minAccessPoints = -1;
   bool saveGuideUpdates = false;
   std::string repairPDNLayerName;
+  std::string pinAccessCacheFile;
+  std::string drouteCheckpointFile;
+  std::string drouteResumeFile;
 };
 
 class TritonRoute
@@ -179,13 +185,22 @@ class TritonRoute
   void reportDRC(const std::string& file_name,
                  const std::list<std::unique_ptr<fr::frMarker>>& markers,
                  odb::Rect bbox = odb::Rect(0, 0, 0, 0));
-  void checkDRC(const char* drc_file, int x0, int y0, int x1, int y1);
+  // When net_names is non-empty only violations involving those nets are
+  // reported and only the regions around them are checked (ECO checking).
+  void checkDRC(const char* drc_file,
+                int x0,
+                int y0,
+                int x1,
+                int y1,
+                const std::vector<std::string>& net_names = {});
   bool initGuide();
   void prep();
   void processBTermsAboveTopLayer(bool has_routing = false);
 
  private:
   std::unique_ptr<fr::frDesign> design_;
+  // Estimated size of the routed design, see reportMemory.
+  utl::MemoryCharge design_memory_;
   std::unique_ptr<fr::frDebugSettings> debug_;
   std::unique_ptr<fr::DesignCallBack> db_callback_;
   odb::dbDatabase* db_;
@@ -209,9 +224,12 @@ class TritonRoute
   void gr();
   void ta();
   void dr();
+  // route object counts and region query size after a phase (verbose > 1)
+  void reportMemory(const char* phase);
   void applyUpdates(const std::vector<std::vector<fr::drUpdate>>& updates);
   void getDRCMarkers(std::list<std::unique_ptr<fr::frMarker>>& markers,
-                     const odb::Rect& requiredDrcBox);
+                     const odb::Rect& requiredDrcBox,
+                     const std::set<fr::frNet*>& dirtyNets = {});
   void stackVias(odb::dbBTerm* bterm,
                  int top_layer_idx,
                  int bterm_bottom_layer_idx,
@@ -34,6 +34,7 @@
 #include <iostream>
 
 #include "DesignCallBack.h"
+#include "db/infra/frTime.h"
 #include "db/tech/frTechObject.h"
 #include "distributed/PinAccessJobDescription.h"
 #include "distributed/RoutingCallBack.h"
@@ -576,6 +577,47 @@ void TritonRoute::gr()
   gr.main(db_);
 }
 
+static utl::MemoryCounter design_memory_counter("drt__design");
+
+void TritonRoute::reportMemory(const char* phase)
+{
+  // list node plus the object itself
+  constexpr size_t node = 3 * sizeof(void*);
+  auto topBlock = design_->getTopBlock();
+  size_t numWires = 0;
+  size_t numVias = 0;
+  size_t numGuides = 0;
+  size_t bytes = topBlock->getNets().size() * sizeof(frNet);
+  for (auto& net : topBlock->getNets()) {
+    numWires += net->getShapes().size() + net->getPatchWires().size();
+    numVias += net->getVias().size();
+    numGuides += net->getGuides().size();
+    bytes += net->getShapes().size() * (node + sizeof(frPathSeg));
+    bytes += net->getPatchWires().size() * (node + sizeof(frPatchWire));
+    bytes += net->getVias().size() * (node + sizeof(frVia));
+    bytes += net->getGuides().size() * (sizeof(void*) + sizeof(frGuide));
+  }
+  const size_t numMarkers = topBlock->getMarkers().size();
+  bytes += numMarkers * (node + sizeof(frMarker));
+  design_memory_.set(design_memory_counter, bytes);
+  if (VERBOSE <= 1) {
+    return;
+  }
+  logger_->info(DRT,
+                343,
+                "{} memory: {} nets, {} wires, {} vias, {} guides, {} markers "
+                "~{:.1f} MB, rss {:.1f} MB.",
+                phase,
+                topBlock->getNets().size(),
+                numWires,
+                numVias,
+                numGuides,
+                numMarkers,
+                bytes / (1024.0 * 1024.0),
+                getCurrentRSS() / (1024.0 * 1024.0));
+  design_->getRegionQuery()->printMemory();
+}
+
 void TritonRoute::ta()
 {
   FlexTA ta(getDesign(), logger_, distributed_);
@@ -876,12 +918,15 @@ int TritonRoute::main()
     parser.postProcessGuide();
   }
   prep();
+  reportMemory("PA");
   ta();
+  reportMemory("TA");
   if (distributed_) {
     asio::post(dist_pool_,
                boost::bind(&TritonRoute::sendDesignUpdates, this, ""));
   }
   dr();
+  reportMemory("DR");
   if (!SINGLE_STEP_DR) {
     endFR();
   }
@@ -919,9 +964,44 @@ void TritonRoute::pinAccess(std::vector<odb::dbInst*> target_insts)
 }
 
 void TritonRoute::getDRCMarkers(frList<std::unique_ptr<frMarker>>& markers,
-                                const Rect& requiredDrcBox)
+                                const Rect& requiredDrcBox,
+                                const std::set<frNet*>& dirtyNets)
 {
   MAX_THREADS = ord::OpenRoad::openRoad()->getThreadCount();
+  // regions touched by the dirty nets, bloated by the interaction distance
+  std::vector<Rect> dirtyBoxes;
+  std::set<frBlockObject*> dirtyOwners;
+  for (frNet* net : dirtyNets) {
+    dirtyOwners.insert(net);
+    auto addBox = [&dirtyBoxes](const Rect& box) {
+      Rect bloated;
+      box.bloat(DRCSAFEDIST, bloated);
+      dirtyBoxes.push_back(bloated);
+    };
+    for (auto& shape : net->getShapes()) {
+      addBox(shape->getBBox());
+    }
+    for (auto& via : net->getVias()) {
+      addBox(via->getBBox());
+    }
+    for (auto& pwire : net->getPatchWires()) {
+      addBox(pwire->getBBox());
+    }
+    for (auto instTerm : net->getInstTerms()) {
+      addBox(instTerm->getBBox(false));
+    }
+    for (auto bterm : net->getBTerms()) {
+      addBox(bterm->getBBox());
+    }
+  }
+  auto touchesDirtyBox = [&dirtyBoxes](const Rect& box) {
+    for (const Rect& dirtyBox : dirtyBoxes) {
+      if (dirtyBox.intersects(box)) {
+        return true;
+      }
+    }
+    return false;
+  };
   std::vector<std::vector<std::unique_ptr<FlexGCWorker>>> workersBatches(1);
   auto size = 7;
   auto offset = 0;
@@ -944,10 +1024,13 @@ void TritonRoute::getDRCMarkers(frList<std::unique_ptr<frMarker>>& markers,
       routeBox.bloat(MTSAFEDIST, extBox);
       if (!drcBox.intersects(requiredDrcBox))
         continue;
+      if (!dirtyNets.empty() && !touchesDirtyBox(drcBox))
+        continue;
       auto gcWorker
           = std::make_unique<FlexGCWorker>(design_->getTech(), logger_);
       gcWorker->setDrcBox(drcBox);
       gcWorker->setExtBox(extBox);
+      gcWorker->setDirtyOwners(dirtyOwners);
       if (workersBatches.back().size() >= BATCHSIZE)
         workersBatches.push_back(std::vector<std::unique_ptr<FlexGCWorker>>());
       workersBatches.back().push_back(std::move(gcWorker));
@@ -991,7 +1074,12 @@ void TritonRoute::getDRCMarkers(frList<std::unique_ptr<frMarker>>& markers,
   }
 }
 
-void TritonRoute::checkDRC(const char* filename, int x1, int y1, int x2, int y2)
+void TritonRoute::checkDRC(const char* filename,
+                           int x1,
+                           int y1,
+                           int x2,
+                           int y2,
+                           const std::vector<std::string>& net_names)
 {
   GC_IGNORE_PDN_LAYER = -1;
   initDesign();
@@ -1002,8 +1090,16 @@ void TritonRoute::checkDRC(const char* filename, int x1, int y1, int x2, int y2)
   if (requiredDrcBox.area() == 0) {
     requiredDrcBox = design_->getTopBlock()->getBBox();
   }
+  std::set<frNet*> dirtyNets;
+  for (const std::string& name : net_names) {
+    frNet* net = design_->getTopBlock()->findNet(name);
+    if (net == nullptr) {
+      logger_->error(DRT, 618, "Net {} not found.", name);
+    }
+    dirtyNets.insert(net);
+  }
   frList<std::unique_ptr<frMarker>> markers;
-  getDRCMarkers(markers, requiredDrcBox);
+  getDRCMarkers(markers, requiredDrcBox, dirtyNets);
   reportDRC(filename, markers, requiredDrcBox);
 }
 
@@ -1218,6 +1314,9 @@ void TritonRoute::setParams(const ParamStruct& params)
   }
   SAVE_GUIDE_UPDATES = params.saveGuideUpdates;
   REPAIR_PDN_LAYER_NAME = params.repairPDNLayerName;
+  PA_CACHE_FILE = params.pinAccessCacheFile;
+  DR_CHECKPOINT_FILE = params.drouteCheckpointFile;
+  DR_RESUME_FILE = params.drouteResumeFile;
 }
 
 void TritonRoute::addWorkerResults(
@@ -36,6 +36,7 @@
 %{
 
 #include <cstring>
+#include <sstream>
 #include "ord/OpenRoad.hh"
 #include "triton_route/TritonRoute.h"
 #include "utl/Logger.h"
@@ -95,7 +96,10 @@ void detailed_route_cmd(const char* outputMazeFile,
                         int minAccessPoints,
                         bool saveGuideUpdates,
                         const char* repairPDNLayerName,
-                        int drcReportIterStep)
+                        int drcReportIterStep,
+                        const char* pinAccessCacheFile,
+                        const char* drouteCheckpointFile,
+                        const char* drouteResumeFile)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
   std::optional<int> drcReportIterStepOpt;
@@ -122,7 +126,10 @@ void detailed_route_cmd(const char* outputMazeFile,
                     singleStepDR,
                     minAccessPoints,
                     saveGuideUpdates,
-                    repairPDNLayerName});
+                    repairPDNLayerName,
+                    pinAccessCacheFile,
+                    drouteCheckpointFile,
+                    drouteResumeFile});
   router->main();
   router->setDistributed(false);
 }
@@ -131,7 +138,8 @@ void pin_access_cmd(const char* dbProcessNode,
                     const char* bottomRoutingLayer,
                     const char* topRoutingLayer,
                     int verbose,
-                    int minAccessPoints)
+                    int minAccessPoints,
+                    const char* pinAccessCacheFile)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
   triton_route::ParamStruct params;
@@ -140,6 +148,7 @@ void pin_access_cmd(const char* dbProcessNode,
   params.topRoutingLayer = topRoutingLayer;
   params.verbose = verbose;
   params.minAccessPoints = minAccessPoints;
+  params.pinAccessCacheFile = pinAccessCacheFile;
   router->setParams(params);
   router->pinAccess();
   router->setDistributed(false);
@@ -234,9 +243,20 @@ void step_end()
   router->endFR();
 }
 
-void check_drc_cmd(const char* drc_file, int x1, int y1, int x2, int y2)
+void check_drc_cmd(const char* drc_file,
+                   int x1,
+                   int y1,
+                   int x2,
+                   int y2,
+                   const char* net_names)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
-  router->checkDRC(drc_file, x1, y1, x2, y2);
+  std::vector<std::string> names;
+  std::istringstream stream(net_names);
+  std::string name;
+  while (stream >> name) {
+    names.push_back(name);
+  }
+  router->checkDRC(drc_file, x1, y1, x2, y2, names);
 }
 %} // inline
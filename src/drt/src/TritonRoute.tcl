@@ -59,6 +59,9 @@ sta::define_cmd_args "detailed_route" {
     [-min_access_points count]
     [-save_guide_updates]
     [-repair_pdn_vias layer]
+    [-pin_access_cache filename]
+    [-droute_checkpoint filename]
+    [-droute_resume filename]
 }
 
 proc detailed_route { args } {
@@ -67,7 +70,8 @@ proc detailed_route { args } {
       -db_process_node -droute_end_iter -via_in_pin_bottom_layer \
       -via_in_pin_top_layer -or_seed -or_k -bottom_routing_layer \
       -top_routing_layer -verbose -remote_host -remote_port -shared_volume \
-      -cloud_size -min_access_points -repair_pdn_vias -drc_report_iter_step} \
+      -cloud_size -min_access_points -repair_pdn_vias -drc_report_iter_step \
+      -pin_access_cache -droute_checkpoint -droute_resume} \
     flags {-disable_via_gen -distributed -clean_patches -no_pin_access -single_step_dr -save_guide_updates}
   sta::check_argc_eq0 "detailed_route" $args
 
@@ -84,6 +88,21 @@ proc detailed_route { args } {
   } else {
     set repair_pdn_vias ""
   }
+  if { [info exists keys(-pin_access_cache)] } {
+    set pin_access_cache $keys(-pin_access_cache)
+  } else {
+    set pin_access_cache ""
+  }
+  if { [info exists keys(-droute_checkpoint)] } {
+    set droute_checkpoint $keys(-droute_checkpoint)
+  } else {
+    set droute_checkpoint ""
+  }
+  if { [info exists keys(-droute_resume)] } {
+    set droute_resume $keys(-droute_resume)
+  } else {
+    set droute_resume ""
+  }
   if { [info exists keys(-output_maze)] } {
     set output_maze $keys(-output_maze)
   } else {
@@ -195,7 +214,8 @@ proc detailed_route { args } {
     $via_in_pin_bottom_layer $via_in_pin_top_layer \
     $or_seed $or_k $bottom_routing_layer $top_routing_layer $verbose \
     $clean_patches $no_pin_access $single_step_dr $min_access_points \
-    $save_guide_updates $repair_pdn_vias $drc_report_iter_step
+    $save_guide_updates $repair_pdn_vias $drc_report_iter_step \
+    $pin_access_cache $droute_checkpoint $droute_resume
 }
 
 proc detailed_route_num_drvs { args } {
@@ -290,11 +310,13 @@ sta::define_cmd_args "pin_access" {
     [-remote_port rport]
     [-shared_volume vol]
     [-cloud_size sz]
+    [-pin_access_cache filename]
 }
 proc pin_access { args } {
   sta::parse_key_args "pin_access" args \
       keys {-db_process_node -bottom_routing_layer -top_routing_layer -verbose \
-            -min_access_points -remote_host -remote_port -shared_volume -cloud_size } \
+            -min_access_points -remote_host -remote_port -shared_volume -cloud_size \
+            -pin_access_cache } \
       flags {-distributed}
   sta::check_argc_eq0 "detailed_route_debug" $args
   if [info exists keys(-db_process_node)] {
@@ -324,6 +346,11 @@ proc pin_access { args } {
   } else {
     set min_access_points -1
   }
+  if { [info exists keys(-pin_access_cache)] } {
+    set pin_access_cache $keys(-pin_access_cache)
+  } else {
+    set pin_access_cache ""
+  }
   if { [info exists flags(-distributed)] } {
     if { [info exists keys(-remote_host)] } {
       set rhost $keys(-remote_host)
@@ -347,7 +374,7 @@ proc pin_access { args } {
     }
     drt::detailed_route_distributed $rhost $rport $vol $cloudsz
   }
-  drt::pin_access_cmd $db_process_node $bottom_routing_layer $top_routing_layer $verbose $min_access_points
+  drt::pin_access_cmd $db_process_node $bottom_routing_layer $top_routing_layer $verbose $min_access_points $pin_access_cache
 }
 
 sta::define_cmd_args "detailed_route_run_worker" {
@@ -463,10 +490,11 @@ proc step_dr { args } {
 sta::define_cmd_args "check_drc" {
     [-box box]
     [-output_file filename]
+    [-nets nets]
 }
 proc check_drc { args } {
   sta::parse_key_args "check_drc" args \
-      keys { -box -output_file } \
+      keys { -box -output_file -nets } \
       flags {}
   sta::check_argc_eq0 "check_drc" $args
   set box { 0 0 0 0 }
@@ -482,7 +510,17 @@ proc check_drc { args } {
   } else {
     utl::error DRT 613 "-output_file is required for check_drc command"
   }
-  drt::check_drc_cmd $output_file $x1 $y1 $x2 $y2
+  set net_names {}
+  if { [info exists keys(-nets)] } {
+    set block [ord::get_db_block]
+    foreach net_name $keys(-nets) {
+      if { [$block findNet $net_name] == "NULL" } {
+        utl::error DRT 614 "Net $net_name not found."
+      }
+      lappend net_names $net_name
+    }
+  }
+  drt::check_drc_cmd $output_file $x1 $y1 $x2 $y2 [join $net_names " "]
 }
 
 }
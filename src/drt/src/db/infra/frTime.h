@@ -33,9 +33,10 @@
 #include <iostream>
 
 #include "frBaseTypes.h"
+#include "utl/MemoryUsage.h"
 
-extern size_t getPeakRSS();
-extern size_t getCurrentRSS();
+using utl::getCurrentRSS;
+using utl::getPeakRSS;
 
 namespace fr {
 class frTime
@@ -216,6 +216,9 @@ class RoutingCallBack : public dst::JobCallBack
     dist_->sendResult(result, sock);
     sock.close();
   }
+  void onPartitionJobReceived(dst::JobMessage& msg, dst::socket& sock) override
+  {
+  }
 
  private:
   void sendResult(std::vector<std::pair<int, std::string>> results,
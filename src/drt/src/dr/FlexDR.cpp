@@ -32,14 +32,22 @@
 #include <omp.h>
 #include <stdio.h>
 
-#include <boost/archive/text_iarchive.hpp>
-#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <algorithm>
+#include <atomic>
 #include <boost/io/ios_state.hpp>
 #include <chrono>
 #include <fstream>
+#include <functional>
 #include <iomanip>
+#include <limits>
 #include <numeric>
+#include <queue>
+#include <shared_mutex>
 #include <sstream>
+#include <stdexcept>
+#include <tuple>
 
 #include "db/infra/frTime.h"
 #include "distributed/RoutingJobDescription.h"
@@ -54,6 +62,7 @@
 #include "ord/OpenRoad.hh"
 #include "serialization.h"
 #include "utl/exception.h"
+#include "zlib.h"
 
 using namespace std;
 using namespace fr;
@@ -68,6 +77,47 @@ enum class SerializationType
   WRITE
 };
 
+// Worker archives are very repetitive so they are stored zlib compressed,
+// prefixed by their uncompressed size.  This cuts the bytes sent to and
+// received from remote workers severalfold.
+static std::string compressArchive(const std::string& str)
+{
+  const uint64_t size = str.size();
+  uLongf len = compressBound(str.size());
+  std::string out(sizeof(size) + len, '\0');
+  memcpy(out.data(), &size, sizeof(size));
+  if (compress2(reinterpret_cast<Bytef*>(out.data()) + sizeof(size),
+                &len,
+                reinterpret_cast<const Bytef*>(str.data()),
+                str.size(),
+                Z_BEST_SPEED)
+      != Z_OK) {
+    throw std::runtime_error("Failed to compress worker archive");
+  }
+  out.resize(sizeof(size) + len);
+  return out;
+}
+
+static std::string decompressArchive(const std::string& str)
+{
+  uint64_t size = 0;
+  if (str.size() < sizeof(size)) {
+    throw std::runtime_error("Truncated worker archive");
+  }
+  memcpy(&size, str.data(), sizeof(size));
+  std::string out(size, '\0');
+  uLongf len = size;
+  if (uncompress(reinterpret_cast<Bytef*>(out.data()),
+                 &len,
+                 reinterpret_cast<const Bytef*>(str.data()) + sizeof(size),
+                 str.size() - sizeof(size))
+          != Z_OK
+      || len != size) {
+    throw std::runtime_error("Failed to decompress worker archive");
+  }
+  return out;
+}
+
 void serializeWorker(FlexDRWorker* worker, std::string& workerStr)
 {
   std::stringstream stream(std::ios_base::binary | std::ios_base::in
@@ -75,7 +125,7 @@ void serializeWorker(FlexDRWorker* worker, std::string& workerStr)
   frOArchive ar(stream);
   registerTypes(ar);
   ar << *worker;
-  workerStr = stream.str();
+  workerStr = compressArchive(stream.str());
 }
 
 void deserializeWorker(FlexDRWorker* worker,
@@ -83,7 +133,7 @@ void deserializeWorker(FlexDRWorker* worker,
                        const std::string& workerStr)
 {
   std::stringstream stream(
-      workerStr,
+      decompressArchive(workerStr),
       std::ios_base::binary | std::ios_base::in | std::ios_base::out);
   frIArchive ar(stream);
   ar.setDesign(design);
@@ -174,6 +224,10 @@ int FlexDRWorker::main(frDesign* design)
                     routeBox_.xMax() * micronPerDBU,
                     routeBox_.yMax() * micronPerDBU);
   }
+  std::shared_lock<std::shared_mutex> design_lock;
+  if (design_lock_) {
+    design_lock = std::shared_lock<std::shared_mutex>(*design_lock_);
+  }
   initMarkers(design);
   if (getDRIter() && getInitNumMarkers() == 0 && !needRecheck_) {
     skipRouting_ = true;
@@ -208,6 +262,9 @@ int FlexDRWorker::main(frDesign* design)
   if (!skipRouting_) {
     init(design);
   }
+  if (design_lock.owns_lock()) {
+    design_lock.unlock();
+  }
   high_resolution_clock::time_point t1 = high_resolution_clock::now();
   if (!skipRouting_) {
     route_queue();
@@ -292,12 +349,12 @@ void FlexDR::initGCell2BoundaryPin()
   auto gCellPatterns = topBlock->getGCellPatterns();
   auto& xgp = gCellPatterns.at(0);
   auto& ygp = gCellPatterns.at(1);
-  auto tmpVec
-      = vector<map<frNet*, set<pair<Point, frLayerNum>>, frBlockObjectComp>>(
-          (int) ygp.getCount());
-  gcell2BoundaryPin_ = vector<
-      vector<map<frNet*, set<pair<Point, frLayerNum>>, frBlockObjectComp>>>(
-      (int) xgp.getCount(), tmpVec);
+  const int ycount = ygp.getCount();
+  const int numGCells = (int) xgp.getCount() * ycount;
+  boundaryPins_.clear();
+  auto addPin = [&](int x, int y, frNet* net, Point pt, frLayerNum lNum) {
+    boundaryPins_.push_back({x * ycount + y, lNum, net, pt});
+  };
   for (auto& net : topBlock->getNets()) {
     auto netPtr = net.get();
     for (auto& guide : net->getGuides()) {
@@ -328,11 +385,11 @@ void FlexDR::initGCell2BoundaryPin()
               const bool hasRightBound = ep.x() >= rightBound;
               if (hasLeftBound) {
                 Point boundaryPt(leftBound, bp.y());
-                gcell2BoundaryPin_[x][y][netPtr].emplace(boundaryPt, layerNum);
+                addPin(x, y, netPtr, boundaryPt, layerNum);
               }
               if (hasRightBound) {
                 Point boundaryPt(rightBound, ep.y());
-                gcell2BoundaryPin_[x][y][netPtr].emplace(boundaryPt, layerNum);
+                addPin(x, y, netPtr, boundaryPt, layerNum);
               }
             }
           } else if (bp.x() == ep.x()) {
@@ -347,11 +404,11 @@ void FlexDR::initGCell2BoundaryPin()
               const bool hasTopBound = ep.y() >= topBound;
               if (hasBottomBound) {
                 Point boundaryPt(bp.x(), bottomBound);
-                gcell2BoundaryPin_[x][y][netPtr].emplace(boundaryPt, layerNum);
+                addPin(x, y, netPtr, boundaryPt, layerNum);
               }
               if (hasTopBound) {
                 Point boundaryPt(ep.x(), topBound);
-                gcell2BoundaryPin_[x][y][netPtr].emplace(boundaryPt, layerNum);
+                addPin(x, y, netPtr, boundaryPt, layerNum);
               }
             }
           } else {
@@ -361,6 +418,32 @@ void FlexDR::initGCell2BoundaryPin()
       }
     }
   }
+
+  auto key = [](const BoundaryPin& pin) {
+    return std::make_tuple(
+        pin.gcell, pin.net->getId(), pin.pt.x(), pin.pt.y(), pin.layerNum);
+  };
+  std::sort(boundaryPins_.begin(),
+            boundaryPins_.end(),
+            [&key](const BoundaryPin& a, const BoundaryPin& b) {
+              return key(a) < key(b);
+            });
+  boundaryPins_.erase(
+      std::unique(boundaryPins_.begin(),
+                  boundaryPins_.end(),
+                  [&key](const BoundaryPin& a, const BoundaryPin& b) {
+                    return key(a) == key(b);
+                  }),
+      boundaryPins_.end());
+  boundaryPins_.shrink_to_fit();
+
+  gcell2BoundaryPinStart_.assign(numGCells + 1, 0);
+  for (const auto& pin : boundaryPins_) {
+    gcell2BoundaryPinStart_[pin.gcell + 1]++;
+  }
+  std::partial_sum(gcell2BoundaryPinStart_.begin(),
+                   gcell2BoundaryPinStart_.end(),
+                   gcell2BoundaryPinStart_.begin());
 }
 
 void FlexDR::init_halfViaEncArea()
@@ -412,8 +495,10 @@ void FlexDR::init()
 
 void FlexDR::removeGCell2BoundaryPin()
 {
-  gcell2BoundaryPin_.clear();
-  gcell2BoundaryPin_.shrink_to_fit();
+  boundaryPins_.clear();
+  boundaryPins_.shrink_to_fit();
+  gcell2BoundaryPinStart_.clear();
+  gcell2BoundaryPinStart_.shrink_to_fit();
 }
 
 map<frNet*, set<pair<Point, frLayerNum>>, frBlockObjectComp>
@@ -428,13 +513,14 @@ FlexDR::initDR_mergeBoundaryPin(int startX,
   auto& ygp = gCellPatterns.at(1);
   for (int i = startX; i < (int) xgp.getCount() && i < startX + size; i++) {
     for (int j = startY; j < (int) ygp.getCount() && j < startY + size; j++) {
-      auto& currBp = gcell2BoundaryPin_[i][j];
-      for (auto& [net, s] : currBp) {
-        for (auto& [pt, lNum] : s) {
-          if (pt.x() == routeBox.xMin() || pt.x() == routeBox.xMax()
-              || pt.y() == routeBox.yMin() || pt.y() == routeBox.yMax()) {
-            bp[net].emplace(pt, lNum);
-          }
+      const int gcell = i * (int) ygp.getCount() + j;
+      for (int k = gcell2BoundaryPinStart_[gcell];
+           k < gcell2BoundaryPinStart_[gcell + 1];
+           k++) {
+        const auto& [idx, lNum, net, pt] = boundaryPins_[k];
+        if (pt.x() == routeBox.xMin() || pt.x() == routeBox.xMax()
+            || pt.y() == routeBox.yMin() || pt.y() == routeBox.yMax()) {
+          bp[net].emplace(pt, lNum);
         }
       }
     }
@@ -448,6 +534,128 @@ void FlexDR::getBatchInfo(int& batchStepX, int& batchStepY)
   batchStepY = 2;
 }
 
+// Workers are run in the given order except that a worker only waits for
+// the earlier workers near enough to touch its region. Each one commits
+// as soon as it is done, so there is no barrier between checkerboard
+// batches.
+void FlexDR::runWorkers(vector<unique_ptr<FlexDRWorker>>& workers,
+                        const std::function<void()>& onCommit)
+{
+  ProfileTask profile("DR:runWorkers");
+  const int numWorkers = workers.size();
+  if (numWorkers == 0) {
+    return;
+  }
+
+  // Bucket the workers by extension box so only nearby ones are compared.
+  int cellSize = 1;
+  Point origin(std::numeric_limits<int>::max(),
+               std::numeric_limits<int>::max());
+  for (auto& worker : workers) {
+    const Rect& extBox = worker->getExtBox();
+    cellSize = max({cellSize, extBox.dx(), extBox.dy()});
+    origin = Point(min(origin.x(), extBox.xMin()),
+                   min(origin.y(), extBox.yMin()));
+  }
+  map<pair<int, int>, vector<int>> buckets;
+  for (int i = 0; i < numWorkers; i++) {
+    const Rect& extBox = workers[i]->getExtBox();
+    buckets[{(extBox.xMin() - origin.x()) / cellSize,
+             (extBox.yMin() - origin.y()) / cellSize}]
+        .push_back(i);
+  }
+
+  // A worker depends on the earlier workers whose extension boxes come
+  // within MTSAFEDIST of its own.
+  vector<vector<int>> successors(numWorkers);
+  vector<std::atomic<int>> pending(numWorkers);
+  for (int i = 0; i < numWorkers; i++) {
+    Rect safeBox;
+    workers[i]->getExtBox().bloat(MTSAFEDIST, safeBox);
+    const int xLo = (safeBox.xMin() - cellSize - origin.x()) / cellSize;
+    const int yLo = (safeBox.yMin() - cellSize - origin.y()) / cellSize;
+    const int xHi = (safeBox.xMax() - origin.x()) / cellSize;
+    const int yHi = (safeBox.yMax() - origin.y()) / cellSize;
+    int numDeps = 0;
+    for (int x = xLo; x <= xHi; x++) {
+      for (int y = yLo; y <= yHi; y++) {
+        auto it = buckets.find({x, y});
+        if (it == buckets.end()) {
+          continue;
+        }
+        for (const int j : it->second) {
+          if (j < i && workers[j]->getExtBox().intersects(safeBox)) {
+            successors[j].push_back(i);
+            numDeps++;
+          }
+        }
+      }
+    }
+    pending[i] = numDeps;
+  }
+
+  using std::chrono::duration;
+  using std::chrono::steady_clock;
+  const auto start = steady_clock::now();
+  std::atomic<int64_t> busyNanos(0);
+
+  std::shared_mutex designLock;
+  ThreadException exception;
+  std::function<void(int)> runWorker = [&](int i) {
+    auto& worker = workers[i];
+    try {
+      if (!exception.hasException()) {
+        const auto workerStart = steady_clock::now();
+        worker->setDesignLock(&designLock);
+        worker->main(getDesign());
+        worker->prepareEnd();
+        {
+          ProfileTask profile("DR:commit");
+          std::unique_lock<std::shared_mutex> lock(designLock);
+          if (worker->end(getDesign())) {
+            numWorkUnits_ += 1;
+          }
+          if (worker->isCongested()) {
+            increaseClipsize_ = true;
+          }
+          onCommit();
+        }
+        busyNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         steady_clock::now() - workerStart)
+                         .count();
+      }
+    } catch (...) {
+      exception.capture();
+    }
+    worker.reset();
+    for (const int succ : successors[i]) {
+      if (--pending[succ] == 0) {
+#pragma omp task firstprivate(succ)
+        runWorker(succ);
+      }
+    }
+  };
+
+#pragma omp parallel
+#pragma omp single
+  for (int i = 0; i < numWorkers; i++) {
+    if (pending[i] == 0) {
+#pragma omp task firstprivate(i)
+      runWorker(i);
+    }
+  }
+  exception.rethrow();
+
+  const duration<double> wall = steady_clock::now() - start;
+  const double capacity = wall.count() * 1e9 * omp_get_max_threads();
+  debugPrint(logger_,
+             utl::DRT,
+             "workers",
+             1,
+             "Worker thread utilization = {:.1f}%.",
+             capacity > 0 ? 100.0 * busyNanos / capacity : 0.0);
+}
+
 void FlexDR::searchRepair(const SearchRepairArgs& args)
 {
   const int iter = iter_++;
@@ -564,10 +772,41 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
     xIdx++;
   }
 
+  auto reportProgress = [&]() {
+    cnt++;
+    if (VERBOSE > 0) {
+      if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1 && prev_perc < 90) {
+        if (prev_perc == 0 && t.isExceed(0)) {
+          isExceed = true;
+        }
+        prev_perc += 10;
+        if (isExceed) {
+          logger_->report("    Completing {}% with {} violations.",
+                          prev_perc,
+                          getDesign()->getTopBlock()->getNumMarkers());
+          logger_->report("    {}.", t);
+        }
+      }
+    }
+  };
+
   omp_set_num_threads(MAX_THREADS);
   int version = 0;
   increaseClipsize_ = false;
   numWorkUnits_ = 0;
+  if (!dist_on_) {
+    // The checkerboard order is kept only between overlapping workers.
+    vector<unique_ptr<FlexDRWorker>> orderedWorkers;
+    for (auto& workerBatch : workers) {
+      for (auto& workersInBatch : workerBatch) {
+        for (auto& worker : workersInBatch) {
+          orderedWorkers.push_back(std::move(worker));
+        }
+      }
+    }
+    workers.clear();
+    runWorkers(orderedWorkers, reportProgress);
+  }
   // parallel execution
   for (auto& workerBatch : workers) {
     ProfileTask profile("DR:checkerboard");
@@ -598,41 +837,16 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
               else
                 workersInBatch[i]->main(getDesign());
 #pragma omp critical
-              {
-                cnt++;
-                if (VERBOSE > 0) {
-                  if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1
-                      && prev_perc < 90) {
-                    if (prev_perc == 0 && t.isExceed(0)) {
-                      isExceed = true;
-                    }
-                    prev_perc += 10;
-                    if (isExceed) {
-                      logger_->report(
-                          "    Completing {}% with {} violations.",
-                          prev_perc,
-                          getDesign()->getTopBlock()->getNumMarkers());
-                      logger_->report("    {}.", t);
-                    }
-                  }
-                }
-              }
+              reportProgress();
             } catch (...) {
               exception.capture();
             }
           }
           exception.rethrow();
           if (dist_on_) {
-            int j = 0;
             std::vector<std::vector<std::pair<int, FlexDRWorker*>>>
-                distWorkerBatches(router_->getCloudSize());
-            for (int i = 0; i < workersInBatch.size(); i++) {
-              auto worker = workersInBatch.at(i).get();
-              if (!worker->isSkipRouting()) {
-                distWorkerBatches[j].push_back({i, worker});
-                j = (j + 1) % router_->getCloudSize();
-              }
-            }
+                distWorkerBatches;
+            distributeWorkers(workersInBatch, distWorkerBatches);
             {
               ProfileTask task("DIST: SERIALIZE+SEND");
 #pragma omp parallel for schedule(dynamic)
@@ -657,7 +871,12 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
       }
       {
         ProfileTask profile("DR:end_batch");
-        // single thread
+        // building the objects to commit only touches worker state
+#pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < (int) workersInBatch.size(); i++) {
+          workersInBatch[i]->prepareEnd();
+        }
+        // writing them into the design is single thread
         for (int i = 0; i < (int) workersInBatch.size(); i++) {
           if (workersInBatch[i]->end(getDesign()))
             numWorkUnits_ += 1;
@@ -1106,13 +1325,130 @@ void FlexDR::reportGuideCoverage()
   file.close();
 }
 
+// bump whenever the checkpoint layout changes
+static constexpr int kCheckpointVersion = 1;
+
+void FlexDR::writeCheckpoint(const std::string& file_name) const
+{
+  ProfileTask profile("DR:writeCheckpoint");
+  auto topBlock = getDesign()->getTopBlock();
+  std::vector<std::vector<drUpdate>> updates(1);
+  auto& routes = updates.front();
+  for (auto& net : topBlock->getNets()) {
+    for (auto& shape : net->getShapes()) {
+      drUpdate update(drUpdate::ADD_SHAPE_NET_ONLY);
+      update.setNet(net.get());
+      update.setPathSeg(*static_cast<frPathSeg*>(shape.get()));
+      routes.push_back(update);
+    }
+    for (auto& pwire : net->getPatchWires()) {
+      drUpdate update(drUpdate::ADD_SHAPE_NET_ONLY);
+      update.setNet(net.get());
+      update.setPatchWire(*static_cast<frPatchWire*>(pwire.get()));
+      routes.push_back(update);
+    }
+    for (auto& via : net->getVias()) {
+      drUpdate update(drUpdate::ADD_SHAPE_NET_ONLY);
+      update.setNet(net.get());
+      update.setVia(*via);
+      routes.push_back(update);
+    }
+  }
+  for (auto& marker : topBlock->getMarkers()) {
+    drUpdate update(drUpdate::ADD_SHAPE);
+    update.setMarker(*marker);
+    routes.push_back(update);
+  }
+
+  // write to a temporary file first so an interrupted run never leaves a
+  // truncated checkpoint behind
+  const std::string tmp_name = file_name + ".tmp";
+  std::ofstream file(tmp_name, std::ios::binary);
+  if (!file.good()) {
+    logger_->warn(DRT, 339, "Cannot write checkpoint {}.", file_name);
+    return;
+  }
+  {
+    frOArchive ar(file);
+    registerTypes(ar);
+    int version = kCheckpointVersion;
+    int iter = iter_;
+    int numNets = topBlock->getNets().size();
+    int numSNets = topBlock->getSNets().size();
+    float clipSizeInc = clipSizeInc_;
+    bool increaseClipsize = increaseClipsize_;
+    std::vector<int> numViols = numViols_;
+    ar << version << numNets << numSNets << iter << clipSizeInc
+       << increaseClipsize << numViols << updates;
+  }
+  file.close();
+  std::rename(tmp_name.c_str(), file_name.c_str());
+  debugPrint(logger_,
+             DRT,
+             "checkpoint",
+             1,
+             "Wrote checkpoint {} after iteration {}.",
+             file_name,
+             iter_ - 1);
+}
+
+bool FlexDR::readCheckpoint(const std::string& file_name)
+{
+  ProfileTask profile("DR:readCheckpoint");
+  std::ifstream file(file_name, std::ios::binary);
+  if (!file.good()) {
+    logger_->warn(DRT, 340, "Cannot open checkpoint {}.", file_name);
+    return false;
+  }
+  auto topBlock = getDesign()->getTopBlock();
+  frIArchive ar(file);
+  ar.setDesign(getDesign());
+  registerTypes(ar);
+  int version = 0;
+  int numNets = 0;
+  int numSNets = 0;
+  ar >> version >> numNets >> numSNets;
+  if (version != kCheckpointVersion
+      || numNets != (int) topBlock->getNets().size()
+      || numSNets != (int) topBlock->getSNets().size()) {
+    logger_->warn(DRT,
+                  341,
+                  "Checkpoint {} does not match the current design.",
+                  file_name);
+    return false;
+  }
+  std::vector<std::vector<drUpdate>> updates;
+  ar >> iter_ >> clipSizeInc_ >> increaseClipsize_ >> numViols_ >> updates;
+  file.close();
+
+  router_->applyUpdates(updates);
+  getRegionQuery()->initDRObj();
+  logger_->info(DRT,
+                342,
+                "Resumed detailed routing from checkpoint {} after iteration "
+                "{} with {} violations.",
+                file_name,
+                iter_ - 1,
+                topBlock->getNumMarkers());
+  return true;
+}
+
 int FlexDR::main()
 {
   ProfileTask profile("DR:main");
   init();
   frTime t;
 
+  int resumeIter = 0;
+  if (!DR_RESUME_FILE.empty() && readCheckpoint(DR_RESUME_FILE)) {
+    resumeIter = iter_;
+  }
+
+  int stepIdx = 0;
   for (auto& args : strategy()) {
+    if (stepIdx++ < resumeIter) {
+      continue;
+    }
     int clipSize = args.size;
     if (args.ripupMode != 1) {
       if (increaseClipsize_) {
@@ -1124,6 +1460,9 @@ int FlexDR::main()
     args.size = clipSize;
 
     searchRepair(args);
+    if (!DR_CHECKPOINT_FILE.empty()) {
+      writeCheckpoint(DR_CHECKPOINT_FILE);
+    }
     if (getDesign()->getTopBlock()->getNumMarkers() == 0) {
       break;
     }
@@ -1152,6 +1491,72 @@ int FlexDR::main()
   return 0;
 }
 
+// Rough routing effort of a worker: guides and pins stand in for the nets
+// it has to route, markers left by the previous iteration for its ripup.
+static int64_t estimateWorkerCost(frRegionQuery* regionQuery,
+                                  const FlexDRWorker* worker)
+{
+  std::vector<frGuide*> guides;
+  regionQuery->queryGuide(worker->getRouteBox(), guides);
+  std::vector<frBlockObject*> pins;
+  regionQuery->queryGRPin(worker->getRouteBox(), pins);
+  return 1 + guides.size() + 2 * pins.size()
+         + 20 * (int64_t) worker->getInitNumMarkers();
+}
+
+void FlexDR::distributeWorkers(
+    const std::vector<std::unique_ptr<FlexDRWorker>>& workers,
+    std::vector<std::vector<std::pair<int, FlexDRWorker*>>>& chunks)
+{
+  // Several chunks per remote rank: each chunk is sent by its own request
+  // and the balancer hands it to the least busy rank, so ranks that finish
+  // early pick up the remaining chunks.
+  constexpr int chunks_per_rank = 4;
+  std::vector<std::pair<int64_t, int>> costs;
+  for (int i = 0; i < (int) workers.size(); i++) {
+    if (!workers[i]->isSkipRouting()) {
+      costs.emplace_back(0, i);
+    }
+  }
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < (int) costs.size(); i++) {
+    costs[i].first
+        = estimateWorkerCost(getRegionQuery(), workers[costs[i].second].get());
+  }
+  std::sort(costs.begin(), costs.end(), std::greater<>());
+
+  // longest processing time first onto the least loaded chunk
+  const int num_chunks = std::min<int>(
+      router_->getCloudSize() * chunks_per_rank, costs.size());
+  chunks.clear();
+  chunks.resize(num_chunks);
+  std::vector<int64_t> loads(num_chunks, 0);
+  using Load = std::pair<int64_t, int>;
+  std::priority_queue<Load, std::vector<Load>, std::greater<>> queue;
+  for (int i = 0; i < num_chunks; i++) {
+    queue.emplace(0, i);
+  }
+  for (auto [cost, idx] : costs) {
+    auto [load, chunk] = queue.top();
+    queue.pop();
+    chunks[chunk].emplace_back(idx, workers[idx].get());
+    loads[chunk] = load + cost;
+    queue.emplace(loads[chunk], chunk);
+  }
+  // send the heaviest chunks first
+  std::vector<int> order(num_chunks);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&loads](int a, int b) {
+    return loads[a] > loads[b];
+  });
+  std::vector<std::vector<std::pair<int, FlexDRWorker*>>> sorted;
+  sorted.reserve(num_chunks);
+  for (int chunk : order) {
+    sorted.push_back(std::move(chunks[chunk]));
+  }
+  chunks.swap(sorted);
+}
+
 void FlexDR::sendWorkers(
     const std::vector<std::pair<int, FlexDRWorker*>>& remote_batch,
     std::vector<std::unique_ptr<FlexDRWorker>>& batch)
@@ -1172,6 +1577,7 @@ void FlexDR::sendWorkers(
   if (router_->getCloudSize() > 1) {
     dst::JobMessage msg(dst::JobMessage::BALANCER),
         result(dst::JobMessage::NONE);
+    msg.setJobSize(remote_batch.size());
     bool ok = dist_->sendJob(msg, dist_ip_.c_str(), dist_port_, result);
     if (!ok) {
       logger_->error(utl::DRT, 7461, "Balancer failed");
@@ -33,7 +33,9 @@
 #include <boost/polygon/polygon.hpp>
 #include <boost/serialization/export.hpp>
 #include <deque>
+#include <functional>
 #include <memory>
+#include <shared_mutex>
 
 #include "db/drObj/drMarker.h"
 #include "db/drObj/drNet.h"
@@ -132,6 +134,10 @@ class FlexDR
     dist_port_ = remote_port;
     dist_dir_ = dir;
   }
+  // split the workers to route remotely into cost balanced chunks
+  void distributeWorkers(
+      const std::vector<std::unique_ptr<FlexDRWorker>>& workers,
+      std::vector<std::vector<std::pair<int, FlexDRWorker*>>>& chunks);
   void sendWorkers(
       const std::vector<std::pair<int, FlexDRWorker*>>& remote_batch,
       std::vector<std::unique_ptr<FlexDRWorker>>& batch);
@@ -139,14 +145,28 @@ class FlexDR
   void reportGuideCoverage();
 
  private:
+  // the routing state and markers after an iteration; on resume the
+  // strategy restarts at the following iteration
+  void writeCheckpoint(const std::string& file_name) const;
+  bool readCheckpoint(const std::string& file_name);
+
   triton_route::TritonRoute* router_;
   frDesign* design_;
   Logger* logger_;
   odb::dbDatabase* db_;
-  std::vector<std::vector<std::map<frNet*,
-                                   std::set<std::pair<Point, frLayerNum>>,
-                                   frBlockObjectComp>>>
-      gcell2BoundaryPin_;
+  // Points where the TA routes of a net cross the boundary of a gcell, only
+  // needed by the first iteration.  Stored as one flat vector sorted by
+  // gcell (x * ycount + y) with per gcell offsets, as per gcell maps of
+  // sets cost several times the memory on large designs.
+  struct BoundaryPin
+  {
+    int gcell;
+    frLayerNum layerNum;
+    frNet* net;
+    Point pt;
+  };
+  std::vector<BoundaryPin> boundaryPins_;
+  std::vector<int> gcell2BoundaryPinStart_;
 
   FlexDRViaData via_data_;
   std::vector<int> numViols_;
@@ -169,6 +189,8 @@ class FlexDR
   void initFromTA();
   void initGCell2BoundaryPin();
   void getBatchInfo(int& batchStepX, int& batchStepY);
+  void runWorkers(std::vector<std::unique_ptr<FlexDRWorker>>& workers,
+                  const std::function<void()>& onCommit);
 
   void init_halfViaEncArea();
 
@@ -277,7 +299,10 @@ class FlexDRWorker
         dist_port_(0),
         dist_on_(false),
         isCongested_(false),
-        save_updates_(false)
+        save_updates_(false),
+        design_lock_(nullptr),
+        endPrepared_(false),
+        endWriteBack_(false)
   {
   }
   FlexDRWorker()
@@ -306,7 +331,10 @@ class FlexDRWorker
         dist_port_(0),
         dist_on_(false),
         isCongested_(false),
-        save_updates_(false)
+        save_updates_(false),
+        design_lock_(nullptr),
+        endPrepared_(false),
+        endWriteBack_(false)
   {
   }
   // setters
@@ -396,6 +424,9 @@ class FlexDRWorker
     gridGraph_.setGraphics(in);
   }
   void setViaData(FlexDRViaData* viaData) { via_data_ = viaData; }
+  // Shared while reading the design in main and held exclusively by the
+  // caller of end, so workers can commit while others are routing.
+  void setDesignLock(std::shared_mutex* lock) { design_lock_ = lock; }
   // getters
   frTechObject* getTech() const { return design_->getTech(); }
   void getRouteBox(Rect& boxIn) const { boxIn = routeBox_; }
@@ -442,6 +473,10 @@ class FlexDRWorker
   void distributedMain(frDesign* design);
   void updateDesign(frDesign* design);
   std::string reloadedMain();
+  // Builds the objects end() writes back from worker-local state only, so it
+  // can run concurrently with other workers' commits. end() calls it itself
+  // when it has not been run yet.
+  void prepareEnd();
   bool end(frDesign* design);
 
   Logger* getLogger() { return logger_; }
@@ -544,6 +579,20 @@ class FlexDRWorker
   bool dist_on_;
   bool isCongested_;
   bool save_updates_;
+  std::shared_mutex* design_lock_;
+
+  // end
+  struct EndConnFig
+  {
+    drConnFig* connFig;
+    std::unique_ptr<frShape> shape;  // path seg or patch wire
+    std::unique_ptr<frVia> via;
+  };
+  bool endPrepared_;
+  bool endWriteBack_;
+  std::set<frNet*, frBlockObjectComp> endModNets_;
+  std::vector<EndConnFig> endConnFigs_;
+  std::vector<std::unique_ptr<frMarker>> endMarkers_;
 
   // init
   void init(const frDesign* design);
@@ -1007,9 +1056,16 @@ class FlexDRWorker
                   std::map<frNet*,
                            std::set<std::pair<Point, frLayerNum>>,
                            frBlockObjectComp>& boundPts);
-  void endAddNets_pathSeg(frDesign* design, drPathSeg* pathSeg);
-  void endAddNets_via(frDesign* design, drVia* via);
-  void endAddNets_patchWire(frDesign* design, drPatchWire* pwire);
+  bool endNeedsWriteBack() const;
+  void endAddNets_pathSeg(frDesign* design,
+                          drPathSeg* pathSeg,
+                          std::unique_ptr<frShape> uShape);
+  void endAddNets_via(frDesign* design,
+                      drVia* via,
+                      std::unique_ptr<frVia> uVia);
+  void endAddNets_patchWire(frDesign* design,
+                            drPatchWire* pwire,
+                            std::unique_ptr<frShape> uShape);
   void endAddNets_merge(frDesign* design,
                         frNet* net,
                         std::set<std::pair<Point, frLayerNum>>& boundPts);
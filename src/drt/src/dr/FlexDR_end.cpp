@@ -321,10 +321,11 @@ void FlexDRWorker::endRemoveNets(
   }
 }
 
-void FlexDRWorker::endAddNets_pathSeg(frDesign* design, drPathSeg* pathSeg)
+void FlexDRWorker::endAddNets_pathSeg(frDesign* design,
+                                      drPathSeg* pathSeg,
+                                      unique_ptr<frShape> uShape)
 {
   auto net = pathSeg->getNet()->getFrNet();
-  unique_ptr<frShape> uShape = make_unique<frPathSeg>(*pathSeg);
   auto rptr = uShape.get();
   net->addShape(std::move(uShape));
   design->getRegionQuery()->addDRObj(rptr);
@@ -336,10 +337,11 @@ void FlexDRWorker::endAddNets_pathSeg(frDesign* design, drPathSeg* pathSeg)
   }
 }
 
-void FlexDRWorker::endAddNets_via(frDesign* design, drVia* via)
+void FlexDRWorker::endAddNets_via(frDesign* design,
+                                  drVia* via,
+                                  unique_ptr<frVia> uVia)
 {
   auto net = via->getNet()->getFrNet();
-  unique_ptr<frVia> uVia = make_unique<frVia>(*via);
   auto rptr = uVia.get();
   net->addVia(std::move(uVia));
   design->getRegionQuery()->addDRObj(rptr);
@@ -351,10 +353,11 @@ void FlexDRWorker::endAddNets_via(frDesign* design, drVia* via)
   }
 }
 
-void FlexDRWorker::endAddNets_patchWire(frDesign* design, drPatchWire* pwire)
+void FlexDRWorker::endAddNets_patchWire(frDesign* design,
+                                        drPatchWire* pwire,
+                                        unique_ptr<frShape> uShape)
 {
   auto net = pwire->getNet()->getFrNet();
-  unique_ptr<frShape> uShape = make_unique<frPatchWire>(*pwire);
   auto rptr = uShape.get();
   net->addPatchWire(std::move(uShape));
   design->getRegionQuery()->addDRObj(rptr);
@@ -529,23 +532,19 @@ void FlexDRWorker::endAddNets(
     frDesign* design,
     map<frNet*, set<pair<Point, frLayerNum>>, frBlockObjectComp>& boundPts)
 {
-  for (auto& net : nets_) {
-    if (!net->isModified()) {
-      continue;
-    }
-    for (auto& connFig : net->getBestRouteConnFigs()) {
-      if (connFig->typeId() == drcPathSeg) {
-        endAddNets_pathSeg(
-            design, static_cast<drPathSeg*>(connFig.get()) /*, cutSegs[fNet]*/);
-      } else if (connFig->typeId() == drcVia) {
-        endAddNets_via(design, static_cast<drVia*>(connFig.get()));
-      } else if (connFig->typeId() == drcPatchWire) {
-        endAddNets_patchWire(design, static_cast<drPatchWire*>(connFig.get()));
-      } else {
-        cout << "Error: endAddNets unsupported type" << endl;
-      }
+  for (auto& fig : endConnFigs_) {
+    auto connFig = fig.connFig;
+    if (connFig->typeId() == drcPathSeg) {
+      endAddNets_pathSeg(
+          design, static_cast<drPathSeg*>(connFig), std::move(fig.shape));
+    } else if (connFig->typeId() == drcVia) {
+      endAddNets_via(design, static_cast<drVia*>(connFig), std::move(fig.via));
+    } else {
+      endAddNets_patchWire(
+          design, static_cast<drPatchWire*>(connFig), std::move(fig.shape));
     }
   }
+  endConnFigs_.clear();
   for (auto& [net, bPts] : boundPts) {
     endAddNets_merge(design, net, bPts);
   }
@@ -572,20 +571,17 @@ void FlexDRWorker::endAddMarkers(frDesign* design)
 {
   auto regionQuery = design->getRegionQuery();
   auto topBlock = design->getTopBlock();
-  // for (auto &m: getMarkers()) {
-  for (auto& m : getBestMarkers()) {
-    if (getDrcBox().intersects(m.getBBox())) {
-      auto uptr = make_unique<frMarker>(m);
-      auto ptr = uptr.get();
-      regionQuery->addMarker(ptr);
-      topBlock->addMarker(std::move(uptr));
-      if (save_updates_) {
-        drUpdate update(drUpdate::ADD_SHAPE);
-        update.setMarker(*ptr);
-        design_->addUpdate(update);
-      }
+  for (auto& uptr : endMarkers_) {
+    auto ptr = uptr.get();
+    regionQuery->addMarker(ptr);
+    topBlock->addMarker(std::move(uptr));
+    if (save_updates_) {
+      drUpdate update(drUpdate::ADD_SHAPE);
+      update.setMarker(*ptr);
+      design_->addUpdate(update);
     }
   }
+  endMarkers_.clear();
 }
 
 void FlexDRWorker::cleanup()
@@ -606,7 +602,7 @@ void FlexDRWorker::cleanup()
   specialAccessAPs.clear();
 }
 
-bool FlexDRWorker::end(frDesign* design)
+bool FlexDRWorker::endNeedsWriteBack() const
 {
   if (skipRouting_ == true) {
     return false;
@@ -624,17 +620,64 @@ bool FlexDRWorker::end(frDesign* design)
              && getBestNumMarkers() > 5 * getInitNumMarkers()) {
     return false;
   }
+  return true;
+}
+
+void FlexDRWorker::prepareEnd()
+{
+  if (endPrepared_) {
+    return;
+  }
+  endPrepared_ = true;
+  endWriteBack_ = endNeedsWriteBack();
+  if (!endWriteBack_) {
+    return;
+  }
+  endGetModNets(endModNets_);
+  for (auto& net : nets_) {
+    if (!net->isModified()) {
+      continue;
+    }
+    for (auto& connFig : net->getBestRouteConnFigs()) {
+      EndConnFig fig{connFig.get(), nullptr, nullptr};
+      if (connFig->typeId() == drcPathSeg) {
+        fig.shape
+            = make_unique<frPathSeg>(*static_cast<drPathSeg*>(connFig.get()));
+      } else if (connFig->typeId() == drcVia) {
+        fig.via = make_unique<frVia>(*static_cast<drVia*>(connFig.get()));
+      } else if (connFig->typeId() == drcPatchWire) {
+        fig.shape = make_unique<frPatchWire>(
+            *static_cast<drPatchWire*>(connFig.get()));
+      } else {
+        cout << "Error: endAddNets unsupported type" << endl;
+        continue;
+      }
+      endConnFigs_.push_back(std::move(fig));
+    }
+  }
+  for (auto& m : getBestMarkers()) {
+    if (getDrcBox().intersects(m.getBBox())) {
+      endMarkers_.push_back(make_unique<frMarker>(m));
+    }
+  }
+}
+
+bool FlexDRWorker::end(frDesign* design)
+{
+  prepareEnd();
+  endPrepared_ = false;
+  if (!endWriteBack_) {
+    return false;
+  }
   save_updates_ = dist_on_ || debugSettings_->debugDumpDR;
-  set<frNet*, frBlockObjectComp> modNets;
-  endGetModNets(modNets);
   // get lock
   map<frNet*, set<pair<Point, frLayerNum>>, frBlockObjectComp> boundPts;
-  endRemoveNets(design, modNets, boundPts);
+  endRemoveNets(design, endModNets_, boundPts);
+  endModNets_.clear();
   endAddNets(design, boundPts);  // if two subnets have diff isModified()
                                  // status, then should always write back
   endRemoveMarkers(design);
   endAddMarkers(design);
   return true;
   // release lock
-  return true;
 }
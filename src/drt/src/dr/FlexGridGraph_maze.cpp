@@ -59,6 +59,10 @@ void FlexGridGraph::expand(FlexWavefrontGrid& currGrid,
   getPoint(currPt, gridX, gridY);
   frCoord currDist = Point::manhattanDistance(currPt, centerPt);
 
+  // the same edge length feeds both the vlength and tlength updates below
+  const frCoord edgeLength
+      = getEdgeLength(currGrid.x(), currGrid.y(), currGrid.z(), dir);
+
   // vlength calculation
   frCoord currVLengthX = 0;
   frCoord currVLengthY = 0;
@@ -75,11 +79,9 @@ void FlexGridGraph::expand(FlexWavefrontGrid& currGrid,
     if (currVLengthX != std::numeric_limits<frCoord>::max()
         && currVLengthY != std::numeric_limits<frCoord>::max()) {
       if (dir == frDirEnum::W || dir == frDirEnum::E) {
-        nextVLengthX
-            += getEdgeLength(currGrid.x(), currGrid.y(), currGrid.z(), dir);
+        nextVLengthX += edgeLength;
       } else {
-        nextVLengthY
-            += getEdgeLength(currGrid.x(), currGrid.y(), currGrid.z(), dir);
+        nextVLengthY += edgeLength;
       }
     }
   }
@@ -89,12 +91,12 @@ void FlexGridGraph::expand(FlexWavefrontGrid& currGrid,
   auto nextTLength = currTLength;
   // if there was a turn, then add tlength
   if (currTLength != std::numeric_limits<frCoord>::max()) {
-    nextTLength += getEdgeLength(currGrid.x(), currGrid.y(), currGrid.z(), dir);
+    nextTLength += edgeLength;
   }
   // if current is a turn, then reset tlength
   if (currGrid.getLastDir() != frDirEnum::UNKNOWN
       && currGrid.getLastDir() != dir) {
-    nextTLength = getEdgeLength(currGrid.x(), currGrid.y(), currGrid.z(), dir);
+    nextTLength = edgeLength;
   }
   // if current is a via, then reset tlength
   if (dir == frDirEnum::U || dir == frDirEnum::D) {
@@ -184,8 +186,9 @@ frCost FlexGridGraph::getEstCost(const FlexMazeIdx& src,
   frCoord minCostY
       = max(max(dstPoint1.y() - srcPoint.y(), srcPoint.y() - dstPoint2.y()), 0)
         * 1;
-  frCoord minCostZ = max(max(getZHeight(dstMazeIdx1.z()) - getZHeight(src.z()),
-                             getZHeight(src.z()) - getZHeight(dstMazeIdx2.z())),
+  const frCoord srcZHeight = getZHeight(src.z());
+  frCoord minCostZ = max(max(getZHeight(dstMazeIdx1.z()) - srcZHeight,
+                             srcZHeight - getZHeight(dstMazeIdx2.z())),
                          0)
                      * 1;
 
@@ -32,16 +32,21 @@
 #include <ittnotify.h>
 #endif
 
+#include <string_view>
+
+#include "utl/trace.h"
+
 namespace fr {
 
 #ifdef HAS_VTUNE
 // This class make a VTune task in its scope (RAII).  This is useful
 // in VTune to see where the runtime is going with more domain specific
-// display.
+// display.  The task is also recorded as a utl trace span.
 class ProfileTask
 {
  public:
-  ProfileTask(const char* name) : done_(false)
+  ProfileTask(const char* name)
+      : span_("drt", std::string_view(name)), done_(false)
   {
     domain_ = __itt_domain_create("TritonRoute");
     name_ = __itt_string_handle_create(name);
@@ -60,9 +65,11 @@ class ProfileTask
   {
     done_ = true;
     __itt_task_end(domain_);
+    span_.end();
   }
 
  private:
+  utl::TraceSpan span_;
   __itt_domain* domain_;
   __itt_string_handle* name_;
   bool done_;
@@ -70,12 +77,15 @@ class ProfileTask
 
 #else
 
-// No-op version
+// Trace only version
 class ProfileTask
 {
  public:
-  ProfileTask(const char* name) {}
-  void done() {}
+  ProfileTask(const char* name) : span_("drt", std::string_view(name)) {}
+  void done() { span_.end(); }
+
+ private:
+  utl::TraceSpan span_;
 };
 #endif
 
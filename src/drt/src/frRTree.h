@@ -32,6 +32,7 @@
 #include <boost/geometry/algorithms/equals.hpp>
 #include <boost/geometry/geometries/register/box.hpp>
 #include <boost/geometry/geometries/register/point.hpp>
+#include <boost/geometry/index/detail/rtree/utilities/statistics.hpp>
 
 #include "db/infra/frBox.h"
 #include "db/infra/frPoint.h"
@@ -55,4 +56,39 @@ namespace fr {
 template <typename T, typename Key = Rect>
 using RTree = bgi::rtree<std::pair<Key, T>, bgi::quadratic<16>>;
 
+// For trees that are only ever built by packing (range construction) and
+// then queried.  Wider nodes give a shallower tree and longer contiguous
+// leaf scans; the split algorithm is irrelevant as nothing is inserted.
+template <typename T, typename Key = Rect>
+using PackedRTree = bgi::rtree<std::pair<Key, T>, bgi::linear<32>>;
+
+struct RTreeStats
+{
+  size_t levels = 0;
+  size_t nodes = 0;  // internal nodes
+  size_t leaves = 0;
+  size_t values = 0;
+  size_t bytes = 0;  // approximate
+};
+
+template <typename Tree>
+RTreeStats getRTreeStats(const Tree& tree)
+{
+  RTreeStats stats;
+  if (tree.empty()) {
+    return stats;
+  }
+  const auto st = bgi::detail::rtree::utilities::statistics(tree);
+  stats.levels = boost::get<0>(st);
+  stats.nodes = boost::get<1>(st);
+  stats.leaves = boost::get<2>(st);
+  stats.values = boost::get<3>(st);
+  // boost reserves max_elements + 1 slots per node
+  const size_t slots = tree.parameters().get_max_elements() + 1;
+  using InternalElem = std::pair<typename Tree::bounds_type, void*>;
+  stats.bytes = stats.leaves * slots * sizeof(typename Tree::value_type)
+                + stats.nodes * slots * sizeof(InternalElem);
+  return stats;
+}
+
 }  // namespace fr
@@ -45,6 +45,9 @@ struct frRegionQuery::Impl
   template <typename T>
   using RTreesByLayer = std::vector<RTree<T>>;
 
+  template <typename T>
+  using PackedRTreesByLayer = std::vector<PackedRTree<T>>;
+
   template <typename T>
   using ObjectsByLayer = std::vector<Objects<T>>;
 
@@ -52,10 +55,12 @@ struct frRegionQuery::Impl
   Logger* logger_;
   // only for pin shapes, obs and snet
   RTreesByLayer<frBlockObject*> shapes_;
-  RTreesByLayer<frGuide*> guides_;
-  RTreesByLayer<frNet*> origGuides_;  // non-processed guides;
-  RTree<frBlockObject*> grPins_;
-  RTreesByLayer<frRPin*> rpins_;  // only for rpins
+  // guides, orig guides, gr pins and rpins are packed once and never
+  // updated incrementally
+  PackedRTreesByLayer<frGuide*> guides_;
+  PackedRTreesByLayer<frNet*> origGuides_;  // non-processed guides;
+  PackedRTree<frBlockObject*> grPins_;
+  PackedRTreesByLayer<frRPin*> rpins_;  // only for rpins
   // only for gr objs, via only in via layer
   RTreesByLayer<grBlockObject*> grObjs_;
   // only for dr objs, via only in via layer
@@ -825,7 +830,7 @@ void frRegionQuery::Impl::initOrigGuide(
     }
   }
   for (auto i = 0; i < numLayers; i++) {
-    origGuides_.at(i) = boost::move(RTree<frNet*>(allShapes.at(i)));
+    origGuides_.at(i) = boost::move(PackedRTree<frNet*>(allShapes.at(i)));
     allShapes.at(i).clear();
     allShapes.at(i).shrink_to_fit();
     if (VERBOSE > 0) {
@@ -868,7 +873,7 @@ void frRegionQuery::Impl::initGuide()
     }
   }
   for (auto i = 0; i < numLayers; i++) {
-    guides_.at(i) = boost::move(RTree<frGuide*>(allGuides.at(i)));
+    guides_.at(i) = boost::move(PackedRTree<frGuide*>(allGuides.at(i)));
     allGuides.at(i).clear();
     allGuides.at(i).shrink_to_fit();
     if (VERBOSE > 0) {
@@ -895,7 +900,7 @@ void frRegionQuery::Impl::initGRPin(vector<pair<frBlockObject*, Point>>& in)
   }
   in.clear();
   in.shrink_to_fit();
-  grPins_ = boost::move(RTree<frBlockObject*>(allGRPins));
+  grPins_ = boost::move(PackedRTree<frBlockObject*>(allGRPins));
 }
 
 void frRegionQuery::initRPin()
@@ -918,7 +923,7 @@ void frRegionQuery::Impl::initRPin()
   }
 
   for (auto i = 0; i < numLayers; i++) {
-    rpins_.at(i) = boost::move(RTree<frRPin*>(allRPins.at(i)));
+    rpins_.at(i) = boost::move(PackedRTree<frRPin*>(allRPins.at(i)));
     allRPins.at(i).clear();
     allRPins.at(i).shrink_to_fit();
   }
@@ -1040,6 +1045,59 @@ void frRegionQuery::printDRObj()
   }
 }
 
+namespace {
+
+template <typename Tree>
+void addRTreeStats(const Tree& tree, RTreeStats& total, size_t& trees)
+{
+  const RTreeStats stats = getRTreeStats(tree);
+  total.levels = std::max(total.levels, stats.levels);
+  total.nodes += stats.nodes;
+  total.leaves += stats.leaves;
+  total.values += stats.values;
+  total.bytes += stats.bytes;
+  trees++;
+}
+
+}  // namespace
+
+void frRegionQuery::printMemory()
+{
+  auto report = [this](const char* name, auto&& addTrees) {
+    RTreeStats total;
+    size_t trees = 0;
+    addTrees(total, trees);
+    impl_->logger_->info(
+        DRT,
+        338,
+        "{:<9} region query: {} trees, {} objects, {} nodes, max depth {}, "
+        "~{:.1f} MB.",
+        name,
+        trees,
+        total.values,
+        total.nodes + total.leaves,
+        total.levels,
+        total.bytes / (1024.0 * 1024.0));
+  };
+  auto byLayer = [](const auto& rtrees) {
+    return [&rtrees](RTreeStats& total, size_t& trees) {
+      for (const auto& rtree : rtrees) {
+        addRTreeStats(rtree, total, trees);
+      }
+    };
+  };
+  report("shape", byLayer(impl_->shapes_));
+  report("guide", byLayer(impl_->guides_));
+  report("origGuide", byLayer(impl_->origGuides_));
+  report("grPin", [this](RTreeStats& total, size_t& trees) {
+    addRTreeStats(impl_->grPins_, total, trees);
+  });
+  report("rpin", byLayer(impl_->rpins_));
+  report("grObj", byLayer(impl_->grObjs_));
+  report("drObj", byLayer(impl_->drObjs_));
+  report("marker", byLayer(impl_->markers_));
+}
+
 void frRegionQuery::clearGuides()
 {
   for (auto& m : impl_->guides_) {
@@ -133,6 +133,8 @@ class frRegionQuery
   void printGuide();
   void printDRObj();
   void printGRObj();
+  // per tree class size, depth and approximate memory
+  void printMemory();
 
  private:
   struct Impl;
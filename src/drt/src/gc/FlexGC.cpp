@@ -66,6 +66,7 @@ FlexGCWorker::Impl::Impl(frTechObject* techIn,
       targetNet_(nullptr),
       minLayerNum_(std::numeric_limits<frLayerNum>::min()),
       maxLayerNum_(std::numeric_limits<frLayerNum>::max()),
+      dirtyOwners_(),
       ignoreDB_(false),
       ignoreMinArea_(false),
       ignoreLongSideEOL_(false),
@@ -191,6 +192,11 @@ void FlexGCWorker::setTargetObjs(const std::set<frBlockObject*>& targetObjs)
   impl_->targetObjs_ = targetObjs;
 }
 
+void FlexGCWorker::setDirtyOwners(const std::set<frBlockObject*>& owners)
+{
+  impl_->dirtyOwners_ = owners;
+}
+
 void FlexGCWorker::setIgnoreDB()
 {
   impl_->ignoreDB_ = true;
@@ -55,6 +55,8 @@ class FlexGCWorker
   void resetTargetNet();
   void addTargetObj(frBlockObject* in);
   void setTargetObjs(const std::set<frBlockObject*>& targetObjs);
+  // only check shapes of these owners (eg nets modified by an ECO)
+  void setDirtyOwners(const std::set<frBlockObject*>& owners);
   void setIgnoreDB();
   void setIgnoreMinArea();
   void setIgnoreLongSideEOL();
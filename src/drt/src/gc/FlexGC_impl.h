@@ -159,6 +159,9 @@ class FlexGCWorker::Impl
   gcNet* targetNet_;
   frLayerNum minLayerNum_;
   frLayerNum maxLayerNum_;
+  // incremental (ECO) checking: when non-empty only the shapes of nets with
+  // these owners are checked, the others are only seen as neighbors
+  std::set<frBlockObject*> dirtyOwners_;
 
   // for pin prep
   std::set<frBlockObject*> targetObjs_;
@@ -169,6 +172,11 @@ class FlexGCWorker::Impl
   bool surgicalFixEnabled_;
 
   FlexGCWorkerRegionQuery& getWorkerRegionQuery() { return rq_; }
+  bool isCheckedNet(gcNet* net) const
+  {
+    return dirtyOwners_.empty()
+           || dirtyOwners_.find(net->getOwner()) != dirtyOwners_.end();
+  }
 
   // init
   gcNet* getNet(frBlockObject* obj);
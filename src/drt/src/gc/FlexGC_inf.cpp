@@ -235,10 +235,14 @@ void FlexGCWorker::Impl::checkMetalSpacingTableInfluence()
       }
       if (!currLayer->hasSpacingTableInfluence())
         continue;
-      for (auto& uNet : getNets())
+      for (auto& uNet : getNets()) {
+        if (!isCheckedNet(uNet.get())) {
+          continue;
+        }
         for (auto& pin : uNet.get()->getPins(i)) {
           checkPinMetSpcTblInf(pin.get());
         }
+      }
     }
   }
 }
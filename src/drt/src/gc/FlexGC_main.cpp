@@ -890,6 +890,9 @@ void FlexGCWorker::Impl::checkMetalSpacing()
         continue;
       }
       for (auto& net : getNets()) {
+        if (!isCheckedNet(net.get())) {
+          continue;
+        }
         for (auto& pin : net->getPins(i)) {
           for (auto& maxrect : pin->getMaxRectangles()) {
             // Short, NSMetal, metSpc
@@ -1155,6 +1158,9 @@ void FlexGCWorker::Impl::checkMetalCornerSpacing()
         continue;
       }
       for (auto& net : getNets()) {
+        if (!isCheckedNet(net.get())) {
+          continue;
+        }
         for (auto& pin : net->getPins(i)) {
           for (auto& corners : pin->getPolygonCorners()) {
             for (auto& corner : corners) {
@@ -1975,6 +1981,9 @@ void FlexGCWorker::Impl::checkMetalShape()
         continue;
       }
       for (auto& net : getNets()) {
+        if (!isCheckedNet(net.get())) {
+          continue;
+        }
         for (auto& pin : net->getPins(i)) {
           checkMetalShape_main(pin.get());
         }
@@ -3266,6 +3275,9 @@ void FlexGCWorker::Impl::checkCutSpacing()
         continue;
       }
       for (auto& net : getNets()) {
+        if (!isCheckedNet(net.get())) {
+          continue;
+        }
         for (auto& pin : net->getPins(i)) {
           for (auto& maxrect : pin->getMaxRectangles()) {
             checkCutSpacing_main(maxrect.get());
@@ -3582,6 +3594,9 @@ void FlexGCWorker::Impl::checkMinimumCut()
       if (!currLayer->hasMinimumcut())
         continue;
       for (auto& net : getNets()) {
+        if (!isCheckedNet(net.get())) {
+          continue;
+        }
         for (auto& pin : net->getPins(i)) {
           for (auto& maxrect : pin->getMaxRectangles()) {
             checkMinimumCut_main(maxrect.get());
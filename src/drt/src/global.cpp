@@ -46,6 +46,9 @@ string DRC_RPT_FILE;
 std::optional<int> DRC_RPT_ITER_STEP;
 string CMAP_FILE;
 string GUIDE_REPORT_FILE;
+string PA_CACHE_FILE;
+string DR_CHECKPOINT_FILE;
+string DR_RESUME_FILE;
 
 // to be removed
 int OR_SEED = -1;
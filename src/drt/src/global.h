@@ -42,6 +42,9 @@ extern std::string DRC_RPT_FILE;
 extern std::optional<int> DRC_RPT_ITER_STEP;
 extern std::string CMAP_FILE;
 extern std::string GUIDE_REPORT_FILE;
+extern std::string PA_CACHE_FILE;
+extern std::string DR_CHECKPOINT_FILE;
+extern std::string DR_RESUME_FILE;
 // to be removed
 extern int OR_SEED;
 extern double OR_K;
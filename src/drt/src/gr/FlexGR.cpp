@@ -228,12 +228,54 @@ void FlexGR::searchRepairMacro(int iter,
     uworkers.push_back(std::move(worker));
   }
 
-  // omp_set_num_threads(1);
-  // currently this is not mt-safe
-  for (int i = 0; i < (int) uworkers.size(); i++) {
-    uworkers[i]->initBoundary();
-    uworkers[i]->main_mt();
-    uworkers[i]->end();
+  // Macro workers overlap freely, so they cannot use the checkerboard
+  // batching of searchRepair. Instead, consecutive workers whose gcell
+  // ranges stay at least one gcell apart form a batch; a worker that would
+  // touch an earlier member of the current batch starts a new one. This
+  // keeps the sequential order wherever two workers interact.
+  vector<vector<FlexGRWorker*>> batches;
+  vector<Rect> batchIdxBoxes;
+  for (auto& worker : uworkers) {
+    const Point& idxLL = worker->getRouteGCellIdxLL();
+    const Point& idxUR = worker->getRouteGCellIdxUR();
+    Rect idxBox(idxLL.x() - 1, idxLL.y() - 1, idxUR.x() + 1, idxUR.y() + 1);
+    bool conflict = batches.empty();
+    for (const Rect& box : batchIdxBoxes) {
+      if (box.intersects(idxBox)) {
+        conflict = true;
+        break;
+      }
+    }
+    if (conflict) {
+      batches.emplace_back();
+      batchIdxBoxes.clear();
+    }
+    batches.back().push_back(worker.get());
+    batchIdxBoxes.push_back(idxBox);
+  }
+
+  omp_set_num_threads(MAX_THREADS);
+
+  for (auto& workersInBatch : batches) {
+    // single thread
+    for (auto worker : workersInBatch) {
+      worker->initBoundary();
+    }
+    // multi thread
+    ThreadException exception;
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < (int) workersInBatch.size(); i++) {
+      try {
+        workersInBatch[i]->main_mt();
+      } catch (...) {
+        exception.capture();
+      }
+    }
+    exception.rethrow();
+    // single thread
+    for (auto worker : workersInBatch) {
+      worker->end();
+    }
   }
   uworkers.clear();
 }
@@ -351,8 +393,7 @@ void FlexGR::searchRepair(int iter,
       xIdx++;
     }
 
-    omp_set_num_threads(min(8, MAX_THREADS));
-    // omp_set_num_threads(1);
+    omp_set_num_threads(MAX_THREADS);
 
     // parallel execution
     for (auto& workerBatch : workers) {
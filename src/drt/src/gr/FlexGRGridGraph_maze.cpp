@@ -115,8 +115,9 @@ frCost FlexGRGridGraph::getEstCost(const FlexMazeIdx& src,
       = max(max(dstPoint1.x() - srcPoint.x(), srcPoint.x() - dstPoint2.x()), 0);
   frCoord minCostY
       = max(max(dstPoint1.y() - srcPoint.y(), srcPoint.y() - dstPoint2.y()), 0);
-  frCoord minCostZ = max(max(getZHeight(dstMazeIdx1.z()) - getZHeight(src.z()),
-                             getZHeight(src.z()) - getZHeight(dstMazeIdx2.z())),
+  const frCoord srcZHeight = getZHeight(src.z());
+  frCoord minCostZ = max(max(getZHeight(dstMazeIdx1.z()) - srcZHeight,
+                             srcZHeight - getZHeight(dstMazeIdx2.z())),
                          0);
 
   bendCnt += (minCostX && dir != frDirEnum::UNKNOWN && dir != frDirEnum::E
@@ -391,24 +392,24 @@ frCost FlexGRGridGraph::getNextPathCost(const FlexGRWavefrontGrid& currGrid,
 
   bool histCost = hasHistoryCost(tmpX, tmpY, tmpZ);
 
-  overflowCost = (rawDemand >= rawSupply * grWorker_->getCongThresh());
+  const double congThresh = grWorker_->getCongThresh();
+  overflowCost = (rawDemand >= rawSupply * congThresh);
+
+  // look up the edge length and evaluate the congestion curve once; both
+  // feed several of the terms below
+  const frCoord edgeLength = getEdgeLength(gridX, gridY, gridZ, dir);
+  const double rawCongCost
+      = (congCost || histCost)
+            ? getCongCost(rawDemand, rawSupply * congThresh)
+            : 0;
 
   nextPathCost
-      += getEdgeLength(gridX, gridY, gridZ, dir)
-         + (congCost
-                ? getCongCost(rawDemand, rawSupply * grWorker_->getCongThresh())
-                      * getEdgeLength(gridX, gridY, gridZ, dir)
-                : 0)
-         + (histCost ? 4
-                           * getCongCost(rawDemand,
-                                         rawSupply * grWorker_->getCongThresh())
-                           * getHistoryCost(gridX, gridY, gridZ)
-                           * getEdgeLength(gridX, gridY, gridZ, dir)
+      += edgeLength + (congCost ? rawCongCost * edgeLength : 0)
+         + (histCost ? 4 * rawCongCost * getHistoryCost(gridX, gridY, gridZ)
+                           * edgeLength
                      : 0)
-         + (blockCost
-                ? BLOCKCOST * getEdgeLength(gridX, gridY, gridZ, dir) * 100
-                : 0)
-         + (overflowCost ? 128 * getEdgeLength(gridX, gridY, gridZ, dir) : 0);
+         + (blockCost ? BLOCKCOST * edgeLength * 100 : 0)
+         + (overflowCost ? 128 * edgeLength : 0);
   return nextPathCost;
 }
 
@@ -844,6 +844,9 @@ void io::Parser::postProcessGuide()
   design_->getRegionQuery()->printGuide();
   logger_->info(DRT, 179, "Init gr pin query.");
   design_->getRegionQuery()->initGRPin(tmpGRPins_);
+  if (VERBOSE > 1) {
+    design_->getRegionQuery()->printMemory();
+  }
 
   if (!SAVE_GUIDE_UPDATES) {
     if (VERBOSE > 0) {
@@ -99,6 +99,14 @@ class FlexPA
 
   UniqueInsts unique_insts_;
 
+  // pin access cache (PA_CACHE_FILE)
+  // unique instances whose access points and patterns came from the cache
+  std::vector<bool> uniqueInstCached_;
+  // cache key of each unique instance, empty if it is not cached
+  std::vector<std::string> uniqueInstCacheKeys_;
+  // serialized entries read from the cache that were not used in this run
+  std::map<std::string, std::string> unusedCacheEntries_;
+
   // helper structures
   std::vector<std::map<frCoord, frAccessPointEnum>> trackCoords_;
   std::map<frLayerNum, std::map<int, std::map<ViaRawPriorityTuple, frViaDef*>>>
@@ -119,6 +127,16 @@ class FlexPA
   bool isSkipInstTerm(frInstTerm* in);
   bool isDistributed() const { return !remote_host_.empty(); }
 
+  // cache
+  size_t getCacheTechSignature() const;
+  size_t getCacheMasterSignature(frMaster* master) const;
+  size_t getCacheContextSignature(frInst* inst);
+  std::string getCacheKey(frInst* inst);
+  bool loadCacheEntry(int uniqueInstIdx, const std::string& data);
+  std::string saveCacheEntry(int uniqueInstIdx);
+  void readCache();
+  void writeCache();
+
   // init
   void init();
   void initTrackCoords();
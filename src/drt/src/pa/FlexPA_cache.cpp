@@ -0,0 +1,431 @@
+/*
+ * Copyright (c) 2023, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Persistent cache of the access points and access patterns computed for
+// unique instances.  An entry is keyed by master, orientation, track-offset
+// signature, the master geometry and the placement context of the unique
+// instance (the fixed shapes around it), so reruns on an unchanged
+// placement skip prepPoint/prepPattern for every unique instance and only
+// the instances whose surroundings changed are recomputed.  The whole file
+// is discarded when the tech or the pin access settings change.
+
+#include <omp.h>
+
+#include <boost/functional/hash.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/utility.hpp>
+#include <fstream>
+#include <sstream>
+
+#include "FlexPA.h"
+#include "distributed/frArchive.h"
+#include "frProfileTask.h"
+#include "serialization.h"
+
+namespace fr {
+
+namespace {
+
+// Pins of an instance in a fixed order; cache entries refer to pins by their
+// position in this list.
+std::vector<frMPin*> getCachePins(frInst* inst)
+{
+  std::vector<frMPin*> pins;
+  for (auto& instTerm : inst->getInstTerms()) {
+    for (auto& pin : instTerm->getTerm()->getPins()) {
+      pins.push_back(pin.get());
+    }
+  }
+  return pins;
+}
+
+void hashRect(size_t& seed, const Rect& box, const Point& origin)
+{
+  boost::hash_combine(seed, box.xMin() - origin.x());
+  boost::hash_combine(seed, box.yMin() - origin.y());
+  boost::hash_combine(seed, box.xMax() - origin.x());
+  boost::hash_combine(seed, box.yMax() - origin.y());
+}
+
+// pin index and access point index of each slot of a pattern, {-1, -1} for
+// a pin without access point
+using CachePattern = std::vector<std::pair<int, int>>;
+
+}  // namespace
+
+size_t FlexPA::getCacheTechSignature() const
+{
+  size_t seed = 0;
+  const auto tech = getTech();
+  boost::hash_combine(seed, tech->getDBUPerUU());
+  boost::hash_combine(seed, tech->getManufacturingGrid());
+  for (auto& layer : tech->getLayers()) {
+    boost::hash_combine(seed, layer->getName());
+    boost::hash_combine(seed, layer->getPitch());
+    boost::hash_combine(seed, layer->getWidth());
+  }
+  // access points refer to via defs by id
+  for (auto& viaDef : tech->getVias()) {
+    boost::hash_combine(seed, viaDef->getName());
+  }
+  for (auto tp : getDesign()->getTopBlock()->getTrackPatterns()) {
+    boost::hash_combine(seed, tp->getLayerNum());
+    boost::hash_combine(seed, tp->isHorizontal());
+    boost::hash_combine(seed, tp->getStartCoord());
+    boost::hash_combine(seed, tp->getTrackSpacing());
+  }
+  boost::hash_combine(seed, DBPROCESSNODE);
+  boost::hash_combine(seed, BOTTOM_ROUTING_LAYER);
+  boost::hash_combine(seed, TOP_ROUTING_LAYER);
+  boost::hash_combine(seed, VIAINPIN_BOTTOMLAYERNUM);
+  boost::hash_combine(seed, VIAINPIN_TOPLAYERNUM);
+  boost::hash_combine(seed, MINNUMACCESSPOINT_STDCELLPIN);
+  boost::hash_combine(seed, MINNUMACCESSPOINT_MACROCELLPIN);
+  return seed;
+}
+
+size_t FlexPA::getCacheMasterSignature(frMaster* master) const
+{
+  size_t seed = 0;
+  const Point origin(0, 0);
+  for (auto& boundary : master->getBoundaries()) {
+    hashRect(seed, boundary.getBBox(), origin);
+  }
+  auto hashPin = [&seed, &origin](frPin* pin) {
+    for (auto& fig : pin->getFigs()) {
+      auto shape = static_cast<frShape*>(fig.get());
+      boost::hash_combine(seed, shape->getLayerNum());
+      hashRect(seed, fig->getBBox(), origin);
+    }
+  };
+  for (auto& term : master->getTerms()) {
+    boost::hash_combine(seed, term->getName());
+    for (auto& pin : term->getPins()) {
+      hashPin(pin.get());
+    }
+  }
+  for (auto& blockage : master->getBlockages()) {
+    hashPin(blockage->getPin());
+  }
+  return seed;
+}
+
+size_t FlexPA::getCacheContextSignature(frInst* inst)
+{
+  // covers the extension of the DRC checks done on access points and patterns
+  frCoord halo = 3000;
+  for (auto& layer : getTech()->getLayers()) {
+    halo = std::max(halo, (frCoord) (5 * layer->getPitch()));
+  }
+  Rect queryBox;
+  inst->getBoundaryBBox().bloat(halo, queryBox);
+  const Point origin = inst->getOrigin();
+
+  // the checks only care whether a neighbor is on the same net as one of
+  // the instance's terms
+  std::map<frNet*, int> netIdx;
+  for (auto& instTerm : inst->getInstTerms()) {
+    if (instTerm->getNet()) {
+      netIdx.emplace(instTerm->getNet(), instTerm->getIndexInOwner());
+    }
+  }
+
+  size_t signature = 0;
+  auto regionQuery = getDesign()->getRegionQuery();
+  frRegionQuery::Objects<frBlockObject> result;
+  for (auto layerNum = getTech()->getBottomLayerNum();
+       layerNum <= getTech()->getTopLayerNum();
+       layerNum++) {
+    result.clear();
+    regionQuery->query(queryBox, layerNum, result);
+    for (auto& [box, obj] : result) {
+      frNet* net = nullptr;
+      if (obj->typeId() == frcInstTerm) {
+        auto instTerm = static_cast<frInstTerm*>(obj);
+        if (instTerm->getInst() == inst) {
+          continue;
+        }
+        net = instTerm->getNet();
+      } else if (obj->typeId() == frcInstBlockage) {
+        if (static_cast<frInstBlockage*>(obj)->getInst() == inst) {
+          continue;
+        }
+      } else if (obj->typeId() == frcBTerm) {
+        net = static_cast<frBTerm*>(obj)->getNet();
+      }
+      size_t seed = 0;
+      boost::hash_combine(seed, layerNum);
+      boost::hash_combine(seed, (int) obj->typeId());
+      hashRect(seed, box, origin);
+      auto it = netIdx.find(net);
+      boost::hash_combine(seed, it == netIdx.end() ? -1 : it->second);
+      // the query order is not deterministic
+      signature += seed;
+    }
+  }
+  return signature;
+}
+
+std::string FlexPA::getCacheKey(frInst* inst)
+{
+  const auto offsets = unique_insts_.getTrackOffsets(inst);
+  if (offsets == nullptr) {
+    return "";
+  }
+  auto master = inst->getMaster();
+  std::string key = fmt::format("{} {} {:x} {:x} ",
+                                master->getName(),
+                                inst->getOrient().getString(),
+                                getCacheMasterSignature(master),
+                                getCacheContextSignature(inst));
+  for (auto& instTerm : inst->getInstTerms()) {
+    key += isSkipInstTerm(instTerm.get()) ? '0' : '1';
+  }
+  for (const frCoord offset : *offsets) {
+    key += fmt::format(" {}", offset);
+  }
+  return key;
+}
+
+bool FlexPA::loadCacheEntry(const int uniqueInstIdx, const std::string& data)
+{
+  frInst* inst = unique_insts_.getUnique(uniqueInstIdx);
+  const int paIdx = unique_insts_.getPAIndex(inst);
+  const std::vector<frMPin*> pins = getCachePins(inst);
+
+  std::vector<std::unique_ptr<frPinAccess>> pinAccess;
+  std::vector<CachePattern> patterns;
+  std::vector<std::pair<int, int>> boundarySlots;
+  try {
+    std::istringstream stream(data);
+    frIArchive ar(stream);
+    ar.setDesign(getDesign());
+    registerTypes(ar);
+    ar >> pinAccess;
+    ar >> patterns;
+    ar >> boundarySlots;
+  } catch (const boost::archive::archive_exception&) {
+    return false;
+  }
+
+  // validate before touching the pins
+  if (pinAccess.size() != pins.size()
+      || boundarySlots.size() != patterns.size()) {
+    return false;
+  }
+  for (int i = 0; i < (int) patterns.size(); i++) {
+    const auto& pattern = patterns[i];
+    for (const auto& [pinIdx, apIdx] : pattern) {
+      if (pinIdx >= (int) pins.size()
+          || (pinIdx >= 0
+              && (apIdx < 0
+                  || apIdx >= pinAccess[pinIdx]->getNumAccessPoints()))) {
+        return false;
+      }
+    }
+    const auto [left, right] = boundarySlots[i];
+    if (left >= (int) pattern.size() || right >= (int) pattern.size()) {
+      return false;
+    }
+  }
+
+  for (int i = 0; i < (int) pins.size(); i++) {
+    pins[i]->setPinAccess(paIdx, std::move(pinAccess[i]));
+  }
+  for (int i = 0; i < (int) patterns.size(); i++) {
+    auto accessPattern = std::make_unique<FlexPinAccessPattern>();
+    for (const auto& [pinIdx, apIdx] : patterns[i]) {
+      frAccessPoint* ap = nullptr;
+      if (pinIdx >= 0) {
+        ap = pins[pinIdx]->getPinAccess(paIdx)->getAccessPoint(apIdx);
+      }
+      accessPattern->addAccessPoint(ap);
+    }
+    const auto [left, right] = boundarySlots[i];
+    const auto& aps = accessPattern->getPattern();
+    accessPattern->setBoundaryAP(true, left < 0 ? nullptr : aps[left]);
+    accessPattern->setBoundaryAP(false, right < 0 ? nullptr : aps[right]);
+    accessPattern->updateCost();
+    uniqueInstPatterns_[uniqueInstIdx].push_back(std::move(accessPattern));
+  }
+  return true;
+}
+
+std::string FlexPA::saveCacheEntry(const int uniqueInstIdx)
+{
+  frInst* inst = unique_insts_.getUnique(uniqueInstIdx);
+  const int paIdx = unique_insts_.getPAIndex(inst);
+  const std::vector<frMPin*> pins = getCachePins(inst);
+
+  std::vector<std::unique_ptr<frPinAccess>> pinAccess;
+  std::map<frPinAccess*, int> paToPinIdx;
+  for (int i = 0; i < (int) pins.size(); i++) {
+    auto pa = pins[i]->getPinAccess(paIdx);
+    paToPinIdx[pa] = i;
+    pinAccess.push_back(std::make_unique<frPinAccess>(*pa));
+  }
+
+  std::vector<CachePattern> patterns;
+  std::vector<std::pair<int, int>> boundarySlots;
+  for (auto& accessPattern : uniqueInstPatterns_[uniqueInstIdx]) {
+    const auto& aps = accessPattern->getPattern();
+    CachePattern pattern;
+    for (frAccessPoint* ap : aps) {
+      if (ap == nullptr) {
+        pattern.emplace_back(-1, -1);
+      } else {
+        pattern.emplace_back(paToPinIdx.at(ap->getPinAccess()), ap->getId());
+      }
+    }
+    auto getSlot = [&aps](frAccessPoint* ap) {
+      auto it = std::find(aps.begin(), aps.end(), ap);
+      return (ap == nullptr || it == aps.end()) ? -1 : int(it - aps.begin());
+    };
+    boundarySlots.emplace_back(getSlot(accessPattern->getBoundaryAP(true)),
+                               getSlot(accessPattern->getBoundaryAP(false)));
+    patterns.push_back(std::move(pattern));
+  }
+
+  std::ostringstream stream;
+  {
+    frOArchive ar(stream);
+    registerTypes(ar);
+    ar << pinAccess;
+    ar << patterns;
+    ar << boundarySlots;
+  }
+  return stream.str();
+}
+
+void FlexPA::readCache()
+{
+  ProfileTask profile("PA:readCache");
+  const auto& unique = unique_insts_.getUnique();
+  uniqueInstCached_.assign(unique.size(), false);
+  uniqueInstCacheKeys_.assign(unique.size(), "");
+  unusedCacheEntries_.clear();
+  if (PA_CACHE_FILE.empty()) {
+    return;
+  }
+
+  omp_set_num_threads(MAX_THREADS);
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < (int) unique.size(); i++) {
+    uniqueInstCacheKeys_[i] = getCacheKey(unique[i]);
+  }
+
+  std::ifstream file(PA_CACHE_FILE, std::ios::binary);
+  if (!file.good()) {
+    logger_->info(
+        DRT, 333, "Pin access cache {} not found, creating it.", PA_CACHE_FILE);
+    return;
+  }
+  size_t techSignature = 0;
+  std::map<std::string, std::string> entries;
+  try {
+    frIArchive ar(file);
+    ar.setDesign(getDesign());
+    registerTypes(ar);
+    ar >> techSignature;
+    ar >> entries;
+  } catch (const boost::archive::archive_exception&) {
+    logger_->warn(
+        DRT, 334, "Ignoring unreadable pin access cache {}.", PA_CACHE_FILE);
+    return;
+  }
+  if (techSignature != getCacheTechSignature()) {
+    logger_->info(DRT,
+                  335,
+                  "Pin access cache {} was built for a different technology "
+                  "or pin access settings, recomputing all instances.",
+                  PA_CACHE_FILE);
+    return;
+  }
+
+  uniqueInstPatterns_.resize(unique.size());
+  int numCached = 0;
+  for (int i = 0; i < (int) unique.size(); i++) {
+    const std::string& key = uniqueInstCacheKeys_[i];
+    if (key.empty()) {
+      continue;
+    }
+    auto it = entries.find(key);
+    if (it == entries.end() || !loadCacheEntry(i, it->second)) {
+      continue;
+    }
+    uniqueInstCached_[i] = true;
+    entries.erase(it);
+    numCached++;
+  }
+  // keep entries of other placements so alternating runs stay cached
+  unusedCacheEntries_ = std::move(entries);
+  if (VERBOSE > 0) {
+    logger_->info(DRT,
+                  336,
+                  "Reused pin access of {} of {} unique instances from {}.",
+                  numCached,
+                  unique.size(),
+                  PA_CACHE_FILE);
+  }
+}
+
+void FlexPA::writeCache()
+{
+  if (PA_CACHE_FILE.empty()) {
+    return;
+  }
+  ProfileTask profile("PA:writeCache");
+  const auto& unique = unique_insts_.getUnique();
+  std::vector<std::string> data(unique.size());
+  omp_set_num_threads(MAX_THREADS);
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < (int) unique.size(); i++) {
+    if (!uniqueInstCacheKeys_[i].empty()) {
+      data[i] = saveCacheEntry(i);
+    }
+  }
+  std::map<std::string, std::string> entries = std::move(unusedCacheEntries_);
+  unusedCacheEntries_.clear();
+  for (int i = 0; i < (int) unique.size(); i++) {
+    if (!uniqueInstCacheKeys_[i].empty()) {
+      entries[uniqueInstCacheKeys_[i]] = std::move(data[i]);
+    }
+  }
+
+  std::ofstream file(PA_CACHE_FILE, std::ios::binary);
+  if (!file.good()) {
+    logger_->warn(DRT, 337, "Cannot write pin access cache {}.", PA_CACHE_FILE);
+    return;
+  }
+  frOArchive ar(file);
+  registerTypes(ar);
+  const size_t techSignature = getCacheTechSignature();
+  ar << techSignature;
+  ar << entries;
+}
+
+}  // namespace fr
@@ -1428,6 +1428,9 @@ void FlexPA::prepPoint()
 #pragma omp parallel for schedule(dynamic)
   for (int i = 0; i < (int) unique.size(); i++) {
     try {
+      if (uniqueInstCached_[i]) {
+        continue;
+      }
       auto& inst = unique[i];
       // only do for core and block cells
       dbMasterType masterType = inst->getMaster()->getMasterType();
@@ -1640,6 +1643,9 @@ void FlexPA::prepPattern()
   for (int currUniqueInstIdx = 0; currUniqueInstIdx < (int) unique.size();
        currUniqueInstIdx++) {
     try {
+      if (uniqueInstCached_[currUniqueInstIdx]) {
+        continue;
+      }
       auto& inst = unique[currUniqueInstIdx];
       // only do for core and block cells
       // TODO the above comment says "block cells" but that's not what the code
@@ -1692,6 +1698,7 @@ void FlexPA::prepPattern()
   if (VERBOSE > 0) {
     logger_->info(DRT, 81, "  Complete {} unique inst patterns.", cnt);
   }
+  writeCache();
   if (isDistributed()) {
     dst::JobMessage msg(dst::JobMessage::PIN_ACCESS,
                         dst::JobMessage::BROADCAST),
@@ -1753,7 +1760,12 @@ void FlexPA::prepPattern()
 void FlexPA::revertAccessPoints()
 {
   const auto& unique = unique_insts_.getUnique();
-  for (auto& inst : unique) {
+  for (int i = 0; i < (int) unique.size(); i++) {
+    // cached access points are already relative to the instance origin
+    if (uniqueInstCached_[i]) {
+      continue;
+    }
+    auto& inst = unique[i];
     const dbTransform xform = inst->getTransform();
     const Point offset(xform.getOffset());
     dbTransform revertXform;
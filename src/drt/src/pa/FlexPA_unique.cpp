@@ -180,6 +180,7 @@ void UniqueInsts::computeUnique(
       for (auto& [vec, insts] : offsetMap) {
         auto uniqueInst = *(insts.begin());
         unique_.push_back(uniqueInst);
+        unique2offsets_[uniqueInst] = vec;
         for (auto i : insts) {
           inst2unique_[i] = uniqueInst;
           inst2Class_[i] = &insts;
@@ -312,6 +313,16 @@ const std::vector<frInst*>& UniqueInsts::getUnique() const
   return unique_;
 }
 
+const std::vector<frCoord>* UniqueInsts::getTrackOffsets(
+    frInst* unique_inst) const
+{
+  auto it = unique2offsets_.find(unique_inst);
+  if (it == unique2offsets_.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
 frInst* UniqueInsts::getUnique(int idx) const
 {
   return unique_[idx];
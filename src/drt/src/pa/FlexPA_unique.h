@@ -63,6 +63,9 @@ class UniqueInsts
   const std::vector<frInst*>& getUnique() const;
   frInst* getUnique(int idx) const;
   bool hasUnique(frInst* inst) const;
+  // Gets the track-offset signature of a unique instance or nullptr if the
+  // instance was not grouped by track offsets (eg NDR instances).
+  const std::vector<frCoord>* getTrackOffsets(frInst* unique_inst) const;
 
   void report() const;
 
@@ -101,6 +104,8 @@ class UniqueInsts
   std::map<frInst*, int, frBlockObjectComp> unique2paidx_;
   // Maps a unique instance to its index in unique_
   std::map<frInst*, int, frBlockObjectComp> unique2Idx_;
+  // Maps a unique instance to its track-offset signature
+  std::map<frInst*, std::vector<frCoord>, frBlockObjectComp> unique2offsets_;
   // master orient track-offset to instances
   map<frMaster*,
       map<dbOrientType, map<vector<frCoord>, set<frInst*, frBlockObjectComp>>>,
@@ -120,7 +120,19 @@ int FlexTA::initTA_helper(int iter,
   auto& ygp = gCellPatterns.at(1);
   int sol = 0;
   numPanels = 0;
-  vector<vector<unique_ptr<FlexTAWorker>>> workers;
+  // Two colors like the DR checkerboard: panels of one color never share
+  // their extension box, so all of them run in parallel and the other
+  // color sees their committed assignments on both sides.
+  const int batchSize = std::max(BATCHSIZETA, MAX_THREADS);
+  vector<vector<vector<unique_ptr<FlexTAWorker>>>> workers(2);
+  int panelIdx = 0;
+  auto addWorker = [&](unique_ptr<FlexTAWorker> uworker) {
+    auto& colorBatches = workers[panelIdx++ % 2];
+    if (colorBatches.empty() || (int) colorBatches.back().size() >= batchSize) {
+      colorBatches.push_back(vector<unique_ptr<FlexTAWorker>>());
+    }
+    colorBatches.back().push_back(std::move(uworker));
+  };
   if (isH) {
     for (int i = offset; i < (int) ygp.getCount(); i += size) {
       auto uworker
@@ -138,10 +150,8 @@ int FlexTA::initTA_helper(int iter,
       worker.setExtBox(extBox);
       worker.setDir(dbTechLayerDir::HORIZONTAL);
       worker.setTAIter(iter);
-      if (workers.empty() || (int) workers.back().size() >= BATCHSIZETA) {
-        workers.push_back(vector<unique_ptr<FlexTAWorker>>());
-      }
-      workers.back().push_back(std::move(uworker));
+      worker.setMacroBlockages(&macroBlockages_);
+      addWorker(std::move(uworker));
     }
   } else {
     for (int i = offset; i < (int) xgp.getCount(); i += size) {
@@ -160,41 +170,76 @@ int FlexTA::initTA_helper(int iter,
       worker.setExtBox(extBox);
       worker.setDir(dbTechLayerDir::VERTICAL);
       worker.setTAIter(iter);
-      if (workers.empty() || (int) workers.back().size() >= BATCHSIZETA) {
-        workers.push_back(vector<unique_ptr<FlexTAWorker>>());
-      }
-      workers.back().push_back(std::move(uworker));
+      worker.setMacroBlockages(&macroBlockages_);
+      addWorker(std::move(uworker));
     }
   }
 
-  omp_set_num_threads(min(8, MAX_THREADS));
+  omp_set_num_threads(MAX_THREADS);
   // parallel execution
   // multi thread
-  for (auto& workerBatch : workers) {
-    ProfileTask profile("TA:batch");
-    ThreadException exception;
+  for (auto& colorBatches : workers) {
+    for (auto& workerBatch : colorBatches) {
+      ProfileTask profile("TA:batch");
+      ThreadException exception;
 #pragma omp parallel for schedule(dynamic)
-    for (int i = 0; i < (int) workerBatch.size(); i++) {
-      try {
-        workerBatch[i]->main_mt();
+      for (int i = 0; i < (int) workerBatch.size(); i++) {
+        try {
+          workerBatch[i]->main_mt();
 #pragma omp critical
-        {
-          sol += workerBatch[i]->getNumAssigned();
-          numPanels++;
+          {
+            sol += workerBatch[i]->getNumAssigned();
+            numPanels++;
+          }
+        } catch (...) {
+          exception.capture();
         }
-      } catch (...) {
-        exception.capture();
       }
+      exception.rethrow();
+      for (int i = 0; i < (int) workerBatch.size(); i++) {
+        workerBatch[i]->end();
+      }
+      workerBatch.clear();
     }
-    exception.rethrow();
-    for (int i = 0; i < (int) workerBatch.size(); i++) {
-      workerBatch[i]->end();
-    }
-    workerBatch.clear();
   }
   return sol;
 }
 
+void FlexTA::initMacroBlockages()
+{
+  ProfileTask profile("TA:initMacroBlockages");
+  auto tech = getDesign()->getTech();
+  // panel extension boxes reach half a gcell past the gcell grid
+  auto gCellPatterns = getDesign()->getTopBlock()->getGCellPatterns();
+  Rect queryBox;
+  getDesign()->getTopBlock()->getDieBox().bloat(
+      std::max(gCellPatterns.at(0).getSpacing(),
+               gCellPatterns.at(1).getSpacing()),
+      queryBox);
+  macroBlockages_.clear();
+  macroBlockages_.resize(tech->getLayers().size());
+  frRegionQuery::Objects<frBlockObject> result;
+  for (auto lNum = tech->getBottomLayerNum(); lNum <= tech->getTopLayerNum();
+       ++lNum) {
+    if (tech->getLayer(lNum)->getType() != dbTechLayerType::ROUTING) {
+      continue;
+    }
+    result.clear();
+    getDesign()->getRegionQuery()->query(queryBox, lNum, result);
+    for (auto& [bounds, obj] : result) {
+      if (obj->typeId() != frcInstBlockage) {
+        continue;
+      }
+      auto inst = static_cast<frInstBlockage*>(obj)->getInst();
+      dbMasterType masterType = inst->getMaster()->getMasterType();
+      if (masterType.isBlock() || masterType.isPad()
+          || masterType == dbMasterType::RING) {
+        macroBlockages_[lNum].emplace_back(bounds, obj);
+      }
+    }
+  }
+}
+
 void FlexTA::initTA(int size)
 {
   ProfileTask profile("TA:init");
@@ -333,6 +378,7 @@ int FlexTA::main()
   if (VERBOSE > 0) {
     logger_->info(DRT, 181, "Start track assignment.");
   }
+  initMacroBlockages();
   initTA(50);
   if (graphics_) {
     graphics_->endIter(0);
@@ -57,8 +57,12 @@ class FlexTA
   Logger* logger_;
   bool save_updates_;
   std::unique_ptr<FlexTAGraphics> graphics_;
+  // block, pad and ring obstructions per layer, collected once and shared
+  // by the panels of both sweeps in every iteration
+  std::vector<frRegionQuery::Objects<frBlockObject>> macroBlockages_;
   // others
   void main_helper(frLayerNum lNum, int maxOffsetIter, int panelWidth);
+  void initMacroBlockages();
   void initTA(int size);
   void searchRepair(int iter, int size, int offset);
   int initTA_helper(int iter, int size, int offset, bool isH, int& numPanels);
@@ -114,12 +118,18 @@ class FlexTAWorker
         numAssigned_(0),
         totCost_(0),
         maxRetry_(1),
-        hardIroutesMode(false){};
+        hardIroutesMode(false),
+        macroBlockages_(nullptr){};
   // setters
   void setRouteBox(const Rect& boxIn) { routeBox_ = boxIn; }
   void setExtBox(const Rect& boxIn) { extBox_ = boxIn; }
   void setDir(dbTechLayerDir in) { dir_ = in; }
   void setTAIter(int in) { taIter_ = in; }
+  void setMacroBlockages(
+      const std::vector<frRegionQuery::Objects<frBlockObject>>* in)
+  {
+    macroBlockages_ = in;
+  }
   void addIroute(std::unique_ptr<taPin> in, bool isExt = false)
   {
     in->setId(iroutes_.size() + extIroutes_.size());
@@ -199,10 +209,14 @@ class FlexTAWorker
   int totCost_;
   int maxRetry_;
   bool hardIroutesMode;
+  // owned by FlexTA
+  const std::vector<frRegionQuery::Objects<frBlockObject>>* macroBlockages_;
 
   //// others
   void init();
   void initFixedObjs();
+  void queryMacroBlockages(frLayerNum lNum,
+                           frRegionQuery::Objects<frBlockObject>& result) const;
   frCoord initFixedObjs_calcBloatDist(frBlockObject* obj,
                                       const frLayerNum lNum,
                                       const Rect& box);
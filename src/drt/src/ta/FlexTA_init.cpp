@@ -793,17 +793,34 @@ void FlexTAWorker::initFixedObjs()
     if (layerNum - 2 >= getDesign()->getTech()->getBottomLayerNum()
         && getTech()->getLayer(layerNum - 2)->getType()
                == dbTechLayerType::ROUTING)
-      getRegionQuery()->query(getExtBox(), layerNum - 2, result);
+      queryMacroBlockages(layerNum - 2, result);
     costResults(false, result);
     result.clear();
     if (layerNum + 2 < getDesign()->getTech()->getLayers().size()
         && getTech()->getLayer(layerNum + 2)->getType()
                == dbTechLayerType::ROUTING)
-      getRegionQuery()->query(getExtBox(), layerNum + 2, result);
+      queryMacroBlockages(layerNum + 2, result);
     costResults(true, result);
   }
 }
 
+// Only block, pad and ring obstructions matter on the neighbor layers, so
+// use FlexTA's prefiltered list rather than querying every pin shape there.
+void FlexTAWorker::queryMacroBlockages(
+    frLayerNum lNum,
+    frRegionQuery::Objects<frBlockObject>& result) const
+{
+  if (macroBlockages_ == nullptr) {
+    getRegionQuery()->query(getExtBox(), lNum, result);
+    return;
+  }
+  for (const auto& blockage : macroBlockages_->at(lNum)) {
+    if (blockage.first.intersects(getExtBox())) {
+      result.push_back(blockage);
+    }
+  }
+}
+
 frCoord FlexTAWorker::initFixedObjs_calcOBSBloatDistVia(frViaDef* viaDef,
                                                         const frLayerNum lNum,
                                                         const Rect& box,
@@ -31,6 +31,8 @@
 #include <tcl.h>
 
 #include <boost/asio.hpp>
+#include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -51,6 +53,16 @@ class Worker;
 class Distributed
 {
  public:
+  // Sends one result of a task back to the caller.
+  using TaskResultSender = std::function<bool(const std::string& result)>;
+  // Runs a task on a worker given its payload, streaming its results through
+  // the sender. Returns false if the task failed.
+  using TaskHandler = std::function<bool(const std::string& payload,
+                                         const TaskResultSender& send_result)>;
+  // Called on the leader for every result a task streams back.
+  using TaskResultCallBack = std::function<void(const std::string& result)>;
+
+
   Distributed(utl::Logger* logger = nullptr);
   ~Distributed();
   void init(Tcl_Interp* tcl_interp, utl::Logger* logger);
@@ -71,6 +83,17 @@ class Distributed
   void addCallBack(JobCallBack* cb);
   const std::vector<JobCallBack*>& getCallBacks() const { return callbacks_; }
 
+  // Generic tasks let any tool use the workers: the tool registers a handler
+  // for its task name on the workers and sends payloads with sendTask.
+  void addTaskHandler(const std::string& task, TaskHandler handler);
+  bool sendTask(const std::string& task,
+                const std::string& payload,
+                const char* ip,
+                unsigned short port,
+                const TaskResultCallBack& on_result);
+  // Runs the task in msg with its registered handler and replies on sock.
+  void runTask(JobMessage& msg, socket& sock);
+
  private:
   struct EndPoint
   {
@@ -81,9 +104,15 @@ class Distributed
     {
     }
   };
+  // Reads a single message frame, returning false on eof or error.
+  static bool readFrame(socket& sock,
+                        std::string& frame,
+                        boost::system::error_code& error);
+
   utl::Logger* logger_;
   std::vector<EndPoint> end_points_;
   std::vector<JobCallBack*> callbacks_;
+  std::map<std::string, TaskHandler> task_handlers_;
   std::vector<std::unique_ptr<Worker>> workers_;
 };
 }  // namespace dst
@@ -37,6 +37,7 @@ class JobCallBack
   virtual void onFrDesignUpdated(JobMessage& msg, socket& sock) = 0;
   virtual void onPinAccessJobReceived(JobMessage& msg, socket& sock) = 0;
   virtual void onGRDRInitJobReceived(JobMessage& msg, socket& sock) = 0;
+  virtual void onPartitionJobReceived(JobMessage& msg, socket& sock) = 0;
   virtual ~JobCallBack() {}
 };
 }  // namespace dst
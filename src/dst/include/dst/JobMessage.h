@@ -27,6 +27,8 @@
  */
 
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -63,6 +65,8 @@ class JobMessage
     BALANCER,
     PIN_ACCESS,
     GRDR_INIT,
+    PARTITIONING,
+    TASK,
     SUCCESS,
     ERROR,
     NONE
@@ -73,7 +77,7 @@ class JobMessage
     BROADCAST
   };
   JobMessage(JobType job_type = NONE, MessageType msg_type = UNICAST)
-      : msg_type_(msg_type), job_type_(job_type)
+      : msg_type_(msg_type), job_type_(job_type), job_size_(1.0)
   {
   }
   void setJobDescription(std::unique_ptr<JobDescription> in)
@@ -94,15 +98,24 @@ class JobMessage
   JobDescription* getJobDescription() { return desc_.get(); }
   JobType getJobType() const { return job_type_; }
   MessageType getMessageType() const { return msg_type_; }
+  // Relative amount of work in the job, used by the balancer to estimate
+  // how long a worker will take with it.
+  void setJobSize(double size) { job_size_ = size; }
+  double getJobSize() const { return job_size_; }
 
  private:
   MessageType msg_type_;
   JobType job_type_;
+  double job_size_;
   std::unique_ptr<JobDescription> desc_;
   std::vector<std::unique_ptr<JobDescription>> descs_;
 
-  static constexpr const char* EOP
-      = "\r\nENDOFPACKET\r\n";  // ENDOFPACKET SEQUENCE
+  // Every message on the wire is a fixed size header holding the payload
+  // size and the uncompressed size followed by the binary archive payload.
+  // The two sizes differ only when the payload is compressed.
+  static constexpr std::size_t HEADER_SIZE = 2 * sizeof(uint64_t);
+  // Payloads at least this large are compressed before sending.
+  static constexpr std::size_t COMPRESSION_THRESHOLD = 64 * 1024;
 
   template <class Archive>
   void serialize(Archive& ar, const unsigned int version);
@@ -114,9 +127,20 @@ class JobMessage
     READ,
     WRITE
   };
+  // str holds a whole frame, header included.
   static bool serializeMsg(SerializeType type,
                            JobMessage& msg,
                            std::string& str);
+  // Writes the header and the payload separately so they can be sent as a
+  // gather write without joining them first.
+  static bool serializeMsg(JobMessage& msg,
+                           std::string& header,
+                           std::string& payload);
+  // Deserializes the frame starting at data, size being the bytes available.
+  static bool deserializeMsg(JobMessage& msg, const char* data, size_t size);
+  // Total frame size (header included) given its header, or 0 if the header
+  // is invalid.
+  static std::size_t frameSize(const char* header);
   friend class dst::Distributed;
   friend class dst::WorkerConnection;
   friend class dst::BalancerConnection;
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2022, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/string.hpp>
+#include <string>
+
+#include "dst/JobMessage.h"
+namespace boost::serialization {
+class access;
+}
+namespace dst {
+
+// Carries a generic task between the leader and the workers. The payload is
+// opaque to dst; each tool serializes its own task and result data into it.
+// Results streamed back by a worker use the same description with an empty
+// task name.
+class TaskJobDescription : public JobDescription
+{
+ public:
+  TaskJobDescription() = default;
+  TaskJobDescription(const std::string& task, const std::string& payload)
+      : task_(task), payload_(payload)
+  {
+  }
+  void setTask(const std::string& task) { task_ = task; }
+  const std::string& getTask() const { return task_; }
+  void setPayload(const std::string& payload) { payload_ = payload; }
+  const std::string& getPayload() const { return payload_; }
+
+ private:
+  std::string task_;
+  std::string payload_;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int version)
+  {
+    (ar) & boost::serialization::base_object<dst::JobDescription>(*this);
+    (ar) & task_;
+    (ar) & payload_;
+  }
+  friend class boost::serialization::access;
+};
+}  // namespace dst
@@ -30,12 +30,13 @@
 
 #include <dst/JobMessage.h>
 
-#include <boost/archive/text_iarchive.hpp>
-#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/asio/post.hpp>
 #include <boost/bind/bind.hpp>
 #include <boost/serialization/export.hpp>
 #include <boost/thread/thread.hpp>
+#include <chrono>
 #include <mutex>
 #include <thread>
 
@@ -43,12 +44,14 @@
 #include "dst/BalancerJobDescription.h"
 #include "dst/BroadcastJobDescription.h"
 #include "dst/Distributed.h"
+#include "dst/TaskJobDescription.h"
 #include "utl/Logger.h"
 
 using namespace dst;
 
 BOOST_CLASS_EXPORT(dst::BalancerJobDescription)
 BOOST_CLASS_EXPORT(dst::BroadcastJobDescription)
+BOOST_CLASS_EXPORT(dst::TaskJobDescription)
 
 BalancerConnection::BalancerConnection(asio::io_service& io_service,
                                        LoadBalancer* owner,
@@ -64,15 +67,45 @@ tcp::socket& BalancerConnection::socket()
 
 void BalancerConnection::start()
 {
-  async_read_until(
-      sock_,
-      in_packet_,
-      JobMessage::EOP,
-      [me = shared_from_this()](boost::system::error_code const& ec,
-                                std::size_t bytes_xfer) {
-        boost::thread t(&BalancerConnection::handle_read, me, ec, bytes_xfer);
-        t.detach();
-      });
+  async_read(sock_,
+             in_packet_,
+             asio::transfer_exactly(JobMessage::HEADER_SIZE),
+             [me = shared_from_this()](boost::system::error_code const& ec,
+                                       std::size_t bytes_xfer) {
+               me->handle_header(ec, bytes_xfer);
+             });
+}
+
+void BalancerConnection::handle_header(boost::system::error_code const& err,
+                                       size_t bytes_transferred)
+{
+  if (err) {
+    handle_read(err, bytes_transferred);
+    return;
+  }
+  const auto header = static_cast<const char*>(in_packet_.data().data());
+  const std::size_t frame_size = JobMessage::frameSize(header);
+  if (frame_size == 0) {
+    logger_->warn(utl::DST,
+                  42,
+                  "Received malformed msg header from port {}",
+                  sock_.remote_endpoint().port());
+    boost::system::error_code error;
+    asio::write(sock_, asio::buffer("0"), error);
+    sock_.close();
+    return;
+  }
+  async_read(sock_,
+             in_packet_,
+             asio::transfer_exactly(frame_size - JobMessage::HEADER_SIZE),
+             [me = shared_from_this()](boost::system::error_code const& ec,
+                                       std::size_t bytes_xfer) {
+               boost::thread t(&BalancerConnection::handle_read,
+                               me,
+                               ec,
+                               me->in_packet_.size());
+               t.detach();
+             });
 }
 
 void BalancerConnection::handle_read(boost::system::error_code const& err,
@@ -80,14 +113,13 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
 {
   if (!err) {
     boost::system::error_code error;
-    std::string data{buffers_begin(in_packet_.data()),
-                     buffers_begin(in_packet_.data()) + bytes_transferred};
+    const auto frame = static_cast<const char*>(in_packet_.data().data());
     JobMessage msg(JobMessage::NONE);
-    if (!JobMessage::serializeMsg(JobMessage::READ, msg, data)) {
+    if (!JobMessage::deserializeMsg(msg, frame, bytes_transferred)) {
       logger_->warn(utl::DST,
                     42,
-                    "Received malformed msg {} from port {}",
-                    data,
+                    "Received malformed msg of {} bytes from port {}",
+                    bytes_transferred,
                     sock_.remote_endpoint().port());
       asio::write(sock_, asio::buffer("0"), error);
       sock_.close();
@@ -97,7 +129,8 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
       case JobMessage::UNICAST: {
         ip::address workerAddress;
         unsigned short port;
-        owner_->getNextWorker(workerAddress, port);
+        const double job_size = msg.getJobSize();
+        owner_->getNextWorker(workerAddress, port, job_size);
         if (workerAddress.is_unspecified()) {
           logger_->warn(utl::DST, 6, "No workers available");
           sock_.close();
@@ -118,11 +151,18 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
             asio::streambuf receive_buffer;
             bool failure = true;
             while (failure) {
+              const auto start = std::chrono::steady_clock::now();
+              auto elapsed = [&start]() {
+                return std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                    .count();
+              };
               try {
                 socket.connect(tcp::endpoint(workerAddress, port));
                 asio::write(socket, in_packet_);
                 asio::read(socket, receive_buffer, asio::transfer_all());
                 failure = false;
+                owner_->updateWorker(workerAddress, port, job_size, elapsed());
               } catch (std::exception const& ex) {
                 if (socket.is_open()) {
                   socket.close();
@@ -132,8 +172,11 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
                   // Since asio::transfer_all() used with a stream buffer it
                   // always reach an eof file exception!
                   failure = false;
+                  owner_->updateWorker(
+                      workerAddress, port, job_size, elapsed());
                   break;
                 }
+                owner_->updateWorker(workerAddress, port, job_size);
                 logger_->warn(utl::DST,
                               204,
                               "Exception thrown: {}. worker with ip \"{}\" and "
@@ -151,14 +194,12 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
                                 failed_workers_trials);
                   break;
                 }
-                owner_->getNextWorker(workerAddress, port);
+                owner_->getNextWorker(workerAddress, port, job_size);
               }
             }
             if (failure) {
               JobMessage result(JobMessage::ERROR);
-              std::string msgStr;
-              JobMessage::serializeMsg(JobMessage::WRITE, result, msgStr);
-              asio::write(sock_, asio::buffer(msgStr), error);
+              owner_->dist_->sendResult(result, sock_);
             } else {
               asio::write(sock_, receive_buffer, error);
             }
@@ -169,17 +210,15 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
       }
       case JobMessage::BROADCAST: {
         std::lock_guard<std::mutex> lock(owner_->workers_mutex_);
+        const std::string data(frame, bytes_transferred);
         owner_->broadcastData.push_back(data);
         asio::thread_pool pool(owner_->workers_.size());
-        auto workers_copy = owner_->workers_;
         std::mutex broadcast_failure_mutex;
         std::vector<std::pair<ip::address, unsigned short>> failed_workers;
-        while (!workers_copy.empty()) {
-          auto worker = workers_copy.top();
-          workers_copy.pop();
+        for (const auto& worker : owner_->workers_) {
           asio::post(
               pool,
-              [worker, data, &failed_workers, &broadcast_failure_mutex]() {
+              [worker, &data, &failed_workers, &broadcast_failure_mutex]() {
                 try {
                   asio::io_service io_service;
                   tcp::socket socket(io_service);
@@ -200,7 +239,6 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
         }
         pool.join();
         JobMessage result(JobMessage::SUCCESS);
-        std::string msgStr;
         unsigned short successBroadcast
             = owner_->workers_.size() - failed_workers.size();
         if (!failed_workers.empty()) {
@@ -221,8 +259,7 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
         auto desc = uDesc.get();
         desc->setWorkersCount(successBroadcast);
         result.setJobDescription(std::move(uDesc));
-        JobMessage::serializeMsg(JobMessage::WRITE, result, msgStr);
-        asio::write(sock_, asio::buffer(msgStr), error);
+        owner_->dist_->sendResult(result, sock_);
         sock_.close();
         break;
       }
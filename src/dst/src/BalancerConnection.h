@@ -57,6 +57,8 @@ class BalancerConnection
   }
   tcp::socket& socket();
   void start();
+  void handle_header(boost::system::error_code const& err,
+                     size_t bytes_transferred);
   void handle_read(boost::system::error_code const& err,
                    size_t bytes_transferred);
   LoadBalancer* getOwner() const { return owner_; }
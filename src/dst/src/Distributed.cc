@@ -28,6 +28,7 @@
 
 #include "dst/Distributed.h"
 
+#include <array>
 #include <boost/asio.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/system/system_error.hpp>
@@ -37,6 +38,7 @@
 #include "Worker.h"
 #include "dst/JobCallBack.h"
 #include "dst/JobMessage.h"
+#include "dst/TaskJobDescription.h"
 #include "sta/StaMain.hh"
 #include "utl/Logger.h"
 namespace dst {
@@ -116,13 +118,18 @@ void Distributed::addWorkerAddress(const char* address, unsigned short port)
   end_points_.emplace_back(address, port);
 }
 // TODO: exponential backoff
-bool sendMsg(dst::socket& sock, const std::string& msg, std::string& errorMsg)
+bool sendMsg(dst::socket& sock,
+             const std::string& header,
+             const std::string& payload,
+             std::string& errorMsg)
 {
+  const std::array<asio::const_buffer, 2> buffers{asio::buffer(header),
+                                                  asio::buffer(payload)};
   int tries = 0;
   while (tries++ < MAX_TRIES) {
     boost::system::error_code error;
     sock.wait(asio::ip::tcp::socket::wait_write);
-    write(sock, asio::buffer(msg), error);
+    write(sock, buffers, error);
     if (!error) {
       errorMsg.clear();
       return true;
@@ -154,14 +161,37 @@ bool readMsg(dst::socket& sock, std::string& dataStr)
   return !dataStr.empty();
 }
 
+bool Distributed::readFrame(socket& sock,
+                            std::string& frame,
+                            boost::system::error_code& error)
+{
+  frame.resize(JobMessage::HEADER_SIZE);
+  asio::read(sock, asio::buffer(frame), error);
+  if (error) {
+    return false;
+  }
+  const std::size_t frame_size = JobMessage::frameSize(frame.data());
+  if (frame_size == 0) {
+    error = asio::error::invalid_argument;
+    return false;
+  }
+  frame.resize(frame_size);
+  asio::read(sock,
+             asio::buffer(&frame[JobMessage::HEADER_SIZE],
+                          frame_size - JobMessage::HEADER_SIZE),
+             error);
+  return !error;
+}
+
 bool Distributed::sendJob(JobMessage& msg,
                           const char* ip,
                           unsigned short port,
                           JobMessage& result)
 {
   int tries = 0;
-  std::string msgStr;
-  if (!JobMessage::serializeMsg(JobMessage::WRITE, msg, msgStr)) {
+  std::string header;
+  std::string payload;
+  if (!JobMessage::serializeMsg(msg, header, payload)) {
     logger_->warn(utl::DST, 112, "Serializing JobMessage failed");
     return false;
   }
@@ -179,7 +209,7 @@ bool Distributed::sendJob(JobMessage& msg,
                     ex.what());
       continue;
     }
-    bool ok = sendMsg(sock, msgStr, resultStr);
+    bool ok = sendMsg(sock, header, payload, resultStr);
     if (!ok) {
       continue;
     }
@@ -187,7 +217,8 @@ bool Distributed::sendJob(JobMessage& msg,
     if (!ok) {
       continue;
     }
-    if (!JobMessage::serializeMsg(JobMessage::READ, result, resultStr)) {
+    if (!JobMessage::deserializeMsg(
+            result, resultStr.data(), resultStr.size())) {
       continue;
     }
     if (sock.is_open()) {
@@ -203,26 +234,15 @@ bool Distributed::sendJob(JobMessage& msg,
   return false;
 }
 
-inline bool getNextMsg(std::string& haystack,
-                       const std::string& needle,
-                       std::string& result)
-{
-  std::size_t found = haystack.find(needle);
-  if (found != std::string::npos) {
-    result = haystack.substr(0, found + needle.size());
-    haystack.erase(0, found + needle.size());
-    return true;
-  }
-  return false;
-}
 bool Distributed::sendJobMultiResult(JobMessage& msg,
                                      const char* ip,
                                      unsigned short port,
                                      JobMessage& result)
 {
   int tries = 0;
-  std::string msgStr;
-  if (!JobMessage::serializeMsg(JobMessage::WRITE, msg, msgStr)) {
+  std::string header;
+  std::string payload;
+  if (!JobMessage::serializeMsg(msg, header, payload)) {
     logger_->warn(utl::DST, 12, "Serializing JobMessage failed");
     return false;
   }
@@ -241,7 +261,7 @@ bool Distributed::sendJobMultiResult(JobMessage& msg,
     }
     boost::asio::ip::tcp::no_delay option(true);
     sock.set_option(option);
-    bool ok = sendMsg(sock, msgStr, resultStr);
+    bool ok = sendMsg(sock, header, payload, resultStr);
     if (!ok) {
       continue;
     }
@@ -249,14 +269,21 @@ bool Distributed::sendJobMultiResult(JobMessage& msg,
     if (!ok) {
       continue;
     }
-    std::string split;
-    while (getNextMsg(resultStr, JobMessage::EOP, split)) {
+    std::size_t offset = 0;
+    while (offset + JobMessage::HEADER_SIZE <= resultStr.size()) {
+      const char* frame = resultStr.data() + offset;
+      const std::size_t frame_size = JobMessage::frameSize(frame);
       JobMessage tmp;
-      if (!JobMessage::serializeMsg(JobMessage::READ, tmp, split)) {
-        logger_->error(utl::DST, 9999, "Problem in deserialize {}", split);
-      } else {
-        result.addJobDescription(std::move(tmp.getJobDescriptionRef()));
+      if (!JobMessage::deserializeMsg(
+              tmp, frame, resultStr.size() - offset)) {
+        logger_->error(utl::DST,
+                       9999,
+                       "Problem in deserialize of {} bytes",
+                       resultStr.size() - offset);
+        break;
       }
+      result.addJobDescription(std::move(tmp.getJobDescriptionRef()));
+      offset += frame_size;
     }
     result.setJobType(JobMessage::SUCCESS);
     if (sock.is_open()) {
@@ -274,15 +301,16 @@ bool Distributed::sendJobMultiResult(JobMessage& msg,
 
 bool Distributed::sendResult(JobMessage& msg, dst::socket& sock)
 {
-  std::string msgStr;
-  if (!JobMessage::serializeMsg(JobMessage::WRITE, msg, msgStr)) {
+  std::string header;
+  std::string payload;
+  if (!JobMessage::serializeMsg(msg, header, payload)) {
     logger_->warn(utl::DST, 20, "Serializing result JobMessage failed");
     return false;
   }
   int tries = 0;
   std::string error;
   while (tries++ < MAX_TRIES) {
-    if (sendMsg(sock, msgStr, error)) {
+    if (sendMsg(sock, header, payload, error)) {
       return true;
     }
   }
@@ -295,3 +323,96 @@ void Distributed::addCallBack(JobCallBack* cb)
 {
   callbacks_.push_back(cb);
 }
+
+void Distributed::addTaskHandler(const std::string& task, TaskHandler handler)
+{
+  task_handlers_[task] = std::move(handler);
+}
+
+bool Distributed::sendTask(const std::string& task,
+                           const std::string& payload,
+                           const char* ip,
+                           unsigned short port,
+                           const TaskResultCallBack& on_result)
+{
+  JobMessage msg(JobMessage::TASK);
+  msg.setJobDescription(std::make_unique<TaskJobDescription>(task, payload));
+  std::string header;
+  std::string msg_payload;
+  if (!JobMessage::serializeMsg(msg, header, msg_payload)) {
+    logger_->warn(utl::DST, 30, "Serializing task {} failed", task);
+    return false;
+  }
+  asio::io_service io_service;
+  dst::socket sock(io_service);
+  std::string error_msg;
+  bool sent = false;
+  int tries = 0;
+  while (!sent && tries++ < MAX_TRIES) {
+    try {
+      sock.connect(tcp::endpoint(ip::address::from_string(ip), port));
+    } catch (const boost::system::system_error& ex) {
+      error_msg = ex.what();
+      continue;
+    }
+    sent = sendMsg(sock, header, msg_payload, error_msg);
+    if (!sent) {
+      sock.close();
+    }
+  }
+  if (!sent) {
+    logger_->warn(utl::DST,
+                  31,
+                  "Sending task {} failed with message \"{}\"",
+                  task,
+                  error_msg);
+    return false;
+  }
+  // Results are streamed back as they are produced and the last message
+  // carries no description, only the status of the task.
+  bool success = false;
+  std::string frame;
+  boost::system::error_code error;
+  while (readFrame(sock, frame, error)) {
+    JobMessage result;
+    if (!JobMessage::deserializeMsg(result, frame.data(), frame.size())) {
+      break;
+    }
+    auto desc = dynamic_cast<TaskJobDescription*>(result.getJobDescription());
+    if (desc == nullptr) {
+      success = result.getJobType() == JobMessage::SUCCESS;
+      break;
+    }
+    on_result(desc->getPayload());
+  }
+  sock.close();
+  if (!success) {
+    logger_->warn(utl::DST, 32, "Task {} failed", task);
+  }
+  return success;
+}
+
+void Distributed::runTask(JobMessage& msg, socket& sock)
+{
+  JobMessage status(JobMessage::ERROR);
+  auto desc = dynamic_cast<TaskJobDescription*>(msg.getJobDescription());
+  if (desc == nullptr) {
+    logger_->warn(utl::DST, 33, "Received a task without a description");
+  } else if (auto it = task_handlers_.find(desc->getTask());
+             it == task_handlers_.end()) {
+    logger_->warn(
+        utl::DST, 34, "No handler registered for task {}", desc->getTask());
+  } else {
+    auto send_result = [this, &sock](const std::string& result) {
+      JobMessage reply(JobMessage::SUCCESS);
+      reply.setJobDescription(
+          std::make_unique<TaskJobDescription>("", result));
+      return sendResult(reply, sock);
+    };
+    if (it->second(desc->getPayload(), send_result)) {
+      status.setJobType(JobMessage::SUCCESS);
+    }
+  }
+  sendResult(status, sock);
+  sock.close();
+}
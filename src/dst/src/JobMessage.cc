@@ -28,32 +28,110 @@
 
 #include "dst/JobMessage.h"
 
-#include <boost/archive/text_iarchive.hpp>
-#include <boost/archive/text_oarchive.hpp>
+#include <zlib.h>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/unique_ptr.hpp>
-#include <sstream>
+#include <cstring>
+#include <streambuf>
 
 #include "dst/BalancerJobDescription.h"
 
 using namespace dst;
 
-template <class Archive>
-inline bool is_loading(const Archive& ar)
+namespace {
+
+// Appends everything written to it to a string, avoiding the extra copy
+// std::ostringstream::str() makes.
+class StringOutBuf : public std::streambuf
+{
+ public:
+  explicit StringOutBuf(std::string& str) : str_(str) {}
+
+ protected:
+  int_type overflow(int_type ch) override
+  {
+    if (ch != traits_type::eof()) {
+      str_.push_back(traits_type::to_char_type(ch));
+    }
+    return ch;
+  }
+  std::streamsize xsputn(const char* s, std::streamsize n) override
+  {
+    str_.append(s, n);
+    return n;
+  }
+
+ private:
+  std::string& str_;
+};
+
+// Reads directly from a memory block without copying it.
+class MemoryInBuf : public std::streambuf
 {
-  return std::is_same<typename Archive::is_loading, boost::mpl::true_>::value;
+ public:
+  MemoryInBuf(const char* data, size_t size)
+  {
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+};
+
+void writeHeader(std::string& header, uint64_t payload_size, uint64_t raw_size)
+{
+  header.resize(sizeof(payload_size) + sizeof(raw_size));
+  std::memcpy(header.data(), &payload_size, sizeof(uint64_t));
+  std::memcpy(header.data() + sizeof(uint64_t), &raw_size, sizeof(uint64_t));
 }
 
+void readHeader(const char* header, uint64_t& payload_size, uint64_t& raw_size)
+{
+  std::memcpy(&payload_size, header, sizeof(uint64_t));
+  std::memcpy(&raw_size, header + sizeof(uint64_t), sizeof(uint64_t));
+}
+
+}  // namespace
+
 template <class Archive>
 void JobMessage::serialize(Archive& ar, const unsigned int version)
 {
   (ar) & msg_type_;
   (ar) & job_type_;
+  (ar) & job_size_;
   (ar) & desc_;
-  if (!is_loading(ar)) {
-    std::string eop = EOP;
-    (ar) & eop;
+}
+
+bool JobMessage::serializeMsg(JobMessage& msg,
+                              std::string& header,
+                              std::string& payload)
+{
+  payload.clear();
+  try {
+    StringOutBuf buf(payload);
+    boost::archive::binary_oarchive archive(buf);
+    archive << msg;
+  } catch (const boost::archive::archive_exception& e) {
+    return false;
   }
+  const uint64_t raw_size = payload.size();
+  if (raw_size >= COMPRESSION_THRESHOLD) {
+    uLongf compressed_size = compressBound(raw_size);
+    std::string compressed(compressed_size, '\0');
+    if (compress2(reinterpret_cast<Bytef*>(compressed.data()),
+                  &compressed_size,
+                  reinterpret_cast<const Bytef*>(payload.data()),
+                  raw_size,
+                  Z_BEST_SPEED)
+            == Z_OK
+        && compressed_size < raw_size) {
+      compressed.resize(compressed_size);
+      payload.swap(compressed);
+    }
+  }
+  writeHeader(header, payload.size(), raw_size);
+  return true;
 }
 
 bool JobMessage::serializeMsg(SerializeType type,
@@ -61,22 +139,60 @@ bool JobMessage::serializeMsg(SerializeType type,
                               std::string& str)
 {
   if (type == WRITE) {
-    try {
-      std::ostringstream oarchive_stream;
-      boost::archive::text_oarchive archive(oarchive_stream);
-      archive << msg;
-      str = oarchive_stream.str();
-    } catch (const boost::archive::archive_exception& e) {
+    std::string payload;
+    if (!serializeMsg(msg, str, payload)) {
       return false;
     }
-  } else {
-    try {
-      std::istringstream iarchive_stream(str);
-      boost::archive::text_iarchive archive(iarchive_stream);
-      archive >> msg;
-    } catch (const boost::archive::archive_exception& e) {
+    str += payload;
+    return true;
+  }
+  return deserializeMsg(msg, str.data(), str.size());
+}
+
+std::size_t JobMessage::frameSize(const char* header)
+{
+  uint64_t payload_size;
+  uint64_t raw_size;
+  readHeader(header, payload_size, raw_size);
+  if (payload_size == 0 || raw_size < payload_size) {
+    return 0;
+  }
+  return HEADER_SIZE + payload_size;
+}
+
+bool JobMessage::deserializeMsg(JobMessage& msg, const char* data, size_t size)
+{
+  if (size < HEADER_SIZE) {
+    return false;
+  }
+  const std::size_t frame_size = frameSize(data);
+  if (frame_size == 0 || frame_size > size) {
+    return false;
+  }
+  uint64_t payload_size;
+  uint64_t raw_size;
+  readHeader(data, payload_size, raw_size);
+  const char* payload = data + HEADER_SIZE;
+  std::string uncompressed;
+  if (raw_size != payload_size) {
+    uncompressed.resize(raw_size);
+    uLongf uncompressed_size = raw_size;
+    if (uncompress(reinterpret_cast<Bytef*>(uncompressed.data()),
+                   &uncompressed_size,
+                   reinterpret_cast<const Bytef*>(payload),
+                   payload_size)
+            != Z_OK
+        || uncompressed_size != raw_size) {
       return false;
     }
+    payload = uncompressed.data();
+  }
+  try {
+    MemoryInBuf buf(payload, raw_size);
+    boost::archive::binary_iarchive archive(buf);
+    archive >> msg;
+  } catch (const boost::archive::archive_exception& e) {
+    return false;
   }
   return true;
-}
\ No newline at end of file
+}
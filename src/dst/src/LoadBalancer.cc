@@ -28,8 +28,10 @@
 
 #include "LoadBalancer.h"
 
+#include <algorithm>
 #include <boost/bind/bind.hpp>
 #include <boost/thread/thread.hpp>
+#include <limits>
 
 #include "utl/Logger.h"
 
@@ -41,14 +43,13 @@ void LoadBalancer::start_accept()
 {
   if (jobs_ != 0 && jobs_ % 100 == 0) {
     logger_->info(utl::DST, 7, "Processed {} jobs", jobs_);
-    auto copy = workers_;
-    while (!copy.empty()) {
-      auto worker = copy.top();
-      logger_->report("Worker {}/{} handled {} jobs",
+    std::lock_guard<std::mutex> lock(workers_mutex_);
+    for (const auto& worker : workers_) {
+      logger_->report("Worker {}/{} handled {} jobs ({:.3f}s per unit)",
                       worker.ip,
                       worker.port,
-                      worker.priority);
-      copy.pop();
+                      worker.jobs,
+                      worker.seconds_per_work);
     }
   }
   jobs_++;
@@ -114,52 +115,103 @@ bool LoadBalancer::addWorker(const std::string& ip, unsigned short port)
     }
   }
   if (validWorkerState) {
-    workers_.push(worker(ip::address::from_string(ip), port, 0));
+    workers_.emplace_back(ip::address::from_string(ip), port, 0);
   }
   return validWorkerState;
 }
-void LoadBalancer::updateWorker(const ip::address& ip, unsigned short port)
+LoadBalancer::worker* LoadBalancer::findWorker(const ip::address& ip,
+                                               unsigned short port)
 {
-  std::lock_guard<std::mutex> lock(workers_mutex_);
-  std::priority_queue<worker, std::vector<worker>, CompareWorker> newQueue;
-  while (!workers_.empty()) {
-    auto worker = workers_.top();
-    workers_.pop();
+  for (auto& worker : workers_) {
     if (worker.ip == ip && worker.port == port) {
-      worker.priority--;
+      return &worker;
     }
-    newQueue.push(worker);
   }
-  workers_.swap(newQueue);
+  return nullptr;
 }
-void LoadBalancer::getNextWorker(ip::address& ip, unsigned short& port)
+
+double LoadBalancer::expectedCompletion(const worker& w,
+                                        double job_size,
+                                        double default_rate) const
+{
+  const double rate
+      = w.seconds_per_work > 0.0 ? w.seconds_per_work : default_rate;
+  return (w.pending_work + job_size) * rate * (1.0 + w.penalty);
+}
+
+void LoadBalancer::updateWorker(const ip::address& ip,
+                                unsigned short port,
+                                double job_size,
+                                double seconds)
 {
   std::lock_guard<std::mutex> lock(workers_mutex_);
-  if (!workers_.empty()) {
-    worker w = workers_.top();
-    workers_.pop();
-    ip = w.ip;
-    port = w.port;
-    if (w.priority != std::numeric_limits<unsigned short>::max()) {
-      w.priority++;
+  worker* w = findWorker(ip, port);
+  if (w == nullptr) {
+    return;
+  }
+  if (w->priority > 0) {
+    w->priority--;
+  }
+  w->pending_work = std::max(0.0, w->pending_work - job_size);
+  if (seconds > 0.0 && job_size > 0.0) {
+    const double sample = seconds / job_size;
+    if (w->seconds_per_work == 0.0) {
+      w->seconds_per_work = sample;
+    } else {
+      w->seconds_per_work = latency_smoothing_ * sample
+                            + (1.0 - latency_smoothing_) * w->seconds_per_work;
     }
-    workers_.push(w);
+    w->penalty /= 2;
   }
 }
 
-void LoadBalancer::punishWorker(const ip::address& ip, unsigned short port)
+void LoadBalancer::getNextWorker(ip::address& ip,
+                                 unsigned short& port,
+                                 double job_size)
 {
   std::lock_guard<std::mutex> lock(workers_mutex_);
-  std::priority_queue<worker, std::vector<worker>, CompareWorker> newQueue;
-  while (!workers_.empty()) {
-    auto worker = workers_.top();
-    workers_.pop();
-    if (worker.ip == ip && worker.port == port) {
-      worker.priority = worker.priority == 0 ? 2 : worker.priority * 2;
+  if (workers_.empty()) {
+    return;
+  }
+
+  // Workers without a measurement are assumed to be average
+  double rate_sum = 0.0;
+  int measured = 0;
+  for (const auto& w : workers_) {
+    if (w.seconds_per_work > 0.0) {
+      rate_sum += w.seconds_per_work;
+      measured++;
     }
-    newQueue.push(worker);
   }
-  workers_.swap(newQueue);
+  const double default_rate = measured > 0 ? rate_sum / measured : 1.0;
+
+  worker* best = nullptr;
+  double best_time = 0.0;
+  for (auto& w : workers_) {
+    const double time = expectedCompletion(w, job_size, default_rate);
+    if (best == nullptr || time < best_time
+        || (time == best_time && w.priority < best->priority)) {
+      best = &w;
+      best_time = time;
+    }
+  }
+
+  ip = best->ip;
+  port = best->port;
+  if (best->priority != std::numeric_limits<unsigned short>::max()) {
+    best->priority++;
+  }
+  best->jobs++;
+  best->pending_work += job_size;
+}
+
+void LoadBalancer::punishWorker(const ip::address& ip, unsigned short port)
+{
+  std::lock_guard<std::mutex> lock(workers_mutex_);
+  worker* w = findWorker(ip, port);
+  if (w != nullptr) {
+    w->penalty = w->penalty == 0.0 ? 2.0 : w->penalty * 2;
+  }
 }
 
 void LoadBalancer::removeWorker(const ip::address& ip,
@@ -169,16 +221,12 @@ void LoadBalancer::removeWorker(const ip::address& ip,
   if (lock) {
     workers_mutex_.lock();
   }
-  std::priority_queue<worker, std::vector<worker>, CompareWorker> newQueue;
-  while (!workers_.empty()) {
-    auto worker = workers_.top();
-    workers_.pop();
-    if (worker.ip == ip && worker.port == port) {
-      continue;
-    }
-    newQueue.push(worker);
-  }
-  workers_.swap(newQueue);
+  workers_.erase(std::remove_if(workers_.begin(),
+                                workers_.end(),
+                                [&](const worker& w) {
+                                  return w.ip == ip && w.port == port;
+                                }),
+                 workers_.end());
   if (lock) {
     workers_mutex_.unlock();
   }
@@ -33,7 +33,6 @@
 #include <boost/thread/thread.hpp>
 #include <cstdint>
 #include <mutex>
-#include <queue>
 #include <vector>
 
 #include "BalancerConnection.h"
@@ -58,19 +57,35 @@ class LoadBalancer
                unsigned short port = 1234);
   ~LoadBalancer();
   bool addWorker(const std::string& ip, unsigned short port);
-  void updateWorker(const ip::address& ip, unsigned short port);
-  void getNextWorker(ip::address& ip, unsigned short& port);
+  // Marks a job of the given size as finished on the worker.  A positive
+  // duration in seconds updates the worker's latency estimate.
+  void updateWorker(const ip::address& ip,
+                    unsigned short port,
+                    double job_size = 1.0,
+                    double seconds = 0.0);
+  // Picks the worker with the shortest expected completion time for a job
+  // of the given size and accounts the job to it.
+  void getNextWorker(ip::address& ip,
+                     unsigned short& port,
+                     double job_size = 1.0);
   void removeWorker(const ip::address& ip,
                     unsigned short port,
                     bool lock = true);
   void punishWorker(const ip::address& ip, unsigned short port);
 
  private:
+  // Weight of the newest sample in the latency moving average
+  static constexpr double latency_smoothing_ = 0.3;
+
   struct worker
   {
     ip::address ip;
     unsigned short port;
-    unsigned short priority;
+    unsigned short priority;  // outstanding jobs
+    uint32_t jobs = 0;        // jobs handed out in total
+    double pending_work = 0.0;
+    double penalty = 0.0;           // grows when the worker fails
+    double seconds_per_work = 0.0;  // moving average, 0 until measured
     worker(ip::address ipIn, unsigned short portIn, unsigned short priorityIn)
         : ip(ipIn), port(portIn), priority(priorityIn)
     {
@@ -80,19 +95,17 @@ class LoadBalancer
       return (ip == rhs.ip && port == rhs.port && priority == rhs.priority);
     }
   };
-  struct CompareWorker
-  {
-    bool operator()(worker const& w1, worker const& w2)
-    {
-      return w1.priority > w2.priority;
-    }
-  };
+
+  double expectedCompletion(const worker& w,
+                            double job_size,
+                            double default_rate) const;
+  worker* findWorker(const ip::address& ip, unsigned short port);
 
   Distributed* dist_;
   tcp::acceptor acceptor_;
   asio::io_service* service;
   utl::Logger* logger_;
-  std::priority_queue<worker, std::vector<worker>, CompareWorker> workers_;
+  std::vector<worker> workers_;
   std::mutex workers_mutex_;
   std::unique_ptr<asio::thread_pool> pool_;
   std::mutex pool_mutex_;
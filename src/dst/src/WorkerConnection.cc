@@ -57,28 +57,54 @@ tcp::socket& WorkerConnection::socket()
 
 void WorkerConnection::start()
 {
-  async_read_until(
-      sock_,
-      in_packet_,
-      JobMessage::EOP,
-      [me = shared_from_this()](boost::system::error_code const& ec,
-                                std::size_t bytes_xfer) {
-        me->handle_read(ec, bytes_xfer);
-      });
+  async_read(sock_,
+             in_packet_,
+             asio::transfer_exactly(JobMessage::HEADER_SIZE),
+             [me = shared_from_this()](boost::system::error_code const& ec,
+                                       std::size_t bytes_xfer) {
+               me->handle_header(ec, bytes_xfer);
+             });
+}
+
+void WorkerConnection::handle_header(boost::system::error_code const& err,
+                                     size_t bytes_transferred)
+{
+  if (err) {
+    handle_read(err, bytes_transferred);
+    return;
+  }
+  const auto header = static_cast<const char*>(in_packet_.data().data());
+  const std::size_t frame_size = JobMessage::frameSize(header);
+  if (frame_size == 0) {
+    logger_->warn(utl::DST,
+                  41,
+                  "Received malformed msg header from port {}",
+                  sock_.remote_endpoint().port());
+    boost::system::error_code error;
+    asio::write(sock_, asio::buffer("0"), error);
+    sock_.close();
+    return;
+  }
+  async_read(sock_,
+             in_packet_,
+             asio::transfer_exactly(frame_size - JobMessage::HEADER_SIZE),
+             [me = shared_from_this()](boost::system::error_code const& ec,
+                                       std::size_t bytes_xfer) {
+               me->handle_read(ec, me->in_packet_.size());
+             });
 }
 
 void WorkerConnection::handle_read(boost::system::error_code const& err,
                                    size_t bytes_transferred)
 {
   if (!err) {
-    std::string data{buffers_begin(in_packet_.data()),
-                     buffers_begin(in_packet_.data()) + bytes_transferred};
+    const auto data = static_cast<const char*>(in_packet_.data().data());
     boost::system::error_code error;
-    if (!JobMessage::serializeMsg(JobMessage::READ, msg_, data)) {
+    if (!JobMessage::deserializeMsg(msg_, data, bytes_transferred)) {
       logger_->warn(utl::DST,
                     41,
-                    "Received malformed msg {} from port {}",
-                    data,
+                    "Received malformed msg of {} bytes from port {}",
+                    bytes_transferred,
                     sock_.remote_endpoint().port());
       asio::write(sock_, asio::buffer("0"), error);
       sock_.close();
@@ -108,6 +134,16 @@ void WorkerConnection::handle_read(boost::system::error_code const& err,
         }
         break;
       }
+      case JobMessage::PARTITIONING: {
+        for (auto& cb : dist_->getCallBacks()) {
+          cb->onPartitionJobReceived(msg_, sock_);
+        }
+        break;
+      }
+      case JobMessage::TASK: {
+        dist_->runTask(msg_, sock_);
+        break;
+      }
       default:
         logger_->warn(utl::DST,
                       5,
@@ -49,6 +49,8 @@ class WorkerConnection : public boost::enable_shared_from_this<WorkerConnection>
                    Worker* worker);
   tcp::socket& socket();
   void start();
+  void handle_header(boost::system::error_code const& err,
+                     size_t bytes_transferred);
   void handle_read(boost::system::error_code const& err,
                    size_t bytes_transferred);
   Worker* getWorker() const { return worker_; }
@@ -53,6 +53,9 @@ class HelperCallBack : public dst::JobCallBack
   void onGRDRInitJobReceived(dst::JobMessage& msg, dst::socket& sock) override
   {
   }
+  void onPartitionJobReceived(dst::JobMessage& msg, dst::socket& sock) override
+  {
+  }
 
  private:
   dst::Distributed* dist_;
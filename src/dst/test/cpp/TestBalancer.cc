@@ -108,4 +108,43 @@ BOOST_AUTO_TEST_CASE(test_default)
   // history i.e have invalid state.
   BOOST_TEST(balancer->addWorker(local_ip, worker_port_2) == false);
 }
+
+BOOST_AUTO_TEST_CASE(test_latency)
+{
+  utl::Logger* logger = new utl::Logger();
+  Distributed* dist = new Distributed(logger);
+  string local_ip = "127.0.0.1";
+  unsigned short balancer_port = 5565;
+  unsigned short worker_port_1 = 5566;
+  unsigned short worker_port_2 = 5567;
+  asio::io_service io_service;
+  LoadBalancer* balancer = new LoadBalancer(
+      dist, io_service, logger, local_ip.c_str(), "", balancer_port);
+  const auto ip = asio::ip::address::from_string(local_ip);
+
+  balancer->addWorker(local_ip, worker_port_1);
+  balancer->addWorker(local_ip, worker_port_2);
+  asio::ip::address address;
+  unsigned short port;
+  balancer->getNextWorker(address, port);
+  BOOST_TEST(port == worker_port_1);
+  balancer->getNextWorker(address, port);
+  BOOST_TEST(port == worker_port_2);
+
+  // Worker 2 is four times faster so it takes jobs until its queue is
+  // expected to take as long as a single job on worker 1.
+  balancer->updateWorker(ip, worker_port_1, 1.0, 4.0);
+  balancer->updateWorker(ip, worker_port_2, 1.0, 1.0);
+  for (int i = 0; i < 3; i++) {
+    balancer->getNextWorker(address, port);
+    BOOST_TEST(port == worker_port_2);
+  }
+  balancer->getNextWorker(address, port);
+  BOOST_TEST(port == worker_port_1);
+
+  // A large job goes to the worker that will finish it first
+  balancer->updateWorker(ip, worker_port_1, 1.0, 4.0);
+  balancer->getNextWorker(address, port, 8.0);
+  BOOST_TEST(port == worker_port_2);
+}
 BOOST_AUTO_TEST_SUITE_END()
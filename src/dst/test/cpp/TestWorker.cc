@@ -6,6 +6,7 @@
 #include <boost/test/included/unit_test.hpp>
 #include <boost/thread/thread.hpp>
 #include <string>
+#include <vector>
 
 #include "HelperCallBack.h"
 #include "Worker.h"
@@ -36,4 +37,44 @@ BOOST_AUTO_TEST_CASE(test_default)
   BOOST_TEST(result.getJobType() == JobMessage::JobType::SUCCESS);
 }
 
+BOOST_AUTO_TEST_CASE(test_task)
+{
+  utl::Logger* logger = new utl::Logger();
+  Distributed* dist = new Distributed(logger);
+  string local_ip = "127.0.0.1";
+  unsigned short port = 1237;
+
+  // Echoes every character of the payload as a separate result.
+  dist->addTaskHandler(
+      "split",
+      [](const string& payload,
+         const Distributed::TaskResultSender& send_result) {
+        for (char c : payload) {
+          if (!send_result(string(1, c))) {
+            return false;
+          }
+        }
+        return true;
+      });
+  dist->addTaskHandler(
+      "fail",
+      [](const string& payload,
+         const Distributed::TaskResultSender& send_result) { return false; });
+
+  Worker* worker = new Worker(dist, logger, local_ip.c_str(), port);
+  boost::thread t(boost::bind(&Worker::run, worker));
+
+  vector<string> results;
+  auto collect = [&results](const string& result) {
+    results.push_back(result);
+  };
+  BOOST_TEST(dist->sendTask("split", "abc", local_ip.c_str(), port, collect));
+  BOOST_TEST(results == vector<string>({"a", "b", "c"}));
+
+  results.clear();
+  BOOST_TEST(!dist->sendTask("fail", "abc", local_ip.c_str(), port, collect));
+  BOOST_TEST(results.empty());
+  BOOST_TEST(!dist->sendTask("none", "abc", local_ip.c_str(), port, collect));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -37,7 +37,9 @@
 #include <boost/lexical_cast.hpp>
 
 #include "graphics.h"
+#include "odb/dbBlockIndex.h"
 #include "odb/dbShape.h"
+#include "utl/ThreadPool.h"
 
 namespace fin {
 
@@ -69,6 +71,102 @@ struct DensityFillLayerConfig
   DensityFillShapesConfig non_opc;
 };
 
+// Edge length of the tiles the fill area is split into
+constexpr int tile_size_um = 100;
+
+// A fill shape and its mask color (0 for single mask layers)
+struct Fill
+{
+  Rect rect;
+  int mask;
+};
+
+// One window of the fill area.  Tiles are filled independently of each
+// other so they only need the shapes within a halo of their window.
+struct FillTile
+{
+  std::vector<Rect> non_fills;      // non-fill shapes near the window
+  std::vector<Rect> non_opc_fills;  // non-OPC fills, from any tile, near it
+  Polygon90Set non_fill;
+  std::vector<Fill> fills;  // the fills made by the last pass
+  int num_areas = 0;        // the number of areas filled by the last pass
+};
+
+// Splits the fill area into square tiles.  Each window stops a gap short
+// of the next tile's so fills in neighboring tiles are always far enough
+// apart.  The halo is how far a shape outside a window can affect it.
+class TileGrid
+{
+ public:
+  TileGrid(const Rect& bounds, int tile_size, int gap_x, int gap_y, int halo)
+      : bounds_(bounds),
+        tile_size_(tile_size),
+        gap_x_(gap_x),
+        gap_y_(gap_y),
+        halo_(halo),
+        cols_(std::max(1, ceilDiv(bounds.dx(), tile_size))),
+        rows_(std::max(1, ceilDiv(bounds.dy(), tile_size)))
+  {
+  }
+
+  int size() const { return cols_ * rows_; }
+
+  Rect window(int i) const
+  {
+    const int col = i % cols_;
+    const int row = i / cols_;
+    const int x_lo = bounds_.xMin() + col * tile_size_;
+    const int y_lo = bounds_.yMin() + row * tile_size_;
+    int x_hi = std::min(x_lo + tile_size_, bounds_.xMax());
+    int y_hi = std::min(y_lo + tile_size_, bounds_.yMax());
+    if (col < cols_ - 1) {
+      x_hi -= gap_x_;
+    }
+    if (row < rows_ - 1) {
+      y_hi -= gap_y_;
+    }
+    return Rect(x_lo, y_lo, x_hi, y_hi);
+  }
+
+  Rect halo(int i) const
+  {
+    Rect rect = window(i);
+    rect.bloat(halo_, rect);
+    return rect;
+  }
+
+  // Calls visitor(i) for every tile whose halo may overlap rect
+  template <typename Visitor>
+  void visitNear(const Rect& rect, Visitor visitor) const
+  {
+    const int col_lo = toIndex(rect.xMin() - halo_ - bounds_.xMin(), cols_);
+    const int col_hi = toIndex(rect.xMax() + halo_ - bounds_.xMin(), cols_);
+    const int row_lo = toIndex(rect.yMin() - halo_ - bounds_.yMin(), rows_);
+    const int row_hi = toIndex(rect.yMax() + halo_ - bounds_.yMin(), rows_);
+    for (int row = row_lo; row <= row_hi; ++row) {
+      for (int col = col_lo; col <= col_hi; ++col) {
+        visitor(row * cols_ + col);
+      }
+    }
+  }
+
+ private:
+  static int ceilDiv(int a, int b) { return (a + b - 1) / b; }
+
+  int toIndex(int offset, int count) const
+  {
+    return std::clamp(offset / tile_size_, 0, count - 1);
+  }
+
+  const Rect bounds_;
+  const int tile_size_;
+  const int gap_x_;
+  const int gap_y_;
+  const int halo_;
+  const int cols_;
+  const int rows_;
+};
+
 // Make a boost polygon representing a rectangle
 static Polygon90 makeRect(int x_lo, int y_lo, int x_hi, int y_hi)
 {
@@ -204,10 +302,10 @@ void DensityFill::loadConfig(const char* cfg_filename, dbTech* tech)
   readAndExpandLayers(tech, tree);
 }
 
-// Insert into polygon_set any part of given shape on the given layer (shape may
+// Insert into rects any part of given shape on the given layer (shape may
 // be a via)
 static void insertShape(const dbShape& shape,
-                        Polygon90Set& polygon_set,
+                        std::vector<Rect>& rects,
                         dbTechLayer* layer)
 {
   auto type = shape.getType();
@@ -233,36 +331,32 @@ static void insertShape(const dbShape& shape,
       dbShape::getViaBoxes(shape, boxes);
       for (auto& box : boxes) {
         if (box.getTechLayer() == layer) {
-          polygon_set.insert(
-              makeRect(box.xMin(), box.yMin(), box.xMax(), box.yMax()));
+          rects.push_back(box.getBox());
         }
       }
       break;
     }
     case dbShape::SEGMENT:
       if (shape.getTechLayer() == layer) {
-        polygon_set.insert(
-            makeRect(shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax()));
+        rects.push_back(shape.getBox());
       }
       break;
     case dbShape::TECH_VIA_BOX:
     case dbShape::VIA_BOX:
       if (shape.getTechLayer() == layer) {
-        polygon_set.insert(
-            makeRect(shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax()));
+        rects.push_back(shape.getBox());
       }
       break;
   }
 }
 
-// Build a polygon set out of all the non-fill shape on the given layer
-// including wires, special wires, and instances' pins & OBS
-static Polygon90Set orNonFills(dbBlock* block, dbTechLayer* layer)
+// Collect the regular wire shapes on the given layer.  Unlike special
+// wires and instances these aren't in the block's spatial index.
+static std::vector<Rect> getWireShapes(dbBlock* block, dbTechLayer* layer)
 {
-  Polygon90Set non_fill;  // The result
-  dbShape shape;          // Shared temp
+  std::vector<Rect> rects;  // The result
+  dbShape shape;            // Shared temp
 
-  // Get shapes from regular wires
   dbWireShapeItr shapes;
   for (auto net : block->getNets()) {
     dbWire* wire = net->getWire();
@@ -270,40 +364,53 @@ static Polygon90Set orNonFills(dbBlock* block, dbTechLayer* layer)
       continue;
     }
     for (shapes.begin(wire); shapes.next(shape);) {
-      insertShape(shape, non_fill, layer);
+      insertShape(shape, rects, layer);
     }
   }
 
+  return rects;
+}
+
+// Collect the special wire and instance (pins & OBS) shapes on the given
+// layer that are near rect.
+static void getIndexedShapes(dbBlockIndex* index,
+                             dbTechLayer* layer,
+                             const Rect& rect,
+                             std::vector<Rect>& rects)
+{
+  dbShape shape;  // Shared temp
+
   // Get shapes from special wires
   std::vector<dbShape> via_shapes;
-  for (auto net : block->getNets()) {
-    for (auto swire : net->getSWires()) {
-      for (auto sbox : swire->getWires()) {
-        if (sbox->isVia()) {
-          dbVia* via = sbox->getBlockVia();
-          Rect rect = sbox->getBox();
-          shape.setVia(via, rect);
-          dbShape::getViaBoxes(shape, via_shapes);
-          for (auto& via_shape : via_shapes) {
-            insertShape(via_shape, non_fill, layer);
-          }
-        } else if (sbox->getTechLayer() == layer) {
-          non_fill.insert(
-              makeRect(sbox->xMin(), sbox->yMin(), sbox->xMax(), sbox->yMax()));
-        }
+  for (dbSBox* sbox : index->findSBoxes(layer, rect)) {
+    if (sbox->isVia()) {
+      dbVia* via = sbox->getBlockVia();
+      shape.setVia(via, sbox->getBox());
+      dbShape::getViaBoxes(shape, via_shapes);
+      for (auto& via_shape : via_shapes) {
+        insertShape(via_shape, rects, layer);
       }
+    } else if (sbox->getTechLayer() == layer) {
+      rects.push_back(sbox->getBox());
     }
   }
 
   // Get shapes from instances
   dbInstShapeItr insts(/* expand_vias */ false);
-  for (auto inst : block->getInsts()) {
+  for (dbInst* inst : index->findInsts(rect)) {
     for (insts.begin(inst, dbInstShapeItr::ALL); insts.next(shape);) {
-      insertShape(shape, non_fill, layer);
+      insertShape(shape, rects, layer);
     }
   }
+}
 
-  return non_fill;
+static Polygon90Set makeSet(const std::vector<Rect>& rects)
+{
+  Polygon90Set set;
+  for (const Rect& rect : rects) {
+    set.insert(makeRect(rect.xMin(), rect.yMin(), rect.xMax(), rect.yMax()));
+  }
+  return set;
 }
 
 static std::pair<int, int> getSpacing(dbTechLayer* layer,
@@ -343,16 +450,14 @@ static void prune(Polygon90Set& fill_area,
 }
 
 // Fill a polygon (area) on the given layer using the given configuration.
-// Num_masks is used to color the generated fills.
-// filled_area, if given, is an OR of the generated fills without bloating
+// Num_masks is used to color the generated fills, which are appended to
+// fills.
 static void fillPolygon(const Polygon90& area,
                         dbTechLayer* layer,
-                        dbBlock* block,
                         const DensityFillShapesConfig& cfg,
                         int num_masks,
-                        bool needs_opc,
                         Graphics* graphics,
-                        Polygon90Set* filled_area = nullptr)
+                        std::vector<Fill>& fills)
 {
   // Convert the area polygon to a polygon set as we will remove areas
   // filled by one fill shape from consideration by future shapes,
@@ -410,15 +515,15 @@ static void fillPolygon(const Polygon90& area,
       }
 
       // Intersect fills with the sub area and keep only whole fill shapes
-      Polygon90Set fills = all_fills & sub_fill_area;
-      keep(fills, w * h, w * h, w - 1, w, h - 1, h);
+      Polygon90Set sub_fills = all_fills & sub_fill_area;
+      keep(sub_fills, w * h, w * h, w - 1, w, h - 1, h);
 
-      Polygon90Set tmp_fills(fills);
+      Polygon90Set tmp_fills(sub_fills);
       all_iter_fills += bloat(tmp_fills, space_x, space_x, space_y, space_y);
 
-      // Insert fills into the db
+      // Color the fills
       std::vector<Rectangle> polygons;
-      fills.get_rectangles(polygons);
+      sub_fills.get_rectangles(polygons);
       const int num_mask = std::max(num_masks, 1);
       int cnt = 0;
       for (auto& f : polygons) {
@@ -428,14 +533,7 @@ static void fillPolygon(const Polygon90& area,
         } else {
           mask = cnt++ % num_mask + 1;
         }
-        auto x_lo = xl(f);
-        auto y_lo = yl(f);
-        auto x_hi = xh(f);
-        auto y_hi = yh(f);
-        dbFill::create(block, needs_opc, mask, layer, x_lo, y_lo, x_hi, y_hi);
-        if (filled_area) {
-          *filled_area += makeRect(x_lo, y_lo, x_hi, y_hi);
-        }
+        fills.push_back({Rect(xl(f), yl(f), xh(f), yh(f)), mask});
       }
     }
     // Remove filled area from use by future shapes
@@ -443,48 +541,111 @@ static void fillPolygon(const Polygon90& area,
   }
 }
 
-// Fill the given layer
+// Fill the area of one tile, leaving the result in tile.fills
+static void fillTile(FillTile& tile,
+                     Polygon90Set& fill_area,
+                     dbTechLayer* layer,
+                     const DensityFillShapesConfig& cfg,
+                     int num_masks,
+                     Graphics* graphics)
+{
+  prune(fill_area, layer, cfg, graphics);
+
+  std::vector<Polygon90> polygons;
+  fill_area.get(polygons);
+  tile.num_areas = polygons.size();
+  tile.fills.clear();
+  for (auto& polygon : polygons) {
+    fillPolygon(polygon, layer, cfg, num_masks, graphics, tile.fills);
+  }
+}
+
+static int countAreas(const std::vector<FillTile>& tiles)
+{
+  int count = 0;
+  for (const FillTile& tile : tiles) {
+    count += tile.num_areas;
+  }
+  return count;
+}
+
+// Fill the given layer.  The fill bounds are split into tiles whose fill
+// polygons are computed in parallel; the dbFills are then created
+// serially in tile order.
 void DensityFill::fillLayer(dbBlock* block,
                             dbTechLayer* layer,
                             const odb::Rect& fill_bounds_rect)
 {
   logger_->info(FIN, 3, "Filling layer {}.", layer->getConstName());
 
-  Polygon90Set non_fill = orNonFills(block, layer);
-
-  auto fill_bounds = makeRect(fill_bounds_rect.xMin(),
-                              fill_bounds_rect.yMin(),
-                              fill_bounds_rect.xMax(),
-                              fill_bounds_rect.yMax());
-
   const DensityFillLayerConfig& cfg = layers_[layer];
 
-  std::vector<Polygon90> polygons;
-
-  // Do non-OPC fill
-  Polygon90Set fill_area
-      = fill_bounds - (non_fill + cfg.non_opc.space_to_non_fill);
-
-  if (graphics_) {
-    graphics_->status("Non-OPC Area");
-    graphics_->drawPolygon90Set(fill_area);
+  auto [gap_x, gap_y] = getSpacing(layer, cfg.non_opc);
+  int halo
+      = std::max(cfg.non_opc.space_to_non_fill, cfg.non_opc.space_to_fill);
+  if (cfg.has_opc) {
+    auto [opc_gap_x, opc_gap_y] = getSpacing(layer, cfg.opc);
+    gap_x = std::max(gap_x, opc_gap_x);
+    gap_y = std::max(gap_y, opc_gap_y);
+    halo = std::max(halo, cfg.opc.space_to_non_fill);
+  }
+  const int tile_size = tile_size_um * block->getDbUnitsPerMicron();
+  const TileGrid grid(fill_bounds_rect, tile_size, gap_x, gap_y, halo);
+  std::vector<FillTile> tiles(grid.size());
+
+  // Gather the non-fill shapes around each tile.  This reads the db so
+  // it is done serially.
+  for (const Rect& rect : getWireShapes(block, layer)) {
+    grid.visitNear(rect, [&](int i) { tiles[i].non_fills.push_back(rect); });
+  }
+  dbBlockIndex* index = block->getSpatialIndex();
+  for (int i = 0; i < grid.size(); ++i) {
+    getIndexedShapes(index, layer, grid.halo(i), tiles[i].non_fills);
   }
 
-  prune(fill_area, layer, cfg.non_opc, graphics_.get());
+  // The graphics can only draw one tile at a time
+  Graphics* graphics = graphics_.get();
+  const int max_threads = graphics ? 1 : 0;
+  auto pool = utl::ThreadPool::global();
 
-  fill_area.get(polygons);
-  logger_->info(FIN, 9, "Filling {} areas with non-OPC fill.", polygons.size());
+  // Do non-OPC fill
+  pool->parallelFor(
+      grid.size(),
+      [&](int i) {
+        FillTile& tile = tiles[i];
+        tile.non_fill = makeSet(tile.non_fills);
+        Polygon90Set fill_area
+            = makeSet({grid.window(i)})
+              - (tile.non_fill + cfg.non_opc.space_to_non_fill);
+
+        if (graphics) {
+          graphics->status("Non-OPC Area");
+          graphics->drawPolygon90Set(fill_area);
+        }
 
-  Polygon90Set non_opc_fill_area;
-  for (auto& polygon : polygons) {
-    fillPolygon(polygon,
-                layer,
-                block,
-                cfg.non_opc,
-                cfg.num_masks,
-                false,
-                graphics_.get(),
-                &non_opc_fill_area);
+        fillTile(tile, fill_area, layer, cfg.non_opc, cfg.num_masks, graphics);
+      },
+      FIN,
+      max_threads);
+
+  logger_->info(
+      FIN, 9, "Filling {} areas with non-OPC fill.", countAreas(tiles));
+  for (const FillTile& tile : tiles) {
+    for (const Fill& fill : tile.fills) {
+      const Rect& rect = fill.rect;
+      dbFill::create(block,
+                     false,
+                     fill.mask,
+                     layer,
+                     rect.xMin(),
+                     rect.yMin(),
+                     rect.xMax(),
+                     rect.yMax());
+      if (cfg.has_opc) {
+        grid.visitNear(
+            rect, [&](int i) { tiles[i].non_opc_fills.push_back(rect); });
+      }
+    }
   }
   logger_->info(FIN, 4, "Total fills: {}.", block->getFills().size());
 
@@ -492,31 +653,42 @@ void DensityFill::fillLayer(dbBlock* block,
     return;
   }
 
-  Polygon90Set opc_fill_area
-      = fill_bounds - (non_fill + cfg.opc.space_to_non_fill)
-        - (non_opc_fill_area + cfg.non_opc.space_to_fill);
-
-  if (graphics_) {
-    graphics_->status("OPC Area");
-    graphics_->drawPolygon90Set(opc_fill_area);
-  }
-
-  prune(opc_fill_area, layer, cfg.opc, graphics_.get());
+  // Do OPC fill
+  pool->parallelFor(
+      grid.size(),
+      [&](int i) {
+        FillTile& tile = tiles[i];
+        Polygon90Set fill_area
+            = makeSet({grid.window(i)})
+              - (tile.non_fill + cfg.opc.space_to_non_fill)
+              - (makeSet(tile.non_opc_fills) + cfg.non_opc.space_to_fill);
+
+        if (graphics) {
+          graphics->status("OPC Area");
+          graphics->drawPolygon90Set(fill_area);
+        }
 
-  polygons.clear();
-  opc_fill_area.get(polygons);
-  logger_->info(FIN, 5, "Filling {} areas with OPC fill.", polygons.size());
-  for (auto& polygon : polygons) {
-    fillPolygon(
-        polygon, layer, block, cfg.opc, cfg.num_masks, true, graphics_.get());
+        fillTile(tile, fill_area, layer, cfg.opc, cfg.num_masks, graphics);
+      },
+      FIN,
+      max_threads);
+
+  logger_->info(FIN, 5, "Filling {} areas with OPC fill.", countAreas(tiles));
+  for (const FillTile& tile : tiles) {
+    for (const Fill& fill : tile.fills) {
+      const Rect& rect = fill.rect;
+      dbFill::create(block,
+                     true,
+                     fill.mask,
+                     layer,
+                     rect.xMin(),
+                     rect.yMin(),
+                     rect.xMax(),
+                     rect.yMax());
+    }
   }
 
   logger_->info(FIN, 6, "Total fills: {}.", block->getFills().size());
-
-  if (graphics_) {
-    graphics_->status("OPC Area");
-    graphics_->drawPolygon90Set(opc_fill_area);
-  }
 }
 
 // Fill the design according to the given cfg file
@@ -34,6 +34,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace odb {
@@ -48,6 +49,10 @@ namespace grt {
 class GlobalRouter;
 }
 
+namespace par {
+class PartitionMgr;
+}
+
 namespace rsz {
 class Resizer;
 }
@@ -78,6 +83,7 @@ class Replace
   void init(odb::dbDatabase* odb,
             rsz::Resizer* resizer,
             grt::GlobalRouter* router,
+            par::PartitionMgr* partitionMgr,
             utl::Logger* logger);
   void reset();
 
@@ -114,7 +120,14 @@ class Replace
   void setPadLeft(int padding);
   void setPadRight(int padding);
 
+  void setNumThreads(int threads);
+
   void setForceCPU(bool force_cpu);
+
+  // Multilevel mode places the clustered netlist level by level before the
+  // flat Nesterov placement.
+  void setMultilevelMode(bool mode);
+  void setMultilevelCoarsestSize(int size);
   void setTimingDrivenMode(bool mode);
 
   void setSkipIoMode(bool mode);
@@ -125,6 +138,7 @@ class Replace
 
   void setRoutabilityMaxBloatIter(int iter);
   void setRoutabilityMaxInflationIter(int iter);
+  void setRoutabilityGrtPeriod(int period);
 
   void setRoutabilityTargetRcMetric(float rc);
   void setRoutabilityInflationRatioCoef(float ratio);
@@ -134,6 +148,13 @@ class Replace
 
   void addTimingNetWeightOverflow(int overflow);
   void setTimingNetWeightMax(float max);
+  void setTimingIncrementalMode(bool mode);
+  void setTimingNetMoveThreshold(int threshold);
+
+  // The Nesterov state is written to file every interval iterations.
+  // Resume continues from that file when it exists.
+  void setCheckpoint(const std::string& file, int interval);
+  void setCheckpointResume(bool resume);
 
   void setDebug(int pause_iterations,
                 int update_iterations,
@@ -143,10 +164,12 @@ class Replace
 
  private:
   bool initNesterovPlace();
+  bool doMultilevelPlace();
 
   odb::dbDatabase* db_;
   rsz::Resizer* rs_;
   grt::GlobalRouter* fr_;
+  par::PartitionMgr* pm_;
   utl::Logger* log_;
 
   std::shared_ptr<PlacerBaseCommon> pbc_;
@@ -165,6 +188,9 @@ class Replace
   int initialPlaceMaxFanout_;
   float initialPlaceNetWeightScale_;
   bool forceCPU_;
+  int numThreads_;
+  bool multilevelMode_;
+  int multilevelCoarsestSize_;
 
   int total_placeable_insts_;
 
@@ -190,16 +216,24 @@ class Replace
 
   int routabilityMaxBloatIter_;
   int routabilityMaxInflationIter_;
+  int routabilityGrtPeriod_;
 
   float timingNetWeightMax_;
+  // dbu; negative uses the site height
+  int timingNetMoveThreshold_;
 
   bool timingDrivenMode_;
+  bool timingIncrementalMode_;
   bool routabilityDrivenMode_;
   bool uniformTargetDensityMode_;
   bool skipIoMode_;
 
   std::vector<int> timingNetWeightOverflows_;
 
+  std::string checkpointFile_;
+  int checkpointInterval_;
+  bool checkpointResume_;
+
   // temp variable; OpenDB should have these values.
   int padLeft_;
   int padRight_;
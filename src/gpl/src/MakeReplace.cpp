@@ -62,6 +62,7 @@ void initReplace(OpenRoad* openroad)
   openroad->getReplace()->init(openroad->getDb(),
                                openroad->getResizer(),
                                openroad->getGlobalRouter(),
+                               openroad->getPartitionMgr(),
                                openroad->getLogger());
 }
 
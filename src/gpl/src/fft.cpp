@@ -33,87 +33,260 @@
 
 #include "fft.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
 
+#ifdef ENABLE_FFTW
+#include <fftw3.h>
+#endif
+
 #define REPLACE_FFT_PI 3.141592653589793238462L
 
 namespace gpl {
 
-FFT::FFT()
-    : binDensity_(nullptr),
-      electroPhi_(nullptr),
-      electroForceX_(nullptr),
-      electroForceY_(nullptr),
-      binCntX_(0),
-      binCntY_(0),
-      binSizeX_(0),
-      binSizeY_(0)
+namespace {
+
+// The bundled Ooura transforms; the default backend.
+class OouraBackend : public FFTBackend
 {
-}
+ public:
+  OouraBackend(int binCntX, int binCntY);
 
-FFT::FFT(int binCntX, int binCntY, int binSizeX, int binSizeY)
-    : binCntX_(binCntX),
-      binCntY_(binCntY),
-      binSizeX_(binSizeX),
-      binSizeY_(binSizeY)
+  void dct2d(float* a) override;
+  void idct2d(float* a) override;
+  void idsct2d(float* a) override;
+  void idcst2d(float* a) override;
+
+ private:
+  // Ooura's 2-D routines take an array of row pointers.
+  float** rows(float* a);
+
+  int binCntX_;
+  int binCntY_;
+  std::vector<float*> rows_;
+
+  // cos/sin table (prev: w_2d)
+  // length:  max(binCntX, binCntY) * 3 / 2
+  std::vector<float> csTable_;
+
+  // work area for bit reversal (prev: ip)
+  // length: round(sqrt( max(binCntX_, binCntY_) )) + 2
+  std::vector<int> workArea_;
+
+  // work area for the column transforms. Passing NULL makes fftsg2d
+  // malloc/free it on every call; 16 covers any FFT2D_MAX_THREADS.
+  std::vector<float> t_;
+};
+
+OouraBackend::OouraBackend(int binCntX, int binCntY)
+    : binCntX_(binCntX), binCntY_(binCntY)
 {
-  init();
+  rows_.resize(binCntX_, nullptr);
+  csTable_.resize(std::max(binCntX_, binCntY_) * 3 / 2, 0);
+  workArea_.resize(round(sqrt(std::max(binCntX_, binCntY_))) + 2, 0);
+  t_.resize(4 * binCntX_ * 16, 0);
 }
 
-FFT::~FFT()
+float** OouraBackend::rows(float* a)
 {
-  using std::vector;
   for (int i = 0; i < binCntX_; i++) {
-    delete[] binDensity_[i];
-    delete[] electroPhi_[i];
-    delete[] electroForceX_[i];
-    delete[] electroForceY_[i];
+    rows_[i] = a + static_cast<size_t>(i) * binCntY_;
   }
-  delete[] binDensity_;
-  delete[] electroPhi_;
-  delete[] electroForceX_;
-  delete[] electroForceY_;
+  return rows_.data();
+}
+
+void OouraBackend::dct2d(float* a)
+{
+  ddct2d(binCntX_,
+         binCntY_,
+         -1,
+         rows(a),
+         t_.data(),
+         workArea_.data(),
+         csTable_.data());
+}
+
+void OouraBackend::idct2d(float* a)
+{
+  ddct2d(binCntX_,
+         binCntY_,
+         1,
+         rows(a),
+         t_.data(),
+         workArea_.data(),
+         csTable_.data());
+}
 
-  csTable_.clear();
-  wx_.clear();
-  wxSquare_.clear();
-  wy_.clear();
-  wySquare_.clear();
+void OouraBackend::idsct2d(float* a)
+{
+  ddsct2d(binCntX_,
+          binCntY_,
+          1,
+          rows(a),
+          t_.data(),
+          workArea_.data(),
+          csTable_.data());
+}
 
-  workArea_.clear();
+void OouraBackend::idcst2d(float* a)
+{
+  ddcst2d(binCntX_,
+          binCntY_,
+          1,
+          rows(a),
+          t_.data(),
+          workArea_.data(),
+          csTable_.data());
 }
 
-void FFT::init()
+#ifdef ENABLE_FFTW
+// FFTW (or MKL through its FFTW3 interface) r2r transforms.
+// Plans are created once and reused for every iteration.
+//
+// FFTW's REDFT10 is twice Ooura's DCT per dimension. For the inverse
+// transforms FFTW's REDFT01/RODFT01 weigh the X_0 / X_n term once and
+// the others twice, while Ooura weighs all terms once. Ooura also
+// keeps the sine coefficient n at index 0, where FFTW expects it last.
+class FftwBackend : public FFTBackend
 {
-  binDensity_ = new float*[binCntX_];
-  electroPhi_ = new float*[binCntX_];
-  electroForceX_ = new float*[binCntX_];
-  electroForceY_ = new float*[binCntX_];
+ public:
+  FftwBackend(int binCntX, int binCntY, int numThreads);
+  ~FftwBackend() override;
 
-  for (int i = 0; i < binCntX_; i++) {
-    binDensity_[i] = new float[binCntY_];
-    electroPhi_[i] = new float[binCntY_];
-    electroForceX_[i] = new float[binCntY_];
-    electroForceY_[i] = new float[binCntY_];
+  void dct2d(float* a) override;
+  void idct2d(float* a) override;
+  void idsct2d(float* a) override;
+  void idcst2d(float* a) override;
+
+ private:
+  void loadInverse(const float* a, bool sineX, bool sineY);
+  void store(float* a) const;
+
+  int binCntX_;
+  int binCntY_;
+  float* in_;
+  float* out_;
+  fftwf_plan dct_;
+  fftwf_plan idct_;
+  fftwf_plan idsct_;
+  fftwf_plan idcst_;
+};
+
+FftwBackend::FftwBackend(int binCntX, int binCntY, int numThreads)
+    : binCntX_(binCntX), binCntY_(binCntY)
+{
+  const size_t size = static_cast<size_t>(binCntX_) * binCntY_;
+  in_ = fftwf_alloc_real(size);
+  out_ = fftwf_alloc_real(size);
+
+  fftwf_init_threads();
+  fftwf_plan_with_nthreads(std::max(numThreads, 1));
 
+  dct_ = fftwf_plan_r2r_2d(
+      binCntX_, binCntY_, in_, out_, FFTW_REDFT10, FFTW_REDFT10, FFTW_MEASURE);
+  idct_ = fftwf_plan_r2r_2d(
+      binCntX_, binCntY_, in_, out_, FFTW_REDFT01, FFTW_REDFT01, FFTW_MEASURE);
+  idsct_ = fftwf_plan_r2r_2d(
+      binCntX_, binCntY_, in_, out_, FFTW_RODFT01, FFTW_REDFT01, FFTW_MEASURE);
+  idcst_ = fftwf_plan_r2r_2d(
+      binCntX_, binCntY_, in_, out_, FFTW_REDFT01, FFTW_RODFT01, FFTW_MEASURE);
+}
+
+FftwBackend::~FftwBackend()
+{
+  fftwf_destroy_plan(dct_);
+  fftwf_destroy_plan(idct_);
+  fftwf_destroy_plan(idsct_);
+  fftwf_destroy_plan(idcst_);
+  fftwf_free(in_);
+  fftwf_free(out_);
+}
+
+void FftwBackend::loadInverse(const float* a, bool sineX, bool sineY)
+{
+  for (int i = 0; i < binCntX_; i++) {
+    const int ii = (sineX && i == 0) ? binCntX_ - 1 : (sineX ? i - 1 : i);
+    const float scaleX = (i == 0) ? 2.0f : 1.0f;
     for (int j = 0; j < binCntY_; j++) {
-      binDensity_[i][j] = electroPhi_[i][j] = electroForceX_[i][j]
-          = electroForceY_[i][j] = 0.0f;
+      const int jj = (sineY && j == 0) ? binCntY_ - 1 : (sineY ? j - 1 : j);
+      const float scaleY = (j == 0) ? 2.0f : 1.0f;
+      in_[ii * binCntY_ + jj] = a[i * binCntY_ + j] * scaleX * scaleY;
     }
   }
+}
 
-  csTable_.resize(std::max(binCntX_, binCntY_) * 3 / 2, 0);
+void FftwBackend::store(float* a) const
+{
+  const size_t size = static_cast<size_t>(binCntX_) * binCntY_;
+  for (size_t k = 0; k < size; k++) {
+    a[k] = out_[k] * 0.25f;
+  }
+}
+
+void FftwBackend::dct2d(float* a)
+{
+  std::copy(a, a + static_cast<size_t>(binCntX_) * binCntY_, in_);
+  fftwf_execute(dct_);
+  store(a);
+}
+
+void FftwBackend::idct2d(float* a)
+{
+  loadInverse(a, false, false);
+  fftwf_execute(idct_);
+  store(a);
+}
+
+void FftwBackend::idsct2d(float* a)
+{
+  loadInverse(a, true, false);
+  fftwf_execute(idsct_);
+  store(a);
+}
+
+void FftwBackend::idcst2d(float* a)
+{
+  loadInverse(a, false, true);
+  fftwf_execute(idcst_);
+  store(a);
+}
+#endif
+
+}  // namespace
+
+FFT::FFT()
+    : binCntX_(0), binCntY_(0), binSizeX_(0), binSizeY_(0), numThreads_(1)
+{
+}
+
+FFT::FFT(int binCntX, int binCntY, int binSizeX, int binSizeY, int numThreads)
+    : binCntX_(binCntX),
+      binCntY_(binCntY),
+      binSizeX_(binSizeX),
+      binSizeY_(binSizeY),
+      numThreads_(numThreads)
+{
+  init();
+}
+
+FFT::~FFT() = default;
+
+void FFT::init()
+{
+  const size_t size = static_cast<size_t>(binCntX_) * binCntY_;
+  binDensity_.resize(size, 0);
+  electroPhi_.resize(size, 0);
+  electroForceX_.resize(size, 0);
+  electroForceY_.resize(size, 0);
 
   wx_.resize(binCntX_, 0);
   wxSquare_.resize(binCntX_, 0);
   wy_.resize(binCntY_, 0);
   wySquare_.resize(binCntY_, 0);
 
-  workArea_.resize(round(sqrt(std::max(binCntX_, binCntY_))) + 2, 0);
-
   for (int i = 0; i < binCntX_; i++) {
     wx_[i]
         = REPLACE_FFT_PI * static_cast<float>(i) / static_cast<float>(binCntX_);
@@ -126,47 +299,46 @@ void FFT::init()
              / static_cast<float>(binSizeX_);
     wySquare_[i] = wy_[i] * wy_[i];
   }
+
+#ifdef ENABLE_FFTW
+  backend_ = std::make_unique<FftwBackend>(binCntX_, binCntY_, numThreads_);
+#else
+  backend_ = std::make_unique<OouraBackend>(binCntX_, binCntY_);
+#endif
 }
 
 void FFT::updateDensity(int x, int y, float density)
 {
-  binDensity_[x][y] = density;
+  binDensity_[x * binCntY_ + y] = density;
 }
 
 std::pair<float, float> FFT::getElectroForce(int x, int y) const
 {
-  return std::make_pair(electroForceX_[x][y], electroForceY_[x][y]);
+  const int idx = x * binCntY_ + y;
+  return std::make_pair(electroForceX_[idx], electroForceY_[idx]);
 }
 
 float FFT::getElectroPhi(int x, int y) const
 {
-  return electroPhi_[x][y];
+  return electroPhi_[x * binCntY_ + y];
 }
 
 using namespace std;
 
 void FFT::doFFT()
 {
-  ddct2d(binCntX_,
-         binCntY_,
-         -1,
-         binDensity_,
-         NULL,
-         (int*) &workArea_[0],
-         (float*) &csTable_[0]);
+  backend_->dct2d(binDensity_.data());
 
   for (int i = 0; i < binCntX_; i++) {
-    binDensity_[i][0] *= 0.5;
+    binDensity_[i * binCntY_] *= 0.5;
   }
 
   for (int i = 0; i < binCntY_; i++) {
-    binDensity_[0][i] *= 0.5;
+    binDensity_[i] *= 0.5;
   }
 
-  for (int i = 0; i < binCntX_; i++) {
-    for (int j = 0; j < binCntY_; j++) {
-      binDensity_[i][j] *= 4.0 / binCntX_ / binCntY_;
-    }
+  for (float& density : binDensity_) {
+    density *= 4.0 / binCntX_ / binCntY_;
   }
 
   for (int i = 0; i < binCntX_; i++) {
@@ -177,7 +349,8 @@ void FFT::doFFT()
       float wy = wy_[j];
       float wy2 = wySquare_[j];
 
-      float density = binDensity_[i][j];
+      const int idx = i * binCntY_ + j;
+      float density = binDensity_[idx];
       float phi = 0;
       float electroX = 0, electroY = 0;
 
@@ -199,33 +372,15 @@ void FFT::doFFT()
         electroX = phi * wx;
         electroY = phi * wy;
       }
-      electroPhi_[i][j] = phi;
-      electroForceX_[i][j] = electroX;
-      electroForceY_[i][j] = electroY;
+      electroPhi_[idx] = phi;
+      electroForceX_[idx] = electroX;
+      electroForceY_[idx] = electroY;
     }
   }
   // Inverse DCT
-  ddct2d(binCntX_,
-         binCntY_,
-         1,
-         electroPhi_,
-         NULL,
-         (int*) &workArea_[0],
-         (float*) &csTable_[0]);
-  ddsct2d(binCntX_,
-          binCntY_,
-          1,
-          electroForceX_,
-          NULL,
-          (int*) &workArea_[0],
-          (float*) &csTable_[0]);
-  ddcst2d(binCntX_,
-          binCntY_,
-          1,
-          electroForceY_,
-          NULL,
-          (int*) &workArea_[0],
-          (float*) &csTable_[0]);
+  backend_->idct2d(electroPhi_.data());
+  backend_->idsct2d(electroForceX_.data());
+  backend_->idcst2d(electroForceY_.data());
 }
 
 }  // namespace gpl
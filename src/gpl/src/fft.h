@@ -33,15 +33,39 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 namespace gpl {
 
+// 2-D real transforms used by the electrostatic solver.
+// All arrays are contiguous binCntX x binCntY, row-major in x
+// (a[i * binCntY + j]), and follow the conventions of Ooura's
+// ddct2d / ddsct2d / ddcst2d (unnormalized).
+class FFTBackend
+{
+ public:
+  virtual ~FFTBackend() = default;
+
+  // forward DCT
+  virtual void dct2d(float* a) = 0;
+  // inverse DCT
+  virtual void idct2d(float* a) = 0;
+  // inverse DST in x, inverse DCT in y
+  virtual void idsct2d(float* a) = 0;
+  // inverse DCT in x, inverse DST in y
+  virtual void idcst2d(float* a) = 0;
+};
+
 class FFT
 {
  public:
   FFT();
-  FFT(int binCntX, int binCntY, int binSizeX, int binSizeY);
+  FFT(int binCntX,
+      int binCntY,
+      int binSizeX,
+      int binSizeY,
+      int numThreads = 1);
   ~FFT();
 
   // input func
@@ -55,16 +79,12 @@ class FFT
   float getElectroPhi(int x, int y) const;
 
  private:
-  // 2D array; width: binCntX_, height: binCntY_;
-  // No hope to use Vector at this moment...
-  float** binDensity_;
-  float** electroPhi_;
-  float** electroForceX_;
-  float** electroForceY_;
-
-  // cos/sin table (prev: w_2d)
-  // length:  max(binCntX, binCntY) * 3 / 2
-  std::vector<float> csTable_;
+  // 2D arrays; width: binCntX_, height: binCntY_;
+  // stored contiguously as [x * binCntY_ + y]
+  std::vector<float> binDensity_;
+  std::vector<float> electroPhi_;
+  std::vector<float> electroForceX_;
+  std::vector<float> electroForceY_;
 
   // wx. length:  binCntX_
   std::vector<float> wx_;
@@ -74,14 +94,13 @@ class FFT
   std::vector<float> wy_;
   std::vector<float> wySquare_;
 
-  // work area for bit reversal (prev: ip)
-  // length: round(sqrt( max(binCntX_, binCntY_) )) + 2
-  std::vector<int> workArea_;
+  std::unique_ptr<FFTBackend> backend_;
 
   int binCntX_;
   int binCntY_;
   int binSizeX_;
   int binSizeY_;
+  int numThreads_;
 
   void init();
 };
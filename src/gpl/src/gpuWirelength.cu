@@ -0,0 +1,330 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cuda_runtime.h>
+#include <climits>
+#include <thrust/copy.h>
+#include <thrust/device_vector.h>
+
+#include "gpuWirelength.h"
+#include "utl/Logger.h"
+
+namespace gpl {
+using utl::GPL;
+
+class GpuWirelengthData
+{
+ public:
+  // connectivity; uploaded once
+  thrust::device_vector<int> netPinStart;
+  thrust::device_vector<int> netPins;
+  thrust::device_vector<int> pinNet;
+  thrust::device_vector<int> cellPinStart;
+  thrust::device_vector<int> cellPins;
+
+  // per call inputs
+  thrust::device_vector<int> pinX;
+  thrust::device_vector<int> pinY;
+  thrust::device_vector<float> netWeight;
+
+  // WA terms; 4 per pin and 8 per net
+  thrust::device_vector<float> pinExp;
+  thrust::device_vector<float> netSum;
+
+  thrust::device_vector<float> pinGrad;
+  thrust::device_vector<float> cellGrad;
+};
+
+namespace {
+
+constexpr int threadsPerBlock = 256;
+
+int numBlocks(int n)
+{
+  return (n + threadsPerBlock - 1) / threadsPerBlock;
+}
+
+// same approximation as fastExp in nesterovBase.cpp
+__device__ float deviceFastExp(float a)
+{
+  a = 1.0f + a / 1024.0f;
+  for (int i = 0; i < 10; i++) {
+    a *= a;
+  }
+  return a;
+}
+
+// One thread per net: net box, then the WA exp terms of its pins.
+// pinExp: minX, maxX, minY, maxY; 0 marks a pin that is not considered.
+// netSum: expMinX, xExpMinX, expMaxX, xExpMaxX, and the same for y.
+__global__ void netExpKernel(int numNets,
+                             const int* netPinStart,
+                             const int* netPins,
+                             const int* pinX,
+                             const int* pinY,
+                             float wlCoeffX,
+                             float wlCoeffY,
+                             float minForceBar,
+                             float* pinExp,
+                             float* netSum)
+{
+  const int net = blockIdx.x * blockDim.x + threadIdx.x;
+  if (net >= numNets) {
+    return;
+  }
+
+  int lx = INT_MAX, ly = INT_MAX;
+  int ux = INT_MIN, uy = INT_MIN;
+  for (int k = netPinStart[net]; k < netPinStart[net + 1]; k++) {
+    const int pin = netPins[k];
+    lx = min(lx, pinX[pin]);
+    ly = min(ly, pinY[pin]);
+    ux = max(ux, pinX[pin]);
+    uy = max(uy, pinY[pin]);
+  }
+
+  float sum[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  for (int k = netPinStart[net]; k < netPinStart[net + 1]; k++) {
+    const int pin = netPins[k];
+    const float cx = pinX[pin];
+    const float cy = pinY[pin];
+    const float expArg[4] = {(lx - pinX[pin]) * wlCoeffX,
+                             (pinX[pin] - ux) * wlCoeffX,
+                             (ly - pinY[pin]) * wlCoeffY,
+                             (pinY[pin] - uy) * wlCoeffY};
+    const float coord[4] = {cx, cx, cy, cy};
+    for (int t = 0; t < 4; t++) {
+      float value = 0;
+      if (expArg[t] > minForceBar) {
+        value = deviceFastExp(expArg[t]);
+        sum[2 * t] += value;
+        sum[2 * t + 1] += coord[t] * value;
+      }
+      pinExp[4 * pin + t] = value;
+    }
+  }
+  for (int t = 0; t < 8; t++) {
+    netSum[8 * net + t] = sum[t];
+  }
+}
+
+// One thread per pin: equation (4.13) of JingWei's thesis, scaled by
+// the net weight.
+__global__ void pinGradKernel(int numPins,
+                              const int* pinNet,
+                              const int* pinX,
+                              const int* pinY,
+                              const float* netWeight,
+                              const float* pinExp,
+                              const float* netSum,
+                              float wlCoeffX,
+                              float wlCoeffY,
+                              float* pinGrad)
+{
+  const int pin = blockIdx.x * blockDim.x + threadIdx.x;
+  if (pin >= numPins) {
+    return;
+  }
+  const int net = pinNet[pin];
+  const float* exps = pinExp + 4 * pin;
+  const float* sums = netSum + 8 * net;
+  const float cx = pinX[pin];
+  const float cy = pinY[pin];
+
+  float gradientMinX = 0, gradientMaxX = 0;
+  float gradientMinY = 0, gradientMaxY = 0;
+  if (exps[0] > 0) {
+    gradientMinX = (sums[0] * (exps[0] * (1.0f - wlCoeffX * cx))
+                    + wlCoeffX * exps[0] * sums[1])
+                   / (sums[0] * sums[0]);
+  }
+  if (exps[1] > 0) {
+    gradientMaxX = (sums[2] * (exps[1] * (1.0f + wlCoeffX * cx))
+                    - wlCoeffX * exps[1] * sums[3])
+                   / (sums[2] * sums[2]);
+  }
+  if (exps[2] > 0) {
+    gradientMinY = (sums[4] * (exps[2] * (1.0f - wlCoeffY * cy))
+                    + wlCoeffY * exps[2] * sums[5])
+                   / (sums[4] * sums[4]);
+  }
+  if (exps[3] > 0) {
+    gradientMaxY = (sums[6] * (exps[3] * (1.0f + wlCoeffY * cy))
+                    - wlCoeffY * exps[3] * sums[7])
+                   / (sums[6] * sums[6]);
+  }
+
+  pinGrad[2 * pin] = (gradientMinX - gradientMaxX) * netWeight[net];
+  pinGrad[2 * pin + 1] = (gradientMinY - gradientMaxY) * netWeight[net];
+}
+
+// One thread per cell: sum the pin gradients in a fixed order, so the
+// result does not depend on scheduling.
+__global__ void cellGradKernel(int numCells,
+                               const int* cellPinStart,
+                               const int* cellPins,
+                               const float* pinGrad,
+                               float* cellGrad)
+{
+  const int cell = blockIdx.x * blockDim.x + threadIdx.x;
+  if (cell >= numCells) {
+    return;
+  }
+  float gradX = 0, gradY = 0;
+  for (int k = cellPinStart[cell]; k < cellPinStart[cell + 1]; k++) {
+    const int pin = cellPins[k];
+    gradX += pinGrad[2 * pin];
+    gradY += pinGrad[2 * pin + 1];
+  }
+  cellGrad[2 * cell] = gradX;
+  cellGrad[2 * cell + 1] = gradY;
+}
+
+template <typename T>
+T* raw(thrust::device_vector<T>& vec)
+{
+  return thrust::raw_pointer_cast(vec.data());
+}
+
+}  // namespace
+
+GpuWirelength::GpuWirelength(const std::vector<int>& netPinStart,
+                             const std::vector<int>& netPins,
+                             const std::vector<int>& cellPinStart,
+                             const std::vector<int>& cellPins,
+                             utl::Logger* logger)
+    : data_(std::make_unique<GpuWirelengthData>()),
+      log_(logger),
+      numNets_(netPinStart.size() - 1),
+      numPins_(netPins.size()),
+      numCells_(cellPinStart.size() - 1)
+{
+  std::vector<int> pinNet(numPins_, 0);
+  for (int net = 0; net < numNets_; net++) {
+    for (int k = netPinStart[net]; k < netPinStart[net + 1]; k++) {
+      pinNet[netPins[k]] = net;
+    }
+  }
+
+  data_->netPinStart = netPinStart;
+  data_->netPins = netPins;
+  data_->pinNet = pinNet;
+  data_->cellPinStart = cellPinStart;
+  data_->cellPins = cellPins;
+
+  data_->pinX.resize(numPins_);
+  data_->pinY.resize(numPins_);
+  data_->netWeight.resize(numNets_);
+  data_->pinExp.resize(4 * numPins_);
+  data_->netSum.resize(8 * numNets_);
+  data_->pinGrad.resize(2 * numPins_);
+  data_->cellGrad.resize(2 * numCells_);
+}
+
+GpuWirelength::~GpuWirelength() = default;
+
+void GpuWirelength::computeGradients(const std::vector<int>& pinX,
+                                     const std::vector<int>& pinY,
+                                     const std::vector<float>& netWeights,
+                                     float wlCoeffX,
+                                     float wlCoeffY,
+                                     float minWireLengthForceBar,
+                                     std::vector<FloatPoint>& cellGrads)
+{
+  thrust::copy(pinX.begin(), pinX.end(), data_->pinX.begin());
+  thrust::copy(pinY.begin(), pinY.end(), data_->pinY.begin());
+  thrust::copy(netWeights.begin(), netWeights.end(), data_->netWeight.begin());
+
+  if (numNets_ > 0) {
+    netExpKernel<<<numBlocks(numNets_), threadsPerBlock>>>(
+        numNets_,
+        raw(data_->netPinStart),
+        raw(data_->netPins),
+        raw(data_->pinX),
+        raw(data_->pinY),
+        wlCoeffX,
+        wlCoeffY,
+        minWireLengthForceBar,
+        raw(data_->pinExp),
+        raw(data_->netSum));
+  }
+  if (numPins_ > 0) {
+    pinGradKernel<<<numBlocks(numPins_), threadsPerBlock>>>(
+        numPins_,
+        raw(data_->pinNet),
+        raw(data_->pinX),
+        raw(data_->pinY),
+        raw(data_->netWeight),
+        raw(data_->pinExp),
+        raw(data_->netSum),
+        wlCoeffX,
+        wlCoeffY,
+        raw(data_->pinGrad));
+  }
+  if (numCells_ > 0) {
+    cellGradKernel<<<numBlocks(numCells_), threadsPerBlock>>>(
+        numCells_,
+        raw(data_->cellPinStart),
+        raw(data_->cellPins),
+        raw(data_->pinGrad),
+        raw(data_->cellGrad));
+  }
+
+  const cudaError_t code = cudaGetLastError();
+  if (code != cudaSuccess) {
+    log_->error(GPL,
+                307,
+                "[CUDA ERROR] {} in wirelength gradient kernels.",
+                cudaGetErrorString(code));
+  }
+
+  // FloatPoint is two packed floats, matching the cellGrad layout
+  static_assert(sizeof(FloatPoint) == 2 * sizeof(float));
+  cellGrads.resize(numCells_);
+  thrust::copy(data_->cellGrad.begin(),
+               data_->cellGrad.end(),
+               reinterpret_cast<float*>(cellGrads.data()));
+}
+
+void GpuWirelength::getWaTerms(std::vector<float>& pinExp,
+                               std::vector<float>& netSum) const
+{
+  pinExp.resize(4 * numPins_);
+  netSum.resize(8 * numNets_);
+  thrust::copy(data_->pinExp.begin(), data_->pinExp.end(), pinExp.begin());
+  thrust::copy(data_->netSum.begin(), data_->netSum.end(), netSum.begin());
+}
+
+}  // namespace gpl
@@ -0,0 +1,91 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "point.h"
+
+namespace utl {
+class Logger;
+}
+
+namespace gpl {
+
+class GpuWirelengthData;
+
+// Computes the weighted-average (WA) wirelength gradient of every GCell
+// on the GPU. The net/pin/cell connectivity is uploaded once; each call
+// only moves the pin locations and net weights in and the per-cell
+// gradients out. Follows the same equations as
+// NesterovBaseCommon::updateWireLengthForceWA/getWireLengthGradientWA.
+class GpuWirelength
+{
+ public:
+  // netPinStart/netPins: CSR of the pins of every net.
+  // cellPinStart/cellPins: CSR of the pins of every cell, in the order
+  // the CPU code sums them.
+  GpuWirelength(const std::vector<int>& netPinStart,
+                const std::vector<int>& netPins,
+                const std::vector<int>& cellPinStart,
+                const std::vector<int>& cellPins,
+                utl::Logger* logger);
+  ~GpuWirelength();
+
+  void computeGradients(const std::vector<int>& pinX,
+                        const std::vector<int>& pinY,
+                        const std::vector<float>& netWeights,
+                        float wlCoeffX,
+                        float wlCoeffY,
+                        float minWireLengthForceBar,
+                        std::vector<FloatPoint>& cellGrads);
+
+  // WA terms of the last computeGradients call.
+  // pinExp: minX, maxX, minY, maxY of every pin; 0 if not considered.
+  // netSum: expMinX, xExpMinX, expMaxX, xExpMaxX and the same for y
+  // of every net.
+  void getWaTerms(std::vector<float>& pinExp,
+                  std::vector<float>& netSum) const;
+
+ private:
+  std::unique_ptr<GpuWirelengthData> data_;
+  utl::Logger* log_;
+  int numNets_;
+  int numPins_;
+  int numCells_;
+};
+
+}  // namespace gpl
@@ -274,6 +274,7 @@ void Graphics::reportSelected()
     auto wlCoeffY = np_->getWireLengthCoefY();
 
     logger_->report("  Wire Length Gradient");
+    nbc_->updateWaVarsFromGpu();
     for (auto& gPin : selected_->gPins()) {
       FloatPoint wlGrad
           = nbc_->getWireLengthGradientPinWA(gPin, wlCoeffX, wlCoeffY);
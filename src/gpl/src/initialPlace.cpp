@@ -33,6 +33,9 @@
 
 #include "initialPlace.h"
 
+#include <omp.h>
+
+#include <algorithm>
 #include <utility>
 
 #include "placerBase.h"
@@ -57,6 +60,7 @@ void InitialPlaceVars::reset()
   netWeightScale = 800.0;
   debug = false;
   forceCPU = false;
+  numThreads = 1;
 }
 
 InitialPlace::InitialPlace() : pbc_(nullptr), log_(nullptr)
@@ -124,6 +128,7 @@ void InitialPlace::doBicgstabPlace()
       if (ipVars_.forceCPU)
         log_->warn(GPL, 251, "CPU solver is forced to be used.");
       error = cpuSparseSolve(ipVars_.maxSolverIter,
+                             ipVars_.numThreads,
                              iter,
                              placeInstForceMatrixX_,
                              fixedInstForceVecX_,
@@ -195,14 +200,21 @@ void InitialPlace::setPlaceInstExtId()
 void InitialPlace::updatePinInfo()
 {
   // reset all MinMax attributes
-  for (auto& pin : pbc_->pins()) {
+  const auto& allPins = pbc_->pins();
+#pragma omp parallel for num_threads(ipVars_.numThreads)
+  for (int i = 0; i < allPins.size(); i++) {
+    Pin* pin = allPins[i];
     pin->unsetMinPinX();
     pin->unsetMinPinY();
     pin->unsetMaxPinX();
     pin->unsetMaxPinY();
   }
 
-  for (auto& net : pbc_->nets()) {
+  // Every pin belongs to a single net, so nets can be marked independently.
+  const auto& nets = pbc_->nets();
+#pragma omp parallel for num_threads(ipVars_.numThreads)
+  for (int i = 0; i < nets.size(); i++) {
+    Net* net = nets[i];
     Pin *pinMinX = nullptr, *pinMinY = nullptr;
     Pin *pinMaxX = nullptr, *pinMaxY = nullptr;
     int lx = INT_MAX, ly = INT_MAX;
@@ -249,6 +261,66 @@ void InitialPlace::updatePinInfo()
   }
 }
 
+// Returns the stored coefficient at (row, col), or nullptr when the
+// sparsity pattern of the (compressed, row major) matrix has no such entry.
+static float* findCoeff(SMatrix& matrix, int row, int col)
+{
+  const int* inner = matrix.innerIndexPtr();
+  const int* begin = inner + matrix.outerIndexPtr()[row];
+  const int* end = inner + matrix.outerIndexPtr()[row + 1];
+  const int* it = std::lower_bound(begin, end, col);
+  if (it == end || *it != col) {
+    return nullptr;
+  }
+  return matrix.valuePtr() + (it - inner);
+}
+
+// Fills the matrix with the sum of the triplets. The B2B pairs change a bit
+// from one iteration to the next, so the existing pattern is reused when it
+// covers every triplet. Otherwise the pattern is extended with the new
+// entries, keeping the old ones as explicit zeros, so that it settles after
+// the first few iterations. Duplicates are summed in list order either way.
+static void fillSparseMatrix(SMatrix& matrix,
+                             const std::vector<const vector<T>*>& lists)
+{
+  bool patternHit = matrix.nonZeros() > 0;
+  if (patternHit) {
+    matrix.coeffs().setZero();
+    for (const vector<T>* list : lists) {
+      for (const T& triplet : *list) {
+        float* coeff = findCoeff(matrix, triplet.row(), triplet.col());
+        if (coeff == nullptr) {
+          patternHit = false;
+          break;
+        }
+        *coeff += triplet.value();
+      }
+      if (!patternHit) {
+        break;
+      }
+    }
+  }
+  if (patternHit) {
+    return;
+  }
+
+  size_t tripletCnt = matrix.nonZeros();
+  for (const vector<T>* list : lists) {
+    tripletCnt += list->size();
+  }
+  vector<T> triplets;
+  triplets.reserve(tripletCnt);
+  for (int row = 0; row < matrix.outerSize(); row++) {
+    for (SMatrix::InnerIterator it(matrix, row); it; ++it) {
+      triplets.emplace_back(row, it.col(), 0.0f);
+    }
+  }
+  for (const vector<T>* list : lists) {
+    triplets.insert(triplets.end(), list->begin(), list->end());
+  }
+  matrix.setFromTriplets(triplets.begin(), triplets.end());
+}
+
 // solve placeInstForceMatrixX_ * xcg_x_ = xcg_b_ and placeInstForceMatrixY_ *
 // ycg_x_ = ycg_b_ eq.
 void InitialPlace::createSparseMatrix()
@@ -259,25 +331,17 @@ void InitialPlace::createSparseMatrix()
   instLocVecY_.resize(placeCnt);
   fixedInstForceVecY_.resize(placeCnt);
 
-  placeInstForceMatrixX_.resize(placeCnt, placeCnt);
-  placeInstForceMatrixY_.resize(placeCnt, placeCnt);
-
-  //
-  // listX and listY is a temporary vector that have tuples, (idx1, idx2, val)
-  //
-  // listX finally becomes placeInstForceMatrixX_
-  // listY finally becomes placeInstForceMatrixY_
-  //
-  // The triplet vector is recommended usages
-  // to fill in SparseMatrix from Eigen docs.
-  //
-
-  vector<T> listX, listY;
-  listX.reserve(1000000);
-  listY.reserve(1000000);
+  // resize() drops the pattern reused from the previous iteration.
+  if (placeInstForceMatrixX_.rows() != placeCnt) {
+    placeInstForceMatrixX_.resize(placeCnt, placeCnt);
+    placeInstForceMatrixY_.resize(placeCnt, placeCnt);
+  }
 
   // initialize vector
-  for (auto& inst : pbc_->placeInsts()) {
+  const auto& placeInsts = pbc_->placeInsts();
+#pragma omp parallel for num_threads(ipVars_.numThreads)
+  for (int i = 0; i < placeInsts.size(); i++) {
+    Instance* inst = placeInsts[i];
     int idx = inst->extId();
 
     instLocVecX_(idx) = inst->cx();
@@ -286,152 +350,181 @@ void InitialPlace::createSparseMatrix()
     fixedInstForceVecX_(idx) = fixedInstForceVecY_(idx) = 0;
   }
 
-  // for each net
-  for (auto& net : pbc_->nets()) {
-    // skip for small nets.
-    if (net->pins().size() <= 1) {
-      continue;
+  //
+  // Each thread collects the terms of a contiguous chunk of nets in its own
+  // triplet lists, (idx1, idx2, val), and force lists, (idx, val). Merging
+  // the chunks in order gives the same sums as a serial pass.
+  //
+  const auto& nets = pbc_->nets();
+  const int numThreads = std::max(1, ipVars_.numThreads);
+  std::vector<B2BTerms> chunkTerms(numThreads);
+#pragma omp parallel num_threads(numThreads)
+  {
+    const int chunk = omp_get_thread_num();
+    const int chunkCnt = omp_get_num_threads();
+    const size_t begin = nets.size() * chunk / chunkCnt;
+    const size_t end = nets.size() * (chunk + 1) / chunkCnt;
+    for (size_t i = begin; i < end; i++) {
+      addNetB2BTerms(nets[i], chunkTerms[chunk]);
     }
+  }
 
-    // escape long time cals on huge fanout.
-    //
-    if (net->pins().size() >= ipVars_.maxFanout) {
-      continue;
+  std::vector<const vector<T>*> listsX, listsY;
+  for (const B2BTerms& terms : chunkTerms) {
+    for (const auto& [idx, force] : terms.forceX) {
+      fixedInstForceVecX_(idx) += force;
+    }
+    for (const auto& [idx, force] : terms.forceY) {
+      fixedInstForceVecY_(idx) += force;
     }
+    listsX.push_back(&terms.listX);
+    listsY.push_back(&terms.listY);
+  }
 
-    float netWeight = ipVars_.netWeightScale / (net->pins().size() - 1);
-    // cout << "net: " << net.net()->getConstName() << endl;
+  fillSparseMatrix(placeInstForceMatrixX_, listsX);
+  fillSparseMatrix(placeInstForceMatrixY_, listsY);
+}
 
-    // foreach two pins in single nets.
-    auto& pins = net->pins();
-    for (int pinIdx1 = 1; pinIdx1 < pins.size(); ++pinIdx1) {
-      Pin* pin1 = pins[pinIdx1];
-      for (int pinIdx2 = 0; pinIdx2 < pinIdx1; ++pinIdx2) {
-        Pin* pin2 = pins[pinIdx2];
+void InitialPlace::addNetB2BTerms(const Net* net, B2BTerms& terms) const
+{
+  // skip for small nets.
+  if (net->pins().size() <= 1) {
+    return;
+  }
 
-        // no need to fill in when instance is same
-        if (pin1->instance() == pin2->instance()) {
-          continue;
+  // escape long time cals on huge fanout.
+  //
+  if (net->pins().size() >= ipVars_.maxFanout) {
+    return;
+  }
+
+  float netWeight = ipVars_.netWeightScale / (net->pins().size() - 1);
+
+  // foreach two pins in single nets.
+  auto& pins = net->pins();
+  for (int pinIdx1 = 1; pinIdx1 < pins.size(); ++pinIdx1) {
+    Pin* pin1 = pins[pinIdx1];
+    for (int pinIdx2 = 0; pinIdx2 < pinIdx1; ++pinIdx2) {
+      Pin* pin2 = pins[pinIdx2];
+
+      // no need to fill in when instance is same
+      if (pin1->instance() == pin2->instance()) {
+        continue;
+      }
+
+      // B2B modeling on min/maxX pins.
+      if (pin1->isMinPinX() || pin1->isMaxPinX() || pin2->isMinPinX()
+          || pin2->isMaxPinX()) {
+        int diffX = abs(pin1->cx() - pin2->cx());
+        float weightX = 0;
+        if (diffX > ipVars_.minDiffLength) {
+          weightX = netWeight / diffX;
+        } else {
+          weightX = netWeight / ipVars_.minDiffLength;
         }
 
-        // B2B modeling on min/maxX pins.
-        if (pin1->isMinPinX() || pin1->isMaxPinX() || pin2->isMinPinX()
-            || pin2->isMaxPinX()) {
-          int diffX = abs(pin1->cx() - pin2->cx());
-          float weightX = 0;
-          if (diffX > ipVars_.minDiffLength) {
-            weightX = netWeight / diffX;
-          } else {
-            weightX = netWeight / ipVars_.minDiffLength;
-          }
-
-          // both pin cames from instance
-          if (pin1->isPlaceInstConnected() && pin2->isPlaceInstConnected()) {
-            const int inst1 = pin1->instance()->extId();
-            const int inst2 = pin2->instance()->extId();
-            // cout << "inst: " << inst1 << " " << inst2 << endl;
-
-            listX.push_back(T(inst1, inst1, weightX));
-            listX.push_back(T(inst2, inst2, weightX));
-
-            listX.push_back(T(inst1, inst2, -weightX));
-            listX.push_back(T(inst2, inst1, -weightX));
-
-            // cout << pin1->cx() << " "
-            //  << pin1->instance()->cx() << endl;
-            fixedInstForceVecX_(inst1)
-                += -weightX
-                   * ((pin1->cx() - pin1->instance()->cx())
-                      - (pin2->cx() - pin2->instance()->cx()));
-
-            fixedInstForceVecX_(inst2)
-                += -weightX
-                   * ((pin2->cx() - pin2->instance()->cx())
-                      - (pin1->cx() - pin1->instance()->cx()));
-          }
-          // pin1 from IO port / pin2 from Instance
-          else if (!pin1->isPlaceInstConnected()
-                   && pin2->isPlaceInstConnected()) {
-            const int inst2 = pin2->instance()->extId();
-            // cout << "inst2: " << inst2 << endl;
-            listX.push_back(T(inst2, inst2, weightX));
-
-            fixedInstForceVecX_(inst2)
-                += weightX
-                   * (pin1->cx() - (pin2->cx() - pin2->instance()->cx()));
-          }
-          // pin1 from Instance / pin2 from IO port
-          else if (pin1->isPlaceInstConnected()
-                   && !pin2->isPlaceInstConnected()) {
-            const int inst1 = pin1->instance()->extId();
-            // cout << "inst1: " << inst1 << endl;
-            listX.push_back(T(inst1, inst1, weightX));
-
-            fixedInstForceVecX_(inst1)
-                += weightX
-                   * (pin2->cx() - (pin1->cx() - pin1->instance()->cx()));
-          }
+        // both pin cames from instance
+        if (pin1->isPlaceInstConnected() && pin2->isPlaceInstConnected()) {
+          const int inst1 = pin1->instance()->extId();
+          const int inst2 = pin2->instance()->extId();
+
+          terms.listX.push_back(T(inst1, inst1, weightX));
+          terms.listX.push_back(T(inst2, inst2, weightX));
+
+          terms.listX.push_back(T(inst1, inst2, -weightX));
+          terms.listX.push_back(T(inst2, inst1, -weightX));
+
+          terms.forceX.emplace_back(
+              inst1,
+              -weightX
+                  * ((pin1->cx() - pin1->instance()->cx())
+                     - (pin2->cx() - pin2->instance()->cx())));
+
+          terms.forceX.emplace_back(
+              inst2,
+              -weightX
+                  * ((pin2->cx() - pin2->instance()->cx())
+                     - (pin1->cx() - pin1->instance()->cx())));
+        }
+        // pin1 from IO port / pin2 from Instance
+        else if (!pin1->isPlaceInstConnected()
+                 && pin2->isPlaceInstConnected()) {
+          const int inst2 = pin2->instance()->extId();
+          terms.listX.push_back(T(inst2, inst2, weightX));
+
+          terms.forceX.emplace_back(
+              inst2,
+              weightX * (pin1->cx() - (pin2->cx() - pin2->instance()->cx())));
+        }
+        // pin1 from Instance / pin2 from IO port
+        else if (pin1->isPlaceInstConnected()
+                 && !pin2->isPlaceInstConnected()) {
+          const int inst1 = pin1->instance()->extId();
+          terms.listX.push_back(T(inst1, inst1, weightX));
+
+          terms.forceX.emplace_back(
+              inst1,
+              weightX * (pin2->cx() - (pin1->cx() - pin1->instance()->cx())));
+        }
+      }
+
+      // B2B modeling on min/maxY pins.
+      if (pin1->isMinPinY() || pin1->isMaxPinY() || pin2->isMinPinY()
+          || pin2->isMaxPinY()) {
+        int diffY = abs(pin1->cy() - pin2->cy());
+        float weightY = 0;
+        if (diffY > ipVars_.minDiffLength) {
+          weightY = netWeight / diffY;
+        } else {
+          weightY = netWeight / ipVars_.minDiffLength;
         }
 
-        // B2B modeling on min/maxY pins.
-        if (pin1->isMinPinY() || pin1->isMaxPinY() || pin2->isMinPinY()
-            || pin2->isMaxPinY()) {
-          int diffY = abs(pin1->cy() - pin2->cy());
-          float weightY = 0;
-          if (diffY > ipVars_.minDiffLength) {
-            weightY = netWeight / diffY;
-          } else {
-            weightY = netWeight / ipVars_.minDiffLength;
-          }
-
-          // both pin cames from instance
-          if (pin1->isPlaceInstConnected() && pin2->isPlaceInstConnected()) {
-            const int inst1 = pin1->instance()->extId();
-            const int inst2 = pin2->instance()->extId();
-
-            listY.push_back(T(inst1, inst1, weightY));
-            listY.push_back(T(inst2, inst2, weightY));
-
-            listY.push_back(T(inst1, inst2, -weightY));
-            listY.push_back(T(inst2, inst1, -weightY));
-
-            fixedInstForceVecY_(inst1)
-                += -weightY
-                   * ((pin1->cy() - pin1->instance()->cy())
-                      - (pin2->cy() - pin2->instance()->cy()));
-
-            fixedInstForceVecY_(inst2)
-                += -weightY
-                   * ((pin2->cy() - pin2->instance()->cy())
-                      - (pin1->cy() - pin1->instance()->cy()));
-          }
-          // pin1 from IO port / pin2 from Instance
-          else if (!pin1->isPlaceInstConnected()
-                   && pin2->isPlaceInstConnected()) {
-            const int inst2 = pin2->instance()->extId();
-            listY.push_back(T(inst2, inst2, weightY));
-
-            fixedInstForceVecY_(inst2)
-                += weightY
-                   * (pin1->cy() - (pin2->cy() - pin2->instance()->cy()));
-          }
-          // pin1 from Instance / pin2 from IO port
-          else if (pin1->isPlaceInstConnected()
-                   && !pin2->isPlaceInstConnected()) {
-            const int inst1 = pin1->instance()->extId();
-            listY.push_back(T(inst1, inst1, weightY));
-
-            fixedInstForceVecY_(inst1)
-                += weightY
-                   * (pin2->cy() - (pin1->cy() - pin1->instance()->cy()));
-          }
+        // both pin cames from instance
+        if (pin1->isPlaceInstConnected() && pin2->isPlaceInstConnected()) {
+          const int inst1 = pin1->instance()->extId();
+          const int inst2 = pin2->instance()->extId();
+
+          terms.listY.push_back(T(inst1, inst1, weightY));
+          terms.listY.push_back(T(inst2, inst2, weightY));
+
+          terms.listY.push_back(T(inst1, inst2, -weightY));
+          terms.listY.push_back(T(inst2, inst1, -weightY));
+
+          terms.forceY.emplace_back(
+              inst1,
+              -weightY
+                  * ((pin1->cy() - pin1->instance()->cy())
+                     - (pin2->cy() - pin2->instance()->cy())));
+
+          terms.forceY.emplace_back(
+              inst2,
+              -weightY
+                  * ((pin2->cy() - pin2->instance()->cy())
+                     - (pin1->cy() - pin1->instance()->cy())));
+        }
+        // pin1 from IO port / pin2 from Instance
+        else if (!pin1->isPlaceInstConnected()
+                 && pin2->isPlaceInstConnected()) {
+          const int inst2 = pin2->instance()->extId();
+          terms.listY.push_back(T(inst2, inst2, weightY));
+
+          terms.forceY.emplace_back(
+              inst2,
+              weightY * (pin1->cy() - (pin2->cy() - pin2->instance()->cy())));
+        }
+        // pin1 from Instance / pin2 from IO port
+        else if (pin1->isPlaceInstConnected()
+                 && !pin2->isPlaceInstConnected()) {
+          const int inst1 = pin1->instance()->extId();
+          terms.listY.push_back(T(inst1, inst1, weightY));
+
+          terms.forceY.emplace_back(
+              inst1,
+              weightY * (pin2->cy() - (pin1->cy() - pin1->instance()->cy())));
         }
       }
     }
   }
-
-  placeInstForceMatrixX_.setFromTriplets(listX.begin(), listX.end());
-  placeInstForceMatrixY_.setFromTriplets(listY.begin(), listY.end());
 }
 
 void InitialPlace::updateCoordi()
@@ -35,6 +35,8 @@
 
 #include <Eigen/SparseCore>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "nesterovPlace.h"
 #include "odb/db.h"
@@ -48,6 +50,7 @@ namespace gpl {
 class PlacerBaseCommon;
 class PlacerBase;
 class Graphics;
+class Net;
 
 class InitialPlaceVars
 {
@@ -59,6 +62,7 @@ class InitialPlaceVars
   float netWeightScale;
   bool debug;
   bool forceCPU;
+  int numThreads;
 
   InitialPlaceVars();
   void reset();
@@ -107,7 +111,8 @@ class InitialPlace
   //        SparseMatrix that contains connectivity forces on Y // B2B model is
   //        used
   //
-  // Used the interative BiCGSTAB solver to solve matrix eqs.
+  // Used the Jacobi preconditioned CG solver to solve matrix eqs.
+  // Both matrices keep their sparsity pattern across the B2B iterations.
 
   Eigen::VectorXf instLocVecX_, fixedInstForceVecX_;
   Eigen::VectorXf instLocVecY_, fixedInstForceVecY_;
@@ -117,6 +122,15 @@ class InitialPlace
   void setPlaceInstExtId();
   void updatePinInfo();
   void createSparseMatrix();
+
+  // B2B contributions of a chunk of nets, kept in net order so that the
+  // merged result does not depend on the number of threads.
+  struct B2BTerms
+  {
+    std::vector<Eigen::Triplet<float>> listX, listY;
+    std::vector<std::pair<int, float>> forceX, forceY;
+  };
+  void addNetB2BTerms(const Net* net, B2BTerms& terms) const;
   void updateCoordi();
   void reset();
 };
@@ -34,11 +34,16 @@
 #include "nesterovBase.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <random>
 #include <utility>
 
 #include "fft.h"
+#ifdef ENABLE_GPU
+#include "gpuWirelength.h"
+#endif
 #include "nesterovPlace.h"
 #include "odb/db.h"
 #include "placerBase.h"
@@ -77,6 +82,13 @@ static float getOverlapDensityArea(const Bin& bin, const GCell* cell);
 
 static float fastExp(float exp);
 
+static float clampDensityCoordi(float c,
+                                float half,
+                                float lo,
+                                float hi,
+                                float minC,
+                                float maxC);
+
 ////////////////////////////////////////////////
 // GCell
 
@@ -149,9 +161,30 @@ void GCell::setFiller()
 {
 }
 
+// A cluster is a square with the total area of its instances,
+// centered at their area-weighted center.
 void GCell::setClusteredInstance(const std::vector<Instance*>& insts)
 {
   insts_ = insts;
+
+  int64_t area = 0;
+  double sumCx = 0, sumCy = 0;
+  for (const Instance* inst : insts_) {
+    area += inst->area();
+    sumCx += static_cast<double>(inst->area()) * inst->cx();
+    sumCy += static_cast<double>(inst->area()) * inst->cy();
+  }
+  if (area == 0) {
+    return;
+  }
+
+  const int size = std::ceil(std::sqrt(static_cast<double>(area)));
+  const int cx = std::round(sumCx / area);
+  const int cy = std::round(sumCy / area);
+  dLx_ = lx_ = cx - size / 2;
+  dLy_ = ly_ = cy - size / 2;
+  dUx_ = ux_ = lx_ + size;
+  dUy_ = uy_ = ly_ + size;
 }
 
 void GCell::setLocation(int lx, int ly)
@@ -272,12 +305,13 @@ bool GCell::isMacroInstance() const
   return instance()->isMacro();
 }
 
+// clusters only group standard cells
 bool GCell::isStdInstance() const
 {
-  if (!isInstance()) {
+  if (!isClusteredInstance()) {
     return false;
   }
-  return !instance()->isMacro();
+  return !isInstance() || !instance()->isMacro();
 }
 
 ////////////////////////////////////////////////
@@ -610,6 +644,7 @@ BinGrid::BinGrid()
       targetDensity_(0),
       overflowArea_(0),
       overflowAreaUnscaled_(0),
+      numThreads_(1),
       isSetBinCnt_(0)
 {
 }
@@ -652,6 +687,11 @@ void BinGrid::setTargetDensity(float density)
   targetDensity_ = density;
 }
 
+void BinGrid::setNumThreads(int numThreads)
+{
+  numThreads_ = std::max(numThreads, 1);
+}
+
 void BinGrid::setBinCnt(int binCntX, int binCntY)
 {
   isSetBinCnt_ = 1;
@@ -847,63 +887,80 @@ void BinGrid::updateBinsNonPlaceArea()
 void BinGrid::updateBinsGCellDensityArea(const std::vector<GCell*>& cells)
 {
   // clear the Bin-area info
-  for (Bin& bin : bins_) {
+#pragma omp parallel for num_threads(numThreads_)
+  for (size_t k = 0; k < bins_.size(); k++) {
+    Bin& bin = bins_[k];
     bin.setInstPlacedArea(0);
     bin.setInstPlacedAreaUnscaled(0);
     bin.setFillerArea(0);
   }
 
-  for (auto& cell : cells) {
-    std::pair<int, int> pairX = getDensityMinMaxIdxX(cell);
-    std::pair<int, int> pairY = getDensityMinMaxIdxY(cell);
+  // Each thread owns a band of bin rows and scatters the part of every
+  // cell that falls into its band, so no bin is written concurrently.
+  // Bin areas are integers; the result is independent of the thread count.
+  const int numBands = std::max(1, std::min(numThreads_, binCntY_));
 
-    // The following function is critical runtime hotspot
-    // for global placer.
-    //
-    if (cell->isInstance()) {
-      // macro should have
-      // scale-down with target-density
-      if (cell->isMacroInstance()) {
-        for (int i = pairX.first; i < pairX.second; i++) {
-          for (int j = pairY.first; j < pairY.second; j++) {
-            Bin& bin = bins_[j * binCntX_ + i];
+#pragma omp parallel for num_threads(numThreads_) schedule(static, 1)
+  for (int band = 0; band < numBands; band++) {
+    const int bandLy = band * binCntY_ / numBands;
+    const int bandUy = (band + 1) * binCntY_ / numBands;
+
+    for (auto& cell : cells) {
+      std::pair<int, int> pairY = getDensityMinMaxIdxY(cell);
+      pairY.first = std::max(pairY.first, bandLy);
+      pairY.second = std::min(pairY.second, bandUy);
+      if (pairY.first >= pairY.second) {
+        continue;
+      }
+      std::pair<int, int> pairX = getDensityMinMaxIdxX(cell);
 
-            const float scaledAvea = getOverlapDensityArea(bin, cell)
-                                     * cell->densityScale()
-                                     * bin.targetDensity();
-            bin.addInstPlacedArea(scaledAvea);
-            bin.addInstPlacedAreaUnscaled(scaledAvea);
+      // The following function is critical runtime hotspot
+      // for global placer.
+      //
+      if (cell->isClusteredInstance()) {
+        // macro should have
+        // scale-down with target-density
+        if (cell->isMacroInstance()) {
+          for (int i = pairX.first; i < pairX.second; i++) {
+            for (int j = pairY.first; j < pairY.second; j++) {
+              Bin& bin = bins_[j * binCntX_ + i];
+
+              const float scaledAvea = getOverlapDensityArea(bin, cell)
+                                       * cell->densityScale()
+                                       * bin.targetDensity();
+              bin.addInstPlacedArea(scaledAvea);
+              bin.addInstPlacedAreaUnscaled(scaledAvea);
+            }
           }
         }
-      }
-      // normal cells
-      else if (cell->isStdInstance()) {
+        // normal cells
+        else if (cell->isStdInstance()) {
+          for (int i = pairX.first; i < pairX.second; i++) {
+            for (int j = pairY.first; j < pairY.second; j++) {
+              Bin& bin = bins_[j * binCntX_ + i];
+              const float scaledArea
+                  = getOverlapDensityArea(bin, cell) * cell->densityScale();
+              bin.addInstPlacedArea(scaledArea);
+              bin.addInstPlacedAreaUnscaled(scaledArea);
+            }
+          }
+        }
+      } else if (cell->isFiller()) {
         for (int i = pairX.first; i < pairX.second; i++) {
           for (int j = pairY.first; j < pairY.second; j++) {
             Bin& bin = bins_[j * binCntX_ + i];
-            const float scaledArea
-                = getOverlapDensityArea(bin, cell) * cell->densityScale();
-            bin.addInstPlacedArea(scaledArea);
-            bin.addInstPlacedAreaUnscaled(scaledArea);
+            bin.addFillerArea(getOverlapDensityArea(bin, cell)
+                              * cell->densityScale());
           }
         }
       }
-    } else if (cell->isFiller()) {
-      for (int i = pairX.first; i < pairX.second; i++) {
-        for (int j = pairY.first; j < pairY.second; j++) {
-          Bin& bin = bins_[j * binCntX_ + i];
-          bin.addFillerArea(getOverlapDensityArea(bin, cell)
-                            * cell->densityScale());
-        }
-      }
     }
   }
 
-  overflowArea_ = 0;
-  overflowAreaUnscaled_ = 0;
-  // update density and overflowArea
-  // for nesterov use and FFT library
-  for (Bin& bin : bins_) {
+  // update density for nesterov use and FFT library
+#pragma omp parallel for num_threads(numThreads_)
+  for (size_t k = 0; k < bins_.size(); k++) {
+    Bin& bin = bins_[k];
     int64_t binArea = bin.binArea();
     const float scaledBinArea
         = static_cast<float>(binArea * bin.targetDensity());
@@ -911,6 +968,15 @@ void BinGrid::updateBinsGCellDensityArea(const std::vector<GCell*>& cells)
                     + static_cast<float>(bin.fillerArea())
                     + static_cast<float>(bin.nonPlaceArea()))
                    / scaledBinArea);
+  }
+
+  // overflowArea is accumulated serially to keep the summation order fixed
+  overflowArea_ = 0;
+  overflowAreaUnscaled_ = 0;
+  for (Bin& bin : bins_) {
+    int64_t binArea = bin.binArea();
+    const float scaledBinArea
+        = static_cast<float>(binArea * bin.targetDensity());
 
     overflowArea_ += std::max(0.0f,
                               static_cast<float>(bin.instPlacedArea())
@@ -978,6 +1044,8 @@ void NesterovBaseVars::reset()
   targetDensity = 1.0;
   binCntX = binCntY = 0;
   minWireLengthForceBar = -300;
+  numThreads = 1;
+  forceCPU = false;
   isSetBinCnt = 0;
   useUniformTargetDensity = 0;
 }
@@ -1010,6 +1078,9 @@ void NesterovPlaceVars::reset()
   debug_update_iterations = 10;
   debug_draw_bins = true;
   debug_inst = nullptr;
+  checkpointFile.clear();
+  checkpointInterval = 0;
+  checkpointResume = false;
 }
 
 ////////////////////////////////////////////////
@@ -1022,13 +1093,14 @@ NesterovBaseCommon::NesterovBaseCommon() : pbc_(nullptr), log_(nullptr)
 
 NesterovBaseCommon::NesterovBaseCommon(NesterovBaseVars nbVars,
                                        std::shared_ptr<PlacerBaseCommon> pbc,
-                                       utl::Logger* log)
+                                       utl::Logger* log,
+                                       const std::vector<int>& instClusters)
     : NesterovBaseCommon()
 {
   nbVars_ = nbVars;
   pbc_ = std::move(pbc);
   log_ = log;
-  init();
+  init(instClusters);
 }
 
 NesterovBaseCommon::~NesterovBaseCommon()
@@ -1042,6 +1114,11 @@ void NesterovBaseCommon::reset()
   pbc_ = nullptr;
   log_ = nullptr;
 
+#ifdef ENABLE_GPU
+  gpuWl_.reset();
+  gpuWlGrads_.clear();
+#endif
+
   gCellStor_.clear();
   gNetStor_.clear();
   gPinStor_.clear();
@@ -1064,13 +1141,31 @@ void NesterovBaseCommon::reset()
   gPins_.shrink_to_fit();
 }
 
-void NesterovBaseCommon::init()
+void NesterovBaseCommon::init(const std::vector<int>& instClusters)
 {
   // gCellStor init
-  gCellStor_.reserve(pbc_->placeInsts().size());
+  if (instClusters.empty()) {
+    gCellStor_.reserve(pbc_->placeInsts().size());
 
-  for (auto& inst : pbc_->placeInsts()) {
-    gCellStor_.push_back(GCell(inst));
+    for (auto& inst : pbc_->placeInsts()) {
+      gCellStor_.push_back(GCell(inst));
+    }
+  } else {
+    const int numClusters
+        = *std::max_element(instClusters.begin(), instClusters.end()) + 1;
+    std::vector<std::vector<Instance*>> clusters(numClusters);
+    for (size_t i = 0; i < pbc_->placeInsts().size(); i++) {
+      clusters[instClusters[i]].push_back(pbc_->placeInsts()[i]);
+    }
+
+    gCellStor_.reserve(numClusters);
+    for (auto& cluster : clusters) {
+      if (cluster.size() == 1) {
+        gCellStor_.push_back(GCell(cluster[0]));
+      } else if (!cluster.empty()) {
+        gCellStor_.push_back(GCell(cluster));
+      }
+    }
   }
 
   // TODO:
@@ -1094,11 +1189,13 @@ void NesterovBaseCommon::init()
   // gCell ptr init
   gCells_.reserve(gCellStor_.size());
   for (auto& gCell : gCellStor_) {
-    if (!gCell.isInstance()) {
+    if (gCell.isFiller()) {
       continue;
     }
     gCells_.push_back(&gCell);
-    gCellMap_[gCell.instance()] = &gCell;
+    for (Instance* inst : gCell.insts()) {
+      gCellMap_[inst] = &gCell;
+    }
   }
 
   // gPin ptr init
@@ -1121,8 +1218,10 @@ void NesterovBaseCommon::init()
       continue;
     }
 
-    for (auto& pin : gCell.instance()->pins()) {
-      gCell.addGPin(pbToNb(pin));
+    for (Instance* inst : gCell.insts()) {
+      for (auto& pin : inst->pins()) {
+        gCell.addGPin(pbToNb(pin));
+      }
     }
   }
 
@@ -1138,7 +1237,46 @@ void NesterovBaseCommon::init()
       gNet.addGPin(pbToNb(pin));
     }
   }
+
+#ifdef ENABLE_GPU
+  if (!nbVars_.forceCPU) {
+    initGpuWirelength();
+  }
+#endif
+}
+
+#ifdef ENABLE_GPU
+void NesterovBaseCommon::initGpuWirelength()
+{
+  std::vector<int> netPinStart(1, 0);
+  std::vector<int> netPins;
+  netPins.reserve(gPinStor_.size());
+  for (GNet& gNet : gNetStor_) {
+    for (GPin* gPin : gNet.gPins()) {
+      netPins.push_back(gPin - gPinStor_.data());
+    }
+    netPinStart.push_back(netPins.size());
+  }
+
+  std::vector<int> cellPinStart(1, 0);
+  std::vector<int> cellPins;
+  cellPins.reserve(gPinStor_.size());
+  for (GCell& gCell : gCellStor_) {
+    for (GPin* gPin : gCell.gPins()) {
+      cellPins.push_back(gPin - gPinStor_.data());
+    }
+    cellPinStart.push_back(cellPins.size());
+  }
+
+  gpuWl_ = std::make_unique<GpuWirelength>(
+      netPinStart, netPins, cellPinStart, cellPins, log_);
+  gpuPinX_.resize(gPinStor_.size());
+  gpuPinY_.resize(gPinStor_.size());
+  gpuNetWeights_.resize(gNetStor_.size());
+
+  log_->info(GPL, 306, "Computing wirelength gradients on the GPU.");
 }
+#endif
 
 GCell* NesterovBaseCommon::pbToNb(Instance* inst) const
 {
@@ -1189,15 +1327,41 @@ GNet* NesterovBaseCommon::dbToNb(odb::dbNet* net) const
 // in ePlace paper.
 void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
 {
+#ifdef ENABLE_GPU
+  if (gpuWl_) {
+    for (size_t i = 0; i < gPinStor_.size(); i++) {
+      gpuPinX_[i] = gPinStor_[i].cx();
+      gpuPinY_[i] = gPinStor_[i].cy();
+    }
+    for (size_t i = 0; i < gNetStor_.size(); i++) {
+      gpuNetWeights_[i] = gNetStor_[i].totalWeight();
+    }
+    gpuWl_->computeGradients(gpuPinX_,
+                             gpuPinY_,
+                             gpuNetWeights_,
+                             wlCoeffX,
+                             wlCoeffY,
+                             nbVars_.minWireLengthForceBar,
+                             gpuWlGrads_);
+    return;
+  }
+#endif
+
   // clear all WA variables.
-  for (auto& gNet : gNets_) {
-    gNet->clearWaVars();
+#pragma omp parallel for num_threads(nbVars_.numThreads)
+  for (size_t i = 0; i < gNets_.size(); i++) {
+    gNets_[i]->clearWaVars();
   }
-  for (auto& gPin : gPins_) {
-    gPin->clearWaVars();
+#pragma omp parallel for num_threads(nbVars_.numThreads)
+  for (size_t i = 0; i < gPins_.size(); i++) {
+    gPins_[i]->clearWaVars();
   }
 
-  for (auto& gNet : gNets_) {
+  // Every GPin belongs to exactly one GNet, so nets can be updated
+  // independently.
+#pragma omp parallel for num_threads(nbVars_.numThreads) schedule(dynamic, 64)
+  for (size_t i = 0; i < gNets_.size(); i++) {
+    GNet* gNet = gNets_[i];
     gNet->updateBox();
 
     for (auto& gPin : gNet->gPins()) {
@@ -1280,11 +1444,64 @@ void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
   }
 }
 
+void NesterovBaseCommon::updateWaVarsFromGpu()
+{
+#ifdef ENABLE_GPU
+  if (!gpuWl_) {
+    return;
+  }
+  std::vector<float> pinExp;
+  std::vector<float> netSum;
+  gpuWl_->getWaTerms(pinExp, netSum);
+
+  for (size_t i = 0; i < gPinStor_.size(); i++) {
+    GPin& gPin = gPinStor_[i];
+    const float* exps = &pinExp[4 * i];
+    gPin.clearWaVars();
+    if (exps[0] > 0) {
+      gPin.setMinExpSumX(exps[0]);
+    }
+    if (exps[1] > 0) {
+      gPin.setMaxExpSumX(exps[1]);
+    }
+    if (exps[2] > 0) {
+      gPin.setMinExpSumY(exps[2]);
+    }
+    if (exps[3] > 0) {
+      gPin.setMaxExpSumY(exps[3]);
+    }
+  }
+  for (size_t i = 0; i < gNetStor_.size(); i++) {
+    GNet& gNet = gNetStor_[i];
+    const float* sums = &netSum[8 * i];
+    gNet.clearWaVars();
+    gNet.addWaExpMinSumX(sums[0]);
+    gNet.addWaXExpMinSumX(sums[1]);
+    gNet.addWaExpMaxSumX(sums[2]);
+    gNet.addWaXExpMaxSumX(sums[3]);
+    gNet.addWaExpMinSumY(sums[4]);
+    gNet.addWaYExpMinSumY(sums[5]);
+    gNet.addWaExpMaxSumY(sums[6]);
+    gNet.addWaYExpMaxSumY(sums[7]);
+  }
+#endif
+}
+
 // get x,y WA Gradient values with given GCell
 FloatPoint NesterovBaseCommon::getWireLengthGradientWA(const GCell* gCell,
                                                        float wlCoeffX,
                                                        float wlCoeffY) const
 {
+#ifdef ENABLE_GPU
+  // the GPU gradients already include the net weights
+  if (gpuWl_) {
+    if (gCell->gPins().empty()) {
+      return FloatPoint();
+    }
+    return gpuWlGrads_[gCell - gCellStor_.data()];
+  }
+#endif
+
   FloatPoint gradientPair;
 
   for (auto& gPin : gCell->gPins()) {
@@ -1400,11 +1617,11 @@ FloatPoint NesterovBaseCommon::getWireLengthPreconditioner(
 void NesterovBaseCommon::updateDbGCells()
 {
   for (auto& gCell : gCells()) {
-    if (gCell->isInstance()) {
-      odb::dbInst* inst = gCell->instance()->dbInst();
+    // the instances of a cluster are stacked at its center
+    for (Instance* replInst : gCell->insts()) {
+      odb::dbInst* inst = replInst->dbInst();
       inst->setPlacementStatus(odb::dbPlacementStatus::PLACED);
 
-      Instance* replInst = gCell->instance();
       // pad awareness on X coordinates
       inst->setLocation(gCell->dCx() - replInst->dx() / 2
                             + pbc_->siteSizeX() * pbc_->padLeft(),
@@ -1413,6 +1630,15 @@ void NesterovBaseCommon::updateDbGCells()
   }
 }
 
+void NesterovBaseCommon::updateInstLocations()
+{
+  for (auto& gCell : gCells()) {
+    for (Instance* inst : gCell->insts()) {
+      inst->setCenterLocation(gCell->dCx(), gCell->dCy());
+    }
+  }
+}
+
 int64_t NesterovBaseCommon::getHpwl()
 {
   int64_t hpwl = 0;
@@ -1544,6 +1770,14 @@ void NesterovBase::init()
 
     GCell* gCell = nbc_->pbToNb(inst);
 
+    // a cluster is added once, by its first instance
+    if (!gCell->isInstance()) {
+      if (gCell->insts().front() == inst) {
+        gCells_.push_back(gCell);
+      }
+      continue;
+    }
+
     inst->setLocation(inst->lx() + x_offset, inst->ly() + y_offset);
 
     gCell->clearInstances();
@@ -1557,7 +1791,7 @@ void NesterovBase::init()
   }
 
   for (auto& gCell : gCells_) {
-    if (gCell->isInstance()) {
+    if (gCell->isClusteredInstance()) {
       gCellInsts_.push_back(gCell);
     } else if (gCell->isFiller()) {
       gCellFillers_.push_back(gCell);
@@ -1576,6 +1810,7 @@ void NesterovBase::init()
 
   bg_.setPlacerBase(pb_);
   bg_.setLogger(log_);
+  bg_.setNumThreads(nbVars_.numThreads);
   bg_.setCorePoints(&(pb_->die()));
   bg_.setTargetDensity(targetDensity_);
 
@@ -1583,8 +1818,11 @@ void NesterovBase::init()
   bg_.initBins();
 
   // initialize fft structrue based on bins
-  std::unique_ptr<FFT> fft(
-      new FFT(bg_.binCntX(), bg_.binCntY(), bg_.binSizeX(), bg_.binSizeY()));
+  std::unique_ptr<FFT> fft(new FFT(bg_.binCntX(),
+                                   bg_.binCntY(),
+                                   bg_.binSizeX(),
+                                   bg_.binSizeY(),
+                                   nbVars_.numThreads));
 
   fft_ = std::move(fft);
 
@@ -2024,8 +2262,12 @@ FloatPoint NesterovBase::getDensityGradient(const GCell* gCell) const
 // Density force cals
 void NesterovBase::updateDensityForceBin()
 {
+  std::vector<Bin>& bins = bg_.bins();
+
   // copy density to utilize FFT
-  for (Bin& bin : bg_.bins()) {
+#pragma omp parallel for num_threads(nbVars_.numThreads)
+  for (size_t i = 0; i < bins.size(); i++) {
+    const Bin& bin = bins[i];
     fft_->updateDensity(bin.x(), bin.y(), bin.density());
   }
 
@@ -2033,15 +2275,18 @@ void NesterovBase::updateDensityForceBin()
   fft_->doFFT();
 
   // update electroPhi and electroForce
-  // update sumPhi_ for nesterov loop
-  sumPhi_ = 0;
-  for (Bin& bin : bg_.bins()) {
+#pragma omp parallel for num_threads(nbVars_.numThreads)
+  for (size_t i = 0; i < bins.size(); i++) {
+    Bin& bin = bins[i];
     auto eForcePair = fft_->getElectroForce(bin.x(), bin.y());
     bin.setElectroForce(eForcePair.first, eForcePair.second);
+    bin.setElectroPhi(fft_->getElectroPhi(bin.x(), bin.y()));
+  }
 
-    float electroPhi = fft_->getElectroPhi(bin.x(), bin.y());
-    bin.setElectroPhi(electroPhi);
-
+  // update sumPhi_ for nesterov loop
+  sumPhi_ = 0;
+  for (const Bin& bin : bins) {
+    const float electroPhi = bin.electroPhi();
     sumPhi_ += electroPhi
                * static_cast<float>(bin.nonPlaceArea() + bin.instPlacedArea()
                                     + bin.fillerArea());
@@ -2176,24 +2421,13 @@ void NesterovBase::updateGradients(std::vector<FloatPoint>& sumGrads,
   debugPrint(
       log_, GPL, "updateGrad", 1, "DensityPenalty: {:g}", densityPenalty_);
 
+#pragma omp parallel for num_threads(nbVars_.numThreads) schedule(dynamic, 256)
   for (size_t i = 0; i < gCells_.size(); i++) {
     GCell* gCell = gCells_.at(i);
     wireLengthGrads[i]
         = nbc_->getWireLengthGradientWA(gCell, wlCoeffX, wlCoeffY);
     densityGrads[i] = getDensityGradient(gCell);
 
-    // Different compiler has different results on the following formula.
-    // e.g. wireLengthGradSum_ += fabs(~~.x) + fabs(~~.y);
-    //
-    // To prevent instability problem,
-    // I partitioned the fabs(~~.x) + fabs(~~.y) as two terms.
-    //
-    wireLengthGradSum_ += fabs(wireLengthGrads[i].x);
-    wireLengthGradSum_ += fabs(wireLengthGrads[i].y);
-
-    densityGradSum_ += fabs(densityGrads[i].x);
-    densityGradSum_ += fabs(densityGrads[i].y);
-
     sumGrads[i].x = wireLengthGrads[i].x + densityPenalty_ * densityGrads[i].x;
     sumGrads[i].y = wireLengthGrads[i].y + densityPenalty_ * densityGrads[i].y;
 
@@ -2214,6 +2448,22 @@ void NesterovBase::updateGradients(std::vector<FloatPoint>& sumGrads,
 
     sumGrads[i].x /= sumPrecondi.x;
     sumGrads[i].y /= sumPrecondi.y;
+  }
+
+  // The sums are reduced serially so that they do not depend on
+  // the thread count.
+  for (size_t i = 0; i < gCells_.size(); i++) {
+    // Different compiler has different results on the following formula.
+    // e.g. wireLengthGradSum_ += fabs(~~.x) + fabs(~~.y);
+    //
+    // To prevent instability problem,
+    // I partitioned the fabs(~~.x) + fabs(~~.y) as two terms.
+    //
+    wireLengthGradSum_ += fabs(wireLengthGrads[i].x);
+    wireLengthGradSum_ += fabs(wireLengthGrads[i].y);
+
+    densityGradSum_ += fabs(densityGrads[i].x);
+    densityGradSum_ += fabs(densityGrads[i].y);
 
     gradSum += fabs(sumGrads[i].x) + fabs(sumGrads[i].y);
   }
@@ -2258,21 +2508,55 @@ void NesterovBase::updateNextGradient(float wlCoeffX, float wlCoeffY)
 
 void NesterovBase::updateInitialPrevSLPCoordi()
 {
-  for (size_t i = 0; i < gCells_.size(); i++) {
-    GCell* curGCell = gCells_[i];
-
-    float prevCoordiX
-        = curSLPCoordi_[i].x
-          - npVars_->initialPrevCoordiUpdateCoef * curSLPSumGrads_[i].x;
-
-    float prevCoordiY
-        = curSLPCoordi_[i].y
-          - npVars_->initialPrevCoordiUpdateCoef * curSLPSumGrads_[i].y;
+  updateDensityBounds();
 
-    FloatPoint newCoordi(getDensityCoordiLayoutInsideX(curGCell, prevCoordiX),
-                         getDensityCoordiLayoutInsideY(curGCell, prevCoordiY));
+  const float lx = bg_.lx();
+  const float ly = bg_.ly();
+  const float ux = bg_.ux();
+  const float uy = bg_.uy();
+  const float coef = npVars_->initialPrevCoordiUpdateCoef;
 
-    prevSLPCoordi_[i] = newCoordi;
+#pragma omp simd
+  for (size_t i = 0; i < gCells_.size(); i++) {
+    float prevCoordiX = curSLPCoordi_[i].x - coef * curSLPSumGrads_[i].x;
+    float prevCoordiY = curSLPCoordi_[i].y - coef * curSLPSumGrads_[i].y;
+
+    prevSLPCoordi_[i].x = clampDensityCoordi(prevCoordiX,
+                                             densityHalfDx_[i],
+                                             lx,
+                                             ux,
+                                             densityMinCx_[i],
+                                             densityMaxCx_[i]);
+    prevSLPCoordi_[i].y = clampDensityCoordi(prevCoordiY,
+                                             densityHalfDy_[i],
+                                             ly,
+                                             uy,
+                                             densityMinCy_[i],
+                                             densityMaxCy_[i]);
+  }
+}
+
+// Gathers the GCell density sizes into the SoA bound arrays used by
+// the vectorized coordinate updates.
+void NesterovBase::updateDensityBounds()
+{
+  const size_t size = gCells_.size();
+  densityHalfDx_.resize(size);
+  densityHalfDy_.resize(size);
+  densityMinCx_.resize(size);
+  densityMaxCx_.resize(size);
+  densityMinCy_.resize(size);
+  densityMaxCy_.resize(size);
+
+  for (size_t i = 0; i < size; i++) {
+    const int halfDx = gCells_[i]->dDx() / 2;
+    const int halfDy = gCells_[i]->dDy() / 2;
+    densityHalfDx_[i] = halfDx;
+    densityHalfDy_[i] = halfDy;
+    densityMinCx_[i] = bg_.lx() + halfDx;
+    densityMaxCx_[i] = bg_.ux() - halfDx;
+    densityMinCy_[i] = bg_.ly() + halfDy;
+    densityMaxCy_[i] = bg_.uy() - halfDy;
   }
 }
 
@@ -2432,25 +2716,34 @@ void NesterovBase::nesterovUpdateCoordinates(float coeff)
     return;
   }
 
+  updateDensityBounds();
+
+  const float lx = bg_.lx();
+  const float ly = bg_.ly();
+  const float ux = bg_.ux();
+  const float uy = bg_.uy();
+
   // fill in nextCoordinates with given stepLength_
+#pragma omp simd
   for (size_t k = 0; k < gCells_.size(); k++) {
-    FloatPoint nextCoordi(
-        curSLPCoordi_[k].x + stepLength_ * curSLPSumGrads_[k].x,
-        curSLPCoordi_[k].y + stepLength_ * curSLPSumGrads_[k].y);
+    const float nextX = curSLPCoordi_[k].x + stepLength_ * curSLPSumGrads_[k].x;
+    const float nextY = curSLPCoordi_[k].y + stepLength_ * curSLPSumGrads_[k].y;
 
-    FloatPoint nextSLPCoordi(
-        nextCoordi.x + coeff * (nextCoordi.x - curCoordi_[k].x),
-        nextCoordi.y + coeff * (nextCoordi.y - curCoordi_[k].y));
+    const float nextSLPX = nextX + coeff * (nextX - curCoordi_[k].x);
+    const float nextSLPY = nextY + coeff * (nextY - curCoordi_[k].y);
 
-    GCell* curGCell = gCells_[k];
+    const float halfDx = densityHalfDx_[k];
+    const float halfDy = densityHalfDy_[k];
 
-    nextCoordi_[k]
-        = FloatPoint(getDensityCoordiLayoutInsideX(curGCell, nextCoordi.x),
-                     getDensityCoordiLayoutInsideY(curGCell, nextCoordi.y));
+    nextCoordi_[k].x = clampDensityCoordi(
+        nextX, halfDx, lx, ux, densityMinCx_[k], densityMaxCx_[k]);
+    nextCoordi_[k].y = clampDensityCoordi(
+        nextY, halfDy, ly, uy, densityMinCy_[k], densityMaxCy_[k]);
 
-    nextSLPCoordi_[k]
-        = FloatPoint(getDensityCoordiLayoutInsideX(curGCell, nextSLPCoordi.x),
-                     getDensityCoordiLayoutInsideY(curGCell, nextSLPCoordi.y));
+    nextSLPCoordi_[k].x = clampDensityCoordi(
+        nextSLPX, halfDx, lx, ux, densityMinCx_[k], densityMaxCx_[k]);
+    nextSLPCoordi_[k].y = clampDensityCoordi(
+        nextSLPY, halfDy, ly, uy, densityMinCy_[k], densityMaxCy_[k]);
   }
 
   // Update Density
@@ -2574,6 +2867,100 @@ bool NesterovBase::revertDivergence()
   return true;
 }
 
+template <typename T>
+static void writeValue(std::ostream& out, const T& value)
+{
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static void writeVector(std::ostream& out, const std::vector<T>& values)
+{
+  writeValue(out, static_cast<uint64_t>(values.size()));
+  out.write(reinterpret_cast<const char*>(values.data()),
+            values.size() * sizeof(T));
+}
+
+template <typename T>
+static bool readValue(std::istream& in, T& value)
+{
+  in.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return static_cast<bool>(in);
+}
+
+// The vectors are already sized by init(), so a size mismatch means the
+// checkpoint belongs to another design or gCell set.
+template <typename T>
+static bool readVector(std::istream& in, std::vector<T>& values)
+{
+  uint64_t size = 0;
+  if (!readValue(in, size) || size != values.size()) {
+    return false;
+  }
+  in.read(reinterpret_cast<char*>(values.data()), size * sizeof(T));
+  return static_cast<bool>(in);
+}
+
+void NesterovBase::writeCheckpoint(std::ostream& out) const
+{
+  writeVector(out, curSLPCoordi_);
+  writeVector(out, curSLPWireLengthGrads_);
+  writeVector(out, curSLPDensityGrads_);
+  writeVector(out, curSLPSumGrads_);
+  writeVector(out, prevSLPCoordi_);
+  writeVector(out, prevSLPWireLengthGrads_);
+  writeVector(out, prevSLPDensityGrads_);
+  writeVector(out, prevSLPSumGrads_);
+  writeVector(out, curCoordi_);
+
+  writeValue(out, stepLength_);
+  writeValue(out, densityPenalty_);
+  writeValue(out, sumOverflow_);
+  writeValue(out, sumOverflowUnscaled_);
+  writeValue(out, prevHpwl_);
+  writeValue(out, minSumOverflow);
+  writeValue(out, hpwlWithMinSumOverflow);
+  writeValue(out, iter_);
+  writeValue(out, isConverged_);
+  writeValue(out, isMaxPhiCoefChanged_);
+}
+
+bool NesterovBase::readCheckpoint(std::istream& in)
+{
+  const bool ok = readVector(in, curSLPCoordi_)
+                  && readVector(in, curSLPWireLengthGrads_)
+                  && readVector(in, curSLPDensityGrads_)
+                  && readVector(in, curSLPSumGrads_)
+                  && readVector(in, prevSLPCoordi_)
+                  && readVector(in, prevSLPWireLengthGrads_)
+                  && readVector(in, prevSLPDensityGrads_)
+                  && readVector(in, prevSLPSumGrads_)
+                  && readVector(in, curCoordi_) && readValue(in, stepLength_)
+                  && readValue(in, densityPenalty_)
+                  && readValue(in, sumOverflow_)
+                  && readValue(in, sumOverflowUnscaled_)
+                  && readValue(in, prevHpwl_) && readValue(in, minSumOverflow)
+                  && readValue(in, hpwlWithMinSumOverflow)
+                  && readValue(in, iter_) && readValue(in, isConverged_)
+                  && readValue(in, isMaxPhiCoefChanged_);
+  if (!ok) {
+    return false;
+  }
+
+  if (isConverged_) {
+    for (auto& gCell : gCells_) {
+      if (gCell->isInstance()) {
+        gCell->instance()->lock();
+      }
+    }
+  }
+
+  // the gCells sit on the last density coordinates at the end of an iter
+  updateGCellDensityCenterLocation(curSLPCoordi_);
+  updateDensityForceBin();
+  return true;
+}
+
 // https://stackoverflow.com/questions/33333363/built-in-mod-vs-custom-mod-function-improve-the-performance-of-modulus-op
 static int fastModulo(const int input, const int ceil)
 {
@@ -2698,6 +3085,19 @@ static float fastExp(float a)
   return a;
 }
 
+// Branch-free form of getDensityCoordiLayoutInsideX/Y.
+// minC/maxC are the precomputed lo + half and hi - half.
+static float clampDensityCoordi(float c,
+                                float half,
+                                float lo,
+                                float hi,
+                                float minC,
+                                float maxC)
+{
+  const float adjVal = (c - half < lo) ? minC : c;
+  return (c + half > hi) ? maxC : adjVal;
+}
+
 static float getDistance(const vector<FloatPoint>& a,
                          const vector<FloatPoint>& b)
 {
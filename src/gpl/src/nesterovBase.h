@@ -33,6 +33,7 @@
 
 #pragma once
 
+#include <iosfwd>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -64,6 +65,9 @@ class Net;
 
 class GPin;
 class FFT;
+#ifdef ENABLE_GPU
+class GpuWirelength;
+#endif
 
 class GCell
 {
@@ -681,6 +685,7 @@ class BinGrid
   void setCorePoints(const Die* die);
   void setBinCnt(int binCntX, int binCntY);
   void setTargetDensity(float density);
+  void setNumThreads(int numThreads);
   void updateBinsGCellDensityArea(const std::vector<GCell*>& cells);
 
   void initBins();
@@ -730,6 +735,7 @@ class BinGrid
   float targetDensity_;
   int64_t overflowArea_;
   int64_t overflowAreaUnscaled_;
+  int numThreads_;
 
   unsigned char isSetBinCnt_ : 1;
 };
@@ -746,6 +752,8 @@ class NesterovBaseVars
   int binCntX;
   int binCntY;
   float minWireLengthForceBar;
+  int numThreads;
+  bool forceCPU;
   // temp variables
   unsigned char isSetBinCnt : 1;
   unsigned char useUniformTargetDensity : 1;
@@ -780,6 +788,9 @@ class NesterovPlaceVars
   int debug_update_iterations;
   bool debug_draw_bins;
   odb::dbInst* debug_inst;
+  std::string checkpointFile;
+  int checkpointInterval;  // 0 disables checkpoints
+  bool checkpointResume;
 
   NesterovPlaceVars();
   void reset();
@@ -791,9 +802,12 @@ class NesterovBaseCommon
 {
  public:
   NesterovBaseCommon();
+  // instClusters[i] is the cluster of pb->placeInsts()[i]. The instances
+  // of a cluster share one gCell. Empty means one gCell per instance.
   NesterovBaseCommon(NesterovBaseVars nbVars,
                      std::shared_ptr<PlacerBaseCommon> pb,
-                     utl::Logger* log);
+                     utl::Logger* log,
+                     const std::vector<int>& instClusters = {});
   ~NesterovBaseCommon();
 
   const std::vector<GCell*>& gCells() const { return gCells_; }
@@ -825,6 +839,11 @@ class NesterovBaseCommon
   //
   void updateWireLengthForceWA(float wlCoeffX, float wlCoeffY);
 
+  // The GPU path keeps the WA terms on the device; this copies them
+  // into the GPins/GNets for getWireLengthGradientPinWA.
+  // No-op when the gradients are computed on the CPU.
+  void updateWaVarsFromGpu();
+
   FloatPoint getWireLengthGradientPinWA(const GPin* gPin,
                                         float wlCoeffX,
                                         float wlCoeffY) const;
@@ -839,6 +858,9 @@ class NesterovBaseCommon
   int64_t getHpwl();
 
   void updateDbGCells();
+  // move the placer instances to their gCells,
+  // e.g. to start the next multilevel placement level.
+  void updateInstLocations();
 
  private:
   NesterovBaseVars nbVars_;
@@ -857,7 +879,18 @@ class NesterovBaseCommon
   std::unordered_map<Pin*, GPin*> gPinMap_;
   std::unordered_map<Net*, GNet*> gNetMap_;
 
-  void init();
+#ifdef ENABLE_GPU
+  // WA wirelength gradients computed on the GPU, indexed like gCellStor_
+  std::unique_ptr<GpuWirelength> gpuWl_;
+  std::vector<FloatPoint> gpuWlGrads_;
+  std::vector<int> gpuPinX_;
+  std::vector<int> gpuPinY_;
+  std::vector<float> gpuNetWeights_;
+
+  void initGpuWirelength();
+#endif
+
+  void init(const std::vector<int>& instClusters);
   void reset();
 };
 
@@ -972,6 +1005,8 @@ class NesterovBase
   float initDensity2(float wlCoeffX, float wlCoeffY);
   void setNpVars(NesterovPlaceVars* npVars) { npVars_ = npVars; }
   void setIter(int iter) { iter_ = iter; }
+  int getNumThreads() const { return nbVars_.numThreads; }
+  void setNumThreads(int threads) { nbVars_.numThreads = threads; }
   void setMaxPhiCoefChanged(bool maxPhiCoefChanged)
   {
     isMaxPhiCoefChanged_ = maxPhiCoefChanged;
@@ -996,6 +1031,10 @@ class NesterovBase
 
   void snapshot();
 
+  // Save/restore the Nesterov state; see NesterovPlace::writeCheckpoint.
+  void writeCheckpoint(std::ostream& out) const;
+  bool readCheckpoint(std::istream& in);
+
   bool checkConvergence();
   bool checkDivergence();
   bool revertDivergence();
@@ -1071,6 +1110,16 @@ class NesterovBase
   std::vector<FloatPoint> curCoordi_;
   std::vector<FloatPoint> nextCoordi_;
 
+  // Per-GCell density half sizes and the resulting center bounds, kept
+  // as contiguous arrays so the coordinate updates vectorize.
+  // Refreshed by updateDensityBounds().
+  std::vector<float> densityHalfDx_;
+  std::vector<float> densityHalfDy_;
+  std::vector<float> densityMinCx_;
+  std::vector<float> densityMaxCx_;
+  std::vector<float> densityMinCy_;
+  std::vector<float> densityMaxCy_;
+
   // save initial coordinates -- needed for RD
   std::vector<FloatPoint> initCoordi_;
 
@@ -1124,6 +1173,8 @@ class NesterovBase
   void init();
   void initFillerGCells();
   void reset();
+
+  void updateDensityBounds();
 };
 
 inline std::vector<Bin>& NesterovBase::bins()
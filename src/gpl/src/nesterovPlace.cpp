@@ -35,6 +35,13 @@
 
 #include "nesterovPlace.h"
 
+#include <omp.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -190,7 +197,11 @@ void NesterovPlace::updateCurGradient(const std::shared_ptr<NesterovBase>& nb)
 void NesterovPlace::updateNextGradient(const std::shared_ptr<NesterovBase>& nb)
 {
   nb->updateNextGradient(wireLengthCoefX_, wireLengthCoefY_);
+  checkNextGradient(nb);
+}
 
+void NesterovPlace::checkNextGradient(const std::shared_ptr<NesterovBase>& nb)
+{
   auto wireLengthGradSum_ = nb->getWireLengthGradSum();
   auto densityGradSum_ = nb->getDensityGradSum();
 
@@ -347,8 +358,17 @@ int NesterovPlace::doNesterovPlace(int start_iter)
     nb->resetMinSumOverflow();
   }
 
-  // Core Nesterov Loop
   int iter = start_iter;
+  if (npVars_.checkpointResume) {
+    // only the first placement of an incremental flow resumes
+    npVars_.checkpointResume = false;
+    int lastIter = 0;
+    if (readCheckpoint(lastIter, curA)) {
+      iter = lastIter + 1;
+    }
+  }
+
+  // Core Nesterov Loop
   for (; iter < npVars_.maxNesterovIter; iter++) {
     float prevA = curA;
 
@@ -364,15 +384,28 @@ int NesterovPlace::doNesterovPlace(int start_iter)
     int numBackTrak = 0;
     for (numBackTrak = 0; numBackTrak < npVars_.maxBackTrack; numBackTrak++) {
       // fill in nextCoordinates with given stepLength_
-      for (auto& nb : nbVec_) {
+      forEachRegion([coeff](NesterovBase* nb) {
         nb->nesterovUpdateCoordinates(coeff);
-      }
+      });
 
       nbc_->updateWireLengthForceWA(wireLengthCoefX_, wireLengthCoefY_);
 
+      // The regions only share the WA wirelength forces, so their density
+      // and gradient updates run concurrently.
+      const float wlCoeffX = wireLengthCoefX_;
+      const float wlCoeffY = wireLengthCoefY_;
+      forEachRegion([wlCoeffX, wlCoeffY](NesterovBase* nb) {
+        nb->updateNextGradient(wlCoeffX, wlCoeffY);
+      });
+
       int numDiverge = 0;
       for (auto& nb : nbVec_) {
-        updateNextGradient(nb);
+        // redo the regions after a retry lowered the wirelength coef
+        if (wireLengthCoefX_ != wlCoeffX || wireLengthCoefY_ != wlCoeffY) {
+          updateNextGradient(nb);
+        } else {
+          checkNextGradient(nb);
+        }
         numDiverge += nb->isDiverged();
       }
 
@@ -555,6 +588,11 @@ int NesterovPlace::doNesterovPlace(int start_iter)
       // log_->report("[NesterovSolve] Finished, all regions converged");
       break;
     }
+
+    if (npVars_.checkpointInterval > 0
+        && (iter + 1) % npVars_.checkpointInterval == 0) {
+      writeCheckpoint(iter, curA);
+    }
   }
   // in all case including diverge,
   // db should be updated.
@@ -611,4 +649,135 @@ void NesterovPlace::updateDb()
   nbc_->updateDbGCells();
 }
 
+void NesterovPlace::forEachRegion(
+    const std::function<void(NesterovBase*)>& func)
+{
+  const int regionCnt = nbVec_.size();
+  const int numThreads = regionCnt > 0 ? nbVec_[0]->getNumThreads() : 1;
+  if (regionCnt <= 1 || numThreads <= 1) {
+    for (auto& nb : nbVec_) {
+      func(nb.get());
+    }
+    return;
+  }
+
+  // Each region keeps an equal share of the threads for its own parallel
+  // loops, which run one level below the loop over the regions.
+  const int regionThreads = std::min(regionCnt, numThreads);
+  const int prevActiveLevels = omp_get_max_active_levels();
+  omp_set_max_active_levels(std::max(prevActiveLevels, 2));
+  for (auto& nb : nbVec_) {
+    nb->setNumThreads(std::max(1, numThreads / regionThreads));
+  }
+
+#pragma omp parallel for num_threads(regionThreads) schedule(dynamic, 1)
+  for (int i = 0; i < regionCnt; i++) {
+    func(nbVec_[i].get());
+  }
+
+  for (auto& nb : nbVec_) {
+    nb->setNumThreads(numThreads);
+  }
+  omp_set_max_active_levels(prevActiveLevels);
+}
+
+namespace {
+// Leading record of a checkpoint file, followed by the state of each
+// NesterovBase in nbVec_ order.
+struct CheckpointHeader
+{
+  char magic[8];
+  int32_t version;
+  int32_t nbCount;
+  int32_t iter;
+  float curA;
+  float wireLengthCoefX;
+  float wireLengthCoefY;
+};
+
+constexpr char checkpointMagic[8] = "GPLCKPT";
+constexpr int32_t checkpointVersion = 1;
+}  // namespace
+
+bool NesterovPlace::hasCheckpoint() const
+{
+  return npVars_.checkpointResume
+         && std::ifstream(npVars_.checkpointFile).good();
+}
+
+void NesterovPlace::writeCheckpoint(int iter, float curA) const
+{
+  // Write next to the target and rename so that a job preempted while
+  // writing still leaves the previous checkpoint intact.
+  const std::string tmpFile = npVars_.checkpointFile + ".tmp";
+  std::ofstream out(tmpFile, std::ios::binary);
+
+  CheckpointHeader header;
+  std::memcpy(header.magic, checkpointMagic, sizeof(header.magic));
+  header.version = checkpointVersion;
+  header.nbCount = nbVec_.size();
+  header.iter = iter;
+  header.curA = curA;
+  header.wireLengthCoefX = wireLengthCoefX_;
+  header.wireLengthCoefY = wireLengthCoefY_;
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  for (auto& nb : nbVec_) {
+    nb->writeCheckpoint(out);
+  }
+  out.close();
+
+  if (!out
+      || std::rename(tmpFile.c_str(), npVars_.checkpointFile.c_str()) != 0) {
+    log_->warn(GPL,
+               314,
+               "Unable to write checkpoint {}.",
+               npVars_.checkpointFile);
+    return;
+  }
+  log_->report("[NesterovSolve] Checkpoint saved at iter = {}", iter);
+}
+
+bool NesterovPlace::readCheckpoint(int& iter, float& curA)
+{
+  std::ifstream in(npVars_.checkpointFile, std::ios::binary);
+  if (!in) {
+    log_->info(GPL,
+               315,
+               "Checkpoint {} not found. Starting from the initial placement.",
+               npVars_.checkpointFile);
+    return false;
+  }
+
+  CheckpointHeader header;
+  in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  bool ok = in
+            && std::memcmp(header.magic, checkpointMagic, sizeof(header.magic))
+                   == 0
+            && header.version == checkpointVersion
+            && header.nbCount == static_cast<int32_t>(nbVec_.size());
+  for (auto& nb : nbVec_) {
+    ok = ok && nb->readCheckpoint(in);
+  }
+  if (!ok) {
+    log_->error(GPL,
+                316,
+                "Checkpoint {} does not match the current placement.",
+                npVars_.checkpointFile);
+  }
+
+  iter = header.iter;
+  curA = header.curA;
+  wireLengthCoefX_ = header.wireLengthCoefX;
+  wireLengthCoefY_ = header.wireLengthCoefY;
+  nbc_->updateWireLengthForceWA(wireLengthCoefX_, wireLengthCoefY_);
+
+  log_->info(GPL,
+             317,
+             "Resuming from checkpoint {} after iteration {}.",
+             npVars_.checkpointFile,
+             iter);
+  return true;
+}
+
 }  // namespace gpl
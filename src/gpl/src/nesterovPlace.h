@@ -33,6 +33,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -80,6 +81,9 @@ class NesterovPlace
 
   void updateDb();
 
+  // True when resuming and npVars_.checkpointFile exists.
+  bool hasCheckpoint() const;
+
   float getWireLengthCoefX() const { return wireLengthCoefX_; }
   float getWireLengthCoefY() const { return wireLengthCoefY_; }
 
@@ -130,6 +134,16 @@ class NesterovPlace
 
   void cutFillerCoordinates();
 
+  // Runs func on all regions concurrently, splitting the threads between
+  // them. The regions must not touch shared state in func.
+  void forEachRegion(const std::function<void(NesterovBase*)>& func);
+  void checkNextGradient(const std::shared_ptr<NesterovBase>& nb);
+
+  // The checkpoint holds the state at the end of iteration iter, so a
+  // preempted run can continue from iter + 1.
+  void writeCheckpoint(int iter, float curA) const;
+  bool readCheckpoint(int& iter, float& curA);
+
   void init();
   void reset();
 };
@@ -33,17 +33,21 @@
 
 #include "gpl/Replace.h"
 
+#include <algorithm>
 #include <iostream>
+#include <unordered_map>
 
 #include "initialPlace.h"
 #include "nesterovBase.h"
 #include "nesterovPlace.h"
 #include "odb/db.h"
+#include "par/PartitionMgr.h"
 #include "placerBase.h"
 #include "routeBase.h"
 #include "rsz/Resizer.hh"
 #include "timingBase.h"
 #include "utl/Logger.h"
+#include "utl/trace.h"
 
 namespace gpl {
 
@@ -54,6 +58,7 @@ Replace::Replace()
     : db_(nullptr),
       rs_(nullptr),
       fr_(nullptr),
+      pm_(nullptr),
       log_(nullptr),
       pbc_(nullptr),
       nbc_(nullptr),
@@ -67,6 +72,9 @@ Replace::Replace()
       initialPlaceMaxFanout_(200),
       initialPlaceNetWeightScale_(800),
       forceCPU_(false),
+      numThreads_(1),
+      multilevelMode_(false),
+      multilevelCoarsestSize_(5000),
       nesterovPlaceMaxIter_(5000),
       binGridCntX_(0),
       binGridCntY_(0),
@@ -88,11 +96,16 @@ Replace::Replace()
       routabilityRcK4_(0.0),
       routabilityMaxBloatIter_(1),
       routabilityMaxInflationIter_(4),
+      routabilityGrtPeriod_(1),
       timingNetWeightMax_(1.9),
+      timingNetMoveThreshold_(-1),
       timingDrivenMode_(true),
+      timingIncrementalMode_(false),
       routabilityDrivenMode_(true),
       uniformTargetDensityMode_(false),
       skipIoMode_(false),
+      checkpointInterval_(0),
+      checkpointResume_(false),
       padLeft_(0),
       padRight_(0),
       gui_debug_(false),
@@ -109,11 +122,13 @@ Replace::~Replace()
 void Replace::init(odb::dbDatabase* odb,
                    rsz::Resizer* resizer,
                    grt::GlobalRouter* router,
+                   par::PartitionMgr* partitionMgr,
                    utl::Logger* logger)
 {
   db_ = odb;
   rs_ = resizer;
   fr_ = router;
+  pm_ = partitionMgr;
   log_ = logger;
 }
 
@@ -139,6 +154,9 @@ void Replace::reset()
   initialPlaceMaxFanout_ = 200;
   initialPlaceNetWeightScale_ = 800;
   forceCPU_ = false;
+  numThreads_ = 1;
+  multilevelMode_ = false;
+  multilevelCoarsestSize_ = 5000;
 
   nesterovPlaceMaxIter_ = 5000;
   binGridCntX_ = binGridCntY_ = 0;
@@ -159,8 +177,10 @@ void Replace::reset()
   routabilityRcK3_ = routabilityRcK4_ = 0.0;
   routabilityMaxBloatIter_ = 1;
   routabilityMaxInflationIter_ = 4;
+  routabilityGrtPeriod_ = 1;
 
   timingDrivenMode_ = true;
+  timingIncrementalMode_ = false;
   routabilityDrivenMode_ = true;
   uniformTargetDensityMode_ = false;
   skipIoMode_ = false;
@@ -170,6 +190,11 @@ void Replace::reset()
   timingNetWeightOverflows_.clear();
   timingNetWeightOverflows_.shrink_to_fit();
   timingNetWeightMax_ = 1.9;
+  timingNetMoveThreshold_ = -1;
+
+  checkpointFile_.clear();
+  checkpointInterval_ = 0;
+  checkpointResume_ = false;
 
   gui_debug_ = false;
   gui_debug_pause_iterations_ = 10;
@@ -258,6 +283,7 @@ void Replace::doIncrementalPlace()
 
 void Replace::doInitialPlace()
 {
+  utl::TraceSpan span("gpl", "initial_place");
   if (pbc_ == nullptr) {
     PlacerBaseVars pbVars;
     pbVars.padLeft = padLeft_;
@@ -289,6 +315,7 @@ void Replace::doInitialPlace()
   ipVars.netWeightScale = initialPlaceNetWeightScale_;
   ipVars.debug = gui_debug_initial_;
   ipVars.forceCPU = forceCPU_;
+  ipVars.numThreads = numThreads_;
 
   std::unique_ptr<InitialPlace> ip(
       new InitialPlace(ipVars, pbc_, pbVec_, log_));
@@ -337,6 +364,8 @@ bool Replace::initNesterovPlace()
     }
 
     nbVars.useUniformTargetDensity = uniformTargetDensityMode_;
+    nbVars.numThreads = numThreads_;
+    nbVars.forceCPU = forceCPU_;
 
     nbc_ = std::make_shared<NesterovBaseCommon>(nbVars, pbc_, log_);
 
@@ -350,6 +379,7 @@ bool Replace::initNesterovPlace()
     rbVars.maxDensity = routabilityMaxDensity_;
     rbVars.maxBloatIter = routabilityMaxBloatIter_;
     rbVars.maxInflationIter = routabilityMaxInflationIter_;
+    rbVars.grtPeriod = routabilityGrtPeriod_;
     rbVars.targetRC = routabilityTargetRcMetric_;
     rbVars.inflationRatioCoef = routabilityInflationRatioCoef_;
     rbVars.maxInflationRatio = routabilityMaxInflationRatio_;
@@ -365,6 +395,10 @@ bool Replace::initNesterovPlace()
     tb_ = std::make_shared<TimingBase>(nbc_, rs_, log_);
     tb_->setTimingNetWeightOverflows(timingNetWeightOverflows_);
     tb_->setTimingNetWeightMax(timingNetWeightMax_);
+    tb_->setIncrementalMode(timingIncrementalMode_);
+    tb_->setNetMoveThreshold(timingNetMoveThreshold_ >= 0
+                                 ? timingNetMoveThreshold_
+                                 : pbc_->siteSizeY());
   }
 
   if (!np_) {
@@ -385,6 +419,9 @@ bool Replace::initNesterovPlace()
     npVars.debug_update_iterations = gui_debug_update_iterations_;
     npVars.debug_draw_bins = gui_debug_draw_bins_;
     npVars.debug_inst = gui_debug_inst_;
+    npVars.checkpointFile = checkpointFile_;
+    npVars.checkpointInterval = checkpointInterval_;
+    npVars.checkpointResume = checkpointResume_;
 
     for (const auto& nb : nbVec_) {
       nb->setNpVars(&npVars);
@@ -398,11 +435,154 @@ bool Replace::initNesterovPlace()
   return true;
 }
 
+// Cluster the netlist with the partitioner's coarsener and place the
+// coarse levels with Nesterov, from the coarsest to the finest one. Every
+// level starts with the instances of a cluster stacked at the center of
+// the cluster that contained them in the coarser level.
+// Returns false if no clustering was done.
+bool Replace::doMultilevelPlace()
+{
+  if (pbVec_.size() > 1) {
+    log_->warn(GPL,
+               311,
+               "Multilevel placement does not support power domains. "
+               "Skipping it.");
+    return false;
+  }
+
+  const std::vector<Instance*>& insts = pbc_->placeInsts();
+  const int numInsts = insts.size();
+  if (numInsts <= multilevelCoarsestSize_) {
+    return false;
+  }
+
+  std::unordered_map<Instance*, int> instIds;
+  int64_t stdInstsArea = 0;
+  for (int i = 0; i < numInsts; i++) {
+    instIds[insts[i]] = i;
+    if (!insts[i]->isMacro()) {
+      stdInstsArea += insts[i]->area();
+    }
+  }
+
+  // clusters grow up to twice the average size of the coarsest level.
+  // Macros are heavier than any cluster so they stay alone.
+  const float maxClusterWeight
+      = 2.0f * stdInstsArea / multilevelCoarsestSize_;
+  std::vector<float> vertexWeights(numInsts);
+  for (int i = 0; i < numInsts; i++) {
+    vertexWeights[i] = insts[i]->isMacro() ? 2.0f * maxClusterWeight
+                                           : insts[i]->area();
+  }
+
+  std::vector<int> eptr(1, 0);
+  std::vector<int> eind;
+  std::vector<int> vertices;
+  for (Net* net : pbc_->nets()) {
+    vertices.clear();
+    for (Pin* pin : net->pins()) {
+      auto it = instIds.find(pin->instance());
+      if (it != instIds.end()) {
+        vertices.push_back(it->second);
+      }
+    }
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()),
+                   vertices.end());
+    if (vertices.size() > 1) {
+      eind.insert(eind.end(), vertices.begin(), vertices.end());
+      eptr.push_back(eind.size());
+    }
+  }
+
+  par::HypergraphView hypergraph;
+  hypergraph.num_vertices = numInsts;
+  hypergraph.num_hyperedges = eptr.size() - 1;
+  hypergraph.eptr = eptr.data();
+  hypergraph.eind = eind.data();
+  hypergraph.vertex_weights = vertexWeights.data();
+  const std::vector<std::vector<int>> parents = pm_->CoarsenHypergraph(
+      0, hypergraph, multilevelCoarsestSize_, maxClusterWeight);
+  if (parents.empty()) {
+    return false;
+  }
+
+  // instClusters[l][i] is the cluster of insts[i] in level l + 1
+  std::vector<std::vector<int>> instClusters(parents.size());
+  for (size_t level = 0; level < parents.size(); level++) {
+    instClusters[level].resize(numInsts);
+    for (int i = 0; i < numInsts; i++) {
+      const int vertex = level == 0 ? i : instClusters[level - 1][i];
+      instClusters[level][i] = parents[level][vertex];
+    }
+  }
+  log_->info(GPL, 312, "Multilevel placement levels: {}", parents.size());
+
+  NesterovBaseVars nbVars;
+  nbVars.targetDensity = density_;
+  if (binGridCntX_ != 0 && binGridCntY_ != 0) {
+    nbVars.isSetBinCnt = 1;
+    nbVars.binCntX = binGridCntX_;
+    nbVars.binCntY = binGridCntY_;
+  }
+  nbVars.useUniformTargetDensity = uniformTargetDensityMode_;
+  nbVars.numThreads = numThreads_;
+  nbVars.forceCPU = forceCPU_;
+
+  // the coarse levels only need a rough spreading
+  constexpr float coarse_overflow = 0.3f;
+  NesterovPlaceVars npVars;
+  npVars.minPhiCoef = minPhiCoef_;
+  npVars.maxPhiCoef = maxPhiCoef_;
+  npVars.referenceHpwl = referenceHpwl_;
+  npVars.initDensityPenalty = initDensityPenalityFactor_;
+  npVars.initWireLengthCoef = initWireLengthCoef_;
+  npVars.targetOverflow = std::max(coarse_overflow, overflow_);
+  npVars.maxNesterovIter = nesterovPlaceMaxIter_;
+  npVars.timingDrivenMode = false;
+  npVars.routabilityDrivenMode = false;
+
+  for (int level = instClusters.size(); level > 0; level--) {
+    const std::vector<int>& clusters = instClusters[level - 1];
+    log_->info(GPL,
+               313,
+               "Multilevel placement level {}: {} clusters.",
+               level,
+               *std::max_element(clusters.begin(), clusters.end()) + 1);
+
+    auto nbc = std::make_shared<NesterovBaseCommon>(
+        nbVars, pbc_, log_, clusters);
+    std::vector<std::shared_ptr<NesterovBase>> nbVec{
+        std::make_shared<NesterovBase>(nbVars, pbVec_[0], nbc, log_)};
+    nbVec[0]->setNpVars(&npVars);
+    auto rb = std::make_shared<RouteBase>(
+        RouteBaseVars(), db_, fr_, nbc, nbVec, log_);
+    auto tb = std::make_shared<TimingBase>(nbc, rs_, log_);
+
+    NesterovPlace np(npVars, pbc_, nbc, pbVec_, nbVec, rb, tb, log_);
+    np.doNesterovPlace();
+    nbc->updateInstLocations();
+  }
+  return true;
+}
+
 int Replace::doNesterovPlace(int start_iter)
 {
+  utl::TraceSpan span("gpl", "nesterov_place");
   if (!initNesterovPlace()) {
     return 0;
   }
+  // a resumed run is already past the coarse levels
+  if (multilevelMode_ && start_iter == 0 && !np_->hasCheckpoint()
+      && doMultilevelPlace()) {
+    // restart from the declustered instance locations
+    np_.reset();
+    tb_.reset();
+    rb_.reset();
+    nbVec_.clear();
+    nbc_.reset();
+    initNesterovPlace();
+  }
   if (timingDrivenMode_)
     rs_->resizeSlackPreamble();
   return np_->doNesterovPlace(start_iter);
@@ -516,11 +696,26 @@ void Replace::setSkipIoMode(bool mode)
   skipIoMode_ = mode;
 }
 
+void Replace::setNumThreads(int threads)
+{
+  numThreads_ = threads;
+}
+
 void Replace::setForceCPU(bool force_cpu)
 {
   forceCPU_ = force_cpu;
 }
 
+void Replace::setMultilevelMode(bool mode)
+{
+  multilevelMode_ = mode;
+}
+
+void Replace::setMultilevelCoarsestSize(int size)
+{
+  multilevelCoarsestSize_ = size;
+}
+
 void Replace::setTimingDrivenMode(bool mode)
 {
   timingDrivenMode_ = mode;
@@ -551,6 +746,11 @@ void Replace::setRoutabilityMaxInflationIter(int iter)
   routabilityMaxInflationIter_ = iter;
 }
 
+void Replace::setRoutabilityGrtPeriod(int period)
+{
+  routabilityGrtPeriod_ = period;
+}
+
 void Replace::setRoutabilityTargetRcMetric(float rc)
 {
   routabilityTargetRcMetric_ = rc;
@@ -597,4 +797,25 @@ void Replace::setTimingNetWeightMax(float max)
   timingNetWeightMax_ = max;
 }
 
+void Replace::setTimingIncrementalMode(bool mode)
+{
+  timingIncrementalMode_ = mode;
+}
+
+void Replace::setTimingNetMoveThreshold(int threshold)
+{
+  timingNetMoveThreshold_ = threshold;
+}
+
+void Replace::setCheckpoint(const std::string& file, int interval)
+{
+  checkpointFile_ = file;
+  checkpointInterval_ = interval;
+}
+
+void Replace::setCheckpointResume(bool resume)
+{
+  checkpointResume_ = resume;
+}
+
 }  // namespace gpl
@@ -43,6 +43,13 @@ replace_nesterov_place_cmd()
   replace->doNesterovPlace();
 }
 
+void
+set_num_threads_cmd(int threads)
+{
+  Replace* replace = getReplace();
+  replace->setNumThreads(threads);
+}
+
 void
 set_density_cmd(float density)
 {
@@ -142,6 +149,34 @@ set_force_cpu(bool force_cpu)
   replace->setForceCPU(force_cpu);
 }
 
+void
+set_multilevel_mode_cmd(bool multilevel)
+{
+  Replace* replace = getReplace();
+  replace->setMultilevelMode(multilevel);
+}
+
+void
+set_multilevel_coarsest_size_cmd(int size)
+{
+  Replace* replace = getReplace();
+  replace->setMultilevelCoarsestSize(size);
+}
+
+void
+set_checkpoint_cmd(const char* file, int interval)
+{
+  Replace* replace = getReplace();
+  replace->setCheckpoint(file, interval);
+}
+
+void
+set_checkpoint_resume_cmd(bool resume)
+{
+  Replace* replace = getReplace();
+  replace->setCheckpointResume(resume);
+}
+
 void set_timing_driven_mode(bool timing_driven)
 {
   Replace* replace = getReplace();
@@ -184,6 +219,13 @@ set_routability_max_inflation_iter_cmd(int iter)
   replace->setRoutabilityMaxInflationIter(iter);
 }
 
+void
+set_routability_grt_period_cmd(int period)
+{
+  Replace* replace = getReplace();
+  replace->setRoutabilityGrtPeriod(period);
+}
+
 void
 set_routability_target_rc_metric_cmd(float rc)
 {
@@ -258,6 +300,20 @@ set_timing_driven_net_weight_max_cmd(float max)
   return replace->setTimingNetWeightMax(max);
 }
 
+void
+set_timing_driven_incremental_cmd(bool incremental)
+{
+  Replace* replace = getReplace();
+  replace->setTimingIncrementalMode(incremental);
+}
+
+void
+set_timing_driven_net_move_threshold_cmd(int threshold)
+{
+  Replace* replace = getReplace();
+  replace->setTimingNetMoveThreshold(threshold);
+}
+
 void
 set_debug_cmd(int pause_iterations,
               int update_iterations,
@@ -40,6 +40,11 @@ sta::define_cmd_args "global_placement" {\
     [-disable_routability_driven]\
     [-incremental]\
     [-force_cpu]\
+    [-multilevel]\
+    [-multilevel_coarsest_size multilevel_coarsest_size]\
+    [-checkpoint_file file]\
+    [-checkpoint_interval iterations]\
+    [-resume]\
     [-skip_io]\
     [-bin_grid_count grid_count]\
     [-density target_density]\
@@ -55,6 +60,7 @@ sta::define_cmd_args "global_placement" {\
     [-routability_max_density routability_max_density]\
     [-routability_max_bloat_iter routability_max_bloat_iter]\
     [-routability_max_inflation_iter routability_max_inflation_iter]\
+    [-routability_grt_period routability_grt_period]\
     [-routability_target_rc_metric routability_target_rc_metric]\
     [-routability_inflation_ratio_coef routability_inflation_ratio_coef]\
     [-routability_max_inflation_ratio routability_max_inflation_ratio]\
@@ -62,6 +68,8 @@ sta::define_cmd_args "global_placement" {\
     [-timing_driven_net_reweight_overflow timing_driven_net_reweight_overflow]\
     [-timing_driven_net_weight_max timing_driven_net_weight_max]\
     [-timing_driven_nets_percentage timing_driven_nets_percentage]\
+    [-timing_driven_incremental]\
+    [-timing_driven_net_move_threshold timing_driven_net_move_threshold]\
     [-pad_left pad_left]\
     [-pad_right pad_right]\
 }
@@ -75,6 +83,7 @@ proc global_placement { args } {
       -initial_place_max_iter -initial_place_max_fanout \
       -routability_check_overflow -routability_max_density \
       -routability_max_bloat_iter -routability_max_inflation_iter \
+      -routability_grt_period \
       -routability_target_rc_metric \
       -routability_inflation_ratio_coef \
       -routability_max_inflation_ratio \
@@ -82,16 +91,22 @@ proc global_placement { args } {
       -timing_driven_net_reweight_overflow \
       -timing_driven_net_weight_max \
       -timing_driven_nets_percentage \
+      -timing_driven_net_move_threshold \
+      -multilevel_coarsest_size \
+      -checkpoint_file -checkpoint_interval \
       -pad_left -pad_right} \
     flags {-skip_initial_place \
       -skip_nesterov_place \
       -timing_driven \
+      -timing_driven_incremental \
       -routability_driven \
       -disable_timing_driven \
       -disable_routability_driven \
       -skip_io \
       -incremental\
-      -force_cpu}
+      -force_cpu \
+      -multilevel \
+      -resume}
 
   # flow control for initial_place
   if { [info exists flags(-skip_initial_place)] } {
@@ -105,6 +120,26 @@ proc global_placement { args } {
   set force_cpu [info exists flags(-force_cpu)]
   gpl::set_force_cpu $force_cpu
 
+  gpl::set_multilevel_mode_cmd [info exists flags(-multilevel)]
+  if { [info exists keys(-multilevel_coarsest_size)] } {
+    set coarsest_size $keys(-multilevel_coarsest_size)
+    sta::check_positive_integer "-multilevel_coarsest_size" $coarsest_size
+    gpl::set_multilevel_coarsest_size_cmd $coarsest_size
+  }
+
+  if { [info exists keys(-checkpoint_file)] } {
+    set checkpoint_interval 100
+    if { [info exists keys(-checkpoint_interval)] } {
+      set checkpoint_interval $keys(-checkpoint_interval)
+      sta::check_positive_integer "-checkpoint_interval" $checkpoint_interval
+    }
+    gpl::set_checkpoint_cmd $keys(-checkpoint_file) $checkpoint_interval
+  } elseif { [info exists keys(-checkpoint_interval)] \
+               || [info exists flags(-resume)] } {
+    utl::error GPL 318 "-checkpoint_interval and -resume require -checkpoint_file."
+  }
+  gpl::set_checkpoint_resume_cmd [info exists flags(-resume)]
+
   set skip_io [info exists flags(-skip_io)]
   gpl::set_skip_io_mode_cmd $skip_io
   if { $skip_io } {
@@ -140,6 +175,16 @@ proc global_placement { args } {
     if { [info exists keys(-timing_driven_nets_percentage)] } {
       rsz::set_worst_slack_nets_percent $keys(-timing_driven_nets_percentage)
     }
+
+    gpl::set_timing_driven_incremental_cmd \
+      [info exists flags(-timing_driven_incremental)]
+
+    if { [info exists keys(-timing_driven_net_move_threshold)] } {
+      set threshold $keys(-timing_driven_net_move_threshold)
+      sta::check_positive_float "-timing_driven_net_move_threshold" $threshold
+      gpl::set_timing_driven_net_move_threshold_cmd \
+        [ord::microns_to_dbu $threshold]
+    }
   }
 
   if { [info exists flags(-disable_timing_driven)] } { 
@@ -258,6 +303,16 @@ proc global_placement { args } {
     sta::check_positive_float "-routability_max_inflation_iter" $routability_max_inflation_iter
     gpl::set_routability_max_inflation_iter_cmd $routability_max_inflation_iter
   }
+
+  # global router period; the calls in between use the RUDY estimate
+  if { [info exists keys(-routability_grt_period)] } {
+    set grt_period $keys(-routability_grt_period)
+    sta::check_positive_integer "-routability_grt_period" $grt_period
+    if { $grt_period < 1 } {
+      utl::error GPL 309 "-routability_grt_period must be at least 1."
+    }
+    gpl::set_routability_grt_period_cmd $grt_period
+  }
   
   # routability inflation iter
   if { [info exists keys(-routability_target_rc_metric)] } {
@@ -302,6 +357,8 @@ proc global_placement { args } {
     gpl::set_pad_right_cmd $pad_right
   }
 
+  gpl::set_num_threads_cmd [ord::thread_count]
+
   if { [ord::db_has_rows] } {
     sta::check_argc_eq0 "global_placement" $args
   
@@ -36,6 +36,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <utility>
 
@@ -288,6 +289,7 @@ void RouteBaseVars::reset()
   rcK3 = rcK4 = 0.0;
   maxBloatIter = 1;
   maxInflationIter = 4;
+  grtPeriod = 1;
 }
 
 /////////////////////////////////////////////
@@ -305,7 +307,10 @@ RouteBase::RouteBase()
       numCall_(0),
       minRc_(1e30),
       minRcTargetDensity_(0),
-      minRcViolatedCnt_(0)
+      minRcViolatedCnt_(0),
+      useRudy_(false),
+      rudyScaleH_(1.0),
+      rudyScaleV_(1.0)
 {
 }
 
@@ -347,6 +352,9 @@ void RouteBase::reset()
   minRcCellSize_.clear();
   minRcCellSize_.shrink_to_fit();
 
+  useRudy_ = false;
+  rudyScaleH_ = rudyScaleV_ = 1.0;
+
   resetRoutabilityResources();
 }
 
@@ -354,6 +362,9 @@ void RouteBase::resetRoutabilityResources()
 {
   inflatedAreaDelta_ = 0;
 
+  rudyRatioH_.clear();
+  rudyRatioV_.clear();
+
   grouter_->clear();
   tg_.reset();
 }
@@ -449,6 +460,35 @@ static float getUsageCapacityRatio(Tile* tile,
   return static_cast<float>(curUse) / curCap;
 }
 
+// Sum of the capacity and blockage tracks over the layers of the given
+// direction in a tile.
+static void getTileTracks(Tile* tile,
+                          odb::dbTech* tech,
+                          odb::dbGCellGrid* gGrid,
+                          bool horizontal,
+                          unsigned int& capacity,
+                          unsigned int& usage,
+                          unsigned int& blockage)
+{
+  capacity = usage = blockage = 0;
+  for (int i = 1; i <= tech->getRoutingLayerCount(); i++) {
+    odb::dbTechLayer* layer = tech->findRoutingLayer(i);
+    if ((layer->getDirection() == odb::dbTechLayerDir::HORIZONTAL)
+        != horizontal) {
+      continue;
+    }
+    unsigned int capH = 0, capV = 0, capU = 0;
+    unsigned int useH = 0, useV = 0, useU = 0;
+    unsigned int blockH = 0, blockV = 0, blockU = 0;
+    gGrid->getCapacity(layer, tile->x(), tile->y(), capH, capV, capU);
+    gGrid->getUsage(layer, tile->x(), tile->y(), useH, useV, useU);
+    gGrid->getBlockage(layer, tile->x(), tile->y(), blockH, blockV, blockU);
+    capacity += horizontal ? capH : capV;
+    usage += horizontal ? useH : useV;
+    blockage += horizontal ? blockH : blockV;
+  }
+}
+
 // fill
 //
 // TileGrids'
@@ -456,7 +496,7 @@ static float getUsageCapacityRatio(Tile* tile,
 // tileCntX_ tileCntY_
 // tileSizeX_ tileSizeY_
 //
-void RouteBase::updateRoute()
+void RouteBase::initTileGrid()
 {
   odb::dbGCellGrid* gGrid = db_->getChip()->getBlock()->getGCellGrid();
   std::vector<int> gridX, gridY;
@@ -464,9 +504,7 @@ void RouteBase::updateRoute()
   gGrid->getGridY(gridY);
 
   // retrieve routing Layer Count from odb
-  odb::dbTech* tech = db_->getTech();
-  int numLayers = tech->getRoutingLayerCount();
-  tg_->setNumRoutingLayers(numLayers);
+  tg_->setNumRoutingLayers(db_->getTech()->getRoutingLayerCount());
 
   // update grid tile info
   tg_->setLx(gridX[0]);
@@ -474,6 +512,15 @@ void RouteBase::updateRoute()
   tg_->setTileSize(gridX[1] - gridX[0], gridY[1] - gridY[0]);
   tg_->setTileCnt(gridX.size(), gridY.size());
   tg_->initTiles();
+}
+
+void RouteBase::updateRoute()
+{
+  initTileGrid();
+
+  odb::dbGCellGrid* gGrid = db_->getChip()->getBlock()->getGCellGrid();
+  odb::dbTech* tech = db_->getTech();
+  int numLayers = tg_->numRoutingLayers();
 
   for (int i = 1; i <= numLayers; i++) {
     odb::dbTechLayer* layer = tech->findRoutingLayer(i);
@@ -556,6 +603,152 @@ void RouteBase::updateRoute()
   }
 }
 
+// RUDY: every net spreads its HPWL uniformly over its bounding box.
+// Returns the horizontal/vertical demand of each tile in tracks.
+void RouteBase::getRudyDemand(std::vector<double>& demandH,
+                              std::vector<double>& demandV) const
+{
+  const int tileSizeX = tg_->tileSizeX();
+  const int tileSizeY = tg_->tileSizeY();
+  demandH.assign(tg_->tiles().size(), 0);
+  demandV.assign(tg_->tiles().size(), 0);
+
+  for (GNet* gNet : nbc_->gNets()) {
+    if (gNet->gPins().size() < 2) {
+      continue;
+    }
+    gNet->updateBox();
+
+    // widen degenerate boxes to one tile so that straight nets still
+    // occupy a row/column of tiles
+    double lx = gNet->lx(), ux = gNet->ux();
+    double ly = gNet->ly(), uy = gNet->uy();
+    if (ux - lx < tileSizeX) {
+      const double cx = (lx + ux) / 2;
+      lx = cx - tileSizeX / 2.0;
+      ux = cx + tileSizeX / 2.0;
+    }
+    if (uy - ly < tileSizeY) {
+      const double cy = (ly + uy) / 2;
+      ly = cy - tileSizeY / 2.0;
+      uy = cy + tileSizeY / 2.0;
+    }
+    const double width = ux - lx;
+    const double height = uy - ly;
+
+    const int minX = std::max(
+        0, static_cast<int>(std::floor((lx - tg_->lx()) / tileSizeX)));
+    const int maxX = std::min(
+        tg_->tileCntX() - 1,
+        static_cast<int>(std::floor((ux - tg_->lx()) / tileSizeX)));
+    const int minY = std::max(
+        0, static_cast<int>(std::floor((ly - tg_->ly()) / tileSizeY)));
+    const int maxY = std::min(
+        tg_->tileCntY() - 1,
+        static_cast<int>(std::floor((uy - tg_->ly()) / tileSizeY)));
+
+    for (int y = minY; y <= maxY; y++) {
+      for (int x = minX; x <= maxX; x++) {
+        const Tile* tile = tg_->tiles()[y * tg_->tileCntX() + x];
+        const double overlapX
+            = std::min(ux, static_cast<double>(tile->ux()))
+              - std::max(lx, static_cast<double>(tile->lx()));
+        const double overlapY
+            = std::min(uy, static_cast<double>(tile->uy()))
+              - std::max(ly, static_cast<double>(tile->ly()));
+        if (overlapX <= 0 || overlapY <= 0) {
+          continue;
+        }
+        const double overlap = overlapX * overlapY;
+        // horizontal wire length = overlap / height; in tracks
+        demandH[y * tg_->tileCntX() + x] += overlap / height / tileSizeX;
+        demandV[y * tg_->tileCntX() + x] += overlap / width / tileSizeY;
+      }
+    }
+  }
+}
+
+// Same role as updateRoute, but from the RUDY estimate instead of
+// a global router run.
+void RouteBase::updateRudy()
+{
+  initTileGrid();
+
+  odb::dbGCellGrid* gGrid = db_->getChip()->getBlock()->getGCellGrid();
+  odb::dbTech* tech = db_->getTech();
+
+  std::vector<double> demandH, demandV;
+  getRudyDemand(demandH, demandV);
+
+  auto getRatio = [this](double demand,
+                         float scale,
+                         unsigned int capacity,
+                         unsigned int blockage) {
+    if (capacity == 0
+        || static_cast<float>(blockage) / capacity
+               >= rbVars_.ignoreEdgeRatio) {
+      return std::numeric_limits<float>::lowest();
+    }
+    return static_cast<float>((scale * demand + blockage) / capacity);
+  };
+
+  rudyRatioH_.assign(tg_->tiles().size(), 0);
+  rudyRatioV_.assign(tg_->tiles().size(), 0);
+  for (Tile* tile : tg_->tiles()) {
+    const int idx = tile->y() * tg_->tileCntX() + tile->x();
+    unsigned int capacity, usage, blockage;
+
+    getTileTracks(tile, tech, gGrid, true, capacity, usage, blockage);
+    rudyRatioH_[idx] = getRatio(demandH[idx], rudyScaleH_, capacity, blockage);
+
+    getTileTracks(tile, tech, gGrid, false, capacity, usage, blockage);
+    rudyRatioV_[idx] = getRatio(demandV[idx], rudyScaleV_, capacity, blockage);
+
+    const float ratio = fmax(fmax(rudyRatioH_[idx], rudyRatioV_[idx]), 0.0f);
+
+    // update inflation Ratio
+    if (ratio >= rbVars_.minInflationRatio) {
+      float inflationRatio = pow(ratio, rbVars_.inflationRatioCoef);
+      inflationRatio = fmin(inflationRatio, rbVars_.maxInflationRatio);
+      tile->setInflationRatio(inflationRatio);
+    }
+  }
+}
+
+// Fits the RUDY scales to the wire usage of the last global router run.
+void RouteBase::calibrateRudy()
+{
+  odb::dbGCellGrid* gGrid = db_->getChip()->getBlock()->getGCellGrid();
+  odb::dbTech* tech = db_->getTech();
+
+  std::vector<double> demandH, demandV;
+  getRudyDemand(demandH, demandV);
+
+  double rudyH = 0, rudyV = 0;
+  double wireH = 0, wireV = 0;
+  for (Tile* tile : tg_->tiles()) {
+    const int idx = tile->y() * tg_->tileCntX() + tile->x();
+    unsigned int capacity, usage, blockage;
+
+    getTileTracks(tile, tech, gGrid, true, capacity, usage, blockage);
+    wireH += usage - std::min(usage, blockage);
+    rudyH += demandH[idx];
+
+    getTileTracks(tile, tech, gGrid, false, capacity, usage, blockage);
+    wireV += usage - std::min(usage, blockage);
+    rudyV += demandV[idx];
+  }
+
+  rudyScaleH_ = (rudyH > 0) ? wireH / rudyH : 1.0;
+  rudyScaleV_ = (rudyV > 0) ? wireV / rudyV : 1.0;
+
+  log_->info(GPL,
+             308,
+             "RUDY calibration scale H: {:.3f} V: {:.3f}",
+             rudyScaleH_,
+             rudyScaleV_);
+}
+
 // first: is Routability Need
 // second: reverting procedure init need
 //          (e.g. calling NesterovPlace's init())
@@ -568,7 +761,17 @@ std::pair<bool, bool> RouteBase::routability()
   tg_ = std::move(tg);
   tg_->setLogger(log_);
 
-  getGlobalRouterResult();
+  // The global router runs on the first and every grtPeriod-th call;
+  // the calls in between use the RUDY estimate calibrated by it.
+  useRudy_ = (numCall_ - 1) % rbVars_.grtPeriod != 0;
+  if (useRudy_) {
+    updateRudy();
+  } else {
+    getGlobalRouterResult();
+    if (rbVars_.grtPeriod > 1) {
+      calibrateRudy();
+    }
+  }
 
   // no need routing if RC is lower than targetRC val
   float curRc = getRC();
@@ -764,30 +967,42 @@ float RouteBase::getRC() const
   std::vector<double> horEdgeCongArray;
   std::vector<double> verEdgeCongArray;
 
-  odb::dbGCellGrid* gGrid = db_->getChip()->getBlock()->getGCellGrid();
-  for (auto& tile : tg_->tiles()) {
-    for (int i = 1; i <= tg_->numRoutingLayers(); i++) {
-      odb::dbTechLayer* layer = db_->getTech()->findRoutingLayer(i);
-      bool isHorizontalLayer
-          = (layer->getDirection() == odb::dbTechLayerDir::HORIZONTAL);
-
-      // extract the ratio in the same way as inflation ratio cals
-      float ratio
-          = getUsageCapacityRatio(tile, layer, gGrid, rbVars_.ignoreEdgeRatio);
+  auto addRatio = [&](float ratio, bool isHorizontalLayer) {
+    // escape the case when blockageRatio is too huge
+    if (ratio < 0.0f) {
+      return;
+    }
+    if (isHorizontalLayer) {
+      totalRouteOverflowH2 += fmax(0.0, -1 + ratio);
+      horEdgeCongArray.push_back(ratio);
+    } else {
+      totalRouteOverflowV2 += fmax(0.0, -1 + ratio);
+      verEdgeCongArray.push_back(ratio);
+    }
 
-      // escape the case when blockageRatio is too huge
-      if (ratio >= 0.0f) {
-        if (isHorizontalLayer) {
-          totalRouteOverflowH2 += fmax(0.0, -1 + ratio);
-          horEdgeCongArray.push_back(ratio);
-        } else {
-          totalRouteOverflowV2 += fmax(0.0, -1 + ratio);
-          verEdgeCongArray.push_back(ratio);
-        }
+    if (ratio > 1.0) {
+      overflowTileCnt2++;
+    }
+  };
 
-        if (ratio > 1.0) {
-          overflowTileCnt2++;
-        }
+  if (useRudy_) {
+    // one horizontal and one vertical ratio per tile
+    for (size_t i = 0; i < rudyRatioH_.size(); i++) {
+      addRatio(rudyRatioH_[i], true);
+      addRatio(rudyRatioV_[i], false);
+    }
+  } else {
+    odb::dbGCellGrid* gGrid = db_->getChip()->getBlock()->getGCellGrid();
+    for (auto& tile : tg_->tiles()) {
+      for (int i = 1; i <= tg_->numRoutingLayers(); i++) {
+        odb::dbTechLayer* layer = db_->getTech()->findRoutingLayer(i);
+        bool isHorizontalLayer
+            = (layer->getDirection() == odb::dbTechLayerDir::HORIZONTAL);
+
+        // extract the ratio in the same way as inflation ratio cals
+        float ratio = getUsageCapacityRatio(
+            tile, layer, gGrid, rbVars_.ignoreEdgeRatio);
+        addRatio(ratio, isHorizontalLayer);
       }
     }
   }
@@ -212,6 +212,10 @@ class RouteBaseVars
   int maxBloatIter;
   int maxInflationIter;
 
+  // run the global router on every grtPeriod-th routability call;
+  // the calls in between use the calibrated RUDY estimate.
+  int grtPeriod;
+
   RouteBaseVars();
   void reset();
 };
@@ -273,6 +277,21 @@ class RouteBase
   int minRcViolatedCnt_;
   std::vector<std::pair<int, int>> minRcCellSize_;
 
+  // RUDY (rectangular uniform wire density) congestion estimate.
+  // The scales map RUDY tracks to the global router's wire usage and
+  // are refreshed after every global router run.
+  bool useRudy_;
+  float rudyScaleH_;
+  float rudyScaleV_;
+  std::vector<float> rudyRatioH_;
+  std::vector<float> rudyRatioV_;
+
+  void initTileGrid();
+  void getRudyDemand(std::vector<double>& demandH,
+                     std::vector<double>& demandV) const;
+  void updateRudy();
+  void calibrateRudy();
+
   void init();
   void reset();
   void resetRoutabilityResources();
@@ -59,6 +59,7 @@ ResidualError cudaSparseSolve(int iter,
 }
 #endif
 ResidualError cpuSparseSolve(int maxSolverIter,
+                             int numThreads,
                              int iter,
                              SMatrix& placeInstForceMatrixX,
                              Eigen::VectorXf& fixedInstForceVecX,
@@ -69,7 +70,15 @@ ResidualError cpuSparseSolve(int maxSolverIter,
                              utl::Logger* logger)
 {
   ResidualError error;
-  BiCGSTAB<SMatrix, IdentityPreconditioner> solver;
+  // The B2B matrices are symmetric positive semi-definite. Using both
+  // triangles of the row major matrix lets Eigen split the SpMV of each
+  // CG step across the OpenMP threads.
+  const int prevThreads = Eigen::nbThreads();
+  Eigen::setNbThreads(numThreads);
+  ConjugateGradient<SMatrix,
+                    Eigen::Lower | Eigen::Upper,
+                    DiagonalPreconditioner<float>>
+      solver;
   solver.setMaxIterations(maxSolverIter);
   solver.compute(placeInstForceMatrixX);
   instLocVecX = solver.solveWithGuess(fixedInstForceVecX, instLocVecX);
@@ -78,6 +87,7 @@ ResidualError cpuSparseSolve(int maxSolverIter,
   solver.compute(placeInstForceMatrixY);
   instLocVecY = solver.solveWithGuess(fixedInstForceVecY, instLocVecY);
   error.y = solver.error();
+  Eigen::setNbThreads(prevThreads);
   return error;
 }
 }  // namespace gpl
\ No newline at end of file
@@ -59,8 +59,8 @@ struct ResidualError
   float y;  // The relative residual error for Y
 };
 
-using Eigen::BiCGSTAB;
-using Eigen::IdentityPreconditioner;
+using Eigen::ConjugateGradient;
+using Eigen::DiagonalPreconditioner;
 using utl::GPL;
 
 typedef Eigen::SparseMatrix<float, Eigen::RowMajor> SMatrix;
@@ -77,6 +77,7 @@ ResidualError cudaSparseSolve(int iter,
 #endif
 
 ResidualError cpuSparseSolve(int maxSolverIter,
+                             int numThreads,
                              int iter,
                              SMatrix& placeInstForceMatrixX,
                              Eigen::VectorXf& fixedInstForceVecX,
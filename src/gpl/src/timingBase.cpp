@@ -35,6 +35,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <string>
 #include <utility>
 
 #include "nesterovBase.h"
@@ -42,6 +44,7 @@
 #include "rsz/Resizer.hh"
 #include "sta/Fuzzy.hh"
 #include "utl/Logger.h"
+#include "utl/timer.h"
 
 namespace gpl {
 
@@ -49,7 +52,13 @@ using utl::GPL;
 
 // TimingBase
 TimingBase::TimingBase()
-    : rs_(nullptr), log_(nullptr), nbc_(nullptr), net_weight_max_(1.9)
+    : rs_(nullptr),
+      log_(nullptr),
+      nbc_(nullptr),
+      net_weight_max_(1.9),
+      incrementalMode_(false),
+      netMoveThreshold_(0),
+      checkpointCount_(0)
 {
 }
 
@@ -145,9 +154,72 @@ void TimingBase::setTimingNetWeightMax(float max)
   net_weight_max_ = max;
 }
 
+void TimingBase::setIncrementalMode(bool mode)
+{
+  incrementalMode_ = mode;
+}
+
+void TimingBase::setNetMoveThreshold(int threshold)
+{
+  netMoveThreshold_ = threshold;
+}
+
+void TimingBase::saveNetBoxes()
+{
+  netBoxes_.clear();
+  netBoxes_.reserve(nbc_->gNets().size());
+  for (auto& gNet : nbc_->gNets()) {
+    netBoxes_.emplace_back(gNet->lx(), gNet->ly(), gNet->ux(), gNet->uy());
+  }
+}
+
+// Mark the parasitics of nets that moved beyond netMoveThreshold_ as
+// invalid so the resizer only re-estimates those. Nets that stay below
+// the threshold keep their saved box so slow drifts still add up.
+int TimingBase::invalidateMovedNets()
+{
+  int moved_net_count = 0;
+  const auto& gNets = nbc_->gNets();
+  for (size_t i = 0; i < gNets.size(); i++) {
+    GNet* gNet = gNets[i];
+    odb::Rect& box = netBoxes_[i];
+    const int delta = std::max({std::abs(gNet->lx() - box.xMin()),
+                                std::abs(gNet->ly() - box.yMin()),
+                                std::abs(gNet->ux() - box.xMax()),
+                                std::abs(gNet->uy() - box.yMax())});
+    if (delta > netMoveThreshold_) {
+      rs_->parasiticsInvalid(gNet->net()->dbNet());
+      box.init(gNet->lx(), gNet->ly(), gNet->ux(), gNet->uy());
+      moved_net_count++;
+    }
+  }
+  return moved_net_count;
+}
+
 bool TimingBase::updateGNetWeights(float overflow)
 {
-  rs_->findResizeSlacks();
+  utl::Timer timer;
+  const int checkpoint = ++checkpointCount_;
+  const std::string metric_prefix
+      = "globalplace__timing__checkpoint_" + std::to_string(checkpoint);
+
+  // gNets_ does not change between checkpoints of one nesterov run.
+  const bool incremental = incrementalMode_ && !netBoxes_.empty()
+                           && netBoxes_.size() == nbc_->gNets().size();
+  if (incremental) {
+    const int moved_net_count = invalidateMovedNets();
+    log_->info(GPL,
+               310,
+               "Re-estimating parasitics of {} of {} nets.",
+               moved_net_count,
+               nbc_->gNets().size());
+    log_->metric(metric_prefix + "__moved_nets", moved_net_count);
+  } else {
+    saveNetBoxes();
+  }
+
+  rs_->findResizeSlacks(incremental);
+  log_->metric(metric_prefix + "__runtime", timer.elapsed());
 
   // get worst resize nets
   sta::NetSeq& worst_slack_nets = rs_->resizeWorstSlackNets();
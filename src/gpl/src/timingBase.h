@@ -36,6 +36,8 @@
 #include <memory>
 #include <vector>
 
+#include "odb/geom.h"
+
 namespace rsz {
 class Resizer;
 }
@@ -67,6 +69,11 @@ class TimingBase
 
   void setTimingNetWeightMax(float overflow);
 
+  // Incremental mode re-estimates parasitics only for nets whose bounding
+  // box moved more than the threshold (dbu) since their last estimation.
+  void setIncrementalMode(bool mode);
+  void setNetMoveThreshold(int threshold);
+
   // updateNetWeight.
   // True: successfully reweighted gnets
   // False: no slacks found
@@ -80,7 +87,16 @@ class TimingBase
   std::vector<int> timingNetWeightOverflow_;
   std::vector<int> timingOverflowChk_;
   float net_weight_max_;
+  bool incrementalMode_;
+  int netMoveThreshold_;
+  int checkpointCount_;
+
+  // gNet bounding boxes at their last parasitics estimation
+  std::vector<odb::Rect> netBoxes_;
+
   void initTimingOverflowChk();
+  int invalidateMovedNets();
+  void saveNetBoxes();
 };
 
 }  // namespace gpl
@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <set>
 #include <vector>
@@ -100,6 +101,14 @@ struct TileCongestion
   int usage;
 };
 
+// Capacity, usage and overflow summed over the gcell edges of a region.
+struct RegionCongestion
+{
+  int64_t capacity = 0;
+  int64_t usage = 0;
+  int64_t overflow = 0;
+};
+
 struct TileInformation
 {
   std::set<odb::dbNet*, cmpById> nets;
@@ -39,6 +39,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -99,6 +100,8 @@ class AbstractFastRouteRenderer;
 class GlobalRouter;
 class AbstractRoutingCongestionDataSource;
 class GRouteDbCbk;
+class GRouteObstructionsCbk;
+struct NetRC;
 
 struct RegionAdjustment
 {
@@ -169,6 +172,8 @@ class GlobalRouter : public ant::GlobalRouteSource
                            int layer,
                            float reduction_percentage);
   void setVerbose(const bool v);
+  void setNumThreads(int threads);
+  void setMazeThreads(int threads);
   void setOverflowIterations(int iterations);
   void setCongestionReportIterStep(int congestion_report_iter_step);
   void setCongestionReportFile(const char* file_name);
@@ -180,6 +185,8 @@ class GlobalRouter : public ant::GlobalRouteSource
 
   // flow functions
   void readGuides(const char* file_name);
+  void writeSegments(const char* file_name);
+  void readSegments(const char* file_name);
   void loadGuidesFromDB();
   void saveGuidesFromFile(std::unordered_map<odb::dbNet*, Guides>& guides);
   void saveGuides();
@@ -195,6 +202,10 @@ class GlobalRouter : public ant::GlobalRouteSource
                    bool start_incremental = false,
                    bool end_incremental = false);
   void saveCongestion();
+  // Capacity, usage and overflow of the gcell edges under rect on a routing
+  // layer, or on all layers when layer is -1. Answered from summed-area
+  // tables, so repeated queries don't walk the grid.
+  RegionCongestion getRegionCongestion(const odb::Rect& rect, int layer = -1);
   NetRouteMap& getRoutes() { return routes_; }
   Net* getNet(odb::dbNet* db_net);
   int getTileSize() const;
@@ -283,7 +294,7 @@ class GlobalRouter : public ant::GlobalRouteSource
                            int& num_tracks,
                            int& track_step);
   void setCapacities(int min_routing_layer, int max_routing_layer);
-  void initNets(std::vector<Net*>& nets);
+  void initNets(std::vector<Net*>& nets, bool incremental);
   bool makeFastrouteNet(Net* net);
   bool checkPinPositions(Net* net, std::vector<odb::Point>& last_pos);
   void computeGridAdjustments(int min_routing_layer, int max_routing_layer);
@@ -295,8 +306,35 @@ class GlobalRouter : public ant::GlobalRouteSource
                                 int layer,
                                 float reduction_percentage);
   void computePinOffsetAdjustments();
+  // Capacity reduction of one obstruction shape.  The shapes are
+  // scanned concurrently and their reductions applied afterwards.
+  struct ObstructionAdjustment
+  {
+    odb::Point first_tile;
+    odb::Point last_tile;
+    int layer;
+    bool vertical;
+    // Blocked intervals of the first and last tiles across the layer.
+    int first_tile_lo;
+    int first_tile_hi;
+    int last_tile_lo;
+    int last_tile_hi;
+  };
+  // Block id and generation, grid area, tile size, routing layers, clock
+  // routing layers and macro extension the obstruction adjustments were
+  // computed for.
+  using ObstructionsKey
+      = std::tuple<odb::uint, int, odb::Rect, int, int, int, int, int, int>;
+  struct ObstructionsScan;
+
   void applyObstructionAdjustment(const odb::Rect& obstruction,
                                   odb::dbTechLayer* tech_layer);
+  void applyObstructionAdjustment(const ObstructionAdjustment& adjustment);
+  // Appends the adjustment of obstruction unless it blocks no edge.
+  void makeObstructionAdjustment(
+      const odb::Rect& obstruction,
+      odb::dbTechLayer* tech_layer,
+      std::vector<ObstructionAdjustment>& adjustments) const;
   int computeNetWirelength(odb::dbNet* db_net);
   void computeWirelength();
   std::vector<Pin*> getAllPorts();
@@ -313,6 +351,7 @@ class GlobalRouter : public ant::GlobalRouteSource
   void findPins(Net* net, std::vector<RoutePt>& pins_on_grid, int& root_idx);
   float getNetSlack(Net* net);
   void computeNetSlacks();
+  void computeNetSlacks(const std::vector<Net*>& nets);
   odb::dbTechLayer* getRoutingLayerByIndex(int index);
   RoutingTracks getRoutingTracksByIndex(int layer);
   void addGuidesForLocalNets(odb::dbNet* db_net,
@@ -353,7 +392,7 @@ class GlobalRouter : public ant::GlobalRouteSource
   void checkPinPlacement();
 
   // incremental funcions
-  void updateDirtyRoutes();
+  std::vector<odb::dbNet*> updateDirtyRoutes();
   void mergeResults(NetRouteMap& routes);
   void updateDirtyNets(std::vector<Net*>& dirty_nets);
   void updateDbCongestion();
@@ -365,6 +404,7 @@ class GlobalRouter : public ant::GlobalRouteSource
   std::vector<Net*> initNetlist();
   void computeObstructionsAdjustments();
   void findLayerExtensions(std::vector<int>& layer_extensions);
+  ObstructionsKey obstructionsKey() const;
   int findObstructions(odb::Rect& die_area);
   bool layerIsBlocked(int layer,
                       const std::unordered_map<int, std::vector<odb::Rect>>&
@@ -375,7 +415,9 @@ class GlobalRouter : public ant::GlobalRouteSource
       int bottom_layer,
       int top_layer);
   int findInstancesObstructions(odb::Rect& die_area,
-                                const std::vector<int>& layer_extensions);
+                                const std::vector<int>& layer_extensions,
+                                int& macros_cnt,
+                                int& pin_out_of_die_count);
   void findNetsObstructions(odb::Rect& die_area);
   int computeMaxRoutingLayer();
   std::map<int, odb::dbTechVia*> getDefaultVias(int max_routing_layer);
@@ -396,6 +438,8 @@ class GlobalRouter : public ant::GlobalRouteSource
   odb::Point grid_origin_;
   std::unique_ptr<AbstractGrouteRenderer> groute_renderer_;
   NetRouteMap routes_;
+  // RC networks of the routes kept between estimateRC calls.
+  std::map<odb::dbNet*, std::unique_ptr<NetRC>> net_rc_cache_;
 
   std::map<odb::dbNet*, Net*, cmpById> db_net_map_;
   Grid* grid_;
@@ -422,9 +466,14 @@ class GlobalRouter : public ant::GlobalRouteSource
   std::vector<RegionAdjustment> region_adjustments_;
 
   bool verbose_;
+  int num_threads_;
+  int maze_threads_;
   int min_layer_for_clock_;
   int max_layer_for_clock_;
   float critical_nets_percentage_;
+  // slack below which nets are critical, found by the last full routing
+  bool has_critical_slack_th_;
+  float critical_slack_th_;
 
   // variables for random grt
   int seed_;
@@ -451,6 +500,18 @@ class GlobalRouter : public ant::GlobalRouteSource
   // incremental grt
   GRouteDbCbk* grouter_cbk_;
 
+  // Obstruction adjustments of the last routing, reused while the key
+  // matches and the callback has seen no change to the shapes.
+  std::vector<ObstructionAdjustment> obstruction_adjustments_;
+  ObstructionsKey obstructions_key_;
+  int obstructions_cnt_;
+  int macros_cnt_;
+  int pin_out_of_die_count_;
+  // Incremented when the block of the adjustments is destroyed, since a
+  // new block can get the same id.
+  int obstructions_generation_;
+  std::unique_ptr<GRouteObstructionsCbk> obstructions_cbk_;
+
   friend class IncrementalGRoute;
   friend class GRouteDbCbk;
   friend class RepairAntennas;
@@ -481,6 +542,35 @@ class GRouteDbCbk : public odb::dbBlockCallBackObj
   GlobalRouter* grouter_;
 };
 
+// Notes changes to the instances, obstructions and wires that the
+// obstruction adjustments are computed from.
+class GRouteObstructionsCbk : public odb::dbBlockCallBackObj
+{
+ public:
+  bool isDirty() const { return dirty_; }
+  void setDirty(bool dirty) { dirty_ = dirty; }
+
+  void inDbInstCreate(odb::dbInst* inst) override;
+  void inDbInstCreate(odb::dbInst* inst, odb::dbRegion* region) override;
+  void inDbInstDestroy(odb::dbInst* inst) override;
+  void inDbInstSwapMasterAfter(odb::dbInst* inst) override;
+  void inDbPostMoveInst(odb::dbInst* inst) override;
+  void inDbNetDestroy(odb::dbNet* net) override;
+  void inDbObstructionCreate(odb::dbObstruction* obs) override;
+  void inDbObstructionDestroy(odb::dbObstruction* obs) override;
+  void inDbWireCreate(odb::dbWire* wire) override;
+  void inDbWireDestroy(odb::dbWire* wire) override;
+  void inDbWirePostModify(odb::dbWire* wire) override;
+  void inDbSWireCreate(odb::dbSWire* wire) override;
+  void inDbSWireDestroy(odb::dbSWire* wire) override;
+  void inDbSWireAddSBox(odb::dbSBox* box) override;
+  void inDbSWireRemoveSBox(odb::dbSBox* box) override;
+  void inDbBlockSetDieArea(odb::dbBlock* block) override;
+
+ private:
+  bool dirty_ = true;
+};
+
 // Class to save global router state and monitor db updates with callbacks
 // to make incremental routing updates.
 class IncrementalGRoute
@@ -488,8 +578,10 @@ class IncrementalGRoute
  public:
   // Saves global router state and enables db callbacks.
   IncrementalGRoute(GlobalRouter* groute, odb::dbBlock* block);
-  // Update global routes for dirty nets.
-  void updateRoutes();
+  // Update global routes for dirty nets. Returns the nets whose routes
+  // changed, which includes nets moved out of congestion on top of the
+  // dirty ones.
+  std::vector<odb::dbNet*> updateRoutes();
   // Disables db callbacks.
   ~IncrementalGRoute();
 
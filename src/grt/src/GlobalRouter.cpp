@@ -71,6 +71,8 @@
 #include "stt/SteinerTreeBuilder.h"
 #include "utl/Logger.h"
 #include "utl/algorithms.h"
+#include "utl/exception.h"
+#include "utl/trace.h"
 
 namespace grt {
 
@@ -97,9 +99,13 @@ GlobalRouter::GlobalRouter()
       allow_congestion_(false),
       macro_extension_(0),
       verbose_(false),
+      num_threads_(1),
+      maze_threads_(0),
       min_layer_for_clock_(-1),
       max_layer_for_clock_(-2),
       critical_nets_percentage_(10),
+      has_critical_slack_th_(false),
+      critical_slack_th_(0),
       seed_(0),
       caps_perturbation_percentage_(0),
       perturbation_amount_(1),
@@ -109,7 +115,11 @@ GlobalRouter::GlobalRouter()
       repair_antennas_(nullptr),
       heatmap_(nullptr),
       congestion_file_name_(nullptr),
-      grouter_cbk_(nullptr)
+      grouter_cbk_(nullptr),
+      obstructions_cnt_(0),
+      macros_cnt_(0),
+      pin_out_of_die_count_(0),
+      obstructions_generation_(0)
 {
 }
 
@@ -150,6 +160,8 @@ void GlobalRouter::clear()
   fastroute_->clear();
   vertical_capacities_.clear();
   horizontal_capacities_.clear();
+  has_critical_slack_th_ = false;
+  net_rc_cache_.clear();
 }
 
 GlobalRouter::~GlobalRouter()
@@ -172,6 +184,8 @@ std::vector<Net*> GlobalRouter::initFastRoute(int min_routing_layer,
   }
 
   fastroute_->setVerbose(verbose_);
+  fastroute_->setNumThreads(num_threads_);
+  fastroute_->setMazeThreads(maze_threads_);
   fastroute_->setOverflowIterations(overflow_iterations_);
   fastroute_->setCongestionReportIterStep(congestion_report_iter_step_);
 
@@ -193,7 +207,7 @@ std::vector<Net*> GlobalRouter::initFastRoute(int min_routing_layer,
         "Timing is not available, setting critical nets percentage to 0");
   }
   std::vector<Net*> nets = initNetlist();
-  initNets(nets);
+  initNets(nets, false);
 
   applyAdjustments(min_routing_layer, max_routing_layer);
   perturbCapacities();
@@ -247,6 +261,7 @@ void GlobalRouter::globalRoute(bool save_guides,
                                bool start_incremental,
                                bool end_incremental)
 {
+  utl::TraceSpan span("grt", "global_route");
   if (start_incremental && end_incremental) {
     logger_->error(GRT,
                    251,
@@ -321,6 +336,21 @@ void GlobalRouter::globalRoute(bool save_guides,
   }
 }
 
+RegionCongestion GlobalRouter::getRegionCongestion(const odb::Rect& rect,
+                                                   int layer)
+{
+  if (routing_layers_.empty()) {
+    return RegionCongestion();
+  }
+  const int x1 = (rect.xMin() - grid_->getXMin()) / grid_->getTileSize();
+  const int y1 = (rect.yMin() - grid_->getYMin()) / grid_->getTileSize();
+  const int x2 = (rect.xMax() - grid_->getXMin()) / grid_->getTileSize();
+  const int y2 = (rect.yMax() - grid_->getYMin()) / grid_->getTileSize();
+
+  return fastroute_->getRegionCongestion(
+      x1, y1, x2, y2, layer == -1 ? -1 : layer - 1);
+}
+
 void GlobalRouter::updateDbCongestion()
 {
   fastroute_->updateDbCongestion();
@@ -350,14 +380,25 @@ void GlobalRouter::repairAntennas(odb::dbMTerm* diode_mterm,
                    diode_mterm->getMaster()->getConstName(),
                    diode_mterm->getConstName());
 
+  std::vector<odb::dbNet*> nets_to_check;
+  for (auto& [db_net, route] : routes_)
+    nets_to_check.push_back(db_net);
+
   bool violations = true;
   int itr = 0;
   while (violations && itr < iterations) {
     if (verbose_)
       logger_->info(GRT, 6, "Repairing antennas, iteration {}.", itr + 1);
     violations = repair_antennas_->checkAntennaViolations(
-        routes_, max_routing_layer_, diode_mterm, ratio_margin);
+        routes_, nets_to_check, max_routing_layer_, diode_mterm, ratio_margin);
     if (violations) {
+      // Only the violating nets and the nets rerouted around the new diodes
+      // can change status, so the next iteration checks just those.
+      std::set<odb::dbNet*> changed_nets;
+      for (auto& [db_net, net_violations] :
+           repair_antennas_->getAntennaViolations())
+        changed_nets.insert(db_net);
+
       IncrementalGRoute incr_groute(this, block_);
       repair_antennas_->repairAntennas(diode_mterm);
       logger_->info(
@@ -370,7 +411,9 @@ void GlobalRouter::repairAntennas(odb::dbMTerm* diode_mterm,
                       "Using detailed placer to place {} diodes.",
                       illegal_diode_placement_count);
       repair_antennas_->legalizePlacedCells();
-      incr_groute.updateRoutes();
+      for (odb::dbNet* db_net : incr_groute.updateRoutes())
+        changed_nets.insert(db_net);
+      nets_to_check.assign(changed_nets.begin(), changed_nets.end());
     }
     repair_antennas_->clearViolations();
     itr++;
@@ -421,15 +464,46 @@ void GlobalRouter::estimateRC()
   // Make separate parasitics for each corner, same for min/max.
   sta_->setParasiticAnalysisPts(true, false);
 
-  MakeWireParasitics builder(logger_, resizer_, sta_, db_->getTech(), this);
-  for (auto& net_route : routes_) {
-    odb::dbNet* db_net = net_route.first;
-    GRoute& route = net_route.second;
+  struct NetEstimate
+  {
+    odb::dbNet* db_net;
+    Net* net;
+    GRoute* route;
+    NetRC* rc;
+  };
+  std::vector<NetEstimate> estimates;
+  for (auto& [db_net, route] : routes_) {
     if (!route.empty()) {
-      Net* net = getNet(db_net);
-      builder.estimateParasitcs(db_net, net->getPins(), route);
+      std::unique_ptr<NetRC>& rc = net_rc_cache_[db_net];
+      if (rc == nullptr) {
+        rc = std::make_unique<NetRC>();
+      }
+      estimates.push_back({db_net, getNet(db_net), &route, rc.get()});
     }
   }
+
+  // The RC networks are built concurrently and only committed to the sta
+  // parasitics serially. Nets whose route and pins did not change since
+  // the last estimate reuse their network.
+  MakeWireParasitics builder(logger_, resizer_, sta_, db_->getTech(), this);
+  utl::ThreadException exception;
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic, 64)
+  for (int i = 0; i < (int) estimates.size(); i++) {
+    try {
+      NetEstimate& estimate = estimates[i];
+      builder.makeNetRC(estimate.db_net,
+                        estimate.net->getPins(),
+                        *estimate.route,
+                        *estimate.rc);
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+
+  for (NetEstimate& estimate : estimates) {
+    builder.makeParasitics(estimate.db_net, *estimate.rc);
+  }
 }
 
 void GlobalRouter::estimateRC(odb::dbNet* db_net)
@@ -442,7 +516,12 @@ void GlobalRouter::estimateRC(odb::dbNet* db_net)
   GRoute& route = iter->second;
   if (!route.empty()) {
     Net* net = getNet(db_net);
-    builder.estimateParasitcs(db_net, net->getPins(), route);
+    std::unique_ptr<NetRC>& rc = net_rc_cache_[db_net];
+    if (rc == nullptr) {
+      rc = std::make_unique<NetRC>();
+    }
+    builder.makeNetRC(db_net, net->getPins(), route, *rc);
+    builder.makeParasitics(db_net, *rc);
   }
 }
 
@@ -761,6 +840,8 @@ void GlobalRouter::computeNetSlacks()
     }
   }
 
+  has_critical_slack_th_ = true;
+  critical_slack_th_ = slack_th;
   if (slack_th >= 0) {
     return;
   }
@@ -772,9 +853,30 @@ void GlobalRouter::computeNetSlacks()
   }
 }
 
-void GlobalRouter::initNets(std::vector<Net*>& nets)
+// Times only the nets rerouted incrementally, comparing them against the
+// critical slack threshold of the last full routing instead of timing
+// every net of the design again.
+void GlobalRouter::computeNetSlacks(const std::vector<Net*>& nets)
+{
+  if (!has_critical_slack_th_) {
+    computeNetSlacks();
+    return;
+  }
+
+  for (Net* net : nets) {
+    const float slack = getNetSlack(net);
+    net->setSlack(critical_slack_th_ < 0 && slack <= critical_slack_th_
+                      ? slack
+                      : 0);
+  }
+}
+
+void GlobalRouter::initNets(std::vector<Net*>& nets, bool incremental)
 {
-  checkPinPlacement();
+  // ports are not moved by the ECOs rerouted incrementally
+  if (!incremental) {
+    checkPinPlacement();
+  }
   pad_pins_connections_.clear();
 
   int min_degree = std::numeric_limits<int>::max();
@@ -793,7 +895,11 @@ void GlobalRouter::initNets(std::vector<Net*>& nets)
 
   if (critical_nets_percentage_ != 0) {
     fastroute_->setUpdateSlack(critical_nets_percentage_);
-    computeNetSlacks();
+    if (incremental) {
+      computeNetSlacks(nets);
+    } else {
+      computeNetSlacks();
+    }
   }
 
   for (Net* net : nets) {
@@ -1256,6 +1362,40 @@ void GlobalRouter::computeRegionAdjustments(const odb::Rect& region,
 
 void GlobalRouter::applyObstructionAdjustment(const odb::Rect& obstruction,
                                               odb::dbTechLayer* tech_layer)
+{
+  std::vector<ObstructionAdjustment> adjustments;
+  makeObstructionAdjustment(obstruction, tech_layer, adjustments);
+  for (const ObstructionAdjustment& adjustment : adjustments) {
+    applyObstructionAdjustment(adjustment);
+  }
+}
+
+void GlobalRouter::applyObstructionAdjustment(
+    const ObstructionAdjustment& adjustment)
+{
+  const interval<int>::type first_tile_reduce_interval(
+      adjustment.first_tile_lo, adjustment.first_tile_hi);
+  const interval<int>::type last_tile_reduce_interval(
+      adjustment.last_tile_lo, adjustment.last_tile_hi);
+  if (!adjustment.vertical) {
+    fastroute_->addHorizontalAdjustments(adjustment.first_tile,
+                                         adjustment.last_tile,
+                                         adjustment.layer,
+                                         first_tile_reduce_interval,
+                                         last_tile_reduce_interval);
+  } else {
+    fastroute_->addVerticalAdjustments(adjustment.first_tile,
+                                       adjustment.last_tile,
+                                       adjustment.layer,
+                                       first_tile_reduce_interval,
+                                       last_tile_reduce_interval);
+  }
+}
+
+void GlobalRouter::makeObstructionAdjustment(
+    const odb::Rect& obstruction,
+    odb::dbTechLayer* tech_layer,
+    std::vector<ObstructionAdjustment>& adjustments) const
 {
   // compute the intersection between obstruction and the die area
   // only when they are overlapping to avoid assert error during
@@ -1294,19 +1434,19 @@ void GlobalRouter::applyObstructionAdjustment(const odb::Rect& obstruction,
                                          false,
                                          tech_layer->getDirection());
 
-  if (!vertical) {
-    fastroute_->addHorizontalAdjustments(first_tile,
-                                         last_tile,
-                                         layer,
-                                         first_tile_reduce_interval,
-                                         last_tile_reduce_interval);
-  } else {
-    fastroute_->addVerticalAdjustments(first_tile,
-                                       last_tile,
-                                       layer,
-                                       first_tile_reduce_interval,
-                                       last_tile_reduce_interval);
+  // Shapes within one gcell along the routing direction block no edge
+  if ((!vertical && first_tile.x() == last_tile.x())
+      || (vertical && first_tile.y() == last_tile.y())) {
+    return;
   }
+  adjustments.push_back({first_tile,
+                         last_tile,
+                         layer,
+                         vertical,
+                         first_tile_reduce_interval.lower(),
+                         first_tile_reduce_interval.upper(),
+                         last_tile_reduce_interval.lower(),
+                         last_tile_reduce_interval.upper()});
 }
 
 void GlobalRouter::setAdjustment(const float adjustment)
@@ -1375,6 +1515,16 @@ void GlobalRouter::setVerbose(const bool v)
   verbose_ = v;
 }
 
+void GlobalRouter::setNumThreads(int threads)
+{
+  num_threads_ = threads;
+}
+
+void GlobalRouter::setMazeThreads(int threads)
+{
+  maze_threads_ = threads;
+}
+
 void GlobalRouter::setOverflowIterations(int iterations)
 {
   overflow_iterations_ = iterations;
@@ -1483,7 +1633,7 @@ void GlobalRouter::initGridAndNets()
     applyAdjustments(min_layer, max_layer);
   }
   std::vector<Net*> nets = initNetlist();
-  initNets(nets);
+  initNets(nets, false);
 }
 
 void GlobalRouter::readGuides(const char* file_name)
@@ -1570,6 +1720,129 @@ void GlobalRouter::readGuides(const char* file_name)
   saveGuidesFromFile(guides);
 }
 
+// Writes the global routing segments of every net so a later session can
+// restore them with readSegments without running FastRoute again. The grid
+// is written first so the segments are only restored onto the same gcells.
+void GlobalRouter::writeSegments(const char* file_name)
+{
+  if (routes_.empty()) {
+    logger_->error(GRT, 253, "Run global_route before writing segments.");
+  }
+
+  std::ofstream segs_file(file_name);
+  if (!segs_file.is_open()) {
+    logger_->error(GRT, 254, "Failed to open segments file {}.", file_name);
+  }
+
+  segs_file << "grid " << grid_->getXMin() << " " << grid_->getYMin() << " "
+            << grid_->getTileSize() << " " << grid_->getXGrids() << " "
+            << grid_->getYGrids() << "\n";
+
+  for (auto& [db_net, route] : routes_) {
+    if (route.empty()) {
+      continue;
+    }
+    segs_file << db_net->getName() << "\n";
+    for (const GSegment& segment : route) {
+      segs_file << segment.init_x << " " << segment.init_y << " "
+                << routing_layers_[segment.init_layer]->getName() << " "
+                << segment.final_x << " " << segment.final_y << " "
+                << routing_layers_[segment.final_layer]->getName() << "\n";
+    }
+  }
+}
+
+void GlobalRouter::readSegments(const char* file_name)
+{
+  if (db_->getChip() == nullptr || db_->getChip()->getBlock() == nullptr
+      || db_->getTech() == nullptr) {
+    logger_->error(GRT, 255, "Load design before reading segments.");
+  }
+
+  initGridAndNets();
+  net_rc_cache_.clear();
+
+  std::ifstream fin(file_name);
+  if (!fin.is_open()) {
+    logger_->error(GRT, 256, "Failed to open segments file {}.", file_name);
+  }
+
+  odb::dbTech* tech = db_->getTech();
+  odb::dbNet* net = nullptr;
+  bool skip = false;
+  bool grid_checked = false;
+  std::string line;
+  while (getline(fin, line)) {
+    std::stringstream ss(line);
+    std::vector<std::string> tokens;
+    std::string word;
+    while (ss >> word) {
+      tokens.push_back(word);
+    }
+
+    if (tokens.empty()) {
+      continue;
+    }
+
+    if (!grid_checked) {
+      if (tokens.size() != 6 || tokens[0] != "grid") {
+        logger_->error(GRT, 257, "Error reading segments file {}.", file_name);
+      }
+      if (stoi(tokens[1]) != grid_->getXMin()
+          || stoi(tokens[2]) != grid_->getYMin()
+          || stoi(tokens[3]) != grid_->getTileSize()
+          || stoi(tokens[4]) != grid_->getXGrids()
+          || stoi(tokens[5]) != grid_->getYGrids()) {
+        logger_->error(GRT,
+                       258,
+                       "Segments file {} was written with a different "
+                       "routing grid.",
+                       file_name);
+      }
+      grid_checked = true;
+    } else if (tokens.size() == 1) {
+      net = block_->findNet(tokens[0].c_str());
+      if (!net) {
+        logger_->error(GRT, 259, "Cannot find net {}.", tokens[0]);
+      }
+      skip = db_net_map_.find(net) == db_net_map_.end();
+      if (skip) {
+        logger_->warn(GRT,
+                      260,
+                      "Net {} has segments but is not routed by the global "
+                      "router and will be skipped.",
+                      net->getName());
+      }
+    } else if (tokens.size() == 6 && net != nullptr) {
+      if (skip) {
+        continue;
+      }
+      odb::dbTechLayer* layer0 = tech->findLayer(tokens[2].c_str());
+      odb::dbTechLayer* layer1 = tech->findLayer(tokens[5].c_str());
+      if (!layer0 || !layer1) {
+        logger_->error(GRT,
+                       261,
+                       "Cannot find layer {}.",
+                       !layer0 ? tokens[2] : tokens[5]);
+      }
+      routes_[net].push_back(GSegment(stoi(tokens[0]),
+                                      stoi(tokens[1]),
+                                      layer0->getRoutingLevel(),
+                                      stoi(tokens[3]),
+                                      stoi(tokens[4]),
+                                      layer1->getRoutingLevel()));
+    } else {
+      logger_->error(GRT, 262, "Error reading segments file {}.", file_name);
+    }
+  }
+
+  updateEdgesUsage();
+  updateDbCongestionFromGuides();
+  heatmap_->update();
+  saveGuides();
+  computeWirelength();
+}
+
 void GlobalRouter::loadGuidesFromDB()
 {
   initGridAndNets();
@@ -2823,6 +3096,7 @@ void GlobalRouter::removeNet(odb::dbNet* db_net)
   db_net_map_.erase(db_net);
   dirty_nets_.erase(db_net);
   routes_.erase(db_net);
+  net_rc_cache_.erase(db_net);
 }
 
 Net* GlobalRouter::getNet(odb::dbNet* db_net)
@@ -3032,19 +3306,75 @@ std::string getLayerName(int layer_idx, odb::dbDatabase* db)
   return tech_layer->getName();
 }
 
+// The obstruction, instance and net shapes are scanned into a list of
+// adjustments that is kept for the next routing of the same block.
+// They are rescanned only when the grid or layer settings change or the
+// callback saw a change to the shapes.
 void GlobalRouter::computeObstructionsAdjustments()
 {
-  odb::Rect die_area(
-      grid_->getXMin(), grid_->getYMin(), grid_->getXMax(), grid_->getYMax());
-  std::vector<int> layer_extensions;
+  // The block removes the owner of its callbacks when it is destroyed
+  if (obstructions_cbk_ != nullptr && !obstructions_cbk_->hasOwner()) {
+    obstructions_cbk_->setDirty(true);
+    obstructions_generation_++;
+  }
+  const ObstructionsKey key = obstructionsKey();
+  if (obstructions_cbk_ == nullptr || obstructions_cbk_->isDirty()
+      || key != obstructions_key_) {
+    odb::Rect die_area(grid_->getXMin(),
+                       grid_->getYMin(),
+                       grid_->getXMax(),
+                       grid_->getYMax());
+    std::vector<int> layer_extensions;
+
+    obstruction_adjustments_.clear();
+    findLayerExtensions(layer_extensions);
+    obstructions_cnt_ = findObstructions(die_area);
+    obstructions_cnt_ += findInstancesObstructions(
+        die_area, layer_extensions, macros_cnt_, pin_out_of_die_count_);
+    findNetsObstructions(die_area);
+
+    if (obstructions_cbk_ == nullptr) {
+      obstructions_cbk_ = std::make_unique<GRouteObstructionsCbk>();
+    }
+    obstructions_cbk_->addOwner(block_);
+    obstructions_cbk_->setDirty(false);
+    obstructions_key_ = key;
+  } else {
+    debugPrint(logger_,
+               GRT,
+               "obstructions",
+               1,
+               "Reusing {} obstruction adjustments.",
+               obstruction_adjustments_.size());
+  }
 
-  findLayerExtensions(layer_extensions);
-  int obstructions_cnt = findObstructions(die_area);
-  obstructions_cnt += findInstancesObstructions(die_area, layer_extensions);
-  findNetsObstructions(die_area);
+  for (const ObstructionAdjustment& adjustment : obstruction_adjustments_) {
+    applyObstructionAdjustment(adjustment);
+  }
 
-  if (verbose_)
-    logger_->info(GRT, 4, "Blockages: {}", obstructions_cnt);
+  if (pin_out_of_die_count_ > 0) {
+    if (verbose_)
+      logger_->error(
+          GRT, 28, "Found {} pins outside die area.", pin_out_of_die_count_);
+  }
+
+  if (verbose_) {
+    logger_->info(GRT, 3, "Macros: {}", macros_cnt_);
+    logger_->info(GRT, 4, "Blockages: {}", obstructions_cnt_);
+  }
+}
+
+GlobalRouter::ObstructionsKey GlobalRouter::obstructionsKey() const
+{
+  return ObstructionsKey(block_->getId(),
+                         obstructions_generation_,
+                         grid_->getGridArea(),
+                         grid_->getTileSize(),
+                         min_routing_layer_,
+                         max_routing_layer_,
+                         min_layer_for_clock_,
+                         max_layer_for_clock_,
+                         macro_extension_);
 }
 
 void GlobalRouter::findLayerExtensions(std::vector<int>& layer_extensions)
@@ -3115,8 +3445,9 @@ int GlobalRouter::findObstructions(odb::Rect& die_area)
         if (verbose_)
           logger_->warn(GRT, 37, "Found blockage outside die area.");
       }
-      applyObstructionAdjustment(obstruction_rect,
-                                 obstruction_box->getTechLayer());
+      makeObstructionAdjustment(obstruction_rect,
+                                obstruction_box->getTechLayer(),
+                                obstruction_adjustments_);
       obstructions_cnt++;
     }
   }
@@ -3197,15 +3528,33 @@ void GlobalRouter::extendObstructions(
   }
 }
 
-int GlobalRouter::findInstancesObstructions(
-    odb::Rect& die_area,
-    const std::vector<int>& layer_extensions)
+// Shapes of a range of instances or nets scanned by one thread, with the
+// shapes outside the die area to warn about once the scan is done.
+struct GlobalRouter::ObstructionsScan
 {
-  int macros_cnt = 0;
+  std::vector<ObstructionAdjustment> adjustments;
   int obstructions_cnt = 0;
+  int macros_cnt = 0;
   int pin_out_of_die_count = 0;
+  // (instance, nullptr) for an obstruction and (instance, mterm) for a
+  // pin outside the die area, in scan order.
+  std::vector<std::pair<odb::dbInst*, odb::dbMTerm*>> inst_outside;
+  // (net, message id) for each wire outside the die area, in scan order.
+  std::vector<std::pair<odb::dbNet*, int>> net_outside;
+};
+
+// Number of instances or nets in a scan task.
+static constexpr int obstructions_scan_chunk = 1024;
+
+int GlobalRouter::findInstancesObstructions(
+    odb::Rect& die_area,
+    const std::vector<int>& layer_extensions,
+    int& macros_cnt,
+    int& pin_out_of_die_count)
+{
   odb::dbTech* tech = db_->getTech();
-  for (odb::dbInst* inst : block_->getInsts()) {
+
+  auto scanInst = [&](odb::dbInst* inst, ObstructionsScan& scan) {
     int pX, pY;
 
     odb::dbMaster* master = inst->getMaster();
@@ -3217,7 +3566,7 @@ int GlobalRouter::findInstancesObstructions(
 
     bool isMacro = false;
     if (master->isBlock()) {
-      macros_cnt++;
+      scan.macros_cnt++;
       isMacro = true;
     }
 
@@ -3233,7 +3582,7 @@ int GlobalRouter::findInstancesObstructions(
           transform.apply(rect);
 
           macro_obs_per_layer[layer].push_back(rect);
-          obstructions_cnt++;
+          scan.obstructions_cnt++;
 
           bottom_layer = std::min(bottom_layer, layer);
           top_layer = std::max(top_layer, layer);
@@ -3251,7 +3600,8 @@ int GlobalRouter::findInstancesObstructions(
           cur_obs.set_ylo(cur_obs.yMin() - layer_extension);
           cur_obs.set_xhi(cur_obs.xMax() + layer_extension);
           cur_obs.set_yhi(cur_obs.yMax() + layer_extension);
-          applyObstructionAdjustment(cur_obs, tech->findRoutingLayer(layer));
+          makeObstructionAdjustment(
+              cur_obs, tech->findRoutingLayer(layer), scan.adjustments);
         }
       }
     } else {
@@ -3265,14 +3615,11 @@ int GlobalRouter::findInstancesObstructions(
           odb::Point upper_bound = odb::Point(rect.xMax(), rect.yMax());
           odb::Rect obstruction_rect = odb::Rect(lower_bound, upper_bound);
           if (!die_area.contains(obstruction_rect)) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            38,
-                            "Found blockage outside die area in instance {}.",
-                            inst->getConstName());
+            scan.inst_outside.emplace_back(inst, nullptr);
           }
-          applyObstructionAdjustment(obstruction_rect, box->getTechLayer());
-          obstructions_cnt++;
+          makeObstructionAdjustment(
+              obstruction_rect, box->getTechLayer(), scan.adjustments);
+          scan.obstructions_cnt++;
         }
       }
     }
@@ -3302,28 +3649,67 @@ int GlobalRouter::findInstancesObstructions(
             pin_box = odb::Rect(lower_bound, upper_bound);
             if (!die_area.contains(pin_box)
                 && !mterm->getSigType().isSupply()) {
-              logger_->warn(GRT,
-                            39,
-                            "Found pin {} outside die area in instance {}.",
-                            mterm->getConstName(),
-                            inst->getConstName());
-              pin_out_of_die_count++;
+              scan.inst_outside.emplace_back(inst, mterm);
+              scan.pin_out_of_die_count++;
             }
-            applyObstructionAdjustment(pin_box, box->getTechLayer());
+            makeObstructionAdjustment(
+                pin_box, box->getTechLayer(), scan.adjustments);
           }
         }
       }
     }
+  };
+
+  std::vector<odb::dbInst*> insts;
+  for (odb::dbInst* inst : block_->getInsts()) {
+    insts.push_back(inst);
+  }
+  const int inst_count = insts.size();
+  const int chunk_count
+      = (inst_count + obstructions_scan_chunk - 1) / obstructions_scan_chunk;
+  std::vector<ObstructionsScan> scans(chunk_count);
+  utl::ThreadException exception;
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic, 1)
+  for (int chunk = 0; chunk < chunk_count; chunk++) {
+    try {
+      const int begin = chunk * obstructions_scan_chunk;
+      const int end = std::min(begin + obstructions_scan_chunk, inst_count);
+      for (int i = begin; i < end; i++) {
+        scanInst(insts[i], scans[chunk]);
+      }
+    } catch (...) {
+      exception.capture();
+    }
   }
+  exception.rethrow();
 
-  if (pin_out_of_die_count > 0) {
-    if (verbose_)
-      logger_->error(
-          GRT, 28, "Found {} pins outside die area.", pin_out_of_die_count);
+  int obstructions_cnt = 0;
+  macros_cnt = 0;
+  pin_out_of_die_count = 0;
+  for (ObstructionsScan& scan : scans) {
+    obstruction_adjustments_.insert(obstruction_adjustments_.end(),
+                                    scan.adjustments.begin(),
+                                    scan.adjustments.end());
+    obstructions_cnt += scan.obstructions_cnt;
+    macros_cnt += scan.macros_cnt;
+    pin_out_of_die_count += scan.pin_out_of_die_count;
+    for (auto [inst, mterm] : scan.inst_outside) {
+      if (mterm == nullptr) {
+        if (verbose_)
+          logger_->warn(GRT,
+                        38,
+                        "Found blockage outside die area in instance {}.",
+                        inst->getConstName());
+      } else {
+        logger_->warn(GRT,
+                      39,
+                      "Found pin {} outside die area in instance {}.",
+                      mterm->getConstName(),
+                      inst->getConstName());
+      }
+    }
   }
 
-  if (verbose_)
-    logger_->info(GRT, 3, "Macros: {}", macros_cnt);
   return obstructions_cnt;
 }
 
@@ -3335,11 +3721,11 @@ void GlobalRouter::findNetsObstructions(odb::Rect& die_area)
     logger_->error(GRT, 94, "Design with no nets.");
   }
 
-  for (odb::dbNet* db_net : nets) {
+  auto scanNet = [&](odb::dbNet* db_net, ObstructionsScan& scan) {
     uint wire_cnt = 0, via_cnt = 0;
     db_net->getWireCount(wire_cnt, via_cnt);
     if (wire_cnt == 0)
-      continue;
+      return;
 
     if (db_net->getSigType().isSupply()) {
       for (odb::dbSWire* swire : db_net->getSWires()) {
@@ -3357,13 +3743,10 @@ void GlobalRouter::findNetsObstructions(odb::Rect& die_area)
                   = odb::Point(wire_rect.xMax(), wire_rect.yMax());
               odb::Rect obstruction_rect = odb::Rect(lower_bound, upper_bound);
               if (!die_area.contains(obstruction_rect)) {
-                if (verbose_)
-                  logger_->warn(GRT,
-                                40,
-                                "Net {} has wires outside die area.",
-                                db_net->getConstName());
+                scan.net_outside.emplace_back(db_net, 40);
               }
-              applyObstructionAdjustment(obstruction_rect, s->getTechLayer());
+              makeObstructionAdjustment(
+                  obstruction_rect, s->getTechLayer(), scan.adjustments);
             }
           }
         }
@@ -3389,19 +3772,60 @@ void GlobalRouter::findNetsObstructions(odb::Rect& die_area)
                   = odb::Point(wire_rect.xMax(), wire_rect.yMax());
               odb::Rect obstruction_rect = odb::Rect(lower_bound, upper_bound);
               if (!die_area.contains(obstruction_rect)) {
-                if (verbose_)
-                  logger_->warn(GRT,
-                                41,
-                                "Net {} has wires outside die area.",
-                                db_net->getConstName());
+                scan.net_outside.emplace_back(db_net, 41);
               }
-              applyObstructionAdjustment(obstruction_rect,
-                                         pshape.shape.getTechLayer());
+              makeObstructionAdjustment(obstruction_rect,
+                                        pshape.shape.getTechLayer(),
+                                        scan.adjustments);
             }
           }
         }
       }
     }
+  };
+
+  std::vector<odb::dbNet*> db_nets;
+  for (odb::dbNet* db_net : nets) {
+    db_nets.push_back(db_net);
+  }
+  const int net_count = db_nets.size();
+  const int chunk_count
+      = (net_count + obstructions_scan_chunk - 1) / obstructions_scan_chunk;
+  std::vector<ObstructionsScan> scans(chunk_count);
+  utl::ThreadException exception;
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic, 1)
+  for (int chunk = 0; chunk < chunk_count; chunk++) {
+    try {
+      const int begin = chunk * obstructions_scan_chunk;
+      const int end = std::min(begin + obstructions_scan_chunk, net_count);
+      for (int i = begin; i < end; i++) {
+        scanNet(db_nets[i], scans[chunk]);
+      }
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+
+  for (ObstructionsScan& scan : scans) {
+    obstruction_adjustments_.insert(obstruction_adjustments_.end(),
+                                    scan.adjustments.begin(),
+                                    scan.adjustments.end());
+    if (verbose_) {
+      for (auto [db_net, id] : scan.net_outside) {
+        if (id == 40) {
+          logger_->warn(GRT,
+                        40,
+                        "Net {} has wires outside die area.",
+                        db_net->getConstName());
+        } else {
+          logger_->warn(GRT,
+                        41,
+                        "Net {} has wires outside die area.",
+                        db_net->getConstName());
+        }
+      }
+    }
   }
 }
 
@@ -3912,9 +4336,9 @@ IncrementalGRoute::IncrementalGRoute(GlobalRouter* groute, odb::dbBlock* block)
   db_cbk_.addOwner(block);
 }
 
-void IncrementalGRoute::updateRoutes()
+std::vector<odb::dbNet*> IncrementalGRoute::updateRoutes()
 {
-  groute_->updateDirtyRoutes();
+  return groute_->updateDirtyRoutes();
 }
 
 IncrementalGRoute::~IncrementalGRoute()
@@ -3940,8 +4364,9 @@ void GlobalRouter::addDirtyNet(odb::dbNet* net)
   dirty_nets_.insert(net);
 }
 
-void GlobalRouter::updateDirtyRoutes()
+std::vector<odb::dbNet*> GlobalRouter::updateDirtyRoutes()
 {
+  std::vector<odb::dbNet*> rerouted_nets;
   if (!dirty_nets_.empty()) {
     fastroute_->setVerbose(false);
     if (verbose_)
@@ -3956,7 +4381,7 @@ void GlobalRouter::updateDirtyRoutes()
     updateDirtyNets(dirty_nets);
 
     if (dirty_nets.empty()) {
-      return;
+      return rerouted_nets;
     }
 
     initFastRouteIncr(dirty_nets);
@@ -3965,6 +4390,12 @@ void GlobalRouter::updateDirtyRoutes()
         = findRouting(dirty_nets, min_routing_layer_, max_routing_layer_);
     mergeResults(new_route);
 
+    // nets moved out of the congestion are rerouted without being dirty
+    std::set<odb::dbNet*> rerouted;
+    for (const auto& [db_net, route] : new_route) {
+      rerouted.insert(db_net);
+    }
+
     bool reroutingOverflow = true;
     if (fastroute_->has2Doverflow() && !allow_congestion_) {
       // The maximum number of times that the nets traversing the congestion
@@ -3990,6 +4421,9 @@ void GlobalRouter::updateDirtyRoutes()
         NetRouteMap new_route
             = findRouting(dirty_nets, min_routing_layer_, max_routing_layer_);
         mergeResults(new_route);
+        for (const auto& [db_net, route] : new_route) {
+          rerouted.insert(db_net);
+        }
         add_max--;
       }
       if (fastroute_->has2Doverflow()) {
@@ -3999,12 +4433,14 @@ void GlobalRouter::updateDirtyRoutes()
                        "heatmap in the GUI.");
       }
     }
+    rerouted_nets.assign(rerouted.begin(), rerouted.end());
   }
+  return rerouted_nets;
 }
 
 void GlobalRouter::initFastRouteIncr(std::vector<Net*>& nets)
 {
-  initNets(nets);
+  initNets(nets, true);
   fastroute_->initAuxVar();
 }
 
@@ -4066,6 +4502,87 @@ void GRouteDbCbk::inDbBTermPreDisconnect(odb::dbBTerm* bterm)
   grouter_->addDirtyNet(bterm->getNet());
 }
 
+void GRouteObstructionsCbk::inDbInstCreate(odb::dbInst* inst)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbInstCreate(odb::dbInst* inst,
+                                           odb::dbRegion* region)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbInstDestroy(odb::dbInst* inst)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbInstSwapMasterAfter(odb::dbInst* inst)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbPostMoveInst(odb::dbInst* inst)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbNetDestroy(odb::dbNet* net)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbObstructionCreate(odb::dbObstruction* obs)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbObstructionDestroy(odb::dbObstruction* obs)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbWireCreate(odb::dbWire* wire)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbWireDestroy(odb::dbWire* wire)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbWirePostModify(odb::dbWire* wire)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbSWireCreate(odb::dbSWire* wire)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbSWireDestroy(odb::dbSWire* wire)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbSWireAddSBox(odb::dbSBox* box)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbSWireRemoveSBox(odb::dbSBox* box)
+{
+  dirty_ = true;
+}
+
+void GRouteObstructionsCbk::inDbBlockSetDieArea(odb::dbBlock* block)
+{
+  dirty_ = true;
+}
+
 ////////////////////////////////////////////////////////////////
 
 GSegment::GSegment(int x0, int y0, int l0, int x1, int y1, int l1)
@@ -113,6 +113,18 @@ set_verbose(bool v)
   getGlobalRouter()->setVerbose(v);
 }
 
+void
+set_num_threads(int threads)
+{
+  getGlobalRouter()->setNumThreads(threads);
+}
+
+void
+set_maze_threads(int threads)
+{
+  getGlobalRouter()->setMazeThreads(threads);
+}
+
 void
 set_overflow_iterations(int iterations)
 {
@@ -236,6 +248,18 @@ read_guides(const char* fileName)
   getGlobalRouter()->readGuides(fileName);
 }
 
+void
+write_segments(const char* file_name)
+{
+  getGlobalRouter()->writeSegments(file_name);
+}
+
+void
+read_segments(const char* file_name)
+{
+  getGlobalRouter()->readSegments(file_name);
+}
+
 void set_global_route_debug_cmd(const odb::dbNet *net,
                                 bool steinerTree,
                                 bool rectilinearSTree,
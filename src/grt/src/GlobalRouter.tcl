@@ -198,6 +198,7 @@ sta::define_cmd_args "global_route" {[-guide_file out_file] \
                                   [-critical_nets_percentage percent] \
                                   [-allow_congestion] \
                                   [-verbose] \
+                                  [-parallel_maze_route] \
                                   [-start_incremental] \
                                   [-end_incremental]
 }
@@ -207,7 +208,8 @@ proc global_route { args } {
     keys {-guide_file -congestion_iterations -congestion_report_file \
           -overflow_iterations -grid_origin -critical_nets_percentage -congestion_report_iter_step
          } \
-    flags {-allow_congestion -allow_overflow -verbose -start_incremental -end_incremental}
+    flags {-allow_congestion -allow_overflow -verbose -parallel_maze_route \
+           -start_incremental -end_incremental}
 
   sta::check_argc_eq0 "global_route" $args
 
@@ -220,6 +222,13 @@ proc global_route { args } {
   }
 
   grt::set_verbose [info exists flags(-verbose)]
+  grt::set_num_threads [ord::thread_count]
+
+  if { [info exists flags(-parallel_maze_route)] } {
+    grt::set_maze_threads [ord::thread_count]
+  } else {
+    grt::set_maze_threads 0
+  }
 
   if { [info exists keys(-grid_origin)] } {
     set origin $keys(-grid_origin)
@@ -334,6 +343,7 @@ proc repair_antennas { args } {
       }
     }
 
+    ant::set_num_threads [ord::thread_count]
     grt::repair_antennas $diode_mterm $iterations $ratio_margin
   } else {
     utl::error GRT 45 "Run global_route before repair_antennas."
@@ -367,6 +377,22 @@ proc read_guides { args } {
   grt::read_guides $file_name
 }
 
+sta::define_cmd_args "write_global_route_segments" { file_name }
+
+proc write_global_route_segments { args } {
+  sta::check_argc_eq1 "write_global_route_segments" $args
+  set file_name [lindex $args 0]
+  grt::write_segments $file_name
+}
+
+sta::define_cmd_args "read_global_route_segments" { file_name }
+
+proc read_global_route_segments { args } {
+  sta::check_argc_eq1 "read_global_route_segments" $args
+  set file_name [lindex $args 0]
+  grt::read_segments $file_name
+}
+
 sta::define_cmd_args "draw_route_guides" { net_names \
                                            [-show_pin_locations] }
 
@@ -70,13 +70,12 @@ MakeWireParasitics::MakeWireParasitics(utl::Logger* logger,
 {
 }
 
-void MakeWireParasitics::estimateParasitcs(odb::dbNet* net,
-                                           std::vector<Pin>& pins,
-                                           GRoute& route) const
+void MakeWireParasitics::reportRoute(odb::dbNet* net,
+                                     const GRoute& route) const
 {
   debugPrint(logger_, GRT, "est_rc", 1, "net {}", net->getConstName());
   if (logger_->debugCheck(GRT, "est_rc", 2)) {
-    for (GSegment& segment : route) {
+    for (GSegment segment : route) {
       logger_->report(
           "({:.2f}, {:.2f}) {:2d} -> ({:.2f}, {:.2f}) {:2d} l={:.2f}",
           grouter_->dbuToMicrons(segment.init_x),
@@ -88,53 +87,11 @@ void MakeWireParasitics::estimateParasitcs(odb::dbNet* net,
           grouter_->dbuToMicrons(segment.length()));
     }
   }
-
-  sta::Net* sta_net = network_->dbToSta(net);
-
-  sta::OperatingConditions* op_cond
-      = sta_->sdc()->operatingConditions(min_max_);
-  sta::ReducedParasiticType reduce_to
-      = sta_->arcDelayCalc()->reducedParasiticType();
-  for (sta::Corner* corner : *sta_->corners()) {
-    NodeRoutePtMap node_map;
-
-    sta::ParasiticAnalysisPt* analysis_point
-        = corner->findParasiticAnalysisPt(min_max_);
-    sta::Parasitic* parasitic
-        = parasitics_->makeParasiticNetwork(sta_net, false, analysis_point);
-    makeRouteParasitics(
-        net, route, sta_net, corner, analysis_point, parasitic, node_map);
-    makeParasiticsToPins(pins, node_map, corner, analysis_point, parasitic);
-
-    // Reduce
-    parasitics_->reduceTo(parasitic,
-                          sta_net,
-                          reduce_to,
-                          op_cond,
-                          corner,
-                          min_max_,
-                          analysis_point);
-  }
-
-  parasitics_->deleteParasiticNetworks(sta_net);
 }
 
 void MakeWireParasitics::estimateParasitcs(odb::dbNet* net, GRoute& route) const
 {
-  debugPrint(logger_, GRT, "est_rc", 1, "net {}", net->getConstName());
-  if (logger_->debugCheck(GRT, "est_rc", 2)) {
-    for (GSegment& segment : route) {
-      logger_->report(
-          "({:.2f}, {:.2f}) {:2d} -> ({:.2f}, {:.2f}) {:2d} l={:.2f}",
-          grouter_->dbuToMicrons(segment.init_x),
-          grouter_->dbuToMicrons(segment.init_y),
-          segment.init_layer,
-          grouter_->dbuToMicrons(segment.final_x),
-          grouter_->dbuToMicrons(segment.final_y),
-          segment.final_layer,
-          grouter_->dbuToMicrons(segment.length()));
-    }
-  }
+  reportRoute(net, route);
 
   sta::Net* sta_net = network_->dbToSta(net);
 
@@ -267,104 +224,232 @@ void MakeWireParasitics::makeRouteParasitics(
   }
 }
 
-void MakeWireParasitics::makeParasiticsToPins(
-    std::vector<Pin>& pins,
-    NodeRoutePtMap& node_map,
-    sta::Corner* corner,
-    sta::ParasiticAnalysisPt* analysis_point,
-    sta::Parasitic* parasitic) const
+bool MakeWireParasitics::isCurrent(const NetRC& rc,
+                                   std::vector<Pin>& pins,
+                                   const GRoute& route) const
 {
-  for (Pin& pin : pins) {
-    makeParasiticsToPin(pin, node_map, corner, analysis_point, parasitic);
+  if (rc.route != route || rc.pins.size() != pins.size()) {
+    return false;
   }
+  for (int i = 0; i < (int) pins.size(); i++) {
+    if (rc.pins[i] != staPin(pins[i])
+        || rc.pin_positions[i] != pins[i].getPosition()) {
+      return false;
+    }
+  }
+  return true;
 }
 
-// Make parasitics for the wire from the pin to the grid location of the pin.
-void MakeWireParasitics::makeParasiticsToPin(
-    Pin& pin,
-    NodeRoutePtMap& node_map,
-    sta::Corner* corner,
-    sta::ParasiticAnalysisPt* analysis_point,
-    sta::Parasitic* parasitic) const
+void MakeWireParasitics::makeNetRC(odb::dbNet* net,
+                                   std::vector<Pin>& pins,
+                                   GRoute& route,
+                                   NetRC& rc) const
 {
-  sta::Pin* sta_pin = staPin(pin);
-  sta::ParasiticNode* pin_node
-      = parasitics_->ensureParasiticNode(parasitic, sta_pin);
+  if (!isCurrent(rc, pins, route)) {
+    rc.route = route;
+    rc.pin_positions.clear();
+    rc.pins.clear();
+    rc.wires.clear();
+
+    NodeIndexMap node_map;
+    makeRouteWires(net, route, node_map, rc);
+    rc.route_node_count = node_map.size();
+    makePinWires(pins, node_map, rc);
+  }
 
-  odb::Point pt = pin.getPosition();
-  odb::Point grid_pt = pin.getOnGridPosition();
+  // The layer RC can change between estimates so it is always recomputed.
+  const int wire_count = rc.wires.size();
+  sta::Corners* corners = sta_->corners();
+  rc.res.resize(corners->count() * wire_count);
+  rc.cap.resize(corners->count() * wire_count);
+  for (sta::Corner* corner : *corners) {
+    const int offset = corner->index() * wire_count;
+    for (int i = 0; i < wire_count; i++) {
+      makeWireRC(rc.wires[i], corner, rc.res[offset + i], rc.cap[offset + i]);
+    }
+  }
+}
 
-  std::vector<std::pair<odb::Point, odb::Point>> ap_positions;
-  bool has_access_points = grouter_->pinAccessPointPositions(pin, ap_positions);
-  if (has_access_points) {
-    auto ap_position = ap_positions.front();
-    pt = ap_position.first;
-    grid_pt = ap_position.second;
+void MakeWireParasitics::makeRouteWires(odb::dbNet* net,
+                                        GRoute& route,
+                                        NodeIndexMap& node_map,
+                                        NetRC& rc) const
+{
+  const int min_routing_layer = grouter_->getMinRoutingLayer();
+
+  for (GSegment& segment : route) {
+    const int n1 = (segment.init_layer >= min_routing_layer)
+                       ? ensureNodeIndex(segment.init_x,
+                                         segment.init_y,
+                                         segment.init_layer,
+                                         node_map)
+                       : -1;
+    const int n2 = (segment.final_layer >= min_routing_layer)
+                       ? ensureNodeIndex(segment.final_x,
+                                         segment.final_y,
+                                         segment.final_layer,
+                                         node_map)
+                       : -1;
+    if (n1 < 0 || n2 < 0) {
+      continue;
+    }
+
+    NetRC::Wire wire{n1, n2, -1, segment.length(), nullptr};
+    if (wire.length == 0) {
+      // via
+      const int lower_layer = min(segment.init_layer, segment.final_layer);
+      wire.cut_layer = tech_->findRoutingLayer(lower_layer)->getUpperLayer();
+    } else if (segment.init_layer == segment.final_layer) {
+      wire.layer = segment.init_layer;
+    } else {
+      logger_->warn(GRT,
+                    25,
+                    "Non wire or via route found on net {}.",
+                    net->getConstName());
+    }
+    rc.wires.push_back(wire);
   }
+}
 
-  // Use the route layer above the pin layer if there is a via
-  // to the pin.
-  int layer = pin.getConnectionLayer() + 1;
-  RoutePt grid_route(grid_pt.getX(), grid_pt.getY(), layer);
-  sta::ParasiticNode* grid_node = node_map[grid_route];
-  float via_res = 0;
+int MakeWireParasitics::ensureNodeIndex(int x,
+                                        int y,
+                                        int layer,
+                                        NodeIndexMap& node_map) const
+{
+  const int index = node_map.size();
+  return node_map.emplace(RoutePt(x, y, layer), index).first->second;
+}
 
-  // Use the pin layer for the connection.
-  if (grid_node == nullptr) {
-    layer--;
-    grid_route = RoutePt(grid_pt.getX(), grid_pt.getY(), layer);
-    grid_node = node_map[grid_route];
-  } else {
-    odb::dbTechLayer* cut_layer
-        = tech_->findRoutingLayer(layer)->getLowerLayer();
-    via_res = getCutLayerRes(cut_layer, corner);
+// Make the wires from the pins to the grid locations of the pins.
+void MakeWireParasitics::makePinWires(std::vector<Pin>& pins,
+                                      NodeIndexMap& node_map,
+                                      NetRC& rc) const
+{
+  for (Pin& pin : pins) {
+    const int pin_node = rc.route_node_count + rc.pins.size();
+    rc.pins.push_back(staPin(pin));
+    rc.pin_positions.push_back(pin.getPosition());
+
+    odb::Point pt = pin.getPosition();
+    odb::Point grid_pt = pin.getOnGridPosition();
+
+    std::vector<std::pair<odb::Point, odb::Point>> ap_positions;
+    bool has_access_points
+        = grouter_->pinAccessPointPositions(pin, ap_positions);
+    if (has_access_points) {
+      auto ap_position = ap_positions.front();
+      pt = ap_position.first;
+      grid_pt = ap_position.second;
+    }
+
+    // Use the route layer above the pin layer if there is a via
+    // to the pin.
+    int layer = pin.getConnectionLayer() + 1;
+    auto grid_node
+        = node_map.find(RoutePt(grid_pt.getX(), grid_pt.getY(), layer));
+    odb::dbTechLayer* cut_layer = nullptr;
+
+    // Use the pin layer for the connection.
+    if (grid_node == node_map.end()) {
+      layer--;
+      grid_node = node_map.find(RoutePt(grid_pt.getX(), grid_pt.getY(), layer));
+    } else {
+      cut_layer = tech_->findRoutingLayer(layer)->getLowerLayer();
+    }
+
+    if (grid_node != node_map.end()) {
+      // Make wire from pin to gcell center on pin layer.
+      // We could added the via resistor before the segment pi-model
+      // but that would require an extra node and the accuracy of all
+      // this is not that high.  Instead we just lump them together.
+      const int wire_length_dbu
+          = abs(pt.getX() - grid_pt.getX()) + abs(pt.getY() - grid_pt.getY());
+      rc.wires.push_back(
+          {pin_node, grid_node->second, layer, wire_length_dbu, cut_layer});
+    } else {
+      logger_->warn(GRT, 26, "Missing route to pin {}.", pin.getName());
+    }
   }
+}
 
-  if (grid_node) {
-    // Make wire from pin to gcell center on pin layer.
-    int wire_length_dbu
-        = abs(pt.getX() - grid_pt.getX()) + abs(pt.getY() - grid_pt.getY());
-    float res, cap;
-    layerRC(wire_length_dbu, layer, corner, res, cap);
-    sta::Units* units = sta_->units();
-    debugPrint(
-        logger_,
-        GRT,
-        "est_rc",
-        1,
-        "{} -> {} ({:.2f}, {:.2f}) {:.2f}u layer={} r={} via_res={} c={}",
-        parasitics_->name(grid_node),
-        parasitics_->name(pin_node),
-        grouter_->dbuToMicrons(pt.getX()),
-        grouter_->dbuToMicrons(pt.getY()),
-        grouter_->dbuToMicrons(wire_length_dbu),
-        layer,
-        units->resistanceUnit()->asString(res),
-        units->resistanceUnit()->asString(via_res),
-        units->capacitanceUnit()->asString(cap));
+void MakeWireParasitics::makeWireRC(const NetRC::Wire& wire,
+                                    sta::Corner* corner,
+                                    // Return values.
+                                    float& res,
+                                    float& cap) const
+{
+  res = 0.0;
+  cap = 0.0;
+  if (wire.layer >= 0) {
+    layerRC(wire.length, wire.layer, corner, res, cap);
+  }
+  if (wire.cut_layer != nullptr) {
+    res += getCutLayerRes(wire.cut_layer, corner);
+  }
+}
 
-    debugPrint(logger_,
-               GRT,
-               "est_rc",
-               1,
-               "pin {} -> to grid {}u layer={} r={} via_res={} c={}",
-               pin.getName(),
-               static_cast<int>(dbuToMeters(wire_length_dbu) * 1e+6),
-               layer,
-               units->resistanceUnit()->asString(res),
-               units->resistanceUnit()->asString(via_res),
-               units->capacitanceUnit()->asString(cap));
+void MakeWireParasitics::makeParasitics(odb::dbNet* net, const NetRC& rc) const
+{
+  reportRoute(net, rc.route);
 
-    // We could added the via resistor before the segment pi-model
-    // but that would require an extra node and the accuracy of all
-    // this is not that high.  Instead we just lump them together.
-    parasitics_->incrCap(pin_node, cap / 2.0, analysis_point);
-    parasitics_->makeResistor(
-        nullptr, pin_node, grid_node, res + via_res, analysis_point);
-    parasitics_->incrCap(grid_node, cap / 2.0, analysis_point);
-  } else {
-    logger_->warn(GRT, 26, "Missing route to pin {}.", pin.getName());
+  sta::Net* sta_net = network_->dbToSta(net);
+  sta::Units* units = sta_->units();
+
+  sta::OperatingConditions* op_cond
+      = sta_->sdc()->operatingConditions(min_max_);
+  sta::ReducedParasiticType reduce_to
+      = sta_->arcDelayCalc()->reducedParasiticType();
+  const int wire_count = rc.wires.size();
+  for (sta::Corner* corner : *sta_->corners()) {
+    sta::ParasiticAnalysisPt* analysis_point
+        = corner->findParasiticAnalysisPt(min_max_);
+    sta::Parasitic* parasitic
+        = parasitics_->makeParasiticNetwork(sta_net, false, analysis_point);
+
+    std::vector<sta::ParasiticNode*> nodes;
+    nodes.reserve(rc.route_node_count + rc.pins.size());
+    for (int i = 0; i < rc.route_node_count; i++) {
+      nodes.push_back(
+          parasitics_->ensureParasiticNode(parasitic, sta_net, i + 1));
+    }
+    for (sta::Pin* pin : rc.pins) {
+      nodes.push_back(parasitics_->ensureParasiticNode(parasitic, pin));
+    }
+
+    const int offset = corner->index() * wire_count;
+    for (int i = 0; i < wire_count; i++) {
+      const NetRC::Wire& wire = rc.wires[i];
+      sta::ParasiticNode* n1 = nodes[wire.node1];
+      sta::ParasiticNode* n2 = nodes[wire.node2];
+      const float res = rc.res[offset + i];
+      const float cap = rc.cap[offset + i];
+      debugPrint(logger_,
+                 GRT,
+                 "est_rc",
+                 1,
+                 "{} -> {} {:.2f}u layer={} r={} c={}",
+                 parasitics_->name(n1),
+                 parasitics_->name(n2),
+                 dbuToMeters(wire.length) * 1e+6,
+                 wire.layer,
+                 units->resistanceUnit()->asString(res),
+                 units->capacitanceUnit()->asString(cap));
+      parasitics_->incrCap(n1, cap / 2.0, analysis_point);
+      parasitics_->makeResistor(nullptr, n1, n2, res, analysis_point);
+      parasitics_->incrCap(n2, cap / 2.0, analysis_point);
+    }
+
+    // Reduce
+    parasitics_->reduceTo(parasitic,
+                          sta_net,
+                          reduce_to,
+                          op_cond,
+                          corner,
+                          min_max_,
+                          analysis_point);
   }
+
+  parasitics_->deleteParasiticNetworks(sta_net);
 }
 
 void MakeWireParasitics::makePartialParasiticsToPins(
@@ -69,6 +69,34 @@ class Resizer;
 
 namespace grt {
 
+// RC network of a net estimated from its global route. It is built without
+// touching sta::Parasitics so nets can be estimated concurrently, and it is
+// kept between estimates to skip the nets whose route and pins are the same.
+struct NetRC
+{
+  struct Wire
+  {
+    int node1;
+    int node2;
+    int layer;  // routing layer of the wire, -1 for a via
+    int length;
+    odb::dbTechLayer* cut_layer;  // via lumped into the wire
+  };
+
+  // Route and pin positions the network was built from.
+  GRoute route;
+  std::vector<odb::Point> pin_positions;
+
+  // Route points are the nodes [0, route_node_count), the pins follow.
+  int route_node_count = 0;
+  std::vector<sta::Pin*> pins;
+  std::vector<Wire> wires;
+  // Resistance and capacitance of each wire, indexed by
+  // corner * wires.size() + wire.
+  std::vector<float> res;
+  std::vector<float> cap;
+};
+
 class MakeWireParasitics : public AbstractMakeWireParasitics
 {
  public:
@@ -77,10 +105,15 @@ class MakeWireParasitics : public AbstractMakeWireParasitics
                      sta::dbSta* sta,
                      odb::dbTech* tech,
                      GlobalRouter* grouter);
-  void estimateParasitcs(odb::dbNet* net,
-                         std::vector<Pin>& pins,
-                         GRoute& route) const;
   void estimateParasitcs(odb::dbNet* net, GRoute& route) const override;
+  // Update rc to the route and pins of net. Safe to call concurrently for
+  // different nets.
+  void makeNetRC(odb::dbNet* net,
+                 std::vector<Pin>& pins,
+                 GRoute& route,
+                 NetRC& rc) const;
+  // Make and reduce the sta parasitics of net from rc.
+  void makeParasitics(odb::dbNet* net, const NetRC& rc) const;
 
   void clearParasitics() override;
   // Return GRT layer lengths in dbu's for db_net's route indexed by routing
@@ -91,8 +124,26 @@ class MakeWireParasitics : public AbstractMakeWireParasitics
 
  private:
   typedef std::map<RoutePt, sta::ParasiticNode*> NodeRoutePtMap;
+  typedef std::map<RoutePt, int> NodeIndexMap;
 
   sta::Pin* staPin(Pin& pin) const;
+  bool isCurrent(const NetRC& rc,
+                 std::vector<Pin>& pins,
+                 const GRoute& route) const;
+  void makeRouteWires(odb::dbNet* net,
+                      GRoute& route,
+                      NodeIndexMap& node_map,
+                      NetRC& rc) const;
+  int ensureNodeIndex(int x, int y, int layer, NodeIndexMap& node_map) const;
+  void makePinWires(std::vector<Pin>& pins,
+                    NodeIndexMap& node_map,
+                    NetRC& rc) const;
+  void makeWireRC(const NetRC::Wire& wire,
+                  sta::Corner* corner,
+                  // Return values.
+                  float& res,
+                  float& cap) const;
+  void reportRoute(odb::dbNet* net, const GRoute& route) const;
   void makeRouteParasitics(odb::dbNet* net,
                            GRoute& route,
                            sta::Net* sta_net,
@@ -106,16 +157,6 @@ class MakeWireParasitics : public AbstractMakeWireParasitics
                                           NodeRoutePtMap& node_map,
                                           sta::Parasitic* parasitic,
                                           sta::Net* net) const;
-  void makeParasiticsToPins(std::vector<Pin>& pins,
-                            NodeRoutePtMap& node_map,
-                            sta::Corner* corner,
-                            sta::ParasiticAnalysisPt* analysis_point,
-                            sta::Parasitic* parasitic) const;
-  void makeParasiticsToPin(Pin& pin,
-                           NodeRoutePtMap& node_map,
-                           sta::Corner* corner,
-                           sta::ParasiticAnalysisPt* analysis_point,
-                           sta::Parasitic* parasitic) const;
   void makePartialParasiticsToPins(std::vector<Pin>& pins,
                                    NodeRoutePtMap& node_map,
                                    sta::Corner* corner,
@@ -67,29 +67,42 @@ RepairAntennas::RepairAntennas(GlobalRouter* grouter,
   block_ = db_->getChip()->getBlock();
 }
 
-bool RepairAntennas::checkAntennaViolations(NetRouteMap& routing,
-                                            int max_routing_layer,
-                                            odb::dbMTerm* diode_mterm,
-                                            float ratio_margin)
+bool RepairAntennas::checkAntennaViolations(
+    NetRouteMap& routing,
+    const std::vector<odb::dbNet*>& nets,
+    int max_routing_layer,
+    odb::dbMTerm* diode_mterm,
+    float ratio_margin)
 {
-  makeNetWires(routing, max_routing_layer);
-  arc_->initAntennaRules();
-  for (auto& [db_net, route] : routing) {
+  std::map<int, odb::dbTechVia*> default_vias
+      = grouter_->getDefaultVias(max_routing_layer);
+  std::vector<odb::dbNet*> wired_nets;
+  for (odb::dbNet* db_net : nets) {
+    auto route = routing.find(db_net);
+    if (route != routing.end()) {
+      makeNetWire(db_net, route->second, default_vias);
+    }
     if (db_net->getWire()) {
-      std::vector<ant::Violation> net_violations
-          = arc_->getAntennaViolations(db_net, diode_mterm, ratio_margin);
-      if (!net_violations.empty()) {
-        antenna_violations_[db_net] = net_violations;
-        debugPrint(logger_,
-                   GRT,
-                   "repair_antennas",
-                   1,
-                   "antenna violations {}",
-                   db_net->getConstName());
-      }
+      wired_nets.push_back(db_net);
     }
   }
-  destroyNetWires();
+
+  arc_->initAntennaRules();
+  auto violations
+      = arc_->getAntennaViolations(wired_nets, diode_mterm, ratio_margin);
+  for (auto& [db_net, net_violations] : violations) {
+    antenna_violations_[db_net] = std::move(net_violations);
+    debugPrint(logger_,
+               GRT,
+               "repair_antennas",
+               1,
+               "antenna violations {}",
+               db_net->getConstName());
+  }
+
+  for (odb::dbNet* db_net : wired_nets) {
+    odb::dbWire::destroy(db_net->getWire());
+  }
 
   logger_->info(
       GRT, 12, "Found {} antenna violations.", antenna_violations_.size());
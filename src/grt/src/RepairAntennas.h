@@ -84,7 +84,10 @@ class RepairAntennas
                  odb::dbDatabase* db,
                  utl::Logger* logger);
 
+  // Only nets are checked; violations found on earlier calls are kept
+  // until clearViolations.
   bool checkAntennaViolations(NetRouteMap& routing,
+                              const std::vector<odb::dbNet*>& nets,
                               int max_routing_layer,
                               odb::dbMTerm* diode_mterm,
                               float ratio_margin);
@@ -49,6 +49,7 @@
 #include "grt/GRoute.h"
 #include "odb/geom.h"
 #include "stt/SteinerTreeBuilder.h"
+#include "utl/MemoryUsage.h"
 
 namespace utl {
 class Logger;
@@ -89,6 +90,187 @@ struct DebugSetting
   bool isOn() const { return renderer_ != nullptr; }
 };
 
+// Dense scratch grid over a window of the gcell grid, indexed [y][x] with
+// gcell coordinates. The storage only grows, so the searches over
+// successive windows reuse one allocation.
+template <typename T>
+class GridWindow
+{
+ public:
+  using reference = typename std::vector<T>::reference;
+
+  class Row
+  {
+   public:
+    Row(std::vector<T>& data, int offset) : data_(data), offset_(offset) {}
+    reference operator[](int x) { return data_[offset_ + x]; }
+
+   private:
+    std::vector<T>& data_;
+    int offset_;
+  };
+
+  // Covers the gcells [x1, x2] x [y1, y2], the contents are undefined.
+  void reset(int x1, int y1, int x2, int y2)
+  {
+    x1_ = x1;
+    y1_ = y1;
+    width_ = x2 - x1 + 1;
+    height_ = y2 - y1 + 1;
+    data_.resize(width_ * height_);
+  }
+  Row operator[](int y) { return Row(data_, (y - y1_) * width_ - x1_); }
+  bool contains(int x, int y) const
+  {
+    return x >= x1_ && x < x1_ + width_ && y >= y1_ && y < y1_ + height_;
+  }
+  int size() const { return width_ * height_; }
+  T* data() { return data_.data(); }
+  // gcell of the element at an offset from data()
+  int xOf(int index) const { return x1_ + index % width_; }
+  int yOf(int index) const { return y1_ + index / width_; }
+
+ private:
+  std::vector<T> data_;
+  int x1_ = 0;
+  int y1_ = 0;
+  int width_ = 0;
+  int height_ = 0;
+};
+
+// GridWindow replicated on every routing layer, indexed [layer][y][x].
+template <typename T>
+class LayeredGridWindow
+{
+ public:
+  using Row = typename GridWindow<T>::Row;
+
+  class Plane
+  {
+   public:
+    Plane(LayeredGridWindow& grid, int offset) : grid_(grid), offset_(offset)
+    {
+    }
+    Row operator[](int y)
+    {
+      return Row(grid_.data_,
+                 offset_ + (y - grid_.y1_) * grid_.width_ - grid_.x1_);
+    }
+
+   private:
+    LayeredGridWindow& grid_;
+    int offset_;
+  };
+
+  // Covers the gcells [x1, x2] x [y1, y2] of num_layers layers, the contents
+  // are undefined.
+  void reset(int num_layers, int x1, int y1, int x2, int y2)
+  {
+    x1_ = x1;
+    y1_ = y1;
+    width_ = x2 - x1 + 1;
+    height_ = y2 - y1 + 1;
+    data_.resize(num_layers * width_ * height_);
+  }
+  Plane operator[](int layer) { return Plane(*this, layer * planeSize()); }
+  bool contains(int x, int y) const
+  {
+    return x >= x1_ && x < x1_ + width_ && y >= y1_ && y < y1_ + height_;
+  }
+  int size() const { return data_.size(); }
+  T* data() { return data_.data(); }
+  // gcell of the element at an offset from data()
+  int layerOf(int index) const { return index / planeSize(); }
+  int xOf(int index) const { return x1_ + index % planeSize() % width_; }
+  int yOf(int index) const { return y1_ + index % planeSize() / width_; }
+
+ private:
+  int planeSize() const { return width_ * height_; }
+
+  std::vector<T> data_;
+  int x1_ = 0;
+  int y1_ = 0;
+  int width_ = 0;
+  int height_ = 0;
+};
+
+// Scratch state of the 2D maze router, covering the search region of the
+// edge being routed. Every thread routing nets concurrently owns one.
+struct MazeWorkspace
+{
+  void reset(int x1, int y1, int x2, int y2);
+
+  GridWindow<float> d1;
+  GridWindow<float> d2;
+  GridWindow<short> parent_x1;
+  GridWindow<short> parent_y1;
+  GridWindow<short> parent_x3;
+  GridWindow<short> parent_y3;
+  GridWindow<bool> hv;
+  GridWindow<bool> hyper_v;
+  GridWindow<bool> hyper_h;
+  GridWindow<int> corr_edge;
+  std::vector<bool> pop_heap2;
+  std::vector<float*> src_heap;
+  std::vector<float*> dest_heap;
+  std::vector<OrderNetEdge> net_eo;
+  // (Y, X) of the edges whose usage was raised, merged into
+  // h_used_ggrid_/v_used_ggrid_ once the routing threads are joined
+  std::vector<std::pair<int, int>> h_used;
+  std::vector<std::pair<int, int>> v_used;
+};
+
+struct parent3D
+{
+  short l;
+  short x, y;
+};
+
+// Scratch state of the 3D maze router, covering the search region of the
+// edge being routed. Every thread routing nets concurrently owns one.
+struct Maze3DWorkspace
+{
+  LayeredGridWindow<Direction> directions;
+  LayeredGridWindow<int> corr_edge;
+  LayeredGridWindow<parent3D> parents;
+  LayeredGridWindow<int> d1;
+  LayeredGridWindow<int> d2;
+  std::vector<bool> pop_heap2;
+  std::vector<int*> src_heap;
+  std::vector<int*> dest_heap;
+  std::vector<int> xcor;
+  std::vector<int> ycor;
+  std::vector<int> dcor;
+  // (Y, X) of the edges whose usage was raised, merged into
+  // h_used_ggrid_/v_used_ggrid_ once the routing threads are joined
+  std::vector<std::pair<int, int>> h_used;
+  std::vector<std::pair<int, int>> v_used;
+};
+
+// Scratch state of the layer assignment of a net, indexed [layer][grid].
+// Every thread assigning nets concurrently owns one.
+struct LayerAssignWorkspace
+{
+  multi_array<int, 2> layer_grid;
+  multi_array<int, 2> via_link;
+};
+
+// Settings shared by all the nets routed in one mazeRouteMSMD pass.
+struct MazeRouteSettings
+{
+  int iter;
+  int expand;
+  float cost_height;
+  int ripup_threshold;
+  int maze_edge_threshold;
+  int cost_type;
+  float logis_cof;
+  int via;
+  int slope;
+  int L;
+  float slack_th;
+};
+
 using stt::Tree;
 
 class FastRouteCore
@@ -156,6 +338,13 @@ class FastRouteCore
                               bool vertical);
   void getCongestionGrid(std::vector<CongestionInformation>& congestionGridV,
                          std::vector<CongestionInformation>& congestionGridH);
+  // Congestion of the edges leaving the gcells (x1, y1)-(x2, y2) to the
+  // right and up on a layer, or on all layers when layer is -1.
+  RegionCongestion getRegionCongestion(int x1,
+                                       int y1,
+                                       int x2,
+                                       int y2,
+                                       int layer);
 
   const std::vector<short>& getVerticalCapacities() { return v_capacity_3D_; }
   const std::vector<short>& getHorizontalCapacities() { return h_capacity_3D_; }
@@ -175,6 +364,8 @@ class FastRouteCore
   void incrementEdge3DUsage(int x1, int y1, int x2, int y2, int layer);
   void setMaxNetDegree(int);
   void setVerbose(bool v);
+  void setNumThreads(int threads);
+  void setMazeThreads(int threads);
   void setUpdateSlack(int u);
   void setMakeWireParasiticsBuilder(AbstractMakeWireParasitics* builder);
   void setOverflowIterations(int iterations);
@@ -221,6 +412,7 @@ class FastRouteCore
   int getEdgeCapacity(FrNet* net, int x1, int y1, EdgeDirection direction);
   void getNetId(odb::dbNet* db_net, int& net_id, bool& exists);
   void clearNetRoute(const int netID);
+  void buildCongestionIndex();
   void initNetAuxVars();
   void clearNets();
   double dbuToMicrons(int64_t dbu);
@@ -242,6 +434,21 @@ class FastRouteCore
                      const int slope,
                      const int L,
                      float& slack_th);
+  bool mazeRouteNet(const int netID,
+                    const MazeRouteSettings& settings,
+                    const odb::Rect& bounds,
+                    MazeWorkspace& ws,
+                    int& last_enlarge);
+  bool mazeNetBounds(const int netID,
+                     const MazeRouteSettings& settings,
+                     odb::Rect& bounds);
+  void mazeRouteBatches(const std::vector<int>& net_ids,
+                        const MazeRouteSettings& settings,
+                        std::vector<MazeWorkspace>& workspaces);
+  void mergeMazeUsage(MazeWorkspace& ws);
+  bool netRouteBounds(const int netID, const int margin, odb::Rect& bounds);
+  std::vector<std::vector<int>> netBatches(
+      const std::vector<odb::Rect>& bounds);
   void convertToMazeroute();
   void updateCongestionHistory(const int upType, bool stopDEC, int& max_adj);
   int getOverflow2D(int* maxOverflow);
@@ -276,16 +483,7 @@ class FastRouteCore
                    std::vector<short>& new_route_x,
                    std::vector<short>& new_route_y);
   void convertToMazerouteNet(const int netID);
-  void setupHeap(const int netID,
-                 const int edgeID,
-                 std::vector<float*>& src_heap,
-                 std::vector<float*>& dest_heap,
-                 multi_array<float, 2>& d1,
-                 multi_array<float, 2>& d2,
-                 const int regionX1,
-                 const int regionX2,
-                 const int regionY1,
-                 const int regionY2);
+  void setupHeap(const int netID, const int edgeID, MazeWorkspace& ws);
   int copyGrids(const TreeNode* treenodes,
                 const int n1,
                 const int n2,
@@ -323,18 +521,22 @@ class FastRouteCore
                             int ripupTHlb,
                             int ripupTHub,
                             int layerOrientation);
+  void mazeRouteNet3D(int netID,
+                      int expand,
+                      int ripupTHlb,
+                      int ripupTHub,
+                      int layerOrientation,
+                      const odb::Rect& bounds,
+                      Maze3DWorkspace& ws);
+  void mergeMaze3DUsage(Maze3DWorkspace& ws);
   void setupHeap3D(int netID,
                    int edgeID,
                    std::vector<int*>& src_heap_3D,
                    std::vector<int*>& dest_heap_3D,
-                   multi_array<Direction, 3>& directions_3D,
-                   multi_array<int, 3>& corr_edge_3D,
-                   multi_array<int, 3>& d1_3D,
-                   multi_array<int, 3>& d2_3D,
-                   int regionX1,
-                   int regionX2,
-                   int regionY1,
-                   int regionY2);
+                   LayeredGridWindow<Direction>& directions_3D,
+                   LayeredGridWindow<int>& corr_edge_3D,
+                   LayeredGridWindow<int>& d1_3D,
+                   LayeredGridWindow<int>& d2_3D);
   void newUpdateNodeLayers(TreeNode* treenodes,
                            const int edgeID,
                            const int n1,
@@ -373,6 +575,14 @@ class FastRouteCore
 
   // rsmt functions
   void copyStTree(const int ind, const Tree& rsmt);
+  float netTreeCoeff(const int netID,
+                     const bool congestionDriven,
+                     const bool noADJ);
+  int makeNetTree(const int netID,
+                  const bool congestionDriven,
+                  const bool cong,
+                  const float coeffV,
+                  Tree& rsmt);
   void gen_brk_RSMT(const bool congestionDriven,
                     const bool reRoute,
                     const bool genTree,
@@ -466,17 +676,23 @@ class FastRouteCore
                          int k,
                          int l,
                          bool horizontal,
-                         int& best_cost);
-  void assignEdge(int netID, int edgeID, bool processDIR);
-  void recoverEdge(int netID, int edgeID);
+                         int& best_cost,
+                         multi_array<int, 2>& layer_grid);
+  void assignEdge(int netID,
+                  int edgeID,
+                  bool processDIR,
+                  LayerAssignWorkspace& ws);
+  void recoverEdge(int netID, int edgeID, Maze3DWorkspace& ws);
   void layerAssignmentV4();
+  void assignNetLayers(int netID, LayerAssignWorkspace& ws);
+  void initLayerAssignWorkspace(LayerAssignWorkspace& ws);
   void netpinOrderInc();
   void checkRoute3D();
   void StNetOrder();
   float CalculatePartialSlack();
   bool checkRoute2DTree(int netID);
   void removeLoops();
-  void netedgeOrderDec(int netID);
+  void netedgeOrderDec(int netID, std::vector<OrderNetEdge>& net_eo);
   void printTree2D(int netID);
   void printEdge2D(int netID, int edgeID);
   void printEdge3D(int netID, int edgeID);
@@ -534,8 +750,9 @@ class FastRouteCore
   int num_layers_;
   int total_overflow_;  // total # overflow
   bool has_2D_overflow_;
-  int grid_hv_;
   bool verbose_;
+  int num_threads_;
+  int maze_threads_;  // 0 routes the nets one at a time
   int update_slack_;
   int via_cost_;
   int mazeedge_threshold_;
@@ -565,7 +782,6 @@ class FastRouteCore
 
   std::vector<FrNet*> nets_;
   std::unordered_map<odb::dbNet*, int> db_net_id_map_;  // db net -> net id
-  std::vector<OrderNetEdge> net_eo_;
   std::vector<std::vector<int>>
       gxs_;  // the copy of xs for nets, used for second FLUTE
   std::vector<std::vector<int>>
@@ -580,17 +796,12 @@ class FastRouteCore
   multi_array<Edge, 2> h_edges_;       // The way it is indexed is (Y, X)
   multi_array<Edge3D, 3> h_edges_3D_;  // The way it is indexed is (Layer, Y, X)
   multi_array<Edge3D, 3> v_edges_3D_;  // The way it is indexed is (Layer, Y, X)
-  multi_array<int, 2> corr_edge_;
-  multi_array<int, 2> layer_grid_;
-  multi_array<int, 2> via_link_;
-  multi_array<short, 2> parent_x1_;
-  multi_array<short, 2> parent_y1_;
-  multi_array<short, 2> parent_x3_;
-  multi_array<short, 2> parent_y3_;
-  multi_array<bool, 2> hv_;
-  multi_array<bool, 2> hyper_v_;
-  multi_array<bool, 2> hyper_h_;
-  multi_array<bool, 2> in_region_;
+  utl::MemoryCharge edges_memory_;  // held by the 2D and 3D edges
+  // Summed-area tables of the 3D edge congestion, indexed
+  // (Layer, Y + 1, X + 1). Rebuilt on the first query after the edge usage
+  // changes.
+  multi_array<RegionCongestion, 3> congestion_index_;
+  bool congestion_index_valid_;
 
   std::vector<StTree> sttrees_;  // the Steiner trees
   std::vector<StTree> sttrees_bk_;
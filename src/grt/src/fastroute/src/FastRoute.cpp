@@ -43,6 +43,7 @@
 #include "DataType.h"
 #include "odb/db.h"
 #include "utl/Logger.h"
+#include "utl/MemoryUsage.h"
 
 namespace grt {
 
@@ -72,8 +73,9 @@ FastRouteCore::FastRouteCore(odb::dbDatabase* db,
       num_layers_(0),
       total_overflow_(0),
       has_2D_overflow_(false),
-      grid_hv_(0),
       verbose_(false),
+      num_threads_(1),
+      maze_threads_(0),
       update_slack_(0),
       via_cost_(0),
       mazeedge_threshold_(0),
@@ -81,6 +83,7 @@ FastRouteCore::FastRouteCore(odb::dbDatabase* db,
       h_capacity_lb_(0),
       regular_x_(false),
       regular_y_(false),
+      congestion_index_valid_(false),
       logger_(log),
       stt_builder_(stt_builder),
       debug_(new DebugSetting())
@@ -116,31 +119,17 @@ void FastRouteCore::clear()
 
   h_edges_3D_.resize(boost::extents[0][0][0]);
   v_edges_3D_.resize(boost::extents[0][0][0]);
-
-  parent_x1_.resize(boost::extents[0][0]);
-  parent_y1_.resize(boost::extents[0][0]);
-  parent_x3_.resize(boost::extents[0][0]);
-  parent_y3_.resize(boost::extents[0][0]);
-
-  net_eo_.clear();
+  edges_memory_.release();
+  congestion_index_.resize(boost::extents[0][0][0]);
+  congestion_index_valid_ = false;
 
   xcor_.clear();
   ycor_.clear();
   dcor_.clear();
 
-  hv_.resize(boost::extents[0][0]);
-  hyper_v_.resize(boost::extents[0][0]);
-  hyper_h_.resize(boost::extents[0][0]);
-  corr_edge_.resize(boost::extents[0][0]);
-
-  in_region_.resize(boost::extents[0][0]);
-
   v_capacity_3D_.clear();
   h_capacity_3D_.clear();
 
-  layer_grid_.resize(boost::extents[0][0]);
-  via_link_.resize(boost::extents[0][0]);
-
   cost_hvh_.clear();
   cost_vhv_.clear();
   cost_h_.clear();
@@ -194,16 +183,6 @@ void FastRouteCore::setGridsAndLayers(int x, int y, int nLayers)
     last_row_h_capacity_3D_[i] = 0;
   }
 
-  layer_grid_.resize(boost::extents[num_layers_][MAXLEN]);
-  via_link_.resize(boost::extents[num_layers_][MAXLEN]);
-
-  hv_.resize(boost::extents[y_range_][x_range_]);
-  hyper_v_.resize(boost::extents[y_range_][x_range_]);
-  hyper_h_.resize(boost::extents[y_range_][x_range_]);
-  corr_edge_.resize(boost::extents[y_range_][x_range_]);
-
-  in_region_.resize(boost::extents[y_range_][x_range_]);
-
   cost_hvh_.resize(x_range_);  // Horizontal first Z
   cost_vhv_.resize(y_range_);  // Vertical first Z
   cost_h_.resize(y_range_);    // Horizontal segment cost
@@ -311,6 +290,13 @@ void FastRouteCore::initEdges()
   v_edges_3D_.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
   h_edges_3D_.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
 
+  static utl::MemoryCounter grid_memory("grt__grids");
+  edges_memory_.set(
+      grid_memory,
+      (h_edges_.num_elements() + v_edges_.num_elements()) * sizeof(Edge)
+          + (h_edges_3D_.num_elements() + v_edges_3D_.num_elements())
+                * sizeof(Edge3D));
+
   for (int i = 0; i < y_grid_; i++) {
     for (int j = 0; j < x_grid_ - 1; j++) {
       // 2D edge initialization
@@ -366,6 +352,7 @@ void FastRouteCore::addAdjustment(int x1,
                                   bool isReduce)
 {
   const int k = layer - 1;
+  congestion_index_valid_ = false;
 
   if (y1 == y2) {
     // horizontal edge
@@ -615,6 +602,7 @@ void FastRouteCore::incrementEdge3DUsage(int x1,
                                          int layer)
 {
   const int k = layer - 1;
+  congestion_index_valid_ = false;
 
   if (y1 == y2) {  // horizontal edge
     for (int x = x1; x < x2; x++) {
@@ -627,18 +615,82 @@ void FastRouteCore::incrementEdge3DUsage(int x1,
   }
 }
 
+void FastRouteCore::buildCongestionIndex()
+{
+  congestion_index_.resize(
+      boost::extents[num_layers_][y_grid_ + 1][x_grid_ + 1]);
+  for (int l = 0; l < num_layers_; l++) {
+    for (int x = 0; x <= x_grid_; x++) {
+      congestion_index_[l][0][x] = RegionCongestion();
+    }
+    for (int y = 0; y < y_grid_; y++) {
+      // sums of the current row up to x
+      RegionCongestion row;
+      congestion_index_[l][y + 1][0] = row;
+      for (int x = 0; x < x_grid_; x++) {
+        if (x < x_grid_ - 1) {
+          const Edge3D& edge = h_edges_3D_[l][y][x];
+          row.capacity += edge.cap;
+          row.usage += edge.usage;
+          row.overflow += std::max(edge.usage - edge.cap, 0);
+        }
+        if (y < y_grid_ - 1) {
+          const Edge3D& edge = v_edges_3D_[l][y][x];
+          row.capacity += edge.cap;
+          row.usage += edge.usage;
+          row.overflow += std::max(edge.usage - edge.cap, 0);
+        }
+        const RegionCongestion& below = congestion_index_[l][y][x + 1];
+        RegionCongestion& sum = congestion_index_[l][y + 1][x + 1];
+        sum.capacity = below.capacity + row.capacity;
+        sum.usage = below.usage + row.usage;
+        sum.overflow = below.overflow + row.overflow;
+      }
+    }
+  }
+  congestion_index_valid_ = true;
+}
+
+RegionCongestion FastRouteCore::getRegionCongestion(int x1,
+                                                    int y1,
+                                                    int x2,
+                                                    int y2,
+                                                    int layer)
+{
+  RegionCongestion congestion;
+  x1 = std::max(x1, 0);
+  y1 = std::max(y1, 0);
+  x2 = std::min(x2, x_grid_ - 1);
+  y2 = std::min(y2, y_grid_ - 1);
+  if (x1 > x2 || y1 > y2 || layer >= num_layers_
+      || h_edges_3D_.num_elements() == 0) {
+    return congestion;
+  }
+
+  if (!congestion_index_valid_) {
+    buildCongestionIndex();
+  }
+
+  const int first_layer = layer == -1 ? 0 : layer;
+  const int last_layer = layer == -1 ? num_layers_ - 1 : layer;
+  for (int l = first_layer; l <= last_layer; l++) {
+    const RegionCongestion& a = congestion_index_[l][y2 + 1][x2 + 1];
+    const RegionCongestion& b = congestion_index_[l][y1][x2 + 1];
+    const RegionCongestion& c = congestion_index_[l][y2 + 1][x1];
+    const RegionCongestion& d = congestion_index_[l][y1][x1];
+    congestion.capacity += a.capacity - b.capacity - c.capacity + d.capacity;
+    congestion.usage += a.usage - b.usage - c.usage + d.usage;
+    congestion.overflow += a.overflow - b.overflow - c.overflow + d.overflow;
+  }
+
+  return congestion;
+}
+
 void FastRouteCore::initAuxVar()
 {
   tree_order_cong_.clear();
 
   initNetAuxVars();
-
-  grid_hv_ = x_range_ * y_range_;
-
-  parent_x1_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_y1_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_x3_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_y3_.resize(boost::extents[y_grid_][x_grid_]);
 }
 
 void FastRouteCore::initNetAuxVars()
@@ -845,6 +897,7 @@ void FastRouteCore::updateDbCongestion()
 
 NetRouteMap FastRouteCore::run()
 {
+  congestion_index_valid_ = false;
   if (netCount() == 0) {
     return getRoutes();
   }
@@ -868,7 +921,6 @@ NetRouteMap FastRouteCore::run()
   xcor_.resize(max_degree2);
   ycor_.resize(max_degree2);
   dcor_.resize(max_degree2);
-  net_eo_.reserve(max_degree2);
 
   int THRESH_M = 20;
   const int ENLARGE = 15;  // 5
@@ -1290,7 +1342,6 @@ NetRouteMap FastRouteCore::run()
   }
 
   NetRouteMap routes = getRoutes();
-  net_eo_.clear();
   return routes;
 }
 
@@ -1299,6 +1350,16 @@ void FastRouteCore::setVerbose(bool v)
   verbose_ = v;
 }
 
+void FastRouteCore::setNumThreads(int threads)
+{
+  num_threads_ = threads;
+}
+
+void FastRouteCore::setMazeThreads(int threads)
+{
+  maze_threads_ = threads;
+}
+
 void FastRouteCore::setUpdateSlack(int u)
 {
   update_slack_ = u;
@@ -36,6 +36,7 @@
 #include "DataType.h"
 #include "FastRoute.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace grt {
 
@@ -635,39 +636,116 @@ float FastRouteCore::coeffADJ(const int netID)
   return coef;
 }
 
+float FastRouteCore::netTreeCoeff(const int netID,
+                                  const bool congestionDriven,
+                                  const bool noADJ)
+{
+  if (noADJ) {
+    return 1.2;
+  }
+  if (congestionDriven) {
+    return coeffADJ(netID);
+  }
+  if (HTreeSuite(netID)) {
+    return 1.2;
+  }
+  return 1.36;
+}
+
+// Builds the Steiner tree of a net from the current edge usage and returns
+// the number of edges shifted. Only the net's own gxs_/gys_/gs_ entries are
+// written, so nets can be built concurrently.
+int FastRouteCore::makeNetTree(const int netID,
+                               const bool congestionDriven,
+                               const bool cong,
+                               const float coeffV,
+                               Tree& rsmt)
+{
+  FrNet* net = nets_[netID];
+  const int flute_accuracy = 2;
+
+  // check net alpha because FastRoute has a special implementation of flute
+  // TODO: move this flute implementation to SteinerTreeBuilder
+  const float net_alpha = stt_builder_->getAlpha(net->getDbNet());
+  if (net_alpha > 0.0) {
+    rsmt = stt_builder_->makeSteinerTree(
+        net->getDbNet(), net->getPinX(), net->getPinY(), net->getDriverIdx());
+    return 0;
+  }
+
+  if (!congestionDriven) {
+    // call FLUTE to generate RSMT for each net
+    fluteNormal(
+        netID, net->getPinX(), net->getPinY(), flute_accuracy, coeffV, rsmt);
+    return 0;
+  }
+
+  // call congestion driven flute to generate RSMT
+  if (cong) {
+    fluteCongest(
+        netID, net->getPinX(), net->getPinY(), flute_accuracy, coeffV, rsmt);
+  } else {
+    fluteNormal(
+        netID, net->getPinX(), net->getPinY(), flute_accuracy, coeffV, rsmt);
+  }
+  if (net->getNumPins() > 3) {
+    return edgeShiftNew(rsmt, netID);
+  }
+  return 0;
+}
+
 void FastRouteCore::gen_brk_RSMT(const bool congestionDriven,
                                  const bool reRoute,
                                  const bool genTree,
                                  const bool newType,
                                  const bool noADJ)
 {
-  Tree rsmt;
   int numShift = 0;
 
   int wl = 0;
   int wl1 = 0;
   int totalNumSeg = 0;
 
-  const int flute_accuracy = 2;
-
+  std::vector<int> net_ids;
   for (int i = 0; i < netCount(); i++) {
-    FrNet* net = nets_[i];
-
-    if (net->isRouted())
-      continue;
-
-    float coeffV = 1.36;
-
-    bool cong;
-    if (congestionDriven) {
-      coeffV = coeffADJ(i);
-      cong = netCongestion(i);
+    if (!nets_[i]->isRouted()) {
+      net_ids.push_back(i);
+    }
+  }
 
-    } else if (HTreeSuite(i)) {
-      coeffV = 1.2;
+  // Without rerouting the trees are independent and are built concurrently
+  // up front. When rerouting, each tree sees the usage left by the nets
+  // routed before it, so they are only built up front, all against the
+  // previous routing, in the parallel maze mode.
+  const bool parallel = num_threads_ > 1 && (!reRoute || maze_threads_ > 0);
+  std::vector<Tree> trees(parallel ? net_ids.size() : 0);
+  if (parallel) {
+    utl::ThreadException exception;
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic, 64) \
+    reduction(+ : numShift)
+    for (int k = 0; k < (int) net_ids.size(); k++) {
+      try {
+        const int netID = net_ids[k];
+        const bool cong = congestionDriven && netCongestion(netID);
+        const float coeffV = netTreeCoeff(netID, congestionDriven, noADJ);
+        numShift
+            += makeNetTree(netID, congestionDriven, cong, coeffV, trees[k]);
+      } catch (...) {
+        exception.capture();
+      }
     }
+    exception.rethrow();
+  }
 
-    int d = net->getNumPins();
+  Tree tree;
+  for (int k = 0; k < (int) net_ids.size(); k++) {
+    const int i = net_ids[k];
+    FrNet* net = nets_[i];
+    Tree& rsmt = parallel ? trees[k] : tree;
+
+    const bool cong = !parallel && congestionDriven && netCongestion(i);
+    const float coeffV
+        = parallel ? 0 : netTreeCoeff(i, congestionDriven, noADJ);
 
     if (reRoute) {
       if (newType) {
@@ -694,35 +772,10 @@ void FastRouteCore::gen_brk_RSMT(const bool congestionDriven,
       }
     }
 
-    if (noADJ) {
-      coeffV = 1.2;
+    if (!parallel) {
+      numShift += makeNetTree(i, congestionDriven, cong, coeffV, rsmt);
     }
 
-    // check net alpha because FastRoute has a special implementation of flute
-    // TODO: move this flute implementation to SteinerTreeBuilder
-    const float net_alpha = stt_builder_->getAlpha(net->getDbNet());
-    if (net_alpha > 0.0) {
-      rsmt = stt_builder_->makeSteinerTree(
-          net->getDbNet(), net->getPinX(), net->getPinY(), net->getDriverIdx());
-    } else {
-      if (congestionDriven) {
-        // call congestion driven flute to generate RSMT
-        if (cong) {
-          fluteCongest(
-              i, net->getPinX(), net->getPinY(), flute_accuracy, coeffV, rsmt);
-        } else {
-          fluteNormal(
-              i, net->getPinX(), net->getPinY(), flute_accuracy, coeffV, rsmt);
-        }
-        if (d > 3) {
-          numShift += edgeShiftNew(rsmt, i);
-        }
-      } else {
-        // call FLUTE to generate RSMT for each net
-        fluteNormal(
-            i, net->getPinX(), net->getPinY(), flute_accuracy, coeffV, rsmt);
-      }
-    }
     if (debug_->isOn() && debug_->steinerTree_
         && net->getDbNet() == debug_->net_) {
       steinerTreeVisualization(rsmt, net);
@@ -732,10 +785,6 @@ void FastRouteCore::gen_brk_RSMT(const bool congestionDriven,
       copyStTree(i, rsmt);
     }
 
-    if (net->getNumPins() != rsmt.deg) {
-      d = rsmt.deg;
-    }
-
     if (congestionDriven) {
       for (int j = 0; j < sttrees_[i].num_edges(); j++)
         wl1 += sttrees_[i].edges[j].len;
@@ -779,7 +828,11 @@ void FastRouteCore::gen_brk_RSMT(const bool congestionDriven,
           RouteType::NoRoute,
           true);  // route the net with no previous route for each tree edge
     }
-  }  // loop i
+
+    if (parallel) {
+      rsmt = Tree();
+    }
+  }  // loop k
 
   debugPrint(logger_,
              GRT,
@@ -30,16 +30,35 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <omp.h>
+
 #include <algorithm>
 
 #include "DataType.h"
 #include "FastRoute.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace grt {
 
 using utl::GRT;
 
+void MazeWorkspace::reset(int x1, int y1, int x2, int y2)
+{
+  d1.reset(x1, y1, x2, y2);
+  d2.reset(x1, y1, x2, y2);
+  parent_x1.reset(x1, y1, x2, y2);
+  parent_y1.reset(x1, y1, x2, y2);
+  parent_x3.reset(x1, y1, x2, y2);
+  parent_y3.reset(x1, y1, x2, y2);
+  hv.reset(x1, y1, x2, y2);
+  hyper_v.reset(x1, y1, x2, y2);
+  hyper_h.reset(x1, y1, x2, y2);
+  corr_edge.reset(x1, y1, x2, y2);
+  // entries are cleared after every search, so new ones start as false
+  pop_heap2.resize(d2.size(), false);
+}
+
 static int parent_index(int i)
 {
   return (i - 1) / 2;
@@ -726,25 +745,19 @@ void FastRouteCore::updateCongestionHistory(const int upType,
 // put all the nodes in the subtree t1 and t2 into src_heap and dest_heap
 // netID     - the ID for the net
 // edgeID    - the ID for the tree edge to route
-// d1        - the distance of any grid from the source subtree t1
-// d2        - the distance of any grid from the destination subtree t2
-// src_heap  - the heap storing the addresses for d1
-// dest_heap - the heap storing the addresses for d2
+// ws        - the workspace covering the enlarged region, holding d1 and d2,
+//             the distance of any grid from the source subtree t1 and the
+//             destination subtree t2, and src_heap and dest_heap, the heaps
+//             storing their addresses
 void FastRouteCore::setupHeap(const int netID,
                               const int edgeID,
-                              std::vector<float*>& src_heap,
-                              std::vector<float*>& dest_heap,
-                              multi_array<float, 2>& d1,
-                              multi_array<float, 2>& d2,
-                              const int regionX1,
-                              const int regionX2,
-                              const int regionY1,
-                              const int regionY2)
+                              MazeWorkspace& ws)
 {
-  for (int i = regionY1; i <= regionY2; i++) {
-    for (int j = regionX1; j <= regionX2; j++)
-      in_region_[i][j] = true;
-  }
+  auto& d1 = ws.d1;
+  auto& d2 = ws.d2;
+  auto& src_heap = ws.src_heap;
+  auto& dest_heap = ws.dest_heap;
+  auto& corr_edge = ws.corr_edge;
 
   const auto& treeedges = sttrees_[netID].edges;
   const auto& treenodes = sttrees_[netID].nodes;
@@ -817,12 +830,12 @@ void FastRouteCore::setupHeap(const int netID,
           if (treeedges[edge].route.routelen > 0) {  // not a degraded edge
             // put nbr into src_heap if in enlarged region
             const TreeNode& nbr_node = treenodes[nbr];
-            if (in_region_[nbr_node.y][nbr_node.x]) {
+            if (d1.contains(nbr_node.x, nbr_node.y)) {
               const int nbrX = nbr_node.x;
               const int nbrY = nbr_node.y;
               d1[nbrY][nbrX] = 0;
               src_heap.push_back(&d1[nbrY][nbrX]);
-              corr_edge_[nbrY][nbrX] = edge;
+              corr_edge[nbrY][nbrX] = edge;
             }
 
             const Route* route = &(treeedges[edge].route);
@@ -835,10 +848,10 @@ void FastRouteCore::setupHeap(const int netID,
               const int x_grid = route->gridsX[j];
               const int y_grid = route->gridsY[j];
 
-              if (in_region_[y_grid][x_grid]) {
+              if (d1.contains(x_grid, y_grid)) {
                 d1[y_grid][x_grid] = 0;
                 src_heap.push_back(&d1[y_grid][x_grid]);
-                corr_edge_[y_grid][x_grid] = edge;
+                corr_edge[y_grid][x_grid] = edge;
               }
             }
           }  // if not a degraded edge (len>0)
@@ -897,12 +910,12 @@ void FastRouteCore::setupHeap(const int netID,
           if (treeedges[edge].route.routelen > 0) {  // not a degraded edge
             // put nbr into dest_heap
             const TreeNode& nbr_node = treenodes[nbr];
-            if (in_region_[nbr_node.y][nbr_node.x]) {
+            if (d1.contains(nbr_node.x, nbr_node.y)) {
               const int nbrX = nbr_node.x;
               const int nbrY = nbr_node.y;
               d2[nbrY][nbrX] = 0;
               dest_heap.push_back(&d2[nbrY][nbrX]);
-              corr_edge_[nbrY][nbrX] = edge;
+              corr_edge[nbrY][nbrX] = edge;
             }
 
             const Route* route = &(treeedges[edge].route);
@@ -914,10 +927,10 @@ void FastRouteCore::setupHeap(const int netID,
             for (int j = 1; j < route->routelen; j++) {
               const int x_grid = route->gridsX[j];
               const int y_grid = route->gridsY[j];
-              if (in_region_[y_grid][x_grid]) {
+              if (d1.contains(x_grid, y_grid)) {
                 d2[y_grid][x_grid] = 0;
                 dest_heap.push_back(&d2[y_grid][x_grid]);
-                corr_edge_[y_grid][x_grid] = edge;
+                corr_edge[y_grid][x_grid] = edge;
               }
             }
           }  // if the edge is not degraded (len>0)
@@ -929,11 +942,6 @@ void FastRouteCore::setupHeap(const int netID,
       }    // while queue is not empty
     }      // else n2 is not a Pin node
   }        // net with more than two pins
-
-  for (int i = regionY1; i <= regionY2; i++) {
-    for (int j = regionX1; j <= regionX2; j++)
-      in_region_[i][j] = false;
-  }
 }
 
 int FastRouteCore::copyGrids(const TreeNode* treenodes,
@@ -1329,8 +1337,6 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
                                   float& slack_th)
 {
   // maze routing for multi-source, multi-destination
-  int tmpX, tmpY;
-
   const int max_usage_multiplier = 40;
 
   // allocate memory for distance and parent and pop_heap
@@ -1346,11 +1352,6 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
         = getCost(i, logis_cof, cost_height, slope, v_capacity_, cost_type);
   }
 
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_; j++)
-      in_region_[i][j] = false;
-  }
-
   if (ordering) {
     if (update_slack_) {
       slack_th = CalculatePartialSlack();
@@ -1358,781 +1359,1047 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
     StNetOrder();
   }
 
-  std::vector<float*> src_heap;
-  std::vector<float*> dest_heap;
-  src_heap.reserve(y_grid_ * x_grid_);
-  dest_heap.reserve(y_grid_ * x_grid_);
+  const MazeRouteSettings settings{iter,
+                                   expand,
+                                   cost_height,
+                                   ripup_threshold,
+                                   maze_edge_threshold,
+                                   cost_type,
+                                   logis_cof,
+                                   via,
+                                   slope,
+                                   L,
+                                   slack_th};
+
+  std::vector<int> net_ids;
+  net_ids.reserve(netCount());
+  for (int nidRPC = 0; nidRPC < netCount(); nidRPC++) {
+    const int netID = ordering ? tree_order_cong_[nidRPC].treeIndex : nidRPC;
 
-  multi_array<float, 2> d1(boost::extents[y_range_][x_range_]);
-  multi_array<float, 2> d2(boost::extents[y_range_][x_range_]);
+    if (!nets_[netID]->isRouted()) {
+      net_ids.push_back(netID);
+    }
+  }
 
-  std::vector<bool> pop_heap2(y_grid_ * x_range_, false);
+  if (maze_threads_ > 0) {
+    std::vector<MazeWorkspace> workspaces(maze_threads_);
+    mazeRouteBatches(net_ids, settings, workspaces);
+  } else {
+    MazeWorkspace ws;
+    const odb::Rect grid(0, 0, x_grid_ - 1, y_grid_ - 1);
+    for (const int netID : net_ids) {
+      // a net left with a broken tree is rebuilt and routed again
+      while (!mazeRouteNet(netID, settings, grid, ws, enlarge_)) {
+        reInitTree(netID);
+      }
+      mergeMazeUsage(ws);
+    }
+  }
 
-  for (int nidRPC = 0; nidRPC < netCount(); nidRPC++) {
-    const int netID = ordering ? tree_order_cong_[nidRPC].treeIndex : nidRPC;
+  h_cost_table_.clear();
+  v_cost_table_.clear();
+}
 
-    if (nets_[netID]->isRouted())
-      continue;
+// Rips up and maze routes the long edges of one net, keeping every search
+// region inside bounds. last_enlarge is set to the region enlargement of
+// the last routed edge. Returns false when the tree of the net got broken
+// and must be rebuilt with reInitTree before routing it again.
+bool FastRouteCore::mazeRouteNet(const int netID,
+                                 const MazeRouteSettings& settings,
+                                 const odb::Rect& bounds,
+                                 MazeWorkspace& ws,
+                                 int& last_enlarge)
+{
+  const int iter = settings.iter;
+  const int expand = settings.expand;
+  const float cost_height = settings.cost_height;
+  const int ripup_threshold = settings.ripup_threshold;
+  const int maze_edge_threshold = settings.maze_edge_threshold;
+  const int cost_type = settings.cost_type;
+  const float logis_cof = settings.logis_cof;
+  const int via = settings.via;
+  const int slope = settings.slope;
+  const int L = settings.L;
+  const float slack_th = settings.slack_th;
+
+  auto& d1 = ws.d1;
+  auto& d2 = ws.d2;
+  auto& parent_x1 = ws.parent_x1;
+  auto& parent_y1 = ws.parent_y1;
+  auto& parent_x3 = ws.parent_x3;
+  auto& parent_y3 = ws.parent_y3;
+  auto& hv = ws.hv;
+  auto& hyper_v = ws.hyper_v;
+  auto& hyper_h = ws.hyper_h;
+  auto& corr_edge = ws.corr_edge;
+  auto& pop_heap2 = ws.pop_heap2;
+  auto& src_heap = ws.src_heap;
+  auto& dest_heap = ws.dest_heap;
+  auto& net_eo = ws.net_eo;
 
-    const int num_terminals = sttrees_[netID].num_terminals;
+  int tmpX, tmpY;
 
-    const int origENG = expand;
+  const int num_terminals = sttrees_[netID].num_terminals;
 
-    netedgeOrderDec(netID);
+  const int origENG = expand;
 
-    auto& treeedges = sttrees_[netID].edges;
-    auto& treenodes = sttrees_[netID].nodes;
-    // loop for all the tree edges
-    const int num_edges = sttrees_[netID].num_edges();
-    for (int edgeREC = 0; edgeREC < num_edges; edgeREC++) {
-      const int edgeID = net_eo_[edgeREC].edgeID;
-      TreeEdge* treeedge = &(treeedges[edgeID]);
-
-      const int n1 = treeedge->n1;
-      const int n2 = treeedge->n2;
-      const int n1x = treenodes[n1].x;
-      const int n1y = treenodes[n1].y;
-      const int n2x = treenodes[n2].x;
-      const int n2y = treenodes[n2].y;
-      treeedge->len = abs(n2x - n1x) + abs(n2y - n1y);
-
-      if (treeedge->len
-          <= maze_edge_threshold)  // only route the non-degraded edges (len>0)
-      {
-        continue;
-      }
+  netedgeOrderDec(netID, net_eo);
 
-      const bool enter = newRipupCheck(treeedge,
-                                       n1x,
-                                       n1y,
-                                       n2x,
-                                       n2y,
-                                       ripup_threshold,
-                                       slack_th,
-                                       netID,
-                                       edgeID);
-
-      if (!enter) {
-        continue;
-      }
+  auto& treeedges = sttrees_[netID].edges;
+  auto& treenodes = sttrees_[netID].nodes;
+  // loop for all the tree edges
+  const int num_edges = sttrees_[netID].num_edges();
+  for (int edgeREC = 0; edgeREC < num_edges; edgeREC++) {
+    const int edgeID = net_eo[edgeREC].edgeID;
+    TreeEdge* treeedge = &(treeedges[edgeID]);
+
+    const int n1 = treeedge->n1;
+    const int n2 = treeedge->n2;
+    const int n1x = treenodes[n1].x;
+    const int n1y = treenodes[n1].y;
+    const int n2x = treenodes[n2].x;
+    const int n2y = treenodes[n2].y;
+    treeedge->len = abs(n2x - n1x) + abs(n2y - n1y);
+
+    if (treeedge->len
+        <= maze_edge_threshold)  // only route the non-degraded edges (len>0)
+    {
+      continue;
+    }
+
+    const bool enter = newRipupCheck(treeedge,
+                                     n1x,
+                                     n1y,
+                                     n2x,
+                                     n2y,
+                                     ripup_threshold,
+                                     slack_th,
+                                     netID,
+                                     edgeID);
 
-      // ripup the routing for the edge
-      const int ymin = std::min(n1y, n2y);
-      const int ymax = std::max(n1y, n2y);
+    if (!enter) {
+      continue;
+    }
 
-      const int xmin = std::min(n1x, n2x);
-      const int xmax = std::max(n1x, n2x);
+    // ripup the routing for the edge
+    const int ymin = std::min(n1y, n2y);
+    const int ymax = std::max(n1y, n2y);
 
-      enlarge_ = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
+    const int xmin = std::min(n1x, n2x);
+    const int xmax = std::max(n1x, n2x);
 
-      int decrease = 0;
+    const int enlarge
+        = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
+    last_enlarge = enlarge;
 
-      if (nets_[netID]->isCritical()) {
-        decrease = std::min((iter / 7) * 5, enlarge_ / 2);
-      }
-      const int regionX1 = std::max(xmin - enlarge_ + decrease, 0);
-      const int regionX2 = std::min(xmax + enlarge_ - decrease, x_grid_ - 1);
-      const int regionY1 = std::max(ymin - enlarge_ + decrease, 0);
-      const int regionY2 = std::min(ymax + enlarge_ - decrease, y_grid_ - 1);
-
-      // initialize d1[][] and d2[][] as BIG_INT
-      for (int i = regionY1; i <= regionY2; i++) {
-        for (int j = regionX1; j <= regionX2; j++) {
-          d1[i][j] = BIG_INT;
-          d2[i][j] = BIG_INT;
-          hyper_h_[i][j] = false;
-          hyper_v_[i][j] = false;
-        }
+    int decrease = 0;
+
+    if (nets_[netID]->isCritical()) {
+      decrease = std::min((iter / 7) * 5, enlarge / 2);
+    }
+    const int regionX1 = std::max(xmin - enlarge + decrease, bounds.xMin());
+    const int regionX2 = std::min(xmax + enlarge - decrease, bounds.xMax());
+    const int regionY1 = std::max(ymin - enlarge + decrease, bounds.yMin());
+    const int regionY2 = std::min(ymax + enlarge - decrease, bounds.yMax());
+
+    ws.reset(regionX1, regionY1, regionX2, regionY2);
+
+    // initialize d1[][] and d2[][] as BIG_INT
+    for (int i = regionY1; i <= regionY2; i++) {
+      for (int j = regionX1; j <= regionX2; j++) {
+        d1[i][j] = BIG_INT;
+        d2[i][j] = BIG_INT;
+        hyper_h[i][j] = false;
+        hyper_v[i][j] = false;
       }
+    }
 
-      // setup src_heap, dest_heap and initialize d1[][] and d2[][] for all the
-      // grids on the two subtrees
-      setupHeap(netID,
-                edgeID,
-                src_heap,
-                dest_heap,
-                d1,
-                d2,
-                regionX1,
-                regionX2,
-                regionY1,
-                regionY2);
-
-      // while loop to find shortest path
-      int ind1 = (src_heap[0] - &d1[0][0]);
-      for (int i = 0; i < dest_heap.size(); i++)
-        pop_heap2[(dest_heap[i] - &d2[0][0])] = true;
-
-      // stop when the grid position been popped out from both src_heap and
-      // dest_heap
-      while (pop_heap2[ind1] == false) {
-        // relax all the adjacent grids within the enlarged region for
-        // source subtree
-        const int curX = ind1 % x_range_;
-        const int curY = ind1 / x_range_;
-        int preX, preY;
-        if (d1[curY][curX] != 0) {
-          if (hv_[curY][curX]) {
-            preX = parent_x1_[curY][curX];
-            preY = parent_y1_[curY][curX];
-          } else {
-            preX = parent_x3_[curY][curX];
-            preY = parent_y3_[curY][curX];
-          }
+    // setup src_heap, dest_heap and initialize d1[][] and d2[][] for all the
+    // grids on the two subtrees
+    setupHeap(netID, edgeID, ws);
+
+    // while loop to find shortest path
+    int ind1 = (src_heap[0] - d1.data());
+    for (int i = 0; i < dest_heap.size(); i++)
+      pop_heap2[(dest_heap[i] - d2.data())] = true;
+
+    // stop when the grid position been popped out from both src_heap and
+    // dest_heap
+    while (pop_heap2[ind1] == false) {
+      // relax all the adjacent grids within the enlarged region for
+      // source subtree
+      const int curX = d1.xOf(ind1);
+      const int curY = d1.yOf(ind1);
+      int preX, preY;
+      if (d1[curY][curX] != 0) {
+        if (hv[curY][curX]) {
+          preX = parent_x1[curY][curX];
+          preY = parent_y1[curY][curX];
         } else {
-          preX = curX;
-          preY = curY;
+          preX = parent_x3[curY][curX];
+          preY = parent_y3[curY][curX];
         }
+      } else {
+        preX = curX;
+        preY = curY;
+      }
 
-        removeMin(src_heap);
-
-        // left
-        if (curX > regionX1) {
-          float tmp, cost1, cost2;
-          const int pos1 = h_edges_[curY][curX - 1].usage_red()
-                           + L * h_edges_[curY][(curX - 1)].last_usage;
-
-          if (pos1 < h_cost_table_.size())
-            cost1 = h_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
-
-          if ((preY == curY) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curX < regionX2 - 1) {
-              const int pos2 = h_edges_[curY][curX].usage_red()
-                               + L * h_edges_[curY][curX].last_usage;
-
-              if (pos2 < h_cost_table_.size())
-                cost2 = h_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                h_capacity_,
-                                cost_type);
-
-              const int tmp_cost = d1[curY][curX + 1] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_h_[curY][curX] = true;
-              }
+      removeMin(src_heap);
+
+      // left
+      if (curX > regionX1) {
+        float tmp, cost1, cost2;
+        const int pos1 = h_edges_[curY][curX - 1].usage_red()
+                         + L * h_edges_[curY][(curX - 1)].last_usage;
+
+        if (pos1 < h_cost_table_.size())
+          cost1 = h_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
+
+        if ((preY == curY) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curX < regionX2 - 1) {
+            const int pos2 = h_edges_[curY][curX].usage_red()
+                             + L * h_edges_[curY][curX].last_usage;
+
+            if (pos2 < h_cost_table_.size())
+              cost2 = h_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              h_capacity_,
+                              cost_type);
+
+            const int tmp_cost = d1[curY][curX + 1] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_h[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpX = curX - 1;  // the left neighbor
-
-          if (d1[curY][tmpX]
-              >= BIG_INT)  // left neighbor not been put into src_heap
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            float* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
         }
-        // right
-        if (curX < regionX2) {
-          float tmp, cost1, cost2;
-          const int pos1 = h_edges_[curY][curX].usage_red()
-                           + L * h_edges_[curY][curX].last_usage;
-
-          if (pos1 < h_cost_table_.size())
-            cost1 = h_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
-
-          if ((preY == curY) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curX > regionX1 + 1) {
-              const int pos2 = h_edges_[curY][curX - 1].usage_red()
-                               + L * h_edges_[curY][curX - 1].last_usage;
-
-              if (pos2 < h_cost_table_.size())
-                cost2 = h_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                h_capacity_,
-                                cost_type);
-              const int tmp_cost = d1[curY][curX - 1] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_h_[curY][curX] = true;
-              }
+        tmpX = curX - 1;  // the left neighbor
+
+        if (d1[curY][tmpX]
+            >= BIG_INT)  // left neighbor not been put into src_heap
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          src_heap.push_back(&d1[curY][tmpX]);
+          updateHeap(src_heap, src_heap.size() - 1);
+        } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          float* dtmp = &d1[curY][tmpX];
+          int ind = 0;
+          while (src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(src_heap, ind);
+        }
+      }
+      // right
+      if (curX < regionX2) {
+        float tmp, cost1, cost2;
+        const int pos1 = h_edges_[curY][curX].usage_red()
+                         + L * h_edges_[curY][curX].last_usage;
+
+        if (pos1 < h_cost_table_.size())
+          cost1 = h_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
+
+        if ((preY == curY) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curX > regionX1 + 1) {
+            const int pos2 = h_edges_[curY][curX - 1].usage_red()
+                             + L * h_edges_[curY][curX - 1].last_usage;
+
+            if (pos2 < h_cost_table_.size())
+              cost2 = h_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              h_capacity_,
+                              cost_type);
+            const int tmp_cost = d1[curY][curX - 1] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_h[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpX = curX + 1;  // the right neighbor
-
-          if (d1[curY][tmpX]
-              >= BIG_INT)  // right neighbor not been put into src_heap
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            float* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
         }
-        // bottom
-        if (curY > regionY1) {
-          float tmp, cost1, cost2;
-          const int pos1 = v_edges_[curY - 1][curX].usage_red()
-                           + L * v_edges_[curY - 1][curX].last_usage;
-
-          if (pos1 < v_cost_table_.size())
-            cost1 = v_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
-
-          if ((preX == curX) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curY < regionY2 - 1) {
-              const int pos2 = v_edges_[curY][curX].usage_red()
-                               + L * v_edges_[curY][curX].last_usage;
-
-              if (pos2 < v_cost_table_.size())
-                cost2 = v_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                v_capacity_,
-                                cost_type);
-              const int tmp_cost = d1[curY + 1][curX] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_v_[curY][curX] = true;
-              }
+        tmpX = curX + 1;  // the right neighbor
+
+        if (d1[curY][tmpX]
+            >= BIG_INT)  // right neighbor not been put into src_heap
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          src_heap.push_back(&d1[curY][tmpX]);
+          updateHeap(src_heap, src_heap.size() - 1);
+        } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          float* dtmp = &d1[curY][tmpX];
+          int ind = 0;
+          while (src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(src_heap, ind);
+        }
+      }
+      // bottom
+      if (curY > regionY1) {
+        float tmp, cost1, cost2;
+        const int pos1 = v_edges_[curY - 1][curX].usage_red()
+                         + L * v_edges_[curY - 1][curX].last_usage;
+
+        if (pos1 < v_cost_table_.size())
+          cost1 = v_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
+
+        if ((preX == curX) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curY < regionY2 - 1) {
+            const int pos2 = v_edges_[curY][curX].usage_red()
+                             + L * v_edges_[curY][curX].last_usage;
+
+            if (pos2 < v_cost_table_.size())
+              cost2 = v_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              v_capacity_,
+                              cost_type);
+            const int tmp_cost = d1[curY + 1][curX] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_v[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpY = curY - 1;  // the bottom neighbor
-          if (d1[tmpY][curX]
-              >= BIG_INT)  // bottom neighbor not been put into src_heap
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            float* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
         }
-        // top
-        if (curY < regionY2) {
-          float tmp, cost1, cost2;
-          const int pos1 = v_edges_[curY][curX].usage_red()
-                           + L * v_edges_[curY][curX].last_usage;
-
-          if (pos1 < v_cost_table_.size())
-            cost1 = v_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
-
-          if ((preX == curX) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curY > regionY1 + 1) {
-              const int pos2 = v_edges_[curY - 1][curX].usage_red()
-                               + L * v_edges_[curY - 1][curX].last_usage;
-
-              if (pos2 < v_cost_table_.size())
-                cost2 = v_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                v_capacity_,
-                                cost_type);
-
-              const int tmp_cost = d1[curY - 1][curX] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_v_[curY][curX] = true;
-              }
+        tmpY = curY - 1;  // the bottom neighbor
+        if (d1[tmpY][curX]
+            >= BIG_INT)  // bottom neighbor not been put into src_heap
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          src_heap.push_back(&d1[tmpY][curX]);
+          updateHeap(src_heap, src_heap.size() - 1);
+        } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          float* dtmp = &d1[tmpY][curX];
+          int ind = 0;
+          while (src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(src_heap, ind);
+        }
+      }
+      // top
+      if (curY < regionY2) {
+        float tmp, cost1, cost2;
+        const int pos1 = v_edges_[curY][curX].usage_red()
+                         + L * v_edges_[curY][curX].last_usage;
+
+        if (pos1 < v_cost_table_.size())
+          cost1 = v_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
+
+        if ((preX == curX) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curY > regionY1 + 1) {
+            const int pos2 = v_edges_[curY - 1][curX].usage_red()
+                             + L * v_edges_[curY - 1][curX].last_usage;
+
+            if (pos2 < v_cost_table_.size())
+              cost2 = v_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              v_capacity_,
+                              cost_type);
+
+            const int tmp_cost = d1[curY - 1][curX] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_v[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpY = curY + 1;  // the top neighbor
-          if (d1[tmpY][curX]
-              >= BIG_INT)  // top neighbor not been put into src_heap
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            float* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
         }
+        tmpY = curY + 1;  // the top neighbor
+        if (d1[tmpY][curX]
+            >= BIG_INT)  // top neighbor not been put into src_heap
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          src_heap.push_back(&d1[tmpY][curX]);
+          updateHeap(src_heap, src_heap.size() - 1);
+        } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          float* dtmp = &d1[tmpY][curX];
+          int ind = 0;
+          while (src_heap[ind] != dtmp)
+            ind++;
+          updateHeap(src_heap, ind);
+        }
+      }
 
-        // update ind1 for next loop
-        ind1 = (src_heap[0] - &d1[0][0]);
+      // update ind1 for next loop
+      ind1 = (src_heap[0] - d1.data());
 
-      }  // while loop
+    }  // while loop
 
-      for (int i = 0; i < dest_heap.size(); i++)
-        pop_heap2[(dest_heap[i] - &d2[0][0])] = false;
+    for (int i = 0; i < dest_heap.size(); i++)
+      pop_heap2[(dest_heap[i] - d2.data())] = false;
 
-      const int crossX = ind1 % x_range_;
-      const int crossY = ind1 / x_range_;
+    const int crossX = d1.xOf(ind1);
+    const int crossY = d1.yOf(ind1);
 
-      int cnt = 0;
-      int curX = crossX;
-      int curY = crossY;
-      std::vector<int> tmp_gridsX, tmp_gridsY;
-      while (d1[curY][curX] != 0)  // loop until reach subtree1
-      {
-        bool hypered = false;
-        if (cnt != 0) {
-          if (curX != tmpX && hyper_h_[curY][curX]) {
-            curX = 2 * curX - tmpX;
-            hypered = true;
-          }
+    int cnt = 0;
+    int curX = crossX;
+    int curY = crossY;
+    std::vector<int> tmp_gridsX, tmp_gridsY;
+    while (d1[curY][curX] != 0)  // loop until reach subtree1
+    {
+      bool hypered = false;
+      if (cnt != 0) {
+        if (curX != tmpX && hyper_h[curY][curX]) {
+          curX = 2 * curX - tmpX;
+          hypered = true;
+        }
 
-          if (curY != tmpY && hyper_v_[curY][curX]) {
-            curY = 2 * curY - tmpY;
-            hypered = true;
-          }
+        if (curY != tmpY && hyper_v[curY][curX]) {
+          curY = 2 * curY - tmpY;
+          hypered = true;
         }
-        tmpX = curX;
-        tmpY = curY;
-        if (!hypered) {
-          if (hv_[tmpY][tmpX]) {
-            curY = parent_y1_[tmpY][tmpX];
-          } else {
-            curX = parent_x3_[tmpY][tmpX];
-          }
+      }
+      tmpX = curX;
+      tmpY = curY;
+      if (!hypered) {
+        if (hv[tmpY][tmpX]) {
+          curY = parent_y1[tmpY][tmpX];
+        } else {
+          curX = parent_x3[tmpY][tmpX];
         }
-        tmp_gridsX.push_back(curX);
-        tmp_gridsY.push_back(curY);
-        cnt++;
       }
-      // reverse the grids on the path
-      std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
-      std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
-
-      // add the connection point (crossX, crossY)
-      gridsX.push_back(crossX);
-      gridsY.push_back(crossY);
+      tmp_gridsX.push_back(curX);
+      tmp_gridsY.push_back(curY);
       cnt++;
+    }
+    // reverse the grids on the path
+    std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
+    std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
 
-      curX = crossX;
-      curY = crossY;
-      const int cnt_n1n2 = cnt;
-
-      // change the tree structure according to the new routing for the tree
-      // edge find E1 and E2, and the endpoints of the edges they are on
-      const int E1x = gridsX[0];
-      const int E1y = gridsY[0];
-      const int E2x = gridsX.back();
-      const int E2y = gridsY.back();
-
-      const int edge_n1n2 = edgeID;
-      // (1) consider subtree1
-      if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
-      // n1 is not a pin and E1!=n1, then make change to subtree1,
-      // otherwise, no change to subtree1
+    // add the connection point (crossX, crossY)
+    gridsX.push_back(crossX);
+    gridsY.push_back(crossY);
+    cnt++;
+
+    curX = crossX;
+    curY = crossY;
+    const int cnt_n1n2 = cnt;
+
+    // change the tree structure according to the new routing for the tree
+    // edge find E1 and E2, and the endpoints of the edges they are on
+    const int E1x = gridsX[0];
+    const int E1y = gridsY[0];
+    const int E2x = gridsX.back();
+    const int E2y = gridsY.back();
+
+    const int edge_n1n2 = edgeID;
+    // (1) consider subtree1
+    if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
+    // n1 is not a pin and E1!=n1, then make change to subtree1,
+    // otherwise, no change to subtree1
+    {
+      // find the endpoints of the edge E1 is on
+      const int endpt1 = treeedges[corr_edge[E1y][E1x]].n1;
+      const int endpt2 = treeedges[corr_edge[E1y][E1x]].n2;
+
+      // find A1, A2 and edge_n1A1, edge_n1A2
+      int A1, A2;
+      int edge_n1A1, edge_n1A2;
+      if (treenodes[n1].nbr[0] == n2) {
+        A1 = treenodes[n1].nbr[1];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[1];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else if (treenodes[n1].nbr[1] == n2) {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[1];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[1];
+      }
+
+      if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
       {
-        // find the endpoints of the edge E1 is on
-        const int endpt1 = treeedges[corr_edge_[E1y][E1x]].n1;
-        const int endpt2 = treeedges[corr_edge_[E1y][E1x]].n2;
-
-        // find A1, A2 and edge_n1A1, edge_n1A2
-        int A1, A2;
-        int edge_n1A1, edge_n1A2;
-        if (treenodes[n1].nbr[0] == n2) {
-          A1 = treenodes[n1].nbr[1];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[1];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else if (treenodes[n1].nbr[1] == n2) {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[1];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[1];
+        // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
+        // (n1, A1)
+        if (endpt1 == A2 || endpt2 == A2) {
+          std::swap(A1, A2);
+          std::swap(edge_n1A1, edge_n1A2);
         }
 
-        if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
-        {
-          // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
-          // (n1, A1)
-          if (endpt1 == A2 || endpt2 == A2) {
-            std::swap(A1, A2);
-            std::swap(edge_n1A1, edge_n1A2);
-          }
-
-          // update route for edge (n1, A1), (n1, A2)
-          bool route_ok = updateRouteType1(netID,
-                                           treenodes.get(),
-                                           n1,
-                                           A1,
-                                           A2,
-                                           E1x,
-                                           E1y,
-                                           treeedges.get(),
-                                           edge_n1A1,
-                                           edge_n1A2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->error(GRT,
-                             150,
-                             "Net {} has errors during updateRouteType1.",
-                             nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        // update route for edge (n1, A1), (n1, A2)
+        bool route_ok = updateRouteType1(netID,
+                                         treenodes.get(),
+                                         n1,
+                                         A1,
+                                         A2,
+                                         E1x,
+                                         E1y,
+                                         treeedges.get(),
+                                         edge_n1A1,
+                                         edge_n1A2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->error(GRT,
+                           150,
+                           "Net {} has errors during updateRouteType1.",
+                           nets_[netID]->getName());
+          return false;
+        }
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+      }     // if E1 is on (n1, A1) or (n1, A2)
+      else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+      {
+        const int C1 = endpt1;
+        const int C2 = endpt2;
+        const int edge_C1C2 = corr_edge[E1y][E1x];
+
+        // update route for edge (n1, C1), (n1, C2) and (A1, A2)
+        bool route_ok = updateRouteType2(netID,
+                                         treenodes.get(),
+                                         n1,
+                                         A1,
+                                         A2,
+                                         C1,
+                                         C2,
+                                         E1x,
+                                         E1y,
+                                         treeedges.get(),
+                                         edge_n1A1,
+                                         edge_n1A2,
+                                         edge_C1C2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->warn(GRT,
+                          151,
+                          "Net {} has errors during updateRouteType2.",
+                          nets_[netID]->getName());
+          return false;
+        }
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+        // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
+        // C2)->(A1, A2)
+        const int edge_n1C1 = edge_n1A1;
+        treeedges[edge_n1C1].n1 = C1;
+        treeedges[edge_n1C1].n2 = n1;
+        const int edge_n1C2 = edge_n1A2;
+        treeedges[edge_n1C2].n1 = n1;
+        treeedges[edge_n1C2].n2 = C2;
+        const int edge_A1A2 = edge_C1C2;
+        treeedges[edge_A1A2].n1 = A1;
+        treeedges[edge_A1A2].n2 = A2;
+        // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
+        // n1's nbr (n2, A1, A2)->(n2, C1, C2)
+        treenodes[n1].nbr[0] = n2;
+        treenodes[n1].edge[0] = edge_n1n2;
+        treenodes[n1].nbr[1] = C1;
+        treenodes[n1].edge[1] = edge_n1C1;
+        treenodes[n1].nbr[2] = C2;
+        treenodes[n1].edge[2] = edge_n1C2;
+        // A1's nbr n1->A2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A1].nbr[i] == n1) {
+            treenodes[A1].nbr[i] = A2;
+            treenodes[A1].edge[i] = edge_A1A2;
             break;
           }
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-        }     // if E1 is on (n1, A1) or (n1, A2)
-        else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-        {
-          const int C1 = endpt1;
-          const int C2 = endpt2;
-          const int edge_C1C2 = corr_edge_[E1y][E1x];
-
-          // update route for edge (n1, C1), (n1, C2) and (A1, A2)
-          bool route_ok = updateRouteType2(netID,
-                                           treenodes.get(),
-                                           n1,
-                                           A1,
-                                           A2,
-                                           C1,
-                                           C2,
-                                           E1x,
-                                           E1y,
-                                           treeedges.get(),
-                                           edge_n1A1,
-                                           edge_n1A2,
-                                           edge_C1C2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            151,
-                            "Net {} has errors during updateRouteType2.",
-                            nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        }
+        // A2's nbr n1->A1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A2].nbr[i] == n1) {
+            treenodes[A2].nbr[i] = A1;
+            treenodes[A2].edge[i] = edge_A1A2;
             break;
           }
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-          // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
-          // C2)->(A1, A2)
-          const int edge_n1C1 = edge_n1A1;
-          treeedges[edge_n1C1].n1 = C1;
-          treeedges[edge_n1C1].n2 = n1;
-          const int edge_n1C2 = edge_n1A2;
-          treeedges[edge_n1C2].n1 = n1;
-          treeedges[edge_n1C2].n2 = C2;
-          const int edge_A1A2 = edge_C1C2;
-          treeedges[edge_A1A2].n1 = A1;
-          treeedges[edge_A1A2].n2 = A2;
-          // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
-          // n1's nbr (n2, A1, A2)->(n2, C1, C2)
-          treenodes[n1].nbr[0] = n2;
-          treenodes[n1].edge[0] = edge_n1n2;
-          treenodes[n1].nbr[1] = C1;
-          treenodes[n1].edge[1] = edge_n1C1;
-          treenodes[n1].nbr[2] = C2;
-          treenodes[n1].edge[2] = edge_n1C2;
-          // A1's nbr n1->A2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A1].nbr[i] == n1) {
-              treenodes[A1].nbr[i] = A2;
-              treenodes[A1].edge[i] = edge_A1A2;
-              break;
-            }
-          }
-          // A2's nbr n1->A1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A2].nbr[i] == n1) {
-              treenodes[A2].nbr[i] = A1;
-              treenodes[A2].edge[i] = edge_A1A2;
-              break;
-            }
-          }
-          // C1's nbr C2->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C1].nbr[i] == C2) {
-              treenodes[C1].nbr[i] = n1;
-              treenodes[C1].edge[i] = edge_n1C1;
-              break;
-            }
+        }
+        // C1's nbr C2->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C1].nbr[i] == C2) {
+            treenodes[C1].nbr[i] = n1;
+            treenodes[C1].edge[i] = edge_n1C1;
+            break;
           }
-          // C2's nbr C1->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C2].nbr[i] == C1) {
-              treenodes[C2].nbr[i] = n1;
-              treenodes[C2].edge[i] = edge_n1C2;
-              break;
-            }
+        }
+        // C2's nbr C1->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C2].nbr[i] == C1) {
+            treenodes[C2].nbr[i] = n1;
+            treenodes[C2].edge[i] = edge_n1C2;
+            break;
           }
+        }
 
-        }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-      }    // n1 is not a pin and E1!=n1
+      }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+    }    // n1 is not a pin and E1!=n1
 
-      // (2) consider subtree2
-      if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
-      // n2 is not a pin and E2!=n2, then make change to subtree2,
-      // otherwise, no change to subtree2
+    // (2) consider subtree2
+    if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
+    // n2 is not a pin and E2!=n2, then make change to subtree2,
+    // otherwise, no change to subtree2
+    {
+      // find the endpoints of the edge E1 is on
+      const int endpt1 = treeedges[corr_edge[E2y][E2x]].n1;
+      const int endpt2 = treeedges[corr_edge[E2y][E2x]].n2;
+
+      // find B1, B2
+      int B1, B2;
+      int edge_n2B1, edge_n2B2;
+      if (treenodes[n2].nbr[0] == n1) {
+        B1 = treenodes[n2].nbr[1];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[1];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else if (treenodes[n2].nbr[1] == n1) {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[1];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[1];
+      }
+
+      if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
       {
-        // find the endpoints of the edge E1 is on
-        const int endpt1 = treeedges[corr_edge_[E2y][E2x]].n1;
-        const int endpt2 = treeedges[corr_edge_[E2y][E2x]].n2;
-
-        // find B1, B2
-        int B1, B2;
-        int edge_n2B1, edge_n2B2;
-        if (treenodes[n2].nbr[0] == n1) {
-          B1 = treenodes[n2].nbr[1];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[1];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else if (treenodes[n2].nbr[1] == n1) {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[1];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[1];
+        // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
+        // (n2, B1)
+        if (endpt1 == B2 || endpt2 == B2) {
+          std::swap(B1, B2);
+          std::swap(edge_n2B1, edge_n2B2);
         }
 
-        if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
-        {
-          // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
-          // (n2, B1)
-          if (endpt1 == B2 || endpt2 == B2) {
-            std::swap(B1, B2);
-            std::swap(edge_n2B1, edge_n2B2);
-          }
+        // update route for edge (n2, B1), (n2, B2)
+        bool route_ok = updateRouteType1(netID,
+                                         treenodes.get(),
+                                         n2,
+                                         B1,
+                                         B2,
+                                         E2x,
+                                         E2y,
+                                         treeedges.get(),
+                                         edge_n2B1,
+                                         edge_n2B2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->warn(GRT,
+                          152,
+                          "Net {} has errors during updateRouteType1.",
+                          nets_[netID]->getName());
+          return false;
+        }
 
-          // update route for edge (n2, B1), (n2, B2)
-          bool route_ok = updateRouteType1(netID,
-                                           treenodes.get(),
-                                           n2,
-                                           B1,
-                                           B2,
-                                           E2x,
-                                           E2y,
-                                           treeedges.get(),
-                                           edge_n2B1,
-                                           edge_n2B2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            152,
-                            "Net {} has errors during updateRouteType1.",
-                            nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+      }     // if E2 is on (n2, B1) or (n2, B2)
+      else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+      {
+        const int D1 = endpt1;
+        const int D2 = endpt2;
+        const int edge_D1D2 = corr_edge[E2y][E2x];
+
+        // update route for edge (n2, D1), (n2, D2) and (B1, B2)
+        bool route_ok = updateRouteType2(netID,
+                                         treenodes.get(),
+                                         n2,
+                                         B1,
+                                         B2,
+                                         D1,
+                                         D2,
+                                         E2x,
+                                         E2y,
+                                         treeedges.get(),
+                                         edge_n2B1,
+                                         edge_n2B2,
+                                         edge_D1D2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->warn(GRT,
+                          153,
+                          "Net {} has errors during updateRouteType2.",
+                          nets_[netID]->getName());
+          return false;
+        }
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+        // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
+        // D2)->(B1, B2)
+        const int edge_n2D1 = edge_n2B1;
+        treeedges[edge_n2D1].n1 = D1;
+        treeedges[edge_n2D1].n2 = n2;
+        const int edge_n2D2 = edge_n2B2;
+        treeedges[edge_n2D2].n1 = n2;
+        treeedges[edge_n2D2].n2 = D2;
+        const int edge_B1B2 = edge_D1D2;
+        treeedges[edge_B1B2].n1 = B1;
+        treeedges[edge_B1B2].n2 = B2;
+        // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
+        // n1's nbr (n1, B1, B2)->(n1, D1, D2)
+        treenodes[n2].nbr[0] = n1;
+        treenodes[n2].edge[0] = edge_n1n2;
+        treenodes[n2].nbr[1] = D1;
+        treenodes[n2].edge[1] = edge_n2D1;
+        treenodes[n2].nbr[2] = D2;
+        treenodes[n2].edge[2] = edge_n2D2;
+        // B1's nbr n2->B2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B1].nbr[i] == n2) {
+            treenodes[B1].nbr[i] = B2;
+            treenodes[B1].edge[i] = edge_B1B2;
             break;
           }
-
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-        }     // if E2 is on (n2, B1) or (n2, B2)
-        else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-        {
-          const int D1 = endpt1;
-          const int D2 = endpt2;
-          const int edge_D1D2 = corr_edge_[E2y][E2x];
-
-          // update route for edge (n2, D1), (n2, D2) and (B1, B2)
-          bool route_ok = updateRouteType2(netID,
-                                           treenodes.get(),
-                                           n2,
-                                           B1,
-                                           B2,
-                                           D1,
-                                           D2,
-                                           E2x,
-                                           E2y,
-                                           treeedges.get(),
-                                           edge_n2B1,
-                                           edge_n2B2,
-                                           edge_D1D2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            153,
-                            "Net {} has errors during updateRouteType2.",
-                            nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        }
+        // B2's nbr n2->B1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B2].nbr[i] == n2) {
+            treenodes[B2].nbr[i] = B1;
+            treenodes[B2].edge[i] = edge_B1B2;
             break;
           }
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-          // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
-          // D2)->(B1, B2)
-          const int edge_n2D1 = edge_n2B1;
-          treeedges[edge_n2D1].n1 = D1;
-          treeedges[edge_n2D1].n2 = n2;
-          const int edge_n2D2 = edge_n2B2;
-          treeedges[edge_n2D2].n1 = n2;
-          treeedges[edge_n2D2].n2 = D2;
-          const int edge_B1B2 = edge_D1D2;
-          treeedges[edge_B1B2].n1 = B1;
-          treeedges[edge_B1B2].n2 = B2;
-          // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
-          // n1's nbr (n1, B1, B2)->(n1, D1, D2)
-          treenodes[n2].nbr[0] = n1;
-          treenodes[n2].edge[0] = edge_n1n2;
-          treenodes[n2].nbr[1] = D1;
-          treenodes[n2].edge[1] = edge_n2D1;
-          treenodes[n2].nbr[2] = D2;
-          treenodes[n2].edge[2] = edge_n2D2;
-          // B1's nbr n2->B2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B1].nbr[i] == n2) {
-              treenodes[B1].nbr[i] = B2;
-              treenodes[B1].edge[i] = edge_B1B2;
-              break;
-            }
-          }
-          // B2's nbr n2->B1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B2].nbr[i] == n2) {
-              treenodes[B2].nbr[i] = B1;
-              treenodes[B2].edge[i] = edge_B1B2;
-              break;
-            }
-          }
-          // D1's nbr D2->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D1].nbr[i] == D2) {
-              treenodes[D1].nbr[i] = n2;
-              treenodes[D1].edge[i] = edge_n2D1;
-              break;
-            }
+        }
+        // D1's nbr D2->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D1].nbr[i] == D2) {
+            treenodes[D1].nbr[i] = n2;
+            treenodes[D1].edge[i] = edge_n2D1;
+            break;
           }
-          // D2's nbr D1->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D2].nbr[i] == D1) {
-              treenodes[D2].nbr[i] = n2;
-              treenodes[D2].edge[i] = edge_n2D2;
-              break;
-            }
+        }
+        // D2's nbr D1->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D2].nbr[i] == D1) {
+            treenodes[D2].nbr[i] = n2;
+            treenodes[D2].edge[i] = edge_n2D2;
+            break;
           }
-        }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-      }    // n2 is not a pin and E2!=n2
+        }
+      }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+    }    // n2 is not a pin and E2!=n2
 
-      // update route for edge (n1, n2) and edge usage
-      if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
-        treeedges[edge_n1n2].route.gridsX.clear();
-        treeedges[edge_n1n2].route.gridsY.clear();
-      }
-      treeedges[edge_n1n2].route.gridsX.resize(cnt_n1n2, 0);
-      treeedges[edge_n1n2].route.gridsY.resize(cnt_n1n2, 0);
-      treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
-      treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
-      treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
-
-      for (int i = 0; i < cnt_n1n2; i++) {
-        treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
-        treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
+    // update route for edge (n1, n2) and edge usage
+    if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
+      treeedges[edge_n1n2].route.gridsX.clear();
+      treeedges[edge_n1n2].route.gridsY.clear();
+    }
+    treeedges[edge_n1n2].route.gridsX.resize(cnt_n1n2, 0);
+    treeedges[edge_n1n2].route.gridsY.resize(cnt_n1n2, 0);
+    treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
+    treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
+    treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
+
+    for (int i = 0; i < cnt_n1n2; i++) {
+      treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
+      treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
+    }
+
+    int edgeCost = nets_[netID]->getEdgeCost();
+
+    // update edge usage
+    for (int i = 0; i < cnt_n1n2 - 1; i++) {
+      if (gridsX[i] == gridsX[i + 1])  // a vertical edge
+      {
+        const int min_y = std::min(gridsY[i], gridsY[i + 1]);
+        v_edges_[min_y][gridsX[i]].usage += edgeCost;
+        ws.v_used.emplace_back(min_y, gridsX[i]);
+      } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
+      {
+        const int min_x = std::min(gridsX[i], gridsX[i + 1]);
+        h_edges_[gridsY[i]][min_x].usage += edgeCost;
+        ws.h_used.emplace_back(gridsY[i], min_x);
       }
+    }
+  }  // loop edgeID
 
-      int edgeCost = nets_[netID]->getEdgeCost();
+  return true;
+}
 
-      // update edge usage
-      for (int i = 0; i < cnt_n1n2 - 1; i++) {
-        if (gridsX[i] == gridsX[i + 1])  // a vertical edge
-        {
-          const int min_y = std::min(gridsY[i], gridsY[i + 1]);
-          v_edges_[min_y][gridsX[i]].usage += edgeCost;
-          v_used_ggrid_.insert(std::make_pair(min_y, gridsX[i]));
-        } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
-        {
-          const int min_x = std::min(gridsX[i], gridsX[i + 1]);
-          h_edges_[gridsY[i]][min_x].usage += edgeCost;
-          h_used_ggrid_.insert(std::make_pair(gridsY[i], min_x));
+// Computes the gcells a maze pass over the net may touch: the tree with its
+// current routes, enlarged by the largest search region enlargement of its
+// edges. Returns false when no edge is long enough to be maze routed.
+bool FastRouteCore::mazeNetBounds(const int netID,
+                                  const MazeRouteSettings& settings,
+                                  odb::Rect& bounds)
+{
+  const auto& treeedges = sttrees_[netID].edges;
+  const auto& treenodes = sttrees_[netID].nodes;
+
+  int enlarge = -1;
+  const int num_edges = sttrees_[netID].num_edges();
+  for (int edgeID = 0; edgeID < num_edges; edgeID++) {
+    const TreeEdge& treeedge = treeedges[edgeID];
+    const TreeNode& node1 = treenodes[treeedge.n1];
+    const TreeNode& node2 = treenodes[treeedge.n2];
+    const int len = abs(node2.x - node1.x) + abs(node2.y - node1.y);
+    if (len > settings.maze_edge_threshold) {
+      const int edge_enlarge
+          = std::min(settings.expand,
+                     (settings.iter / 6 + 3) * treeedge.route.routelen);
+      enlarge = std::max(enlarge, edge_enlarge);
+    }
+  }
+  if (enlarge < 0) {
+    return false;
+  }
+
+  int x_min = x_grid_ - 1;
+  int y_min = y_grid_ - 1;
+  int x_max = 0;
+  int y_max = 0;
+  for (int nodeID = 0; nodeID < sttrees_[netID].num_nodes; nodeID++) {
+    x_min = std::min(x_min, (int) treenodes[nodeID].x);
+    y_min = std::min(y_min, (int) treenodes[nodeID].y);
+    x_max = std::max(x_max, (int) treenodes[nodeID].x);
+    y_max = std::max(y_max, (int) treenodes[nodeID].y);
+  }
+  for (int edgeID = 0; edgeID < num_edges; edgeID++) {
+    const Route& route = treeedges[edgeID].route;
+    if (route.type != RouteType::MazeRoute) {
+      continue;
+    }
+    const int grid_cnt = route.gridsX.size();
+    for (int i = 0; i < grid_cnt; i++) {
+      x_min = std::min(x_min, (int) route.gridsX[i]);
+      y_min = std::min(y_min, (int) route.gridsY[i]);
+      x_max = std::max(x_max, (int) route.gridsX[i]);
+      y_max = std::max(y_max, (int) route.gridsY[i]);
+    }
+  }
+
+  bounds.init(std::max(x_min - enlarge, 0),
+              std::max(y_min - enlarge, 0),
+              std::min(x_max + enlarge, x_grid_ - 1),
+              std::min(y_max + enlarge, y_grid_ - 1));
+  return true;
+}
+
+// Computes the gcells holding the nodes and the routes of the net, enlarged
+// by margin. Returns false when the net has no routed edge.
+bool FastRouteCore::netRouteBounds(const int netID,
+                                   const int margin,
+                                   odb::Rect& bounds)
+{
+  const auto& treeedges = sttrees_[netID].edges;
+  const auto& treenodes = sttrees_[netID].nodes;
+
+  bounds.mergeInit();
+  bool routed = false;
+  for (int edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
+    const TreeEdge& treeedge = treeedges[edgeID];
+    if (treeedge.len <= 0) {
+      continue;
+    }
+    routed = true;
+    const TreeNode& node1 = treenodes[treeedge.n1];
+    const TreeNode& node2 = treenodes[treeedge.n2];
+    bounds.merge(odb::Rect(node1.x, node1.y, node1.x, node1.y));
+    bounds.merge(odb::Rect(node2.x, node2.y, node2.x, node2.y));
+    const Route& route = treeedge.route;
+    const int grid_cnt = std::min(route.gridsX.size(), route.gridsY.size());
+    for (int i = 0; i < grid_cnt; i++) {
+      const int x = route.gridsX[i];
+      const int y = route.gridsY[i];
+      bounds.merge(odb::Rect(x, y, x, y));
+    }
+  }
+  if (!routed) {
+    return false;
+  }
+
+  bounds.init(std::max(bounds.xMin() - margin, 0),
+              std::max(bounds.yMin() - margin, 0),
+              std::min(bounds.xMax() + margin, x_grid_ - 1),
+              std::min(bounds.yMax() + margin, y_grid_ - 1));
+  return true;
+}
+
+// Splits the nets into batches whose bounds don't overlap. A net joins the
+// batch following the last one holding an earlier net it overlaps, so the
+// order between overlapping nets is kept and the nets of a batch can be
+// processed concurrently without depending on the number of threads. Nets
+// with inverted bounds touch no edge usage and go in the first batch.
+std::vector<std::vector<int>> FastRouteCore::netBatches(
+    const std::vector<odb::Rect>& bounds)
+{
+  // coarse grid with the last batch touching each tile
+  const int tile_size = 4;
+  const int tiles_x = (x_grid_ + tile_size - 1) / tile_size;
+  const int tiles_y = (y_grid_ + tile_size - 1) / tile_size;
+  std::vector<int> tile_batch(tiles_x * tiles_y, -1);
+
+  std::vector<std::vector<int>> batches;
+  for (int i = 0; i < (int) bounds.size(); i++) {
+    int batch = 0;
+    if (!bounds[i].isInverted()) {
+      const int tx1 = bounds[i].xMin() / tile_size;
+      const int tx2 = bounds[i].xMax() / tile_size;
+      const int ty1 = bounds[i].yMin() / tile_size;
+      const int ty2 = bounds[i].yMax() / tile_size;
+      for (int ty = ty1; ty <= ty2; ty++) {
+        for (int tx = tx1; tx <= tx2; tx++) {
+          batch = std::max(batch, tile_batch[ty * tiles_x + tx] + 1);
+        }
+      }
+      for (int ty = ty1; ty <= ty2; ty++) {
+        for (int tx = tx1; tx <= tx2; tx++) {
+          tile_batch[ty * tiles_x + tx] = batch;
         }
       }
-    }  // loop edgeID
-  }    // loop netID
+    }
+    if (batch >= (int) batches.size()) {
+      batches.resize(batch + 1);
+    }
+    batches[batch].push_back(i);
+  }
+  return batches;
+}
 
-  h_cost_table_.clear();
-  v_cost_table_.clear();
+// Maze routes the nets in batches whose bounds don't overlap, routing the
+// nets of a batch concurrently.
+void FastRouteCore::mazeRouteBatches(const std::vector<int>& net_ids,
+                                     const MazeRouteSettings& settings,
+                                     std::vector<MazeWorkspace>& workspaces)
+{
+  const int net_cnt = net_ids.size();
+  std::vector<odb::Rect> bounds(net_cnt);
+  for (int i = 0; i < net_cnt; i++) {
+    // nets without long edges touch no edge usage
+    if (!mazeNetBounds(net_ids[i], settings, bounds[i])) {
+      bounds[i].mergeInit();
+    }
+  }
+  const std::vector<std::vector<int>> batches = netBatches(bounds);
+
+  debugPrint(logger_,
+             GRT,
+             "mazeRouting",
+             1,
+             "Maze routing {} nets in {} batches.",
+             net_cnt,
+             batches.size());
+
+  std::vector<int> last_enlarge(net_cnt, -1);
+  for (const std::vector<int>& batch : batches) {
+    const int batch_size = batch.size();
+    std::vector<char> routed(batch_size, true);
+    utl::ThreadException exception;
+#pragma omp parallel for num_threads(workspaces.size()) schedule(dynamic)
+    for (int i = 0; i < batch_size; i++) {
+      try {
+        const int net = batch[i];
+        routed[i] = mazeRouteNet(net_ids[net],
+                                 settings,
+                                 bounds[net],
+                                 workspaces[omp_get_thread_num()],
+                                 last_enlarge[net]);
+      } catch (...) {
+        exception.capture();
+      }
+    }
+    exception.rethrow();
+
+    // nets left with a broken tree are rebuilt and routed again in order
+    for (int i = 0; i < batch_size; i++) {
+      const int net = batch[i];
+      while (!routed[i]) {
+        reInitTree(net_ids[net]);
+        routed[i] = mazeRouteNet(net_ids[net],
+                                 settings,
+                                 bounds[net],
+                                 workspaces[0],
+                                 last_enlarge[net]);
+      }
+    }
+
+    for (MazeWorkspace& ws : workspaces) {
+      mergeMazeUsage(ws);
+    }
+  }
+
+  for (int i = 0; i < net_cnt; i++) {
+    if (last_enlarge[i] >= 0) {
+      enlarge_ = last_enlarge[i];
+    }
+  }
+}
+
+void FastRouteCore::mergeMazeUsage(MazeWorkspace& ws)
+{
+  h_used_ggrid_.insert(ws.h_used.begin(), ws.h_used.end());
+  v_used_ggrid_.insert(ws.v_used.begin(), ws.v_used.end());
+  ws.h_used.clear();
+  ws.v_used.clear();
 }
 
 void FastRouteCore::findCongestedEdgesNets(
@@ -30,22 +30,19 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <omp.h>
+
 #include <algorithm>
 
 #include "DataType.h"
 #include "FastRoute.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace grt {
 
 using utl::GRT;
 
-struct parent3D
-{
-  short l;
-  int x, y;
-};
-
 static int parent_index(int i)
 {
   return (i - 1) / 2;
@@ -116,14 +113,10 @@ void FastRouteCore::setupHeap3D(int netID,
                                 int edgeID,
                                 std::vector<int*>& src_heap_3D,
                                 std::vector<int*>& dest_heap_3D,
-                                multi_array<Direction, 3>& directions_3D,
-                                multi_array<int, 3>& corr_edge_3D,
-                                multi_array<int, 3>& d1_3D,
-                                multi_array<int, 3>& d2_3D,
-                                int regionX1,
-                                int regionX2,
-                                int regionY1,
-                                int regionY2)
+                                LayeredGridWindow<Direction>& directions_3D,
+                                LayeredGridWindow<int>& corr_edge_3D,
+                                LayeredGridWindow<int>& d1_3D,
+                                LayeredGridWindow<int>& d2_3D)
 {
   const auto& treeedges = sttrees_[netID].edges;
   const auto& treenodes = sttrees_[netID].nodes;
@@ -148,12 +141,6 @@ void FastRouteCore::setupHeap3D(int netID,
     directions_3D[0][y2][x2] = Direction::Origin;
     dest_heap_3D.push_back(&d2_3D[0][y2][x2]);
   } else {  // net with more than 2 pins
-    for (int i = regionY1; i <= regionY2; i++) {
-      for (int j = regionX1; j <= regionX2; j++) {
-        in_region_[i][j] = true;
-      }
-    }
-
     const int numNodes = sttrees_[netID].num_nodes;
     std::vector<bool> heapVisited(numNodes, false);
     std::vector<int> heapQueue(numNodes);
@@ -211,7 +198,7 @@ void FastRouteCore::setupHeap3D(int netID,
           if (treeedges[edge].route.routelen > 0) {
             // not a degraded edge
             // put nbr into src_heap_3D if in enlarged region
-            if (in_region_[treenodes[nbr].y][treenodes[nbr].x]) {
+            if (d1_3D.contains(treenodes[nbr].x, treenodes[nbr].y)) {
               const int nbrX = treenodes[nbr].x;
               const int nbrY = treenodes[nbr].y;
               nt = treenodes[nbr].stackAlias;
@@ -233,7 +220,7 @@ void FastRouteCore::setupHeap3D(int netID,
                 const int y_grid = route->gridsY[j];
                 const int l_grid = route->gridsL[j];
 
-                if (in_region_[y_grid][x_grid]) {
+                if (d1_3D.contains(x_grid, y_grid)) {
                   d1_3D[l_grid][y_grid][x_grid] = 0;
                   src_heap_3D.push_back(&d1_3D[l_grid][y_grid][x_grid]);
                   directions_3D[l_grid][y_grid][x_grid] = Direction::Origin;
@@ -306,7 +293,7 @@ void FastRouteCore::setupHeap3D(int netID,
           if (treeedges[edge].route.routelen > 0) {
             // not a degraded edge
             // put nbr into dest_heap_3D
-            if (in_region_[treenodes[nbr].y][treenodes[nbr].x]) {
+            if (d1_3D.contains(treenodes[nbr].x, treenodes[nbr].y)) {
               const int nbrX = treenodes[nbr].x;
               const int nbrY = treenodes[nbr].y;
               const int nt = treenodes[nbr].stackAlias;
@@ -330,7 +317,7 @@ void FastRouteCore::setupHeap3D(int netID,
                 const int x_grid = route->gridsX[j];
                 const int y_grid = route->gridsY[j];
                 const int l_grid = route->gridsL[j];
-                if (in_region_[y_grid][x_grid]) {
+                if (d1_3D.contains(x_grid, y_grid)) {
                   d2_3D[l_grid][y_grid][x_grid] = 0;
                   directions_3D[l_grid][y_grid][x_grid] = Direction::Origin;
                   dest_heap_3D.push_back(&d2_3D[l_grid][y_grid][x_grid]);
@@ -348,13 +335,7 @@ void FastRouteCore::setupHeap3D(int netID,
         }  // loop i (3 neigbors for cur node)
       }    // while heapQueue is not empty
     }      // else n2 is not a Pin node
-
-    for (int i = regionY1; i <= regionY2; i++) {
-      for (int j = regionX1; j <= regionX2; j++) {
-        in_region_[i][j] = false;
-      }
-    }
-  }  // net with more than two pins
+  }        // net with more than two pins
 }
 
 void FastRouteCore::newUpdateNodeLayers(TreeNode* treenodes,
@@ -848,866 +829,925 @@ void FastRouteCore::updateRouteType23D(int netID,
   }
 }
 
+void FastRouteCore::mergeMaze3DUsage(Maze3DWorkspace& ws)
+{
+  h_used_ggrid_.insert(ws.h_used.begin(), ws.h_used.end());
+  v_used_ggrid_.insert(ws.v_used.begin(), ws.v_used.end());
+  ws.h_used.clear();
+  ws.v_used.clear();
+}
+
 void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                                          int ripupTHlb,
                                          int ripupTHub,
                                          int layerOrientation)
 {
-  static multi_array<Direction, 3> directions_3D(
-      boost::extents[num_layers_][y_grid_][x_grid_]);
-  static multi_array<int, 3> corr_edge_3D(
-      boost::extents[num_layers_][y_grid_][x_grid_]);
-  static multi_array<parent3D, 3> pr_3D_(
-      boost::extents[num_layers_][y_grid_][x_grid_]);
-
-  int64 total_size = static_cast<int64>(num_layers_) * y_range_ * x_range_;
-  static std::vector<bool> pop_heap2_3D(total_size, false);
-
-  // allocate memory for priority queue
-  total_size = static_cast<int64>(y_grid_) * x_grid_ * num_layers_;
-  static std::vector<int*> src_heap_3D(total_size);
-  static std::vector<int*> dest_heap_3D(total_size);
-
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_; j++) {
-      in_region_[i][j] = false;
-    }
-  }
-
   const int endIND = tree_order_pv_.size() * 0.9;
 
-  static multi_array<int, 3> d1_3D(
-      boost::extents[num_layers_][y_range_][x_range_]);
-  static multi_array<int, 3> d2_3D(
-      boost::extents[num_layers_][y_range_][x_range_]);
-
+  std::vector<int> net_ids;
   for (int orderIndex = 0; orderIndex < endIND; orderIndex++) {
     const int netID = tree_order_pv_[orderIndex].treeIndex;
-    FrNet* net = nets_[netID];
+    if (!nets_[netID]->isRouted()) {
+      net_ids.push_back(netID);
+    }
+  }
 
-    if (net->isRouted())
-      continue;
+  if (maze_threads_ <= 0) {
+    Maze3DWorkspace ws;
+    ws.xcor.resize(xcor_.size());
+    ws.ycor.resize(ycor_.size());
+    ws.dcor.resize(dcor_.size());
+    const odb::Rect grid(0, 0, x_grid_ - 1, y_grid_ - 1);
+    for (const int netID : net_ids) {
+      mazeRouteNet3D(
+          netID, expand, ripupTHlb, ripupTHub, layerOrientation, grid, ws);
+      mergeMaze3DUsage(ws);
+    }
+    return;
+  }
 
-    int enlarge = expand;
-    const int num_terminals = sttrees_[netID].num_terminals;
-    const auto& treeedges = sttrees_[netID].edges;
-    const auto& treenodes = sttrees_[netID].nodes;
-    const int origEng = enlarge;
+  // Nets whose routes and search regions do not overlap touch disjoint
+  // edges, so each batch can be rerouted concurrently.  The search regions
+  // are clamped to the net bounds to keep that guarantee.
+  std::vector<odb::Rect> bounds(net_ids.size());
+  for (int i = 0; i < (int) net_ids.size(); i++) {
+    if (!netRouteBounds(net_ids[i], expand, bounds[i])) {
+      bounds[i].mergeInit();
+    }
+  }
 
-    for (int edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
-      TreeEdge* treeedge = &(treeedges[edgeID]);
+  std::vector<Maze3DWorkspace> workspaces(maze_threads_);
+  for (Maze3DWorkspace& ws : workspaces) {
+    ws.xcor.resize(xcor_.size());
+    ws.ycor.resize(ycor_.size());
+    ws.dcor.resize(dcor_.size());
+  }
 
-      if (treeedge->len >= ripupTHub || treeedge->len <= ripupTHlb) {
-        continue;
-      }
-      int n1 = treeedge->n1;
-      int n2 = treeedge->n2;
-      const int n1x = treenodes[n1].x;
-      const int n1y = treenodes[n1].y;
-      const int n2x = treenodes[n2].x;
-      const int n2y = treenodes[n2].y;
-      int routeLen = treeedges[edgeID].route.routelen;
-
-      const int ymin = std::min(n1y, n2y);
-      const int ymax = std::max(n1y, n2y);
-
-      const int xmin = std::min(n1x, n2x);
-      const int xmax = std::max(n1x, n2x);
-
-      // ripup the routing for the edge
-      if (!newRipup3DType3(netID, edgeID)) {
-        continue;
+  for (const std::vector<int>& batch : netBatches(bounds)) {
+    utl::ThreadException exception;
+#pragma omp parallel for num_threads(maze_threads_) schedule(dynamic)
+    for (int i = 0; i < (int) batch.size(); i++) {
+      try {
+        const int idx = batch[i];
+        mazeRouteNet3D(net_ids[idx],
+                       expand,
+                       ripupTHlb,
+                       ripupTHub,
+                       layerOrientation,
+                       bounds[idx],
+                       workspaces[omp_get_thread_num()]);
+      } catch (...) {
+        exception.capture();
       }
-      enlarge = std::min(origEng, treeedge->route.routelen);
-
-      const int regionX1 = std::max(0, xmin - enlarge);
-      const int regionX2 = std::min(x_grid_ - 1, xmax + enlarge);
-      const int regionY1 = std::max(0, ymin - enlarge);
-      const int regionY2 = std::min(y_grid_ - 1, ymax + enlarge);
-
-      bool n1Shift = false;
-      bool n2Shift = false;
-      int n1a = treeedge->n1a;
-      int n2a = treeedge->n2a;
-
-      // initialize pop_src_heap_3D_[] and pop_heap2_3D[] as false (for
-      // detecting the shortest path is found or not)
-
-      for (int k = 0; k < num_layers_; k++) {
-        for (int i = regionY1; i <= regionY2; i++) {
-          for (int j = regionX1; j <= regionX2; j++) {
-            d1_3D[k][i][j] = BIG_INT;
-            d2_3D[k][i][j] = BIG_INT;
-          }
+    }
+    exception.rethrow();
+    for (Maze3DWorkspace& ws : workspaces) {
+      mergeMaze3DUsage(ws);
+    }
+  }
+}
+
+void FastRouteCore::mazeRouteNet3D(const int netID,
+                                   const int expand,
+                                   const int ripupTHlb,
+                                   const int ripupTHub,
+                                   const int layerOrientation,
+                                   const odb::Rect& bounds,
+                                   Maze3DWorkspace& ws)
+{
+  // scratch grids covering the search region of the edge being routed
+  auto& directions_3D = ws.directions;
+  auto& corr_edge_3D = ws.corr_edge;
+  auto& pr_3D_ = ws.parents;
+  auto& d1_3D = ws.d1;
+  auto& d2_3D = ws.d2;
+  auto& pop_heap2_3D = ws.pop_heap2;
+  auto& src_heap_3D = ws.src_heap;
+  auto& dest_heap_3D = ws.dest_heap;
+
+  FrNet* net = nets_[netID];
+
+  int enlarge = expand;
+  const int num_terminals = sttrees_[netID].num_terminals;
+  const auto& treeedges = sttrees_[netID].edges;
+  const auto& treenodes = sttrees_[netID].nodes;
+  const int origEng = enlarge;
+
+  for (int edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
+    TreeEdge* treeedge = &(treeedges[edgeID]);
+
+    if (treeedge->len >= ripupTHub || treeedge->len <= ripupTHlb) {
+      continue;
+    }
+    int n1 = treeedge->n1;
+    int n2 = treeedge->n2;
+    const int n1x = treenodes[n1].x;
+    const int n1y = treenodes[n1].y;
+    const int n2x = treenodes[n2].x;
+    const int n2y = treenodes[n2].y;
+    int routeLen = treeedges[edgeID].route.routelen;
+
+    const int ymin = std::min(n1y, n2y);
+    const int ymax = std::max(n1y, n2y);
+
+    const int xmin = std::min(n1x, n2x);
+    const int xmax = std::max(n1x, n2x);
+
+    // ripup the routing for the edge
+    if (!newRipup3DType3(netID, edgeID)) {
+      continue;
+    }
+    enlarge = std::min(origEng, treeedge->route.routelen);
+
+    const int regionX1 = std::max(bounds.xMin(), xmin - enlarge);
+    const int regionX2 = std::min(bounds.xMax(), xmax + enlarge);
+    const int regionY1 = std::max(bounds.yMin(), ymin - enlarge);
+    const int regionY2 = std::min(bounds.yMax(), ymax + enlarge);
+
+    bool n1Shift = false;
+    bool n2Shift = false;
+    int n1a = treeedge->n1a;
+    int n2a = treeedge->n2a;
+
+    directions_3D.reset(num_layers_, regionX1, regionY1, regionX2, regionY2);
+    corr_edge_3D.reset(num_layers_, regionX1, regionY1, regionX2, regionY2);
+    pr_3D_.reset(num_layers_, regionX1, regionY1, regionX2, regionY2);
+    d1_3D.reset(num_layers_, regionX1, regionY1, regionX2, regionY2);
+    d2_3D.reset(num_layers_, regionX1, regionY1, regionX2, regionY2);
+    // pop_heap2_3D[] entries are cleared after every search (for
+    // detecting the shortest path is found or not), new ones start as false
+    pop_heap2_3D.resize(d2_3D.size(), false);
+
+    for (int k = 0; k < num_layers_; k++) {
+      for (int i = regionY1; i <= regionY2; i++) {
+        for (int j = regionX1; j <= regionX2; j++) {
+          d1_3D[k][i][j] = BIG_INT;
+          d2_3D[k][i][j] = BIG_INT;
         }
       }
+    }
 
-      // setup src_heap_3D, dest_heap_3D and initialize d1_3D[][] and
-      // d2_3D[][] for all the grids on the two subtrees
-      setupHeap3D(netID,
-                  edgeID,
-                  src_heap_3D,
-                  dest_heap_3D,
-                  directions_3D,
-                  corr_edge_3D,
-                  d1_3D,
-                  d2_3D,
-                  regionX1,
-                  regionX2,
-                  regionY1,
-                  regionY2);
-
-      // while loop to find shortest path
-      int ind1 = (src_heap_3D[0] - &d1_3D[0][0][0]);
-
-      for (int i = 0; i < dest_heap_3D.size(); i++)
-        pop_heap2_3D[dest_heap_3D[i] - &d2_3D[0][0][0]] = true;
-
-      while (pop_heap2_3D[ind1]
-             == false)  // stop until the grid position been popped out from
-                        // both src_heap_3D and dest_heap_3D
-      {
-        // relax all the adjacent grids within the enlarged region for
-        // source subtree
-        const int curL = ind1 / (grid_hv_);
-        const int remd = ind1 % (grid_hv_);
-        const int curX = remd % x_range_;
-        const int curY = remd / x_range_;
-        removeMin3D(src_heap_3D);
-
-        const bool Horizontal = (((curL % 2) - layerOrientation) == 0);
-
-        if (Horizontal) {
-          // left
-          if (curX > regionX1
-              && directions_3D[curL][curY][curX] != Direction::East) {
-            const float tmp = d1_3D[curL][curY][curX] + 1;
-            if (h_edges_3D_[curL][curY][curX - 1].usage
-                    < h_edges_3D_[curL][curY][curX - 1].cap
-                && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
-              const int tmpX = curX - 1;  // the left neighbor
-
-              if (d1_3D[curL][curY][tmpX] >= BIG_INT)  // left neighbor not been
-                                                       // put into src_heap_3D
-              {
-                d1_3D[curL][curY][tmpX] = tmp;
-                pr_3D_[curL][curY][tmpX].l = curL;
-                pr_3D_[curL][curY][tmpX].x = curX;
-                pr_3D_[curL][curY][tmpX].y = curY;
-                directions_3D[curL][curY][tmpX] = Direction::West;
-                src_heap_3D.push_back(&d1_3D[curL][curY][tmpX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-              } else if (d1_3D[curL][curY][tmpX]
-                         > tmp)  // left neighbor been put into src_heap_3D
-                                 // but needs update
-              {
-                d1_3D[curL][curY][tmpX] = tmp;
-                pr_3D_[curL][curY][tmpX].l = curL;
-                pr_3D_[curL][curY][tmpX].x = curX;
-                pr_3D_[curL][curY][tmpX].y = curY;
-                directions_3D[curL][curY][tmpX] = Direction::West;
-                const int* dtmp = &d1_3D[curL][curY][tmpX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
-              }
+    // setup src_heap_3D, dest_heap_3D and initialize d1_3D[][] and
+    // d2_3D[][] for all the grids on the two subtrees
+    setupHeap3D(netID,
+                edgeID,
+                src_heap_3D,
+                dest_heap_3D,
+                directions_3D,
+                corr_edge_3D,
+                d1_3D,
+                d2_3D);
+
+    // while loop to find shortest path
+    int ind1 = (src_heap_3D[0] - d1_3D.data());
+
+    for (int i = 0; i < dest_heap_3D.size(); i++)
+      pop_heap2_3D[dest_heap_3D[i] - d2_3D.data()] = true;
+
+    while (pop_heap2_3D[ind1]
+           == false)  // stop until the grid position been popped out from
+                      // both src_heap_3D and dest_heap_3D
+    {
+      // relax all the adjacent grids within the enlarged region for
+      // source subtree
+      const int curL = d1_3D.layerOf(ind1);
+      const int curX = d1_3D.xOf(ind1);
+      const int curY = d1_3D.yOf(ind1);
+      removeMin3D(src_heap_3D);
+
+      const bool Horizontal = (((curL % 2) - layerOrientation) == 0);
+
+      if (Horizontal) {
+        // left
+        if (curX > regionX1
+            && directions_3D[curL][curY][curX] != Direction::East) {
+          const float tmp = d1_3D[curL][curY][curX] + 1;
+          if (h_edges_3D_[curL][curY][curX - 1].usage
+                  < h_edges_3D_[curL][curY][curX - 1].cap
+              && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
+            const int tmpX = curX - 1;  // the left neighbor
+
+            if (d1_3D[curL][curY][tmpX] >= BIG_INT)  // left neighbor not been
+                                                     // put into src_heap_3D
+            {
+              d1_3D[curL][curY][tmpX] = tmp;
+              pr_3D_[curL][curY][tmpX].l = curL;
+              pr_3D_[curL][curY][tmpX].x = curX;
+              pr_3D_[curL][curY][tmpX].y = curY;
+              directions_3D[curL][curY][tmpX] = Direction::West;
+              src_heap_3D.push_back(&d1_3D[curL][curY][tmpX]);
+              updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+            } else if (d1_3D[curL][curY][tmpX]
+                       > tmp)  // left neighbor been put into src_heap_3D
+                               // but needs update
+            {
+              d1_3D[curL][curY][tmpX] = tmp;
+              pr_3D_[curL][curY][tmpX].l = curL;
+              pr_3D_[curL][curY][tmpX].x = curX;
+              pr_3D_[curL][curY][tmpX].y = curY;
+              directions_3D[curL][curY][tmpX] = Direction::West;
+              const int* dtmp = &d1_3D[curL][curY][tmpX];
+              int ind = 0;
+              while (src_heap_3D[ind] != dtmp)
+                ind++;
+              updateHeap3D(src_heap_3D, ind);
             }
           }
-          // right
-          if (Horizontal && curX < regionX2
-              && directions_3D[curL][curY][curX] != Direction::West) {
-            const float tmp = d1_3D[curL][curY][curX] + 1;
-            const int tmpX = curX + 1;  // the right neighbor
-
-            if (h_edges_3D_[curL][curY][curX].usage
-                    < h_edges_3D_[curL][curY][curX].cap
-                && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
-              if (d1_3D[curL][curY][tmpX]
-                  >= BIG_INT)  // right neighbor not been put into
-                               // src_heap_3D
-              {
-                d1_3D[curL][curY][tmpX] = tmp;
-                pr_3D_[curL][curY][tmpX].l = curL;
-                pr_3D_[curL][curY][tmpX].x = curX;
-                pr_3D_[curL][curY][tmpX].y = curY;
-                directions_3D[curL][curY][tmpX] = Direction::East;
-                src_heap_3D.push_back(&d1_3D[curL][curY][tmpX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-              } else if (d1_3D[curL][curY][tmpX]
-                         > tmp)  // right neighbor been put into src_heap_3D
-                                 // but needs update
-              {
-                d1_3D[curL][curY][tmpX] = tmp;
-                pr_3D_[curL][curY][tmpX].l = curL;
-                pr_3D_[curL][curY][tmpX].x = curX;
-                pr_3D_[curL][curY][tmpX].y = curY;
-                directions_3D[curL][curY][tmpX] = Direction::East;
-                const int* dtmp = &d1_3D[curL][curY][tmpX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
-              }
+        }
+        // right
+        if (Horizontal && curX < regionX2
+            && directions_3D[curL][curY][curX] != Direction::West) {
+          const float tmp = d1_3D[curL][curY][curX] + 1;
+          const int tmpX = curX + 1;  // the right neighbor
+
+          if (h_edges_3D_[curL][curY][curX].usage
+                  < h_edges_3D_[curL][curY][curX].cap
+              && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
+            if (d1_3D[curL][curY][tmpX]
+                >= BIG_INT)  // right neighbor not been put into
+                             // src_heap_3D
+            {
+              d1_3D[curL][curY][tmpX] = tmp;
+              pr_3D_[curL][curY][tmpX].l = curL;
+              pr_3D_[curL][curY][tmpX].x = curX;
+              pr_3D_[curL][curY][tmpX].y = curY;
+              directions_3D[curL][curY][tmpX] = Direction::East;
+              src_heap_3D.push_back(&d1_3D[curL][curY][tmpX]);
+              updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+            } else if (d1_3D[curL][curY][tmpX]
+                       > tmp)  // right neighbor been put into src_heap_3D
+                               // but needs update
+            {
+              d1_3D[curL][curY][tmpX] = tmp;
+              pr_3D_[curL][curY][tmpX].l = curL;
+              pr_3D_[curL][curY][tmpX].x = curX;
+              pr_3D_[curL][curY][tmpX].y = curY;
+              directions_3D[curL][curY][tmpX] = Direction::East;
+              const int* dtmp = &d1_3D[curL][curY][tmpX];
+              int ind = 0;
+              while (src_heap_3D[ind] != dtmp)
+                ind++;
+              updateHeap3D(src_heap_3D, ind);
             }
           }
-        } else {
-          // bottom
-          if (!Horizontal && curY > regionY1
-              && directions_3D[curL][curY][curX] != Direction::South) {
-            const float tmp = d1_3D[curL][curY][curX] + 1;
-            const int tmpY = curY - 1;  // the bottom neighbor
-            if (v_edges_3D_[curL][curY - 1][curX].usage
-                    < v_edges_3D_[curL][curY - 1][curX].cap
-                && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
-              if (d1_3D[curL][tmpY][curX]
-                  >= BIG_INT)  // bottom neighbor not been put into
-                               // src_heap_3D
-              {
-                d1_3D[curL][tmpY][curX] = tmp;
-                pr_3D_[curL][tmpY][curX].l = curL;
-                pr_3D_[curL][tmpY][curX].x = curX;
-                pr_3D_[curL][tmpY][curX].y = curY;
-                directions_3D[curL][tmpY][curX] = Direction::North;
-                src_heap_3D.push_back(&d1_3D[curL][tmpY][curX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-              } else if (d1_3D[curL][tmpY][curX]
-                         > tmp)  // bottom neighbor been put into
-                                 // src_heap_3D but needs update
-              {
-                d1_3D[curL][tmpY][curX] = tmp;
-                pr_3D_[curL][tmpY][curX].l = curL;
-                pr_3D_[curL][tmpY][curX].x = curX;
-                pr_3D_[curL][tmpY][curX].y = curY;
-                directions_3D[curL][tmpY][curX] = Direction::North;
-                const int* dtmp = &d1_3D[curL][tmpY][curX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
-              }
+        }
+      } else {
+        // bottom
+        if (!Horizontal && curY > regionY1
+            && directions_3D[curL][curY][curX] != Direction::South) {
+          const float tmp = d1_3D[curL][curY][curX] + 1;
+          const int tmpY = curY - 1;  // the bottom neighbor
+          if (v_edges_3D_[curL][curY - 1][curX].usage
+                  < v_edges_3D_[curL][curY - 1][curX].cap
+              && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
+            if (d1_3D[curL][tmpY][curX]
+                >= BIG_INT)  // bottom neighbor not been put into
+                             // src_heap_3D
+            {
+              d1_3D[curL][tmpY][curX] = tmp;
+              pr_3D_[curL][tmpY][curX].l = curL;
+              pr_3D_[curL][tmpY][curX].x = curX;
+              pr_3D_[curL][tmpY][curX].y = curY;
+              directions_3D[curL][tmpY][curX] = Direction::North;
+              src_heap_3D.push_back(&d1_3D[curL][tmpY][curX]);
+              updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+            } else if (d1_3D[curL][tmpY][curX]
+                       > tmp)  // bottom neighbor been put into
+                               // src_heap_3D but needs update
+            {
+              d1_3D[curL][tmpY][curX] = tmp;
+              pr_3D_[curL][tmpY][curX].l = curL;
+              pr_3D_[curL][tmpY][curX].x = curX;
+              pr_3D_[curL][tmpY][curX].y = curY;
+              directions_3D[curL][tmpY][curX] = Direction::North;
+              const int* dtmp = &d1_3D[curL][tmpY][curX];
+              int ind = 0;
+              while (src_heap_3D[ind] != dtmp)
+                ind++;
+              updateHeap3D(src_heap_3D, ind);
             }
           }
-          // top
-          if (!Horizontal && curY < regionY2
-              && directions_3D[curL][curY][curX] != Direction::North) {
-            const float tmp = d1_3D[curL][curY][curX] + 1;
-            const int tmpY = curY + 1;  // the top neighbor
-            if (v_edges_3D_[curL][curY][curX].usage
-                    < v_edges_3D_[curL][curY][curX].cap
-                && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
-              if (d1_3D[curL][tmpY][curX]
-                  >= BIG_INT)  // top neighbor not been put into src_heap_3D
-              {
-                d1_3D[curL][tmpY][curX] = tmp;
-                pr_3D_[curL][tmpY][curX].l = curL;
-                pr_3D_[curL][tmpY][curX].x = curX;
-                pr_3D_[curL][tmpY][curX].y = curY;
-                directions_3D[curL][tmpY][curX] = Direction::South;
-                src_heap_3D.push_back(&d1_3D[curL][tmpY][curX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-              } else if (d1_3D[curL][tmpY][curX]
-                         > tmp)  // top neighbor been put into src_heap_3D
-                                 // but needs update
-              {
-                d1_3D[curL][tmpY][curX] = tmp;
-                pr_3D_[curL][tmpY][curX].l = curL;
-                pr_3D_[curL][tmpY][curX].x = curX;
-                pr_3D_[curL][tmpY][curX].y = curY;
-                directions_3D[curL][tmpY][curX] = Direction::South;
-                const int* dtmp = &d1_3D[curL][tmpY][curX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
-              }
+        }
+        // top
+        if (!Horizontal && curY < regionY2
+            && directions_3D[curL][curY][curX] != Direction::North) {
+          const float tmp = d1_3D[curL][curY][curX] + 1;
+          const int tmpY = curY + 1;  // the top neighbor
+          if (v_edges_3D_[curL][curY][curX].usage
+                  < v_edges_3D_[curL][curY][curX].cap
+              && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
+            if (d1_3D[curL][tmpY][curX]
+                >= BIG_INT)  // top neighbor not been put into src_heap_3D
+            {
+              d1_3D[curL][tmpY][curX] = tmp;
+              pr_3D_[curL][tmpY][curX].l = curL;
+              pr_3D_[curL][tmpY][curX].x = curX;
+              pr_3D_[curL][tmpY][curX].y = curY;
+              directions_3D[curL][tmpY][curX] = Direction::South;
+              src_heap_3D.push_back(&d1_3D[curL][tmpY][curX]);
+              updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+            } else if (d1_3D[curL][tmpY][curX]
+                       > tmp)  // top neighbor been put into src_heap_3D
+                               // but needs update
+            {
+              d1_3D[curL][tmpY][curX] = tmp;
+              pr_3D_[curL][tmpY][curX].l = curL;
+              pr_3D_[curL][tmpY][curX].x = curX;
+              pr_3D_[curL][tmpY][curX].y = curY;
+              directions_3D[curL][tmpY][curX] = Direction::South;
+              const int* dtmp = &d1_3D[curL][tmpY][curX];
+              int ind = 0;
+              while (src_heap_3D[ind] != dtmp)
+                ind++;
+              updateHeap3D(src_heap_3D, ind);
             }
           }
         }
+      }
 
-        // down
-        if (curL > 0 && directions_3D[curL][curY][curX] != Direction::Up) {
-          const float tmp = d1_3D[curL][curY][curX] + via_cost_;
-          const int tmpL = curL - 1;  // the bottom neighbor
-
-          if (d1_3D[tmpL][curY][curX]
-              >= BIG_INT)  // bottom neighbor not been put into src_heap_3D
-          {
-            d1_3D[tmpL][curY][curX] = tmp;
-            pr_3D_[tmpL][curY][curX].l = curL;
-            pr_3D_[tmpL][curY][curX].x = curX;
-            pr_3D_[tmpL][curY][curX].y = curY;
-            directions_3D[tmpL][curY][curX] = Direction::Down;
-            src_heap_3D.push_back(&d1_3D[tmpL][curY][curX]);
-            updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-          } else if (d1_3D[tmpL][curY][curX]
-                     > tmp)  // bottom neighbor been put into src_heap_3D
-                             // but needs update
-          {
-            d1_3D[tmpL][curY][curX] = tmp;
-            pr_3D_[tmpL][curY][curX].l = curL;
-            pr_3D_[tmpL][curY][curX].x = curX;
-            pr_3D_[tmpL][curY][curX].y = curY;
-            directions_3D[tmpL][curY][curX] = Direction::Down;
-            const int* dtmp = &d1_3D[tmpL][curY][curX];
-            int ind = 0;
-            while (src_heap_3D[ind] != dtmp)
-              ind++;
-            updateHeap3D(src_heap_3D, ind);
-          }
-        }
+      // down
+      if (curL > 0 && directions_3D[curL][curY][curX] != Direction::Up) {
+        const float tmp = d1_3D[curL][curY][curX] + via_cost_;
+        const int tmpL = curL - 1;  // the bottom neighbor
 
-        // up
-        if (curL < num_layers_ - 1
-            && directions_3D[curL][curY][curX] != Direction::Down) {
-          const float tmp = d1_3D[curL][curY][curX] + via_cost_;
-          const int tmpL = curL + 1;  // the bottom neighbor
-          if (d1_3D[tmpL][curY][curX]
-              >= BIG_INT)  // bottom neighbor not been put into src_heap_3D
-          {
-            d1_3D[tmpL][curY][curX] = tmp;
-            pr_3D_[tmpL][curY][curX].l = curL;
-            pr_3D_[tmpL][curY][curX].x = curX;
-            pr_3D_[tmpL][curY][curX].y = curY;
-            directions_3D[tmpL][curY][curX] = Direction::Up;
-            src_heap_3D.push_back(&d1_3D[tmpL][curY][curX]);
-            updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-          } else if (d1_3D[tmpL][curY][curX]
-                     > tmp)  // bottom neighbor been put into src_heap_3D
-                             // but needs update
-          {
-            d1_3D[tmpL][curY][curX] = tmp;
-            pr_3D_[tmpL][curY][curX].l = curL;
-            pr_3D_[tmpL][curY][curX].x = curX;
-            pr_3D_[tmpL][curY][curX].y = curY;
-            directions_3D[tmpL][curY][curX] = Direction::Up;
-            const int* dtmp = &d1_3D[tmpL][curY][curX];
-            int ind = 0;
-            while (src_heap_3D[ind] != dtmp)
-              ind++;
-            updateHeap3D(src_heap_3D, ind);
-          }
+        if (d1_3D[tmpL][curY][curX]
+            >= BIG_INT)  // bottom neighbor not been put into src_heap_3D
+        {
+          d1_3D[tmpL][curY][curX] = tmp;
+          pr_3D_[tmpL][curY][curX].l = curL;
+          pr_3D_[tmpL][curY][curX].x = curX;
+          pr_3D_[tmpL][curY][curX].y = curY;
+          directions_3D[tmpL][curY][curX] = Direction::Down;
+          src_heap_3D.push_back(&d1_3D[tmpL][curY][curX]);
+          updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+        } else if (d1_3D[tmpL][curY][curX]
+                   > tmp)  // bottom neighbor been put into src_heap_3D
+                           // but needs update
+        {
+          d1_3D[tmpL][curY][curX] = tmp;
+          pr_3D_[tmpL][curY][curX].l = curL;
+          pr_3D_[tmpL][curY][curX].x = curX;
+          pr_3D_[tmpL][curY][curX].y = curY;
+          directions_3D[tmpL][curY][curX] = Direction::Down;
+          const int* dtmp = &d1_3D[tmpL][curY][curX];
+          int ind = 0;
+          while (src_heap_3D[ind] != dtmp)
+            ind++;
+          updateHeap3D(src_heap_3D, ind);
         }
+      }
 
-        if (src_heap_3D.empty()) {
-          logger_->error(GRT,
-                         183,
-                         "Net {}: heap underflow during 3D maze routing.",
-                         nets_[netID]->getName());
+      // up
+      if (curL < num_layers_ - 1
+          && directions_3D[curL][curY][curX] != Direction::Down) {
+        const float tmp = d1_3D[curL][curY][curX] + via_cost_;
+        const int tmpL = curL + 1;  // the bottom neighbor
+        if (d1_3D[tmpL][curY][curX]
+            >= BIG_INT)  // bottom neighbor not been put into src_heap_3D
+        {
+          d1_3D[tmpL][curY][curX] = tmp;
+          pr_3D_[tmpL][curY][curX].l = curL;
+          pr_3D_[tmpL][curY][curX].x = curX;
+          pr_3D_[tmpL][curY][curX].y = curY;
+          directions_3D[tmpL][curY][curX] = Direction::Up;
+          src_heap_3D.push_back(&d1_3D[tmpL][curY][curX]);
+          updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+        } else if (d1_3D[tmpL][curY][curX]
+                   > tmp)  // bottom neighbor been put into src_heap_3D
+                           // but needs update
+        {
+          d1_3D[tmpL][curY][curX] = tmp;
+          pr_3D_[tmpL][curY][curX].l = curL;
+          pr_3D_[tmpL][curY][curX].x = curX;
+          pr_3D_[tmpL][curY][curX].y = curY;
+          directions_3D[tmpL][curY][curX] = Direction::Up;
+          const int* dtmp = &d1_3D[tmpL][curY][curX];
+          int ind = 0;
+          while (src_heap_3D[ind] != dtmp)
+            ind++;
+          updateHeap3D(src_heap_3D, ind);
         }
-        // update ind1 for next loop
-        ind1 = (src_heap_3D[0] - &d1_3D[0][0][0]);
-      }  // while loop
-
-      for (int i = 0; i < dest_heap_3D.size(); i++)
-        pop_heap2_3D[dest_heap_3D[i] - &d2_3D[0][0][0]] = false;
+      }
 
-      // get the new route for the edge and store it in gridsX[] and
-      // gridsY[] temporarily
+      if (src_heap_3D.empty()) {
+        logger_->error(GRT,
+                       183,
+                       "Net {}: heap underflow during 3D maze routing.",
+                       nets_[netID]->getName());
+      }
+      // update ind1 for next loop
+      ind1 = (src_heap_3D[0] - d1_3D.data());
+    }  // while loop
 
-      const int crossL = ind1 / (grid_hv_);
-      const int crossX = (ind1 % (grid_hv_)) % x_range_;
-      const int crossY = (ind1 % (grid_hv_)) / x_range_;
+    for (int i = 0; i < dest_heap_3D.size(); i++)
+      pop_heap2_3D[dest_heap_3D[i] - d2_3D.data()] = false;
 
-      int cnt = 0;
-      int curX = crossX;
-      int curY = crossY;
-      int curL = crossL;
+    // get the new route for the edge and store it in gridsX[] and
+    // gridsY[] temporarily
 
-      if (d1_3D[curL][curY][curX] == 0) {
-        recoverEdge(netID, edgeID);
-        break;
-      }
+    const int crossL = d1_3D.layerOf(ind1);
+    const int crossX = d1_3D.xOf(ind1);
+    const int crossY = d1_3D.yOf(ind1);
 
-      std::vector<int> tmp_gridsX, tmp_gridsY, tmp_gridsL;
+    int cnt = 0;
+    int curX = crossX;
+    int curY = crossY;
+    int curL = crossL;
 
-      while (d1_3D[curL][curY][curX] != 0)  // loop until reach subtree1
-      {
-        const int tmpL = pr_3D_[curL][curY][curX].l;
-        const int tmpX = pr_3D_[curL][curY][curX].x;
-        const int tmpY = pr_3D_[curL][curY][curX].y;
-        curX = tmpX;
-        curY = tmpY;
-        curL = tmpL;
-        fflush(stdout);
-        tmp_gridsX.push_back(curX);
-        tmp_gridsY.push_back(curY);
-        tmp_gridsL.push_back(curL);
-        cnt++;
-      }
+    if (d1_3D[curL][curY][curX] == 0) {
+      recoverEdge(netID, edgeID, ws);
+      break;
+    }
 
-      std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
-      std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
-      std::vector<int> gridsL(tmp_gridsL.rbegin(), tmp_gridsL.rend());
+    std::vector<int> tmp_gridsX, tmp_gridsY, tmp_gridsL;
 
-      // add the connection point (crossX, crossY)
-      gridsX.push_back(crossX);
-      gridsY.push_back(crossY);
-      gridsL.push_back(crossL);
+    while (d1_3D[curL][curY][curX] != 0)  // loop until reach subtree1
+    {
+      const int tmpL = pr_3D_[curL][curY][curX].l;
+      const int tmpX = pr_3D_[curL][curY][curX].x;
+      const int tmpY = pr_3D_[curL][curY][curX].y;
+      curX = tmpX;
+      curY = tmpY;
+      curL = tmpL;
+      fflush(stdout);
+      tmp_gridsX.push_back(curX);
+      tmp_gridsY.push_back(curY);
+      tmp_gridsL.push_back(curL);
       cnt++;
+    }
 
-      curX = crossX;
-      curY = crossY;
-      curL = crossL;
+    std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
+    std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
+    std::vector<int> gridsL(tmp_gridsL.rbegin(), tmp_gridsL.rend());
 
-      const int cnt_n1n2 = cnt;
+    // add the connection point (crossX, crossY)
+    gridsX.push_back(crossX);
+    gridsY.push_back(crossY);
+    gridsL.push_back(crossL);
+    cnt++;
 
-      const int E1x = gridsX[0];
-      const int E1y = gridsY[0];
-      const int E2x = gridsX.back();
-      const int E2y = gridsY.back();
+    curX = crossX;
+    curY = crossY;
+    curL = crossL;
 
-      int headRoom = 0;
-      int origL = gridsL[0];
+    const int cnt_n1n2 = cnt;
 
-      while (headRoom < gridsX.size() && gridsX[headRoom] == E1x
-             && gridsY[headRoom] == E1y) {
-        headRoom++;
-      }
-      if (headRoom > 0) {
-        headRoom--;
-      }
+    const int E1x = gridsX[0];
+    const int E1y = gridsY[0];
+    const int E2x = gridsX.back();
+    const int E2y = gridsY.back();
 
-      int lastL = gridsL[headRoom];
+    int headRoom = 0;
+    int origL = gridsL[0];
 
-      // change the tree structure according to the new routing for the tree
-      // edge find E1 and E2, and the endpoints of the edges they are on
+    while (headRoom < gridsX.size() && gridsX[headRoom] == E1x
+           && gridsY[headRoom] == E1y) {
+      headRoom++;
+    }
+    if (headRoom > 0) {
+      headRoom--;
+    }
+
+    int lastL = gridsL[headRoom];
 
-      const int edge_n1n2 = edgeID;
-      // (1) consider subtree1
-      if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
-      // n1 is not a pin and E1!=n1, then make change to subtree1,
-      // otherwise, no change to subtree1
+    // change the tree structure according to the new routing for the tree
+    // edge find E1 and E2, and the endpoints of the edges they are on
+
+    const int edge_n1n2 = edgeID;
+    // (1) consider subtree1
+    if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
+    // n1 is not a pin and E1!=n1, then make change to subtree1,
+    // otherwise, no change to subtree1
+    {
+      n1Shift = true;
+      const int corE1 = corr_edge_3D[origL][E1y][E1x];
+
+      const int endpt1 = treeedges[corE1].n1;
+      const int endpt2 = treeedges[corE1].n2;
+
+      // find A1, A2 and edge_n1A1, edge_n1A2
+      int edge_n1A1, edge_n1A2;
+      int A1, A2;
+      if (treenodes[n1].nbr[0] == n2) {
+        A1 = treenodes[n1].nbr[1];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[1];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else if (treenodes[n1].nbr[1] == n2) {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[1];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[1];
+      }
+
+      if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
       {
-        n1Shift = true;
-        const int corE1 = corr_edge_3D[origL][E1y][E1x];
-
-        const int endpt1 = treeedges[corE1].n1;
-        const int endpt2 = treeedges[corE1].n2;
-
-        // find A1, A2 and edge_n1A1, edge_n1A2
-        int edge_n1A1, edge_n1A2;
-        int A1, A2;
-        if (treenodes[n1].nbr[0] == n2) {
-          A1 = treenodes[n1].nbr[1];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[1];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else if (treenodes[n1].nbr[1] == n2) {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[1];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[1];
+        // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
+        // (n1, A1)
+        if (endpt1 == A2 || endpt2 == A2) {
+          std::swap(A1, A2);
+          std::swap(edge_n1A1, edge_n1A2);
         }
 
-        if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
-        {
-          // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
-          // (n1, A1)
-          if (endpt1 == A2 || endpt2 == A2) {
-            std::swap(A1, A2);
-            std::swap(edge_n1A1, edge_n1A2);
-          }
-
-          // update route for edge (n1, A1), (n1, A2)
-          updateRouteType13D(netID,
-                             treenodes.get(),
-                             n1,
-                             A1,
-                             A2,
-                             E1x,
-                             E1y,
-                             treeedges.get(),
-                             edge_n1A1,
-                             edge_n1A2);
-
-          // update position for n1
-
-          // treenodes[n1].l = E1l;
-          treenodes[n1].assigned = true;
-        }     // if E1 is on (n1, A1) or (n1, A2)
-        else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-        {
-          const int C1 = endpt1;
-          const int C2 = endpt2;
-          const int edge_C1C2 = corr_edge_3D[origL][E1y][E1x];
-
-          // update route for edge (n1, C1), (n1, C2) and (A1, A2)
-          updateRouteType23D(netID,
-                             treenodes.get(),
-                             n1,
-                             A1,
-                             A2,
-                             C1,
-                             C2,
-                             E1x,
-                             E1y,
-                             treeedges.get(),
-                             edge_n1A1,
-                             edge_n1A2,
-                             edge_C1C2);
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-          treenodes[n1].assigned = true;
-          // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
-          // C2)->(A1, A2)
-          const int edge_n1C1 = edge_n1A1;
-          treeedges[edge_n1C1].n1 = C1;
-          treeedges[edge_n1C1].n2 = n1;
-          const int edge_n1C2 = edge_n1A2;
-          treeedges[edge_n1C2].n1 = n1;
-          treeedges[edge_n1C2].n2 = C2;
-          const int edge_A1A2 = edge_C1C2;
-          treeedges[edge_A1A2].n1 = A1;
-          treeedges[edge_A1A2].n2 = A2;
-          // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
-          // n1's nbr (n2, A1, A2)->(n2, C1, C2)
-          treenodes[n1].nbr[0] = n2;
-          treenodes[n1].edge[0] = edge_n1n2;
-          treenodes[n1].nbr[1] = C1;
-          treenodes[n1].edge[1] = edge_n1C1;
-          treenodes[n1].nbr[2] = C2;
-          treenodes[n1].edge[2] = edge_n1C2;
-          // A1's nbr n1->A2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A1].nbr[i] == n1) {
-              treenodes[A1].nbr[i] = A2;
-              treenodes[A1].edge[i] = edge_A1A2;
-              break;
-            }
+        // update route for edge (n1, A1), (n1, A2)
+        updateRouteType13D(netID,
+                           treenodes.get(),
+                           n1,
+                           A1,
+                           A2,
+                           E1x,
+                           E1y,
+                           treeedges.get(),
+                           edge_n1A1,
+                           edge_n1A2);
+
+        // update position for n1
+
+        // treenodes[n1].l = E1l;
+        treenodes[n1].assigned = true;
+      }     // if E1 is on (n1, A1) or (n1, A2)
+      else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+      {
+        const int C1 = endpt1;
+        const int C2 = endpt2;
+        const int edge_C1C2 = corr_edge_3D[origL][E1y][E1x];
+
+        // update route for edge (n1, C1), (n1, C2) and (A1, A2)
+        updateRouteType23D(netID,
+                           treenodes.get(),
+                           n1,
+                           A1,
+                           A2,
+                           C1,
+                           C2,
+                           E1x,
+                           E1y,
+                           treeedges.get(),
+                           edge_n1A1,
+                           edge_n1A2,
+                           edge_C1C2);
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+        treenodes[n1].assigned = true;
+        // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
+        // C2)->(A1, A2)
+        const int edge_n1C1 = edge_n1A1;
+        treeedges[edge_n1C1].n1 = C1;
+        treeedges[edge_n1C1].n2 = n1;
+        const int edge_n1C2 = edge_n1A2;
+        treeedges[edge_n1C2].n1 = n1;
+        treeedges[edge_n1C2].n2 = C2;
+        const int edge_A1A2 = edge_C1C2;
+        treeedges[edge_A1A2].n1 = A1;
+        treeedges[edge_A1A2].n2 = A2;
+        // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
+        // n1's nbr (n2, A1, A2)->(n2, C1, C2)
+        treenodes[n1].nbr[0] = n2;
+        treenodes[n1].edge[0] = edge_n1n2;
+        treenodes[n1].nbr[1] = C1;
+        treenodes[n1].edge[1] = edge_n1C1;
+        treenodes[n1].nbr[2] = C2;
+        treenodes[n1].edge[2] = edge_n1C2;
+        // A1's nbr n1->A2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A1].nbr[i] == n1) {
+            treenodes[A1].nbr[i] = A2;
+            treenodes[A1].edge[i] = edge_A1A2;
+            break;
           }
-          // A2's nbr n1->A1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A2].nbr[i] == n1) {
-              treenodes[A2].nbr[i] = A1;
-              treenodes[A2].edge[i] = edge_A1A2;
-              break;
-            }
+        }
+        // A2's nbr n1->A1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A2].nbr[i] == n1) {
+            treenodes[A2].nbr[i] = A1;
+            treenodes[A2].edge[i] = edge_A1A2;
+            break;
           }
-          // C1's nbr C2->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C1].nbr[i] == C2) {
-              treenodes[C1].nbr[i] = n1;
-              treenodes[C1].edge[i] = edge_n1C1;
-              break;
-            }
+        }
+        // C1's nbr C2->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C1].nbr[i] == C2) {
+            treenodes[C1].nbr[i] = n1;
+            treenodes[C1].edge[i] = edge_n1C1;
+            break;
           }
-          // C2's nbr C1->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C2].nbr[i] == C1) {
-              treenodes[C2].nbr[i] = n1;
-              treenodes[C2].edge[i] = edge_n1C2;
-              break;
-            }
+        }
+        // C2's nbr C1->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C2].nbr[i] == C1) {
+            treenodes[C2].nbr[i] = n1;
+            treenodes[C2].edge[i] = edge_n1C2;
+            break;
           }
-        }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-      }    // n1 is not a pin and E1!=n1
-      else {
-        newUpdateNodeLayers(treenodes.get(), edge_n1n2, n1a, lastL);
-      }
+        }
+      }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+    }    // n1 is not a pin and E1!=n1
+    else {
+      newUpdateNodeLayers(treenodes.get(), edge_n1n2, n1a, lastL);
+    }
 
-      origL = gridsL[cnt_n1n2 - 1];
-      int tailRoom = cnt_n1n2 - 1;
+    origL = gridsL[cnt_n1n2 - 1];
+    int tailRoom = cnt_n1n2 - 1;
 
-      while (tailRoom > 0 && gridsX[tailRoom] == E2x
-             && gridsY[tailRoom] == E2y) {
-        tailRoom--;
-      }
-      if (tailRoom < cnt_n1n2 - 1) {
-        tailRoom++;
-      }
+    while (tailRoom > 0 && gridsX[tailRoom] == E2x
+           && gridsY[tailRoom] == E2y) {
+      tailRoom--;
+    }
+    if (tailRoom < cnt_n1n2 - 1) {
+      tailRoom++;
+    }
 
-      lastL = gridsL[tailRoom];
+    lastL = gridsL[tailRoom];
 
-      // (2) consider subtree2
-      if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
-      // n2 is not a pin and E2!=n2, then make change to subtree2,
-      // otherwise, no change to subtree2
+    // (2) consider subtree2
+    if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
+    // n2 is not a pin and E2!=n2, then make change to subtree2,
+    // otherwise, no change to subtree2
+    {
+      // find the endpoints of the edge E1 is on
+
+      n2Shift = true;
+      const int corE2 = corr_edge_3D[origL][E2y][E2x];
+      const int endpt1 = treeedges[corE2].n1;
+      const int endpt2 = treeedges[corE2].n2;
+
+      // find B1, B2
+      int edge_n2B1, edge_n2B2;
+      int B1, B2;
+      if (treenodes[n2].nbr[0] == n1) {
+        B1 = treenodes[n2].nbr[1];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[1];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else if (treenodes[n2].nbr[1] == n1) {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[1];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[1];
+      }
+
+      if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
       {
-        // find the endpoints of the edge E1 is on
-
-        n2Shift = true;
-        const int corE2 = corr_edge_3D[origL][E2y][E2x];
-        const int endpt1 = treeedges[corE2].n1;
-        const int endpt2 = treeedges[corE2].n2;
-
-        // find B1, B2
-        int edge_n2B1, edge_n2B2;
-        int B1, B2;
-        if (treenodes[n2].nbr[0] == n1) {
-          B1 = treenodes[n2].nbr[1];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[1];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else if (treenodes[n2].nbr[1] == n1) {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[1];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[1];
+        // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
+        // (n2, B1)
+        if (endpt1 == B2 || endpt2 == B2) {
+          std::swap(B1, B2);
+          std::swap(edge_n2B1, edge_n2B2);
         }
 
-        if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
-        {
-          // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
-          // (n2, B1)
-          if (endpt1 == B2 || endpt2 == B2) {
-            std::swap(B1, B2);
-            std::swap(edge_n2B1, edge_n2B2);
-          }
-
-          // update route for edge (n2, B1), (n2, B2)
-          updateRouteType13D(netID,
-                             treenodes.get(),
-                             n2,
-                             B1,
-                             B2,
-                             E2x,
-                             E2y,
-                             treeedges.get(),
-                             edge_n2B1,
-                             edge_n2B2);
-
-          // update position for n2
-          treenodes[n2].assigned = true;
-        }     // if E2 is on (n2, B1) or (n2, B2)
-        else  // E2 is not on (n2, B1) or (n2, B2), but on (d1_3D, d2_3D)
-        {
-          const int D1 = endpt1;
-          const int D2 = endpt2;
-          const int edge_D1D2 = corr_edge_3D[origL][E2y][E2x];
-
-          // update route for edge (n2, d1_3D), (n2, d2_3D) and (B1, B2)
-          updateRouteType23D(netID,
-                             treenodes.get(),
-                             n2,
-                             B1,
-                             B2,
-                             D1,
-                             D2,
-                             E2x,
-                             E2y,
-                             treeedges.get(),
-                             edge_n2B1,
-                             edge_n2B2,
-                             edge_D1D2);
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-          treenodes[n2].assigned = true;
-          // update 3 edges (n2, B1)->(d1_3D, n2), (n2, B2)->(n2, d2_3D),
-          // (d1_3D, d2_3D)->(B1, B2)
-          const int edge_n2D1 = edge_n2B1;
-          treeedges[edge_n2D1].n1 = D1;
-          treeedges[edge_n2D1].n2 = n2;
-          const int edge_n2D2 = edge_n2B2;
-          treeedges[edge_n2D2].n1 = n2;
-          treeedges[edge_n2D2].n2 = D2;
-          const int edge_B1B2 = edge_D1D2;
-          treeedges[edge_B1B2].n1 = B1;
-          treeedges[edge_B1B2].n2 = B2;
-          // update nbr and edge for 5 nodes n2, B1, B2, d1_3D, d2_3D
-          // n1's nbr (n1, B1, B2)->(n1, d1_3D, d2_3D)
-          treenodes[n2].nbr[0] = n1;
-          treenodes[n2].edge[0] = edge_n1n2;
-          treenodes[n2].nbr[1] = D1;
-          treenodes[n2].edge[1] = edge_n2D1;
-          treenodes[n2].nbr[2] = D2;
-          treenodes[n2].edge[2] = edge_n2D2;
-          // B1's nbr n2->B2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B1].nbr[i] == n2) {
-              treenodes[B1].nbr[i] = B2;
-              treenodes[B1].edge[i] = edge_B1B2;
-              break;
-            }
+        // update route for edge (n2, B1), (n2, B2)
+        updateRouteType13D(netID,
+                           treenodes.get(),
+                           n2,
+                           B1,
+                           B2,
+                           E2x,
+                           E2y,
+                           treeedges.get(),
+                           edge_n2B1,
+                           edge_n2B2);
+
+        // update position for n2
+        treenodes[n2].assigned = true;
+      }     // if E2 is on (n2, B1) or (n2, B2)
+      else  // E2 is not on (n2, B1) or (n2, B2), but on (d1_3D, d2_3D)
+      {
+        const int D1 = endpt1;
+        const int D2 = endpt2;
+        const int edge_D1D2 = corr_edge_3D[origL][E2y][E2x];
+
+        // update route for edge (n2, d1_3D), (n2, d2_3D) and (B1, B2)
+        updateRouteType23D(netID,
+                           treenodes.get(),
+                           n2,
+                           B1,
+                           B2,
+                           D1,
+                           D2,
+                           E2x,
+                           E2y,
+                           treeedges.get(),
+                           edge_n2B1,
+                           edge_n2B2,
+                           edge_D1D2);
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+        treenodes[n2].assigned = true;
+        // update 3 edges (n2, B1)->(d1_3D, n2), (n2, B2)->(n2, d2_3D),
+        // (d1_3D, d2_3D)->(B1, B2)
+        const int edge_n2D1 = edge_n2B1;
+        treeedges[edge_n2D1].n1 = D1;
+        treeedges[edge_n2D1].n2 = n2;
+        const int edge_n2D2 = edge_n2B2;
+        treeedges[edge_n2D2].n1 = n2;
+        treeedges[edge_n2D2].n2 = D2;
+        const int edge_B1B2 = edge_D1D2;
+        treeedges[edge_B1B2].n1 = B1;
+        treeedges[edge_B1B2].n2 = B2;
+        // update nbr and edge for 5 nodes n2, B1, B2, d1_3D, d2_3D
+        // n1's nbr (n1, B1, B2)->(n1, d1_3D, d2_3D)
+        treenodes[n2].nbr[0] = n1;
+        treenodes[n2].edge[0] = edge_n1n2;
+        treenodes[n2].nbr[1] = D1;
+        treenodes[n2].edge[1] = edge_n2D1;
+        treenodes[n2].nbr[2] = D2;
+        treenodes[n2].edge[2] = edge_n2D2;
+        // B1's nbr n2->B2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B1].nbr[i] == n2) {
+            treenodes[B1].nbr[i] = B2;
+            treenodes[B1].edge[i] = edge_B1B2;
+            break;
           }
-          // B2's nbr n2->B1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B2].nbr[i] == n2) {
-              treenodes[B2].nbr[i] = B1;
-              treenodes[B2].edge[i] = edge_B1B2;
-              break;
-            }
+        }
+        // B2's nbr n2->B1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B2].nbr[i] == n2) {
+            treenodes[B2].nbr[i] = B1;
+            treenodes[B2].edge[i] = edge_B1B2;
+            break;
           }
-          // D1's nbr D2->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D1].nbr[i] == D2) {
-              treenodes[D1].nbr[i] = n2;
-              treenodes[D1].edge[i] = edge_n2D1;
-              break;
-            }
+        }
+        // D1's nbr D2->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D1].nbr[i] == D2) {
+            treenodes[D1].nbr[i] = n2;
+            treenodes[D1].edge[i] = edge_n2D1;
+            break;
           }
-          // D2's nbr D1->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D2].nbr[i] == D1) {
-              treenodes[D2].nbr[i] = n2;
-              treenodes[D2].edge[i] = edge_n2D2;
-              break;
-            }
+        }
+        // D2's nbr D1->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D2].nbr[i] == D1) {
+            treenodes[D2].nbr[i] = n2;
+            treenodes[D2].edge[i] = edge_n2D2;
+            break;
           }
-        }     // else E2 is not on (n2, B1) or (n2, B2), but on (d1_3D,
-              // d2_3D)
-      } else  // n2 is not a pin and E2!=n2
-      {
-        newUpdateNodeLayers(treenodes.get(), edge_n1n2, n2a, lastL);
-      }
+        }
+      }     // else E2 is not on (n2, B1) or (n2, B2), but on (d1_3D,
+            // d2_3D)
+    } else  // n2 is not a pin and E2!=n2
+    {
+      newUpdateNodeLayers(treenodes.get(), edge_n1n2, n2a, lastL);
+    }
 
-      const int newcnt_n1n2 = tailRoom - headRoom + 1;
+    const int newcnt_n1n2 = tailRoom - headRoom + 1;
 
-      // update route for edge (n1, n2) and edge usage
-      if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
-        treeedges[edge_n1n2].route.gridsX.clear();
-        treeedges[edge_n1n2].route.gridsY.clear();
-        treeedges[edge_n1n2].route.gridsL.clear();
-      }
+    // update route for edge (n1, n2) and edge usage
+    if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
+      treeedges[edge_n1n2].route.gridsX.clear();
+      treeedges[edge_n1n2].route.gridsY.clear();
+      treeedges[edge_n1n2].route.gridsL.clear();
+    }
 
-      // avoid resizing vector with negative value.
-      // this may happen when all elements of gridsX and gridsY are the
-      // same.
-      if (newcnt_n1n2 > 0) {
-        treeedges[edge_n1n2].route.gridsX.resize(newcnt_n1n2, 0);
-        treeedges[edge_n1n2].route.gridsY.resize(newcnt_n1n2, 0);
-        treeedges[edge_n1n2].route.gridsL.resize(newcnt_n1n2, 0);
-      }
-      treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
-      treeedges[edge_n1n2].route.routelen = newcnt_n1n2 - 1;
-      treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
-
-      int j = headRoom;
-      for (int i = 0; i < newcnt_n1n2; i++) {
-        treeedges[edge_n1n2].route.gridsX[i] = gridsX[j];
-        treeedges[edge_n1n2].route.gridsY[i] = gridsY[j];
-        treeedges[edge_n1n2].route.gridsL[i] = gridsL[j];
-        j++;
+    // avoid resizing vector with negative value.
+    // this may happen when all elements of gridsX and gridsY are the
+    // same.
+    if (newcnt_n1n2 > 0) {
+      treeedges[edge_n1n2].route.gridsX.resize(newcnt_n1n2, 0);
+      treeedges[edge_n1n2].route.gridsY.resize(newcnt_n1n2, 0);
+      treeedges[edge_n1n2].route.gridsL.resize(newcnt_n1n2, 0);
+    }
+    treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
+    treeedges[edge_n1n2].route.routelen = newcnt_n1n2 - 1;
+    treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
+
+    int j = headRoom;
+    for (int i = 0; i < newcnt_n1n2; i++) {
+      treeedges[edge_n1n2].route.gridsX[i] = gridsX[j];
+      treeedges[edge_n1n2].route.gridsY[i] = gridsY[j];
+      treeedges[edge_n1n2].route.gridsL[i] = gridsL[j];
+      j++;
+    }
+
+    // update edge usage
+    for (int i = headRoom; i < tailRoom; i++) {
+      if (gridsL[i] == gridsL[i + 1]) {
+        if (gridsX[i] == gridsX[i + 1])  // a vertical edge
+        {
+          const int min_y = std::min(gridsY[i], gridsY[i + 1]);
+          v_edges_[min_y][gridsX[i]].usage += net->getEdgeCost();
+          ws.v_used.emplace_back(min_y, gridsX[i]);
+          v_edges_3D_[gridsL[i]][min_y][gridsX[i]].usage
+              += net->getLayerEdgeCost(gridsL[i]);
+        } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
+        {
+          const int min_x = std::min(gridsX[i], gridsX[i + 1]);
+          h_edges_[gridsY[i]][min_x].usage += net->getEdgeCost();
+          ws.h_used.emplace_back(gridsY[i], min_x);
+          h_edges_3D_[gridsL[i]][gridsY[i]][min_x].usage
+              += net->getLayerEdgeCost(gridsL[i]);
+        }
       }
+    }
 
-      // update edge usage
-      for (int i = headRoom; i < tailRoom; i++) {
-        if (gridsL[i] == gridsL[i + 1]) {
-          if (gridsX[i] == gridsX[i + 1])  // a vertical edge
-          {
-            const int min_y = std::min(gridsY[i], gridsY[i + 1]);
-            v_edges_[min_y][gridsX[i]].usage += net->getEdgeCost();
-            v_used_ggrid_.insert(std::make_pair(min_y, gridsX[i]));
-            v_edges_3D_[gridsL[i]][min_y][gridsX[i]].usage
-                += net->getLayerEdgeCost(gridsL[i]);
-          } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
-          {
-            const int min_x = std::min(gridsX[i], gridsX[i + 1]);
-            h_edges_[gridsY[i]][min_x].usage += net->getEdgeCost();
-            h_used_ggrid_.insert(std::make_pair(gridsY[i], min_x));
-            h_edges_3D_[gridsL[i]][gridsY[i]][min_x].usage
-                += net->getLayerEdgeCost(gridsL[i]);
+    if (!n1Shift && !n2Shift) {
+      continue;
+    }
+    // re statis the node overlap
+    int numpoints = 0;
+
+    for (int d = 0; d < sttrees_[netID].num_nodes; d++) {
+      treenodes[d].topL = -1;
+      treenodes[d].botL = num_layers_;
+      treenodes[d].assigned = false;
+      treenodes[d].stackAlias = d;
+      treenodes[d].conCNT = 0;
+      treenodes[d].hID = BIG_INT;
+      treenodes[d].lID = BIG_INT;
+      treenodes[d].status = 0;
+
+      if (d < num_terminals) {
+        treenodes[d].botL = treenodes[d].topL = 0;
+        // treenodes[d].l = 0;
+        treenodes[d].assigned = true;
+        treenodes[d].status = 1;
+
+        ws.xcor[numpoints] = treenodes[d].x;
+        ws.ycor[numpoints] = treenodes[d].y;
+        ws.dcor[numpoints] = d;
+        numpoints++;
+      } else {
+        bool redundant = false;
+        for (int k = 0; k < numpoints; k++) {
+          if ((treenodes[d].x == ws.xcor[k])
+              && (treenodes[d].y == ws.ycor[k])) {
+            treenodes[d].stackAlias = ws.dcor[k];
+
+            redundant = true;
+            break;
           }
         }
+        if (!redundant) {
+          ws.xcor[numpoints] = treenodes[d].x;
+          ws.ycor[numpoints] = treenodes[d].y;
+          ws.dcor[numpoints] = d;
+          numpoints++;
+        }
       }
+    }  // numerating for nodes
+    for (int k = 0; k < sttrees_[netID].num_edges(); k++) {
+      treeedge = &(treeedges[k]);
 
-      if (!n1Shift && !n2Shift) {
+      if (treeedge->len <= 0) {
         continue;
       }
-      // re statis the node overlap
-      int numpoints = 0;
-
-      for (int d = 0; d < sttrees_[netID].num_nodes; d++) {
-        treenodes[d].topL = -1;
-        treenodes[d].botL = num_layers_;
-        treenodes[d].assigned = false;
-        treenodes[d].stackAlias = d;
-        treenodes[d].conCNT = 0;
-        treenodes[d].hID = BIG_INT;
-        treenodes[d].lID = BIG_INT;
-        treenodes[d].status = 0;
-
-        if (d < num_terminals) {
-          treenodes[d].botL = treenodes[d].topL = 0;
-          // treenodes[d].l = 0;
-          treenodes[d].assigned = true;
-          treenodes[d].status = 1;
-
-          xcor_[numpoints] = treenodes[d].x;
-          ycor_[numpoints] = treenodes[d].y;
-          dcor_[numpoints] = d;
-          numpoints++;
-        } else {
-          bool redundant = false;
-          for (int k = 0; k < numpoints; k++) {
-            if ((treenodes[d].x == xcor_[k]) && (treenodes[d].y == ycor_[k])) {
-              treenodes[d].stackAlias = dcor_[k];
-
-              redundant = true;
-              break;
-            }
-          }
-          if (!redundant) {
-            xcor_[numpoints] = treenodes[d].x;
-            ycor_[numpoints] = treenodes[d].y;
-            dcor_[numpoints] = d;
-            numpoints++;
-          }
-        }
-      }  // numerating for nodes
-      for (int k = 0; k < sttrees_[netID].num_edges(); k++) {
-        treeedge = &(treeedges[k]);
-
-        if (treeedge->len <= 0) {
-          continue;
-        }
-        routeLen = treeedge->route.routelen;
+      routeLen = treeedge->route.routelen;
 
-        n1 = treeedge->n1;
-        n2 = treeedge->n2;
-        const std::vector<short>& gridsLtmp = treeedge->route.gridsL;
+      n1 = treeedge->n1;
+      n2 = treeedge->n2;
+      const std::vector<short>& gridsLtmp = treeedge->route.gridsL;
 
-        n1a = treenodes[n1].stackAlias;
+      n1a = treenodes[n1].stackAlias;
 
-        n2a = treenodes[n2].stackAlias;
+      n2a = treenodes[n2].stackAlias;
 
-        treeedge->n1a = n1a;
-        treeedge->n2a = n2a;
+      treeedge->n1a = n1a;
+      treeedge->n2a = n2a;
 
-        int connectionCNT = treenodes[n1a].conCNT;
-        treenodes[n1a].heights[connectionCNT] = gridsLtmp[0];
-        treenodes[n1a].eID[connectionCNT] = k;
-        treenodes[n1a].conCNT++;
+      int connectionCNT = treenodes[n1a].conCNT;
+      treenodes[n1a].heights[connectionCNT] = gridsLtmp[0];
+      treenodes[n1a].eID[connectionCNT] = k;
+      treenodes[n1a].conCNT++;
 
-        if (gridsLtmp[0] > treenodes[n1a].topL) {
-          treenodes[n1a].hID = k;
-          treenodes[n1a].topL = gridsLtmp[0];
-        }
-        if (gridsLtmp[0] < treenodes[n1a].botL) {
-          treenodes[n1a].lID = k;
-          treenodes[n1a].botL = gridsLtmp[0];
-        }
+      if (gridsLtmp[0] > treenodes[n1a].topL) {
+        treenodes[n1a].hID = k;
+        treenodes[n1a].topL = gridsLtmp[0];
+      }
+      if (gridsLtmp[0] < treenodes[n1a].botL) {
+        treenodes[n1a].lID = k;
+        treenodes[n1a].botL = gridsLtmp[0];
+      }
 
-        treenodes[n1a].assigned = true;
+      treenodes[n1a].assigned = true;
 
-        connectionCNT = treenodes[n2a].conCNT;
-        treenodes[n2a].heights[connectionCNT] = gridsLtmp[routeLen];
-        treenodes[n2a].eID[connectionCNT] = k;
-        treenodes[n2a].conCNT++;
-        if (gridsLtmp[routeLen] > treenodes[n2a].topL) {
-          treenodes[n2a].hID = k;
-          treenodes[n2a].topL = gridsLtmp[routeLen];
-        }
-        if (gridsLtmp[routeLen] < treenodes[n2a].botL) {
-          treenodes[n2a].lID = k;
-          treenodes[n2a].botL = gridsLtmp[routeLen];
-        }
+      connectionCNT = treenodes[n2a].conCNT;
+      treenodes[n2a].heights[connectionCNT] = gridsLtmp[routeLen];
+      treenodes[n2a].eID[connectionCNT] = k;
+      treenodes[n2a].conCNT++;
+      if (gridsLtmp[routeLen] > treenodes[n2a].topL) {
+        treenodes[n2a].hID = k;
+        treenodes[n2a].topL = gridsLtmp[routeLen];
+      }
+      if (gridsLtmp[routeLen] < treenodes[n2a].botL) {
+        treenodes[n2a].lID = k;
+        treenodes[n2a].botL = gridsLtmp[routeLen];
+      }
 
-        treenodes[n2a].assigned = true;
-      }  // eunmerating edges
-    }
+      treenodes[n2a].assigned = true;
+    }  // eunmerating edges
   }
 }
 
@@ -30,6 +30,8 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <omp.h>
+
 #include <algorithm>
 #include <fstream>
 #include <queue>
@@ -38,6 +40,7 @@
 #include "FastRoute.h"
 #include "odb/db.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace grt {
 
@@ -308,16 +311,17 @@ void FastRouteCore::fixEdgeAssignment(int& net_layer,
                                       int k,
                                       int l,
                                       bool vertical,
-                                      int& best_cost)
+                                      int& best_cost,
+                                      multi_array<int, 2>& layer_grid)
 {
   bool is_vertical = ((l % 2) - layer_orientation_) != 0;
   // if layer direction doesn't match edge direction or
   // if already found a layer for the edge, ignores the remaining layers
   if (is_vertical != vertical || best_cost > 0) {
-    layer_grid_[l][k] = std::numeric_limits<int>::min();
+    layer_grid[l][k] = std::numeric_limits<int>::min();
   } else {
-    layer_grid_[l][k] = edges_3D[l][y][x].cap - edges_3D[l][y][x].usage;
-    best_cost = std::max(best_cost, layer_grid_[l][k]);
+    layer_grid[l][k] = edges_3D[l][y][x].cap - edges_3D[l][y][x].usage;
+    best_cost = std::max(best_cost, layer_grid[l][k]);
     if (best_cost > 0) {
       // set the new min/max routing layer for the net to avoid
       // errors during mazeRouteMSMDOrder3D
@@ -326,13 +330,18 @@ void FastRouteCore::fixEdgeAssignment(int& net_layer,
   }
 }
 
-void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
+void FastRouteCore::assignEdge(int netID,
+                               int edgeID,
+                               bool processDIR,
+                               LayerAssignWorkspace& ws)
 {
   std::vector<std::vector<long>> gridD;
   int i, k, l, min_x, min_y, routelen, n1a, n2a, last_layer;
   int min_result, endLayer = 0;
 
   FrNet* net = nets_[netID];
+  multi_array<int, 2>& layer_grid = ws.layer_grid;
+  multi_array<int, 2>& via_link = ws.via_link;
   const auto& treeedges = sttrees_[netID].edges;
   const auto& treenodes = sttrees_[netID].nodes;
   TreeEdge* treeedge = &(treeedges[edgeID]);
@@ -353,7 +362,7 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
   for (l = 0; l < num_layers_; l++) {
     for (k = 0; k <= routelen; k++) {
       gridD[l][k] = BIG_INT;
-      via_link_[l][k] = BIG_INT;
+      via_link[l][k] = BIG_INT;
     }
   }
 
@@ -365,11 +374,11 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
         // check if the current layer is vertical to match the edge orientation
         bool is_vertical = ((l % 2) - layer_orientation_) != 0;
         if (is_vertical) {
-          layer_grid_[l][k] = v_edges_3D_[l][min_y][gridsX[k]].cap
+          layer_grid[l][k] = v_edges_3D_[l][min_y][gridsX[k]].cap
                               - v_edges_3D_[l][min_y][gridsX[k]].usage;
-          best_cost = std::max(best_cost, layer_grid_[l][k]);
+          best_cost = std::max(best_cost, layer_grid[l][k]);
         } else {
-          layer_grid_[l][k] = std::numeric_limits<int>::min();
+          layer_grid[l][k] = std::numeric_limits<int>::min();
         }
       }
 
@@ -379,22 +388,36 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
         // layer
         int min_layer = net->getMinLayer();
         for (l = net->getMinLayer() - 1; l >= 0; l--) {
-          fixEdgeAssignment(
-              min_layer, v_edges_3D_, gridsX[k], min_y, k, l, true, best_cost);
+          fixEdgeAssignment(min_layer,
+                            v_edges_3D_,
+                            gridsX[k],
+                            min_y,
+                            k,
+                            l,
+                            true,
+                            best_cost,
+                            layer_grid);
         }
         net->setMinLayer(min_layer);
         // try to assign the edge to the closest layer above the max routing
         // layer
         int max_layer = net->getMaxLayer();
         for (l = net->getMaxLayer() + 1; l < num_layers_; l++) {
-          fixEdgeAssignment(
-              max_layer, v_edges_3D_, gridsX[k], min_y, k, l, true, best_cost);
+          fixEdgeAssignment(max_layer,
+                            v_edges_3D_,
+                            gridsX[k],
+                            min_y,
+                            k,
+                            l,
+                            true,
+                            best_cost,
+                            layer_grid);
         }
         net->setMaxLayer(max_layer);
       } else {  // the edge was assigned to a layer without causing overflow
         for (l = 0; l < num_layers_; l++) {
           if (l < net->getMinLayer() || l > net->getMaxLayer()) {
-            layer_grid_[l][k] = std::numeric_limits<int>::min();
+            layer_grid[l][k] = std::numeric_limits<int>::min();
           }
         }
       }
@@ -405,11 +428,11 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
         // orientation
         bool is_horizontal = ((l % 2) - layer_orientation_) == 0;
         if (is_horizontal) {
-          layer_grid_[l][k] = h_edges_3D_[l][gridsY[k]][min_x].cap
+          layer_grid[l][k] = h_edges_3D_[l][gridsY[k]][min_x].cap
                               - h_edges_3D_[l][gridsY[k]][min_x].usage;
-          best_cost = std::max(best_cost, layer_grid_[l][k]);
+          best_cost = std::max(best_cost, layer_grid[l][k]);
         } else {
-          layer_grid_[l][k] = std::numeric_limits<int>::min();
+          layer_grid[l][k] = std::numeric_limits<int>::min();
         }
       }
 
@@ -419,22 +442,36 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
         // layer
         int min_layer = net->getMinLayer();
         for (l = net->getMinLayer() - 1; l >= 0; l--) {
-          fixEdgeAssignment(
-              min_layer, h_edges_3D_, min_x, gridsY[k], k, l, false, best_cost);
+          fixEdgeAssignment(min_layer,
+                            h_edges_3D_,
+                            min_x,
+                            gridsY[k],
+                            k,
+                            l,
+                            false,
+                            best_cost,
+                            layer_grid);
         }
         net->setMinLayer(min_layer);
         // try to assign the edge to the closest layer above the max routing
         // layer
         int max_layer = net->getMaxLayer();
         for (l = net->getMaxLayer() + 1; l < num_layers_; l++) {
-          fixEdgeAssignment(
-              max_layer, h_edges_3D_, min_x, gridsY[k], k, l, false, best_cost);
+          fixEdgeAssignment(max_layer,
+                            h_edges_3D_,
+                            min_x,
+                            gridsY[k],
+                            k,
+                            l,
+                            false,
+                            best_cost,
+                            layer_grid);
         }
         net->setMaxLayer(max_layer);
       } else {  // the edge was assigned to a layer without causing overflow
         for (l = 0; l < num_layers_; l++) {
           if (l < net->getMinLayer() || l > net->getMaxLayer()) {
-            layer_grid_[l][k] = std::numeric_limits<int>::min();
+            layer_grid[l][k] = std::numeric_limits<int>::min();
           }
         }
       }
@@ -459,23 +496,23 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
             if (l != i) {
               if (gridD[i][k] > gridD[l][k] + abs(i - l) * 2) {
                 gridD[i][k] = gridD[l][k] + abs(i - l) * 2;
-                via_link_[i][k] = l;
+                via_link[i][k] = l;
               }
             }
           } else {
             if (l != i) {
               if (gridD[i][k] > gridD[l][k] + abs(i - l) * 3) {
                 gridD[i][k] = gridD[l][k] + abs(i - l) * 3;
-                via_link_[i][k] = l;
+                via_link[i][k] = l;
               }
             }
           }
         }
       }
       for (l = 0; l < num_layers_; l++) {
-        if (layer_grid_[l][k] > 0) {
+        if (layer_grid[l][k] > 0) {
           gridD[l][k + 1] = gridD[l][k] + 1;
-        } else if (layer_grid_[l][k] == std::numeric_limits<int>::min()) {
+        } else if (layer_grid[l][k] == std::numeric_limits<int>::min()) {
           // when the layer orientation doesn't match the edge orientation,
           // set a larger weight to avoid assigning to this layer when the
           // routing has 3D overflow
@@ -491,7 +528,7 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
         if (l != i) {
           if (gridD[i][k] > gridD[l][k] + abs(i - l) * 1) {
             gridD[i][k] = gridD[l][k] + abs(i - l) * 1;
-            via_link_[i][k] = l;
+            via_link[i][k] = l;
           }
         }
       }
@@ -518,16 +555,16 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
       }
     }
 
-    if (via_link_[endLayer][routelen] == BIG_INT) {
+    if (via_link[endLayer][routelen] == BIG_INT) {
       last_layer = endLayer;
     } else {
-      last_layer = via_link_[endLayer][routelen];
+      last_layer = via_link[endLayer][routelen];
     }
 
     for (k = routelen; k >= 0; k--) {
       gridsL[k] = last_layer;
-      if (via_link_[last_layer][k] != BIG_INT) {
-        last_layer = via_link_[last_layer][k];
+      if (via_link[last_layer][k] != BIG_INT) {
+        last_layer = via_link[last_layer][k];
       }
     }
 
@@ -580,23 +617,23 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
             if (l != i) {
               if (gridD[i][k] > gridD[l][k] + abs(i - l) * 2) {
                 gridD[i][k] = gridD[l][k] + abs(i - l) * 2;
-                via_link_[i][k] = l;
+                via_link[i][k] = l;
               }
             }
           } else {
             if (l != i) {
               if (gridD[i][k] > gridD[l][k] + abs(i - l) * 3) {
                 gridD[i][k] = gridD[l][k] + abs(i - l) * 3;
-                via_link_[i][k] = l;
+                via_link[i][k] = l;
               }
             }
           }
         }
       }
       for (l = 0; l < num_layers_; l++) {
-        if (layer_grid_[l][k - 1] > 0) {
+        if (layer_grid[l][k - 1] > 0) {
           gridD[l][k - 1] = gridD[l][k] + 1;
-        } else if (layer_grid_[l][k] == std::numeric_limits<int>::min()) {
+        } else if (layer_grid[l][k] == std::numeric_limits<int>::min()) {
           // when the layer orientation doesn't match the edge orientation,
           // set a larger weight to avoid assigning to this layer when the
           // routing has 3D overflow
@@ -612,7 +649,7 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
         if (l != i) {
           if (gridD[i][0] > gridD[l][0] + abs(i - l) * 1) {
             gridD[i][0] = gridD[l][0] + abs(i - l) * 1;
-            via_link_[i][0] = l;
+            via_link[i][0] = l;
           }
         }
       }
@@ -641,8 +678,8 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
     last_layer = endLayer;
 
     for (k = 0; k <= routelen; k++) {
-      if (via_link_[last_layer][k] != BIG_INT) {
-        last_layer = via_link_[last_layer][k];
+      if (via_link[last_layer][k] != BIG_INT) {
+        last_layer = via_link[last_layer][k];
       }
       gridsL[k] = last_layer;
     }
@@ -694,12 +731,7 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
 
 void FastRouteCore::layerAssignmentV4()
 {
-  int i, k, netID, edgeID, nodeID, routeLen;
-  int n1, n2, connectionCNT;
-
-  int n1a, n2a;
-  std::queue<int> edgeQueue;
-
+  int netID, edgeID, routeLen;
   TreeEdge* treeedge;
 
   for (netID = 0; netID < netCount(); netID++) {
@@ -718,121 +750,171 @@ void FastRouteCore::layerAssignmentV4()
   }
   netpinOrderInc();
 
-  for (i = 0; i < tree_order_pv_.size(); i++) {
-    netID = tree_order_pv_[i].treeIndex;
+  std::vector<int> net_ids;
+  for (const OrderNetPin& order : tree_order_pv_) {
+    if (!nets_[order.treeIndex]->isRouted()) {
+      net_ids.push_back(order.treeIndex);
+    }
+  }
 
-    if (nets_[netID]->isRouted())
-      continue;
+  if (num_threads_ > 1) {
+    // A net only reads and raises the 3D usage along its own routes, so
+    // nets with disjoint routes are assigned concurrently.
+    std::vector<odb::Rect> bounds(net_ids.size());
+    for (int i = 0; i < (int) net_ids.size(); i++) {
+      netRouteBounds(net_ids[i], 0, bounds[i]);
+    }
+    std::vector<LayerAssignWorkspace> workspaces(num_threads_);
+    for (LayerAssignWorkspace& ws : workspaces) {
+      initLayerAssignWorkspace(ws);
+    }
+    for (const std::vector<int>& batch : netBatches(bounds)) {
+      const int batch_size = batch.size();
+      utl::ThreadException exception;
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+      for (int i = 0; i < batch_size; i++) {
+        try {
+          assignNetLayers(net_ids[batch[i]],
+                          workspaces[omp_get_thread_num()]);
+        } catch (...) {
+          exception.capture();
+        }
+      }
+      exception.rethrow();
+    }
+  } else {
+    LayerAssignWorkspace ws;
+    initLayerAssignWorkspace(ws);
+    for (const int netID : net_ids) {
+      assignNetLayers(netID, ws);
+    }
+  }
+}
 
-    const auto& treeedges = sttrees_[netID].edges;
-    const auto& treenodes = sttrees_[netID].nodes;
-    const int num_terminals = sttrees_[netID].num_terminals;
+void FastRouteCore::initLayerAssignWorkspace(LayerAssignWorkspace& ws)
+{
+  ws.layer_grid.resize(boost::extents[num_layers_][MAXLEN]);
+  ws.via_link.resize(boost::extents[num_layers_][MAXLEN]);
+}
 
-    for (nodeID = 0; nodeID < num_terminals; nodeID++) {
-      for (k = 0; k < treenodes[nodeID].conCNT; k++) {
-        edgeID = treenodes[nodeID].eID[k];
-        if (!treeedges[edgeID].assigned) {
-          edgeQueue.push(edgeID);
-          treeedges[edgeID].assigned = true;
-        }
+void FastRouteCore::assignNetLayers(int netID, LayerAssignWorkspace& ws)
+{
+  int k, edgeID, nodeID, routeLen;
+  int n1, n2, connectionCNT;
+
+  int n1a, n2a;
+  std::queue<int> edgeQueue;
+
+  TreeEdge* treeedge;
+
+  const auto& treeedges = sttrees_[netID].edges;
+  const auto& treenodes = sttrees_[netID].nodes;
+  const int num_terminals = sttrees_[netID].num_terminals;
+
+  for (nodeID = 0; nodeID < num_terminals; nodeID++) {
+    for (k = 0; k < treenodes[nodeID].conCNT; k++) {
+      edgeID = treenodes[nodeID].eID[k];
+      if (!treeedges[edgeID].assigned) {
+        edgeQueue.push(edgeID);
+        treeedges[edgeID].assigned = true;
       }
     }
+  }
 
-    while (!edgeQueue.empty()) {
-      edgeID = edgeQueue.front();
-      edgeQueue.pop();
-      treeedge = &(treeedges[edgeID]);
-      if (treenodes[treeedge->n1a].assigned) {
-        assignEdge(netID, edgeID, 1);
-        treeedge->assigned = true;
-        if (!treenodes[treeedge->n2a].assigned) {
-          for (k = 0; k < treenodes[treeedge->n2a].conCNT; k++) {
-            edgeID = treenodes[treeedge->n2a].eID[k];
-            if (!treeedges[edgeID].assigned) {
-              edgeQueue.push(edgeID);
-              treeedges[edgeID].assigned = true;
-            }
+  while (!edgeQueue.empty()) {
+    edgeID = edgeQueue.front();
+    edgeQueue.pop();
+    treeedge = &(treeedges[edgeID]);
+    if (treenodes[treeedge->n1a].assigned) {
+      assignEdge(netID, edgeID, 1, ws);
+      treeedge->assigned = true;
+      if (!treenodes[treeedge->n2a].assigned) {
+        for (k = 0; k < treenodes[treeedge->n2a].conCNT; k++) {
+          edgeID = treenodes[treeedge->n2a].eID[k];
+          if (!treeedges[edgeID].assigned) {
+            edgeQueue.push(edgeID);
+            treeedges[edgeID].assigned = true;
           }
-          treenodes[treeedge->n2a].assigned = true;
         }
-      } else {
-        assignEdge(netID, edgeID, 0);
-        treeedge->assigned = true;
-        if (!treenodes[treeedge->n1a].assigned) {
-          for (k = 0; k < treenodes[treeedge->n1a].conCNT; k++) {
-            edgeID = treenodes[treeedge->n1a].eID[k];
-            if (!treeedges[edgeID].assigned) {
-              edgeQueue.push(edgeID);
-              treeedges[edgeID].assigned = true;
-            }
+        treenodes[treeedge->n2a].assigned = true;
+      }
+    } else {
+      assignEdge(netID, edgeID, 0, ws);
+      treeedge->assigned = true;
+      if (!treenodes[treeedge->n1a].assigned) {
+        for (k = 0; k < treenodes[treeedge->n1a].conCNT; k++) {
+          edgeID = treenodes[treeedge->n1a].eID[k];
+          if (!treeedges[edgeID].assigned) {
+            edgeQueue.push(edgeID);
+            treeedges[edgeID].assigned = true;
           }
-          treenodes[treeedge->n1a].assigned = true;
         }
+        treenodes[treeedge->n1a].assigned = true;
       }
     }
+  }
 
-    for (nodeID = 0; nodeID < sttrees_[netID].num_nodes; nodeID++) {
-      treenodes[nodeID].topL = -1;
-      treenodes[nodeID].botL = num_layers_;
-      treenodes[nodeID].conCNT = 0;
-      treenodes[nodeID].hID = BIG_INT;
-      treenodes[nodeID].lID = BIG_INT;
-      treenodes[nodeID].status = 0;
-      treenodes[nodeID].assigned = false;
+  for (nodeID = 0; nodeID < sttrees_[netID].num_nodes; nodeID++) {
+    treenodes[nodeID].topL = -1;
+    treenodes[nodeID].botL = num_layers_;
+    treenodes[nodeID].conCNT = 0;
+    treenodes[nodeID].hID = BIG_INT;
+    treenodes[nodeID].lID = BIG_INT;
+    treenodes[nodeID].status = 0;
+    treenodes[nodeID].assigned = false;
 
-      if (nodeID < num_terminals) {
-        treenodes[nodeID].botL = 0;
-        treenodes[nodeID].assigned = true;
-        treenodes[nodeID].status = 1;
-      }
+    if (nodeID < num_terminals) {
+      treenodes[nodeID].botL = 0;
+      treenodes[nodeID].assigned = true;
+      treenodes[nodeID].status = 1;
     }
+  }
 
-    for (edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
-      treeedge = &(treeedges[edgeID]);
+  for (edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
+    treeedge = &(treeedges[edgeID]);
 
-      if (treeedge->len > 0) {
-        routeLen = treeedge->route.routelen;
+    if (treeedge->len > 0) {
+      routeLen = treeedge->route.routelen;
 
-        n1 = treeedge->n1;
-        n2 = treeedge->n2;
-        const std::vector<short>& gridsL = treeedge->route.gridsL;
+      n1 = treeedge->n1;
+      n2 = treeedge->n2;
+      const std::vector<short>& gridsL = treeedge->route.gridsL;
 
-        n1a = treenodes[n1].stackAlias;
-        n2a = treenodes[n2].stackAlias;
-        connectionCNT = treenodes[n1a].conCNT;
-        treenodes[n1a].heights[connectionCNT] = gridsL[0];
-        treenodes[n1a].eID[connectionCNT] = edgeID;
-        treenodes[n1a].conCNT++;
+      n1a = treenodes[n1].stackAlias;
+      n2a = treenodes[n2].stackAlias;
+      connectionCNT = treenodes[n1a].conCNT;
+      treenodes[n1a].heights[connectionCNT] = gridsL[0];
+      treenodes[n1a].eID[connectionCNT] = edgeID;
+      treenodes[n1a].conCNT++;
 
-        if (gridsL[0] > treenodes[n1a].topL) {
-          treenodes[n1a].hID = edgeID;
-          treenodes[n1a].topL = gridsL[0];
-        }
-        if (gridsL[0] < treenodes[n1a].botL) {
-          treenodes[n1a].lID = edgeID;
-          treenodes[n1a].botL = gridsL[0];
-        }
+      if (gridsL[0] > treenodes[n1a].topL) {
+        treenodes[n1a].hID = edgeID;
+        treenodes[n1a].topL = gridsL[0];
+      }
+      if (gridsL[0] < treenodes[n1a].botL) {
+        treenodes[n1a].lID = edgeID;
+        treenodes[n1a].botL = gridsL[0];
+      }
 
-        treenodes[n1a].assigned = true;
+      treenodes[n1a].assigned = true;
 
-        connectionCNT = treenodes[n2a].conCNT;
-        treenodes[n2a].heights[connectionCNT] = gridsL[routeLen];
-        treenodes[n2a].eID[connectionCNT] = edgeID;
-        treenodes[n2a].conCNT++;
-        if (gridsL[routeLen] > treenodes[n2a].topL) {
-          treenodes[n2a].hID = edgeID;
-          treenodes[n2a].topL = gridsL[routeLen];
-        }
-        if (gridsL[routeLen] < treenodes[n2a].botL) {
-          treenodes[n2a].lID = edgeID;
-          treenodes[n2a].botL = gridsL[routeLen];
-        }
+      connectionCNT = treenodes[n2a].conCNT;
+      treenodes[n2a].heights[connectionCNT] = gridsL[routeLen];
+      treenodes[n2a].eID[connectionCNT] = edgeID;
+      treenodes[n2a].conCNT++;
+      if (gridsL[routeLen] > treenodes[n2a].topL) {
+        treenodes[n2a].hID = edgeID;
+        treenodes[n2a].topL = gridsL[routeLen];
+      }
+      if (gridsL[routeLen] < treenodes[n2a].botL) {
+        treenodes[n2a].lID = edgeID;
+        treenodes[n2a].botL = gridsL[routeLen];
+      }
 
-        treenodes[n2a].assigned = true;
+      treenodes[n2a].assigned = true;
 
-      }  // edge len > 0
-    }    // eunmerating edges
-  }
+    }  // edge len > 0
+  }    // eunmerating edges
 }
 
 void FastRouteCore::layerAssignment()
@@ -1184,7 +1266,7 @@ float FastRouteCore::CalculatePartialSlack()
   return slack_th;
 }
 
-void FastRouteCore::recoverEdge(int netID, int edgeID)
+void FastRouteCore::recoverEdge(int netID, int edgeID, Maze3DWorkspace& ws)
 {
   int i, ymin, xmin, n1a, n2a;
   int connectionCNT, routeLen;
@@ -1245,14 +1327,14 @@ void FastRouteCore::recoverEdge(int netID, int edgeID)
       {
         ymin = std::min(gridsY[i], gridsY[i + 1]);
         v_edges_[ymin][gridsX[i]].usage += net->getEdgeCost();
-        v_used_ggrid_.insert(std::make_pair(ymin, gridsX[i]));
+        ws.v_used.emplace_back(ymin, gridsX[i]);
         v_edges_3D_[gridsL[i]][ymin][gridsX[i]].usage
             += net->getLayerEdgeCost(gridsL[i]);
       } else if (gridsY[i] == gridsY[i + 1])  // a horizontal edge
       {
         xmin = std::min(gridsX[i], gridsX[i + 1]);
         h_edges_[gridsY[i]][xmin].usage += net->getEdgeCost();
-        h_used_ggrid_.insert(std::make_pair(gridsY[i], xmin));
+        ws.h_used.emplace_back(gridsY[i], xmin);
         h_edges_3D_[gridsL[i]][gridsY[i]][xmin].usage
             += net->getLayerEdgeCost(gridsL[i]);
       }
@@ -1534,20 +1616,21 @@ static bool compareEdgeLen(const OrderNetEdge a, const OrderNetEdge b)
   return a.length > b.length;
 }
 
-void FastRouteCore::netedgeOrderDec(int netID)
+void FastRouteCore::netedgeOrderDec(int netID,
+                                    std::vector<OrderNetEdge>& net_eo)
 {
   const int numTreeedges = sttrees_[netID].num_edges();
 
-  net_eo_.clear();
+  net_eo.clear();
 
   for (int j = 0; j < numTreeedges; j++) {
     OrderNetEdge orderNet;
     orderNet.length = sttrees_[netID].edges[j].route.routelen;
     orderNet.edgeID = j;
-    net_eo_.push_back(orderNet);
+    net_eo.push_back(orderNet);
   }
 
-  std::stable_sort(net_eo_.begin(), net_eo_.end(), compareEdgeLen);
+  std::stable_sort(net_eo.begin(), net_eo.end(), compareEdgeLen);
 }
 
 void FastRouteCore::printEdge2D(int netID, int edgeID)
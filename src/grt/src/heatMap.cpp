@@ -200,6 +200,9 @@ bool RoutingCongestionDataSource::populateMap()
   const uint y_grid_sz = y_grid.size();
 
   for (uint x_idx = 0; x_idx < gcell_congestion_data.numRows(); ++x_idx) {
+    if (isPopulateCancelled()) {
+      return false;
+    }
     for (uint y_idx = 0; y_idx < gcell_congestion_data.numCols(); ++y_idx) {
       const auto& cong_data = gcell_congestion_data(x_idx, y_idx);
 
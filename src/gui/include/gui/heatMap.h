@@ -33,10 +33,12 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <boost/multi_array.hpp>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <variant>
 #include <vector>
@@ -221,11 +223,17 @@ class HeatMapDataSource
 
   void setIssueRedraw(bool state) { issue_redraw_ = state; }
 
+  // True once the map has been invalidated while it is being populated.
+  // The partial result is discarded so populateMap may stop early.
+  bool isPopulateCancelled() const { return destroy_map_; }
+
  private:
   const std::string name_;
   const std::string short_name_;
   const std::string settings_group_;
-  bool destroy_map_;
+  // Set from the gui thread while the map is built on the render thread
+  std::atomic_bool destroy_map_;
+  std::mutex map_mutex_;
   bool use_dbu_;
 
   bool populated_;
@@ -38,6 +38,7 @@
 
 #include "heatMapSetup.h"
 #include "utl/Logger.h"
+#include "utl/timer.h"
 
 namespace gui {
 
@@ -123,10 +124,10 @@ void HeatMapDataSource::dumpToFile(const std::string& file)
   csv.close();
 }
 
+// The map is (re)built by the renderer on the render thread so changing
+// settings does not block the gui.
 void HeatMapDataSource::redraw()
 {
-  ensureMap();
-
   if (issue_redraw_) {
     renderer_->redraw();
   }
@@ -365,6 +366,10 @@ HeatMapDataSource::MapView HeatMapDataSource::getMapView(
 
 void HeatMapDataSource::addToMap(const odb::Rect& region, double value)
 {
+  if (isPopulateCancelled()) {
+    return;
+  }
+
   for (const auto& map_col : getMapView(region)) {
     for (const auto& map_pt : map_col) {
       odb::Rect intersection;
@@ -460,9 +465,11 @@ bool HeatMapDataSource::hasData() const
 
 void HeatMapDataSource::ensureMap()
 {
-  if (destroy_map_) {
+  // Requested by both the render thread and tcl commands
+  std::lock_guard<std::mutex> lock(map_mutex_);
+
+  if (destroy_map_.exchange(false)) {
     clearMap();
-    destroy_map_ = false;
   }
 
   const bool build_map = map_[0][0] == nullptr;
@@ -471,7 +478,20 @@ void HeatMapDataSource::ensureMap()
   }
 
   if (build_map || !isPopulated()) {
+    utl::Timer timer;
     populated_ = populateMap();
+    if (isPopulateCancelled()) {
+      // Settings changed during population so it will be rebuilt
+      populated_ = false;
+    }
+    debugPrint(logger_,
+               utl::GUI,
+               "heat_map",
+               1,
+               "{} populated: {} in {}",
+               name_,
+               populated_,
+               timer);
 
     if (isPopulated()) {
       correctMapScale(map_);
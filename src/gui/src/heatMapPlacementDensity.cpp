@@ -84,6 +84,9 @@ bool PlacementDensityDataSource::populateMap()
     const bool has_child_blocks = !current_block->getChildren().empty();
 
     for (auto* inst : current_block->getInsts()) {
+      if (isPopulateCancelled()) {
+        return false;
+      }
       if (!inst->getPlacementStatus().isPlaced()) {
         continue;
       }
@@ -33,10 +33,15 @@
 #include "renderThread.h"
 
 #include <QPainterPath>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
 
 #include "layoutViewer.h"
 #include "odb/dbShape.h"
 #include "odb/dbTransform.h"
+#include "ord/OpenRoad.hh"
 #include "painter.h"
 #include "utl/timer.h"
 
@@ -206,7 +211,17 @@ void RenderThread::draw(QImage& image,
     image.fill(background);
   }
 
-  drawBlock(&painter, viewer_->block_, dbu_bounds, 0);
+  // User renderers are not required to be thread safe so only split the
+  // block into concurrently drawn tiles when there are none.
+  const int min_tile_height = 64;
+  const int num_tiles
+      = std::min(ord::OpenRoad::openRoad()->getThreadCount(),
+                 image.height() / min_tile_height);
+  if (num_tiles > 1 && Gui::get()->renderers().empty()) {
+    drawBlockTiled(&painter, image, dbu_bounds, background, num_tiles);
+  } else {
+    drawBlock(&painter, viewer_->block_, dbu_bounds, dbu_bounds, 0);
+  }
 
   // draw selected and over top level and fast painting events
   drawSelected(gui_painter, selected);
@@ -215,6 +230,81 @@ void RenderThread::draw(QImage& image,
   drawRulers(gui_painter, rulers);
 }
 
+// Split the image into horizontal strips that are each drawn by their own
+// thread and painter and then copied into the image.
+void RenderThread::drawBlockTiled(QPainter* painter,
+                                  const QImage& image,
+                                  const Rect& view_bounds,
+                                  const QColor& background,
+                                  int num_tiles)
+{
+  utl::Timer timer;
+
+  const int width = image.width();
+  const QTransform xfm = painter->transform();
+  const QTransform inverse = xfm.inverted();
+
+  std::vector<int> tile_y(num_tiles + 1);
+  for (int i = 0; i <= num_tiles; i++) {
+    tile_y[i] = image.height() * static_cast<int64_t>(i) / num_tiles;
+  }
+
+  std::vector<QImage> tiles(num_tiles);
+  auto draw_tile = [&](int i) {
+    const int y = tile_y[i];
+    const int height = tile_y[i + 1] - y;
+    QImage& tile = tiles[i];
+    tile = QImage(width, height, image.format());
+    tile.fill(background);
+
+    QPainter tile_painter(&tile);
+    tile_painter.setRenderHints(QPainter::Antialiasing);
+    tile_painter.setTransform(xfm * QTransform::fromTranslate(0, -y));
+
+    // Pad by a pixel so shapes straddling a tile edge are found by
+    // both tiles.
+    const QRectF area
+        = inverse.mapRect(QRectF(-1, y - 1, width + 2, height + 2));
+    const Rect bounds(static_cast<int>(std::floor(area.left())),
+                      static_cast<int>(std::floor(area.top())),
+                      static_cast<int>(std::ceil(area.right())),
+                      static_cast<int>(std::ceil(area.bottom())));
+    drawBlock(&tile_painter, viewer_->block_, bounds, view_bounds, 0);
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_tiles - 1);
+  for (int i = 1; i < num_tiles; i++) {
+    threads.emplace_back(draw_tile, i);
+  }
+  draw_tile(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  painter->save();
+  painter->resetTransform();
+  painter->setCompositionMode(QPainter::CompositionMode_Source);
+  for (int i = 0; i < num_tiles; i++) {
+    painter->drawImage(0, tile_y[i], tiles[i]);
+  }
+  painter->restore();
+
+  debugPrint(
+      logger_, GUI, "draw", 1, "tiled render ({} tiles) {}", num_tiles, timer);
+}
+
+int RenderThread::cutMaximumSize(dbTechLayer* layer) const
+{
+  // Lookup without inserting as this is called from concurrent tiles
+  const auto& sizes = viewer_->cut_maximum_size_;
+  auto it = sizes.find(layer);
+  if (it == sizes.end()) {
+    return 0;
+  }
+  return it->second;
+}
+
 QColor RenderThread::getColor(dbTechLayer* layer)
 {
   return viewer_->options_->color(layer);
@@ -882,7 +972,7 @@ void RenderThread::drawLayer(QPainter* painter,
   // Skip the cut layer if the cuts will be too small to see
   const bool draw_shapes
       = !(layer->getType() == dbTechLayerType::CUT
-          && viewer_->cut_maximum_size_[layer] < shape_limit);
+          && cutMaximumSize(layer) < shape_limit);
 
   if (draw_shapes) {
     drawInstanceShapes(layer, painter, insts, bounds, gui_painter);
@@ -896,25 +986,40 @@ void RenderThread::drawLayer(QPainter* painter,
     Qt::BrushStyle brush_pattern = getPattern(layer);
     painter->setBrush(QBrush(color, brush_pattern));
     painter->setPen(QPen(color, 0));
-    auto box_iter = viewer_->search_.searchBoxShapes(block,
-                                                     layer,
-                                                     bounds.xMin(),
-                                                     bounds.yMin(),
-                                                     bounds.xMax(),
-                                                     bounds.yMax(),
-                                                     shape_limit);
-
-    for (auto& [box, net] : box_iter) {
-      if (restart_) {
-        break;
-      }
-      if (!viewer_->isNetVisible(net)) {
-        continue;
+
+    // When zoomed out far enough that the coverage raster is no coarser
+    // than a couple of pixels, draw it instead of every wire segment.
+    const double density_max_pixels = 2.0;
+    const Search::ShapeDensity* density = nullptr;
+    if (viewer_->focus_nets_.empty()
+        && !viewer_->options_->isDetailedVisibility()) {
+      density = viewer_->search_.searchBoxDensity(block, layer);
+    }
+    if (density != nullptr
+        && density->cell_size * viewer_->pixels_per_dbu_
+               <= density_max_pixels) {
+      drawShapeDensity(painter, *density, layer, bounds);
+    } else {
+      auto box_iter = viewer_->search_.searchBoxShapes(block,
+                                                       layer,
+                                                       bounds.xMin(),
+                                                       bounds.yMin(),
+                                                       bounds.xMax(),
+                                                       bounds.yMax(),
+                                                       shape_limit);
+
+      for (auto& [box, net] : box_iter) {
+        if (restart_) {
+          break;
+        }
+        if (!viewer_->isNetVisible(net)) {
+          continue;
+        }
+        const auto& ll = box.min_corner();
+        const auto& ur = box.max_corner();
+        painter->drawRect(
+            QRect(ll.x(), ll.y(), ur.x() - ll.x(), ur.y() - ll.y()));
       }
-      const auto& ll = box.min_corner();
-      const auto& ur = box.max_corner();
-      painter->drawRect(
-          QRect(ll.x(), ll.y(), ur.x() - ll.x(), ur.y() - ll.y()));
     }
 
     if (layer->getType() == dbTechLayerType::CUT) {
@@ -925,12 +1030,12 @@ void RenderThread::drawLayer(QPainter* painter,
       // will be too small based on the cut size (enclosure shapes
       // are generally only slightly larger).
       if (auto upper = layer->getUpperLayer()) {
-        if (viewer_->cut_maximum_size_[upper] >= shape_limit) {
+        if (cutMaximumSize(upper) >= shape_limit) {
           drawViaShapes(painter, block, upper, layer, bounds, shape_limit);
         }
       }
       if (auto lower = layer->getLowerLayer()) {
-        if (viewer_->cut_maximum_size_[lower] >= shape_limit) {
+        if (cutMaximumSize(lower) >= shape_limit) {
           drawViaShapes(painter, block, lower, layer, bounds, shape_limit);
         }
       }
@@ -1008,11 +1113,74 @@ void RenderThread::drawLayer(QPainter* painter,
              layer_timer);
 }
 
+// Draw the cells of the coverage raster that fall in bounds as one image
+// in the layer color with the alpha scaled by the coverage.
+void RenderThread::drawShapeDensity(QPainter* painter,
+                                    const Search::ShapeDensity& density,
+                                    dbTechLayer* layer,
+                                    const Rect& bounds)
+{
+  const Rect& extent = density.bounds;
+  const int cell_size = density.cell_size;
+  if (!bounds.intersects(extent)) {
+    return;
+  }
+
+  const int col_lo = std::max(0, (bounds.xMin() - extent.xMin()) / cell_size);
+  const int col_hi
+      = std::min(density.cols - 1, (bounds.xMax() - extent.xMin()) / cell_size);
+  const int row_lo = std::max(0, (bounds.yMin() - extent.yMin()) / cell_size);
+  const int row_hi
+      = std::min(density.rows - 1, (bounds.yMax() - extent.yMin()) / cell_size);
+  if (col_lo > col_hi || row_lo > row_hi) {
+    return;
+  }
+
+  const int width = col_hi - col_lo + 1;
+  const int height = row_hi - row_lo + 1;
+  QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+  image.fill(Qt::transparent);
+
+  const QColor color = getColor(layer);
+  for (const auto& [type, channel] : density.channels) {
+    if (restart_) {
+      return;
+    }
+    if (channel.net != nullptr && !viewer_->isNetVisible(channel.net)) {
+      continue;
+    }
+    for (int row = row_lo; row <= row_hi; row++) {
+      // Image rows run with the raster rows; the painter's transform
+      // flips them into place.
+      QRgb* pixels = reinterpret_cast<QRgb*>(image.scanLine(row - row_lo));
+      const uint8_t* coverage = &channel.coverage[row * density.cols];
+      for (int col = col_lo; col <= col_hi; col++) {
+        if (coverage[col] == 0) {
+          continue;
+        }
+        const int alpha = color.alpha() * coverage[col] / 255;
+        QRgb& pixel = pixels[col - col_lo];
+        if (alpha > qAlpha(pixel)) {
+          pixel = qPremultiply(
+              qRgba(color.red(), color.green(), color.blue(), alpha));
+        }
+      }
+    }
+  }
+
+  painter->drawImage(QRectF(extent.xMin() + col_lo * cell_size,
+                            extent.yMin() + row_lo * cell_size,
+                            width * cell_size,
+                            height * cell_size),
+                     image);
+}
+
 // Draw the region of the block.  Depth is not yet used but
 // is there for hierarchical design support.
 void RenderThread::drawBlock(QPainter* painter,
                              dbBlock* block,
                              const Rect& bounds,
+                             const Rect& view_bounds,
                              int depth)
 {
   utl::Timer timer;
@@ -1022,7 +1190,7 @@ void RenderThread::drawBlock(QPainter* painter,
 
   GuiPainter gui_painter(painter,
                          viewer_->options_,
-                         bounds,
+                         view_bounds,
                          viewer_->pixels_per_dbu_,
                          block->getDbUnitsPerMicron());
 
@@ -1126,7 +1294,7 @@ void RenderThread::drawBlock(QPainter* painter,
 
   utl::Timer inst_pin_markers;
   if (viewer_->options_->arePinMarkersVisible()) {
-    drawPinMarkers(gui_painter, block, bounds);
+    drawPinMarkers(gui_painter, block, view_bounds);
   }
   debugPrint(logger_, GUI, "draw", 1, "pin markers {}", inst_pin_markers);
 
@@ -41,6 +41,7 @@
 #include "gui/gui.h"
 #include "odb/db.h"
 #include "ruler.h"
+#include "search.h"
 #include "utl/Logger.h"
 
 namespace gui {
@@ -79,16 +80,28 @@ class RenderThread : public QThread
  private:
   void run() override;
 
+  // bounds is the area to draw while view_bounds is the whole area being
+  // rendered; they differ when drawing a single tile.
   void drawBlock(QPainter* painter,
                  odb::dbBlock* block,
                  const odb::Rect& bounds,
+                 const odb::Rect& view_bounds,
                  int depth);
+  void drawBlockTiled(QPainter* painter,
+                      const QImage& image,
+                      const odb::Rect& view_bounds,
+                      const QColor& background,
+                      int num_tiles);
   void drawLayer(QPainter* painter,
                  odb::dbBlock* block,
                  odb::dbTechLayer* layer,
                  const std::vector<odb::dbInst*>& insts,
                  const odb::Rect& bounds,
                  GuiPainter& gui_painter);
+  void drawShapeDensity(QPainter* painter,
+                        const Search::ShapeDensity& density,
+                        odb::dbTechLayer* layer,
+                        const odb::Rect& bounds);
   void drawRegions(QPainter* painter, odb::dbBlock* block);
   void drawTracks(odb::dbTechLayer* layer,
                   QPainter* painter,
@@ -144,6 +157,7 @@ class RenderThread : public QThread
   void drawRulers(Painter& painter, const Rulers& rulers);
 
   bool instanceBelowMinSize(odb::dbInst* inst);
+  int cutMaximumSize(odb::dbTechLayer* layer) const;
 
   void addInstTransform(QTransform& xfm, const odb::dbTransform& inst_xfm);
   QColor getColor(odb::dbTechLayer* layer);
@@ -32,10 +32,13 @@
 
 #include "search.h"
 
+#include <algorithm>
+#include <cmath>
 #include <tuple>
 #include <utility>
 
 #include "dbShape.h"
+#include "utl/ThreadPool.h"
 
 namespace gui {
 
@@ -54,29 +57,44 @@ void Search::inDbNetDestroy(odb::dbNet* net)
 void Search::inDbInstDestroy(odb::dbInst* inst)
 {
   if (inst->isPlaced()) {
-    clearInsts();
+    queueInst(inst, /* insert */ false);
+  }
+}
+
+void Search::inDbInstSwapMasterBefore(odb::dbInst* inst, odb::dbMaster* master)
+{
+  if (inst->isPlaced()) {
+    queueInst(inst, /* insert */ false);
   }
 }
 
 void Search::inDbInstSwapMasterAfter(odb::dbInst* inst)
 {
   if (inst->isPlaced()) {
-    clearInsts();
+    queueInst(inst, /* insert */ true);
   }
 }
 
 void Search::inDbInstPlacementStatusBefore(odb::dbInst* inst,
                                            const odb::dbPlacementStatus& status)
 {
-  if (inst->getPlacementStatus().isPlaced() != status.isPlaced()) {
-    clearInsts();
+  const bool was_placed = inst->getPlacementStatus().isPlaced();
+  if (was_placed != status.isPlaced()) {
+    queueInst(inst, /* insert */ !was_placed);
+  }
+}
+
+void Search::inDbPreMoveInst(odb::dbInst* inst)
+{
+  if (inst->isPlaced()) {
+    queueInst(inst, /* insert */ false);
   }
 }
 
 void Search::inDbPostMoveInst(odb::dbInst* inst)
 {
   if (inst->isPlaced()) {
-    clearInsts();
+    queueInst(inst, /* insert */ true);
   }
 }
 
@@ -87,7 +105,17 @@ void Search::inDbBPinDestroy(odb::dbBPin* pin)
 
 void Search::inDbFillCreate(odb::dbFill* fill)
 {
-  clearFills();
+  // Only the top block calls back
+  BlockData& data = top_block_data_;
+  odb::Rect rect;
+  fill->getRect(rect);
+  queueUpdate(data.fills_init_,
+              data.fills_init_mutex_,
+              data.fill_updates_,
+              fill->getTechLayer(),
+              convertRect(rect),
+              fill,
+              /* insert */ true);
 }
 
 void Search::inDbWireCreate(odb::dbWire* wire)
@@ -122,17 +150,40 @@ void Search::inDbSWireRemoveSBox(odb::dbSBox* box)
 
 void Search::inDbBlockageCreate(odb::dbBlockage* blockage)
 {
-  clearBlockages();
+  BlockData& data = getData(blockage->getBlock());
+  queueUpdate(data.blockages_init_,
+              data.blockages_init_mutex_,
+              data.blockage_updates_,
+              /* layer */ nullptr,
+              convertRect(blockage->getBBox()->getBox()),
+              blockage,
+              /* insert */ true);
 }
 
 void Search::inDbObstructionCreate(odb::dbObstruction* obs)
 {
-  clearObstructions();
+  BlockData& data = getData(obs->getBlock());
+  odb::dbBox* bbox = obs->getBBox();
+  queueUpdate(data.obstructions_init_,
+              data.obstructions_init_mutex_,
+              data.obstruction_updates_,
+              bbox->getTechLayer(),
+              convertRect(bbox->getBox()),
+              obs,
+              /* insert */ true);
 }
 
 void Search::inDbObstructionDestroy(odb::dbObstruction* obs)
 {
-  clearObstructions();
+  BlockData& data = getData(obs->getBlock());
+  odb::dbBox* bbox = obs->getBBox();
+  queueUpdate(data.obstructions_init_,
+              data.obstructions_init_mutex_,
+              data.obstruction_updates_,
+              bbox->getTechLayer(),
+              convertRect(bbox->getBox()),
+              obs,
+              /* insert */ false);
 }
 
 void Search::inDbBlockSetDieArea(odb::dbBlock* block)
@@ -152,12 +203,26 @@ void Search::inDbRegionDestroy(odb::dbRegion* region)
 
 void Search::inDbRowCreate(odb::dbRow* row)
 {
-  clearRows();
+  BlockData& data = getData(row->getBlock());
+  queueUpdate(data.rows_init_,
+              data.rows_init_mutex_,
+              data.row_updates_,
+              /* layer */ nullptr,
+              convertRect(row->getBBox()),
+              row,
+              /* insert */ true);
 }
 
 void Search::inDbRowDestroy(odb::dbRow* row)
 {
-  clearRows();
+  BlockData& data = getData(row->getBlock());
+  queueUpdate(data.rows_init_,
+              data.rows_init_mutex_,
+              data.row_updates_,
+              /* layer */ nullptr,
+              convertRect(row->getBBox()),
+              row,
+              /* insert */ false);
 }
 
 void Search::inDbWirePostModify(odb::dbWire* wire)
@@ -245,6 +310,85 @@ Search::BlockData& Search::getData(odb::dbBlock* block)
   return block == top_block_ ? top_block_data_ : child_block_data_[block];
 }
 
+template <typename T>
+void Search::queueUpdate(std::atomic_bool& init,
+                         std::mutex& init_mutex,
+                         PendingUpdates<T>& pending,
+                         odb::dbTechLayer* layer,
+                         const Box& box,
+                         T object,
+                         bool insert)
+{
+  if (!init) {
+    return;  // the next search loads the current state
+  }
+
+  std::lock_guard<std::mutex> lock(init_mutex);
+  // Past this many changes reloading in bulk is the cheaper update
+  const size_t min_reload_updates = 1024;
+  if (pending.updates.size()
+      >= std::max(min_reload_updates, pending.tree_size / 4)) {
+    pending.updates.clear();
+    pending.any = false;
+    announceModified(init);
+    return;
+  }
+
+  pending.updates.push_back({layer, {box, object}, insert});
+  if (!pending.any.exchange(true)) {
+    emit modified();
+  }
+}
+
+template <typename T, typename GetTree>
+void Search::applyUpdates(PendingUpdates<T>& pending, const GetTree& get_tree)
+{
+  for (const auto& update : pending.updates) {
+    auto& tree = get_tree(update.layer);
+    if (update.insert) {
+      tree.insert(update.value);
+      pending.tree_size++;
+    } else {
+      pending.tree_size -= tree.remove(update.value);
+    }
+  }
+  pending.updates.clear();
+  pending.any = false;
+}
+
+void Search::queueInst(odb::dbInst* inst, bool insert)
+{
+  BlockData& data = getData(inst->getBlock());
+  queueUpdate(data.insts_init_,
+              data.insts_init_mutex_,
+              data.inst_updates_,
+              /* layer */ nullptr,
+              convertRect(inst->getBBox()->getBox()),
+              inst,
+              insert);
+}
+
+// Bulk loads each layer's tree with the packing constructor, which is
+// much faster than inserting the values one at a time and gives better
+// trees.  The layers are independent so they are loaded concurrently.
+template <typename Value>
+void Search::packTrees(LayerValues<Value>& values, LayerTrees<Value>& trees)
+{
+  using Tree = typename LayerTrees<Value>::mapped_type;
+  std::vector<std::pair<std::vector<Value>*, Tree*>> layers;
+  for (auto& [layer, layer_values] : values) {
+    layers.emplace_back(&layer_values, &trees[layer]);
+  }
+  utl::ThreadPool::global()->parallelFor(
+      layers.size(),
+      [&](int i) {
+        auto& [layer_values, tree] = layers[i];
+        *tree = Tree(layer_values->begin(), layer_values->end());
+        std::vector<Value>().swap(*layer_values);
+      },
+      utl::GUI);
+}
+
 void Search::updateShapes(odb::dbBlock* block)
 {
   BlockData& data = getData(block);
@@ -256,10 +400,12 @@ void Search::updateShapes(odb::dbBlock* block)
   data.box_shapes_.clear();
   data.via_sbox_shapes_.clear();
   data.polygon_shapes_.clear();
+  data.box_density_.clear();
 
+  ShapeValues values;
   for (odb::dbNet* net : block->getNets()) {
-    addNet(net);
-    addSNet(net);
+    addNet(net, values);
+    addSNet(net, values);
   }
 
   for (odb::dbBTerm* term : block->getBTerms()) {
@@ -276,31 +422,121 @@ void Search::updateShapes(odb::dbBlock* block)
         Box bbox(Point(box->xMin(), box->yMin()),
                  Point(box->xMax(), box->yMax()));
         odb::dbTechLayer* layer = box->getTechLayer();
-        data.box_shapes_[layer].insert({bbox, term->getNet()});
+        values.boxes[layer].emplace_back(bbox, term->getNet());
       }
     }
   }
 
+  packTrees(values.boxes, data.box_shapes_);
+  packTrees(values.via_sboxes, data.via_sbox_shapes_);
+  packTrees(values.polygons, data.polygon_shapes_);
+
+  // Small layers draw quickly enough shape by shape
+  const size_t density_min_shapes = 100000;
+  std::vector<std::pair<const RtreeBox<odb::dbNet*>*, ShapeDensity*>> dense;
+  for (const auto& [layer, shapes] : data.box_shapes_) {
+    if (shapes.size() >= density_min_shapes) {
+      dense.emplace_back(&shapes, &data.box_density_[layer]);
+    }
+  }
+  utl::ThreadPool::global()->parallelFor(
+      dense.size(),
+      [&](int i) { buildDensity(*dense[i].first, *dense[i].second); },
+      utl::GUI);
+
   data.shapes_init_ = true;
 }
 
+void Search::buildDensity(const RtreeBox<odb::dbNet*>& shapes,
+                          ShapeDensity& density)
+{
+  // Cells along the longer side of the shapes' extent
+  const int density_cells = 1024;
+
+  const auto extent = shapes.bounds();
+  density.bounds = odb::Rect(bg::get<bg::min_corner, 0>(extent),
+                             bg::get<bg::min_corner, 1>(extent),
+                             bg::get<bg::max_corner, 0>(extent),
+                             bg::get<bg::max_corner, 1>(extent));
+  const int max_dim = std::max(density.bounds.dx(), density.bounds.dy());
+  const int cell_size
+      = std::max(1, (max_dim + density_cells - 1) / density_cells);
+  const int cols = density.bounds.dx() / cell_size + 1;
+  const int rows = density.bounds.dy() / cell_size + 1;
+  density.cell_size = cell_size;
+  density.cols = cols;
+  density.rows = rows;
+
+  const int x_origin = density.bounds.xMin();
+  const int y_origin = density.bounds.yMin();
+  const double cell_area = static_cast<double>(cell_size) * cell_size;
+
+  std::map<int, std::vector<float>> coverage;
+  for (const auto& [box, net] : shapes) {
+    const int key = net == nullptr ? -1 : net->getSigType().getValue();
+    auto& cells = coverage[key];
+    if (cells.empty()) {
+      cells.resize(static_cast<size_t>(cols) * rows, 0.0f);
+      density.channels[key].net = net;
+    }
+
+    const int x_lo = box.min_corner().x() - x_origin;
+    const int y_lo = box.min_corner().y() - y_origin;
+    const int x_hi = box.max_corner().x() - x_origin;
+    const int y_hi = box.max_corner().y() - y_origin;
+    for (int row = y_lo / cell_size; row <= y_hi / cell_size; row++) {
+      const int cell_y = row * cell_size;
+      const int dy = std::min(y_hi, cell_y + cell_size)
+                     - std::max(y_lo, cell_y);
+      for (int col = x_lo / cell_size; col <= x_hi / cell_size; col++) {
+        const int cell_x = col * cell_size;
+        const int dx = std::min(x_hi, cell_x + cell_size)
+                       - std::max(x_lo, cell_x);
+        cells[row * cols + col] += dx * static_cast<double>(dy) / cell_area;
+      }
+    }
+  }
+
+  for (auto& [key, cells] : coverage) {
+    auto& channel = density.channels[key].coverage;
+    channel.resize(cells.size());
+    for (size_t i = 0; i < cells.size(); i++) {
+      if (cells[i] <= 0.0f) {
+        channel[i] = 0;
+      } else {
+        // Keep any touched cell visible
+        channel[i] = std::clamp<int>(std::lround(cells[i] * 255), 1, 255);
+      }
+    }
+  }
+}
+
 void Search::updateFills(odb::dbBlock* block)
 {
   BlockData& data = getData(block);
   std::lock_guard<std::mutex> lock(data.fills_init_mutex_);
   if (data.fills_init_) {
-    return;  // already done by another thread
+    applyUpdates(data.fill_updates_, [&](odb::dbTechLayer* layer) -> auto& {
+      return data.fills_[layer];
+    });
+    return;
   }
 
   data.fills_.clear();
 
+  LayerValues<BoxValue<odb::dbFill*>> values;
+  size_t count = 0;
   for (odb::dbFill* fill : block->getFills()) {
     odb::Rect rect;
     fill->getRect(rect);
-    Box box(Point(rect.xMin(), rect.yMin()), Point(rect.xMax(), rect.yMax()));
-    data.fills_[fill->getTechLayer()].insert({box, fill});
+    values[fill->getTechLayer()].emplace_back(convertRect(rect), fill);
+    count++;
   }
+  packTrees(values, data.fills_);
 
+  data.fill_updates_.updates.clear();
+  data.fill_updates_.any = false;
+  data.fill_updates_.tree_size = count;
   data.fills_init_ = true;
 }
 
@@ -309,17 +545,22 @@ void Search::updateInsts(odb::dbBlock* block)
   BlockData& data = getData(block);
   std::lock_guard<std::mutex> lock(data.insts_init_mutex_);
   if (data.insts_init_) {
-    return;  // already done by another thread
+    applyUpdates(data.inst_updates_,
+                 [&](odb::dbTechLayer*) -> auto& { return data.insts_; });
+    return;
   }
 
-  data.insts_.clear();
-
+  std::vector<BoxValue<odb::dbInst*>> values;
   for (odb::dbInst* inst : block->getInsts()) {
     if (inst->isPlaced()) {
-      addInst(inst);
+      values.emplace_back(convertRect(inst->getBBox()->getBox()), inst);
     }
   }
+  data.insts_ = RtreeBox<odb::dbInst*>(values.begin(), values.end());
 
+  data.inst_updates_.updates.clear();
+  data.inst_updates_.any = false;
+  data.inst_updates_.tree_size = values.size();
   data.insts_init_ = true;
 }
 
@@ -328,15 +569,20 @@ void Search::updateBlockages(odb::dbBlock* block)
   BlockData& data = getData(block);
   std::lock_guard<std::mutex> lock(data.blockages_init_mutex_);
   if (data.blockages_init_) {
-    return;  // already done by another thread
+    applyUpdates(data.blockage_updates_,
+                 [&](odb::dbTechLayer*) -> auto& { return data.blockages_; });
+    return;
   }
 
-  data.blockages_.clear();
-
+  std::vector<BoxValue<odb::dbBlockage*>> values;
   for (odb::dbBlockage* blockage : block->getBlockages()) {
-    addBlockage(blockage);
+    values.emplace_back(convertRect(blockage->getBBox()->getBox()), blockage);
   }
+  data.blockages_ = RtreeBox<odb::dbBlockage*>(values.begin(), values.end());
 
+  data.blockage_updates_.updates.clear();
+  data.blockage_updates_.any = false;
+  data.blockage_updates_.tree_size = values.size();
   data.blockages_init_ = true;
 }
 
@@ -345,15 +591,27 @@ void Search::updateObstructions(odb::dbBlock* block)
   BlockData& data = getData(block);
   std::lock_guard<std::mutex> lock(data.obstructions_init_mutex_);
   if (data.obstructions_init_) {
-    return;  // already done by another thread
+    applyUpdates(data.obstruction_updates_,
+                 [&](odb::dbTechLayer* layer) -> auto& {
+                   return data.obstructions_[layer];
+                 });
+    return;
   }
 
   data.obstructions_.clear();
 
+  LayerValues<BoxValue<odb::dbObstruction*>> values;
+  size_t count = 0;
   for (odb::dbObstruction* obs : block->getObstructions()) {
-    addObstruction(obs);
+    odb::dbBox* bbox = obs->getBBox();
+    values[bbox->getTechLayer()].emplace_back(convertRect(bbox->getBox()), obs);
+    count++;
   }
+  packTrees(values, data.obstructions_);
 
+  data.obstruction_updates_.updates.clear();
+  data.obstruction_updates_.any = false;
+  data.obstruction_updates_.tree_size = count;
   data.obstructions_init_ = true;
 }
 
@@ -362,29 +620,36 @@ void Search::updateRows(odb::dbBlock* block)
   BlockData& data = getData(block);
   std::lock_guard<std::mutex> lock(data.rows_init_mutex_);
   if (data.rows_init_) {
-    return;  // already done by another thread
+    applyUpdates(data.row_updates_,
+                 [&](odb::dbTechLayer*) -> auto& { return data.rows_; });
+    return;
   }
 
-  data.rows_.clear();
-
+  std::vector<BoxValue<odb::dbRow*>> values;
   for (odb::dbRow* row : block->getRows()) {
-    addRow(row);
+    values.emplace_back(convertRect(row->getBBox()), row);
   }
+  data.rows_ = RtreeBox<odb::dbRow*>(values.begin(), values.end());
 
+  data.row_updates_.updates.clear();
+  data.row_updates_.any = false;
+  data.row_updates_.tree_size = values.size();
   data.rows_init_ = true;
 }
 
-void Search::addVia(odb::dbNet* net, odb::dbShape* shape, int x, int y)
+void Search::addVia(odb::dbNet* net,
+                    odb::dbShape* shape,
+                    int x,
+                    int y,
+                    ShapeValues& values)
 {
-  BlockData& data = getData(net->getBlock());
-
   if (shape->getType() == odb::dbShape::TECH_VIA) {
     odb::dbTechVia* via = shape->getTechVia();
     for (odb::dbBox* box : via->getBoxes()) {
       Point ll(x + box->xMin(), y + box->yMin());
       Point ur(x + box->xMax(), y + box->yMax());
       Box bbox(ll, ur);
-      data.box_shapes_[box->getTechLayer()].insert({bbox, net});
+      values.boxes[box->getTechLayer()].emplace_back(bbox, net);
     }
   } else {
     odb::dbVia* via = shape->getVia();
@@ -392,15 +657,13 @@ void Search::addVia(odb::dbNet* net, odb::dbShape* shape, int x, int y)
       Point ll(x + box->xMin(), y + box->yMin());
       Point ur(x + box->xMax(), y + box->yMax());
       Box bbox(ll, ur);
-      data.box_shapes_[box->getTechLayer()].insert({bbox, net});
+      values.boxes[box->getTechLayer()].emplace_back(bbox, net);
     }
   }
 }
 
-void Search::addSNet(odb::dbNet* net)
+void Search::addSNet(odb::dbNet* net, ShapeValues& values)
 {
-  BlockData& data = getData(net->getBlock());
-
   for (odb::dbSWire* swire : net->getSWires()) {
     for (odb::dbSBox* box : swire->getWires()) {
       if (box->isVia()) {
@@ -414,7 +677,7 @@ void Search::addSNet(odb::dbNet* net)
           auto block_via = box->getBlockVia();
           layer = block_via->getBottomLayer()->getUpperLayer();
         }
-        data.via_sbox_shapes_[layer].insert({geom_bbox, box, net});
+        values.via_sboxes[layer].emplace_back(geom_bbox, box, net);
       } else {
         Box bbox(Point(box->xMin(), box->yMin()),
                  Point(box->xMax(), box->yMax()));
@@ -429,72 +692,33 @@ void Search::addSNet(odb::dbNet* net)
         for (const auto& point : points) {
           bg::append(poly.outer(), Point(point.getX(), point.getY()));
         }
-        data.polygon_shapes_[box->getTechLayer()].insert({bbox, poly, net});
+        values.polygons[box->getTechLayer()].emplace_back(
+            bbox, std::move(poly), net);
       }
     }
   }
 }
 
-void Search::addNet(odb::dbNet* net)
+void Search::addNet(odb::dbNet* net, ShapeValues& values)
 {
   odb::dbWire* wire = net->getWire();
 
   if (wire == NULL)
     return;
 
-  BlockData& data = getData(net->getBlock());
-
   odb::dbWireShapeItr itr;
   odb::dbShape s;
 
   for (itr.begin(wire); itr.next(s);) {
     if (s.isVia()) {
-      addVia(net, &s, itr._prev_x, itr._prev_y);
+      addVia(net, &s, itr._prev_x, itr._prev_y, values);
     } else {
       Box box(Point(s.xMin(), s.yMin()), Point(s.xMax(), s.yMax()));
-      data.box_shapes_[s.getTechLayer()].insert({box, net});
+      values.boxes[s.getTechLayer()].emplace_back(box, net);
     }
   }
 }
 
-void Search::addInst(odb::dbInst* inst)
-{
-  BlockData& data = getData(inst->getBlock());
-  odb::dbBox* bbox = inst->getBBox();
-  Point ll(bbox->xMin(), bbox->yMin());
-  Point ur(bbox->xMax(), bbox->yMax());
-  Box box(ll, ur);
-  data.insts_.insert({box, inst});
-}
-
-void Search::addBlockage(odb::dbBlockage* blockage)
-{
-  BlockData& data = getData(blockage->getBlock());
-  odb::dbBox* bbox = blockage->getBBox();
-  Point ll(bbox->xMin(), bbox->yMin());
-  Point ur(bbox->xMax(), bbox->yMax());
-  Box box(ll, ur);
-  data.blockages_.insert({box, blockage});
-}
-
-void Search::addObstruction(odb::dbObstruction* obs)
-{
-  BlockData& data = getData(obs->getBlock());
-  odb::dbBox* bbox = obs->getBBox();
-  Point ll(bbox->xMin(), bbox->yMin());
-  Point ur(bbox->xMax(), bbox->yMax());
-  Box box(ll, ur);
-  data.obstructions_[bbox->getTechLayer()].insert({box, obs});
-}
-
-void Search::addRow(odb::dbRow* row)
-{
-  BlockData& data = getData(row->getBlock());
-  odb::Rect bbox = row->getBBox();
-  Box box = convertRect(bbox);
-  data.rows_.insert({box, row});
-}
-
 Search::Box Search::convertRect(const odb::Rect& box) const
 {
   Point ll(box.xMin(), box.yMin());
@@ -585,6 +809,22 @@ Search::BoxRange Search::searchBoxShapes(odb::dbBlock* block,
   return BoxRange(rtree.qbegin(bgi::intersects(query)), rtree.qend());
 }
 
+const Search::ShapeDensity* Search::searchBoxDensity(odb::dbBlock* block,
+                                                     odb::dbTechLayer* layer)
+{
+  BlockData& data = getData(block);
+  if (!data.shapes_init_) {
+    updateShapes(block);
+  }
+
+  auto it = data.box_density_.find(layer);
+  if (it == data.box_density_.end()) {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
 Search::SBoxRange Search::searchViaSBoxShapes(odb::dbBlock* block,
                                               odb::dbTechLayer* layer,
                                               int x_lo,
@@ -657,7 +897,7 @@ Search::FillRange Search::searchFills(odb::dbBlock* block,
                                       int min_size)
 {
   BlockData& data = getData(block);
-  if (!data.fills_init_) {
+  if (!data.fills_init_ || data.fill_updates_.any) {
     updateFills(block);
   }
 
@@ -687,7 +927,7 @@ Search::InstRange Search::searchInsts(odb::dbBlock* block,
                                       int min_height)
 {
   BlockData& data = getData(block);
-  if (!data.insts_init_) {
+  if (!data.insts_init_ || data.inst_updates_.any) {
     updateInsts(block);
   }
 
@@ -712,7 +952,7 @@ Search::BlockageRange Search::searchBlockages(odb::dbBlock* block,
                                               int min_height)
 {
   BlockData& data = getData(block);
-  if (!data.blockages_init_) {
+  if (!data.blockages_init_ || data.blockage_updates_.any) {
     updateBlockages(block);
   }
 
@@ -739,7 +979,7 @@ Search::ObstructionRange Search::searchObstructions(odb::dbBlock* block,
                                                     int min_size)
 {
   BlockData& data = getData(block);
-  if (!data.obstructions_init_) {
+  if (!data.obstructions_init_ || data.obstruction_updates_.any) {
     updateObstructions(block);
   }
 
@@ -769,7 +1009,7 @@ Search::RowRange Search::searchRows(odb::dbBlock* block,
                                     int min_height)
 {
   BlockData& data = getData(block);
-  if (!data.rows_init_) {
+  if (!data.rows_init_ || data.row_updates_.any) {
     updateRows(block);
   }
 
@@ -33,9 +33,13 @@
 #pragma once
 
 #include <QObject>
+#include <atomic>
 #include <boost/geometry.hpp>
 #include <boost/geometry/index/rtree.hpp>
+#include <cstdint>
+#include <map>
 #include <mutex>
+#include <vector>
 
 #include "odb/db.h"
 #include "odb/dbBlockCallBackObj.h"
@@ -50,8 +54,9 @@ namespace bgi = boost::geometry::index;
 // rtree.  OpenDB also has some code for this purpose but I
 // find it confusing so just made a simpler solution for now.
 //
-// Currently this class is static once built and doesn't follow
-// db changes.  TODO: this should be into an observer of OpenDB.
+// Each structure is bulk loaded on its first search.  Instances,
+// fills, blockages, obstructions and rows then follow db changes
+// incrementally; shapes are reloaded after any wire change.
 class Search : public QObject, public odb::dbBlockCallBackObj
 {
   Q_OBJECT
@@ -109,6 +114,26 @@ class Search : public QObject, public odb::dbBlockCallBackObj
   using BlockageRange = Range<RtreeBox<odb::dbBlockage*>>;
   using RowRange = Range<RtreeBox<odb::dbRow*>>;
 
+  // A coarse raster of how much of each cell is covered by the box shapes
+  // on a layer, drawn instead of the shapes in zoomed out views.  Coverage
+  // is kept per net signal type so net visibility can still be applied;
+  // the channel's net is any net of that type (nullptr for unconnected
+  // shapes).
+  struct ShapeDensity
+  {
+    struct Channel
+    {
+      odb::dbNet* net = nullptr;
+      std::vector<uint8_t> coverage;  // row major from the lower left
+    };
+
+    odb::Rect bounds;
+    int cell_size = 0;
+    int cols = 0;
+    int rows = 0;
+    std::map<int, Channel> channels;  // by dbSigType value, -1 for no net
+  };
+
   ~Search();
 
   // Build the structure for the given block.
@@ -124,6 +149,11 @@ class Search : public QObject, public odb::dbBlockCallBackObj
                            int y_hi,
                            int min_size = 0);
 
+  // Get the coverage raster of the box shapes on the given layer or
+  // nullptr if the layer has too few shapes to warrant one.
+  const ShapeDensity* searchBoxDensity(odb::dbBlock* block,
+                                       odb::dbTechLayer* layer);
+
   // Find all via sbox shapes in the given bounds on the given layer which
   // are at least min_size in either dimension.
   SBoxRange searchViaSBoxShapes(odb::dbBlock* block,
@@ -198,10 +228,13 @@ class Search : public QObject, public odb::dbBlockCallBackObj
   // From dbBlockCallBackObj
   virtual void inDbNetDestroy(odb::dbNet* net) override;
   virtual void inDbInstDestroy(odb::dbInst* inst) override;
+  virtual void inDbInstSwapMasterBefore(odb::dbInst* inst,
+                                        odb::dbMaster* master) override;
   virtual void inDbInstSwapMasterAfter(odb::dbInst* inst) override;
   virtual void inDbInstPlacementStatusBefore(
       odb::dbInst* inst,
       const odb::dbPlacementStatus& status) override;
+  virtual void inDbPreMoveInst(odb::dbInst* inst) override;
   virtual void inDbPostMoveInst(odb::dbInst* inst) override;
   virtual void inDbBPinDestroy(odb::dbBPin* pin) override;
   virtual void inDbFillCreate(odb::dbFill* fill) override;
@@ -228,15 +261,62 @@ class Search : public QObject, public odb::dbBlockCallBackObj
  private:
   struct BlockData;
 
-  void addSNet(odb::dbNet* net);
-  void addNet(odb::dbNet* net);
-  void addVia(odb::dbNet* net, odb::dbShape* shape, int x, int y);
-  void addInst(odb::dbInst* inst);
-  void addBlockage(odb::dbBlockage* blockage);
-  void addObstruction(odb::dbObstruction* obstruction);
-  void addRow(odb::dbRow* row);
+  template <typename Value>
+  using LayerValues = std::map<odb::dbTechLayer*, std::vector<Value>>;
+  template <typename Value>
+  using LayerTrees
+      = std::map<odb::dbTechLayer*, bgi::rtree<Value, bgi::quadratic<16>>>;
+
+  // Shapes gathered from the block before the trees are bulk loaded.
+  struct ShapeValues
+  {
+    LayerValues<BoxValue<odb::dbNet*>> boxes;
+    LayerValues<SBoxValue<odb::dbNet*>> via_sboxes;
+    LayerValues<PolygonValue<odb::dbNet*>> polygons;
+  };
+
+  // Changes to a built tree queued by the db callbacks.  The next search
+  // applies them so that, as with a reload, the trees are only modified
+  // by the searching thread.
+  template <typename T>
+  struct PendingUpdates
+  {
+    struct Update
+    {
+      odb::dbTechLayer* layer;  // nullptr for trees without layers
+      BoxValue<T> value;
+      bool insert;
+    };
+    std::vector<Update> updates;
+    std::atomic_bool any{false};
+    size_t tree_size = 0;  // values in the tree(s) once updated
+  };
+
+  void addSNet(odb::dbNet* net, ShapeValues& values);
+  void addNet(odb::dbNet* net, ShapeValues& values);
+  void addVia(odb::dbNet* net,
+              odb::dbShape* shape,
+              int x,
+              int y,
+              ShapeValues& values);
+
+  template <typename Value>
+  static void packTrees(LayerValues<Value>& values, LayerTrees<Value>& trees);
+  template <typename T>
+  void queueUpdate(std::atomic_bool& init,
+                   std::mutex& init_mutex,
+                   PendingUpdates<T>& pending,
+                   odb::dbTechLayer* layer,
+                   const Box& box,
+                   T object,
+                   bool insert);
+  template <typename T, typename GetTree>
+  static void applyUpdates(PendingUpdates<T>& pending, const GetTree& get_tree);
+  void queueInst(odb::dbInst* inst, bool insert);
 
   void updateShapes(odb::dbBlock* block);
+  void buildDensity(const RtreeBox<odb::dbNet*>& shapes,
+                    ShapeDensity& density);
   void updateFills(odb::dbBlock* block);
   void updateInsts(odb::dbBlock* block);
   void updateBlockages(odb::dbBlock* block);
@@ -261,23 +341,29 @@ class Search : public QObject, public odb::dbBlockCallBackObj
     // particularly true when you have parallel straps like m1 & m2 in asap7.
     std::map<odb::dbTechLayer*, RtreeSBox<odb::dbNet*>> via_sbox_shapes_;
     std::map<odb::dbTechLayer*, RtreePolygon<odb::dbNet*>> polygon_shapes_;
+    std::map<odb::dbTechLayer*, ShapeDensity> box_density_;
     std::atomic_bool shapes_init_{false};
     std::mutex shapes_init_mutex_;
     std::map<odb::dbTechLayer*, RtreeBox<odb::dbFill*>> fills_;
     std::atomic_bool fills_init_{false};
     std::mutex fills_init_mutex_;
+    PendingUpdates<odb::dbFill*> fill_updates_;
     RtreeBox<odb::dbInst*> insts_;
     std::atomic_bool insts_init_{false};
     std::mutex insts_init_mutex_;
+    PendingUpdates<odb::dbInst*> inst_updates_;
     RtreeBox<odb::dbBlockage*> blockages_;
     std::atomic_bool blockages_init_{false};
     std::mutex blockages_init_mutex_;
+    PendingUpdates<odb::dbBlockage*> blockage_updates_;
     std::map<odb::dbTechLayer*, RtreeBox<odb::dbObstruction*>> obstructions_;
     std::atomic_bool obstructions_init_{false};
     std::mutex obstructions_init_mutex_;
+    PendingUpdates<odb::dbObstruction*> obstruction_updates_;
     RtreeBox<odb::dbRow*> rows_;
     std::atomic_bool rows_init_{false};
     std::mutex rows_init_mutex_;
+    PendingUpdates<odb::dbRow*> row_updates_;
   };
   std::map<odb::dbBlock*, BlockData> child_block_data_;
   BlockData top_block_data_;
@@ -49,6 +49,7 @@ class dbDatabase;
 class dbMTerm;
 class dbSite;
 class dbTechLayer;
+class dbTrackGrid;
 class Rect;
 }  // namespace odb
 
@@ -112,6 +113,12 @@ class InitFloorplan
                int factor,
                int row_index);
   void makeTracks(const char* tracks_file, odb::Rect& die_area);
+  void addTrackPatterns(odb::dbTechLayer* layer,
+                        odb::dbTrackGrid*& grid,
+                        int x_offset,
+                        int x_pitch,
+                        int y_offset,
+                        int y_pitch);
   void autoPlacePins(odb::dbTechLayer* pin_layer, odb::Rect& core);
   int snapToMfgGrid(int coord) const;
   void updateVoltageDomain(int core_lx, int core_ly, int core_ux, int core_uy);
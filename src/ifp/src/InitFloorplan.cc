@@ -191,19 +191,25 @@ void InitFloorplan::initFloorplan(const odb::Rect& die,
   if (core.xMin() >= 0 && core.yMin() >= 0) {
     int row_index = 0;
     eval_upf(network_, logger_, block_);
+
+    // Destroy any existing rows of the sites being placed in one pass over
+    // the rows rather than one pass per site.
+    std::set<dbSite*> row_sites;
     for (const auto& [site_name, site] : sites_by_name) {
-      // Destroy any existing rows.
-      int x_height_site = site->getHeight() / min_site_height;
-      auto rows = block_->getRows();
-      for (dbSet<dbRow>::iterator row_itr = rows.begin();
-           row_itr != rows.end();) {
-        if (site != row_itr->getSite()) {
-          row_itr++;
-        } else {
-          row_itr = dbRow::destroy(row_itr);
-        }
+      row_sites.insert(site);
+    }
+    auto rows = block_->getRows();
+    for (dbSet<dbRow>::iterator row_itr = rows.begin();
+         row_itr != rows.end();) {
+      if (row_sites.find(row_itr->getSite()) == row_sites.end()) {
+        row_itr++;
+      } else {
+        row_itr = dbRow::destroy(row_itr);
       }
+    }
 
+    for (const auto& [site_name, site] : sites_by_name) {
+      int x_height_site = site->getHeight() / min_site_height;
       uint site_dx = site->getWidth();
       uint site_dy = site->getHeight();
       // core lower left corner to multiple of site dx/dy.
@@ -455,11 +461,12 @@ int InitFloorplan::makeRows(dbSite* site,
   int rows_y = core_dy / site_dy;
 
   int y = core_ly;
+  string row_name;
   for (int row = 0; row < rows_y; row++) {
     dbOrientType orient = (factor % 2 == 0 or row % 2 == 0)
                               ? dbOrientType::R0   // N
                               : dbOrientType::MX;  // FS
-    string row_name = stdstrPrint("ROW_%d", row_index + row);
+    row_name = "ROW_" + std::to_string(row_index + row);
     dbRow::create(block_,
                   row_name.c_str(),
                   site,
@@ -538,8 +545,9 @@ void InitFloorplan::insertTiecells(odb::dbMTerm* tie_term,
                    master->getName());
   }
 
-  int count = 0;
-
+  // Collect the tie nets first so the instance table can be sized once
+  // before any tie cell is created.
+  std::vector<odb::dbNet*> tie_nets;
   for (auto* net : block_->getNets()) {
     if (net->isSpecial()) {
       continue;
@@ -547,20 +555,26 @@ void InitFloorplan::insertTiecells(odb::dbMTerm* tie_term,
     if (look_for != net->getSigType()) {
       continue;
     }
+    tie_nets.push_back(net);
+  }
+
+  block_->reserveInsts(block_->getInsts().size() + tie_nets.size());
 
-    const std::string inst_name = prefix + net->getName();
+  std::string inst_name = prefix;
+  for (auto* net : tie_nets) {
+    inst_name.resize(prefix.size());
+    inst_name += net->getName();
 
     auto* inst = odb::dbInst::create(block_, master, inst_name.c_str());
-    auto* iterm = inst->findITerm(tie_term->getConstName());
+    auto* iterm = inst->getITerm(tie_term);
     iterm->connect(net);
     net->setSigType(odb::dbSigType::SIGNAL);
-    count++;
   }
 
   logger_->info(utl::IFP,
                 30,
                 "Inserted {} tiecells using {}/{}.",
-                count,
+                tie_nets.size(),
                 master->getName(),
                 tie_term->getName());
 }
@@ -601,6 +615,19 @@ void InitFloorplan::makeTracks(odb::dbTechLayer* layer,
   v.check_non_negative("y_offset", y_offset, 41);
   v.check_positive("y_pitch", y_pitch, 42);
 
+  dbTrackGrid* grid = nullptr;
+  addTrackPatterns(layer, grid, x_offset, x_pitch, y_offset, y_pitch);
+}
+
+// grid is looked up (or created) on the first pattern that is not skipped
+// and reused by the caller for any further patterns on the same layer.
+void InitFloorplan::addTrackPatterns(odb::dbTechLayer* layer,
+                                     odb::dbTrackGrid*& grid,
+                                     int x_offset,
+                                     int x_pitch,
+                                     int y_offset,
+                                     int y_pitch)
+{
   Rect die_area = block_->getDieArea();
 
   if (x_offset == 0) {
@@ -627,9 +654,11 @@ void InitFloorplan::makeTracks(odb::dbTechLayer* layer,
     return;
   }
 
-  auto grid = block_->findTrackGrid(layer);
   if (!grid) {
-    grid = dbTrackGrid::create(block_, layer);
+    grid = block_->findTrackGrid(layer);
+    if (!grid) {
+      grid = dbTrackGrid::create(block_, layer);
+    }
   }
 
   int layer_min_width = layer->getMinWidth();
@@ -697,12 +726,23 @@ void InitFloorplan::makeTracksNonUniform(odb::dbTechLayer* layer,
   auto y_track_count
       = int((cell_row_height - 2 * first_last_pitch) / y_pitch) + 1;
   int origin_y = die_area.yMin() + first_last_pitch;
+
+  // The argument checks and grid lookup are shared by every row pattern;
+  // origin_y only grows from here.
+  utl::Validator v(logger_, IFP);
+  v.check_non_negative("x_offset", x_offset, 39);
+  v.check_positive("x_pitch", x_pitch, 40);
+  v.check_non_negative("y_offset", origin_y, 41);
+  v.check_positive("y_pitch", cell_row_height, 42);
+
+  dbTrackGrid* grid = nullptr;
   for (int i = 0; i < y_track_count; i++) {
-    makeTracks(layer, x_offset, x_pitch, origin_y, cell_row_height);
+    addTrackPatterns(
+        layer, grid, x_offset, x_pitch, origin_y, cell_row_height);
     origin_y += y_pitch;
   }
   origin_y += first_last_pitch - y_pitch;
-  makeTracks(layer, x_offset, x_pitch, origin_y, cell_row_height);
+  addTrackPatterns(layer, grid, x_offset, x_pitch, origin_y, cell_row_height);
 }
 
 }  // namespace ifp
@@ -43,6 +43,7 @@ class Logger;
 }
 
 namespace parquetfp {
+class DB;
 class Nets;
 }
 
@@ -101,6 +102,10 @@ class Partition
   vector<double> net_tbl_;
 
  private:
+  bool annealStart(int seed,
+                   pfp::DB& db,
+                   double& soln_width,
+                   double& soln_height);
   string getName(int macroIdx);
   int globalIndex(int macro_idx);
   void makePins(int macro_idx1,
@@ -111,6 +116,11 @@ class Partition
 
   utl::Logger* logger_;
   MacroPlacer* macro_placer_;
+
+  // Seed of the first ParquetFP start and how many more are tried if it
+  // doesn't fit
+  static constexpr int first_seed_ = 100;
+  static constexpr int extra_starts_ = 3;
 };
 
 }  // namespace mpl
@@ -50,6 +50,7 @@
 #include "sta/Sequential.hh"
 #include "sta/Sta.hh"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 namespace mpl {
 
@@ -408,6 +409,28 @@ void MacroPlacer::placeMacrosCornerMaxWl()
     graphics = std::make_unique<Graphics>(db_);
   }
 
+  // The partitions don't depend on each other's placement so they are
+  // all annealed up front, concurrently.
+  std::vector<std::vector<char>> annealed(allSets.size());
+  std::vector<std::pair<int, int>> anneal_tasks;
+  for (size_t i = 0; i < allSets.size(); i++) {
+    // skip for top partition
+    if (allSets[i].size() == 1) {
+      continue;
+    }
+    annealed[i].resize(allSets[i].size());
+    for (size_t j = 0; j < allSets[i].size(); j++) {
+      anneal_tasks.emplace_back(i, j);
+    }
+  }
+  utl::ThreadPool::global()->parallelFor(
+      anneal_tasks.size(),
+      [&](const int task) {
+        const auto [i, j] = anneal_tasks[task];
+        annealed[i][j] = allSets[i][j].anneal();
+      },
+      MPL);
+
   solution_count_ = 0;
   bool found_best = false;
   int best_setIdx = 0;
@@ -424,10 +447,12 @@ void MacroPlacer::placeMacrosCornerMaxWl()
     }
 
     // For each of the 4 partitions
+    const std::vector<char>& set_annealed
+        = annealed[&partition_set - &allSets[0]];
     bool isFailed = false;
     for (auto& curPart : partition_set) {
       // Annealing based on ParquetFP Engine
-      bool success = curPart.anneal();
+      bool success = set_annealed[&curPart - &partition_set[0]];
       if (!success) {
         logger_->warn(
             MPL,
@@ -87,8 +87,7 @@ BaseAnnealer::BaseAnnealer(const parquetfp::Command_Line* const params,
   // set the random seed for each invokation of the Annealer
   unsigned seed = _params->seed;
 
-  srand(seed);             // seed for rand function
-  _random_gen.seed(seed);  // seed for shuffle
+  _random_gen.seed(seed);  // seed for randInt and shuffle
 
   _baseFileName = _params->inFileName;
   annealTime = 0.0;
@@ -33,6 +33,7 @@
 #ifndef BASEANNEALER_H
 #define BASEANNEALER_H
 
+#include <cstdlib>
 #include <random>
 #include <string>
 
@@ -119,7 +120,11 @@ class BaseAnnealer
   const float _outlineWidth;
   const float _outlineHeight;
   std::random_device _rd;
-  std::mt19937 _random_gen;
+  mutable std::mt19937 _random_gen;
+
+  // replaces rand() so that annealers can run concurrently and each
+  // one only depends on its own seed
+  inline int randInt() const;
 
   BaseAnnealer()
       : annealTime(0),
@@ -161,5 +166,10 @@ inline float BaseAnnealer::outlineHeight() const
   return _outlineHeight;
 }
 // --------------------------------------------------------
+inline int BaseAnnealer::randInt() const
+{
+  return std::uniform_int_distribution<int>(0, RAND_MAX)(_random_gen);
+}
+// --------------------------------------------------------
 
 #endif
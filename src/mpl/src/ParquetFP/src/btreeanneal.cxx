@@ -542,8 +542,8 @@ bool BTreeAreaWireAnnealer::anneal()
 
       // -----select the types of moves here-----
       if (_params->softBlocks && currTime < 50)
-        masterMoveSel = rand() % 1000;
-      moveSelect = rand() % 1000;
+        masterMoveSel = randInt() % 1000;
+      moveSelect = randInt() % 1000;
 
       // -----take action-----
       int indexOrient = UNSIGNED_UNINITIALIZED;
@@ -777,7 +777,7 @@ bool BTreeAreaWireAnnealer::anneal()
       else if (currTime > _params->timeCool)
       // become greedy below time > timeCool
       {
-        float ran = rand() % 10000;
+        float ran = randInt() % 10000;
         float r = float(ran) / 9999;
         if (r < exp(-1 * delta / currTime))
           moveAccepted = true;
@@ -1140,20 +1140,18 @@ int BTreeAreaWireAnnealer::makeMove(int& indexOrient,
 int BTreeAreaWireAnnealer::makeMoveSlacks()
 {
   //  cout << "makeMoveSlacks" << endl;
-  int movedir = rand() % 100;
+  int movedir = randInt() % 100;
   int threshold = 50;
   bool horizontal = (movedir < threshold);
 
   makeMoveSlacksCore(horizontal);
 
-  static int total = 0;
-  static int numHoriz = 0;
+  _numSlackMoves++;
+  _numHorizSlackMoves += ((horizontal) ? 1 : 0);
 
-  total++;
-  numHoriz += ((horizontal) ? 1 : 0);
-
-  if (total % 1000 == 0 && _params->verb > 0)
-    cout << "total: " << total << "horiz: " << numHoriz << endl;
+  if (_numSlackMoves % 1000 == 0 && _params->verb > 0)
+    cout << "total: " << _numSlackMoves << "horiz: " << _numHorizSlackMoves
+         << endl;
   return SLACKS_MOVE;
 }
 // --------------------------------------------------------
@@ -1186,14 +1184,14 @@ void BTreeAreaWireAnnealer::makeMoveSlacksCore(bool horizontal)
   int blocknum = in_curr_solution.NUM_BLOCKS;
   int range = int(ceil(blocknum / 5.0));
 
-  int operand_ptr = rand() % range;
+  int operand_ptr = randInt() % range;
   int operand = indices_sorted[operand_ptr];
   while (operand_ptr > 0 && slacks[operand] > 0) {
     operand_ptr--;
     operand = indices_sorted[operand_ptr];
   }
 
-  int target_ptr = blocknum - 1 - (rand() % range);
+  int target_ptr = blocknum - 1 - (randInt() % range);
   int target = indices_sorted[target_ptr];
   while (target_ptr < (blocknum - 1) && slacks[target] <= 0) {
     target_ptr++;
@@ -1211,22 +1209,22 @@ int BTreeAreaWireAnnealer::makeHPWLMove()
 {
   //  cout << "makeHPWLMove" << endl;
   int size = in_curr_solution.NUM_BLOCKS;
-  int operand = rand() % size;
+  int operand = randInt() % size;
   int target = UNSIGNED_UNINITIALIZED;
 
   vector<int> searchBlocks;
   locateSearchBlocks(operand, searchBlocks);
 
   if (searchBlocks.size() > 0) {
-    int temp = rand() % searchBlocks.size();
+    int temp = randInt() % searchBlocks.size();
     target = searchBlocks[temp];
   } else {
     do
-      target = rand() % size;
+      target = randInt() % size;
     while (target == operand);
   }
 
-  bool leftChild = bool(rand() % 2);
+  bool leftChild = bool(randInt() % 2);
   in_next_solution = in_curr_solution;
   in_next_solution.move(operand, target, leftChild);
   return HPWL;
@@ -1261,7 +1259,7 @@ int BTreeAreaWireAnnealer::makeARWLMove()
   int blocknum = in_curr_solution.NUM_BLOCKS;
   int range = int(ceil(blocknum / 5.0));
 
-  int operand_ptr = rand() % range;
+  int operand_ptr = randInt() % range;
   int operand = indices_sorted[operand_ptr];
   while (operand_ptr > 0 && slacks[operand] > 0) {
     operand_ptr--;
@@ -1275,7 +1273,7 @@ int BTreeAreaWireAnnealer::makeARWLMove()
   float maxSlack = -1;
   if (searchBlocks.size() == 0) {
     do
-      target = rand() % blocknum;
+      target = randInt() % blocknum;
     while (target == operand);
   } else {
     for (unsigned int i = 0; i < searchBlocks.size(); i++) {
@@ -1311,7 +1309,7 @@ int BTreeAreaWireAnnealer::makeSoftBlMove(int& index,
 {
   _slackEval->evaluateSlacks(in_curr_solution);
 
-  int moveDir = rand() % 2;
+  int moveDir = randInt() % 2;
   bool horizontal = (moveDir % 2 == 0);
   index = getSoftBlIndex(horizontal);
 
@@ -1527,7 +1525,7 @@ void BTreeAreaWireAnnealer::GenerateRandomSoln(BTree& soln, int blocknum)
   int balance = 0;
   int num_zeros = 0;
   for (int i = 0; i < 2 * blocknum; i++) {
-    float rand_num = float(rand()) / (RAND_MAX + 1.0);
+    float rand_num = float(randInt()) / (RAND_MAX + 1.0);
     float threshold;
 
     if (balance == 0)
@@ -1559,7 +1557,7 @@ void BTreeAreaWireAnnealer::GenerateRandomSoln(BTree& soln, int blocknum)
 
   vector<int> tree_orient(blocknum);
   for (int i = 0; i < blocknum; i++) {
-    int rand_num = int(8 * (float(rand()) / (RAND_MAX + 1.0)));
+    int rand_num = int(8 * (float(randInt()) / (RAND_MAX + 1.0)));
     rand_num = _physicalOrient[i][rand_num];
 
     tree_orient[tree_perm_inverse[i]] = rand_num;
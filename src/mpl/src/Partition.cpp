@@ -33,10 +33,14 @@
 
 #include "mpl/Partition.h"
 
+#include <algorithm>
+#include <memory>
+
 #include "btreeanneal.h"
 #include "mixedpackingfromdb.h"
 #include "mpl/MacroPlacer.h"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 namespace mpl {
 
@@ -217,135 +221,174 @@ int Partition::globalIndex(int macro_idx)
   return macro_placer_->macroIndex(macros_[macro_idx].dbInstPtr);
 }
 
-// Call ParquetFP
-bool Partition::anneal()
+// Anneal the macros with ParquetFP into db with the given seed.  Returns
+// whether the solution fits in the partition.  Only writes to db and the
+// solution sizes so starts can run concurrently.
+bool Partition::annealStart(int seed,
+                            pfp::DB& db,
+                            double& soln_width,
+                            double& soln_height)
 {
-  debugPrint(logger_, utl::MPL, "anneal", 1, "start anneal");
-  // No macro, no need to execute
-  if (!macros_.empty()) {
-    // Populating DB structure
-    // Instantiate Parquet DB structure
-    DB db;
-    pfp::Nodes* pfp_nodes = db.getNodes();
-    pfp::Nets* pfp_nets = db.getNets();
-
-    //////////////////////////////////////////////////////
-    // Make node structures for macros.
-    for (auto& macro : macros_) {
-      // ParqueFP Node putHaloX/Y, putChannelX/Y are non-functional.
-      // Simulate them by expanding the macro size.
-      // Halo and 1/2 channel on both left/right top/bottom.
-      double padded_width = macro_placer_->paddedWidth(macro);
-      double padded_height = macro_placer_->paddedHeight(macro);
-      double aspect_ratio = padded_width / padded_height;
-      pfp::Node node(macro.name(),
-                     padded_width * padded_height,
-                     aspect_ratio,
-                     aspect_ratio,
-                     &macro - &macros_[0],
-                     false);
-
-      node.addSubBlockIndex(&macro - &macros_[0]);
-      pfp_nodes->putNewNode(node);
-    }
+  // Populating DB structure
+  pfp::Nodes* pfp_nodes = db.getNodes();
+  pfp::Nets* pfp_nets = db.getNets();
+
+  //////////////////////////////////////////////////////
+  // Make node structures for macros.
+  for (auto& macro : macros_) {
+    // ParqueFP Node putHaloX/Y, putChannelX/Y are non-functional.
+    // Simulate them by expanding the macro size.
+    // Halo and 1/2 channel on both left/right top/bottom.
+    double padded_width = macro_placer_->paddedWidth(macro);
+    double padded_height = macro_placer_->paddedHeight(macro);
+    double aspect_ratio = padded_width / padded_height;
+    pfp::Node node(macro.name(),
+                   padded_width * padded_height,
+                   aspect_ratio,
+                   aspect_ratio,
+                   &macro - &macros_[0],
+                   false);
+
+    node.addSubBlockIndex(&macro - &macros_[0]);
+    pfp_nodes->putNewNode(node);
+  }
 
-    // Make node structures for pin edges.
-    int indexTerm = 0;
-    for (int i = 0; i < core_edge_count; i++) {
-      CoreEdge core_edge = coreEdgeFromIndex(i);
-      pfp::Node pin(coreEdgeString(core_edge), 0, 1, 1, indexTerm++, true);
-      double x = 0.0;
-      double y = 0.0;
-      switch (core_edge) {
-        case CoreEdge::West:
-          x = 0.0;
-          y = height / 2.0;
-          break;
-        case CoreEdge::East:
-          x = width;
-          y = height / 2.0;
-          break;
-        case CoreEdge::North:
-          x = width / 2.0;
-          y = height;
-          break;
-        case CoreEdge::South:
-          x = width / 2.0;
-          y = 0.0;
-          break;
-      }
-      pin.putX(x);
-      pin.putY(y);
-      pfp_nodes->putNewTerm(pin);
+  // Make node structures for pin edges.
+  int indexTerm = 0;
+  for (int i = 0; i < core_edge_count; i++) {
+    CoreEdge core_edge = coreEdgeFromIndex(i);
+    pfp::Node pin(coreEdgeString(core_edge), 0, 1, 1, indexTerm++, true);
+    double x = 0.0;
+    double y = 0.0;
+    switch (core_edge) {
+      case CoreEdge::West:
+        x = 0.0;
+        y = height / 2.0;
+        break;
+      case CoreEdge::East:
+        x = width;
+        y = height / 2.0;
+        break;
+      case CoreEdge::North:
+        x = width / 2.0;
+        y = height;
+        break;
+      case CoreEdge::South:
+        x = width / 2.0;
+        y = 0.0;
+        break;
     }
+    pin.putX(x);
+    pin.putY(y);
+    pfp_nodes->putNewTerm(pin);
+  }
 
-    //////////////////////////////////////////////////////
-    // Feed net / weight structure
+  //////////////////////////////////////////////////////
+  // Feed net / weight structure
 
-    // Preprocessing in macro placer side
-    // For nets and wts
-    int macro_edge_count = macros_.size() + core_edge_count;
-    int pnet_idx = 0;
-    for (size_t i = 0; i < macro_edge_count; i++) {
-      for (size_t j = i + 1; j < macro_edge_count; j++) {
-        int cost = 0;
-        if (!net_tbl_.empty()) {
-          // Note that net_tbl only has entries for i < j.
-          // This looks stupid because it is looking at ij and ji entries
-          // -cherry
-          cost = net_tbl_[i * macro_edge_count + j]
-                 + net_tbl_[j * macro_edge_count + i];
-        }
-        if (cost != 0) {
-          makePins(min(i, j), max(i, j), cost, pnet_idx, pfp_nets);
-          pnet_idx++;
-        }
+  // Preprocessing in macro placer side
+  // For nets and wts
+  int macro_edge_count = macros_.size() + core_edge_count;
+  int pnet_idx = 0;
+  for (size_t i = 0; i < macro_edge_count; i++) {
+    for (size_t j = i + 1; j < macro_edge_count; j++) {
+      int cost = 0;
+      if (!net_tbl_.empty()) {
+        // Note that net_tbl only has entries for i < j.
+        // This looks stupid because it is looking at ij and ji entries
+        // -cherry
+        cost = net_tbl_[i * macro_edge_count + j]
+               + net_tbl_[j * macro_edge_count + i];
+      }
+      if (cost != 0) {
+        makePins(min(i, j), max(i, j), cost, pnet_idx, pfp_nets);
+        pnet_idx++;
       }
     }
+  }
 
-    if (pnet_idx == 0) {
-      for (size_t i = 0; i < core_edge_count; i++) {
-        for (size_t j = i + 1; j < core_edge_count; j++) {
-          makePins(i, j, 1, pnet_idx, pfp_nets);
-          pnet_idx++;
-        }
+  if (pnet_idx == 0) {
+    for (size_t i = 0; i < core_edge_count; i++) {
+      for (size_t j = i + 1; j < core_edge_count; j++) {
+        makePins(i, j, 1, pnet_idx, pfp_nets);
+        pnet_idx++;
       }
     }
+  }
+
+  pfp_nets->updateNodeInfo(*pfp_nodes);
+  pfp_nodes->updatePinsInfo(*pfp_nets);
+
+  // Populate MixedBlockInfoType object
+  // It is from DB object
+  MixedBlockInfoTypeFromDB dbBlockInfo(db);
+  MixedBlockInfoType* blockInfo = &dbBlockInfo;
+
+  // Populate Command_Line options.
+  pfp::Command_Line param;
+  param.minWL = true;
+  param.noRotation = true;
+  param.FPrep = "BTree";
+  param.seed = seed;
+  param.scaleTerms = false;
+
+  // Fixed-outline mode in Parquet
+  param.nonTrivialOutline = pfp::BBox(0, 0, width, height);
+  param.reqdAR = width / height;
+  param.maxWS = 0;
+  param.verb = 0;
+
+  // Instantiate BTreeAnnealer Object
+  pfp::BTreeAreaWireAnnealer* annealer
+      = new pfp::BTreeAreaWireAnnealer(*blockInfo, &param, &db);
+  annealer->go();
+
+  const pfp::BTree& sol = annealer->currSolution();
+  soln_width = sol.totalWidth();
+  soln_height = sol.totalHeight();
+  delete annealer;
+  return soln_width <= width && soln_height <= height;
+}
 
-    pfp_nets->updateNodeInfo(*pfp_nodes);
-    pfp_nodes->updatePinsInfo(*pfp_nets);
-
-    // Populate MixedBlockInfoType object
-    // It is from DB object
-    MixedBlockInfoTypeFromDB dbBlockInfo(db);
-    MixedBlockInfoType* blockInfo = &dbBlockInfo;
-
-    // Populate Command_Line options.
-    pfp::Command_Line param;
-    param.minWL = true;
-    param.noRotation = true;
-    param.FPrep = "BTree";
-    param.seed = 100;
-    param.scaleTerms = false;
-
-    // Fixed-outline mode in Parquet
-    param.nonTrivialOutline = pfp::BBox(0, 0, width, height);
-    param.reqdAR = width / height;
-    param.maxWS = 0;
-    param.verb = 0;
-
-    // Instantiate BTreeAnnealer Object
-    pfp::BTreeAreaWireAnnealer* annealer
-        = new pfp::BTreeAreaWireAnnealer(*blockInfo, &param, &db);
-    annealer->go();
-
-    const pfp::BTree& sol = annealer->currSolution();
-    solution_width = sol.totalWidth();
-    solution_height = sol.totalHeight();
-    delete annealer;
-    if (solution_width > width || solution_height > height) {
+// Call ParquetFP
+bool Partition::anneal()
+{
+  debugPrint(logger_, utl::MPL, "anneal", 1, "start anneal");
+  // No macro, no need to execute
+  if (!macros_.empty()) {
+    // The first start usually fits.  When it doesn't, more starts with
+    // other seeds are annealed concurrently and the first of them (by
+    // seed) that fits is used.
+    const int num_starts = 1 + extra_starts_;
+    std::vector<std::unique_ptr<pfp::DB>> dbs(num_starts);
+    std::vector<double> widths(num_starts);
+    std::vector<double> heights(num_starts);
+    std::vector<char> fits(num_starts, false);
+
+    dbs[0] = std::make_unique<pfp::DB>();
+    fits[0] = annealStart(first_seed_, *dbs[0], widths[0], heights[0]);
+    if (!fits[0]) {
+      utl::ThreadPool::global()->parallelFor(
+          extra_starts_,
+          [&](const int start) {
+            const int i = start + 1;
+            dbs[i] = std::make_unique<pfp::DB>();
+            fits[i] = annealStart(
+                first_seed_ + i, *dbs[i], widths[i], heights[i]);
+          },
+          utl::MPL);
+    }
+    const int best = std::find(fits.begin(), fits.end(), true) - fits.begin();
+    if (best == num_starts) {
+      solution_width = widths[0];
+      solution_height = heights[0];
       return false;
     }
+    solution_width = widths[best];
+    solution_height = heights[best];
+    debugPrint(logger_, utl::MPL, "anneal", 1, "start {} fits", best);
+    pfp::Nodes* pfp_nodes = dbs[best]->getNodes();
+
     // flip info initialization for each partition
     bool isFlipX = false, isFlipY = false;
     switch (partClass) {
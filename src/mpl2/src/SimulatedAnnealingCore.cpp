@@ -117,6 +117,10 @@ template <class T>
 void SimulatedAnnealingCore<T>::setNets(const std::vector<BundledNet>& nets)
 {
   nets_ = nets;
+  tot_net_weight_ = 0.0;
+  for (const auto& net : nets_) {
+    tot_net_weight_ += net.weight;
+  }
 }
 
 template <class T>
@@ -243,12 +247,7 @@ void SimulatedAnnealingCore<T>::calWirelength()
     return;
   }
 
-  // calculate the total net weight
-  float tot_net_weight = 0.0;
-  for (const auto& net : nets_)
-    tot_net_weight += net.weight;
-
-  if (tot_net_weight <= 0.0) {
+  if (tot_net_weight_ <= 0.0) {
     return;
   }
 
@@ -262,7 +261,7 @@ void SimulatedAnnealingCore<T>::calWirelength()
 
   // normalization
   wirelength_
-      = wirelength_ / tot_net_weight / (outline_height_ + outline_width_);
+      = wirelength_ / tot_net_weight_ / (outline_height_ + outline_width_);
 
   if (graphics_) {
     graphics_->setWirelength(wirelength_);
@@ -353,69 +352,62 @@ void SimulatedAnnealingCore<T>::packFloorplan()
     macro.setY(0.0);
   }
 
-  // calculate X position
-  // store the position of each macro in the pos_seq_ and neg_seq_
-  std::vector<std::pair<int, int>> match(macros_.size());
+  // store the position of each macro in the neg_seq_
+  std::vector<int> neg_pos(macros_.size());
   for (int i = 0; i < macros_.size(); i++) {
-    match[pos_seq_[i]].first = i;
-    match[neg_seq_[i]].second = i;
-  }
-  // Initialize current length
-  std::vector<float> length(macros_.size(), 0.0);
-  for (int i = 0; i < pos_seq_.size(); i++) {
-    const int b = pos_seq_[i];  // macro_id
-    // add the continue syntax to handle fixed terminals
-    if (macros_[b].getWidth() <= 0 || macros_[b].getHeight() <= 0) {
-      continue;
-    }
-    const int p = match[b].second;  // the position of current macro in neg_seq_
-    macros_[b].setX(length[p]);
-    const float t = macros_[b].getX() + macros_[b].getWidth();
-    for (int j = p; j < neg_seq_.size(); j++) {
-      if (t > length[j]) {
-        length[j] = t;
-      } else {
-        break;
-      }
-    }
+    neg_pos[neg_seq_[i]] = i;
   }
-  // update width_ of current floorplan
-  width_ = length[macros_.size() - 1];
+
+  // calculate X position
+  width_ = packAxis(pos_seq_, neg_pos, true);
 
   // calulate Y position
-  std::vector<int> pos_seq(pos_seq_.size());
-  for (int i = 0; i < macros_.size(); i++) {
-    pos_seq[i] = pos_seq_[macros_.size() - 1 - i];
-  }
-  // store the position of each macro in the pos_seq_ and neg_seq_
-  for (int i = 0; i < macros_.size(); i++) {
-    match[pos_seq[i]].first = i;
-    match[neg_seq_[i]].second = i;
-    length[i] = 0.0;  // initialize the length
+  const std::vector<int> pos_seq(pos_seq_.rbegin(), pos_seq_.rend());
+  height_ = packAxis(pos_seq, neg_pos, false);
+
+  if (graphics_) {
+    graphics_->saStep(macros_);
   }
-  for (int i = 0; i < pos_seq_.size(); i++) {
-    const int b = pos_seq[i];  // macro_id
-    // add continue syntax to handle fixed terminals
-    if (macros_[b].getHeight() <= 0 || macros_[b].getWidth() <= 0.0) {
+}
+
+// Place the macros along one axis in the order of seq.  Each macro starts
+// at the largest end of the macros already placed before it in neg_seq_.
+// Those ends are kept in a Fenwick tree of prefix maxima over the neg_seq_
+// positions, so a pass is O(n log n) instead of O(n^2).  Returns the
+// extent of the packing.
+template <class T>
+float SimulatedAnnealingCore<T>::packAxis(const std::vector<int>& seq,
+                                          const std::vector<int>& neg_pos,
+                                          bool horizontal)
+{
+  const int num_macros = macros_.size();
+  std::vector<float> prefix_max(num_macros + 1, 0.0);
+  float extent = 0.0;
+  for (const int b : seq) {
+    T& macro = macros_[b];
+    // add the continue syntax to handle fixed terminals
+    if (macro.getWidth() <= 0 || macro.getHeight() <= 0) {
       continue;
     }
-    const int p = match[b].second;  // the position of current macro in neg_seq_
-    macros_[b].setY(length[p]);
-    const float t = macros_[b].getY() + macros_[b].getHeight();
-    for (int j = p; j < neg_seq_.size(); j++) {
-      if (t > length[j]) {
-        length[j] = t;
-      } else {
-        break;
-      }
+    const int p = neg_pos[b];
+    float start = 0.0;
+    for (int i = p; i > 0; i -= i & -i) {
+      start = std::max(start, prefix_max[i]);
     }
+    float end;
+    if (horizontal) {
+      macro.setX(start);
+      end = macro.getX() + macro.getWidth();
+    } else {
+      macro.setY(start);
+      end = macro.getY() + macro.getHeight();
+    }
+    for (int i = p + 1; i <= num_macros; i += i & -i) {
+      prefix_max[i] = std::max(prefix_max[i], end);
+    }
+    extent = std::max(extent, end);
   }
-  // update width_ of current floorplan
-  height_ = length[macros_.size() - 1];
-
-  if (graphics_) {
-    graphics_->saStep(macros_);
-  }
+  return extent;
 }
 
 // SingleSeqSwap
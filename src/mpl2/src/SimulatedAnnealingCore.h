@@ -121,6 +121,9 @@ class SimulatedAnnealingCore
 
   // operations
   void packFloorplan();
+  float packAxis(const std::vector<int>& seq,
+                 const std::vector<int>& neg_pos,
+                 bool horizontal);
   virtual void perturb() = 0;
   virtual void restore() = 0;
   // actions used
@@ -142,6 +145,7 @@ class SimulatedAnnealingCore
 
   // nets, fences, guides, blockages
   std::vector<BundledNet> nets_;
+  float tot_net_weight_ = 0.0;  // sum of the weights of nets_
   std::map<int, Rect> fences_;
   std::map<int, Rect> guides_;
 
@@ -37,7 +37,6 @@
 #include <fstream>
 #include <iostream>
 #include <queue>
-#include <thread>
 
 #include "Mpl2Observer.h"
 #include "SACoreHardMacro.h"
@@ -49,6 +48,7 @@
 #include "par/PartitionMgr.h"
 #include "sta/Liberty.hh"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 namespace mpl2 {
 
@@ -477,8 +477,20 @@ void HierRTLMP::hierRTLMacroPlacer()
   createBundledIOs();
 
   // create data flow information
-  debugPrint(logger_, MPL, "macro_placement", 1, "\nCreate Data Flow");
-  createDataFlow();
+  // The dataflow only depends on the netlist, so a rerun with different
+  // options reuses it as long as the netlist is unchanged.
+  const size_t netlist_hash = computeNetlistHash();
+  if (dataflow_valid_ && netlist_hash == dataflow_netlist_hash_) {
+    debugPrint(logger_, MPL, "macro_placement", 1, "\nReuse Data Flow");
+  } else {
+    debugPrint(logger_, MPL, "macro_placement", 1, "\nCreate Data Flow");
+    macro_ffs_conn_map_.clear();
+    io_ffs_conn_map_.clear();
+    macro_macro_conn_map_.clear();
+    createDataFlow();
+    dataflow_netlist_hash_ = netlist_hash;
+    dataflow_valid_ = true;
+  }
 
   // Create physical hierarchy tree in a post-order DFS manner
   logger_->info(MPL, 24, "Perform Clustering..");
@@ -1483,55 +1495,93 @@ void HierRTLMP::calculateConnection()
     cluster->initConnection();
   }
 
-  // Traverse all nets through OpenDB
+  // Look up the cluster of each instance once instead of once per pin.
+  // Instances without a liberty cell are ignored; nets connecting Pads
+  // or Covers are ignored altogether.
+  const int ignored_inst = -1;
+  const int pad_inst = -2;
+  std::vector<int> inst_cluster_id;
+  for (odb::dbInst* inst : block_->getInsts()) {
+    const int id = inst->getId();
+    if (id >= inst_cluster_id.size()) {
+      inst_cluster_id.resize(id + 1, ignored_inst);
+    }
+    if (network_->libertyCell(inst) == nullptr) {
+      continue;
+    }
+    odb::dbMaster* master = inst->getMaster();
+    if (master->isPad() || master->isCover()) {
+      inst_cluster_id[id] = pad_inst;
+    } else if (auto prop = odb::dbIntProperty::find(inst, "cluster_id")) {
+      inst_cluster_id[id] = prop->getValue();
+    }
+  }
+
+  std::vector<odb::dbNet*> nets;
+  nets.reserve(block_->getNets().size());
   for (odb::dbNet* net : block_->getNets()) {
+    nets.push_back(net);
+  }
+
+  // The nets are traversed in parallel, but the connections are added in
+  // net order below so the weights sum up the same way as a serial run.
+  struct NetConnection
+  {
+    int driver_id = -1;         // cluster id of the driver instance
+    std::vector<int> loads_id;  // cluster id of sink instances
+    bool io_flag = false;
+  };
+  std::vector<NetConnection> net_connections(nets.size());
+
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic, 256)
+  for (int i = 0; i < nets.size(); i++) {
+    odb::dbNet* net = nets[i];
     // ignore all the power net
     if (net->getSigType().isSupply()) {
       continue;
     }
-    int driver_id = -1;         // cluster id of the driver instance
-    std::vector<int> loads_id;  // cluster id of sink instances
+    NetConnection& connection = net_connections[i];
     bool pad_flag = false;
     // check the connected instances
     for (odb::dbITerm* iterm : net->getITerms()) {
-      odb::dbInst* inst = iterm->getInst();
-      const sta::LibertyCell* liberty_cell = network_->libertyCell(inst);
-      if (liberty_cell == nullptr)
+      const int cluster_id = inst_cluster_id[iterm->getInst()->getId()];
+      if (cluster_id == ignored_inst) {
         continue;
-      odb::dbMaster* master = inst->getMaster();
-      // check if the instance is a Pad, Cover or empty block (such as marker)
-      // We ignore nets connecting Pads, Covers, or markers
-      if (master->isPad() || master->isCover()) {
+      }
+      if (cluster_id == pad_inst) {
         pad_flag = true;
         break;
       }
-      const int cluster_id
-          = odb::dbIntProperty::find(inst, "cluster_id")->getValue();
       if (iterm->getIoType() == odb::dbIoType::OUTPUT) {
-        driver_id = cluster_id;
+        connection.driver_id = cluster_id;
       } else {
-        loads_id.push_back(cluster_id);
+        connection.loads_id.push_back(cluster_id);
       }
     }
     if (pad_flag) {
+      connection = NetConnection();
       continue;  // the nets with Pads should be ignored
     }
-    bool io_flag = false;
     // check the connected IO pins
     for (odb::dbBTerm* bterm : net->getBTerms()) {
       const int cluster_id
           = odb::dbIntProperty::find(bterm, "cluster_id")->getValue();
-      io_flag = true;
+      connection.io_flag = true;
       if (bterm->getIoType() == odb::dbIoType::INPUT) {
-        driver_id = cluster_id;
+        connection.driver_id = cluster_id;
       } else {
-        loads_id.push_back(cluster_id);
+        connection.loads_id.push_back(cluster_id);
       }
     }
-    // add the net to connections between clusters
+  }
+
+  // add the nets to connections between clusters
+  for (const NetConnection& connection : net_connections) {
+    const int driver_id = connection.driver_id;
+    const std::vector<int>& loads_id = connection.loads_id;
     if (driver_id != -1 && loads_id.size() > 0
         && loads_id.size() < large_net_threshold_) {
-      const float weight = io_flag == true ? virtual_weight_ : 1.0;
+      const float weight = connection.io_flag ? virtual_weight_ : 1.0;
       for (int i = 0; i < loads_id.size(); i++) {
         if (loads_id[i]
             != driver_id) {  // we model the connections as undirected edges
@@ -1543,6 +1593,36 @@ void HierRTLMP::calculateConnection()
   }      // end net traversal
 }
 
+// Hash the connectivity that createDataFlow depends on, along with the
+// options it uses, to detect whether a previous dataflow can be reused.
+size_t HierRTLMP::computeNetlistHash() const
+{
+  size_t hash = 0;
+  auto combine = [&hash](size_t value) {
+    hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  };
+  combine(reinterpret_cast<uintptr_t>(block_));
+  combine(max_num_ff_dist_);
+  combine(large_net_threshold_);
+  for (odb::dbInst* inst : block_->getInsts()) {
+    combine(inst->getId());
+    combine(reinterpret_cast<uintptr_t>(inst->getMaster()));
+  }
+  for (odb::dbNet* net : block_->getNets()) {
+    combine(net->getId());
+    combine(net->getSigType().getValue());
+    for (odb::dbITerm* iterm : net->getITerms()) {
+      combine(iterm->getInst()->getId());
+      combine(iterm->getMTerm()->getIndex());
+    }
+    for (odb::dbBTerm* bterm : net->getBTerms()) {
+      combine(bterm->getId());
+      combine(bterm->getIoType().getValue());
+    }
+  }
+  return hash;
+}
+
 // Create Dataflow Information
 // model each std cell instance, IO pin and macro pin as vertices
 void HierRTLMP::createDataFlow()
@@ -1556,10 +1636,18 @@ void HierRTLMP::createDataFlow()
   std::map<int, odb::dbITerm*> macro_pin_vertex;
 
   std::vector<bool> stop_flag_vec;
+  // a previous run may have left vertex ids behind
+  auto set_vertex_id = [](odb::dbObject* object, int vertex_id) {
+    if (auto prop = odb::dbIntProperty::find(object, "vertex_id")) {
+      prop->setValue(vertex_id);
+    } else {
+      odb::dbIntProperty::create(object, "vertex_id", vertex_id);
+    }
+  };
   // assign vertex_id property of each Bterm
   // All boundary terms are marked as sequential stopping pts
   for (odb::dbBTerm* term : block_->getBTerms()) {
-    odb::dbIntProperty::create(term, "vertex_id", stop_flag_vec.size());
+    set_vertex_id(term, stop_flag_vec.size());
     io_pin_vertex[stop_flag_vec.size()] = term;
     stop_flag_vec.push_back(true);
   }
@@ -1577,7 +1665,7 @@ void HierRTLMP::createDataFlow()
     }
 
     // mark sequential instances
-    odb::dbIntProperty::create(inst, "vertex_id", stop_flag_vec.size());
+    set_vertex_id(inst, stop_flag_vec.size());
     std_cell_vertex[stop_flag_vec.size()] = inst;
     if (liberty_cell->hasSequentials()) {
       stop_flag_vec.push_back(true);
@@ -1592,7 +1680,7 @@ void HierRTLMP::createDataFlow()
       if (pin->getSigType() != odb::dbSigType::SIGNAL) {
         continue;
       }
-      odb::dbIntProperty::create(pin, "vertex_id", stop_flag_vec.size());
+      set_vertex_id(pin, stop_flag_vec.size());
       macro_pin_vertex[stop_flag_vec.size()] = pin;
       stop_flag_vec.push_back(true);
     }
@@ -1687,7 +1775,15 @@ void HierRTLMP::createDataFlow()
   debugPrint(logger_, MPL, "dataflow", 1, "Created hypergraph");
 
   // traverse hypergraph to build dataflow
-  for (auto [src, src_pin] : io_pin_vertex) {
+  // Each source is searched independently, so the searches run in
+  // parallel and the results are collected in source order.
+  const std::vector<std::pair<int, odb::dbBTerm*>> io_pin_srcs(
+      io_pin_vertex.begin(), io_pin_vertex.end());
+  std::vector<std::vector<std::set<odb::dbInst*>>> io_pin_insts(
+      io_pin_srcs.size());
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (int i = 0; i < io_pin_srcs.size(); i++) {
+    const int src = io_pin_srcs[i].first;
     int idx = 0;
     std::vector<bool> visited(vertices.size(), false);
     std::vector<std::set<odb::dbInst*>> insts(max_num_ff_dist_);
@@ -1713,12 +1809,23 @@ void HierRTLMP::createDataFlow()
                      backward_vertices,
                      hyperedges,
                      true);
-    io_ffs_conn_map_.push_back(
-        std::pair<odb::dbBTerm*, std::vector<std::set<odb::dbInst*>>>(src_pin,
-                                                                      insts));
+    io_pin_insts[i] = std::move(insts);
   }
-
-  for (auto [src, src_pin] : macro_pin_vertex) {
+  for (int i = 0; i < io_pin_srcs.size(); i++) {
+    io_ffs_conn_map_.push_back(
+        std::pair<odb::dbBTerm*, std::vector<std::set<odb::dbInst*>>>(
+            io_pin_srcs[i].second, std::move(io_pin_insts[i])));
+  }
+
+  const std::vector<std::pair<int, odb::dbITerm*>> macro_pin_srcs(
+      macro_pin_vertex.begin(), macro_pin_vertex.end());
+  std::vector<std::vector<std::set<odb::dbInst*>>> macro_pin_std_cells(
+      macro_pin_srcs.size());
+  std::vector<std::vector<std::set<odb::dbInst*>>> macro_pin_macros(
+      macro_pin_srcs.size());
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (int i = 0; i < macro_pin_srcs.size(); i++) {
+    const int src = macro_pin_srcs[i].first;
     int idx = 0;
     std::vector<bool> visited(vertices.size(), false);
     std::vector<std::set<odb::dbInst*>> std_cells(max_num_ff_dist_);
@@ -1747,12 +1854,17 @@ void HierRTLMP::createDataFlow()
                         backward_vertices,
                         hyperedges,
                         true);
+    macro_pin_std_cells[i] = std::move(std_cells);
+    macro_pin_macros[i] = std::move(macros);
+  }
+  for (int i = 0; i < macro_pin_srcs.size(); i++) {
+    odb::dbITerm* src_pin = macro_pin_srcs[i].second;
     macro_ffs_conn_map_.push_back(
         std::pair<odb::dbITerm*, std::vector<std::set<odb::dbInst*>>>(
-            src_pin, std_cells));
+            src_pin, std::move(macro_pin_std_cells[i])));
     macro_macro_conn_map_.push_back(
-        std::pair<odb::dbITerm*, std::vector<std::set<odb::dbInst*>>>(src_pin,
-                                                                      macros));
+        std::pair<odb::dbITerm*, std::vector<std::set<odb::dbInst*>>>(
+            src_pin, std::move(macro_pin_macros[i])));
   }
 }
 
@@ -1777,9 +1889,9 @@ void HierRTLMP::dataFlowDFSIOPin(int parent,
     if (parent < io_pin_vertex.size()) {
       ;  // currently we do not consider IO pin to IO pin connnection
     } else if (parent < io_pin_vertex.size() + std_cell_vertex.size()) {
-      insts[idx].insert(std_cell_vertex[parent]);
+      insts[idx].insert(std_cell_vertex.at(parent));
     } else {
-      insts[idx].insert(macro_pin_vertex[parent]->getInst());
+      insts[idx].insert(macro_pin_vertex.at(parent)->getInst());
     }
     idx++;
   }
@@ -1853,9 +1965,9 @@ void HierRTLMP::dataFlowDFSMacroPin(
     if (parent < io_pin_vertex.size()) {
       ;  // the connection between IO and macro pins have been considers
     } else if (parent < io_pin_vertex.size() + std_cell_vertex.size()) {
-      std_cells[idx].insert(std_cell_vertex[parent]);
+      std_cells[idx].insert(std_cell_vertex.at(parent));
     } else {
-      macros[idx].insert(macro_pin_vertex[parent]->getInst());
+      macros[idx].insert(macro_pin_vertex.at(parent)->getInst());
     }
     idx++;
   }
@@ -2059,7 +2171,9 @@ void HierRTLMP::breakLargeFlatCluster(Cluster* parent)
   std::map<odb::dbInst*, int> inst_vertex_id_map;
   const int parent_cluster_id = parent->getId();
   std::vector<odb::dbInst*> std_cells = parent->getLeafStdCells();
-  std::vector<std::vector<int>> hyperedges;
+  // hyperedges in compressed sparse row format
+  std::vector<int> eptr{0};
+  std::vector<int> eind;
   std::vector<float> vertex_weight;
   // vertices
   // other clusters behaves like fixed vertices
@@ -2134,9 +2248,8 @@ void HierRTLMP::breakLargeFlatCluster(Cluster* parent)
     // add the net as a hyperedge
     if (driver_id != -1 && loads_id.size() > 1
         && loads_id.size() < large_net_threshold_) {
-      std::vector<int> hyperedge;
-      hyperedge.insert(hyperedge.end(), loads_id.begin(), loads_id.end());
-      hyperedges.push_back(hyperedge);
+      eind.insert(eind.end(), loads_id.begin(), loads_id.end());
+      eptr.push_back(static_cast<int>(eind.size()));
     }
   }
 
@@ -2144,14 +2257,15 @@ void HierRTLMP::breakLargeFlatCluster(Cluster* parent)
   const float balance_constraint = 1.0;
   const int num_parts = 2;  // We use two-way partitioning here
   const int num_vertices = static_cast<int>(vertex_weight.size());
-  std::vector<float> hyperedge_weights(hyperedges.size(), 1.0f);
-  std::vector<int> part
-      = tritonpart_->PartitionKWaySimpleMode(num_parts,
-                                             balance_constraint,
-                                             seed,
-                                             hyperedges,
-                                             vertex_weight,
-                                             hyperedge_weights);
+  par::HypergraphView hypergraph;
+  hypergraph.num_vertices = num_vertices;
+  hypergraph.num_hyperedges = static_cast<int>(eptr.size()) - 1;
+  hypergraph.eptr = eptr.data();
+  hypergraph.eind = eind.data();
+  hypergraph.vertex_weights = vertex_weight.data();
+  std::vector<int> part(num_vertices, 0);
+  tritonpart_->PartitionKWaySimpleMode(
+      num_parts, balance_constraint, seed, hypergraph, part.data());
 
   // create cluster based on partitioning solutions
   // Note that all the std cells are stored in the leaf_std_cells_ for a flat
@@ -2465,6 +2579,28 @@ static bool comparePairProduct(const std::pair<float, float>& p1,
   return p1.first * p1.second < p2.first * p2.second;
 }
 
+// Each thread takes the next pending run as soon as its previous run is
+// done, so a slow run no longer keeps the other threads waiting for the
+// rest of its group. Every run has its own seed and state, so the results
+// do not depend on which thread executes it.
+template <class SACore>
+void HierRTLMP::runSAs(std::vector<std::unique_ptr<SACore>>& sa_list)
+{
+  const int num_runs = sa_list.size();
+  const int num_workers = graphics_ ? 1 : std::min(num_runs, num_threads_);
+  if (num_workers <= 1) {
+    for (auto& sa : sa_list) {
+      runSA<SACore>(sa.get());
+    }
+    return;
+  }
+  utl::ThreadPool::global()->parallelFor(
+      num_runs,
+      [&](int run) { runSA<SACore>(sa_list[run].get()); },
+      utl::MPL,
+      num_workers);
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // Macro Placement related functions
 // Determine the macro tilings within each cluster in a bottom-up manner.
@@ -2529,7 +2665,7 @@ void HierRTLMP::calClusterMacroTilings(Cluster* parent)
   const int num_perturb_per_step = (macros.size() > num_perturb_per_step_ / 10)
                                        ? macros.size()
                                        : num_perturb_per_step_ / 10;
-  std::vector<SACoreSoftMacro*> sa_containers;
+  std::vector<std::unique_ptr<SACoreSoftMacro>> sa_containers;
   // we vary the outline of parent cluster to generate different tilings
   // we first vary the outline width while keeping outline height fixed
   // Then we vary the outline height while keeping outline width fixed
@@ -2539,130 +2675,48 @@ void HierRTLMP::calClusterMacroTilings(Cluster* parent)
   for (int i = 1; i < num_runs_; i++) {
     vary_factor_list.push_back(1.0 - i * vary_step);
   }
-  int remaining_runs = num_runs_;
-  int run_id = 0;
-  while (remaining_runs > 0) {
-    std::vector<SACoreSoftMacro*> sa_vector;
-    const int run_thread
-        = graphics_ ? 1 : std::min(remaining_runs, num_threads_);
-    for (int i = 0; i < run_thread; i++) {
-      const float width = outline_width * vary_factor_list[run_id++];
-      const float height = outline_height;
-      SACoreSoftMacro* sa = new SACoreSoftMacro(
-          width,
-          height,
-          macros,
-          1.0,     // area weight
-          1000.0,  // outline weight
-          0.0,     // wirelength weight
-          0.0,     // guidance weight
-          0.0,     // fence weight
-          0.0,     // boundary weight
-          0.0,     // macro blockage
-          0.0,     // notch weight
-          0.0,     // no notch size
-          0.0,     // no notch size
-          pos_swap_prob_ / action_sum,
-          neg_swap_prob_ / action_sum,
-          double_swap_prob_ / action_sum,
-          exchange_swap_prob_ / action_sum,
-          resize_prob_ / action_sum,
-          init_prob_,
-          max_num_step_,
-          num_perturb_per_step,
-          k_,  // This will be replaced by min_temperature later
-          c_,
-          random_seed_,
-          graphics_.get(),
-          logger_);
-      sa_vector.push_back(sa);
-    }
-    if (sa_vector.size() == 1) {
-      runSA<SACoreSoftMacro>(sa_vector[0]);
-    } else {
-      // multi threads
-      std::vector<std::thread> threads;
-      for (auto& sa : sa_vector) {
-        threads.push_back(std::thread(runSA<SACoreSoftMacro>, sa));
-      }
-      for (auto& th : threads) {
-        th.join();
-      }
+  // The runs are independent, so both sweeps share one pool of threads.
+  for (int run = 0; run < 2 * num_runs_; run++) {
+    const bool vary_width = run < num_runs_;
+    const float vary_factor = vary_factor_list[run % num_runs_];
+    const float width = outline_width * (vary_width ? vary_factor : 1.0f);
+    const float height = outline_height * (vary_width ? 1.0f : vary_factor);
+    sa_containers.push_back(std::make_unique<SACoreSoftMacro>(
+        width,
+        height,
+        macros,
+        1.0,     // area weight
+        1000.0,  // outline weight
+        0.0,     // wirelength weight
+        0.0,     // guidance weight
+        0.0,     // fence weight
+        0.0,     // boundary weight
+        0.0,     // macro blockage
+        0.0,     // notch weight
+        0.0,     // no notch size
+        0.0,     // no notch size
+        pos_swap_prob_ / action_sum,
+        neg_swap_prob_ / action_sum,
+        double_swap_prob_ / action_sum,
+        exchange_swap_prob_ / action_sum,
+        resize_prob_ / action_sum,
+        init_prob_,
+        max_num_step_,
+        num_perturb_per_step,
+        k_,  // This will be replaced by min_temperature later
+        c_,
+        random_seed_,
+        graphics_.get(),
+        logger_));
+  }
+  runSAs(sa_containers);
+  // add macro tilings
+  for (auto& sa : sa_containers) {
+    if (sa->isValid(outline_width, outline_height) == true) {
+      macro_tilings.insert(
+          std::pair<float, float>(sa->getWidth(), sa->getHeight()));
     }
-    // add macro tilings
-    for (auto& sa : sa_vector) {
-      sa_containers.push_back(sa);
-      if (sa->isValid(outline_width, outline_height) == true) {
-        macro_tilings.insert(
-            std::pair<float, float>(sa->getWidth(), sa->getHeight()));
-      }
-    }
-    sa_vector.clear();
-    remaining_runs -= run_thread;
   }
-  // vary the outline height while keeping outline width fixed
-  remaining_runs = num_runs_;
-  run_id = 0;
-  while (remaining_runs > 0) {
-    std::vector<SACoreSoftMacro*> sa_vector;
-    const int run_thread
-        = graphics_ ? 1 : std::min(remaining_runs, num_threads_);
-    for (int i = 0; i < run_thread; i++) {
-      const float width = outline_width;
-      const float height = outline_height * vary_factor_list[run_id++];
-      SACoreSoftMacro* sa = new SACoreSoftMacro(
-          width,
-          height,
-          macros,
-          1.0,     // area weight
-          1000.0,  // outline weight
-          0.0,     // wirelength weight
-          0.0,     // guidance weight
-          0.0,     // fence weight
-          0.0,     // boundary weight
-          0.0,     // macro blockage
-          0.0,     // notch weight
-          0.0,     // no notch size
-          0.0,     // no notch size
-          pos_swap_prob_ / action_sum,
-          neg_swap_prob_ / action_sum,
-          double_swap_prob_ / action_sum,
-          exchange_swap_prob_ / action_sum,
-          resize_prob_ / action_sum,
-          init_prob_,
-          max_num_step_,
-          num_perturb_per_step,
-          k_,  // later this will be replaced by min_temperature
-          c_,
-          random_seed_,
-          graphics_.get(),
-          logger_);
-      sa_vector.push_back(sa);
-    }
-    if (sa_vector.size() == 1) {
-      runSA<SACoreSoftMacro>(sa_vector[0]);
-    } else {
-      // multi threads
-      std::vector<std::thread> threads;
-      for (auto& sa : sa_vector) {
-        threads.push_back(std::thread(runSA<SACoreSoftMacro>, sa));
-      }
-      for (auto& th : threads) {
-        th.join();
-      }
-    }
-    // add macro tilings
-    for (auto& sa : sa_vector) {
-      sa_containers.push_back(sa);
-      if (sa->isValid(outline_width, outline_height) == true) {
-        macro_tilings.insert(
-            std::pair<float, float>(sa->getWidth(), sa->getHeight()));
-      }
-    }
-    sa_vector.clear();
-    remaining_runs -= run_thread;
-  }
-  // clean all the SA to avoid memory leakage
   sa_containers.clear();
   std::vector<std::pair<float, float>> tilings(macro_tilings.begin(),
                                                macro_tilings.end());
@@ -2760,7 +2814,7 @@ void HierRTLMP::calHardMacroClusterShape(Cluster* cluster)
                                : num_perturb_per_step_ / 5;
   }
 
-  std::vector<SACoreHardMacro*> sa_containers;
+  std::vector<std::unique_ptr<SACoreHardMacro>> sa_containers;
   // To generate different macro tilings, we vary the outline constraints
   // we first vary the outline width while keeping outline_height fixed
   // Then we vary the outline height while keeping outline_width fixed
@@ -2770,118 +2824,43 @@ void HierRTLMP::calHardMacroClusterShape(Cluster* cluster)
   for (int i = 1; i < num_runs_; i++) {
     vary_factor_list.push_back(1.0 - i * vary_step);
   }
-  int remaining_runs = num_runs_;
-  int run_id = 0;
-  while (remaining_runs > 0) {
-    std::vector<SACoreHardMacro*> sa_vector;
-    const int run_thread
-        = graphics_ ? 1 : std::min(remaining_runs, num_threads_);
-    for (int i = 0; i < run_thread; i++) {
-      const float width = outline_width * vary_factor_list[run_id++];
-      const float height = outline_height;
-      SACoreHardMacro* sa = new SACoreHardMacro(
-          width,
-          height,
-          macros,
-          1.0,     // area_weight
-          1000.0,  // outline weight
-          0.0,     // wirelength weight
-          0.0,     // guidance
-          0.0,     // fence weight
-          pos_swap_prob_ / action_sum,
-          neg_swap_prob_ / action_sum,
-          double_swap_prob_ / action_sum,
-          exchange_swap_prob_ / action_sum,
-          0.0,  // no flip
-          init_prob_,
-          max_num_step_,
-          num_perturb_per_step,
-          k_,  // later this will be replaced by min_temperature
-          c_,
-          random_seed_ + run_id,
-          graphics_.get(),
-          logger_);
-      sa_vector.push_back(sa);
-    }
-    if (sa_vector.size() == 1) {
-      runSA<SACoreHardMacro>(sa_vector[0]);
-    } else {
-      // multi threads
-      std::vector<std::thread> threads;
-      for (auto& sa : sa_vector) {
-        threads.push_back(std::thread(runSA<SACoreHardMacro>, sa));
-      }
-      for (auto& th : threads) {
-        th.join();
-      }
-    }
-    // add macro tilings
-    for (auto& sa : sa_vector) {
-      sa_containers.push_back(sa);
-      if (sa->isValid(outline_width, outline_height) == true) {
-        macro_tilings.insert(
-            std::pair<float, float>(sa->getWidth(), sa->getHeight()));
-      }
-    }
-    sa_vector.clear();
-    remaining_runs -= run_thread;
-  }
-  // change the outline height while keeping outline width fixed
-  remaining_runs = num_runs_;
-  run_id = 0;
-  while (remaining_runs > 0) {
-    std::vector<SACoreHardMacro*> sa_vector;
-    const int run_thread
-        = graphics_ ? 1 : std::min(remaining_runs, num_threads_);
-    for (int i = 0; i < run_thread; i++) {
-      const float width = outline_width;
-      const float height = outline_height * vary_factor_list[run_id++];
-      SACoreHardMacro* sa
-          = new SACoreHardMacro(width,
-                                height,
-                                macros,
-                                1.0,     // area_weight
-                                1000.0,  // outline weight
-                                0.0,     // wirelength weight
-                                0.0,     // guidance
-                                0.0,     // fence weight
-                                pos_swap_prob_ / action_sum,
-                                neg_swap_prob_ / action_sum,
-                                double_swap_prob_ / action_sum,
-                                exchange_swap_prob_ / action_sum,
-                                0.0,
-                                init_prob_,
-                                max_num_step_,
-                                num_perturb_per_step,
-                                k_,
-                                c_,
-                                random_seed_ + run_id,
-                                graphics_.get(),
-                                logger_);
-      sa_vector.push_back(sa);
-    }
-    if (sa_vector.size() == 1) {
-      runSA<SACoreHardMacro>(sa_vector[0]);
-    } else {
-      // multi threads
-      std::vector<std::thread> threads;
-      for (auto& sa : sa_vector) {
-        threads.push_back(std::thread(runSA<SACoreHardMacro>, sa));
-      }
-      for (auto& th : threads) {
-        th.join();
-      }
-    }
-    // add macro tilings
-    for (auto& sa : sa_vector) {
-      sa_containers.push_back(sa);
-      if (sa->isValid(outline_width, outline_height) == true) {
-        macro_tilings.insert(
-            std::pair<float, float>(sa->getWidth(), sa->getHeight()));
-      }
+  // The runs are independent, so both sweeps share one pool of threads.
+  for (int run = 0; run < 2 * num_runs_; run++) {
+    const bool vary_width = run < num_runs_;
+    const int run_id = run % num_runs_;
+    const float vary_factor = vary_factor_list[run_id];
+    const float width = outline_width * (vary_width ? vary_factor : 1.0f);
+    const float height = outline_height * (vary_width ? 1.0f : vary_factor);
+    sa_containers.push_back(std::make_unique<SACoreHardMacro>(
+        width,
+        height,
+        macros,
+        1.0,     // area_weight
+        1000.0,  // outline weight
+        0.0,     // wirelength weight
+        0.0,     // guidance
+        0.0,     // fence weight
+        pos_swap_prob_ / action_sum,
+        neg_swap_prob_ / action_sum,
+        double_swap_prob_ / action_sum,
+        exchange_swap_prob_ / action_sum,
+        0.0,  // no flip
+        init_prob_,
+        max_num_step_,
+        num_perturb_per_step,
+        k_,  // later this will be replaced by min_temperature
+        c_,
+        random_seed_ + run_id + 1,
+        graphics_.get(),
+        logger_));
+  }
+  runSAs(sa_containers);
+  // add macro tilings
+  for (auto& sa : sa_containers) {
+    if (sa->isValid(outline_width, outline_height) == true) {
+      macro_tilings.insert(
+          std::pair<float, float>(sa->getWidth(), sa->getHeight()));
     }
-    sa_vector.clear();
-    remaining_runs -= run_thread;
   }
   // clean the sa_container to avoid memory leakage
   sa_containers.clear();
@@ -3531,7 +3510,7 @@ void HierRTLMP::multiLevelMacroPlacement(Cluster* parent)
   int remaining_runs = target_util_list.size();
   int run_id = 0;
   SACoreSoftMacro* best_sa = nullptr;
-  std::vector<SACoreSoftMacro*>
+  std::vector<std::unique_ptr<SACoreSoftMacro>>
       sa_containers;  // store all the SA runs to avoid memory leakage
   float best_cost = std::numeric_limits<float>::max();
   debugPrint(logger_,
@@ -3540,7 +3519,7 @@ void HierRTLMP::multiLevelMacroPlacement(Cluster* parent)
              1,
              "[MultiLevelMacroPlacement] Start Simulated Annealing Core");
   while (remaining_runs > 0) {
-    std::vector<SACoreSoftMacro*> sa_vector;
+    std::vector<std::unique_ptr<SACoreSoftMacro>> sa_vector;
     run_thread
         = (remaining_runs > num_threads_) ? num_threads_ : remaining_runs;
     if (graphics_) {
@@ -3586,7 +3565,7 @@ void HierRTLMP::multiLevelMacroPlacement(Cluster* parent)
       // Note that all the probabilities are normalized to the summation of 1.0.
       // Note that the weight are not necessaries summarized to 1.0, i.e., not
       // normalized.
-      SACoreSoftMacro* sa = new SACoreSoftMacro(
+      auto sa = std::make_unique<SACoreSoftMacro>(
           outline_width,
           outline_height,
           shaped_macros,
@@ -3619,27 +3598,16 @@ void HierRTLMP::multiLevelMacroPlacement(Cluster* parent)
       sa->setNets(nets);
       sa->setBlockages(blockages);
       sa->setBlockages(macro_blockages);
-      sa_vector.push_back(sa);
-    }
-    if (sa_vector.size() == 1) {
-      runSA<SACoreSoftMacro>(sa_vector[0]);
-    } else {
-      // multi threads
-      std::vector<std::thread> threads;
-      for (auto& sa : sa_vector) {
-        threads.push_back(std::thread(runSA<SACoreSoftMacro>, sa));
-      }
-      for (auto& th : threads) {
-        th.join();
-      }
+      sa_vector.push_back(std::move(sa));
     }
+    runSAs(sa_vector);
     // add macro tilings
     for (auto& sa : sa_vector) {
-      sa_containers.push_back(sa);  // add SA to containers
       if (sa->isValid() && sa->getNormCost() < best_cost) {
         best_cost = sa->getNormCost();
-        best_sa = sa;
+        best_sa = sa.get();
       }
+      sa_containers.push_back(std::move(sa));  // add SA to containers
     }
     sa_vector.clear();
     // add early stop mechanism
@@ -3766,7 +3734,7 @@ void HierRTLMP::multiLevelMacroPlacement(Cluster* parent)
                1,
                "[MultiLevelMacroPlacement] Start Simulated Annealing Core");
     while (remaining_runs > 0) {
-      std::vector<SACoreSoftMacro*> sa_vector;
+      std::vector<std::unique_ptr<SACoreSoftMacro>> sa_vector;
       run_thread
           = (remaining_runs > num_threads_) ? num_threads_ : remaining_runs;
       if (graphics_) {
@@ -3813,7 +3781,7 @@ void HierRTLMP::multiLevelMacroPlacement(Cluster* parent)
         // Note that all the probabilities are normalized to the summation
         // of 1.0. Note that the weight are not necessaries summarized to 1.0,
         // i.e., not normalized.
-        SACoreSoftMacro* sa = new SACoreSoftMacro(
+        auto sa = std::make_unique<SACoreSoftMacro>(
             outline_width,
             outline_height,
             shaped_macros,
@@ -3846,27 +3814,16 @@ void HierRTLMP::multiLevelMacroPlacement(Cluster* parent)
         sa->setNets(nets);
         sa->setBlockages(blockages);
         sa->setBlockages(macro_blockages);
-        sa_vector.push_back(sa);
-      }
-      if (sa_vector.size() == 1) {
-        runSA<SACoreSoftMacro>(sa_vector[0]);
-      } else {
-        // multi threads
-        std::vector<std::thread> threads;
-        for (auto& sa : sa_vector) {
-          threads.push_back(std::thread(runSA<SACoreSoftMacro>, sa));
-        }
-        for (auto& th : threads) {
-          th.join();
-        }
+        sa_vector.push_back(std::move(sa));
       }
+      runSAs(sa_vector);
       // add macro tilings
       for (auto& sa : sa_vector) {
-        sa_containers.push_back(sa);  // add SA to containers
         if (sa->isValid() && sa->getNormCost() < best_cost) {
           best_cost = sa->getNormCost();
-          best_sa = sa;
+          best_sa = sa.get();
         }
+        sa_containers.push_back(std::move(sa));  // add SA to containers
       }
       sa_vector.clear();
       // add early stop mechanism
@@ -4277,7 +4234,7 @@ void HierRTLMP::multiLevelMacroPlacementWithoutBusPlanning(Cluster* parent)
   int remaining_runs = target_util_list.size();
   int run_id = 0;
   SACoreSoftMacro* best_sa = nullptr;
-  std::vector<SACoreSoftMacro*>
+  std::vector<std::unique_ptr<SACoreSoftMacro>>
       sa_containers;  // store all the SA runs to avoid memory leakage
   float best_cost = std::numeric_limits<float>::max();
   debugPrint(logger_,
@@ -4286,7 +4243,7 @@ void HierRTLMP::multiLevelMacroPlacementWithoutBusPlanning(Cluster* parent)
              1,
              "[MultiLevelMacroPlacement] Start Simulated Annealing Core");
   while (remaining_runs > 0) {
-    std::vector<SACoreSoftMacro*> sa_vector;
+    std::vector<std::unique_ptr<SACoreSoftMacro>> sa_vector;
     run_thread
         = (remaining_runs > num_threads_) ? num_threads_ : remaining_runs;
     if (graphics_) {
@@ -4332,7 +4289,7 @@ void HierRTLMP::multiLevelMacroPlacementWithoutBusPlanning(Cluster* parent)
       // Note that all the probabilities are normalized to the summation of 1.0.
       // Note that the weight are not necessaries summarized to 1.0, i.e., not
       // normalized.
-      SACoreSoftMacro* sa = new SACoreSoftMacro(
+      auto sa = std::make_unique<SACoreSoftMacro>(
           outline_width,
           outline_height,
           shaped_macros,
@@ -4365,27 +4322,16 @@ void HierRTLMP::multiLevelMacroPlacementWithoutBusPlanning(Cluster* parent)
       sa->setNets(nets);
       sa->setBlockages(blockages);
       sa->setBlockages(macro_blockages);
-      sa_vector.push_back(sa);
-    }
-    if (sa_vector.size() == 1) {
-      runSA<SACoreSoftMacro>(sa_vector[0]);
-    } else {
-      // multi threads
-      std::vector<std::thread> threads;
-      for (auto& sa : sa_vector) {
-        threads.push_back(std::thread(runSA<SACoreSoftMacro>, sa));
-      }
-      for (auto& th : threads) {
-        th.join();
-      }
+      sa_vector.push_back(std::move(sa));
     }
+    runSAs(sa_vector);
     // add macro tilings
     for (auto& sa : sa_vector) {
-      sa_containers.push_back(sa);  // add SA to containers
       if (sa->isValid() && sa->getNormCost() < best_cost) {
         best_cost = sa->getNormCost();
-        best_sa = sa;
+        best_sa = sa.get();
       }
+      sa_containers.push_back(std::move(sa));  // add SA to containers
     }
     sa_vector.clear();
     // add early stop mechanism
@@ -4758,7 +4704,7 @@ void HierRTLMP::enhancedMacroPlacement(Cluster* parent)
   int remaining_runs = target_util_list.size();
   int run_id = 0;
   SACoreSoftMacro* best_sa = nullptr;
-  std::vector<SACoreSoftMacro*>
+  std::vector<std::unique_ptr<SACoreSoftMacro>>
       sa_containers;  // store all the SA runs to avoid memory leakage
   float best_cost = std::numeric_limits<float>::max();
   debugPrint(logger_,
@@ -4767,7 +4713,7 @@ void HierRTLMP::enhancedMacroPlacement(Cluster* parent)
              1,
              "[EnhancedMacroPlacement] Start Simulated Annealing Core");
   while (remaining_runs > 0) {
-    std::vector<SACoreSoftMacro*> sa_vector;
+    std::vector<std::unique_ptr<SACoreSoftMacro>> sa_vector;
     run_thread
         = (remaining_runs > num_threads_) ? num_threads_ : remaining_runs;
     if (graphics_) {
@@ -4813,7 +4759,7 @@ void HierRTLMP::enhancedMacroPlacement(Cluster* parent)
       // Note that all the probabilities are normalized to the summation of 1.0.
       // Note that the weight are not necessaries summarized to 1.0, i.e., not
       // normalized.
-      SACoreSoftMacro* sa = new SACoreSoftMacro(
+      auto sa = std::make_unique<SACoreSoftMacro>(
           outline_width,
           outline_height,
           shaped_macros,
@@ -4846,27 +4792,16 @@ void HierRTLMP::enhancedMacroPlacement(Cluster* parent)
       sa->setNets(nets);
       sa->setBlockages(blockages);
       sa->setBlockages(macro_blockages);
-      sa_vector.push_back(sa);
-    }
-    if (sa_vector.size() == 1) {
-      runSA<SACoreSoftMacro>(sa_vector[0]);
-    } else {
-      // multi threads
-      std::vector<std::thread> threads;
-      for (auto& sa : sa_vector) {
-        threads.push_back(std::thread(runSA<SACoreSoftMacro>, sa));
-      }
-      for (auto& th : threads) {
-        th.join();
-      }
+      sa_vector.push_back(std::move(sa));
     }
+    runSAs(sa_vector);
     // add macro tilings
     for (auto& sa : sa_vector) {
-      sa_containers.push_back(sa);  // add SA to containers
       if (sa->isValid() && sa->getNormCost() < best_cost) {
         best_cost = sa->getNormCost();
-        best_sa = sa;
+        best_sa = sa.get();
       }
+      sa_containers.push_back(std::move(sa));  // add SA to containers
     }
     sa_vector.clear();
     // add early stop mechanism
@@ -5283,73 +5218,52 @@ void HierRTLMP::hardMacroClusterMacroPlacement(Cluster* cluster)
   const int num_perturb_per_step = (macros.size() > num_perturb_per_step_ / 10)
                                        ? macros.size()
                                        : num_perturb_per_step_ / 10;
-  int run_thread = num_threads_;
-  int remaining_runs = num_runs_;
-  int run_id = 0;
+  // The outline and wirelength weights follow the position of the run in
+  // its group of num_threads_ runs.
+  const int group_size = graphics_ ? 1 : num_threads_;
+  std::vector<std::unique_ptr<SACoreHardMacro>>
+      sa_containers;  // store all the SA runs
+  for (int run_id = 0; run_id < num_runs_; run_id++) {
+    const int i = run_id % group_size;
+    // change the aspect ratio
+    const float width = outline_width * vary_factor_list[run_id];
+    const float height = outline_width * outline_height / width;
+    auto sa = std::make_unique<SACoreHardMacro>(
+        width,
+        height,
+        macros,
+        area_weight_,
+        outline_weight_ * (i + 1) * 10,
+        wirelength_weight_ / (i + 1),
+        guidance_weight_,
+        fence_weight_,
+        pos_swap_prob_ * 10 / action_sum,
+        neg_swap_prob_ * 10 / action_sum,
+        double_swap_prob_ / action_sum,
+        exchange_swap_prob_ / action_sum,
+        flip_prob_ / action_sum,
+        init_prob_,
+        max_num_step_,
+        num_perturb_per_step,
+        k_,  // later will be updated to min_temperature
+        c_,
+        random_seed_ + run_id + 1,
+        graphics_.get(),
+        logger_);
+    sa->setNets(nets);
+    sa->setFences(fences);
+    sa->setGuides(guides);
+    sa_containers.push_back(std::move(sa));
+  }
+  runSAs(sa_containers);
   SACoreHardMacro* best_sa = nullptr;
-  std::vector<SACoreHardMacro*> sa_containers;  // store all the SA runs
   float best_cost = std::numeric_limits<float>::max();
-  while (remaining_runs > 0) {
-    std::vector<SACoreHardMacro*> sa_vector;
-    run_thread
-        = (remaining_runs > num_threads_) ? num_threads_ : remaining_runs;
-    if (graphics_) {
-      run_thread = 1;
-    }
-    for (int i = 0; i < run_thread; i++) {
-      // change the aspect ratio
-      const float width = outline_width * vary_factor_list[run_id++];
-      const float height = outline_width * outline_height / width;
-      SACoreHardMacro* sa
-          = new SACoreHardMacro(width,
-                                height,
-                                macros,
-                                area_weight_,
-                                outline_weight_ * (i + 1) * 10,
-                                wirelength_weight_ / (i + 1),
-                                guidance_weight_,
-                                fence_weight_,
-                                pos_swap_prob_ * 10 / action_sum,
-                                neg_swap_prob_ * 10 / action_sum,
-                                double_swap_prob_ / action_sum,
-                                exchange_swap_prob_ / action_sum,
-                                flip_prob_ / action_sum,
-                                init_prob_,
-                                max_num_step_,
-                                num_perturb_per_step,
-                                k_,  // later will be updated to min_temperature
-                                c_,
-                                random_seed_ + run_id,
-                                graphics_.get(),
-                                logger_);
-      sa->setNets(nets);
-      sa->setFences(fences);
-      sa->setGuides(guides);
-      sa_vector.push_back(sa);
+  for (auto& sa : sa_containers) {
+    if (sa->isValid(outline_width, outline_height)
+        && sa->getNormCost() < best_cost) {
+      best_cost = sa->getNormCost();
+      best_sa = sa.get();
     }
-    if (sa_vector.size() == 1) {
-      runSA<SACoreHardMacro>(sa_vector[0]);
-    } else {
-      // multi threads
-      std::vector<std::thread> threads;
-      for (auto& sa : sa_vector) {
-        threads.push_back(std::thread(runSA<SACoreHardMacro>, sa));
-      }
-      for (auto& th : threads) {
-        th.join();
-      }
-    }
-    // add macro tilings
-    for (auto& sa : sa_vector) {
-      sa_containers.push_back(sa);  // add SA to containers
-      if (sa->isValid(outline_width, outline_height)
-          && sa->getNormCost() < best_cost) {
-        best_cost = sa->getNormCost();
-        best_sa = sa;
-      }
-    }
-    sa_vector.clear();
-    remaining_runs -= run_thread;
   }
   debugPrint(
       logger_,
@@ -149,6 +149,7 @@ class HierRTLMP
   void setDefaultThresholds();
   void createDataFlow();
   void updateDataFlow();
+  size_t computeNetlistHash() const;
   void dataFlowDFSIOPin(int parent,
                         int idx,
                         std::vector<std::set<odb::dbInst*>>& insts,
@@ -220,6 +221,9 @@ class HierRTLMP
   // multi thread enabled
   // random seed deterministic enabled
   void calHardMacroClusterShape(Cluster* cluster);
+  // Run all the SA workers on a pool of up to num_threads_ threads
+  template <class SACore>
+  void runSAs(std::vector<std::unique_ptr<SACore>>& sa_list);
   // The cluster placement is done in a top-down manner
   // (Preorder DFS)
   void multiLevelMacroPlacement(Cluster* parent);
@@ -370,6 +374,9 @@ class HierRTLMP
       io_ffs_conn_map_;
   std::vector<std::pair<odb::dbITerm*, std::vector<std::set<odb::dbInst*>>>>
       macro_macro_conn_map_;
+  // the dataflow above is reused by later runs on the same netlist
+  bool dataflow_valid_ = false;
+  size_t dataflow_netlist_hash_ = 0;
 
   // statistics of the design
   // Here when we calculate macro area, we do not include halo_width
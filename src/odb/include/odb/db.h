@@ -97,6 +97,7 @@ class dbRow;
 class dbFill;
 class dbTechAntennaPinModel;
 class dbBlockCallBackObj;
+class dbBlockIndex;
 class dbRegion;
 class dbBPin;
 
@@ -368,6 +369,16 @@ class dbDatabase : public dbObject
   ///
   void read(std::ifstream& f);
 
+  ///
+  /// Read a database from the named file by mapping it into memory, so
+  /// pages are faulted in by the OS as the reader advances rather than
+  /// copied through a stream buffer.
+  /// Returns false, leaving the database untouched, if the file could not
+  /// be mapped; callers may then fall back to read().
+  /// WARNING: This function destroys the data currently in the database.
+  ///
+  bool readMapped(const char* filename);
+
   ///
   /// Write a database to this stream.
   /// Throws ZIOError..
@@ -392,6 +403,23 @@ class dbDatabase : public dbObject
   void readParasitics(std::ifstream& f, dbBlock* block);
   void readChip(std::ifstream& f);
 
+  ///
+  /// Save a library to filename so it can be reloaded with readLibCache
+  /// instead of re-reading its LEF. The file records the schema revision.
+  /// Returns false if the file could not be written.
+  ///
+  bool writeLibCache(const char* filename, dbLib* lib);
+
+  ///
+  /// Load a library saved by writeLibCache as a new library of this
+  /// database bound to tech. The library's masters refer to tech layers
+  /// and vias by id, so tech must match the one the cache was made with.
+  /// Returns nullptr if the file does not exist, was written with another
+  /// schema revision, or holds a library whose name is already in use.
+  /// Throws on a truncated file.
+  ///
+  dbLib* readLibCache(const char* filename, dbTech* tech);
+
   ///
   /// ECO - The following methods implement a simple ECO mechanism for capturing
   /// netlist changes. The intent of the ECO mechanism is to support delta
@@ -416,6 +444,21 @@ class dbDatabase : public dbObject
   ///
   static void endEco(dbBlock* block);
 
+  ///
+  /// End collecting netlist changes on specified block, and append them to
+  /// the pending eco instead of replacing it.
+  ///
+  static void appendEco(dbBlock* block);
+
+  ///
+  /// Revert the changes collected since beginEco and stop collecting.
+  /// The cost is proportional to the number of journaled edits. Instance
+  /// moves, orient/status changes, master swaps, iterm connects and
+  /// disconnects and net/instance creation are reverted; other edits
+  /// (e.g. object deletion, parasitics) are not.
+  ///
+  static void undoEco(dbBlock* block);
+
   ///
   /// Returns true of the pending eco is empty
   ///
@@ -985,6 +1028,25 @@ class dbBlock : public dbObject
   ///
   dbInst* findInst(const char* name);
 
+  ///
+  /// Find many instances at once.  The result has one entry per name,
+  /// nullptr for names that were not found.
+  ///
+  std::vector<dbInst*> findInsts(const std::vector<std::string>& names);
+
+  ///
+  /// Get the shared spatial index of this block's instances and special
+  /// wire shapes.  It is built on first use and then kept current.
+  ///
+  dbBlockIndex* getSpatialIndex();
+
+  ///
+  /// Size the instance and net name tables for the given number of objects
+  /// so that bulk creation (e.g. from DEF) does not rehash repeatedly.
+  ///
+  void reserveInsts(uint count);
+  void reserveNets(uint count);
+
   ///
   /// Find a specific module in this block.
   /// Returns nullptr if the object was not found.
@@ -1081,6 +1143,12 @@ class dbBlock : public dbObject
   ///
   dbNet* findNet(const char* name);
 
+  ///
+  /// Find many nets at once.  The result has one entry per name, nullptr
+  /// for names that were not found.
+  ///
+  std::vector<dbNet*> findNets(const std::vector<std::string>& names);
+
   ///
   /// Find a set of nets. Each name can be real name, or Nxxx, or xxx,
   /// where xxx is the net oid.
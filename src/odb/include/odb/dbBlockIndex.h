@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "dbBlockCallBackObj.h"
+#include "geom.h"
+
+namespace odb {
+
+class dbBlock;
+class dbInst;
+class dbMaster;
+class dbRegion;
+class dbSBox;
+class dbSWire;
+class dbTechLayer;
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// dbBlockIndex - A spatial index over the instances and special wire
+/// shapes of a block. It registers itself as a callback on the block and
+/// follows instance creation, moves, master swaps and special wire edits,
+/// so clients can share one index instead of rebuilding their own.
+///
+/// Use dbBlock::getSpatialIndex() to get the block's shared index.
+///
+///////////////////////////////////////////////////////////////////////////////
+class dbBlockIndex : public dbBlockCallBackObj
+{
+ public:
+  dbBlockIndex(dbBlock* block);
+  ~dbBlockIndex() override;
+
+  // Instances whose bounding box intersects rect.
+  std::vector<dbInst*> findInsts(const Rect& rect) const;
+
+  // Special wire shapes on layer that intersect rect.  Via shapes are
+  // indexed by their per layer boxes.
+  std::vector<dbSBox*> findSBoxes(dbTechLayer* layer, const Rect& rect) const;
+
+  // dbBlockCallBackObj
+  void inDbInstCreate(dbInst* inst) override;
+  void inDbInstCreate(dbInst* inst, dbRegion* region) override;
+  void inDbInstDestroy(dbInst* inst) override;
+  void inDbInstSwapMasterBefore(dbInst* inst, dbMaster* master) override;
+  void inDbInstSwapMasterAfter(dbInst* inst) override;
+  void inDbPreMoveInst(dbInst* inst) override;
+  void inDbPostMoveInst(dbInst* inst) override;
+  void inDbSWireAddSBox(dbSBox* box) override;
+  void inDbSWireRemoveSBox(dbSBox* box) override;
+  void inDbSWirePreDestroySBoxes(dbSWire* wire) override;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace odb
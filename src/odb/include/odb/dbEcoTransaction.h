@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "db.h"
+
+namespace odb {
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// dbEcoTransaction - A scoped set of tentative edits on a block. Edits
+/// made while the transaction is alive are journaled; unless commit() is
+/// called they are reverted when it goes out of scope:
+///
+///   {
+///     dbEcoTransaction trial(block);
+///     inst->swapMaster(bigger);
+///     if (better()) {
+///       trial.commit();
+///     }
+///   }  // reverted here unless committed
+///
+/// Transactions share the block's ECO journal and can not be nested with
+/// each other or with beginEco/endEco.  The edits of sequential committed
+/// transactions are appended to the block's pending eco.
+///
+///////////////////////////////////////////////////////////////////////////////
+class dbEcoTransaction
+{
+ public:
+  explicit dbEcoTransaction(dbBlock* block) : block_(block)
+  {
+    dbDatabase::beginEco(block_);
+  }
+
+  ~dbEcoTransaction()
+  {
+    if (block_) {
+      dbDatabase::undoEco(block_);
+    }
+  }
+
+  dbEcoTransaction(const dbEcoTransaction&) = delete;
+  dbEcoTransaction& operator=(const dbEcoTransaction&) = delete;
+
+  /// Keep the edits; they are appended to the block's pending eco.
+  void commit()
+  {
+    dbDatabase::appendEco(block_);
+    block_ = nullptr;
+  }
+
+  /// Revert the edits now rather than at the end of the scope.
+  void rollback()
+  {
+    dbDatabase::undoEco(block_);
+    block_ = nullptr;
+  }
+
+ private:
+  dbBlock* block_;
+};
+
+}  // namespace odb
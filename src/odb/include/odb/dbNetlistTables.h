@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace odb {
+
+class dbBlock;
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// dbNetlistTables - A column-oriented snapshot of a block's netlist and
+/// placement for bulk export to analytics tools.
+///
+/// Instances and nets are numbered by their row in the inst_* and net_*
+/// columns. There is one pin row per instance terminal, in block order;
+/// pin_net is -1 for unconnected terminals. Enumerated columns hold the
+/// dbOrientType, dbPlacementStatus and dbSigType values.
+///
+///////////////////////////////////////////////////////////////////////////////
+struct dbNetlistTables
+{
+  std::vector<std::string> inst_name;
+  std::vector<std::string> inst_master;
+  std::vector<int> inst_x;
+  std::vector<int> inst_y;
+  std::vector<int> inst_orient;
+  std::vector<int> inst_status;
+
+  std::vector<std::string> net_name;
+  std::vector<int> net_sig_type;
+
+  std::vector<int> pin_inst;
+  std::vector<int> pin_net;
+  std::vector<std::string> pin_name;
+
+  ///
+  /// Fill the tables from block in one pass over its instances, nets and
+  /// terminals. The pass is spread over num_threads threads (e.g. the
+  /// OpenROAD thread_count); the block must not be modified meanwhile.
+  ///
+  static void extract(dbBlock* block,
+                      dbNetlistTables& tables,
+                      int num_threads = 1);
+
+  ///
+  /// Write the tables as insts.csv, nets.csv and pins.csv in dir, which
+  /// must exist. Returns false if a file can not be opened.
+  ///
+  bool writeCsv(const char* dir) const;
+};
+
+}  // namespace odb
@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "dbIterator.h"
 
 namespace odb {
@@ -224,3 +226,61 @@ inline dbSetIterator<T> dbSetIterator<T>::operator++(int)
 #include "dbBlockSet.h"
 #include "dbCCSegSet.h"
 #include "dbNetSet.h"
+
+namespace odb {
+
+///
+/// A consecutive range of a dbSet, usable in a range-based for loop.
+///
+template <class T>
+class dbSetRange
+{
+  typename dbSet<T>::iterator _begin;
+  typename dbSet<T>::iterator _end;
+
+ public:
+  dbSetRange(const typename dbSet<T>::iterator& begin,
+             const typename dbSet<T>::iterator& end)
+      : _begin(begin), _end(end)
+  {
+  }
+
+  typename dbSet<T>::iterator begin() const { return _begin; }
+  typename dbSet<T>::iterator end() const { return _end; }
+};
+
+///
+/// Split a set into at most num_chunks consecutive ranges of about equal
+/// size, e.g. to distribute a netlist walk over a parallel for loop.
+///
+/// The set is walked once, serially, to find the range boundaries.
+/// Iterating the ranges afterwards only reads the database: set
+/// iterators keep no shared state, so distinct ranges may be walked from
+/// different threads provided nothing modifies the block meanwhile.
+/// Accessors that cache results on first use (e.g. dbBlock::getBBox)
+/// should be called once before the parallel section.
+///
+template <class T>
+inline std::vector<dbSetRange<T>> splitSet(dbSet<T> set, uint num_chunks)
+{
+  std::vector<dbSetRange<T>> ranges;
+  const uint size = set.size();
+  if (size == 0 || num_chunks == 0) {
+    return ranges;
+  }
+
+  const uint chunk_size = (size + num_chunks - 1) / num_chunks;
+  ranges.reserve(num_chunks);
+  auto it = set.begin();
+  const auto end = set.end();
+  while (it != end) {
+    const auto first = it;
+    for (uint i = 0; i < chunk_size && it != end; ++i) {
+      ++it;
+    }
+    ranges.emplace_back(first, it);
+  }
+  return ranges;
+}
+
+}  // namespace odb
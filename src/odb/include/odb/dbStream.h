@@ -37,6 +37,7 @@
 #include <cstring>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "ZException.h"
 #include "dbObject.h"
@@ -48,12 +49,21 @@ namespace odb {
 
 class _dbDatabase;
 
+//
+// dbOStream - Writes are collected in a user space buffer and handed to
+// the FILE in large blocks. Call flush() before touching the FILE directly;
+// the destructor only makes a best effort attempt as it cannot throw.
+//
 class dbOStream
 {
   _dbDatabase* _db;
   FILE* _f;
   double _lef_area_factor;
   double _lef_dist_factor;
+  std::vector<char> _buf;
+  size_t _buf_pos;
+
+  static constexpr size_t kBufferSize = 1 << 20;
 
   void write_error()
   {
@@ -63,9 +73,42 @@ class dbOStream
 
  public:
   dbOStream(_dbDatabase* db, FILE* f);
+  ~dbOStream();
 
   _dbDatabase* getDatabase() { return _db; }
 
+  // Append size bytes to the stream.  Large blocks bypass the buffer.
+  void writeRaw(const void* data, size_t size)
+  {
+    if (_buf_pos + size <= _buf.size()) {
+      std::memcpy(_buf.data() + _buf_pos, data, size);
+      _buf_pos += size;
+      return;
+    }
+    flush();
+    if (size >= _buf.size()) {
+      if (fwrite(data, size, 1, _f) != 1) {
+        write_error();
+      }
+      return;
+    }
+    std::memcpy(_buf.data(), data, size);
+    _buf_pos = size;
+  }
+
+  // Hand all buffered bytes to the FILE.
+  void flush()
+  {
+    if (_buf_pos == 0) {
+      return;
+    }
+    size_t n = fwrite(_buf.data(), _buf_pos, 1, _f);
+    _buf_pos = 0;
+    if (n != 1) {
+      write_error();
+    }
+  }
+
   dbOStream& operator<<(bool c)
   {
     unsigned char b = (c == true ? 1 : 0);
@@ -74,100 +117,67 @@ class dbOStream
 
   dbOStream& operator<<(char c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeRaw(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(unsigned char c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeRaw(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(int16_t c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeRaw(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(uint16_t c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeRaw(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(int c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeRaw(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(uint64_t c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeRaw(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(unsigned int c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeRaw(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(int8_t c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeRaw(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(float c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeRaw(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(double c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeRaw(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(long double c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeRaw(&c, sizeof(c));
     return *this;
   }
 
@@ -178,10 +188,7 @@ class dbOStream
     } else {
       int l = strlen(c) + 1;
       *this << l;
-      int n = fwrite(c, l, 1, _f);
-      if (n != 1) {
-        write_error();
-      }
+      writeRaw(c, l);
     }
 
     return *this;
@@ -189,10 +196,7 @@ class dbOStream
 
   dbOStream& operator<<(dbObjectType c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeRaw(&c, sizeof(c));
     return *this;
   }
 
@@ -249,18 +253,42 @@ class dbOStream
   double lefdist(int value) { return ((double) value * _lef_dist_factor); }
 };
 
+//
+// dbIStream - Reads either from an ifstream or from an in-memory image of
+// the file (see dbDatabase::readMapped).
+//
 class dbIStream
 {
-  std::ifstream& _f;
+  std::ifstream* _f;
+  const char* _data;
+  size_t _size;
+  size_t _pos;
   _dbDatabase* _db;
   double _lef_area_factor;
   double _lef_dist_factor;
 
+  void init(_dbDatabase* db);
+
  public:
   dbIStream(_dbDatabase* db, std::ifstream& f);
+  dbIStream(_dbDatabase* db, const char* data, size_t size);
 
   _dbDatabase* getDatabase() { return _db; }
 
+  // Read size bytes from the stream.
+  void readRaw(void* data, size_t size)
+  {
+    if (_data) {
+      if (size > _size - _pos) {
+        throw ZException("read past the end of the database image");
+      }
+      std::memcpy(data, _data + _pos, size);
+      _pos += size;
+      return;
+    }
+    _f->read(reinterpret_cast<char*>(data), size);
+  }
+
   dbIStream& operator>>(bool& c)
   {
     unsigned char b;
@@ -271,67 +299,67 @@ class dbIStream
 
   dbIStream& operator>>(char& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readRaw(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(unsigned char& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readRaw(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(int16_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readRaw(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(uint16_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readRaw(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(int& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readRaw(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(uint64_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readRaw(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(unsigned int& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readRaw(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(int8_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readRaw(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(float& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readRaw(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(double& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readRaw(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(long double& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readRaw(&c, sizeof(c));
     return *this;
   }
 
@@ -344,7 +372,7 @@ class dbIStream
       c = nullptr;
     } else {
       c = (char*) malloc(l);
-      _f.read(reinterpret_cast<char*>(c), l);
+      readRaw(c, l);
     }
 
     return *this;
@@ -352,7 +380,7 @@ class dbIStream
 
   dbIStream& operator>>(dbObjectType& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readRaw(&c, sizeof(c));
     return *this;
   }
 
@@ -65,6 +65,7 @@ class defout
   void setUseMasterIds(bool value);
   void selectNet(dbNet* net);
   void setVersion(Version v);  // default is 5.8
+  void setNumThreads(int threads);  // threads formatting the nets
 
   bool writeBlock(dbBlock* block, const char* def_file);
 };
@@ -126,6 +126,10 @@ class lefin
   }
 
   bool readLef(const char* lef_file);
+  std::string libCachePath(dbTech* tech,
+                           const char* name,
+                           const char* lef_file,
+                           const char* cache_dir);
   bool addGeoms(dbObject* object, bool is_pin, lefiGeometries* geometry);
   void createLibrary();
   void createPolygon(dbObject* object,
@@ -243,6 +247,14 @@ class lefin
   // Create a library from the library-data of this LEF file.
   dbLib* createLib(dbTech* tech, const char* name, const char* lef_file);
 
+  // Same as createLib, but first looks in cache_dir for a library made
+  // from a LEF file with the same contents against the same technology.
+  // On a miss the LEF is read and the library is saved to cache_dir.
+  dbLib* createLibCached(dbTech* tech,
+                         const char* name,
+                         const char* lef_file,
+                         const char* cache_dir);
+
   // Create a technology and library from the MACRO's in this LEF file.
   dbLib* createTechAndLib(const char* tech_name,
                           const char* lib_name,
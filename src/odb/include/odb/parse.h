@@ -78,10 +78,12 @@ class Ath__parser
   void reportProgress();
   int mkWords(int jj);
   bool isSeparator(char a);
+  void updateSeparatorTable();
 
   char* _line;
   char* _tmpLine;
   char* _wordSeparators;
+  bool _separatorTable[256];
   char** _wordArray;
   char _commentChar;
   int _maxWordCnt;
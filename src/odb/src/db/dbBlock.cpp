@@ -49,6 +49,7 @@
 #include "dbBTerm.h"
 #include "dbBTermItr.h"
 #include "dbBlockCallBackObj.h"
+#include "dbBlockIndex.h"
 #include "dbBlockItr.h"
 #include "dbBlockage.h"
 #include "dbBox.h"
@@ -312,6 +313,8 @@ _dbBlock::_dbBlock(_dbDatabase* db)
 
   _net_hash.setTable(_net_tbl);
   _inst_hash.setTable(_inst_tbl);
+  _net_hash.cacheHashes();
+  _inst_hash.cacheHashes();
   _module_hash.setTable(_module_tbl);
   _modinst_hash.setTable(_modinst_tbl);
   _powerdomain_hash.setTable(_powerdomain_tbl);
@@ -371,6 +374,7 @@ _dbBlock::_dbBlock(_dbDatabase* db)
   _extmi = nullptr;
   _journal = nullptr;
   _journal_pending = nullptr;
+  _spatial_index = nullptr;
 }
 
 _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
@@ -507,6 +511,8 @@ _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
 
   _net_hash.setTable(_net_tbl);
   _inst_hash.setTable(_inst_tbl);
+  _net_hash.cacheHashes();
+  _inst_hash.cacheHashes();
   _module_hash.setTable(_module_tbl);
   _modinst_hash.setTable(_modinst_tbl);
   _group_hash.setTable(_group_tbl);
@@ -573,10 +579,14 @@ _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
   _extmi = block._extmi;
   _journal = nullptr;
   _journal_pending = nullptr;
+  _spatial_index = nullptr;
 }
 
 _dbBlock::~_dbBlock()
 {
+  // Detach the index while the callback list is still intact.
+  delete _spatial_index;
+
   if (_name)
     free((void*) _name);
 
@@ -1067,6 +1077,10 @@ dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
   // TOM
   //-------------------------------------------------------------------------------
 
+  // Name lookups are the hot path for SDC and netlist readers.
+  block._net_hash.cacheHashes();
+  block._inst_hash.cacheHashes();
+
   return stream;
 }
 
@@ -1787,6 +1801,38 @@ dbInst* dbBlock::findInst(const char* name)
   return (dbInst*) block->_inst_hash.find(name);
 }
 
+std::vector<dbInst*> dbBlock::findInsts(const std::vector<std::string>& names)
+{
+  _dbBlock* block = (_dbBlock*) this;
+  std::vector<dbInst*> insts;
+  insts.reserve(names.size());
+  for (const std::string& name : names) {
+    insts.push_back((dbInst*) block->_inst_hash.find(name.c_str()));
+  }
+  return insts;
+}
+
+dbBlockIndex* dbBlock::getSpatialIndex()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  if (block->_spatial_index == nullptr) {
+    block->_spatial_index = new dbBlockIndex(this);
+  }
+  return block->_spatial_index;
+}
+
+void dbBlock::reserveInsts(uint count)
+{
+  _dbBlock* block = (_dbBlock*) this;
+  block->_inst_hash.reserve(count);
+}
+
+void dbBlock::reserveNets(uint count)
+{
+  _dbBlock* block = (_dbBlock*) this;
+  block->_net_hash.reserve(count);
+}
+
 dbModule* dbBlock::findModule(const char* name)
 {
   _dbBlock* block = (_dbBlock*) this;
@@ -1892,6 +1938,17 @@ dbNet* dbBlock::findNet(const char* name)
   return (dbNet*) block->_net_hash.find(name);
 }
 
+std::vector<dbNet*> dbBlock::findNets(const std::vector<std::string>& names)
+{
+  _dbBlock* block = (_dbBlock*) this;
+  std::vector<dbNet*> nets;
+  nets.reserve(names.size());
+  for (const std::string& name : names) {
+    nets.push_back((dbNet*) block->_net_hash.find(name.c_str()));
+  }
+  return nets;
+}
+
 bool dbBlock::findSomeMaster(const char* names, std::vector<dbMaster*>& masters)
 {
   if (!names || names[0] == '\0')
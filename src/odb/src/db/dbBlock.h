@@ -123,6 +123,7 @@ class dbOStream;
 class dbDiff;
 class dbBlockSearch;
 class dbBlockCallBackObj;
+class dbBlockIndex;
 class dbGuideItr;
 class dbNetTrackItr;
 
@@ -257,6 +258,9 @@ class _dbBlock : public _dbObject
   dbJournal* _journal;
   dbJournal* _journal_pending;
 
+  // NON-PERSISTANT-MEMBERS
+  dbBlockIndex* _spatial_index;
+
   _dbBlock(_dbDatabase* db);
   _dbBlock(_dbDatabase* db, const _dbBlock& block);
   ~_dbBlock();
@@ -0,0 +1,212 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbBlockIndex.h"
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <map>
+#include <utility>
+
+#include "db.h"
+#include "dbShape.h"
+
+namespace odb {
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+using BgPoint = bg::model::d2::point_xy<int, bg::cs::cartesian>;
+using BgBox = bg::model::box<BgPoint>;
+
+template <typename T>
+using IndexTree = bgi::rtree<std::pair<BgBox, T>, bgi::quadratic<16>>;
+
+static BgBox toBgBox(const Rect& rect)
+{
+  return BgBox(BgPoint(rect.xMin(), rect.yMin()),
+               BgPoint(rect.xMax(), rect.yMax()));
+}
+
+struct dbBlockIndex::Impl
+{
+  IndexTree<dbInst*> insts;
+  std::map<dbTechLayer*, IndexTree<dbSBox*>> sboxes;
+
+  void insertInst(dbInst* inst)
+  {
+    insts.insert({toBgBox(inst->getBBox()->getBox()), inst});
+  }
+
+  void removeInst(dbInst* inst)
+  {
+    insts.remove({toBgBox(inst->getBBox()->getBox()), inst});
+  }
+
+  // Calls fn(layer, rect) for each layer shape of box.
+  template <typename Fn>
+  void forEachShape(dbSBox* box, Fn fn)
+  {
+    if (box->isVia()) {
+      std::vector<dbShape> shapes;
+      box->getViaBoxes(shapes);
+      for (const dbShape& shape : shapes) {
+        fn(shape.getTechLayer(), shape.getBox());
+      }
+    } else {
+      fn(box->getTechLayer(), box->getBox());
+    }
+  }
+
+  void insertSBox(dbSBox* box)
+  {
+    forEachShape(box, [this, box](dbTechLayer* layer, const Rect& rect) {
+      sboxes[layer].insert({toBgBox(rect), box});
+    });
+  }
+
+  void removeSBox(dbSBox* box)
+  {
+    forEachShape(box, [this, box](dbTechLayer* layer, const Rect& rect) {
+      auto it = sboxes.find(layer);
+      if (it != sboxes.end()) {
+        it->second.remove({toBgBox(rect), box});
+      }
+    });
+  }
+};
+
+dbBlockIndex::dbBlockIndex(dbBlock* block) : impl_(std::make_unique<Impl>())
+{
+  // Bulk load the instances with the packing algorithm rather than
+  // inserting them one by one.
+  std::vector<std::pair<BgBox, dbInst*>> insts;
+  insts.reserve(block->getInsts().size());
+  for (dbInst* inst : block->getInsts()) {
+    insts.emplace_back(toBgBox(inst->getBBox()->getBox()), inst);
+  }
+  impl_->insts = IndexTree<dbInst*>(insts);
+
+  for (dbNet* net : block->getNets()) {
+    for (dbSWire* swire : net->getSWires()) {
+      for (dbSBox* box : swire->getWires()) {
+        impl_->insertSBox(box);
+      }
+    }
+  }
+
+  addOwner(block);
+}
+
+dbBlockIndex::~dbBlockIndex() = default;
+
+std::vector<dbInst*> dbBlockIndex::findInsts(const Rect& rect) const
+{
+  std::vector<dbInst*> result;
+  for (auto it = impl_->insts.qbegin(bgi::intersects(toBgBox(rect)));
+       it != impl_->insts.qend();
+       ++it) {
+    result.push_back(it->second);
+  }
+  return result;
+}
+
+std::vector<dbSBox*> dbBlockIndex::findSBoxes(dbTechLayer* layer,
+                                              const Rect& rect) const
+{
+  std::vector<dbSBox*> result;
+  auto tree = impl_->sboxes.find(layer);
+  if (tree == impl_->sboxes.end()) {
+    return result;
+  }
+  for (auto it = tree->second.qbegin(bgi::intersects(toBgBox(rect)));
+       it != tree->second.qend();
+       ++it) {
+    result.push_back(it->second);
+  }
+  return result;
+}
+
+void dbBlockIndex::inDbInstCreate(dbInst* inst)
+{
+  impl_->insertInst(inst);
+}
+
+void dbBlockIndex::inDbInstCreate(dbInst* inst, dbRegion* /* region */)
+{
+  impl_->insertInst(inst);
+}
+
+void dbBlockIndex::inDbInstDestroy(dbInst* inst)
+{
+  impl_->removeInst(inst);
+}
+
+void dbBlockIndex::inDbInstSwapMasterBefore(dbInst* inst,
+                                            dbMaster* /* master */)
+{
+  impl_->removeInst(inst);
+}
+
+void dbBlockIndex::inDbInstSwapMasterAfter(dbInst* inst)
+{
+  impl_->insertInst(inst);
+}
+
+void dbBlockIndex::inDbPreMoveInst(dbInst* inst)
+{
+  impl_->removeInst(inst);
+}
+
+void dbBlockIndex::inDbPostMoveInst(dbInst* inst)
+{
+  impl_->insertInst(inst);
+}
+
+void dbBlockIndex::inDbSWireAddSBox(dbSBox* box)
+{
+  impl_->insertSBox(box);
+}
+
+void dbBlockIndex::inDbSWireRemoveSBox(dbSBox* box)
+{
+  impl_->removeSBox(box);
+}
+
+void dbBlockIndex::inDbSWirePreDestroySBoxes(dbSWire* wire)
+{
+  for (dbSBox* box : wire->getWires()) {
+    impl_->removeSBox(box);
+  }
+}
+
+}  // namespace odb
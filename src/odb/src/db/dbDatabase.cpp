@@ -32,8 +32,15 @@
 
 #include "dbDatabase.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
 
 #include "db.h"
@@ -48,6 +55,7 @@
 #include "dbITerm.h"
 #include "dbJournal.h"
 #include "dbLib.h"
+#include "dbMaster.h"
 #include "dbNameCache.h"
 #include "dbNet.h"
 #include "dbProperty.h"
@@ -453,6 +461,35 @@ void dbDatabase::read(std::ifstream& file)
   stream >> *db;
 }
 
+bool dbDatabase::readMapped(const char* filename)
+{
+  const int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return false;
+  }
+  const size_t size = st.st_size;
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+  madvise(data, size, MADV_SEQUENTIAL);
+
+  // Unmap on both the normal and the exception path.
+  std::unique_ptr<void, std::function<void(void*)>> guard(
+      data, [size](void* p) { munmap(p, size); });
+
+  _dbDatabase* db = (_dbDatabase*) this;
+  dbIStream stream(db, static_cast<const char*>(data), size);
+  stream >> *db;
+  return true;
+}
+
 void dbDatabase::readTech(std::ifstream& file)
 {
   _dbDatabase* db = (_dbDatabase*) this;
@@ -547,11 +584,74 @@ void dbDatabase::readChip(std::ifstream& file)
   stream >> *chip;
 }
 
+bool dbDatabase::writeLibCache(const char* filename, dbLib* lib)
+{
+  _dbDatabase* db = (_dbDatabase*) this;
+  FILE* file = fopen(filename, "wb");
+  if (!file) {
+    return false;
+  }
+
+  {
+    dbOStream stream(db, file);
+    stream << db_schema_minor;
+    stream << *(_dbLib*) lib;
+    stream.flush();
+  }
+  const bool ok = ferror(file) == 0;
+  fclose(file);
+  return ok;
+}
+
+dbLib* dbDatabase::readLibCache(const char* filename, dbTech* tech)
+{
+  _dbDatabase* db = (_dbDatabase*) this;
+  // The library stream is decoded against this database's schema.
+  if (db->_schema_minor != db_schema_minor) {
+    return nullptr;
+  }
+
+  std::ifstream file;
+  file.open(filename, std::ios::binary);
+  if (!file) {
+    return nullptr;
+  }
+  file.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                  | std::ios::eofbit);
+
+  dbIStream stream(db, file);
+  uint schema;
+  stream >> schema;
+  if (schema != db_schema_minor) {
+    return nullptr;
+  }
+
+  _dbLib* lib = db->_lib_tbl->create();
+  stream >> *lib;
+  lib->_tech = tech->getId();
+
+  for (dbLib* other : getLibs()) {
+    if (other != (dbLib*) lib
+        && strcmp(other->getConstName(), lib->_name) == 0) {
+      dbLib::destroy((dbLib*) lib);
+      return nullptr;
+    }
+  }
+
+  // Master ids are numbered across all the libraries of a database.
+  for (dbMaster* master : ((dbLib*) lib)->getMasters()) {
+    ((_dbMaster*) master)->_id = db->_master_id++;
+  }
+
+  return (dbLib*) lib;
+}
+
 void dbDatabase::write(FILE* file)
 {
   _dbDatabase* db = (_dbDatabase*) this;
   dbOStream stream(db, file);
   stream << *db;
+  stream.flush();
   fflush(file);
 }
 
@@ -565,6 +665,7 @@ void dbDatabase::writeTech(FILE* file)
 
   dbOStream stream(db, file);
   stream << *tech;
+  stream.flush();
   fflush(file);
 }
 
@@ -573,6 +674,7 @@ void dbDatabase::writeLib(FILE* file, dbLib* lib)
   _dbDatabase* db = (_dbDatabase*) this;
   dbOStream stream(db, file);
   stream << *(_dbLib*) lib;
+  stream.flush();
   fflush(file);
 }
 
@@ -581,6 +683,7 @@ void dbDatabase::writeLibs(FILE* file)
   _dbDatabase* db = (_dbDatabase*) this;
   dbOStream stream(db, file);
   stream << *db->_lib_tbl;
+  stream.flush();
   fflush(file);
 }
 
@@ -589,6 +692,7 @@ void dbDatabase::writeBlock(FILE* file, dbBlock* block)
   _dbDatabase* db = (_dbDatabase*) this;
   dbOStream stream(db, file);
   stream << *(_dbBlock*) block;
+  stream.flush();
   fflush(file);
 }
 
@@ -597,6 +701,7 @@ void dbDatabase::writeNets(FILE* file, dbBlock* block)
   _dbDatabase* db = (_dbDatabase*) this;
   dbOStream stream(db, file);
   stream << *((_dbBlock*) block)->_net_tbl;
+  stream.flush();
   fflush(file);
 }
 
@@ -605,6 +710,7 @@ void dbDatabase::writeWires(FILE* file, dbBlock* block)
   _dbDatabase* db = (_dbDatabase*) this;
   dbOStream stream(db, file);
   stream << *((_dbBlock*) block)->_wire_tbl;
+  stream.flush();
   fflush(file);
 }
 
@@ -621,6 +727,7 @@ void dbDatabase::writeParasitics(FILE* file, dbBlock* block)
   stream << *((_dbBlock*) block)->_r_seg_tbl;
   stream << *((_dbBlock*) block)->_cc_seg_tbl;
   stream << *((_dbBlock*) block)->_extControl;
+  stream.flush();
   fflush(file);
 }
 
@@ -630,6 +737,7 @@ void dbDatabase::writeChip(FILE* file)
   _dbChip* chip = (_dbChip*) getChip();
   dbOStream stream(db, file);
   stream << *chip;
+  stream.flush();
   fflush(file);
 }
 
@@ -656,6 +764,36 @@ void dbDatabase::endEco(dbBlock* block_)
   block->_journal_pending = eco;
 }
 
+void dbDatabase::appendEco(dbBlock* block_)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+  dbJournal* eco = block->_journal;
+  block->_journal = nullptr;
+
+  if (!block->_journal_pending) {
+    block->_journal_pending = eco;
+    return;
+  }
+
+  if (eco) {
+    block->_journal_pending->append(*eco);
+    delete eco;
+  }
+}
+
+void dbDatabase::undoEco(dbBlock* block_)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+  dbJournal* eco = block->_journal;
+  if (!eco)
+    return;
+
+  // Detach first so the reverting edits are not journaled themselves.
+  block->_journal = nullptr;
+  eco->undo();
+  delete eco;
+}
+
 bool dbDatabase::ecoEmpty(dbBlock* block_)
 {
   _dbBlock* block = (_dbBlock*) block_;
@@ -712,6 +850,7 @@ void dbDatabase::writeEco(dbBlock* block_, const char* filename)
   if (block->_journal_pending) {
     dbOStream stream(block->getDatabase(), file);
     stream << *block->_journal_pending;
+    stream.flush();
   }
 
   fclose(file);
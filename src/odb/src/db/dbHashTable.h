@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "dbPagedVector.h"
 #include "odb.h"
 
@@ -68,6 +70,10 @@ class dbHashTable
 
   // NON-PERSISTANT-MEMBERS
   dbTable<T>* _obj_tbl;
+  // hash_string() of each entry's name indexed by object id, so chain
+  // walks can skip strcmp on mismatches.  Only kept after cacheHashes().
+  std::vector<uint> _name_hashes;
+  bool _cache_hashes;
 
   void growTable();
   void shrinkTable();
@@ -87,6 +93,15 @@ class dbHashTable
   int hasMember(const char* name);
   void insert(T* object);
   void remove(T* object);
+  // Grow the table so that count entries fit within CHAIN_LENGTH.
+  void reserve(uint count);
+  // (Re)compute the name hash cache from the current entries and keep it
+  // up to date from now on.
+  void cacheHashes();
+
+ private:
+  uint entryHash(T* entry) const;
+  void setEntryHash(T* entry, uint hash);
 };
 
 template <class T>
@@ -53,14 +53,56 @@ dbHashTable<T>::dbHashTable()
 {
   _obj_tbl = nullptr;
   _num_entries = 0;
+  _cache_hashes = false;
 }
 
 template <class T>
 dbHashTable<T>::dbHashTable(const dbHashTable<T>& t)
-    : _hash_tbl(t._hash_tbl), _num_entries(t._num_entries), _obj_tbl(t._obj_tbl)
+    : _hash_tbl(t._hash_tbl),
+      _num_entries(t._num_entries),
+      _obj_tbl(t._obj_tbl),
+      _name_hashes(t._name_hashes),
+      _cache_hashes(t._cache_hashes)
 {
 }
 
+template <class T>
+inline uint dbHashTable<T>::entryHash(T* entry) const
+{
+  if (_cache_hashes) {
+    return _name_hashes[entry->getOID()];
+  }
+  return hash_string(entry->_name);
+}
+
+template <class T>
+inline void dbHashTable<T>::setEntryHash(T* entry, uint hash)
+{
+  if (!_cache_hashes) {
+    return;
+  }
+  const uint id = entry->getOID();
+  if (id >= _name_hashes.size()) {
+    _name_hashes.resize(id + 1);
+  }
+  _name_hashes[id] = hash;
+}
+
+template <class T>
+void dbHashTable<T>::cacheHashes()
+{
+  _cache_hashes = true;
+  _name_hashes.clear();
+  const uint sz = _hash_tbl.size();
+  for (uint i = 0; i < sz; ++i) {
+    for (dbId<T> cur = _hash_tbl[i]; cur != 0;) {
+      T* entry = _obj_tbl->getPtr(cur);
+      setEntryHash(entry, hash_string(entry->_name));
+      cur = entry->_next_entry;
+    }
+  }
+}
+
 template <class T>
 dbHashTable<T>::~dbHashTable()
 {
@@ -111,7 +153,7 @@ void dbHashTable<T>::growTable()
   while (cur != 0) {
     T* entry = _obj_tbl->getPtr(cur);
     dbId<T> next = entry->_next_entry;
-    uint hid = hash_string(entry->_name) & sz;
+    uint hid = entryHash(entry) & sz;
     dbId<T>& e = _hash_tbl[hid];
     entry->_next_entry = e;
     e = entry->getOID();
@@ -156,7 +198,7 @@ void dbHashTable<T>::shrinkTable()
   while (cur != 0) {
     T* entry = _obj_tbl->getPtr(cur);
     dbId<T> next = entry->_next_entry;
-    uint hid = hash_string(entry->_name) & sz;
+    uint hid = entryHash(entry) & sz;
     dbId<T>& e = _hash_tbl[hid];
     entry->_next_entry = e;
     e = entry->getOID();
@@ -183,12 +225,27 @@ void dbHashTable<T>::insert(T* object)
     }
   }
 
-  uint hid = hash_string(object->_name) & (sz - 1);
+  const uint hash = hash_string(object->_name);
+  setEntryHash(object, hash);
+  uint hid = hash & (sz - 1);
   dbId<T>& e = _hash_tbl[hid];
   object->_next_entry = e;
   e = object->getOID();
 }
 
+template <class T>
+void dbHashTable<T>::reserve(uint count)
+{
+  if (_hash_tbl.size() == 0) {
+    dbId<T> nullId;
+    _hash_tbl.push_back(nullId);
+  }
+
+  while (count / _hash_tbl.size() > CHAIN_LENGTH) {
+    growTable();
+  }
+}
+
 template <class T>
 T* dbHashTable<T>::find(const char* name)
 {
@@ -197,13 +254,15 @@ T* dbHashTable<T>::find(const char* name)
   if (sz == 0)
     return 0;
 
-  uint hid = hash_string(name) & (sz - 1);
+  const uint hash = hash_string(name);
+  uint hid = hash & (sz - 1);
   dbId<T> cur = _hash_tbl[hid];
 
   while (cur != 0) {
     T* entry = _obj_tbl->getPtr(cur);
 
-    if (strcmp(entry->_name, name) == 0)
+    if ((!_cache_hashes || _name_hashes[cur] == hash)
+        && strcmp(entry->_name, name) == 0)
       return entry;
 
     cur = entry->_next_entry;
@@ -220,13 +279,15 @@ int dbHashTable<T>::hasMember(const char* name)
   if (sz == 0)
     return false;
 
-  uint hid = hash_string(name) & (sz - 1);
+  const uint hash = hash_string(name);
+  uint hid = hash & (sz - 1);
   dbId<T> cur = _hash_tbl[hid];
 
   while (cur != 0) {
     T* entry = _obj_tbl->getPtr(cur);
 
-    if (strcmp(entry->_name, name) == 0)
+    if ((!_cache_hashes || _name_hashes[cur] == hash)
+        && strcmp(entry->_name, name) == 0)
       return true;
 
     cur = entry->_next_entry;
@@ -282,6 +343,10 @@ dbIStream& operator>>(dbIStream& stream, dbHashTable<T>& table)
 {
   stream >> table._hash_tbl;
   stream >> table._num_entries;
+  // The entries may not be loaded yet; the owner calls cacheHashes() again
+  // once they are.
+  table._name_hashes.clear();
+  table._cache_hashes = false;
   return stream;
 }
 
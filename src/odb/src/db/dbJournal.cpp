@@ -35,6 +35,7 @@
 #include "db.h"
 #include "dbBTerm.h"
 #include "dbBlock.h"
+#include "dbBlockCallBackObj.h"
 #include "dbCCSeg.h"
 #include "dbCapNode.h"
 #include "dbITerm.h"
@@ -587,12 +588,15 @@ void dbJournal::redo_disconnectObject()
       uint iterm_id;
       _log.pop(iterm_id);
       dbITerm* iterm = dbITerm::getITerm(_block, iterm_id);
+      uint net_id;
+      _log.pop(net_id);
       debugPrint(_logger,
                  utl::ODB,
                  "DB_ECO",
                  2,
-                 "REDO ECO: disconnect dbITermObj, iterm_id {}",
-                 iterm_id);
+                 "REDO ECO: disconnect dbITermObj, iterm_id {}, net_id {}",
+                 iterm_id,
+                 net_id);
       iterm->disconnect();
       break;
     }
@@ -1369,18 +1373,18 @@ void dbJournal::redo_updateCCSegField()
   }
 }
 
-//
-// WORK-IN-PROGRESS undo does not yet work.
-//
+// The actions are undone from the last one.  Each action ends with its
+// offset in the log (see endAction).
 void dbJournal::undo()
 {
   if (_log.empty())
     return;
 
-  _log.set(_log.size() - sizeof(uint));
+  uint action_end = _log.size();
 
   for (;;) {
     uint action_idx;
+    _log.setUIntBefore(action_end);
     _log.pop(action_idx);
     _log.set(action_idx);
     _log.pop(_cur_action);
@@ -1418,7 +1422,34 @@ void dbJournal::undo()
     if (action_idx == 0)
       break;
 
-    _log.set(action_idx -= sizeof(uint));
+    action_end = action_idx;
+  }
+}
+
+void dbJournal::append(dbJournal& journal)
+{
+  dbJournalLog& log = journal._log;
+  if (log.empty())
+    return;
+
+  // Find the actions of journal from the last one, as in undo
+  std::vector<uint> action_idxs;
+  std::vector<uint> offset_idxs;
+  uint action_end = log.size();
+  while (action_end > 0) {
+    uint action_idx;
+    log.setUIntBefore(action_end);
+    offset_idxs.push_back(log.idx());
+    log.pop(action_idx);
+    action_idxs.push_back(action_idx);
+    action_end = action_idx;
+  }
+
+  // Copy the actions with their offsets in this log
+  for (int i = action_idxs.size() - 1; i >= 0; --i) {
+    const uint action_idx = _log.size();
+    _log.append(log, action_idxs[i], offset_idxs[i]);
+    _log.push(action_idx);
   }
 }
 
@@ -1428,8 +1459,38 @@ void dbJournal::undo_createObject()
   _log.pop(obj_type);
 
   switch ((dbObjectType) obj_type) {
-    case dbNetObj:
-    case dbInstObj:
+    case dbNetObj: {
+      std::string name;
+      _log.pop(name);
+      debugPrint(
+          _logger, utl::ODB, "DB_ECO", 2, "UNDO ECO: create dbNet {}", name);
+      dbNet* net = _block->findNet(name.c_str());
+      if (net) {
+        dbNet::destroy(net);
+      }
+      break;
+    }
+
+    case dbInstObj: {
+      uint lib_id;
+      uint master_id;
+      std::string name;
+      _log.pop(lib_id);
+      _log.pop(master_id);
+      _log.pop(name);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: create dbInstObj {}",
+                 name);
+      dbInst* inst = _block->findInst(name.c_str());
+      if (inst) {
+        dbInst::destroy(inst);
+      }
+      break;
+    }
+
     case dbRSegObj:
     case dbCapNodeObj:
     case dbCCSegObj:
@@ -1461,7 +1522,20 @@ void dbJournal::undo_connectObject()
   _log.pop(obj_type);
 
   switch ((dbObjectType) obj_type) {
-    case dbITermObj:
+    case dbITermObj: {
+      uint iterm_id;
+      _log.pop(iterm_id);
+      dbITerm* iterm = dbITerm::getITerm(_block, iterm_id);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: connect dbITermObj, iterm_id {}",
+                 iterm_id);
+      iterm->disconnect();
+      break;
+    }
+
     default:
       break;
   }
@@ -1473,7 +1547,24 @@ void dbJournal::undo_disconnectObject()
   _log.pop(obj_type);
 
   switch ((dbObjectType) obj_type) {
-    case dbITermObj:
+    case dbITermObj: {
+      uint iterm_id;
+      _log.pop(iterm_id);
+      dbITerm* iterm = dbITerm::getITerm(_block, iterm_id);
+      uint net_id;
+      _log.pop(net_id);
+      dbNet* net = dbNet::getNet(_block, net_id);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: disconnect dbITermObj, iterm_id {}, net_id {}",
+                 iterm_id,
+                 net_id);
+      iterm->connect(net);
+      break;
+    }
+
     default:
       break;
   }
@@ -1485,7 +1576,30 @@ void dbJournal::undo_swapObject()
   _log.pop(obj_type);
 
   switch ((dbObjectType) obj_type) {
-    case dbInstObj:
+    case dbInstObj: {
+      uint inst_id;
+      _log.pop(inst_id);
+      dbInst* inst = dbInst::getInst(_block, inst_id);
+
+      uint prev_lib_id;
+      _log.pop(prev_lib_id);
+      dbLib* prev_lib = dbLib::getLib(_block->getDb(), prev_lib_id);
+
+      uint prev_master_id;
+      _log.pop(prev_master_id);
+      dbMaster* prev_master = dbMaster::getMaster(prev_lib, prev_master_id);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: swapMaster inst {}, restore lib/master: {}/{}",
+                 inst_id,
+                 prev_lib_id,
+                 prev_master_id);
+      inst->swapMaster(prev_master);
+      break;
+    }
+
     default:
       break;
   }
@@ -1544,19 +1658,60 @@ void dbJournal::undo_updateInstField()
 {
   uint inst_id;
   _log.pop(inst_id);
-  //_dbInst * inst = (_dbInst *) dbInst::getInst(_block, inst_id );
+  _dbInst* inst = (_dbInst*) dbInst::getInst(_block, inst_id);
 
   int field;
   _log.pop(field);
 
-#if 0  // dead code generates warnings -cherry
-    switch( (_dbInst::Field) field )
-    {
-        case _dbInst::FLAGS:
-        case _dbInst::ORIGIN:
-            break;
+  switch ((_dbInst::Field) field) {
+    case _dbInst::FLAGS: {
+      uint prev_flags;
+      _log.pop(prev_flags);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: dbInst {}, restore flags {}",
+                 inst_id,
+                 prev_flags);
+      _dbInstFlags prev;
+      *((uint*) &prev) = prev_flags;
+      _dbBlock* block = (_dbBlock*) _block;
+      const bool reoriented = prev._orient != inst->_flags._orient;
+      if (reoriented) {
+        for (auto callback : block->_callbacks)
+          callback->inDbPreMoveInst((dbInst*) inst);
+      }
+      *((uint*) &inst->_flags) = prev_flags;
+      block->_flags._valid_bbox = 0;
+      if (reoriented) {
+        _dbInst::setInstBBox(inst);
+        for (auto callback : block->_callbacks)
+          callback->inDbPostMoveInst((dbInst*) inst);
+      }
+      break;
     }
-#endif
+
+    case _dbInst::ORIGIN: {
+      int prev_x;
+      _log.pop(prev_x);
+      int prev_y;
+      _log.pop(prev_y);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: dbInst {}, restore origin {},{}",
+                 inst_id,
+                 prev_x,
+                 prev_y);
+      ((dbInst*) inst)->setOrigin(prev_x, prev_y);
+      break;
+    }
+
+    default:
+      break;
+  }
 }
 
 void dbJournal::undo_updateITermField()
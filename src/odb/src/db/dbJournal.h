@@ -175,6 +175,9 @@ class dbJournal
   // undo the transaction log
   void undo();
 
+  // append the actions of journal to the transaction log
+  void append(dbJournal& journal);
+
   bool empty() { return _log.empty(); }
 
   friend dbIStream& operator>>(dbIStream& stream, dbJournal& jrnl);
@@ -72,6 +72,19 @@ dbJournalLog::~dbJournalLog()
   clear();
 }
 
+void dbJournalLog::setUIntBefore(uint idx)
+{
+  // the type of the entry precedes its value in the debug log
+  _idx = idx - sizeof(unsigned int) - (_debug ? 1 : 0);
+}
+
+void dbJournalLog::append(dbJournalLog& log, uint begin, uint end)
+{
+  for (uint idx = begin; idx < end; ++idx) {
+    _data.push_back(log._data[idx]);
+  }
+}
+
 void dbJournalLog::push(bool value)
 {
   SET_TYPE(LOG_BOOL);
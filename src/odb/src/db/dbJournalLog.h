@@ -74,6 +74,10 @@ class dbJournalLog
   void begin() { _idx = 0; }
   bool end() { return _idx == (int) _data.size(); }
   void set(uint idx) { _idx = idx; }
+  // Move to the unsigned int entry ending at idx
+  void setUIntBefore(uint idx);
+  // Copy the entries of log in [begin, end)
+  void append(dbJournalLog& log, uint begin, uint end);
 
   void pop(bool& value);
   void pop(char& value);
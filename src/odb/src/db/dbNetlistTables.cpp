@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "dbNetlistTables.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#include "db.h"
+#include "dbBlock.h"
+#include "dbITerm.h"
+#include "dbInst.h"
+#include "dbNet.h"
+#include "dbSet.h"
+#include "dbTable.h"
+
+namespace odb {
+
+// Calls fn(object, row) for every member of set, spread over num_threads
+// threads. splitSet returns ranges of chunk_size members except for the
+// last one, so each range starts at row chunk * chunk_size.
+template <class T, class Fn>
+static void forEachRow(dbSet<T> set, int num_threads, Fn fn)
+{
+  const uint size = set.size();
+  const uint num_chunks = 4 * num_threads;
+  const uint chunk_size = (size + num_chunks - 1) / num_chunks;
+  const std::vector<dbSetRange<T>> ranges = splitSet(set, num_chunks);
+
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+  for (int chunk = 0; chunk < (int) ranges.size(); ++chunk) {
+    int row = chunk * chunk_size;
+    for (T* object : ranges[chunk]) {
+      fn(object, row++);
+    }
+  }
+}
+
+void dbNetlistTables::extract(dbBlock* block_,
+                              dbNetlistTables& tables,
+                              int num_threads)
+{
+  num_threads = std::max(num_threads, 1);
+  _dbBlock* block = (_dbBlock*) block_;
+  dbSet<dbInst> insts = block_->getInsts();
+  dbSet<dbNet> nets = block_->getNets();
+  dbSet<dbITerm> iterms = block_->getITerms();
+
+  const uint num_insts = insts.size();
+  tables.inst_name.assign(num_insts, std::string());
+  tables.inst_master.assign(num_insts, std::string());
+  tables.inst_x.assign(num_insts, 0);
+  tables.inst_y.assign(num_insts, 0);
+  tables.inst_orient.assign(num_insts, 0);
+  tables.inst_status.assign(num_insts, 0);
+
+  const uint num_nets = nets.size();
+  tables.net_name.assign(num_nets, std::string());
+  tables.net_sig_type.assign(num_nets, 0);
+
+  const uint num_pins = iterms.size();
+  tables.pin_inst.assign(num_pins, -1);
+  tables.pin_net.assign(num_pins, -1);
+  tables.pin_name.assign(num_pins, std::string());
+
+  // Rows by object id, to resolve the pin table's references.
+  std::vector<int> inst_row(block->_inst_tbl->_top_idx + 1, -1);
+  std::vector<int> net_row(block->_net_tbl->_top_idx + 1, -1);
+
+  forEachRow(insts, num_threads, [&](dbInst* inst, int row) {
+    _dbInst* inst_impl = (_dbInst*) inst;
+    inst_row[inst->getId()] = row;
+    tables.inst_name[row] = inst_impl->_name;
+    tables.inst_master[row] = inst->getMaster()->getName();
+    tables.inst_x[row] = inst_impl->_x;
+    tables.inst_y[row] = inst_impl->_y;
+    tables.inst_orient[row] = inst_impl->_flags._orient;
+    tables.inst_status[row] = inst_impl->_flags._status;
+  });
+
+  forEachRow(nets, num_threads, [&](dbNet* net, int row) {
+    net_row[net->getId()] = row;
+    tables.net_name[row] = ((_dbNet*) net)->_name;
+    tables.net_sig_type[row] = net->getSigType().getValue();
+  });
+
+  forEachRow(iterms, num_threads, [&](dbITerm* iterm, int row) {
+    tables.pin_inst[row] = inst_row[iterm->getInst()->getId()];
+    dbNet* net = iterm->getNet();
+    if (net) {
+      tables.pin_net[row] = net_row[net->getId()];
+    }
+    tables.pin_name[row] = iterm->getMTerm()->getName();
+  });
+}
+
+bool dbNetlistTables::writeCsv(const char* dir) const
+{
+  const std::string prefix = std::string(dir) + "/";
+
+  FILE* insts = fopen((prefix + "insts.csv").c_str(), "w");
+  if (!insts) {
+    return false;
+  }
+  fprintf(insts, "name,master,x,y,orient,status\n");
+  for (size_t i = 0; i < inst_name.size(); ++i) {
+    fprintf(insts,
+            "%s,%s,%d,%d,%s,%s\n",
+            inst_name[i].c_str(),
+            inst_master[i].c_str(),
+            inst_x[i],
+            inst_y[i],
+            dbOrientType((dbOrientType::Value) inst_orient[i]).getString(),
+            dbPlacementStatus((dbPlacementStatus::Value) inst_status[i])
+                .getString());
+  }
+  fclose(insts);
+
+  FILE* nets = fopen((prefix + "nets.csv").c_str(), "w");
+  if (!nets) {
+    return false;
+  }
+  fprintf(nets, "name,sig_type\n");
+  for (size_t i = 0; i < net_name.size(); ++i) {
+    fprintf(nets,
+            "%s,%s\n",
+            net_name[i].c_str(),
+            dbSigType((dbSigType::Value) net_sig_type[i]).getString());
+  }
+  fclose(nets);
+
+  FILE* pins = fopen((prefix + "pins.csv").c_str(), "w");
+  if (!pins) {
+    return false;
+  }
+  fprintf(pins, "inst,net,name\n");
+  for (size_t i = 0; i < pin_name.size(); ++i) {
+    fprintf(pins, "%d,%d,%s\n", pin_inst[i], pin_net[i], pin_name[i].c_str());
+  }
+  fclose(pins);
+
+  return true;
+}
+
+}  // namespace odb
@@ -32,6 +32,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 #include "ZException.h"
 #include "dbDiff.h"
 #include "dbStream.h"
@@ -359,6 +363,16 @@ inline dbOStream& operator<<(dbOStream& stream, const dbPagedVector<T, P, S>& v)
   uint sz = v.size();
   stream << sz;
 
+  // Plain numeric pages are written as whole blocks; the bytes are the
+  // same as the per element path so the format is unchanged.
+  if constexpr (std::is_arithmetic_v<T>) {
+    for (uint i = 0; i < sz; i += P) {
+      const uint cnt = std::min(P, sz - i);
+      stream.writeRaw(&v[i], cnt * sizeof(T));
+    }
+    return stream;
+  }
+
   uint i;
   for (i = 0; i < sz; ++i) {
     const T& t = v[i];
@@ -375,6 +389,19 @@ inline dbIStream& operator>>(dbIStream& stream, dbPagedVector<T, P, S>& v)
 
   uint sz;
   stream >> sz;
+
+  if constexpr (std::is_arithmetic_v<T>) {
+    std::vector<T> chunk(std::min(P, sz));
+    for (uint i = 0; i < sz; i += P) {
+      const uint cnt = std::min(P, sz - i);
+      stream.readRaw(chunk.data(), cnt * sizeof(T));
+      for (uint j = 0; j < cnt; ++j) {
+        v.push_back(chunk[j]);
+      }
+    }
+    return stream;
+  }
+
   T t;
   uint i;
 
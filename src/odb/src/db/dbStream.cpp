@@ -87,6 +87,7 @@ dbIStream& operator>>(dbIStream& stream, Oct& o)
 }
 
 dbOStream::dbOStream(_dbDatabase* db, FILE* f)
+    : _buf(kBufferSize), _buf_pos(0)
 {
   _db = db;
   _f = f;
@@ -101,7 +102,27 @@ dbOStream::dbOStream(_dbDatabase* db, FILE* f)
   }
 }
 
-dbIStream::dbIStream(_dbDatabase* db, std::ifstream& f) : _f(f)
+dbOStream::~dbOStream()
+{
+  // Errors can't be reported from here; callers that care use flush().
+  if (_buf_pos > 0) {
+    fwrite(_buf.data(), _buf_pos, 1, _f);
+  }
+}
+
+dbIStream::dbIStream(_dbDatabase* db, std::ifstream& f)
+    : _f(&f), _data(nullptr), _size(0), _pos(0)
+{
+  init(db);
+}
+
+dbIStream::dbIStream(_dbDatabase* db, const char* data, size_t size)
+    : _f(nullptr), _data(data), _size(size), _pos(0)
+{
+  init(db);
+}
+
+void dbIStream::init(_dbDatabase* db)
 {
   _db = db;
 
@@ -40,9 +40,17 @@
 #include "dbDiff.h"
 #include "dbStream.h"
 #include "dbTable.h"
+#include "utl/MemoryUsage.h"
 
 namespace odb {
 
+// Memory held by the pages of all the tables.
+inline utl::MemoryCounter& dbTablePageMemory()
+{
+  static utl::MemoryCounter counter("odb__tables");
+  return counter;
+}
+
 template <class T>
 inline void dbTable<T>::pushQ(uint& Q, _dbFreeObject* e)
 {
@@ -115,6 +123,9 @@ void dbTable<T>::clear()
 
     free((void*) page);
   }
+  dbTablePageMemory().sub(
+      static_cast<int64_t>(_page_cnt)
+      * (page_size() * sizeof(T) + sizeof(dbObjectPage)));
 
   delete[] _pages;
 
@@ -197,6 +208,7 @@ void dbTable<T>::newPage()
   dbTablePage* page = (dbTablePage*) malloc(size);
   ZALLOCATED(page);
   memset(page, 0, size);
+  dbTablePageMemory().add(size);
 
   uint page_id = _page_cnt;
 
@@ -602,6 +614,7 @@ void dbTable<T>::copy_page(uint page_id, dbTablePage* page)
   dbTablePage* p = (dbTablePage*) malloc(size);
   ZALLOCATED(p);
   memset(p, 0, size);
+  dbTablePageMemory().add(size);
   p->_table = this;
   p->_page_addr = page_id << _page_shift;
   p->_alloccnt = page->_alloccnt;
@@ -669,6 +682,7 @@ dbIStream& operator>>(dbIStream& stream, dbTable<T>& table)
     dbTablePage* page = (dbTablePage*) malloc(size);
     ZALLOCATED(page);
     memset(page, 0, size);
+    dbTablePageMemory().add(size);
     page->_page_addr = i << table._page_shift;
     page->_table = &table;
     table._pages[i] = page;
@@ -616,6 +616,12 @@ void dbWireEncoder::end()
   ((_dbBlock*) _block)->_flags._valid_bbox = 0;
   _point_cnt = 0;
 
+  // Re-encoding the routing of a net invalidates its parasitics; flag it
+  // so incremental extraction can pick it up.
+  _dbNet* net = (_dbNet*) ((dbWire*) _wire)->getNet();
+  if (net && !_wire->_flags._is_global)
+    net->_flags._wire_altered = 1;
+
   for (auto callback : ((_dbBlock*) _block)->_callbacks) {
     callback->inDbWirePostModify((dbWire*) _wire);
   }
@@ -452,6 +452,18 @@ int definReader::blockageCallback(defrCallbackType_e /* unused: type */,
   return PARSE_OK;
 }
 
+int definReader::componentsStartCallback(defrCallbackType_e /* unused: type */,
+                                         int number,
+                                         defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  CHECKBLOCK
+  // Size the name table up front rather than rehashing as instances
+  // are created one at a time.
+  reader->_block->reserveInsts(reader->_block->getInsts().size() + number);
+  return PARSE_OK;
+}
+
 int definReader::componentsCallback(defrCallbackType_e /* unused: type */,
                                     defiComponent* comp,
                                     defiUserData data)
@@ -692,6 +704,16 @@ int definReader::historyCallback(defrCallbackType_e /* unused: type */,
   return PARSE_OK;
 }
 
+int definReader::netsStartCallback(defrCallbackType_e /* unused: type */,
+                                   int number,
+                                   defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  CHECKBLOCK
+  reader->_block->reserveNets(reader->_block->getNets().size() + number);
+  return PARSE_OK;
+}
+
 int definReader::netCallback(defrCallbackType_e /* unused: type */,
                              defiNet* net,
                              defiUserData data)
@@ -1820,6 +1842,8 @@ bool definReader::createBlock(const char* file)
   }
 
   if (_mode == defin::DEFAULT) {
+    defrSetComponentStartCbk(componentsStartCallback);
+    defrSetNetStartCbk(netsStartCallback);
     defrSetPropCbk(propCallback);
     defrSetPropDefEndCbk(propEndCallback);
     defrSetPropDefStartCbk(propStartCallback);
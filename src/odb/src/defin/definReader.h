@@ -112,6 +112,10 @@ class definReader : public definBase
                                 defiComponent* comp,
                                 defiUserData data);
 
+  static int componentsStartCallback(defrCallbackType_e type,
+                                     int number,
+                                     defiUserData data);
+
   static int componentMaskShiftCallback(
       defrCallbackType_e type,
       defiComponentMaskShiftLayer* shiftLayers,
@@ -156,6 +160,10 @@ class definReader : public definBase
                          defiNet* net,
                          defiUserData data);
 
+  static int netsStartCallback(defrCallbackType_e type,
+                               int number,
+                               defiUserData data);
+
   static int nonDefaultRuleCallback(defrCallbackType_e type,
                                     defiNonDefault* rule,
                                     defiUserData data);
@@ -35,11 +35,13 @@
 #include <stdio.h>
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <optional>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "odb/db.h"
 #include "odb/dbMap.h"
@@ -99,6 +101,22 @@ static const char* defIoType(dbIoType type)
   return type.getString();
 }
 
+defout_impl::defout_impl(const defout_impl& parent, FILE* out)
+{
+  _dist_factor = parent._dist_factor;
+  _out = out;
+  _use_net_inst_ids = parent._use_net_inst_ids;
+  _use_master_ids = parent._use_master_ids;
+  _use_alias = parent._use_alias;
+  _select_net_map = parent._select_net_map;
+  _select_inst_map = parent._select_inst_map;
+  _non_default_rule = parent._non_default_rule;
+  _version = parent._version;
+  _prop_defs_src = parent._prop_defs_src;
+  _logger = parent._logger;
+  _num_threads = 1;
+}
+
 void defout_impl::selectNet(dbNet* net)
 {
   if (!net)
@@ -1309,17 +1327,60 @@ void defout_impl::writeNets(dbBlock* block)
 
   fprintf(_out, "NETS %d ;\n", net_cnt);
 
+  std::vector<dbNet*> out_nets;
+  out_nets.reserve(net_cnt);
   for (dbNet* net : sorted_nets) {
     if (_select_net_map && !(*_select_net_map)[net])
       continue;
 
     if (regular_net[net] == 1)
-      writeNet(net);
+      out_nets.push_back(net);
   }
 
+  writeNetChunks(out_nets);
+
   fprintf(_out, "END NETS\n");
 }
 
+// Nets are formatted concurrently into per-chunk memory streams by chunk
+// writers and then emitted in order, so the output is identical to
+// formatting them one by one. Chunks are processed in bounded batches to
+// cap the memory held for a full chip.
+void defout_impl::writeNetChunks(const std::vector<dbNet*>& nets)
+{
+  const int chunk_size = 1024;
+  const int batch_chunks = 256;
+  const int num_chunks = (nets.size() + chunk_size - 1) / chunk_size;
+
+  if (num_chunks <= 1) {
+    for (dbNet* net : nets)
+      writeNet(net);
+    return;
+  }
+
+  std::vector<std::string> chunks(batch_chunks);
+  for (int first = 0; first < num_chunks; first += batch_chunks) {
+    const int last = std::min(first + batch_chunks, num_chunks);
+#pragma omp parallel for num_threads(_num_threads) schedule(dynamic)
+    for (int c = first; c < last; ++c) {
+      char* buf = nullptr;
+      size_t len = 0;
+      defout_impl writer(*this, open_memstream(&buf, &len));
+      const size_t end = std::min(nets.size(), (size_t) (c + 1) * chunk_size);
+      for (size_t i = (size_t) c * chunk_size; i < end; ++i)
+        writer.writeNet(nets[i]);
+      fclose(writer._out);
+      chunks[c - first].assign(buf, len);
+      free(buf);
+    }
+    for (int c = first; c < last; ++c) {
+      std::string& chunk = chunks[c - first];
+      fwrite(chunk.data(), 1, chunk.size(), _out);
+      chunk.clear();
+    }
+  }
+}
+
 void defout_impl::writeSNet(dbNet* net)
 {
   dbSet<dbITerm> iterms = net->getITerms();
@@ -2099,7 +2160,8 @@ bool defout_impl::hasProperties(dbObject* object, ObjType type)
     dbProperty* prop = *itr;
     std::string name = prop->getName();
 
-    if (_prop_defs[type].find(name.c_str()) != _prop_defs[type].end())
+    if (_prop_defs_src[type].find(name.c_str())
+        != _prop_defs_src[type].end())
       return true;
   }
 
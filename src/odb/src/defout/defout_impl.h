@@ -35,6 +35,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "odb/db.h"
 #include "odb/dbMap.h"
@@ -79,7 +80,11 @@ class defout_impl
   dbTechNonDefaultRule* _non_default_rule;
   int _version;
   std::map<std::string, bool> _prop_defs[9];
+  // the property definitions checked by hasProperties; those of the
+  // parent writer for a chunk writer
+  const std::map<std::string, bool>* _prop_defs_src;
   utl::Logger* _logger;
+  int _num_threads;
 
   int defdist(int value) { return (int) (((double) value) * _dist_factor); }
 
@@ -106,6 +111,7 @@ class defout_impl
   void writeFills(dbBlock* block);
   void writeNets(dbBlock* block);
   void writeNet(dbNet* net);
+  void writeNetChunks(const std::vector<dbNet*>& nets);
   void writeSNet(dbNet* net);
   void writeWire(dbWire* wire);
   void writeSWire(dbSWire* wire);
@@ -115,6 +121,10 @@ class defout_impl
   void writePinProperties(dbBlock* block);
   bool hasProperties(dbObject* object, ObjType type);
 
+  // A writer of a chunk of nets to out, with the settings and the
+  // property definitions of parent. The selection lists are not copied.
+  defout_impl(const defout_impl& parent, FILE* out);
+
  public:
   defout_impl(utl::Logger* logger)
   {
@@ -124,7 +134,9 @@ class defout_impl
     _select_net_map = nullptr;
     _select_inst_map = nullptr;
     _version = defout::DEF_5_8;
+    _prop_defs_src = _prop_defs;
     _logger = logger;
+    _num_threads = 1;
   }
 
   ~defout_impl() {}
@@ -139,6 +151,7 @@ class defout_impl
 
   void selectInst(dbInst* inst);
   void setVersion(int v) { _version = v; }
+  void setNumThreads(int threads) { _num_threads = threads; }
 
   bool writeBlock(dbBlock* block, const char* def_file);
 };
@@ -37,6 +37,7 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <list>
 #include <string>
 #include <vector>
@@ -2255,6 +2256,92 @@ dbLib* lefin::createLib(dbTech* tech, const char* name, const char* lef_file)
   return _lib;
 }
 
+// FNV-1a, folded over the LEF contents and the technology's layer and
+// via names, which library geometry refers to by id.
+static void hashBytes(uint64_t& hash, const char* data, size_t size)
+{
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= (unsigned char) data[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+static void hashString(uint64_t& hash, const std::string& str)
+{
+  hashBytes(hash, str.c_str(), str.size() + 1);
+}
+
+std::string lefin::libCachePath(dbTech* tech,
+                                const char* name,
+                                const char* lef_file,
+                                const char* cache_dir)
+{
+  FILE* file = fopen(lef_file, "rb");
+  if (file == nullptr) {
+    return std::string();
+  }
+
+  uint64_t hash = 14695981039346656037ULL;
+  std::vector<char> buffer(1 << 20);
+  size_t count;
+  while ((count = fread(buffer.data(), 1, buffer.size(), file)) > 0) {
+    hashBytes(hash, buffer.data(), count);
+  }
+  fclose(file);
+
+  hashString(hash, name);
+  hashString(hash, tech->getName());
+  hashString(hash, std::to_string(tech->getDbUnitsPerMicron()));
+  for (dbTechLayer* layer : tech->getLayers()) {
+    hashString(hash, layer->getName());
+  }
+  for (dbTechVia* via : tech->getVias()) {
+    hashString(hash, via->getName());
+  }
+
+  return fmt::format("{}/{}-{:016x}.odblib", cache_dir, name, hash);
+}
+
+dbLib* lefin::createLibCached(dbTech* tech,
+                              const char* name,
+                              const char* lef_file,
+                              const char* cache_dir)
+{
+  if (tech == nullptr) {
+    return createLib(tech, name, lef_file);
+  }
+
+  const std::string path = libCachePath(tech, name, lef_file, cache_dir);
+  if (!path.empty() && !_db->findLib(name)) {
+    dbLib* lib = _db->readLibCache(path.c_str(), tech);
+    if (lib) {
+      _logger->info(utl::ODB,
+                    437,
+                    "Loaded library {} for {} from cache {}",
+                    name,
+                    lef_file,
+                    path);
+      return lib;
+    }
+  }
+
+  dbLib* lib = createLib(tech, name, lef_file);
+  if (lib && !path.empty()) {
+    // Write to a temporary name so a concurrent reader never sees a
+    // partial file.
+    const std::string tmp_path = path + "." + std::to_string(getpid());
+    if (_db->writeLibCache(tmp_path.c_str(), lib)
+        && rename(tmp_path.c_str(), path.c_str()) == 0) {
+      debugPrint(
+          _logger, utl::ODB, "lef_cache", 1, "Saved library cache {}", path);
+    } else {
+      remove(tmp_path.c_str());
+      _logger->warn(utl::ODB, 438, "Unable to write library cache {}", path);
+    }
+  }
+  return lib;
+}
+
 dbLib* lefin::createTechAndLib(const char* tech_name,
                                const char* lib_name,
                                const char* lef_file)
@@ -39,6 +39,7 @@
 #include "dbBlockSet.h"
 #include "dbNetSet.h"
 #include "dbMap.h"
+#include "dbNetlistTables.h"
 #include "dbCCSegSet.h"
 #include "dbSet.h"
 #include "dbTypes.h"
@@ -97,3 +98,7 @@ using namespace odb;
 %include "odb/dbNetSet.h"
 %include "odb/dbCCSegSet.h"
 %include "odb/wOrder.h"
+
+%template(IntVector) std::vector<int>;
+%template(StringVector) std::vector<std::string>;
+%include "odb/dbNetlistTables.h"
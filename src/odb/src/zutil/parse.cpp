@@ -32,9 +32,11 @@
 
 #include "parse.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
 
 #include "odb/odb.h"
 
@@ -52,6 +54,10 @@ static FILE* ATH__openFile(const char* name,
   return a;
 }
 
+// Large stdio buffer for input files; parsed files such as SPEF can be
+// several gigabytes and are read line by line.
+static constexpr size_t ATH__inputBufferSize = 1 << 22;
+
 static void ATH__closeFile(FILE* fp)
 {
   if (fp != nullptr) {
@@ -121,6 +127,7 @@ void Ath__parser::init()
   _wordSeparators = ATH__allocCharWord(24, _logger);
 
   strcpy(_wordSeparators, " \n\t");
+  updateSeparatorTable();
 
   _commentChar = '#';
 
@@ -153,11 +160,21 @@ bool Ath__parser::isDigit(int ii, int jj)
 void Ath__parser::resetSeparator(const char* s)
 {
   strcpy(_wordSeparators, s);
+  updateSeparatorTable();
 }
 
 void Ath__parser::addSeparator(const char* s)
 {
   strcat(_wordSeparators, s);
+  updateSeparatorTable();
+}
+
+void Ath__parser::updateSeparatorTable()
+{
+  std::fill(std::begin(_separatorTable), std::end(_separatorTable), false);
+  for (const char* c = _wordSeparators; *c != '\0'; c++) {
+    _separatorTable[(unsigned char) *c] = true;
+  }
 }
 
 void Ath__parser::openFile(char* name)
@@ -189,6 +206,9 @@ void Ath__parser::openFile(char* name)
   } else {  //
     _inFP = ATH__openFile(_inputFile, "r", _logger);
   }
+  if (_inFP != nullptr) {
+    setvbuf(_inFP, nullptr, _IOFBF, ATH__inputBufferSize);
+  }
 }
 
 void Ath__parser::setInputFP(FILE* fp)
@@ -295,11 +315,16 @@ int Ath__parser::mkWords(const char* word, const char* sep)
     strcpy(_wordSeparators, sep);
   }
 
+  if (sep != nullptr) {
+    updateSeparatorTable();
+  }
+
   strcpy(_line, word);
   _currentWordCnt = mkWords(0);
 
   if (sep != nullptr) {
     strcpy(_wordSeparators, buf1);
+    updateSeparatorTable();
   }
 
   return _currentWordCnt;
@@ -330,13 +355,7 @@ int Ath__parser::mkDirTree(const char* word, const char* sep)
 
 bool Ath__parser::isSeparator(char a)
 {
-  int len = strlen(_wordSeparators);
-  for (int k = 0; k < len; k++) {
-    if (a == _wordSeparators[k]) {
-      return true;
-    }
-  }
-  return false;
+  return _separatorTable[(unsigned char) a];
 }
 
 int Ath__parser::mkWords(int jj)
@@ -0,0 +1,59 @@
+#define BOOST_TEST_MODULE TestBlockIndex
+#include <boost/test/included/unit_test.hpp>
+
+#include "db.h"
+#include "dbBlockIndex.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(test_insts)
+{
+  dbDatabase* db = createSimpleDB();
+  dbBlock* block = db->getChip()->getBlock();
+  dbMaster* and2 = db->findMaster("and2");
+  dbInst* i1 = dbInst::create(block, and2, "i1");
+  i1->setLocation(0, 0);
+
+  dbBlockIndex* index = block->getSpatialIndex();
+  BOOST_TEST(block->getSpatialIndex() == index);
+  BOOST_TEST(index->findInsts(Rect(100, 100, 200, 200)).size() == 1);
+
+  // Follows moves
+  i1->setLocation(5000, 5000);
+  BOOST_TEST(index->findInsts(Rect(100, 100, 200, 200)).empty());
+  auto found = index->findInsts(Rect(5100, 5100, 5200, 5200));
+  BOOST_TEST(found.size() == 1);
+  BOOST_TEST(found[0] == i1);
+
+  // Follows creation and destruction
+  dbInst* i2 = dbInst::create(block, and2, "i2");
+  i2->setLocation(5500, 5000);
+  BOOST_TEST(index->findInsts(Rect(5000, 5000, 7000, 7000)).size() == 2);
+  dbInst::destroy(i2);
+  BOOST_TEST(index->findInsts(Rect(5000, 5000, 7000, 7000)).size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_sboxes)
+{
+  dbDatabase* db = createSimpleDB();
+  dbBlock* block = db->getChip()->getBlock();
+  dbTechLayer* layer = db->getTech()->findLayer("L1");
+  dbNet* net = dbNet::create(block, "vdd");
+  dbSWire* swire = dbSWire::create(net, dbWireType::ROUTED);
+  dbSBox::create(swire, layer, 0, 0, 1000, 100, dbWireShapeType::STRIPE);
+
+  dbBlockIndex* index = block->getSpatialIndex();
+  BOOST_TEST(index->findSBoxes(layer, Rect(500, 50, 600, 60)).size() == 1);
+
+  dbSBox::create(swire, layer, 0, 500, 1000, 600, dbWireShapeType::STRIPE);
+  BOOST_TEST(index->findSBoxes(layer, Rect(0, 0, 1000, 1000)).size() == 2);
+
+  dbSWire::destroy(swire);
+  BOOST_TEST(index->findSBoxes(layer, Rect(0, 0, 1000, 1000)).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,36 @@
+#define BOOST_TEST_MODULE TestDbSet
+#include <boost/test/included/unit_test.hpp>
+#include <set>
+
+#include "db.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(test_split_set)
+{
+  dbDatabase* db = create2LevetDbNoBTerms();
+  dbBlock* block = db->getChip()->getBlock();
+  dbInst::destroy(block->findInst("i2"));
+
+  auto ranges = splitSet(block->getNets(), 3);
+  BOOST_TEST(ranges.size() == 3);
+  std::set<dbNet*> seen;
+  for (auto& range : ranges) {
+    for (dbNet* net : range) {
+      BOOST_TEST(seen.insert(net).second);
+    }
+  }
+  BOOST_TEST(seen.size() == block->getNets().size());
+
+  // More chunks than objects yields one range per object
+  auto inst_ranges = splitSet(block->getInsts(), 10);
+  BOOST_TEST(inst_ranges.size() == 2);
+
+  BOOST_TEST(splitSet(block->getBTerms(), 4).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
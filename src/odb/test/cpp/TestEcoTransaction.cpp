@@ -0,0 +1,104 @@
+#define BOOST_TEST_MODULE TestEcoTransaction
+#include <boost/test/included/unit_test.hpp>
+#include <filesystem>
+
+#include "db.h"
+#include "dbEcoTransaction.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(test_rollback)
+{
+  dbDatabase* db = create2LevetDbNoBTerms();
+  dbBlock* block = db->getChip()->getBlock();
+  dbInst* i1 = block->findInst("i1");
+  dbMaster* and2 = db->findMaster("and2");
+  dbMaster* or2 = db->findMaster("or2");
+  dbNet* n1 = block->findNet("n1");
+  dbNet* n7 = block->findNet("n7");
+  i1->setLocation(100, 200);
+  i1->setPlacementStatus(dbPlacementStatus::PLACED);
+
+  {
+    dbEcoTransaction trial(block);
+    i1->setLocation(3000, 4000);
+    i1->setOrient(dbOrientType::MX);
+    i1->swapMaster(or2);
+    i1->findITerm("a")->disconnect();
+    i1->findITerm("a")->connect(n7);
+    dbInst* buf = dbInst::create(block, and2, "buf");
+    buf->findITerm("o")->connect(n1);
+    i1->setPlacementStatus(dbPlacementStatus::FIRM);
+  }
+
+  int x, y;
+  i1->getLocation(x, y);
+  BOOST_TEST(x == 100);
+  BOOST_TEST(y == 200);
+  BOOST_TEST(i1->getOrient() == dbOrientType::R0);
+  BOOST_TEST(i1->getPlacementStatus() == dbPlacementStatus::PLACED);
+  BOOST_TEST(i1->getMaster() == and2);
+  BOOST_TEST(i1->findITerm("a")->getNet() == n1);
+  BOOST_TEST(block->findInst("buf") == nullptr);
+  BOOST_TEST(n1->getITerms().size() == 1);
+  BOOST_TEST(n7->getITerms().size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_commit)
+{
+  dbDatabase* db = create2LevetDbNoBTerms();
+  dbBlock* block = db->getChip()->getBlock();
+  dbInst* i1 = block->findInst("i1");
+  dbMaster* or2 = db->findMaster("or2");
+
+  {
+    dbEcoTransaction trial(block);
+    i1->swapMaster(or2);
+    trial.commit();
+  }
+  BOOST_TEST(i1->getMaster() == or2);
+}
+
+BOOST_AUTO_TEST_CASE(test_sequential_commits)
+{
+  dbDatabase* db = create2LevetDbNoBTerms();
+  dbBlock* block = db->getChip()->getBlock();
+  dbMaster* and2 = db->findMaster("and2");
+  dbMaster* or2 = db->findMaster("or2");
+
+  {
+    dbEcoTransaction trial(block);
+    block->findInst("i1")->swapMaster(or2);
+    trial.commit();
+  }
+  {
+    dbEcoTransaction trial(block);
+    dbInst::create(block, and2, "buf");
+    trial.commit();
+  }
+  {
+    dbEcoTransaction trial(block);
+    block->findInst("i2")->swapMaster(or2);
+  }
+
+  const std::string eco_file
+      = (std::filesystem::temp_directory_path() / "sequential_commits.eco")
+            .string();
+  dbDatabase::writeEco(block, eco_file.c_str());
+
+  dbDatabase* db2 = create2LevetDbNoBTerms();
+  dbBlock* block2 = db2->getChip()->getBlock();
+  dbDatabase::readEco(block2, eco_file.c_str());
+  dbDatabase::commitEco(block2);
+  std::filesystem::remove(eco_file);
+
+  BOOST_TEST(block2->findInst("i1")->getMaster()->getName() == "or2");
+  BOOST_TEST(block2->findInst("i2")->getMaster()->getName() == "and2");
+  BOOST_TEST(block2->findInst("buf") != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
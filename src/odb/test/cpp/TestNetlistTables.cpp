@@ -0,0 +1,71 @@
+#define BOOST_TEST_MODULE TestNetlistTables
+#include <boost/test/included/unit_test.hpp>
+
+#include "db.h"
+#include "dbNetlistTables.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(test_extract)
+{
+  dbDatabase* db = create2LevetDbNoBTerms();
+  dbBlock* block = db->getChip()->getBlock();
+  dbInst* i3 = block->findInst("i3");
+  i3->setLocation(1000, 2000);
+  i3->setOrient(dbOrientType::MY);
+
+  dbNetlistTables tables;
+  dbNetlistTables::extract(block, tables);
+
+  BOOST_TEST(tables.inst_name.size() == 3);
+  BOOST_TEST(tables.net_name.size() == 7);
+  BOOST_TEST(tables.pin_name.size() == 9);
+
+  int row = 0;
+  for (dbInst* inst : block->getInsts()) {
+    BOOST_TEST(tables.inst_name[row] == inst->getName());
+    BOOST_TEST(tables.inst_master[row] == inst->getMaster()->getName());
+    ++row;
+  }
+  const int i3_row = 2;
+  BOOST_TEST(tables.inst_name[i3_row] == "i3");
+  BOOST_TEST(tables.inst_x[i3_row] == 1000);
+  BOOST_TEST(tables.inst_y[i3_row] == 2000);
+  BOOST_TEST(tables.inst_orient[i3_row] == dbOrientType::MY);
+
+  // Every pin row points back at its instance and net rows.
+  row = 0;
+  for (dbITerm* iterm : block->getITerms()) {
+    BOOST_TEST(tables.inst_name[tables.pin_inst[row]]
+               == iterm->getInst()->getName());
+    BOOST_TEST(tables.net_name[tables.pin_net[row]]
+               == iterm->getNet()->getName());
+    BOOST_TEST(tables.pin_name[row] == iterm->getMTerm()->getName());
+    ++row;
+  }
+}
+
+// The rows do not depend on the number of threads
+BOOST_AUTO_TEST_CASE(test_extract_threads)
+{
+  dbDatabase* db = create2LevetDbNoBTerms();
+  dbBlock* block = db->getChip()->getBlock();
+
+  dbNetlistTables serial;
+  dbNetlistTables::extract(block, serial);
+  dbNetlistTables parallel;
+  dbNetlistTables::extract(block, parallel, 4);
+
+  BOOST_TEST(parallel.inst_name == serial.inst_name);
+  BOOST_TEST(parallel.inst_x == serial.inst_x);
+  BOOST_TEST(parallel.net_name == serial.net_name);
+  BOOST_TEST(parallel.pin_inst == serial.pin_inst);
+  BOOST_TEST(parallel.pin_net == serial.pin_net);
+  BOOST_TEST(parallel.pin_name == serial.pin_name);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,117 @@
+#define BOOST_TEST_MODULE TestStream
+#include <boost/test/included/unit_test.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "db.h"
+#include "dbStream.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+// Mixes small writes with a block larger than the stream buffer so both
+// the buffered and the pass-through paths are exercised.
+BOOST_AUTO_TEST_CASE(test_buffered_round_trip)
+{
+  dbDatabase* db = dbDatabase::create();
+  const std::string path
+      = (std::filesystem::temp_directory_path() / "TestStreamRW").string();
+
+  std::vector<int> big(1 << 19);
+  for (size_t i = 0; i < big.size(); ++i) {
+    big[i] = i * 7;
+  }
+
+  FILE* write = fopen(path.c_str(), "wb");
+  {
+    dbOStream stream((_dbDatabase*) db, write);
+    stream << 42;
+    stream << std::string("before");
+    stream.writeRaw(big.data(), big.size() * sizeof(int));
+    stream << 2.5;
+    stream << std::string("after");
+    stream.flush();
+  }
+  fclose(write);
+
+  std::ifstream read;
+  read.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                  | std::ios::eofbit);
+  read.open(path.c_str(), std::ios::binary);
+  dbIStream stream((_dbDatabase*) db, read);
+  int i;
+  std::string s;
+  std::vector<int> big_in(big.size());
+  double d;
+  stream >> i;
+  BOOST_TEST(i == 42);
+  stream >> s;
+  BOOST_TEST(s == "before");
+  stream.readRaw(big_in.data(), big_in.size() * sizeof(int));
+  BOOST_TEST(big_in == big);
+  stream >> d;
+  BOOST_TEST(d == 2.5);
+  stream >> s;
+  BOOST_TEST(s == "after");
+
+  std::filesystem::remove(path);
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_CASE(test_memory_image)
+{
+  dbDatabase* db = dbDatabase::create();
+  std::vector<char> image(sizeof(int) + sizeof(double));
+  const int i_out = 7;
+  const double d_out = -1.25;
+  std::memcpy(image.data(), &i_out, sizeof(int));
+  std::memcpy(image.data() + sizeof(int), &d_out, sizeof(double));
+
+  dbIStream stream((_dbDatabase*) db, image.data(), image.size());
+  int i;
+  double d;
+  stream >> i;
+  stream >> d;
+  BOOST_TEST(i == i_out);
+  BOOST_TEST(d == d_out);
+  BOOST_CHECK_THROW(stream >> i, std::runtime_error);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_CASE(test_lib_cache)
+{
+  dbDatabase* db = createSimpleDB();
+  const std::string path
+      = (std::filesystem::temp_directory_path() / "TestStreamLib").string();
+  BOOST_TEST(db->writeLibCache(path.c_str(), db->findLib("lib1")));
+
+  // The name is taken in the database the cache came from.
+  BOOST_TEST(db->readLibCache(path.c_str(), db->getTech()) == nullptr);
+
+  dbDatabase* db2 = dbDatabase::create();
+  dbTech* tech2 = dbTech::create(db2, "tech");
+  dbTechLayer::create(tech2, "L1", dbTechLayerType::MASTERSLICE);
+  dbLib* lib = db2->readLibCache(path.c_str(), tech2);
+  BOOST_TEST(lib != nullptr);
+  BOOST_TEST(lib->getName() == "lib1");
+  BOOST_TEST(lib->getTech() == tech2);
+  BOOST_TEST(db2->getNumberOfMasters() == 2);
+  dbMaster* and2 = lib->findMaster("and2");
+  BOOST_TEST(and2 != nullptr);
+  BOOST_TEST(and2->getWidth() == 1000);
+  BOOST_TEST(and2->findMTerm("o") != nullptr);
+
+  BOOST_TEST(db2->readLibCache("/nonexistent/lib", tech2) == nullptr);
+
+  std::filesystem::remove(path);
+  dbDatabase::destroy(db2);
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -38,6 +38,7 @@
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 #include <boost/graph/astar_search.hpp>
+#include <boost/graph/filtered_graph.hpp>
 #include <boost/graph/lookup_edge.hpp>
 #include <boost/polygon/polygon.hpp>
 #include <limits>
@@ -49,6 +50,7 @@
 #include "odb/dbTransform.h"
 #include "pad/ICeWall.h"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 namespace pad {
 
@@ -57,7 +59,7 @@ class RDLRouterDistanceHeuristic
 {
  public:
   RDLRouterDistanceHeuristic(
-      const std::map<RDLRouter::grid_vertex, odb::Point>& vertex_map,
+      const std::vector<odb::Point>& vertex_map,
       const std::vector<RDLRouter::grid_vertex>& predecessor,
       const RDLRouter::grid_vertex& start_vertex,
       const odb::Point& goal,
@@ -71,7 +73,7 @@ class RDLRouterDistanceHeuristic
   }
   int64_t operator()(RDLRouter::grid_vertex vt_next)
   {
-    const auto& pt_next = vertex_map_.at(vt_next);
+    const auto& pt_next = vertex_map_[vt_next];
 
     const int64_t distance = RDLRouter::distance(goal_, pt_next);
 
@@ -85,8 +87,8 @@ class RDLRouterDistanceHeuristic
       return distance;
     }
 
-    const auto& pt_curr = vertex_map_.at(vt_curr);
-    const auto& pt_prev = vertex_map_.at(vt_prev);
+    const auto& pt_curr = vertex_map_[vt_curr];
+    const auto& pt_prev = vertex_map_[vt_prev];
 
     const odb::Point incoming_vec(pt_curr.x() - pt_prev.x(),
                                   pt_curr.y() - pt_prev.y());
@@ -102,13 +104,34 @@ class RDLRouterDistanceHeuristic
   }
 
  private:
-  const std::map<RDLRouter::grid_vertex, odb::Point>& vertex_map_;
+  const std::vector<odb::Point>& vertex_map_;
   const std::vector<RDLRouter::grid_vertex>& predecessor_;
   const RDLRouter::grid_vertex& start_vertex_;
   odb::Point goal_;
   const float turn_penalty_;
 };
 
+// Keeps a search to the vertices within a region, or all vertices if
+// there is no region
+class RDLRouterRegionFilter
+{
+ public:
+  RDLRouterRegionFilter() = default;
+  RDLRouterRegionFilter(const std::vector<odb::Point>* vertex_map,
+                        const odb::Rect* region)
+      : vertex_map_(vertex_map), region_(region)
+  {
+  }
+  bool operator()(RDLRouter::grid_vertex v) const
+  {
+    return region_ == nullptr || region_->intersects((*vertex_map_)[v]);
+  }
+
+ private:
+  const std::vector<odb::Point>* vertex_map_ = nullptr;
+  const odb::Rect* region_ = nullptr;
+};
+
 struct RDLRouterGoalFound
 {
 };  // exception for termination
@@ -238,7 +261,8 @@ void RDLRouter::route(const std::vector<odb::dbNet*>& nets)
              ordered_nets.size());
 
   const double dbus = block_->getDbUnitsPerMicron();
-  for (const auto& [points, net] : ordered_nets) {
+  auto insert_terminals = [&](const RouteSet& route_set) {
+    const auto& [points, net] = route_set;
     debugPrint(logger_,
                utl::PAD,
                "Router",
@@ -250,27 +274,107 @@ void RDLRouter::route(const std::vector<odb::dbNet*>& nets)
                points.target1.center.x() / dbus,
                points.target1.center.y() / dbus);
 
-    const auto added_edges0
-        = insertTerminalVertex(points.target0, points.target1);
+    auto added_edges = insertTerminalVertex(points.target0, points.target1);
     const auto added_edges1
         = insertTerminalVertex(points.target1, points.target0);
+    added_edges.insert(
+        added_edges.end(), added_edges1.begin(), added_edges1.end());
+    return added_edges;
+  };
+  auto remove_edges = [this](const std::vector<Edge>& edges) {
+    for (const auto& [p0, p1] : edges) {
+      boost::remove_edge(point_vertex_map_[p0], point_vertex_map_[p1], graph_);
+    }
+  };
+  auto commit = [&](const RouteSet& route_set,
+                    const std::vector<grid_vertex>& route) {
+    const auto& [points, net] = route_set;
+    debugPrint(
+        logger_, utl::PAD, "Router", 2, "Route segments {}", route.size());
+    routes[net].push_back({route, points.target0, points.target1});
+    commitRoute(route);
+  };
+
+  // Consecutive routes whose regions don't overlap are searched
+  // concurrently, each confined to its region.  The batches only depend
+  // on the route order so the result doesn't depend on the thread count.
+  std::vector<odb::Rect> regions;
+  regions.reserve(ordered_nets.size());
+  for (const auto& route_set : ordered_nets) {
+    regions.push_back(getRouteRegion(route_set.points));
+  }
+  std::vector<std::vector<size_t>> batches;
+  for (size_t i = 0; i < ordered_nets.size(); i++) {
+    bool new_batch
+        = batches.empty() || batches.back().size() >= max_batch_size_;
+    if (!new_batch) {
+      for (const size_t j : batches.back()) {
+        if (regions[i].intersects(regions[j])) {
+          new_batch = true;
+          break;
+        }
+      }
+    }
+    if (new_batch) {
+      batches.emplace_back();
+    }
+    batches.back().push_back(i);
+  }
 
-    auto route = run(points.target0.center, points.target1.center);
-    if (!route.empty()) {
-      debugPrint(
-          logger_, utl::PAD, "Router", 2, "Route segments {}", route.size());
-      routes[net].push_back({route, points.target0, points.target1});
-      commitRoute(route);
-      for (const auto& [p0, p1] : added_edges0) {
-        boost::remove_edge(
-            point_vertex_map_[p0], point_vertex_map_[p1], graph_);
+  for (const auto& batch : batches) {
+    if (batch.size() == 1) {
+      const RouteSet& route_set = ordered_nets[batch[0]];
+      const auto added_edges = insert_terminals(route_set);
+      auto route = run(route_set.points.target0.center,
+                       route_set.points.target1.center);
+      if (!route.empty()) {
+        commit(route_set, route);
+        remove_edges(added_edges);
+      } else {
+        failed[route_set.net].push_back(route_set.points);
       }
-      for (const auto& [p0, p1] : added_edges1) {
-        boost::remove_edge(
-            point_vertex_map_[p0], point_vertex_map_[p1], graph_);
+      continue;
+    }
+
+    std::vector<std::vector<Edge>> added_edges;
+    added_edges.reserve(batch.size());
+    for (const size_t i : batch) {
+      added_edges.push_back(insert_terminals(ordered_nets[i]));
+    }
+
+    std::vector<std::vector<grid_vertex>> batch_routes(batch.size());
+    utl::ThreadPool::global()->parallelFor(
+        batch.size(),
+        [&](int b) {
+          const RouteSet& route_set = ordered_nets[batch[b]];
+          batch_routes[b] = run(route_set.points.target0.center,
+                                route_set.points.target1.center,
+                                &regions[batch[b]]);
+        },
+        utl::PAD);
+
+    std::vector<size_t> retry;
+    for (size_t b = 0; b < batch.size(); b++) {
+      if (!batch_routes[b].empty()) {
+        commit(ordered_nets[batch[b]], batch_routes[b]);
+      } else {
+        retry.push_back(batch[b]);
+      }
+      remove_edges(added_edges[b]);
+    }
+
+    // Routes that didn't fit in their region get the whole grid
+    for (const size_t i : retry) {
+      const RouteSet& route_set = ordered_nets[i];
+      const auto retry_edges = insert_terminals(route_set);
+      auto route = run(route_set.points.target0.center,
+                       route_set.points.target1.center);
+      if (!route.empty()) {
+        commit(route_set, route);
+        remove_edges(retry_edges);
+      } else {
+        failed[route_set.net].push_back(route_set.points);
       }
-    } else {
-      failed[net].push_back(points);
     }
   }
 
@@ -303,6 +407,21 @@ void RDLRouter::route(const std::vector<odb::dbNet*>& nets)
   }
 }
 
+// The part of the grid a route is confined to when it is searched
+// concurrently with others.  The targets are bloated by half of the
+// distance between them so the route has some room to detour.
+odb::Rect RDLRouter::getRouteRegion(const TargetPair& pair) const
+{
+  odb::Rect region = pair.target0.shape;
+  region.merge(pair.target1.shape);
+  const int64_t half_distance
+      = distance(pair.target0.center, pair.target1.center) / 2;
+  const int64_t margin
+      = std::max<int64_t>(half_distance, 10 * (width_ + spacing_));
+  region.bloat(margin, region);
+  return region;
+}
+
 std::vector<RDLRouter::Edge> RDLRouter::insertTerminalVertex(
     const RouteTarget& target,
     const RouteTarget& source)
@@ -575,15 +694,17 @@ std::set<std::pair<odb::Point, odb::Point>> RDLRouter::commitRoute(
   return removed_edges;
 }
 
-std::vector<RDLRouter::grid_vertex> RDLRouter::run(const odb::Point& source,
-                                                   const odb::Point& dest)
+std::vector<RDLRouter::grid_vertex> RDLRouter::run(
+    const odb::Point& source,
+    const odb::Point& dest,
+    const odb::Rect* region) const
 {
   const int N = boost::num_vertices(graph_);
   std::vector<grid_vertex> p(N);
   std::vector<int64_t> d(N);
 
-  const grid_vertex& start = point_vertex_map_[source];
-  const grid_vertex& goal = point_vertex_map_[dest];
+  const grid_vertex start = point_vertex_map_.at(source);
+  const grid_vertex goal = point_vertex_map_.at(dest);
 
   debugPrint(logger_,
              utl::PAD,
@@ -595,18 +716,26 @@ std::vector<RDLRouter::grid_vertex> RDLRouter::run(const odb::Point& source,
              dest.x(),
              dest.y());
 
+  // Only reads the graph so searches in disjoint regions can run
+  // concurrently
+  using RegionGraph = boost::
+      filtered_graph<GridGraph, boost::keep_all, RDLRouterRegionFilter>;
+  const RegionGraph graph(graph_,
+                          boost::keep_all(),
+                          RDLRouterRegionFilter(&vertex_point_map_, region));
+
   try {
     // call astar named parameter interface
     boost::astar_search_tree(
-        graph_,
+        graph,
         start,
         RDLRouterDistanceHeuristic(
             vertex_point_map_, p, start, dest, turn_penalty_),
         boost::predecessor_map(
             boost::make_iterator_property_map(
-                p.begin(), boost::get(boost::vertex_index, graph_)))
+                p.begin(), boost::get(boost::vertex_index, graph)))
             .distance_map(boost::make_iterator_property_map(
-                d.begin(), boost::get(boost::vertex_index, graph_)))
+                d.begin(), boost::get(boost::vertex_index, graph)))
             .visitor(RDLRouterGoalVisitor<grid_vertex>(goal)));
   } catch (const RDLRouterGoalFound&) {  // found a path to the goal
     std::list<grid_vertex> shortest_path;
@@ -749,7 +878,7 @@ void RDLRouter::addGraphVertex(const odb::Point& point)
              point.y(),
              idx);
   point_vertex_map_[point] = idx;
-  vertex_point_map_[idx] = point;
+  vertex_point_map_.push_back(point);
 }
 
 bool RDLRouter::addGraphEdge(const odb::Point& point0,
@@ -139,7 +139,7 @@ class RDLRouter
   using grid_edge = GridGraph::edge_descriptor;
 
   const GridGraph& getGraph() const { return graph_; };
-  const std::map<grid_vertex, odb::Point>& getVertexMap() const
+  const std::vector<odb::Point>& getVertexMap() const
   {
     return vertex_point_map_;
   }
@@ -154,7 +154,8 @@ class RDLRouter
                     bool check_obstructions = true);
 
   std::vector<grid_vertex> run(const odb::Point& source,
-                               const odb::Point& dest);
+                               const odb::Point& dest,
+                               const odb::Rect* region = nullptr) const;
   std::set<std::pair<odb::Point, odb::Point>> commitRoute(
       const std::vector<grid_vertex>& route);
   void uncommitRoute(const std::set<std::pair<odb::Point, odb::Point>>& route);
@@ -177,6 +178,7 @@ class RDLRouter
                                          const RouteTarget& source);
 
   std::vector<TargetPair> generateRoutingPairs(odb::dbNet* net) const;
+  odb::Rect getRouteRegion(const TargetPair& pair) const;
 
   int getBloatFactor() const;
 
@@ -191,6 +193,9 @@ class RDLRouter
   bool allow45_;
   float turn_penalty_;
 
+  // Most routes searched concurrently in one batch
+  static constexpr size_t max_batch_size_ = 64;
+
   const std::map<odb::dbITerm*, odb::dbITerm*>& routing_map_;
 
   GridGraph graph_;
@@ -199,7 +204,7 @@ class RDLRouter
 
   // Lookup tables
   std::map<odb::Point, grid_vertex> point_vertex_map_;
-  std::map<grid_vertex, odb::Point> vertex_point_map_;
+  std::vector<odb::Point> vertex_point_map_;
   std::map<odb::dbITerm*, std::vector<Edge>> iterm_edges_;
 
   // Routing grid
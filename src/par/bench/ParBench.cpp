@@ -0,0 +1,584 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+// High-level description
+// Micro-benchmarks of the main kernels of TritonPart:
+//   coarsen        : Coarsener::LazyFirstChoice
+//   fm_pass        : one pass of KWayFMRefine
+//   pm_pass        : one pass of KWayPMRefine
+//   priority_queue : insert, update and extract all vertices of PriorityQueue
+//   cut_evaluator  : GoldenEvaluator::CutEvaluator
+// Each kernel is run on a set of hypergraphs. The inputs are hMETIS files
+// given on the command line. If no file is given, a fixed suite of synthetic
+// netlists is generated with a deterministic random seed.
+// The results (wall time, peak RSS and cutcost) are written to a JSON file
+// such that the results of two commits can be compared with diff.
+// -shuffle randomly permutes the vertex ids of the inputs (like the order of
+// the instances in odb), and -vertex_order renumbers the vertices and
+// hyperedges for locality before running the kernels, such that the effect
+// of the renumbering can be measured.
+// -lazy_gain_threshold sets the minimum size of the hyperedges with lazy gain
+// updates in the FM refiners (0 means disabled).
+//
+// Usage:
+//   par_bench [-repeats n] [-num_parts k] [-seed s] [-o file.json]
+//             [-shuffle] [-vertex_order none|rcm] [-lazy_gain_threshold n]
+//             [file.hgr ...]
+///////////////////////////////////////////////////////////////////////////////
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Coarsener.h"
+#include "Evaluator.h"
+#include "Hypergraph.h"
+#include "KWayFMRefine.h"
+#include "KWayPMRefine.h"
+#include "PriorityQueue.h"
+#include "Utilities.h"
+#include "utl/Logger.h"
+
+namespace par {
+
+// the options of the benchmarks
+struct BenchOptions
+{
+  int repeats = 5;
+  int num_parts = 2;
+  int seed = 0;
+  bool shuffle = false;
+  VertexOrder vertex_order = VertexOrder::NONE;
+  int lazy_gain_threshold = 0;
+  std::string output_file = "par_bench.json";
+  std::vector<std::string> hypergraph_files;
+};
+
+// the input of the benchmarks
+struct BenchInput
+{
+  std::string name;
+  HGraphPtr hgraph;
+};
+
+// the result of one benchmark on one input
+struct BenchResult
+{
+  std::string kernel;
+  std::string input;
+  int num_vertices = 0;
+  int num_hyperedges = 0;
+  double min_time_ms = 0.0;
+  double median_time_ms = 0.0;
+  long peak_rss_kb = 0;  // peak RSS of the process after the benchmark
+  float cutcost = 0.0;   // the cutcost of the solution (if applicable)
+};
+
+// Read a hypergraph in hMETIS format.
+// The first line is "num_hyperedges num_vertices [fmt]", where fmt = 1
+// means the hyperedges are weighted, fmt = 10 means the vertices are
+// weighted and fmt = 11 means both. Lines started with "%" are comments.
+static HGraphPtr ReadHgrFile(const std::string& file_name,
+                             utl::Logger* logger)
+{
+  TextFileReader reader;
+  if (reader.Open(file_name) == false) {
+    std::cerr << "[ERROR] Cannot open " << file_name << std::endl;
+    return nullptr;
+  }
+  // Move to the next line which is neither empty nor a comment.
+  // The first element of the line is consumed and stored in token.
+  std::string_view token;
+  auto lambda_next_line = [&]() -> bool {
+    while (reader.NextLine() == true) {
+      if (reader.NextToken(token) == true && token.front() != '%') {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  auto lambda_first_int = [&](int& value) -> bool {
+    return !token.empty()
+           && std::from_chars(token.data(), token.data() + token.size(), value)
+                      .ec
+                  == std::errc();
+  };
+
+  int num_hyperedges = 0;
+  int num_vertices = 0;
+  int fmt = 0;
+  if (lambda_next_line() == false || lambda_first_int(num_hyperedges) == false
+      || reader.NextInt(num_vertices) == false) {
+    std::cerr << "[ERROR] Invalid header in " << file_name << std::endl;
+    return nullptr;
+  }
+  reader.NextInt(fmt);
+  const bool weighted_hyperedges = (fmt % 10 == 1);
+  const bool weighted_vertices = (fmt / 10 == 1);
+
+  std::vector<CsrOffset> eptr{0};
+  std::vector<int> eind;
+  Matrix<float> hyperedge_weights;
+  hyperedge_weights.reserve(num_hyperedges);
+  eptr.reserve(num_hyperedges + 1);
+  for (int e = 0; e < num_hyperedges; e++) {
+    int value = 0;
+    if (lambda_next_line() == false || lambda_first_int(value) == false) {
+      std::cerr << "[ERROR] Missing hyperedges in " << file_name << std::endl;
+      return nullptr;
+    }
+    float weight = 1.0;
+    if (weighted_hyperedges == true) {
+      weight = static_cast<float>(value);
+    } else {
+      eind.push_back(value - 1);
+    }
+    while (reader.NextInt(value) == true) {
+      eind.push_back(value - 1);
+    }
+    eptr.push_back(static_cast<CsrOffset>(eind.size()));
+    hyperedge_weights.push_back({weight});
+  }
+  for (const int v : eind) {
+    if (v < 0 || v >= num_vertices) {
+      std::cerr << "[ERROR] Invalid vertex in " << file_name << std::endl;
+      return nullptr;
+    }
+  }
+
+  Matrix<float> vertex_weights(num_vertices, std::vector<float>(1, 1.0));
+  if (weighted_vertices == true) {
+    for (int v = 0; v < num_vertices; v++) {
+      int value = 0;
+      if (lambda_next_line() == false || lambda_first_int(value) == false) {
+        std::cerr << "[ERROR] Missing vertex weights in " << file_name
+                  << std::endl;
+        return nullptr;
+      }
+      vertex_weights[v][0] = static_cast<float>(value);
+    }
+  }
+
+  return std::make_shared<Hypergraph>(1,
+                                      1,
+                                      0,
+                                      std::move(eptr),
+                                      std::move(eind),
+                                      vertex_weights,
+                                      hyperedge_weights,
+                                      std::vector<int>{},
+                                      std::vector<int>{},
+                                      Matrix<float>{},
+                                      logger);
+}
+
+// Generate a synthetic netlist with locality.
+// The vertices are placed on a line and the pins of each hyperedge are
+// picked around a random center, such that the netlist has a natural
+// clustering structure like the Titan and ISPD98 benchmarks.
+// Most of the hyperedges are small, and a few of them are large (global nets)
+static HGraphPtr GenerateHypergraph(int num_vertices,
+                                    int seed,
+                                    utl::Logger* logger)
+{
+  std::mt19937 rng(seed);
+  const int num_hyperedges = num_vertices + num_vertices / 4;
+  const int locality_window = 64;
+  std::uniform_int_distribution<int> center_dist(0, num_vertices - 1);
+  std::uniform_int_distribution<int> offset_dist(-locality_window,
+                                                 locality_window);
+  std::uniform_real_distribution<float> prob_dist(0.0, 1.0);
+  std::geometric_distribution<int> size_dist(0.5);
+  std::uniform_int_distribution<int> global_size_dist(20, 60);
+
+  std::vector<CsrOffset> eptr{0};
+  std::vector<int> eind;
+  eptr.reserve(num_hyperedges + 1);
+  for (int e = 0; e < num_hyperedges; e++) {
+    const bool global_net = prob_dist(rng) < 0.01;
+    const int size = global_net ? global_size_dist(rng)
+                                : std::min(2 + size_dist(rng), 8);
+    const int center = center_dist(rng);
+    const int begin = static_cast<int>(eind.size());
+    while (static_cast<int>(eind.size()) - begin < size) {
+      int v = global_net ? center_dist(rng) : center + offset_dist(rng);
+      v = std::clamp(v, 0, num_vertices - 1);
+      if (std::find(eind.begin() + begin, eind.end(), v) == eind.end()) {
+        eind.push_back(v);
+      }
+    }
+    eptr.push_back(static_cast<CsrOffset>(eind.size()));
+  }
+
+  // a few vertices are larger (macros) than others
+  Matrix<float> vertex_weights(num_vertices, std::vector<float>(1, 1.0));
+  for (auto& weight : vertex_weights) {
+    if (prob_dist(rng) < 0.005) {
+      weight[0] = 50.0;
+    }
+  }
+  const Matrix<float> hyperedge_weights(num_hyperedges,
+                                        std::vector<float>(1, 1.0));
+
+  return std::make_shared<Hypergraph>(1,
+                                      1,
+                                      0,
+                                      std::move(eptr),
+                                      std::move(eind),
+                                      vertex_weights,
+                                      hyperedge_weights,
+                                      std::vector<int>{},
+                                      std::vector<int>{},
+                                      Matrix<float>{},
+                                      logger);
+}
+
+// Generate a balanced random solution
+static std::vector<int> RandomSolution(const HGraphPtr& hgraph,
+                                       int num_parts,
+                                       int seed)
+{
+  std::vector<int> solution(hgraph->GetNumVertices());
+  for (int v = 0; v < hgraph->GetNumVertices(); v++) {
+    solution[v] = v % num_parts;
+  }
+  std::shuffle(solution.begin(), solution.end(), std::mt19937(seed));
+  return solution;
+}
+
+// Renumber the vertices (and hyperedges) of the input hypergraph.
+// The vertex i of the result is the vertex vertices[i] of hgraph.
+static HGraphPtr RenumberHypergraph(const HGraphPtr& hgraph,
+                                    const BenchOptions& options)
+{
+  HGraphPtr renumbered_hgraph = hgraph;
+  if (options.shuffle == true) {
+    std::vector<int> vertices(renumbered_hgraph->GetNumVertices());
+    std::iota(vertices.begin(), vertices.end(), 0);
+    std::shuffle(vertices.begin(), vertices.end(), std::mt19937(options.seed));
+    renumbered_hgraph = renumbered_hgraph->GetSubHypergraph(vertices);
+  }
+  if (options.vertex_order != VertexOrder::NONE) {
+    renumbered_hgraph = renumbered_hgraph->GetSubHypergraph(
+        renumbered_hgraph->GetLocalityOrder(options.vertex_order));
+  }
+  return renumbered_hgraph;
+}
+
+static long PeakRssKb()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;  // in kilobytes on Linux
+}
+
+// Run the kernel "repeats" times and record the wall time.
+// The setup function is called before each run and is not timed.
+// The kernel returns the cutcost of its solution (0 if not applicable).
+static BenchResult RunBenchmark(const std::string& kernel,
+                                const BenchInput& input,
+                                int repeats,
+                                const std::function<void()>& setup,
+                                const std::function<float()>& run)
+{
+  BenchResult result;
+  result.kernel = kernel;
+  result.input = input.name;
+  result.num_vertices = input.hgraph->GetNumVertices();
+  result.num_hyperedges = input.hgraph->GetNumHyperedges();
+  std::vector<double> times;
+  times.reserve(repeats);
+  for (int i = 0; i < repeats; i++) {
+    setup();
+    const auto start = std::chrono::steady_clock::now();
+    result.cutcost = run();
+    const auto end = std::chrono::steady_clock::now();
+    times.push_back(
+        std::chrono::duration<double, std::milli>(end - start).count());
+  }
+  std::sort(times.begin(), times.end());
+  result.min_time_ms = times.front();
+  result.median_time_ms = times[times.size() / 2];
+  result.peak_rss_kb = PeakRssKb();
+  std::cout << kernel << " " << input.name << " : median "
+            << result.median_time_ms << " ms, cutcost " << result.cutcost
+            << std::endl;
+  return result;
+}
+
+static void RunBenchmarks(const BenchOptions& options,
+                          const BenchInput& input,
+                          utl::Logger* logger,
+                          std::vector<BenchResult>& results)
+{
+  const HGraphPtr& hgraph = input.hgraph;
+  const int num_parts = options.num_parts;
+  // the same parameters as the default of triton_part_hypergraph
+  const float ub_factor = 1.0;
+  const std::vector<float> base_balance(num_parts, 1.0 / num_parts);
+  const Matrix<float> upper_block_balance
+      = hgraph->GetUpperVertexBalance(num_parts, ub_factor, base_balance);
+  const Matrix<float> lower_block_balance
+      = hgraph->GetLowerVertexBalance(num_parts, ub_factor, base_balance);
+  const int refiner_iters = 1;  // run exactly one pass of the refiners
+  const int max_moves = 60;
+  const int total_corking_passes = 25;
+  const int min_num_vertices_each_part = 4;
+
+  auto evaluator = std::make_shared<GoldenEvaluator>(num_parts,
+                                                     std::vector<float>{1.0},
+                                                     std::vector<float>{1.0},
+                                                     std::vector<float>{},
+                                                     0.0,
+                                                     0.0,
+                                                     0.0,
+                                                     0.0,
+                                                     0.0,
+                                                     hgraph,
+                                                     logger);
+  const std::vector<float> thr_cluster_weight
+      = DivideFactor(hgraph->GetTotalVertexWeights(),
+                     min_num_vertices_each_part * num_parts);
+  auto coarsener = std::make_shared<Coarsener>(num_parts,
+                                               200,
+                                               10,
+                                               50,
+                                               1.6,
+                                               30,
+                                               0.0001,
+                                               thr_cluster_weight,
+                                               options.seed,
+                                               CoarsenOrder::RANDOM,
+                                               evaluator,
+                                               logger);
+  auto k_way_fm_refiner = std::make_shared<KWayFMRefine>(num_parts,
+                                                         refiner_iters,
+                                                         0.0,
+                                                         0.0,
+                                                         max_moves,
+                                                         total_corking_passes,
+                                                         evaluator,
+                                                         logger);
+  auto k_way_pm_refiner = std::make_shared<KWayPMRefine>(num_parts,
+                                                         refiner_iters,
+                                                         0.0,
+                                                         0.0,
+                                                         max_moves,
+                                                         total_corking_passes,
+                                                         evaluator,
+                                                         logger);
+  k_way_fm_refiner->SetLazyGainThreshold(options.lazy_gain_threshold);
+  k_way_pm_refiner->SetLazyGainThreshold(options.lazy_gain_threshold);
+
+  auto lambda_no_setup = []() -> void {};
+  const std::vector<int> init_solution
+      = RandomSolution(hgraph, num_parts, options.seed);
+  std::vector<int> solution;
+  auto lambda_reset_solution = [&]() -> void { solution = init_solution; };
+
+  results.push_back(RunBenchmark(
+      "coarsen", input, options.repeats, lambda_no_setup, [&]() -> float {
+        coarsener->LazyFirstChoice(hgraph);
+        return 0.0;
+      }));
+
+  results.push_back(RunBenchmark(
+      "fm_pass", input, options.repeats, lambda_reset_solution, [&]() -> float {
+        k_way_fm_refiner->Refine(
+            hgraph, upper_block_balance, lower_block_balance, solution);
+        return evaluator->CutEvaluator(hgraph, solution).cost;
+      }));
+
+  results.push_back(RunBenchmark(
+      "pm_pass", input, options.repeats, lambda_reset_solution, [&]() -> float {
+        k_way_pm_refiner->Refine(
+            hgraph, upper_block_balance, lower_block_balance, solution);
+        return evaluator->CutEvaluator(hgraph, solution).cost;
+      }));
+
+  // the gains are generated once, such that only the queue is timed
+  std::mt19937 rng(options.seed);
+  std::uniform_real_distribution<float> gain_dist(-10.0, 10.0);
+  std::vector<float> gains(hgraph->GetNumVertices());
+  std::vector<float> new_gains(hgraph->GetNumVertices());
+  for (int v = 0; v < hgraph->GetNumVertices(); v++) {
+    gains[v] = gain_dist(rng);
+    new_gains[v] = gain_dist(rng);
+  }
+  std::unique_ptr<PriorityQueue> queue;
+  results.push_back(RunBenchmark(
+      "priority_queue",
+      input,
+      options.repeats,
+      [&]() -> void {
+        queue = std::make_unique<PriorityQueue>(
+            hgraph->GetNumVertices(), total_corking_passes, hgraph);
+      },
+      [&]() -> float {
+        for (int v = 0; v < hgraph->GetNumVertices(); v++) {
+          queue->InsertIntoPQ(VertexGain(v, 0, 1, gains[v], PathCost{}));
+        }
+        for (int v = 0; v < hgraph->GetNumVertices(); v += 2) {
+          queue->ChangePriority(v,
+                                VertexGain(v, 0, 1, new_gains[v], PathCost{}));
+        }
+        while (queue->CheckIfEmpty() == false) {
+          queue->ExtractMax();
+        }
+        return 0.0;
+      }));
+
+  results.push_back(RunBenchmark(
+      "cut_evaluator", input, options.repeats, lambda_no_setup, [&]() -> float {
+        return evaluator->CutEvaluator(hgraph, init_solution).cost;
+      }));
+
+  results.push_back(RunBenchmark(
+      "cut_cost", input, options.repeats, lambda_no_setup, [&]() -> float {
+        return evaluator->CutCost(hgraph, init_solution);
+      }));
+}
+
+static void WriteResults(const BenchOptions& options,
+                         const std::vector<BenchResult>& results)
+{
+  std::ofstream file(options.output_file);
+  if (!file.is_open()) {
+    std::cerr << "[ERROR] Cannot open " << options.output_file << std::endl;
+    return;
+  }
+  // one benchmark per line, such that the files can be compared with diff
+  file << "{\n";
+  file << "  \"repeats\": " << options.repeats << ",\n";
+  file << "  \"num_parts\": " << options.num_parts << ",\n";
+  file << "  \"seed\": " << options.seed << ",\n";
+  file << "  \"shuffle\": " << (options.shuffle ? "true" : "false") << ",\n";
+  file << "  \"vertex_order\": \"" << ToString(options.vertex_order)
+       << "\",\n";
+  file << "  \"lazy_gain_threshold\": " << options.lazy_gain_threshold
+       << ",\n";
+  file << "  \"benchmarks\": [\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchResult& result = results[i];
+    file << "    {\"kernel\": \"" << result.kernel << "\", \"input\": \""
+         << result.input << "\", \"num_vertices\": " << result.num_vertices
+         << ", \"num_hyperedges\": " << result.num_hyperedges
+         << ", \"min_time_ms\": " << result.min_time_ms
+         << ", \"median_time_ms\": " << result.median_time_ms
+         << ", \"peak_rss_kb\": " << result.peak_rss_kb
+         << ", \"cutcost\": " << result.cutcost << "}"
+         << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  file << "  ]\n";
+  file << "}\n";
+  std::cout << "Write the results to " << options.output_file << std::endl;
+}
+
+}  // namespace par
+
+int main(int argc, char* argv[])
+{
+  par::BenchOptions options;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    const bool has_value = (i + 1 < argc);
+    if (arg == "-repeats" && has_value) {
+      options.repeats = std::max(std::atoi(argv[++i]), 1);
+    } else if (arg == "-num_parts" && has_value) {
+      options.num_parts = std::max(std::atoi(argv[++i]), 2);
+    } else if (arg == "-seed" && has_value) {
+      options.seed = std::atoi(argv[++i]);
+    } else if (arg == "-o" && has_value) {
+      options.output_file = argv[++i];
+    } else if (arg == "-shuffle") {
+      options.shuffle = true;
+    } else if (arg == "-vertex_order" && has_value
+               && (std::string(argv[i + 1]) == "none"
+                   || std::string(argv[i + 1]) == "rcm")) {
+      options.vertex_order = std::string(argv[++i]) == "rcm"
+                                 ? par::VertexOrder::RCM
+                                 : par::VertexOrder::NONE;
+    } else if (arg == "-lazy_gain_threshold" && has_value) {
+      options.lazy_gain_threshold = std::max(std::atoi(argv[++i]), 0);
+    } else if (!arg.empty() && arg.front() == '-') {
+      std::cerr << "Usage: par_bench [-repeats n] [-num_parts k] [-seed s]"
+                << " [-o file.json] [-shuffle] [-vertex_order none|rcm]"
+                << " [-lazy_gain_threshold n] [file.hgr ...]" << std::endl;
+      return 1;
+    } else {
+      options.hypergraph_files.push_back(arg);
+    }
+  }
+
+  utl::Logger logger;
+  std::vector<par::BenchInput> inputs;
+  if (options.hypergraph_files.empty()) {
+    // the synthetic suite covers the sizes from ISPD98 to Titan
+    for (const int num_vertices : {10000, 50000, 200000}) {
+      inputs.push_back({"synthetic_" + std::to_string(num_vertices),
+                        par::GenerateHypergraph(
+                            num_vertices, options.seed, &logger)});
+    }
+  } else {
+    for (const auto& file_name : options.hypergraph_files) {
+      par::HGraphPtr hgraph = par::ReadHgrFile(file_name, &logger);
+      if (hgraph == nullptr) {
+        return 1;
+      }
+      inputs.push_back({file_name, hgraph});
+    }
+  }
+
+  for (auto& input : inputs) {
+    input.hgraph = par::RenumberHypergraph(input.hgraph, options);
+  }
+
+  std::vector<par::BenchResult> results;
+  for (const auto& input : inputs) {
+    par::RunBenchmarks(options, input, &logger, results);
+  }
+  par::WriteResults(options, results);
+  return 0;
+}
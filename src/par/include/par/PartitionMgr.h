@@ -39,6 +39,7 @@
 #include <memory>
 #include <random>
 #include <set>
+#include <string>
 
 namespace ord {
 class dbVerilogNetwork;
@@ -52,11 +53,6 @@ class dbBlock;
 
 namespace sta {
 class dbNetwork;
-class Instance;
-class NetworkReader;
-class Library;
-class Port;
-class Net;
 class dbSta;
 }  // namespace sta
 
@@ -64,15 +60,189 @@ namespace utl {
 class Logger;
 }
 
+namespace dst {
+class Distributed;
+}
+
 namespace par {
 
+class TimingPathsCache;
+
+// Read-only view of a hypergraph in compressed sparse row format.
+// Hyperedge e contains the vertices eind[eptr[e], eptr[e + 1]).
+struct HypergraphView
+{
+  int num_vertices = 0;
+  int num_hyperedges = 0;
+  const int* eptr = nullptr;               // num_hyperedges + 1 entries
+  const int* eind = nullptr;               // eptr[num_hyperedges] entries
+  const float* vertex_weights = nullptr;   // num_vertices entries
+  const float* hyperedge_weights = nullptr;  // nullptr for unit weights
+};
+
 class PartitionMgr
 {
  public:
+  PartitionMgr();
+  ~PartitionMgr();
+
   void init(odb::dbDatabase* db,
             sta::dbNetwork* db_network,
             sta::dbSta* sta,
-            utl::Logger* logger);
+            utl::Logger* logger,
+            dst::Distributed* dist = nullptr);
+
+  // Number of threads used by TritonPart
+  void setNumThreads(int num_threads) { num_threads_ = num_threads; }
+
+  // Early stop of the initial partitioning portfolio (0 means disabled)
+  void setInitPlateauWindow(int init_plateau_window)
+  {
+    init_plateau_window_ = init_plateau_window;
+  }
+
+  // Data structure of the FM gain buckets ("heap" or "bucket")
+  // gain_resolution is the width of each bucket for "bucket"
+  void setGainBucketType(const char* gain_bucket_type, float gain_resolution)
+  {
+    gain_bucket_type_ = gain_bucket_type;
+    gain_resolution_ = gain_resolution;
+  }
+
+  // Use the deterministic parallel vertex matching during coarsening
+  void setParallelMatching(bool parallel_matching)
+  {
+    parallel_matching_ = parallel_matching;
+  }
+
+  // Detect the communities of the hypergraph when no community file is
+  // given, so the coarsening only merges vertices of the same community
+  void setDetectCommunities(bool detect_communities)
+  {
+    detect_communities_ = detect_communities;
+  }
+
+  // Use a spectral embedding with spectral_dimensions dimensions as the
+  // placement information when no placement is given (0 means disabled)
+  void setSpectralDimensions(int spectral_dimensions)
+  {
+    spectral_dimensions_ = spectral_dimensions;
+  }
+
+  // Coarsen the hypergraph file out of core before loading it, such that
+  // the number of vertices is reduced by coarsening_ratio (0 means disabled)
+  void setStreamingCoarseningRatio(float streaming_coarsening_ratio)
+  {
+    streaming_coarsening_ratio_ = streaming_coarsening_ratio;
+  }
+
+  // The wall-clock budget (in seconds, 0 means no limit), the number of
+  // threads and the solver ("auto", "scip" or "cp_sat") for each call of
+  // the ILP solver
+  void setIlpParams(float ilp_time_limit,
+                    int ilp_num_threads,
+                    const char* ilp_solver)
+  {
+    ilp_time_limit_ = ilp_time_limit;
+    ilp_num_threads_ = ilp_num_threads;
+    ilp_solver_ = ilp_solver;
+  }
+
+  // Number of guided v-cycles run concurrently in each round of the
+  // v-cycle refinement (1 means serial)
+  void setNumParallelVcycles(int num_parallel_vcycles)
+  {
+    num_parallel_vcycles_ = num_parallel_vcycles;
+  }
+
+  // The levels with more than num_vertices_threshold_lp vertices are refined
+  // by label propagation instead of FM (0 means disabled)
+  void setNumVerticesThresholdLp(int num_vertices_threshold_lp)
+  {
+    num_vertices_threshold_lp_ = num_vertices_threshold_lp;
+  }
+
+  // The flow of triton_part_hypergraph: "direct" partitions the hypergraph
+  // into num_parts blocks at once, "recursive" uses recursive bisection
+  void setPartitionMode(const char* mode) { partition_mode_ = mode; }
+
+  // Renumber the hypergraph for locality before partitioning:
+  // "none", "rcm" or "placement"
+  void setVertexOrder(const char* order) { vertex_order_ = order; }
+
+  // The FM gains through the hyperedges with at least lazy_gain_threshold
+  // pins are only updated when the move changes the cut status of the
+  // hyperedge (0 means disabled)
+  void setLazyGainThreshold(int lazy_gain_threshold)
+  {
+    lazy_gain_threshold_ = lazy_gain_threshold;
+  }
+
+  // Stop the FM passes adaptively (random walk model) with the given alpha
+  // (0 means disabled)
+  void setAdaptiveStopAlpha(float adaptive_stop_alpha)
+  {
+    adaptive_stop_alpha_ = adaptive_stop_alpha;
+  }
+
+  // Round the costs of the hyperedges and timing paths to multiples of
+  // 2^-fixed_point_bits, such that the gains do not depend on the order
+  // of the summation.  This approximates the cut objective (0 means
+  // disabled), see GoldenEvaluator::SetFixedPointBits
+  void setFixedPointBits(int fixed_point_bits)
+  {
+    fixed_point_bits_ = fixed_point_bits;
+  }
+
+  // The solutions of tritonPartHypergraph are cached in cache_dir and
+  // reused by the runs with the same inputs and parameters
+  // (an empty cache_dir disables the cache)
+  void setSolutionCacheDir(const char* cache_dir)
+  {
+    solution_cache_dir_ = cache_dir;
+  }
+
+  // The wall-clock budget of the partitioner in seconds (0 means no limit).
+  // When the time is up, the best solution found so far is returned
+  void setTimeLimit(float time_limit) { time_limit_ = time_limit; }
+
+  // Reuse the timing paths extracted from STA across triton_part_design
+  // calls until the netlist is changed
+  void setReuseTimingPaths(bool reuse_timing_paths)
+  {
+    reuse_timing_paths_ = reuse_timing_paths;
+  }
+
+  // Start triton_part_design from the "partition_id" properties (e.g.,
+  // loaded by read_partitioning) and only refine around the instances
+  // without a partition_id
+  void setWarmStart(bool warm_start) { warm_start_ = warm_start; }
+
+  // Generate the candidate solutions of triton_part_hypergraph on the dst
+  // workers behind the load balancer at remote_host:remote_port.
+  // The hypergraph is shipped through shared_volume.
+  // An empty remote_host generates them locally
+  void setDistributed(const char* remote_host,
+                      unsigned short remote_port,
+                      const char* shared_volume)
+  {
+    remote_host_ = remote_host;
+    remote_port_ = remote_port;
+    shared_volume_ = shared_volume;
+  }
+
+  // Send triton_part_hypergraph and evaluate_hypergraph_solution to the dst
+  // worker at server_host:server_port (started by run_worker), which keeps
+  // the hypergraph resident under hypergraph_id. The files must be visible
+  // to the worker. An empty server_host runs them locally
+  void setServer(const char* server_host,
+                 unsigned short server_port,
+                 const char* hypergraph_id)
+  {
+    server_host_ = server_host;
+    server_port_ = server_port;
+    server_hypergraph_id_ = hypergraph_id;
+  }
 
   // The function for partitioning a hypergraph
   // This is used for replacing hMETIS
@@ -141,6 +311,34 @@ class PartitionMgr
                                   const std::vector<float>& e_wt_factors,
                                   const std::vector<float>& v_wt_factors);
 
+  // Evaluate many solutions of the same hypergraph. The hypergraph is
+  // loaded only once and the solutions are scored in parallel
+  void evaluateHypergraphSolutions(
+      unsigned int num_parts,
+      float balance_constraint,
+      const std::vector<float>& base_balance,
+      const std::vector<float>& scale_factor,
+      int vertex_dimension,
+      int hyperedge_dimension,
+      const char* hypergraph_file,
+      const char* fixed_file,
+      const char* group_file,
+      const std::vector<std::string>& solution_files,
+      const char* summary_file,
+      // weight parameters
+      const std::vector<float>& e_wt_factors,
+      const std::vector<float>& v_wt_factors);
+
+  // Convert a hypergraph in hMETIS format into the binary format
+  void writeHypergraphBinary(int vertex_dimension,
+                             int hyperedge_dimension,
+                             int placement_dimension,
+                             const char* hypergraph_file,
+                             const char* fixed_file,
+                             const char* community_file,
+                             const char* placement_file,
+                             const char* binary_file);
+
   // Top level interface
   // The function for partitioning a hypergraph
   // This is the main API for TritonPart
@@ -229,6 +427,30 @@ class PartitionMgr
                                   const std::vector<float>& e_wt_factors,
                                   const std::vector<float>& v_wt_factors);
 
+  // Partition the hypergraph given in compressed sparse row format without
+  // any file I/O (e.g., NumPy arrays from Python, which are used in place).
+  // Hyperedge e contains the vertices eind[eptr[e]] ... eind[eptr[e+1] - 1].
+  // The weights are stored row by row, and their dimensions are
+  // num_vertex_weights / num_vertices and
+  // num_hyperedge_weights / (num_eptr - 1).  Empty weights mean unit
+  // weights, and empty fixed_attr means no fixed vertices.
+  // The block id of each vertex is written to solution.
+  void tritonPartHypergraphArrays(unsigned int num_parts,
+                                  float balance_constraint,
+                                  unsigned int seed,
+                                  const int* eptr,
+                                  int num_eptr,
+                                  const int* eind,
+                                  int num_eind,
+                                  const float* vertex_weights,
+                                  int num_vertex_weights,
+                                  const float* hyperedge_weights,
+                                  int num_hyperedge_weights,
+                                  const int* fixed_attr,
+                                  int num_fixed_attr,
+                                  int* solution,
+                                  int num_vertices);
+
   // k-way partitioning used by Hier-RTLMP
   std::vector<int> PartitionKWaySimpleMode(
       unsigned int num_parts_arg,
@@ -238,6 +460,27 @@ class PartitionMgr
       const std::vector<float>& vertex_weights,
       const std::vector<float>& hyperedge_weights);
 
+  // Re-entrant version of the above. Every call builds its own partitioner
+  // and PartitionMgr is only read, so independent hypergraphs can be
+  // partitioned by concurrent threads. The solution is written to
+  // solution[0, hypergraph.num_vertices).
+  void PartitionKWaySimpleMode(unsigned int num_parts_arg,
+                               float balance_constraint_arg,
+                               unsigned int seed_arg,
+                               const HypergraphView& hypergraph,
+                               int* solution) const;
+
+  // Multilevel clustering used by global placement. The hypergraph is
+  // coarsened with the TritonPart first-choice coarsener until it has about
+  // thr_coarsen_vertices vertices, and no cluster is heavier than
+  // max_cluster_weight. The i-th returned vector maps the vertices of level
+  // i to their clusters in level i + 1, level 0 being the input hypergraph.
+  std::vector<std::vector<int>> CoarsenHypergraph(
+      unsigned int seed_arg,
+      const HypergraphView& hypergraph,
+      int thr_coarsen_vertices,
+      float max_cluster_weight) const;
+
   void readPartitioningFile(const std::string& filename,
                             const std::string& instance_map_file);
   void writePartitionVerilog(const char* file_name,
@@ -246,23 +489,42 @@ class PartitionMgr
 
  private:
   odb::dbBlock* getDbBlock() const;
-  sta::Instance* buildPartitionedInstance(
-      const char* name,
-      const char* port_prefix,
-      sta::Library* library,
-      sta::NetworkReader* network,
-      sta::Instance* parent,
-      const std::set<sta::Instance*>* insts,
-      std::map<sta::Net*, sta::Port*>* port_map);
-
-  sta::Instance* buildPartitionedTopInstance(const char* name,
-                                             sta::Library* library,
-                                             sta::NetworkReader* network);
+  TimingPathsCache* getTimingPathsCache();
 
   odb::dbDatabase* db_ = nullptr;
   sta::dbNetwork* db_network_ = nullptr;
   sta::dbSta* sta_ = nullptr;
   utl::Logger* logger_ = nullptr;
+  dst::Distributed* dist_ = nullptr;
+  int num_threads_ = 1;
+  int init_plateau_window_ = 0;
+  std::string gain_bucket_type_ = "heap";
+  float gain_resolution_ = 1.0;
+  bool parallel_matching_ = false;
+  bool detect_communities_ = false;
+  int spectral_dimensions_ = 0;
+  float streaming_coarsening_ratio_ = 0.0;
+  float ilp_time_limit_ = 0.0;
+  int ilp_num_threads_ = 1;
+  std::string ilp_solver_ = "auto";
+  int num_parallel_vcycles_ = 1;
+  int num_vertices_threshold_lp_ = 0;
+  std::string partition_mode_ = "direct";
+  std::string vertex_order_ = "none";
+  int lazy_gain_threshold_ = 0;
+  float adaptive_stop_alpha_ = 0.0;
+  int fixed_point_bits_ = 0;
+  std::string solution_cache_dir_;
+  float time_limit_ = 0.0;
+  bool reuse_timing_paths_ = false;
+  bool warm_start_ = false;
+  std::string remote_host_;
+  unsigned short remote_port_ = 0;
+  std::string shared_volume_;
+  std::string server_host_;
+  unsigned short server_port_ = 0;
+  std::string server_hypergraph_id_;
+  std::unique_ptr<TimingPathsCache> timing_paths_cache_;
 };
 
 }  // namespace par
@@ -0,0 +1,261 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "BucketQueue.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Hypergraph.h"
+
+namespace par {
+
+// the keys are clamped to [-kMaxBucketKey, kMaxBucketKey] to bound
+// the number of buckets for extremely large gains
+static constexpr int kMaxBucketKey = 1 << 20;
+
+BucketQueue::BucketQueue(const int total_elements,
+                         const int maximum_traverse_level,
+                         const float gain_resolution,
+                         HGraphPtr hypergraph)
+    : GainContainer(maximum_traverse_level, std::move(hypergraph)),
+      gain_resolution_(gain_resolution > 0.0 ? gain_resolution : 1.0)
+{
+  locations_.resize(total_elements, -1);
+  keys_.resize(total_elements, 0);
+  next_.resize(total_elements, -1);
+  prev_.resize(total_elements, -1);
+}
+
+void BucketQueue::Clear()
+{
+  active_ = false;
+  total_elements_ = 0;
+  for (const auto& cell : cells_) {
+    locations_[cell.GetVertex()] = -1;
+  }
+  cells_.clear();
+  std::fill(heads_.begin(), heads_.end(), -1);
+  max_index_ = -1;
+}
+
+void BucketQueue::Reset(HGraphPtr hypergraph)
+{
+  if (hypergraph == hypergraph_) {
+    Clear();
+    return;
+  }
+  hypergraph_ = std::move(hypergraph);
+  active_ = false;
+  total_elements_ = 0;
+  cells_.clear();
+  const int num_vertices = hypergraph_->GetNumVertices();
+  locations_.assign(num_vertices, -1);
+  keys_.assign(num_vertices, 0);
+  next_.assign(num_vertices, -1);
+  prev_.assign(num_vertices, -1);
+  std::fill(heads_.begin(), heads_.end(), -1);
+  max_index_ = -1;
+}
+
+// insert one element into the bucket list
+void BucketQueue::InsertIntoPQ(const VertexGain& element)
+{
+  num_operations_++;
+  const int vertex_id = element.GetVertex();
+  if (locations_[vertex_id] > -1) {
+    UpdateCell(vertex_id, element);
+    return;
+  }
+  total_elements_++;
+  locations_[vertex_id] = cells_.size();
+  cells_.push_back(element);
+  Link(vertex_id, GetKey(element.GetGain()));
+}
+
+// get the largest element
+const VertexGain& BucketQueue::GetMax()
+{
+  if (max_index_ < 0) {
+    return dummy_cell_;
+  }
+  return cells_[locations_[heads_[max_index_]]];
+}
+
+// get the largest element and remove it from the bucket list
+VertexGain BucketQueue::ExtractMax()
+{
+  num_operations_++;
+  VertexGain max_element = GetMax();
+  if (max_index_ >= 0) {
+    RemoveCell(max_element.GetVertex());
+  }
+  return max_element;
+}
+
+// find the vertex gain which can satisfy the balance constraint
+// We traverse the buckets from the highest key and check at most
+// maximum_traverse_level_ elements
+VertexGain BucketQueue::GetBestCandidate(const MoveLegality& is_legal_move)
+{
+  int pass = 0;
+  for (int index = max_index_; index >= 0; index--) {
+    for (int v = heads_[index]; v != -1; v = next_[v]) {
+      if (pass++ > maximum_traverse_level_) {
+        return dummy_cell_;
+      }
+      const VertexGain& cell = cells_[locations_[v]];
+      if (is_legal_move(cell) == true) {
+        return cell;
+      }
+    }
+  }
+  return dummy_cell_;
+}
+
+// Remove the specified vertex
+void BucketQueue::Remove(int vertex_id)
+{
+  num_operations_++;
+  RemoveCell(vertex_id);
+}
+
+// Update the priority (gain) for the specified vertex
+void BucketQueue::ChangePriority(int vertex_id, const VertexGain& new_element)
+{
+  num_operations_++;
+  UpdateCell(vertex_id, new_element);
+}
+
+// ----------------------------------------------------------------
+// Private functions
+// ----------------------------------------------------------------
+
+// The last element of cells_ is moved into the freed location
+void BucketQueue::RemoveCell(int vertex_id)
+{
+  const int location = locations_[vertex_id];
+  if (location == -1) {
+    return;  // This vertex does not exists
+  }
+  Unlink(vertex_id);
+  const int last_location = static_cast<int>(cells_.size()) - 1;
+  if (location != last_location) {
+    cells_[location] = std::move(cells_[last_location]);
+    locations_[cells_[location].GetVertex()] = location;
+  }
+  cells_.pop_back();
+  locations_[vertex_id] = -1;
+  total_elements_--;
+  if (total_elements_ <= 0) {
+    active_ = false;
+  }
+}
+
+void BucketQueue::UpdateCell(int vertex_id, const VertexGain& new_element)
+{
+  const int location = locations_[vertex_id];
+  if (location == -1) {
+    return;  // This vertex does not exists
+  }
+  cells_[location] = new_element;
+  const int key = GetKey(new_element.GetGain());
+  if (key == keys_[vertex_id]) {
+    return;  // the vertex stays in the same bucket
+  }
+  Unlink(vertex_id);
+  Link(vertex_id, key);
+}
+
+int BucketQueue::GetKey(float gain) const
+{
+  // infinite gains go to the extreme buckets, NaN to the lowest one
+  if (!std::isfinite(gain)) {
+    return gain > 0.0 ? kMaxBucketKey : -kMaxBucketKey;
+  }
+  const float key = std::floor(gain / gain_resolution_);
+  return static_cast<int>(std::clamp(key,
+                                     static_cast<float>(-kMaxBucketKey),
+                                     static_cast<float>(kMaxBucketKey)));
+}
+
+// add the vertex to the head of its bucket
+// The bucket array is extended when the key is out of the current range
+void BucketQueue::Link(int vertex_id, int key)
+{
+  if (heads_.empty()) {
+    min_key_ = key;
+    heads_.push_back(-1);
+  } else if (key < min_key_) {
+    const int num_new_buckets = min_key_ - key;
+    heads_.insert(heads_.begin(), num_new_buckets, -1);
+    if (max_index_ >= 0) {
+      max_index_ += num_new_buckets;
+    }
+    min_key_ = key;
+  } else if (key - min_key_ >= static_cast<int>(heads_.size())) {
+    heads_.resize(key - min_key_ + 1, -1);
+  }
+  const int index = key - min_key_;
+  keys_[vertex_id] = key;
+  prev_[vertex_id] = -1;
+  next_[vertex_id] = heads_[index];
+  if (heads_[index] != -1) {
+    prev_[heads_[index]] = vertex_id;
+  }
+  heads_[index] = vertex_id;
+  max_index_ = std::max(max_index_, index);
+}
+
+// remove the vertex from its bucket
+// If the highest bucket becomes empty, move max_index_ down
+void BucketQueue::Unlink(int vertex_id)
+{
+  const int index = keys_[vertex_id] - min_key_;
+  if (prev_[vertex_id] != -1) {
+    next_[prev_[vertex_id]] = next_[vertex_id];
+  } else {
+    heads_[index] = next_[vertex_id];
+  }
+  if (next_[vertex_id] != -1) {
+    prev_[next_[vertex_id]] = prev_[vertex_id];
+  }
+  prev_[vertex_id] = -1;
+  next_[vertex_id] = -1;
+  while (max_index_ >= 0 && heads_[max_index_] == -1) {
+    max_index_--;
+  }
+}
+
+}  // namespace par
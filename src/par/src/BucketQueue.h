@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <vector>
+
+#include "PriorityQueue.h"
+
+namespace par {
+
+// ------------------------------------------------------------
+// Bucket-list based gain bucket (Only for VertexGain)
+// This is the classical gain-bucket data structure of FM.
+// The float gain is quantized into an integer key
+// (key = floor(gain / gain_resolution)), and all the elements
+// with the same key are stored in a doubly-linked list.
+// Insert, Remove and ChangePriority are O(1).
+// The vertex gains are stored contiguously and the lists are
+// intrusive (indexed by vertex id), so no memory is allocated
+// once the gain bucket has grown to its working size.
+// Elements with the same key are returned in LIFO order.
+// -------------------------------------------------------------
+class BucketQueue : public GainContainer
+{
+ public:
+  // constructors
+  BucketQueue(int total_elements,
+              int maximum_traverse_level,
+              float gain_resolution,
+              HGraphPtr hypergraph);
+
+  // insert one element (VertexGain) into the bucket list
+  void InsertIntoPQ(const VertexGain& element) override;
+
+  // extract the largest element, i.e.,
+  // get the largest element and remove it from the bucket list
+  VertexGain ExtractMax() override;
+
+  // get the largest element without removing it from the bucket list
+  const VertexGain& GetMax() override;
+
+  // find the vertex gain which can satisfy the balance constraint
+  VertexGain GetBestCandidate(const MoveLegality& is_legal_move) override;
+
+  // update the priority (gain) for the specified vertex
+  void ChangePriority(int vertex_id, const VertexGain& new_element) override;
+
+  // Remove the specified vertex
+  void Remove(int vertex_id) override;
+
+  // the maximum number of elements
+  int GetSizeOfMap() const override { return locations_.size(); }
+  // check if the vertex exists
+  bool CheckIfVertexExists(int v) const override { return locations_[v] > -1; }
+  // clear the bucket list
+  void Clear() override;
+  void Reset(HGraphPtr hypergraph) override;
+
+ private:
+  // Remove and ChangePriority without counting the operation
+  void RemoveCell(int vertex_id);
+  void UpdateCell(int vertex_id, const VertexGain& new_element);
+
+  // quantize the gain into the key of the bucket
+  int GetKey(float gain) const;
+
+  // add the vertex to the head of the bucket with the specified key
+  void Link(int vertex_id, int key);
+
+  // remove the vertex from its bucket
+  void Unlink(int vertex_id);
+
+  // private variables
+  const float gain_resolution_ = 1.0;
+  const VertexGain dummy_cell_;    // returned when the bucket list is empty
+  std::vector<VertexGain> cells_;  // the elements stored contiguously
+  std::vector<int> locations_;     // the location of each vertex in cells_
+                                   // (-1 if the vertex is not in the bucket)
+  std::vector<int> keys_;  // the key of the bucket containing each vertex
+  std::vector<int> next_;  // next vertex in the same bucket (-1 for tail)
+  std::vector<int> prev_;  // previous vertex in the same bucket (-1 for head)
+  std::vector<int> heads_;  // the first vertex of each bucket (-1 for empty)
+                            // the bucket of key is heads_[key - min_key_]
+  int min_key_ = 0;         // the key of heads_[0]
+  int max_index_ = -1;      // the index of the highest non-empty bucket
+};
+
+}  // namespace par
@@ -40,9 +40,12 @@
 
 #include "Coarsener.h"
 
+#include <algorithm>
+#include <functional>
 #include <numeric>
 #include <random>
 #include <set>
+#include <unordered_map>
 
 #include "Evaluator.h"
 #include "Hypergraph.h"
@@ -88,6 +91,7 @@ Coarsener::Coarsener(const int num_parts,
 CoarseGraphPtrs Coarsener::LazyFirstChoice(const HGraphPtr& hgraph) const
 {
   const auto start_timestamp = std::chrono::high_resolution_clock::now();
+  ProfileTimer profile_timer(profiler_.get(), ProfilePhase::COARSENING);
   const bool timing_flag = hgraph->HasTiming();
   std::vector<HGraphPtr> hierarchy;  // a sequence of coarser hypergraphs
   // start the FC multilevel coarsening by pushing the original hgraph to
@@ -124,6 +128,9 @@ CoarseGraphPtrs Coarsener::LazyFirstChoice(const HGraphPtr& hgraph) const
               // previous iteration
     }
     hierarchy.push_back(hg);
+    if (profiler_ != nullptr) {
+      profiler_->AddCoarseningLevel(hg->GetMemoryUsage());
+    }
     if (timing_flag == true) {
       logger_->report(
           "[COARSEN] Level {} :: num_vertices = {}, num_hyperedges = {}, "
@@ -290,13 +297,13 @@ void Coarsener::VertexMatching(
       // mark fixed vertices as single-vertex clusters
       if (hgraph->GetFixedAttr(v) > -1) {
         vertex_cluster_id_vec[v] = cluster_id++;
-        vertex_weights_c.push_back(hgraph->GetVertexWeights(v));
+        vertex_weights_c.push_back(ToVector(hgraph->GetVertexWeights(v)));
         fixed_attr_c.push_back(hgraph->GetFixedAttr(v));
         if (hgraph->HasCommunity()) {
           community_attr_c.push_back(hgraph->GetCommunity(v));
         }
         if (hgraph->HasPlacement()) {
-          placement_attr_c.push_back(hgraph->GetPlacement(v));
+          placement_attr_c.push_back(ToVector(hgraph->GetPlacement(v)));
         }
       } else {
         unvisited.push_back(v);  // this vertex is not fixed
@@ -305,12 +312,28 @@ void Coarsener::VertexMatching(
   }
   // shuffle the remaining vertices based on user-specified options
   OrderVertices(hgraph, unvisited);
+  // the score of each hyperedge is calculated once for all its pins
+  const std::vector<float> norm_edge_scores
+      = evaluator_->GetNormEdgeScores(hgraph);
+  if (parallel_matching_ == true) {
+    ParallelVertexMatching(hgraph,
+                           norm_edge_scores,
+                           unvisited,
+                           cluster_id,
+                           vertex_cluster_id_vec,
+                           vertex_weights_c,
+                           community_attr_c,
+                           fixed_attr_c,
+                           placement_attr_c);
+    return;
+  }
   // calculate the best vertex to cluster for current vertex
   // if the number of visited vertices is larger than
   // num_early_stop_visited_vertices, then stop the coarsening process
   const int num_early_stop_visited_vertices
       = static_cast<int>(unvisited.size()) / coarsening_ratio_;
   int num_visited_vertices = 0;
+  NeighborScores neighbor_scores;
   for (auto v_iter = unvisited.begin(); v_iter != unvisited.end(); v_iter++) {
     const int v = *v_iter;  // here we should use iterator to enable early-stop
                             // mechanism
@@ -318,132 +341,21 @@ void Coarsener::VertexMatching(
       continue;  // this vertex has been mapped
     }
 
-    // initialize the score for neighbors
-    std::map<int, float> score_map;
-    // traverse all its neighbors
-    for (const int he : hgraph->Edges(v)) {
-      const auto edge_range = hgraph->Vertices(he);
-      const int he_size = edge_range.size();
-      if (he_size <= 1 || he_size > thr_coarsen_hyperedge_size_skip_) {
-        continue;
-      }
-      // get the normalized score
-      const float he_score = evaluator_->GetNormEdgeScore(he, hgraph);
-      // check the vertices in this hyperedge
-      for (const int nbr_v : edge_range) {
-        if (nbr_v == v) {
-          continue;  // ignore the vertex v itself
-        }
-        // if the nbr_v has been identified
-        if (score_map.find(nbr_v) != score_map.end()) {
-          score_map[nbr_v] += he_score;
-          continue;
-        }
-        // if the nbr_v is a new neighbor
-        //
-        // check if the merging conditions are satisfied
-        // we do not allow the weight of cluster exceed the weight threshold
-        // we do not allow the merging of non-fixed vertices with fixed-vertices
-        // we do not allow the merging between vertices in different communities
-        if ((hgraph->HasFixedVertices() && hgraph->GetFixedAttr(nbr_v) > -1)
-            || (hgraph->HasCommunity()
-                && hgraph->GetCommunity(v) != hgraph->GetCommunity(nbr_v))) {
-          continue;
-        }
-        // check the vertex weight constraint
-        const std::vector<float>& nbr_v_weight
-            = vertex_cluster_id_vec[nbr_v] > -1
-                  ? vertex_weights_c[vertex_cluster_id_vec[nbr_v]]
-                  : hgraph->GetVertexWeights(nbr_v);
-        // This line needs to be updated
-        if (hgraph->GetVertexWeights(v) + nbr_v_weight > thr_cluster_weight_) {
-          continue;  // cannot satisfy the vertex weight constraint
-        }
-        score_map[nbr_v] = he_score;
-      }
-    }  // finish traversing all the neighbors
-
-    // if there is no neighbor, map current vertex as a single-vertex cluster
-    if (score_map.empty()) {
-      num_visited_vertices++;
-      vertex_cluster_id_vec[v] = cluster_id++;
-      vertex_weights_c.push_back(hgraph->GetVertexWeights(v));
-      if (hgraph->HasPlacement()) {
-        placement_attr_c.push_back(hgraph->GetPlacement(v));
-      }
-      if (hgraph->HasCommunity()) {
-        community_attr_c.push_back(hgraph->GetCommunity(v));
-      }
-      if (hgraph->HasFixedVertices()) {
-        fixed_attr_c.push_back(hgraph->GetFixedAttr(v));
-      }
-      continue;
-    }
-    // update the score based on critical timing paths
-    // Here we do not need to traverse the entire paths
-    // we just need to check the neighbors of the path
-    // because if there is a path, the most important neighbors
-    // must have been counter when traversing hyperedges before
-    // We just consider the direct neighbors of the vertex
-    // i.e., left neighbor and right neighbor
-    // TODO: 20230409:
-    // Exploration that if we can further improve the results by considering
-    // more neighbors on timing-critical paths
-    // No idea yet.
-    if (hgraph->HasTiming() && hgraph->GetNumTimingPaths() > 0) {
-      for (const int p : hgraph->TimingPathsThrough(v)) {
-        const float path_timing_score
-            = evaluator_->GetPathTimingScore(p, hgraph);
-        // traverse the current path
-        auto path_range = hgraph->PathVertices(p);
-        for (auto iter = path_range.begin(); iter != path_range.end(); ++iter) {
-          const int vertex_id = *iter;
-          if (vertex_id != v) {
-            continue;  // we need to find the neighbors of v, so continue here
-          }
-          std::vector<int> neighbors;
-          if (iter != path_range.begin()) {
-            neighbors.push_back(*(iter - 1));  // left neighbor
-          }
-          if (iter + 1 != path_range.end()) {
-            neighbors.push_back(*(iter + 1));  // right neighbor
-          }
-          // add the score.
-          // If the neighbor not found by connectivity, which means the balance
-          // constraint cannot be statisfied
-          for (const auto& nbr_v : neighbors) {
-            if (score_map.find(nbr_v) != score_map.end()) {
-              score_map[nbr_v] += path_timing_score;
-            }
-          }
-        }  // finish traversing current paths
-      }    // finish current nbr_v
-    }
-    // update the score based on physical location information
-    if (hgraph->HasPlacement()) {
-      for (auto& [u, score] : score_map) {  // the score will be updated
-        score += evaluator_->GetPlacementScore(v, u, hgraph);
-      }
-    }
     // find the best neighbor vertex
-    float best_score = -std::numeric_limits<float>::max();
-    int best_vertex = -1;
-    for (const auto& [u, score] : score_map) {
-      if (score > best_score) {
-        best_vertex = u;
-        best_score = score;
-      } else if (score == best_score && vertex_cluster_id_vec[u] == -1) {
-        best_vertex = u;
-      }
-    }
-
+    const int best_vertex = FindBestNeighbor(hgraph,
+                                             v,
+                                             norm_edge_scores,
+                                             vertex_cluster_id_vec,
+                                             vertex_weights_c,
+                                             neighbor_scores);
+    // if there is no neighbor, map current vertex as a single-vertex cluster
     if (best_vertex == -1) {
       num_visited_vertices += 1;
       vertex_cluster_id_vec[v] = cluster_id;
       cluster_id++;
-      vertex_weights_c.push_back(hgraph->GetVertexWeights(v));
+      vertex_weights_c.push_back(ToVector(hgraph->GetVertexWeights(v)));
       if (hgraph->HasPlacement()) {
-        placement_attr_c.push_back(hgraph->GetPlacement(v));
+        placement_attr_c.push_back(ToVector(hgraph->GetPlacement(v)));
       }
       if (hgraph->HasCommunity()) {
         community_attr_c.push_back(hgraph->GetCommunity(v));
@@ -510,9 +422,11 @@ void Coarsener::VertexMatching(
           continue;  // this vertex has been visited
         }
         vertex_cluster_id_vec[cur_vertex] = cluster_id++;
-        vertex_weights_c.push_back(hgraph->GetVertexWeights(cur_vertex));
+        vertex_weights_c.push_back(
+            ToVector(hgraph->GetVertexWeights(cur_vertex)));
         if (hgraph->HasPlacement()) {
-          placement_attr_c.push_back(hgraph->GetPlacement(cur_vertex));
+          placement_attr_c.push_back(
+              ToVector(hgraph->GetPlacement(cur_vertex)));
         }
         if (hgraph->HasCommunity()) {
           community_attr_c.push_back(hgraph->GetCommunity(cur_vertex));
@@ -526,6 +440,347 @@ void Coarsener::VertexMatching(
   }
 }
 
+// Parallel version of VertexMatching.
+// The matching is performed in rounds. In each round, all the unmatched
+// vertices propose their best neighbors in parallel, based on the clusters
+// formed in the previous rounds. Then the proposals are resolved in the
+// order of unvisited, following the same rules as VertexMatching.
+// If the cluster of the best neighbor has grown too heavy in the current
+// round, the proposal is rejected and the vertex proposes again in the next
+// round. The proposals do not depend on the number of threads, so the
+// matching is deterministic.
+void Coarsener::ParallelVertexMatching(
+    const HGraphPtr& hgraph,
+    const std::vector<float>& norm_edge_scores,
+    const std::vector<int>& unvisited,
+    int cluster_id,
+    std::vector<int>& vertex_cluster_id_vec,
+    Matrix<float>& vertex_weights_c,
+    std::vector<int>& community_attr_c,
+    std::vector<int>& fixed_attr_c,
+    Matrix<float>& placement_attr_c) const
+{
+  // map the vertex v as a single-vertex cluster
+  auto lambda_single_cluster = [&](int v) -> void {
+    vertex_cluster_id_vec[v] = cluster_id++;
+    vertex_weights_c.push_back(ToVector(hgraph->GetVertexWeights(v)));
+    if (hgraph->HasPlacement()) {
+      placement_attr_c.push_back(ToVector(hgraph->GetPlacement(v)));
+    }
+    if (hgraph->HasCommunity()) {
+      community_attr_c.push_back(hgraph->GetCommunity(v));
+    }
+    if (hgraph->HasFixedVertices()) {
+      fixed_attr_c.push_back(hgraph->GetFixedAttr(v));
+    }
+  };
+
+  const int num_early_stop_visited_vertices
+      = static_cast<int>(unvisited.size()) / coarsening_ratio_;
+  int num_visited_vertices = 0;
+  bool early_stop_flag = false;
+  std::vector<int> candidates = unvisited;  // vertices to be matched
+  std::vector<int> best_neighbors(hgraph->GetNumVertices(), -1);
+  for (int round = 0; round < max_matching_rounds_; round++) {
+    if (candidates.empty() == true || early_stop_flag == true) {
+      break;
+    }
+    // Step 1: each candidate proposes its best neighbor in parallel
+    // The clusters are not changed in this step.
+    ParallelForChunks(
+        thread_pool_.get(),
+        candidates.size(),
+        parallel_workload_threshold_,
+        [&](int begin, int end) {
+          NeighborScores neighbor_scores;
+          for (int i = begin; i < end; i++) {
+            const int v = candidates[i];
+            best_neighbors[v] = FindBestNeighbor(hgraph,
+                                                 v,
+                                                 norm_edge_scores,
+                                                 vertex_cluster_id_vec,
+                                                 vertex_weights_c,
+                                                 neighbor_scores);
+          }
+        });
+
+    // Step 2: resolve the proposals in the order of candidates
+    std::vector<int> rejected_candidates;
+    for (const int v : candidates) {
+      if (vertex_cluster_id_vec[v] > -1) {
+        continue;  // v has been clustered by other vertex in this round
+      }
+      const int best_vertex = best_neighbors[v];
+      if (best_vertex == -1) {
+        // if there is no neighbor, map v as a single-vertex cluster
+        num_visited_vertices++;
+        lambda_single_cluster(v);
+        continue;
+      }
+
+      // cluster best_vertex and v
+      // Case 1 : best_vertex has been clustered with other vertices, add v to
+      // that cluster Case 2 : best_vertex and v both are not clustered
+      if (vertex_cluster_id_vec[best_vertex] > -1) {
+        const int best_cluster_id = vertex_cluster_id_vec[best_vertex];
+        // the cluster may have grown in this round
+        if (hgraph->GetVertexWeights(v)
+                + FloatView(vertex_weights_c[best_cluster_id])
+            > thr_cluster_weight_) {
+          rejected_candidates.push_back(v);
+          continue;
+        }
+        num_visited_vertices++;
+        vertex_cluster_id_vec[v] = best_cluster_id;
+        // you cannot change the order here
+        // update the placement location
+        if (hgraph->HasPlacement()) {
+          placement_attr_c[best_cluster_id] = evaluator_->GetAvgPlacementLoc(
+              vertex_weights_c[best_cluster_id],
+              hgraph->GetVertexWeights(v),
+              placement_attr_c[best_cluster_id],
+              hgraph->GetPlacement(v));
+        }
+        // update the weight of cluster
+        Accumulate(vertex_weights_c[best_cluster_id],
+                   hgraph->GetVertexWeights(v));
+      } else {
+        num_visited_vertices += 2;
+        vertex_cluster_id_vec[best_vertex] = cluster_id;
+        vertex_cluster_id_vec[v] = cluster_id;
+        cluster_id++;
+        vertex_weights_c.push_back(hgraph->GetVertexWeights(best_vertex)
+                                   + hgraph->GetVertexWeights(v));
+        if (hgraph->HasPlacement()) {
+          placement_attr_c.push_back(
+              evaluator_->GetAvgPlacementLoc(v, best_vertex, hgraph));
+        }
+        if (hgraph->HasCommunity()) {
+          community_attr_c.push_back(hgraph->GetCommunity(v));
+        }
+        if (hgraph->HasFixedVertices()) {
+          fixed_attr_c.push_back(hgraph->GetFixedAttr(v));
+        }
+      }
+      const int remaining_vertices
+          = hgraph->GetNumVertices() + cluster_id - num_visited_vertices;
+      // check the early-stop condition
+      if (remaining_vertices <= num_early_stop_visited_vertices) {
+        early_stop_flag = true;
+        break;
+      }
+    }
+    candidates = std::move(rejected_candidates);
+  }
+
+  // the remaining vertices are mapped as single-vertex clusters
+  for (const int v : unvisited) {
+    if (vertex_cluster_id_vec[v] == -1) {
+      lambda_single_cluster(v);
+    }
+  }
+}
+
+void NeighborScores::Reset(const int max_neighbors)
+{
+  // keep the load factor at most 1/2
+  size_t num_slots = 16;
+  while (num_slots < 2 * static_cast<size_t>(max_neighbors)) {
+    num_slots *= 2;
+  }
+  if (num_slots > slots_.size()) {
+    slots_.assign(num_slots, Entry());
+    mask_ = num_slots - 1;
+  } else {
+    for (const int slot : used_slots_) {
+      slots_[slot] = Entry();
+    }
+  }
+  used_slots_.clear();
+}
+
+int NeighborScores::GetSlot(const int u) const
+{
+  // multiplicative hashing, followed by linear probing
+  unsigned slot = (static_cast<unsigned>(u) * 2654435769u) & mask_;
+  while (slots_[slot].vertex != -1 && slots_[slot].vertex != u) {
+    slot = (slot + 1) & mask_;
+  }
+  return slot;
+}
+
+NeighborScores::Entry* NeighborScores::Find(const int u)
+{
+  Entry& entry = slots_[GetSlot(u)];
+  return entry.vertex == u ? &entry : nullptr;
+}
+
+NeighborScores::Entry& NeighborScores::Insert(const int u)
+{
+  const int slot = GetSlot(u);
+  used_slots_.push_back(slot);
+  Entry& entry = slots_[slot];
+  entry.vertex = u;
+  return entry;
+}
+
+const std::vector<NeighborScores::Entry*>&
+NeighborScores::GetAcceptedEntries()
+{
+  accepted_entries_.clear();
+  for (const int slot : used_slots_) {
+    if (slots_[slot].accepted == true) {
+      accepted_entries_.push_back(&slots_[slot]);
+    }
+  }
+  std::sort(accepted_entries_.begin(),
+            accepted_entries_.end(),
+            [](const Entry* a, const Entry* b) {
+              return a->vertex < b->vertex;
+            });
+  return accepted_entries_;
+}
+
+// find the best neighbor to cluster for vertex v.
+// Return -1 if no neighbor can be clustered with v.
+// vertex_cluster_id_vec and vertex_weights_c are the clusters found so far
+int Coarsener::FindBestNeighbor(
+    const HGraphPtr& hgraph,
+    int v,
+    const std::vector<float>& norm_edge_scores,
+    const std::vector<int>& vertex_cluster_id_vec,
+    const Matrix<float>& vertex_weights_c,
+    NeighborScores& neighbor_scores) const
+{
+  // the number of pins of the neighbors bounds the number of neighbors
+  int max_neighbors = 0;
+  for (const int he : hgraph->Edges(v)) {
+    const int he_size = hgraph->Vertices(he).size();
+    if (he_size > 1 && he_size <= thr_coarsen_hyperedge_size_skip_) {
+      max_neighbors += he_size - 1;
+    }
+  }
+  // initialize the score for neighbors
+  neighbor_scores.Reset(max_neighbors);
+  // traverse all its neighbors
+  for (const int he : hgraph->Edges(v)) {
+    const auto edge_range = hgraph->Vertices(he);
+    const int he_size = edge_range.size();
+    if (he_size <= 1 || he_size > thr_coarsen_hyperedge_size_skip_) {
+      continue;
+    }
+    // get the normalized score
+    const float he_score = norm_edge_scores[he];
+    // check the vertices in this hyperedge
+    for (const int nbr_v : edge_range) {
+      if (nbr_v == v) {
+        continue;  // ignore the vertex v itself
+      }
+      // if the nbr_v has been identified
+      NeighborScores::Entry* entry = neighbor_scores.Find(nbr_v);
+      if (entry != nullptr) {
+        if (entry->accepted == true) {
+          entry->score += he_score;
+        }
+        continue;
+      }
+      // if the nbr_v is a new neighbor, it is recorded even if it is
+      // rejected, so the merging conditions are checked only once
+      NeighborScores::Entry& new_entry = neighbor_scores.Insert(nbr_v);
+      //
+      // check if the merging conditions are satisfied
+      // we do not allow the weight of cluster exceed the weight threshold
+      // we do not allow the merging of non-fixed vertices with fixed-vertices
+      // we do not allow the merging between vertices in different communities
+      if ((hgraph->HasFixedVertices() && hgraph->GetFixedAttr(nbr_v) > -1)
+          || (hgraph->HasCommunity()
+              && hgraph->GetCommunity(v) != hgraph->GetCommunity(nbr_v))) {
+        continue;
+      }
+      // check the vertex weight constraint
+      const FloatView nbr_v_weight
+          = vertex_cluster_id_vec[nbr_v] > -1
+                ? FloatView(vertex_weights_c[vertex_cluster_id_vec[nbr_v]])
+                : hgraph->GetVertexWeights(nbr_v);
+      // This line needs to be updated
+      if (hgraph->GetVertexWeights(v) + nbr_v_weight > thr_cluster_weight_) {
+        continue;  // cannot satisfy the vertex weight constraint
+      }
+      new_entry.accepted = true;
+      new_entry.score = he_score;
+    }
+  }  // finish traversing all the neighbors
+
+  const std::vector<NeighborScores::Entry*>& candidates
+      = neighbor_scores.GetAcceptedEntries();
+  // if there is no neighbor, map current vertex as a single-vertex cluster
+  if (candidates.empty()) {
+    return -1;
+  }
+  // update the score based on critical timing paths
+  // Here we do not need to traverse the entire paths
+  // we just need to check the neighbors of the path
+  // because if there is a path, the most important neighbors
+  // must have been counter when traversing hyperedges before
+  // We just consider the direct neighbors of the vertex
+  // i.e., left neighbor and right neighbor
+  // TODO: 20230409:
+  // Exploration that if we can further improve the results by considering
+  // more neighbors on timing-critical paths
+  // No idea yet.
+  if (hgraph->HasTiming() && hgraph->GetNumTimingPaths() > 0) {
+    for (const int p : hgraph->TimingPathsThrough(v)) {
+      const float path_timing_score
+          = evaluator_->GetPathTimingScore(p, hgraph);
+      // traverse the current path
+      auto path_range = hgraph->PathVertices(p);
+      for (auto iter = path_range.begin(); iter != path_range.end(); ++iter) {
+        const int vertex_id = *iter;
+        if (vertex_id != v) {
+          continue;  // we need to find the neighbors of v, so continue here
+        }
+        std::vector<int> neighbors;
+        if (iter != path_range.begin()) {
+          neighbors.push_back(*(iter - 1));  // left neighbor
+        }
+        if (iter + 1 != path_range.end()) {
+          neighbors.push_back(*(iter + 1));  // right neighbor
+        }
+        // add the score.
+        // If the neighbor not found by connectivity, which means the balance
+        // constraint cannot be statisfied
+        for (const auto& nbr_v : neighbors) {
+          NeighborScores::Entry* entry = neighbor_scores.Find(nbr_v);
+          if (entry != nullptr && entry->accepted == true) {
+            entry->score += path_timing_score;
+          }
+        }
+      }  // finish traversing current paths
+    }    // finish current nbr_v
+  }
+  // update the score based on physical location information
+  if (hgraph->HasPlacement()) {
+    for (NeighborScores::Entry* entry : candidates) {
+      entry->score += evaluator_->GetPlacementScore(v, entry->vertex, hgraph);
+    }
+  }
+  // find the best neighbor vertex
+  float best_score = -std::numeric_limits<float>::max();
+  int best_vertex = -1;
+  // the neighbors are checked in increasing order of vertex id
+  for (const NeighborScores::Entry* entry : candidates) {
+    const int u = entry->vertex;
+    if (entry->score > best_score) {
+      best_vertex = u;
+      best_score = entry->score;
+    } else if (entry->score == best_score && vertex_cluster_id_vec[u] == -1) {
+      best_vertex = u;
+    }
+  }
+
+  return best_vertex;
+}
+
 // handle group information
 // group fixed vertices based on each block
 // group vertices based on group_attr and hgraph->fixed_attr_
@@ -551,7 +806,7 @@ void Coarsener::ClusterBasedGroupInfo(
     vertex_cluster_id_vec.clear();
     vertex_cluster_id_vec.resize(hgraph->GetNumVertices());
     std::iota(vertex_cluster_id_vec.begin(), vertex_cluster_id_vec.end(), 0);
-    vertex_weights_c = hgraph->GetVertexWeights();
+    hgraph->CopyVertexWeights(vertex_weights_c);
     hgraph->CopyCommunity(community_attr_c);
     hgraph->CopyFixedAttr(fixed_attr_c);
     hgraph->CopyPlacement(placement_attr_c);
@@ -728,192 +983,221 @@ HGraphPtr Coarsener::Contraction(
     const Matrix<float>& placement_attr_c) const
 {
   // Step 1:  identify the contracted hyperedges
-  std::vector<int> hyperedge_cluster_id_vec;  // map the hyperedge to hyperedge
-                                              // in clustered hypergraph
-  hyperedge_cluster_id_vec.resize(hgraph->GetNumHyperedges());
-  // -1 means the hyperedge is fully within one cluster
-  std::fill(
-      hyperedge_cluster_id_vec.begin(), hyperedge_cluster_id_vec.end(), -1);
-  Matrix<int> hyperedges_c;  // represent each hyperedge as a set of clusters
-  Matrix<float> hyperedges_weights_c;  // each element represents the weight of
-                                       // the clustered hyperedge
+  // The vertices of each hyperedge are mapped to clusters in parallel.
+  // hyperedges_clusters[e] is empty if the hyperedge is ignored
+  const int num_hyperedges = hgraph->GetNumHyperedges();
+  Matrix<int> hyperedges_clusters(num_hyperedges);
+  std::vector<size_t> hyperedges_hash(num_hyperedges, 0);
+  ParallelForChunks(
+      thread_pool_.get(),
+      num_hyperedges,
+      parallel_workload_threshold_,
+      [&](int begin, int end) {
+        for (int e = begin; e < end; e++) {
+          const auto range = hgraph->Vertices(e);
+          const int he_size = range.size();
+          if (he_size <= 1 || he_size > thr_coarsen_hyperedge_size_skip_) {
+            continue;  // ignore the single-vertex hyperedge and large hyperedge
+          }
+          std::vector<int>& hyperedge_c = hyperedges_clusters[e];
+          hyperedge_c.reserve(he_size);
+          for (const int vertex_id : range) {
+            // cluster id
+            hyperedge_c.push_back(vertex_cluster_id_vec[vertex_id]);
+          }
+          std::sort(hyperedge_c.begin(), hyperedge_c.end());
+          hyperedge_c.erase(std::unique(hyperedge_c.begin(), hyperedge_c.end()),
+                            hyperedge_c.end());
+          if (hyperedge_c.size() <= 1) {
+            hyperedge_c.clear();  // ignore the single-vertex hyperedge
+            continue;
+          }
+          hyperedges_hash[e] = std::inner_product(hyperedge_c.begin(),
+                                                  hyperedge_c.end(),
+                                                  hyperedge_c.begin(),
+                                                  static_cast<size_t>(0));
+        }
+      });
+
+  // detect parallel hyperedges.
+  // Each group of parallel hyperedges becomes one clustered hyperedge
+  const Matrix<int> parallel_hyperedges
+      = GroupParallelItems(hyperedges_clusters, hyperedges_hash);
+  const int num_hyperedges_c = static_cast<int>(parallel_hyperedges.size());
+  std::vector<int> hyperedge_cluster_id_vec(
+      num_hyperedges, -1);  // map the hyperedge to hyperedge in clustered
+                            // hypergraph. -1 means the hyperedge is fully
+                            // within one cluster
+  // the clustered hyperedges are stored in compressed sparse row format
+  // directly, i.e., the clusters of hyperedge e are
+  // eind_c[eptr_c[e]], ..., eind_c[eptr_c[e + 1] - 1]
+  std::vector<CsrOffset> eptr_c(num_hyperedges_c + 1, 0);
+  for (int hyperedge_c_id = 0; hyperedge_c_id < num_hyperedges_c;
+       hyperedge_c_id++) {
+    const int first_e = parallel_hyperedges[hyperedge_c_id].front();
+    eptr_c[hyperedge_c_id + 1] = eptr_c[hyperedge_c_id]
+                                 + hyperedges_clusters[first_e].size();
+  }
+  std::vector<int> eind_c(eptr_c.back());
+  Matrix<float> hyperedges_weights_c(
+      num_hyperedges_c);  // each element represents the weight of the
+                          // clustered hyperedge
   std::vector<float> hyperedge_slack_c;  // the slack for clustered hyperedge.
-  std::vector<std::set<int>>
-      hyperedge_arc_set_c;  // map current hyperedge into arcs in timing graph.
-                            // We need this for propagation
-  std::map<size_t, int>
-      hash_map;  // store the hash value of each contracted hyperedge
-  std::map<size_t, std::vector<int>>
-      parallel_hash_map;  // store the hyperedges_c with the same hash_value
-                          // (candidate)
-  for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
-    const auto range = hgraph->Vertices(e);
-    const int he_size = range.size();
-    if (he_size <= 1 || he_size > thr_coarsen_hyperedge_size_skip_) {
-      continue;  // ignore the single-vertex hyperedge and large hyperedge
-    }
-    std::set<int> hyperedge_c;
-    for (const int vertex_id : range) {
-      hyperedge_c.insert(vertex_cluster_id_vec[vertex_id]);  // get cluster id
-    }
-    if (hyperedge_c.size() <= 1) {
-      continue;  // ignore the single-vertex hyperedge
-    }
-    size_t hash_value = std::inner_product(hyperedge_c.begin(),
-                                           hyperedge_c.end(),
-                                           hyperedge_c.begin(),
-                                           static_cast<size_t>(0));
-    // check if the hash value has been used
-    // for detecting parallel hyperedge
-    // hyperedge_slack_c[e] = min_slack(hyperedge_arc_set_c[e])
-    if (hash_map.find(hash_value) == hash_map.end()) {
-      const int hyperedge_c_id = static_cast<int>(hyperedges_c.size());
-      hyperedge_cluster_id_vec[e] = hyperedge_c_id;
-      hash_map[hash_value] = hyperedge_c_id;
-      hyperedges_c.push_back(
-          std::vector<int>(hyperedge_c.begin(), hyperedge_c.end()));
-      hyperedges_weights_c.push_back(hgraph->GetHyperedgeWeights(e));
-      if (hgraph->HasTiming()) {
-        hyperedge_slack_c.push_back(
-            hgraph->GetHyperedgeTimingAttr(e));  // the slack of hyperedge
-        hyperedge_arc_set_c.push_back(
-            hgraph->GetHyperedgeArcSet(e));  // map the hyperedge to timing arcs
+  // map current hyperedge into arcs in timing graph (compressed sparse row
+  // format). We need this for propagation. The arcs of the parallel
+  // hyperedges are first copied into the slots reserved for the clustered
+  // hyperedge, then sorted and deduplicated in place. num_arcs_c records the
+  // number of distinct arcs, and the slots are compacted afterwards
+  std::vector<CsrOffset> arc_ptr_c;
+  std::vector<int> arc_ind_c;
+  std::vector<int> num_arcs_c;
+  if (hgraph->HasTiming()) {
+    hyperedge_slack_c.resize(num_hyperedges_c);
+    num_arcs_c.resize(num_hyperedges_c, 0);
+    arc_ptr_c.resize(num_hyperedges_c + 1, 0);
+    for (int hyperedge_c_id = 0; hyperedge_c_id < num_hyperedges_c;
+         hyperedge_c_id++) {
+      CsrOffset num_arcs = 0;
+      for (const int e : parallel_hyperedges[hyperedge_c_id]) {
+        num_arcs += hgraph->GetHyperedgeArcSet(e).size();
       }
-      continue;
+      arc_ptr_c[hyperedge_c_id + 1] = arc_ptr_c[hyperedge_c_id] + num_arcs;
     }
-
-    // there may be parallel hyperedges
-    const int hash_hyperedge_c_id
-        = hash_map[hash_value];  // the hyperedge_c has been found
-    std::vector<int> hyperedge_vec(hyperedge_c.begin(), hyperedge_c.end());
-    // check the representative hyperedge_c
-    int parallel_hyperedge_c_id
-        = -1;  // the hyperedge_c_id of parallel hyperedge
-    // find the parallel_hyperedge_c_id
-    if (hyperedge_vec == hyperedges_c[hash_hyperedge_c_id]) {
-      // check the representative hyperedge_c
-      parallel_hyperedge_c_id = hash_hyperedge_c_id;
-    } else {
-      // check the parallel hyperedge_c_id
-      for (const auto& candidate_id : parallel_hash_map[hash_value]) {
-        if (hyperedge_vec == hyperedges_c[candidate_id]) {
-          parallel_hyperedge_c_id = candidate_id;
-          break;  // found the same hyperedge_c
+    arc_ind_c.resize(arc_ptr_c.back());
+  }
+  // merge the weights and slacks of parallel hyperedges.
+  // hyperedge_slack_c[e] = min_slack(arcs of e)
+  ParallelForChunks(
+      thread_pool_.get(),
+      num_hyperedges_c,
+      parallel_workload_threshold_,
+      [&](int begin, int end) {
+        for (int hyperedge_c_id = begin; hyperedge_c_id < end;
+             hyperedge_c_id++) {
+          const std::vector<int>& group = parallel_hyperedges[hyperedge_c_id];
+          const int first_e = group.front();
+          std::copy(hyperedges_clusters[first_e].begin(),
+                    hyperedges_clusters[first_e].end(),
+                    eind_c.begin() + eptr_c[hyperedge_c_id]);
+          std::vector<float>& weights = hyperedges_weights_c[hyperedge_c_id];
+          weights = ToVector(hgraph->GetHyperedgeWeights(first_e));
+          if (hgraph->HasTiming()) {
+            hyperedge_slack_c[hyperedge_c_id]
+                = hgraph->GetHyperedgeTimingAttr(first_e);
+            auto arc_iter = arc_ind_c.begin() + arc_ptr_c[hyperedge_c_id];
+            for (const int e : group) {
+              const auto arcs = hgraph->GetHyperedgeArcSet(e);
+              arc_iter = std::copy(arcs.begin(), arcs.end(), arc_iter);
+            }
+            const auto arc_begin
+                = arc_ind_c.begin() + arc_ptr_c[hyperedge_c_id];
+            std::sort(arc_begin, arc_iter);
+            num_arcs_c[hyperedge_c_id]
+                = std::distance(arc_begin, std::unique(arc_begin, arc_iter));
+          }
+          for (const int e : group) {
+            hyperedge_cluster_id_vec[e] = hyperedge_c_id;
+            if (e == first_e) {
+              continue;
+            }
+            Accumulate(weights, hgraph->GetHyperedgeWeights(e));
+            if (hgraph->HasTiming()) {
+              hyperedge_slack_c[hyperedge_c_id]
+                  = std::min(hyperedge_slack_c[hyperedge_c_id],
+                             hgraph->GetHyperedgeTimingAttr(e));
+            }
+          }
         }
-      }
-    }
-    // check if the hyperedge has been existed
-    if (parallel_hyperedge_c_id == -1) {
-      // not existed
-      const int hyperedge_c_id = static_cast<int>(hyperedges_c.size());
-      hyperedge_cluster_id_vec[e] = hyperedge_c_id;
-      parallel_hash_map[hash_value].push_back(hyperedge_c_id);
-      hyperedges_c.push_back(hyperedge_vec);
-      hyperedges_weights_c.push_back(hgraph->GetHyperedgeWeights(e));
-      if (hgraph->HasTiming()) {
-        hyperedge_slack_c.push_back(
-            hgraph->GetHyperedgeTimingAttr(e));  // the slack of hyperedge
-        hyperedge_arc_set_c.push_back(
-            hgraph->GetHyperedgeArcSet(e));  // map the hyperedge to timing arcs
-      }
-    } else {
-      // existed
-      hyperedges_weights_c[parallel_hyperedge_c_id]
-          = hyperedges_weights_c[parallel_hyperedge_c_id]
-            + hgraph->GetHyperedgeWeights(e);
-      hyperedge_cluster_id_vec[e] = parallel_hyperedge_c_id;
-      if (hgraph->HasTiming()) {
-        hyperedge_slack_c[parallel_hyperedge_c_id]
-            = std::min(hyperedge_slack_c[parallel_hyperedge_c_id],
-                       hgraph->GetHyperedgeTimingAttr(e));
-        hyperedge_arc_set_c[parallel_hyperedge_c_id].insert(
-            hgraph->GetHyperedgeArcSet(e).begin(),
-            hgraph->GetHyperedgeArcSet(e).end());
-      }
+      });
+
+  // compact the distinct arcs of each clustered hyperedge
+  if (hgraph->HasTiming()) {
+    CsrOffset num_arcs = 0;
+    for (int hyperedge_c_id = 0; hyperedge_c_id < num_hyperedges_c;
+         hyperedge_c_id++) {
+      const auto arc_begin = arc_ind_c.begin() + arc_ptr_c[hyperedge_c_id];
+      std::copy(arc_begin,
+                arc_begin + num_arcs_c[hyperedge_c_id],
+                arc_ind_c.begin() + num_arcs);
+      arc_ptr_c[hyperedge_c_id] = num_arcs;
+      num_arcs += num_arcs_c[hyperedge_c_id];
     }
+    arc_ptr_c.back() = num_arcs;
+    arc_ind_c.resize(num_arcs);
+    arc_ind_c.shrink_to_fit();
   }
 
+  // release the mapped hyperedges before building the timing paths
+  Matrix<int>().swap(hyperedges_clusters);
+
   // Step 2: identify all the timing paths
   std::vector<TimingPath> timing_paths_c;
-  hash_map.clear();           // used to detect parallel timing path
-  parallel_hash_map.clear();  // used to detect parallel timing path
   if (hgraph->HasTiming() && hgraph->GetNumTimingPaths() > 0) {
-    for (int p = 0; p < hgraph->GetNumTimingPaths(); ++p) {
-      // check vertex representation
-      auto path_range = hgraph->PathVertices(p);
-      const int path_size_original = path_range.size();
-
-      if (path_size_original <= 1) {
-        continue;  // ignore single-vertex path
-      }
-      std::vector<int> path_c;  // create path_c
-      for (const int vertex_id : path_range) {
-        const int cluster_id = vertex_cluster_id_vec[vertex_id];
-        if (path_c.empty() == true || path_c.back() != cluster_id) {
-          path_c.push_back(cluster_id);
-        }
-      }
-      if (path_c.size() <= 1) {
-        continue;  // ignore single-vertex path
-      }
-      const size_t hash_value = std::inner_product(
-          path_c.begin(), path_c.end(), path_c.begin(), static_cast<size_t>(0));
-      if (hash_map.find(hash_value) == hash_map.end()) {
-        // the path does not exists
-        // check hyperedge representation
-        std::vector<int> arcs_c;
-        for (const int edge : hgraph->PathEdges(p)) {
-          const int hyperedge_c_id = hyperedge_cluster_id_vec[edge];
-          // if hyperedge_c_id is -1, that means that hyperedge has been merged
-          // during coarsening
-          if ((hyperedge_c_id > -1)
-              && (arcs_c.empty() == true || arcs_c.back() != hyperedge_c_id)) {
-            arcs_c.push_back(hyperedge_c_id);
-          }
-        }
-        hash_map[hash_value] = static_cast<int>(timing_paths_c.size());
-        TimingPath timing_path_c(path_c, arcs_c, hgraph->PathTimingSlack(p));
-        timing_paths_c.push_back(timing_path_c);
-      } else {
-        const int timing_path_c_id = hash_map[hash_value];
-        int parallel_timing_path_c_id
-            = -1;  // the timing_path_id of parallel timing path
-        if (path_c == timing_paths_c[timing_path_c_id].path) {
-          // check the representative timing path
-          parallel_timing_path_c_id = timing_path_c_id;
-        } else {
-          // check the parallel timing paths
-          for (const auto& candidate_id : parallel_hash_map[hash_value]) {
-            if (path_c == timing_paths_c[candidate_id].path) {
-              parallel_timing_path_c_id = candidate_id;
-              break;  // found the same timing path
+    // check vertex representation
+    const int num_paths = hgraph->GetNumTimingPaths();
+    Matrix<int> paths_clusters(num_paths);
+    std::vector<size_t> paths_hash(num_paths, 0);
+    ParallelForChunks(
+        thread_pool_.get(),
+        num_paths,
+        parallel_workload_threshold_,
+        [&](int begin, int end) {
+          for (int p = begin; p < end; p++) {
+            const auto path_range = hgraph->PathVertices(p);
+            if (path_range.size() <= 1) {
+              continue;  // ignore single-vertex path
+            }
+            std::vector<int>& path_c = paths_clusters[p];
+            for (const int vertex_id : path_range) {
+              const int cluster_id = vertex_cluster_id_vec[vertex_id];
+              if (path_c.empty() == true || path_c.back() != cluster_id) {
+                path_c.push_back(cluster_id);
+              }
             }
+            if (path_c.size() <= 1) {
+              path_c.clear();  // ignore single-vertex path
+              continue;
+            }
+            paths_hash[p] = std::inner_product(path_c.begin(),
+                                               path_c.end(),
+                                               path_c.begin(),
+                                               static_cast<size_t>(0));
           }
-        }
-        // check if the timing path has been existed
-        if (parallel_timing_path_c_id == -1) {
-          // not existed
-          std::vector<int> arcs_c;
-          for (const int edge : hgraph->PathEdges(p)) {
-            const int hyperedge_c_id = hyperedge_cluster_id_vec[edge];
-            if ((hyperedge_c_id > -1)
-                && (arcs_c.empty() == true
-                    || arcs_c.back() != hyperedge_c_id)) {
-              arcs_c.push_back(hyperedge_c_id);
+        });
+
+    // detect parallel timing paths
+    const Matrix<int> parallel_paths
+        = GroupParallelItems(paths_clusters, paths_hash);
+    const int num_paths_c = static_cast<int>(parallel_paths.size());
+    timing_paths_c.resize(num_paths_c);
+    ParallelForChunks(
+        thread_pool_.get(),
+        num_paths_c,
+        parallel_workload_threshold_,
+        [&](int begin, int end) {
+          for (int path_c_id = begin; path_c_id < end; path_c_id++) {
+            const std::vector<int>& group = parallel_paths[path_c_id];
+            const int first_p = group.front();
+            TimingPath& timing_path_c = timing_paths_c[path_c_id];
+            timing_path_c.path = std::move(paths_clusters[first_p]);
+            // check hyperedge representation
+            for (const int edge : hgraph->PathEdges(first_p)) {
+              const int hyperedge_c_id = hyperedge_cluster_id_vec[edge];
+              // if hyperedge_c_id is -1, that means that hyperedge has been
+              // merged during coarsening
+              if ((hyperedge_c_id > -1)
+                  && (timing_path_c.arcs.empty() == true
+                      || timing_path_c.arcs.back() != hyperedge_c_id)) {
+                timing_path_c.arcs.push_back(hyperedge_c_id);
+              }
+            }
+            timing_path_c.slack = hgraph->PathTimingSlack(first_p);
+            for (const int p : group) {
+              timing_path_c.slack
+                  = std::min(timing_path_c.slack, hgraph->PathTimingSlack(p));
             }
           }
-          parallel_hash_map[hash_value].push_back(
-              static_cast<int>(timing_paths_c.size()));
-          timing_paths_c.emplace_back(
-              path_c, arcs_c, hgraph->PathTimingSlack(p));
-        } else {
-          // existed
-          timing_paths_c[parallel_timing_path_c_id].slack
-              = std::min(timing_paths_c[parallel_timing_path_c_id].slack,
-                         hgraph->PathTimingSlack(p));
-        }
-      }
-    }
+        });
   }
 
   // create vertex_type for clustered hypergraph
@@ -927,7 +1211,8 @@ HGraphPtr Coarsener::Contraction(
       = std::make_shared<Hypergraph>(hgraph->GetVertexDimensions(),
                                      hgraph->GetHyperedgeDimensions(),
                                      hgraph->GetPlacementDimensions(),
-                                     hyperedges_c,
+                                     std::move(eptr_c),
+                                     std::move(eind_c),
                                      vertex_weights_c,
                                      hyperedges_weights_c,
                                      // vertex attributes
@@ -937,21 +1222,82 @@ HGraphPtr Coarsener::Contraction(
                                      vertex_types_c,
                                      // timing information
                                      hyperedge_slack_c,
-                                     hyperedge_arc_set_c,
+                                     std::move(arc_ptr_c),
+                                     std::move(arc_ind_c),
                                      timing_paths_c,
                                      logger_);
 
-  // fill vertex_c_attr which maps the vertex to its corresponding cluster
-  // To simpify the implementation, the vertex_c_attr maps the original larger
-  // hypergraph
-  clustered_hgraph->ResetVertexCAttr();
-  for (int v = 0; v < hgraph->GetNumVertices(); v++) {
-    clustered_hgraph->AddVertexCAttr(vertex_cluster_id_vec[v], v);
-  }
+  // map the vertices of hgraph to their clusters
+  clustered_hgraph->SetVertexCParent(vertex_cluster_id_vec);
 
   return clustered_hgraph;
 }
 
+// The items (hyperedges or timing paths) with the same list of clusters
+// are parallel. The items are distributed into shards based on their
+// fingerprints (hash values), so parallel items always fall into the same
+// shard. Then the shards are processed concurrently without any lock.
+// Each group lists the parallel items in increasing order, and the groups
+// are sorted by their first item. This is the same order as detecting the
+// parallel items with a serial traversal.
+Matrix<int> Coarsener::GroupParallelItems(
+    const Matrix<int>& items,
+    const std::vector<size_t>& hashes) const
+{
+  const int num_items = static_cast<int>(items.size());
+  const int num_shards = GetNumParallelTasks(num_items);
+  Matrix<int> shards(num_shards);
+  for (int i = 0; i < num_items; i++) {
+    if (items[i].empty() == false) {
+      shards[hashes[i] % num_shards].push_back(i);
+    }
+  }
+  // the first item with the same list of clusters
+  std::vector<int> representatives(num_items, -1);
+  // each shard is processed by a single task
+  ParallelForChunks(
+      thread_pool_.get(), num_shards, 2, [&](int begin, int end) {
+        for (int shard_id = begin; shard_id < end; shard_id++) {
+          // store the representative items with the same hash value
+          std::unordered_map<size_t, std::vector<int>> hash_map;
+          for (const int i : shards[shard_id]) {
+            std::vector<int>& candidates = hash_map[hashes[i]];
+            for (const int candidate_id : candidates) {
+              if (items[candidate_id] == items[i]) {
+                representatives[i] = candidate_id;
+                break;  // found the same item
+              }
+            }
+            if (representatives[i] == -1) {
+              representatives[i] = i;
+              candidates.push_back(i);
+            }
+          }
+        }
+      });
+
+  Matrix<int> groups;
+  std::vector<int> group_id(num_items, -1);
+  for (int i = 0; i < num_items; i++) {
+    if (representatives[i] == i) {
+      group_id[i] = static_cast<int>(groups.size());
+      groups.push_back({i});
+    } else if (representatives[i] > -1) {
+      groups[group_id[representatives[i]]].push_back(i);
+    }
+  }
+  return groups;
+}
+
+// Only use the thread pool for large workloads
+int Coarsener::GetNumParallelTasks(int num_items) const
+{
+  if (thread_pool_ == nullptr || num_items < parallel_workload_threshold_) {
+    return 1;
+  }
+  return std::max(1, thread_pool_->GetNumThreads()) * 4;
+}
+
 // Utility functions
 std::string ToString(const CoarsenOrder order)
 {
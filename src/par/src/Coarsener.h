@@ -40,8 +40,12 @@
 // It will accept a HGraphPtr (std::shared_ptr<Hypergraph>) as input
 // and return a sequence of coarser hypergraphs
 
+#include <functional>
+
 #include "Evaluator.h"
 #include "Hypergraph.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
 #include "utl/Logger.h"
 
 namespace par {
@@ -65,6 +69,42 @@ enum class CoarsenOrder
 // function : convert CoarsenOrder to string
 std::string ToString(CoarsenOrder order);
 
+// The scores of the neighbors of one vertex during vertex matching, stored
+// in an open-addressing hash table keyed by the neighbor.  The table is
+// reused for all the vertices matched by one thread, and Reset() only
+// clears the slots touched since the last reset, so scoring a vertex does
+// not allocate memory once the table is large enough.
+class NeighborScores
+{
+ public:
+  struct Entry
+  {
+    int vertex = -1;        // -1 means an empty slot
+    float score = 0.0;      // the accumulated score of vertex
+    bool accepted = false;  // false if vertex cannot be clustered with v
+  };
+
+  // Clear the table, with room for at least max_neighbors neighbors
+  void Reset(int max_neighbors);
+
+  // Return the entry of u, nullptr if u has not been inserted
+  Entry* Find(int u);
+
+  // Insert u (not in the table) and return its entry
+  Entry& Insert(int u);
+
+  // The accepted neighbors in increasing order of vertex id
+  const std::vector<Entry*>& GetAcceptedEntries();
+
+ private:
+  int GetSlot(int u) const;
+
+  std::vector<Entry> slots_;
+  std::vector<int> used_slots_;
+  std::vector<Entry*> accepted_entries_;
+  unsigned mask_ = 0;  // the number of slots - 1 (a power of two)
+};
+
 // coarsening class
 // during coarsening, all the coarser hypergraph will not have vertex type
 // Because the timing information will become messy in the coarser hypergraph
@@ -125,6 +165,35 @@ class Coarsener
 
   void IncreaseRandomSeed() { random_seed_++; }
 
+  void SetRandomSeed(int random_seed) { random_seed_ = random_seed; }
+
+  int GetRandomSeed() const { return random_seed_; }
+
+  // Set the order of vertices to visit during matching
+  void SetVertexOrderChoice(CoarsenOrder vertex_order_choice)
+  {
+    vertex_order_choice_ = vertex_order_choice;
+  }
+
+  CoarsenOrder GetVertexOrderChoice() const { return vertex_order_choice_; }
+
+  // Match the vertices with the deterministic parallel matching
+  void SetParallelMatching(bool parallel_matching)
+  {
+    parallel_matching_ = parallel_matching;
+  }
+
+  // The thread pool is used to match the vertices and contract
+  // large hypergraphs.
+  // If no thread pool is set, the contraction is sequential.
+  void SetThreadPool(ThreadPoolPtr thread_pool)
+  {
+    thread_pool_ = std::move(thread_pool);
+  }
+
+  // The runtime and the memory of each coarsening are added to the profiler
+  void SetProfiler(ProfilerPtr profiler) { profiler_ = std::move(profiler); }
+
  private:
   // private functions (utilities)
 
@@ -149,6 +218,33 @@ class Coarsener
       std::vector<int>& fixed_attr_c,
       Matrix<float>& placement_attr_c) const;
 
+  // Parallel version of VertexMatching.
+  // unvisited is the ordered list of vertices to be clustered,
+  // and cluster_id is the number of clusters formed by fixed vertices
+  void ParallelVertexMatching(
+      const HGraphPtr& hgraph,
+      const std::vector<float>& norm_edge_scores,
+      const std::vector<int>& unvisited,
+      int cluster_id,
+      std::vector<int>&
+          vertex_cluster_id_vec,  // map current vertex_id to cluster_id
+      // the remaining arguments are related to clusters
+      Matrix<float>& vertex_weights_c,
+      std::vector<int>& community_attr_c,
+      std::vector<int>& fixed_attr_c,
+      Matrix<float>& placement_attr_c) const;
+
+  // find the best neighbor to cluster for vertex v (-1 if none)
+  // norm_edge_scores are the normalized scores of the hyperedges
+  // (see GoldenEvaluator::GetNormEdgeScores)
+  // neighbor_scores is the scratch table of the calling thread
+  int FindBestNeighbor(const HGraphPtr& hgraph,
+                       int v,
+                       const std::vector<float>& norm_edge_scores,
+                       const std::vector<int>& vertex_cluster_id_vec,
+                       const Matrix<float>& vertex_weights_c,
+                       NeighborScores& neighbor_scores) const;
+
   // order the vertices based on user-specified parameters
   void OrderVertices(const HGraphPtr& hgraph, std::vector<int>& vertices) const;
 
@@ -181,6 +277,16 @@ class Coarsener
       const std::vector<int>& fixed_attr_c,
       const Matrix<float>& placement_attr_c) const;
 
+  // Group the parallel items (hyperedges or timing paths).
+  // items[i] is the list of clusters of item i (empty means ignored),
+  // and hashes[i] is the hash value of items[i].
+  // Each group contains the items with the same list of clusters.
+  Matrix<int> GroupParallelItems(const Matrix<int>& items,
+                                 const std::vector<size_t>& hashes) const;
+
+  // the number of tasks for processing num_items items in parallel
+  int GetNumParallelTasks(int num_items) const;
+
   const int num_parts_ = 2;
   // coarsening related parameters (stop conditions)
 
@@ -213,6 +319,16 @@ class Coarsener
   CoarsenOrder vertex_order_choice_ = CoarsenOrder::RANDOM;
   EvaluatorPtr evaluator_ = nullptr;
   utl::Logger* logger_ = nullptr;
+
+  // Use the parallel vertex matching
+  bool parallel_matching_ = false;
+  // the maximum number of proposal rounds in parallel vertex matching
+  const int max_matching_rounds_ = 4;
+
+  // the minimum number of items for running the contraction in parallel
+  const int parallel_workload_threshold_ = 4096;
+  ThreadPoolPtr thread_pool_ = nullptr;
+  ProfilerPtr profiler_ = nullptr;
 };
 
 }  // namespace par
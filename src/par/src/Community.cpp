@@ -0,0 +1,336 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include "Community.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <utility>
+
+#include "ThreadPool.h"
+#include "utl/Logger.h"
+
+namespace par {
+
+namespace {
+
+const int kParallelWorkloadThreshold = 4096;
+
+// Sort the (id, weight) pairs and merge the pairs with the same id
+void MergeNeighbors(std::vector<std::pair<int, double>>& neighbors)
+{
+  if (neighbors.empty()) {
+    return;
+  }
+  std::sort(neighbors.begin(), neighbors.end());
+  size_t num_unique = 0;
+  for (size_t i = 1; i < neighbors.size(); i++) {
+    if (neighbors[i].first == neighbors[num_unique].first) {
+      neighbors[num_unique].second += neighbors[i].second;
+    } else {
+      neighbors[++num_unique] = neighbors[i];
+    }
+  }
+  neighbors.resize(num_unique + 1);
+}
+
+// Build a graph from the (merged) neighbors of each node
+WeightedGraph BuildGraph(
+    std::vector<std::vector<std::pair<int, double>>>& neighbors)
+{
+  WeightedGraph graph;
+  const int num_nodes = static_cast<int>(neighbors.size());
+  graph.ptr.resize(num_nodes + 1, 0);
+  for (int node = 0; node < num_nodes; node++) {
+    graph.ptr[node + 1] = graph.ptr[node] + neighbors[node].size();
+  }
+  graph.adj.reserve(graph.ptr.back());
+  graph.wt.reserve(graph.ptr.back());
+  graph.volume.resize(num_nodes, 0.0);
+  for (int node = 0; node < num_nodes; node++) {
+    for (const auto& [neighbor, weight] : neighbors[node]) {
+      graph.adj.push_back(neighbor);
+      graph.wt.push_back(weight);
+      graph.volume[node] += weight;
+    }
+    // release the memory as soon as possible
+    std::vector<std::pair<int, double>>().swap(neighbors[node]);
+  }
+  return graph;
+}
+
+}  // namespace
+
+WeightedGraph BuildCliqueGraph(const HGraphPtr& hgraph,
+                               const std::vector<float>& edge_weights,
+                               const int max_hyperedge_size,
+                               ThreadPool* thread_pool)
+{
+  const int num_vertices = hgraph->GetNumVertices();
+  std::vector<std::vector<std::pair<int, double>>> neighbors(num_vertices);
+  ParallelForChunks(
+      thread_pool,
+      num_vertices,
+      kParallelWorkloadThreshold,
+      [&](int begin, int end) {
+        for (int v = begin; v < end; v++) {
+          for (const int e : hgraph->Edges(v)) {
+            const auto range = hgraph->Vertices(e);
+            const int he_size = static_cast<int>(range.size());
+            if (he_size <= 1 || he_size > max_hyperedge_size
+                || edge_weights[e] <= 0.0) {
+              continue;
+            }
+            for (const int u : range) {
+              if (u != v) {
+                neighbors[v].emplace_back(u, edge_weights[e]);
+              }
+            }
+          }
+          MergeNeighbors(neighbors[v]);
+        }
+      });
+  return BuildGraph(neighbors);
+}
+
+CommunityDetector::CommunityDetector(const int max_hyperedge_size,
+                                     const int max_num_levels,
+                                     const int max_num_passes,
+                                     ThreadPool* thread_pool,
+                                     utl::Logger* logger)
+    : max_hyperedge_size_(max_hyperedge_size),
+      max_num_levels_(max_num_levels),
+      max_num_passes_(max_num_passes),
+      thread_pool_(thread_pool),
+      logger_(logger)
+{
+}
+
+std::vector<int> CommunityDetector::Detect(
+    const HGraphPtr& hgraph,
+    const std::vector<float>& edge_weights) const
+{
+  std::vector<WeightedGraph> graphs;
+  Matrix<int> communities;
+  BuildHierarchy(hgraph, edge_weights, graphs, communities);
+  // each vertex is a community at the beginning
+  std::vector<int> vertex_community(hgraph->GetNumVertices());
+  std::iota(vertex_community.begin(), vertex_community.end(), 0);
+  for (const std::vector<int>& community : communities) {
+    for (int& c : vertex_community) {
+      c = community[c];
+    }
+  }
+  return vertex_community;
+}
+
+void CommunityDetector::BuildHierarchy(const HGraphPtr& hgraph,
+                                       const std::vector<float>& edge_weights,
+                                       std::vector<WeightedGraph>& graphs,
+                                       Matrix<int>& communities) const
+{
+  graphs.clear();
+  communities.clear();
+  graphs.push_back(BuildCliqueGraph(
+      hgraph, edge_weights, max_hyperedge_size_, thread_pool_));
+  for (int level = 0; level < max_num_levels_; level++) {
+    const WeightedGraph& graph = graphs.back();
+    std::vector<int> community(graph.GetNumNodes());
+    std::iota(community.begin(), community.end(), 0);
+    const int num_moves = LocalMoving(graph, community);
+    if (num_moves == 0) {
+      break;  // the communities cannot be improved any more
+    }
+    // renumber the communities in the order of their first node
+    std::vector<int> community_id(graph.GetNumNodes(), -1);
+    int num_communities = 0;
+    for (int& c : community) {
+      if (community_id[c] == -1) {
+        community_id[c] = num_communities++;
+      }
+      c = community_id[c];
+    }
+    logger_->report(
+        "[COMMUNITY] Level {} :: num_nodes = {}, num_moves = {}, "
+        "num_communities = {}",
+        level,
+        graph.GetNumNodes(),
+        num_moves,
+        num_communities);
+    WeightedGraph coarse_graph = Contract(graph, community, num_communities);
+    communities.push_back(std::move(community));
+    graphs.push_back(std::move(coarse_graph));
+  }
+}
+
+int CommunityDetector::LocalMoving(const WeightedGraph& graph,
+                                   std::vector<int>& community) const
+{
+  const int num_nodes = graph.GetNumNodes();
+  const double total_volume
+      = std::accumulate(graph.volume.begin(), graph.volume.end(), 0.0);
+  if (num_nodes == 0 || total_volume <= 0.0) {
+    return 0;
+  }
+  std::vector<double> community_volume = graph.volume;
+  std::vector<int> community_size(num_nodes, 1);
+  // the nodes are visited in a random order (with a fixed seed)
+  std::vector<int> order(num_nodes);
+  std::iota(order.begin(), order.end(), 0);
+  std::mt19937 gen(0);
+  std::shuffle(order.begin(), order.end(), gen);
+
+  // Return the neighboring community of node with the largest modularity
+  // gain, based on the committed communities
+  auto lambda_best_community
+      = [&](int node, std::vector<std::pair<int, double>>& weights) {
+          weights.clear();
+          for (int64_t k = graph.ptr[node]; k < graph.ptr[node + 1]; k++) {
+            if (graph.adj[k] != node) {
+              weights.emplace_back(community[graph.adj[k]], graph.wt[k]);
+            }
+          }
+          MergeNeighbors(weights);
+          const int from = community[node];
+          const double node_volume = graph.volume[node];
+          double best_gain
+              = -node_volume * (community_volume[from] - node_volume)
+                / total_volume;
+          for (const auto& [c, weight] : weights) {
+            if (c == from) {
+              best_gain += weight;
+              break;
+            }
+          }
+          int best_community = from;
+          for (const auto& [c, weight] : weights) {
+            // two singletons moving into each other at the same time
+            // would only swap their communities
+            if (c == from
+                || (community_size[from] == 1 && community_size[c] == 1
+                    && c > from)) {
+              continue;
+            }
+            const double gain
+                = weight - node_volume * community_volume[c] / total_volume;
+            if (gain > best_gain) {
+              best_gain = gain;
+              best_community = c;
+            }
+          }
+          return best_community;
+        };
+
+  const int num_sub_rounds = std::min(num_sub_rounds_, num_nodes);
+  std::vector<int> target(num_nodes);
+  int total_moves = 0;
+  for (int pass = 0; pass < max_num_passes_; pass++) {
+    int num_moves = 0;
+    for (int round = 0; round < num_sub_rounds; round++) {
+      const int round_begin
+          = static_cast<int>(int64_t{num_nodes} * round / num_sub_rounds);
+      const int round_end
+          = static_cast<int>(int64_t{num_nodes} * (round + 1) / num_sub_rounds);
+      ParallelForChunks(
+          thread_pool_,
+          round_end - round_begin,
+          kParallelWorkloadThreshold,
+          [&](int begin, int end) {
+            std::vector<std::pair<int, double>> weights;
+            for (int i = round_begin + begin; i < round_begin + end; i++) {
+              target[order[i]] = lambda_best_community(order[i], weights);
+            }
+          });
+      // commit the moves
+      for (int i = round_begin; i < round_end; i++) {
+        const int node = order[i];
+        const int from = community[node];
+        const int to = target[node];
+        if (from == to) {
+          continue;
+        }
+        community_volume[from] -= graph.volume[node];
+        community_volume[to] += graph.volume[node];
+        community_size[from]--;
+        community_size[to]++;
+        community[node] = to;
+        num_moves++;
+      }
+    }
+    total_moves += num_moves;
+    if (num_moves == 0) {
+      break;
+    }
+  }
+  return total_moves;
+}
+
+WeightedGraph CommunityDetector::Contract(
+    const WeightedGraph& graph,
+    const std::vector<int>& community,
+    const int num_communities) const
+{
+  // the nodes of each community
+  std::vector<int> member_ptr(num_communities + 1, 0);
+  for (const int c : community) {
+    member_ptr[c + 1]++;
+  }
+  std::partial_sum(member_ptr.begin(), member_ptr.end(), member_ptr.begin());
+  std::vector<int> members(graph.GetNumNodes());
+  std::vector<int> cursor(member_ptr.begin(), member_ptr.end() - 1);
+  for (int node = 0; node < graph.GetNumNodes(); node++) {
+    members[cursor[community[node]]++] = node;
+  }
+
+  std::vector<std::vector<std::pair<int, double>>> neighbors(num_communities);
+  ParallelForChunks(
+      thread_pool_,
+      num_communities,
+      kParallelWorkloadThreshold,
+      [&](int begin, int end) {
+        for (int c = begin; c < end; c++) {
+          for (int i = member_ptr[c]; i < member_ptr[c + 1]; i++) {
+            const int node = members[i];
+            for (int64_t k = graph.ptr[node]; k < graph.ptr[node + 1]; k++) {
+              // the internal edges of the community become a self loop
+              neighbors[c].emplace_back(community[graph.adj[k]], graph.wt[k]);
+            }
+          }
+          MergeNeighbors(neighbors[c]);
+        }
+      });
+  return BuildGraph(neighbors);
+}
+
+}  // namespace par
@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+// High-level description
+// Built-in community detection, used to generate the community attributes
+// of the vertices when no community file is given.
+// The hypergraph is converted to a weighted graph by the clique expansion of
+// the hyperedges up to max_hyperedge_size vertices (the larger hyperedges
+// are ignored, like in the coarsening).  The communities are detected by
+// the Louvain method.  In each level the vertices are moved to the
+// neighboring community with the largest modularity gain, then the
+// communities are contracted into the nodes of the next level.
+// The moves are evaluated in parallel in sub-rounds and committed serially,
+// so the communities do not depend on the number of threads.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Hypergraph.h"
+
+namespace utl {
+class Logger;
+}
+
+namespace par {
+
+class ThreadPool;
+
+// The weighted graph in compressed sparse row format.
+// A contracted node keeps the internal weight of its community as a
+// self loop
+struct WeightedGraph
+{
+  std::vector<int64_t> ptr;
+  std::vector<int> adj;
+  std::vector<double> wt;
+  std::vector<double> volume;  // the weighted degree of each node
+  int GetNumNodes() const { return static_cast<int>(volume.size()); }
+};
+
+// Build the clique expansion of the hyperedges of hgraph with at most
+// max_hyperedge_size vertices.  edge_weights[e] is the weight of each edge
+// in the clique of hyperedge e.  thread_pool can be nullptr (serial)
+WeightedGraph BuildCliqueGraph(const HGraphPtr& hgraph,
+                               const std::vector<float>& edge_weights,
+                               int max_hyperedge_size,
+                               ThreadPool* thread_pool);
+
+class CommunityDetector
+{
+ public:
+  // thread_pool can be nullptr (serial)
+  CommunityDetector(int max_hyperedge_size,
+                    int max_num_levels,
+                    int max_num_passes,
+                    ThreadPool* thread_pool,
+                    utl::Logger* logger);
+
+  // Return the community id of each vertex of hgraph.
+  // edge_weights[e] is the weight of each edge in the clique expansion of
+  // hyperedge e (e.g., GetNormEdgeScores of the evaluator)
+  std::vector<int> Detect(const HGraphPtr& hgraph,
+                          const std::vector<float>& edge_weights) const;
+
+  // The levels of the Louvain method.  graphs[0] is the clique expansion of
+  // hgraph, graphs[i + 1] is graphs[i] with the communities[i][v] of each
+  // node v contracted.  The hierarchy is also used by the spectral embedding
+  void BuildHierarchy(const HGraphPtr& hgraph,
+                      const std::vector<float>& edge_weights,
+                      std::vector<WeightedGraph>& graphs,
+                      Matrix<int>& communities) const;
+
+ private:
+  // Move the nodes between the communities greedily.
+  // Return the number of moves
+  int LocalMoving(const WeightedGraph& graph,
+                  std::vector<int>& community) const;
+
+  // Contract each community into a node
+  WeightedGraph Contract(const WeightedGraph& graph,
+                         const std::vector<int>& community,
+                         int num_communities) const;
+
+  const int max_hyperedge_size_ = 50;
+  const int max_num_levels_ = 16;
+  const int max_num_passes_ = 10;
+  // the moves of each pass are evaluated in num_sub_rounds_ sub-rounds
+  // against the communities committed by the previous sub-rounds
+  const int num_sub_rounds_ = 16;
+  ThreadPool* thread_pool_ = nullptr;
+  utl::Logger* logger_ = nullptr;
+};
+
+}  // namespace par
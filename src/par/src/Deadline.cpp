@@ -0,0 +1,138 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include "Deadline.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "utl/Logger.h"
+
+namespace par {
+
+using utl::PAR;
+
+Deadline::Deadline(const float time_limit)
+    : has_limit_(time_limit > 0.0),
+      time_limit_(std::max(time_limit, 0.0f)),
+      start_(Clock::now()),
+      end_(start_
+           + std::chrono::duration_cast<Clock::duration>(
+               std::chrono::duration<double>(time_limit_)))
+{
+}
+
+bool Deadline::IsExpired() const
+{
+  return cancelled_ || (has_limit_ && Clock::now() >= end_);
+}
+
+double Deadline::GetRemainingTime() const
+{
+  if (cancelled_) {
+    return 0.0;
+  }
+  if (has_limit_ == false) {
+    return std::numeric_limits<double>::max();
+  }
+  return std::max(
+      std::chrono::duration<double>(end_ - Clock::now()).count(), 0.0);
+}
+
+float Deadline::CapTimeLimit(const float time_limit) const
+{
+  if (has_limit_ == false && cancelled_ == false) {
+    return time_limit;
+  }
+  // a positive limit, such that the solver does not treat it as no limit
+  const float remaining_time
+      = std::max(static_cast<float>(GetRemainingTime()), 1e-3f);
+  return time_limit > 0.0 ? std::min(time_limit, remaining_time)
+                          : remaining_time;
+}
+
+Deadline::Clock::time_point Deadline::StartPhase(const float fraction) const
+{
+  if (has_limit_ == false) {
+    return Clock::time_point::max();
+  }
+  const Clock::time_point now = Clock::now();
+  if (now >= end_) {
+    return end_;
+  }
+  return now
+         + std::chrono::duration_cast<Clock::duration>(
+             (end_ - now) * std::clamp(fraction, 0.0f, 1.0f));
+}
+
+bool Deadline::IsExpired(const Clock::time_point phase_end) const
+{
+  return IsExpired() || (has_limit_ && Clock::now() >= phase_end);
+}
+
+void Deadline::AddShortenedPhase(const std::string& phase)
+{
+  std::lock_guard<std::mutex> lock(shortened_phases_mutex_);
+  shortened_phases_[phase]++;
+}
+
+void Deadline::Report(utl::Logger* logger) const
+{
+  if (has_limit_ == false && cancelled_ == false) {
+    return;
+  }
+  const double runtime
+      = std::chrono::duration<double>(Clock::now() - start_).count();
+  if (cancelled_) {
+    logger->info(
+        PAR, 223, "Partitioning is cancelled after {:.2f} seconds", runtime);
+  } else {
+    logger->info(PAR,
+                 224,
+                 "Time limit : {} seconds, runtime : {:.2f} seconds",
+                 time_limit_,
+                 runtime);
+  }
+  std::lock_guard<std::mutex> lock(shortened_phases_mutex_);
+  if (shortened_phases_.empty()) {
+    logger->info(
+        PAR, 225, "All the phases are completed within the time limit");
+    return;
+  }
+  for (const auto& [phase, num_times] : shortened_phases_) {
+    logger->info(
+        PAR, 226, "Shortened phase : {} ({} times)", phase, num_times);
+  }
+}
+
+}  // namespace par
@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+// High-level description
+// The global time budget of TritonPart.
+// The multi-level partitioner splits the remaining time between its phases
+// (candidate generation, v-cycles, ...) and stops starting new work when
+// the budget of a phase is used up.  The refiners and the ILP solver check
+// the global deadline cooperatively, so the best solution found so far is
+// returned soon after the time limit.  The deadline is shared by all the
+// threads, so the cancellation flag and the counters are atomic.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace utl {
+class Logger;
+}
+
+namespace par {
+
+class Deadline;
+using DeadlinePtr = std::shared_ptr<Deadline>;
+
+class Deadline
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // time_limit is the wall-clock budget in seconds
+  // (time_limit <= 0 means no limit)
+  explicit Deadline(float time_limit);
+
+  bool HasLimit() const { return has_limit_; }
+
+  // Return true if the time budget is used up or the run is cancelled
+  bool IsExpired() const;
+
+  // Stop all the phases as soon as possible
+  void Cancel() { cancelled_ = true; }
+
+  // The remaining time in seconds (0 if the deadline is expired)
+  double GetRemainingTime() const;
+
+  // Cap the time limit of a solver call (time_limit <= 0 means no limit)
+  // by the remaining time
+  float CapTimeLimit(float time_limit) const;
+
+  // A phase starting now may use fraction of the remaining time, so the
+  // time saved by the earlier phases is given to the later ones.
+  // Return the end of the phase
+  Clock::time_point StartPhase(float fraction) const;
+
+  // Return true if the phase ending at phase_end is out of time
+  bool IsExpired(Clock::time_point phase_end) const;
+
+  // The phase stopped before completing all its work
+  void AddShortenedPhase(const std::string& phase);
+
+  // Report the runtime against the time limit and the shortened phases
+  void Report(utl::Logger* logger) const;
+
+ private:
+  const bool has_limit_ = false;
+  const float time_limit_ = 0.0;  // seconds
+  const Clock::time_point start_;
+  const Clock::time_point end_;
+  std::atomic<bool> cancelled_ = false;
+
+  // the number of times each phase is shortened
+  mutable std::mutex shortened_phases_mutex_;
+  std::map<std::string, int> shortened_phases_;
+};
+
+// Nothing is shortened if the deadline is nullptr
+inline bool IsTimeUp(const DeadlinePtr& deadline)
+{
+  return deadline != nullptr && deadline->IsExpired();
+}
+
+}  // namespace par
@@ -0,0 +1,269 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include "Embedding.h"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+
+#include "Community.h"
+#include "ThreadPool.h"
+#include "Utilities.h"
+#include "utl/Logger.h"
+
+namespace par {
+
+namespace {
+
+// the vertices are stored in rows, so the rows of a block can be updated by
+// different threads
+using RowMatrix
+    = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+const int kParallelWorkloadThreshold = 4096;
+
+// The subspace iteration on one level of the hierarchy
+class SubspaceIteration
+{
+ public:
+  SubspaceIteration(const WeightedGraph& graph, ThreadPool* thread_pool)
+      : graph_(graph),
+        thread_pool_(thread_pool),
+        inv_sqrt_degree_(graph.GetNumNodes()),
+        trivial_(graph.GetNumNodes())
+  {
+    // D^-1/2 and the trivial eigenvector D^1/2 * 1 of N
+    for (int v = 0; v < graph.GetNumNodes(); v++) {
+      const double degree = graph.volume[v];
+      inv_sqrt_degree_[v] = degree > 0.0 ? 1.0 / std::sqrt(degree) : 0.0;
+      trivial_[v] = std::sqrt(degree);
+    }
+    trivial_.normalize();
+  }
+
+  const Eigen::VectorXd& GetInvSqrtDegree() const { return inv_sqrt_degree_; }
+
+  // Run num_iters filtered iterations on the columns of x.  The columns of x
+  // are replaced by the Ritz vectors and the Ritz values are returned (in
+  // increasing order)
+  Eigen::VectorXd Run(RowMatrix& x, const int num_iters, const int degree) const
+  {
+    x -= trivial_ * (trivial_.transpose() * x);
+    Orthonormalize(x);
+    Eigen::VectorXd ritz_values = RayleighRitz(x);
+    for (int iter = 0; iter < num_iters; iter++) {
+      // the smallest Ritz value bounds the unwanted part of the spectrum
+      Filter(x, std::max(ritz_values[0], 0.0), degree);
+      Orthonormalize(x);
+      ritz_values = RayleighRitz(x);
+    }
+    return ritz_values;
+  }
+
+ private:
+  // y = N * x, orthogonal to the trivial eigenvector
+  void Multiply(const RowMatrix& x, RowMatrix& y) const
+  {
+    ParallelForChunks(
+        thread_pool_,
+        graph_.GetNumNodes(),
+        kParallelWorkloadThreshold,
+        [&](int begin, int end) {
+          Eigen::RowVectorXd row(x.cols());
+          for (int v = begin; v < end; v++) {
+            row.setZero();
+            for (int64_t k = graph_.ptr[v]; k < graph_.ptr[v + 1]; k++) {
+              const int u = graph_.adj[k];
+              row += (graph_.wt[k] * inv_sqrt_degree_[u]) * x.row(u);
+            }
+            y.row(v) = inv_sqrt_degree_[v] * row;
+          }
+        });
+    y -= trivial_ * (trivial_.transpose() * y);
+  }
+
+  // Chebyshev filter: amplify the components of x with the eigenvalues of N
+  // above cut, relative to the components in [-1, cut]
+  void Filter(RowMatrix& x, const double cut, const int degree) const
+  {
+    const double half_width = (cut + 1.0) / 2.0;
+    const double center = (cut - 1.0) / 2.0;
+    RowMatrix y(x.rows(), x.cols());
+    RowMatrix z(x.rows(), x.cols());
+    Multiply(x, y);
+    y = (y - center * x) / half_width;
+    for (int i = 1; i < degree; i++) {
+      Multiply(y, z);
+      z = (2.0 / half_width) * (z - center * y) - x;
+      x.swap(y);
+      y.swap(z);
+    }
+    x.swap(y);
+  }
+
+  // make the columns of x orthonormal
+  static void Orthonormalize(RowMatrix& x)
+  {
+    const Eigen::HouseholderQR<RowMatrix> qr(x);
+    x = qr.householderQ() * RowMatrix::Identity(x.rows(), x.cols());
+  }
+
+  // Rayleigh-Ritz projection: replace the columns of x by the Ritz vectors
+  // and return the Ritz values (in increasing order)
+  Eigen::VectorXd RayleighRitz(RowMatrix& x) const
+  {
+    RowMatrix y(x.rows(), x.cols());
+    Multiply(x, y);
+    Eigen::MatrixXd projection = x.transpose() * y;
+    projection = 0.5 * (projection + projection.transpose());
+    const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigen_solver(
+        projection);
+    x = x * eigen_solver.eigenvectors();
+    return eigen_solver.eigenvalues();
+  }
+
+  const WeightedGraph& graph_;
+  ThreadPool* thread_pool_ = nullptr;
+  Eigen::VectorXd inv_sqrt_degree_;
+  Eigen::VectorXd trivial_;
+};
+
+}  // namespace
+
+SpectralEmbedding::SpectralEmbedding(const int num_dimensions,
+                                     const int max_hyperedge_size,
+                                     const int max_num_iters,
+                                     const int seed,
+                                     ThreadPool* thread_pool,
+                                     utl::Logger* logger)
+    : num_dimensions_(num_dimensions),
+      max_hyperedge_size_(max_hyperedge_size),
+      max_num_iters_(max_num_iters),
+      seed_(seed),
+      thread_pool_(thread_pool),
+      logger_(logger)
+{
+}
+
+std::vector<float> SpectralEmbedding::Compute(
+    const HGraphPtr& hgraph,
+    const std::vector<float>& edge_weights) const
+{
+  // the hierarchy of the contracted communities
+  std::vector<WeightedGraph> graphs;
+  Matrix<int> communities;
+  const CommunityDetector community_detector(max_hyperedge_size_,
+                                             /* max_num_levels */ 16,
+                                             /* max_num_passes */ 10,
+                                             thread_pool_,
+                                             logger_);
+  community_detector.BuildHierarchy(hgraph, edge_weights, graphs, communities);
+  const WeightedGraph& finest_graph = graphs.front();
+  const int num_nodes = finest_graph.GetNumNodes();
+  // the trivial eigenvector is excluded from the subspace
+  const int block_size = num_dimensions_ + num_extra_vectors_;
+  if (num_dimensions_ <= 0 || num_nodes <= block_size
+      || std::all_of(finest_graph.volume.begin(),
+                     finest_graph.volume.end(),
+                     [](double volume) { return volume <= 0.0; })) {
+    return {};  // the hypergraph is too small or has no edge
+  }
+
+  // start from a random subspace (fixed seed) on the coarsest level which
+  // is large enough
+  int level = static_cast<int>(graphs.size()) - 1;
+  while (level > 0 && graphs[level].GetNumNodes() <= 2 * block_size) {
+    level--;
+  }
+  std::mt19937 gen(seed_);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  RowMatrix x(graphs[level].GetNumNodes(), block_size);
+  for (int v = 0; v < x.rows(); v++) {
+    for (int j = 0; j < block_size; j++) {
+      x(v, j) = distribution(gen);
+    }
+  }
+  Eigen::VectorXd ritz_values = SubspaceIteration(graphs[level], thread_pool_)
+                                    .Run(x, max_num_iters_, filter_degree_);
+  // interpolate the vectors to the finer levels and refine them, i.e.,
+  // D^-1/2 * x is constant inside each community
+  while (level > 0) {
+    const WeightedGraph& graph = graphs[level - 1];
+    const std::vector<int>& community = communities[level - 1];
+    const SubspaceIteration coarse_iteration(graphs[level], thread_pool_);
+    const Eigen::VectorXd& coarse_inv_sqrt_degree
+        = coarse_iteration.GetInvSqrtDegree();
+    RowMatrix fine_x(graph.GetNumNodes(), block_size);
+    for (int v = 0; v < graph.GetNumNodes(); v++) {
+      const int c = community[v];
+      fine_x.row(v) = (std::sqrt(graph.volume[v]) * coarse_inv_sqrt_degree[c])
+                      * x.row(c);
+    }
+    x.swap(fine_x);
+    level--;
+    ritz_values = SubspaceIteration(graphs[level], thread_pool_)
+                      .Run(x, num_refine_iters_, filter_degree_);
+  }
+
+  // the largest eigenvalues of N are the smallest eigenvalues of L
+  std::vector<float> laplacian_eigenvalues;
+  for (int j = 0; j < num_dimensions_; j++) {
+    laplacian_eigenvalues.push_back(1.0 - ritz_values[block_size - 1 - j]);
+  }
+  logger_->report(
+      "[EMBEDDING] Eigenvalues of the normalized Laplacian : [ {} ]",
+      GetVectorString(laplacian_eigenvalues));
+
+  // the coordinates are D^-1/2 * (Ritz vectors), scaled to [0, 1]
+  RowMatrix coordinates = x.rightCols(num_dimensions_).rowwise().reverse();
+  for (int v = 0; v < num_nodes; v++) {
+    const double degree = finest_graph.volume[v];
+    coordinates.row(v) *= degree > 0.0 ? 1.0 / std::sqrt(degree) : 0.0;
+  }
+  std::vector<float> embedding(static_cast<size_t>(num_nodes)
+                               * num_dimensions_);
+  for (int j = 0; j < num_dimensions_; j++) {
+    const double min_value = coordinates.col(j).minCoeff();
+    const double range = coordinates.col(j).maxCoeff() - min_value;
+    for (int v = 0; v < num_nodes; v++) {
+      embedding[static_cast<size_t>(v) * num_dimensions_ + j]
+          = range > 0.0 ? (coordinates(v, j) - min_value) / range : 0.5;
+    }
+  }
+  return embedding;
+}
+
+}  // namespace par
@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+// High-level description
+// Spectral embedding of the vertices, used as placement information for the
+// designs without placement.
+// The coordinates are the eigenvectors of the smallest nontrivial
+// eigenvalues of the normalized Laplacian L = I - D^-1/2 A D^-1/2 of the
+// clique expansion A of the hypergraph (see Community.h), i.e., the largest
+// eigenvalues of N = D^-1/2 A D^-1/2 except the trivial one.  They are
+// computed by a Chebyshev-filtered subspace iteration with Rayleigh-Ritz
+// projection.  The iteration starts on the coarsest level of the Louvain
+// hierarchy (see CommunityDetector), then the vectors are interpolated to
+// the finer levels and refined by a few iterations on each level.
+// The sparse matrix-block products are multi-threaded, the small dense
+// problems are solved by Eigen.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <vector>
+
+#include "Hypergraph.h"
+
+namespace utl {
+class Logger;
+}
+
+namespace par {
+
+class ThreadPool;
+
+class SpectralEmbedding
+{
+ public:
+  // thread_pool can be nullptr (serial)
+  SpectralEmbedding(int num_dimensions,
+                    int max_hyperedge_size,
+                    int max_num_iters,
+                    int seed,
+                    ThreadPool* thread_pool,
+                    utl::Logger* logger);
+
+  // Return the flattened num_vertices x num_dimensions embedding of hgraph.
+  // Each dimension is scaled to [0, 1].
+  // edge_weights[e] is the weight of each edge in the clique expansion of
+  // hyperedge e
+  std::vector<float> Compute(const HGraphPtr& hgraph,
+                             const std::vector<float>& edge_weights) const;
+
+ private:
+  const int num_dimensions_ = 2;
+  const int max_hyperedge_size_ = 50;
+  const int max_num_iters_ = 20;  // on the coarsest level
+  const int num_refine_iters_ = 4;  // on the finer levels
+  // the degree of the Chebyshev filter in each iteration
+  const int filter_degree_ = 10;
+  // the number of extra vectors in the subspace to speed up the convergence
+  const int num_extra_vectors_ = 4;
+  const int seed_ = 0;
+  ThreadPool* thread_pool_ = nullptr;
+  utl::Logger* logger_ = nullptr;
+};
+
+}  // namespace par
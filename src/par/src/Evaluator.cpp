@@ -34,9 +34,11 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "Evaluator.h"
 
+#include <algorithm>
 #include <fstream>
 #include <functional>
 #include <numeric>
+#include <utility>
 
 #include "Hypergraph.h"
 #include "Utilities.h"
@@ -75,12 +77,40 @@ GoldenEvaluator::GoldenEvaluator(const int num_parts,
   logger_ = logger;
 }
 
+void GoldenEvaluator::SetFixedPointBits(const int fixed_point_bits)
+{
+  fixed_point_scale_
+      = fixed_point_bits > 0 ? std::ldexp(1.0f, fixed_point_bits) : 0.0f;
+}
+
+void GoldenEvaluator::SetThreadPool(ThreadPoolPtr thread_pool)
+{
+  thread_pool_ = std::move(thread_pool);
+}
+
+void GoldenEvaluator::ForEachEvalChunk(
+    const int num_items,
+    const std::function<void(int, int, int)>& task) const
+{
+  // The chunks have a fixed size, so the result of reducing them in the
+  // order of chunk_id does not depend on the number of threads
+  ParallelForChunks(
+      thread_pool_.get(),
+      GetNumEvalChunks(num_items),
+      2,
+      [&](int first_chunk, int last_chunk) {
+        for (int chunk_id = first_chunk; chunk_id < last_chunk; chunk_id++) {
+          const int begin = chunk_id * eval_chunk_size_;
+          task(chunk_id, begin, std::min(begin + eval_chunk_size_, num_items));
+        }
+      });
+}
+
 // calculate the vertex distribution of each net
-Matrix<int> GoldenEvaluator::GetNetDegrees(const HGraphPtr& hgraph,
-                                           const Partitions& solution) const
+NetDegrees GoldenEvaluator::GetNetDegrees(const HGraphPtr& hgraph,
+                                          const Partitions& solution) const
 {
-  Matrix<int> net_degs(hgraph->GetNumHyperedges(),
-                       std::vector<int>(num_parts_, 0));
+  NetDegrees net_degs(hgraph->GetNumHyperedges(), num_parts_);
   for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
     for (const int vertex_id : hgraph->Vertices(e)) {
       net_degs[e][solution[vertex_id]]++;
@@ -93,12 +123,29 @@ Matrix<int> GoldenEvaluator::GetNetDegrees(const HGraphPtr& hgraph,
 Matrix<float> GoldenEvaluator::GetBlockBalance(const HGraphPtr& hgraph,
                                                const Partitions& solution) const
 {
-  Matrix<float> block_balance(
-      num_parts_, std::vector<float>(hgraph->GetVertexDimensions(), 0.0));
-  // update the block_balance
-  for (int v = 0; v < hgraph->GetNumVertices(); v++) {
-    block_balance[solution[v]]
-        = block_balance[solution[v]] + hgraph->GetVertexWeights(v);
+  const int dims = hgraph->GetVertexDimensions();
+  // the flat (block x dimension) balance of each chunk of vertices
+  std::vector<std::vector<float>> chunk_balances(
+      GetNumEvalChunks(hgraph->GetNumVertices()));
+  ForEachEvalChunk(
+      hgraph->GetNumVertices(), [&](int chunk_id, int begin, int end) {
+        std::vector<float>& balance = chunk_balances[chunk_id];
+        balance.assign(num_parts_ * dims, 0.0f);
+        for (int v = begin; v < end; v++) {
+          const FloatView weights = hgraph->GetVertexWeights(v);
+          float* block_balance = balance.data() + solution[v] * dims;
+          for (int dim = 0; dim < dims; dim++) {
+            block_balance[dim] += weights[dim];
+          }
+        }
+      });
+  Matrix<float> block_balance(num_parts_, std::vector<float>(dims, 0.0));
+  for (const std::vector<float>& balance : chunk_balances) {
+    for (int block_id = 0; block_id < num_parts_; block_id++) {
+      for (int dim = 0; dim < dims; dim++) {
+        block_balance[block_id][dim] += balance[block_id * dims + dim];
+      }
+    }
   }
   return block_balance;
 }
@@ -134,37 +181,32 @@ float GoldenEvaluator::CalculatePathCost(int path_id,
     return 0.0;
   }
   float cost = 0.0;
-  std::vector<int>
-      path;  // we must use vector here.  Becuase we need to calculate the
-             // snaking factor represent the path in terms of block_id
-  std::map<int, int> block_counter;  // block_id counter
-  for (const int u : hgraph->PathVertices(path_id)) {
-    const int block_id = solution[u];
-    if (path.empty() || path.back() != block_id) {
-      path.push_back(block_id);
-      if (block_counter.find(block_id) != block_counter.end()) {
-        block_counter[block_id] += 1;
-      } else {
-        block_counter[block_id] = 1;
-      }
-    }
-  }
+  // the block changes along the path, without building the block sequence
+  const PathCuts cuts
+      = CountPathCuts(hgraph->PathVertices(path_id), solution, num_parts_);
   // check if the entire path is within the block
-  if (path.size() <= 1) {
+  if (cuts.num_cuts == 0) {
     return cost;  // the path is fully within the block
   }
   // timing-related cost (basic path_cost * number of cut on the path)
-  cost = path_timing_factor_ * (path.size() - 1)
-         * hgraph->PathTimingCost(path_id);
+  cost = path_timing_factor_ * cuts.num_cuts * hgraph->PathTimingCost(path_id);
   // get the snaking factor of the path (maximum repetition of block_id - 1)
-  int snaking_factor = 0;
-  for (auto& [block_id, count] : block_counter) {
-    if (count > snaking_factor) {
-      snaking_factor = count;
-    }
+  cost += path_snaking_factor_ * static_cast<float>(cuts.max_block_visits - 1);
+  return QuantizeCost(cost);
+}
+
+// Get the connectivity status of a partitioning solution
+PartitionState GoldenEvaluator::GetPartitionState(
+    const HGraphPtr& hgraph,
+    const Partitions& solution) const
+{
+  PartitionState state;
+  state.net_degs = GetNetDegrees(hgraph, solution);
+  state.block_balance = GetBlockBalance(hgraph, solution);
+  if (hgraph->HasTiming()) {
+    state.paths_cost = GetPathsCost(hgraph, solution);
   }
-  cost += path_snaking_factor_ * static_cast<float>(snaking_factor - 1);
-  return cost;
+  return state;
 }
 
 // Get Paths cost: include the timing part and snaking part
@@ -199,34 +241,48 @@ PathStats GoldenEvaluator::GetTimingCuts(const HGraphPtr& hgraph,
 
   // Initialize the initial values
   path_stats.tot_num_path = hgraph->GetNumTimingPaths();
-  for (int i = 0; i < hgraph->GetNumTimingPaths(); ++i) {
-    std::vector<int> block_path;  // It must be a vector
-    for (const int v : hgraph->PathVertices(i)) {
-      const int block_id = solution[v];
-      if (block_path.empty() || block_path.back() != block_id) {
-        block_path.push_back(block_id);
-      }
-    }
-    const int cut_on_path = block_path.size() - 1;
-    float path_slack = hgraph->PathTimingSlack(i);
-    if (path_slack < 0) {  // critical path
-      path_stats.tot_num_critical_path += 1;
-      if (cut_on_path > 0) {
-        path_stats.worst_cut_critical_path
-            = std::max(cut_on_path, path_stats.worst_cut_critical_path);
-        path_stats.avg_cut_critical_path += cut_on_path;
-      }
-    } else {  // noncritical path
-      path_stats.tot_num_noncritical_path += 1;
-      // update the path slack based on extra delay
-      path_slack -= extra_cut_delay_ * cut_on_path;
-      if (path_slack < 0.0f) {
-        path_stats.number_non2critical_path += 1;
-        path_stats.worst_cut_non2critical_path
-            = std::max(cut_on_path, path_stats.worst_cut_non2critical_path);
-        path_stats.avg_cut_non2critical_path += cut_on_path;
-      }
-    }
+  // the statistics of each chunk of paths, merged in order below
+  std::vector<PathStats> chunk_stats(
+      GetNumEvalChunks(hgraph->GetNumTimingPaths()));
+  ForEachEvalChunk(
+      hgraph->GetNumTimingPaths(), [&](int chunk_id, int begin, int end) {
+        PathStats& stats = chunk_stats[chunk_id];
+        for (int i = begin; i < end; ++i) {
+          const int cut_on_path
+              = CountPathCuts(hgraph->PathVertices(i), solution, num_parts_)
+                    .num_cuts;
+          float path_slack = hgraph->PathTimingSlack(i);
+          if (path_slack < 0) {  // critical path
+            stats.tot_num_critical_path += 1;
+            if (cut_on_path > 0) {
+              stats.worst_cut_critical_path
+                  = std::max(cut_on_path, stats.worst_cut_critical_path);
+              stats.avg_cut_critical_path += cut_on_path;
+            }
+          } else {  // noncritical path
+            stats.tot_num_noncritical_path += 1;
+            // update the path slack based on extra delay
+            path_slack -= extra_cut_delay_ * cut_on_path;
+            if (path_slack < 0.0f) {
+              stats.number_non2critical_path += 1;
+              stats.worst_cut_non2critical_path
+                  = std::max(cut_on_path, stats.worst_cut_non2critical_path);
+              stats.avg_cut_non2critical_path += cut_on_path;
+            }
+          }
+        }
+      });
+  for (const PathStats& stats : chunk_stats) {
+    path_stats.tot_num_critical_path += stats.tot_num_critical_path;
+    path_stats.tot_num_noncritical_path += stats.tot_num_noncritical_path;
+    path_stats.worst_cut_critical_path = std::max(
+        path_stats.worst_cut_critical_path, stats.worst_cut_critical_path);
+    path_stats.avg_cut_critical_path += stats.avg_cut_critical_path;
+    path_stats.number_non2critical_path += stats.number_non2critical_path;
+    path_stats.worst_cut_non2critical_path
+        = std::max(path_stats.worst_cut_non2critical_path,
+                   stats.worst_cut_non2critical_path);
+    path_stats.avg_cut_non2critical_path += stats.avg_cut_non2critical_path;
   }
 
   // normalization to calculate average
@@ -328,7 +384,8 @@ float GoldenEvaluator::CalculateHyperedgeTimingCost(
   return 0.0;
 }
 
-// Calculate the cost of a hyperedge
+// Calculate the cost of a hyperedge (generic dimensions)
+template <int Dimensions>
 float GoldenEvaluator::CalculateHyperedgeCost(int e,
                                               const HGraphPtr& hgraph) const
 {
@@ -337,6 +394,19 @@ float GoldenEvaluator::CalculateHyperedgeCost(int e,
                                   hgraph->GetHyperedgeWeights(e).end(),
                                   e_wt_factors_.begin(),
                                   0.0);
+  if (hgraph->HasTiming()) {
+    cost += net_timing_factor_ * hgraph->GetHyperedgeTimingCost(e);
+  }
+  return cost;
+}
+
+// Calculate the cost of a hyperedge (one-dimensional weights)
+template <>
+float GoldenEvaluator::CalculateHyperedgeCost<1>(int e,
+                                                 const HGraphPtr& hgraph) const
+{
+  // calculate the edge score
+  float cost = hgraph->GetHyperedgeWeights(e).front() * e_wt_factors_.front();
   if (hgraph->HasTiming()) {
     // Note that hgraph->GetHyperedgeTimingCost(e) may be different from
     // the CalculateHyperedgeTimingCost(e, hgraph). Because this hyperedge may
@@ -347,6 +417,16 @@ float GoldenEvaluator::CalculateHyperedgeCost(int e,
   return cost;
 }
 
+// Calculate the cost of a hyperedge
+float GoldenEvaluator::CalculateHyperedgeCost(int e,
+                                              const HGraphPtr& hgraph) const
+{
+  if (hgraph->GetHyperedgeDimensions() == 1) {
+    return QuantizeCost(CalculateHyperedgeCost<1>(e, hgraph));
+  }
+  return QuantizeCost(CalculateHyperedgeCost<0>(e, hgraph));
+}
+
 // calculate the hyperedge score. score / (hyperedge.size() - 1)
 float GoldenEvaluator::GetNormEdgeScore(int e, const HGraphPtr& hgraph) const
 {
@@ -357,6 +437,16 @@ float GoldenEvaluator::GetNormEdgeScore(int e, const HGraphPtr& hgraph) const
   return CalculateHyperedgeCost(e, hgraph) / (he_size - 1);
 }
 
+std::vector<float> GoldenEvaluator::GetNormEdgeScores(
+    const HGraphPtr& hgraph) const
+{
+  std::vector<float> scores(hgraph->GetNumHyperedges());
+  for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
+    scores[e] = GetNormEdgeScore(e, hgraph);
+  }
+  return scores;
+}
+
 // Calculate the summation of normalized vertex weights
 // connecting to the same hyperedge
 float GoldenEvaluator::CalculateHyperedgeVertexWtSum(
@@ -385,8 +475,8 @@ float GoldenEvaluator::GetPlacementScore(int v,
                                          int u,
                                          const HGraphPtr& hgraph) const
 {
-  const float dist = norm2(hgraph->GetPlacement(v) - hgraph->GetPlacement(u),
-                           placement_wt_factors_);
+  const float dist = Distance(
+      hgraph->GetPlacement(v), hgraph->GetPlacement(u), placement_wt_factors_);
   if (dist == 0.0) {
     return std::numeric_limits<float>::max() / 2.0;
   }
@@ -401,16 +491,18 @@ GoldenEvaluator::GetAvgPlacementLoc(int v, int u, const HGraphPtr& hgraph) const
   const float u_weight = GetVertexWeightNorm(u, hgraph);
   const float weight_sum = v_weight + u_weight;
 
-  return MultiplyFactor(hgraph->GetPlacement(v), v_weight / weight_sum)
-         + MultiplyFactor(hgraph->GetPlacement(u), u_weight / weight_sum);
+  std::vector<float> avg_loc = ToVector(hgraph->GetPlacement(v));
+  Scale(avg_loc, v_weight / weight_sum);
+  AccumulateScaled(avg_loc, hgraph->GetPlacement(u), u_weight / weight_sum);
+  return avg_loc;
 }
 
 // calculate the average placement location
 std::vector<float> GoldenEvaluator::GetAvgPlacementLoc(
-    const std::vector<float>& vertex_weight_a,
-    const std::vector<float>& vertex_weight_b,
-    const std::vector<float>& placement_loc_a,
-    const std::vector<float>& placement_loc_b) const
+    FloatView vertex_weight_a,
+    FloatView vertex_weight_b,
+    FloatView placement_loc_a,
+    FloatView placement_loc_b) const
 {
   const float a_weight = std::inner_product(vertex_weight_a.begin(),
                                             vertex_weight_a.end(),
@@ -423,8 +515,10 @@ std::vector<float> GoldenEvaluator::GetAvgPlacementLoc(
                                             0.0f);
 
   const float weight_sum = a_weight + b_weight;
-  return MultiplyFactor(placement_loc_a, a_weight / weight_sum)
-         + MultiplyFactor(placement_loc_b, b_weight / weight_sum);
+  std::vector<float> avg_loc = ToVector(placement_loc_a);
+  Scale(avg_loc, a_weight / weight_sum);
+  AccumulateScaled(avg_loc, placement_loc_b, b_weight / weight_sum);
+  return avg_loc;
 }
 
 // get vertex weight summation
@@ -434,7 +528,7 @@ std::vector<float> GoldenEvaluator::GetVertexWeightSum(
 {
   std::vector<float> group_weight(hgraph->GetPlacementDimensions(), 0.0f);
   for (const auto& v : group) {
-    group_weight = group_weight + hgraph->GetVertexWeights(v);
+    Accumulate(group_weight, hgraph->GetVertexWeights(v));
   }
   return group_weight;
 }
@@ -487,7 +581,7 @@ std::vector<float> GoldenEvaluator::GetGroupPlacementLoc(
                                    hgraph->GetVertexWeights(v),
                                    group_loc,
                                    hgraph->GetPlacement(v));
-    group_weight = group_weight + hgraph->GetVertexWeights(v);
+    Accumulate(group_weight, hgraph->GetVertexWeights(v));
   }
 
   return group_weight;
@@ -521,31 +615,42 @@ std::map<std::pair<int, int>, float> GoldenEvaluator::GetMatchingConnectivity(
     const HGraphPtr& hgraph,
     const std::vector<int>& solution) const
 {
+  // The hyperedges are traversed once.  Each hyperedge adds its cost to
+  // all the pairs of blocks it spans, which are accumulated in a dense
+  // (block_a x block_b) array.  The scores are summed in the order of the
+  // hyperedges, the same as checking the pairs one by one.
+  std::vector<float> scores(num_parts_ * num_parts_, 0.0f);
+  std::vector<bool> block_flags(num_parts_, false);
+  std::vector<int> blocks;  // the blocks spanned by the current hyperedge
+  blocks.reserve(num_parts_);
+  for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
+    for (const int vertex_id : hgraph->Vertices(e)) {
+      const int block_id = solution[vertex_id];
+      if (block_flags[block_id] == false) {
+        block_flags[block_id] = true;
+        blocks.push_back(block_id);
+      }
+    }
+    if (blocks.size() > 1) {
+      std::sort(blocks.begin(), blocks.end());
+      const float cost = CalculateHyperedgeCost(e, hgraph);
+      for (int i = 0; i < static_cast<int>(blocks.size()); i++) {
+        for (int j = i + 1; j < static_cast<int>(blocks.size()); j++) {
+          scores[blocks[i] * num_parts_ + blocks[j]] += cost;
+        }
+      }
+    }
+    // reset the flags of the touched blocks only
+    for (const int block_id : blocks) {
+      block_flags[block_id] = false;
+    }
+    blocks.clear();
+  }
   std::map<std::pair<int, int>, float> matching_connectivity;
-  // the score between block_a and block_b is the same as
-  // the score between block_b and block_a
   for (int block_a = 0; block_a < num_parts_; block_a++) {
     for (int block_b = block_a + 1; block_b < num_parts_; block_b++) {
-      float score = 0.0;
-      // check each hyperedge
-      for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
-        bool block_a_flag = false;  // the hyperedge intersects with block_a
-        bool block_b_flag = false;  // the hyperedge intersects with block_b
-        for (const int vertex_id : hgraph->Vertices(e)) {
-          const int block_id = solution[vertex_id];
-          if (block_a_flag == false && block_id == block_a) {
-            block_a_flag = true;
-          }
-          if (block_b_flag == false && block_id == block_b) {
-            block_b_flag = true;
-          }
-          if (block_a_flag == true && block_b_flag == true) {
-            score += CalculateHyperedgeCost(e, hgraph);
-            break;
-          }
-        }
-      }
-      matching_connectivity[std::pair<int, int>(block_a, block_b)] = score;
+      matching_connectivity[std::pair<int, int>(block_a, block_b)]
+          = scores[block_a * num_parts_ + block_b];
     }
   }
   return matching_connectivity;
@@ -559,41 +664,118 @@ PartitionToken GoldenEvaluator::CutEvaluator(const HGraphPtr& hgraph,
                                              bool print_flag) const
 {
   Matrix<float> block_balance = GetBlockBalance(hgraph, solution);
+  const PartitionToken token{CutCost(hgraph, solution), block_balance};
+  // print the statistics
+  if (print_flag == true) {
+    PrintPartitionToken(hgraph, token);
+  }
+
+  return token;
+}
+
+// the cut cost of the hyperedges plus the cost of the timing paths
+float GoldenEvaluator::CutCost(const HGraphPtr& hgraph,
+                               const std::vector<int>& solution) const
+{
+  // check the cutsize
+  std::vector<float> chunk_edge_costs(
+      GetNumEvalChunks(hgraph->GetNumHyperedges()), 0.0f);
+  ForEachEvalChunk(
+      hgraph->GetNumHyperedges(), [&](int chunk_id, int begin, int end) {
+        float cost = 0.0;
+        for (int e = begin; e < end; ++e) {
+          const auto range = hgraph->Vertices(e);
+          const int first_solution = solution[*range.begin()];
+          for (const int vertex_id :
+               boost::make_iterator_range(range.begin() + 1, range.end())) {
+            if (solution[vertex_id] != first_solution) {
+              cost += CalculateHyperedgeCost(e, hgraph);
+              break;  // this net has been cut
+            }
+          }
+        }
+        chunk_edge_costs[chunk_id] = cost;
+      });
+  // check path related cost
+  std::vector<float> chunk_path_costs(
+      GetNumEvalChunks(hgraph->GetNumTimingPaths()), 0.0f);
+  ForEachEvalChunk(
+      hgraph->GetNumTimingPaths(), [&](int chunk_id, int begin, int end) {
+        float cost = 0.0;
+        for (int path_id = begin; path_id < end; path_id++) {
+          // the path cost has been weighted
+          cost += CalculatePathCost(path_id, hgraph, solution);
+        }
+        chunk_path_costs[chunk_id] = cost;
+      });
   float edge_cost = 0.0;
+  for (const float cost : chunk_edge_costs) {
+    edge_cost += cost;
+  }
   float path_cost = 0.0;
-  // check the cutsize
-  std::vector<int> cut_hyperedges = GetCutHyperedges(hgraph, solution);
-  for (auto& e : cut_hyperedges) {
-    edge_cost += CalculateHyperedgeCost(e, hgraph);
+  for (const float cost : chunk_path_costs) {
+    path_cost += cost;
   }
-  // check path related cost
-  for (int path_id = 0; path_id < hgraph->GetNumTimingPaths(); path_id++) {
-    // the path cost has been weighted
-    path_cost += CalculatePathCost(path_id, hgraph, solution);
+  return edge_cost + path_cost;
+}
+
+// calculate the statistics of a given partitioning solution
+// from the net degrees, block balance and path cost in the state
+PartitionToken GoldenEvaluator::CutEvaluator(const HGraphPtr& hgraph,
+                                             const PartitionState& state,
+                                             bool print_flag) const
+{
+  // a hyperedge is cut if its vertices span more than one block
+  std::vector<float> chunk_edge_costs(
+      GetNumEvalChunks(hgraph->GetNumHyperedges()), 0.0f);
+  ForEachEvalChunk(
+      hgraph->GetNumHyperedges(), [&](int chunk_id, int begin, int end) {
+        float cost = 0.0;
+        for (int e = begin; e < end; e++) {
+          if (state.net_degs.IsCut(e)) {
+            cost += CalculateHyperedgeCost(e, hgraph);
+          }
+        }
+        chunk_edge_costs[chunk_id] = cost;
+      });
+  float edge_cost = 0.0;
+  for (const float cost : chunk_edge_costs) {
+    edge_cost += cost;
+  }
+  float path_cost = 0.0;
+  // the path cost has been weighted
+  for (const float cost : state.paths_cost) {
+    path_cost += cost;
   }
-  const float cost = edge_cost + path_cost;
+  const PartitionToken token{edge_cost + path_cost, state.block_balance};
   // print the statistics
   if (print_flag == true) {
-    // print cost
-    logger_->report("[Cutcost of partition : {}]", cost);
-    // print block balance
-    const std::vector<float> tot_vertex_weights
-        = hgraph->GetTotalVertexWeights();
-    for (auto block_id = 0; block_id < num_parts_; block_id++) {
-      std::string line
-          = "[Vertex balance of block_" + std::to_string(block_id) + " : ";
-      for (auto dim = 0; dim < tot_vertex_weights.size(); dim++) {
-        std::stringstream ss;  // for converting float to string
-        ss << std::fixed << std::setprecision(5)
-           << block_balance[block_id][dim] / tot_vertex_weights[dim] << "  ( "
-           << block_balance[block_id][dim] << " )  ";
-        line += ss.str() + "  ";
-      }
-      logger_->report(line);
-    }  // finish block balance
+    PrintPartitionToken(hgraph, token);
   }
 
-  return PartitionToken{cost, block_balance};
+  return token;
+}
+
+// print the cost and the block balance of a partitioning solution
+void GoldenEvaluator::PrintPartitionToken(const HGraphPtr& hgraph,
+                                          const PartitionToken& token) const
+{
+  // print cost
+  logger_->report("[Cutcost of partition : {}]", token.cost);
+  // print block balance
+  const std::vector<float> tot_vertex_weights = hgraph->GetTotalVertexWeights();
+  for (auto block_id = 0; block_id < num_parts_; block_id++) {
+    std::string line
+        = "[Vertex balance of block_" + std::to_string(block_id) + " : ";
+    for (auto dim = 0; dim < tot_vertex_weights.size(); dim++) {
+      std::stringstream ss;  // for converting float to string
+      ss << std::fixed << std::setprecision(5)
+         << token.block_balance[block_id][dim] / tot_vertex_weights[dim]
+         << "  ( " << token.block_balance[block_id][dim] << " )  ";
+      line += ss.str() + "  ";
+    }
+    logger_->report(line);
+  }  // finish block balance
 }
 
 // check the constraints
@@ -606,7 +788,27 @@ bool GoldenEvaluator::ConstraintAndCutEvaluator(
     const std::vector<std::vector<int>>& group_attr,
     bool print_flag) const
 {
-  auto solution_token = CutEvaluator(hgraph, solution, print_flag);
+  const PartitionToken solution_token
+      = CutEvaluator(hgraph, solution, print_flag);
+  return ConstraintEvaluator(hgraph,
+                             solution,
+                             solution_token,
+                             ub_factor,
+                             std::move(base_balance),
+                             group_attr,
+                             print_flag);
+}
+
+// check the constraints of a solution whose statistics are already known
+bool GoldenEvaluator::ConstraintEvaluator(
+    const HGraphPtr& hgraph,
+    const std::vector<int>& solution,
+    const PartitionToken& solution_token,
+    float ub_factor,
+    std::vector<float> base_balance,
+    const std::vector<std::vector<int>>& group_attr,
+    bool print_flag) const
+{
   // check block balance
   bool balance_satisfied_flag = true;
   const Matrix<float> upper_block_balance
@@ -697,27 +899,11 @@ void GoldenEvaluator::InitializeTiming(const HGraphPtr& hgraph) const
   }
 }
 
-// Update timing information of a hypergraph
-// For timing-driven flow,
-// we first need to update the timing information of all the hyperedges
-// and paths (path_timing_attr_ and hyperedge_timing_attr_),
-// i.e., introducing extra delay on the hyperedges being cut.
-// Then we call InitializeTiming to update the corresponding weights.
-// The timing_graph_ contains all the necessary information,
-// include the original slack for each path and hyperedge,
-// and the type of each vertex
-void GoldenEvaluator::UpdateTiming(const HGraphPtr& hgraph,
-                                   const Partitions& solution) const
+// Introduce the extra delay on the cut hyperedges and propagate it
+std::vector<float> GoldenEvaluator::PropagateCutDelay(
+    const HGraphPtr& hgraph,
+    const std::vector<int>& cut_hyperedges) const
 {
-  if (!hgraph->HasTiming()) {
-    return;
-  }
-
-  // Here we need to update the path_timing_attr_ and hyperedge_timing_attr_ of
-  // hgraph Step 1: update the hyperedge_timing_attr_ first identify all the
-  // hyperedges being cut in the timing graph
-  std::vector<int> cut_hyperedges = GetCutHyperedges(hgraph, solution);
-
   // Timing arc slacks store the updated slack for each hyperedge in the timing
   // graph instead of hgraph
   std::vector<float> timing_arc_slacks
@@ -804,6 +990,33 @@ void GoldenEvaluator::UpdateTiming(const HGraphPtr& hgraph,
     }
   }
 
+  return timing_arc_slacks;
+}
+
+// Update timing information of a hypergraph
+// For timing-driven flow,
+// we first need to update the timing information of all the hyperedges
+// and paths (path_timing_attr_ and hyperedge_timing_attr_),
+// i.e., introducing extra delay on the hyperedges being cut.
+// Then we call InitializeTiming to update the corresponding weights.
+// The timing_graph_ contains all the necessary information,
+// include the original slack for each path and hyperedge,
+// and the type of each vertex
+void GoldenEvaluator::UpdateTiming(const HGraphPtr& hgraph,
+                                   const Partitions& solution) const
+{
+  // the original slacks are read from timing_graph_, which is never updated
+  if (!hgraph->HasTiming() || hgraph == timing_graph_) {
+    return;
+  }
+
+  // Here we need to update the path_timing_attr_ and hyperedge_timing_attr_ of
+  // hgraph Step 1: update the hyperedge_timing_attr_ first identify all the
+  // hyperedges being cut in the timing graph
+  std::vector<int> cut_hyperedges = GetCutHyperedges(hgraph, solution);
+  const std::vector<float> timing_arc_slacks
+      = PropagateCutDelay(hgraph, cut_hyperedges);
+
   // update the hyperedge_timing_attr_
   hgraph->ResetHyperedgeTimingAttr();
   for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
@@ -830,6 +1043,82 @@ void GoldenEvaluator::UpdateTiming(const HGraphPtr& hgraph,
   InitializeTiming(hgraph);
 }
 
+// Incremental version of UpdateTiming
+// The delay is still propagated from all the cut hyperedges, because the
+// propagation stops at the arcs with a smaller slack.  Only the hyperedges
+// whose slack is changed, and the paths through them, are updated, and their
+// costs are adjusted by the delta values.
+void GoldenEvaluator::UpdateTiming(const HGraphPtr& hgraph,
+                                   const Partitions& pre_solution,
+                                   const Partitions& solution) const
+{
+  if (!hgraph->HasTiming() || hgraph == timing_graph_) {
+    return;
+  }
+
+  if (hgraph->HasHyperedgeTimingCost() == false
+      || hgraph->GetTimingPathCostSize() < hgraph->GetNumTimingPaths()) {
+    UpdateTiming(hgraph, solution);  // the timing cost is not initialized
+    return;
+  }
+
+  // Step 1: the timing information does not change if the cut hyperedges
+  // do not change
+  const std::vector<int> cut_hyperedges = GetCutHyperedges(hgraph, solution);
+  if (cut_hyperedges == GetCutHyperedges(hgraph, pre_solution)) {
+    return;
+  }
+  const std::vector<float> timing_arc_slacks
+      = PropagateCutDelay(hgraph, cut_hyperedges);
+
+  // Step 2: update the hyperedges whose slack is changed
+  std::vector<int> changed_hyperedges;
+  for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
+    float slack = std::numeric_limits<float>::max();
+    for (const auto& arc_id : hgraph->GetHyperedgeArcSet(e)) {
+      slack = std::min(slack, timing_arc_slacks[arc_id]);
+    }
+    if (slack == hgraph->GetHyperedgeTimingAttr(e)) {
+      continue;
+    }
+    const float pre_cost = CalculateHyperedgeTimingCost(e, hgraph);
+    hgraph->SetHyperedgeTimingAttr(e, slack);
+    hgraph->AddHyperedgeTimingCost(
+        e, CalculateHyperedgeTimingCost(e, hgraph) - pre_cost);
+    changed_hyperedges.push_back(e);
+  }
+
+  // Step 3: update the paths through the changed hyperedges.
+  // the slack of a path is the worst slack of all its hyperedges.
+  // A path through hyperedge e always goes through the vertices of e
+  std::vector<bool> visited_paths(hgraph->GetNumTimingPaths(), false);
+  for (const int e : changed_hyperedges) {
+    for (const int v : hgraph->Vertices(e)) {
+      for (const int path_id : hgraph->TimingPathsThrough(v)) {
+        if (visited_paths[path_id] == true) {
+          continue;
+        }
+        visited_paths[path_id] = true;
+        float slack = std::numeric_limits<float>::max();
+        for (const int path_e : hgraph->PathEdges(path_id)) {
+          slack = std::min(slack, hgraph->GetHyperedgeTimingAttr(path_e));
+        }
+        if (slack == hgraph->PathTimingSlack(path_id)) {
+          continue;
+        }
+        hgraph->SetPathTimingSlack(path_id, slack);
+        const float pre_cost = hgraph->PathTimingCost(path_id);
+        const float cost = GetPathTimingScore(path_id, hgraph);
+        hgraph->SetPathTimingCost(path_id, cost);
+        // lay the delta path weight on corresponding hyperedges
+        for (const int path_e : hgraph->PathEdges(path_id)) {
+          hgraph->AddHyperedgeTimingCost(path_e, cost - pre_cost);
+        }
+      }
+    }
+  }
+}
+
 // Write the weighted hypergraph in hMETIS format
 void GoldenEvaluator::WriteWeightedHypergraph(const HGraphPtr& hgraph,
                                               const std::string& file_name,
@@ -889,4 +1178,122 @@ void GoldenEvaluator::WriteIntWeightHypergraph(
   file_output.close();
 }
 
+// Write the hypergraph in the binary format
+// All the values are stored in native byte order:
+// magic string, header, hyperedges (eptr, eind), vertex weights,
+// hyperedge weights, fixed attributes, community attributes,
+// placement attributes, timing information
+void GoldenEvaluator::WriteBinaryHypergraph(const HGraphPtr& hgraph,
+                                            const std::string& file_name) const
+{
+  std::ofstream file_output(file_name, std::ios::binary);
+  if (!file_output.is_open()) {
+    logger_->error(
+        PAR, 2505, "Can not open the binary hypergraph file : {}", file_name);
+  }
+  auto lambda_write = [&file_output](const auto& values) {
+    file_output.write(reinterpret_cast<const char*>(values.data()),
+                      values.size() * sizeof(values[0]));
+  };
+
+  const int num_vertices = hgraph->GetNumVertices();
+  const int num_hyperedges = hgraph->GetNumHyperedges();
+  const int num_timing_paths
+      = hgraph->HasTiming() == true ? hgraph->GetNumTimingPaths() : 0;
+  const std::vector<int> header{binary_hypergraph_version,
+                                num_vertices,
+                                num_hyperedges,
+                                hgraph->GetVertexDimensions(),
+                                hgraph->GetHyperedgeDimensions(),
+                                hgraph->GetPlacementDimensions(),
+                                hgraph->HasFixedVertices(),
+                                hgraph->HasCommunity(),
+                                hgraph->HasPlacement(),
+                                num_timing_paths};
+  lambda_write(binary_hypergraph_magic);
+  lambda_write(header);
+
+  // hyperedges in compressed sparse row format
+  std::vector<CsrOffset> eptr{0};
+  std::vector<int> eind;
+  for (int e = 0; e < num_hyperedges; e++) {
+    for (const int vertex : hgraph->Vertices(e)) {
+      eind.push_back(vertex);
+    }
+    eptr.push_back(eind.size());
+  }
+  lambda_write(eptr);
+  lambda_write(eind);
+
+  // weights
+  std::vector<float> vertex_weights;
+  for (int v = 0; v < num_vertices; v++) {
+    for (const float weight : hgraph->GetVertexWeights(v)) {
+      vertex_weights.push_back(weight);
+    }
+  }
+  lambda_write(vertex_weights);
+  std::vector<float> hyperedge_weights;
+  for (int e = 0; e < num_hyperedges; e++) {
+    for (const float weight : hgraph->GetHyperedgeWeights(e)) {
+      hyperedge_weights.push_back(weight);
+    }
+  }
+  lambda_write(hyperedge_weights);
+
+  // attributes of vertices
+  if (hgraph->HasFixedVertices() == true) {
+    std::vector<int> fixed_attr;
+    hgraph->CopyFixedAttr(fixed_attr);
+    lambda_write(fixed_attr);
+  }
+  if (hgraph->HasCommunity() == true) {
+    std::vector<int> community_attr;
+    hgraph->CopyCommunity(community_attr);
+    lambda_write(community_attr);
+  }
+  if (hgraph->HasPlacement() == true) {
+    std::vector<float> placement_attr;
+    for (int v = 0; v < num_vertices; v++) {
+      for (const float value : hgraph->GetPlacement(v)) {
+        placement_attr.push_back(value);
+      }
+    }
+    lambda_write(placement_attr);
+  }
+
+  // timing information: vertex types, slack of hyperedges,
+  // vertices (vptr, vind), hyperedges (eptr, eind) and slack of paths
+  if (num_timing_paths > 0) {
+    std::vector<int> vertex_types;
+    for (int v = 0; v < num_vertices; v++) {
+      vertex_types.push_back(static_cast<int>(hgraph->GetVertexType(v)));
+    }
+    lambda_write(vertex_types);
+    lambda_write(hgraph->GetHyperedgeTimingAttr());
+    std::vector<CsrOffset> vptr_p{0};
+    std::vector<int> vind_p;
+    std::vector<CsrOffset> eptr_p{0};
+    std::vector<int> eind_p;
+    std::vector<float> path_slacks;
+    for (int path_id = 0; path_id < num_timing_paths; path_id++) {
+      for (const int vertex : hgraph->PathVertices(path_id)) {
+        vind_p.push_back(vertex);
+      }
+      vptr_p.push_back(vind_p.size());
+      for (const int e : hgraph->PathEdges(path_id)) {
+        eind_p.push_back(e);
+      }
+      eptr_p.push_back(eind_p.size());
+      path_slacks.push_back(hgraph->PathTimingSlack(path_id));
+    }
+    lambda_write(vptr_p);
+    lambda_write(vind_p);
+    lambda_write(eptr_p);
+    lambda_write(eind_p);
+    lambda_write(path_slacks);
+  }
+  file_output.close();
+}
+
 }  // namespace par
@@ -34,6 +34,10 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "GreedyRefine.h"
 
+#include <algorithm>
+#include <functional>
+#include <queue>
+
 // ------------------------------------------------------------------------------
 // K-way hyperedge greedy refinement
 // ------------------------------------------------------------------------------
@@ -48,49 +52,110 @@ float GreedyRefine::Pass(
     const Matrix<float>& upper_block_balance,
     const Matrix<float>& lower_block_balance,
     Matrix<float>& block_balance,        // the current block balance
-    Matrix<int>& net_degs,               // the current net degree
+    NetDegrees& net_degs,                // the current net degree
     std::vector<float>& cur_paths_cost,  // the current path cost
     Partitions& solution,
     std::vector<bool>& visited_vertices_flag)
 {
-  float total_gain = 0.0;  // total gain improvement
+  GainValue total_gain;  // total gain improvement
   int num_move = 0;
-  for (int hyperedge_id = 0; hyperedge_id < hgraph->GetNumHyperedges();
-       hyperedge_id++) {
-    // check if the hyperedge is a straddled_hyperedge
-    std::set<int> block_set;
-    for (int block_id = 0; block_id < num_parts_; block_id++) {
-      if (net_degs[hyperedge_id][block_id] > 0) {
-        block_set.insert(block_id);
-      }
+  int num_accepted_moves = 0;  // for profiling
+  int64_t gain_updates = 0;
+
+  // Step 1: collect the straddled hyperedges in increasing order.  At most
+  // max_move_ - 1 hyperedges are visited in each pass, so only their gains
+  // are precomputed.
+  const std::vector<int> cut_edges
+      = FindCutHyperedges(hgraph, net_degs, hgraph->GetNumHyperedges());
+  const int num_cut_edges = static_cast<int>(cut_edges.size());
+  const int num_gain_edges = std::clamp(max_move_ - 1, 0, num_cut_edges);
+
+  // Step 2: calculate the gains of moving each cut hyperedge to each block
+  // in parallel.  Calculating the timing cost modifies the solution, so the
+  // gains are calculated on the fly if there are timing paths.
+  const bool parallel_flag = hgraph->GetNumTimingPaths() == 0;
+  std::vector<std::vector<HyperedgeGain>> edge_gains;
+  if (parallel_flag == true && num_gain_edges > 0) {
+    edge_gains.resize(num_gain_edges);
+    ParallelForChunks(
+        thread_pool_.get(),
+        num_gain_edges,
+        parallel_workload_threshold_,
+        [&](int begin, int end) {
+          for (int i = begin; i < end; i++) {
+            edge_gains[i].reserve(num_parts_);
+            for (int to_pid = 0; to_pid < num_parts_; to_pid++) {
+              edge_gains[i].push_back(CalculateHyperedgeGain(cut_edges[i],
+                                                             to_pid,
+                                                             hgraph,
+                                                             solution,
+                                                             cur_paths_cost,
+                                                             net_degs));
+            }
+          }
+        });
+    gain_updates += static_cast<int64_t>(num_gain_edges) * num_parts_;
+    edge_stamps_.resize(hgraph->GetNumHyperedges(), 0);
+    edge_epoch_++;
+  }
+
+  // define a lambda function to compare two HyperedgeGain (>=)
+  auto CompareHyperedgeGain
+      = [&](const HyperedgeGain& a, const HyperedgeGain& b) {
+          if (a.GetGainValue() > b.GetGainValue()) {
+            return true;
+          }
+          // break ties based on vertex weight summation of
+          // the hyperedge
+          return a.GetGainValue() == b.GetGainValue()
+                 && evaluator_->CalculateHyperedgeVertexWtSum(
+                        a.GetHyperedge(), hgraph)
+                        < evaluator_->CalculateHyperedgeVertexWtSum(
+                            b.GetHyperedge(), hgraph);
+        };
+
+  // Step 3: apply the moves in the increasing order of hyperedge ids.
+  // A hyperedge cut by a move is visited later if its id is larger than the
+  // one of the moved hyperedge, as when all the hyperedges are scanned.
+  std::priority_queue<int, std::vector<int>, std::greater<int>> new_cut_edges;
+  std::vector<int> moved_vertices;
+  int next_cut_edge = 0;  // the position of the next hyperedge in cut_edges
+  int prev_hyperedge_id = -1;
+  while (next_cut_edge < num_cut_edges || new_cut_edges.empty() == false) {
+    int hyperedge_id = -1;
+    int gain_id = -1;  // the position of the precomputed gains
+    if (new_cut_edges.empty() == true
+        || (next_cut_edge < num_cut_edges
+            && cut_edges[next_cut_edge] <= new_cut_edges.top())) {
+      gain_id = next_cut_edge;
+      hyperedge_id = cut_edges[next_cut_edge++];
+    } else {
+      hyperedge_id = new_cut_edges.top();
+      new_cut_edges.pop();
     }
-    // ignore the hyperedge if it's fully within one block
-    if (block_set.size() <= 1) {
+    // a hyperedge can be added several times
+    if (hyperedge_id == prev_hyperedge_id) {
+      continue;
+    }
+    prev_hyperedge_id = hyperedge_id;
+    // ignore the hyperedge if it's fully within one block after the
+    // previous moves
+    if (IsCutHyperedge(hyperedge_id, net_degs) == false) {
       continue;
     }
     // updated the iteration
     num_move++;
-    if (num_move >= max_move_) {
-      return total_gain;
+    if (num_move >= max_move_ || CheckDeadline(num_move)) {
+      break;
     }
+    // the precomputed gains are stale if the hyperedge is touched by the
+    // previous moves
+    const bool stale_flag = gain_id < 0
+                            || gain_id >= static_cast<int>(edge_gains.size())
+                            || IsChangedByMoves(hgraph, hyperedge_id) == true;
     // find the best candidate block
-    // the initialization of best_gain is 0.0
-    // define a lambda function to compare two HyperedgeGainPtr (>=)
-    auto CompareHyperedgeGain
-        = [&](const HyperedgeGainPtr& a, const HyperedgeGainPtr& b) {
-            if (a->GetGain() > b->GetGain()) {
-              return true;
-            }
-            // break ties based on vertex weight summation of
-            // the hyperedge
-            return a->GetGain() == b->GetGain()
-                   && evaluator_->CalculateHyperedgeVertexWtSum(
-                          a->GetHyperedge(), hgraph)
-                          < evaluator_->CalculateHyperedgeVertexWtSum(
-                              b->GetHyperedge(), hgraph);
-          };
-
-    std::shared_ptr<HyperedgeGain> best_gain_hyperedge;
+    // the dummy hyperedge gain has no destination block
+    HyperedgeGain best_gain_hyperedge;
     for (int to_pid = 0; to_pid < num_parts_; to_pid++) {
       if (CheckHyperedgeMoveLegality(hyperedge_id,
                                      to_pid,
@@ -99,19 +164,36 @@ float GreedyRefine::Pass(
                                      block_balance,
                                      upper_block_balance,
                                      lower_block_balance)
-          == true) {
-        HyperedgeGainPtr gain_hyperedge = CalculateHyperedgeGain(
+          == false) {
+        continue;
+      }
+      HyperedgeGain gain_hyperedge;
+      if (stale_flag == true) {
+        gain_hyperedge = CalculateHyperedgeGain(
             hyperedge_id, to_pid, hgraph, solution, cur_paths_cost, net_degs);
-        if (!best_gain_hyperedge
-            || CompareHyperedgeGain(gain_hyperedge, best_gain_hyperedge)) {
-          best_gain_hyperedge = gain_hyperedge;
-        }
+        gain_updates++;
+      } else {
+        gain_hyperedge = edge_gains[gain_id][to_pid];
+      }
+      if (best_gain_hyperedge.GetDestinationPart() == -1
+          || CompareHyperedgeGain(gain_hyperedge, best_gain_hyperedge)) {
+        best_gain_hyperedge = std::move(gain_hyperedge);
       }
     }
 
     // We only accept positive move
-    if (best_gain_hyperedge && best_gain_hyperedge->GetDestinationPart() > -1
-        && best_gain_hyperedge->GetGain() >= 0.0f) {
+    if (best_gain_hyperedge.GetDestinationPart() > -1
+        && best_gain_hyperedge.GetGainValue() >= GainValue()) {
+      const int to_pid = best_gain_hyperedge.GetDestinationPart();
+      moved_vertices.clear();
+      for (const int v : hgraph->Vertices(hyperedge_id)) {
+        if (solution[v] != to_pid) {
+          moved_vertices.push_back(v);
+        }
+      }
+      if (parallel_flag == true) {
+        MarkChangedByMove(hgraph, moved_vertices);
+      }
       AcceptHyperedgeGain(best_gain_hyperedge,
                           hgraph,
                           total_gain,
@@ -119,11 +201,42 @@ float GreedyRefine::Pass(
                           cur_paths_cost,
                           block_balance,
                           net_degs);
+      num_accepted_moves++;
+      for (const int v : moved_vertices) {
+        for (const int he : hgraph->Edges(v)) {
+          if (he > hyperedge_id && IsCutHyperedge(he, net_degs) == true) {
+            new_cut_edges.push(he);
+          }
+        }
+      }
     }
   }
 
   // finish traversing all the hyperedges
-  return total_gain;
+  RecordPass(num_move, num_accepted_moves, gain_updates, GainBuckets{});
+  return total_gain.GetValue();
+}
+
+bool GreedyRefine::IsChangedByMoves(const HGraphPtr& hgraph, const int e) const
+{
+  for (const int v : hgraph->Vertices(e)) {
+    for (const int he : hgraph->Edges(v)) {
+      if (edge_stamps_[he] == edge_epoch_) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void GreedyRefine::MarkChangedByMove(const HGraphPtr& hgraph,
+                                     const std::vector<int>& moved_vertices)
+{
+  for (const int v : moved_vertices) {
+    for (const int he : hgraph->Edges(v)) {
+      edge_stamps_[he] = edge_epoch_;
+    }
+  }
 }
 
 }  // namespace par
@@ -34,7 +34,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
-#include <set>
+#include <vector>
 
 #include "Refiner.h"
 
@@ -49,12 +49,26 @@ using GreedyRefinerPtr = std::shared_ptr<GreedyRefine>;
 // hyperedge into some block, to minimize the cost.
 // Moving the entire hyperedge can help to escape the local minimum caused
 // by moving vertex one by one
+// Only the cut hyperedges are visited in each pass, in the increasing order
+// of hyperedge ids.  The hyperedges cut by a move are added to the visited
+// ones if their ids are larger than the one of the moved hyperedge.
+// Without timing paths, the gains of the cut hyperedges are calculated
+// concurrently before the moves are applied.  A gain is calculated again if
+// the hyperedge touches a hyperedge changed by a previous move, so the
+// result is the same as the sequential scan of all the hyperedges and does
+// not depend on the number of threads.
 // ------------------------------------------------------------------------------
 class GreedyRefine : public Refiner
 {
  public:
   using Refiner::Refiner;
 
+  // Create a new refiner with the same parameters (thread-local usage)
+  GreedyRefinerPtr Clone() const
+  {
+    return std::make_shared<GreedyRefine>(*this);
+  }
+
  private:
   // In each pass, we only move the boundary vertices
   // here we pass block_balance and net_degrees as reference
@@ -66,10 +80,23 @@ class GreedyRefine : public Refiner
              const Matrix<float>& upper_block_balance,
              const Matrix<float>& lower_block_balance,
              Matrix<float>& block_balance,        // the current block balance
-             Matrix<int>& net_degs,               // the current net degree
+             NetDegrees& net_degs,                // the current net degree
              std::vector<float>& cur_paths_cost,  // the current path cost
              Partitions& solution,
              std::vector<bool>& visited_vertices_flag) override;
+
+  // Return true if hyperedge e shares a vertex with a hyperedge changed by
+  // the moves applied in the current pass
+  bool IsChangedByMoves(const HGraphPtr& hgraph, int e) const;
+
+  // Mark the hyperedges changed by moving the vertices of a hyperedge
+  void MarkChangedByMove(const HGraphPtr& hgraph,
+                         const std::vector<int>& moved_vertices);
+
+  // edge_stamps_[e] == edge_epoch_ if hyperedge e is changed in the
+  // current pass
+  std::vector<int> edge_stamps_;
+  int edge_epoch_ = 0;
 };
 
 }  // namespace par
@@ -35,14 +35,72 @@
 
 #include "Hypergraph.h"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <numeric>
 #include <string>
+#include <utility>
 
 #include "Utilities.h"
 #include "utl/Logger.h"
 
 namespace par {
 
+// Memory held by all the hypergraphs of the multilevel hierarchy
+static utl::MemoryCounter hypergraph_memory("par__hypergraphs");
+
+// Convert a matrix into a flat array with dimensions elements in each row
+static std::vector<float> FlattenMatrix(const Matrix<float>& matrix,
+                                        const int dimensions)
+{
+  std::vector<float> flat_array(matrix.size() * dimensions, 0.0f);
+  auto iter = flat_array.begin();
+  for (const auto& row : matrix) {
+    std::copy_n(
+        row.begin(), std::min(static_cast<int>(row.size()), dimensions), iter);
+    iter += dimensions;
+  }
+  return flat_array;
+}
+
+// Convert a flat array into a matrix with dimensions elements in each row
+static void UnflattenMatrix(const std::vector<float>& flat_array,
+                            const int dimensions,
+                            Matrix<float>& matrix)
+{
+  matrix.clear();
+  if (dimensions <= 0) {
+    return;
+  }
+  matrix.reserve(flat_array.size() / dimensions);
+  for (auto iter = flat_array.begin(); iter != flat_array.end();
+       iter += dimensions) {
+    matrix.emplace_back(iter, iter + dimensions);
+  }
+}
+
+// Convert the hyperedges into compressed sparse row format
+static std::vector<CsrOffset> GetHyperedgePtr(const Matrix<int>& hyperedges)
+{
+  std::vector<CsrOffset> eptr;
+  eptr.reserve(hyperedges.size() + 1);
+  eptr.push_back(0);
+  for (const auto& hyperedge : hyperedges) {
+    eptr.push_back(eptr.back() + static_cast<CsrOffset>(hyperedge.size()));
+  }
+  return eptr;
+}
+
+static std::vector<int> GetHyperedgeInd(const Matrix<int>& hyperedges)
+{
+  std::vector<int> eind;
+  for (const auto& hyperedge : hyperedges) {
+    eind.insert(eind.end(), hyperedge.begin(), hyperedge.end());
+  }
+  return eind;
+}
+
 Hypergraph::Hypergraph(
     const int vertex_dimensions,
     const int hyperedge_dimensions,
@@ -57,36 +115,61 @@ Hypergraph::Hypergraph(
     // placement information
     const std::vector<std::vector<float>>& placement_attr,
     utl::Logger* logger)
+    : Hypergraph(vertex_dimensions,
+                 hyperedge_dimensions,
+                 placement_dimensions,
+                 GetHyperedgePtr(hyperedges),
+                 GetHyperedgeInd(hyperedges),
+                 vertex_weights,
+                 hyperedge_weights,
+                 fixed_attr,
+                 community_attr,
+                 placement_attr,
+                 logger)
+{
+}
+
+Hypergraph::Hypergraph(
+    const int vertex_dimensions,
+    const int hyperedge_dimensions,
+    const int placement_dimensions,
+    std::vector<CsrOffset> eptr,
+    std::vector<int> eind,
+    const std::vector<std::vector<float>>& vertex_weights,
+    const std::vector<std::vector<float>>& hyperedge_weights,
+    // fixed vertices
+    const std::vector<int>& fixed_attr,  // the block id of fixed vertices.
+    // community attribute
+    const std::vector<int>& community_attr,
+    // placement information
+    const std::vector<std::vector<float>>& placement_attr,
+    utl::Logger* logger)
     : num_vertices_(static_cast<int>(vertex_weights.size())),
       num_hyperedges_(static_cast<int>(hyperedge_weights.size())),
       vertex_dimensions_(vertex_dimensions),
       hyperedge_dimensions_(hyperedge_dimensions),
-      vertex_weights_(vertex_weights),
-      hyperedge_weights_(hyperedge_weights)
+      vertex_weights_(FlattenMatrix(vertex_weights, vertex_dimensions)),
+      hyperedge_weights_(
+          FlattenMatrix(hyperedge_weights, hyperedge_dimensions)),
+      eind_(std::move(eind)),
+      eptr_(std::move(eptr))
 {
-  // add hyperedge
-  // hyperedges: each hyperedge is a set of vertices
-  eptr_.push_back(0);
-  for (const auto& hyperedge : hyperedges) {
-    eind_.insert(eind_.end(), hyperedge.begin(), hyperedge.end());
-    eptr_.push_back(static_cast<int>(eind_.size()));
-  }
-
   // add vertex
   // create vertices from hyperedges
-  std::vector<std::vector<int>> vertices(num_vertices_);
+  // count the hyperedges of each vertex, then fill them in
+  vptr_.resize(num_vertices_ + 1, 0);
+  for (const int v : eind_) {
+    vptr_[v + 1]++;
+  }
+  std::partial_sum(vptr_.begin(), vptr_.end(), vptr_.begin());
+  vind_.resize(eind_.size());
+  std::vector<CsrOffset> vertex_pos(vptr_.begin(), vptr_.end() - 1);
   for (int e = 0; e < num_hyperedges_; e++) {
-    for (auto v : hyperedges[e]) {
-      vertices[v].push_back(e);  // e is the hyperedge id
+    for (const int v : Vertices(e)) {
+      vind_[vertex_pos[v]++] = e;  // e is the hyperedge id
     }
   }
 
-  vptr_.push_back(0);
-  for (const auto& vertex : vertices) {
-    vind_.insert(vind_.end(), vertex.begin(), vertex.end());
-    vptr_.push_back(static_cast<int>(vind_.size()));
-  }
-
   // fixed vertices
   fixed_vertex_flag_ = (fixed_attr.size() == num_vertices_);
   if (fixed_vertex_flag_) {
@@ -104,12 +187,13 @@ Hypergraph::Hypergraph(
       = (placement_dimensions > 0 && placement_attr.size() == num_vertices_);
   if (placement_flag_) {
     placement_dimensions_ = placement_dimensions;
-    placement_attr_ = placement_attr;
+    placement_attr_ = FlattenMatrix(placement_attr, placement_dimensions_);
   } else {
     placement_dimensions_ = 0;
   }
 
   logger_ = logger;
+  memory_charge_.set(hypergraph_memory, GetMemoryUsage());
 }
 
 Hypergraph::Hypergraph(
@@ -131,13 +215,58 @@ Hypergraph::Hypergraph(
                        // users do not need to specify this
     // slack information
     const std::vector<float>& hyperedges_slack,
-    const std::vector<std::set<int>>& hyperedges_arc_set,
+    std::vector<CsrOffset> arc_ptr,
+    std::vector<int> arc_ind,
+    const std::vector<TimingPath>& timing_paths,
+    utl::Logger* logger)
+    : Hypergraph(vertex_dimensions,
+                 hyperedge_dimensions,
+                 placement_dimensions,
+                 GetHyperedgePtr(hyperedges),
+                 GetHyperedgeInd(hyperedges),
+                 vertex_weights,
+                 hyperedge_weights,
+                 fixed_attr,
+                 community_attr,
+                 placement_attr,
+                 vertex_types,
+                 hyperedges_slack,
+                 std::move(arc_ptr),
+                 std::move(arc_ind),
+                 timing_paths,
+                 logger)
+{
+}
+
+Hypergraph::Hypergraph(
+    const int vertex_dimensions,
+    const int hyperedge_dimensions,
+    const int placement_dimensions,
+    std::vector<CsrOffset> eptr,
+    std::vector<int> eind,
+    const std::vector<std::vector<float>>& vertex_weights,
+    const std::vector<std::vector<float>>& hyperedge_weights,
+    // fixed vertices
+    const std::vector<int>& fixed_attr,  // the block id of fixed vertices.
+    // community attribute
+    const std::vector<int>& community_attr,
+    // placement information
+    const std::vector<std::vector<float>>& placement_attr,
+    // the type of each vertex
+    const std::vector<VertexType>&
+        vertex_types,  // except the original timing graph,
+                       // users do not need to specify this
+    // slack information
+    const std::vector<float>& hyperedges_slack,
+    std::vector<CsrOffset> arc_ptr,
+    std::vector<int> arc_ind,
     const std::vector<TimingPath>& timing_paths,
     utl::Logger* logger)
     : Hypergraph(vertex_dimensions,
                  hyperedge_dimensions,
                  placement_dimensions,
-                 hyperedges,
+                 std::move(eptr),
+                 std::move(eind),
                  vertex_weights,
                  hyperedge_weights,
                  fixed_attr,
@@ -150,11 +279,12 @@ Hypergraph::Hypergraph(
 
   // slack information
   if (hyperedges_slack.size() == num_hyperedges_
-      && hyperedges_arc_set.size() == num_hyperedges_) {
+      && arc_ptr.size() == num_hyperedges_ + 1) {
     timing_flag_ = true;
     num_timing_paths_ = static_cast<int>(timing_paths.size());
     hyperedge_timing_attr_ = hyperedges_slack;
-    hyperedge_arc_set_ = hyperedges_arc_set;
+    arc_ptr_ = std::move(arc_ptr);
+    arc_ind_ = std::move(arc_ind);
     // create the vertex Matrix which stores the paths incident to vertex
     std::vector<std::vector<int>> incident_paths(num_vertices_);
     vptr_p_.push_back(0);
@@ -163,34 +293,99 @@ Hypergraph::Hypergraph(
       // view each path as a sequence of vertices
       const auto& timing_path = timing_paths[path_id].path;
       vind_p_.insert(vind_p_.end(), timing_path.begin(), timing_path.end());
-      vptr_p_.push_back(static_cast<int>(vind_p_.size()));
+      vptr_p_.push_back(static_cast<CsrOffset>(vind_p_.size()));
       for (const int v : timing_path) {
         incident_paths[v].push_back(path_id);
       }
       // view each path as a sequence of hyperedge
       const auto& timing_arc = timing_paths[path_id].arcs;
       eind_p_.insert(eind_p_.end(), timing_arc.begin(), timing_arc.end());
-      eptr_p_.push_back(static_cast<int>(eind_p_.size()));
+      eptr_p_.push_back(static_cast<CsrOffset>(eind_p_.size()));
       // add the timing attribute
       path_timing_attr_.push_back(timing_paths[path_id].slack);
     }
     pptr_v_.push_back(0);
     for (auto& paths : incident_paths) {
       pind_v_.insert(pind_v_.end(), paths.begin(), paths.end());
-      pptr_v_.push_back(static_cast<int>(pind_v_.size()));
+      pptr_v_.push_back(static_cast<CsrOffset>(pind_v_.size()));
     }
   }
+  memory_charge_.set(hypergraph_memory, GetMemoryUsage());
 }
 
 std::vector<float> Hypergraph::GetTotalVertexWeights() const
 {
   std::vector<float> total_weight(vertex_dimensions_, 0.0);
-  for (auto& weight : vertex_weights_) {
-    total_weight = total_weight + weight;
+  for (int v = 0; v < num_vertices_; v++) {
+    Accumulate(total_weight, GetVertexWeights(v));
   }
   return total_weight;
 }
 
+int64_t Hypergraph::GetMemoryUsage() const
+{
+  auto lambda_bytes = [](const auto& vec) -> int64_t {
+    return static_cast<int64_t>(vec.capacity() * sizeof(vec[0]));
+  };
+  return lambda_bytes(vertex_weights_) + lambda_bytes(hyperedge_weights_)
+         + lambda_bytes(hyperedge_timing_attr_)
+         + lambda_bytes(hyperedge_timing_cost_) + lambda_bytes(arc_ind_)
+         + lambda_bytes(arc_ptr_) + lambda_bytes(eind_) + lambda_bytes(eptr_)
+         + lambda_bytes(vind_) + lambda_bytes(vptr_) + lambda_bytes(fixed_attr_)
+         + lambda_bytes(vertex_types_) + lambda_bytes(community_attr_)
+         + lambda_bytes(placement_attr_) + lambda_bytes(pind_v_)
+         + lambda_bytes(pptr_v_) + lambda_bytes(vind_p_) + lambda_bytes(vptr_p_)
+         + lambda_bytes(eind_p_) + lambda_bytes(eptr_p_)
+         + lambda_bytes(path_timing_attr_) + lambda_bytes(path_timing_cost_)
+         + lambda_bytes(vertex_c_parent_);
+}
+
+void Hypergraph::AddToFingerprint(Fingerprint& fingerprint) const
+{
+  fingerprint.AddValue(num_vertices_);
+  fingerprint.AddValue(num_hyperedges_);
+  fingerprint.AddValue(vertex_dimensions_);
+  fingerprint.AddValue(hyperedge_dimensions_);
+  fingerprint.AddValue(placement_dimensions_);
+  fingerprint.AddVector(eptr_);
+  fingerprint.AddVector(eind_);
+  fingerprint.AddVector(vertex_weights_);
+  fingerprint.AddVector(hyperedge_weights_);
+  fingerprint.AddVector(fixed_attr_);
+  fingerprint.AddVector(community_attr_);
+  fingerprint.AddVector(placement_attr_);
+  fingerprint.AddVector(hyperedge_timing_attr_);
+  fingerprint.AddVector(vptr_p_);
+  fingerprint.AddVector(vind_p_);
+  fingerprint.AddVector(path_timing_attr_);
+}
+
+void Hypergraph::CopyVertexWeights(Matrix<float>& weights) const
+{
+  UnflattenMatrix(vertex_weights_, vertex_dimensions_, weights);
+}
+
+void Hypergraph::CopyPlacement(Matrix<float>& attr) const
+{
+  UnflattenMatrix(placement_attr_, placement_dimensions_, attr);
+}
+
+void Hypergraph::SetPlacement(const int placement_dimensions,
+                              std::vector<float> placement_attr)
+{
+  placement_flag_
+      = (placement_dimensions > 0
+         && placement_attr.size()
+                == static_cast<size_t>(num_vertices_) * placement_dimensions);
+  if (placement_flag_) {
+    placement_dimensions_ = placement_dimensions;
+    placement_attr_ = std::move(placement_attr);
+  } else {
+    placement_dimensions_ = 0;
+    placement_attr_.clear();
+  }
+}
+
 std::vector<std::vector<float>> Hypergraph::GetUpperVertexBalance(
     int num_parts,
     float ub_factor,
@@ -230,10 +425,220 @@ std::vector<std::vector<float>> Hypergraph::GetLowerVertexBalance(
   return lower_block_balance;
 }
 
-void Hypergraph::ResetVertexCAttr()
+void Hypergraph::ProjectSolution(const std::vector<int>& solution,
+                                 std::vector<int>& finer_solution) const
+{
+  finer_solution.resize(vertex_c_parent_.size());
+  for (size_t v = 0; v < vertex_c_parent_.size(); v++) {
+    finer_solution[v] = solution[vertex_c_parent_[v]];
+  }
+}
+
+HGraphPtr Hypergraph::GetSubHypergraph(const std::vector<int>& vertices) const
+{
+  const int num_sub_vertices = static_cast<int>(vertices.size());
+  // map the vertices of this hypergraph to the vertices of the sub-hypergraph
+  std::vector<int> sub_vertex_id(num_vertices_, -1);
+  for (int i = 0; i < num_sub_vertices; i++) {
+    sub_vertex_id[vertices[i]] = i;
+  }
+
+  // vertex attributes
+  Matrix<float> vertex_weights;
+  vertex_weights.reserve(num_sub_vertices);
+  std::vector<int> fixed_attr;
+  std::vector<int> community_attr;
+  Matrix<float> placement_attr;
+  std::vector<VertexType> vertex_types;
+  for (const int v : vertices) {
+    vertex_weights.push_back(ToVector(GetVertexWeights(v)));
+    if (fixed_vertex_flag_ == true) {
+      fixed_attr.push_back(fixed_attr_[v]);
+    }
+    if (community_flag_ == true) {
+      community_attr.push_back(community_attr_[v]);
+    }
+    if (placement_flag_ == true) {
+      placement_attr.push_back(ToVector(GetPlacement(v)));
+    }
+    if (static_cast<int>(vertex_types_.size()) == num_vertices_) {
+      vertex_types.push_back(vertex_types_[v]);
+    }
+  }
+
+  // hyperedges with at least two vertices in the sub-hypergraph.
+  // sub_edge_id maps the hyperedges of this hypergraph to the hyperedges
+  // of the sub-hypergraph (-1 means that the hyperedge is removed)
+  std::vector<int> sub_edge_id(num_hyperedges_, -1);
+  std::vector<bool> visited(num_hyperedges_, false);
+  std::vector<CsrOffset> eptr{0};
+  std::vector<int> eind;
+  Matrix<float> hyperedge_weights;
+  std::vector<float> hyperedges_slack;
+  std::vector<CsrOffset> arc_ptr;
+  std::vector<int> arc_ind;
+  if (timing_flag_ == true) {
+    arc_ptr.push_back(0);
+  }
+  for (const int v : vertices) {
+    for (const int e : Edges(v)) {
+      if (visited[e] == true) {
+        continue;
+      }
+      visited[e] = true;
+      const size_t num_pins = eind.size();
+      for (const int u : Vertices(e)) {
+        if (sub_vertex_id[u] >= 0) {
+          eind.push_back(sub_vertex_id[u]);
+        }
+      }
+      if (eind.size() - num_pins < 2) {
+        eind.resize(num_pins);
+        continue;
+      }
+      sub_edge_id[e] = static_cast<int>(hyperedge_weights.size());
+      eptr.push_back(static_cast<CsrOffset>(eind.size()));
+      hyperedge_weights.push_back(ToVector(GetHyperedgeWeights(e)));
+      if (timing_flag_ == true) {
+        hyperedges_slack.push_back(hyperedge_timing_attr_[e]);
+        const auto arcs = GetHyperedgeArcSet(e);
+        arc_ind.insert(arc_ind.end(), arcs.begin(), arcs.end());
+        arc_ptr.push_back(static_cast<CsrOffset>(arc_ind.size()));
+      }
+    }
+  }
+
+  // timing paths with at least two vertices in the sub-hypergraph
+  std::vector<TimingPath> timing_paths;
+  if (timing_flag_ == true) {
+    std::vector<bool> visited_path(num_timing_paths_, false);
+    for (const int v : vertices) {
+      for (const int path_id : TimingPathsThrough(v)) {
+        if (visited_path[path_id] == true) {
+          continue;
+        }
+        visited_path[path_id] = true;
+        TimingPath timing_path;
+        timing_path.slack = path_timing_attr_[path_id];
+        for (const int u : PathVertices(path_id)) {
+          if (sub_vertex_id[u] >= 0) {
+            timing_path.path.push_back(sub_vertex_id[u]);
+          }
+        }
+        if (timing_path.path.size() < 2) {
+          continue;
+        }
+        for (const int e : PathEdges(path_id)) {
+          if (sub_edge_id[e] >= 0) {
+            timing_path.arcs.push_back(sub_edge_id[e]);
+          }
+        }
+        timing_paths.push_back(std::move(timing_path));
+      }
+    }
+  }
+
+  return std::make_shared<Hypergraph>(vertex_dimensions_,
+                                      hyperedge_dimensions_,
+                                      placement_dimensions_,
+                                      std::move(eptr),
+                                      std::move(eind),
+                                      vertex_weights,
+                                      hyperedge_weights,
+                                      fixed_attr,
+                                      community_attr,
+                                      placement_attr,
+                                      vertex_types,
+                                      hyperedges_slack,
+                                      std::move(arc_ptr),
+                                      std::move(arc_ind),
+                                      timing_paths,
+                                      logger_);
+}
+
+std::vector<int> Hypergraph::GetLocalityOrder(const VertexOrder order) const
 {
-  vertex_c_attr_.clear();
-  vertex_c_attr_.resize(GetNumVertices());
+  std::vector<int> vertices(num_vertices_);
+  std::iota(vertices.begin(), vertices.end(), 0);
+  if (order == VertexOrder::PLACEMENT && placement_flag_ == true
+      && placement_dimensions_ > 0) {
+    // quantize the (first two dimensions of the) placement locations and
+    // interleave the bits of the coordinates (Z-order curve)
+    const int num_dims = std::min(placement_dimensions_, 2);
+    std::vector<float> lower(num_dims, std::numeric_limits<float>::max());
+    std::vector<float> upper(num_dims, std::numeric_limits<float>::lowest());
+    for (int v = 0; v < num_vertices_; v++) {
+      const FloatView loc = GetPlacement(v);
+      for (int d = 0; d < num_dims; d++) {
+        lower[d] = std::min(lower[d], loc[d]);
+        upper[d] = std::max(upper[d], loc[d]);
+      }
+    }
+    const int num_bits = 16;
+    const float max_cell = static_cast<float>((1 << num_bits) - 1);
+    std::vector<uint64_t> keys(num_vertices_, 0);
+    for (int v = 0; v < num_vertices_; v++) {
+      const FloatView loc = GetPlacement(v);
+      for (int d = 0; d < num_dims; d++) {
+        const float span = upper[d] - lower[d];
+        const uint64_t cell
+            = span > 0.0 ? static_cast<uint64_t>((loc[d] - lower[d]) / span
+                                                 * max_cell)
+                         : 0;
+        for (int bit = 0; bit < num_bits; bit++) {
+          keys[v] |= ((cell >> bit) & 1) << (bit * num_dims + d);
+        }
+      }
+    }
+    std::stable_sort(vertices.begin(), vertices.end(), [&](int a, int b) {
+      return keys[a] < keys[b];
+    });
+    return vertices;
+  }
+
+  if (order != VertexOrder::RCM) {
+    return vertices;
+  }
+
+  // Cuthill-McKee: BFS over the hyperedges, starting from the vertex with
+  // the minimum degree of each connected component. The vertices reached
+  // from the same vertex are visited by increasing degree. Each hyperedge
+  // is traversed only once, thus the cost is linear in the number of pins
+  auto lambda_degree = [&](int v) { return vptr_[v + 1] - vptr_[v]; };
+  auto lambda_less_degree
+      = [&](int a, int b) { return lambda_degree(a) < lambda_degree(b); };
+  std::vector<int> seeds = vertices;
+  std::stable_sort(seeds.begin(), seeds.end(), lambda_less_degree);
+  std::vector<bool> visited_vertex(num_vertices_, false);
+  std::vector<bool> visited_hyperedge(num_hyperedges_, false);
+  std::vector<int> bfs_order;
+  bfs_order.reserve(num_vertices_);
+  for (const int seed : seeds) {
+    if (visited_vertex[seed] == true) {
+      continue;
+    }
+    visited_vertex[seed] = true;
+    bfs_order.push_back(seed);
+    for (size_t head = bfs_order.size() - 1; head < bfs_order.size(); head++) {
+      const size_t first_new = bfs_order.size();
+      for (const int e : Edges(bfs_order[head])) {
+        if (visited_hyperedge[e] == true) {
+          continue;
+        }
+        visited_hyperedge[e] = true;
+        for (const int u : Vertices(e)) {
+          if (visited_vertex[u] == false) {
+            visited_vertex[u] = true;
+            bfs_order.push_back(u);
+          }
+        }
+      }
+      std::stable_sort(
+          bfs_order.begin() + first_new, bfs_order.end(), lambda_less_degree);
+    }
+  }
+  std::reverse(bfs_order.begin(), bfs_order.end());
+  return bfs_order;
 }
 
 void Hypergraph::ResetHyperedgeTimingAttr()
@@ -255,4 +660,37 @@ void Hypergraph::ResetPathTimingSlack()
   path_timing_attr_.resize(GetNumTimingPaths());
 }
 
+Hypergraph::TimingState Hypergraph::GetTimingState() const
+{
+  return TimingState{hyperedge_timing_attr_,
+                     hyperedge_timing_cost_,
+                     path_timing_attr_,
+                     path_timing_cost_};
+}
+
+void Hypergraph::SetTimingState(TimingState state)
+{
+  hyperedge_timing_attr_ = std::move(state.hyperedge_timing_attr);
+  hyperedge_timing_cost_ = std::move(state.hyperedge_timing_cost);
+  path_timing_attr_ = std::move(state.path_timing_attr);
+  path_timing_cost_ = std::move(state.path_timing_cost);
+}
+
+std::string ToString(const VertexOrder order)
+{
+  switch (order) {
+    case VertexOrder::NONE:
+      return std::string("NONE");
+
+    case VertexOrder::RCM:
+      return std::string("RCM");
+
+    case VertexOrder::PLACEMENT:
+      return std::string("PLACEMENT");
+
+    default:
+      return std::string("NONE");
+  }
+}
+
 }  // namespace par
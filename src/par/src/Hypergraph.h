@@ -44,12 +44,15 @@
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include <boost/range/iterator_range.hpp>
+#include <cstdint>
 #include <functional>
 #include <set>
+#include <string>
 #include <vector>
 
 #include "Utilities.h"
 #include "utl/Logger.h"
+#include "utl/MemoryUsage.h"
 
 // The basic function related to hypergraph should be listed here
 
@@ -58,6 +61,22 @@ namespace par {
 struct Hypergraph;
 using HGraphPtr = std::shared_ptr<Hypergraph>;
 
+// The offsets of the compressed sparse row arrays (eptr, vptr, ...).
+// The number of pins can exceed 2^31 on large designs, while the vertex and
+// hyperedge ids themselves always fit in int
+using CsrOffset = int64_t;
+
+// the order used to renumber the vertices of a hypergraph for locality
+enum class VertexOrder
+{
+  NONE,      // keep the input order
+  RCM,       // reverse Cuthill-McKee, i.e., a BFS over the hyperedges
+  PLACEMENT  // Z-order curve over the placement locations
+};
+
+// function : convert VertexOrder to string
+std::string ToString(VertexOrder order);
+
 // The data structure for critical timing path
 // A timing path is a sequence of vertices, for example, a -> b -> c -> d
 // A timing path can also be viewed a sequence of hypereges,
@@ -102,6 +121,26 @@ class Hypergraph
       const std::vector<std::vector<float>>& placement_attr,
       utl::Logger* logger);
 
+  // The hyperedges can also be specified in compressed sparse row format,
+  // i.e., the vertices of hyperedge e are eind[eptr[e]], ...,
+  // eind[eptr[e + 1] - 1]. eptr and eind are moved into the hypergraph
+  // directly.
+  Hypergraph(
+      int vertex_dimensions,
+      int hyperedge_dimensions,
+      int placement_dimensions,
+      std::vector<CsrOffset> eptr,
+      std::vector<int> eind,
+      const std::vector<std::vector<float>>& vertex_weights,
+      const std::vector<std::vector<float>>& hyperedge_weights,
+      // fixed vertices
+      const std::vector<int>& fixed_attr,  // the block id of fixed vertices.
+      // community attribute
+      const std::vector<int>& community_attr,
+      // placement information
+      const std::vector<std::vector<float>>& placement_attr,
+      utl::Logger* logger);
+
   Hypergraph(
       int vertex_dimensions,
       int hyperedge_dimensions,
@@ -121,7 +160,37 @@ class Hypergraph
                          // to specify this
       // slack information
       const std::vector<float>& hyperedges_slack,
-      const std::vector<std::set<int>>& hyperedges_arc_set,
+      // the timing arcs of hyperedge e are
+      // arc_ind[arc_ptr[e]], ..., arc_ind[arc_ptr[e + 1] - 1]
+      std::vector<CsrOffset> arc_ptr,
+      std::vector<int> arc_ind,
+      const std::vector<TimingPath>& timing_paths,
+      utl::Logger* logger);
+
+  Hypergraph(
+      int vertex_dimensions,
+      int hyperedge_dimensions,
+      int placement_dimensions,
+      std::vector<CsrOffset> eptr,
+      std::vector<int> eind,
+      const std::vector<std::vector<float>>& vertex_weights,
+      const std::vector<std::vector<float>>& hyperedge_weights,
+      // fixed vertices
+      const std::vector<int>& fixed_attr,  // the block id of fixed vertices.
+      // community attribute
+      const std::vector<int>& community_attr,
+      // placement information
+      const std::vector<std::vector<float>>& placement_attr,
+      // the type of each vertex
+      const std::vector<VertexType>&
+          vertex_types,  // except the original timing graph, users do not need
+                         // to specify this
+      // slack information
+      const std::vector<float>& hyperedges_slack,
+      // the timing arcs of hyperedge e are
+      // arc_ind[arc_ptr[e]], ..., arc_ind[arc_ptr[e + 1] - 1]
+      std::vector<CsrOffset> arc_ptr,
+      std::vector<int> arc_ind,
       const std::vector<TimingPath>& timing_paths,
       utl::Logger* logger);
 
@@ -134,15 +203,31 @@ class Hypergraph
 
   std::vector<float> GetTotalVertexWeights() const;
 
-  const std::vector<float>& GetVertexWeights(const int vertex_id) const
+  // the approximate memory (in bytes) used by the arrays of the hypergraph
+  int64_t GetMemoryUsage() const;
+
+  // Add the content of the hypergraph (hyperedges, weights, vertex
+  // attributes and timing paths) to the fingerprint
+  void AddToFingerprint(Fingerprint& fingerprint) const;
+
+  // The weights are stored in a flat array (row-major).
+  // The weights of a vertex (hyperedge) are returned as a view of the array.
+  FloatView GetVertexWeights(const int vertex_id) const
   {
-    return vertex_weights_[vertex_id];
+    auto begin_iter = vertex_weights_.cbegin()
+                      + static_cast<size_t>(vertex_id) * vertex_dimensions_;
+    return boost::make_iterator_range(begin_iter,
+                                      begin_iter + vertex_dimensions_);
   }
-  const Matrix<float>& GetVertexWeights() const { return vertex_weights_; }
 
-  const std::vector<float>& GetHyperedgeWeights(const int edge_id) const
+  void CopyVertexWeights(Matrix<float>& weights) const;
+
+  FloatView GetHyperedgeWeights(const int edge_id) const
   {
-    return hyperedge_weights_[edge_id];
+    auto begin_iter = hyperedge_weights_.cbegin()
+                      + static_cast<size_t>(edge_id) * hyperedge_dimensions_;
+    return boost::make_iterator_range(begin_iter,
+                                      begin_iter + hyperedge_dimensions_);
   }
 
   float GetHyperedgeTimingAttr(const int edge_id) const
@@ -182,21 +267,32 @@ class Hypergraph
     hyperedge_timing_cost_ = costs;
   }
 
-  void ResetVertexCAttr();
-
-  void AddVertexCAttr(int vertex_id, int v)
+  // A clustered hypergraph maps each vertex of the finer hypergraph (the
+  // hypergraph it is contracted from) to its cluster, i.e., the vertex v of
+  // the finer hypergraph belongs to the cluster GetVertexCParent(v)
+  void SetVertexCParent(std::vector<int> vertex_c_parent)
   {
-    vertex_c_attr_[vertex_id].push_back(v);
+    vertex_c_parent_ = std::move(vertex_c_parent);
   }
 
-  const std::vector<int>& GetVertexCAttr(int vertex_id) const
+  int GetVertexCParent(int v) const { return vertex_c_parent_[v]; }
+
+  // the number of vertices in the finer hypergraph
+  int GetNumFinerVertices() const
   {
-    return vertex_c_attr_[vertex_id];
+    return static_cast<int>(vertex_c_parent_.size());
   }
 
-  const std::set<int>& GetHyperedgeArcSet(const int edge_id) const
+  // Project the solution of the clustered hypergraph to the finer hypergraph
+  void ProjectSolution(const std::vector<int>& solution,
+                       std::vector<int>& finer_solution) const;
+
+  // Returns the (sorted, distinct) timing arcs merged into the hyperedge
+  auto GetHyperedgeArcSet(const int edge_id) const
   {
-    return hyperedge_arc_set_[edge_id];
+    auto begin_iter = arc_ind_.cbegin();
+    return boost::make_iterator_range(begin_iter + arc_ptr_[edge_id],
+                                      begin_iter + arc_ptr_[edge_id + 1]);
   }
 
   bool HasFixedVertices() const { return fixed_vertex_flag_; }
@@ -207,6 +303,13 @@ class Hypergraph
 
   void CopyFixedAttr(std::vector<int>& attr) const { attr = fixed_attr_; }
 
+  // an empty attr removes the fixed vertices
+  void SetFixedAttr(const std::vector<int>& attr)
+  {
+    fixed_vertex_flag_ = (static_cast<int>(attr.size()) == num_vertices_);
+    fixed_attr_ = fixed_vertex_flag_ ? attr : std::vector<int>();
+  }
+
   VertexType GetVertexType(const int vertex_id) const
   {
     return vertex_types_[vertex_id];
@@ -231,12 +334,22 @@ class Hypergraph
 
   bool HasTiming() const { return timing_flag_; }
 
-  const std::vector<float>& GetPlacement(const int vertex_id) const
+  FloatView GetPlacement(const int vertex_id) const
   {
-    return placement_attr_[vertex_id];
+    auto begin_iter = placement_attr_.cbegin()
+                      + static_cast<size_t>(vertex_id) * placement_dimensions_;
+    return boost::make_iterator_range(begin_iter,
+                                      begin_iter + placement_dimensions_);
   }
 
-  void CopyPlacement(Matrix<float>& attr) const { attr = placement_attr_; }
+  void CopyPlacement(Matrix<float>& attr) const;
+
+  // Replace the placement information (e.g., by a spectral embedding).
+  // placement_attr is the flattened num_vertices x placement_dimensions
+  // matrix
+  void SetPlacement(int placement_dimensions,
+                    std::vector<float> placement_attr);
+
   float PathTimingCost(const int path_id) const
   {
     return path_timing_cost_[path_id];
@@ -265,6 +378,19 @@ class Hypergraph
 
   void ResetPathTimingSlack();
 
+  // The slacks and timing costs of the hyperedges and paths, which are
+  // saved before the timing is updated for a partitioning solution and
+  // restored afterwards
+  struct TimingState
+  {
+    std::vector<float> hyperedge_timing_attr;
+    std::vector<float> hyperedge_timing_cost;
+    std::vector<float> path_timing_attr;
+    std::vector<float> path_timing_cost;
+  };
+  TimingState GetTimingState() const;
+  void SetTimingState(TimingState state);
+
   // Returns the vertex ids connected by the hyper edge
   auto Vertices(const int edge_id) const
   {
@@ -305,6 +431,20 @@ class Hypergraph
                                       begin_iter + eptr_p_[path_id + 1]);
   }
 
+  // Build the sub-hypergraph induced by the given vertices, i.e., the vertex
+  // i of the sub-hypergraph is vertices[i]. Only the hyperedges (and the
+  // timing paths) with at least two vertices in the sub-hypergraph are kept,
+  // restricted to these vertices.  The fixed, community, placement and timing
+  // attributes are copied from this hypergraph.
+  HGraphPtr GetSubHypergraph(const std::vector<int>& vertices) const;
+
+  // Order the vertices such that the vertices connected by the same
+  // hyperedges (or placed close to each other) get close ids. The result is
+  // a permutation of the vertices, which can be passed to GetSubHypergraph
+  // to renumber the vertices and hyperedges for the locality of the CSR
+  // accesses. VertexOrder::NONE returns the identity
+  std::vector<int> GetLocalityOrder(VertexOrder order) const;
+
   // get balance constraints
   std::vector<std::vector<float>> GetUpperVertexBalance(
       int num_parts,
@@ -323,8 +463,13 @@ class Hypergraph
   const int vertex_dimensions_ = 1;
   const int hyperedge_dimensions_ = 1;
 
-  const Matrix<float> vertex_weights_;
-  const Matrix<float> hyperedge_weights_;  // weights can be negative
+  // the weights of vertex v are
+  // vertex_weights_[v * vertex_dimensions_, (v + 1) * vertex_dimensions_)
+  const std::vector<float> vertex_weights_;
+  // the weights of hyperedge e are
+  // hyperedge_weights_[e * hyperedge_dimensions_,
+  //                    (e + 1) * hyperedge_dimensions_)
+  const std::vector<float> hyperedge_weights_;  // weights can be negative
 
   // slack for hyperedge
   std::vector<float> hyperedge_timing_attr_;
@@ -333,22 +478,24 @@ class Hypergraph
   std::vector<float> hyperedge_timing_cost_;
 
   // map current hyperedge into arcs in timing graph the slack of each
-  // hyperedge e is the minimum_slack_hyperedge_arc_set_[e]
-  std::vector<std::set<int>> hyperedge_arc_set_;
+  // hyperedge e is the minimum slack of the arcs
+  // arc_ind_[arc_ptr_[e]], ..., arc_ind_[arc_ptr_[e + 1] - 1]
+  std::vector<int> arc_ind_;
+  std::vector<CsrOffset> arc_ptr_;
 
   // hyperedges: each hyperedge is a set of vertices
   std::vector<int> eind_;
-  std::vector<int> eptr_;
+  std::vector<CsrOffset> eptr_;
 
   // vertices: each vertex is a set of hyperedges
   std::vector<int> vind_;
-  std::vector<int> vptr_;
+  std::vector<CsrOffset> vptr_;
 
-  // Fill vertex_c_attr which maps the vertex to its corresponding cluster
-  // To simpify the implementation, the vertex_c_attr maps the original larger
-  // hypergraph vertex_c_attr has hgraph->num_vertices_ elements. This is used
-  // during coarsening phase similar to hyperedge_arc_set_
-  std::vector<std::vector<int>> vertex_c_attr_;
+  // vertex_c_parent_ maps the vertices of the finer hypergraph to the
+  // vertices (clusters) of this hypergraph. It is a flat array with one
+  // element for each vertex of the finer hypergraph. This is used during
+  // coarsening phase similar to arc_ind_
+  std::vector<int> vertex_c_parent_;
 
   // fixed vertices.  If fixed_vertex_flag_ = false, fixed_attr_ is empty
   bool fixed_vertex_flag_ = false;  // If there are fixed vertices
@@ -370,8 +517,8 @@ class Hypergraph
   // If placement_flag = false, placement_attr_ is empty
   bool placement_flag_ = false;
   int placement_dimensions_ = 0;
-  // the embedding for vertices
-  std::vector<std::vector<float>> placement_attr_;
+  // the embedding for vertices (flat array, similar to vertex_weights_)
+  std::vector<float> placement_attr_;
 
   // Timing information
   bool timing_flag_ = false;
@@ -379,15 +526,15 @@ class Hypergraph
 
   // All the timing paths connected to the vertex
   std::vector<int> pind_v_;
-  std::vector<int> pptr_v_;
+  std::vector<CsrOffset> pptr_v_;
 
   // view a timing path as a sequence of vertices
   std::vector<int> vind_p_;
-  std::vector<int> vptr_p_;
+  std::vector<CsrOffset> vptr_p_;
 
   // view a timing path as a sequence of arcs
   std::vector<int> eind_p_;
-  std::vector<int> eptr_p_;
+  std::vector<CsrOffset> eptr_p_;
 
   // slack for each timing paths
   std::vector<float> path_timing_attr_;
@@ -395,6 +542,8 @@ class Hypergraph
   std::vector<float> path_timing_cost_;
   // logger information
   utl::Logger* logger_ = nullptr;
+  // charged to the par__hypergraphs memory counter
+  utl::MemoryCharge memory_charge_;
 };
 
 }  // namespace par
@@ -34,6 +34,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "ILPRefine.h"
 
+#include <algorithm>
+
 // ------------------------------------------------------------------------------
 // ILP-based refinement
 // ILP-based hypergraph partitioning cannot optimize path cost
@@ -51,7 +53,7 @@ float IlpRefine::Pass(
     const Matrix<float>& upper_block_balance,
     const Matrix<float>& lower_block_balance,
     Matrix<float>& block_balance,        // the current block balance
-    Matrix<int>& net_degs,               // the current net degree
+    NetDegrees& net_degs,                // the current net degree
     std::vector<float>& cur_paths_cost,  // the current path cost
     Partitions& solution,
     std::vector<bool>& visited_vertices_flag)
@@ -69,17 +71,16 @@ float IlpRefine::Pass(
   std::vector<int> vertices_extracted;
   vertices_extracted.reserve(num_extracted_vertices);
   std::map<int, int> fixed_vertices_extracted;  // vertex_id, block_id
-  std::map<int, int> vertices_extracted_map;    // map the boundary vertices to
-                                                // the extracted vertices
   Matrix<float> vertices_weight_extracted;      // extracted vertex weight
   Matrix<int> hyperedges_extracted;
   std::vector<float> hyperedges_weight_extracted;
   vertices_weight_extracted.reserve(num_extracted_vertices);
+  extracted_ids_.resize(hgraph->GetNumVertices(), -1);
   int vertex_id = 0;
   for (const auto& v : boundary_vertices) {
     vertices_extracted.push_back(v);
-    vertices_extracted_map[v] = vertex_id++;
-    vertices_weight_extracted.push_back(hgraph->GetVertexWeights(v));
+    extracted_ids_[v] = vertex_id++;
+    vertices_weight_extracted.push_back(ToVector(hgraph->GetVertexWeights(v)));
     const int block_id = solution[v];
     block_balance[block_id]
         = block_balance[block_id] - hgraph->GetVertexWeights(v);
@@ -93,34 +94,50 @@ float IlpRefine::Pass(
   }
 
   // get the hyperedge information
-  std::set<int> boundary_hyperedges;
+  std::vector<int> boundary_hyperedges;
   for (const auto& v : boundary_vertices) {
     for (const int edge_id : hgraph->Edges(v)) {
-      boundary_hyperedges.insert(edge_id);
+      boundary_hyperedges.push_back(edge_id);
     }
   }
+  std::sort(boundary_hyperedges.begin(), boundary_hyperedges.end());
+  boundary_hyperedges.erase(
+      std::unique(boundary_hyperedges.begin(), boundary_hyperedges.end()),
+      boundary_hyperedges.end());
   // convert boundary hyperegdes into extracted hyperedges
+  std::vector<int> hyperedge;
   for (const auto& e : boundary_hyperedges) {
-    std::set<int> hyperedge;
+    hyperedge.clear();
     for (const int vertex_id : hgraph->Vertices(e)) {
-      if (vertices_extracted_map.find(vertex_id)
-          == vertices_extracted_map.end()) {
-        hyperedge.insert(part_vertex_id_base + solution[vertex_id]);
-      } else {
-        hyperedge.insert(vertices_extracted_map[vertex_id]);
-      }
+      const int extracted_id = extracted_ids_[vertex_id];
+      hyperedge.push_back(extracted_id == -1
+                              ? part_vertex_id_base + solution[vertex_id]
+                              : extracted_id);
     }
+    std::sort(hyperedge.begin(), hyperedge.end());
+    hyperedge.erase(std::unique(hyperedge.begin(), hyperedge.end()),
+                    hyperedge.end());
     if (hyperedge.size() > 1) {
-      hyperedges_extracted.push_back(
-          std::vector<int>(hyperedge.begin(), hyperedge.end()));
+      hyperedges_extracted.push_back(hyperedge);
       hyperedges_weight_extracted.push_back(
           evaluator_->CalculateHyperedgeCost(e, hgraph));
     }
   }
+  for (const auto& v : boundary_vertices) {
+    extracted_ids_[v] = -1;
+  }
   // get vertex weight dimension
   const int vertex_weight_dimension = hgraph->GetVertexDimensions();
   // call the ILP solver
+  // the current solution is used as the hint
   std::vector<int> solution_extracted;
+  solution_extracted.reserve(vertices_extracted.size());
+  for (int i = 0; i < part_vertex_id_base; i++) {
+    solution_extracted.push_back(solution[vertices_extracted[i]]);
+  }
+  for (int block_id = 0; block_id < num_parts_; block_id++) {
+    solution_extracted.push_back(block_id);
+  }
   if (ILPPartitionInst(num_parts_,
                        vertex_weight_dimension,
                        solution_extracted,
@@ -129,7 +146,12 @@ float IlpRefine::Pass(
                        hyperedges_weight_extracted,
                        vertices_weight_extracted,
                        upper_block_balance,
-                       lower_block_balance)
+                       lower_block_balance,
+                       deadline_ != nullptr
+                           ? deadline_->CapTimeLimit(ilp_time_limit_)
+                           : ilp_time_limit_,
+                       ilp_num_threads_,
+                       ilp_solver_)
       == false) {
     logger_->warn(
         PAR, 115, "ILP-based partitioning cannot find a valid solution.");
@@ -139,12 +161,16 @@ float IlpRefine::Pass(
   // We have this extra step, because the ILP-based partitioning cannot handle
   // path related cost
   std::vector<GainCell> moves_trace;
-  float best_gain = 0.0;
-  float total_gain = 0.0;
+  GainValue best_gain;
+  GainValue total_gain;
   int best_vertex_id = -1;
   for (int i = 0; i < part_vertex_id_base; i++) {
     const int vertex_id = vertices_extracted[i];
     const int to_pid = solution_extracted[i];
+    // the ILP kept the vertex in its block, so there is nothing to move
+    if (to_pid == solution[vertex_id]) {
+      continue;
+    }
     // calculate the gain
     GainCell gain_cell = CalculateVertexGain(vertex_id,
                                              solution[vertex_id],
@@ -171,13 +197,15 @@ float IlpRefine::Pass(
 
   // update the solution to the status with best_gain
   // traverse the moves_trace in the reversing order
+  int num_rollbacks = 0;
   for (auto move_iter = moves_trace.rbegin(); move_iter != moves_trace.rend();
        move_iter++) {
     // stop when we encounter the best_vertex_id
     auto& vertex_move = *move_iter;
-    if (vertex_move->GetVertex() == best_vertex_id) {
+    if (vertex_move.GetVertex() == best_vertex_id) {
       break;  // stop here
     }
+    num_rollbacks++;
     RollBackVertexGain(vertex_move,
                        hgraph,
                        visited_vertices_flag,
@@ -186,7 +214,9 @@ float IlpRefine::Pass(
                        block_balance,
                        net_degs);
   }
-  return best_gain;
+  const int num_moves = static_cast<int>(moves_trace.size());
+  RecordPass(num_moves, num_moves - num_rollbacks, num_moves, GainBuckets{});
+  return best_gain.GetValue();
 }
 
 }  // namespace par
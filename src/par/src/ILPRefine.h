@@ -34,7 +34,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
-#include <set>
+#include <vector>
 
 #include "Refiner.h"
 
@@ -55,7 +55,21 @@ class IlpRefine : public Refiner
  public:
   using Refiner::Refiner;
 
- private:
+  // Create a new refiner with the same parameters (thread-local usage)
+  IlpRefinerPtr Clone() const { return std::make_shared<IlpRefine>(*this); }
+
+  // The wall-clock budget (in seconds, 0 means no limit), the number of
+  // threads and the solver of the ILP for each pass
+  void SetIlpParams(float ilp_time_limit,
+                    int ilp_num_threads,
+                    IlpSolver ilp_solver)
+  {
+    ilp_time_limit_ = ilp_time_limit;
+    ilp_num_threads_ = ilp_num_threads;
+    ilp_solver_ = ilp_solver;
+  }
+
+ protected:
   // In each pass, we only move the boundary vertices
   // here we pass block_balance and net_degrees as reference
   // because we only move a few vertices during each pass
@@ -66,10 +80,19 @@ class IlpRefine : public Refiner
              const Matrix<float>& upper_block_balance,
              const Matrix<float>& lower_block_balance,
              Matrix<float>& block_balance,        // the current block balance
-             Matrix<int>& net_degs,               // the current net degree
+             NetDegrees& net_degs,                // the current net degree
              std::vector<float>& cur_paths_cost,  // the current path cost
              Partitions& solution,
              std::vector<bool>& visited_vertices_flag) override;
+
+ private:
+  float ilp_time_limit_ = 0.0;  // seconds, 0 means no limit
+  int ilp_num_threads_ = 1;
+  IlpSolver ilp_solver_ = IlpSolver::AUTO;
+
+  // extracted_ids_[v] is the id of the boundary vertex v in the extracted
+  // hypergraph, -1 for the other vertices (reset after each pass)
+  std::vector<int> extracted_ids_;
 };
 
 }  // namespace par
@@ -34,7 +34,10 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "KWayFMRefine.h"
 
-#include <thread>
+#include <algorithm>
+#include <cmath>
+
+#include "BucketQueue.h"
 
 // Implement the direct k-way FM refinement
 namespace par {
@@ -58,25 +61,52 @@ KWayFMRefine::KWayFMRefine(const int num_parts,
 {
 }
 
+void KWayFMRefine::SetGainBucketType(const GainBucketType gain_bucket_type,
+                                     const float gain_resolution)
+{
+  gain_bucket_type_ = gain_bucket_type;
+  gain_resolution_ = gain_resolution;
+  gain_buckets_.clear();
+}
+
+GainBuckets& KWayFMRefine::GetGainBuckets(const HGraphPtr& hgraph)
+{
+  if (gain_buckets_.empty() == false) {
+    for (auto& bucket : gain_buckets_) {
+      bucket->Reset(hgraph);
+    }
+    return gain_buckets_;
+  }
+  gain_buckets_.reserve(num_parts_);
+  for (int i = 0; i < num_parts_; ++i) {
+    // the maxinum size of each bucket is hgraph->GetNumVertices()
+    if (gain_bucket_type_ == GainBucketType::BUCKET_LIST) {
+      gain_buckets_.push_back(
+          std::make_shared<BucketQueue>(hgraph->GetNumVertices(),
+                                        total_corking_passes_,
+                                        gain_resolution_,
+                                        hgraph));
+    } else {
+      gain_buckets_.push_back(std::make_shared<PriorityQueue>(
+          hgraph->GetNumVertices(), total_corking_passes_, hgraph));
+    }
+  }
+  return gain_buckets_;
+}
+
 // In each pass, we only move the boundary vertices
 float KWayFMRefine::Pass(
     const HGraphPtr& hgraph,
     const Matrix<float>& upper_block_balance,
     const Matrix<float>& lower_block_balance,
     Matrix<float>& block_balance,        // the current block balance
-    Matrix<int>& net_degs,               // the current net degree
+    NetDegrees& net_degs,                // the current net degree
     std::vector<float>& cur_paths_cost,  // the current path cost
     Partitions& solution,
     std::vector<bool>& visited_vertices_flag)
 {
   // initialize the gain buckets
-  GainBuckets buckets;
-  for (int i = 0; i < num_parts_; ++i) {
-    // the maxinum size of each bucket is hgraph->GetNumVertices()
-    auto bucket = std::make_shared<PriorityQueue>(
-        hgraph->GetNumVertices(), total_corking_passes_, hgraph);
-    buckets.push_back(bucket);
-  }
+  GainBuckets& buckets = GetGainBuckets(hgraph);
   // identify all the boundary vertices
   // fixed vertices will not be identified as boundary vertices
   std::vector<int> boundary_vertices
@@ -94,30 +124,40 @@ float KWayFMRefine::Pass(
   // Based on our experiments, the moves is usually very limited.
   // Restoring from backwards will be more efficient
   std::vector<GainCell> moves_trace;  // store the moved vertex_gain in sequence
-  float total_delta_gain = 0.0;
+  moves_trace.reserve(max_move_);
+  GainValue total_delta_gain;
   // Trick here:  We can adjust the best_gain to value to decide whether we
   // should accept a worse solution If the current solution violates the balance
   // constraint, we have to accept the worse solution to get a balanced solution
   // Otherwise we should only accept better solutions
-  float best_gain = 0.0;
+  GainValue best_gain;
   for (int block_id = 0; block_id < num_parts_; block_id++) {
-    if (upper_block_balance[block_id] < block_balance[block_id]
-        || block_balance[block_id] < lower_block_balance[block_id]) {
-      best_gain = -std::numeric_limits<float>::max();
+    if (CheckBlockBalance(block_id,
+                          block_balance,
+                          upper_block_balance,
+                          lower_block_balance)
+        == false) {
+      best_gain = GainValue::Lowest();
       break;
     }
   }
 
   int best_vertex_id = -1;  // dummy best vertex id
+  int64_t gain_updates = 0;  // for profiling
+  AdaptiveStoppingRule stopping_rule(
+      adaptive_stop_alpha_, std::log(std::max(hgraph->GetNumVertices(), 1)));
   // main loop of FM pass
   for (int i = 0; i < max_move_; i++) {
+    if (CheckDeadline(i)) {
+      break;  // roll back to the best prefix of the moves below
+    }
     auto candidate = PickMoveKWay(buckets,
                                   hgraph,
                                   block_balance,
                                   upper_block_balance,
                                   lower_block_balance);
     // check the status of candidate
-    const int vertex = candidate->GetVertex();  // candidate vertex
+    const int vertex = candidate.GetVertex();  // candidate vertex
     if (vertex < 0) {
       break;  // no valid vertex found
     }
@@ -131,41 +171,50 @@ float KWayFMRefine::Pass(
                    net_degs,
                    cur_paths_cost,
                    solution);
-    std::vector<int> neighbors
-        = FindNeighbors(hgraph, vertex, visited_vertices_flag);
+    const std::vector<int>& neighbors
+        = FindNeighbors(hgraph, candidate, net_degs, visited_vertices_flag);
     // update the neighbors of v for all gain buckets in parallel
-    std::vector<std::thread> threads;
-    threads.reserve(num_parts_);
-    for (int to_pid = 0; to_pid < num_parts_; to_pid++) {
-      threads.emplace_back(&KWayFMRefine::UpdateSingleGainBucket,
-                           this,
-                           to_pid,
-                           std::ref(buckets),
-                           hgraph,
-                           std::ref(neighbors),
-                           std::ref(net_degs),
-                           std::ref(cur_paths_cost),
-                           std::ref(solution));
-    }
-    for (auto& t : threads) {
-      t.join();  // wait for all threads to finish
-    }
-    threads.clear();
+    ParallelForChunks(
+        GetThreadPool(neighbors.size()),
+        num_parts_,
+        2,
+        [&](int begin, int end) {
+          for (int to_pid = begin; to_pid < end; to_pid++) {
+            UpdateSingleGainBucket(to_pid,
+                                   buckets,
+                                   hgraph,
+                                   neighbors,
+                                   net_degs,
+                                   cur_paths_cost,
+                                   solution);
+          }
+        });
+    gain_updates += static_cast<int64_t>(neighbors.size()) * num_parts_;
     if (total_delta_gain >= best_gain) {
       best_gain = total_delta_gain;
       best_vertex_id = vertex;
+      stopping_rule.Reset();
+    } else if (adaptive_stop_alpha_ > 0.0) {
+      stopping_rule.AddGain(candidate.GetGain());
+      if (stopping_rule.ShouldStop()) {
+        // the remaining moves are unlikely to find a better solution
+        RecordSavedMoves(max_move_ - i - 1);
+        break;
+      }
     }
   }
 
   // find the best solution and restore the status which achieves the best
   // solution traverse the moves_trace in the reversing order
+  int num_rollbacks = 0;
   for (auto move_iter = moves_trace.rbegin(); move_iter != moves_trace.rend();
        move_iter++) {
     // stop when we encounter the best_vertex_id
     auto& vertex_move = *move_iter;
-    if (vertex_move->GetVertex() == best_vertex_id) {
+    if (vertex_move.GetVertex() == best_vertex_id) {
       break;  // stop here
     }
+    num_rollbacks++;
     RollBackVertexGain(vertex_move,
                        hgraph,
                        visited_vertices_flag,
@@ -175,6 +224,8 @@ float KWayFMRefine::Pass(
                        net_degs);
   }
 
+  const int num_moves = static_cast<int>(moves_trace.size());
+  RecordPass(num_moves, num_moves - num_rollbacks, gain_updates, buckets);
   // clear the move traces
   moves_trace.clear();
   // clear the buckets
@@ -182,7 +233,7 @@ float KWayFMRefine::Pass(
     buckets[block_id]->Clear();
   }
 
-  return best_gain;
+  return best_gain.GetValue();
 }
 
 // gain bucket related functions
@@ -192,29 +243,27 @@ void KWayFMRefine::InitializeGainBucketsKWay(
     GainBuckets& buckets,
     const HGraphPtr& hgraph,
     const std::vector<int>& boundary_vertices,
-    const Matrix<int>& net_degs,
+    const NetDegrees& net_degs,
     const std::vector<float>& cur_paths_cost,
     const Partitions& solution) const
 {
-  std::vector<std::thread> threads;  // for parallel updating
-  threads.reserve(num_parts_);
   // parallel initialize the num_parts gain_buckets
-  for (int to_pid = 0; to_pid < num_parts_; to_pid++) {
-    threads.emplace_back(
-        &KWayFMRefine::InitializeSingleGainBucket,
-        this,
-        std::ref(buckets),
-        to_pid,
-        hgraph,
-        std::ref(boundary_vertices),  // we only consider boundary vertices
-        std::ref(net_degs),
-        std::ref(cur_paths_cost),
-        std::ref(solution));
-  }
-  for (auto& t : threads) {
-    t.join();  // wait for all threads to finish
-  }
-  threads.clear();
+  ParallelForChunks(
+      GetThreadPool(boundary_vertices.size()),
+      num_parts_,
+      2,
+      [&](int begin, int end) {
+        for (int to_pid = begin; to_pid < end; to_pid++) {
+          InitializeSingleGainBucket(
+              buckets,
+              to_pid,
+              hgraph,
+              boundary_vertices,  // we only consider boundary vertices
+              net_degs,
+              cur_paths_cost,
+              solution);
+        }
+      });
 }
 
 // Initialize the single bucket
@@ -223,7 +272,7 @@ void KWayFMRefine::InitializeSingleGainBucket(
     int to_pid,  // move the vertex into this block (block_id = to_pid)
     const HGraphPtr& hgraph,
     const std::vector<int>& boundary_vertices,
-    const Matrix<int>& net_degs,
+    const NetDegrees& net_degs,
     const std::vector<float>& cur_paths_cost,
     const Partitions& solution) const
 {
@@ -246,7 +295,7 @@ void KWayFMRefine::InitializeSingleGainBucket(
 }
 
 // Determine which vertex gain to be picked
-std::shared_ptr<VertexGain> KWayFMRefine::PickMoveKWay(
+GainCell KWayFMRefine::PickMoveKWay(
     GainBuckets& buckets,
     const HGraphPtr& hgraph,
     const Matrix<float>& curr_block_balance,
@@ -255,25 +304,24 @@ std::shared_ptr<VertexGain> KWayFMRefine::PickMoveKWay(
 {
   // dummy candidate
   int to_pid = -1;
-  auto candidate = std::make_shared<VertexGain>();
+  GainValue candidate_gain = GainValue::Lowest();
 
   // best gain bucket for "corking effect".
   // i.e., if there is no normal candidate available,
   // we will traverse the best_to_pid bucket
   int best_to_pid = -1;  // block id with best_gain
-  float best_gain = -std::numeric_limits<float>::max();
-  auto dummy_cell = std::make_shared<VertexGain>();
+  GainValue best_gain = GainValue::Lowest();
 
   // checking the first elements in each bucket
   for (int i = 0; i < num_parts_; ++i) {
     if (buckets[i]->GetStatus() == false) {
       continue;  // This bucket is empty
     }
-    auto ele = buckets[i]->GetMax();
-    const int vertex = ele->GetVertex();
-    const float gain = ele->GetGain();
-    const int from_pid = ele->GetSourcePart();
-    if ((gain > candidate->GetGain())
+    const GainCell& ele = buckets[i]->GetMax();
+    const int vertex = ele.GetVertex();
+    const GainValue& gain = ele.GetGainValue();
+    const int from_pid = ele.GetSourcePart();
+    if ((gain > candidate_gain)
         && CheckVertexMoveLegality(vertex,
                                    i,
                                    from_pid,
@@ -283,7 +331,7 @@ std::shared_ptr<VertexGain> KWayFMRefine::PickMoveKWay(
                                    lower_block_balance)
                == true) {
       to_pid = i;
-      candidate = ele;
+      candidate_gain = gain;
     }
     // record part for solving corking effect
     if (gain > best_gain) {
@@ -292,28 +340,37 @@ std::shared_ptr<VertexGain> KWayFMRefine::PickMoveKWay(
     }
   }
   // Case 1:  if there is a candidate available or no vertex to move
-  if (to_pid > -1 || best_to_pid == -1) {
-    return candidate;
+  if (to_pid > -1) {
+    return buckets[to_pid]->GetMax();
+  }
+  if (best_to_pid == -1) {
+    return GainCell();  // return the dummy cell
   }
   // Case 2:  "corking effect", i.e., no candidate
-  return buckets.at(best_to_pid)
-      ->GetBestCandidate(
-          curr_block_balance, upper_block_balance, lower_block_balance, hgraph);
+  return buckets.at(best_to_pid)->GetBestCandidate([&](const GainCell& cell) {
+    return CheckVertexMoveLegality(cell.GetVertex(),
+                                   cell.GetDestinationPart(),
+                                   cell.GetSourcePart(),
+                                   hgraph,
+                                   curr_block_balance,
+                                   upper_block_balance,
+                                   lower_block_balance);
+  });
 }
 
 // move one vertex based on the calculated gain_cell
-void KWayFMRefine::AcceptKWayMove(const std::shared_ptr<VertexGain>& gain_cell,
+void KWayFMRefine::AcceptKWayMove(const GainCell& gain_cell,
                                   GainBuckets& gain_buckets,
                                   std::vector<GainCell>& moves_trace,
-                                  float& total_delta_gain,
+                                  GainValue& total_delta_gain,
                                   std::vector<bool>& visited_vertices_flag,
                                   const HGraphPtr& hgraph,
                                   Matrix<float>& curr_block_balance,
-                                  Matrix<int>& net_degs,
+                                  NetDegrees& net_degs,
                                   std::vector<float>& cur_paths_cost,
                                   std::vector<int>& solution) const
 {
-  const int vertex_id = gain_cell->GetVertex();
+  const int vertex_id = gain_cell.GetVertex();
   moves_trace.push_back(gain_cell);
   AcceptVertexGain(gain_cell,
                    hgraph,
@@ -324,17 +381,10 @@ void KWayFMRefine::AcceptKWayMove(const std::shared_ptr<VertexGain>& gain_cell,
                    curr_block_balance,
                    net_degs);
   // Remove vertex from all buckets where vertex is present
-  std::vector<std::thread> deletion_threads;
-  deletion_threads.reserve(num_parts_);
+  // Each deletion only costs O(log n), so it is cheaper to do it inline
+  // than to dispatch it to the thread pool
   for (int i = 0; i < num_parts_; ++i) {
-    deletion_threads.emplace_back(&par::KWayFMRefine::HeapEleDeletion,
-                                  this,
-                                  vertex_id,
-                                  i,
-                                  std::ref(gain_buckets));
-  }
-  for (auto& th : deletion_threads) {
-    th.join();
+    HeapEleDeletion(vertex_id, i, gain_buckets);
   }
 }
 
@@ -356,7 +406,7 @@ void KWayFMRefine::UpdateSingleGainBucket(
     GainBuckets& buckets,
     const HGraphPtr& hgraph,
     const std::vector<int>& neighbors,
-    const Matrix<int>& net_degs,
+    const NetDegrees& net_degs,
     const std::vector<float>& cur_paths_cost,
     const Partitions& solution) const
 {
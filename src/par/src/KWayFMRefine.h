@@ -61,6 +61,15 @@ class KWayFMRefine : public Refiner
       EvaluatorPtr evaluator,
       utl::Logger* logger);
 
+  // Create a new refiner with the same parameters (thread-local usage)
+  // The gain buckets are not shared with the new refiner
+  KWayFMRefinerPtr Clone() const
+  {
+    auto refiner = std::make_shared<KWayFMRefine>(*this);
+    refiner->gain_buckets_.clear();
+    return refiner;
+  }
+
   // Mark these two functions as public.
   // Because they will be called by multi-threading
   // Initialize the single bucket
@@ -69,7 +78,7 @@ class KWayFMRefine : public Refiner
       int to_pid,  // move the vertex into this block (block_id = to_pid)
       const HGraphPtr& hgraph,
       const std::vector<int>& boundary_vertices,
-      const Matrix<int>& net_degs,
+      const NetDegrees& net_degs,
       const std::vector<float>& cur_paths_cost,
       const Partitions& solution) const;
 
@@ -81,18 +90,28 @@ class KWayFMRefine : public Refiner
                               GainBuckets& buckets,
                               const HGraphPtr& hgraph,
                               const std::vector<int>& neighbors,
-                              const Matrix<int>& net_degs,
+                              const NetDegrees& net_degs,
                               const std::vector<float>& cur_paths_cost,
                               const Partitions& solution) const;
 
+  // Select the data structure of the gain buckets.
+  // gain_resolution is the width of each bucket for GainBucketType::BUCKET_LIST
+  void SetGainBucketType(GainBucketType gain_bucket_type,
+                         float gain_resolution);
+
  protected:
+  // Get one empty gain bucket for each block.
+  // The gain buckets are kept by the refiner and reused across passes,
+  // so the memory of the vertex gains is only allocated once
+  GainBuckets& GetGainBuckets(const HGraphPtr& hgraph);
+
   // The main function for the FM-based refinement
   // In each pass, we only move the boundary vertices
   float Pass(const HGraphPtr& hgraph,
              const Matrix<float>& upper_block_balance,
              const Matrix<float>& lower_block_balance,
              Matrix<float>& block_balance,        // the current block balance
-             Matrix<int>& net_degs,               // the current net degree
+             NetDegrees& net_degs,                // the current net degree
              std::vector<float>& cur_paths_cost,  // the current path cost
              Partitions& solution,
              std::vector<bool>& visited_vertices_flag) override;
@@ -102,27 +121,26 @@ class KWayFMRefine : public Refiner
   void InitializeGainBucketsKWay(GainBuckets& buckets,
                                  const HGraphPtr& hgraph,
                                  const std::vector<int>& boundary_vertices,
-                                 const Matrix<int>& net_degs,
+                                 const NetDegrees& net_degs,
                                  const std::vector<float>& cur_paths_cost,
                                  const Partitions& solution) const;
 
   // Determine which vertex gain to be picked
-  std::shared_ptr<VertexGain> PickMoveKWay(
-      GainBuckets& buckets,
-      const HGraphPtr& hgraph,
-      const Matrix<float>& curr_block_balance,
-      const Matrix<float>& upper_block_balance,
-      const Matrix<float>& lower_block_balance) const;
+  GainCell PickMoveKWay(GainBuckets& buckets,
+                        const HGraphPtr& hgraph,
+                        const Matrix<float>& curr_block_balance,
+                        const Matrix<float>& upper_block_balance,
+                        const Matrix<float>& lower_block_balance) const;
 
   // move one vertex based on the calculated gain_cell
-  void AcceptKWayMove(const std::shared_ptr<VertexGain>& gain_cell,
+  void AcceptKWayMove(const GainCell& gain_cell,
                       GainBuckets& gain_buckets,
                       std::vector<GainCell>& moves_trace,
-                      float& total_delta_gain,
+                      GainValue& total_delta_gain,
                       std::vector<bool>& visited_vertices_flag,
                       const HGraphPtr& hgraph,
                       Matrix<float>& curr_block_balance,
-                      Matrix<int>& net_degs,
+                      NetDegrees& net_degs,
                       std::vector<float>& cur_paths_cost,
                       std::vector<int>& solution) const;
 
@@ -133,6 +151,9 @@ class KWayFMRefine : public Refiner
   // variables
   int total_corking_passes_ = 25;  // the maximum level of traversing the
                                    // buckets to solve the "corking effect"
+  GainBucketType gain_bucket_type_ = GainBucketType::PRIORITY_QUEUE;
+  float gain_resolution_ = 1.0;  // the width of each bucket in the bucket list
+  GainBuckets gain_buckets_;     // reused across passes
 };
 
 }  // namespace par
@@ -34,7 +34,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "KWayPMRefine.h"
 
-#include <thread>
+#include <atomic>
 
 // ------------------------------------------------------------------------------
 // K-way pair-wise FM refinement
@@ -62,7 +62,7 @@ float KWayPMRefine::Pass(
     const Matrix<float>& upper_block_balance,
     const Matrix<float>& lower_block_balance,
     Matrix<float>& block_balance,    // the current block balance
-    Matrix<int>& net_degs,           // the current net degree
+    NetDegrees& net_degs,            // the current net degree
     std::vector<float>& paths_cost,  // the current path cost
     Partitions& solution,
     std::vector<bool>& visited_vertices_flag)
@@ -73,16 +73,32 @@ float KWayPMRefine::Pass(
   std::map<std::pair<int, int>, float> matching_connectivity
       = evaluator_->GetMatchingConnectivity(hgraph, solution);
   CalculateMaximumMatch(maximum_matches, matching_connectivity);
-  float delta_gain = 0.0;
   // Step 2: update the solution based on calculated maximum matching
-  // initialize the gain buckets
-  GainBuckets buckets;
-  for (int i = 0; i < num_parts_; ++i) {
-    // the maxinum size of each bucket is hgraph->GetNumVertices()
-    auto bucket = std::make_shared<PriorityQueue>(
-        hgraph->GetNumVertices(), total_corking_passes_, hgraph);
-    buckets.push_back(bucket);
+  // The disjoint block pairs of large hypergraphs are refined independently
+  // (concurrently if possible), so the solution does not depend on the
+  // number of threads
+  if (hgraph->GetNumVertices() >= parallel_pairs_threshold_
+      && maximum_matches.size() > 1) {
+    int num_workers = 1;
+    if (thread_pool_ != nullptr) {
+      // the calling thread also works on the pairs
+      num_workers = std::min(thread_pool_->GetNumThreads() + 1,
+                             static_cast<int>(maximum_matches.size()));
+    }
+    return ParallelPairFM(hgraph,
+                          upper_block_balance,
+                          lower_block_balance,
+                          block_balance,
+                          net_degs,
+                          paths_cost,
+                          solution,
+                          visited_vertices_flag,
+                          maximum_matches,
+                          num_workers);
   }
+  float delta_gain = 0.0;
+  // initialize the gain buckets
+  GainBuckets& buckets = GetGainBuckets(hgraph);
   for (const auto& partition_pair : maximum_matches) {
     // after performing FM, the corresponding buckets will be cleared
     delta_gain += PerformPairFM(hgraph,
@@ -109,7 +125,7 @@ float KWayPMRefine::Pass(
 float KWayPMRefine::Pass(const HGraphPtr hgraph,
                            const Matrix<float>& max_block_balance,
                            Matrix<float>& block_balance, // the current block
-balance Matrix<int>& net_degs, // the current net degree std::vector<float>&
+balance NetDegrees& net_degs, // the current net degree std::vector<float>&
 paths_cost, // the current path cost Partitions& solution, std::vector<bool>&
 visited_vertices_flag)
 {
@@ -138,15 +154,7 @@ evaluator_->GetMatchingConnectivity(hgraph, solution);
   float delta_gain = 0.0;
   // Step 2: update the solution based on calculated maximum matching
   // initialize the gain buckets
-  GainBuckets buckets;
-  for (int i = 0; i < num_parts_; ++i) {
-    // the maxinum size of each bucket is hgraph->GetNumVertices()
-    GainBucket bucket
-        = std::make_shared<PriorityQueue>(hgraph->GetNumVertices(),
-                                          total_corking_passes_,
-                                          hgraph);
-    buckets.push_back(bucket);
-  }
+  GainBuckets& buckets = GetGainBuckets(hgraph);
   for (const auto& partition_pair : maximum_matches) {
     // after performing FM, the corresponding buckets will be cleared
     delta_gain += PerformPairFM(hgraph, max_block_balance, block_balance,
@@ -156,6 +164,102 @@ net_degs, paths_cost, solution, buckets, visited_vertices_flag, partition_pair);
 }
 */
 
+// The block pairs are disjoint, so the pair-wise FM of one pair only
+// moves the vertices of its own blocks.  Each worker refines its pairs
+// on a private copy of the state and restores the copy after each pair,
+// such that every pair starts from the state at the beginning of the pass.
+// The accepted moves are merged into the state in the order of the pairs.
+float KWayPMRefine::ParallelPairFM(
+    const HGraphPtr& hgraph,
+    const Matrix<float>& upper_block_balance,
+    const Matrix<float>& lower_block_balance,
+    Matrix<float>& block_balance,    // the current block balance
+    NetDegrees& net_degs,            // the current net degree
+    std::vector<float>& paths_cost,  // the current path cost
+    Partitions& solution,
+    std::vector<bool>& visited_vertices_flag,
+    const std::vector<std::pair<int, int>>& maximum_matches,
+    const int num_workers)
+{
+  // each worker has its own gain buckets
+  while (static_cast<int>(worker_refiners_.size()) < num_workers) {
+    worker_refiners_.push_back(Clone());
+  }
+
+  const int num_pairs = static_cast<int>(maximum_matches.size());
+  std::vector<std::vector<GainCell>> pair_moves(num_pairs);
+  std::atomic<int> next_pair = 0;
+  auto lambda_worker = [&](int worker_id) -> void {
+    KWayPMRefine& refiner = *worker_refiners_[worker_id];
+    GainBuckets& buckets = refiner.GetGainBuckets(hgraph);
+    refiner.CopyRefinementState(*this);
+    // thread-local copy of the state
+    Matrix<float> local_block_balance = block_balance;
+    NetDegrees local_net_degs = net_degs;
+    std::vector<float> local_paths_cost = paths_cost;
+    Partitions local_solution = solution;
+    std::vector<bool> local_visited_vertices_flag = visited_vertices_flag;
+    for (int id = next_pair++; id < num_pairs; id = next_pair++) {
+      std::vector<GainCell>& moves = pair_moves[id];
+      refiner.PerformPairFM(hgraph,
+                            upper_block_balance,
+                            lower_block_balance,
+                            local_block_balance,
+                            local_net_degs,
+                            local_paths_cost,
+                            local_solution,
+                            buckets,
+                            local_visited_vertices_flag,
+                            maximum_matches[id],
+                            &moves);
+      // restore the state for the next pair
+      for (auto move_iter = moves.rbegin(); move_iter != moves.rend();
+           move_iter++) {
+        refiner.RollBackVertexGain(*move_iter,
+                                   hgraph,
+                                   local_visited_vertices_flag,
+                                   local_solution,
+                                   local_paths_cost,
+                                   local_block_balance,
+                                   local_net_degs);
+      }
+    }
+  };
+  if (num_workers > 1) {
+    thread_pool_->ParallelFor(num_workers, lambda_worker);
+  } else {
+    lambda_worker(0);
+  }
+
+  // merge the accepted moves of all the pairs
+  GainValue delta_gain;
+  for (const auto& moves : pair_moves) {
+    for (const auto& move : moves) {
+      AcceptVertexGain(move,
+                       hgraph,
+                       delta_gain,
+                       visited_vertices_flag,
+                       solution,
+                       paths_cost,
+                       block_balance,
+                       net_degs);
+    }
+  }
+  // The change of the path cost is calculated within the pair. A timing path
+  // may go through the blocks of different pairs, so the cost of the paths
+  // through the moved vertices is recalculated on the merged solution
+  if (hgraph->GetNumTimingPaths() > 0) {
+    for (const auto& moves : pair_moves) {
+      for (const auto& move : moves) {
+        for (const int path_id : hgraph->TimingPathsThrough(move.GetVertex())) {
+          paths_cost[path_id] = CalculatePathCost(path_id, hgraph, solution);
+        }
+      }
+    }
+  }
+  return delta_gain.GetValue();
+}
+
 // The function to calculate the matching_scores
 void KWayPMRefine::CalculateMaximumMatch(
     std::vector<std::pair<int, int>>& maximum_matches,
@@ -200,12 +304,13 @@ float KWayPMRefine::PerformPairFM(
     const Matrix<float>& upper_block_balance,
     const Matrix<float>& lower_block_balance,
     Matrix<float>& block_balance,    // the current block balance
-    Matrix<int>& net_degs,           // the current net degree
+    NetDegrees& net_degs,            // the current net degree
     std::vector<float>& paths_cost,  // the current path cost
     Partitions& solution,
     GainBuckets& buckets,
     std::vector<bool>& visited_vertices_flag,
-    const std::pair<int, int>& partition_pair) const
+    const std::pair<int, int>& partition_pair,
+    std::vector<GainCell>* accepted_moves) const
 {
   // clear the buckets
   std::vector<int> blocks{partition_pair.first, partition_pair.second};
@@ -230,14 +335,19 @@ float KWayPMRefine::PerformPairFM(
   // Based on our experiments, the moves is usually very limited.
   // Restoring from backwards will be more efficient
   std::vector<GainCell> moves_trace;  // store the moved vertex_gain in sequence
-  float total_delta_gain = 0.0;
+  moves_trace.reserve(max_move_);
+  GainValue total_delta_gain;
   // Notice that the best_gain should be initialized as 0 instead of -infinity
   // because after each pass, the total gain should be improved, i.e.,
   // best_gain must be >= 0.0.
-  float best_gain = 0.0;
+  GainValue best_gain;
   int best_vertex_id = -1;  // dummy best vertex id
+  int64_t gain_updates = 0;  // for profiling
   // main loop of FM pass
   for (int i = 0; i < max_move_; i++) {
+    if (CheckDeadline(i)) {
+      break;  // roll back to the best prefix of the moves below
+    }
     // here we use the PickMoveKWay method inheriting from KWayPMRefine
     // directly, because the buckets cooresponding to other blocks are empty
     // Similarly, we can also use AcceptKWayMove method inheriting from
@@ -248,7 +358,7 @@ float KWayPMRefine::PerformPairFM(
                                   upper_block_balance,
                                   lower_block_balance);
     // check the status of candidate
-    const int vertex = candidate->GetVertex();  // candidate vertex
+    const int vertex = candidate.GetVertex();  // candidate vertex
     if (vertex < 0) {
       break;  // no valid vertex found
     }
@@ -263,26 +373,29 @@ float KWayPMRefine::PerformPairFM(
                    paths_cost,
                    solution);
     // find the neighbors of vertex in partition_pair blocks
-    const std::vector<int> neighbors = FindNeighbors(
-        hgraph, vertex, visited_vertices_flag, solution, partition_pair);
+    const std::vector<int>& neighbors = FindNeighbors(hgraph,
+                                                      candidate,
+                                                      net_degs,
+                                                      visited_vertices_flag,
+                                                      solution,
+                                                      partition_pair);
     // update the neighbors of v for all gain buckets in parallel
-    std::vector<std::thread> threads;
-    threads.reserve(blocks.size());
-    for (auto& to_pid : blocks) {
-      threads.emplace_back(&KWayFMRefine::UpdateSingleGainBucket,
-                           this,
-                           to_pid,
-                           std::ref(buckets),
-                           hgraph,
-                           std::ref(neighbors),
-                           std::ref(net_degs),
-                           std::ref(paths_cost),
-                           std::ref(solution));
-    }
-    for (auto& t : threads) {
-      t.join();  // wait for all threads to finish
-    }
-    threads.clear();
+    ParallelForChunks(
+        GetThreadPool(neighbors.size()),
+        static_cast<int>(blocks.size()),
+        2,
+        [&](int begin, int end) {
+          for (int i = begin; i < end; i++) {
+            UpdateSingleGainBucket(blocks[i],
+                                   buckets,
+                                   hgraph,
+                                   neighbors,
+                                   net_degs,
+                                   paths_cost,
+                                   solution);
+          }
+        });
+    gain_updates += static_cast<int64_t>(neighbors.size()) * blocks.size();
     if (total_delta_gain >= best_gain) {
       best_gain = total_delta_gain;
       best_vertex_id = vertex;
@@ -290,13 +403,15 @@ float KWayPMRefine::PerformPairFM(
   }
 
   // traverse the moves_trace in the reversing order
+  int num_rollbacks = 0;
   for (auto move_iter = moves_trace.rbegin(); move_iter != moves_trace.rend();
        move_iter++) {
     // stop when we encounter the best_vertex_id
     auto& vertex_move = *move_iter;
-    if (vertex_move->GetVertex() == best_vertex_id) {
+    if (vertex_move.GetVertex() == best_vertex_id) {
       break;  // stop here
     }
+    num_rollbacks++;
     RollBackVertexGain(vertex_move,
                        hgraph,
                        visited_vertices_flag,
@@ -306,6 +421,13 @@ float KWayPMRefine::PerformPairFM(
                        net_degs);
   }
 
+  const int num_moves = static_cast<int>(moves_trace.size());
+  RecordPass(num_moves, num_moves - num_rollbacks, gain_updates, buckets);
+  if (accepted_moves != nullptr) {
+    // the rolled-back moves are at the end of moves_trace
+    moves_trace.resize(num_moves - num_rollbacks);
+    accepted_moves->swap(moves_trace);
+  }
   // clear the move traces
   moves_trace.clear();
   // clear the buckets
@@ -313,7 +435,7 @@ float KWayPMRefine::PerformPairFM(
     buckets[block_id]->Clear();
   }
 
-  return best_gain;
+  return best_gain.GetValue();
 }
 
 // gain bucket related functions
@@ -322,32 +444,29 @@ void KWayPMRefine::InitializeGainBucketsPM(
     GainBuckets& buckets,
     const HGraphPtr& hgraph,
     const std::vector<int>& boundary_vertices,
-    const Matrix<int>& net_degs,
+    const NetDegrees& net_degs,
     const std::vector<float>& cur_paths_cost,
     const Partitions& solution,
     const std::pair<int, int>& partition_pair) const
 {
   std::vector<int> blocks_id{partition_pair.first, partition_pair.second};
-  std::vector<std::thread> threads;  // for parallel updating
-  threads.reserve(blocks_id.size());
-
-  // parallel initialize the num_parts gain_buckets
-  for (const auto to_pid : blocks_id) {
-    threads.emplace_back(
-        &KWayFMRefine::InitializeSingleGainBucket,
-        this,
-        std::ref(buckets),
-        to_pid,
-        hgraph,
-        std::ref(boundary_vertices),  // we only consider boundary vertices
-        std::ref(net_degs),
-        std::ref(cur_paths_cost),
-        std::ref(solution));
-  }
-  for (auto& t : threads) {
-    t.join();  // wait for all threads to finish
-  }
-  threads.clear();
+  // parallel initialize the gain_buckets of the two blocks
+  ParallelForChunks(
+      GetThreadPool(boundary_vertices.size()),
+      static_cast<int>(blocks_id.size()),
+      2,
+      [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+          InitializeSingleGainBucket(
+              buckets,
+              blocks_id[i],
+              hgraph,
+              boundary_vertices,  // we only consider boundary vertices
+              net_degs,
+              cur_paths_cost,
+              solution);
+        }
+      });
 }
 
 }  // namespace par
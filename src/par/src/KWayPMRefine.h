@@ -60,6 +60,16 @@ class KWayPMRefine : public KWayFMRefine
  public:
   using KWayFMRefine::KWayFMRefine;
 
+  // Create a new refiner with the same parameters (thread-local usage)
+  // The gain buckets are not shared with the new refiner
+  KWayPMRefinerPtr Clone() const
+  {
+    auto refiner = std::make_shared<KWayPMRefine>(*this);
+    refiner->gain_buckets_.clear();
+    refiner->worker_refiners_.clear();
+    return refiner;
+  }
+
  private:
   // In each pass, we only move the boundary vertices
   // here we pass block_balance and net_degrees as reference
@@ -71,7 +81,7 @@ class KWayPMRefine : public KWayFMRefine
              const Matrix<float>& upper_block_balance,
              const Matrix<float>& lower_block_balance,
              Matrix<float>& block_balance,        // the current block balance
-             Matrix<int>& net_degs,               // the current net degree
+             NetDegrees& net_degs,                // the current net degree
              std::vector<float>& cur_paths_cost,  // the current path cost
              Partitions& solution,
              std::vector<bool>& visited_vertices_flag) override;
@@ -81,25 +91,46 @@ class KWayPMRefine : public KWayFMRefine
       std::vector<std::pair<int, int>>& maximum_matches,
       const std::map<std::pair<int, int>, float>& matching_scores) const;
 
+  // The block pairs of a maximum matching are disjoint, so they are
+  // refined concurrently by num_workers workers.  Each pair is refined by a
+  // worker on its own copy of the state at the beginning of the pass, and
+  // the accepted moves of all the pairs are then applied to the state in the
+  // order of the pairs, so the result depends neither on the scheduling nor
+  // on the number of the workers.
+  float ParallelPairFM(
+      const HGraphPtr& hgraph,
+      const Matrix<float>& upper_block_balance,
+      const Matrix<float>& lower_block_balance,
+      Matrix<float>& block_balance,    // the current block balance
+      NetDegrees& net_degs,            // the current net degree
+      std::vector<float>& paths_cost,  // the current path cost
+      Partitions& solution,
+      std::vector<bool>& visited_vertices_flag,
+      const std::vector<std::pair<int, int>>& maximum_matches,
+      int num_workers);
+
   // Perform 2-way FM between blocks in partition pair
+  // If accepted_moves is not nullptr, the moves kept in the solution
+  // are returned in the order they are accepted
   float PerformPairFM(
       const HGraphPtr& hgraph,
       const Matrix<float>& upper_block_balance,
       const Matrix<float>& lower_block_balance,
       Matrix<float>& block_balance,    // the current block balance
-      Matrix<int>& net_degs,           // the current net degree
+      NetDegrees& net_degs,            // the current net degree
       std::vector<float>& paths_cost,  // the current path cost
       Partitions& solution,
       GainBuckets& buckets,
       std::vector<bool>& visited_vertices_flag,
-      const std::pair<int, int>& partition_pair) const;
+      const std::pair<int, int>& partition_pair,
+      std::vector<GainCell>* accepted_moves = nullptr) const;
 
   // gain bucket related functions
   // Initialize the gain buckets in parallel
   void InitializeGainBucketsPM(GainBuckets& buckets,
                                const HGraphPtr& hgraph,
                                const std::vector<int>& boundary_vertices,
-                               const Matrix<int>& net_degs,
+                               const NetDegrees& net_degs,
                                const std::vector<float>& cur_paths_cost,
                                const Partitions& solution,
                                const std::pair<int, int>& partition_pair) const;
@@ -108,6 +139,12 @@ class KWayPMRefine : public KWayFMRefine
   // the connectivity between different blocks.
   // (block_a, block_b, score) where block_a < block_b
   std::map<std::pair<int, int>, float> pre_matching_connectivity_;
+  // the refiners used by the workers of ParallelPairFM.
+  // Each of them keeps its own gain buckets across passes
+  std::vector<KWayPMRefinerPtr> worker_refiners_;
+  // the block pairs are only refined in parallel for large hypergraphs,
+  // the copies of the state cost more than the refinement otherwise
+  const int parallel_pairs_threshold_ = 4096;  // number of vertices
 };
 
 }  // namespace par
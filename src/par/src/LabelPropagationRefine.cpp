@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "LabelPropagationRefine.h"
+
+#include <algorithm>
+
+// ------------------------------------------------------------------------------
+// K-way size-constrained label propagation refinement
+// ------------------------------------------------------------------------------
+
+namespace par {
+
+float LabelPropagationRefine::Pass(
+    const HGraphPtr& hgraph,
+    const Matrix<float>& upper_block_balance,
+    const Matrix<float>& lower_block_balance,
+    Matrix<float>& block_balance,        // the current block balance
+    NetDegrees& net_degs,                // the current net degree
+    std::vector<float>& cur_paths_cost,  // the current path cost
+    Partitions& solution,
+    std::vector<bool>& visited_vertices_flag)
+{
+  // Step 1: identify all the boundary vertices
+  // fixed vertices will not be identified as boundary vertices
+  const std::vector<int> boundary_vertices
+      = FindBoundaryVertices(hgraph, net_degs, visited_vertices_flag);
+  const int num_boundary_vertices = static_cast<int>(boundary_vertices.size());
+  if (num_boundary_vertices == 0) {
+    return 0.0f;  // no vertices are available
+  }
+
+  // Step 2: find the best move of each boundary vertex in parallel.
+  // All the vertices are evaluated on the same (read-only) status
+  std::vector<GainCell> best_moves(num_boundary_vertices);
+  ParallelForChunks(
+      thread_pool_.get(),
+      num_boundary_vertices,
+      parallel_workload_threshold_,
+      [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+          best_moves[i] = FindBestMove(boundary_vertices[i],
+                                       hgraph,
+                                       upper_block_balance,
+                                       lower_block_balance,
+                                       block_balance,
+                                       net_degs,
+                                       cur_paths_cost,
+                                       solution);
+        }
+      });
+
+  // Step 3: apply the moves in the order of decreasing gain.
+  // The ties are broken by the vertex id, so the result does not depend
+  // on the number of threads
+  std::vector<int> candidates;
+  candidates.reserve(num_boundary_vertices);
+  for (int i = 0; i < num_boundary_vertices; i++) {
+    if (best_moves[i].GetVertex() > -1) {
+      candidates.push_back(i);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), [&](int a, int b) {
+    if (best_moves[a].GetGainValue() != best_moves[b].GetGainValue()) {
+      return best_moves[a].GetGainValue() > best_moves[b].GetGainValue();
+    }
+    return best_moves[a].GetVertex() < best_moves[b].GetVertex();
+  });
+
+  GainValue total_gain;  // total gain improvement
+  int num_accepted_moves = 0;
+  for (const int i : candidates) {
+    const GainCell& move = best_moves[i];
+    const int v = move.GetVertex();
+    const int from_pid = move.GetSourcePart();
+    const int to_pid = move.GetDestinationPart();
+    // The neighbors of v may have been moved, so the move is checked again
+    // on the current status
+    if (CheckVertexMoveLegality(v,
+                                to_pid,
+                                from_pid,
+                                hgraph,
+                                block_balance,
+                                upper_block_balance,
+                                lower_block_balance)
+        == false) {
+      continue;
+    }
+    const GainCell gain_cell = CalculateVertexGain(
+        v, from_pid, to_pid, hgraph, solution, cur_paths_cost, net_degs);
+    if (gain_cell.GetGainValue() <= GainValue()) {
+      continue;  // the move conflicts with the previous moves
+    }
+    AcceptVertexGain(gain_cell,
+                     hgraph,
+                     total_gain,
+                     visited_vertices_flag,
+                     solution,
+                     cur_paths_cost,
+                     block_balance,
+                     net_degs);
+    num_accepted_moves++;
+  }
+
+  const int64_t gain_updates
+      = static_cast<int64_t>(num_boundary_vertices) * (num_parts_ - 1)
+        + static_cast<int64_t>(candidates.size());
+  RecordPass(static_cast<int>(candidates.size()),
+             num_accepted_moves,
+             gain_updates,
+             GainBuckets());
+  return total_gain.GetValue();
+}
+
+GainCell LabelPropagationRefine::FindBestMove(
+    const int v,
+    const HGraphPtr& hgraph,
+    const Matrix<float>& upper_block_balance,
+    const Matrix<float>& lower_block_balance,
+    const Matrix<float>& block_balance,
+    const NetDegrees& net_degs,
+    const std::vector<float>& cur_paths_cost,
+    const Partitions& solution) const
+{
+  GainCell best_move;  // the vertex is -1 by default
+  GainValue best_gain;  // only the moves with positive gain are considered
+  const int from_pid = solution[v];
+  for (int to_pid = 0; to_pid < num_parts_; to_pid++) {
+    if (to_pid == from_pid
+        || CheckVertexMoveLegality(v,
+                                   to_pid,
+                                   from_pid,
+                                   hgraph,
+                                   block_balance,
+                                   upper_block_balance,
+                                   lower_block_balance)
+               == false) {
+      continue;
+    }
+    GainCell gain_cell = CalculateVertexGain(
+        v, from_pid, to_pid, hgraph, solution, cur_paths_cost, net_degs);
+    if (gain_cell.GetGainValue() > best_gain) {
+      best_gain = gain_cell.GetGainValue();
+      best_move = std::move(gain_cell);
+    }
+  }
+  return best_move;
+}
+
+}  // namespace par
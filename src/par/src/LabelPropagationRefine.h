@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Refiner.h"
+
+namespace par {
+
+class LabelPropagationRefine;
+using LabelPropagationRefinerPtr = std::shared_ptr<LabelPropagationRefine>;
+
+// ------------------------------------------------------------------------------
+// K-way size-constrained label propagation refinement
+// In each pass, all the boundary vertices look for their best moves
+// concurrently based on the same status of the solution.  Then the moves
+// with positive gain are applied in the order of decreasing gain.  Because
+// the neighbors of a vertex may have been moved before it, the gain and the
+// balance of each move are checked again before applying it, so only the
+// non-conflicting moves with positive gain are accepted.
+// Different from the FM refiners, all the boundary vertices are evaluated in
+// each pass (max_move is not used), and no negative move is accepted. So it
+// is much faster than FM on large hypergraphs, i.e., the first levels of
+// the uncoarsening.
+// ------------------------------------------------------------------------------
+class LabelPropagationRefine : public Refiner
+{
+ public:
+  using Refiner::Refiner;
+
+  // Create a new refiner with the same parameters (thread-local usage)
+  LabelPropagationRefinerPtr Clone() const
+  {
+    return std::make_shared<LabelPropagationRefine>(*this);
+  }
+
+ private:
+  // In each pass, we only move the boundary vertices
+  // the return value is the gain improvement
+  float Pass(const HGraphPtr& hgraph,
+             const Matrix<float>& upper_block_balance,
+             const Matrix<float>& lower_block_balance,
+             Matrix<float>& block_balance,        // the current block balance
+             NetDegrees& net_degs,                // the current net degree
+             std::vector<float>& cur_paths_cost,  // the current path cost
+             Partitions& solution,
+             std::vector<bool>& visited_vertices_flag) override;
+
+  // Find the legal move of vertex v with the largest positive gain.
+  // If there is no such move, the vertex of the returned gain cell is -1
+  GainCell FindBestMove(int v,
+                        const HGraphPtr& hgraph,
+                        const Matrix<float>& upper_block_balance,
+                        const Matrix<float>& lower_block_balance,
+                        const Matrix<float>& block_balance,
+                        const NetDegrees& net_degs,
+                        const std::vector<float>& cur_paths_cost,
+                        const Partitions& solution) const;
+};
+
+}  // namespace par
@@ -58,16 +58,27 @@ par::PartitionMgr* makePartitionMgr()
 
 void initPartitionMgr(OpenRoad* openroad)
 {
-  Tcl_Interp* tcl_interp = openroad->tclInterp();
-  Par_Init(tcl_interp);
-  sta::evalTclInit(tcl_interp, sta::par_tcl_inits);
-
   par::PartitionMgr* kernel = openroad->getPartitionMgr();
 
   kernel->init(openroad->getDb(),
                openroad->getDbNetwork(),
                openroad->getSta(),
-               openroad->getLogger());
+               openroad->getLogger(),
+               openroad->getDistributed());
+
+  // Most flows never partition, so the commands are defined on first use
+  openroad->addLazyTclCommands({"triton_part_hypergraph",
+                                "evaluate_hypergraph_solution",
+                                "write_hypergraph_binary",
+                                "triton_part_design",
+                                "evaluate_part_design_solution",
+                                "write_partition_verilog",
+                                "read_partitioning"},
+                               [](Tcl_Interp* tcl_interp) {
+                                 Par_Init(tcl_interp);
+                                 sta::evalTclInit(tcl_interp,
+                                                  sta::par_tcl_inits);
+                               });
 };
 
 void deletePartitionMgr(par::PartitionMgr* partitionmgr)
@@ -35,10 +35,10 @@
 
 #include "Multilevel.h"
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
-#include <queue>
 #include <random>
-#include <thread>
 
 #include "Evaluator.h"
 #include "Hypergraph.h"
@@ -83,6 +83,15 @@ MultilevelPartitioner::MultilevelPartitioner(
   ilp_refiner_ = std::move(ilp_refiner);
   evaluator_ = std::move(evaluator);
   logger_ = logger;
+  // The coarsener and all the refiners share the same long-lived workers,
+  // instead of creating threads for every move
+  thread_pool_ = std::make_shared<ThreadPool>();
+  coarsener_->SetThreadPool(thread_pool_);
+  k_way_fm_refiner_->SetThreadPool(thread_pool_);
+  k_way_pm_refiner_->SetThreadPool(thread_pool_);
+  greedy_refiner_->SetThreadPool(thread_pool_);
+  ilp_refiner_->SetThreadPool(thread_pool_);
+  evaluator_->SetThreadPool(thread_pool_);
 }
 
 // Main function
@@ -102,15 +111,75 @@ std::vector<int> MultilevelPartitioner::Partition(
   // In experiments, we observe that the benefits of increasing number of
   // vcycles is very limited. However, the quality of solutions will change a
   // lot with different random seed
-  Matrix<int> top_solutions;
+  // The remote candidates are requested concurrently, since each request
+  // only waits for its worker.
+  // The first candidate is always generated, and the others are skipped
+  // when the candidate generation is out of time
+  const auto candidate_phase_end = StartPhase(candidate_time_fraction_);
+  Matrix<int> top_solutions(num_coarsen_solutions_);
+  const int num_threads = remote_generator_ != nullptr
+                              ? num_coarsen_solutions_
+                              : std::min(num_threads_, num_coarsen_solutions_);
+  if (num_threads <= 1 && remote_generator_ == nullptr) {
+    for (int id = 0; id < num_coarsen_solutions_; id++) {
+      if (id > 0 && IsPhaseExpired(candidate_phase_end)) {
+        break;
+      }
+      coarsener_->IncreaseRandomSeed();
+      top_solutions[id] = SingleLevelPartition(
+          hgraph, upper_block_balance, lower_block_balance);
+    }
+  } else {
+    // The timing cost of hgraph is initialized by the first coarsening call.
+    // Do it here to avoid multiple threads updating hgraph at the same time.
+    if (hgraph->HasTiming() && hgraph->GetTimingPathCostSize() == 0
+        && !hgraph->HasHyperedgeTimingCost()) {
+      evaluator_->InitializeTiming(hgraph);
+    }
+    // candidate id uses the same random seed as the serial mode
+    const int base_seed = coarsener_->GetRandomSeed();
+    std::atomic<int> next_id = 0;
+    std::vector<double> busy_times(num_threads, 0.0);
+    auto lambda_generate_candidates = [&](int thread_id) -> void {
+      ProfileTimer timer;
+      for (int id = next_id++; id < num_coarsen_solutions_; id = next_id++) {
+        if (id > 0 && IsPhaseExpired(candidate_phase_end)) {
+          continue;
+        }
+        if (remote_generator_ != nullptr
+            && remote_generator_(base_seed + id + 1, top_solutions[id])
+                   == true) {
+          continue;
+        }
+        auto candidate_partitioner
+            = CreateCandidatePartitioner(base_seed + id + 1);
+        top_solutions[id] = candidate_partitioner->SingleLevelPartition(
+            hgraph, upper_block_balance, lower_block_balance);
+      }
+      busy_times[thread_id] = timer.GetSeconds();
+    };
+    ProfileTimer region_timer;
+    thread_pool_->ParallelFor(num_threads, lambda_generate_candidates);
+    RecordParallelRegion(region_timer.GetSeconds(), busy_times);
+    coarsener_->SetRandomSeed(base_seed + num_coarsen_solutions_);
+  }
+
+  // remove the skipped candidates
+  top_solutions.erase(
+      std::remove_if(top_solutions.begin(),
+                     top_solutions.end(),
+                     [](const std::vector<int>& solution) {
+                       return solution.empty();
+                     }),
+      top_solutions.end());
+  if (static_cast<int>(top_solutions.size()) < num_coarsen_solutions_) {
+    deadline_->AddShortenedPhase("candidate_generation");
+  }
+
   float best_cost = std::numeric_limits<float>::max();
   int best_solution_id = -1;
-  for (int id = 0; id < num_coarsen_solutions_; id++) {
-    coarsener_->IncreaseRandomSeed();
-    top_solutions.push_back(
-        SingleLevelPartition(hgraph, upper_block_balance, lower_block_balance));
-    const float cost
-        = evaluator_->CutEvaluator(hgraph, top_solutions.back(), false).cost;
+  for (int id = 0; id < static_cast<int>(top_solutions.size()); id++) {
+    const float cost = evaluator_->CutCost(hgraph, top_solutions[id]);
     if (cost <= best_cost) {
       best_cost = cost;
       best_solution_id = id;
@@ -134,8 +203,11 @@ std::vector<int> MultilevelPartitioner::Partition(
   // The initial value of best solution will be used to guide the coarsening
   // process and use as the initial solution
   if (v_cycle_flag_ == true) {
-    VcycleRefinement(
-        hgraph, upper_block_balance, lower_block_balance, best_solution);
+    VcycleRefinement(hgraph,
+                     upper_block_balance,
+                     lower_block_balance,
+                     best_solution,
+                     vcycle_time_fraction_);
   }
 
   logger_->info(PAR, 153, "Finish Vcycle Refinement");
@@ -143,8 +215,150 @@ std::vector<int> MultilevelPartitioner::Partition(
   return best_solution;
 }
 
+void MultilevelPartitioner::SetNumThreads(const int num_threads)
+{
+  num_threads_ = std::max(num_threads, 1);
+  logger_->info(PAR,
+                182,
+                "Generate candidate solutions with {} threads",
+                num_threads_);
+}
+
+void MultilevelPartitioner::SetInitPlateauWindow(const int init_plateau_window)
+{
+  init_plateau_window_ = std::max(init_plateau_window, 0);
+}
+
+void MultilevelPartitioner::SetProfiler(ProfilerPtr profiler)
+{
+  profiler_ = std::move(profiler);
+  coarsener_->SetProfiler(profiler_);
+  k_way_fm_refiner_->SetProfiler(profiler_);
+  k_way_pm_refiner_->SetProfiler(profiler_);
+  greedy_refiner_->SetProfiler(profiler_);
+  ilp_refiner_->SetProfiler(profiler_);
+  if (lp_refiner_ != nullptr) {
+    lp_refiner_->SetProfiler(profiler_);
+  }
+}
+
+void MultilevelPartitioner::SetDeadline(DeadlinePtr deadline)
+{
+  deadline_ = std::move(deadline);
+  partitioner_->SetDeadline(deadline_);
+  k_way_fm_refiner_->SetDeadline(deadline_);
+  k_way_pm_refiner_->SetDeadline(deadline_);
+  greedy_refiner_->SetDeadline(deadline_);
+  ilp_refiner_->SetDeadline(deadline_);
+  if (lp_refiner_ != nullptr) {
+    lp_refiner_->SetDeadline(deadline_);
+  }
+}
+
+void MultilevelPartitioner::SetLabelPropagationRefiner(
+    LabelPropagationRefinerPtr lp_refiner,
+    const int num_vertices_threshold_lp)
+{
+  lp_refiner_ = std::move(lp_refiner);
+  num_vertices_threshold_lp_ = std::max(num_vertices_threshold_lp, 0);
+  if (lp_refiner_ == nullptr || num_vertices_threshold_lp_ == 0) {
+    return;
+  }
+  lp_refiner_->SetThreadPool(thread_pool_);
+  lp_refiner_->SetProfiler(profiler_);
+  lp_refiner_->SetDeadline(deadline_);
+  logger_->info(PAR,
+                198,
+                "Refine the levels with more than {} vertices by label "
+                "propagation",
+                num_vertices_threshold_lp_);
+}
+
+void MultilevelPartitioner::SetNumParallelVcycles(
+    const int num_parallel_vcycles)
+{
+  num_parallel_vcycles_ = std::max(num_parallel_vcycles, 1);
+  if (num_parallel_vcycles_ > 1) {
+    logger_->info(PAR,
+                  196,
+                  "Run {} guided v-cycles concurrently in each round",
+                  num_parallel_vcycles_);
+  }
+}
+
+void MultilevelPartitioner::SetRemoteCandidateGenerator(
+    CandidateGenerator generator)
+{
+  remote_generator_ = std::move(generator);
+}
+
+std::vector<int> MultilevelPartitioner::GenerateCandidate(
+    const HGraphPtr& hgraph,
+    const Matrix<float>& upper_block_balance,
+    const Matrix<float>& lower_block_balance,
+    const int coarsen_seed) const
+{
+  auto candidate_partitioner = CreateCandidatePartitioner(coarsen_seed);
+  candidate_partitioner->num_threads_ = num_threads_;
+  return candidate_partitioner->SingleLevelPartition(
+      hgraph, upper_block_balance, lower_block_balance);
+}
+
 // Private functions (Utilities)
 
+// Create a multilevel partitioner with its own coarsener, partitioner and
+// refiners. The evaluator, logger and thread pool are shared.
+MultiLevelPartitioner MultilevelPartitioner::CreateCandidatePartitioner(
+    const int coarsen_seed) const
+{
+  auto candidate_partitioner = std::make_shared<MultilevelPartitioner>(*this);
+  candidate_partitioner->coarsener_ = std::make_shared<Coarsener>(*coarsener_);
+  candidate_partitioner->coarsener_->SetRandomSeed(coarsen_seed);
+  candidate_partitioner->partitioner_
+      = std::make_shared<Partitioner>(*partitioner_);
+  candidate_partitioner->k_way_fm_refiner_ = k_way_fm_refiner_->Clone();
+  candidate_partitioner->k_way_pm_refiner_ = k_way_pm_refiner_->Clone();
+  candidate_partitioner->greedy_refiner_ = greedy_refiner_->Clone();
+  candidate_partitioner->ilp_refiner_ = ilp_refiner_->Clone();
+  if (lp_refiner_ != nullptr) {
+    candidate_partitioner->lp_refiner_ = lp_refiner_->Clone();
+  }
+  // the remaining threads are used by the initial partitioning
+  candidate_partitioner->num_threads_
+      = std::max(1, num_threads_ / num_coarsen_solutions_);
+  return candidate_partitioner;
+}
+
+void MultilevelPartitioner::RecordParallelRegion(
+    const double wall_time,
+    const std::vector<double>& busy_times) const
+{
+  if (profiler_ == nullptr) {
+    return;
+  }
+  double busy_time = 0.0;
+  for (const double time : busy_times) {
+    busy_time += time;
+  }
+  profiler_->AddParallelRegion(
+      wall_time, busy_time, static_cast<int>(busy_times.size()));
+}
+
+Deadline::Clock::time_point MultilevelPartitioner::StartPhase(
+    const float fraction) const
+{
+  if (deadline_ == nullptr) {
+    return Deadline::Clock::time_point::max();
+  }
+  return deadline_->StartPhase(fraction);
+}
+
+bool MultilevelPartitioner::IsPhaseExpired(
+    const Deadline::Clock::time_point phase_end) const
+{
+  return deadline_ != nullptr && deadline_->IsExpired(phase_end);
+}
+
 // Run single-level partitioning
 std::vector<int> MultilevelPartitioner::SingleLevelPartition(
     const HGraphPtr& hgraph,
@@ -180,7 +394,8 @@ std::vector<int> MultilevelPartitioner::SingleLevelPartition(
 
   // Step 3: run refinement
   // Here we need to do rebugetting on the best solution
-  RefinePartition(hierarchy,
+  coarsest_hgraph.reset();
+  RefinePartition(std::move(hierarchy),
                   upper_block_balance,
                   lower_block_balance,
                   top_solutions,
@@ -203,32 +418,169 @@ void MultilevelPartitioner::VcycleRefinement(
     const HGraphPtr& hgraph,
     const Matrix<float>& upper_block_balance,
     const Matrix<float>& lower_block_balance,
-    std::vector<int>& best_solution) const
+    std::vector<int>& best_solution,
+    const float time_fraction) const
 {
-  Matrix<int> candidate_solutions;
-  candidate_solutions.push_back(best_solution);
-  for (int num_cycles = 0; num_cycles < max_num_vcycle_; num_cycles++) {
-    // use the initial solution as the community feature
-    hgraph->SetCommunity(best_solution);
-    best_solution = SingleCycleRefinement(
-        hgraph, upper_block_balance, lower_block_balance);
+  ProfileTimer profile_timer(profiler_.get(), ProfilePhase::VCYCLE);
+  const auto phase_end = StartPhase(time_fraction);
+  // The timing weights of hgraph follow the cut of the solution guiding the
+  // v-cycles, starting from the cut-overlay solution, and are restored when
+  // the refinement is done.
+  Hypergraph::TimingState timing_state;
+  if (hgraph->HasTiming()) {
+    timing_state = hgraph->GetTimingState();
+    evaluator_->UpdateTiming(hgraph, best_solution);
+  }
+
+  if (num_parallel_vcycles_ > 1) {
+    ParallelVcycleRefinement(hgraph,
+                             upper_block_balance,
+                             lower_block_balance,
+                             best_solution,
+                             phase_end);
+  } else {
+    Matrix<int> candidate_solutions;
     candidate_solutions.push_back(best_solution);
-    const float cost
-        = evaluator_->CutEvaluator(hgraph, best_solution, false).cost;
+    for (int num_cycles = 0; num_cycles < max_num_vcycle_; num_cycles++) {
+      if (IsPhaseExpired(phase_end)) {
+        deadline_->AddShortenedPhase(ToString(ProfilePhase::VCYCLE));
+        break;
+      }
+      // use the initial solution as the community feature
+      hgraph->SetCommunity(best_solution);
+      std::vector<int> solution = SingleCycleRefinement(
+          hgraph, upper_block_balance, lower_block_balance);
+      candidate_solutions.push_back(solution);
+      const float cost = evaluator_->CutCost(hgraph, solution);
+      logger_->info(PAR,
+                    154,
+                    "[V-cycle Refinement] num_cycles = {}, cutcost = {}",
+                    num_cycles,
+                    cost);
+      // only the paths through the changed cut hyperedges are re-weighted
+      evaluator_->UpdateTiming(hgraph, best_solution, solution);
+      best_solution = std::move(solution);
+    }
+
+    // Perform Cut-overlay clustering and ILP-based partitioning
+    best_solution
+        = CutOverlayILPPart(hgraph,
+                            upper_block_balance,
+                            lower_block_balance,
+                            candidate_solutions,
+                            static_cast<int>(candidate_solutions.size()) - 1);
+  }
+
+  if (hgraph->HasTiming()) {
+    hgraph->SetTimingState(std::move(timing_state));
+  }
+}
+
+// Run the guided v-cycles in rounds of concurrent v-cycles.
+// All the v-cycles in a round are guided by the best solution in the elite
+// pool, and the solutions of the round are merged into the pool.
+void MultilevelPartitioner::ParallelVcycleRefinement(
+    const HGraphPtr& hgraph,
+    const Matrix<float>& upper_block_balance,
+    const Matrix<float>& lower_block_balance,
+    std::vector<int>& best_solution,
+    const Deadline::Clock::time_point phase_end) const
+{
+  // the elite pool is sorted by the cutcost in ascending order
+  const int max_num_elite_solutions = num_parallel_vcycles_ + 1;
+  Matrix<int> elite_solutions;
+  std::vector<float> elite_costs;
+  elite_solutions.push_back(best_solution);
+  elite_costs.push_back(evaluator_->CutCost(hgraph, best_solution));
+  auto lambda_add_elite_solution
+      = [&](std::vector<int>& solution, float cost) -> void {
+    const int pos
+        = std::upper_bound(elite_costs.begin(), elite_costs.end(), cost)
+          - elite_costs.begin();
+    if (pos >= max_num_elite_solutions) {
+      return;  // not better than any elite solution
+    }
+    elite_costs.insert(elite_costs.begin() + pos, cost);
+    elite_solutions.insert(elite_solutions.begin() + pos, std::move(solution));
+    if (static_cast<int>(elite_costs.size()) > max_num_elite_solutions) {
+      elite_costs.pop_back();
+      elite_solutions.pop_back();
+    }
+  };
+
+  // The first v-cycle of each round uses the user-specified coarsening
+  // order, the others alternate between the remaining orders, such that the
+  // concurrent v-cycles explore different clusterings.
+  const CoarsenOrder base_order = coarsener_->GetVertexOrderChoice();
+  std::vector<CoarsenOrder> coarsen_orders{base_order};
+  for (const CoarsenOrder order :
+       {CoarsenOrder::RANDOM, CoarsenOrder::DEGREE, CoarsenOrder::SIZE}) {
+    if (order != base_order) {
+      coarsen_orders.push_back(order);
+    }
+  }
+
+  // the random seed of each v-cycle only depends on its id
+  const int base_seed = coarsener_->GetRandomSeed();
+  const int num_threads = std::min(num_threads_, num_parallel_vcycles_);
+  Matrix<int> round_solutions(num_parallel_vcycles_);
+  for (int num_cycles = 0; num_cycles < max_num_vcycle_; num_cycles++) {
+    if (IsPhaseExpired(phase_end)) {
+      deadline_->AddShortenedPhase(ToString(ProfilePhase::VCYCLE));
+      break;
+    }
+    // use the best elite solution as the community feature
+    hgraph->SetCommunity(elite_solutions.front());
+    const int round_seed = base_seed + num_cycles * num_parallel_vcycles_;
+    std::atomic<int> next_id = 0;
+    std::vector<double> busy_times(num_threads, 0.0);
+    auto lambda_run_vcycles = [&](int thread_id) -> void {
+      ProfileTimer timer;
+      for (int id = next_id++; id < num_parallel_vcycles_; id = next_id++) {
+        auto candidate_partitioner
+            = CreateCandidatePartitioner(round_seed + id + 1);
+        candidate_partitioner->coarsener_->SetVertexOrderChoice(
+            coarsen_orders[id % coarsen_orders.size()]);
+        candidate_partitioner->num_threads_
+            = std::max(1, num_threads_ / num_parallel_vcycles_);
+        round_solutions[id] = candidate_partitioner->SingleCycleRefinement(
+            hgraph, upper_block_balance, lower_block_balance);
+      }
+      busy_times[thread_id] = timer.GetSeconds();
+    };
+    ProfileTimer region_timer;
+    thread_pool_->ParallelFor(num_threads, lambda_run_vcycles);
+    RecordParallelRegion(region_timer.GetSeconds(), busy_times);
+
+    // merge the solutions of this round into the elite pool
+    const float pre_best_cost = elite_costs.front();
+    const std::vector<int> pre_best_solution = elite_solutions.front();
+    for (auto& solution : round_solutions) {
+      const float cost = evaluator_->CutCost(hgraph, solution);
+      lambda_add_elite_solution(solution, cost);
+    }
+    // only the paths through the changed cut hyperedges are re-weighted
+    evaluator_->UpdateTiming(
+        hgraph, pre_best_solution, elite_solutions.front());
     logger_->info(PAR,
-                  154,
+                  2532,
                   "[V-cycle Refinement] num_cycles = {}, cutcost = {}",
                   num_cycles,
-                  cost);
+                  elite_costs.front());
+    if (elite_costs.front() >= pre_best_cost) {
+      logger_->info(PAR,
+                    197,
+                    "[V-cycle Refinement] converged after {} rounds",
+                    num_cycles + 1);
+      break;
+    }
   }
+  coarsener_->SetRandomSeed(base_seed
+                            + max_num_vcycle_ * num_parallel_vcycles_);
 
   // Perform Cut-overlay clustering and ILP-based partitioning
-  best_solution
-      = CutOverlayILPPart(hgraph,
-                          upper_block_balance,
-                          lower_block_balance,
-                          candidate_solutions,
-                          static_cast<int>(candidate_solutions.size()) - 1);
+  best_solution = CutOverlayILPPart(
+      hgraph, upper_block_balance, lower_block_balance, elite_solutions, 0);
 }
 
 // Single Vcycle Refinement
@@ -256,7 +608,8 @@ std::vector<int> MultilevelPartitioner::SingleCycleRefinement(
                             PartitionType::INIT_DIRECT_ILP);
   }
   // Here we need to do rebugetting on the best solution
-  RefinePartition(hierarchy,
+  coarsest_hgraph.reset();
+  RefinePartition(std::move(hierarchy),
                   upper_block_balance,
                   lower_block_balance,
                   top_solutions,
@@ -274,6 +627,8 @@ void MultilevelPartitioner::InitialPartition(
     Matrix<int>& top_initial_solutions,
     int& best_solution_id) const
 {
+  ProfileTimer profile_timer(profiler_.get(),
+                             ProfilePhase::INITIAL_PARTITIONING);
   logger_->report(
       "======================================================================");
   logger_->report("[STATUS] Initial Partitioning ");
@@ -286,79 +641,63 @@ void MultilevelPartitioner::InitialPartition(
   std::vector<bool>
       initial_solutions_flag;  // if the solutions statisfy balance constraint
   Matrix<int> initial_solutions;
-  if (hgraph->GetNumVertices() <= num_vertices_threshold_ilp_) {
-    // random partitioning + Vile + ILP
-    initial_solutions.resize(num_initial_random_solutions_ * 2 + 2);
-  } else {
-    // random partitioning + Vile
-    initial_solutions.resize(num_initial_random_solutions_ * 2 + 1);
-  }
-  // We need k_way_fm_refiner to generate a balanced partitioning
-  k_way_fm_refiner_->SetMaxMove(hgraph->GetNumVertices());
+  // random partitioning + Vile (+ ILP)
+  initial_solutions.reserve(num_initial_random_solutions_ * 2 + 2);
   // generate random seed
+  // The seeds are generated before partitioning, such that the results
+  // do not depend on the number of threads
+  std::vector<int> random_seeds;
+  std::vector<int> random_vile_seeds;
+  random_seeds.reserve(num_initial_random_solutions_);
+  random_vile_seeds.reserve(num_initial_random_solutions_);
   for (int i = 0; i < num_initial_random_solutions_; ++i) {
-    const int seed = std::numeric_limits<int>::max() * dist(gen);
-    auto& solution = initial_solutions[i];
-    // call random partitioning
-    partitioner_->SetRandomSeed(seed);
-    partitioner_->Partition(hgraph,
-                            upper_block_balance,
-                            lower_block_balance,
-                            solution,
-                            PartitionType::INIT_RANDOM);
-    // call FM refiner to improve the solution
-    k_way_fm_refiner_->Refine(
-        hgraph, upper_block_balance, lower_block_balance, solution);
-    const auto token = evaluator_->CutEvaluator(hgraph, solution, true);
-    initial_solutions_cost.push_back(token.cost);
-    // Here we only check the upper bound to make sure more possible solutions
-    initial_solutions_flag.push_back(token.block_balance
-                                     <= upper_block_balance);
-    logger_->report(
-        "[INIT-PART] {} :: Random part cutcost = {}, balance_flag = {}",
-        i,
-        initial_solutions_cost.back(),
-        initial_solutions_flag.back());
+    random_seeds.push_back(
+        static_cast<int>(std::numeric_limits<int>::max() * dist(gen)));
   }
-  // generate random vile solution
   for (int i = 0; i < num_initial_random_solutions_; ++i) {
-    const int seed = std::numeric_limits<int>::max() * dist(gen);
-    auto& solution = initial_solutions[i + num_initial_random_solutions_];
-    // call random partitioning
-    partitioner_->SetRandomSeed(seed);
-    partitioner_->Partition(hgraph,
-                            upper_block_balance,
-                            lower_block_balance,
-                            solution,
-                            PartitionType::INIT_RANDOM_VILE);
-    // call FM refiner to improve the solution
-    k_way_fm_refiner_->Refine(
-        hgraph, upper_block_balance, lower_block_balance, solution);
-    const auto token = evaluator_->CutEvaluator(hgraph, solution, true);
-    initial_solutions_cost.push_back(token.cost);
-    // Here we only check the upper bound to make sure more possible solutions
-    initial_solutions_flag.push_back(token.block_balance
-                                     <= upper_block_balance);
-    logger_->report(
-        "[INIT-PART] {} :: Random VILE part cutcost = {}, balance_flag = {}",
-        i,
-        initial_solutions_cost.back(),
-        initial_solutions_flag.back());
+    random_vile_seeds.push_back(
+        static_cast<int>(std::numeric_limits<int>::max() * dist(gen)));
   }
+  // We need k_way_fm_refiner to generate a balanced partitioning
+  k_way_fm_refiner_->SetMaxMove(hgraph->GetNumVertices());
+  // generate random solutions
+  GenerateInitialSolutions(hgraph,
+                           upper_block_balance,
+                           lower_block_balance,
+                           PartitionType::INIT_RANDOM,
+                           random_seeds,
+                           initial_solutions,
+                           initial_solutions_cost,
+                           initial_solutions_flag);
+  // generate random vile solution
+  GenerateInitialSolutions(hgraph,
+                           upper_block_balance,
+                           lower_block_balance,
+                           PartitionType::INIT_RANDOM_VILE,
+                           random_vile_seeds,
+                           initial_solutions,
+                           initial_solutions_cost,
+                           initial_solutions_flag);
 
   // Vile partitioning. Vile partitioning needs refiner to generated a balanced
   // partitioning
-  auto& vile_solution = initial_solutions[num_initial_random_solutions_ * 2L];
+  initial_solutions.emplace_back();
+  auto& vile_solution = initial_solutions.back();
   partitioner_->Partition(hgraph,
                           upper_block_balance,
                           lower_block_balance,
                           vile_solution,
                           PartitionType::INIT_VILE);
   // We need k_way_fm_refiner to generate a balanced partitioning
-  k_way_fm_refiner_->Refine(
-      hgraph, upper_block_balance, lower_block_balance, vile_solution);
+  PartitionState vile_state
+      = evaluator_->GetPartitionState(hgraph, vile_solution);
+  k_way_fm_refiner_->Refine(hgraph,
+                            upper_block_balance,
+                            lower_block_balance,
+                            vile_solution,
+                            vile_state);
   k_way_fm_refiner_->RestoreDefaultParameters();
-  const auto vile_token = evaluator_->CutEvaluator(hgraph, vile_solution, true);
+  const auto vile_token = evaluator_->CutEvaluator(hgraph, vile_state, true);
   initial_solutions_cost.push_back(vile_token.cost);
   initial_solutions_flag.push_back(vile_token.block_balance
                                    <= upper_block_balance);
@@ -367,6 +706,7 @@ void MultilevelPartitioner::InitialPartition(
                   initial_solutions_flag.back());
   // ILP partitioning
   if (hgraph->GetNumVertices() <= num_vertices_threshold_ilp_) {
+    initial_solutions.emplace_back();
     auto& ilp_solution = initial_solutions.back();
     // Use previous best solution as a starting point
     int ilp_solution_id = 0;
@@ -447,6 +787,131 @@ void MultilevelPartitioner::InitialPartition(
   logger_->info(PAR, 156, "Best initial cutcost {}", best_initial_cost);
 }
 
+// Generate one initial solution for each seed with random partitioning
+// (partition_type is INIT_RANDOM or INIT_RANDOM_VILE) and improve it with
+// FM refinement. The candidates are evaluated by num_threads_ threads, each
+// with its own partitioner and refiner.  If init_plateau_window_ > 0, we stop
+// when the best balanced cutcost has not been improved by
+// init_plateau_window_ consecutive candidates.  The candidates are always
+// checked in the order of seeds, so the results do not depend on the
+// number of threads.
+void MultilevelPartitioner::GenerateInitialSolutions(
+    const HGraphPtr& hgraph,
+    const Matrix<float>& upper_block_balance,
+    const Matrix<float>& lower_block_balance,
+    const PartitionType partition_type,
+    const std::vector<int>& seeds,
+    Matrix<int>& initial_solutions,
+    std::vector<float>& initial_solutions_cost,
+    std::vector<bool>& initial_solutions_flag) const
+{
+  const int num_candidates = static_cast<int>(seeds.size());
+  const int num_threads = std::max(1, std::min(num_threads_, num_candidates));
+  const std::string partition_name
+      = (partition_type == PartitionType::INIT_RANDOM) ? "Random"
+                                                       : "Random VILE";
+  Matrix<int> solutions(num_candidates);
+  std::vector<PartitionToken> tokens(num_candidates);
+
+  // generate the solution for candidate id
+  auto lambda_generate_solution = [&](const PartitioningPtr& partitioner,
+                                      const KWayFMRefinerPtr& refiner,
+                                      int id) -> void {
+    if (IsTimeUp(deadline_)) {
+      return;  // the candidate is skipped
+    }
+    auto& solution = solutions[id];
+    // call random partitioning
+    partitioner->SetRandomSeed(seeds[id]);
+    partitioner->Partition(hgraph,
+                           upper_block_balance,
+                           lower_block_balance,
+                           solution,
+                           partition_type);
+    // call FM refiner to improve the solution
+    PartitionState state = evaluator_->GetPartitionState(hgraph, solution);
+    refiner->Refine(
+        hgraph, upper_block_balance, lower_block_balance, solution, state);
+    tokens[id] = evaluator_->CutEvaluator(hgraph, state, true);
+  };
+
+  // When the plateau detection is enabled, the candidates are generated
+  // batch by batch. Otherwise, all the candidates are in one batch.
+  const int batch_size
+      = (init_plateau_window_ > 0) ? num_threads : num_candidates;
+  float best_cost = std::numeric_limits<float>::max();
+  int num_non_improving_candidates = 0;
+  int num_generated_candidates = 0;
+  bool stop_flag = false;
+  bool time_up_flag = false;
+  for (int batch_start = 0; batch_start < num_candidates && stop_flag == false
+                            && time_up_flag == false;
+       batch_start += batch_size) {
+    const int batch_end = std::min(batch_start + batch_size, num_candidates);
+    if (num_threads == 1) {
+      for (int id = batch_start; id < batch_end; id++) {
+        lambda_generate_solution(partitioner_, k_way_fm_refiner_, id);
+      }
+    } else {
+      std::atomic<int> next_id = batch_start;
+      auto lambda_worker = [&]() -> void {
+        // thread-local partitioner and refiner
+        auto partitioner = std::make_shared<Partitioner>(*partitioner_);
+        auto refiner = k_way_fm_refiner_->Clone();
+        for (int id = next_id++; id < batch_end; id = next_id++) {
+          lambda_generate_solution(partitioner, refiner, id);
+        }
+      };
+      thread_pool_->ParallelFor(num_threads,
+                                [&](int) { lambda_worker(); });
+    }
+
+    // collect the results in the order of candidates
+    for (int id = batch_start; id < batch_end; id++) {
+      if (solutions[id].empty()) {
+        // the remaining candidates are skipped for the time limit
+        deadline_->AddShortenedPhase(
+            ToString(ProfilePhase::INITIAL_PARTITIONING));
+        time_up_flag = true;
+        break;
+      }
+      const bool balance_flag = tokens[id].block_balance <= upper_block_balance;
+      initial_solutions.push_back(std::move(solutions[id]));
+      initial_solutions_cost.push_back(tokens[id].cost);
+      // Here we only check the upper bound to make sure more possible
+      // solutions
+      initial_solutions_flag.push_back(balance_flag);
+      logger_->report(
+          "[INIT-PART] {} :: {} part cutcost = {}, balance_flag = {}",
+          id,
+          partition_name,
+          initial_solutions_cost.back(),
+          initial_solutions_flag.back());
+      num_generated_candidates++;
+      if (balance_flag == true && tokens[id].cost < best_cost) {
+        best_cost = tokens[id].cost;
+        num_non_improving_candidates = 0;
+      } else {
+        num_non_improving_candidates++;
+      }
+      if (init_plateau_window_ > 0
+          && num_non_improving_candidates >= init_plateau_window_) {
+        stop_flag = true;
+        break;
+      }
+    }
+  }
+
+  if (stop_flag == true) {
+    logger_->info(PAR,
+                  183,
+                  "{} initial partitioning reaches a plateau after {} "
+                  "candidates",
+                  partition_name,
+                  num_generated_candidates);
+  }
+}
+
 // Refine the solutions in top_solutions in parallel with multi-threading
 // the top_solutions and best_solution_id will be updated during this process
 void MultilevelPartitioner::RefinePartition(
@@ -459,53 +924,61 @@ void MultilevelPartitioner::RefinePartition(
   if (hierarchy.size() <= 1) {
     return;  // no need to refine.
   }
+  ProfileTimer profile_timer(profiler_.get(), ProfilePhase::REFINEMENT);
 
   int num_level = 0;
-  // rebudget based on the best solution
-  auto hgraph_iter = hierarchy.rbegin();
-  while (hgraph_iter != hierarchy.rend()) {
-    HGraphPtr coarse_hgraph = *hgraph_iter;
-    hgraph_iter++;
-    if (hgraph_iter == hierarchy.rend()) {
-      return;
-    }
-    HGraphPtr hgraph = *hgraph_iter;
+  std::vector<int> refined_solution;
+  // The refiners keep their gain buckets across passes, so each solution
+  // is refined by its own copy of the refiners.  The first solution uses
+  // the refiners of this partitioner.
+  std::vector<MultiLevelPartitioner> refine_partitioners;
+  for (int i = 1; i < static_cast<int>(top_solutions.size()); i++) {
+    refine_partitioners.push_back(CreateCandidatePartitioner(i));
+  }
+  // The levels are released from the coarsest one as soon as their solutions
+  // have been projected, so only the current level and the finer levels
+  // are kept in memory (if the caller does not hold the hierarchy).
+  while (hierarchy.size() > 1) {
+    HGraphPtr coarse_hgraph = std::move(hierarchy.back());
+    hierarchy.pop_back();
+    HGraphPtr hgraph = hierarchy.back();
 
     // convert the solution in coarse_hgraph to the solution of hgraph
     for (auto& top_solution : top_solutions) {
-      std::vector<int> refined_solution;
-      refined_solution.resize(hgraph->GetNumVertices());
-      for (int cluster_id = 0; cluster_id < coarse_hgraph->GetNumVertices();
-           cluster_id++) {
-        const int part_id = top_solution[cluster_id];
-        for (const auto& v : coarse_hgraph->GetVertexCAttr(cluster_id)) {
-          refined_solution[v] = part_id;
-        }
-      }
-      top_solution = refined_solution;
+      coarse_hgraph->ProjectSolution(top_solution, refined_solution);
+      top_solution.swap(refined_solution);
     }
+    coarse_hgraph.reset();  // release the coarse level
+    // the level is the distance to the finest hypergraph
+    const int level = static_cast<int>(hierarchy.size()) - 1;
 
     // Parallel refine all the solutions
-    std::vector<std::thread> threads;
-    threads.reserve(top_solutions.size());
-    for (auto& top_solution : top_solutions) {
-      threads.emplace_back(&par::MultilevelPartitioner::CallRefiner,
-                           this,
-                           hgraph,
-                           std::ref(upper_block_balance),
-                           std::ref(lower_block_balance),
-                           std::ref(top_solution));
-    }
-    for (auto& th : threads) {
-      th.join();
+    ProfileTimer level_timer;
+    std::vector<PartitionState> states(top_solutions.size());
+    std::vector<double> busy_times(top_solutions.size(), 0.0);
+    auto lambda_refine = [&](int i) -> void {
+      ProfileTimer timer;
+      const MultilevelPartitioner* refine_partitioner
+          = (i == 0) ? this : refine_partitioners[i - 1].get();
+      refine_partitioner->SetRefinementLevel(level);
+      refine_partitioner->CallRefiner(hgraph,
+                                      upper_block_balance,
+                                      lower_block_balance,
+                                      top_solutions[i],
+                                      states[i]);
+      busy_times[i] = timer.GetSeconds();
+    };
+    thread_pool_->ParallelFor(top_solutions.size(), lambda_refine);
+    const double level_time = level_timer.GetSeconds();
+    RecordParallelRegion(level_time, busy_times);
+    if (profiler_ != nullptr) {
+      profiler_->AddRefinementLevelTime(level, level_time);
     }
-    threads.clear();
 
     // update the best_solution_id
     float best_cost = std::numeric_limits<float>::max();
     for (auto i = 0; i < top_solutions.size(); i++) {
-      const float cost
-          = evaluator_->CutEvaluator(hgraph, top_solutions[i], true).cost;
+      const float cost = evaluator_->CutEvaluator(hgraph, states[i], true).cost;
       if (best_cost > cost) {
         best_cost = cost;
         best_solution_id = i;
@@ -520,6 +993,18 @@ void MultilevelPartitioner::RefinePartition(
         best_cost,
         best_solution_id);
   }
+  SetRefinementLevel(-1);
+}
+
+void MultilevelPartitioner::SetRefinementLevel(const int level) const
+{
+  k_way_fm_refiner_->SetRefinementLevel(level);
+  k_way_pm_refiner_->SetRefinementLevel(level);
+  greedy_refiner_->SetRefinementLevel(level);
+  ilp_refiner_->SetRefinementLevel(level);
+  if (lp_refiner_ != nullptr) {
+    lp_refiner_->SetRefinementLevel(level);
+  }
 }
 
 // Refine function
@@ -529,16 +1014,27 @@ void MultilevelPartitioner::CallRefiner(
     const HGraphPtr& hgraph,
     const Matrix<float>& upper_block_balance,
     const Matrix<float>& lower_block_balance,
-    std::vector<int>& solution) const
+    std::vector<int>& solution,
+    PartitionState& state) const
 {
-  if (num_parts_ > 1) {  // Pair-wise FM only used for multi-way partitioning
-    k_way_pm_refiner_->Refine(
-        hgraph, upper_block_balance, lower_block_balance, solution);
+  // The hyperedges differ between levels, so the connectivity status
+  // is rebuilt once per level and then updated by each refiner
+  state = evaluator_->GetPartitionState(hgraph, solution);
+  if (lp_refiner_ != nullptr && num_vertices_threshold_lp_ > 0
+      && hgraph->GetNumVertices() > num_vertices_threshold_lp_) {
+    // the large levels are refined by label propagation instead of FM
+    lp_refiner_->Refine(
+        hgraph, upper_block_balance, lower_block_balance, solution, state);
+  } else {
+    if (num_parts_ > 1) {  // Pair-wise FM only used for multi-way partitioning
+      k_way_pm_refiner_->Refine(
+          hgraph, upper_block_balance, lower_block_balance, solution, state);
+    }
+    k_way_fm_refiner_->Refine(
+        hgraph, upper_block_balance, lower_block_balance, solution, state);
   }
-  k_way_fm_refiner_->Refine(
-      hgraph, upper_block_balance, lower_block_balance, solution);
   greedy_refiner_->Refine(
-      hgraph, upper_block_balance, lower_block_balance, solution);
+      hgraph, upper_block_balance, lower_block_balance, solution, state);
 }
 
 // Perform cut-overlay clustering and ILP-based partitioning
@@ -551,63 +1047,39 @@ std::vector<int> MultilevelPartitioner::CutOverlayILPPart(
     const Matrix<int>& top_solutions,
     int best_solution_id) const
 {
-  std::vector<int> optimal_solution = top_solutions[best_solution_id];
-  std::vector<int> vertex_cluster_vec(hgraph->GetNumVertices(), -1);
-  // check if the hyperedge is cut by solutions
-  std::vector<bool> hyperedge_mask(hgraph->GetNumHyperedges(), false);
-  for (const auto& solution : top_solutions) {
-    for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
-      if (hyperedge_mask[e] == true) {
-        continue;  // This hyperedge has been cut
-      }
-
-      const auto range = hgraph->Vertices(e);
-      const int block_id = solution[*range.begin()];
-      for (const int vertex :
-           boost::make_iterator_range(range.begin() + 1, range.end())) {
-        if (solution[vertex] != block_id) {
-          hyperedge_mask[e] = true;
-          break;  // end this hyperedge
-        }
+  ProfileTimer profile_timer(profiler_.get(), ProfilePhase::CUT_OVERLAY_ILP);
+  if (IsTimeUp(deadline_)) {
+    // return the best solution without cut-overlay clustering
+    deadline_->AddShortenedPhase(ToString(ProfilePhase::CUT_OVERLAY_ILP));
+    float best_cost = std::numeric_limits<float>::max();
+    for (int id = 0; id < static_cast<int>(top_solutions.size()); id++) {
+      const float cost = evaluator_->CutCost(hgraph, top_solutions[id]);
+      if (cost < best_cost) {
+        best_cost = cost;
+        best_solution_id = id;
       }
     }
+    return top_solutions[best_solution_id];
   }
-
-  // pre-order BFS to traverse the hypergraph
-  auto lambda_detect_connected_components = [&](int v, int cluster_id) -> void {
-    std::queue<int> wavefront;
-    wavefront.push(v);
-    while (wavefront.empty() == false) {
-      const int u = wavefront.front();
-      wavefront.pop();
-      for (const int e : hgraph->Edges(u)) {
-        if (hyperedge_mask[e] == true) {
-          continue;  // this hyperedge has been cut
-        }
-        for (const int v_nbr : hgraph->Vertices(e)) {
-          if (vertex_cluster_vec[v_nbr] == -1) {
-            vertex_cluster_vec[v_nbr] = cluster_id;
-            wavefront.push(v_nbr);
-          }
-        }
-      }
-    }
-  };
-
+  std::vector<int> optimal_solution = top_solutions[best_solution_id];
+  // check if the hyperedge is cut by solutions
+  const std::vector<uint8_t> hyperedge_mask
+      = GetCutOverlayMask(hgraph, top_solutions);
   // detect the connected components and mask each connected component as a
   // cluster
-  int cluster_id = -1;
-  // map the initial optimal solution to the solution of clustered hgraph
+  std::vector<int> vertex_cluster_vec;
+  const int num_clusters
+      = DetectConnectedComponents(hgraph, hyperedge_mask, vertex_cluster_vec);
+  // map the initial optimal solution to the solution of clustered hgraph.
+  // The smallest vertex of each cluster is visited first
   std::vector<int> init_solution;
+  init_solution.reserve(num_clusters);
   for (int v = 0; v < hgraph->GetNumVertices(); v++) {
-    if (vertex_cluster_vec[v] == -1) {
-      vertex_cluster_vec[v] = ++cluster_id;
+    if (vertex_cluster_vec[v] == static_cast<int>(init_solution.size())) {
       init_solution.push_back(top_solutions[best_solution_id][v]);
-      lambda_detect_connected_components(v, cluster_id);
     }
   }
 
-  const int num_clusters = cluster_id + 1;
   std::vector<std::vector<int>> cluster_attr;
   cluster_attr.reserve(num_clusters);
   for (int id = 0; id < num_clusters; id++) {
@@ -640,16 +1112,126 @@ std::vector<int> MultilevelPartitioner::CutOverlayILPPart(
   }
 
   // map the solution back to the original hypergraph
-  for (int c_id = 0; c_id < clustered_hgraph->GetNumVertices(); c_id++) {
-    const int block_id = init_solution[c_id];
-    for (const auto& v : clustered_hgraph->GetVertexCAttr(c_id)) {
-      optimal_solution[v] = block_id;
-    }
-  }
+  clustered_hgraph->ProjectSolution(init_solution, optimal_solution);
 
   logger_->info(PAR, 158, "Statistics of cut-overlay solution:");
   evaluator_->CutEvaluator(hgraph, optimal_solution, true);
   return optimal_solution;
 }
 
+// All the solutions are checked for each hyperedge, so each hyperedge is
+// only traversed once and the hyperedges are handled in parallel
+std::vector<uint8_t> MultilevelPartitioner::GetCutOverlayMask(
+    const HGraphPtr& hgraph,
+    const Matrix<int>& solutions) const
+{
+  const int num_hyperedges = hgraph->GetNumHyperedges();
+  const int num_solutions = static_cast<int>(solutions.size());
+  std::vector<uint8_t> hyperedge_mask(num_hyperedges, 0);
+  ParallelForChunks(
+      thread_pool_.get(),
+      num_hyperedges,
+      parallel_workload_threshold_,
+      [&](int begin, int end) {
+        // the blocks of the first vertex of the hyperedge in each solution
+        std::vector<int> first_blocks(num_solutions);
+        for (int e = begin; e < end; e++) {
+          const auto range = hgraph->Vertices(e);
+          if (range.empty() == true) {
+            continue;
+          }
+          for (int s = 0; s < num_solutions; s++) {
+            first_blocks[s] = solutions[s][*range.begin()];
+          }
+          for (const int vertex :
+               boost::make_iterator_range(range.begin() + 1, range.end())) {
+            uint8_t cut_flag = 0;
+            for (int s = 0; s < num_solutions; s++) {
+              cut_flag |= static_cast<uint8_t>(solutions[s][vertex]
+                                               != first_blocks[s]);
+            }
+            if (cut_flag != 0) {
+              hyperedge_mask[e] = 1;
+              break;  // end this hyperedge
+            }
+          }
+        }
+      });
+  return hyperedge_mask;
+}
+
+// The connected components are found by a concurrent union-find over the
+// uncut hyperedges.  A root is always linked to a smaller root, so the root
+// of each component is its smallest vertex and the result is independent
+// of the order of the unions, i.e., the same as the sequential BFS.
+int MultilevelPartitioner::DetectConnectedComponents(
+    const HGraphPtr& hgraph,
+    const std::vector<uint8_t>& hyperedge_mask,
+    std::vector<int>& vertex_cluster_vec) const
+{
+  const int num_vertices = hgraph->GetNumVertices();
+  // parent[v] <= v, and parent[v] == v if v is a root.  The parents only
+  // decrease, so the relaxed atomic operations are enough.
+  std::vector<std::atomic<int>> parent(num_vertices);
+  for (int v = 0; v < num_vertices; v++) {
+    parent[v].store(v, std::memory_order_relaxed);
+  }
+  // find the root of v with path halving
+  auto lambda_find = [&](int v) {
+    int p = parent[v].load(std::memory_order_relaxed);
+    while (p != v) {
+      const int gp = parent[p].load(std::memory_order_relaxed);
+      parent[v].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+      v = gp;
+      p = parent[v].load(std::memory_order_relaxed);
+    }
+    return v;
+  };
+  // link the larger root to the smaller root
+  auto lambda_union = [&](int u, int v) {
+    while (true) {
+      u = lambda_find(u);
+      v = lambda_find(v);
+      if (u == v) {
+        return;
+      }
+      if (u > v) {
+        std::swap(u, v);
+      }
+      int root = v;
+      if (parent[v].compare_exchange_strong(
+              root, u, std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  };
+  ParallelForChunks(
+      thread_pool_.get(),
+      hgraph->GetNumHyperedges(),
+      parallel_workload_threshold_,
+      [&](int begin, int end) {
+        for (int e = begin; e < end; e++) {
+          const auto range = hgraph->Vertices(e);
+          if (hyperedge_mask[e] == 1 || range.empty() == true) {
+            continue;  // this hyperedge has been cut
+          }
+          for (const int v :
+               boost::make_iterator_range(range.begin() + 1, range.end())) {
+            lambda_union(*range.begin(), v);
+          }
+        }
+      });
+
+  // number the clusters in the increasing order of the roots.
+  // The root of v is not larger than v, so it has been numbered.
+  vertex_cluster_vec.assign(num_vertices, -1);
+  int num_clusters = 0;
+  for (int v = 0; v < num_vertices; v++) {
+    const int root = lambda_find(v);
+    vertex_cluster_vec[v]
+        = (root == v) ? num_clusters++ : vertex_cluster_vec[root];
+  }
+  return num_clusters;
+}
+
 }  // namespace par
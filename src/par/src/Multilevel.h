@@ -34,14 +34,21 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include "Coarsener.h"
+#include "Deadline.h"
 #include "Evaluator.h"
 #include "GreedyRefine.h"
 #include "Hypergraph.h"
 #include "ILPRefine.h"
 #include "KWayFMRefine.h"
 #include "KWayPMRefine.h"
+#include "LabelPropagationRefine.h"
 #include "Partitioner.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
 #include "Utilities.h"
 #include "utl/Logger.h"
 
@@ -54,6 +61,11 @@ using MultiLevelPartitioner = std::shared_ptr<MultilevelPartitioner>;
 class MultilevelPartitioner
 {
  public:
+  // Generate the candidate solution with the given coarsening seed outside
+  // this process (e.g., on a remote worker). Return false if it fails.
+  using CandidateGenerator
+      = std::function<bool(int coarsen_seed, std::vector<int>& solution)>;
+
   MultilevelPartitioner(const int num_parts,
                         // user-specified parameters
                         const bool v_cycle_flag,
@@ -82,12 +94,97 @@ class MultilevelPartitioner
 
   // Use the initial solution as the community feature
   // Call Vcycle refinement
+  // The v-cycles may use time_fraction of the remaining time (see
+  // SetDeadline)
   void VcycleRefinement(const HGraphPtr& hgraph,
                         const Matrix<float>& upper_block_balance,
                         const Matrix<float>& lower_block_balance,
-                        std::vector<int>& best_solution) const;
+                        std::vector<int>& best_solution,
+                        float time_fraction = 1.0) const;
+
+  // The candidate solutions (num_coarsen_solutions) are generated by
+  // num_threads threads concurrently.  Each thread works on its own copy of
+  // the coarsener, partitioner and refiners, and the random seed of each
+  // candidate is the same as the serial mode. So the results do not depend
+  // on num_threads. The initial partitioning candidates are also generated
+  // with num_threads threads.
+  void SetNumThreads(int num_threads);
+
+  // Stop generating random initial solutions when the best cutcost has not
+  // been improved by init_plateau_window consecutive candidates.
+  // 0 means generating all the num_initial_solutions candidates.
+  void SetInitPlateauWindow(int init_plateau_window);
+
+  // Run num_parallel_vcycles guided v-cycles concurrently in each round of
+  // the v-cycle refinement. Each v-cycle uses its own random seed and
+  // coarsening order, and all of them are guided by the best solution in
+  // the elite pool. 1 means the serial v-cycle refinement.
+  void SetNumParallelVcycles(int num_parallel_vcycles);
+
+  // The levels with more than num_vertices_threshold_lp vertices are
+  // refined by the label propagation refiner instead of the FM refiners.
+  // num_vertices_threshold_lp <= 0 means the label propagation refiner
+  // is not used.
+  void SetLabelPropagationRefiner(LabelPropagationRefinerPtr lp_refiner,
+                                  int num_vertices_threshold_lp);
+
+  // The runtime of each phase (coarsening, initial partitioning,
+  // refinement, cut-overlay ILP and v-cycles), the statistics of the
+  // refiners and the thread utilization are added to the profiler.
+  // The profiler is shared by the coarsener and all the refiners.
+  void SetProfiler(ProfilerPtr profiler);
+
+  // Partition splits the remaining time of the deadline between the
+  // candidate generation (candidate_time_fraction_) and the v-cycles
+  // (vcycle_time_fraction_), and no new candidate or v-cycle is started when
+  // the budget of its phase is used up.  The refiners and the ILP solver
+  // stop when the deadline is expired, and the best solution found so far is
+  // returned.  The shortened phases are recorded in the deadline.
+  // If no deadline is set, there is no limit.
+  void SetDeadline(DeadlinePtr deadline);
+
+  // The candidate solutions of Partition are requested from generator
+  // concurrently, and the ones that fail are generated locally.
+  // nullptr means that all the candidates are generated locally.
+  void SetRemoteCandidateGenerator(CandidateGenerator generator);
+
+  // Generate one candidate solution (coarsening, initial partitioning,
+  // refinement and cut-overlay ILP) with coarsen_seed in the same way as
+  // the parallel mode of Partition, but with all the num_threads threads.
+  // This is the work done by a remote worker for each candidate.
+  std::vector<int> GenerateCandidate(const HGraphPtr& hgraph,
+                                     const Matrix<float>& upper_block_balance,
+                                     const Matrix<float>& lower_block_balance,
+                                     int coarsen_seed) const;
 
  private:
+  // Create a multilevel partitioner with its own coarsener, partitioner and
+  // refiners for generating a candidate solution in a separate thread.
+  // The evaluator, logger and thread pool are shared.
+  MultiLevelPartitioner CreateCandidatePartitioner(int coarsen_seed) const;
+
+  // Add a parallel region with wall_time to the profiler (if any).
+  // busy_times contains the busy time of each thread in the region.
+  void RecordParallelRegion(double wall_time,
+                            const std::vector<double>& busy_times) const;
+
+  // Return the end of a phase using fraction of the remaining time
+  Deadline::Clock::time_point StartPhase(float fraction) const;
+
+  // Return true if the phase ending at phase_end is out of time
+  bool IsPhaseExpired(Deadline::Clock::time_point phase_end) const;
+
+  // Run the guided v-cycles in rounds of num_parallel_vcycles_ concurrent
+  // v-cycles. The solutions are kept in an elite pool, and the best solution
+  // in the pool guides the next round. The refinement stops early if a
+  // round cannot improve the best solution. Finally, the elite solutions
+  // are merged with cut-overlay clustering and ILP-based partitioning.
+  void ParallelVcycleRefinement(const HGraphPtr& hgraph,
+                                const Matrix<float>& upper_block_balance,
+                                const Matrix<float>& lower_block_balance,
+                                std::vector<int>& best_solution,
+                                Deadline::Clock::time_point phase_end) const;
+
   // Run single-level partitioning
   std::vector<int> SingleLevelPartition(
       const HGraphPtr& hgraph,
@@ -108,6 +205,20 @@ class MultilevelPartitioner
                         Matrix<int>& top_initial_solutions,
                         int& best_solution_id) const;
 
+  // Generate one initial solution for each seed with random partitioning
+  // and FM refinement (in parallel). The solutions, costs and balance flags
+  // are appended to initial_solutions, initial_solutions_cost and
+  // initial_solutions_flag in the order of seeds.
+  void GenerateInitialSolutions(
+      const HGraphPtr& hgraph,
+      const Matrix<float>& upper_block_balance,
+      const Matrix<float>& lower_block_balance,
+      PartitionType partition_type,
+      const std::vector<int>& seeds,
+      Matrix<int>& initial_solutions,
+      std::vector<float>& initial_solutions_cost,
+      std::vector<bool>& initial_solutions_flag) const;
+
   // Refine the solutions in top_solutions in parallel with multi-threading
   // the top_solutions and best_solution_id will be updated during this process
   void RefinePartition(CoarseGraphPtrs hierarchy,
@@ -120,10 +231,18 @@ class MultilevelPartitioner
   // Refine function
   // Ilp refinement, k_way_pm_refinement,
   // k_way_fm_refinement and greedy refinement
+  // (label propagation instead of FM on the large levels)
+  // The connectivity status of the solution is built once and shared by
+  // all the refiners. It is returned in state for evaluating the solution
   void CallRefiner(const HGraphPtr& hgraph,
                    const Matrix<float>& upper_block_balance,
                    const Matrix<float>& lower_block_balance,
-                   std::vector<int>& solution) const;
+                   std::vector<int>& solution,
+                   PartitionState& state) const;
+
+  // The statistics of the refiners are reported for the level (the distance
+  // to the finest hypergraph) of the multilevel refinement (-1 means none)
+  void SetRefinementLevel(int level) const;
 
   // Perform cut-overlay clustering and ILP-based partitioning
   // The ILP-based partitioning uses top_solutions[best_solution_id] as a hint,
@@ -134,6 +253,18 @@ class MultilevelPartitioner
                                      const Matrix<int>& top_solutions,
                                      int best_solution_id) const;
 
+  // hyperedge_mask[e] = 1 if hyperedge e is cut by any of the solutions
+  std::vector<uint8_t> GetCutOverlayMask(const HGraphPtr& hgraph,
+                                         const Matrix<int>& solutions) const;
+
+  // Group the vertices connected by the hyperedges not in hyperedge_mask
+  // into clusters (connected components).  The clusters are numbered in
+  // the increasing order of their smallest vertex id.
+  // Return the number of clusters
+  int DetectConnectedComponents(const HGraphPtr& hgraph,
+                                const std::vector<uint8_t>& hyperedge_mask,
+                                std::vector<int>& vertex_cluster_vec) const;
+
   // basic parameters
   const int num_parts_ = 2;
   const int num_vertices_threshold_ilp_
@@ -147,6 +278,19 @@ class MultilevelPartitioner
       = 3;  // number of coarsening solutions with different random seed
   const int seed_ = 0;  // random seed
   const bool v_cycle_flag_ = true;
+  int num_threads_ = 1;  // number of threads for candidate generation
+  int init_plateau_window_ = 0;  // 0 means no early stop for initial part
+  int num_parallel_vcycles_ = 1;  // 1 means serial v-cycle refinement
+  // the levels larger than the threshold are refined by label propagation.
+  // 0 means no label propagation refinement
+  int num_vertices_threshold_lp_ = 0;
+  // the fractions of the remaining time used by the candidate generation and
+  // the v-cycles of Partition (the last-minute v-cycles use the rest)
+  const float candidate_time_fraction_ = 0.4;
+  const float vcycle_time_fraction_ = 0.5;
+  // the minimum number of items for running the cut-overlay clustering
+  // in parallel
+  const int parallel_workload_threshold_ = 4096;
 
   // pointers
   CoarseningPtr coarsener_ = nullptr;
@@ -155,8 +299,14 @@ class MultilevelPartitioner
   KWayPMRefinerPtr k_way_pm_refiner_ = nullptr;
   GreedyRefinerPtr greedy_refiner_ = nullptr;
   IlpRefinerPtr ilp_refiner_ = nullptr;
+  LabelPropagationRefinerPtr lp_refiner_ = nullptr;
+  CandidateGenerator remote_generator_ = nullptr;
   EvaluatorPtr evaluator_ = nullptr;
   utl::Logger* logger_ = nullptr;
+  // the thread pool shared by all the refiners
+  ThreadPoolPtr thread_pool_ = nullptr;
+  ProfilerPtr profiler_ = nullptr;
+  DeadlinePtr deadline_ = nullptr;
 };
 
 }  // namespace par
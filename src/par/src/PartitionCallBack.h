@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "PartitionJobDescription.h"
+#include "TritonPart.h"
+#include "dst/Distributed.h"
+#include "dst/JobCallBack.h"
+#include "dst/JobMessage.h"
+#include "utl/Logger.h"
+
+namespace par {
+
+// Serve the distributed candidate-solution generation of TritonPart on a
+// dst worker. The hypergraph of the last LOAD_HYPERGRAPH job is kept by
+// triton_part_ and used by all the following GENERATE_CANDIDATE jobs.
+// In the server mode, the worker keeps up to max_num_resident_ hypergraphs
+// loaded by the PARTITION_RESIDENT and EVALUATE_RESIDENT jobs, and the
+// least recently used one is dropped to load a new one.
+class PartitionCallBack : public dst::JobCallBack
+{
+ public:
+  PartitionCallBack(ord::dbNetwork* network,
+                    odb::dbDatabase* db,
+                    sta::dbSta* sta,
+                    dst::Distributed* dist,
+                    utl::Logger* logger)
+      : network_(network), db_(db), sta_(sta), dist_(dist), logger_(logger)
+  {
+  }
+  void onRoutingJobReceived(dst::JobMessage& msg, dst::socket& sock) override
+  {
+  }
+  void onFrDesignUpdated(dst::JobMessage& msg, dst::socket& sock) override {}
+  void onPinAccessJobReceived(dst::JobMessage& msg, dst::socket& sock) override
+  {
+  }
+  void onGRDRInitJobReceived(dst::JobMessage& msg, dst::socket& sock) override
+  {
+  }
+  void onPartitionJobReceived(dst::JobMessage& msg, dst::socket& sock) override
+  {
+    if (msg.getJobType() != dst::JobMessage::PARTITIONING) {
+      return;
+    }
+    auto desc = static_cast<PartitionJobDescription*>(msg.getJobDescription());
+    dst::JobMessage result(dst::JobMessage::ERROR);
+    if (desc != nullptr) {
+      if (desc->getType() == PartitionJobDescription::PARTITION_RESIDENT
+          || desc->getType() == PartitionJobDescription::EVALUATE_RESIDENT) {
+        onResidentJobReceived(*desc, result);
+      } else if (desc->getType() == PartitionJobDescription::LOAD_HYPERGRAPH) {
+        triton_part_
+            = std::make_unique<TritonPart>(network_, db_, sta_, logger_);
+        if (triton_part_->LoadRemoteHypergraph(*desc) == true) {
+          result.setJobType(dst::JobMessage::SUCCESS);
+        } else {
+          triton_part_.reset();
+        }
+      } else if (triton_part_ != nullptr) {
+        std::vector<int> solution;
+        if (triton_part_->GenerateRemoteCandidate(desc->getSeed(), solution)
+            == true) {
+          auto result_desc = std::make_unique<PartitionJobDescription>();
+          result_desc->setType(PartitionJobDescription::GENERATE_CANDIDATE);
+          result_desc->setSeed(desc->getSeed());
+          result_desc->setSolution(solution);
+          result.setJobDescription(std::move(result_desc));
+          result.setJobType(dst::JobMessage::SUCCESS);
+        }
+      }
+    }
+    dist_->sendResult(result, sock);
+    sock.close();
+  }
+
+ private:
+  void onResidentJobReceived(const PartitionJobDescription& desc,
+                             dst::JobMessage& result)
+  {
+    auto iter = resident_.find(desc.getHypergraphId());
+    if (iter == resident_.end()) {
+      if (resident_.size() >= max_num_resident_) {
+        resident_.erase(std::min_element(
+            resident_.begin(), resident_.end(), [](auto& a, auto& b) {
+              return a.second.last_use < b.second.last_use;
+            }));
+      }
+      Resident resident;
+      resident.triton_part
+          = std::make_unique<TritonPart>(network_, db_, sta_, logger_);
+      iter = resident_.emplace(desc.getHypergraphId(), std::move(resident))
+                 .first;
+    }
+    Resident& resident = iter->second;
+    resident.last_use = ++num_jobs_;
+
+    auto result_desc = std::make_unique<PartitionJobDescription>();
+    result_desc->setType(desc.getType());
+    bool success = false;
+    if (desc.getType() == PartitionJobDescription::PARTITION_RESIDENT) {
+      std::vector<int> solution;
+      success
+          = resident.triton_part->PartitionResidentHypergraph(desc, solution);
+      result_desc->setSolution(solution);
+    } else {
+      PartitionToken token;
+      bool feasible = false;
+      success = resident.triton_part->EvaluateResidentSolution(
+          desc, token, feasible);
+      result_desc->setEvaluation(token.cost, token.block_balance, feasible);
+    }
+    if (success == true) {
+      result.setJobDescription(std::move(result_desc));
+      result.setJobType(dst::JobMessage::SUCCESS);
+    } else {
+      // the hypergraph is loaded again by the next job
+      resident_.erase(iter);
+    }
+  }
+
+  struct Resident
+  {
+    std::unique_ptr<TritonPart> triton_part;
+    int64_t last_use = 0;
+  };
+
+  ord::dbNetwork* network_;
+  odb::dbDatabase* db_;
+  sta::dbSta* sta_;
+  dst::Distributed* dist_;
+  utl::Logger* logger_;
+  std::unique_ptr<TritonPart> triton_part_;
+  // the resident hypergraphs of the server mode by their ids
+  std::map<std::string, Resident> resident_;
+  const size_t max_num_resident_ = 16;
+  int64_t num_jobs_ = 0;
+};
+
+}  // namespace par
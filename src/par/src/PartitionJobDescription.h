@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <string>
+#include <vector>
+
+#include "dst/JobMessage.h"
+
+namespace boost::serialization {
+class access;
+}
+
+namespace par {
+
+// The job description of distributed candidate-solution generation.
+// LOAD_HYPERGRAPH is broadcast once: each worker loads the binary
+// hypergraph from the shared volume and the partitioning parameters.
+// GENERATE_CANDIDATE asks a worker for one candidate solution generated
+// with the given coarsening seed. Only the solution is sent back.
+//
+// In the server mode, a worker keeps the hypergraphs resident by their ids.
+// PARTITION_RESIDENT partitions the hypergraph with the given parameters
+// and sends the solution back, EVALUATE_RESIDENT evaluates the given
+// solution and sends its cost and block balance back.  The hypergraph and
+// attribute files are loaded by the first job of each hypergraph id.
+class PartitionJobDescription : public dst::JobDescription
+{
+ public:
+  enum Type : int
+  {
+    LOAD_HYPERGRAPH,
+    GENERATE_CANDIDATE,
+    PARTITION_RESIDENT,
+    EVALUATE_RESIDENT
+  };
+
+  void setType(Type type) { type_ = type; }
+  void setHypergraphFile(const std::string& file) { hypergraph_file_ = file; }
+  void setParams(const std::string& params) { params_ = params; }
+  void setBlockBalance(const std::vector<std::vector<float>>& upper,
+                       const std::vector<std::vector<float>>& lower)
+  {
+    upper_block_balance_ = upper;
+    lower_block_balance_ = lower;
+  }
+  void setSeed(int seed) { seed_ = seed; }
+  void setSolution(const std::vector<int>& solution) { solution_ = solution; }
+  void setHypergraphId(const std::string& id) { hypergraph_id_ = id; }
+  // fixed, community, group and placement files
+  void setAttributeFiles(const std::vector<std::string>& files)
+  {
+    attribute_files_ = files;
+  }
+  void setBalance(float ub_factor,
+                  const std::vector<float>& base_balance,
+                  const std::vector<float>& scale_factor)
+  {
+    ub_factor_ = ub_factor;
+    base_balance_ = base_balance;
+    scale_factor_ = scale_factor;
+  }
+  void setEvaluation(float cost,
+                     const std::vector<std::vector<float>>& block_balance,
+                     bool feasible)
+  {
+    cost_ = cost;
+    block_balance_ = block_balance;
+    feasible_ = feasible;
+  }
+
+  Type getType() const { return type_; }
+  const std::string& getHypergraphFile() const { return hypergraph_file_; }
+  const std::string& getParams() const { return params_; }
+  const std::vector<std::vector<float>>& getUpperBlockBalance() const
+  {
+    return upper_block_balance_;
+  }
+  const std::vector<std::vector<float>>& getLowerBlockBalance() const
+  {
+    return lower_block_balance_;
+  }
+  int getSeed() const { return seed_; }
+  const std::vector<int>& getSolution() const { return solution_; }
+  const std::string& getHypergraphId() const { return hypergraph_id_; }
+  const std::vector<std::string>& getAttributeFiles() const
+  {
+    return attribute_files_;
+  }
+  float getUbFactor() const { return ub_factor_; }
+  const std::vector<float>& getBaseBalance() const { return base_balance_; }
+  const std::vector<float>& getScaleFactor() const { return scale_factor_; }
+  float getCost() const { return cost_; }
+  const std::vector<std::vector<float>>& getBlockBalance() const
+  {
+    return block_balance_;
+  }
+  bool isFeasible() const { return feasible_; }
+
+ private:
+  Type type_ = LOAD_HYPERGRAPH;
+  // LOAD_HYPERGRAPH
+  std::string hypergraph_file_;
+  std::string params_;  // serialized by TritonPart::WriteRemoteParams
+  std::vector<std::vector<float>> upper_block_balance_;
+  std::vector<std::vector<float>> lower_block_balance_;
+  // GENERATE_CANDIDATE
+  int seed_ = 0;
+  std::vector<int> solution_;  // the result
+  // PARTITION_RESIDENT and EVALUATE_RESIDENT
+  // (hypergraph_file_ and params_ are also used)
+  std::string hypergraph_id_;
+  std::vector<std::string> attribute_files_;
+  float ub_factor_ = 1.0;
+  std::vector<float> base_balance_;
+  std::vector<float> scale_factor_;
+  // the result of EVALUATE_RESIDENT
+  float cost_ = 0.0;
+  std::vector<std::vector<float>> block_balance_;
+  bool feasible_ = false;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int version)
+  {
+    (ar) & boost::serialization::base_object<dst::JobDescription>(*this);
+    (ar) & type_;
+    (ar) & hypergraph_file_;
+    (ar) & params_;
+    (ar) & upper_block_balance_;
+    (ar) & lower_block_balance_;
+    (ar) & seed_;
+    (ar) & solution_;
+    (ar) & hypergraph_id_;
+    (ar) & attribute_files_;
+    (ar) & ub_factor_;
+    (ar) & base_balance_;
+    (ar) & scale_factor_;
+    (ar) & cost_;
+    (ar) & block_balance_;
+    (ar) & feasible_;
+  }
+  friend class boost::serialization::access;
+};
+
+}  // namespace par
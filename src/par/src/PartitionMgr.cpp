@@ -36,57 +36,61 @@
 #include "par/PartitionMgr.h"
 
 #include <algorithm>
+#include <cctype>
 #include <chrono>
 #include <cmath>
 #include <ctime>
 #include <fstream>
 #include <iostream>
 
+#include "PartitionCallBack.h"
+#include "TimingPathsCache.h"
 #include "TritonPart.h"
 #include "Utilities.h"
 #include "db_sta/dbSta.hh"
 #include "odb/db.h"
-#include "sta/MakeConcreteNetwork.hh"
 #include "sta/ParseBus.hh"
 #include "sta/PortDirection.hh"
-#include "sta/VerilogWriter.hh"
 #include "utl/Logger.h"
 
 using odb::dbBlock;
+using odb::dbBTerm;
 using odb::dbInst;
 using odb::dbIntProperty;
+using odb::dbIoType;
+using odb::dbITerm;
+using odb::dbNet;
 
-using sta::Cell;
-using sta::CellPortBitIterator;
-using sta::ConcreteNetwork;
 using sta::dbNetwork;
-using sta::Instance;
-using sta::InstancePinIterator;
 using sta::isBusName;
-using sta::Library;
-using sta::Net;
-using sta::NetPinIterator;
-using sta::NetTermIterator;
-using sta::NetworkReader;
 using sta::parseBusName;
-using sta::Pin;
-using sta::Port;
 using sta::PortDirection;
-using sta::Term;
-using sta::writeVerilog;
 using utl::PAR;
 
 namespace par {
 
+PartitionMgr::PartitionMgr()
+    : timing_paths_cache_(std::make_unique<TimingPathsCache>())
+{
+}
+
+PartitionMgr::~PartitionMgr() = default;
+
 void PartitionMgr::init(odb::dbDatabase* db,
                         sta::dbNetwork* db_network,
                         sta::dbSta* sta,
-                        utl::Logger* logger)
+                        utl::Logger* logger,
+                        dst::Distributed* dist)
 {
   db_ = db;
   db_network_ = db_network;
   sta_ = sta;
   logger_ = logger;
+  dist_ = dist;
+  if (dist_ != nullptr) {
+    dist_->addCallBack(
+        new PartitionCallBack(db_network_, db_, sta_, dist_, logger_));
+  }
 }
 
 // The function for partitioning a hypergraph
@@ -144,6 +148,31 @@ void PartitionMgr::tritonPartHypergraph(
   // Thus users can use this function to partition the input hypergraph
   auto triton_part
       = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  triton_part->SetNumThreads(num_threads_);
+  triton_part->SetInitPlateauWindow(init_plateau_window_);
+  triton_part->SetGainBucketType(gain_bucket_type_, gain_resolution_);
+  triton_part->SetParallelMatching(parallel_matching_);
+  triton_part->SetDetectCommunities(detect_communities_);
+  triton_part->SetSpectralDimensions(spectral_dimensions_);
+  triton_part->SetStreamingCoarseningRatio(streaming_coarsening_ratio_);
+  triton_part->SetIlpParams(ilp_time_limit_, ilp_num_threads_, ilp_solver_);
+  triton_part->SetNumParallelVcycles(num_parallel_vcycles_);
+  triton_part->SetNumVerticesThresholdLp(num_vertices_threshold_lp_);
+  triton_part->SetVertexOrder(vertex_order_);
+  triton_part->SetLazyGainThreshold(lazy_gain_threshold_);
+  triton_part->SetAdaptiveStopAlpha(adaptive_stop_alpha_);
+  triton_part->SetFixedPointBits(fixed_point_bits_);
+  triton_part->SetTimeLimit(time_limit_);
+  triton_part->SetSolutionCacheDir(solution_cache_dir_);
+  triton_part->SetPartitionMode(partition_mode_);
+  if (dist_ != nullptr && !remote_host_.empty()) {
+    triton_part->SetDistributed(
+        dist_, remote_host_, remote_port_, shared_volume_);
+  }
+  if (dist_ != nullptr && !server_host_.empty()) {
+    triton_part->SetServer(
+        dist_, server_host_, server_port_, server_hypergraph_id_);
+  }
   // Convert the string e_wt_factors_str to vector
   triton_part->SetNetWeight(e_wt_factors);
   triton_part->SetVertexWeight(v_wt_factors);
@@ -210,6 +239,10 @@ void PartitionMgr::evaluateHypergraphSolution(
   // Convert the string e_wt_factors_str to vector
   triton_part->SetNetWeight(e_wt_factors);
   triton_part->SetVertexWeight(v_wt_factors);
+  if (dist_ != nullptr && !server_host_.empty()) {
+    triton_part->SetServer(
+        dist_, server_host_, server_port_, server_hypergraph_id_);
+  }
   triton_part->EvaluateHypergraphSolution(num_parts,
                                           balance_constraint,
                                           base_balance,
@@ -222,6 +255,62 @@ void PartitionMgr::evaluateHypergraphSolution(
                                           solution_file);
 }
 
+// Evaluate many solutions of the same hypergraph
+void PartitionMgr::evaluateHypergraphSolutions(
+    unsigned int num_parts,
+    float balance_constraint,
+    const std::vector<float>& base_balance,
+    const std::vector<float>& scale_factor,
+    int vertex_dimension,
+    int hyperedge_dimension,
+    const char* hypergraph_file,
+    const char* fixed_file,
+    const char* group_file,
+    const std::vector<std::string>& solution_files,
+    const char* summary_file,
+    // weight parameters
+    const std::vector<float>& e_wt_factors,
+    const std::vector<float>& v_wt_factors)
+{
+  auto triton_part
+      = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  triton_part->SetNumThreads(num_threads_);
+  triton_part->SetNetWeight(e_wt_factors);
+  triton_part->SetVertexWeight(v_wt_factors);
+  triton_part->EvaluateHypergraphSolutions(num_parts,
+                                           balance_constraint,
+                                           base_balance,
+                                           scale_factor,
+                                           vertex_dimension,
+                                           hyperedge_dimension,
+                                           hypergraph_file,
+                                           fixed_file,
+                                           group_file,
+                                           solution_files,
+                                           summary_file);
+}
+
+void PartitionMgr::writeHypergraphBinary(int vertex_dimension,
+                                         int hyperedge_dimension,
+                                         int placement_dimension,
+                                         const char* hypergraph_file,
+                                         const char* fixed_file,
+                                         const char* community_file,
+                                         const char* placement_file,
+                                         const char* binary_file)
+{
+  auto triton_part
+      = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  triton_part->WriteHypergraphBinary(vertex_dimension,
+                                     hyperedge_dimension,
+                                     placement_dimension,
+                                     hypergraph_file,
+                                     fixed_file,
+                                     community_file,
+                                     placement_file,
+                                     binary_file);
+}
+
 // Top level interface
 // The function for partitioning a hypergraph
 // This is the main API for TritonPart
@@ -285,6 +374,22 @@ void PartitionMgr::tritonPartDesign(
 {
   auto triton_part
       = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  triton_part->SetNumThreads(num_threads_);
+  triton_part->SetInitPlateauWindow(init_plateau_window_);
+  triton_part->SetGainBucketType(gain_bucket_type_, gain_resolution_);
+  triton_part->SetParallelMatching(parallel_matching_);
+  triton_part->SetDetectCommunities(detect_communities_);
+  triton_part->SetSpectralDimensions(spectral_dimensions_);
+  triton_part->SetIlpParams(ilp_time_limit_, ilp_num_threads_, ilp_solver_);
+  triton_part->SetNumParallelVcycles(num_parallel_vcycles_);
+  triton_part->SetNumVerticesThresholdLp(num_vertices_threshold_lp_);
+  triton_part->SetVertexOrder(vertex_order_);
+  triton_part->SetLazyGainThreshold(lazy_gain_threshold_);
+  triton_part->SetAdaptiveStopAlpha(adaptive_stop_alpha_);
+  triton_part->SetFixedPointBits(fixed_point_bits_);
+  triton_part->SetTimeLimit(time_limit_);
+  triton_part->SetTimingPathsCache(getTimingPathsCache());
+  triton_part->SetWarmStart(warm_start_);
   // Convert the string e_wt_factors_str to vector
   triton_part->SetNetWeight(e_wt_factors);
   triton_part->SetVertexWeight(v_wt_factors);
@@ -376,6 +481,7 @@ void PartitionMgr::evaluatePartDesignSolution(
 {
   auto triton_part
       = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  triton_part->SetTimingPathsCache(getTimingPathsCache());
   // Convert the string e_wt_factors_str to vector
   triton_part->SetNetWeight(e_wt_factors);
   triton_part->SetVertexWeight(v_wt_factors);
@@ -407,6 +513,56 @@ void PartitionMgr::evaluatePartDesignSolution(
                                           solution_filename_arg);
 }
 
+void PartitionMgr::tritonPartHypergraphArrays(unsigned int num_parts,
+                                              float balance_constraint,
+                                              unsigned int seed,
+                                              const int* eptr,
+                                              int num_eptr,
+                                              const int* eind,
+                                              int num_eind,
+                                              const float* vertex_weights,
+                                              int num_vertex_weights,
+                                              const float* hyperedge_weights,
+                                              int num_hyperedge_weights,
+                                              const int* fixed_attr,
+                                              int num_fixed_attr,
+                                              int* solution,
+                                              int num_vertices)
+{
+  auto triton_part
+      = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  triton_part->SetNumThreads(num_threads_);
+  triton_part->SetInitPlateauWindow(init_plateau_window_);
+  triton_part->SetGainBucketType(gain_bucket_type_, gain_resolution_);
+  triton_part->SetParallelMatching(parallel_matching_);
+  triton_part->SetDetectCommunities(detect_communities_);
+  triton_part->SetSpectralDimensions(spectral_dimensions_);
+  triton_part->SetIlpParams(ilp_time_limit_, ilp_num_threads_, ilp_solver_);
+  triton_part->SetNumParallelVcycles(num_parallel_vcycles_);
+  triton_part->SetNumVerticesThresholdLp(num_vertices_threshold_lp_);
+  triton_part->SetVertexOrder(vertex_order_);
+  triton_part->SetLazyGainThreshold(lazy_gain_threshold_);
+  triton_part->SetAdaptiveStopAlpha(adaptive_stop_alpha_);
+  triton_part->SetFixedPointBits(fixed_point_bits_);
+  triton_part->SetTimeLimit(time_limit_);
+  triton_part->SetPartitionMode(partition_mode_);
+  triton_part->PartitionHypergraphArrays(num_parts,
+                                         balance_constraint,
+                                         seed,
+                                         eptr,
+                                         num_eptr,
+                                         eind,
+                                         num_eind,
+                                         vertex_weights,
+                                         num_vertex_weights,
+                                         hyperedge_weights,
+                                         num_hyperedge_weights,
+                                         fixed_attr,
+                                         num_fixed_attr,
+                                         solution,
+                                         num_vertices);
+}
+
 // k-way partitioning used by Hier-RTLMP
 std::vector<int> PartitionMgr::PartitionKWaySimpleMode(
     unsigned int num_parts_arg,
@@ -416,72 +572,104 @@ std::vector<int> PartitionMgr::PartitionKWaySimpleMode(
     const std::vector<float>& vertex_weights,
     const std::vector<float>& hyperedge_weights)
 {
+  std::vector<int> eptr;
+  std::vector<int> eind;
+  eptr.reserve(hyperedges.size() + 1);
+  eptr.push_back(0);
+  for (const auto& hyperedge : hyperedges) {
+    eind.insert(eind.end(), hyperedge.begin(), hyperedge.end());
+    eptr.push_back(static_cast<int>(eind.size()));
+  }
+
+  HypergraphView hypergraph;
+  hypergraph.num_vertices = static_cast<int>(vertex_weights.size());
+  hypergraph.num_hyperedges = static_cast<int>(hyperedges.size());
+  hypergraph.eptr = eptr.data();
+  hypergraph.eind = eind.data();
+  hypergraph.vertex_weights = vertex_weights.data();
+  hypergraph.hyperedge_weights
+      = hyperedge_weights.empty() ? nullptr : hyperedge_weights.data();
+
+  std::vector<int> solution(hypergraph.num_vertices, 0);
+  PartitionKWaySimpleMode(num_parts_arg,
+                          balance_constraint_arg,
+                          seed_arg,
+                          hypergraph,
+                          solution.data());
+  return solution;
+}
+
+void PartitionMgr::PartitionKWaySimpleMode(unsigned int num_parts_arg,
+                                           float balance_constraint_arg,
+                                           unsigned int seed_arg,
+                                           const HypergraphView& hypergraph,
+                                           int* solution) const
+{
+  // the partitioner is the context of this call, nothing is shared
   auto triton_part
       = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
-  return triton_part->PartitionKWaySimpleMode(num_parts_arg,
-                                              balance_constraint_arg,
-                                              seed_arg,
-                                              hyperedges,
-                                              vertex_weights,
-                                              hyperedge_weights);
+  const int num_eind
+      = hypergraph.eptr != nullptr && hypergraph.num_hyperedges >= 0
+            ? hypergraph.eptr[hypergraph.num_hyperedges]
+            : 0;
+  triton_part->PartitionHypergraphArrays(
+      num_parts_arg,
+      balance_constraint_arg,
+      seed_arg,
+      hypergraph.eptr,
+      hypergraph.num_hyperedges + 1,
+      hypergraph.eind,
+      num_eind,
+      hypergraph.vertex_weights,
+      hypergraph.vertex_weights != nullptr ? hypergraph.num_vertices : 0,
+      hypergraph.hyperedge_weights,
+      hypergraph.hyperedge_weights != nullptr ? hypergraph.num_hyperedges
+                                              : 0,
+      nullptr,
+      0,
+      solution,
+      hypergraph.num_vertices);
 }
 
-// determine the required direction of a port.
-static PortDirection* determinePortDirection(const Net* net,
-                                             const std::set<Instance*>* insts,
-                                             const dbNetwork* db_network)
+std::vector<std::vector<int>> PartitionMgr::CoarsenHypergraph(
+    unsigned int seed_arg,
+    const HypergraphView& hypergraph,
+    int thr_coarsen_vertices,
+    float max_cluster_weight) const
 {
-  bool local_only = true;
-  bool locally_driven = false;
-  bool externally_driven = false;
-
-  NetTermIterator* term_iter = db_network->termIterator(net);
-  while (term_iter->hasNext()) {
-    Term* term = term_iter->next();
-    PortDirection* dir = db_network->direction(db_network->pin(term));
-    if (dir->isAnyInput()) {
-      externally_driven = true;
-    }
-    local_only = false;
-  }
-  delete term_iter;
-
-  if (insts != nullptr) {
-    NetPinIterator* pin_iter = db_network->pinIterator(net);
-    while (pin_iter->hasNext()) {
-      const Pin* pin = pin_iter->next();
-      const PortDirection* dir = db_network->direction(pin);
-      Instance* inst = db_network->instance(pin);
-
-      if (insts->find(inst) == insts->end()) {
-        local_only = false;
-        if (dir->isAnyOutput()) {
-          externally_driven = true;
-        }
-      } else {
-        if (dir->isAnyOutput()) {
-          locally_driven = true;
-        }
-      }
-    }
-    delete pin_iter;
-  }
+  auto triton_part
+      = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  triton_part->SetNumThreads(num_threads_);
+  const int num_eind
+      = hypergraph.eptr != nullptr && hypergraph.num_hyperedges >= 0
+            ? hypergraph.eptr[hypergraph.num_hyperedges]
+            : 0;
+  return triton_part->CoarsenHypergraphArrays(seed_arg,
+                                              hypergraph.eptr,
+                                              hypergraph.num_hyperedges + 1,
+                                              hypergraph.eind,
+                                              num_eind,
+                                              hypergraph.vertex_weights,
+                                              hypergraph.num_vertices,
+                                              thr_coarsen_vertices,
+                                              max_cluster_weight);
+}
 
-  // no port is needed
-  if (local_only) {
-    return nullptr;
-  }
+namespace {
 
-  if (locally_driven && externally_driven) {
-    return PortDirection::bidirect();
-  }
+// A signal of a partitioned verilog module. Bus bits sharing the same
+// base name are merged into one declaration covering [min_idx, max_idx].
+struct VerilogSignal
+{
+  PortDirection* dir = nullptr;  // nullptr for wires
+  bool is_bus = false;
+  int min_idx = 0;
+  int max_idx = 0;
+};
 
-  if (externally_driven) {
-    return PortDirection::input();
-  }
+using VerilogSignals = std::map<std::string, VerilogSignal>;
 
-  return PortDirection::output();
-}
+}  // namespace
 
 // find the correct brackets used in the liberty libraries.
 static void determineLibraryBrackets(const dbNetwork* db_network,
@@ -500,247 +688,148 @@ static void determineLibraryBrackets(const dbNetwork* db_network,
   delete lib_iter;
 }
 
-// Builds an instance/cell of a partition
-Instance* PartitionMgr::buildPartitionedInstance(
-    const char* name,
-    const char* port_prefix,
-    sta::Library* library,
-    sta::NetworkReader* network,
-    sta::Instance* parent,
-    const std::set<Instance*>* insts,
-    std::map<Net*, Port*>* port_map)
+// convert an odb name into a verilog identifier, escaping it if needed.
+static std::string verilogName(const std::string& name)
 {
-  // build cell
-  Cell* cell = network->makeCell(library, name, false, nullptr);
-
-  // add global ports
-  auto pin_iter = db_network_->pinIterator(db_network_->topInstance());
-  while (pin_iter->hasNext()) {
-    const Pin* pin = pin_iter->next();
-
-    bool add_port = false;
-    Net* net = db_network_->net(db_network_->term(pin));
-    if (net) {
-      NetPinIterator* net_pin_iter = db_network_->pinIterator(net);
-      while (net_pin_iter->hasNext()) {
-        // check if port is connected to instance in this partition
-        if (insts->find(db_network_->instance(net_pin_iter->next()))
-            != insts->end()) {
-          add_port = true;
-          break;
-        }
-      }
-      delete net_pin_iter;
+  std::string ident;
+  ident.reserve(name.size());
+  bool is_simple = !name.empty()
+                   && !std::isdigit(static_cast<unsigned char>(name[0]))
+                   && name[0] != '$';
+  for (size_t i = 0; i < name.size(); i++) {
+    char ch = name[i];
+    if (ch == '\\' && i + 1 < name.size()) {
+      ch = name[++i];  // drop the odb escape
     }
-
-    if (add_port) {
-      const char* portname = db_network_->name(pin);
-
-      Port* port = network->makePort(cell, portname);
-      // copy exactly the parent port direction
-      network->setDirection(port, db_network_->direction(pin));
-      PortDirection* sub_module_dir
-          = determinePortDirection(net, insts, db_network_);
-      if (sub_module_dir != nullptr) {
-        network->setDirection(port, sub_module_dir);
-      }
-
-      port_map->insert({net, port});
+    if (!std::isalnum(static_cast<unsigned char>(ch)) && ch != '_'
+        && ch != '$') {
+      is_simple = false;
     }
+    ident += ch;
   }
-  delete pin_iter;
-
-  // make internal ports for partitions and if port is not needed.
-  std::set<Net*> local_nets;
-  for (Instance* inst : *insts) {
-    InstancePinIterator* pin_iter = db_network_->pinIterator(inst);
-    while (pin_iter->hasNext()) {
-      Net* net = db_network_->net(pin_iter->next());
-      if (net != nullptr &&                          // connected
-          port_map->find(net) == port_map->end() &&  // port not present
-          local_nets.find(net) == local_nets.end()) {
-        // check if connected to anything in a different partition
-        NetPinIterator* net_pin_iter = db_network_->pinIterator(net);
-        while (net_pin_iter->hasNext()) {
-          Net* net = db_network_->net(net_pin_iter->next());
-          PortDirection* port_dir
-              = determinePortDirection(net, insts, db_network_);
-          if (port_dir == nullptr) {
-            local_nets.insert(net);
-            continue;
-          }
-          std::string port_name = port_prefix;
-          port_name += db_network_->name(net);
-
-          Port* port = network->makePort(cell, port_name.c_str());
-          network->setDirection(port, port_dir);
-
-          port_map->insert({net, port});
-          break;
-        }
-        delete net_pin_iter;
-      }
-    }
-    delete pin_iter;
-  }
+  return is_simple ? ident : "\\" + ident + " ";
+}
 
-  // loop over buses and to ensure all bit ports are created, only needed for
-  // partitioned modules
-  char path_escape = db_network_->pathEscape();
-  char left_bracket;
-  char right_bracket;
-  determineLibraryBrackets(db_network_, &left_bracket, &right_bracket);
-  std::map<std::string, std::vector<Port*>> port_buses;
-  for (auto& [net, port] : *port_map) {
-    std::string portname = network->name(port);
-
-    // check if bus and get name
-    if (isBusName(portname.c_str(), left_bracket, right_bracket, path_escape)) {
-      std::string bus_name;
-      bool is_bus;
-      int idx;
-      parseBusName(portname.c_str(),
-                   left_bracket,
-                   right_bracket,
-                   path_escape,
-                   is_bus,
-                   bus_name,
-                   idx);
-
-      portname = bus_name;
-      port_buses[portname].push_back(port);
-    }
+// add a (bit of a) signal to the declarations of a module.
+static void addVerilogSignal(VerilogSignals& signals,
+                             const std::string& name,
+                             PortDirection* dir,
+                             char left,
+                             char right,
+                             char escape)
+{
+  std::string base = name;
+  bool is_bus = false;
+  int idx = 0;
+  if (isBusName(name.c_str(), left, right, escape)) {
+    parseBusName(name.c_str(), left, right, escape, is_bus, base, idx);
   }
-  for (auto& [bus, ports] : port_buses) {
-    std::set<int> port_idx;
-    std::set<PortDirection*> port_dirs;
-    for (Port* port : ports) {
-      std::string bus_name;
-      bool is_bus;
-      int idx;
-      parseBusName(network->name(port),
-                   left_bracket,
-                   right_bracket,
-                   path_escape,
-                   is_bus,
-                   bus_name,
-                   idx);
-
-      port_idx.insert(idx);
-      port_dirs.insert(network->direction(port));
-    }
 
-    // determine real direction of port
-    PortDirection* overall_direction = nullptr;
-    if (port_dirs.size() == 1) {  // only one direction is used.
-      overall_direction = *port_dirs.begin();
-    } else {
-      overall_direction = PortDirection::bidirect();
-    }
+  auto [iter, inserted] = signals.try_emplace(base);
+  VerilogSignal& signal = iter->second;
+  if (inserted) {
+    signal.dir = dir;
+    signal.is_bus = is_bus;
+    signal.min_idx = idx;
+    signal.max_idx = idx;
+    return;
+  }
 
-    // set port direction to match
-    for (Port* port : ports) {
-      network->setDirection(port, overall_direction);
-    }
+  // bits driven in different directions make the whole bus bidirectional
+  if (dir != nullptr && signal.dir != dir) {
+    signal.dir = (signal.dir == nullptr) ? dir : PortDirection::bidirect();
+  }
+  if (is_bus && signal.is_bus) {
+    signal.min_idx = std::min(signal.min_idx, idx);
+    signal.max_idx = std::max(signal.max_idx, idx);
+  }
+}
 
-    // fill in missing ports in bus
-    const auto [min_idx, max_idx]
-        = std::minmax_element(port_idx.begin(), port_idx.end());
-    for (int idx = *min_idx; idx <= *max_idx; idx++) {
-      if (port_idx.find(idx) == port_idx.end()) {
-        // build missing port
-        std::string portname = bus;
-        portname += left_bracket + std::to_string(idx) + right_bracket;
-        Port* port = network->makePort(cell, portname.c_str());
-        network->setDirection(port, overall_direction);
-      }
+// reference to a (bit of a) signal inside a module.
+static std::string verilogReference(const std::string& name,
+                                    char left,
+                                    char right,
+                                    char escape)
+{
+  if (isBusName(name.c_str(), left, right, escape)) {
+    std::string base;
+    bool is_bus = false;
+    int idx = 0;
+    parseBusName(name.c_str(), left, right, escape, is_bus, base, idx);
+    if (is_bus) {
+      return verilogName(base) + "[" + std::to_string(idx) + "]";
     }
   }
+  return verilogName(name);
+}
 
-  network->groupBusPorts(cell, [](const char*) { return true; });
-
-  // build instance
-  std::string instname = name;
-  instname += "_inst";
-  Instance* inst = network->makeInstance(cell, instname.c_str(), parent);
+// reference to a whole signal, i.e. the full range of a bus.
+static std::string verilogReference(const std::string& name,
+                                    const VerilogSignal& signal)
+{
+  if (!signal.is_bus) {
+    return verilogName(name);
+  }
+  return verilogName(name) + "[" + std::to_string(signal.max_idx) + ":"
+         + std::to_string(signal.min_idx) + "]";
+}
 
-  // create nets for ports in cell
-  for (auto& [db_net, port] : *port_map) {
-    Net* net = network->makeNet(network->name(port), inst);
-    Pin* pin = network->makePin(inst, port, nullptr);
-    network->makeTerm(pin, net);
+static void writeVerilogModuleHeader(std::ofstream& out,
+                                     const std::string& module_name,
+                                     const VerilogSignals& ports)
+{
+  out << "module " << verilogName(module_name) << " (";
+  const char* separator = "";
+  for (const auto& [name, signal] : ports) {
+    out << separator << verilogName(name);
+    separator = ",\n    ";
   }
+  out << ");\n";
+}
 
-  // create and connect instances
-  for (Instance* instance : *insts) {
-    Instance* leaf_inst = network->makeInstance(
-        db_network_->cell(instance), db_network_->name(instance), inst);
-
-    InstancePinIterator* pin_iter = db_network_->pinIterator(instance);
-    while (pin_iter->hasNext()) {
-      Pin* pin = pin_iter->next();
-      Net* net = db_network_->net(pin);
-      if (net != nullptr) {  // connected
-        Port* port = db_network_->port(pin);
-
-        // check if connected to a port
-        auto port_find = port_map->find(net);
-        if (port_find != port_map->end()) {
-          Net* new_net
-              = network->findNet(inst, network->name(port_find->second));
-          network->connect(leaf_inst, port, new_net);
-        } else {
-          Net* new_net = network->findNet(inst, db_network_->name(net));
-          if (new_net == nullptr) {
-            new_net = network->makeNet(db_network_->name(net), inst);
-          }
-          network->connect(leaf_inst, port, new_net);
-        }
+static void writeVerilogDeclarations(std::ofstream& out,
+                                     const VerilogSignals& signals)
+{
+  for (const auto& [name, signal] : signals) {
+    const char* keyword = "wire";
+    if (signal.dir != nullptr) {
+      if (signal.dir->isInput()) {
+        keyword = "input";
+      } else if (signal.dir->isOutput()) {
+        keyword = "output";
+      } else {
+        keyword = "inout";
       }
     }
-    delete pin_iter;
+    out << " " << keyword << " ";
+    if (signal.is_bus) {
+      out << "[" << signal.max_idx << ":" << signal.min_idx << "] ";
+    }
+    out << verilogName(name) << ";\n";
   }
-
-  return inst;
 }
 
-// Builds an instance/cell instantiating the partitions
-Instance* PartitionMgr::buildPartitionedTopInstance(const char* name,
-                                                    sta::Library* library,
-                                                    sta::NetworkReader* network)
+static PortDirection* bTermDirection(dbBTerm* bterm)
 {
-  // build cell
-  Cell* cell = network->makeCell(library, name, false, nullptr);
-
-  // add global ports
-  auto pin_iter = db_network_->pinIterator(db_network_->topInstance());
-  while (pin_iter->hasNext()) {
-    const Pin* pin = pin_iter->next();
-
-    const char* portname = db_network_->name(pin);
-    Port* port = network->makePort(cell, portname);
-    network->setDirection(port, db_network_->direction(pin));
+  switch (bterm->getIoType().getValue()) {
+    case dbIoType::INPUT:
+      return PortDirection::input();
+    case dbIoType::OUTPUT:
+      return PortDirection::output();
+    default:
+      return PortDirection::bidirect();
   }
-  delete pin_iter;
-
-  network->groupBusPorts(cell, [](const char*) { return true; });
-
-  // build instance
-  std::string instname = name;
-  instname += "_inst";
-  Instance* inst = network->makeInstance(cell, instname.c_str(), nullptr);
-
-  CellPortBitIterator* port_iter = network->portBitIterator(cell);
-  while (port_iter->hasNext()) {
-    Port* port = port_iter->next();
-    const char* port_name = network->name(port);
-    Net* net = network->makeNet(port_name, inst);
-    Pin* pin = network->makePin(inst, port, nullptr);
-    network->makeTerm(pin, net);
-  }
-  delete port_iter;
+}
 
-  return inst;
+// The cached timing paths are dropped if they are not reused, because
+// the constraints may be changed before they are requested again
+TimingPathsCache* PartitionMgr::getTimingPathsCache()
+{
+  if (reuse_timing_paths_ == false) {
+    timing_paths_cache_->Invalidate();
+    return nullptr;
+  }
+  return timing_paths_cache_.get();
 }
 
 odb::dbBlock* PartitionMgr::getDbBlock() const
@@ -750,6 +839,9 @@ odb::dbBlock* PartitionMgr::getDbBlock() const
   return block;
 }
 
+// Writes the partitioned netlist straight from odb. A single pass over the
+// nets determines the boundary ports of every partition, then each
+// submodule and the new top module are streamed to the output file.
 void PartitionMgr::writePartitionVerilog(const char* file_name,
                                          const char* port_prefix,
                                          const char* module_suffix)
@@ -761,10 +853,12 @@ void PartitionMgr::writePartitionVerilog(const char* file_name,
 
   logger_->report("Writing partition to verilog.");
   // get top module name
-  const std::string top_name = db_network_->name(db_network_->topInstance());
+  const std::string top_name = block->getName();
 
-  // build partition instance map
-  std::map<int, std::set<Instance*>> instance_map;
+  // partition id of every instance (indexed by odb id), and the
+  // instances of every partition
+  std::vector<int> inst_partition;
+  std::map<int, std::vector<dbInst*>> partition_insts;
   for (dbInst* inst : block->getInsts()) {
     dbIntProperty* prop_id = dbIntProperty::find(inst, "partition_id");
     if (!prop_id) {
@@ -772,55 +866,182 @@ void PartitionMgr::writePartitionVerilog(const char* file_name,
                     15,
                     "Property 'partition_id' not found for inst {}.",
                     inst->getName());
-    } else {
-      const int partition = prop_id->getValue();
-      instance_map[partition].insert(db_network_->dbToSta(inst));
+      continue;
     }
+    const int partition = prop_id->getValue();
+    const uint id = inst->getId();
+    if (id >= inst_partition.size()) {
+      inst_partition.resize(id + 1, -1);
+    }
+    inst_partition[id] = partition;
+    partition_insts[partition].push_back(inst);
   }
 
-  // create new network and library
-  NetworkReader* network = sta::makeConcreteNetwork();
-  Library* library = network->makeLibrary("Partitions", nullptr);
+  char left_bracket;
+  char right_bracket;
+  determineLibraryBrackets(db_network_, &left_bracket, &right_bracket);
+  const char path_escape = db_network_->pathEscape();
+
+  // Walk every net once. A net touching a single partition is a local wire
+  // of that partition; otherwise it becomes a port of every partition it
+  // touches, named after the top-level port if it has one.
+  std::map<int, VerilogSignals> partition_ports;
+  std::map<int, VerilogSignals> partition_wires;
+  VerilogSignals top_wires;
+  std::vector<std::string> net_names;  // indexed by odb id
+  std::map<int, bool> net_partitions;  // partition -> drives the net
+  for (dbNet* net : block->getNets()) {
+    if (net->getSigType().isSupply()) {
+      continue;
+    }
 
-  // new top module
-  Instance* top_inst
-      = buildPartitionedTopInstance(top_name.c_str(), library, network);
+    net_partitions.clear();
+    for (dbITerm* iterm : net->getITerms()) {
+      const uint inst_id = iterm->getInst()->getId();
+      if (inst_id >= inst_partition.size() || inst_partition[inst_id] < 0) {
+        continue;
+      }
+      const dbIoType io_type = iterm->getIoType();
+      const bool drives
+          = (io_type == dbIoType::OUTPUT || io_type == dbIoType::INOUT);
+      net_partitions[inst_partition[inst_id]] |= drives;
+    }
+    if (net_partitions.empty()) {
+      continue;
+    }
 
-  // build submodule partitions
-  std::map<int, Instance*> sta_instance_map;
-  std::map<int, std::map<Net*, Port*>> sta_port_map;
-  for (auto& [partition, instances] : instance_map) {
-    const std::string cell_name
-        = top_name + module_suffix + std::to_string(partition);
-    sta_instance_map[partition]
-        = buildPartitionedInstance(cell_name.c_str(),
-                                   port_prefix,
-                                   library,
-                                   network,
-                                   top_inst,
-                                   &instances,
-                                   &sta_port_map[partition]);
-  }
+    dbBTerm* top_bterm = nullptr;
+    bool top_driven = false;
+    for (dbBTerm* bterm : net->getBTerms()) {
+      if (top_bterm == nullptr) {
+        top_bterm = bterm;
+      }
+      const dbIoType io_type = bterm->getIoType();
+      if (io_type == dbIoType::INPUT || io_type == dbIoType::INOUT) {
+        top_driven = true;
+      }
+    }
 
-  // connect submodule partitions in new top module
-  for (auto& [partition, instance] : sta_instance_map) {
-    for (auto& [portnet, port] : sta_port_map[partition]) {
-      const char* net_name = network->name(port);
+    std::string net_name;
+    if (top_bterm == nullptr && net_partitions.size() == 1) {
+      net_name = net->getName();
+      addVerilogSignal(partition_wires[net_partitions.begin()->first],
+                       net_name,
+                       nullptr,
+                       left_bracket,
+                       right_bracket,
+                       path_escape);
+    } else {
+      if (top_bterm != nullptr) {
+        net_name = top_bterm->getName();
+      } else {
+        net_name = port_prefix + net->getName();
+        addVerilogSignal(top_wires,
+                         net_name,
+                         nullptr,
+                         left_bracket,
+                         right_bracket,
+                         path_escape);
+      }
 
-      Net* net = network->findNet(top_inst, net_name);
-      if (net == nullptr) {
-        net = network->makeNet(net_name, top_inst);
+      int num_drivers = 0;
+      for (const auto& [partition, drives] : net_partitions) {
+        num_drivers += drives ? 1 : 0;
       }
+      for (const auto& [partition, drives] : net_partitions) {
+        const bool externally_driven
+            = top_driven || num_drivers > (drives ? 1 : 0);
+        PortDirection* dir = PortDirection::output();
+        if (drives && externally_driven) {
+          dir = PortDirection::bidirect();
+        } else if (externally_driven) {
+          dir = PortDirection::input();
+        }
+        addVerilogSignal(partition_ports[partition],
+                         net_name,
+                         dir,
+                         left_bracket,
+                         right_bracket,
+                         path_escape);
+      }
+    }
 
-      network->connect(instance, port, net);
+    const uint net_id = net->getId();
+    if (net_id >= net_names.size()) {
+      net_names.resize(net_id + 1);
     }
+    net_names[net_id] = std::move(net_name);
   }
 
-  reinterpret_cast<ConcreteNetwork*>(network)->setTopInstance(top_inst);
+  std::ofstream out(file_name);
+  if (!out) {
+    logger_->error(PAR, 2533, "Unable to open file {}.", file_name);
+  }
 
-  writeVerilog(file_name, true, false, {}, network);
+  // submodule partitions
+  for (const auto& [partition, insts] : partition_insts) {
+    const std::string cell_name
+        = top_name + module_suffix + std::to_string(partition);
+    const VerilogSignals& ports = partition_ports[partition];
+    writeVerilogModuleHeader(out, cell_name, ports);
+    writeVerilogDeclarations(out, ports);
+    writeVerilogDeclarations(out, partition_wires[partition]);
+    out << "\n";
+    for (dbInst* inst : insts) {
+      out << " " << verilogName(inst->getMaster()->getName()) << " "
+          << verilogName(inst->getName()) << " (";
+      const char* separator = "";
+      for (dbITerm* iterm : inst->getITerms()) {
+        dbNet* net = iterm->getNet();
+        if (net == nullptr || net->getId() >= net_names.size()
+            || net_names[net->getId()].empty()) {
+          continue;
+        }
+        out << separator << "." << verilogName(iterm->getMTerm()->getName())
+            << "("
+            << verilogReference(net_names[net->getId()],
+                                left_bracket,
+                                right_bracket,
+                                path_escape)
+            << ")";
+        separator = ",\n    ";
+      }
+      out << ");\n";
+    }
+    out << "endmodule\n\n";
+  }
 
-  delete network;
+  // new top module instantiating the partitions
+  VerilogSignals top_ports;
+  for (dbBTerm* bterm : block->getBTerms()) {
+    if (bterm->getSigType().isSupply()) {
+      continue;
+    }
+    addVerilogSignal(top_ports,
+                     bterm->getName(),
+                     bTermDirection(bterm),
+                     left_bracket,
+                     right_bracket,
+                     path_escape);
+  }
+  writeVerilogModuleHeader(out, top_name, top_ports);
+  writeVerilogDeclarations(out, top_ports);
+  writeVerilogDeclarations(out, top_wires);
+  out << "\n";
+  for (const auto& [partition, insts] : partition_insts) {
+    const std::string cell_name
+        = top_name + module_suffix + std::to_string(partition);
+    out << " " << verilogName(cell_name) << " "
+        << verilogName(cell_name + "_inst") << " (";
+    const char* separator = "";
+    for (const auto& [name, signal] : partition_ports[partition]) {
+      out << separator << "." << verilogName(name) << "("
+          << verilogReference(name, signal) << ")";
+      separator = ",\n    ";
+    }
+    out << ");\n";
+  }
+  out << "endmodule\n";
 }
 
 // Read partitioning input file
@@ -837,16 +1058,19 @@ void PartitionMgr::readPartitioningFile(const std::string& filename,
     if (!map_file) {
       logger_->error(PAR, 72, "Unable to open file {}.", instance_map_file);
     }
+    std::vector<std::string> names;
     std::string line;
     while (getline(map_file, line)) {
       if (line.empty()) {
         continue;
       }
-      auto inst = block->findInst(line.c_str());
-      if (!inst) {
-        logger_->error(PAR, 73, "Unable to find instance {}.", line);
+      names.push_back(line);
+    }
+    instance_order = block->findInsts(names);
+    for (size_t i = 0; i < names.size(); i++) {
+      if (!instance_order[i]) {
+        logger_->error(PAR, 73, "Unable to find instance {}.", names[i]);
       }
-      instance_order.push_back(inst);
     }
   } else {
     auto insts = block->getInsts();
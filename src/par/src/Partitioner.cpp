@@ -35,6 +35,7 @@
 
 #include "Partitioner.h"
 
+#include <algorithm>
 #include <random>
 
 #include "Evaluator.h"
@@ -207,6 +208,14 @@ void Partitioner::ILPPart(const HGraphPtr& hgraph,
                           const Matrix<float>& lower_block_balance,
                           std::vector<int>& solution) const
 {
+  // keep the hint (if any) when the time is up
+  if (IsTimeUp(deadline_)
+      && std::all_of(solution.begin(), solution.end(), [](int block_id) {
+           return block_id >= 0;
+         })) {
+    deadline_->AddShortenedPhase("ilp");
+    return;
+  }
   logger_->report("[STATUS] Optimal ILP-based Partitioning Starts !");
   std::map<int, int> fixed_vertices_map;
   Matrix<float> vertex_weights;  // two-dimensional
@@ -215,7 +224,7 @@ void Partitioner::ILPPart(const HGraphPtr& hgraph,
   std::vector<float> hyperedge_weights;  // one-dimensional
   // set vertices
   for (int v = 0; v < hgraph->GetNumVertices(); v++) {
-    vertex_weights.push_back(hgraph->GetVertexWeights(v));
+    vertex_weights.push_back(ToVector(hgraph->GetVertexWeights(v)));
   }
   // check fixed vertices
   if (hgraph->HasFixedVertices()) {
@@ -296,7 +305,12 @@ void Partitioner::ILPPart(const HGraphPtr& hgraph,
                        hyperedge_weights,
                        vertex_weights,
                        upper_block_balance,
-                       lower_block_balance)
+                       lower_block_balance,
+                       deadline_ != nullptr
+                           ? deadline_->CapTimeLimit(ilp_time_limit_)
+                           : ilp_time_limit_,
+                       ilp_num_threads_,
+                       ilp_solver_)
       == true) {
     logger_->report("[STATUS] Optimal ILP-based Partitioning Finished !");
   } else {
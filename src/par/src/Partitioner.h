@@ -43,6 +43,7 @@
 // then put remaining vertices into the first block 3) ILP-based Partitioning
 // (INIT_DIRECT_ILP)
 
+#include "Deadline.h"
 #include "Evaluator.h"
 #include "Hypergraph.h"
 #include "Utilities.h"
@@ -84,6 +85,21 @@ class Partitioner
 
   void DisableIlpAcceleration();
 
+  // The wall-clock budget (in seconds, 0 means no limit), the number of
+  // threads and the solver of the ILP
+  void SetIlpParams(float ilp_time_limit,
+                    int ilp_num_threads,
+                    IlpSolver ilp_solver)
+  {
+    ilp_time_limit_ = ilp_time_limit;
+    ilp_num_threads_ = ilp_num_threads;
+    ilp_solver_ = ilp_solver;
+  }
+
+  // The time limit of the ILP solver is capped by the remaining time, and
+  // the hint solution is kept if the deadline is expired
+  void SetDeadline(DeadlinePtr deadline) { deadline_ = std::move(deadline); }
+
  private:
   // random partitioning
   // Different to other random partitioning,
@@ -110,7 +126,11 @@ class Partitioner
       = 1.0;  // In the default mode, we do not use ilp acceleration
               // If the ilp acceleration is enabled, we only use
               // top ilp_accelerator_factor hyperedges. Range: 0, 1
+  float ilp_time_limit_ = 0.0;  // seconds, 0 means no limit
+  int ilp_num_threads_ = 1;
+  IlpSolver ilp_solver_ = IlpSolver::AUTO;
   int seed_ = 0;
+  DeadlinePtr deadline_ = nullptr;
   EvaluatorPtr evaluator_ = nullptr;  // evaluator
   utl::Logger* logger_ = nullptr;
 };
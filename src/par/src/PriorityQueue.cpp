@@ -39,78 +39,93 @@
 
 namespace par {
 
+GainContainer::GainContainer(const int maximum_traverse_level,
+                             HGraphPtr hypergraph)
+    : hypergraph_(std::move(hypergraph)),
+      maximum_traverse_level_(maximum_traverse_level)
+{
+}
+
 PriorityQueue::PriorityQueue(const int total_elements,
                              const int maximum_traverse_level,
                              HGraphPtr hypergraph)
-    : maximum_traverse_level_(maximum_traverse_level)
+    : GainContainer(maximum_traverse_level, std::move(hypergraph))
 {
   vertices_map_.resize(total_elements);
   std::fill(vertices_map_.begin(), vertices_map_.end(), -1);
-  total_elements_ = 0;
-  hypergraph_ = std::move(hypergraph);
-  active_ = false;
 }
 
 void PriorityQueue::Clear()
 {
   active_ = false;
+  for (const auto& element : vertices_) {
+    vertices_map_[element.GetVertex()] = -1;
+  }
   vertices_.clear();
   total_elements_ = 0;
-  std::fill(vertices_map_.begin(), vertices_map_.end(), -1);
+}
+
+void PriorityQueue::Reset(HGraphPtr hypergraph)
+{
+  if (hypergraph == hypergraph_) {
+    Clear();
+    return;
+  }
+  hypergraph_ = std::move(hypergraph);
+  active_ = false;
+  vertices_.clear();
+  total_elements_ = 0;
+  vertices_map_.assign(hypergraph_->GetNumVertices(), -1);
 }
 
 // insert one element into the priority queue
-void PriorityQueue::InsertIntoPQ(const std::shared_ptr<VertexGain>& element)
+void PriorityQueue::InsertIntoPQ(const VertexGain& element)
 {
+  num_operations_++;
   total_elements_++;
   vertices_.push_back(element);
-  vertices_map_[element->GetVertex()] = total_elements_ - 1;
+  vertices_map_[element.GetVertex()] = total_elements_ - 1;
   HeapifyUp(total_elements_ - 1);
 }
 
 // get the largest element
-std::shared_ptr<VertexGain> PriorityQueue::ExtractMax()
+VertexGain PriorityQueue::ExtractMax()
 {
-  auto max_element = vertices_.front();
+  num_operations_++;
+  return PopMax();
+}
+
+// ExtractMax without counting the operation
+VertexGain PriorityQueue::PopMax()
+{
+  VertexGain max_element = std::move(vertices_.front());
   // replace the first element with the last element, then
   // call HeapifyDown to update the order of elements
-  vertices_[0] = vertices_[total_elements_ - 1];
-  vertices_map_[vertices_[total_elements_ - 1]->GetVertex()] = 0;
+  vertices_map_[vertices_[total_elements_ - 1].GetVertex()] = 0;
+  if (total_elements_ > 1) {
+    vertices_[0] = std::move(vertices_[total_elements_ - 1]);
+  }
   total_elements_--;
   vertices_.pop_back();
   HeapifyDown(0);
   // Set location of this vertex to -1 in the map
-  vertices_map_[max_element->GetVertex()] = -1;
+  vertices_map_[max_element.GetVertex()] = -1;
   return max_element;
 }
 
 // find the vertex gain which can satisfy the balance constraint
-std::shared_ptr<VertexGain> PriorityQueue::GetBestCandidate(
-    const Matrix<float>& curr_block_balance,
-    const Matrix<float>& upper_block_balance,
-    const Matrix<float>& lower_block_balance,
-    const HGraphPtr& hgraph)
+VertexGain PriorityQueue::GetBestCandidate(const MoveLegality& is_legal_move)
 {
   if (total_elements_ <= 0) {               // empty
-    return std::make_shared<VertexGain>();  // return the dummy cell
+    return VertexGain();  // return the dummy cell
   }
   int pass = 0;
   int candidate_index = -1;  // the index of the candidate vertex gain
   int index = 0;             // starting from the first index
 
   // define the lambda function to check the balance constraint
-  auto CheckBalance = [&](int index) {
-    const int vertex_id = vertices_[index]->GetVertex();
-    const int to_pid = vertices_[index]->GetDestinationPart();
-    const int from_pid = vertices_[index]->GetSourcePart();
-    if ((curr_block_balance[to_pid] + hgraph->GetVertexWeights(vertex_id)
-         < upper_block_balance[to_pid])
-        && (curr_block_balance[from_pid] - hgraph->GetVertexWeights(vertex_id)
-            > lower_block_balance[from_pid])) {
-      return true;
-    }
-    return false;
-  };
+  auto CheckBalance
+      = [&](int index) { return is_legal_move(vertices_[index]); };
 
   // check the first index
   if (CheckBalance(index) == true) {
@@ -139,45 +154,46 @@ std::shared_ptr<VertexGain> PriorityQueue::GetBestCandidate(
     }
     if (left_child >= total_elements_ || right_child >= total_elements_) {
       // no valid candidate
-      return std::make_shared<VertexGain>();  // return the dummy cell
+      return VertexGain();  // return the dummy cell
     }
     index = CompareElementLargeThan(right_child, left_child) == true
                 ? right_child
                 : left_child;
   }
-  return std::make_shared<VertexGain>();  // return the dummy cell
+  return VertexGain();  // return the dummy cell
 }
 
 // Remove the specifid vertex
 void PriorityQueue::Remove(int vertex_id)
 {
+  num_operations_++;
   const int index = vertices_map_[vertex_id];
   if (index == -1) {
     return;  // This vertex does not exists
   }
-  // set the gain of this element to maximum + 1
-  vertices_[index]->SetGain(GetMax()->GetGain() + 1.0);
+  // set the gain of this element larger than all the others
+  vertices_[index].SetGain(GainValue::Highest());
   // Shift the element to top of the heap
   HeapifyUp(index);
   // Extract the element from the heap
-  ExtractMax();
+  PopMax();
   if (total_elements_ <= 0) {
     active_ = false;
   }
 }
 
 // Update the priority (gain) for the specified vertex
-void PriorityQueue::ChangePriority(
-    int vertex_id,
-    const std::shared_ptr<VertexGain>& new_element)
+void PriorityQueue::ChangePriority(int vertex_id,
+                                   const VertexGain& new_element)
 {
+  num_operations_++;
   const int index = vertices_map_[vertex_id];
   if (index == -1) {
     return;  // This vertex does not exists
   }
-  const float old_priority = vertices_[index]->GetGain();
+  const GainValue old_priority = vertices_[index].GetGainValue();
   vertices_[index] = new_element;
-  if (new_element->GetGain() > old_priority) {
+  if (new_element.GetGainValue() > old_priority) {
     HeapifyUp(index);
   } else {
     HeapifyDown(index);
@@ -193,13 +209,15 @@ void PriorityQueue::ChangePriority(
 // The hope is doing this will incentivize in preventing corking effect
 bool PriorityQueue::CompareElementLargeThan(int index_a, int index_b)
 {
-  if (vertices_[index_a]->GetGain() > vertices_[index_b]->GetGain()) {
+  const GainValue& gain_a = vertices_[index_a].GetGainValue();
+  const GainValue& gain_b = vertices_[index_b].GetGainValue();
+  if (gain_a > gain_b) {
     return true;
   }
   return (
-      (vertices_[index_a]->GetGain() == vertices_[index_b]->GetGain())
-      && (hypergraph_->GetVertexWeights(vertices_[index_a]->GetVertex())
-          < hypergraph_->GetVertexWeights(vertices_[index_b]->GetVertex())));
+      (gain_a == gain_b)
+      && (hypergraph_->GetVertexWeights(vertices_[index_a].GetVertex())
+          < hypergraph_->GetVertexWeights(vertices_[index_b].GetVertex())));
 }
 
 // push the element at location index to its ordered location
@@ -210,8 +228,8 @@ void PriorityQueue::HeapifyUp(int index)
     // Update the map (exchange parent and child)
     auto& parent_heap_element = vertices_[Parent(index)];
     auto& child_heap_element = vertices_[index];
-    vertices_map_[child_heap_element->GetVertex()] = Parent(index);
-    vertices_map_[parent_heap_element->GetVertex()] = index;
+    vertices_map_[child_heap_element.GetVertex()] = Parent(index);
+    vertices_map_[parent_heap_element.GetVertex()] = index;
     // Swap the elements
     std::swap(parent_heap_element, child_heap_element);
     // Next iteration
@@ -247,12 +265,27 @@ void PriorityQueue::HeapifyDown(int index)
   auto& cur_heap_element = vertices_[index];
   auto& large_heap_element = vertices_[max_index];
   // Update the map
-  vertices_map_[cur_heap_element->GetVertex()] = max_index;
-  vertices_map_[large_heap_element->GetVertex()] = index;
+  vertices_map_[cur_heap_element.GetVertex()] = max_index;
+  vertices_map_[large_heap_element.GetVertex()] = index;
   // Swap the elements
   std::swap(cur_heap_element, large_heap_element);
   // Next recursive iteration
   HeapifyDown(max_index);
 }
 
+// Utility functions
+std::string ToString(const GainBucketType type)
+{
+  switch (type) {
+    case GainBucketType::PRIORITY_QUEUE:
+      return std::string("PRIORITY_QUEUE");
+
+    case GainBucketType::BUCKET_LIST:
+      return std::string("BUCKET_LIST");
+
+    default:
+      return std::string("PRIORITY_QUEUE");
+  }
+}
+
 }  // namespace par
@@ -34,14 +34,99 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <boost/container/small_vector.hpp>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <set>
+#include <string>
+#include <utility>
 
 #include "Hypergraph.h"
 
 namespace par {
 
+// The delta path cost of moving a vertex or a hyperedge
+// (path_id, delta cost).  Only a few timing paths go through a vertex,
+// so the entries are usually stored inline without heap allocation
+using PathCost = boost::container::small_vector<std::pair<int, float>, 2>;
+
+// The gain of a move or of a sequence of moves.
+// In the fixed-point mode (see GoldenEvaluator::SetFixedPointBits), the
+// refiners calculate the gains from the integer costs in units of
+// 2^-fixed_point_bits.  Such gains are added and compared as integers, so
+// they do not depend on the rounding of float sums, and the float value is
+// only reported.  Otherwise the float values are compared.
+class GainValue
+{
+ public:
+  GainValue() = default;
+
+  // a float gain
+  GainValue(float value) : value_(value) {}
+
+  // a fixed-point gain, fixed * 2^-fixed_point_bits = value
+  GainValue(float value, int64_t fixed)
+      : value_(value), fixed_(fixed), fixed_point_flag_(true)
+  {
+  }
+
+  // larger or smaller than all the other gains, in both modes
+  static GainValue Highest()
+  {
+    return GainValue(std::numeric_limits<float>::max(),
+                     std::numeric_limits<int64_t>::max(),
+                     false);
+  }
+  static GainValue Lowest()
+  {
+    return GainValue(-std::numeric_limits<float>::max(),
+                     std::numeric_limits<int64_t>::min(),
+                     false);
+  }
+
+  float GetValue() const { return value_; }
+  int64_t GetFixed() const { return fixed_; }
+  bool IsFixedPoint() const { return fixed_point_flag_; }
+
+  GainValue& operator+=(const GainValue& gain)
+  {
+    value_ += gain.value_;
+    fixed_ += gain.fixed_;
+    fixed_point_flag_ = fixed_point_flag_ || gain.fixed_point_flag_;
+    return *this;
+  }
+
+  bool operator<(const GainValue& gain) const
+  {
+    if (fixed_point_flag_ || gain.fixed_point_flag_) {
+      return fixed_ < gain.fixed_;
+    }
+    return value_ < gain.value_;
+  }
+  bool operator>(const GainValue& gain) const { return gain < *this; }
+  bool operator<=(const GainValue& gain) const { return !(gain < *this); }
+  bool operator>=(const GainValue& gain) const { return !(*this < gain); }
+  bool operator==(const GainValue& gain) const
+  {
+    return !(*this < gain) && !(gain < *this);
+  }
+  bool operator!=(const GainValue& gain) const { return !(*this == gain); }
+
+ private:
+  GainValue(float value, int64_t fixed, bool fixed_point_flag)
+      : value_(value), fixed_(fixed), fixed_point_flag_(fixed_point_flag)
+  {
+  }
+
+  float value_ = 0.0;
+  int64_t fixed_ = 0;  // the gain in units of 2^-fixed_point_bits
+  bool fixed_point_flag_ = false;
+};
+
 // Vertex Gain is the basic elements of FM
-// We do not use the classical gain-bucket data structure
+// The gain buckets store the vertex gains by value, so computing and
+// updating a gain does not allocate any memory.
 // We design our own priority-queue based gain-bucket data structure
 // to support float gain
 class VertexGain
@@ -53,18 +138,19 @@ class VertexGain
   VertexGain(int vertex,
              int src_block_id,
              int destination_block_id,
-             float gain,
-             const std::map<int, float>& path_cost);
+             GainValue gain,
+             PathCost path_cost);
 
   // accessor functions
   int GetVertex() const { return vertex_; }
   void SetVertex(int vertex) { vertex_ = vertex; }
 
-  float GetGain() const { return gain_; }
-  void SetGain(float gain) { gain_ = gain; }
+  float GetGain() const { return gain_.GetValue(); }
+  const GainValue& GetGainValue() const { return gain_; }
+  void SetGain(const GainValue& gain) { gain_ = gain; }
 
   // get the delta path cost
-  const std::map<int, float>& GetPathCost() const { return path_cost_; }
+  const PathCost& GetPathCost() const { return path_cost_; }
 
   int GetSourcePart() const { return source_part_; }
   int GetDestinationPart() const { return destination_part_; }
@@ -73,13 +159,89 @@ class VertexGain
   int vertex_ = -1;            // vertex id
   int source_part_ = -1;       // the source block id
   int destination_part_ = -1;  // the destination block id
-  float gain_
-      = -std::numeric_limits<float>::max();  // gain value of moving this vertex
-  std::map<int, float>
-      path_cost_;  // the updated DELTA path cost after moving vertex
-                   // the path_cost will change because we will dynamically
-                   // update the the weight of the path based on the number of
-                   // the cut on the path
+  GainValue gain_ = GainValue::Lowest();  // gain value of moving this vertex
+  PathCost path_cost_;  // the updated DELTA path cost after moving vertex
+                        // the path_cost will change because we will
+                        // dynamically update the the weight of the path based
+                        // on the number of the cut on the path
+};
+
+// The data structures we support for the gain buckets
+enum class GainBucketType
+{
+  PRIORITY_QUEUE,  // max heap, exact float gain, O(log n) update
+  BUCKET_LIST      // bucket list with quantized gain, O(1) update
+};
+
+// function : convert GainBucketType to string
+std::string ToString(GainBucketType type);
+
+// Return true if the move of the vertex gain satisfies the balance
+// constraint (see Refiner::CheckVertexMoveLegality)
+using MoveLegality = std::function<bool(const VertexGain&)>;
+
+// ------------------------------------------------------------
+// The interface of the gain bucket (Only for VertexGain)
+// The FM refiners only access the gain buckets through this
+// interface, so the data structure can be selected by the user
+// -------------------------------------------------------------
+class GainContainer
+{
+ public:
+  GainContainer(int maximum_traverse_level, HGraphPtr hypergraph);
+  virtual ~GainContainer() = default;
+
+  // Clear the gain bucket and prepare it for the hypergraph.
+  // The memory is kept, so the gain bucket can be reused across passes
+  // and levels without reallocation
+  virtual void Reset(HGraphPtr hypergraph) = 0;
+
+  // insert one element (VertexGain) into the gain bucket
+  virtual void InsertIntoPQ(const VertexGain& element) = 0;
+
+  // extract the largest element, i.e.,
+  // get the largest element and remove it from the gain bucket
+  virtual VertexGain ExtractMax() = 0;
+
+  // get the largest element without removing it from the gain bucket
+  virtual const VertexGain& GetMax() = 0;
+
+  // find the vertex gain which can satisfy the balance constraint
+  virtual VertexGain GetBestCandidate(const MoveLegality& is_legal_move) = 0;
+
+  // update the priority (gain) for the specified vertex
+  virtual void ChangePriority(int vertex_id, const VertexGain& new_element)
+      = 0;
+
+  // Remove the specified vertex
+  virtual void Remove(int vertex_id) = 0;
+
+  // Basic accessors
+  bool CheckIfEmpty() const { return total_elements_ == 0; }
+  int GetTotalElements() const { return total_elements_; }
+  // the maximum number of elements
+  virtual int GetSizeOfMap() const = 0;
+  // check if the vertex exists
+  virtual bool CheckIfVertexExists(int v) const = 0;
+  // check the status of the gain bucket
+  void SetActive() { active_ = true; }
+  void SetDeactive() { active_ = false; }
+  bool GetStatus() const { return active_; }
+  // clear the gain bucket
+  virtual void Clear() = 0;
+
+  // the number of insert, extract, update and remove operations
+  // since the last call of ResetNumOperations (for profiling)
+  int64_t GetNumOperations() const { return num_operations_; }
+  void ResetNumOperations() { num_operations_ = 0; }
+
+ protected:
+  bool active_ = false;
+  HGraphPtr hypergraph_;
+  int total_elements_ = 0;           // number of elements in the gain bucket
+  int maximum_traverse_level_ = 25;  // the maximum level of traversing the
+                                     // buckets to solve the "corking effect"
+  int64_t num_operations_ = 0;       // number of operations for profiling
 };
 
 // ------------------------------------------------------------
@@ -88,7 +250,7 @@ class VertexGain
 // We did not use the STL priority queue becuase we need
 // to record the location of each element (vertex gain)
 // -------------------------------------------------------------
-class PriorityQueue
+class PriorityQueue : public GainContainer
 {
  public:
   // constructors
@@ -96,43 +258,35 @@ class PriorityQueue
                 int maximum_traverse_level,
                 HGraphPtr hypergraph);
 
-  // insert one element (std::shared_ptr<VertexGain>) into the priority queue
-  void InsertIntoPQ(const std::shared_ptr<VertexGain>& element);
+  // insert one element (VertexGain) into the priority queue
+  void InsertIntoPQ(const VertexGain& element) override;
 
   // extract the largest element, i.e.,
   // get the largest element and remove it from the heap
-  std::shared_ptr<VertexGain> ExtractMax();
+  VertexGain ExtractMax() override;
 
   // get the largest element without removing it from the heap
-  std::shared_ptr<VertexGain> GetMax() { return vertices_.front(); }
+  const VertexGain& GetMax() override { return vertices_.front(); }
 
   // find the vertex gain which can satisfy the balance constraint
-  std::shared_ptr<VertexGain> GetBestCandidate(
-      const Matrix<float>& curr_block_balance,
-      const Matrix<float>& upper_block_balance,
-      const Matrix<float>& lower_block_balance,
-      const HGraphPtr& hgraph);
+  VertexGain GetBestCandidate(const MoveLegality& is_legal_move) override;
 
   // update the priority (gain) for the specified vertex
-  void ChangePriority(int vertex_id,
-                      const std::shared_ptr<VertexGain>& new_element);
+  void ChangePriority(int vertex_id, const VertexGain& new_element) override;
 
   // Remove the specified vertex
-  void Remove(int vertex_id);
+  void Remove(int vertex_id) override;
 
-  // Basic accessors
-  bool CheckIfEmpty() const { return vertices_.empty(); }
-  int GetTotalElements() const { return total_elements_; }
   // the size of the max heap
-  int GetSizeOfMap() const { return vertices_map_.size(); }
+  int GetSizeOfMap() const override { return vertices_map_.size(); }
   // check if the vertex exists
-  bool CheckIfVertexExists(int v) const { return vertices_map_[v] > -1; }
-  // check the status of the heap
-  void SetActive() { active_ = true; }
-  void SetDeactive() { active_ = false; }
-  bool GetStatus() const { return active_; }
+  bool CheckIfVertexExists(int v) const override
+  {
+    return vertices_map_[v] > -1;
+  }
   // clear the heap
-  void Clear();
+  void Clear() override;
+  void Reset(HGraphPtr hypergraph) override;
 
  private:
   // The max heap (priority queue) is organized as a binary tree
@@ -150,21 +304,19 @@ class PriorityQueue
   // This is called when we remove an existing element
   void HeapifyDown(int index);
 
+  // ExtractMax without counting the operation
+  VertexGain PopMax();
+
   // Compare the two elements
   // If the gains are equal then pick the vertex with the smaller weight
   // The hope is doing this will incentivize in preventing corking effect
   bool CompareElementLargeThan(int index_a, int index_b);
 
   // private variables
-  bool active_;
-  HGraphPtr hypergraph_;
-  std::vector<std::shared_ptr<VertexGain>> vertices_;  // elements
+  std::vector<VertexGain> vertices_;  // elements
   std::vector<int> vertices_map_;  // store the location of vertex_gain for each
                                    // vertex vertices_map_ always has the size
                                    // of hypergraph_->num_vertices_
-  int total_elements_;             // number of elements in the priority queue
-  int maximum_traverse_level_ = 25;  // the maximum level of traversing the
-                                     // buckets to solve the "corking effect"
 };
 
 }  // namespace par
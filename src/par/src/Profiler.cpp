@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "Profiler.h"
+
+#include <algorithm>
+
+#include "utl/Logger.h"
+
+namespace par {
+
+std::string ToString(const ProfilePhase phase)
+{
+  switch (phase) {
+    case ProfilePhase::COARSENING:
+      return std::string("coarsening");
+    case ProfilePhase::INITIAL_PARTITIONING:
+      return std::string("initial_partitioning");
+    case ProfilePhase::REFINEMENT:
+      return std::string("refinement");
+    case ProfilePhase::CUT_OVERLAY_ILP:
+      return std::string("cut_overlay_ilp");
+    case ProfilePhase::VCYCLE:
+      return std::string("vcycle");
+    case ProfilePhase::NUM_PHASES:
+      break;
+  }
+  return std::string("unknown");
+}
+
+void Profiler::AddPhaseTime(const ProfilePhase phase, const double seconds)
+{
+  PhaseCounter& counter = phases_[static_cast<int>(phase)];
+  counter.num_calls.fetch_add(1, std::memory_order_relaxed);
+  counter.time_ns.fetch_add(ToNanoseconds(seconds), std::memory_order_relaxed);
+}
+
+void Profiler::AddRefinementLevelTime(const int level, const double seconds)
+{
+  // the levels beyond max_num_levels_ are merged into the last one
+  const int id = std::clamp(level, 0, max_num_levels_ - 1);
+  refinement_level_time_ns_[id].fetch_add(ToNanoseconds(seconds),
+                                          std::memory_order_relaxed);
+}
+
+void Profiler::AddCoarseningLevel(const int64_t num_bytes)
+{
+  num_coarsening_levels_.fetch_add(1, std::memory_order_relaxed);
+  coarsening_bytes_.fetch_add(num_bytes, std::memory_order_relaxed);
+}
+
+void Profiler::AddRefinementPass(const int64_t moves_attempted,
+                                 const int64_t moves_accepted,
+                                 const int64_t gain_updates,
+                                 const int64_t heap_operations)
+{
+  num_refinement_passes_.fetch_add(1, std::memory_order_relaxed);
+  moves_attempted_.fetch_add(moves_attempted, std::memory_order_relaxed);
+  moves_accepted_.fetch_add(moves_accepted, std::memory_order_relaxed);
+  gain_updates_.fetch_add(gain_updates, std::memory_order_relaxed);
+  heap_operations_.fetch_add(heap_operations, std::memory_order_relaxed);
+}
+
+void Profiler::AddSavedMoves(const int level, const int64_t num_moves)
+{
+  moves_saved_.fetch_add(num_moves, std::memory_order_relaxed);
+  if (level < 0) {
+    return;
+  }
+  const int id = std::min(level, max_num_levels_ - 1);
+  refinement_level_moves_saved_[id].fetch_add(num_moves,
+                                              std::memory_order_relaxed);
+}
+
+void Profiler::AddParallelRegion(const double wall_seconds,
+                                 const double busy_seconds,
+                                 const int num_threads)
+{
+  parallel_wall_ns_.fetch_add(ToNanoseconds(wall_seconds * num_threads),
+                              std::memory_order_relaxed);
+  parallel_busy_ns_.fetch_add(ToNanoseconds(busy_seconds),
+                              std::memory_order_relaxed);
+}
+
+void Profiler::ReportMetrics(utl::Logger* logger,
+                             const int num_vertices,
+                             const double runtime) const
+{
+  for (int i = 0; i < static_cast<int>(ProfilePhase::NUM_PHASES); i++) {
+    const std::string phase = ToString(static_cast<ProfilePhase>(i));
+    logger->metric("partition__" + phase + "__count",
+                   phases_[i].num_calls.load());
+    logger->metric("partition__" + phase + "__runtime",
+                   phases_[i].time_ns.load() * 1e-9);
+  }
+  for (int level = 0; level < max_num_levels_; level++) {
+    const int64_t time_ns = refinement_level_time_ns_[level].load();
+    if (time_ns > 0) {
+      logger->metric(
+          "partition__refinement__level_" + std::to_string(level) + "__runtime",
+          time_ns * 1e-9);
+    }
+    const int64_t moves_saved = refinement_level_moves_saved_[level].load();
+    if (moves_saved > 0) {
+      logger->metric("partition__refinement__level_" + std::to_string(level)
+                         + "__moves__saved",
+                     moves_saved);
+    }
+  }
+  logger->metric("partition__coarsening__levels",
+                 num_coarsening_levels_.load());
+  logger->metric("partition__coarsening__bytes", coarsening_bytes_.load());
+  logger->metric("partition__refinement__passes",
+                 num_refinement_passes_.load());
+  logger->metric("partition__refinement__moves__attempted",
+                 moves_attempted_.load());
+  logger->metric("partition__refinement__moves__accepted",
+                 moves_accepted_.load());
+  logger->metric("partition__refinement__moves__saved", moves_saved_.load());
+  logger->metric("partition__refinement__gain_updates", gain_updates_.load());
+  logger->metric("partition__refinement__heap_operations",
+                 heap_operations_.load());
+  // the busy time of the threads over the time they are available
+  const int64_t parallel_wall_ns = parallel_wall_ns_.load();
+  double thread_utilization = 0.0;
+  if (parallel_wall_ns > 0) {
+    thread_utilization
+        = static_cast<double>(parallel_busy_ns_.load()) / parallel_wall_ns;
+  }
+  logger->metric("partition__thread_utilization", thread_utilization);
+  logger->metric("partition__runtime", runtime);
+  logger->metric("partition__design__vertices", num_vertices);
+  logger->metric("partition__throughput",
+                 runtime > 0.0 ? num_vertices / runtime : 0.0);
+}
+
+}  // namespace par
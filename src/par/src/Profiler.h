@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+// High-level description
+// Low-overhead counters for profiling the phases of TritonPart.
+// The counters are shared by the coarsener, the refiners and the multi-level
+// partitioner (and by their thread-local copies), so all of them are atomic.
+// The hot loops accumulate their statistics locally and only update the
+// counters once per call (e.g., once per refinement pass).
+// The counters are reported through the utl metrics.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace utl {
+class Logger;
+}
+
+namespace par {
+
+class Profiler;
+using ProfilerPtr = std::shared_ptr<Profiler>;
+
+// the phases of the multi-level partitioner
+enum class ProfilePhase
+{
+  COARSENING,
+  INITIAL_PARTITIONING,
+  REFINEMENT,
+  CUT_OVERLAY_ILP,
+  VCYCLE,
+  NUM_PHASES  // not a phase
+};
+
+std::string ToString(ProfilePhase phase);
+
+class Profiler
+{
+ public:
+  // The time of a phase is summed over all the threads running the phase
+  void AddPhaseTime(ProfilePhase phase, double seconds);
+
+  // level is the distance to the finest hypergraph (0 means the finest)
+  void AddRefinementLevelTime(int level, double seconds);
+
+  // one coarser hypergraph with num_bytes memory is created
+  void AddCoarseningLevel(int64_t num_bytes);
+
+  // the statistics of one refinement pass
+  void AddRefinementPass(int64_t moves_attempted,
+                         int64_t moves_accepted,
+                         int64_t gain_updates,
+                         int64_t heap_operations);
+
+  // num_moves moves are saved by stopping an FM pass adaptively.
+  // level is the refinement level (-1 means the moves are only counted in
+  // the total)
+  void AddSavedMoves(int level, int64_t num_moves);
+
+  // A parallel region runs for wall_seconds with num_threads threads,
+  // and the threads are busy for busy_seconds in total
+  void AddParallelRegion(double wall_seconds,
+                         double busy_seconds,
+                         int num_threads);
+
+  // Report all the counters as metrics.
+  // num_vertices is the size of the partitioned hypergraph and
+  // runtime is the total runtime (in seconds) of the partitioner
+  void ReportMetrics(utl::Logger* logger,
+                     int num_vertices,
+                     double runtime) const;
+
+ private:
+  static constexpr int max_num_levels_ = 64;
+
+  static int64_t ToNanoseconds(double seconds)
+  {
+    return static_cast<int64_t>(seconds * 1e9);
+  }
+
+  struct PhaseCounter
+  {
+    std::atomic<int64_t> num_calls = 0;
+    std::atomic<int64_t> time_ns = 0;
+  };
+
+  std::array<PhaseCounter, static_cast<int>(ProfilePhase::NUM_PHASES)>
+      phases_;
+  std::array<std::atomic<int64_t>, max_num_levels_> refinement_level_time_ns_{};
+  std::atomic<int64_t> num_coarsening_levels_ = 0;
+  std::atomic<int64_t> coarsening_bytes_ = 0;
+  std::atomic<int64_t> num_refinement_passes_ = 0;
+  std::atomic<int64_t> moves_attempted_ = 0;
+  std::atomic<int64_t> moves_accepted_ = 0;
+  std::atomic<int64_t> gain_updates_ = 0;
+  std::atomic<int64_t> heap_operations_ = 0;
+  std::atomic<int64_t> moves_saved_ = 0;
+  std::array<std::atomic<int64_t>, max_num_levels_>
+      refinement_level_moves_saved_{};
+  std::atomic<int64_t> parallel_wall_ns_ = 0;  // wall time x num_threads
+  std::atomic<int64_t> parallel_busy_ns_ = 0;
+};
+
+// Add the lifetime of the timer to the phase.
+// Nothing is recorded if the profiler is nullptr.
+class ProfileTimer
+{
+ public:
+  // Only measure the time, e.g., the busy time of a thread
+  ProfileTimer() : start_(std::chrono::steady_clock::now()) {}
+
+  ProfileTimer(Profiler* profiler, ProfilePhase phase)
+      : profiler_(profiler),
+        phase_(phase),
+        start_(std::chrono::steady_clock::now())
+  {
+  }
+
+  ~ProfileTimer()
+  {
+    if (profiler_ != nullptr) {
+      profiler_->AddPhaseTime(phase_, GetSeconds());
+    }
+  }
+
+  double GetSeconds() const
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                         - start_)
+        .count();
+  }
+
+ private:
+  Profiler* profiler_ = nullptr;
+  ProfilePhase phase_ = ProfilePhase::NUM_PHASES;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace par
@@ -34,6 +34,9 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "Refiner.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "Evaluator.h"
 #include "Hypergraph.h"
 #include "Utilities.h"
@@ -46,24 +49,24 @@ using utl::PAR;
 VertexGain::VertexGain(const int vertex,
                        const int src_block_id,
                        const int destination_block_id,
-                       const float gain,
-                       const std::map<int, float>& path_cost)
+                       GainValue gain,
+                       PathCost path_cost)
     : vertex_(vertex),
       source_part_(src_block_id),
       destination_part_(destination_block_id),
       gain_(gain),
-      path_cost_(path_cost)
+      path_cost_(std::move(path_cost))
 {
 }
 
 HyperedgeGain::HyperedgeGain(const int hyperedge_id,
                              const int destination_part,
-                             const float gain,
-                             const std::map<int, float>& path_cost)
+                             GainValue gain,
+                             PathCost path_cost)
     : hyperedge_id_(hyperedge_id),
       destination_part_(destination_part),
       gain_(gain),
-      path_cost_(path_cost)
+      path_cost_(std::move(path_cost))
 {
 }
 
@@ -108,6 +111,84 @@ void Refiner::RestoreDefaultParameters()
   logger_->info(PAR, 166, "Reset the refiner_iters to {}", refiner_iters_);
 }
 
+void Refiner::SetThreadPool(ThreadPoolPtr thread_pool)
+{
+  thread_pool_ = std::move(thread_pool);
+}
+
+void Refiner::SetProfiler(ProfilerPtr profiler)
+{
+  profiler_ = std::move(profiler);
+}
+
+void Refiner::SetDeadline(DeadlinePtr deadline)
+{
+  deadline_ = std::move(deadline);
+}
+
+bool Refiner::CheckDeadline(const int num_moves) const
+{
+  return num_moves % time_check_interval_ == 0 && IsTimeUp(deadline_);
+}
+
+void Refiner::RecordPass(const int moves_attempted,
+                         const int moves_accepted,
+                         const int64_t gain_updates,
+                         const GainBuckets& buckets) const
+{
+  if (profiler_ == nullptr) {
+    return;
+  }
+  int64_t heap_operations = 0;
+  for (const auto& bucket : buckets) {
+    heap_operations += bucket->GetNumOperations();
+    bucket->ResetNumOperations();
+  }
+  profiler_->AddRefinementPass(
+      moves_attempted, moves_accepted, gain_updates, heap_operations);
+}
+
+void Refiner::RecordSavedMoves(const int num_saved_moves) const
+{
+  if (profiler_ == nullptr || num_saved_moves <= 0) {
+    return;
+  }
+  profiler_->AddSavedMoves(refinement_level_, num_saved_moves);
+}
+
+ThreadPool* Refiner::GetThreadPool(const int workload) const
+{
+  if (workload < parallel_workload_threshold_) {
+    return nullptr;
+  }
+  return thread_pool_.get();
+}
+
+void AdaptiveStoppingRule::Reset()
+{
+  num_steps_ = 0;
+  mean_ = 0.0;
+  sum_squares_ = 0.0;
+}
+
+// Welford's algorithm
+void AdaptiveStoppingRule::AddGain(const float gain)
+{
+  num_steps_++;
+  const double delta = gain - mean_;
+  mean_ += delta / num_steps_;
+  sum_squares_ += delta * (gain - mean_);
+}
+
+bool AdaptiveStoppingRule::ShouldStop() const
+{
+  if (num_steps_ < 2 || mean_ >= 0.0) {
+    return false;
+  }
+  const double variance = sum_squares_ / (num_steps_ - 1);
+  return num_steps_ * mean_ * mean_ > alpha_ * variance + beta_;
+}
+
 // The main function of refinement class
 void Refiner::Refine(const HGraphPtr& hgraph,
                      const Matrix<float>& upper_block_balance,
@@ -120,14 +201,26 @@ void Refiner::Refine(const HGraphPtr& hgraph,
     return;
   }
   // calculate the basic statistics of current solution
-  Matrix<float> cur_block_balance
-      = evaluator_->GetBlockBalance(hgraph, solution);
-  Matrix<int> net_degs = evaluator_->GetNetDegrees(hgraph, solution);
-  std::vector<float> cur_paths_cost;
-  if (hgraph->HasTiming()) {
-    cur_paths_cost = evaluator_->GetPathsCost(hgraph, solution);
-  }
+  PartitionState state = evaluator_->GetPartitionState(hgraph, solution);
+  Refine(hgraph, upper_block_balance, lower_block_balance, solution, state);
+}
+
+// The net degrees, block balance and path cost in state are updated
+// incrementally with each accepted move
+void Refiner::Refine(const HGraphPtr& hgraph,
+                     const Matrix<float>& upper_block_balance,
+                     const Matrix<float>& lower_block_balance,
+                     Partitions& solution,
+                     PartitionState& state)
+{
+  // the boundary is built once and then maintained with the moves
+  InitializeBoundary(hgraph, state.net_degs);
+  InitializeFixedPoint(
+      hgraph, upper_block_balance, lower_block_balance, solution);
   for (int i = 0; i < refiner_iters_; ++i) {
+    if (IsTimeUp(deadline_)) {
+      break;  // keep the best solution found so far
+    }
     // the main function for improving the solution
     // mark the vertices can be moved as unvisited
     std::vector<bool> visited_vertices_flag(hgraph->GetNumVertices(), false);
@@ -142,15 +235,41 @@ void Refiner::Refine(const HGraphPtr& hgraph,
     const float gain = Pass(hgraph,
                             upper_block_balance,
                             lower_block_balance,
-                            cur_block_balance,
-                            net_degs,
-                            cur_paths_cost,
+                            state.block_balance,
+                            state.net_degs,
+                            state.paths_cost,
                             solution,
                             visited_vertices_flag);
     if (gain <= 0.0) {
-      return;  // stop if there is no improvement
+      break;  // stop if there is no improvement
     }
   }
+  if (IsTimeUp(deadline_)) {
+    deadline_->AddShortenedPhase(ToString(ProfilePhase::REFINEMENT));
+  }
+  boundary_flag_ = false;
+  fixed_point_flag_ = false;
+}
+
+void Refiner::CopyRefinementState(const Refiner& refiner)
+{
+  boundary_flag_ = refiner.boundary_flag_;
+  edge_span_ = refiner.edge_span_;
+  cut_edges_ = refiner.cut_edges_;
+  cut_edge_pos_ = refiner.cut_edge_pos_;
+  num_cut_edges_ = refiner.num_cut_edges_;
+  boundary_vertices_ = refiner.boundary_vertices_;
+  boundary_pos_ = refiner.boundary_pos_;
+  fixed_point_flag_ = refiner.fixed_point_flag_;
+  if (fixed_point_flag_ == true) {
+    fixed_edge_costs_ = refiner.fixed_edge_costs_;
+    fixed_path_costs_ = refiner.fixed_path_costs_;
+    fixed_snaking_cost_ = refiner.fixed_snaking_cost_;
+    fixed_vertex_weights_ = refiner.fixed_vertex_weights_;
+    fixed_upper_balance_ = refiner.fixed_upper_balance_;
+    fixed_lower_balance_ = refiner.fixed_lower_balance_;
+    fixed_block_balance_ = refiner.fixed_block_balance_;
+  }
 }
 
 // ---------------------------------------------------------------
@@ -174,60 +293,104 @@ float Refiner::CalculatePathCost(int path_id,
       || path_id >= hgraph->GetNumTimingPaths()) {
     return cost;  // no timing paths
   }
-  // we must use vector here.  Becuase we need to calculate the snaking factor
-  std::vector<int> path;             // represent the path in terms of block_id
-  std::map<int, int> block_counter;  // block_id counter
-  for (const int u : hgraph->PathVertices(path_id)) {
-    int block_id = solution[u];
-    if ((to_pid != -1) && (u == v)) {
-      block_id = to_pid;
-    }
-    if (path.empty() || path.back() != block_id) {
-      path.push_back(block_id);
-      if (block_counter.find(block_id) != block_counter.end()) {
-        block_counter[block_id] += 1;
-      } else {
-        block_counter[block_id] = 1;
-      }
-    }
-  }
+  // the block changes along the path, without building the block sequence
+  const PathCuts cuts = CountPathCuts(
+      hgraph->PathVertices(path_id), solution, num_parts_, v, to_pid);
   // check if the entire path is within the block
-  if (path.size() <= 1) {
+  if (cuts.num_cuts == 0) {
     return cost;
   }
   // timing-related cost (basic path_cost * number of cut on the path)
-  cost = path_wt_factor_ * (path.size() - 1) * hgraph->PathTimingCost(path_id);
+  // hgraph->PathTimingCost(path_id) holds the exponential timing score of
+  // the path, precomputed by GoldenEvaluator::InitializeTiming
+  cost = path_wt_factor_ * cuts.num_cuts * hgraph->PathTimingCost(path_id);
   // get the snaking factor of the path (maximum repetition of block_id - 1)
-  int snaking_factor = 0;
-  for (auto [block_id, count] : block_counter) {
-    if (count > snaking_factor) {
-      snaking_factor = count;
+  cost += snaking_wt_factor_ * static_cast<float>(cuts.max_block_visits - 1);
+  return evaluator_->QuantizeCost(cost);
+}
+
+// The same cost as CalculatePathCost from the integer costs
+int64_t Refiner::CalculateFixedPathCost(int path_id,
+                                        const HGraphPtr& hgraph,
+                                        const Partitions& solution,
+                                        int v,      // v = -1 by default
+                                        int to_pid  // to_pid = -1 by default
+) const
+{
+  if (hgraph->GetNumTimingPaths() == 0
+      || path_id >= hgraph->GetNumTimingPaths()) {
+    return 0;  // no timing paths
+  }
+  const PathCuts cuts = CountPathCuts(
+      hgraph->PathVertices(path_id), solution, num_parts_, v, to_pid);
+  if (cuts.num_cuts == 0) {
+    return 0;
+  }
+  return cuts.num_cuts * fixed_path_costs_[path_id]
+         + (cuts.max_block_visits - 1) * fixed_snaking_cost_;
+}
+
+// Only the first max_num_edges cut hyperedges (in increasing order of ids)
+// are sorted
+std::vector<int> Refiner::FindCutHyperedges(const HGraphPtr& hgraph,
+                                            const NetDegrees& net_degs,
+                                            const int max_num_edges) const
+{
+  std::vector<int> cut_edges;
+  if (max_num_edges <= 0) {
+    return cut_edges;
+  }
+  if (boundary_flag_ == true) {
+    cut_edges = cut_edges_;
+    if (static_cast<int>(cut_edges.size()) > max_num_edges) {
+      std::nth_element(cut_edges.begin(),
+                       cut_edges.begin() + max_num_edges,
+                       cut_edges.end());
+      cut_edges.resize(max_num_edges);
+    }
+    std::sort(cut_edges.begin(), cut_edges.end());
+    return cut_edges;
+  }
+  for (int e = 0; e < hgraph->GetNumHyperedges()
+                  && static_cast<int>(cut_edges.size()) < max_num_edges;
+       e++) {
+    if (IsCutHyperedge(e, net_degs) == true) {
+      cut_edges.push_back(e);
     }
   }
-  cost += snaking_wt_factor_ * static_cast<float>(snaking_factor - 1);
-  return cost;
+  return cut_edges;
+}
+
+bool Refiner::IsCutHyperedge(const int e, const NetDegrees& net_degs) const
+{
+  if (boundary_flag_ == true) {
+    return edge_span_[e] > 1;
+  }
+  return net_degs.IsCut(e);
 }
 
 // Find all the boundary vertices.
 // The boundary vertices do not include fixed vertices
 std::vector<int> Refiner::FindBoundaryVertices(
     const HGraphPtr& hgraph,
-    const Matrix<int>& net_degs,
+    const NetDegrees& net_degs,
     const std::vector<bool>& visited_vertices_flag) const
 {
+  if (boundary_flag_ == true) {
+    std::vector<int> boundary_vertices;
+    boundary_vertices.reserve(boundary_vertices_.size());
+    for (const int v : boundary_vertices_) {
+      if (visited_vertices_flag[v] == false) {
+        boundary_vertices.push_back(v);
+      }
+    }
+    std::sort(boundary_vertices.begin(), boundary_vertices.end());
+    return boundary_vertices;
+  }
   // Step 1 : found all the boundary hyperedges
   std::vector<bool> boundary_net_flag(hgraph->GetNumHyperedges(), false);
   for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
-    int num_span_part = 0;
-    for (int i = 0; i < num_parts_; i++) {
-      if (net_degs[e][i] > 0) {
-        num_span_part++;
-        if (num_span_part >= 2) {
-          boundary_net_flag[e] = true;
-          break;
-        }
-      }
-    }
+    boundary_net_flag[e] = net_degs.IsCut(e);
   }
   // Step 2: check all the non-fixed vertices
   std::vector<int> boundary_vertices;
@@ -247,16 +410,37 @@ std::vector<int> Refiner::FindBoundaryVertices(
 
 std::vector<int> Refiner::FindBoundaryVertices(
     const HGraphPtr& hgraph,
-    const Matrix<int>& net_degs,
+    const NetDegrees& net_degs,
     const std::vector<bool>& visited_vertices_flag,
     const std::vector<int>& solution,
     const std::pair<int, int>& partition_pair) const
 {
+  auto lambda_pair_boundary = [&](int e) {
+    return net_degs[e][partition_pair.first] > 0
+           && net_degs[e][partition_pair.second] > 0;
+  };
+  if (boundary_flag_ == true) {
+    // a hyperedge spanning both blocks is a cut hyperedge, so only the
+    // boundary vertices need to be checked
+    std::vector<int> boundary_vertices;
+    for (const int v : boundary_vertices_) {
+      if (visited_vertices_flag[v] == true) {
+        continue;
+      }
+      for (const int edge_id : hgraph->Edges(v)) {
+        if (lambda_pair_boundary(edge_id)) {
+          boundary_vertices.push_back(v);
+          break;
+        }
+      }
+    }
+    std::sort(boundary_vertices.begin(), boundary_vertices.end());
+    return boundary_vertices;
+  }
   // Step 1 : found all the boundary hyperedges
   std::vector<bool> boundary_net_flag(hgraph->GetNumHyperedges(), false);
   for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
-    if (net_degs[e][partition_pair.first] > 0
-        && net_degs[e][partition_pair.second] > 0) {
+    if (lambda_pair_boundary(e)) {
       boundary_net_flag[e] = true;
     }
   }
@@ -276,44 +460,81 @@ std::vector<int> Refiner::FindBoundaryVertices(
   return boundary_vertices;
 }
 
+// The gain of moving a vertex only depends on the number of blocks spanned
+// by its hyperedges and on the number of their pins in the source and the
+// destination blocks (0, 1 or more, see CalculateVertexGain).  Moving a pin
+// of e from from_pid to to_pid only changes these numbers for the other pins
+// when the pins left in from_pid drop to 1 or 0, or the pins in to_pid rise
+// to 1 or 2 (the classical delta-gain rule).  For the other moves the
+// neighbors through the large hyperedges are skipped
+bool Refiner::IsGainAffected(const HGraphPtr& hgraph,
+                             const int e,
+                             const int from_pid,
+                             const int to_pid,
+                             const NetDegrees& net_degs) const
+{
+  if (lazy_gain_threshold_ <= 0
+      || static_cast<int>(hgraph->Vertices(e).size()) < lazy_gain_threshold_) {
+    return true;
+  }
+  return net_degs[e][from_pid] <= 1 || net_degs[e][to_pid] <= 2;
+}
+
 // Find the neighboring vertices
-std::vector<int> Refiner::FindNeighbors(
+const std::vector<int>& Refiner::FindNeighbors(
     const HGraphPtr& hgraph,
-    const int vertex_id,
+    const GainCell& gain_cell,
+    const NetDegrees& net_degs,
     const std::vector<bool>& visited_vertices_flag) const
 {
-  std::set<int> neighbors;
+  const int vertex_id = gain_cell.GetVertex();
+  const int from_pid = gain_cell.GetSourcePart();
+  const int to_pid = gain_cell.GetDestinationPart();
+  StartNeighbors(hgraph);
   for (const int e : hgraph->Edges(vertex_id)) {
+    if (IsGainAffected(hgraph, e, from_pid, to_pid, net_degs) == false) {
+      continue;
+    }
     for (const int v : hgraph->Vertices(e)) {
-      if (visited_vertices_flag[v] == false) {
+      if (visited_vertices_flag[v] == false && MarkNeighbor(v) == true) {
         // This vertex has not been visited yet
-        neighbors.insert(v);
+        neighbors_.push_back(v);
       }
     }
   }
-  return std::vector<int>(neighbors.begin(), neighbors.end());
+  std::sort(neighbors_.begin(), neighbors_.end());
+  return neighbors_;
 }
 
 // Find the neighboring vertices in specified blocks
-std::vector<int> Refiner::FindNeighbors(
+const std::vector<int>& Refiner::FindNeighbors(
     const HGraphPtr& hgraph,
-    const int vertex_id,
+    const GainCell& gain_cell,
+    const NetDegrees& net_degs,
     const std::vector<bool>& visited_vertices_flag,
     const std::vector<int>& solution,
     const std::pair<int, int>& partition_pair) const
 {
-  std::set<int> neighbors;
+  const int vertex_id = gain_cell.GetVertex();
+  const int from_pid = gain_cell.GetSourcePart();
+  const int to_pid = gain_cell.GetDestinationPart();
+  StartNeighbors(hgraph);
   for (const int e : hgraph->Edges(vertex_id)) {
+    if (IsGainAffected(hgraph, e, from_pid, to_pid, net_degs) == false) {
+      continue;
+    }
     for (const int v : hgraph->Vertices(e)) {
       if (visited_vertices_flag[v] == false
           && (solution[v] == partition_pair.first
-              || solution[v] == partition_pair.second)) {
+              || solution[v] == partition_pair.second)
+          && MarkNeighbor(v) == true) {
         // This vertex has not been visited yet
-        neighbors.insert(v);
+        neighbors_.push_back(v);
       }
     }
   }
-  return std::vector<int>(neighbors.begin(), neighbors.end());
+  std::sort(neighbors_.begin(), neighbors_.end());
+  return neighbors_;
 }
 
 // Functions related to move a vertex
@@ -335,48 +556,44 @@ GainCell Refiner::CalculateVertexGain(int v,
                                       const HGraphPtr& hgraph,
                                       const std::vector<int>& solution,
                                       const std::vector<float>& cur_paths_cost,
-                                      const Matrix<int>& net_degs) const
+                                      const NetDegrees& net_degs) const
 {
   // We assume from_pid == solution[v] when we call CalculateGain
   // we need solution argument to update the score related to path
   float cut_score = 0.0;
   float path_score = 0.0;
-  std::map<int, float>
-      delta_path_cost;       // map path_id to the change of path cost
+  int64_t fixed_score = 0;  // the score in the fixed-point mode
+  PathCost delta_path_cost;  // map path_id to the change of path cost
   if (from_pid == to_pid) {  // no gain for this case
-    return std::make_shared<VertexGain>(
-        v, from_pid, to_pid, 0.0f, delta_path_cost);
+    return VertexGain(v, from_pid, to_pid, MakeGain(0.0, 0), delta_path_cost);
   }
-  // define lambda function
-  // for checking connectivity (number of blocks connected by a hyperedge)
-  // function : check the connectivity for the hyperedge
-  auto GetConnectivity = [&](int e) {
-    int connectivity = 0;
-    for (auto& num_v : net_degs[e]) {
-      if (num_v > 0) {
-        connectivity++;
-      }
-    }
-    return connectivity;
-  };
   // traverse all the hyperedges connected to v
   for (const int e : hgraph->Edges(v)) {
-    const int connectivity = GetConnectivity(e);
-    const float e_score = evaluator_->CalculateHyperedgeCost(e, hgraph);
+    // connectivity : number of blocks connected by the hyperedge
+    const int connectivity = net_degs.GetSpan(e);
     if (connectivity == 0) {
       // ignore the hyperedge consisting of multiple vertices
       // ignore single-vertex hyperedge
       continue;
     }
+    int sign = 0;
     if (connectivity == 1 && net_degs[e][from_pid] > 1) {
       // move from_pid to to_pid will have negative score
       // all the vertices are with block from_id
-      cut_score -= e_score;
+      sign = -1;
     } else if (connectivity == 2 && net_degs[e][from_pid] == 1
                && net_degs[e][to_pid] > 0) {
       // all the vertices excluding v are all within block to_pid
       // move from_pid to to_pid will increase the score
-      cut_score += e_score;
+      sign = 1;
+    }
+    if (sign == 0) {
+      continue;
+    }
+    if (fixed_point_flag_ == true) {
+      fixed_score += sign * fixed_edge_costs_[e];
+    } else {
+      cut_score += sign * evaluator_->CalculateHyperedgeCost(e, hgraph);
     }
   }
   // check the timing path
@@ -385,48 +602,55 @@ GainCell Refiner::CalculateVertexGain(int v,
       // Get updated path costs if vertex is moved to a different partition
       const float cost
           = CalculatePathCost(path_id, hgraph, solution, v, to_pid);
-      delta_path_cost[path_id] = cost - cur_paths_cost[path_id];
+      delta_path_cost.emplace_back(path_id, cost - cur_paths_cost[path_id]);
       // gain accomodates for the change in the cost of the timing path
-      path_score += cur_paths_cost[path_id] - cost;  // score in minus cost
+      if (fixed_point_flag_ == true) {
+        fixed_score += CalculateFixedPathCost(path_id, hgraph, solution)
+                       - CalculateFixedPathCost(
+                           path_id, hgraph, solution, v, to_pid);
+      } else {
+        path_score += cur_paths_cost[path_id] - cost;  // score in minus cost
+      }
     }
   }
   const float score = cut_score + path_score;
-  return std::make_shared<VertexGain>(
-      v, from_pid, to_pid, score, delta_path_cost);
+  return VertexGain(v,
+                    from_pid,
+                    to_pid,
+                    MakeGain(score, fixed_score),
+                    std::move(delta_path_cost));
 }
 
 // move one vertex based on the calculated gain_cell
 void Refiner::AcceptVertexGain(const GainCell& gain_cell,
                                const HGraphPtr& hgraph,
-                               float& total_delta_gain,
+                               GainValue& total_delta_gain,
                                std::vector<bool>& visited_vertices_flag,
                                std::vector<int>& solution,
                                std::vector<float>& cur_paths_cost,
                                Matrix<float>& curr_block_balance,
-                               Matrix<int>& net_degs) const
+                               NetDegrees& net_degs) const
 {
-  const int vertex_id = gain_cell->GetVertex();
+  const int vertex_id = gain_cell.GetVertex();
   visited_vertices_flag[vertex_id] = true;
-  total_delta_gain += gain_cell->GetGain();  // increase the total gain
+  total_delta_gain += gain_cell.GetGainValue();  // increase the total gain
   // Update the path cost first
-  for (const auto& [path_id, delta_path_cost] : gain_cell->GetPathCost()) {
+  for (const auto& [path_id, delta_path_cost] : gain_cell.GetPathCost()) {
     cur_paths_cost[path_id] += delta_path_cost;
   }
   // get partition id
-  const int pre_part_id = gain_cell->GetSourcePart();
-  const int new_part_id = gain_cell->GetDestinationPart();
+  const int pre_part_id = gain_cell.GetSourcePart();
+  const int new_part_id = gain_cell.GetDestinationPart();
   // update the solution vector
   solution[vertex_id] = new_part_id;
   // Update the partition balance
-  curr_block_balance[pre_part_id]
-      = curr_block_balance[pre_part_id] - hgraph->GetVertexWeights(vertex_id);
-  curr_block_balance[new_part_id]
-      = curr_block_balance[new_part_id] + hgraph->GetVertexWeights(vertex_id);
+  Subtract(curr_block_balance[pre_part_id],
+           hgraph->GetVertexWeights(vertex_id));
+  Accumulate(curr_block_balance[new_part_id],
+             hgraph->GetVertexWeights(vertex_id));
+  MoveFixedBlockBalance(hgraph, vertex_id, pre_part_id, new_part_id);
   // update net_degs
-  for (const int he : hgraph->Edges(vertex_id)) {
-    --net_degs[he][pre_part_id];
-    ++net_degs[he][new_part_id];
-  }
+  MoveNetDegrees(hgraph, vertex_id, pre_part_id, new_part_id, net_degs);
 }
 
 // restore one vertex based on the calculated gain_cell
@@ -436,33 +660,74 @@ void Refiner::RollBackVertexGain(const GainCell& gain_cell,
                                  std::vector<int>& solution,
                                  std::vector<float>& cur_paths_cost,
                                  Matrix<float>& curr_block_balance,
-                                 Matrix<int>& net_degs) const
+                                 NetDegrees& net_degs) const
 {
-  const int vertex_id = gain_cell->GetVertex();
+  const int vertex_id = gain_cell.GetVertex();
   visited_vertices_flag[vertex_id] = false;
   // Update the path cost first
-  for (const auto& [path_id, delta_path_cost] : gain_cell->GetPathCost()) {
+  for (const auto& [path_id, delta_path_cost] : gain_cell.GetPathCost()) {
     cur_paths_cost[path_id] -= delta_path_cost;
   }
   // get partition id
-  const int pre_part_id = gain_cell->GetSourcePart();
-  const int new_part_id = gain_cell->GetDestinationPart();
+  const int pre_part_id = gain_cell.GetSourcePart();
+  const int new_part_id = gain_cell.GetDestinationPart();
   // update the solution vector
   solution[vertex_id] = pre_part_id;
   // Update the partition balance
-  curr_block_balance[pre_part_id]
-      = curr_block_balance[pre_part_id] + hgraph->GetVertexWeights(vertex_id);
-  curr_block_balance[new_part_id]
-      = curr_block_balance[new_part_id] - hgraph->GetVertexWeights(vertex_id);
+  Accumulate(curr_block_balance[pre_part_id],
+             hgraph->GetVertexWeights(vertex_id));
+  Subtract(curr_block_balance[new_part_id],
+           hgraph->GetVertexWeights(vertex_id));
+  MoveFixedBlockBalance(hgraph, vertex_id, new_part_id, pre_part_id);
   // update net_degs
-  for (const int he : hgraph->Edges(vertex_id)) {
-    ++net_degs[he][pre_part_id];
-    --net_degs[he][new_part_id];
-  }
+  MoveNetDegrees(hgraph, vertex_id, new_part_id, pre_part_id, net_degs);
 }
 
 // check if we can move the vertex to some block
 // Here we assume the vertex v is not in the block to_pid
+template <int Dimensions>
+bool Refiner::CheckVertexMoveLegality(
+    int v,         // vertex id
+    int to_pid,    // to block id
+    int from_pid,  // from block_id
+    const HGraphPtr& hgraph,
+    const Matrix<float>& curr_block_balance,
+    const Matrix<float>& upper_block_balance,
+    const Matrix<float>& lower_block_balance) const
+{
+  // total_wt_to_block <= upper_block_balance[to_pid]
+  // total_wt_from_block >= lower_block_balance[from_pid]
+  return CompareSum(curr_block_balance[to_pid],
+                    hgraph->GetVertexWeights(v),
+                    1.0,
+                    upper_block_balance[to_pid])
+             <= 0
+         && CompareSum(curr_block_balance[from_pid],
+                       hgraph->GetVertexWeights(v),
+                       -1.0,
+                       lower_block_balance[from_pid])
+                >= 0;
+}
+
+// one-dimensional vertex weights
+template <>
+bool Refiner::CheckVertexMoveLegality<1>(
+    int v,         // vertex id
+    int to_pid,    // to block id
+    int from_pid,  // from block_id
+    const HGraphPtr& hgraph,
+    const Matrix<float>& curr_block_balance,
+    const Matrix<float>& upper_block_balance,
+    const Matrix<float>& lower_block_balance) const
+{
+  const float vertex_weight = hgraph->GetVertexWeights(v).front();
+  const float total_wt_to_block = curr_block_balance[to_pid][0] + vertex_weight;
+  const float total_wt_from_block
+      = curr_block_balance[from_pid][0] - vertex_weight;
+  return total_wt_to_block <= upper_block_balance[to_pid][0]
+         && lower_block_balance[from_pid][0] <= total_wt_from_block;
+}
+
 bool Refiner::CheckVertexMoveLegality(
     int v,         // vertex id
     int to_pid,    // to block id
@@ -472,33 +737,46 @@ bool Refiner::CheckVertexMoveLegality(
     const Matrix<float>& upper_block_balance,
     const Matrix<float>& lower_block_balance) const
 {
-  const std::vector<float> total_wt_to_block
-      = curr_block_balance[to_pid] + hgraph->GetVertexWeights(v);
-  const std::vector<float> total_wt_from_block
-      = curr_block_balance[from_pid] - hgraph->GetVertexWeights(v);
-  return total_wt_to_block <= upper_block_balance[to_pid]
-         && lower_block_balance[from_pid] <= total_wt_from_block;
+  if (fixed_point_flag_ == true) {
+    return CheckFixedVertexMoveLegality(hgraph, v, to_pid, from_pid);
+  }
+  if (hgraph->GetVertexDimensions() == 1) {
+    return CheckVertexMoveLegality<1>(v,
+                                      to_pid,
+                                      from_pid,
+                                      hgraph,
+                                      curr_block_balance,
+                                      upper_block_balance,
+                                      lower_block_balance);
+  }
+  return CheckVertexMoveLegality<0>(v,
+                                    to_pid,
+                                    from_pid,
+                                    hgraph,
+                                    curr_block_balance,
+                                    upper_block_balance,
+                                    lower_block_balance);
 }
 
 // calculate the possible gain of moving a entire hyperedge
 // We can view the process of moving the vertices in hyperege
 // one by one, then restore the moving sequence to make sure that
 // the current status is not changed. Solution should not be const
-HyperedgeGainPtr Refiner::CalculateHyperedgeGain(
+HyperedgeGain Refiner::CalculateHyperedgeGain(
     int hyperedge_id,
     int to_pid,
     const HGraphPtr& hgraph,
     std::vector<int>& solution,
     const std::vector<float>& cur_paths_cost,
-    const Matrix<int>& net_degs) const
+    const NetDegrees& net_degs) const
 {
   // We assume from_pid == solution[v] when we call CalculateGain
   // we need solution argument to update the score related to path
   float cut_score = 0.0;
   float path_score = 0.0;
   float score = 0.0;
-  std::map<int, float>
-      delta_path_cost;  // map path_id to the change of path cost
+  int64_t fixed_score = 0;  // the score in the fixed-point mode
+  PathCost delta_path_cost;  // map path_id to the change of path cost
   // find the all the vertices of hyperedge,
   // which are not in the to_pid block
   std::vector<std::pair<int, int>> vertices;  // vertex_id, from_pid
@@ -509,14 +787,14 @@ HyperedgeGainPtr Refiner::CalculateHyperedgeGain(
       vertices.emplace_back(vertex_id, solution[vertex_id]);
       for (const int e : hgraph->Edges(vertex_id)) {
         if (net_deg_map.find(e) == net_deg_map.end()) {
-          net_deg_map[e] = net_degs[e];
+          net_deg_map[e].assign(net_degs[e].begin(), net_degs[e].end());
         }
       }
     }
   }
   if (vertices.empty() == true) {
-    return std::make_shared<HyperedgeGain>(
-        hyperedge_id, to_pid, score, delta_path_cost);
+    return HyperedgeGain(
+        hyperedge_id, to_pid, MakeGain(score, fixed_score), delta_path_cost);
   }
   // define lambda function
   // for checking connectivity (number of blocks connected by a hyperedge)
@@ -538,21 +816,26 @@ HyperedgeGainPtr Refiner::CalculateHyperedgeGain(
     // traverse all the hyperedges connected to v
     for (const int e : hgraph->Edges(v)) {
       const int connectivity = GetConnectivity(e);
-      const float e_score = evaluator_->CalculateHyperedgeCost(e, hgraph);
       if (connectivity == 0) {
         // ignore the hyperedge consisting of multiple vertices
         // ignore single-vertex hyperedge
         continue;
       }
+      int sign = 0;
       if (connectivity == 1 && net_deg_map[e][from_pid] > 1) {
         // move from_pid to to_pid will have negative score
         // all the vertices are with block from_id
-        cut_score -= e_score;
+        sign = -1;
       } else if (connectivity == 2 && net_deg_map[e][from_pid] == 1
                  && net_deg_map[e][to_pid] > 0) {
         // all the vertices excluding v are all within block to_pid
         // move from_pid to to_pid will increase the score
-        cut_score += e_score;
+        sign = 1;
+      }
+      if (fixed_point_flag_ == true) {
+        fixed_score += sign * fixed_edge_costs_[e];
+      } else if (sign != 0) {
+        cut_score += sign * evaluator_->CalculateHyperedgeCost(e, hgraph);
       }
       net_deg_map[e][from_pid]--;
       net_deg_map[e][to_pid]++;
@@ -567,13 +850,26 @@ HyperedgeGainPtr Refiner::CalculateHyperedgeGain(
     for (const auto& vertex_pair : vertices) {
       const int v = vertex_pair.first;
       for (const int path_id : hgraph->TimingPathsThrough(v)) {
-        if (delta_path_cost.find(path_id) == delta_path_cost.end()) {
+        const bool visited_path
+            = std::any_of(delta_path_cost.begin(),
+                          delta_path_cost.end(),
+                          [path_id](const std::pair<int, float>& path_cost) {
+                            return path_cost.first == path_id;
+                          });
+        if (visited_path == false) {
           // Get updated path costs if vertex is moved to a different partition
           const float cost
               = CalculatePathCost(path_id, hgraph, solution, v, to_pid);
-          delta_path_cost[path_id] = cost - cur_paths_cost[path_id];
+          delta_path_cost.emplace_back(path_id,
+                                       cost - cur_paths_cost[path_id]);
           // gain accomodates for the change in the cost of the timing path
-          path_score += cur_paths_cost[path_id] - cost;  // score in minus cost
+          if (fixed_point_flag_ == true) {
+            fixed_score -= CalculateFixedPathCost(
+                path_id, hgraph, solution, v, to_pid);
+          } else {
+            path_score
+                += cur_paths_cost[path_id] - cost;  // score in minus cost
+          }
         }
       }
     }
@@ -581,30 +877,39 @@ HyperedgeGainPtr Refiner::CalculateHyperedgeGain(
     for (const auto& vertex_pair : vertices) {
       solution[vertex_pair.first] = vertex_pair.second;
     }
+    // the current costs of the paths
+    if (fixed_point_flag_ == true) {
+      for (const auto& path_cost : delta_path_cost) {
+        fixed_score
+            += CalculateFixedPathCost(path_cost.first, hgraph, solution);
+      }
+    }
   }
 
   score = cut_score + path_score;
-  return std::make_shared<HyperedgeGain>(
-      hyperedge_id, to_pid, score, delta_path_cost);
+  return HyperedgeGain(hyperedge_id,
+                       to_pid,
+                       MakeGain(score, fixed_score),
+                       std::move(delta_path_cost));
 }
 
 // accpet the hyperedge gain
-void Refiner::AcceptHyperedgeGain(const HyperedgeGainPtr& hyperedge_gain,
+void Refiner::AcceptHyperedgeGain(const HyperedgeGain& hyperedge_gain,
                                   const HGraphPtr& hgraph,
-                                  float& total_delta_gain,
+                                  GainValue& total_delta_gain,
                                   std::vector<int>& solution,
                                   std::vector<float>& cur_paths_cost,
                                   Matrix<float>& cur_block_balance,
-                                  Matrix<int>& net_degs) const
+                                  NetDegrees& net_degs) const
 {
-  const int hyperedge_id = hyperedge_gain->GetHyperedge();
-  total_delta_gain += hyperedge_gain->GetGain();
+  const int hyperedge_id = hyperedge_gain.GetHyperedge();
+  total_delta_gain += hyperedge_gain.GetGainValue();
   // Update the path cost first
-  for (const auto& [path_id, delta_path_cost] : hyperedge_gain->GetPathCost()) {
+  for (const auto& [path_id, delta_path_cost] : hyperedge_gain.GetPathCost()) {
     cur_paths_cost[path_id] += delta_path_cost;
   }
   // get block id
-  const int new_part_id = hyperedge_gain->GetDestinationPart();
+  const int new_part_id = hyperedge_gain.GetDestinationPart();
   // update the solution vector block_balance and net_degs
   for (const int vertex_id : hgraph->Vertices(hyperedge_id)) {
     const int pre_part_id = solution[vertex_id];
@@ -614,16 +919,14 @@ void Refiner::AcceptHyperedgeGain(const HyperedgeGainPtr& hyperedge_gain,
     // update solution
     solution[vertex_id] = new_part_id;
     // Update the partition balance
-    cur_block_balance[pre_part_id]
-        = cur_block_balance[pre_part_id] - hgraph->GetVertexWeights(vertex_id);
-    cur_block_balance[new_part_id]
-        = cur_block_balance[new_part_id] + hgraph->GetVertexWeights(vertex_id);
+    Subtract(cur_block_balance[pre_part_id],
+             hgraph->GetVertexWeights(vertex_id));
+    Accumulate(cur_block_balance[new_part_id],
+               hgraph->GetVertexWeights(vertex_id));
+    MoveFixedBlockBalance(hgraph, vertex_id, pre_part_id, new_part_id);
     // update net_degs
     // not just this hyperedge, we need to update all the related hyperedges
-    for (const int he : hgraph->Edges(vertex_id)) {
-      --net_degs[he][pre_part_id];
-      ++net_degs[he][new_part_id];
-    }
+    MoveNetDegrees(hgraph, vertex_id, pre_part_id, new_part_id, net_degs);
   }
 }
 
@@ -636,6 +939,9 @@ bool Refiner::CheckHyperedgeMoveLegality(
     const Matrix<float>& upper_block_balance,
     const Matrix<float>& lower_block_balance) const
 {
+  if (fixed_point_flag_ == true) {
+    return CheckFixedHyperedgeMoveLegality(hgraph, e, to_pid, solution);
+  }
   Matrix<float> update_block_balance = curr_block_balance;
   for (const int v : hgraph->Vertices(e)) {
     // check if satisfies the fixed vertices constraint
@@ -644,10 +950,8 @@ bool Refiner::CheckHyperedgeMoveLegality(
     }
     const int pid = solution[v];
     if (solution[v] != to_pid) {
-      update_block_balance[to_pid]
-          = update_block_balance[to_pid] + hgraph->GetVertexWeights(v);
-      update_block_balance[pid]
-          = update_block_balance[pid] - hgraph->GetVertexWeights(v);
+      Accumulate(update_block_balance[to_pid], hgraph->GetVertexWeights(v));
+      Subtract(update_block_balance[pid], hgraph->GetVertexWeights(v));
     }
   }
   // Violate the upper bound
@@ -666,4 +970,299 @@ bool Refiner::CheckHyperedgeMoveLegality(
   return true;
 }
 
+bool Refiner::CheckBlockBalance(const int block_id,
+                                const Matrix<float>& curr_block_balance,
+                                const Matrix<float>& upper_block_balance,
+                                const Matrix<float>& lower_block_balance) const
+{
+  if (fixed_point_flag_ == false) {
+    return !(upper_block_balance[block_id] < curr_block_balance[block_id])
+           && !(curr_block_balance[block_id] < lower_block_balance[block_id]);
+  }
+  // the same comparisons as the operator< of the weight vectors, i.e.,
+  // a < b if all the dimensions of a are smaller
+  const int dimensions = static_cast<int>(curr_block_balance[block_id].size());
+  const int offset = block_id * dimensions;
+  bool above_upper = true;
+  bool below_lower = true;
+  for (int dim = offset; dim < offset + dimensions; dim++) {
+    above_upper = above_upper
+                  && fixed_upper_balance_[dim] < fixed_block_balance_[dim];
+    below_lower = below_lower
+                  && fixed_block_balance_[dim] < fixed_lower_balance_[dim];
+  }
+  return !above_upper && !below_lower;
+}
+
+// ---------------------------------------------------------------
+// Private functions
+// ---------------------------------------------------------------
+
+void Refiner::InitializeFixedPoint(const HGraphPtr& hgraph,
+                                   const Matrix<float>& upper_block_balance,
+                                   const Matrix<float>& lower_block_balance,
+                                   const Partitions& solution)
+{
+  fixed_point_flag_ = evaluator_->IsFixedPoint();
+  if (fixed_point_flag_ == false) {
+    return;
+  }
+  const int num_hyperedges = hgraph->GetNumHyperedges();
+  fixed_edge_costs_.resize(num_hyperedges);
+  for (int e = 0; e < num_hyperedges; e++) {
+    fixed_edge_costs_[e] = evaluator_->ToFixedPoint(
+        evaluator_->CalculateHyperedgeCost(e, hgraph));
+  }
+  const int num_paths = hgraph->GetNumTimingPaths();
+  fixed_path_costs_.resize(num_paths);
+  for (int path_id = 0; path_id < num_paths; path_id++) {
+    fixed_path_costs_[path_id] = evaluator_->ToFixedPoint(
+        path_wt_factor_ * hgraph->PathTimingCost(path_id));
+  }
+  fixed_snaking_cost_ = evaluator_->ToFixedPoint(snaking_wt_factor_);
+  const int num_vertices = hgraph->GetNumVertices();
+  const int dimensions = hgraph->GetVertexDimensions();
+  fixed_vertex_weights_.resize(static_cast<size_t>(num_vertices) * dimensions);
+  for (int v = 0; v < num_vertices; v++) {
+    const FloatView weights = hgraph->GetVertexWeights(v);
+    for (int dim = 0; dim < dimensions; dim++) {
+      fixed_vertex_weights_[v * dimensions + dim]
+          = evaluator_->ToFixedPoint(weights[dim]);
+    }
+  }
+  fixed_upper_balance_.resize(num_parts_ * dimensions);
+  fixed_lower_balance_.resize(num_parts_ * dimensions);
+  fixed_block_balance_.assign(num_parts_ * dimensions, 0);
+  for (int block_id = 0; block_id < num_parts_; block_id++) {
+    for (int dim = 0; dim < dimensions; dim++) {
+      const int index = block_id * dimensions + dim;
+      fixed_upper_balance_[index]
+          = evaluator_->ToFixedPoint(upper_block_balance[block_id][dim]);
+      fixed_lower_balance_[index]
+          = evaluator_->ToFixedPoint(lower_block_balance[block_id][dim]);
+    }
+  }
+  for (int v = 0; v < num_vertices; v++) {
+    for (int dim = 0; dim < dimensions; dim++) {
+      fixed_block_balance_[solution[v] * dimensions + dim]
+          += fixed_vertex_weights_[v * dimensions + dim];
+    }
+  }
+}
+
+void Refiner::MoveFixedBlockBalance(const HGraphPtr& hgraph,
+                                    const int v,
+                                    const int from_pid,
+                                    const int to_pid) const
+{
+  if (fixed_point_flag_ == false) {
+    return;
+  }
+  const int dimensions = hgraph->GetVertexDimensions();
+  for (int dim = 0; dim < dimensions; dim++) {
+    const int64_t weight = fixed_vertex_weights_[v * dimensions + dim];
+    fixed_block_balance_[from_pid * dimensions + dim] -= weight;
+    fixed_block_balance_[to_pid * dimensions + dim] += weight;
+  }
+}
+
+// The same lexicographic comparisons as CheckVertexMoveLegality<Dimensions>
+bool Refiner::CheckFixedVertexMoveLegality(const HGraphPtr& hgraph,
+                                           const int v,
+                                           const int to_pid,
+                                           const int from_pid) const
+{
+  const int dimensions = hgraph->GetVertexDimensions();
+  auto compare_sum = [&](int block_id, int64_t factor, const auto& bound) {
+    for (int dim = 0; dim < dimensions; dim++) {
+      const int index = block_id * dimensions + dim;
+      const int64_t weight = fixed_vertex_weights_[v * dimensions + dim];
+      const int64_t sum = fixed_block_balance_[index] + factor * weight;
+      if (sum != bound[index]) {
+        return sum < bound[index] ? -1 : 1;
+      }
+    }
+    return 0;
+  };
+  return compare_sum(to_pid, 1, fixed_upper_balance_) <= 0
+         && compare_sum(from_pid, -1, fixed_lower_balance_) >= 0;
+}
+
+// The same comparisons as CheckHyperedgeMoveLegality
+bool Refiner::CheckFixedHyperedgeMoveLegality(const HGraphPtr& hgraph,
+                                              const int e,
+                                              const int to_pid,
+                                              const Partitions& solution) const
+{
+  const int dimensions = hgraph->GetVertexDimensions();
+  std::vector<int64_t> update_block_balance = fixed_block_balance_;
+  for (const int v : hgraph->Vertices(e)) {
+    // check if satisfies the fixed vertices constraint
+    if (hgraph->HasFixedVertices() && hgraph->GetFixedAttr(v) != to_pid) {
+      return false;  // violate the fixed vertices constraint
+    }
+    const int pid = solution[v];
+    if (pid != to_pid) {
+      for (int dim = 0; dim < dimensions; dim++) {
+        const int64_t weight = fixed_vertex_weights_[v * dimensions + dim];
+        update_block_balance[to_pid * dimensions + dim] += weight;
+        update_block_balance[pid * dimensions + dim] -= weight;
+      }
+    }
+  }
+  // a < b if all the dimensions of a are smaller
+  auto less_than = [&](const std::vector<int64_t>& a,
+                       const std::vector<int64_t>& b,
+                       int block_id) {
+    for (int dim = 0; dim < dimensions; dim++) {
+      const int index = block_id * dimensions + dim;
+      if (a[index] >= b[index]) {
+        return false;
+      }
+    }
+    return true;
+  };
+  // Violate the upper bound
+  if (less_than(fixed_upper_balance_, update_block_balance, to_pid)) {
+    return false;
+  }
+  // Violate the lower bound
+  for (int pid = 0; pid < num_parts_; pid++) {
+    if (pid != to_pid
+        && less_than(update_block_balance, fixed_lower_balance_, pid)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+GainValue Refiner::MakeGain(const float score, const int64_t fixed_score) const
+{
+  if (fixed_point_flag_ == true) {
+    return GainValue(evaluator_->FromFixedPoint(fixed_score), fixed_score);
+  }
+  return score;
+}
+
+void Refiner::InitializeBoundary(const HGraphPtr& hgraph,
+                                 const NetDegrees& net_degs) const
+{
+  const int num_vertices = hgraph->GetNumVertices();
+  const int num_hyperedges = hgraph->GetNumHyperedges();
+  edge_span_.assign(num_hyperedges, 0);
+  cut_edges_.clear();
+  cut_edge_pos_.assign(num_hyperedges, -1);
+  num_cut_edges_.assign(num_vertices, 0);
+  boundary_vertices_.clear();
+  boundary_pos_.assign(num_vertices, -1);
+  for (int e = 0; e < num_hyperedges; e++) {
+    edge_span_[e] = net_degs.GetSpan(e);
+    if (edge_span_[e] > 1) {
+      UpdateCutEdge(e, true);
+      for (const int v : hgraph->Vertices(e)) {
+        num_cut_edges_[v]++;
+      }
+    }
+  }
+  for (int v = 0; v < num_vertices; v++) {
+    if (num_cut_edges_[v] > 0) {
+      boundary_pos_[v] = static_cast<int>(boundary_vertices_.size());
+      boundary_vertices_.push_back(v);
+    }
+  }
+  boundary_flag_ = true;
+}
+
+void Refiner::MoveNetDegrees(const HGraphPtr& hgraph,
+                             const int v,
+                             const int from_pid,
+                             const int to_pid,
+                             NetDegrees& net_degs) const
+{
+  // Staying in the same block changes neither the degrees nor the spans.
+  if (from_pid == to_pid) {
+    return;
+  }
+  for (const int he : hgraph->Edges(v)) {
+    --net_degs[he][from_pid];
+    ++net_degs[he][to_pid];
+    if (boundary_flag_ == false) {
+      continue;
+    }
+    const int pre_span = edge_span_[he];
+    int span = pre_span;
+    if (net_degs[he][from_pid] == 0) {
+      span--;
+    }
+    if (net_degs[he][to_pid] == 1) {
+      span++;
+    }
+    edge_span_[he] = span;
+    // the hyperedge becomes a cut hyperedge or is not cut any more
+    if ((pre_span > 1) != (span > 1)) {
+      UpdateCutEdge(he, span > 1);
+      const int delta = (span > 1) ? 1 : -1;
+      for (const int u : hgraph->Vertices(he)) {
+        UpdateNumCutEdges(u, delta);
+      }
+    }
+  }
+}
+
+void Refiner::UpdateNumCutEdges(const int v, const int delta) const
+{
+  const int pre_num_cut_edges = num_cut_edges_[v];
+  num_cut_edges_[v] += delta;
+  if (pre_num_cut_edges == 0 && num_cut_edges_[v] > 0) {
+    boundary_pos_[v] = static_cast<int>(boundary_vertices_.size());
+    boundary_vertices_.push_back(v);
+  } else if (pre_num_cut_edges > 0 && num_cut_edges_[v] == 0) {
+    // remove v by moving the last boundary vertex to its position
+    const int pos = boundary_pos_[v];
+    const int last_v = boundary_vertices_.back();
+    boundary_vertices_[pos] = last_v;
+    boundary_pos_[last_v] = pos;
+    boundary_vertices_.pop_back();
+    boundary_pos_[v] = -1;
+  }
+}
+
+void Refiner::UpdateCutEdge(const int e, const bool cut_flag) const
+{
+  if (cut_flag == true) {
+    cut_edge_pos_[e] = static_cast<int>(cut_edges_.size());
+    cut_edges_.push_back(e);
+    return;
+  }
+  // remove e by moving the last cut hyperedge to its position
+  const int pos = cut_edge_pos_[e];
+  const int last_e = cut_edges_.back();
+  cut_edges_[pos] = last_e;
+  cut_edge_pos_[last_e] = pos;
+  cut_edges_.pop_back();
+  cut_edge_pos_[e] = -1;
+}
+
+void Refiner::StartNeighbors(const HGraphPtr& hgraph) const
+{
+  neighbors_.clear();
+  if (static_cast<int>(neighbor_stamps_.size()) < hgraph->GetNumVertices()) {
+    neighbor_stamps_.resize(hgraph->GetNumVertices(), 0);
+  }
+  if (neighbor_epoch_ == std::numeric_limits<int>::max()) {
+    std::fill(neighbor_stamps_.begin(), neighbor_stamps_.end(), 0);
+    neighbor_epoch_ = 0;
+  }
+  neighbor_epoch_++;
+}
+
+bool Refiner::MarkNeighbor(const int v) const
+{
+  if (neighbor_stamps_[v] == neighbor_epoch_) {
+    return false;
+  }
+  neighbor_stamps_[v] = neighbor_epoch_;
+  return true;
+}
+
 }  // namespace par
@@ -34,11 +34,16 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <set>
 
+#include "Deadline.h"
 #include "Evaluator.h"
 #include "Hypergraph.h"
 #include "PriorityQueue.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
 #include "Utilities.h"
 #include "utl/Logger.h"
 
@@ -47,21 +52,19 @@ namespace par {
 // The algorithms we support
 enum class RefinerChoice
 {
-  GREEDY,         // greedy refinement. try to one entire hyperedge each time
-  FLAT_K_WAY_FM,  // direct k-way FM
-  KPM_FM,         // K-way pair-wise FM
-  ILP_REFINE      // ILP-based partitioning (only for two-way since k-way ILP
-                  // partitioning is too timing-consuming)
+  GREEDY,            // greedy refinement. try to one entire hyperedge each
+                     // time
+  FLAT_K_WAY_FM,     // direct k-way FM
+  KPM_FM,            // K-way pair-wise FM
+  ILP_REFINE,        // ILP-based partitioning (only for two-way since k-way
+                     // ILP partitioning is too timing-consuming)
+  LABEL_PROPAGATION  // parallel size-constrained label propagation
 };
 
-class VertexGain;
-using GainCell = std::shared_ptr<VertexGain>;  // for abbreviation
+using GainCell = VertexGain;  // for abbreviation
 
-class HyperedgeGain;
-using HyperedgeGainPtr = std::shared_ptr<HyperedgeGain>;
-
-// Priority-queue based gain bucket
-using GainBucket = std::shared_ptr<PriorityQueue>;
+// Gain bucket (priority queue or bucket list)
+using GainBucket = std::shared_ptr<GainContainer>;
 using GainBuckets = std::vector<GainBucket>;
 
 // Hyperedge Gain.
@@ -70,29 +73,63 @@ using GainBuckets = std::vector<GainBucket>;
 class HyperedgeGain
 {
  public:
+  HyperedgeGain() = default;
+
   HyperedgeGain(int hyperedge_id,
                 int destination_part,
-                float gain,
-                const std::map<int, float>& path_cost);
+                GainValue gain,
+                PathCost path_cost);
 
-  float GetGain() const { return gain_; }
-  void SetGain(float gain) { gain_ = gain; }
+  float GetGain() const { return gain_.GetValue(); }
+  const GainValue& GetGainValue() const { return gain_; }
+  void SetGain(const GainValue& gain) { gain_ = gain; }
 
   int GetHyperedge() const { return hyperedge_id_; }
 
   int GetDestinationPart() const { return destination_part_; }
 
-  const std::map<int, float>& GetPathCost() const { return path_cost_; }
+  const PathCost& GetPathCost() const { return path_cost_; }
 
  private:
-  const int hyperedge_id_ = -1;
-  const int destination_part_ = -1;  // the destination block id
-  float gain_ = 0.0;
+  int hyperedge_id_ = -1;
+  int destination_part_ = -1;  // the destination block id
+  GainValue gain_;
 
   // The updated DELTA path cost after moving vertex the path_cost
   // will change because we will dynamically update the the weight of
   // the path based on the number of the cut on the path
-  const std::map<int, float> path_cost_;
+  PathCost path_cost_;
+};
+
+// ------------------------------------------------------------------------
+// The adaptive stopping rule of the FM passes (the random walk model of
+// KaHyPar).  The gains of the moves since the last improvement are modeled
+// as a random walk, whose mean mu and variance sigma^2 are updated
+// incrementally.  After p such moves, a new improvement is unlikely if
+// mu < 0 and p * mu^2 > alpha * sigma^2 + beta.
+// ------------------------------------------------------------------------
+class AdaptiveStoppingRule
+{
+ public:
+  // beta is usually ln(number of vertices)
+  AdaptiveStoppingRule(float alpha, float beta) : alpha_(alpha), beta_(beta)
+  {
+  }
+
+  // Start a new random walk after an improvement
+  void Reset();
+
+  // Add the gain of a move which does not improve the best solution
+  void AddGain(float gain);
+
+  bool ShouldStop() const;
+
+ private:
+  const double alpha_ = 1.0;
+  const double beta_ = 0.0;
+  int num_steps_ = 0;
+  double mean_ = 0.0;
+  double sum_squares_ = 0.0;  // sum of the squared deviations from mean_
 };
 
 // ------------------------------------------------------------------------
@@ -113,7 +150,6 @@ class Refiner
           EvaluatorPtr evaluator,
           utl::Logger* logger);
 
-  Refiner(const Refiner&) = delete;
   Refiner(Refiner&) = delete;
   virtual ~Refiner() = default;
 
@@ -123,17 +159,65 @@ class Refiner
               const Matrix<float>& lower_block_balance,
               Partitions& solution);
 
+  // Refine the solution starting from the given connectivity status.
+  // The state is updated together with the solution, so it can be
+  // reused by the following refiners and the evaluator
+  void Refine(const HGraphPtr& hgraph,
+              const Matrix<float>& upper_block_balance,
+              const Matrix<float>& lower_block_balance,
+              Partitions& solution,
+              PartitionState& state);
+
   void SetMaxMove(int max_move);
   void SetRefineIters(int refiner_iters);
 
+  // The gains through the hyperedges with at least lazy_gain_threshold pins
+  // are only updated when a move changes the cut status of the hyperedge,
+  // i.e., when the number of its pins in the source block drops to 1 or 0,
+  // or the number of its pins in the destination block rises to 1 or 2.
+  // 0 means that the neighbors through all the hyperedges are updated.
+  void SetLazyGainThreshold(int lazy_gain_threshold)
+  {
+    lazy_gain_threshold_ = lazy_gain_threshold;
+  }
+
+  // Stop the FM passes with AdaptiveStoppingRule (alpha =
+  // adaptive_stop_alpha) instead of always trying max_move moves.
+  // 0 means disabled.
+  void SetAdaptiveStopAlpha(float adaptive_stop_alpha)
+  {
+    adaptive_stop_alpha_ = adaptive_stop_alpha;
+  }
+
+  // The statistics of the following passes are reported for the level
+  // (the distance to the finest hypergraph) of the multilevel refinement.
+  // -1 means that the passes are not reported per level.
+  void SetRefinementLevel(int level) { refinement_level_ = level; }
+
   void RestoreDefaultParameters();
 
+  // The thread pool is shared by all the refiners.
+  // If no thread pool is set, all the tasks are executed sequentially.
+  void SetThreadPool(ThreadPoolPtr thread_pool);
+
+  // The statistics of each pass are added to the profiler.
+  // If no profiler is set, nothing is recorded.
+  void SetProfiler(ProfilerPtr profiler);
+
+  // The passes stop early when the deadline is expired, and the best
+  // solution found so far is kept.  If no deadline is set, there is no limit.
+  void SetDeadline(DeadlinePtr deadline);
+
  protected:
+  // The refiners can only be copied by Clone() of the derived classes,
+  // which is used to create thread-local refiners
+  Refiner(const Refiner&) = default;
+
   virtual float Pass(const HGraphPtr& hgraph,
                      const Matrix<float>& upper_block_balance,
                      const Matrix<float>& lower_block_balance,
                      Matrix<float>& block_balance,  // the current block balance
-                     Matrix<int>& net_degs,         // the current net degree
+                     NetDegrees& net_degs,          // the current net degree
                      std::vector<float>& paths_cost,  // the current path cost
                      Partitions& solution,
                      std::vector<bool>& visited_vertices_flag)
@@ -148,32 +232,63 @@ class Refiner
                           int v = -1,
                           int to_pid = -1) const;
 
+  // The cost of the path in the fixed-point mode, from the integer costs
+  // quantized at the start of Refine()
+  int64_t CalculateFixedPathCost(int path_id,
+                                 const HGraphPtr& hgraph,
+                                 const Partitions& solution,
+                                 int v = -1,
+                                 int to_pid = -1) const;
+
   // Find all the boundary vertices. The boundary vertices will not include any
-  // fixed vertices
+  // fixed vertices.  The boundary vertices are returned in increasing order.
+  // During Refine(), the boundary is maintained incrementally with the moves,
+  // so only the boundary vertices are checked instead of all the hyperedges.
   std::vector<int> FindBoundaryVertices(
       const HGraphPtr& hgraph,
-      const Matrix<int>& net_degs,
+      const NetDegrees& net_degs,
       const std::vector<bool>& visited_vertices_flag) const;
 
   std::vector<int> FindBoundaryVertices(
       const HGraphPtr& hgraph,
-      const Matrix<int>& net_degs,
+      const NetDegrees& net_degs,
       const std::vector<bool>& visited_vertices_flag,
       const std::vector<int>& solution,
       const std::pair<int, int>& partition_pair) const;
 
-  std::vector<int> FindNeighbors(
+  // Find the max_num_edges cut hyperedges with the smallest ids, in
+  // increasing order.  During Refine(), the cut hyperedges are maintained
+  // incrementally with the moves, so the hyperedges are not scanned.
+  std::vector<int> FindCutHyperedges(const HGraphPtr& hgraph,
+                                     const NetDegrees& net_degs,
+                                     int max_num_edges) const;
+
+  // Return true if hyperedge e spans more than one block
+  bool IsCutHyperedge(int e, const NetDegrees& net_degs) const;
+
+  // Find the unvisited neighbors of the vertex moved by gain_cell in
+  // increasing order, i.e., the vertices whose gains may be changed by the
+  // move.  net_degs are the net degrees after the move.
+  // The neighbors are collected in a scratch array owned by the refiner,
+  // so the returned vector is only valid until the next call.
+  const std::vector<int>& FindNeighbors(
       const HGraphPtr& hgraph,
-      int vertex_id,
+      const GainCell& gain_cell,
+      const NetDegrees& net_degs,
       const std::vector<bool>& visited_vertices_flag) const;
 
-  std::vector<int> FindNeighbors(
+  const std::vector<int>& FindNeighbors(
       const HGraphPtr& hgraph,
-      int vertex_id,
+      const GainCell& gain_cell,
+      const NetDegrees& net_degs,
       const std::vector<bool>& visited_vertices_flag,
       const std::vector<int>& solution,
       const std::pair<int, int>& partition_pair) const;
 
+  // Copy the boundary status and the fixed-point costs from another refiner
+  // working on the same solution, e.g., for the thread-local refiners
+  void CopyRefinementState(const Refiner& refiner);
+
   // Functions related to move a vertex and hyperedge
   // -----------------------------------------------------------
   // The most important function for refinent
@@ -193,17 +308,17 @@ class Refiner
                                const HGraphPtr& hgraph,
                                const std::vector<int>& solution,
                                const std::vector<float>& cur_paths_cost,
-                               const Matrix<int>& net_degs) const;
+                               const NetDegrees& net_degs) const;
 
   // accept the vertex gain
   void AcceptVertexGain(const GainCell& gain_cell,
                         const HGraphPtr& hgraph,
-                        float& total_delta_gain,
+                        GainValue& total_delta_gain,
                         std::vector<bool>& visited_vertices_flag,
                         std::vector<int>& solution,
                         std::vector<float>& cur_paths_cost,
                         Matrix<float>& curr_block_balance,
-                        Matrix<int>& net_degs) const;
+                        NetDegrees& net_degs) const;
 
   // restore the vertex gain
   void RollBackVertexGain(const GainCell& gain_cell,
@@ -212,7 +327,7 @@ class Refiner
                           std::vector<int>& solution,
                           std::vector<float>& cur_paths_cost,
                           Matrix<float>& curr_block_balance,
-                          Matrix<int>& net_degs) const;
+                          NetDegrees& net_degs) const;
 
   // check if we can move the vertex to some block
   bool CheckVertexMoveLegality(int v,         // vertex_id
@@ -223,18 +338,31 @@ class Refiner
                                const Matrix<float>& upper_block_balance,
                                const Matrix<float>& lower_block_balance) const;
 
+  // Dimensions is the number of vertex weight dimensions known at compile
+  // time. Dimensions = 0 means the dimensions are only known at runtime.
+  // The specialization for one-dimensional weights compares plain floats
+  // instead of building temporary vectors.
+  template <int Dimensions>
+  bool CheckVertexMoveLegality(int v,         // vertex_id
+                               int to_pid,    // to block id
+                               int from_pid,  // from block id
+                               const HGraphPtr& hgraph,
+                               const Matrix<float>& curr_block_balance,
+                               const Matrix<float>& upper_block_balance,
+                               const Matrix<float>& lower_block_balance) const;
+
   // Calculate the possible gain of moving a entire hyperedge.
   // We can view the process of moving the vertices in hyperege
   // one by one, then restore the moving sequence to make sure that
   // the current status is not changed. Solution should not be const
   // calculate the possible gain of moving a hyperedge
-  HyperedgeGainPtr CalculateHyperedgeGain(
+  HyperedgeGain CalculateHyperedgeGain(
       int hyperedge_id,
       int to_pid,
       const HGraphPtr& hgraph,
       std::vector<int>& solution,
       const std::vector<float>& cur_paths_cost,
-      const Matrix<int>& net_degs) const;
+      const NetDegrees& net_degs) const;
 
   // check if we can move the hyperegde into some block
   bool CheckHyperedgeMoveLegality(
@@ -247,17 +375,42 @@ class Refiner
       const Matrix<float>& lower_block_balance) const;
 
   // accpet the hyperedge gain
-  void AcceptHyperedgeGain(const HyperedgeGainPtr& hyperedge_gain,
+  void AcceptHyperedgeGain(const HyperedgeGain& hyperedge_gain,
                            const HGraphPtr& hgraph,
-                           float& total_delta_gain,
+                           GainValue& total_delta_gain,
                            std::vector<int>& solution,
                            std::vector<float>& cur_paths_cost,
                            Matrix<float>& cur_block_balance,
-                           Matrix<int>& net_degs) const;
+                           NetDegrees& net_degs) const;
 
   // Note that there is no RollBackHyperedgeGain
   // Because we only use greedy hyperedge refinement
 
+  // Return true if the block balance is within the bounds
+  bool CheckBlockBalance(int block_id,
+                         const Matrix<float>& curr_block_balance,
+                         const Matrix<float>& upper_block_balance,
+                         const Matrix<float>& lower_block_balance) const;
+
+  // Add the statistics of one pass to the profiler (if any).
+  // The operations of the gain buckets are collected and reset.
+  void RecordPass(int moves_attempted,
+                  int moves_accepted,
+                  int64_t gain_updates,
+                  const GainBuckets& buckets) const;
+
+  // Add the moves saved by the adaptive stopping rule to the profiler
+  void RecordSavedMoves(int num_saved_moves) const;
+
+  // Return true if the deadline is expired.  It is called in the move loops,
+  // so the clock is only read once every time_check_interval_ moves
+  bool CheckDeadline(int num_moves) const;
+
+  // The thread pool for tasks handling workload vertices each, or nullptr
+  // for small workloads.  They are executed inline, since synchronizing
+  // the workers costs more than the work itself.
+  ThreadPool* GetThreadPool(int workload) const;
+
   // user specified parameters
   const int num_parts_ = 2;  // number of blocks in the partitioning
   int refiner_iters_ = 2;    // number of refinement iterations
@@ -274,14 +427,138 @@ class Refiner
   // the maxinum number of vertices can be moved in each pass
   int max_move_ = 50;
 
+  // the minimum size of the hyperedges with lazy gain updates (0 = disabled)
+  int lazy_gain_threshold_ = 0;
+
+  // alpha of the adaptive stopping rule of FM passes (0 = disabled)
+  float adaptive_stop_alpha_ = 0.0;
+
+  // the level of the multilevel refinement (-1 = none), for profiling
+  int refinement_level_ = -1;
+
   // default parameters
   // during partitioning, we may need to update the value
   // of refiner_iters_ and max_move_ for the coarsest hypergraphs
   const int refiner_iters_default_ = 2;
   const int max_move_default_ = 50;
 
+  // the minimum workload for running tasks on the thread pool
+  const int parallel_workload_threshold_ = 32;
+
+  // the number of moves between two checks of the deadline
+  static constexpr int time_check_interval_ = 64;
+
   utl::Logger* logger_ = nullptr;
   EvaluatorPtr evaluator_ = nullptr;
+  ThreadPoolPtr thread_pool_ = nullptr;
+  ProfilerPtr profiler_ = nullptr;
+  DeadlinePtr deadline_ = nullptr;
+
+ private:
+  // Build the boundary status from the net degrees
+  void InitializeBoundary(const HGraphPtr& hgraph,
+                          const NetDegrees& net_degs) const;
+
+  // Move vertex v from from_pid to to_pid in the net degrees,
+  // and update the boundary status if it is maintained
+  void MoveNetDegrees(const HGraphPtr& hgraph,
+                      int v,
+                      int from_pid,
+                      int to_pid,
+                      NetDegrees& net_degs) const;
+
+  // add delta to the number of cut hyperedges of v
+  void UpdateNumCutEdges(int v, int delta) const;
+
+  // Quantize the costs, the vertex weights and the block balances in the
+  // fixed-point mode
+  void InitializeFixedPoint(const HGraphPtr& hgraph,
+                            const Matrix<float>& upper_block_balance,
+                            const Matrix<float>& lower_block_balance,
+                            const Partitions& solution);
+
+  // Move the weight of vertex v from from_pid to to_pid in the fixed-point
+  // block balance
+  void MoveFixedBlockBalance(const HGraphPtr& hgraph,
+                             int v,
+                             int from_pid,
+                             int to_pid) const;
+
+  // CheckVertexMoveLegality on the fixed-point block balance
+  bool CheckFixedVertexMoveLegality(const HGraphPtr& hgraph,
+                                    int v,
+                                    int to_pid,
+                                    int from_pid) const;
+
+  // CheckHyperedgeMoveLegality on the fixed-point block balance
+  bool CheckFixedHyperedgeMoveLegality(const HGraphPtr& hgraph,
+                                       int e,
+                                       int to_pid,
+                                       const Partitions& solution) const;
+
+  // the gain of the cut and path costs in the current mode
+  GainValue MakeGain(float score, int64_t fixed_score) const;
+
+  // add e to (cut_flag = true) or remove e from the cut hyperedges
+  void UpdateCutEdge(int e, bool cut_flag) const;
+
+  // Start a new round of collecting the neighbors
+  void StartNeighbors(const HGraphPtr& hgraph) const;
+
+  // Return false if the gains through hyperedge e are not changed by moving
+  // one of its pins from from_pid to to_pid, and e is large enough for the
+  // lazy gain updates.  net_degs are the net degrees after the move
+  bool IsGainAffected(const HGraphPtr& hgraph,
+                      int e,
+                      int from_pid,
+                      int to_pid,
+                      const NetDegrees& net_degs) const;
+
+  // Mark v in the scratch array for collecting the neighbors.
+  // Return false if v has been marked in the current round
+  bool MarkNeighbor(int v) const;
+
+  // The boundary status is only maintained during Refine().
+  // edge_span_[e] is the number of blocks spanned by hyperedge e, and
+  // cut_edges_ contains all the hyperedges spanning more than one block
+  // (cut_edge_pos_[e] is the position of e in cut_edges_, -1 if e is not
+  // cut).
+  // num_cut_edges_[v] is the number of hyperedges of v spanning more than
+  // one block, and boundary_vertices_ contains all the vertices with
+  // num_cut_edges_[v] > 0 (boundary_pos_[v] is the position of v in
+  // boundary_vertices_, -1 if v is not a boundary vertex).
+  // The refiner is used by one thread at a time (see Clone() of the derived
+  // classes), so the scratch arrays can be updated by the const functions.
+  mutable bool boundary_flag_ = false;
+  mutable std::vector<int> edge_span_;
+  mutable std::vector<int> cut_edges_;
+  mutable std::vector<int> cut_edge_pos_;
+  mutable std::vector<int> num_cut_edges_;
+  mutable std::vector<int> boundary_vertices_;
+  mutable std::vector<int> boundary_pos_;
+
+  // the epoch-stamped scratch array for collecting the neighbors, i.e.,
+  // v has been collected if neighbor_stamps_[v] == neighbor_epoch_
+  mutable std::vector<int> neighbor_stamps_;
+  mutable int neighbor_epoch_ = 0;
+  mutable std::vector<int> neighbors_;
+
+  // The fixed-point mode (see GoldenEvaluator::SetFixedPointBits) is only
+  // used during Refine().  The costs and the weights are quantized to
+  // integers in units of 2^-fixed_point_bits at the start of Refine(),
+  // since the timing costs and the hypergraph change between the calls.
+  // fixed_path_costs_[path_id] is the cost of cutting the path once.
+  // The vertex weights and the block balances are flattened, e.g.,
+  // fixed_vertex_weights_[v * vertex_dimensions + dim], and
+  // fixed_block_balance_ is updated with the moves.
+  bool fixed_point_flag_ = false;
+  std::vector<int64_t> fixed_edge_costs_;
+  std::vector<int64_t> fixed_path_costs_;
+  int64_t fixed_snaking_cost_ = 0;
+  std::vector<int64_t> fixed_vertex_weights_;
+  std::vector<int64_t> fixed_upper_balance_;
+  std::vector<int64_t> fixed_lower_balance_;
+  mutable std::vector<int64_t> fixed_block_balance_;
 };
 
 }  // namespace par
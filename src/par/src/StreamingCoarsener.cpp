@@ -0,0 +1,628 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include "StreamingCoarsener.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <utility>
+
+#include "Utilities.h"
+#include "utl/Logger.h"
+
+namespace par {
+
+using utl::PAR;
+
+namespace {
+
+// Read the elements of an array in the binary file sequentially,
+// block by block
+template <typename T>
+class SequentialReader
+{
+ public:
+  bool Open(const std::string& file_name, size_t offset, size_t size)
+  {
+    offset_ = offset;
+    size_ = size;
+    if (reader_.Open(file_name, true) == false) {
+      return false;
+    }
+    Rewind();
+    return true;
+  }
+
+  void Rewind()
+  {
+    reader_.Seek(offset_);
+    remaining_ = size_;
+    block_.clear();
+    pos_ = 0;
+  }
+
+  bool Next(T& value)
+  {
+    if (pos_ == block_.size()) {
+      const size_t size = std::min(remaining_, block_size_);
+      if (size == 0 || reader_.Read(block_, size) == false) {
+        return false;
+      }
+      remaining_ -= size;
+      pos_ = 0;
+    }
+    value = block_[pos_++];
+    return true;
+  }
+
+ private:
+  const size_t block_size_ = 1 << 16;
+  BinaryFileReader reader_;
+  size_t offset_ = 0;
+  size_t size_ = 0;
+  size_t remaining_ = 0;
+  std::vector<T> block_;
+  size_t pos_ = 0;
+};
+
+// The hyperedges of a hypergraph file, read one by one.
+// The vertex weights and the attributes of the vertices are kept in memory
+class HyperedgeStream
+{
+ public:
+  HyperedgeStream(const std::string& file_name,
+                  int vertex_dimensions,
+                  int hyperedge_dimensions,
+                  size_t chunk_size,
+                  utl::Logger* logger)
+      : file_name_(file_name),
+        vertex_dimensions_(vertex_dimensions),
+        hyperedge_dimensions_(hyperedge_dimensions),
+        chunk_size_(chunk_size),
+        logger_(logger)
+  {
+    binary_ = IsBinaryHypergraphFile(file_name_);
+    if (binary_ == true) {
+      OpenBinary();
+    } else {
+      OpenText();
+    }
+  }
+
+  // Move back to the first hyperedge
+  void Rewind();
+
+  // Read the next hyperedge. Return false after the last hyperedge
+  bool Next(std::vector<int>& vertices, std::vector<float>& weights);
+
+  int GetNumVertices() const { return num_vertices_; }
+  int GetNumHyperedges() const { return num_hyperedges_; }
+  int GetVertexDimensions() const { return vertex_dimensions_; }
+  int GetHyperedgeDimensions() const { return hyperedge_dimensions_; }
+  // the weights of vertex v are
+  // vertex_weights[v * vertex_dimensions], ...
+  const std::vector<float>& GetVertexWeights() const
+  {
+    return vertex_weights_;
+  }
+  std::vector<int>& GetFixedAttr() { return fixed_attr_; }
+  std::vector<int>& GetCommunityAttr() { return community_attr_; }
+
+ private:
+  void OpenText();
+  void OpenBinary();
+  void InvalidFile() const
+  {
+    logger_->error(
+        PAR, 2528, "Invalid binary hypergraph file : {}", file_name_);
+  }
+
+  const std::string file_name_;
+  int vertex_dimensions_ = 1;
+  int hyperedge_dimensions_ = 1;
+  const size_t chunk_size_ = 0;
+  utl::Logger* logger_ = nullptr;
+  bool binary_ = false;
+  int num_vertices_ = 0;
+  int num_hyperedges_ = 0;
+  int next_hyperedge_ = 0;
+  std::vector<float> vertex_weights_;
+  std::vector<int> fixed_attr_;
+  std::vector<int> community_attr_;
+  // hMETIS format
+  TextFileReader text_reader_;
+  bool hyperedge_weight_flag_ = false;
+  // binary format.  The version 1 files store the offsets as int
+  bool int_offsets_ = false;
+  SequentialReader<int> eptr_int_reader_;
+  SequentialReader<CsrOffset> eptr_reader_;
+  SequentialReader<int> eind_reader_;
+  SequentialReader<float> hyperedge_weight_reader_;
+  CsrOffset eptr_end_ = 0;
+};
+
+void HyperedgeStream::OpenText()
+{
+  if (text_reader_.Open(file_name_, chunk_size_) == false) {
+    logger_->error(
+        PAR, 2526, "Can not open the input hypergraph file : {}", file_name_);
+  }
+  // the number of hyperedges, the number of vertices and the weight flag
+  text_reader_.NextLine();
+  std::vector<int> stats;
+  int value = 0;
+  while (text_reader_.NextInt(value)) {
+    stats.push_back(value);
+  }
+  if (stats.size() < 2) {
+    logger_->error(
+        PAR, 2517, "Invalid hypergraph file header : {}", file_name_);
+  }
+  num_hyperedges_ = stats[0];
+  num_vertices_ = stats[1];
+  bool vertex_weight_flag = false;
+  if (stats.size() == 3) {
+    hyperedge_weight_flag_ = (stats[2] % 10) == 1;
+    vertex_weight_flag = stats[2] >= 10;
+  }
+
+  // skip the hyperedges to read the vertex weights, which follow them
+  for (int e = 0; e < num_hyperedges_; e++) {
+    text_reader_.NextLine();
+  }
+  vertex_weights_.assign(
+      static_cast<size_t>(num_vertices_) * vertex_dimensions_, 1.0);
+  if (vertex_weight_flag == true) {
+    for (int v = 0; v < num_vertices_; v++) {
+      text_reader_.NextLine();
+      float weight = 0.0;
+      for (int d = 0; d < vertex_dimensions_ && text_reader_.NextFloat(weight);
+           d++) {
+        vertex_weights_[static_cast<size_t>(v) * vertex_dimensions_ + d]
+            = weight;
+      }
+    }
+  }
+  Rewind();
+}
+
+void HyperedgeStream::OpenBinary()
+{
+  BinaryFileReader header_reader;
+  if (header_reader.Open(file_name_, true) == false) {
+    logger_->error(
+        PAR, 2527, "Can not open the input hypergraph file : {}", file_name_);
+  }
+  // the layout is described in GoldenEvaluator::WriteBinaryHypergraph
+  std::vector<char> magic;
+  std::vector<int> header;
+  header_reader.Read(magic, binary_hypergraph_magic.size());
+  if (header_reader.Read(header, 10) == false || header[0] < 1
+      || header[0] > binary_hypergraph_version) {
+    InvalidFile();
+  }
+  num_vertices_ = header[1];
+  num_hyperedges_ = header[2];
+  vertex_dimensions_ = header[3];
+  hyperedge_dimensions_ = header[4];
+  const int placement_dimensions = header[5];
+  const bool fixed_flag = header[6] != 0;
+  const bool community_flag = header[7] != 0;
+  if (num_vertices_ < 0 || num_hyperedges_ < 0 || vertex_dimensions_ <= 0
+      || hyperedge_dimensions_ <= 0 || placement_dimensions < 0) {
+    InvalidFile();
+  }
+  int_offsets_ = header[0] == 1;
+
+  // the offsets of the arrays in the file
+  const size_t num_vertices = num_vertices_;
+  const size_t num_hyperedges = num_hyperedges_;
+  const size_t eptr_offset
+      = binary_hypergraph_magic.size() + header.size() * sizeof(int);
+  const size_t offset_size = int_offsets_ ? sizeof(int) : sizeof(CsrOffset);
+  header_reader.Seek(eptr_offset + num_hyperedges * offset_size);
+  if (int_offsets_ == true) {
+    std::vector<int> eptr_end;
+    if (header_reader.Read(eptr_end, 1) == false) {
+      InvalidFile();
+    }
+    eptr_end_ = eptr_end.front();
+  } else {
+    std::vector<CsrOffset> eptr_end;
+    if (header_reader.Read(eptr_end, 1) == false) {
+      InvalidFile();
+    }
+    eptr_end_ = eptr_end.front();
+  }
+  if (eptr_end_ < 0) {
+    InvalidFile();
+  }
+  const size_t eind_offset = eptr_offset + (num_hyperedges + 1) * offset_size;
+  const size_t vertex_weight_offset
+      = eind_offset + static_cast<size_t>(eptr_end_) * sizeof(int);
+  const size_t num_vertex_weights = num_vertices * vertex_dimensions_;
+  const size_t hyperedge_weight_offset
+      = vertex_weight_offset + num_vertex_weights * sizeof(float);
+  const size_t num_hyperedge_weights = num_hyperedges * hyperedge_dimensions_;
+  const size_t fixed_offset
+      = hyperedge_weight_offset + num_hyperedge_weights * sizeof(float);
+  const size_t community_offset
+      = fixed_offset + (fixed_flag ? num_vertices * sizeof(int) : 0);
+
+  // the per-vertex arrays are loaded
+  header_reader.Seek(vertex_weight_offset);
+  if (header_reader.Read(vertex_weights_, num_vertex_weights) == false) {
+    InvalidFile();
+  }
+  header_reader.Seek(fixed_offset);
+  if (fixed_flag == true
+      && header_reader.Read(fixed_attr_, num_vertices) == false) {
+    InvalidFile();
+  }
+  header_reader.Seek(community_offset);
+  if (community_flag == true
+      && header_reader.Read(community_attr_, num_vertices) == false) {
+    InvalidFile();
+  }
+
+  // the hyperedges are streamed
+  const size_t num_offsets = num_hyperedges + 1;
+  const bool valid
+      = (int_offsets_
+             ? eptr_int_reader_.Open(file_name_, eptr_offset, num_offsets)
+             : eptr_reader_.Open(file_name_, eptr_offset, num_offsets))
+        && eind_reader_.Open(file_name_, eind_offset, eptr_end_)
+        && hyperedge_weight_reader_.Open(
+            file_name_, hyperedge_weight_offset, num_hyperedge_weights);
+  if (valid == false) {
+    InvalidFile();
+  }
+  Rewind();
+}
+
+void HyperedgeStream::Rewind()
+{
+  next_hyperedge_ = 0;
+  if (binary_ == false) {
+    // reopen the file and skip the header line
+    text_reader_.Open(file_name_, chunk_size_);
+    text_reader_.NextLine();
+    return;
+  }
+  eptr_int_reader_.Rewind();
+  eptr_reader_.Rewind();
+  eind_reader_.Rewind();
+  hyperedge_weight_reader_.Rewind();
+  // skip eptr[0], which is always 0
+  int int_offset = 0;
+  CsrOffset offset = 0;
+  if (int_offsets_ == true) {
+    eptr_int_reader_.Next(int_offset);
+  } else {
+    eptr_reader_.Next(offset);
+  }
+  eptr_end_ = 0;
+}
+
+bool HyperedgeStream::Next(std::vector<int>& vertices,
+                           std::vector<float>& weights)
+{
+  if (next_hyperedge_ >= num_hyperedges_) {
+    return false;
+  }
+  next_hyperedge_++;
+  vertices.clear();
+  weights.assign(hyperedge_dimensions_, 1.0);
+  if (binary_ == false) {
+    text_reader_.NextLine();
+    if (hyperedge_weight_flag_ == true) {
+      float weight = 0.0;
+      for (int d = 0;
+           d < hyperedge_dimensions_ && text_reader_.NextFloat(weight);
+           d++) {
+        weights[d] = weight;
+      }
+    }
+    int value = 0;
+    while (text_reader_.NextInt(value)) {
+      // the vertex id starts from 1 in the hypergraph file
+      if (value < 1 || value > num_vertices_) {
+        logger_->error(PAR,
+                       2518,
+                       "Invalid vertex {} of hyperedge {} in the hypergraph "
+                       "file : {}",
+                       value,
+                       next_hyperedge_,
+                       file_name_);
+      }
+      vertices.push_back(value - 1);
+    }
+    return true;
+  }
+
+  // binary format: eptr_end_ is the end of the previous hyperedge
+  int int_offset = 0;
+  CsrOffset offset = 0;
+  if (int_offsets_ == true) {
+    if (eptr_int_reader_.Next(int_offset) == false) {
+      InvalidFile();
+    }
+    offset = int_offset;
+  } else if (eptr_reader_.Next(offset) == false) {
+    InvalidFile();
+  }
+  for (CsrOffset i = eptr_end_; i < offset; i++) {
+    int vertex = 0;
+    if (eind_reader_.Next(vertex) == false || vertex < 0
+        || vertex >= num_vertices_) {
+      InvalidFile();
+    }
+    vertices.push_back(vertex);
+  }
+  eptr_end_ = offset;
+  for (float& weight : weights) {
+    if (hyperedge_weight_reader_.Next(weight) == false) {
+      InvalidFile();
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+StreamingCoarsener::StreamingCoarsener(float coarsening_ratio,
+                                       int max_hyperedge_size,
+                                       size_t chunk_size,
+                                       utl::Logger* logger)
+    : coarsening_ratio_(coarsening_ratio),
+      max_hyperedge_size_(max_hyperedge_size),
+      chunk_size_(chunk_size),
+      logger_(logger)
+{
+}
+
+HGraphPtr StreamingCoarsener::Coarsen(const std::string& hypergraph_file,
+                                      int vertex_dimensions,
+                                      int hyperedge_dimensions,
+                                      std::vector<int> fixed_attr,
+                                      std::vector<int> community_attr,
+                                      const std::string& cluster_map_file,
+                                      int& num_vertices) const
+{
+  HyperedgeStream stream(hypergraph_file,
+                         vertex_dimensions,
+                         hyperedge_dimensions,
+                         chunk_size_,
+                         logger_);
+  num_vertices = stream.GetNumVertices();
+  vertex_dimensions = stream.GetVertexDimensions();
+  hyperedge_dimensions = stream.GetHyperedgeDimensions();
+  // the attributes of the binary file are used if no file is given
+  if (fixed_attr.empty()) {
+    fixed_attr = std::move(stream.GetFixedAttr());
+  }
+  if (community_attr.empty()) {
+    community_attr = std::move(stream.GetCommunityAttr());
+  }
+  const std::vector<float>& vertex_weights = stream.GetVertexWeights();
+  auto lambda_weights = [&](auto& weights, int v) {
+    return weights.begin() + static_cast<size_t>(v) * vertex_dimensions;
+  };
+
+  // Pass 1: cluster the vertices.
+  // cluster[v] is the representative vertex of the cluster of v
+  std::vector<int> cluster(num_vertices);
+  std::iota(cluster.begin(), cluster.end(), 0);
+  std::vector<int> cluster_size(num_vertices, 1);
+  std::vector<float> cluster_weights = vertex_weights;
+  std::vector<float> max_cluster_weights(vertex_dimensions, 0.0);
+  for (int v = 0; v < num_vertices; v++) {
+    auto weights = lambda_weights(vertex_weights, v);
+    for (int d = 0; d < vertex_dimensions; d++) {
+      max_cluster_weights[d] += weights[d];
+    }
+  }
+  for (float& weight : max_cluster_weights) {
+    weight *= max_cluster_weight_factor_ * coarsening_ratio_
+              / std::max(num_vertices, 1);
+  }
+  auto lambda_compatible = [&](int u, int target) {
+    if (!fixed_attr.empty() && fixed_attr[u] != fixed_attr[target]) {
+      return false;
+    }
+    if (!community_attr.empty()
+        && community_attr[u] != community_attr[target]) {
+      return false;
+    }
+    auto u_weights = lambda_weights(cluster_weights, u);
+    auto target_weights = lambda_weights(cluster_weights, target);
+    for (int d = 0; d < vertex_dimensions; d++) {
+      if (u_weights[d] + target_weights[d] > max_cluster_weights[d]) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  const int target_num_clusters = std::max(
+      1, static_cast<int>(std::ceil(num_vertices / coarsening_ratio_)));
+  int num_clusters = num_vertices;
+  std::vector<int> vertices;
+  std::vector<float> hyperedge_weights;
+  while (num_clusters > target_num_clusters
+         && stream.Next(vertices, hyperedge_weights)) {
+    if (vertices.size() < 2
+        || static_cast<int>(vertices.size()) > max_hyperedge_size_) {
+      continue;
+    }
+    // the singleton vertices join the cluster of the first vertex
+    const int target = cluster[vertices.front()];
+    for (const int u : vertices) {
+      if (u == target || cluster[u] != u || cluster_size[u] > 1
+          || lambda_compatible(u, target) == false) {
+        continue;
+      }
+      cluster[u] = target;
+      cluster_size[target]++;
+      auto u_weights = lambda_weights(cluster_weights, u);
+      auto target_weights = lambda_weights(cluster_weights, target);
+      for (int d = 0; d < vertex_dimensions; d++) {
+        target_weights[d] += u_weights[d];
+      }
+      if (--num_clusters <= target_num_clusters) {
+        break;
+      }
+    }
+  }
+  cluster_size.clear();
+  cluster_size.shrink_to_fit();
+
+  // number the clusters in the order of their first vertices,
+  // then cluster[v] is the coarse vertex of v
+  std::vector<int> coarse_id(num_vertices, -1);
+  num_clusters = 0;
+  for (int v = 0; v < num_vertices; v++) {
+    int& id = coarse_id[cluster[v]];
+    if (id < 0) {
+      id = num_clusters++;
+    }
+    cluster[v] = id;
+  }
+  coarse_id.clear();
+  coarse_id.shrink_to_fit();
+
+  std::ofstream cluster_map_output(cluster_map_file, std::ios::binary);
+  cluster_map_output.write(reinterpret_cast<const char*>(cluster.data()),
+                           cluster.size() * sizeof(int));
+  cluster_map_output.close();
+  if (!cluster_map_output) {
+    logger_->error(
+        PAR, 2522, "Can not write the cluster map file : {}", cluster_map_file);
+  }
+
+  // the weights and the attributes of the coarse vertices
+  Matrix<float> coarse_vertex_weights(
+      num_clusters, std::vector<float>(vertex_dimensions, 0.0));
+  std::vector<int> coarse_fixed_attr(fixed_attr.empty() ? 0 : num_clusters);
+  std::vector<int> coarse_community_attr(community_attr.empty() ? 0
+                                                                : num_clusters);
+  for (int v = 0; v < num_vertices; v++) {
+    const int c = cluster[v];
+    auto weights = lambda_weights(vertex_weights, v);
+    for (int d = 0; d < vertex_dimensions; d++) {
+      coarse_vertex_weights[c][d] += weights[d];
+    }
+    if (!fixed_attr.empty()) {
+      coarse_fixed_attr[c] = fixed_attr[v];
+    }
+    if (!community_attr.empty()) {
+      coarse_community_attr[c] = community_attr[v];
+    }
+  }
+  logger_->report(
+      "[STREAMING] Pass 1 :: num_vertices = {}, num_clusters = {}",
+      num_vertices,
+      num_clusters);
+
+  // Pass 2: build the coarse hyperedges.
+  // The hyperedges within a cluster are removed
+  std::vector<CsrOffset> eptr{0};
+  std::vector<int> eind;
+  Matrix<float> coarse_hyperedge_weights;
+  stream.Rewind();
+  while (stream.Next(vertices, hyperedge_weights)) {
+    for (int& v : vertices) {
+      v = cluster[v];
+    }
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()),
+                   vertices.end());
+    if (vertices.size() < 2) {
+      continue;
+    }
+    eind.insert(eind.end(), vertices.begin(), vertices.end());
+    eptr.push_back(static_cast<CsrOffset>(eind.size()));
+    coarse_hyperedge_weights.push_back(hyperedge_weights);
+  }
+  logger_->report(
+      "[STREAMING] Pass 2 :: num_hyperedges = {}, num_coarse_hyperedges = {}",
+      stream.GetNumHyperedges(),
+      coarse_hyperedge_weights.size());
+
+  return std::make_shared<Hypergraph>(vertex_dimensions,
+                                      hyperedge_dimensions,
+                                      0,
+                                      std::move(eptr),
+                                      std::move(eind),
+                                      coarse_vertex_weights,
+                                      coarse_hyperedge_weights,
+                                      coarse_fixed_attr,
+                                      coarse_community_attr,
+                                      Matrix<float>(),
+                                      logger_);
+}
+
+void StreamingCoarsener::ProjectSolution(const std::string& cluster_map_file,
+                                         const std::vector<int>& solution,
+                                         const std::string& solution_file) const
+{
+  SequentialReader<int> cluster_map;
+  std::ifstream cluster_map_input(cluster_map_file,
+                                  std::ios::binary | std::ios::ate);
+  if (!cluster_map_input.is_open()) {
+    logger_->error(
+        PAR, 2519, "Can not open the cluster map file : {}", cluster_map_file);
+  }
+  const size_t num_vertices
+      = static_cast<size_t>(cluster_map_input.tellg()) / sizeof(int);
+  cluster_map_input.close();
+  cluster_map.Open(cluster_map_file, 0, num_vertices);
+
+  std::ofstream solution_file_output(solution_file);
+  int cluster = 0;
+  while (cluster_map.Next(cluster)) {
+    if (cluster < 0 || cluster >= static_cast<int>(solution.size())) {
+      logger_->error(
+          PAR, 2520, "Invalid cluster map file : {}", cluster_map_file);
+    }
+    solution_file_output << solution[cluster] << '\n';
+  }
+  solution_file_output.close();
+  std::remove(cluster_map_file.c_str());
+}
+
+}  // namespace par
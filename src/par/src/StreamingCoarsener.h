@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+// High-level description
+// Out-of-core coarsening for hypergraphs that do not fit in memory.
+// The hypergraph file (hMETIS or binary format) is read in chunks, and only
+// the per-vertex arrays (weights, attributes and the cluster of each vertex)
+// are kept in memory.  The first pass clusters the vertices greedily: each
+// hyperedge merges its singleton vertices into the cluster of its first
+// vertex, subject to the same fixed block, the same community and a cluster
+// weight limit.  The second pass builds the hyperedges of the coarse
+// hypergraph, which is the only level materialized in memory.  The cluster
+// of each original vertex is written to a file, which is used to project
+// the partitioning solution of the coarse hypergraph back to the original
+// vertices.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Hypergraph.h"
+
+namespace utl {
+class Logger;
+}
+
+namespace par {
+
+class StreamingCoarsener
+{
+ public:
+  // coarsening_ratio is the target ratio between the number of vertices
+  // and the number of clusters.  The hyperedges with more than
+  // max_hyperedge_size vertices are not used for clustering.
+  // chunk_size is the number of bytes read from the file at once.
+  StreamingCoarsener(float coarsening_ratio,
+                     int max_hyperedge_size,
+                     size_t chunk_size,
+                     utl::Logger* logger);
+
+  // Coarsen the hypergraph in hypergraph_file and write the cluster of each
+  // vertex into cluster_map_file.  The dimensions are only used for the
+  // hMETIS format (the binary format stores them).  fixed_attr and
+  // community_attr are either empty or have one element per vertex; if they
+  // are empty, the attributes of the binary file are used.
+  // num_vertices is set to the number of vertices of the original hypergraph
+  HGraphPtr Coarsen(const std::string& hypergraph_file,
+                    int vertex_dimensions,
+                    int hyperedge_dimensions,
+                    std::vector<int> fixed_attr,
+                    std::vector<int> community_attr,
+                    const std::string& cluster_map_file,
+                    int& num_vertices) const;
+
+  // Write the block of each original vertex in hMETIS format, where
+  // solution is the partitioning solution of the coarse hypergraph
+  void ProjectSolution(const std::string& cluster_map_file,
+                       const std::vector<int>& solution,
+                       const std::string& solution_file) const;
+
+ private:
+  const float coarsening_ratio_ = 10.0;
+  const int max_hyperedge_size_ = 50;
+  const size_t chunk_size_ = 1 << 24;
+  // a cluster is heavier than the average cluster by at most this factor
+  const float max_cluster_weight_factor_ = 2.0;
+  utl::Logger* logger_ = nullptr;
+};
+
+}  // namespace par
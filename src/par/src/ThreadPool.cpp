@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace par {
+
+ThreadPool::ThreadPool(int num_threads) : pool_(utl::ThreadPool::global())
+{
+  num_threads_ = pool_->getThreadCount();
+  if (num_threads > 0) {
+    num_threads_ = std::min(num_threads, num_threads_);
+  }
+}
+
+void ThreadPool::ParallelFor(const int num_tasks,
+                             const std::function<void(int)>& task)
+{
+  pool_->parallelFor(num_tasks, task, utl::PAR, num_threads_);
+}
+
+void ParallelForChunks(ThreadPool* thread_pool,
+                       const int num_items,
+                       const int min_num_items,
+                       const std::function<void(int, int)>& task)
+{
+  if (thread_pool == nullptr || num_items < min_num_items) {
+    task(0, num_items);
+    return;
+  }
+  // a few chunks per thread to balance the workload
+  const int num_tasks = std::max(1, thread_pool->GetNumThreads()) * 4;
+  const int chunk_size = (num_items + num_tasks - 1) / num_tasks;
+  thread_pool->ParallelFor(num_tasks, [&](int task_id) {
+    const int begin = task_id * chunk_size;
+    const int end = std::min(begin + chunk_size, num_items);
+    if (begin < end) {
+      task(begin, end);
+    }
+  });
+}
+
+}  // namespace par
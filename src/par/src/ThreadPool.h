@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "utl/ThreadPool.h"
+
+namespace par {
+
+class ThreadPool;
+using ThreadPoolPtr = std::shared_ptr<ThreadPool>;
+
+// --------------------------------------------------------------------------
+// The refiners' handle on the work-stealing pool shared by all the tools
+// (utl::ThreadPool::global()).  It only limits how many threads a
+// ParallelFor may use, so several partitioners running at once share the
+// machine instead of each starting its own threads.
+// --------------------------------------------------------------------------
+class ThreadPool
+{
+ public:
+  // num_threads <= 0 means all the threads of the shared pool
+  explicit ThreadPool(int num_threads = 0);
+
+  // the number of threads helping the calling thread
+  int GetNumThreads() const { return num_threads_ - 1; }
+
+  // Run task(0), task(1), ..., task(num_tasks - 1) and wait for all of them
+  // to finish (barrier). The first exception raised by a task is rethrown
+  // in the calling thread.
+  void ParallelFor(int num_tasks, const std::function<void(int)>& task);
+
+ private:
+  std::shared_ptr<utl::ThreadPool> pool_;
+  int num_threads_ = 1;
+};
+
+// Run task(begin, end) on contiguous chunks of [0, num_items) in parallel.
+// The items are processed serially in the calling thread if thread_pool is
+// nullptr or there are less than min_num_items items
+void ParallelForChunks(ThreadPool* thread_pool,
+                       int num_items,
+                       int min_num_items,
+                       const std::function<void(int, int)>& task);
+
+}  // namespace par
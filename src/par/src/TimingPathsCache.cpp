@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "TimingPathsCache.h"
+
+namespace par {
+
+bool TimingPathsCache::IsValid(odb::dbBlock* block, int top_n) const
+{
+  return valid_ == true && block_ == block && top_n_ == top_n;
+}
+
+void TimingPathsCache::Update(
+    odb::dbBlock* block,
+    int top_n,
+    std::vector<StaTimingPath> timing_paths,
+    std::vector<std::pair<odb::dbNet*, float>> net_slacks)
+{
+  if (block_ != block) {
+    removeOwner();
+    addOwner(block);
+    block_ = block;
+  }
+  top_n_ = top_n;
+  timing_paths_ = std::move(timing_paths);
+  net_slacks_ = std::move(net_slacks);
+  valid_ = true;
+}
+
+void TimingPathsCache::Invalidate()
+{
+  valid_ = false;
+  timing_paths_.clear();
+  net_slacks_.clear();
+}
+
+void TimingPathsCache::inDbInstCreate(odb::dbInst* inst)
+{
+  Invalidate();
+}
+
+void TimingPathsCache::inDbInstCreate(odb::dbInst* inst, odb::dbRegion* region)
+{
+  Invalidate();
+}
+
+void TimingPathsCache::inDbInstDestroy(odb::dbInst* inst)
+{
+  Invalidate();
+}
+
+void TimingPathsCache::inDbInstSwapMasterAfter(odb::dbInst* inst)
+{
+  Invalidate();
+}
+
+// The wire parasitics (and the slacks) depend on the placement
+void TimingPathsCache::inDbPostMoveInst(odb::dbInst* inst)
+{
+  Invalidate();
+}
+
+void TimingPathsCache::inDbNetCreate(odb::dbNet* net)
+{
+  Invalidate();
+}
+
+void TimingPathsCache::inDbNetDestroy(odb::dbNet* net)
+{
+  Invalidate();
+}
+
+void TimingPathsCache::inDbITermPostDisconnect(odb::dbITerm* iterm,
+                                               odb::dbNet* net)
+{
+  Invalidate();
+}
+
+void TimingPathsCache::inDbITermPostConnect(odb::dbITerm* iterm)
+{
+  Invalidate();
+}
+
+void TimingPathsCache::inDbBTermCreate(odb::dbBTerm* bterm)
+{
+  Invalidate();
+}
+
+void TimingPathsCache::inDbBTermDestroy(odb::dbBTerm* bterm)
+{
+  Invalidate();
+}
+
+void TimingPathsCache::inDbBTermPostConnect(odb::dbBTerm* bterm)
+{
+  Invalidate();
+}
+
+void TimingPathsCache::inDbBTermPostDisConnect(odb::dbBTerm* bterm,
+                                               odb::dbNet* net)
+{
+  Invalidate();
+}
+
+}  // namespace par
@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
+
+namespace par {
+
+// A pin on a timing path reported by STA.
+// The pin belongs to an instance or an IO port (bterm),
+// and it is connected to net.
+struct StaTimingPin
+{
+  odb::dbInst* inst = nullptr;
+  odb::dbBTerm* bterm = nullptr;
+  odb::dbNet* net = nullptr;
+};
+
+// A timing path reported by STA.
+// The slack is in seconds, i.e., it is not normalized yet
+struct StaTimingPath
+{
+  std::vector<StaTimingPin> pins;
+  float slack = 0.0;
+  float clock_period = 0.0;  // the period of the target clock
+};
+
+// --------------------------------------------------------------------------
+// The timing paths and net slacks extracted from STA are expensive to
+// compute, but they only depend on the netlist and the constraints.
+// TimingPathsCache keeps them across triton_part_design calls, so the
+// parameter sweeps do not need to run STA again.  The cached information
+// is in terms of OpenDB objects and is independent of the vertex ids.
+// The cache is invalidated by any change of the netlist or the placement,
+// which is tracked by the OpenDB callbacks.  Changes of the constraints
+// are not visible from OpenDB, so the cache is only used on request.
+// --------------------------------------------------------------------------
+class TimingPathsCache : public odb::dbBlockCallBackObj
+{
+ public:
+  // Check if the cached information is valid for the block and top_n
+  bool IsValid(odb::dbBlock* block, int top_n) const;
+
+  // Store the information extracted from STA
+  void Update(odb::dbBlock* block,
+              int top_n,
+              std::vector<StaTimingPath> timing_paths,
+              std::vector<std::pair<odb::dbNet*, float>> net_slacks);
+
+  void Invalidate();
+
+  const std::vector<StaTimingPath>& GetTimingPaths() const
+  {
+    return timing_paths_;
+  }
+
+  const std::vector<std::pair<odb::dbNet*, float>>& GetNetSlacks() const
+  {
+    return net_slacks_;
+  }
+
+  // OpenDB callbacks
+  void inDbInstCreate(odb::dbInst* inst) override;
+  void inDbInstCreate(odb::dbInst* inst, odb::dbRegion* region) override;
+  void inDbInstDestroy(odb::dbInst* inst) override;
+  void inDbInstSwapMasterAfter(odb::dbInst* inst) override;
+  void inDbPostMoveInst(odb::dbInst* inst) override;
+  void inDbNetCreate(odb::dbNet* net) override;
+  void inDbNetDestroy(odb::dbNet* net) override;
+  void inDbITermPostDisconnect(odb::dbITerm* iterm, odb::dbNet* net) override;
+  void inDbITermPostConnect(odb::dbITerm* iterm) override;
+  void inDbBTermCreate(odb::dbBTerm* bterm) override;
+  void inDbBTermDestroy(odb::dbBTerm* bterm) override;
+  void inDbBTermPostConnect(odb::dbBTerm* bterm) override;
+  void inDbBTermPostDisConnect(odb::dbBTerm* bterm, odb::dbNet* net) override;
+
+ private:
+  bool valid_ = false;
+  odb::dbBlock* block_ = nullptr;
+  int top_n_ = 0;  // the number of timing paths requested from STA
+  std::vector<StaTimingPath> timing_paths_;
+  // the slack of each net in seconds
+  std::vector<std::pair<odb::dbNet*, float>> net_slacks_;
+};
+
+}  // namespace par
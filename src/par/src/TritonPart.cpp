@@ -40,16 +40,45 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "TritonPart.h"
 
+#include <algorithm>
+#include <atomic>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/serialization/export.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
 #include <set>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <utility>
 
 #include "Coarsener.h"
+#include "Community.h"
+#include "Embedding.h"
 #include "Hypergraph.h"
 #include "Multilevel.h"
+#include "PartitionJobDescription.h"
 #include "Partitioner.h"
+#include "Profiler.h"
 #include "Refiner.h"
+#include "StreamingCoarsener.h"
+#include "ThreadPool.h"
 #include "Utilities.h"
+#include "dst/BroadcastJobDescription.h"
+#include "dst/Distributed.h"
+#include "dst/JobMessage.h"
 #include "odb/db.h"
 #include "sta/ArcDelayCalc.hh"
 #include "sta/Bfs.hh"
@@ -77,6 +106,8 @@
 
 using utl::PAR;
 
+BOOST_CLASS_EXPORT(par::PartitionJobDescription)
+
 namespace par {
 
 // -----------------------------------------------------------------------------------
@@ -208,6 +239,154 @@ void TritonPart::SetFineTuneParams(
   global_net_threshold_ = global_net_threshold;
 }
 
+void TritonPart::SetGainBucketType(const std::string& gain_bucket_type,
+                                   float gain_resolution)
+{
+  if (gain_bucket_type == "heap") {
+    gain_bucket_type_ = GainBucketType::PRIORITY_QUEUE;
+  } else if (gain_bucket_type == "bucket") {
+    gain_bucket_type_ = GainBucketType::BUCKET_LIST;
+  } else {
+    logger_->error(PAR,
+                   184,
+                   "Unknown gain bucket type {}. Use heap or bucket.",
+                   gain_bucket_type);
+  }
+  if (gain_resolution <= 0.0) {
+    logger_->error(
+        PAR, 185, "The gain resolution {} must be positive.", gain_resolution);
+  }
+  gain_resolution_ = gain_resolution;
+}
+
+void TritonPart::SetPartitionMode(const std::string& mode)
+{
+  if (mode == "direct") {
+    recursive_bisection_flag_ = false;
+  } else if (mode == "recursive") {
+    recursive_bisection_flag_ = true;
+  } else {
+    logger_->error(
+        PAR, 2507, "Unknown partition mode {}. Use direct or recursive.", mode);
+  }
+}
+
+void TritonPart::SetVertexOrder(const std::string& order)
+{
+  if (order == "none") {
+    vertex_order_ = VertexOrder::NONE;
+  } else if (order == "rcm") {
+    vertex_order_ = VertexOrder::RCM;
+  } else if (order == "placement") {
+    vertex_order_ = VertexOrder::PLACEMENT;
+  } else {
+    logger_->error(PAR,
+                   2508,
+                   "Unknown vertex order {}. Use none, rcm or placement.",
+                   order);
+  }
+}
+
+void TritonPart::SetAdaptiveStopAlpha(const float adaptive_stop_alpha)
+{
+  if (adaptive_stop_alpha < 0.0) {
+    logger_->error(PAR,
+                   2512,
+                   "The adaptive stop alpha {} must not be negative.",
+                   adaptive_stop_alpha);
+  }
+  adaptive_stop_alpha_ = adaptive_stop_alpha;
+}
+
+void TritonPart::SetSpectralDimensions(const int spectral_dimensions)
+{
+  if (spectral_dimensions < 0) {
+    logger_->error(PAR,
+                   2513,
+                   "The number of spectral dimensions {} must not be negative.",
+                   spectral_dimensions);
+  }
+  spectral_dimensions_ = spectral_dimensions;
+}
+
+void TritonPart::SetStreamingCoarseningRatio(
+    const float streaming_coarsening_ratio)
+{
+  if (streaming_coarsening_ratio != 0.0 && streaming_coarsening_ratio <= 1.0) {
+    logger_->error(PAR,
+                   2521,
+                   "The streaming coarsening ratio {} must be larger than 1 "
+                   "(or 0 to disable the streaming coarsening).",
+                   streaming_coarsening_ratio);
+  }
+  streaming_coarsening_ratio_ = streaming_coarsening_ratio;
+}
+
+void TritonPart::SetFixedPointBits(const int fixed_point_bits)
+{
+  // the costs are stored in float (24-bit significand)
+  if (fixed_point_bits < 0 || fixed_point_bits > 16) {
+    logger_->error(PAR,
+                   2509,
+                   "The fixed-point bits {} must be between 0 and 16.",
+                   fixed_point_bits);
+  }
+  fixed_point_bits_ = fixed_point_bits;
+}
+
+void TritonPart::SetTimeLimit(const float time_limit)
+{
+  time_limit_ = std::max(time_limit, 0.0f);
+}
+
+void TritonPart::SetDistributed(dst::Distributed* dist,
+                                const std::string& remote_host,
+                                unsigned short remote_port,
+                                const std::string& shared_volume)
+{
+  dist_ = dist;
+  remote_host_ = remote_host;
+  remote_port_ = remote_port;
+  shared_volume_ = shared_volume;
+}
+
+void TritonPart::SetServer(dst::Distributed* dist,
+                           const std::string& server_host,
+                           unsigned short server_port,
+                           const std::string& hypergraph_id)
+{
+  server_dist_ = dist;
+  server_host_ = server_host;
+  server_port_ = server_port;
+  server_hypergraph_id_ = hypergraph_id;
+}
+
+void TritonPart::SetIlpParams(float ilp_time_limit,
+                              int ilp_num_threads,
+                              const std::string& ilp_solver)
+{
+  if (ilp_num_threads <= 0) {
+    logger_->error(PAR,
+                   193,
+                   "The number of ILP threads {} must be positive.",
+                   ilp_num_threads);
+  }
+  if (ilp_solver == "auto") {
+    ilp_solver_ = IlpSolver::AUTO;
+  } else if (ilp_solver == "scip") {
+    ilp_solver_ = IlpSolver::SCIP;
+  } else if (ilp_solver == "cp_sat") {
+    ilp_solver_ = IlpSolver::CP_SAT;
+  } else {
+    logger_->error(PAR,
+                   2510,
+                   "Unknown ILP solver {}. Use auto, scip or cp_sat.",
+                   ilp_solver);
+  }
+  ilp_time_limit_ = std::max(ilp_time_limit, 0.0f);
+  ilp_num_threads_ = ilp_num_threads;
+}
+
 // The function for partitioning a hypergraph
 // This is used for replacing hMETIS
 // Key supports:
@@ -284,28 +463,313 @@ void TritonPart::PartitionHypergraph(unsigned int num_parts_arg,
                 "Reset the timing_aware_flag to false. Timing-driven mode is "
                 "not supported");
 
+  // In the server mode, the resident hypergraph is partitioned by the server
+  bool server_flag = false;
+  if (server_dist_ != nullptr) {
+    dst::JobMessage result(dst::JobMessage::NONE);
+    server_flag = SendServerJob(
+        PartitionJobDescription::PARTITION_RESIDENT,
+        hypergraph_file,
+        {fixed_file, community_file, group_file, placement_file},
+        {},
+        result);
+    if (server_flag == true) {
+      solution_ = static_cast<PartitionJobDescription*>(
+                      result.getJobDescription())
+                      ->getSolution();
+    }
+  }
+
   // build hypergraph: read the basic hypergraph information and other
-  // constraints
-  ReadHypergraph(
-      hypergraph_file, fixed_file, community_file, group_file, placement_file);
+  // constraints.
+  // In the streaming mode, the hypergraph is coarsened out of core first
+  const bool streaming_flag
+      = server_flag == false && streaming_coarsening_ratio_ > 0.0;
+  const std::string cluster_map_file = solution_file + ".clusters";
+  if (streaming_flag == true) {
+    logger_->info(PAR,
+                  237,
+                  "Streaming coarsening ratio = {}",
+                  streaming_coarsening_ratio_);
+    ReadStreamingHypergraph(hypergraph_file,
+                            fixed_file,
+                            community_file,
+                            group_file,
+                            placement_file,
+                            cluster_map_file);
+  } else if (server_flag == false) {
+    ReadHypergraph(hypergraph_file,
+                   fixed_file,
+                   community_file,
+                   group_file,
+                   placement_file);
+  }
 
   // call the multilevel partitioner to partition hypergraph_
-  // but the evaluation is the original_hypergraph_
-  MultiLevelPartition();
+  // but the evaluation is the original_hypergraph_.
+  // An identical earlier run is answered from the solution cache
+  if (server_flag == false) {
+    const std::string cache_file = GetSolutionCacheFile();
+    if (ReadCachedSolution(cache_file) == false) {
+      MultiLevelPartition();
+      WriteCachedSolution(cache_file);
+    }
+  }
 
-  // write the solution in hmetis format
-  std::ofstream solution_file_output;
-  solution_file_output.open(solution_file);
-  for (auto part_id : solution_) {
-    solution_file_output << part_id << std::endl;
+  // write the solution in hmetis format.
+  // The solution of the coarse hypergraph is projected in the streaming mode
+  if (streaming_flag == true) {
+    StreamingCoarsener coarsener(streaming_coarsening_ratio_,
+                                 thr_coarsen_hyperedge_size_skip_,
+                                 streaming_chunk_size_,
+                                 logger_);
+    coarsener.ProjectSolution(cluster_map_file, solution_, solution_file);
+  } else {
+    std::ofstream solution_file_output;
+    solution_file_output.open(solution_file);
+    for (auto part_id : solution_) {
+      solution_file_output << part_id << std::endl;
+    }
+    solution_file_output.close();
   }
-  solution_file_output.close();
 
   // finish hypergraph partitioning
   logger_->report("===============================================");
   logger_->report("Exiting TritonPart");
 }
 
+// The function for partitioning a hypergraph given as arrays
+// in compressed sparse row format (eptr, eind) instead of files.
+// Only fixed vertices are supported as constraints; there is no timing,
+// placement, fence, community or group information.
+// The block of vertex v is written to solution[v]
+void TritonPart::PartitionHypergraphArrays(unsigned int num_parts_arg,
+                                           float balance_constraint_arg,
+                                           unsigned int seed_arg,
+                                           const int* eptr,
+                                           const int num_eptr,
+                                           const int* eind,
+                                           const int num_eind,
+                                           const float* vertex_weights,
+                                           const int num_vertex_weights,
+                                           const float* hyperedge_weights,
+                                           const int num_hyperedge_weights,
+                                           const int* fixed_attr,
+                                           const int num_fixed_attr,
+                                           int* solution,
+                                           const int num_vertices)
+{
+  num_parts_ = num_parts_arg;
+  ub_factor_ = balance_constraint_arg;
+  seed_ = seed_arg;
+  base_balance_.clear();
+  scale_factor_.clear();
+  timing_aware_flag_ = false;
+  placement_flag_ = false;
+  placement_dimensions_ = 0;
+  fence_flag_ = false;
+  group_attr_.clear();
+  community_attr_.clear();
+  placement_attr_.clear();
+  if (solution == nullptr) {
+    logger_->error(PAR, 2515, "Invalid hypergraph arrays : {}", "no solution");
+  }
+  ReadHypergraphArrays(eptr,
+                       num_eptr,
+                       eind,
+                       num_eind,
+                       vertex_weights,
+                       num_vertex_weights,
+                       hyperedge_weights,
+                       num_hyperedge_weights,
+                       fixed_attr,
+                       num_fixed_attr,
+                       num_vertices);
+
+  // call the multilevel partitioner to partition hypergraph_
+  // but the evaluation is the original_hypergraph_
+  MultiLevelPartition();
+  std::copy(solution_.begin(), solution_.end(), solution);
+}
+
+// Build original_hypergraph_ from the arrays of PartitionHypergraphArrays
+// or CoarsenHypergraphArrays
+void TritonPart::ReadHypergraphArrays(const int* eptr,
+                                      const int num_eptr,
+                                      const int* eind,
+                                      const int num_eind,
+                                      const float* vertex_weights,
+                                      const int num_vertex_weights,
+                                      const float* hyperedge_weights,
+                                      const int num_hyperedge_weights,
+                                      const int* fixed_attr,
+                                      const int num_fixed_attr,
+                                      const int num_vertices)
+{
+  num_vertices_ = num_vertices;
+  num_hyperedges_ = num_eptr - 1;
+
+  // the same checks as ReadBinaryHypergraph
+  auto lambda_invalid = [&](const char* reason) {
+    logger_->error(PAR, 2529, "Invalid hypergraph arrays : {}", reason);
+  };
+  if (num_vertices_ <= 0) {
+    lambda_invalid("no vertices");
+  }
+  if (eptr == nullptr || num_hyperedges_ < 0 || eptr[0] != 0
+      || std::is_sorted(eptr, eptr + num_eptr) == false
+      || eptr[num_hyperedges_] != num_eind) {
+    lambda_invalid("eptr does not match eind");
+  }
+  if (eind == nullptr && num_eind > 0) {
+    lambda_invalid("eptr does not match eind");
+  }
+  for (int i = 0; i < num_eind; i++) {
+    if (eind[i] < 0 || eind[i] >= num_vertices_) {
+      lambda_invalid("vertex id out of range");
+    }
+  }
+  vertex_dimensions_
+      = num_vertex_weights > 0 ? num_vertex_weights / num_vertices_ : 1;
+  hyperedge_dimensions_
+      = num_hyperedge_weights > 0 && num_hyperedges_ > 0
+            ? num_hyperedge_weights / num_hyperedges_
+            : 1;
+  if ((num_vertex_weights > 0
+       && (vertex_weights == nullptr
+           || vertex_dimensions_ * num_vertices_ != num_vertex_weights))
+      || (num_hyperedge_weights > 0
+          && (hyperedge_weights == nullptr
+              || hyperedge_dimensions_ * num_hyperedges_
+                     != num_hyperedge_weights))) {
+    lambda_invalid("the number of weights");
+  }
+  if (num_fixed_attr > 0
+      && (fixed_attr == nullptr || num_fixed_attr != num_vertices_)) {
+    lambda_invalid("the number of fixed attributes");
+  }
+
+  // The weights are stored row by row
+  auto lambda_rows = [](const float* values,
+                        const int num_rows,
+                        const int dimensions,
+                        std::vector<std::vector<float>>& rows) {
+    rows.clear();
+    rows.reserve(num_rows);
+    for (int row = 0; row < num_rows; row++) {
+      if (values == nullptr) {
+        rows.emplace_back(dimensions, 1.0f);
+      } else {
+        rows.emplace_back(values + static_cast<size_t>(row) * dimensions,
+                          values + static_cast<size_t>(row + 1) * dimensions);
+      }
+    }
+  };
+  lambda_rows(
+      vertex_weights, num_vertices_, vertex_dimensions_, vertex_weights_);
+  lambda_rows(hyperedge_weights,
+              num_hyperedges_,
+              hyperedge_dimensions_,
+              hyperedge_weights_);
+  if (num_fixed_attr > 0) {
+    fixed_attr_.assign(fixed_attr, fixed_attr + num_fixed_attr);
+  } else {
+    fixed_attr_.clear();
+  }
+
+  logger_->info(PAR,
+                209,
+                "Hypergraph arrays : {} vertices, {} hyperedges, "
+                "vertex dimensions = {}, hyperedge dimensions = {}",
+                num_vertices_,
+                num_hyperedges_,
+                vertex_dimensions_,
+                hyperedge_dimensions_);
+
+  original_hypergraph_ = std::make_shared<Hypergraph>(
+      vertex_dimensions_,
+      hyperedge_dimensions_,
+      placement_dimensions_,
+      std::vector<CsrOffset>(eptr, eptr + num_eptr),
+      std::vector<int>(eind, eind + num_eind),
+      vertex_weights_,
+      hyperedge_weights_,
+      fixed_attr_,
+      community_attr_,
+      placement_attr_,
+      logger_);
+}
+
+std::vector<std::vector<int>> TritonPart::CoarsenHypergraphArrays(
+    unsigned int seed_arg,
+    const int* eptr,
+    const int num_eptr,
+    const int* eind,
+    const int num_eind,
+    const float* vertex_weights,
+    const int num_vertices,
+    const int thr_coarsen_vertices,
+    const float max_cluster_weight)
+{
+  num_parts_ = 2;
+  seed_ = seed_arg;
+  timing_aware_flag_ = false;
+  placement_flag_ = false;
+  placement_dimensions_ = 0;
+  fence_flag_ = false;
+  group_attr_.clear();
+  community_attr_.clear();
+  placement_attr_.clear();
+  ReadHypergraphArrays(eptr,
+                       num_eptr,
+                       eind,
+                       num_eind,
+                       vertex_weights,
+                       vertex_weights != nullptr ? num_vertices : 0,
+                       nullptr,
+                       0,
+                       nullptr,
+                       0,
+                       num_vertices);
+
+  e_wt_factors_.assign(hyperedge_dimensions_, 1.0);
+  v_wt_factors_.assign(vertex_dimensions_, 1.0);
+  placement_wt_factors_.clear();
+  thr_coarsen_vertices_ = thr_coarsen_vertices;
+  auto evaluator = CreateEvaluator(num_parts_, original_hypergraph_);
+  // no cluster may grow beyond max_cluster_weight
+  auto coarsener
+      = std::make_shared<Coarsener>(num_parts_,
+                                    thr_coarsen_hyperedge_size_skip_,
+                                    thr_coarsen_vertices_,
+                                    thr_coarsen_hyperedges_,
+                                    coarsening_ratio_,
+                                    max_coarsen_iters_,
+                                    adj_diff_ratio_,
+                                    std::vector<float>(vertex_dimensions_,
+                                                       max_cluster_weight),
+                                    seed_,
+                                    coarsen_order_,
+                                    evaluator,
+                                    logger_);
+  coarsener->SetParallelMatching(parallel_matching_);
+  coarsener->SetThreadPool(std::make_shared<ThreadPool>(num_threads_));
+  const CoarseGraphPtrs hierarchy
+      = coarsener->LazyFirstChoice(original_hypergraph_);
+
+  std::vector<std::vector<int>> parents;
+  parents.reserve(hierarchy.size() - 1);
+  for (size_t level = 1; level < hierarchy.size(); level++) {
+    const HGraphPtr& hgraph = hierarchy[level];
+    std::vector<int> parent(hgraph->GetNumFinerVertices());
+    for (int v = 0; v < hgraph->GetNumFinerVertices(); v++) {
+      parent[v] = hgraph->GetVertexCParent(v);
+    }
+    parents.push_back(std::move(parent));
+  }
+  return parents;
+}
+
 // Top level interface
 // The function for partitioning a hypergraph
 // This is the main API for TritonPart
@@ -419,6 +883,12 @@ void TritonPart::PartitionDesign(unsigned int num_parts_arg,
   ReadNetlist(fixed_file, community_file, group_file);
   logger_->report("[STATUS] Finish reading netlist****");
 
+  // start from the previous solution stored in the "partition_id" properties
+  warm_start_solution_.clear();
+  if (warm_start_flag_ == true) {
+    ReadWarmStartSolution();
+  }
+
   // call the multilevel partitioner to partition hypergraph_
   // but the evaluation is the original_hypergraph_
   MultiLevelPartition();
@@ -426,8 +896,7 @@ void TritonPart::PartitionDesign(unsigned int num_parts_arg,
   // Write out the solution.
   // Format 1: write the clustered netlist in verilog directly
   for (auto term : block_->getBTerms()) {
-    auto vertex_id_property = odb::dbIntProperty::find(term, "vertex_id");
-    const int vertex_id = vertex_id_property->getValue();
+    const int vertex_id = GetVertexId(term);
     if (vertex_id == -1) {
       continue;  // This instance is not used
     }
@@ -440,8 +909,7 @@ void TritonPart::PartitionDesign(unsigned int num_parts_arg,
   }
 
   for (auto inst : block_->getInsts()) {
-    auto vertex_id_property = odb::dbIntProperty::find(inst, "vertex_id");
-    const int vertex_id = vertex_id_property->getValue();
+    const int vertex_id = GetVertexId(inst);
     if (vertex_id == -1) {
       continue;  // This instance is not used
     }
@@ -511,48 +979,60 @@ void TritonPart::EvaluateHypergraphSolution(unsigned int num_parts_arg,
   logger_->report("========================================");
   logger_->report("[STATUS] Starting Evaluating Hypergraph Solution");
   logger_->report("========================================");
-  logger_->info(PAR, 169, "Partitioning parameters**** ");
-  // Parameters
-  num_parts_ = num_parts_arg;
-  ub_factor_ = balance_constraint_arg;
-  base_balance_ = base_balance_arg;
-  scale_factor_ = scale_factor_arg;
-  seed_ = 0;  // use the default random seed (no meaning in this function)
-  vertex_dimensions_ = vertex_dimension_arg;
-  hyperedge_dimensions_ = hyperedge_dimension_arg;
-  placement_dimensions_
-      = 0;  // use the default value (no meaning in this function)
-  // local parameters
-  std::string hypergraph_file = hypergraph_file_arg;
-  std::string fixed_file = fixed_file_arg;
-  std::string group_file = group_file_arg;
   // solution file
   std::string solution_file = solution_file_arg;
-  std::string community_file;  // no community file is used (no meaning in this
-                               // function)
-  std::string placement_file;  // no placement file is used (no meaning in this
-                               // function)
-  logger_->info(PAR, 31, "Number of partitions = {}", num_parts_);
-  logger_->info(PAR, 32, "UBfactor = {}", ub_factor_);
-  logger_->info(PAR, 33, "Seed = {}", seed_);
-  logger_->info(PAR, 34, "Vertex dimensions = {}", vertex_dimensions_);
-  logger_->info(PAR, 35, "Hyperedge dimensions = {}", hyperedge_dimensions_);
-  logger_->info(PAR, 36, "Placement dimensions = {}", placement_dimensions_);
-  logger_->info(PAR, 37, "Hypergraph file = {}", hypergraph_file);
   logger_->info(PAR, 38, "Solution file = {}", solution_file);
-  if (!fixed_file.empty()) {
-    logger_->info(PAR, 39, "Fixed file  = {}", fixed_file);
-  }
-  if (!community_file.empty()) {
-    logger_->info(PAR, 40, "Community file = {}", community_file);
-  }
-  if (!group_file.empty()) {
-    logger_->info(PAR, 41, "Group file = {}", group_file);
-  }
-  if (!placement_file.empty()) {
-    logger_->info(PAR, 42, "Placement file = {}", placement_file);
+
+  // In the server mode, the solution is evaluated on the resident hypergraph
+  if (server_dist_ != nullptr) {
+    num_parts_ = num_parts_arg;
+    ub_factor_ = balance_constraint_arg;
+    base_balance_ = base_balance_arg;
+    scale_factor_ = scale_factor_arg;
+    vertex_dimensions_ = vertex_dimension_arg;
+    hyperedge_dimensions_ = hyperedge_dimension_arg;
+    placement_dimensions_ = 0;
+    std::vector<int> solution;
+    std::ifstream solution_file_input(solution_file);
+    int part_id = -1;
+    while (solution_file_input >> part_id) {
+      solution.push_back(part_id);
+    }
+    dst::JobMessage result(dst::JobMessage::NONE);
+    if (solution_file_input.is_open()
+        && SendServerJob(PartitionJobDescription::EVALUATE_RESIDENT,
+                         hypergraph_file_arg,
+                         {fixed_file_arg, "", group_file_arg, ""},
+                         solution,
+                         result)
+               == true) {
+      auto desc
+          = static_cast<PartitionJobDescription*>(result.getJobDescription());
+      logger_->report("[Cutcost of partition : {}]", desc->getCost());
+      const Matrix<float>& block_balance = desc->getBlockBalance();
+      for (int block_id = 0; block_id < static_cast<int>(block_balance.size());
+           block_id++) {
+        logger_->report("[Vertex balance of block_{} : {} ]",
+                        block_id,
+                        GetVectorString(block_balance[block_id]));
+      }
+      logger_->report("Satisfy the constraints : {}", desc->isFeasible());
+      logger_->report("===============================================");
+      logger_->report("Exiting Evaluating Hypergraph Solution");
+      return;
+    }
   }
 
+  auto evaluator = InitHypergraphEvaluation(num_parts_arg,
+                                            balance_constraint_arg,
+                                            std::move(base_balance_arg),
+                                            std::move(scale_factor_arg),
+                                            vertex_dimension_arg,
+                                            hyperedge_dimension_arg,
+                                            hypergraph_file_arg,
+                                            fixed_file_arg,
+                                            group_file_arg);
+
   int part_id = -1;
   std::ifstream solution_file_input(solution_file);
   if (!solution_file_input.is_open()) {
@@ -564,122 +1044,192 @@ void TritonPart::EvaluateHypergraphSolution(unsigned int num_parts_arg,
   }
   solution_file_input.close();
 
-  // set the random seed
-  srand(seed_);  // set the random seed
-
-  timing_aware_flag_ = false;
-  logger_->warn(PAR,
-                120,
-                "Reset the timing_aware_flag to false. Timing-driven mode is "
-                "not supported");
+  evaluator->ConstraintAndCutEvaluator(original_hypergraph_,
+                                       solution_,
+                                       ub_factor_,
+                                       base_balance_,
+                                       group_attr_,
+                                       true);
 
-  // build hypergraph: read the basic hypergraph information and other
-  // constraints
-  ReadHypergraph(
-      hypergraph_file, fixed_file, community_file, group_file, placement_file);
+  logger_->report("===============================================");
+  logger_->report("Exiting Evaluating Hypergraph Solution");
+}
 
-  // check the base balance constraint
-  if (static_cast<int>(base_balance_.size()) != num_parts_) {
-    logger_->warn(PAR, 350, "no base balance is specified. Use default value.");
-    base_balance_.clear();
-    base_balance_.resize(num_parts_);
-    std::fill(base_balance_.begin(), base_balance_.end(), 1.0 / num_parts_);
+// Evaluate many solutions of the same hypergraph. The hypergraph is loaded
+// only once and the solution files are scored in parallel. The statistics
+// of all the solutions are written into a single summary table
+void TritonPart::EvaluateHypergraphSolutions(
+    unsigned int num_parts_arg,
+    float balance_constraint_arg,
+    std::vector<float> base_balance_arg,
+    std::vector<float> scale_factor_arg,
+    int vertex_dimension_arg,
+    int hyperedge_dimension_arg,
+    const char* hypergraph_file_arg,
+    const char* fixed_file_arg,
+    const char* group_file_arg,
+    const std::vector<std::string>& solution_files,
+    const char* summary_file_arg)
+{
+  logger_->report("========================================");
+  logger_->report("[STATUS] Starting Evaluating Hypergraph Solutions");
+  logger_->report("========================================");
+  logger_->info(
+      PAR, 210, "Number of solution files = {}", solution_files.size());
+  auto evaluator = InitHypergraphEvaluation(num_parts_arg,
+                                            balance_constraint_arg,
+                                            std::move(base_balance_arg),
+                                            std::move(scale_factor_arg),
+                                            vertex_dimension_arg,
+                                            hyperedge_dimension_arg,
+                                            hypergraph_file_arg,
+                                            fixed_file_arg,
+                                            group_file_arg);
+
+  // statistics of each solution file
+  struct SolutionScore
+  {
+    std::string error;  // empty if the solution file is valid
+    PartitionToken token;
+    bool constraints_satisfied = false;
+  };
+  std::vector<SolutionScore> scores(solution_files.size());
+  const int num_vertices = original_hypergraph_->GetNumVertices();
+  auto lambda_score = [&](int i) {
+    SolutionScore& score = scores[i];
+    std::ifstream solution_file_input(solution_files[i]);
+    if (!solution_file_input.is_open()) {
+      score.error = "can not open the file";
+      return;
+    }
+    std::vector<int> solution;
+    solution.reserve(num_vertices);
+    int part_id = -1;
+    while (solution_file_input >> part_id) {
+      if (part_id < 0 || part_id >= num_parts_) {
+        score.error = "invalid block id " + std::to_string(part_id);
+        return;
+      }
+      solution.push_back(part_id);
+    }
+    if (static_cast<int>(solution.size()) != num_vertices) {
+      score.error = std::to_string(solution.size()) + " vertices instead of "
+                    + std::to_string(num_vertices);
+      return;
+    }
+    score.token = evaluator->CutEvaluator(original_hypergraph_, solution);
+    score.constraints_satisfied
+        = evaluator->ConstraintEvaluator(original_hypergraph_,
+                                         solution,
+                                         score.token,
+                                         ub_factor_,
+                                         base_balance_,
+                                         group_attr_);
+  };
+  ThreadPool thread_pool(num_threads_);
+  thread_pool.ParallelFor(static_cast<int>(solution_files.size()),
+                          lambda_score);
+
+  // summary table: one line per solution file
+  std::string summary_file = summary_file_arg;
+  std::ofstream summary_output;
+  if (!summary_file.empty()) {
+    summary_output.open(summary_file);
+    if (!summary_output.is_open()) {
+      logger_->error(
+          PAR, 2516, "Can not open the summary file : {}", summary_file);
+    }
   }
-
-  if (static_cast<int>(scale_factor_.size()) != num_parts_) {
-    logger_->warn(PAR, 354, "no scale factor is specified. Use default value.");
-    scale_factor_.clear();
-    scale_factor_.resize(num_parts_);
-    std::fill(scale_factor_.begin(), scale_factor_.end(), 1.0);
+  auto lambda_write = [&](const std::string& line) {
+    if (summary_output.is_open()) {
+      summary_output << line << std::endl;
+    } else {
+      logger_->report("{}", line);
+    }
+  };
+  lambda_write("solution_file cutsize constraints_satisfied block_balance");
+  int best_solution = -1;
+  for (int i = 0; i < static_cast<int>(solution_files.size()); i++) {
+    const SolutionScore& score = scores[i];
+    if (!score.error.empty()) {
+      logger_->warn(PAR,
+                    211,
+                    "Skip the solution file {} : {}",
+                    solution_files[i],
+                    score.error);
+      continue;
+    }
+    std::string line = solution_files[i] + " "
+                       + std::to_string(score.token.cost) + " "
+                       + (score.constraints_satisfied ? "1" : "0");
+    for (const auto& block_balance : score.token.block_balance) {
+      line += " [ " + GetVectorString(block_balance) + "]";
+    }
+    lambda_write(line);
+    if (score.constraints_satisfied
+        && (best_solution == -1
+            || score.token.cost < scores[best_solution].token.cost)) {
+      best_solution = i;
+    }
   }
-
-  // adjust the size of vertices based on scale factor
-  for (int i = 0; i < num_parts_; ++i) {
-    base_balance_[i] = base_balance_[i] / scale_factor_[i];
+  if (summary_output.is_open()) {
+    summary_output.close();
   }
 
-  // check the weighting scheme
-  if (static_cast<int>(e_wt_factors_.size()) != hyperedge_dimensions_) {
-    logger_->warn(
-        PAR,
-        121,
-        "no hyperedge weighting is specified. Use default value of 1.");
-    e_wt_factors_.clear();
-    e_wt_factors_.resize(hyperedge_dimensions_);
-    std::fill(e_wt_factors_.begin(), e_wt_factors_.end(), 1.0);
+  if (best_solution != -1) {
+    logger_->info(PAR,
+                  212,
+                  "Best solution satisfying the constraints : {} "
+                  "(cutsize = {})",
+                  solution_files[best_solution],
+                  scores[best_solution].token.cost);
   }
-  logger_->info(PAR,
-                43,
-                "hyperedge weight factor : [ {} ]",
-                GetVectorString(e_wt_factors_));
 
-  if (static_cast<int>(v_wt_factors_.size()) != vertex_dimensions_) {
-    logger_->warn(
-        PAR, 124, "No vertex weighting is specified. Use default value of 1.");
-    v_wt_factors_.clear();
-    v_wt_factors_.resize(vertex_dimensions_);
-    std::fill(v_wt_factors_.begin(), v_wt_factors_.end(), 1.0);
-  }
-  logger_->info(
-      PAR, 44, "vertex weight factor : [ {} ]", GetVectorString(v_wt_factors_));
-
-  if (static_cast<int>(placement_wt_factors_.size()) != placement_dimensions_) {
-    if (placement_dimensions_ <= 0) {
-      placement_wt_factors_.clear();
-    } else {
-      logger_->warn(
-          PAR,
-          125,
-          "No placement weighting is specified. Use default value of 1.");
-      placement_wt_factors_.clear();
-      placement_wt_factors_.resize(placement_dimensions_);
-      std::fill(
-          placement_wt_factors_.begin(), placement_wt_factors_.end(), 1.0f);
-    }
-  }
-  logger_->info(PAR,
-                45,
-                "placement weight factor : [ {} ]",
-                GetVectorString(placement_wt_factors_));
-
-  // following parameters are not used
-  net_timing_factor_ = 0.0;
-  path_timing_factor_ = 0.0;
-  path_snaking_factor_ = 0.0;
-  timing_exp_factor_ = 0.0;
-  extra_delay_ = 0.0;
-
-  // print all the weighting parameters
-  logger_->info(PAR, 46, "net_timing_factor : {}", net_timing_factor_);
-  logger_->info(PAR, 47, "path_timing_factor : {}", path_timing_factor_);
-  logger_->info(PAR, 48, "path_snaking_factor : {}", path_snaking_factor_);
-  logger_->info(PAR, 49, "timing_exp_factor : {}", timing_exp_factor_);
-  logger_->info(PAR, 50, "extra_delay : {}", extra_delay_);
+  logger_->report("===============================================");
+  logger_->report("Exiting Evaluating Hypergraph Solutions");
+}
 
-  // create the evaluator class
-  auto evaluator = std::make_shared<GoldenEvaluator>(num_parts_,
-                                                     // weight vectors
-                                                     e_wt_factors_,
-                                                     v_wt_factors_,
-                                                     placement_wt_factors_,
-                                                     // timing related weight
-                                                     net_timing_factor_,
-                                                     path_timing_factor_,
-                                                     path_snaking_factor_,
-                                                     timing_exp_factor_,
-                                                     extra_delay_,
-                                                     original_hypergraph_,
-                                                     logger_);
+void TritonPart::WriteHypergraphBinary(int vertex_dimension_arg,
+                                       int hyperedge_dimension_arg,
+                                       int placement_dimension_arg,
+                                       const char* hypergraph_file_arg,
+                                       const char* fixed_file_arg,
+                                       const char* community_file_arg,
+                                       const char* placement_file_arg,
+                                       const char* binary_file_arg)
+{
+  vertex_dimensions_ = vertex_dimension_arg;
+  hyperedge_dimensions_ = hyperedge_dimension_arg;
+  placement_dimensions_ = placement_dimension_arg;
+  timing_aware_flag_ = false;
+  // local parameters
+  std::string hypergraph_file = hypergraph_file_arg;
+  std::string fixed_file = fixed_file_arg;
+  std::string community_file = community_file_arg;
+  std::string placement_file = placement_file_arg;
+  std::string binary_file = binary_file_arg;
+  std::string group_file;  // the groups are not part of the hypergraph
+  logger_->info(PAR, 190, "Hypergraph file = {}", hypergraph_file);
+  logger_->info(PAR, 191, "Binary hypergraph file = {}", binary_file);
 
-  evaluator->ConstraintAndCutEvaluator(original_hypergraph_,
-                                       solution_,
-                                       ub_factor_,
-                                       base_balance_,
-                                       group_attr_,
-                                       true);
+  ReadHypergraph(
+      hypergraph_file, fixed_file, community_file, group_file, placement_file);
 
-  logger_->report("===============================================");
-  logger_->report("Exiting Evaluating Hypergraph Solution");
+  // the weighting parameters are not used for writing the hypergraph
+  auto evaluator = std::make_shared<GoldenEvaluator>(
+      num_parts_,
+      std::vector<float>(hyperedge_dimensions_, 1.0),
+      std::vector<float>(vertex_dimensions_, 1.0),
+      std::vector<float>(placement_dimensions_, 1.0),
+      0.0,
+      0.0,
+      0.0,
+      0.0,
+      0.0,
+      original_hypergraph_,
+      logger_);
+  evaluator->WriteBinaryHypergraph(original_hypergraph_, binary_file);
+  logger_->report("Finish writing binary hypergraph");
 }
 
 // Function to evaluate the hypergraph partitioning solution
@@ -935,87 +1485,192 @@ void TritonPart::EvaluatePartDesignSolution(
   }
 }
 
-// k-way partitioning used by Hier-RTLMP
-std::vector<int> TritonPart::PartitionKWaySimpleMode(
+// --------------------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------------------
+
+// Set the parameters and read the hypergraph shared by the evaluation of
+// one or more solutions
+EvaluatorPtr TritonPart::InitHypergraphEvaluation(
     unsigned int num_parts_arg,
     float balance_constraint_arg,
-    unsigned int seed_arg,
-    const std::vector<std::vector<int>>& hyperedges,
-    const std::vector<float>& vertex_weights,
-    const std::vector<float>& hyperedge_weights)
+    std::vector<float> base_balance_arg,
+    std::vector<float> scale_factor_arg,
+    int vertex_dimension_arg,
+    int hyperedge_dimension_arg,
+    const char* hypergraph_file_arg,
+    const char* fixed_file_arg,
+    const char* group_file_arg)
 {
+  logger_->info(PAR, 169, "Partitioning parameters**** ");
+  // Parameters
   num_parts_ = num_parts_arg;
   ub_factor_ = balance_constraint_arg;
-  seed_ = seed_arg;
-  vertex_dimensions_ = 1;  // for design partitioning, vertex weight is the area
-                           // of the instance
-  hyperedge_dimensions_
-      = 1;  // for design partitioning, hyperedge weight is the connectivity
+  base_balance_ = base_balance_arg;
+  scale_factor_ = scale_factor_arg;
+  seed_ = 0;  // use the default random seed (no meaning in this function)
+  vertex_dimensions_ = vertex_dimension_arg;
+  hyperedge_dimensions_ = hyperedge_dimension_arg;
+  placement_dimensions_
+      = 0;  // use the default value (no meaning in this function)
+  // local parameters
+  std::string hypergraph_file = hypergraph_file_arg;
+  std::string fixed_file = fixed_file_arg;
+  std::string group_file = group_file_arg;
+  std::string community_file;  // no community file is used (no meaning in this
+                               // function)
+  std::string placement_file;  // no placement file is used (no meaning in this
+                               // function)
+  logger_->info(PAR, 31, "Number of partitions = {}", num_parts_);
+  logger_->info(PAR, 32, "UBfactor = {}", ub_factor_);
+  logger_->info(PAR, 33, "Seed = {}", seed_);
+  logger_->info(PAR, 34, "Vertex dimensions = {}", vertex_dimensions_);
+  logger_->info(PAR, 35, "Hyperedge dimensions = {}", hyperedge_dimensions_);
+  logger_->info(PAR, 36, "Placement dimensions = {}", placement_dimensions_);
+  logger_->info(PAR, 37, "Hypergraph file = {}", hypergraph_file);
+  if (!fixed_file.empty()) {
+    logger_->info(PAR, 39, "Fixed file  = {}", fixed_file);
+  }
+  if (!community_file.empty()) {
+    logger_->info(PAR, 40, "Community file = {}", community_file);
+  }
+  if (!group_file.empty()) {
+    logger_->info(PAR, 41, "Group file = {}", group_file);
+  }
+  if (!placement_file.empty()) {
+    logger_->info(PAR, 42, "Placement file = {}", placement_file);
+  }
+
+  // set the random seed
+  srand(seed_);  // set the random seed
+
   timing_aware_flag_ = false;
-  placement_flag_ = false;
-  placement_dimensions_ = 0;
-  fence_flag_ = false;
-  hyperedges_ = hyperedges;
-  fixed_attr_.clear();
-  community_attr_.clear();
-  group_attr_.clear();
+  logger_->warn(PAR,
+                120,
+                "Reset the timing_aware_flag to false. Timing-driven mode is "
+                "not supported");
+
+  // build hypergraph: read the basic hypergraph information and other
+  // constraints
+  ReadHypergraph(
+      hypergraph_file, fixed_file, community_file, group_file, placement_file);
 
-  // convert vertex and hyperedge weights
-  for (const auto& weight : vertex_weights) {
-    std::vector<float> v_wt{weight};
-    vertex_weights_.push_back(v_wt);
+  // check the base balance constraint
+  if (static_cast<int>(base_balance_.size()) != num_parts_) {
+    logger_->warn(PAR, 350, "no base balance is specified. Use default value.");
+    base_balance_.clear();
+    base_balance_.resize(num_parts_);
+    std::fill(base_balance_.begin(), base_balance_.end(), 1.0 / num_parts_);
   }
 
-  for (const auto& weight : hyperedge_weights) {
-    std::vector<float> e_wt{weight};
-    hyperedge_weights_.push_back(e_wt);
+  if (static_cast<int>(scale_factor_.size()) != num_parts_) {
+    logger_->warn(PAR, 354, "no scale factor is specified. Use default value.");
+    scale_factor_.clear();
+    scale_factor_.resize(num_parts_);
+    std::fill(scale_factor_.begin(), scale_factor_.end(), 1.0);
   }
 
-  // Build the original hypergraph first
-  original_hypergraph_ = std::make_shared<Hypergraph>(vertex_dimensions_,
-                                                      hyperedge_dimensions_,
-                                                      placement_dimensions_,
-                                                      hyperedges_,
-                                                      vertex_weights_,
-                                                      hyperedge_weights_,
-                                                      fixed_attr_,
-                                                      community_attr_,
-                                                      placement_attr_,
-                                                      logger_);
+  // adjust the size of vertices based on scale factor
+  for (int i = 0; i < num_parts_; ++i) {
+    base_balance_[i] = base_balance_[i] / scale_factor_[i];
+  }
 
-  // call the multilevel partitioner to partition hypergraph_
-  // but the evaluation is the original_hypergraph_
-  MultiLevelPartition();
+  // check the weighting scheme
+  if (static_cast<int>(e_wt_factors_.size()) != hyperedge_dimensions_) {
+    logger_->warn(
+        PAR,
+        121,
+        "no hyperedge weighting is specified. Use default value of 1.");
+    e_wt_factors_.clear();
+    e_wt_factors_.resize(hyperedge_dimensions_);
+    std::fill(e_wt_factors_.begin(), e_wt_factors_.end(), 1.0);
+  }
+  logger_->info(PAR,
+                43,
+                "hyperedge weight factor : [ {} ]",
+                GetVectorString(e_wt_factors_));
 
-  return solution_;
-}
+  if (static_cast<int>(v_wt_factors_.size()) != vertex_dimensions_) {
+    logger_->warn(
+        PAR, 124, "No vertex weighting is specified. Use default value of 1.");
+    v_wt_factors_.clear();
+    v_wt_factors_.resize(vertex_dimensions_);
+    std::fill(v_wt_factors_.begin(), v_wt_factors_.end(), 1.0);
+  }
+  logger_->info(
+      PAR, 44, "vertex weight factor : [ {} ]", GetVectorString(v_wt_factors_));
 
-// --------------------------------------------------------------------------------------
-// Private functions
-// --------------------------------------------------------------------------------------
+  if (static_cast<int>(placement_wt_factors_.size()) != placement_dimensions_) {
+    if (placement_dimensions_ <= 0) {
+      placement_wt_factors_.clear();
+    } else {
+      logger_->warn(
+          PAR,
+          125,
+          "No placement weighting is specified. Use default value of 1.");
+      placement_wt_factors_.clear();
+      placement_wt_factors_.resize(placement_dimensions_);
+      std::fill(
+          placement_wt_factors_.begin(), placement_wt_factors_.end(), 1.0f);
+    }
+  }
+  logger_->info(PAR,
+                45,
+                "placement weight factor : [ {} ]",
+                GetVectorString(placement_wt_factors_));
 
-// for hypergraph partitioning
-// Read hypergraph from input files and related constraint files
-void TritonPart::ReadHypergraph(const std::string& hypergraph_file,
-                                const std::string& fixed_file,
-                                const std::string& community_file,
-                                const std::string& group_file,
-                                const std::string& placement_file)
+  // following parameters are not used
+  net_timing_factor_ = 0.0;
+  path_timing_factor_ = 0.0;
+  path_snaking_factor_ = 0.0;
+  timing_exp_factor_ = 0.0;
+  extra_delay_ = 0.0;
+
+  // print all the weighting parameters
+  logger_->info(PAR, 46, "net_timing_factor : {}", net_timing_factor_);
+  logger_->info(PAR, 47, "path_timing_factor : {}", path_timing_factor_);
+  logger_->info(PAR, 48, "path_snaking_factor : {}", path_snaking_factor_);
+  logger_->info(PAR, 49, "timing_exp_factor : {}", timing_exp_factor_);
+  logger_->info(PAR, 50, "extra_delay : {}", extra_delay_);
+
+  // create the evaluator class
+  return std::make_shared<GoldenEvaluator>(num_parts_,
+                                           // weight vectors
+                                           e_wt_factors_,
+                                           v_wt_factors_,
+                                           placement_wt_factors_,
+                                           // timing related weight
+                                           net_timing_factor_,
+                                           path_timing_factor_,
+                                           path_snaking_factor_,
+                                           timing_exp_factor_,
+                                           extra_delay_,
+                                           original_hypergraph_,
+                                           logger_);
+}
+
+// Read the hypergraph in hMETIS format
+// The hyperedges are returned in compressed sparse row format
+void TritonPart::ReadTextHypergraph(const std::string& hypergraph_file,
+                                    std::vector<CsrOffset>& eptr,
+                                    std::vector<int>& eind)
 {
   // read hypergraph file
-  std::ifstream hypergraph_file_input(hypergraph_file);
-  if (!hypergraph_file_input.is_open()) {
+  // The file is loaded with a single read and parsed in place
+  TextFileReader hypergraph_file_input;
+  if (!hypergraph_file_input.Open(hypergraph_file)) {
     logger_->error(PAR,
                    2500,
                    "Can not open the input hypergraph file : {}",
                    hypergraph_file);
   }
   // Check the number of vertices, number of hyperedges, weight flag
-  std::string cur_line;
-  std::getline(hypergraph_file_input, cur_line);
-  std::istringstream cur_line_buf(cur_line);
-  std::vector<int> stats{std::istream_iterator<int>(cur_line_buf),
-                         std::istream_iterator<int>()};
+  hypergraph_file_input.NextLine();
+  std::vector<int> stats;
+  int value = 0;
+  while (hypergraph_file_input.NextInt(value)) {
+    stats.push_back(value);
+  }
   num_hyperedges_ = stats[0];
   num_vertices_ = stats[1];
   bool hyperedge_weight_flag = false;
@@ -1030,125 +1685,361 @@ void TritonPart::ReadHypergraph(const std::string& hypergraph_file,
   }
 
   // clear the related vectors
-  hyperedges_.clear();
+  // The hyperedges are stored in compressed sparse row format directly
   hyperedge_weights_.clear();
   vertex_weights_.clear();
-  hyperedges_.reserve(num_hyperedges_);
   hyperedge_weights_.reserve(num_hyperedges_);
   vertex_weights_.reserve(num_vertices_);
+  eptr.clear();
+  eind.clear();
+  eptr.reserve(num_hyperedges_ + 1);
+  eptr.push_back(0);
 
   // Read hyperedge information
   for (int i = 0; i < num_hyperedges_; i++) {
-    std::getline(hypergraph_file_input, cur_line);
+    hypergraph_file_input.NextLine();
     if (hyperedge_weight_flag == true) {
-      std::istringstream cur_line_buf(cur_line);
-      std::vector<float> hvec{std::istream_iterator<float>(cur_line_buf),
-                              std::istream_iterator<float>()};
-      std::vector<float>::iterator breakpoint{hvec.begin()
-                                              + hyperedge_dimensions_};
       // read first hyperedge_dimensions_ elements as hyperege weights
-      std::vector<float> hwts(hvec.begin(), breakpoint);
-      // read remaining elements as hyperedge
-      std::vector<int> hyperedge(breakpoint, hvec.end());
-      for (auto& value : hyperedge) {
-        value--;  // the vertex id starts from 1 in the hypergraph file
+      std::vector<float> hwts;
+      hwts.reserve(hyperedge_dimensions_);
+      float weight = 0.0;
+      while (static_cast<int>(hwts.size()) < hyperedge_dimensions_
+             && hypergraph_file_input.NextFloat(weight)) {
+        hwts.push_back(weight);
       }
       hyperedge_weights_.push_back(hwts);
-      hyperedges_.push_back(hyperedge);
     } else {
-      std::istringstream cur_line_buf(cur_line);
-      std::vector<int> hyperedge{std::istream_iterator<int>(cur_line_buf),
-                                 std::istream_iterator<int>()};
-      for (auto& value : hyperedge) {
-        value--;  // the vertex id starts from 1 in the hypergraph file
-      }
       std::vector<float> hwts(hyperedge_dimensions_,
                               1.0);  // each dimension has the same weight
       hyperedge_weights_.push_back(hwts);
-      hyperedges_.push_back(hyperedge);
     }
+    // read remaining elements as hyperedge
+    while (hypergraph_file_input.NextInt(value)) {
+      // the vertex id starts from 1 in the hypergraph file
+      eind.push_back(value - 1);
+    }
+    eptr.push_back(static_cast<CsrOffset>(eind.size()));
   }
 
   // Read weight for vertices
   for (int i = 0; i < num_vertices_; i++) {
     if (vertex_weight_flag == true) {
-      std::getline(hypergraph_file_input, cur_line);
-      std::istringstream cur_line_buf(cur_line);
-      std::vector<float> vwts{std::istream_iterator<float>(cur_line_buf),
-                              std::istream_iterator<float>()};
+      hypergraph_file_input.NextLine();
+      std::vector<float> vwts;
+      float weight = 0.0;
+      while (hypergraph_file_input.NextFloat(weight)) {
+        vwts.push_back(weight);
+      }
       vertex_weights_.push_back(vwts);
     } else {
       std::vector<float> vwts(vertex_dimensions_, 1.0);
       vertex_weights_.push_back(vwts);
     }
   }
+}
 
-  // Read fixed vertices
-  if (!fixed_file.empty()) {
-    int part_id = -1;
-    std::ifstream fixed_file_input(fixed_file);
-    if (!fixed_file_input.is_open()) {
-      logger_->error(PAR, 2501, "Can not open the fixed file : {}", fixed_file);
-    }
-    while (fixed_file_input >> part_id) {
-      fixed_attr_.push_back(part_id);
-    }
-    fixed_file_input.close();
-    if (static_cast<int>(fixed_attr_.size()) != num_vertices_) {
-      logger_->warn(PAR, 129, "Reset the fixed attributes to NONE.");
-      fixed_attr_.clear();
-    }
+// Read the hypergraph in the binary format
+// (see GoldenEvaluator::WriteBinaryHypergraph)
+// The arrays are copied from the file directly without parsing.
+// The timing information is not loaded because hypergraph partitioning
+// does not support timing-driven mode.
+void TritonPart::ReadBinaryHypergraph(const std::string& hypergraph_file,
+                                      std::vector<CsrOffset>& eptr,
+                                      std::vector<int>& eind)
+{
+  BinaryFileReader hypergraph_file_input;
+  if (!hypergraph_file_input.Open(hypergraph_file)) {
+    logger_->error(PAR,
+                   2531,
+                   "Can not open the input hypergraph file : {}",
+                   hypergraph_file);
+  }
+  auto lambda_invalid_file = [&]() {
+    logger_->error(
+        PAR, 2506, "Invalid binary hypergraph file : {}", hypergraph_file);
+  };
+  // skip the magic string, which is checked by IsBinaryHypergraphFile
+  std::vector<char> magic;
+  std::vector<int> header;
+  hypergraph_file_input.Read(magic, binary_hypergraph_magic.size());
+  if (hypergraph_file_input.Read(header, 10) == false
+      || header[0] < 1 || header[0] > binary_hypergraph_version) {
+    lambda_invalid_file();
+  }
+  num_vertices_ = header[1];
+  num_hyperedges_ = header[2];
+  // the dimensions are stored in the file
+  if (vertex_dimensions_ != header[3] || hyperedge_dimensions_ != header[4]
+      || placement_dimensions_ != header[5]) {
+    logger_->warn(PAR,
+                  189,
+                  "Use the dimensions of the binary hypergraph file. "
+                  "Vertex dimensions = {}, Hyperedge dimensions = {}, "
+                  "Placement dimensions = {}",
+                  header[3],
+                  header[4],
+                  header[5]);
+  }
+  vertex_dimensions_ = header[3];
+  hyperedge_dimensions_ = header[4];
+  placement_dimensions_ = header[5];
+  const bool fixed_flag = header[6] != 0;
+  const bool community_flag = header[7] != 0;
+  const bool placement_flag = header[8] != 0;
+  if (num_vertices_ < 0 || num_hyperedges_ < 0 || vertex_dimensions_ <= 0
+      || hyperedge_dimensions_ <= 0 || placement_dimensions_ < 0) {
+    lambda_invalid_file();
+  }
+
+  // hyperedges. The version 1 files store the offsets as int
+  bool valid_eptr = false;
+  if (header[0] == 1) {
+    std::vector<int> eptr_int;
+    valid_eptr = hypergraph_file_input.Read(eptr_int, num_hyperedges_ + 1);
+    eptr.assign(eptr_int.begin(), eptr_int.end());
+  } else {
+    valid_eptr = hypergraph_file_input.Read(eptr, num_hyperedges_ + 1);
+  }
+  if (valid_eptr == false || eptr.front() != 0
+      || std::is_sorted(eptr.begin(), eptr.end()) == false
+      || hypergraph_file_input.Read(eind, eptr.back()) == false) {
+    lambda_invalid_file();
+  }
+  for (const int vertex : eind) {
+    if (vertex < 0 || vertex >= num_vertices_) {
+      lambda_invalid_file();
+    }
+  }
+
+  // weights
+  std::vector<float> vertex_weights;
+  std::vector<float> hyperedge_weights;
+  const size_t num_vertex_weights
+      = static_cast<size_t>(num_vertices_) * vertex_dimensions_;
+  const size_t num_hyperedge_weights
+      = static_cast<size_t>(num_hyperedges_) * hyperedge_dimensions_;
+  if (hypergraph_file_input.Read(vertex_weights, num_vertex_weights) == false
+      || hypergraph_file_input.Read(hyperedge_weights, num_hyperedge_weights)
+             == false) {
+    lambda_invalid_file();
+  }
+  vertex_weights_.clear();
+  vertex_weights_.reserve(num_vertices_);
+  for (auto iter = vertex_weights.begin(); iter != vertex_weights.end();
+       iter += vertex_dimensions_) {
+    vertex_weights_.emplace_back(iter, iter + vertex_dimensions_);
+  }
+  hyperedge_weights_.clear();
+  hyperedge_weights_.reserve(num_hyperedges_);
+  for (auto iter = hyperedge_weights.begin(); iter != hyperedge_weights.end();
+       iter += hyperedge_dimensions_) {
+    hyperedge_weights_.emplace_back(iter, iter + hyperedge_dimensions_);
+  }
+
+  // attributes of vertices
+  if ((fixed_flag == true
+       && hypergraph_file_input.Read(fixed_attr_, num_vertices_) == false)
+      || (community_flag == true
+          && hypergraph_file_input.Read(community_attr_, num_vertices_)
+                 == false)) {
+    lambda_invalid_file();
+  }
+  if (placement_flag == true) {
+    std::vector<float> placement_attr;
+    if (hypergraph_file_input.Read(
+            placement_attr,
+            static_cast<size_t>(num_vertices_) * placement_dimensions_)
+        == false) {
+      lambda_invalid_file();
+    }
+    placement_attr_.reserve(num_vertices_);
+    for (auto iter = placement_attr.begin(); iter != placement_attr.end();
+         iter += placement_dimensions_) {
+      placement_attr_.emplace_back(iter, iter + placement_dimensions_);
+    }
+  }
+}
+
+// Read the block ids stored in the file until the first invalid element
+static void ReadIds(TextFileReader& file_input, std::vector<int>& ids)
+{
+  int id = -1;
+  bool valid = true;
+  while (valid == true && file_input.NextLine()) {
+    while (file_input.NextInt(id)) {
+      ids.push_back(id);
+    }
+    valid = file_input.EndOfLine();
+  }
+}
+
+// Read fixed_attr_ and community_attr_ of the num_vertices_ vertices
+// from the fixed file and the community file (if given)
+void TritonPart::ReadVertexAttributes(const std::string& fixed_file,
+                                      const std::string& community_file)
+{
+  // Read fixed vertices
+  if (!fixed_file.empty()) {
+    TextFileReader fixed_file_input;
+    if (!fixed_file_input.Open(fixed_file)) {
+      logger_->error(PAR, 2501, "Can not open the fixed file : {}", fixed_file);
+    }
+    fixed_attr_.clear();
+    ReadIds(fixed_file_input, fixed_attr_);
+    if (static_cast<int>(fixed_attr_.size()) != num_vertices_) {
+      logger_->warn(PAR, 129, "Reset the fixed attributes to NONE.");
+      fixed_attr_.clear();
+    }
   }
 
   // Read community file
   if (!community_file.empty()) {
-    int part_id = -1;
-    std::ifstream community_file_input(community_file);
-    if (!community_file_input.is_open()) {
+    TextFileReader community_file_input;
+    if (!community_file_input.Open(community_file)) {
       logger_->error(
           PAR, 2502, "Can not open the community file : {}", community_file);
     }
-    while (community_file_input >> part_id) {
-      community_attr_.push_back(part_id);
-    }
-    community_file_input.close();
+    community_attr_.clear();
+    ReadIds(community_file_input, community_attr_);
     if (static_cast<int>(community_attr_.size()) != num_vertices_) {
       logger_->warn(PAR, 130, "Reset the community attributes to NONE.");
       community_attr_.clear();
     }
   }
+}
+
+// for hypergraph partitioning
+// Coarsen the hypergraph file out of core with StreamingCoarsener,
+// then the coarse hypergraph is partitioned as the original hypergraph.
+// The cluster of each vertex is stored in cluster_map_file
+void TritonPart::ReadStreamingHypergraph(const std::string& hypergraph_file,
+                                         const std::string& fixed_file,
+                                         const std::string& community_file,
+                                         const std::string& group_file,
+                                         const std::string& placement_file,
+                                         const std::string& cluster_map_file)
+{
+  if (!group_file.empty() || !placement_file.empty()) {
+    logger_->warn(PAR,
+                  235,
+                  "The group file and the placement file are ignored by the "
+                  "streaming coarsening.");
+  }
+  hyperedges_.clear();
+  vertex_weights_.clear();
+  hyperedge_weights_.clear();
+  fixed_attr_.clear();
+  community_attr_.clear();
+  group_attr_.clear();
+  placement_attr_.clear();
+
+  // the number of vertices is needed to check the attribute files
+  StreamingCoarsener coarsener(streaming_coarsening_ratio_,
+                               thr_coarsen_hyperedge_size_skip_,
+                               streaming_chunk_size_,
+                               logger_);
+  if (!fixed_file.empty() || !community_file.empty()) {
+    num_vertices_ = 0;
+    if (IsBinaryHypergraphFile(hypergraph_file) == true) {
+      BinaryFileReader hypergraph_file_input;
+      std::vector<int> header;
+      if (hypergraph_file_input.Open(hypergraph_file, true)) {
+        hypergraph_file_input.Seek(binary_hypergraph_magic.size());
+        if (hypergraph_file_input.Read(header, 10)) {
+          num_vertices_ = header[1];
+        }
+      }
+    } else {
+      // the second number in the first line
+      TextFileReader hypergraph_file_input;
+      int value = 0;
+      if (hypergraph_file_input.Open(hypergraph_file, streaming_chunk_size_)
+          && hypergraph_file_input.NextLine()
+          && hypergraph_file_input.NextInt(value)
+          && hypergraph_file_input.NextInt(value)) {
+        num_vertices_ = value;
+      }
+    }
+    ReadVertexAttributes(fixed_file, community_file);
+  }
+
+  int num_original_vertices = 0;
+  original_hypergraph_ = coarsener.Coarsen(hypergraph_file,
+                                           vertex_dimensions_,
+                                           hyperedge_dimensions_,
+                                           std::move(fixed_attr_),
+                                           std::move(community_attr_),
+                                           cluster_map_file,
+                                           num_original_vertices);
+  fixed_attr_.clear();
+  community_attr_.clear();
+  vertex_dimensions_ = original_hypergraph_->GetVertexDimensions();
+  hyperedge_dimensions_ = original_hypergraph_->GetHyperedgeDimensions();
+  placement_dimensions_ = 0;
+  num_vertices_ = original_hypergraph_->GetNumVertices();
+  num_hyperedges_ = original_hypergraph_->GetNumHyperedges();
+
+  // show the status of hypergraph
+  logger_->info(PAR, 2523, "Hypergraph Information**");
+  logger_->info(PAR, 236, "Original vertices = {}", num_original_vertices);
+  logger_->info(PAR, 2524, "Vertices = {}", num_vertices_);
+  logger_->info(PAR, 2525, "Hyperedges = {}", num_hyperedges_);
+}
+
+// for hypergraph partitioning
+// Read hypergraph from input files and related constraint files
+void TritonPart::ReadHypergraph(const std::string& hypergraph_file,
+                                const std::string& fixed_file,
+                                const std::string& community_file,
+                                const std::string& group_file,
+                                const std::string& placement_file)
+{
+  // read hypergraph file
+  // The binary hypergraph file is loaded directly,
+  // otherwise the file is in hMETIS format
+  hyperedges_.clear();
+  fixed_attr_.clear();
+  community_attr_.clear();
+  placement_attr_.clear();
+  std::vector<CsrOffset> eptr;
+  std::vector<int> eind;
+  if (IsBinaryHypergraphFile(hypergraph_file) == true) {
+    ReadBinaryHypergraph(hypergraph_file, eptr, eind);
+  } else {
+    ReadTextHypergraph(hypergraph_file, eptr, eind);
+  }
+
+  // Read fixed vertices and community file
+  // (the files override the binary hypergraph file)
+  ReadVertexAttributes(fixed_file, community_file);
 
   // read group file
   if (!group_file.empty()) {
-    std::ifstream group_file_input(group_file);
-    if (!group_file_input.is_open()) {
+    TextFileReader group_file_input;
+    if (!group_file_input.Open(group_file)) {
       logger_->error(PAR, 2503, "Can not open the group file : {}", group_file);
     }
     group_attr_.clear();
-    std::string cur_line;
-    while (std::getline(group_file_input, cur_line)) {
-      std::istringstream cur_line_buf(cur_line);
-      std::vector<int> group_info{std::istream_iterator<int>(cur_line_buf),
-                                  std::istream_iterator<int>()};
-      // reduce by 1 because definition of hMETIS
-      for (auto& value : group_info) {
-        value--;
+    int value = 0;
+    while (group_file_input.NextLine()) {
+      std::vector<int> group_info;
+      while (group_file_input.NextInt(value)) {
+        // reduce by 1 because definition of hMETIS
+        group_info.push_back(value - 1);
       }
       if (group_info.size() > 1) {
         group_attr_.push_back(group_info);
       }
     }
-    group_file_input.close();
   }
 
   // Read placement file
   if (!placement_file.empty()) {
-    std::ifstream placement_file_input(placement_file);
-    if (!placement_file_input.is_open()) {
+    TextFileReader placement_file_input;
+    if (!placement_file_input.Open(placement_file)) {
       logger_->error(
           PAR, 2504, "Can not open the placement file : {}", placement_file);
     }
-    std::string cur_line;
     // We assume the embedding has been normalized
     const float max_placement_value
         = 1.0;  // we assume the embedding has been normalized,
@@ -1161,17 +2052,18 @@ void TritonPart::ReadHypergraph(const std::string& hypergraph_file,
                   // is invalid
     const float default_placement_value = 0.0;  // default placement value
     std::vector<std::vector<float>> temp_placement_attr;
-    while (std::getline(placement_file_input, cur_line)) {
-      std::vector<std::string> elements = SplitLine(
-          cur_line);  // split the line based on deliminator empty space, ','
+    while (placement_file_input.NextLine()) {
+      // split the line based on deliminator empty space, ','
+      std::string_view ele;
       std::vector<float> vertex_placement;
-      for (auto& ele : elements) {
+      while (placement_file_input.NextToken(ele)) {
         if (ele == "NaN" || ele == "nan" || ele == "NAN") {
           vertex_placement.push_back(default_placement_value);
         } else {
-          const float ele_value = std::stof(ele);
+          // the element is always followed by a deliminator or '\0'
+          const float ele_value = std::strtof(ele.data(), nullptr);
           if (std::abs(ele_value) < invalid_placement_thr) {
-            vertex_placement.push_back(std::stof(ele));
+            vertex_placement.push_back(ele_value);
           } else {
             vertex_placement.push_back(default_placement_value);
           }
@@ -1179,7 +2071,6 @@ void TritonPart::ReadHypergraph(const std::string& hypergraph_file,
       }
       temp_placement_attr.push_back(vertex_placement);
     }
-    placement_file_input.close();
     // Here comes the very important part for placement-driven clustering
     // Since we have so many vertices, the embedding value for each single
     // vertex usually very small, around e-5 - e-7 So we need to normalize the
@@ -1194,6 +2085,7 @@ void TritonPart::ReadHypergraph(const std::string& hypergraph_file,
     mean_placement_value_list = DivideFactor(mean_placement_value_list,
                                              temp_placement_attr.size() * 1.0);
     // perform normalization
+    placement_attr_.clear();
     for (auto& emb : temp_placement_attr) {
       placement_attr_.push_back(
           DivideVectorElebyEle(emb, mean_placement_value_list));
@@ -1209,7 +2101,8 @@ void TritonPart::ReadHypergraph(const std::string& hypergraph_file,
   original_hypergraph_ = std::make_shared<Hypergraph>(vertex_dimensions_,
                                                       hyperedge_dimensions_,
                                                       placement_dimensions_,
-                                                      hyperedges_,
+                                                      std::move(eptr),
+                                                      std::move(eind),
                                                       vertex_weights_,
                                                       hyperedge_weights_,
                                                       fixed_attr_,
@@ -1234,42 +2127,48 @@ void TritonPart::ReadNetlist(const std::string& fixed_file,
                              const std::string& community_file,
                              const std::string& group_file)
 {
-  // assign vertex_id property of each instance and each IO port
-  // the vertex_id property will be removed after the partitioning
+  // assign vertex_id to each instance and each IO port.
+  // The vertex ids are stored in tables indexed by the OpenDB ids,
+  // -1 means that the instance (IO port) is not used by the partitioner
+  unsigned int max_inst_id = 0;
+  for (auto inst : block_->getInsts()) {
+    max_inst_id = std::max(max_inst_id, inst->getId());
+  }
+  unsigned int max_bterm_id = 0;
+  for (auto term : block_->getBTerms()) {
+    max_bterm_id = std::max(max_bterm_id, term->getId());
+  }
+  inst_vertex_id_.assign(max_inst_id + 1, -1);
+  bterm_vertex_id_.assign(max_bterm_id + 1, -1);
   vertex_weights_.clear();
   vertex_types_.clear();
   fixed_attr_.clear();
   community_attr_.clear();
   group_attr_.clear();
   placement_attr_.clear();
+  // the instance (or the IO port) of each vertex
+  std::vector<odb::dbInst*> vertex_insts;
+  std::vector<odb::dbBTerm*> vertex_bterms;
   // traverse all the instances
   int vertex_id = 0;
   // check if the fence constraint is specified
   if (fence_flag_ == true) {
     // check IO ports
     for (auto term : block_->getBTerms()) {
-      // -1 means that the instance is not used by the partitioner
-      odb::dbIntProperty::create(term, "vertex_id", -1);
       odb::Rect box = term->getBBox();
       if (box.xMin() >= fence_.lx && box.xMax() <= fence_.ux
           && box.yMin() >= fence_.ly && box.yMax() <= fence_.uy) {
-        odb::dbIntProperty::create(term, "vertex_id", vertex_id++);
         std::vector<float> vwts(vertex_dimensions_,
                                 0.0);  // IO port has no area
         vertex_weights_.emplace_back(vwts);
         vertex_types_.emplace_back(PORT);
-        odb::dbIntProperty::find(term, "vertex_id")->setValue(vertex_id++);
-        if (placement_flag_ == true) {
-          std::vector<float> loc{(box.xMin() + box.xMax()) / 2.0f,
-                                 (box.yMin() + box.yMax()) / 2.0f};
-          placement_attr_.emplace_back(loc);
-        }
+        bterm_vertex_id_[term->getId()] = vertex_id++;
+        vertex_insts.push_back(nullptr);
+        vertex_bterms.push_back(term);
       }
     }
     // check instances
     for (auto inst : block_->getInsts()) {
-      // -1 means that the instance is not used by the partitioner
-      odb::dbIntProperty::create(inst, "vertex_id", -1);
       const sta::LibertyCell* liberty_cell = network_->libertyCell(inst);
       if (liberty_cell == nullptr) {
         continue;  // ignore the instance with no liberty
@@ -1293,31 +2192,22 @@ void TritonPart::ReadNetlist(const std::string& fixed_file,
         } else {
           vertex_types_.emplace_back(COMB_STD_CELL);
         }
-        if (placement_flag_ == true) {
-          std::vector<float> loc{(box->xMin() + box->xMax()) / 2.0f,
-                                 (box->yMin() + box->yMax()) / 2.0f};
-          placement_attr_.emplace_back(loc);
-        }
-        odb::dbIntProperty::find(inst, "vertex_id")->setValue(vertex_id++);
+        inst_vertex_id_[inst->getId()] = vertex_id++;
+        vertex_insts.push_back(inst);
+        vertex_bterms.push_back(nullptr);
       }
     }
   } else {
     for (auto term : block_->getBTerms()) {
-      odb::dbIntProperty::create(term, "vertex_id", vertex_id++);
+      bterm_vertex_id_[term->getId()] = vertex_id++;
       vertex_types_.emplace_back(PORT);
       std::vector<float> vwts(vertex_dimensions_, 0.0);
       vertex_weights_.push_back(vwts);
-      if (placement_flag_ == true) {
-        odb::Rect box = term->getBBox();
-        std::vector<float> loc{(box.xMin() + box.xMax()) / 2.0f,
-                               (box.yMin() + box.yMax()) / 2.0f};
-        placement_attr_.emplace_back(loc);
-      }
+      vertex_insts.push_back(nullptr);
+      vertex_bterms.push_back(term);
     }
 
     for (auto inst : block_->getInsts()) {
-      // -1 means that the instance is not used by the partitioner
-      odb::dbIntProperty::create(inst, "vertex_id", -1);
       const sta::LibertyCell* liberty_cell = network_->libertyCell(inst);
       if (liberty_cell == nullptr) {
         continue;  // ignore the instance with no liberty
@@ -1337,18 +2227,68 @@ void TritonPart::ReadNetlist(const std::string& fixed_file,
       } else {
         vertex_types_.emplace_back(COMB_STD_CELL);
       }
-      odb::dbIntProperty::find(inst, "vertex_id")->setValue(vertex_id++);
-      if (placement_flag_ == true) {
-        odb::dbBox* box = inst->getBBox();
-        std::vector<float> loc{(box->xMin() + box->xMax()) / 2.0f,
-                               (box->yMin() + box->yMax()) / 2.0f};
-        placement_attr_.emplace_back(loc);
-      }
+      inst_vertex_id_[inst->getId()] = vertex_id++;
+      vertex_insts.push_back(inst);
+      vertex_bterms.push_back(nullptr);
     }
   }
 
   num_vertices_ = vertex_id;
 
+  // run func(begin, end) on contiguous chunks of [0, num_items) in parallel
+  auto lambda_parallel_chunks
+      = [&](int num_items, const std::function<void(int, int)>& func) -> void {
+    const int num_threads = std::max(1, std::min(num_threads_, num_items));
+    const int chunk_size = (num_items + num_threads - 1) / num_threads;
+    auto lambda_run_chunk = [&](int chunk_id) -> void {
+      func(std::min(num_items, chunk_id * chunk_size),
+           std::min(num_items, (chunk_id + 1) * chunk_size));
+    };
+    ThreadPool(num_threads).ParallelFor(num_threads, lambda_run_chunk);
+  };
+
+  // The placement locations are read from OpenDB directly, i.e., the
+  // center of each placed instance (IO port), normalized to the die area.
+  // The unplaced instances (IO ports) are put at the center of the die
+  if (placement_flag_ == true) {
+    const odb::Rect die = block_->getDieArea();
+    const float die_width = std::max(1, die.dx());
+    const float die_height = std::max(1, die.dy());
+    placement_attr_.resize(num_vertices_);
+    std::atomic<int> num_unplaced_vertices = 0;
+    lambda_parallel_chunks(num_vertices_, [&](int begin, int end) {
+      int num_unplaced = 0;
+      for (int v = begin; v < end; v++) {
+        odb::Rect box;
+        bool placed = false;
+        if (vertex_insts[v] != nullptr) {
+          placed = vertex_insts[v]->getPlacementStatus().isPlaced();
+          box = vertex_insts[v]->getBBox()->getBox();
+        } else {
+          placed = vertex_bterms[v]->getFirstPinPlacementStatus().isPlaced();
+          box = vertex_bterms[v]->getBBox();
+        }
+        if (placed == false) {
+          num_unplaced++;
+          placement_attr_[v] = {0.5f, 0.5f};
+          continue;
+        }
+        placement_attr_[v]
+            = {((box.xMin() + box.xMax()) / 2.0f - die.xMin()) / die_width,
+               ((box.yMin() + box.yMax()) / 2.0f - die.yMin()) / die_height};
+      }
+      num_unplaced_vertices += num_unplaced;
+    });
+    if (num_unplaced_vertices > 0) {
+      logger_->warn(PAR,
+                    232,
+                    "{} of {} vertices are not placed. They are put at the "
+                    "center of the die.",
+                    num_unplaced_vertices.load(),
+                    num_vertices_);
+    }
+  }
+
   // read fixed instance file
   if (fixed_file.empty() == false) {
     std::ifstream file_input(fixed_file);
@@ -1366,8 +2306,7 @@ void TritonPart::ReadNetlist(const std::string& fixed_file,
         ss >> inst_name;
         ss >> partition_id;
         auto db_inst = block_->findInst(inst_name.c_str());
-        const int vertex_id
-            = odb::dbIntProperty::find(db_inst, "vertex_id")->getValue();
+        const int vertex_id = GetVertexId(db_inst);
         if (vertex_id > -1) {
           fixed_attr_[vertex_id] = partition_id;
         }
@@ -1393,8 +2332,7 @@ void TritonPart::ReadNetlist(const std::string& fixed_file,
         ss >> inst_name;
         ss >> partition_id;
         auto db_inst = block_->findInst(inst_name.c_str());
-        const int vertex_id
-            = odb::dbIntProperty::find(db_inst, "vertex_id")->getValue();
+        const int vertex_id = GetVertexId(db_inst);
         if (vertex_id > -1) {
           community_attr_[vertex_id] = partition_id;
         }
@@ -1417,8 +2355,7 @@ void TritonPart::ReadNetlist(const std::string& fixed_file,
         std::vector<int> inst_group;
         while (ss >> inst_name) {
           auto db_inst = block_->findInst(inst_name.c_str());
-          const int vertex_id
-              = odb::dbIntProperty::find(db_inst, "vertex_id")->getValue();
+          const int vertex_id = GetVertexId(db_inst);
           if (vertex_id > -1) {
             inst_group.push_back(vertex_id);
           }
@@ -1434,67 +2371,117 @@ void TritonPart::ReadNetlist(const std::string& fixed_file,
   // Check all the hyperedges,
   // we do not check the parallel hyperedges
   // because we need to consider timing graph
+  // The hyperedges are built in compressed sparse row format (eptr, eind)
+  // directly. The nets are split into chunks which are traversed by
+  // multiple threads in two passes: (1) count the vertices of each
+  // hyperedge, (2) fill the vertices of each hyperedge.
   hyperedges_.clear();
   hyperedge_weights_.clear();
-  // Each net correponds to an hyperedge
-  // Traverse the hyperedge and assign hyperedge_id to each net
-  // the hyperedge_id property will be removed after partitioning
-  int hyperedge_id = 0;
+  std::vector<odb::dbNet*> nets;
+  unsigned int max_net_id = 0;
   for (auto net : block_->getNets()) {
-    odb::dbIntProperty::create(net, "hyperedge_id", -1);
+    nets.push_back(net);
+    max_net_id = std::max(max_net_id, net->getId());
+  }
+  const int num_nets = static_cast<int>(nets.size());
+
+  // get the vertices of the hyperedge corresponding to the net
+  // the driver is the first vertex
+  auto lambda_get_hyperedge = [&](odb::dbNet* net,
+                                  std::vector<int>& hyperedge) -> void {
+    hyperedge.clear();
     // ignore all the power net
     if (net->getSigType().isSupply()) {
-      continue;
+      return;
     }
     // check the hyperedge
-    int driver_id = -1;      // vertex id of the driver instance
-    std::set<int> loads_id;  // vertex id of sink instances
+    int driver_id = -1;  // vertex id of the driver instance
     // check the connected instances
     for (odb::dbITerm* iterm : net->getITerms()) {
-      odb::dbInst* inst = iterm->getInst();
-      const int vertex_id
-          = odb::dbIntProperty::find(inst, "vertex_id")->getValue();
+      const int vertex_id = GetVertexId(iterm->getInst());
       if (vertex_id == -1) {
         continue;  // the current instance is not used
       }
       if (iterm->getIoType() == odb::dbIoType::OUTPUT) {
         driver_id = vertex_id;
       } else {
-        loads_id.insert(vertex_id);
+        hyperedge.push_back(vertex_id);
       }
     }
     // check the connected IO pins
     for (odb::dbBTerm* bterm : net->getBTerms()) {
-      const int vertex_id
-          = odb::dbIntProperty::find(bterm, "vertex_id")->getValue();
+      const int vertex_id = GetVertexId(bterm);
       if (vertex_id == -1) {
         continue;  // the current bterm is not used
       }
       if (bterm->getIoType() == odb::dbIoType::INPUT) {
         driver_id = vertex_id;
       } else {
-        loads_id.insert(vertex_id);
+        hyperedge.push_back(vertex_id);
       }
     }
-    // check the hyperedges
-    std::vector<int> hyperedge;
-    if (driver_id != -1 && !loads_id.empty()) {
-      hyperedge.push_back(driver_id);
-      for (auto& load_id : loads_id) {
-        if (load_id != driver_id) {
-          hyperedge.push_back(load_id);
-        }
+    if (driver_id == -1 || hyperedge.empty() == true) {
+      hyperedge.clear();
+      return;
+    }
+    // sort the loads and remove the duplicated loads and the driver
+    std::sort(hyperedge.begin(), hyperedge.end());
+    hyperedge.erase(std::unique(hyperedge.begin(), hyperedge.end()),
+                    hyperedge.end());
+    hyperedge.erase(
+        std::remove(hyperedge.begin(), hyperedge.end(), driver_id),
+        hyperedge.end());
+    hyperedge.insert(hyperedge.begin(), driver_id);
+    // Ignore all the single-vertex hyperedge
+    if (hyperedge.size() <= 1) {
+      hyperedge.clear();
+    }
+  };
+
+  // traverse all the nets in parallel
+  // each thread works on a contiguous chunk of nets
+  auto lambda_traverse_nets
+      = [&](const std::function<void(int, std::vector<int>&)>& func) -> void {
+    lambda_parallel_chunks(num_nets, [&](int begin, int end) {
+      std::vector<int> hyperedge;
+      for (int i = begin; i < end; i++) {
+        lambda_get_hyperedge(nets[i], hyperedge);
+        func(i, hyperedge);
       }
+    });
+  };
+
+  // Pass 1: count the number of vertices in each hyperedge
+  std::vector<int> net_sizes(num_nets, 0);
+  lambda_traverse_nets([&](int i, std::vector<int>& hyperedge) {
+    net_sizes[i] = static_cast<int>(hyperedge.size());
+  });
+
+  // Each net correponds to an hyperedge
+  // Traverse the hyperedge and assign hyperedge_id to each net
+  // -1 means that the net is not used by the partitioner
+  net_hyperedge_id_.assign(max_net_id + 1, -1);
+  std::vector<CsrOffset> eptr{0};
+  for (int i = 0; i < num_nets; i++) {
+    if (net_sizes[i] > 0) {
+      net_hyperedge_id_[nets[i]->getId()] = static_cast<int>(eptr.size()) - 1;
+      eptr.push_back(eptr.back() + net_sizes[i]);
     }
-    // Ignore all the single-vertex hyperedge and large global netthreshold
-    // if (hyperedge.size() > 1 && hyperedge.size() <= global_net_threshold_) {
-    if (hyperedge.size() > 1) {
-      hyperedges_.push_back(hyperedge);
-      hyperedge_weights_.emplace_back(hyperedge_dimensions_, 1.0);
-      odb::dbIntProperty::find(net, "hyperedge_id")->setValue(hyperedge_id++);
+  }
+  num_hyperedges_ = static_cast<int>(eptr.size()) - 1;
+  hyperedge_weights_.resize(num_hyperedges_,
+                            std::vector<float>(hyperedge_dimensions_, 1.0));
+
+  // Pass 2: fill the vertices of each hyperedge
+  std::vector<int> eind(eptr.back());
+  lambda_traverse_nets([&](int i, std::vector<int>& hyperedge) {
+    if (hyperedge.empty() == false) {
+      const int hyperedge_id = net_hyperedge_id_[nets[i]->getId()];
+      std::copy(hyperedge.begin(),
+                hyperedge.end(),
+                eind.begin() + eptr[hyperedge_id]);
     }
-  }  // finish hyperedge
-  num_hyperedges_ = static_cast<int>(hyperedges_.size());
+  });
 
   // add timing features
   if (timing_aware_flag_ == true) {
@@ -1507,17 +2494,18 @@ void TritonPart::ReadNetlist(const std::string& fixed_file,
   }
 
   // build the timing graph
-  // map each net to the timing arc in the timing graph
-  std::vector<std::set<int>> hyperedges_arc_set;
-  for (int e = 0; e < num_hyperedges_; e++) {
-    const std::set<int> arc_set{e};
-    hyperedges_arc_set.push_back(arc_set);
-  }
+  // map each net to the timing arc in the timing graph, i.e.,
+  // the hyperedge e consists of the single arc e
+  std::vector<CsrOffset> arc_ptr(num_hyperedges_ + 1);
+  std::iota(arc_ptr.begin(), arc_ptr.end(), 0);
+  std::vector<int> arc_ind(num_hyperedges_);
+  std::iota(arc_ind.begin(), arc_ind.end(), 0);
 
   original_hypergraph_ = std::make_shared<Hypergraph>(vertex_dimensions_,
                                                       hyperedge_dimensions_,
                                                       placement_dimensions_,
-                                                      hyperedges_,
+                                                      std::move(eptr),
+                                                      std::move(eind),
                                                       vertex_weights_,
                                                       hyperedge_weights_,
                                                       fixed_attr_,
@@ -1525,7 +2513,8 @@ void TritonPart::ReadNetlist(const std::string& fixed_file,
                                                       placement_attr_,
                                                       vertex_types_,
                                                       hyperedge_slacks_,
-                                                      hyperedges_arc_set,
+                                                      std::move(arc_ptr),
+                                                      std::move(arc_ind),
                                                       timing_paths_,
                                                       logger_);
   // show the status of hypergraph
@@ -1537,17 +2526,185 @@ void TritonPart::ReadNetlist(const std::string& fixed_file,
   logger_->info(PAR, 177, "Number of timing paths = {}", timing_paths_.size());
 }
 
+// get the vertex id of an instance (-1 if the instance is not used)
+int TritonPart::GetVertexId(odb::dbInst* inst) const
+{
+  if (inst == nullptr || inst->getId() >= inst_vertex_id_.size()) {
+    return -1;
+  }
+  return inst_vertex_id_[inst->getId()];
+}
+
+// get the vertex id of an IO port (-1 if the IO port is not used)
+int TritonPart::GetVertexId(odb::dbBTerm* bterm) const
+{
+  if (bterm == nullptr || bterm->getId() >= bterm_vertex_id_.size()) {
+    return -1;
+  }
+  return bterm_vertex_id_[bterm->getId()];
+}
+
+// get the hyperedge id of a net (-1 if the net is not used)
+int TritonPart::GetHyperedgeId(odb::dbNet* net) const
+{
+  if (net == nullptr || net->getId() >= net_hyperedge_id_.size()) {
+    return -1;
+  }
+  return net_hyperedge_id_[net->getId()];
+}
+
+void TritonPart::ReadWarmStartSolution()
+{
+  const int num_vertices = original_hypergraph_->GetNumVertices();
+  warm_start_solution_.clear();
+  warm_start_solution_.resize(num_vertices, -1);
+  auto lambda_read = [&](int vertex_id, odb::dbObject* object) -> void {
+    if (vertex_id == -1) {
+      return;  // This object is not used
+    }
+    if (auto property = odb::dbIntProperty::find(object, "partition_id")) {
+      const int partition_id = property->getValue();
+      if (partition_id >= 0 && partition_id < num_parts_) {
+        warm_start_solution_[vertex_id] = partition_id;
+      }
+    }
+  };
+  for (auto term : block_->getBTerms()) {
+    lambda_read(GetVertexId(term), term);
+  }
+  for (auto inst : block_->getInsts()) {
+    lambda_read(GetVertexId(inst), inst);
+  }
+
+  const int num_changed_vertices = std::count(
+      warm_start_solution_.begin(), warm_start_solution_.end(), -1);
+  if (num_changed_vertices == num_vertices) {
+    logger_->warn(PAR,
+                  200,
+                  "No valid partition_id is found for the warm start. "
+                  "Partition the design from scratch.");
+    warm_start_solution_.clear();
+    return;
+  }
+  logger_->info(PAR,
+                201,
+                "Warm start : {} out of {} vertices have no valid partition_id",
+                num_changed_vertices,
+                num_vertices);
+}
+
+std::vector<int> TritonPart::PrepareWarmStart()
+{
+  const HGraphPtr& hgraph = original_hypergraph_;
+  const int num_vertices = hgraph->GetNumVertices();
+  // the fixed vertices always stay in their blocks
+  if (hgraph->HasFixedVertices() == true) {
+    for (int v = 0; v < num_vertices; v++) {
+      if (hgraph->GetFixedAttr(v) >= 0) {
+        warm_start_solution_[v] = hgraph->GetFixedAttr(v);
+      }
+    }
+  }
+
+  // Breadth-first search from the changed vertices.
+  // The large hyperedges are skipped, otherwise the refined region
+  // may cover most of the design.
+  auto lambda_skip = [&](int e) -> bool {
+    return static_cast<int>(hgraph->Vertices(e).size())
+           > thr_coarsen_hyperedge_size_skip_;
+  };
+  std::vector<int> distance(num_vertices, -1);
+  std::vector<int> visited_vertices;  // in the order of distance
+  for (int v = 0; v < num_vertices; v++) {
+    if (warm_start_solution_[v] == -1) {
+      distance[v] = 0;
+      visited_vertices.push_back(v);
+    }
+  }
+  for (size_t i = 0; i < visited_vertices.size(); i++) {
+    const int v = visited_vertices[i];
+    if (distance[v] >= warm_start_hops_) {
+      continue;
+    }
+    for (const int e : hgraph->Edges(v)) {
+      if (lambda_skip(e) == true) {
+        continue;
+      }
+      for (const int u : hgraph->Vertices(e)) {
+        if (distance[u] == -1) {
+          distance[u] = distance[v] + 1;
+          visited_vertices.push_back(u);
+        }
+      }
+    }
+  }
+
+  // Assign each changed vertex to the block with the most connections.
+  // If it is not connected to any assigned vertex, use the lightest block
+  Matrix<float> block_balance(
+      num_parts_, std::vector<float>(hgraph->GetVertexDimensions(), 0.0f));
+  for (int v = 0; v < num_vertices; v++) {
+    if (warm_start_solution_[v] >= 0) {
+      Accumulate(block_balance[warm_start_solution_[v]],
+                 hgraph->GetVertexWeights(v));
+    }
+  }
+  std::vector<float> connections(num_parts_, 0.0f);
+  for (const int v : visited_vertices) {
+    if (warm_start_solution_[v] >= 0) {
+      continue;
+    }
+    std::fill(connections.begin(), connections.end(), 0.0f);
+    for (const int e : hgraph->Edges(v)) {
+      if (lambda_skip(e) == true) {
+        continue;
+      }
+      for (const int u : hgraph->Vertices(e)) {
+        if (warm_start_solution_[u] >= 0) {
+          connections[warm_start_solution_[u]]
+              += hgraph->GetHyperedgeWeights(e).front();
+        }
+      }
+    }
+    int best_block_id
+        = std::min_element(block_balance.begin(), block_balance.end())
+          - block_balance.begin();
+    for (int block_id = 0; block_id < num_parts_; block_id++) {
+      if (connections[block_id] > connections[best_block_id]) {
+        best_block_id = block_id;
+      }
+    }
+    warm_start_solution_[v] = best_block_id;
+    Accumulate(block_balance[best_block_id], hgraph->GetVertexWeights(v));
+  }
+
+  // Only the vertices around the changed vertices can be moved
+  std::vector<int> fixed_attr(num_vertices, -1);
+  int num_free_vertices = 0;
+  for (int v = 0; v < num_vertices; v++) {
+    if (distance[v] == -1
+        || (hgraph->HasFixedVertices() == true
+            && hgraph->GetFixedAttr(v) >= 0)) {
+      fixed_attr[v] = warm_start_solution_[v];
+    } else {
+      num_free_vertices++;
+    }
+  }
+  logger_->info(PAR,
+                202,
+                "Warm start : refine {} vertices around the changed vertices",
+                num_free_vertices);
+  return fixed_attr;
+}
+
 // Find all the critical timing paths
 // The codes below similar to gui/src/staGui.cpp
 // Please refer to sta/Search/ReportPath.cc for how to check the timing path
 // Currently we can only consider single-clock design
 // TODO:  how to handle multi-clock design
-void TritonPart::BuildTimingPaths()
+// Extract the top_n critical timing paths and the slack of each net from STA
+void TritonPart::ExtractStaTimingPaths(TimingPathsCache& timing_paths_cache)
 {
-  if (timing_aware_flag_ == false || top_n_ <= 0) {
-    logger_->warn(PAR, 136, "Timing driven partitioning is disabled");
-    return;
-  }
   sta_->ensureGraph();     // Ensure that the timing graph has been built
   sta_->searchPreamble();  // Make graph and find delays
   sta_->ensureLevelized();
@@ -1612,21 +2769,17 @@ void TritonPart::BuildTimingPaths()
       false);
 
   // check all the timing paths
+  std::vector<StaTimingPath> timing_paths;
   for (auto& path_end : path_ends) {
     // Printing timing paths to logger
     // sta_->reportPathEnd(path_end);
     auto* path = path_end->path();
-    TimingPath timing_path;                     // create the timing path
-    const float slack = path_end->slack(sta_);  // slack information
-    // TODO: to be deleted.  We should not
-    // normalize the slack according to the clock period for multi-clock design
-    const float clock_period = path_end->targetClk(sta_)->period();
-    maximum_clock_period_ = std::max(maximum_clock_period_, clock_period);
-    timing_path.slack = slack;
-    // logger_->report("clock_period = {}, slack = {}", maximum_clock_period_,
-    // timing_path.slack);
+    StaTimingPath timing_path;                  // create the timing path
+    timing_path.slack = path_end->slack(sta_);  // slack information
+    timing_path.clock_period = path_end->targetClk(sta_)->period();
     sta::PathExpanded expand(path, sta_);
     expand.path(expand.size() - 1);
+    timing_path.pins.reserve(expand.size());
     for (size_t i = 0; i < expand.size(); i++) {
       // PathRef is reference to a path vertex
       sta::PathRef* ref = expand.path(i);
@@ -1637,58 +2790,113 @@ void TritonPart::BuildTimingPaths()
       if (net == nullptr) {
         continue;  // check if the net exists
       }
+      // The sta objects are converted to OpenDB objects directly,
+      // instead of looking up the OpenDB objects by their names
+      StaTimingPin timing_pin;
       if (network_->isTopLevelPort(pin) == true) {
-        auto bterm = block_->findBTerm(network_->pathName(pin));
-        const int vertex_id
-            = odb::dbIntProperty::find(bterm, "vertex_id")->getValue();
-        if (vertex_id == -1) {
-          continue;
-        }
-        if (timing_path.path.empty() == true
-            || timing_path.path.back() != vertex_id) {
-          timing_path.path.push_back(vertex_id);
-        }
+        odb::dbITerm* iterm = nullptr;
+        network_->staToDb(pin, iterm, timing_pin.bterm);
       } else {
-        auto inst = network_->instance(pin);
-        auto db_inst = block_->findInst(network_->pathName(inst));
-        const int vertex_id
-            = odb::dbIntProperty::find(db_inst, "vertex_id")->getValue();
-        if (vertex_id == -1) {
-          continue;
-        }
-        if (timing_path.path.empty() == true
-            || timing_path.path.back() != vertex_id) {
-          timing_path.path.push_back(vertex_id);
-        }
-      }
-      auto db_net = block_->findNet(
-          network_->pathName(net));  // convert sta::Net* to dbNet*
-      const int hyperedge_id
-          = odb::dbIntProperty::find(db_net, "hyperedge_id")->getValue();
-      if (hyperedge_id == -1) {
-        continue;
+        timing_pin.inst = network_->staToDb(network_->instance(pin));
       }
-      timing_path.arcs.push_back(hyperedge_id);
+      timing_pin.net = network_->staToDb(net);  // convert sta::Net* to dbNet*
+      timing_path.pins.push_back(timing_pin);
     }
-    // add timing path
-    if (!timing_path.arcs.empty()) {
-      timing_paths_.push_back(timing_path);
+    timing_paths.push_back(std::move(timing_path));
+  }
+
+  // check the slack on each net
+  std::vector<std::pair<odb::dbNet*, float>> net_slacks;
+  for (auto db_net : block_->getNets()) {
+    if (db_net->getSigType().isSupply()) {
+      continue;  // the power nets are not used
     }
+    sta::Net* net = network_->dbToSta(db_net);
+    net_slacks.emplace_back(db_net, sta_->netSlack(net, sta::MinMax::max()));
+  }
+
+  timing_paths_cache.Update(
+      block_, top_n_, std::move(timing_paths), std::move(net_slacks));
+}
+
+void TritonPart::BuildTimingPaths()
+{
+  if (timing_aware_flag_ == false || top_n_ <= 0) {
+    logger_->warn(PAR, 136, "Timing driven partitioning is disabled");
+    return;
+  }
+  // The timing paths extracted by the previous run are reused if the
+  // netlist has not been changed
+  TimingPathsCache local_timing_paths_cache;
+  TimingPathsCache& timing_paths_cache = timing_paths_cache_ != nullptr
+                                             ? *timing_paths_cache_
+                                             : local_timing_paths_cache;
+  if (timing_paths_cache.IsValid(block_, top_n_) == true) {
+    logger_->info(PAR,
+                  192,
+                  "Reuse {} timing paths extracted by the previous run",
+                  timing_paths_cache.GetTimingPaths().size());
+  } else {
+    ExtractStaTimingPaths(timing_paths_cache);
   }
 
   // normalize all the slack
+  // TODO: to be deleted.  We should not
+  // normalize the slack according to the clock period for multi-clock design
+  const std::vector<StaTimingPath>& sta_timing_paths
+      = timing_paths_cache.GetTimingPaths();
+  for (const auto& sta_timing_path : sta_timing_paths) {
+    maximum_clock_period_
+        = std::max(maximum_clock_period_, sta_timing_path.clock_period);
+  }
   logger_->info(
       PAR, 178, "maximum_clock_period : {} second", maximum_clock_period_);
   extra_delay_ = extra_delay_ / maximum_clock_period_;
   logger_->info(PAR, 179, "normalized extra delay : {}", extra_delay_);
-  if (guardband_flag_ == false) {
-    for (auto& timing_path : timing_paths_) {
-      timing_path.slack = timing_path.slack / maximum_clock_period_;
-    }
-  } else {
-    for (auto& timing_path : timing_paths_) {
+  const float slack_offset = guardband_flag_ == true ? extra_delay_ : 0.0f;
+
+  // map the timing paths to the vertices and hyperedges in parallel.
+  // Each path is written to its own slot, so the threads share nothing
+  const int num_sta_timing_paths = static_cast<int>(sta_timing_paths.size());
+  std::vector<TimingPath> timing_paths(num_sta_timing_paths);
+  auto lambda_map_paths = [&](int chunk_id, int chunk_size) -> void {
+    const int end = std::min(num_sta_timing_paths, (chunk_id + 1) * chunk_size);
+    for (int path_id = chunk_id * chunk_size; path_id < end; path_id++) {
+      const StaTimingPath& sta_timing_path = sta_timing_paths[path_id];
+      TimingPath& timing_path = timing_paths[path_id];
       timing_path.slack
-          = timing_path.slack / maximum_clock_period_ - extra_delay_;
+          = sta_timing_path.slack / maximum_clock_period_ - slack_offset;
+      timing_path.path.reserve(sta_timing_path.pins.size());
+      timing_path.arcs.reserve(sta_timing_path.pins.size());
+      for (const auto& timing_pin : sta_timing_path.pins) {
+        const int vertex_id = timing_pin.bterm != nullptr
+                                  ? GetVertexId(timing_pin.bterm)
+                                  : GetVertexId(timing_pin.inst);
+        if (vertex_id == -1) {
+          continue;
+        }
+        if (timing_path.path.empty() == true
+            || timing_path.path.back() != vertex_id) {
+          timing_path.path.push_back(vertex_id);
+        }
+        const int hyperedge_id = GetHyperedgeId(timing_pin.net);
+        if (hyperedge_id == -1) {
+          continue;
+        }
+        timing_path.arcs.push_back(hyperedge_id);
+      }
+    }
+  };
+  const int num_threads
+      = std::max(1, std::min(num_threads_, num_sta_timing_paths));
+  const int chunk_size = (num_sta_timing_paths + num_threads - 1) / num_threads;
+  ThreadPool(num_threads).ParallelFor(num_threads, [&](int chunk_id) {
+    lambda_map_paths(chunk_id, chunk_size);
+  });
+  // add timing path
+  for (auto& timing_path : timing_paths) {
+    if (!timing_path.arcs.empty()) {
+      timing_paths_.push_back(std::move(timing_path));
     }
   }
   logger_->info(PAR,
@@ -1707,14 +2915,11 @@ void TritonPart::BuildTimingPaths()
       "We normalized the slack of each net based on maximum clock period");
   int num_unconstrained_hyperedges = 0;
   // check the slack on each net
-  for (auto db_net : block_->getNets()) {
-    const int hyperedge_id
-        = odb::dbIntProperty::find(db_net, "hyperedge_id")->getValue();
+  for (const auto& [db_net, slack] : timing_paths_cache.GetNetSlacks()) {
+    const int hyperedge_id = GetHyperedgeId(db_net);
     if (hyperedge_id == -1) {
       continue;  // this net is not used
     }
-    sta::Net* net = network_->dbToSta(db_net);
-    const float slack = sta_->netSlack(net, sta::MinMax::max());
     // set the slack of unconstrained net to max_clock_period_
     if (slack > maximum_clock_period_) {
       num_unconstrained_hyperedges++;
@@ -1782,6 +2987,43 @@ void TritonPart::MultiLevelPartition()
                 "hyperedge weight factor : [ {} ]",
                 GetVectorString(e_wt_factors_));
 
+  // use the spectral embedding as placement information
+  if (spectral_dimensions_ > 0
+      && original_hypergraph_->HasPlacement() == false) {
+    // the weight of each edge in the clique expansion of a hyperedge
+    std::vector<float> edge_weights(original_hypergraph_->GetNumHyperedges(),
+                                    0.0f);
+    for (int e = 0; e < original_hypergraph_->GetNumHyperedges(); e++) {
+      const int he_size = original_hypergraph_->Vertices(e).size();
+      if (he_size > 1) {
+        const FloatView weights = original_hypergraph_->GetHyperedgeWeights(e);
+        edge_weights[e] = std::inner_product(e_wt_factors_.begin(),
+                                             e_wt_factors_.end(),
+                                             weights.begin(),
+                                             0.0f)
+                          / (he_size - 1);
+      }
+    }
+    ThreadPool thread_pool(num_threads_);
+    const SpectralEmbedding spectral_embedding(
+        spectral_dimensions_,
+        community_max_hyperedge_size_,
+        /* max_num_iters */ 20,
+        seed_,
+        &thread_pool,
+        logger_);
+    std::vector<float> embedding
+        = spectral_embedding.Compute(original_hypergraph_, edge_weights);
+    if (embedding.empty() == true) {
+      logger_->warn(
+          PAR, 234, "The hypergraph is too small for the spectral embedding.");
+    } else {
+      original_hypergraph_->SetPlacement(spectral_dimensions_,
+                                         std::move(embedding));
+      placement_dimensions_ = spectral_dimensions_;
+    }
+  }
+
   if (static_cast<int>(v_wt_factors_.size()) != vertex_dimensions_) {
     logger_->warn(
         PAR, 141, "No vertex weighting is specified. Use default value of 1.");
@@ -1827,6 +3069,9 @@ void TritonPart::MultiLevelPartition()
   logger_->info(PAR, 88, "coarsening_ratio : {}", coarsening_ratio_);
   logger_->info(PAR, 89, "max_coarsen_iters : {}", max_coarsen_iters_);
   logger_->info(PAR, 90, "adj_diff_ratio : {}", adj_diff_ratio_);
+  logger_->info(PAR, 188, "parallel_matching : {}", parallel_matching_);
+  logger_->info(PAR, 230, "detect_communities : {}", detect_communities_);
+  logger_->info(PAR, 233, "spectral_dimensions : {}", spectral_dimensions_);
   logger_->info(
       PAR, 91, "min_num_vertcies_each_part : {}", min_num_vertices_each_part_);
   // initial partitioning parameter
@@ -1839,27 +3084,29 @@ void TritonPart::MultiLevelPartition()
       PAR, 95, "max_moves (FM or greedy refinement) : {}", max_moves_);
   logger_->info(PAR, 96, "early_stop_ratio : {}", early_stop_ratio_);
   logger_->info(PAR, 97, "total_corking_passes : {}", total_corking_passes_);
+  logger_->info(PAR, 186, "gain_bucket_type : {}", ToString(gain_bucket_type_));
+  if (gain_bucket_type_ == GainBucketType::BUCKET_LIST) {
+    logger_->info(PAR, 187, "gain_resolution : {}", gain_resolution_);
+  }
   logger_->info(PAR, 98, "v_cycle_flag : {}", v_cycle_flag_);
   logger_->info(PAR, 99, "max_num_vcycle : {}", max_num_vcycle_);
   logger_->info(PAR, 100, "num_coarsen_solutions : {}", num_coarsen_solutions_);
   logger_->info(
       PAR, 101, "num_vertices_threshold_ilp : {}", num_vertices_threshold_ilp_);
+  logger_->info(PAR, 194, "ilp_time_limit : {} second", ilp_time_limit_);
+  logger_->info(PAR, 195, "ilp_num_threads : {}", ilp_num_threads_);
+  logger_->info(PAR, 228, "ilp_solver : {}", ToString(ilp_solver_));
+  logger_->info(PAR, 213, "vertex_order : {}", ToString(vertex_order_));
+  logger_->info(PAR, 216, "lazy_gain_threshold : {}", lazy_gain_threshold_);
+  logger_->info(PAR, 229, "adaptive_stop_alpha : {}", adaptive_stop_alpha_);
+  logger_->info(PAR, 217, "fixed_point_bits : {}", fixed_point_bits_);
+  logger_->info(PAR, 227, "time_limit : {} second", time_limit_);
+
+  // all the phases below share the time budget
+  deadline_ = std::make_shared<Deadline>(time_limit_);
 
   // create the evaluator class
-  auto tritonpart_evaluator
-      = std::make_shared<GoldenEvaluator>(num_parts_,
-                                          // weight vectors
-                                          e_wt_factors_,
-                                          v_wt_factors_,
-                                          placement_wt_factors_,
-                                          // timing related weight
-                                          net_timing_factor_,
-                                          path_timing_factor_,
-                                          path_snaking_factor_,
-                                          timing_exp_factor_,
-                                          extra_delay_,
-                                          original_hypergraph_,
-                                          logger_);
+  auto tritonpart_evaluator = CreateEvaluator(num_parts_, original_hypergraph_);
 
   Matrix<float> upper_block_balance
       = original_hypergraph_->GetUpperVertexBalance(
@@ -1870,74 +3117,277 @@ void TritonPart::MultiLevelPartition()
           num_parts_, ub_factor_, base_balance_);
 
   // Step 1 : create all the coarsening, partitionig and refinement class
-  // TODO:  This may need to modify as lower_block_balance
-  const std::vector<float> thr_cluster_weight
-      = DivideFactor(original_hypergraph_->GetTotalVertexWeights(),
-                     min_num_vertices_each_part_ * num_parts_);
-
-  // create the coarsener cluster
-  auto tritonpart_coarsener
-      = std::make_shared<Coarsener>(num_parts_,
-                                    thr_coarsen_hyperedge_size_skip_,
-                                    thr_coarsen_vertices_,
-                                    thr_coarsen_hyperedges_,
-                                    coarsening_ratio_,
-                                    max_coarsen_iters_,
-                                    adj_diff_ratio_,
-                                    thr_cluster_weight,
-                                    seed_,
-                                    coarsen_order_,
+  auto tritonpart_coarsener = CreateCoarsener(
+      num_parts_, original_hypergraph_, tritonpart_evaluator);
+  // the counters of all the phases are reported as metrics
+  auto profiler = std::make_shared<Profiler>();
+  auto tritonpart_mlevel_partitioner
+      = CreateMultilevelPartitioner(num_parts_,
                                     tritonpart_evaluator,
-                                    logger_);
-
-  // create the initial partitioning class
-  auto tritonpart_partitioner = std::make_shared<Partitioner>(
-      num_parts_, seed_, tritonpart_evaluator, logger_);
+                                    tritonpart_coarsener,
+                                    profiler,
+                                    num_threads_);
+
+  if (timing_aware_flag_ == true) {
+    // Initialize the timing on original_hypergraph_
+    tritonpart_evaluator->InitializeTiming(original_hypergraph_);
+  }
+  // The community file has priority over the detected communities
+  if (detect_communities_ == true
+      && original_hypergraph_->HasCommunity() == false) {
+    ThreadPool thread_pool(num_threads_);
+    CommunityDetector community_detector(community_max_hyperedge_size_,
+                                         /* max_num_levels */ 16,
+                                         /* max_num_passes */ 10,
+                                         &thread_pool,
+                                         logger_);
+    std::vector<int> community_attr = community_detector.Detect(
+        original_hypergraph_,
+        tritonpart_evaluator->GetNormEdgeScores(original_hypergraph_));
+    const int num_communities
+        = community_attr.empty()
+              ? 0
+              : *std::max_element(community_attr.begin(), community_attr.end())
+                    + 1;
+    logger_->info(PAR,
+                  231,
+                  "Detected {} communities among {} vertices",
+                  num_communities,
+                  original_hypergraph_->GetNumVertices());
+    original_hypergraph_->SetCommunity(community_attr);
+  }
+  // Use coarsening to do preprocessing step
+  // Build the hypergraph used to call multi-level partitioner
+  // (1) remove single-vertex hyperedge
+  // (2) remove lager hyperedge
+  // (3) detect parallel hyperedges
+  // (4) handle group information
+  // (5) group fixed vertices based on each block
+  // group vertices based on group_attr_
+  // the original_hypergraph_ will be modified by the Group Vertices command
+  // We will store the mapping relationship of vertices between
+  // original_hypergraph_ and hypergraph_
+  // In the warm-start mode, the vertices far from the changed vertices are
+  // fixed temporarily, thus they are grouped into one vertex for each block
+  const bool warm_start_flag = (warm_start_solution_.empty() == false);
+  std::vector<int> fixed_attr;
+  if (warm_start_flag == true) {
+    original_hypergraph_->CopyFixedAttr(fixed_attr);
+    original_hypergraph_->SetFixedAttr(PrepareWarmStart());
+  }
+  tritonpart_coarsener->SetThrCoarsenHyperedgeSizeSkip(global_net_threshold_);
+  hypergraph_
+      = tritonpart_coarsener->GroupVertices(original_hypergraph_, group_attr_);
+  tritonpart_coarsener->SetThrCoarsenHyperedgeSizeSkip(
+      thr_coarsen_hyperedge_size_skip_);
+  if (warm_start_flag == true) {
+    original_hypergraph_->SetFixedAttr(fixed_attr);
+  }
+  if (vertex_order_ != VertexOrder::NONE) {
+    hypergraph_ = RenumberHypergraph(hypergraph_, tritonpart_evaluator);
+  }
+
+  // partition on the processed hypergraph
+  std::vector<int> solution;
+  if (warm_start_flag == true) {
+    // skip the initial partitioning.  The guided v-cycles below start
+    // from the warm-start solution
+    solution.resize(hypergraph_->GetNumVertices(), 0);
+    for (int v = 0; v < original_hypergraph_->GetNumVertices(); v++) {
+      solution[hypergraph_->GetVertexCParent(v)] = warm_start_solution_[v];
+    }
+  } else if (recursive_bisection_flag_ == true) {
+    // the k-way partitioner is only used for the final refinement
+    logger_->info(PAR,
+                  199,
+                  "Recursive bisection into {} blocks with {} threads",
+                  num_parts_,
+                  std::max(num_threads_, 1));
+    std::vector<int> vertices(hypergraph_->GetNumVertices());
+    std::iota(vertices.begin(), vertices.end(), 0);
+    solution.resize(hypergraph_->GetNumVertices(), 0);
+    RecursiveBisection(hypergraph_,
+                       vertices,
+                       0,
+                       num_parts_,
+                       upper_block_balance,
+                       std::max(num_threads_, 1),
+                       profiler,
+                       solution);
+  } else {
+    if (dist_ != nullptr) {
+      StartRemoteCandidateGeneration(tritonpart_mlevel_partitioner,
+                                     tritonpart_evaluator,
+                                     upper_block_balance,
+                                     lower_block_balance);
+    }
+    solution = tritonpart_mlevel_partitioner->Partition(
+        hypergraph_, upper_block_balance, lower_block_balance);
+    tritonpart_mlevel_partitioner->SetRemoteCandidateGenerator(nullptr);
+  }
+
+  // Perform the last-minute refinement
+  tritonpart_coarsener->SetThrCoarsenHyperedgeSizeSkip(global_net_threshold_);
+  tritonpart_mlevel_partitioner->VcycleRefinement(
+      hypergraph_, upper_block_balance, lower_block_balance, solution);
+
+  // Translate the solution of hypergraph to original_hypergraph_
+  // solution to solution_
+  hypergraph_->ProjectSolution(solution, solution_);
+
+  // evaluate on the original hypergraph
+  // tritonpart_evaluator->CutEvaluator(original_hypergraph_, solution_, true);
+  tritonpart_evaluator->ConstraintAndCutEvaluator(original_hypergraph_,
+                                                  solution_,
+                                                  ub_factor_,
+                                                  base_balance_,
+                                                  group_attr_,
+                                                  true);
+
+  // generate the timing report
+  if (timing_aware_flag_ == true) {
+    logger_->report("[STATUS] Displaying timing path cuts statistics");
+    PathStats path_stats
+        = tritonpart_evaluator->GetTimingCuts(original_hypergraph_, solution_);
+    tritonpart_evaluator->PrintPathStats(path_stats);
+  }
+
+  // print the runtime
+  auto end_timestamp_global = std::chrono::high_resolution_clock::now();
+  double total_global_time
+      = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            end_timestamp_global - start_time_stamp_global)
+            .count();
+  total_global_time *= 1e-9;
+  logger_->info(PAR,
+                109,
+                "The runtime of multi-level partitioner : {} seconds",
+                total_global_time);
+  deadline_->Report(logger_);
+  deadline_.reset();
+  profiler->ReportMetrics(
+      logger_, original_hypergraph_->GetNumVertices(), total_global_time);
+}
+
+EvaluatorPtr TritonPart::CreateEvaluator(const int num_parts,
+                                         const HGraphPtr& timing_graph) const
+{
+  auto evaluator = std::make_shared<GoldenEvaluator>(num_parts,
+                                                     // weight vectors
+                                                     e_wt_factors_,
+                                                     v_wt_factors_,
+                                                     placement_wt_factors_,
+                                                     // timing related weight
+                                                     net_timing_factor_,
+                                                     path_timing_factor_,
+                                                     path_snaking_factor_,
+                                                     timing_exp_factor_,
+                                                     extra_delay_,
+                                                     timing_graph,
+                                                     logger_);
+  evaluator->SetFixedPointBits(fixed_point_bits_);
+  return evaluator;
+}
+
+CoarseningPtr TritonPart::CreateCoarsener(
+    const int num_parts,
+    const HGraphPtr& hgraph,
+    const EvaluatorPtr& evaluator) const
+{
+  // TODO:  This may need to modify as lower_block_balance
+  const std::vector<float> thr_cluster_weight
+      = DivideFactor(hgraph->GetTotalVertexWeights(),
+                     min_num_vertices_each_part_ * num_parts);
+
+  // create the coarsener cluster
+  auto coarsener = std::make_shared<Coarsener>(num_parts,
+                                               thr_coarsen_hyperedge_size_skip_,
+                                               thr_coarsen_vertices_,
+                                               thr_coarsen_hyperedges_,
+                                               coarsening_ratio_,
+                                               max_coarsen_iters_,
+                                               adj_diff_ratio_,
+                                               thr_cluster_weight,
+                                               seed_,
+                                               coarsen_order_,
+                                               evaluator,
+                                               logger_);
+  coarsener->SetParallelMatching(parallel_matching_);
+  return coarsener;
+}
+
+MultiLevelPartitioner TritonPart::CreateMultilevelPartitioner(
+    const int num_parts,
+    const EvaluatorPtr& evaluator,
+    const CoarseningPtr& coarsener,
+    const ProfilerPtr& profiler,
+    const int num_threads) const
+{
+  // create the initial partitioning class
+  auto partitioner
+      = std::make_shared<Partitioner>(num_parts, seed_, evaluator, logger_);
+  partitioner->SetIlpParams(ilp_time_limit_, ilp_num_threads_, ilp_solver_);
 
   // create the refinement classes
   // We have four types of refiner
   // (1) greedy refinement. try to one entire hyperedge each time
-  auto greedy_refiner = std::make_shared<GreedyRefine>(num_parts_,
+  auto greedy_refiner = std::make_shared<GreedyRefine>(num_parts,
                                                        refiner_iters_,
                                                        path_timing_factor_,
                                                        path_snaking_factor_,
                                                        max_moves_,
-                                                       tritonpart_evaluator,
+                                                       evaluator,
                                                        logger_);
 
   // (2) ILP-based partitioning (only for two-way since k-way ILP partitioning
   // is too timing-consuming)
-  auto ilp_refiner = std::make_shared<IlpRefine>(num_parts_,
+  auto ilp_refiner = std::make_shared<IlpRefine>(num_parts,
                                                  refiner_iters_,
                                                  path_timing_factor_,
                                                  path_snaking_factor_,
                                                  max_moves_,
-                                                 tritonpart_evaluator,
+                                                 evaluator,
                                                  logger_);
+  ilp_refiner->SetIlpParams(ilp_time_limit_, ilp_num_threads_, ilp_solver_);
 
   // (3) direct k-way FM
-  auto k_way_fm_refiner = std::make_shared<KWayFMRefine>(num_parts_,
+  auto k_way_fm_refiner = std::make_shared<KWayFMRefine>(num_parts,
                                                          refiner_iters_,
                                                          path_timing_factor_,
                                                          path_snaking_factor_,
                                                          max_moves_,
                                                          total_corking_passes_,
-                                                         tritonpart_evaluator,
+                                                         evaluator,
                                                          logger_);
 
   // (4) k-way pair-wise FM
-  auto k_way_pm_refiner = std::make_shared<KWayPMRefine>(num_parts_,
+  auto k_way_pm_refiner = std::make_shared<KWayPMRefine>(num_parts,
                                                          refiner_iters_,
                                                          path_timing_factor_,
                                                          path_snaking_factor_,
                                                          max_moves_,
                                                          total_corking_passes_,
-                                                         tritonpart_evaluator,
+                                                         evaluator,
                                                          logger_);
+  k_way_fm_refiner->SetGainBucketType(gain_bucket_type_, gain_resolution_);
+  k_way_pm_refiner->SetGainBucketType(gain_bucket_type_, gain_resolution_);
+  k_way_fm_refiner->SetLazyGainThreshold(lazy_gain_threshold_);
+  k_way_pm_refiner->SetLazyGainThreshold(lazy_gain_threshold_);
+  k_way_fm_refiner->SetAdaptiveStopAlpha(adaptive_stop_alpha_);
+
+  // (5) parallel label propagation (only for the large levels)
+  auto lp_refiner
+      = std::make_shared<LabelPropagationRefine>(num_parts,
+                                                 refiner_iters_,
+                                                 path_timing_factor_,
+                                                 path_snaking_factor_,
+                                                 max_moves_,
+                                                 evaluator,
+                                                 logger_);
 
   // create the multi-level class
-  auto tritonpart_mlevel_partitioner
-      = std::make_shared<MultilevelPartitioner>(num_parts_,
+  auto mlevel_partitioner
+      = std::make_shared<MultilevelPartitioner>(num_parts,
                                                 v_cycle_flag_,
                                                 num_initial_solutions_,
                                                 num_best_initial_solutions_,
@@ -1945,86 +3395,683 @@ void TritonPart::MultiLevelPartition()
                                                 max_num_vcycle_,
                                                 num_coarsen_solutions_,
                                                 seed_,
-                                                tritonpart_coarsener,
-                                                tritonpart_partitioner,
+                                                coarsener,
+                                                partitioner,
                                                 k_way_fm_refiner,
                                                 k_way_pm_refiner,
                                                 greedy_refiner,
                                                 ilp_refiner,
-                                                tritonpart_evaluator,
+                                                evaluator,
                                                 logger_);
+  mlevel_partitioner->SetNumThreads(num_threads);
+  mlevel_partitioner->SetInitPlateauWindow(init_plateau_window_);
+  mlevel_partitioner->SetNumParallelVcycles(num_parallel_vcycles_);
+  mlevel_partitioner->SetLabelPropagationRefiner(lp_refiner,
+                                                 num_vertices_threshold_lp_);
+  mlevel_partitioner->SetProfiler(profiler);
+  mlevel_partitioner->SetDeadline(deadline_);
+  return mlevel_partitioner;
+}
 
-  if (timing_aware_flag_ == true) {
-    // Initialize the timing on original_hypergraph_
-    tritonpart_evaluator->InitializeTiming(original_hypergraph_);
+void TritonPart::RecursiveBisection(HGraphPtr hgraph,
+                                    const std::vector<int>& vertices,
+                                    const int block_begin,
+                                    const int block_end,
+                                    const Matrix<float>& upper_block_balance,
+                                    const int num_threads,
+                                    const ProfilerPtr& profiler,
+                                    std::vector<int>& solution) const
+{
+  const int num_blocks = block_end - block_begin;
+  if (num_blocks == 1) {
+    for (const int v : vertices) {
+      solution[v] = block_begin;
+    }
+    return;
+  }
+  if (vertices.empty() == true) {
+    return;
   }
-  // Use coarsening to do preprocessing step
-  // Build the hypergraph used to call multi-level partitioner
-  // (1) remove single-vertex hyperedge
-  // (2) remove lager hyperedge
-  // (3) detect parallel hyperedges
-  // (4) handle group information
-  // (5) group fixed vertices based on each block
-  // group vertices based on group_attr_
-  // the original_hypergraph_ will be modified by the Group Vertices command
-  // We will store the mapping relationship of vertices between
-  // original_hypergraph_ and hypergraph_
-  tritonpart_coarsener->SetThrCoarsenHyperedgeSizeSkip(global_net_threshold_);
-  hypergraph_
-      = tritonpart_coarsener->GroupVertices(original_hypergraph_, group_attr_);
-  tritonpart_coarsener->SetThrCoarsenHyperedgeSizeSkip(
-      thr_coarsen_hyperedge_size_skip_);
 
-  // partition on the processed hypergraph
-  std::vector<int> solution = tritonpart_mlevel_partitioner->Partition(
-      hypergraph_, upper_block_balance, lower_block_balance);
+  // the blocks [block_begin, block_mid) form side 0 of the bisection and
+  // the blocks [block_mid, block_end) form side 1
+  const int block_mid = block_begin + num_blocks / 2;
+  const float total_base = std::accumulate(base_balance_.begin() + block_begin,
+                                           base_balance_.begin() + block_end,
+                                           0.0f);
+  // the target of each block as a fraction of hgraph
+  auto lambda_target = [&](int block_id) -> float {
+    return total_base > 0.0 ? base_balance_[block_id] / total_base
+                            : 1.0f / num_blocks;
+  };
+  std::vector<float> base_balance(2, 0.0);
+  for (int block_id = block_begin; block_id < block_end; block_id++) {
+    base_balance[block_id < block_mid ? 0 : 1] += lambda_target(block_id);
+  }
+
+  // The imbalance of each bisection is chosen such that the final blocks
+  // still satisfy upper_block_balance after the remaining
+  // ceil(log2(num_blocks)) levels of bisection
+  const std::vector<float> total_weight = hgraph->GetTotalVertexWeights();
+  const int num_levels = static_cast<int>(std::ceil(std::log2(num_blocks)));
+  Matrix<float> upper_bisection_balance(2, total_weight);
+  Matrix<float> lower_bisection_balance(2, total_weight);
+  for (int dim = 0; dim < static_cast<int>(total_weight.size()); dim++) {
+    float ratio = std::numeric_limits<float>::max();
+    for (int block_id = block_begin; block_id < block_end; block_id++) {
+      const float target = total_weight[dim] * lambda_target(block_id);
+      if (target > 0.0) {
+        ratio = std::min(ratio, upper_block_balance[block_id][dim] / target);
+      }
+    }
+    ratio = (ratio == std::numeric_limits<float>::max())
+                ? 1.0f
+                : std::pow(std::max(ratio, 1.0f), 1.0f / num_levels);
+    for (int side = 0; side < 2; side++) {
+      const float target = total_weight[dim] * base_balance[side];
+      upper_bisection_balance[side][dim] = target * ratio;
+      lower_bisection_balance[side][dim]
+          = target * std::max(2.0f - ratio, 0.0f);
+    }
+  }
 
-  // Translate the solution of hypergraph to original_hypergraph_
-  // solution to solution_
-  solution_.clear();
-  solution_.resize(original_hypergraph_->GetNumVertices());
-  std::fill(solution_.begin(), solution_.end(), -1);
-  for (int cluster_id = 0; cluster_id < hypergraph_->GetNumVertices();
-       cluster_id++) {
-    const int part_id = solution[cluster_id];
-    for (const auto& v : hypergraph_->GetVertexCAttr(cluster_id)) {
-      solution_[v] = part_id;
+  // map the fixed vertices to the side of their blocks.
+  // The original fixed attributes are restored after the bisection
+  const bool fixed_vertex_flag = hgraph->HasFixedVertices();
+  std::vector<int> fixed_attr;
+  if (fixed_vertex_flag == true) {
+    hgraph->CopyFixedAttr(fixed_attr);
+    std::vector<int> side_fixed_attr(fixed_attr.size(), -1);
+    for (size_t v = 0; v < fixed_attr.size(); v++) {
+      if (fixed_attr[v] >= 0) {
+        side_fixed_attr[v] = fixed_attr[v] < block_mid ? 0 : 1;
+      }
     }
+    hgraph->SetFixedAttr(side_fixed_attr);
+  }
+
+  auto evaluator = CreateEvaluator(2, hgraph);
+  auto coarsener = CreateCoarsener(2, hgraph, evaluator);
+  if (timing_aware_flag_ == true && hgraph->HasTiming() == true) {
+    evaluator->InitializeTiming(hgraph);
+  }
+  // group the fixed vertices of each side as in MultiLevelPartition()
+  coarsener->SetThrCoarsenHyperedgeSizeSkip(global_net_threshold_);
+  HGraphPtr grouped_hgraph = coarsener->GroupVertices(hgraph, Matrix<int>());
+  coarsener->SetThrCoarsenHyperedgeSizeSkip(thr_coarsen_hyperedge_size_skip_);
+  std::vector<int> grouped_bisection;
+  if (grouped_hgraph->GetNumHyperedges() == 0) {
+    // nothing can be cut, so fill side 0 up to its target
+    grouped_bisection.resize(grouped_hgraph->GetNumVertices(), 1);
+    float side_0_weight = 0.0;
+    for (int v = 0; v < grouped_hgraph->GetNumVertices(); v++) {
+      const float weight = grouped_hgraph->GetVertexWeights(v).front();
+      if (grouped_hgraph->HasFixedVertices() == true
+          && grouped_hgraph->GetFixedAttr(v) >= 0) {
+        grouped_bisection[v] = grouped_hgraph->GetFixedAttr(v);
+      } else if (side_0_weight + weight
+                 <= total_weight.front() * base_balance[0]) {
+        grouped_bisection[v] = 0;
+      }
+      if (grouped_bisection[v] == 0) {
+        side_0_weight += weight;
+      }
+    }
+  } else {
+    auto mlevel_partitioner = CreateMultilevelPartitioner(
+        2, evaluator, coarsener, profiler, num_threads);
+    grouped_bisection = mlevel_partitioner->Partition(
+        grouped_hgraph, upper_bisection_balance, lower_bisection_balance);
+  }
+  std::vector<int> bisection;
+  grouped_hgraph->ProjectSolution(grouped_bisection, bisection);
+  grouped_hgraph.reset();
+  if (fixed_vertex_flag == true) {
+    hgraph->SetFixedAttr(fixed_attr);
+  }
+
+  // build the sub-hypergraph of each side, then release hgraph
+  Matrix<int> sub_vertices(2);  // the vertices of hgraph
+  Matrix<int> sub_original_vertices(2);  // the vertices of hypergraph_
+  for (int v = 0; v < hgraph->GetNumVertices(); v++) {
+    sub_vertices[bisection[v]].push_back(v);
+    sub_original_vertices[bisection[v]].push_back(vertices[v]);
+  }
+  std::vector<HGraphPtr> sub_hgraphs;
+  for (int side = 0; side < 2; side++) {
+    sub_hgraphs.push_back(hgraph->GetSubHypergraph(sub_vertices[side]));
+  }
+  hgraph.reset();
+
+  // solve the two sides concurrently on the shared thread pool
+  auto lambda_solve = [&](int side, int side_num_threads) {
+    RecursiveBisection(std::move(sub_hgraphs[side]),
+                       sub_original_vertices[side],
+                       side == 0 ? block_begin : block_mid,
+                       side == 0 ? block_mid : block_end,
+                       upper_block_balance,
+                       side_num_threads,
+                       profiler,
+                       solution);
+  };
+  if (num_threads > 1) {
+    utl::TaskGroup sides(utl::PAR);
+    sides.run([&]() { lambda_solve(0, num_threads / 2); });
+    lambda_solve(1, num_threads - num_threads / 2);
+    sides.wait();
+  } else {
+    lambda_solve(0, 1);
+    lambda_solve(1, 1);
   }
+}
 
-  // Perform the last-minute refinement
-  tritonpart_coarsener->SetThrCoarsenHyperedgeSizeSkip(global_net_threshold_);
-  tritonpart_mlevel_partitioner->VcycleRefinement(
-      hypergraph_, upper_block_balance, lower_block_balance, solution_);
+// The parameters used by CreateEvaluator, CreateCoarsener and
+// CreateMultilevelPartitioner
+template <class Archive>
+void TritonPart::serialize(Archive& ar, const unsigned int version)
+{
+  (ar) & num_parts_;
+  (ar) & seed_;
+  (ar) & vertex_dimensions_;
+  (ar) & hyperedge_dimensions_;
+  (ar) & placement_dimensions_;
+  (ar) & e_wt_factors_;
+  (ar) & v_wt_factors_;
+  (ar) & placement_wt_factors_;
+  (ar) & net_timing_factor_;
+  (ar) & path_timing_factor_;
+  (ar) & path_snaking_factor_;
+  (ar) & timing_exp_factor_;
+  (ar) & extra_delay_;
+  (ar) & thr_coarsen_hyperedge_size_skip_;
+  (ar) & thr_coarsen_vertices_;
+  (ar) & thr_coarsen_hyperedges_;
+  (ar) & coarsening_ratio_;
+  (ar) & max_coarsen_iters_;
+  (ar) & adj_diff_ratio_;
+  (ar) & min_num_vertices_each_part_;
+  (ar) & coarsen_order_;
+  (ar) & parallel_matching_;
+  (ar) & detect_communities_;
+  (ar) & community_max_hyperedge_size_;
+  (ar) & spectral_dimensions_;
+  (ar) & num_initial_solutions_;
+  (ar) & num_best_initial_solutions_;
+  (ar) & init_plateau_window_;
+  (ar) & refiner_iters_;
+  (ar) & max_moves_;
+  (ar) & total_corking_passes_;
+  (ar) & gain_bucket_type_;
+  (ar) & gain_resolution_;
+  (ar) & lazy_gain_threshold_;
+  (ar) & adaptive_stop_alpha_;
+  (ar) & fixed_point_bits_;
+  (ar) & time_limit_;
+  (ar) & ilp_time_limit_;
+  (ar) & ilp_num_threads_;
+  (ar) & ilp_solver_;
+  (ar) & v_cycle_flag_;
+  (ar) & max_num_vcycle_;
+  (ar) & num_coarsen_solutions_;
+  (ar) & num_vertices_threshold_ilp_;
+  (ar) & num_parallel_vcycles_;
+  (ar) & num_vertices_threshold_lp_;
+  (ar) & num_threads_;
+}
 
-  // evaluate on the original hypergraph
-  // tritonpart_evaluator->CutEvaluator(original_hypergraph_, solution_, true);
-  tritonpart_evaluator->ConstraintAndCutEvaluator(original_hypergraph_,
-                                                  solution_,
-                                                  ub_factor_,
-                                                  base_balance_,
-                                                  group_attr_,
-                                                  true);
+// The key of the solution cache is the fingerprint of the hypergraph, the
+// constraints and all the parameters which may change the solution
+std::string TritonPart::GetSolutionCacheFile() const
+{
+  if (solution_cache_dir_.empty()) {
+    return std::string();
+  }
+  Fingerprint fingerprint;
+  original_hypergraph_->AddToFingerprint(fingerprint);
+  fingerprint.AddValue(group_attr_.size());
+  for (const auto& group : group_attr_) {
+    fingerprint.AddVector(group);
+  }
+  fingerprint.AddValue(ub_factor_);
+  fingerprint.AddVector(base_balance_);
+  fingerprint.AddVector(scale_factor_);
+  fingerprint.AddValue(global_net_threshold_);
+  fingerprint.AddValue(recursive_bisection_flag_);
+  fingerprint.AddValue(vertex_order_);
+  // the other parameters are the ones shipped to the remote workers
+  std::ostringstream params_stream;
+  {
+    boost::archive::text_oarchive archive(params_stream,
+                                          boost::archive::no_header);
+    archive << *this;
+  }
+  fingerprint.AddString(params_stream.str());
+  return fmt::format("{}/{}.part.{}",
+                     solution_cache_dir_,
+                     fingerprint.ToString(),
+                     num_parts_);
+}
 
-  // generate the timing report
-  if (timing_aware_flag_ == true) {
-    logger_->report("[STATUS] Displaying timing path cuts statistics");
-    PathStats path_stats
-        = tritonpart_evaluator->GetTimingCuts(original_hypergraph_, solution_);
-    tritonpart_evaluator->PrintPathStats(path_stats);
+bool TritonPart::ReadCachedSolution(const std::string& cache_file)
+{
+  if (cache_file.empty()) {
+    return false;
+  }
+  std::ifstream cache_input(cache_file);
+  if (!cache_input.is_open()) {
+    logger_->info(PAR, 218, "Solution cache miss : {}", cache_file);
+    return false;
+  }
+  std::vector<int> solution;
+  solution.reserve(original_hypergraph_->GetNumVertices());
+  int part_id = -1;
+  while (cache_input >> part_id) {
+    solution.push_back(part_id);
+  }
+  if (static_cast<int>(solution.size())
+          != original_hypergraph_->GetNumVertices()
+      || std::any_of(solution.begin(), solution.end(), [&](int block_id) {
+           return block_id < 0 || block_id >= num_parts_;
+         })) {
+    logger_->warn(
+        PAR, 219, "Ignore the invalid cached solution : {}", cache_file);
+    return false;
   }
+  logger_->info(PAR, 220, "Solution cache hit : {}", cache_file);
+  solution_ = std::move(solution);
+  auto evaluator = CreateEvaluator(num_parts_, original_hypergraph_);
+  evaluator->ConstraintAndCutEvaluator(original_hypergraph_,
+                                       solution_,
+                                       ub_factor_,
+                                       base_balance_,
+                                       group_attr_,
+                                       true);
+  return true;
+}
 
-  // print the runtime
-  auto end_timestamp_global = std::chrono::high_resolution_clock::now();
-  double total_global_time
-      = std::chrono::duration_cast<std::chrono::nanoseconds>(
-            end_timestamp_global - start_time_stamp_global)
-            .count();
-  total_global_time *= 1e-9;
+// The solution is written to a temporary file first and then renamed,
+// such that concurrent runs never read a partially written solution
+void TritonPart::WriteCachedSolution(const std::string& cache_file) const
+{
+  if (cache_file.empty()) {
+    return;
+  }
+  std::error_code error;
+  std::filesystem::create_directories(solution_cache_dir_, error);
+  const std::string temp_file
+      = fmt::format("{}.{}.tmp", cache_file, std::random_device()());
+  std::ofstream cache_output(temp_file);
+  for (const int part_id : solution_) {
+    cache_output << part_id << '\n';
+  }
+  cache_output.close();
+  if (cache_output) {
+    std::filesystem::rename(temp_file, cache_file, error);
+  }
+  if (!cache_output || error) {
+    logger_->warn(
+        PAR, 221, "Can not write the solution cache : {}", cache_file);
+    std::filesystem::remove(temp_file, error);
+    return;
+  }
+  logger_->info(PAR, 222, "Store the solution in the cache : {}", cache_file);
+}
+
+HGraphPtr TritonPart::RenumberHypergraph(const HGraphPtr& hgraph,
+                                         const EvaluatorPtr& evaluator) const
+{
+  VertexOrder order = vertex_order_;
+  if (order == VertexOrder::PLACEMENT && hgraph->HasPlacement() == false) {
+    logger_->warn(PAR,
+                  214,
+                  "No placement information for the placement vertex order. "
+                  "Use the rcm vertex order.");
+    order = VertexOrder::RCM;
+  }
+
+  const std::vector<int> vertices = hgraph->GetLocalityOrder(order);
+  HGraphPtr renumbered_hgraph = hgraph->GetSubHypergraph(vertices);
+  std::vector<int> new_vertex_id(hgraph->GetNumVertices());
+  for (int i = 0; i < static_cast<int>(vertices.size()); i++) {
+    new_vertex_id[vertices[i]] = i;
+  }
+  std::vector<int> vertex_c_parent(hgraph->GetNumFinerVertices());
+  for (int v = 0; v < hgraph->GetNumFinerVertices(); v++) {
+    vertex_c_parent[v] = new_vertex_id[hgraph->GetVertexCParent(v)];
+  }
+  renumbered_hgraph->SetVertexCParent(std::move(vertex_c_parent));
+  if (renumbered_hgraph->HasTiming()) {
+    evaluator->InitializeTiming(renumbered_hgraph);
+  }
   logger_->info(PAR,
-                109,
-                "The runtime of multi-level partitioner : {} seconds",
-                total_global_time);
+                215,
+                "Renumber {} vertices and {} hyperedges in {} order",
+                renumbered_hgraph->GetNumVertices(),
+                renumbered_hgraph->GetNumHyperedges(),
+                ToString(order));
+  return renumbered_hgraph;
+}
+
+void TritonPart::StartRemoteCandidateGeneration(
+    const MultiLevelPartitioner& mlevel_partitioner,
+    const EvaluatorPtr& evaluator,
+    const Matrix<float>& upper_block_balance,
+    const Matrix<float>& lower_block_balance)
+{
+  // the binary hypergraph does not carry the timing cost of hypergraph_
+  if (hypergraph_->HasTiming() == true) {
+    logger_->warn(PAR,
+                  203,
+                  "Distributed candidate generation does not support "
+                  "timing-driven partitioning. Generate the candidates "
+                  "locally.");
+    return;
+  }
+
+  // ship the hypergraph and the parameters to the workers once
+  const std::string hypergraph_file
+      = fmt::format("{}/par_hypergraph.bin", shared_volume_);
+  evaluator->WriteBinaryHypergraph(hypergraph_, hypergraph_file);
+  std::ostringstream params_stream;
+  {
+    boost::archive::text_oarchive archive(params_stream);
+    archive << *this;
+  }
+  dst::JobMessage msg(dst::JobMessage::PARTITIONING,
+                      dst::JobMessage::BROADCAST),
+      result(dst::JobMessage::NONE);
+  auto desc = std::make_unique<PartitionJobDescription>();
+  desc->setType(PartitionJobDescription::LOAD_HYPERGRAPH);
+  desc->setHypergraphFile(hypergraph_file);
+  desc->setParams(params_stream.str());
+  desc->setBlockBalance(upper_block_balance, lower_block_balance);
+  msg.setJobDescription(std::move(desc));
+  if (dist_->sendJob(msg, remote_host_.c_str(), remote_port_, result) == false
+      || result.getJobType() != dst::JobMessage::SUCCESS
+      || result.getJobDescription() == nullptr) {
+    logger_->warn(PAR,
+                  204,
+                  "Failed to load the hypergraph on the remote workers. "
+                  "Generate the candidates locally.");
+    return;
+  }
+  auto broadcast_desc
+      = static_cast<dst::BroadcastJobDescription*>(result.getJobDescription());
+  logger_->info(PAR,
+                205,
+                "Generate the candidate solutions on {} remote workers",
+                broadcast_desc->getWorkersCount());
+  mlevel_partitioner->SetRemoteCandidateGenerator(
+      [this](int coarsen_seed, std::vector<int>& solution) {
+        return RequestRemoteCandidate(coarsen_seed, solution);
+      });
+}
+
+bool TritonPart::RequestRemoteCandidate(const int coarsen_seed,
+                                        std::vector<int>& solution) const
+{
+  dst::JobMessage msg(dst::JobMessage::PARTITIONING),
+      result(dst::JobMessage::NONE);
+  auto desc = std::make_unique<PartitionJobDescription>();
+  desc->setType(PartitionJobDescription::GENERATE_CANDIDATE);
+  desc->setSeed(coarsen_seed);
+  msg.setJobDescription(std::move(desc));
+  auto lambda_fail = [&]() -> bool {
+    logger_->warn(PAR,
+                  206,
+                  "Failed to generate the candidate solution with seed {} "
+                  "remotely. Generate it locally.",
+                  coarsen_seed);
+    return false;
+  };
+  if (dist_->sendJob(msg, remote_host_.c_str(), remote_port_, result) == false
+      || result.getJobType() != dst::JobMessage::SUCCESS
+      || result.getJobDescription() == nullptr) {
+    return lambda_fail();
+  }
+  const std::vector<int>& remote_solution
+      = static_cast<PartitionJobDescription*>(result.getJobDescription())
+            ->getSolution();
+  if (static_cast<int>(remote_solution.size())
+      != hypergraph_->GetNumVertices()) {
+    return lambda_fail();
+  }
+  for (const int block_id : remote_solution) {
+    if (block_id < 0 || block_id >= num_parts_) {
+      return lambda_fail();
+    }
+  }
+  solution = remote_solution;
+  return true;
+}
+
+bool TritonPart::LoadRemoteHypergraph(const PartitionJobDescription& desc)
+{
+  remote_mlevel_partitioner_ = nullptr;
+  try {
+    std::istringstream params_stream(desc.getParams());
+    boost::archive::text_iarchive archive(params_stream);
+    archive >> *this;
+  } catch (const boost::archive::archive_exception& e) {
+    logger_->warn(PAR, 207, "Invalid partitioning parameters : {}", e.what());
+    return false;
+  }
+  if (IsBinaryHypergraphFile(desc.getHypergraphFile()) == false) {
+    logger_->warn(PAR,
+                  208,
+                  "Can not load the binary hypergraph file : {}",
+                  desc.getHypergraphFile());
+    return false;
+  }
+
+  // the hypergraph has been processed by the master,
+  // so it is partitioned as it is
+  timing_aware_flag_ = false;
+  group_attr_.clear();
+  ReadHypergraph(desc.getHypergraphFile(), "", "", "", "");
+  hypergraph_ = original_hypergraph_;
+  remote_upper_block_balance_ = desc.getUpperBlockBalance();
+  remote_lower_block_balance_ = desc.getLowerBlockBalance();
+  auto evaluator = CreateEvaluator(num_parts_, hypergraph_);
+  auto coarsener = CreateCoarsener(num_parts_, hypergraph_, evaluator);
+  remote_mlevel_partitioner_
+      = CreateMultilevelPartitioner(num_parts_,
+                                    evaluator,
+                                    coarsener,
+                                    std::make_shared<Profiler>(),
+                                    num_threads_);
+  return true;
+}
+
+bool TritonPart::GenerateRemoteCandidate(const int coarsen_seed,
+                                         std::vector<int>& solution)
+{
+  if (remote_mlevel_partitioner_ == nullptr) {
+    return false;
+  }
+  solution = remote_mlevel_partitioner_->GenerateCandidate(
+      hypergraph_,
+      remote_upper_block_balance_,
+      remote_lower_block_balance_,
+      coarsen_seed);
+  return true;
+}
+
+bool TritonPart::SendServerJob(const int type,
+                               const std::string& hypergraph_file,
+                               const std::vector<std::string>& attribute_files,
+                               const std::vector<int>& solution,
+                               dst::JobMessage& result) const
+{
+  // the files are loaded by the server, so the paths must be absolute
+  auto lambda_absolute = [](const std::string& file) {
+    return file.empty() ? file : std::filesystem::absolute(file).string();
+  };
+  std::vector<std::string> files;
+  std::string hypergraph_id = lambda_absolute(hypergraph_file);
+  for (const std::string& file : attribute_files) {
+    files.push_back(lambda_absolute(file));
+    hypergraph_id += ";" + files.back();
+  }
+  if (!server_hypergraph_id_.empty()) {
+    hypergraph_id = server_hypergraph_id_;
+  }
+
+  std::ostringstream params_stream;
+  {
+    boost::archive::text_oarchive archive(params_stream);
+    archive << *this;
+  }
+  dst::JobMessage msg(dst::JobMessage::PARTITIONING);
+  auto desc = std::make_unique<PartitionJobDescription>();
+  desc->setType(static_cast<PartitionJobDescription::Type>(type));
+  desc->setHypergraphId(hypergraph_id);
+  desc->setHypergraphFile(lambda_absolute(hypergraph_file));
+  desc->setAttributeFiles(files);
+  desc->setParams(params_stream.str());
+  desc->setBalance(ub_factor_, base_balance_, scale_factor_);
+  desc->setSolution(solution);
+  msg.setJobDescription(std::move(desc));
+  if (server_dist_->sendJob(msg, server_host_.c_str(), server_port_, result)
+          == false
+      || result.getJobType() != dst::JobMessage::SUCCESS
+      || result.getJobDescription() == nullptr) {
+    logger_->warn(PAR,
+                  238,
+                  "The server {}:{} failed to process the hypergraph {}. "
+                  "Run locally.",
+                  server_host_,
+                  server_port_,
+                  hypergraph_id);
+    return false;
+  }
+  logger_->info(PAR,
+                239,
+                "The server {}:{} processed the hypergraph {}",
+                server_host_,
+                server_port_,
+                hypergraph_id);
+  return true;
+}
+
+bool TritonPart::LoadResidentHypergraph(const PartitionJobDescription& desc)
+{
+  try {
+    std::istringstream params_stream(desc.getParams());
+    boost::archive::text_iarchive archive(params_stream);
+    archive >> *this;
+  } catch (const boost::archive::archive_exception& e) {
+    logger_->warn(PAR, 2530, "Invalid partitioning parameters : {}", e.what());
+    return false;
+  }
+  ub_factor_ = desc.getUbFactor();
+  base_balance_ = desc.getBaseBalance();
+  scale_factor_ = desc.getScaleFactor();
+  timing_aware_flag_ = false;
+
+  if (resident_hypergraph_ == nullptr) {
+    const std::vector<std::string>& attribute_files = desc.getAttributeFiles();
+    bool valid_files = attribute_files.size() == 4
+                       && std::filesystem::exists(desc.getHypergraphFile());
+    for (const std::string& file : attribute_files) {
+      valid_files = valid_files
+                    && (file.empty() || std::filesystem::exists(file));
+    }
+    if (valid_files == false) {
+      logger_->warn(PAR,
+                    240,
+                    "Can not load the resident hypergraph {} from {}",
+                    desc.getHypergraphId(),
+                    desc.getHypergraphFile());
+      return false;
+    }
+    group_attr_.clear();
+    ReadHypergraph(desc.getHypergraphFile(),
+                   attribute_files[0],
+                   attribute_files[1],
+                   attribute_files[2],
+                   attribute_files[3]);
+    resident_hypergraph_ = original_hypergraph_;
+    resident_group_attr_ = group_attr_;
+    logger_->info(
+        PAR, 241, "Load the resident hypergraph {}", desc.getHypergraphId());
+  }
+
+  // the partitioner updates the attributes of original_hypergraph_
+  // (e.g., the detected communities), so each job works on a copy
+  original_hypergraph_ = std::make_shared<Hypergraph>(*resident_hypergraph_);
+  group_attr_ = resident_group_attr_;
+  vertex_dimensions_ = original_hypergraph_->GetVertexDimensions();
+  hyperedge_dimensions_ = original_hypergraph_->GetHyperedgeDimensions();
+  placement_dimensions_ = original_hypergraph_->GetPlacementDimensions();
+  num_vertices_ = original_hypergraph_->GetNumVertices();
+  num_hyperedges_ = original_hypergraph_->GetNumHyperedges();
+  solution_.clear();
+  return true;
+}
+
+bool TritonPart::PartitionResidentHypergraph(
+    const PartitionJobDescription& desc,
+    std::vector<int>& solution)
+{
+  if (LoadResidentHypergraph(desc) == false) {
+    return false;
+  }
+  MultiLevelPartition();
+  solution = solution_;
+  return true;
+}
+
+bool TritonPart::EvaluateResidentSolution(const PartitionJobDescription& desc,
+                                          PartitionToken& token,
+                                          bool& feasible)
+{
+  if (LoadResidentHypergraph(desc) == false) {
+    return false;
+  }
+  const std::vector<int>& solution = desc.getSolution();
+  bool valid_solution = static_cast<int>(solution.size()) == num_vertices_;
+  for (const int block_id : solution) {
+    valid_solution = valid_solution && block_id >= 0 && block_id < num_parts_;
+  }
+  if (valid_solution == false) {
+    logger_->warn(PAR,
+                  242,
+                  "Invalid solution of the resident hypergraph {}",
+                  desc.getHypergraphId());
+    return false;
+  }
+
+  // the same defaults as InitHypergraphEvaluation
+  if (static_cast<int>(base_balance_.size()) != num_parts_) {
+    base_balance_.assign(num_parts_, 1.0 / num_parts_);
+  }
+  if (static_cast<int>(scale_factor_.size()) != num_parts_) {
+    scale_factor_.assign(num_parts_, 1.0);
+  }
+  for (int i = 0; i < num_parts_; i++) {
+    base_balance_[i] = base_balance_[i] / scale_factor_[i];
+  }
+  if (static_cast<int>(e_wt_factors_.size()) != hyperedge_dimensions_) {
+    e_wt_factors_.assign(hyperedge_dimensions_, 1.0);
+  }
+  if (static_cast<int>(v_wt_factors_.size()) != vertex_dimensions_) {
+    v_wt_factors_.assign(vertex_dimensions_, 1.0);
+  }
+  if (static_cast<int>(placement_wt_factors_.size())
+      != placement_dimensions_) {
+    placement_wt_factors_.assign(placement_dimensions_, 1.0);
+  }
+  auto evaluator = CreateEvaluator(num_parts_, original_hypergraph_);
+  token = evaluator->CutEvaluator(original_hypergraph_, solution, true);
+  feasible = evaluator->ConstraintEvaluator(original_hypergraph_,
+                                            solution,
+                                            token,
+                                            ub_factor_,
+                                            base_balance_,
+                                            group_attr_,
+                                            true);
+  return true;
 }
 
 }  // namespace par
@@ -41,7 +41,11 @@
 #include <vector>
 
 #include "Coarsener.h"
+#include "Deadline.h"
 #include "Hypergraph.h"
+#include "Multilevel.h"
+#include "PriorityQueue.h"
+#include "TimingPathsCache.h"
 #include "db_sta/dbReadVerilog.hh"
 #include "db_sta/dbSta.hh"
 #include "odb/db.h"
@@ -51,8 +55,19 @@
 #include "sta/Sta.hh"
 #include "utl/Logger.h"
 
+namespace boost::serialization {
+class access;
+}
+
+namespace dst {
+class Distributed;
+class JobMessage;
+}
+
 namespace par {
 
+class PartitionJobDescription;
+
 // The TritonPart Interface
 // TritonPart is a state-of-the-art hypergraph and netlist partitioner that
 // replaces previous engines such as hMETIS.
@@ -163,14 +178,68 @@ class TritonPart
                                   const char* group_file,
                                   const char* solution_file);
 
-  // k-way partitioning used by Hier-RTLMP
-  std::vector<int> PartitionKWaySimpleMode(
-      unsigned int num_parts_arg,
-      float balance_constraint_arg,
-      unsigned int seed_arg,
-      const std::vector<std::vector<int>>& hyperedges,
-      const std::vector<float>& vertex_weights,
-      const std::vector<float>& hyperedge_weights);
+  // Evaluate many solutions of the same hypergraph in parallel.
+  // The hypergraph is loaded only once, and the statistics of all the
+  // solutions are written to summary_file (or reported if it is empty)
+  void EvaluateHypergraphSolutions(
+      unsigned int num_parts,
+      float balance_constraint,
+      std::vector<float> base_balance,
+      std::vector<float> scale_factor,
+      int vertex_dimension,
+      int hyperedge_dimension,
+      const char* hypergraph_file,
+      const char* fixed_file,
+      const char* group_file,
+      const std::vector<std::string>& solution_files,
+      const char* summary_file);
+
+  // Convert a hypergraph in hMETIS format and the related constraint files
+  // into the binary format, which can be loaded by PartitionHypergraph
+  // directly without parsing
+  void WriteHypergraphBinary(int vertex_dimension,
+                             int hyperedge_dimension,
+                             int placement_dimension,
+                             const char* hypergraph_file,
+                             const char* fixed_file,
+                             const char* community_file,
+                             const char* placement_file,
+                             const char* binary_file);
+
+  // Partition the hypergraph given in compressed sparse row format
+  // (see PartitionMgr::tritonPartHypergraphArrays). The arrays are only
+  // read while the hypergraph is built, and the solution is written to
+  // solution[0, num_vertices)
+  void PartitionHypergraphArrays(unsigned int num_parts,
+                                 float balance_constraint,
+                                 unsigned int seed,
+                                 const int* eptr,
+                                 int num_eptr,
+                                 const int* eind,
+                                 int num_eind,
+                                 const float* vertex_weights,
+                                 int num_vertex_weights,
+                                 const float* hyperedge_weights,
+                                 int num_hyperedge_weights,
+                                 const int* fixed_attr,
+                                 int num_fixed_attr,
+                                 int* solution,
+                                 int num_vertices);
+
+  // Coarsen the hypergraph given in compressed sparse row format with the
+  // first-choice coarsener, without partitioning it. No cluster is heavier
+  // than max_cluster_weight. The i-th returned vector maps the vertices of
+  // level i to their clusters in level i + 1, level 0 being the input.
+  std::vector<std::vector<int>> CoarsenHypergraphArrays(
+      unsigned int seed,
+      const int* eptr,
+      int num_eptr,
+      const int* eind,
+      int num_eind,
+      const float* vertex_weights,
+      int num_vertices,
+      int thr_coarsen_vertices,
+      float max_cluster_weight);
 
   // Main APIs
   void SetTimingParams(float net_timing_factor,
@@ -238,10 +307,228 @@ class TritonPart
       int num_vertices_threshold_ilp,
       int global_net_threshold);
 
+  // Number of threads used for generating candidate solutions
+  void SetNumThreads(int num_threads) { num_threads_ = num_threads; }
+
+  // Stop the initial partitioning when the best cutcost has not been
+  // improved by init_plateau_window consecutive candidates (0 means disabled)
+  void SetInitPlateauWindow(int init_plateau_window)
+  {
+    init_plateau_window_ = init_plateau_window;
+  }
+
+  // Data structure of the FM gain buckets ("heap" or "bucket")
+  // gain_resolution is the width of each bucket for "bucket"
+  void SetGainBucketType(const std::string& gain_bucket_type,
+                         float gain_resolution);
+
+  // Use the deterministic parallel vertex matching during coarsening
+  void SetParallelMatching(bool parallel_matching)
+  {
+    parallel_matching_ = parallel_matching;
+  }
+
+  // Detect the communities of the hypergraph when no community file is
+  // given, so the coarsening only merges vertices of the same community
+  void SetDetectCommunities(bool detect_communities)
+  {
+    detect_communities_ = detect_communities;
+  }
+
+  // Use a spectral embedding with spectral_dimensions dimensions as the
+  // placement information when no placement is given (0 means disabled)
+  void SetSpectralDimensions(int spectral_dimensions);
+
+  // Coarsen the hypergraph file out of core before loading it, such that
+  // the number of vertices is reduced by coarsening_ratio (0 means disabled)
+  void SetStreamingCoarseningRatio(float streaming_coarsening_ratio);
+
+  // The wall-clock budget (in seconds, 0 means no limit), the number of
+  // threads and the solver ("auto", "scip" or "cp_sat") for each call of
+  // the ILP solver
+  void SetIlpParams(float ilp_time_limit,
+                    int ilp_num_threads,
+                    const std::string& ilp_solver);
+
+  // Number of guided v-cycles run concurrently in each round of the
+  // v-cycle refinement (1 means serial)
+  void SetNumParallelVcycles(int num_parallel_vcycles)
+  {
+    num_parallel_vcycles_ = num_parallel_vcycles;
+  }
+
+  // The levels with more than num_vertices_threshold_lp vertices are refined
+  // by label propagation instead of FM (0 means disabled)
+  void SetNumVerticesThresholdLp(int num_vertices_threshold_lp)
+  {
+    num_vertices_threshold_lp_ = num_vertices_threshold_lp;
+  }
+
+  // "direct" partitions the hypergraph into num_parts blocks at once.
+  // "recursive" partitions the hypergraph by recursive bisection, where the
+  // two halves of each bisection are solved on separate threads, followed
+  // by a k-way refinement
+  void SetPartitionMode(const std::string& mode);
+
+  // Renumber the vertices and hyperedges of the processed hypergraph for
+  // locality before partitioning: "none", "rcm" (BFS order) or "placement"
+  // (Z-order curve over the placement locations). The solution is mapped
+  // back to the original vertex ids
+  void SetVertexOrder(const std::string& order);
+
+  // The FM gains through the hyperedges with at least lazy_gain_threshold
+  // pins are only updated when the move changes the cut status of the
+  // hyperedge (0 means disabled)
+  void SetLazyGainThreshold(int lazy_gain_threshold)
+  {
+    lazy_gain_threshold_ = lazy_gain_threshold;
+  }
+
+  // Stop the FM passes adaptively when the moves since the last improvement
+  // are unlikely to find a better solution.  A larger alpha stops later.
+  // 0 means that each pass tries up to max_moves moves.
+  void SetAdaptiveStopAlpha(float adaptive_stop_alpha);
+
+  // Round the costs of the hyperedges and timing paths to multiples of
+  // 2^-fixed_point_bits during partitioning (0 means disabled), see
+  // GoldenEvaluator::SetFixedPointBits
+  void SetFixedPointBits(int fixed_point_bits);
+
+  // The wall-clock budget of the multi-level partitioner in seconds
+  // (0 means no limit).  The phases are shortened when the time is up,
+  // and the best solution found so far is returned
+  void SetTimeLimit(float time_limit);
+
+  // Cache the solutions of PartitionHypergraph in cache_dir.  A run with the
+  // same hypergraph, constraints and parameters returns the cached solution
+  // without partitioning.  An empty cache_dir disables the cache
+  void SetSolutionCacheDir(const std::string& cache_dir)
+  {
+    solution_cache_dir_ = cache_dir;
+  }
+
+  // Reuse the timing paths extracted from STA across runs.
+  // nullptr means that STA is run for every call
+  void SetTimingPathsCache(TimingPathsCache* timing_paths_cache)
+  {
+    timing_paths_cache_ = timing_paths_cache;
+  }
+
+  // Start PartitionDesign from the "partition_id" properties instead of
+  // partitioning from scratch (incremental re-partitioning after ECOs).
+  // Only the vertices within warm_start_hops_ hops of the vertices without
+  // a valid partition_id (the changed vertices) are refined
+  void SetWarmStart(bool warm_start) { warm_start_flag_ = warm_start; }
+
+  // Generate the candidate solutions of the multilevel partitioner on the
+  // workers of the dst load balancer at remote_host:remote_port.
+  // The hypergraph is written to shared_volume and loaded by each worker
+  // once, then only the solutions are sent back. dist = nullptr means
+  // that all the candidates are generated locally.
+  void SetDistributed(dst::Distributed* dist,
+                      const std::string& remote_host,
+                      unsigned short remote_port,
+                      const std::string& shared_volume);
+
+  // The worker side of the distributed candidate generation.
+  // LoadRemoteHypergraph loads the hypergraph and the parameters of a
+  // LOAD_HYPERGRAPH job, and GenerateRemoteCandidate generates the
+  // candidate solution for coarsen_seed on the loaded hypergraph.
+  // Both return false on failure.
+  bool LoadRemoteHypergraph(const PartitionJobDescription& desc);
+  bool GenerateRemoteCandidate(int coarsen_seed, std::vector<int>& solution);
+
+  // Send the hypergraph partitioning and evaluation jobs to the dst worker
+  // at server_host:server_port, which keeps the hypergraph resident under
+  // hypergraph_id (the hypergraph and attribute files by default), so the
+  // files are loaded only by the first job. The jobs run locally if the
+  // server cannot be used.
+  void SetServer(dst::Distributed* dist,
+                 const std::string& server_host,
+                 unsigned short server_port,
+                 const std::string& hypergraph_id);
+
+  // The server side. The hypergraph is loaded by the first job and kept
+  // by this object. PartitionResidentHypergraph partitions it with the
+  // parameters of a PARTITION_RESIDENT job, and EvaluateResidentSolution
+  // evaluates the solution of an EVALUATE_RESIDENT job.
+  // Both return false on failure.
+  bool PartitionResidentHypergraph(const PartitionJobDescription& desc,
+                                   std::vector<int>& solution);
+  bool EvaluateResidentSolution(const PartitionJobDescription& desc,
+                                PartitionToken& token,
+                                bool& feasible);
+
  private:
   // Main partititon function
   void MultiLevelPartition();
 
+  // Build original_hypergraph_ from compressed sparse row arrays
+  void ReadHypergraphArrays(const int* eptr,
+                            int num_eptr,
+                            const int* eind,
+                            int num_eind,
+                            const float* vertex_weights,
+                            int num_vertex_weights,
+                            const float* hyperedge_weights,
+                            int num_hyperedge_weights,
+                            const int* fixed_attr,
+                            int num_fixed_attr,
+                            int num_vertices);
+
+  // Renumber the vertices and hyperedges of hgraph in vertex_order_.
+  // The finer vertices of hgraph are mapped to the renumbered vertices, such
+  // that ProjectSolution returns the solution in the original vertex ids
+  HGraphPtr RenumberHypergraph(const HGraphPtr& hgraph,
+                               const EvaluatorPtr& evaluator) const;
+
+  // The file in solution_cache_dir_ for the solution of original_hypergraph_
+  // with the current parameters. Empty if the cache is disabled
+  std::string GetSolutionCacheFile() const;
+  // Load solution_ from the cache file and report its cost.
+  // Return false if there is no valid solution in the cache
+  bool ReadCachedSolution(const std::string& cache_file);
+  void WriteCachedSolution(const std::string& cache_file) const;
+
+  // Set the parameters and read the hypergraph for the evaluation of
+  // one or more solutions
+  EvaluatorPtr InitHypergraphEvaluation(unsigned int num_parts,
+                                        float balance_constraint,
+                                        std::vector<float> base_balance,
+                                        std::vector<float> scale_factor,
+                                        int vertex_dimension,
+                                        int hyperedge_dimension,
+                                        const char* hypergraph_file,
+                                        const char* fixed_file,
+                                        const char* group_file);
+
+  // create the components of the multi-level partitioner for num_parts blocks.
+  // The maximum cluster weight of the coarsener is based on hgraph
+  EvaluatorPtr CreateEvaluator(int num_parts,
+                               const HGraphPtr& timing_graph) const;
+  CoarseningPtr CreateCoarsener(int num_parts,
+                                const HGraphPtr& hgraph,
+                                const EvaluatorPtr& evaluator) const;
+  MultiLevelPartitioner CreateMultilevelPartitioner(
+      int num_parts,
+      const EvaluatorPtr& evaluator,
+      const CoarseningPtr& coarsener,
+      const ProfilerPtr& profiler,
+      int num_threads) const;
+
+  // Partition hgraph into the blocks [block_begin, block_end) by recursive
+  // bisection. The vertex v of hgraph is the vertex vertices[v] of
+  // hypergraph_ and the fixed attributes of hgraph are the final block ids.
+  // The two halves are solved on separate threads if num_threads > 1
+  void RecursiveBisection(HGraphPtr hgraph,
+                          const std::vector<int>& vertices,
+                          int block_begin,
+                          int block_end,
+                          const Matrix<float>& upper_block_balance,
+                          int num_threads,
+                          const ProfilerPtr& profiler,
+                          std::vector<int>& solution) const;
+
   // read and build hypergraph
   void ReadHypergraph(const std::string& hypergraph,
                       const std::string& fixed_file,
@@ -249,12 +536,81 @@ class TritonPart
                       const std::string& group_file,
                       const std::string& placement_file);
 
+  // read the hypergraph file and coarsen it out of core
+  // (streaming_coarsening_ratio_ > 0)
+  void ReadStreamingHypergraph(const std::string& hypergraph_file,
+                               const std::string& fixed_file,
+                               const std::string& community_file,
+                               const std::string& group_file,
+                               const std::string& placement_file,
+                               const std::string& cluster_map_file);
+
+  // read the fixed file and the community file
+  void ReadVertexAttributes(const std::string& fixed_file,
+                            const std::string& community_file);
+
+  // read the hypergraph file in hMETIS format or in the binary format.
+  // The hyperedges are returned in compressed sparse row format
+  void ReadTextHypergraph(const std::string& hypergraph_file,
+                          std::vector<CsrOffset>& eptr,
+                          std::vector<int>& eind);
+  void ReadBinaryHypergraph(const std::string& hypergraph_file,
+                            std::vector<CsrOffset>& eptr,
+                            std::vector<int>& eind);
+
   // read and build netlist
   // placement information is extracted from the OpenDB database
   void ReadNetlist(const std::string& fixed_file,
                    const std::string& community_file,
                    const std::string& group_file);
   void BuildTimingPaths();  // Find all the critical timing paths
+  // Run STA and store the timing paths and net slacks in timing_paths_cache
+  void ExtractStaTimingPaths(TimingPathsCache& timing_paths_cache);
+
+  // Load the hypergraph on the remote workers and let mlevel_partitioner
+  // request the candidate solutions from them.  The candidates are
+  // generated locally if the workers cannot be used
+  void StartRemoteCandidateGeneration(
+      const MultiLevelPartitioner& mlevel_partitioner,
+      const EvaluatorPtr& evaluator,
+      const Matrix<float>& upper_block_balance,
+      const Matrix<float>& lower_block_balance);
+  bool RequestRemoteCandidate(int coarsen_seed,
+                              std::vector<int>& solution) const;
+
+  // The client side of the server mode: send the job of type (a
+  // PartitionJobDescription::Type) for the hypergraph and attribute files
+  // (fixed, community, group and placement files) to the server.
+  // Return false on failure, otherwise result carries the
+  // PartitionJobDescription of the result
+  bool SendServerJob(int type,
+                     const std::string& hypergraph_file,
+                     const std::vector<std::string>& attribute_files,
+                     const std::vector<int>& solution,
+                     dst::JobMessage& result) const;
+  // Load the parameters of a server job, and the hypergraph if it is not
+  // resident yet.  original_hypergraph_ is set to a copy of the resident
+  // hypergraph
+  bool LoadResidentHypergraph(const PartitionJobDescription& desc);
+
+  // The partitioning parameters sent to the remote workers
+  template <class Archive>
+  void serialize(Archive& ar, unsigned int version);
+  friend class boost::serialization::access;
+
+  // Read the warm-start solution from the "partition_id" properties.
+  // The vertices without a valid partition_id are marked as -1
+  void ReadWarmStartSolution();
+  // Assign the changed vertices of the warm-start solution to the block of
+  // their neighbors, and return the fixed attributes of original_hypergraph_
+  // where all the vertices far from the changed vertices are fixed
+  std::vector<int> PrepareWarmStart();
+
+  // get the vertex id of an instance or an IO port,
+  // and the hyperedge id of a net. -1 means that the object is not used
+  int GetVertexId(odb::dbInst* inst) const;
+  int GetVertexId(odb::dbBTerm* bterm) const;
+  int GetHyperedgeId(odb::dbNet* net) const;
 
   // private member functions
   ord::dbNetwork* network_ = nullptr;
@@ -293,6 +649,7 @@ class TritonPart
   std::vector<TimingPath>
       timing_paths_;  // critical timing paths, extracted based OpenSTA
   bool guardband_flag_ = true;  // Turn on the timing guardband option
+  TimingPathsCache* timing_paths_cache_ = nullptr;  // owned by PartitionMgr
 
   // ---- community information
   // ---- all the vertices in the same community will stay together
@@ -307,6 +664,88 @@ class TritonPart
   std::vector<std::vector<int>>
       group_attr_;  // each group cooresponds to a group
 
+  // --- number of threads for generating candidate solutions
+  int num_threads_ = 1;
+  int init_plateau_window_ = 0;  // early stop of initial partitioning
+
+  // --- data structure of the FM gain buckets
+  GainBucketType gain_bucket_type_ = GainBucketType::PRIORITY_QUEUE;
+  float gain_resolution_ = 1.0;
+
+  // --- coarsening with parallel vertex matching
+  bool parallel_matching_ = false;
+
+  // --- built-in community detection (used without community file)
+  bool detect_communities_ = false;
+  // the larger hyperedges are ignored by the clique expansion
+  int community_max_hyperedge_size_ = 50;
+
+  // --- spectral embedding (used without placement information)
+  int spectral_dimensions_ = 0;
+
+  // --- out-of-core coarsening of the hypergraph file
+  float streaming_coarsening_ratio_ = 0.0;  // 0 means disabled
+  // the number of bytes read from the hypergraph file at once
+  size_t streaming_chunk_size_ = 1 << 24;
+
+  // --- ILP solver budget
+  float ilp_time_limit_ = 0.0;  // seconds, 0 means no limit
+  int ilp_num_threads_ = 1;
+  IlpSolver ilp_solver_ = IlpSolver::AUTO;
+
+  // --- number of concurrent guided v-cycles
+  int num_parallel_vcycles_ = 1;
+
+  // --- label propagation refinement for the large levels (0 = disabled)
+  int num_vertices_threshold_lp_ = 0;
+
+  // --- recursive bisection instead of direct k-way partitioning
+  bool recursive_bisection_flag_ = false;
+
+  // --- renumber the processed hypergraph for locality
+  VertexOrder vertex_order_ = VertexOrder::NONE;
+
+  // --- lazy gain updates for the large hyperedges (0 = disabled)
+  int lazy_gain_threshold_ = 0;
+
+  // --- adaptive stopping rule of FM passes (0 = disabled)
+  float adaptive_stop_alpha_ = 0.0;
+
+  // --- fixed-point costs (0 = disabled)
+  int fixed_point_bits_ = 0;
+
+  // --- time budget of MultiLevelPartition (seconds, 0 = no limit)
+  float time_limit_ = 0.0;
+  DeadlinePtr deadline_ = nullptr;  // only set during MultiLevelPartition
+
+  // --- on-disk cache of the hypergraph partitioning solutions
+  std::string solution_cache_dir_;
+
+  // --- warm start from the "partition_id" properties
+  bool warm_start_flag_ = false;
+  int warm_start_hops_ = 2;  // the radius of the refined region
+  std::vector<int> warm_start_solution_;  // empty if not used
+
+  // --- distributed candidate generation over the dst workers
+  dst::Distributed* dist_ = nullptr;  // nullptr if not used
+  std::string remote_host_;
+  unsigned short remote_port_ = 0;
+  std::string shared_volume_;
+  // the worker side: the loaded hypergraph is stored in hypergraph_
+  MultiLevelPartitioner remote_mlevel_partitioner_ = nullptr;
+  Matrix<float> remote_upper_block_balance_;
+  Matrix<float> remote_lower_block_balance_;
+
+  // --- server mode over a dst worker
+  // the client side (server_dist_ is nullptr if not used)
+  dst::Distributed* server_dist_ = nullptr;
+  std::string server_host_;
+  unsigned short server_port_ = 0;
+  std::string server_hypergraph_id_;
+  // the server side: the resident hypergraph and its groups
+  HGraphPtr resident_hypergraph_ = nullptr;
+  std::vector<std::vector<int>> resident_group_attr_;
+
   // --- Global net threshold
   int global_net_threshold_
       = 1000;  // If the net is larger than global_net_threshold_,
@@ -421,6 +860,13 @@ class TritonPart
       = nullptr;  // the original hypergraph. In the timing-driven flow,
                   // the original hypergraph also serves as the timing graph
 
+  // map the OpenDB objects to the vertices and hyperedges.
+  // The tables are indexed by the id of dbInst, dbBTerm and dbNet.
+  // -1 means that the object is not used by the partitioner
+  std::vector<int> inst_vertex_id_;
+  std::vector<int> bterm_vertex_id_;
+  std::vector<int> net_hyperedge_id_;
+
   // Final solution
   std::vector<int> solution_;  // store the part_id for each vertex
 
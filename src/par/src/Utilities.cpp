@@ -41,12 +41,18 @@
 #include <ortools/base/logging.h>
 #include <ortools/linear_solver/linear_solver.h>
 #include <ortools/linear_solver/linear_solver.pb.h>
+#include <ortools/sat/cp_model.h>
+#include <ortools/sat/model.h>
+#include <ortools/sat/sat_parameters.pb.h>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <charconv>
 #include <chrono>
 #include <climits>
 #include <cmath>
+#include <cstdlib>
 #include <fstream>
 #include <functional>
 #include <iomanip>
@@ -68,6 +74,16 @@ using operations_research::MPConstraint;
 using operations_research::MPObjective;
 using operations_research::MPSolver;
 using operations_research::MPVariable;
+using operations_research::sat::BoolVar;
+using operations_research::sat::CpModelBuilder;
+using operations_research::sat::CpSolverResponse;
+using operations_research::sat::CpSolverStatus;
+using operations_research::sat::LinearExpr;
+using operations_research::sat::Model;
+using operations_research::sat::NewSatParameters;
+using operations_research::sat::SatParameters;
+using operations_research::sat::SolutionBooleanValue;
+using operations_research::sat::SolveCpModel;
 
 std::string GetVectorString(const std::vector<float>& vec)
 {
@@ -132,13 +148,288 @@ std::vector<std::string> SplitLine(const std::string& line)
   return items;
 }
 
+// Load the whole file into the buffer with a single read
+static bool LoadFile(const std::string& file_name, std::string& buffer)
+{
+  std::ifstream file_input(file_name, std::ios::binary);
+  if (!file_input.is_open()) {
+    return false;
+  }
+  file_input.seekg(0, std::ios::end);
+  const std::streamoff file_size = file_input.tellg();
+  file_input.seekg(0, std::ios::beg);
+  buffer.resize(file_size > 0 ? static_cast<size_t>(file_size) : 0);
+  file_input.read(buffer.data(), buffer.size());
+  buffer.resize(file_input.gcount());
+  return true;
+}
+
+bool TextFileReader::Open(const std::string& file_name,
+                          const size_t chunk_size)
+{
+  line_end_ = 0;
+  next_line_ = 0;
+  pos_ = 0;
+  chunk_size_ = chunk_size;
+  if (chunk_size_ == 0) {
+    stream_.reset();
+    return LoadFile(file_name, buffer_);
+  }
+  buffer_.clear();
+  stream_ = std::make_unique<std::ifstream>(file_name, std::ios::binary);
+  return stream_->is_open();
+}
+
+bool TextFileReader::ReadChunk()
+{
+  if (stream_ == nullptr || stream_->eof()) {
+    return false;
+  }
+  buffer_.erase(0, next_line_);
+  next_line_ = 0;
+  const size_t size = buffer_.size();
+  buffer_.resize(size + chunk_size_);
+  stream_->read(buffer_.data() + size, chunk_size_);
+  buffer_.resize(size + stream_->gcount());
+  return stream_->gcount() > 0;
+}
+
+bool TextFileReader::NextLine()
+{
+  // the buffer must hold the complete next line in the streaming mode
+  while (stream_ != nullptr
+         && buffer_.find('\n', next_line_) == std::string::npos
+         && ReadChunk() == true) {
+  }
+  if (next_line_ >= buffer_.size()) {
+    line_end_ = buffer_.size();
+    pos_ = line_end_;
+    return false;
+  }
+  pos_ = next_line_;
+  line_end_ = buffer_.find('\n', next_line_);
+  if (line_end_ == std::string::npos) {
+    line_end_ = buffer_.size();
+  }
+  next_line_ = line_end_ + 1;
+  return true;
+}
+
+void TextFileReader::SkipDelims(std::string_view delims)
+{
+  while (pos_ < line_end_ && delims.find(buffer_[pos_]) != delims.npos) {
+    pos_++;
+  }
+}
+
+bool TextFileReader::NextInt(int& value)
+{
+  SkipDelims(" \t\r\v\f");
+  if (pos_ >= line_end_) {
+    return false;
+  }
+  const char* begin = buffer_.data() + pos_;
+  if (*begin == '+') {
+    begin++;  // std::from_chars does not accept the plus sign
+  }
+  const auto [ptr, ec]
+      = std::from_chars(begin, buffer_.data() + line_end_, value);
+  if (ec != std::errc()) {
+    return false;
+  }
+  pos_ = ptr - buffer_.data();
+  return true;
+}
+
+bool TextFileReader::NextFloat(float& value)
+{
+  SkipDelims(" \t\r\v\f");
+  if (pos_ >= line_end_) {
+    return false;
+  }
+  // The current element does not start with a white space, so strtof
+  // never goes beyond the current line
+  const char* begin = buffer_.data() + pos_;
+  char* end = nullptr;
+  value = std::strtof(begin, &end);
+  if (end == begin) {
+    return false;
+  }
+  pos_ += end - begin;
+  return true;
+}
+
+bool TextFileReader::NextToken(std::string_view& token)
+{
+  const std::string_view delims(", \t\r\v\f");
+  SkipDelims(delims);
+  if (pos_ >= line_end_) {
+    return false;
+  }
+  const size_t start = pos_;
+  while (pos_ < line_end_ && delims.find(buffer_[pos_]) == delims.npos) {
+    pos_++;
+  }
+  token = std::string_view(buffer_.data() + start, pos_ - start);
+  return true;
+}
+
+bool TextFileReader::EndOfLine()
+{
+  SkipDelims(" \t\r\v\f");
+  return pos_ >= line_end_;
+}
+
+bool IsBinaryHypergraphFile(const std::string& file_name)
+{
+  std::ifstream file_input(file_name, std::ios::binary);
+  std::string magic(binary_hypergraph_magic.size(), '\0');
+  file_input.read(magic.data(), magic.size());
+  return file_input.gcount() == static_cast<std::streamsize>(magic.size())
+         && magic == binary_hypergraph_magic;
+}
+
+bool BinaryFileReader::Open(const std::string& file_name, const bool streaming)
+{
+  pos_ = 0;
+  if (streaming == false) {
+    stream_.reset();
+    return LoadFile(file_name, buffer_);
+  }
+  buffer_.clear();
+  stream_ = std::make_unique<std::ifstream>(file_name, std::ios::binary);
+  return stream_->is_open();
+}
+
+void BinaryFileReader::Seek(const size_t offset)
+{
+  if (stream_ != nullptr) {
+    stream_->clear();
+    stream_->seekg(static_cast<std::streamoff>(offset));
+  } else {
+    pos_ = std::min(offset, buffer_.size());
+  }
+}
+
+void Fingerprint::Add(const void* data, const size_t size)
+{
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash_ = (hash_ ^ bytes[i]) * 1099511628211ULL;
+  }
+}
+
+std::string Fingerprint::ToString() const
+{
+  std::ostringstream stream;
+  stream << std::hex << std::setw(16) << std::setfill('0') << hash_;
+  return stream.str();
+}
+
+PathCuts CountPathCuts(
+    boost::iterator_range<std::vector<int>::const_iterator> path,
+    const std::vector<int>& solution,
+    const int num_parts,
+    const int v,
+    const int to_pid)
+{
+  // the number of times the path enters each block
+  constexpr int max_stack_parts = 64;
+  std::array<int, max_stack_parts> stack_visits{};
+  std::vector<int> heap_visits;
+  int* block_visits = stack_visits.data();
+  if (num_parts > max_stack_parts) {
+    heap_visits.resize(num_parts, 0);
+    block_visits = heap_visits.data();
+  }
+  PathCuts cuts;
+  int pre_block_id = -1;
+  for (const int u : path) {
+    const int block_id = (to_pid != -1 && u == v) ? to_pid : solution[u];
+    if (block_id != pre_block_id) {
+      cuts.max_block_visits
+          = std::max(cuts.max_block_visits, ++block_visits[block_id]);
+      cuts.num_cuts++;
+      pre_block_id = block_id;
+    }
+  }
+  // the first block entered is not a cut
+  cuts.num_cuts = std::max(cuts.num_cuts - 1, 0);
+  return cuts;
+}
+
 // Add right vector to left vector
-void Accumulate(std::vector<float>& a, const std::vector<float>& b)
+std::vector<float> ToVector(FloatView a)
+{
+  return std::vector<float>(a.begin(), a.end());
+}
+
+void Accumulate(std::vector<float>& a, FloatView b)
 {
   assert(a.size() == b.size());
   std::transform(a.begin(), a.end(), b.begin(), a.begin(), std::plus<float>());
 }
 
+void Subtract(std::vector<float>& a, FloatView b)
+{
+  assert(a.size() == b.size());
+  std::transform(a.begin(),
+                 a.end(),
+                 b.begin(),
+                 a.begin(),
+                 std::minus<float>());
+}
+
+void AccumulateScaled(std::vector<float>& a, FloatView b, const float factor)
+{
+  assert(a.size() == b.size());
+  std::transform(a.begin(),
+                 a.end(),
+                 b.begin(),
+                 a.begin(),
+                 [factor](float x, float y) { return x + factor * y; });
+}
+
+void Scale(std::vector<float>& a, const float factor)
+{
+  for (auto& value : a) {
+    value *= factor;
+  }
+}
+
+int CompareSum(FloatView a, FloatView b, const float factor, FloatView c)
+{
+  assert(a.size() == b.size() && a.size() == c.size());
+  auto a_iter = a.begin();
+  auto b_iter = b.begin();
+  auto c_iter = c.begin();
+  while (a_iter != a.end()) {
+    const float sum = (*a_iter++) + factor * (*b_iter++);
+    const float value = *c_iter++;
+    if (sum < value) {
+      return -1;
+    }
+    if (value < sum) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+float Distance(FloatView a, FloatView b, const std::vector<float>& factor)
+{
+  float result{0};
+  assert(a.size() == b.size() && a.size() <= factor.size());
+  auto a_iter = a.begin();
+  auto b_iter = b.begin();
+  auto factor_iter = factor.begin();
+  while (a_iter != a.end()) {
+    const float diff = (*a_iter++) - (*b_iter++);
+    result += diff * diff * std::abs(*factor_iter++);
+  }
+  return std::sqrt(result);
+}
+
 // weighted sum
 std::vector<float> WeightedSum(const std::vector<float>& a,
                                const float a_factor,
@@ -168,10 +459,9 @@ std::vector<float> DivideFactor(const std::vector<float>& a, const float factor)
 }
 
 // multiply the vector
-std::vector<float> MultiplyFactor(const std::vector<float>& a,
-                                  const float factor)
+std::vector<float> MultiplyFactor(FloatView a, const float factor)
 {
-  std::vector<float> result = a;
+  std::vector<float> result(a.begin(), a.end());
   for (auto& value : result) {
     value *= factor;
   }
@@ -198,8 +488,7 @@ std::vector<float> DivideVectorElebyEle(const std::vector<float>& emb,
 }
 
 // operation for two vectors +, -, *,  ==, <
-std::vector<float> operator+(const std::vector<float>& a,
-                             const std::vector<float>& b)
+std::vector<float> operator+(FloatView a, FloatView b)
 {
   assert(a.size() == b.size());
   std::vector<float> result;
@@ -212,8 +501,7 @@ std::vector<float> operator+(const std::vector<float>& a,
   return result;
 }
 
-std::vector<float> operator-(const std::vector<float>& a,
-                             const std::vector<float>& b)
+std::vector<float> operator-(FloatView a, FloatView b)
 {
   assert(a.size() == b.size());
   std::vector<float> result;
@@ -251,6 +539,11 @@ std::vector<float> operator*(const std::vector<float>& a, const float factor)
 }
 
 bool operator<(const std::vector<float>& a, const std::vector<float>& b)
+{
+  return FloatView(a) < FloatView(b);
+}
+
+bool operator<(FloatView a, FloatView b)
 {
   assert(a.size() == b.size());
   auto a_iter = a.begin();
@@ -314,6 +607,177 @@ float norm2(const std::vector<float>& a, const std::vector<float>& factor)
   return std::sqrt(result);
 }
 
+std::string ToString(const IlpSolver solver)
+{
+  switch (solver) {
+    case IlpSolver::AUTO:
+      return std::string("AUTO");
+
+    case IlpSolver::SCIP:
+      return std::string("SCIP");
+
+    case IlpSolver::CP_SAT:
+      return std::string("CP_SAT");
+
+    default:
+      return std::string("AUTO");
+  }
+}
+
+// The minimum number of binary variables for choosing CP-SAT automatically.
+// SCIP solves the smaller models in its presolve, before the CP-SAT workers
+// are even started
+constexpr int kCpSatMinVariables = 1000;
+
+// CP-SAT only supports integer coefficients, so the weights of each
+// dimension are scaled such that the largest one becomes kCpSatWeightScale
+constexpr double kCpSatWeightScale = 1 << 20;
+
+// Solve the same model as ILPPartitionInst with CP-SAT
+static bool CpSatPartitionInst(
+    int num_parts,
+    int vertex_weight_dimension,
+    std::vector<int>& solution,
+    const std::vector<int>& hint_solution,
+    const std::map<int, int>& fixed_vertices,  // vertex_id, block_id
+    const Matrix<int>& hyperedges,
+    const std::vector<float>& hyperedge_weights,  // one-dimensional
+    const Matrix<float>& vertex_weights,          // two-dimensional
+    const Matrix<float>& upper_block_balance,
+    const Matrix<float>& lower_block_balance,
+    float time_limit,
+    int num_threads)
+{
+  const int num_vertices = static_cast<int>(vertex_weights.size());
+  const int num_hyperedges = static_cast<int>(hyperedge_weights.size());
+  CpModelBuilder cp_model;
+  // x[i][v] represents whether the vertex v is within block i
+  // y[i][e] represents whether the hyperedge e is fully within block i
+  std::vector<std::vector<BoolVar>> x(num_parts,
+                                      std::vector<BoolVar>(num_vertices));
+  std::vector<std::vector<BoolVar>> y(num_parts,
+                                      std::vector<BoolVar>(num_hyperedges));
+  for (auto& x_v_vector : x) {
+    for (auto& x_v : x_v_vector) {
+      x_v = cp_model.NewBoolVar();
+    }
+  }
+  for (auto& y_e_vector : y) {
+    for (auto& y_e : y_e_vector) {
+      y_e = cp_model.NewBoolVar();
+    }
+  }
+  // balance constraint
+  std::vector<int64_t> coeffs(num_vertices);
+  for (int j = 0; j < vertex_weight_dimension; j++) {
+    float max_weight = 0.0;
+    for (int v = 0; v < num_vertices; v++) {
+      max_weight = std::max(max_weight, vertex_weights[v][j]);
+    }
+    if (max_weight <= 0.0) {
+      continue;  // all the vertices have zero weight in this dimension
+    }
+    const double scale = kCpSatWeightScale / max_weight;
+    for (int v = 0; v < num_vertices; v++) {
+      coeffs[v] = std::llround(vertex_weights[v][j] * scale);
+    }
+    for (int i = 0; i < num_parts; i++) {
+      const LinearExpr balance_expr = LinearExpr::WeightedSum(x[i], coeffs);
+      cp_model.AddLessOrEqual(
+          balance_expr,
+          static_cast<int64_t>(std::floor(upper_block_balance[i][j] * scale)));
+      cp_model.AddGreaterOrEqual(
+          balance_expr,
+          static_cast<int64_t>(std::ceil(lower_block_balance[i][j] * scale)));
+    }
+  }
+  // fixed vertices constraints
+  for (const auto& [vertex_id, block_id] : fixed_vertices) {
+    cp_model.FixVariable(x[block_id][vertex_id], true);
+  }
+  // each vertex can only belong to one part
+  std::vector<BoolVar> vertex_blocks(num_parts);
+  for (int v = 0; v < num_vertices; v++) {
+    for (int i = 0; i < num_parts; i++) {
+      vertex_blocks[i] = x[i][v];
+    }
+    cp_model.AddExactlyOne(vertex_blocks);
+  }
+  // Hyperedge constraint: y[i][e] => x[i][v] for all the vertices of e
+  for (int e = 0; e < num_hyperedges; e++) {
+    for (const int v : hyperedges[e]) {
+      for (int i = 0; i < num_parts; i++) {
+        cp_model.AddImplication(y[i][e], x[i][v]);
+      }
+    }
+  }
+  // Maximize the weight of the hyperedges fully within one block
+  // -> minimize the cutsize
+  float max_hyperedge_weight = 0.0;
+  for (const float weight : hyperedge_weights) {
+    max_hyperedge_weight = std::max(max_hyperedge_weight, weight);
+  }
+  if (max_hyperedge_weight > 0.0) {
+    const double scale = kCpSatWeightScale / max_hyperedge_weight;
+    std::vector<BoolVar> obj_vars;
+    std::vector<int64_t> obj_coeffs;
+    obj_vars.reserve(static_cast<size_t>(num_hyperedges) * num_parts);
+    obj_coeffs.reserve(static_cast<size_t>(num_hyperedges) * num_parts);
+    for (int e = 0; e < num_hyperedges; e++) {
+      const int64_t weight = std::llround(hyperedge_weights[e] * scale);
+      for (int i = 0; i < num_parts; i++) {
+        obj_vars.push_back(y[i][e]);
+        obj_coeffs.push_back(weight);
+      }
+    }
+    cp_model.Maximize(LinearExpr::WeightedSum(obj_vars, obj_coeffs));
+  }
+
+  // warm start from the hint solution
+  if (hint_solution.empty() == false) {
+    for (int v = 0; v < num_vertices; v++) {
+      for (int i = 0; i < num_parts; i++) {
+        cp_model.AddHint(x[i][v], hint_solution[v] == i);
+      }
+    }
+    for (int e = 0; e < num_hyperedges; e++) {
+      const std::vector<int>& hyperedge = hyperedges[e];
+      for (int i = 0; i < num_parts; i++) {
+        cp_model.AddHint(
+            y[i][e],
+            std::all_of(hyperedge.begin(), hyperedge.end(), [&](int v) {
+              return hint_solution[v] == i;
+            }));
+      }
+    }
+  }
+
+  // Solve the model with parallel search workers
+  SatParameters parameters;
+  parameters.set_num_workers(std::max(num_threads, 1));
+  if (time_limit > 0.0) {
+    parameters.set_max_time_in_seconds(time_limit);
+  }
+  Model model;
+  model.Add(NewSatParameters(parameters));
+  const CpSolverResponse response = SolveCpModel(cp_model.Build(), &model);
+
+  // If the time limit is reached, use the best solution found so far
+  if (response.status() == CpSolverStatus::OPTIMAL
+      || response.status() == CpSolverStatus::FEASIBLE) {
+    for (int v = 0; v < num_vertices; v++) {
+      for (int i = 0; i < num_parts; i++) {
+        if (SolutionBooleanValue(response, x[i][v]) == true) {
+          solution[v] = i;
+          break;
+        }
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
 // ILP-based Partitioning Instance
 // Call ILP Solver to partition the design
 // We use Google OR-Tools as our ILP solver
@@ -328,7 +792,10 @@ bool ILPPartitionInst(
     const std::vector<float>& hyperedge_weights,  // one-dimensional
     const Matrix<float>& vertex_weights,          // two-dimensional
     const Matrix<float>& upper_block_balance,
-    const Matrix<float>& lower_block_balance)
+    const Matrix<float>& lower_block_balance,
+    float time_limit,
+    int num_threads,
+    IlpSolver ilp_solver)
 {
   const int num_vertices = static_cast<int>(vertex_weights.size());
   const int num_hyperedges = static_cast<int>(hyperedge_weights.size());
@@ -351,13 +818,51 @@ bool ILPPartitionInst(
                           lower_block_balance);
 #endif
 
+  // keep the incoming solution as the hint
+  std::vector<int> hint_solution;
+  if (static_cast<int>(solution.size()) == num_vertices
+      && std::all_of(solution.begin(), solution.end(), [&](int block_id) {
+           return block_id >= 0 && block_id < num_parts;
+         })) {
+    hint_solution = solution;
+  }
+
   // reset variable
   solution.clear();
   solution.resize(num_vertices);
   std::fill(solution.begin(), solution.end(), -1);
 
+  if (ilp_solver == IlpSolver::AUTO) {
+    const int64_t num_variables
+        = static_cast<int64_t>(num_vertices + num_hyperedges) * num_parts;
+    ilp_solver = (num_threads > 1 && num_variables >= kCpSatMinVariables)
+                     ? IlpSolver::CP_SAT
+                     : IlpSolver::SCIP;
+  }
+  if (ilp_solver == IlpSolver::CP_SAT) {
+    return CpSatPartitionInst(num_parts,
+                              vertex_weight_dimension,
+                              solution,
+                              hint_solution,
+                              fixed_vertices,
+                              hyperedges,
+                              hyperedge_weights,
+                              vertex_weights,
+                              upper_block_balance,
+                              lower_block_balance,
+                              time_limit,
+                              num_threads);
+  }
+
   // Google OR-Tools Implementation
   std::unique_ptr<MPSolver> solver(MPSolver::CreateSolver("SCIP"));
+  if (time_limit > 0.0) {
+    solver->SetTimeLimit(
+        absl::Milliseconds(static_cast<int64_t>(time_limit * 1000)));
+  }
+  if (num_threads > 1) {
+    solver->SetNumThreads(num_threads).IgnoreError();
+  }
 
   // Define constraints
   // For each vertex, define a variable x
@@ -443,17 +948,42 @@ bool ILPPartitionInst(
   }
   obj_expr->SetMaximization();
 
+  // warm start from the hint solution
+  if (hint_solution.empty() == false) {
+    std::vector<std::pair<const MPVariable*, double>> hint;
+    hint.reserve(static_cast<size_t>(num_vertices + num_hyperedges)
+                 * num_parts);
+    for (int v = 0; v < num_vertices; v++) {
+      for (int i = 0; i < num_parts; i++) {
+        hint.emplace_back(x[i][v], hint_solution[v] == i ? 1.0 : 0.0);
+      }
+    }
+    for (int e = 0; e < num_hyperedges; e++) {
+      const std::vector<int>& hyperedge = hyperedges[e];
+      for (int i = 0; i < num_parts; i++) {
+        const bool within_block_flag
+            = std::all_of(hyperedge.begin(), hyperedge.end(), [&](int v) {
+                return hint_solution[v] == i;
+              });
+        hint.emplace_back(y[i][e], within_block_flag == true ? 1.0 : 0.0);
+      }
+    }
+    solver->SetHint(hint);
+  }
+
   // Solve the ILP Problem
   const MPSolver::ResultStatus result_status = solver->Solve();
 
   // Check that the problem has an optimal solution.
-  if (result_status == MPSolver::OPTIMAL) {
+  // If the time limit is reached, use the best solution found so far
+  if (result_status == MPSolver::OPTIMAL
+      || result_status == MPSolver::FEASIBLE) {
     // update the solution
     // all the fixed vertices has been encoded into fixed vertices constraints
     // so we do not handle fixed vertices here
     for (int v = 0; v < num_vertices; v++) {
       for (int i = 0; i < num_parts; i++) {
-        if (x[i][v]->solution_value() == 1.0) {
+        if (x[i][v]->solution_value() > 0.5) {
           solution[v] = i;
           break;
         }
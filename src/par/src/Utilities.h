@@ -36,8 +36,14 @@
 // This file includes the basic utility functions for operations
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include <boost/range/iterator_range.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <map>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #ifdef LOAD_CPLEX
@@ -52,6 +58,84 @@ namespace par {
 template <typename T>
 using Matrix = std::vector<std::vector<T>>;
 
+// A read-only view of a contiguous sequence of floats, e.g., the weights
+// of a vertex in the flat storage of Hypergraph. A std::vector<float> can
+// be implicitly converted to a FloatView without any copy.
+using FloatView = boost::iterator_range<std::vector<float>::const_iterator>;
+
+// The block changes along a timing path under a partitioning solution.
+// num_cuts is the number of cuts on the path, and max_block_visits is the
+// maximum number of times the path enters one block (the snaking factor
+// plus one).
+struct PathCuts
+{
+  int num_cuts = 0;
+  int max_block_visits = 0;
+};
+
+// Count the block changes along path (the vertices of a timing path).
+// If to_pid > -1, the vertex v is counted in block to_pid instead of
+// solution[v].  No memory is allocated for up to 64 blocks.
+PathCuts CountPathCuts(
+    boost::iterator_range<std::vector<int>::const_iterator> path,
+    const std::vector<int>& solution,
+    int num_parts,
+    int v = -1,
+    int to_pid = -1);
+
+// The number of vertices of each hyperedge in each block (net degrees).
+// All the counts are stored in one contiguous num_hyperedges x num_parts
+// array, and net_degs[e] is a view of the num_parts counts of hyperedge e,
+// i.e., net_degs[e][i] is the number of vertices of hyperedge e in block i.
+class NetDegrees
+{
+ public:
+  using Row = boost::iterator_range<int*>;
+  using ConstRow = boost::iterator_range<const int*>;
+
+  NetDegrees() = default;
+  NetDegrees(int num_hyperedges, int num_parts)
+      : num_parts_(num_parts),
+        degs_(static_cast<size_t>(num_hyperedges) * num_parts, 0)
+  {
+  }
+
+  int GetNumParts() const { return num_parts_; }
+
+  Row operator[](int e)
+  {
+    int* row = degs_.data() + Offset(e);
+    return Row(row, row + num_parts_);
+  }
+
+  ConstRow operator[](int e) const
+  {
+    const int* row = degs_.data() + Offset(e);
+    return ConstRow(row, row + num_parts_);
+  }
+
+  // Number of blocks spanned by hyperedge e.  The loop has no branch, so
+  // the compiler can vectorize it.
+  int GetSpan(int e) const
+  {
+    const int* row = degs_.data() + Offset(e);
+    int span = 0;
+    for (int i = 0; i < num_parts_; i++) {
+      span += static_cast<int>(row[i] > 0);
+    }
+    return span;
+  }
+
+  // Return true if hyperedge e spans more than one block
+  bool IsCut(int e) const { return GetSpan(e) > 1; }
+
+ private:
+  size_t Offset(int e) const { return static_cast<size_t>(e) * num_parts_; }
+
+  int num_parts_ = 0;
+  std::vector<int> degs_;
+};
+
 struct Rect
 {
   // all the values are in db unit
@@ -91,8 +175,167 @@ std::string GetVectorString(const std::vector<float>& vec);
 // Split a string based on deliminator : empty space and ","
 std::vector<std::string> SplitLine(const std::string& line);
 
-// Add right vector to left vector
-void Accumulate(std::vector<float>& a, const std::vector<float>& b);
+// A fast reader for text files, e.g., the hypergraph file in hMETIS format.
+// The whole file is loaded into memory with a single read, then the lines
+// and numbers are parsed in place without creating intermediate strings.
+// The numbers in a line are separated by white spaces.
+// In the streaming mode, the file is read in chunks of chunk_size bytes and
+// only the chunk of the current line is kept in memory.
+class TextFileReader
+{
+ public:
+  // Load the file (chunk_size = 0) or open it in the streaming mode.
+  // Return false if the file cannot be opened.
+  bool Open(const std::string& file_name, size_t chunk_size = 0);
+
+  // Move to the next line. Return false if there is no more line,
+  // then the current line is empty.
+  bool NextLine();
+
+  // Parse the next number in the current line.
+  // Return false if the current line is finished or the next element
+  // is not a number.
+  bool NextInt(int& value);
+  bool NextFloat(float& value);
+
+  // Get the next element in the current line.
+  // The elements are separated by white spaces and ",".
+  bool NextToken(std::string_view& token);
+
+  // Check if all the elements in the current line have been parsed
+  bool EndOfLine();
+
+ private:
+  // skip the deliminators in the current line
+  void SkipDelims(std::string_view delims);
+
+  // Streaming mode: drop the lines before next_line_ and append the next
+  // chunk of the file to the buffer. Return false at the end of the file
+  bool ReadChunk();
+
+  std::string buffer_;     // the content of the file
+  size_t line_end_ = 0;    // the end of the current line
+  size_t next_line_ = 0;   // the start of the next line
+  size_t pos_ = 0;         // the current position in the current line
+  // the file in the streaming mode (nullptr if the file is loaded)
+  std::unique_ptr<std::ifstream> stream_;
+  size_t chunk_size_ = 0;
+};
+
+// The binary hypergraph file starts with the magic string and
+// the version of the format (see GoldenEvaluator::WriteBinaryHypergraph).
+// Version 1 stores the offsets of the hyperedges and timing paths as int,
+// version 2 stores them as int64_t
+constexpr std::string_view binary_hypergraph_magic = "TPARTHGR";
+constexpr int binary_hypergraph_version = 2;
+
+// Check if the file is a binary hypergraph file
+bool IsBinaryHypergraphFile(const std::string& file_name);
+
+// A reader for binary files.
+// The whole file is loaded into memory with a single read, then the arrays
+// are copied out of the buffer directly without any parsing.
+// In the streaming mode, the arrays are read from the file directly.
+class BinaryFileReader
+{
+ public:
+  // Load the file, or open it in the streaming mode, where the elements
+  // are read from the file on demand.
+  // Return false if the file cannot be opened.
+  bool Open(const std::string& file_name, bool streaming = false);
+
+  // Copy the next size elements into values.
+  // Return false if the file does not have enough data.
+  template <typename T>
+  bool Read(std::vector<T>& values, size_t size)
+  {
+    if (stream_ != nullptr) {
+      values.resize(size);
+      stream_->read(reinterpret_cast<char*>(values.data()), size * sizeof(T));
+      return stream_->gcount()
+             == static_cast<std::streamsize>(size * sizeof(T));
+    }
+    if (size > (buffer_.size() - pos_) / sizeof(T)) {
+      return false;
+    }
+    values.resize(size);
+    std::memcpy(values.data(), buffer_.data() + pos_, size * sizeof(T));
+    pos_ += size * sizeof(T);
+    return true;
+  }
+
+  // Move to the byte offset of the file
+  void Seek(size_t offset);
+
+ private:
+  std::string buffer_;  // the content of the file
+  size_t pos_ = 0;      // the current position in the file
+  // the file in the streaming mode (nullptr if the file is loaded)
+  std::unique_ptr<std::ifstream> stream_;
+};
+
+// 64-bit FNV-1a hash of a sequence of values, e.g., the content of a
+// hypergraph and the partitioning parameters.  The hash only depends on the
+// bytes of the values, thus it is stable across runs on the same platform
+class Fingerprint
+{
+ public:
+  void Add(const void* data, size_t size);
+
+  template <typename T>
+  void AddValue(T value)
+  {
+    Add(&value, sizeof(T));
+  }
+
+  // the size is included, such that [a, b] [] differs from [a] [b]
+  template <typename T>
+  void AddVector(const std::vector<T>& values)
+  {
+    AddValue(values.size());
+    Add(values.data(), values.size() * sizeof(T));
+  }
+
+  void AddString(std::string_view value)
+  {
+    AddValue(value.size());
+    Add(value.data(), value.size());
+  }
+
+  uint64_t Get() const { return hash_; }
+
+  // the hash as 16 hexadecimal digits
+  std::string ToString() const;
+
+ private:
+  uint64_t hash_ = 14695981039346656037ULL;
+};
+
+// Copy the elements of a view into a vector
+std::vector<float> ToVector(FloatView a);
+
+// In-place vector arithmetic.
+// These functions update the left vector directly and never allocate,
+// so they should be used in the inner loops of refinement and evaluation.
+// a += b
+void Accumulate(std::vector<float>& a, FloatView b);
+
+// a -= b
+void Subtract(std::vector<float>& a, FloatView b);
+
+// a += factor * b
+void AccumulateScaled(std::vector<float>& a, FloatView b, float factor);
+
+// a *= factor
+void Scale(std::vector<float>& a, float factor);
+
+// Compare (a + factor * b) with c in lexicographic order (the order used
+// by the relational operators of std::vector) without building the sum.
+// Return -1 if less, 0 if equal and 1 if greater
+int CompareSum(FloatView a, FloatView b, float factor, FloatView c);
+
+// norm2(a - b, factor) without building the difference
+float Distance(FloatView a, FloatView b, const std::vector<float>& factor);
 
 // weighted sum
 std::vector<float> WeightedSum(const std::vector<float>& a,
@@ -108,22 +351,22 @@ std::vector<float> DivideVectorElebyEle(const std::vector<float>& emb,
                                         const std::vector<float>& factor);
 
 // multiplty the vector
-std::vector<float> MultiplyFactor(const std::vector<float>& a, float factor);
+std::vector<float> MultiplyFactor(FloatView a, float factor);
 
 // operation for two vectors +, -, *,  ==, <
-std::vector<float> operator+(const std::vector<float>& a,
-                             const std::vector<float>& b);
+std::vector<float> operator+(FloatView a, FloatView b);
 
 std::vector<float> operator*(const std::vector<float>& a, float factor);
 
-std::vector<float> operator-(const std::vector<float>& a,
-                             const std::vector<float>& b);
+std::vector<float> operator-(FloatView a, FloatView b);
 
 std::vector<float> operator*(const std::vector<float>& a,
                              const std::vector<float>& b);
 
 bool operator<(const std::vector<float>& a, const std::vector<float>& b);
 
+bool operator<(FloatView a, FloatView b);
+
 bool operator<=(const Matrix<float>& a, const Matrix<float>& b);
 
 bool operator==(const std::vector<float>& a, const std::vector<float>& b);
@@ -135,8 +378,27 @@ float norm2(const std::vector<float>& a);
 
 float norm2(const std::vector<float>& a, const std::vector<float>& factor);
 
+// The solver used for the ILP-based partitioning
+enum class IlpSolver
+{
+  AUTO,   // choose the solver based on the size of the model
+  SCIP,   // SCIP through MPSolver (single search)
+  CP_SAT  // CP-SAT with parallel search workers
+};
+
+// function : convert IlpSolver to string
+std::string ToString(IlpSolver solver);
+
 // ILP-based Partitioning Instance
 // Call ILP Solver to partition the design
+// If solution is a valid partitioning when calling the function,
+// it is used as the hint (warm start) for the solver.
+// time_limit is the wall-clock budget of the solver in seconds
+// (time_limit <= 0 means no limit).  If the time limit is reached,
+// the best solution found by the solver is returned.
+// num_threads is the number of threads of SCIP, or the number of parallel
+// search workers of CP-SAT.  IlpSolver::AUTO uses CP-SAT if more than one
+// thread is allowed and the model is not tiny, and SCIP otherwise.
 bool ILPPartitionInst(
     int num_parts,
     int vertex_weight_dimension,
@@ -146,7 +408,10 @@ bool ILPPartitionInst(
     const std::vector<float>& hyperedge_weights,  // one-dimensional
     const Matrix<float>& vertex_weights,          // two-dimensional
     const Matrix<float>& upper_block_balance,
-    const Matrix<float>& lower_block_balance);
+    const Matrix<float>& lower_block_balance,
+    float time_limit = 0.0,
+    int num_threads = 1,
+    IlpSolver ilp_solver = IlpSolver::AUTO);
 
 // Call CPLEX to solve the ILP Based Partitioning
 #ifdef LOAD_CPLEX
@@ -35,8 +35,106 @@
 
 %{
 #include "par/PartitionMgr.h"
+
+// A view of a C-contiguous Python buffer (e.g., a NumPy array) whose
+// elements are T in the native byte order. The data is used in place.
+// None is a view with no elements.
+template <class T>
+class BufferView
+{
+ public:
+  ~BufferView()
+  {
+    if (open_) {
+      PyBuffer_Release(&view_);
+    }
+  }
+
+  bool Open(PyObject* obj, bool writable, char format)
+  {
+    if (obj == Py_None) {
+      return true;
+    }
+    int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT;
+    if (writable) {
+      flags |= PyBUF_WRITABLE;
+    }
+    if (PyObject_GetBuffer(obj, &view_, flags) != 0) {
+      PyErr_Clear();
+      return false;
+    }
+    open_ = true;
+    const char* type = view_.format != nullptr ? view_.format : "B";
+    const int one = 1;
+    const bool little_endian = *reinterpret_cast<const char*>(&one) == 1;
+    if (*type == '@' || *type == '=' || (*type == '<' && little_endian)
+        || (*type == '>' && !little_endian)) {
+      type++;
+    }
+    return view_.itemsize == sizeof(T) && type[0] == format && type[1] == '\0';
+  }
+
+  T* data() const { return open_ ? static_cast<T*>(view_.buf) : nullptr; }
+  int size() const
+  {
+    return open_ ? static_cast<int>(view_.len / view_.itemsize) : 0;
+  }
+
+ private:
+  Py_buffer view_;
+  bool open_ = false;
+};
+
+using IntBufferView = BufferView<int>;
+using FloatBufferView = BufferView<float>;
 %}
 
+// The arrays of tritonPartHypergraphArrays are passed as int32 / float32
+// buffers without copying, e.g.,
+//   solution = numpy.empty(num_vertices, dtype=numpy.int32)
+//   part.tritonPartHypergraphArrays(2, 2.0, 0, eptr, eind, vertex_weights,
+//                                   None, None, solution)
+%typemap(in) (const int* IN_ARRAY, int IN_SIZE) (IntBufferView view) {
+  if (!view.Open($input, false, 'i')) {
+    SWIG_exception_fail(SWIG_TypeError,
+                        "in method '$symname', expected a contiguous int32 "
+                        "array or None");
+  }
+  $1 = view.data();
+  $2 = view.size();
+}
+
+%typemap(in) (const float* IN_ARRAY, int IN_SIZE) (FloatBufferView view) {
+  if (!view.Open($input, false, 'f')) {
+    SWIG_exception_fail(SWIG_TypeError,
+                        "in method '$symname', expected a contiguous float32 "
+                        "array or None");
+  }
+  $1 = view.data();
+  $2 = view.size();
+}
+
+%typemap(in) (int* OUT_ARRAY, int OUT_SIZE) (IntBufferView view) {
+  if ($input == Py_None || !view.Open($input, true, 'i')) {
+    SWIG_exception_fail(SWIG_TypeError,
+                        "in method '$symname', expected a writable contiguous "
+                        "int32 array");
+  }
+  $1 = view.data();
+  $2 = view.size();
+}
+
+%apply (const int* IN_ARRAY, int IN_SIZE) {
+  (const int* eptr, int num_eptr),
+  (const int* eind, int num_eind),
+  (const int* fixed_attr, int num_fixed_attr)
+};
+%apply (const float* IN_ARRAY, int IN_SIZE) {
+  (const float* vertex_weights, int num_vertex_weights),
+  (const float* hyperedge_weights, int num_hyperedge_weights)
+};
+%apply (int* OUT_ARRAY, int OUT_SIZE) { (int* solution, int num_vertices) };
+
 %include "../../Exception-py.i"
 
 %include <std_vector.i>
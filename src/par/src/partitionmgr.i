@@ -38,6 +38,8 @@
 #include <iostream>
 #include <memory>
 #include <regex>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include "par/PartitionMgr.h"
@@ -69,6 +71,117 @@ int SwigDouble_As(Tcl_Interp * interp, Tcl_Obj * o, Type * val)
 %include "../../Exception.i"
 
 %inline %{
+void set_num_threads(int num_threads)
+{
+  getPartitionMgr()->setNumThreads(num_threads);
+}
+
+void set_init_plateau_window(int init_plateau_window)
+{
+  getPartitionMgr()->setInitPlateauWindow(init_plateau_window);
+}
+
+void set_gain_bucket_type(const char* gain_bucket_type, float gain_resolution)
+{
+  getPartitionMgr()->setGainBucketType(gain_bucket_type, gain_resolution);
+}
+
+void set_parallel_matching(bool parallel_matching)
+{
+  getPartitionMgr()->setParallelMatching(parallel_matching);
+}
+
+void set_detect_communities(bool detect_communities)
+{
+  getPartitionMgr()->setDetectCommunities(detect_communities);
+}
+
+void set_spectral_dimensions(int spectral_dimensions)
+{
+  getPartitionMgr()->setSpectralDimensions(spectral_dimensions);
+}
+
+void set_streaming_coarsening_ratio(float streaming_coarsening_ratio)
+{
+  getPartitionMgr()->setStreamingCoarseningRatio(streaming_coarsening_ratio);
+}
+
+void set_ilp_params(float ilp_time_limit,
+                    int ilp_num_threads,
+                    const char* ilp_solver)
+{
+  getPartitionMgr()->setIlpParams(ilp_time_limit, ilp_num_threads, ilp_solver);
+}
+
+void set_num_parallel_vcycles(int num_parallel_vcycles)
+{
+  getPartitionMgr()->setNumParallelVcycles(num_parallel_vcycles);
+}
+
+void set_num_vertices_threshold_lp(int num_vertices_threshold_lp)
+{
+  getPartitionMgr()->setNumVerticesThresholdLp(num_vertices_threshold_lp);
+}
+
+void set_partition_mode(const char* mode)
+{
+  getPartitionMgr()->setPartitionMode(mode);
+}
+
+void set_vertex_order(const char* order)
+{
+  getPartitionMgr()->setVertexOrder(order);
+}
+
+void set_lazy_gain_threshold(int lazy_gain_threshold)
+{
+  getPartitionMgr()->setLazyGainThreshold(lazy_gain_threshold);
+}
+
+void set_adaptive_stop_alpha(float adaptive_stop_alpha)
+{
+  getPartitionMgr()->setAdaptiveStopAlpha(adaptive_stop_alpha);
+}
+
+void set_fixed_point_bits(int fixed_point_bits)
+{
+  getPartitionMgr()->setFixedPointBits(fixed_point_bits);
+}
+
+void set_solution_cache_dir(const char* cache_dir)
+{
+  getPartitionMgr()->setSolutionCacheDir(cache_dir);
+}
+
+void set_time_limit(float time_limit)
+{
+  getPartitionMgr()->setTimeLimit(time_limit);
+}
+
+void set_distributed(const char* remote_host,
+                     unsigned short remote_port,
+                     const char* shared_volume)
+{
+  getPartitionMgr()->setDistributed(remote_host, remote_port, shared_volume);
+}
+
+void set_server(const char* server_host,
+                unsigned short server_port,
+                const char* hypergraph_id)
+{
+  getPartitionMgr()->setServer(server_host, server_port, hypergraph_id);
+}
+
+void set_reuse_timing_paths(bool reuse_timing_paths)
+{
+  getPartitionMgr()->setReuseTimingPaths(reuse_timing_paths);
+}
+
+void set_warm_start(bool warm_start)
+{
+  getPartitionMgr()->setWarmStart(warm_start);
+}
+
 void triton_part_hypergraph(unsigned int num_parts,
                             float balance_constraint,
                             const std::vector<float>& base_balance,
@@ -178,6 +291,63 @@ void evaluate_hypergraph_solution(unsigned int num_parts,
                                                 v_wt_factors);
 }
 
+// The solution files are separated by new lines
+void evaluate_hypergraph_solutions(unsigned int num_parts,
+                                   float balance_constraint,
+                                   const std::vector<float>& base_balance,
+                                   const std::vector<float>& scale_factor,
+                                   int vertex_dimension,
+                                   int hyperedge_dimension,
+                                   const char* hypergraph_file,
+                                   const char* fixed_file,
+                                   const char* group_file,
+                                   const char* solution_files,
+                                   const char* summary_file,
+                                   const std::vector<float>& e_wt_factors,
+                                   const std::vector<float>& v_wt_factors)
+{
+  std::vector<std::string> files;
+  std::istringstream files_input(solution_files);
+  std::string file;
+  while (std::getline(files_input, file)) {
+    if (!file.empty()) {
+      files.push_back(file);
+    }
+  }
+  getPartitionMgr()->evaluateHypergraphSolutions(num_parts,
+                                                 balance_constraint,
+                                                 base_balance,
+                                                 scale_factor,
+                                                 vertex_dimension,
+                                                 hyperedge_dimension,
+                                                 hypergraph_file,
+                                                 fixed_file,
+                                                 group_file,
+                                                 files,
+                                                 summary_file,
+                                                 e_wt_factors,
+                                                 v_wt_factors);
+}
+
+void write_hypergraph_binary(int vertex_dimension,
+                             int hyperedge_dimension,
+                             int placement_dimension,
+                             const char* hypergraph_file,
+                             const char* fixed_file,
+                             const char* community_file,
+                             const char* placement_file,
+                             const char* binary_file)
+{
+  getPartitionMgr()->writeHypergraphBinary(vertex_dimension,
+                                           hyperedge_dimension,
+                                           placement_dimension,
+                                           hypergraph_file,
+                                           fixed_file,
+                                           community_file,
+                                           placement_file,
+                                           binary_file);
+}
+
 void triton_part_design(unsigned int num_parts_arg,
                         float balance_constraint_arg,
                         const std::vector<float>& base_balance_arg,
@@ -71,6 +71,31 @@ sta::define_cmd_args "triton_part_hypergraph" {
   [-num_coarsen_solutions num_coarsen_solutions] \
   [-num_vertices_threshold_ilp num_vertices_threshold_ilp] \
   [-global_net_threshold global_net_threshold] \
+  [-init_plateau_window init_plateau_window] \
+  [-gain_bucket_type gain_bucket_type] \
+  [-gain_resolution gain_resolution] \
+  [-parallel_matching parallel_matching] \
+  [-detect_communities detect_communities] \
+  [-spectral_dimensions spectral_dimensions] \
+  [-streaming_coarsening_ratio streaming_coarsening_ratio] \
+  [-ilp_time_limit ilp_time_limit] \
+  [-ilp_num_threads ilp_num_threads] \
+  [-ilp_solver ilp_solver] \
+  [-num_parallel_vcycles num_parallel_vcycles] \
+  [-num_vertices_threshold_lp num_vertices_threshold_lp] \
+  [-mode mode] \
+  [-vertex_order vertex_order] \
+  [-lazy_gain_threshold lazy_gain_threshold] \
+  [-adaptive_stop_alpha adaptive_stop_alpha] \
+  [-fixed_point_bits fixed_point_bits] \
+  [-cache_dir cache_dir] \
+  [-time_limit time_limit] \
+  [-remote_host rhost] \
+  [-remote_port rport] \
+  [-shared_volume vol] \
+  [-server_host server_host] \
+  [-server_port server_port] \
+  [-hypergraph_id hypergraph_id] \
   }
 proc triton_part_hypergraph { args } {
   sta::parse_key_args "triton_part_hypergraph" args \
@@ -107,7 +132,32 @@ proc triton_part_hypergraph { args } {
             -max_num_vcycle \
             -num_coarsen_solutions \
             -num_vertices_threshold_ilp \
-            -global_net_threshold } \
+            -global_net_threshold \
+            -init_plateau_window \
+            -gain_bucket_type \
+            -gain_resolution \
+            -parallel_matching \
+            -detect_communities \
+            -spectral_dimensions \
+            -streaming_coarsening_ratio \
+            -ilp_time_limit \
+            -ilp_num_threads \
+            -ilp_solver \
+            -num_parallel_vcycles \
+            -num_vertices_threshold_lp \
+            -mode \
+            -vertex_order \
+            -lazy_gain_threshold \
+            -adaptive_stop_alpha \
+            -fixed_point_bits \
+            -cache_dir \
+            -time_limit \
+            -remote_host \
+            -remote_port \
+            -shared_volume \
+            -server_host \
+            -server_port \
+            -hypergraph_id } \
       flags {}
  
   if { ![info exists keys(-hypergraph_file)] } {
@@ -147,6 +197,31 @@ proc triton_part_hypergraph { args } {
   set num_coarsen_solutions 3
   set num_vertices_threshold_ilp 50
   set global_net_threshold 1000
+  set init_plateau_window 0
+  set gain_bucket_type "heap"
+  set gain_resolution 1.0
+  set parallel_matching false
+  set detect_communities false
+  set spectral_dimensions 0
+  set streaming_coarsening_ratio 0.0
+  set ilp_time_limit 0.0
+  set ilp_num_threads 1
+  set ilp_solver "auto"
+  set num_parallel_vcycles 1
+  set num_vertices_threshold_lp 0
+  set mode "direct"
+  set vertex_order "none"
+  set lazy_gain_threshold 0
+  set adaptive_stop_alpha 0.0
+  set fixed_point_bits 0
+  set cache_dir ""
+  set time_limit 0.0
+  set remote_host ""
+  set remote_port 0
+  set shared_volume ""
+  set server_host ""
+  set server_port 0
+  set hypergraph_id ""
   
   if { [info exists keys(-num_parts)] } {
     set num_parts $keys(-num_parts)
@@ -280,6 +355,128 @@ proc triton_part_hypergraph { args } {
     set global_net_threshold $keys(-global_net_threshold)
   }
 
+  if { [info exists keys(-init_plateau_window)] } {
+    set init_plateau_window $keys(-init_plateau_window)
+  }
+
+  if { [info exists keys(-gain_bucket_type)] } {
+    set gain_bucket_type $keys(-gain_bucket_type)
+  }
+
+  if { [info exists keys(-gain_resolution)] } {
+    set gain_resolution $keys(-gain_resolution)
+  }
+
+  if { [info exists keys(-parallel_matching)] } {
+    set parallel_matching $keys(-parallel_matching)
+  }
+  if { [info exists keys(-detect_communities)] } {
+    set detect_communities $keys(-detect_communities)
+  }
+  if { [info exists keys(-spectral_dimensions)] } {
+    set spectral_dimensions $keys(-spectral_dimensions)
+  }
+  if { [info exists keys(-streaming_coarsening_ratio)] } {
+    set streaming_coarsening_ratio $keys(-streaming_coarsening_ratio)
+  }
+
+  if { [info exists keys(-ilp_time_limit)] } {
+    set ilp_time_limit $keys(-ilp_time_limit)
+  }
+
+  if { [info exists keys(-ilp_num_threads)] } {
+    set ilp_num_threads $keys(-ilp_num_threads)
+  }
+
+  if { [info exists keys(-ilp_solver)] } {
+    set ilp_solver $keys(-ilp_solver)
+  }
+
+  if { [info exists keys(-num_parallel_vcycles)] } {
+    set num_parallel_vcycles $keys(-num_parallel_vcycles)
+  }
+
+  if { [info exists keys(-num_vertices_threshold_lp)] } {
+    set num_vertices_threshold_lp $keys(-num_vertices_threshold_lp)
+  }
+
+  if { [info exists keys(-mode)] } {
+    set mode $keys(-mode)
+  }
+
+  if { [info exists keys(-vertex_order)] } {
+    set vertex_order $keys(-vertex_order)
+  }
+
+  if { [info exists keys(-lazy_gain_threshold)] } {
+    set lazy_gain_threshold $keys(-lazy_gain_threshold)
+  }
+
+  if { [info exists keys(-adaptive_stop_alpha)] } {
+    set adaptive_stop_alpha $keys(-adaptive_stop_alpha)
+  }
+
+  if { [info exists keys(-fixed_point_bits)] } {
+    set fixed_point_bits $keys(-fixed_point_bits)
+  }
+
+  # reuse the solutions of identical runs
+  if { [info exists keys(-cache_dir)] } {
+    set cache_dir $keys(-cache_dir)
+  }
+
+  # the wall-clock budget of the partitioner in seconds (0 means no limit)
+  if { [info exists keys(-time_limit)] } {
+    set time_limit $keys(-time_limit)
+  }
+
+  # generate the candidate solutions on the dst workers
+  if { [info exists keys(-remote_host)] } {
+    set remote_host $keys(-remote_host)
+    if { [info exists keys(-remote_port)] } {
+      set remote_port $keys(-remote_port)
+    } else {
+      utl::error PAR 0928 "-remote_port is required for distributed partitioning."
+    }
+    if { [info exists keys(-shared_volume)] } {
+      set shared_volume $keys(-shared_volume)
+    } else {
+      utl::error PAR 0929 "-shared_volume is required for distributed partitioning."
+    }
+  }
+
+  # partition the resident hypergraph on a dst worker
+  if { [info exists keys(-server_host)] } {
+    set server_host $keys(-server_host)
+    if { [info exists keys(-server_port)] } {
+      set server_port $keys(-server_port)
+    } else {
+      utl::error PAR 0932 "-server_port is required for the server mode."
+    }
+  }
+  if { [info exists keys(-hypergraph_id)] } {
+    set hypergraph_id $keys(-hypergraph_id)
+  }
+
+  par::set_num_threads [ord::thread_count]
+  par::set_init_plateau_window $init_plateau_window
+  par::set_gain_bucket_type $gain_bucket_type $gain_resolution
+  par::set_parallel_matching $parallel_matching
+  par::set_detect_communities $detect_communities
+  par::set_spectral_dimensions $spectral_dimensions
+  par::set_streaming_coarsening_ratio $streaming_coarsening_ratio
+  par::set_ilp_params $ilp_time_limit $ilp_num_threads $ilp_solver
+  par::set_num_parallel_vcycles $num_parallel_vcycles
+  par::set_num_vertices_threshold_lp $num_vertices_threshold_lp
+  par::set_partition_mode $mode
+  par::set_vertex_order $vertex_order
+  par::set_lazy_gain_threshold $lazy_gain_threshold
+  par::set_adaptive_stop_alpha $adaptive_stop_alpha
+  par::set_fixed_point_bits $fixed_point_bits
+  par::set_solution_cache_dir $cache_dir
+  par::set_time_limit $time_limit
+  par::set_distributed $remote_host $remote_port $shared_volume
+  par::set_server $server_host $server_port $hypergraph_id
   par::triton_part_hypergraph $num_parts \
             $balance_constraint \
             $base_balance \
@@ -322,7 +519,9 @@ sta::define_cmd_args "evaluate_hypergraph_solution" {
   -num_parts num_parts \
   -balance_constraint balance_constraint \
   -hypergraph_file hypergraph_file \
-  -solution_file solution_file \
+  [-solution_file solution_file] \
+  [-solution_files solution_files] \
+  [-summary_file summary_file] \
   [-base_balance base_balance] \
   [-scale_factor scale_factor] \
   [-vertex_dimension vertex_dimension] \
@@ -330,7 +529,10 @@ sta::define_cmd_args "evaluate_hypergraph_solution" {
   [-fixed_file fixed_file] \
   [-group_file group_file] \
   [-e_wt_factors e_wt_factors] \
-  [-v_wt_factors v_wt_factors] \ 
+  [-v_wt_factors v_wt_factors] \
+  [-server_host server_host] \
+  [-server_port server_port] \
+  [-hypergraph_id hypergraph_id] \
   }
 proc evaluate_hypergraph_solution { args } {
   sta::parse_key_args "evaluate_hypergraph_solution" args \
@@ -342,17 +544,29 @@ proc evaluate_hypergraph_solution { args } {
             -hyperedge_dimension \
             -hypergraph_file \
             -solution_file \
+            -solution_files \
+            -summary_file \
             -fixed_file \
             -group_file \
             -e_wt_factors \
             -v_wt_factors \
+            -server_host \
+            -server_port \
+            -hypergraph_id \
              } \
       flags {}
   if { ![info exists keys(-hypergraph_file)] } {
     utl::error PAR 0925 "Missing mandatory argument -hypergraph_file."
   }
+  if { ![info exists keys(-solution_file)] \
+       && ![info exists keys(-solution_files)] } {
+    utl::error PAR 0930 "Missing mandatory argument -solution_file or -solution_files."
+  }
   set hypergraph_file $keys(-hypergraph_file)
-  set solution_file $keys(-solution_file)
+  set summary_file ""
+  if { [info exists keys(-summary_file)] } {
+    set summary_file $keys(-summary_file)
+  }
   set num_parts 2
   set base_balance { 1.0 }
   set scale_factor { 1.0 }
@@ -363,6 +577,9 @@ proc evaluate_hypergraph_solution { args } {
   set group_file ""
   set e_wt_factors { 1.0 }
   set v_wt_factors { 1.0 }
+  set server_host ""
+  set server_port 0
+  set hypergraph_id ""
   
   if { [info exists keys(-num_parts)] } {
     set num_parts $keys(-num_parts)
@@ -407,7 +624,47 @@ proc evaluate_hypergraph_solution { args } {
   if { [info exists keys(-v_wt_factors)] } {
     set v_wt_factors $keys(-v_wt_factors)
   }
+
+  # evaluate the solution on the resident hypergraph of a dst worker
+  if { [info exists keys(-server_host)] } {
+    set server_host $keys(-server_host)
+    if { [info exists keys(-server_port)] } {
+      set server_port $keys(-server_port)
+    } else {
+      utl::error PAR 0933 "-server_port is required for the server mode."
+    }
+  }
+  if { [info exists keys(-hypergraph_id)] } {
+    set hypergraph_id $keys(-hypergraph_id)
+  }
+  par::set_server $server_host $server_port $hypergraph_id
  
+  # each entry of -solution_files can be a glob pattern
+  if { [info exists keys(-solution_files)] } {
+    set solution_files {}
+    foreach pattern $keys(-solution_files) {
+      set files [lsort [glob -nocomplain -- $pattern]]
+      if { [llength $files] == 0 } {
+        utl::warn PAR 0931 "No solution file matches $pattern."
+      }
+      lappend solution_files {*}$files
+    }
+    par::evaluate_hypergraph_solutions $num_parts \
+            $balance_constraint \
+            $base_balance \
+            $scale_factor \
+            $vertex_dimension \
+            $hyperedge_dimension \
+            $hypergraph_file \
+            $fixed_file \
+            $group_file \
+            [join $solution_files "\n"] \
+            $summary_file \
+            $e_wt_factors \
+            $v_wt_factors
+    return
+  }
+
   par::evaluate_hypergraph_solution $num_parts \
             $balance_constraint \
             $base_balance \
@@ -417,12 +674,84 @@ proc evaluate_hypergraph_solution { args } {
             $hypergraph_file \
             $fixed_file \
             $group_file \
-            $solution_file \
+            $keys(-solution_file) \
             $e_wt_factors \
             $v_wt_factors
 }
 
 
+sta::define_cmd_args "write_hypergraph_binary" {
+  -hypergraph_file hypergraph_file \
+  -binary_file binary_file \
+  [-vertex_dimension vertex_dimension] \
+  [-hyperedge_dimension hyperedge_dimension] \
+  [-placement_dimension placement_dimension] \
+  [-fixed_file fixed_file] \
+  [-community_file community_file] \
+  [-placement_file placement_file] \
+  }
+proc write_hypergraph_binary { args } {
+  sta::parse_key_args "write_hypergraph_binary" args \
+      keys {-hypergraph_file \
+            -binary_file \
+            -vertex_dimension \
+            -hyperedge_dimension \
+            -placement_dimension \
+            -fixed_file \
+            -community_file \
+            -placement_file \
+             } \
+      flags {}
+  if { ![info exists keys(-hypergraph_file)] } {
+    utl::error PAR 0926 "Missing mandatory argument -hypergraph_file."
+  }
+  if { ![info exists keys(-binary_file)] } {
+    utl::error PAR 0927 "Missing mandatory argument -binary_file."
+  }
+  set hypergraph_file $keys(-hypergraph_file)
+  set binary_file $keys(-binary_file)
+  set vertex_dimension 1
+  set hyperedge_dimension 1
+  set placement_dimension 0
+  set fixed_file ""
+  set community_file ""
+  set placement_file ""
+
+  if { [info exists keys(-vertex_dimension)] } {
+    set vertex_dimension $keys(-vertex_dimension)
+  }
+
+  if { [info exists keys(-hyperedge_dimension)] } {
+    set hyperedge_dimension $keys(-hyperedge_dimension)
+  }
+
+  if { [info exists keys(-placement_dimension)] } {
+    set placement_dimension $keys(-placement_dimension)
+  }
+
+  if { [info exists keys(-fixed_file)] } {
+    set fixed_file $keys(-fixed_file)
+  }
+
+  if { [info exists keys(-community_file)] } {
+    set community_file $keys(-community_file)
+  }
+
+  if { [info exists keys(-placement_file)] } {
+    set placement_file $keys(-placement_file)
+  }
+
+  par::write_hypergraph_binary $vertex_dimension \
+            $hyperedge_dimension \
+            $placement_dimension \
+            $hypergraph_file \
+            $fixed_file \
+            $community_file \
+            $placement_file \
+            $binary_file
+}
+
+
 sta::define_cmd_args "triton_part_design" { [-num_parts num_parts] \
                                             [-balance_constraint balance_constraint] \
                                             [-base_balance base_balance] \
@@ -467,6 +796,24 @@ sta::define_cmd_args "triton_part_design" { [-num_parts num_parts] \
                                             [-num_coarsen_solutions num_coarsen_solutions] \
                                             [-num_vertices_threshold_ilp num_vertices_threshold_ilp] \
                                             [-global_net_threshold global_net_threshold] \
+                                            [-init_plateau_window init_plateau_window] \
+                                            [-gain_bucket_type gain_bucket_type] \
+                                            [-gain_resolution gain_resolution] \
+                                            [-parallel_matching parallel_matching] \
+                                            [-detect_communities detect_communities] \
+                                            [-spectral_dimensions spectral_dimensions] \
+                                            [-reuse_timing_paths reuse_timing_paths] \
+                                            [-warm_start warm_start] \
+                                            [-vertex_order vertex_order] \
+                                            [-lazy_gain_threshold lazy_gain_threshold] \
+                                            [-adaptive_stop_alpha adaptive_stop_alpha] \
+                                            [-fixed_point_bits fixed_point_bits] \
+                                            [-time_limit time_limit] \
+                                            [-ilp_time_limit ilp_time_limit] \
+                                            [-ilp_num_threads ilp_num_threads] \
+                                            [-ilp_solver ilp_solver] \
+                                            [-num_parallel_vcycles num_parallel_vcycles] \
+                                            [-num_vertices_threshold_lp num_vertices_threshold_lp] \
                                           }
 proc triton_part_design { args } {
   sta::parse_key_args "triton_part_design" args \
@@ -513,7 +860,25 @@ proc triton_part_design { args } {
             -max_num_vcycle \
             -num_coarsen_solutions \
             -num_vertices_threshold_ilp \
-            -global_net_threshold } \
+            -global_net_threshold \
+            -init_plateau_window \
+            -gain_bucket_type \
+            -gain_resolution \
+            -parallel_matching \
+            -detect_communities \
+            -spectral_dimensions \
+            -reuse_timing_paths \
+            -warm_start \
+            -vertex_order \
+            -lazy_gain_threshold \
+            -adaptive_stop_alpha \
+            -fixed_point_bits \
+            -time_limit \
+            -ilp_time_limit \
+            -ilp_num_threads \
+            -ilp_solver \
+            -num_parallel_vcycles \
+            -num_vertices_threshold_lp } \
       flags {}
   set num_parts 2
   set balance_constraint 1.0
@@ -559,6 +924,24 @@ proc triton_part_design { args } {
   set num_coarsen_solutions 4
   set num_vertices_threshold_ilp 50
   set global_net_threshold 1000
+  set init_plateau_window 0
+  set gain_bucket_type "heap"
+  set gain_resolution 1.0
+  set parallel_matching false
+  set detect_communities false
+  set spectral_dimensions 0
+  set ilp_time_limit 0.0
+  set ilp_num_threads 1
+  set ilp_solver "auto"
+  set num_parallel_vcycles 1
+  set num_vertices_threshold_lp 0
+  set reuse_timing_paths false
+  set warm_start false
+  set vertex_order "none"
+  set lazy_gain_threshold 0
+  set adaptive_stop_alpha 0.0
+  set fixed_point_bits 0
+  set time_limit 0.0
   
   if { [info exists keys(-num_parts)] } {
       set num_parts $keys(-num_parts)
@@ -728,7 +1111,93 @@ proc triton_part_design { args } {
     set global_net_threshold $keys(-global_net_threshold)
   }
 
+  if { [info exists keys(-init_plateau_window)] } {
+    set init_plateau_window $keys(-init_plateau_window)
+  }
+
+  if { [info exists keys(-gain_bucket_type)] } {
+    set gain_bucket_type $keys(-gain_bucket_type)
+  }
+
+  if { [info exists keys(-gain_resolution)] } {
+    set gain_resolution $keys(-gain_resolution)
+  }
+
+  if { [info exists keys(-parallel_matching)] } {
+    set parallel_matching $keys(-parallel_matching)
+  }
+  if { [info exists keys(-detect_communities)] } {
+    set detect_communities $keys(-detect_communities)
+  }
+  if { [info exists keys(-spectral_dimensions)] } {
+    set spectral_dimensions $keys(-spectral_dimensions)
+  }
+
+  if { [info exists keys(-ilp_time_limit)] } {
+    set ilp_time_limit $keys(-ilp_time_limit)
+  }
+
+  if { [info exists keys(-ilp_num_threads)] } {
+    set ilp_num_threads $keys(-ilp_num_threads)
+  }
+
+  if { [info exists keys(-ilp_solver)] } {
+    set ilp_solver $keys(-ilp_solver)
+  }
+
+  if { [info exists keys(-num_parallel_vcycles)] } {
+    set num_parallel_vcycles $keys(-num_parallel_vcycles)
+  }
+
+  if { [info exists keys(-num_vertices_threshold_lp)] } {
+    set num_vertices_threshold_lp $keys(-num_vertices_threshold_lp)
+  }
+
+  if { [info exists keys(-reuse_timing_paths)] } {
+    set reuse_timing_paths $keys(-reuse_timing_paths)
+  }
+
+  if { [info exists keys(-warm_start)] } {
+    set warm_start $keys(-warm_start)
+  }
+
+  if { [info exists keys(-vertex_order)] } {
+    set vertex_order $keys(-vertex_order)
+  }
+
+  if { [info exists keys(-lazy_gain_threshold)] } {
+    set lazy_gain_threshold $keys(-lazy_gain_threshold)
+  }
+
+  if { [info exists keys(-adaptive_stop_alpha)] } {
+    set adaptive_stop_alpha $keys(-adaptive_stop_alpha)
+  }
+
+  if { [info exists keys(-fixed_point_bits)] } {
+    set fixed_point_bits $keys(-fixed_point_bits)
+  }
+
+  # the wall-clock budget of the partitioner in seconds (0 means no limit)
+  if { [info exists keys(-time_limit)] } {
+    set time_limit $keys(-time_limit)
+  }
 
+  par::set_num_threads [ord::thread_count]
+  par::set_init_plateau_window $init_plateau_window
+  par::set_gain_bucket_type $gain_bucket_type $gain_resolution
+  par::set_parallel_matching $parallel_matching
+  par::set_detect_communities $detect_communities
+  par::set_spectral_dimensions $spectral_dimensions
+  par::set_ilp_params $ilp_time_limit $ilp_num_threads $ilp_solver
+  par::set_num_parallel_vcycles $num_parallel_vcycles
+  par::set_num_vertices_threshold_lp $num_vertices_threshold_lp
+  par::set_reuse_timing_paths $reuse_timing_paths
+  par::set_warm_start $warm_start
+  par::set_vertex_order $vertex_order
+  par::set_lazy_gain_threshold $lazy_gain_threshold
+  par::set_adaptive_stop_alpha $adaptive_stop_alpha
+  par::set_fixed_point_bits $fixed_point_bits
+  par::set_time_limit $time_limit
   par::triton_part_design $num_parts \
             $balance_constraint \
             $base_balance \
@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+// Tests of the spectral embedding on 2D grids, whose eigenvectors are known.
+// On a W x H grid with W much larger than H, the two leading nontrivial
+// eigenvectors only depend on the column x of the vertex and are close to
+// cos(k * pi * x / (W - 1)), k = 1, 2, which are the exact eigenvectors of
+// the random walk on a path of W vertices.
+
+#define BOOST_TEST_MODULE TestEmbedding
+#include <boost/test/included/unit_test.hpp>
+#include <cmath>
+#include <vector>
+
+#include "Embedding.h"
+#include "Hypergraph.h"
+#include "ThreadPool.h"
+#include "Utilities.h"
+#include "utl/Logger.h"
+
+namespace par {
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 4;
+constexpr int kNumDimensions = 2;
+
+// A kWidth x kHeight grid, where vertex y * kWidth + x is in column x
+static HGraphPtr MakeGrid(utl::Logger* logger)
+{
+  Matrix<int> hyperedges;
+  for (int y = 0; y < kHeight; y++) {
+    for (int x = 0; x < kWidth; x++) {
+      const int v = y * kWidth + x;
+      if (x + 1 < kWidth) {
+        hyperedges.push_back({v, v + 1});
+      }
+      if (y + 1 < kHeight) {
+        hyperedges.push_back({v, v + kWidth});
+      }
+    }
+  }
+  const Matrix<float> vertex_weights(kWidth * kHeight,
+                                     std::vector<float>(1, 1.0));
+  const Matrix<float> hyperedge_weights(hyperedges.size(),
+                                        std::vector<float>(1, 1.0));
+  return std::make_shared<Hypergraph>(1,
+                                      1,
+                                      0,
+                                      hyperedges,
+                                      vertex_weights,
+                                      hyperedge_weights,
+                                      std::vector<int>{},
+                                      std::vector<int>{},
+                                      Matrix<float>{},
+                                      logger);
+}
+
+// The coefficient of determination of the linear regression of y on x
+static double GetRSquared(const std::vector<double>& x,
+                          const std::vector<double>& y)
+{
+  const int n = x.size();
+  double mean_x = 0.0;
+  double mean_y = 0.0;
+  for (int i = 0; i < n; i++) {
+    mean_x += x[i] / n;
+    mean_y += y[i] / n;
+  }
+  double sxy = 0.0;
+  double sxx = 0.0;
+  double syy = 0.0;
+  for (int i = 0; i < n; i++) {
+    sxy += (x[i] - mean_x) * (y[i] - mean_y);
+    sxx += (x[i] - mean_x) * (x[i] - mean_x);
+    syy += (y[i] - mean_y) * (y[i] - mean_y);
+  }
+  return sxy * sxy / (sxx * syy);
+}
+
+static void CheckGridEmbedding(ThreadPool* thread_pool)
+{
+  utl::Logger logger;
+  const HGraphPtr hgraph = MakeGrid(&logger);
+  const std::vector<float> edge_weights(hgraph->GetNumHyperedges(), 1.0);
+  const SpectralEmbedding spectral_embedding(kNumDimensions,
+                                             /* max_hyperedge_size */ 50,
+                                             /* max_num_iters */ 20,
+                                             /* seed */ 0,
+                                             thread_pool,
+                                             &logger);
+  const std::vector<float> embedding
+      = spectral_embedding.Compute(hgraph, edge_weights);
+  BOOST_TEST(embedding.size() == kWidth * kHeight * kNumDimensions);
+
+  for (int k = 1; k <= kNumDimensions; k++) {
+    std::vector<double> expected;
+    std::vector<double> coordinates;
+    for (int v = 0; v < hgraph->GetNumVertices(); v++) {
+      const int x = v % kWidth;
+      expected.push_back(std::cos(k * M_PI * x / (kWidth - 1)));
+      coordinates.push_back(embedding[v * kNumDimensions + k - 1]);
+    }
+    BOOST_TEST(GetRSquared(expected, coordinates) > 0.999);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(grid_serial)
+{
+  CheckGridEmbedding(nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(grid_parallel)
+{
+  ThreadPool thread_pool(4);
+  CheckGridEmbedding(&thread_pool);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace par
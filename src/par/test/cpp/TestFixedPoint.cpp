@@ -0,0 +1,220 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Tests of the timing update of GoldenEvaluator.  The incremental update,
+//
+// Tests of the fixed-point mode of the refiners (-fixed_point_bits).  The
+// costs, the vertex weights and the gains are integers, so the refined
+// solution must not depend on the number of threads.
+
+#define BOOST_TEST_MODULE TestFixedPoint
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Evaluator.h"
+#include "GreedyRefine.h"
+#include "Hypergraph.h"
+#include "KWayFMRefine.h"
+#include "KWayPMRefine.h"
+#include "LabelPropagationRefine.h"
+#include "PriorityQueue.h"
+#include "Refiner.h"
+#include "ThreadPool.h"
+#include "Utilities.h"
+#include "utl/Logger.h"
+#include "utl/ThreadPool.h"
+
+namespace par {
+
+constexpr int kNumParts = 4;
+constexpr int kFixedPointBits = 8;
+constexpr int kNumThreads = 4;
+
+// A random weighted hypergraph with 2 to 4 pins per hyperedge, with most
+// pins close to each other.  It is large enough for the parallel pair
+// refinement of KWayPMRefine.
+static HGraphPtr MakeRandomHypergraph(const int num_vertices,
+                                      const int num_hyperedges,
+                                      utl::Logger* logger)
+{
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> pin_dist(2, 4);
+  std::uniform_int_distribution<int> vertex_dist(0, num_vertices - 1);
+  std::uniform_int_distribution<int> offset_dist(-8, 8);
+  std::uniform_real_distribution<float> hyperedge_wt_dist(0.1, 3.0);
+  std::uniform_real_distribution<float> vertex_wt_dist(0.5, 2.0);
+  Matrix<int> hyperedges;
+  Matrix<float> hyperedge_weights;
+  for (int e = 0; e < num_hyperedges; e++) {
+    const int center = vertex_dist(rng);
+    std::vector<int> hyperedge = {center};
+    const int num_pins = pin_dist(rng);
+    while (static_cast<int>(hyperedge.size()) < num_pins) {
+      const int v = std::clamp(center + offset_dist(rng), 0, num_vertices - 1);
+      if (std::find(hyperedge.begin(), hyperedge.end(), v) == hyperedge.end()) {
+        hyperedge.push_back(v);
+      }
+    }
+    hyperedges.push_back(hyperedge);
+    hyperedge_weights.push_back({hyperedge_wt_dist(rng)});
+  }
+  Matrix<float> vertex_weights;
+  for (int v = 0; v < num_vertices; v++) {
+    vertex_weights.push_back({vertex_wt_dist(rng)});
+  }
+  return std::make_shared<Hypergraph>(1,
+                                      1,
+                                      0,
+                                      hyperedges,
+                                      vertex_weights,
+                                      hyperedge_weights,
+                                      std::vector<int>{},
+                                      std::vector<int>{},
+                                      Matrix<float>{},
+                                      logger);
+}
+
+static EvaluatorPtr MakeEvaluator(const HGraphPtr& hgraph,
+                                  utl::Logger* logger)
+{
+  auto evaluator = std::make_shared<GoldenEvaluator>(kNumParts,
+                                                     std::vector<float>{1.0},
+                                                     std::vector<float>{1.0},
+                                                     std::vector<float>{},
+                                                     0.0,
+                                                     0.0,
+                                                     0.0,
+                                                     0.0,
+                                                     0.0,
+                                                     hgraph,
+                                                     logger);
+  evaluator->SetFixedPointBits(kFixedPointBits);
+  return evaluator;
+}
+
+// Refine the same random solution with 1 and kNumThreads threads.  The
+// refiner is created by make_refiner for each run.
+static void CheckSameSolution(
+    const std::function<std::shared_ptr<Refiner>(const EvaluatorPtr&,
+                                               utl::Logger*)>&
+        make_refiner)
+{
+  utl::ThreadPool::setGlobalThreadCount(kNumThreads);
+  utl::Logger logger;
+  const HGraphPtr hgraph = MakeRandomHypergraph(5000, 8000, &logger);
+  const EvaluatorPtr evaluator = MakeEvaluator(hgraph, &logger);
+  const std::vector<float> base_balance(kNumParts, 1.0 / kNumParts);
+  const Matrix<float> upper_block_balance
+      = hgraph->GetUpperVertexBalance(kNumParts, 5.0, base_balance);
+  const Matrix<float> lower_block_balance
+      = hgraph->GetLowerVertexBalance(kNumParts, 5.0, base_balance);
+
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> block_dist(0, kNumParts - 1);
+  Partitions initial_solution(hgraph->GetNumVertices());
+  for (int& block_id : initial_solution) {
+    block_id = block_dist(rng);
+  }
+
+  std::vector<Partitions> solutions;
+  for (const int num_threads : {1, kNumThreads}) {
+    const std::shared_ptr<Refiner> refiner = make_refiner(evaluator, &logger);
+    refiner->SetThreadPool(std::make_shared<ThreadPool>(num_threads));
+    Partitions solution = initial_solution;
+    refiner->Refine(
+        hgraph, upper_block_balance, lower_block_balance, solution);
+    solutions.push_back(std::move(solution));
+  }
+  BOOST_TEST(solutions[0] != initial_solution);
+  BOOST_TEST(solutions[0] == solutions[1], boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+// The fixed-point gains are compared as integers, whatever the rounding
+// of their float values is
+BOOST_AUTO_TEST_CASE(fixed_point_gains_compare_as_integers)
+{
+  const GainValue gain(0.1f + 0.2f, 77);
+  BOOST_TEST((gain == GainValue(0.3f, 77)));
+  BOOST_TEST((gain < GainValue(0.29f, 78)));
+  BOOST_TEST((GainValue::Lowest() < gain));
+  BOOST_TEST((gain < GainValue::Highest()));
+
+  GainValue total_gain;
+  total_gain += GainValue(0.5f, 128);
+  total_gain += GainValue(-0.25f, -64);
+  BOOST_TEST(total_gain.IsFixedPoint());
+  BOOST_TEST(total_gain.GetFixed() == 64);
+}
+
+BOOST_AUTO_TEST_CASE(kway_fm_refine_is_thread_count_independent)
+{
+  CheckSameSolution([](const EvaluatorPtr& evaluator, utl::Logger* logger) {
+    return std::make_shared<KWayFMRefine>(
+        kNumParts, 2, 0.0, 0.0, 1000, 5, evaluator, logger);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(kway_pm_refine_is_thread_count_independent)
+{
+  CheckSameSolution([](const EvaluatorPtr& evaluator, utl::Logger* logger) {
+    return std::make_shared<KWayPMRefine>(
+        kNumParts, 2, 0.0, 0.0, 1000, 5, evaluator, logger);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(greedy_refine_is_thread_count_independent)
+{
+  CheckSameSolution([](const EvaluatorPtr& evaluator, utl::Logger* logger) {
+    return std::make_shared<GreedyRefine>(
+        kNumParts, 2, 0.0, 0.0, 1000, evaluator, logger);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(label_propagation_refine_is_thread_count_independent)
+{
+  CheckSameSolution([](const EvaluatorPtr& evaluator, utl::Logger* logger) {
+    return std::make_shared<LabelPropagationRefine>(
+        kNumParts, 2, 0.0, 0.0, 1000, evaluator, logger);
+  });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace par
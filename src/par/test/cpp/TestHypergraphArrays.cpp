@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+// Tests of TritonPart::PartitionHypergraphArrays, which partitions a
+// hypergraph given as arrays in compressed sparse row format (the API used
+// by the Python bindings).
+
+#define BOOST_TEST_MODULE TestHypergraphArrays
+#include <boost/test/included/unit_test.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "TritonPart.h"
+#include "utl/Logger.h"
+
+namespace par {
+
+// Two clusters {0, 1, 2, 3} and {4, 5, 6, 7} connected by the hyperedge
+// {3, 4}.  The only balanced bipartition that cuts a single hyperedge
+// puts each cluster in its own block.
+const std::vector<int> kEptr = {0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20};
+const std::vector<int> kEind = {0, 1, 1, 2, 2, 3, 0, 3, 0, 2,
+                                4, 5, 5, 6, 6, 7, 4, 7, 3, 4};
+constexpr int kNumVertices = 8;
+
+static std::vector<int> PartitionToyHypergraph(
+    utl::Logger* logger,
+    const std::vector<int>& fixed_attr)
+{
+  TritonPart triton_part(nullptr, nullptr, nullptr, logger);
+  std::vector<int> solution(kNumVertices, -1);
+  triton_part.PartitionHypergraphArrays(2,
+                                        1.0,
+                                        0,
+                                        kEptr.data(),
+                                        kEptr.size(),
+                                        kEind.data(),
+                                        kEind.size(),
+                                        nullptr,
+                                        0,
+                                        nullptr,
+                                        0,
+                                        fixed_attr.data(),
+                                        fixed_attr.size(),
+                                        solution.data(),
+                                        kNumVertices);
+  return solution;
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(two_clusters)
+{
+  utl::Logger logger;
+  const std::vector<int> solution = PartitionToyHypergraph(&logger, {});
+
+  for (int v = 0; v < kNumVertices; v++) {
+    BOOST_TEST((solution[v] == 0 || solution[v] == 1));
+    BOOST_TEST(solution[v] == solution[v < 4 ? 0 : 4]);
+  }
+  BOOST_TEST(solution[0] != solution[4]);
+}
+
+BOOST_AUTO_TEST_CASE(fixed_vertices)
+{
+  utl::Logger logger;
+  std::vector<int> fixed_attr(kNumVertices, -1);
+  fixed_attr[0] = 1;
+  fixed_attr[7] = 0;
+  const std::vector<int> solution = PartitionToyHypergraph(&logger, fixed_attr);
+
+  BOOST_TEST(solution[0] == 1);
+  BOOST_TEST(solution[7] == 0);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_arrays)
+{
+  utl::Logger logger;
+  TritonPart triton_part(nullptr, nullptr, nullptr, &logger);
+  // vertex 8 is out of range
+  const std::vector<int> eptr = {0, 2};
+  const std::vector<int> eind = {0, 8};
+  std::vector<int> solution(kNumVertices, -1);
+  BOOST_CHECK_THROW(triton_part.PartitionHypergraphArrays(2,
+                                                          1.0,
+                                                          0,
+                                                          eptr.data(),
+                                                          eptr.size(),
+                                                          eind.data(),
+                                                          eind.size(),
+                                                          nullptr,
+                                                          0,
+                                                          nullptr,
+                                                          0,
+                                                          nullptr,
+                                                          0,
+                                                          solution.data(),
+                                                          kNumVertices),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace par
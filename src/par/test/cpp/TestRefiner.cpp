@@ -0,0 +1,427 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+// Tests of the boundary status (cut hyperedges and boundary vertices) that
+// the refiners maintain incrementally with the moves.  After each pass, the
+// incremental status must be the same as the one computed from scratch.
+
+#define BOOST_TEST_MODULE TestRefiner
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Evaluator.h"
+#include "GreedyRefine.h"
+#include "Hypergraph.h"
+#include "ILPRefine.h"
+#include "PriorityQueue.h"
+#include "Refiner.h"
+#include "ThreadPool.h"
+#include "Utilities.h"
+#include "utl/Logger.h"
+
+namespace par {
+
+constexpr int kNumParts = 2;
+
+// Two clusters {0, 1, 2, 3} and {4, 5, 6, 7} connected by the hyperedges
+// {3, 4} and {2, 3, 4}.  The single-pin hyperedges {3} and {4} are never
+// cut, whatever the blocks of 3 and 4 are.
+static HGraphPtr MakeTwoClusters(utl::Logger* logger)
+{
+  const Matrix<int> hyperedges = {{0, 1},
+                                  {1, 2},
+                                  {2, 3},
+                                  {0, 3},
+                                  {4, 5},
+                                  {5, 6},
+                                  {6, 7},
+                                  {4, 7},
+                                  {3, 4},
+                                  {2, 3, 4},
+                                  {3},
+                                  {4}};
+  const Matrix<float> vertex_weights(8, std::vector<float>(1, 1.0));
+  const Matrix<float> hyperedge_weights(hyperedges.size(),
+                                        std::vector<float>(1, 1.0));
+  return std::make_shared<Hypergraph>(1,
+                                      1,
+                                      0,
+                                      hyperedges,
+                                      vertex_weights,
+                                      hyperedge_weights,
+                                      std::vector<int>{},
+                                      std::vector<int>{},
+                                      Matrix<float>{},
+                                      logger);
+}
+
+// A random hypergraph with num_vertices vertices and 2 to 4 pins per
+// hyperedge, with most pins close to each other
+static HGraphPtr MakeRandomHypergraph(const int num_vertices,
+                                      const int num_hyperedges,
+                                      utl::Logger* logger)
+{
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> pin_dist(2, 4);
+  std::uniform_int_distribution<int> vertex_dist(0, num_vertices - 1);
+  std::uniform_int_distribution<int> offset_dist(-8, 8);
+  Matrix<int> hyperedges;
+  for (int e = 0; e < num_hyperedges; e++) {
+    const int center = vertex_dist(rng);
+    std::vector<int> hyperedge = {center};
+    const int num_pins = pin_dist(rng);
+    while (static_cast<int>(hyperedge.size()) < num_pins) {
+      const int v = std::clamp(center + offset_dist(rng), 0, num_vertices - 1);
+      if (std::find(hyperedge.begin(), hyperedge.end(), v) == hyperedge.end()) {
+        hyperedge.push_back(v);
+      }
+    }
+    hyperedges.push_back(hyperedge);
+  }
+  const Matrix<float> vertex_weights(num_vertices, std::vector<float>(1, 1.0));
+  const Matrix<float> hyperedge_weights(hyperedges.size(),
+                                        std::vector<float>(1, 1.0));
+  return std::make_shared<Hypergraph>(1,
+                                      1,
+                                      0,
+                                      hyperedges,
+                                      vertex_weights,
+                                      hyperedge_weights,
+                                      std::vector<int>{},
+                                      std::vector<int>{},
+                                      Matrix<float>{},
+                                      logger);
+}
+
+static EvaluatorPtr MakeEvaluator(const HGraphPtr& hgraph,
+                                  utl::Logger* logger)
+{
+  return std::make_shared<GoldenEvaluator>(kNumParts,
+                                           std::vector<float>{1.0},
+                                           std::vector<float>{1.0},
+                                           std::vector<float>{},
+                                           0.0,
+                                           0.0,
+                                           0.0,
+                                           0.0,
+                                           0.0,
+                                           hgraph,
+                                           logger);
+}
+
+// Compare the boundary status of the refiner with the one computed from
+// the net degrees, and the net degrees with the ones of the solution
+template <typename T>
+class BoundaryChecker : public T
+{
+ public:
+  using T::T;
+
+  int num_checks = 0;
+
+ protected:
+  void CheckBoundary(const HGraphPtr& hgraph,
+                     const NetDegrees& net_degs,
+                     const Partitions& solution)
+  {
+    std::vector<int> cut_edges;
+    std::vector<bool> cut_flag(hgraph->GetNumHyperedges(), false);
+    for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
+      std::vector<int> degs(kNumParts, 0);
+      for (const int v : hgraph->Vertices(e)) {
+        degs[solution[v]]++;
+      }
+      int span = 0;
+      for (int block_id = 0; block_id < kNumParts; block_id++) {
+        BOOST_TEST(net_degs[e][block_id] == degs[block_id]);
+        span += (degs[block_id] > 0) ? 1 : 0;
+      }
+      if (span > 1) {
+        cut_edges.push_back(e);
+        cut_flag[e] = true;
+      }
+    }
+    std::vector<int> boundary_vertices;
+    for (int v = 0; v < hgraph->GetNumVertices(); v++) {
+      for (const int e : hgraph->Edges(v)) {
+        if (cut_flag[e] == true) {
+          boundary_vertices.push_back(v);
+          break;
+        }
+      }
+    }
+    const std::vector<bool> unvisited(hgraph->GetNumVertices(), false);
+    BOOST_TEST(this->FindCutHyperedges(
+                   hgraph, net_degs, hgraph->GetNumHyperedges())
+                   == cut_edges,
+               boost::test_tools::per_element());
+    BOOST_TEST(this->FindBoundaryVertices(hgraph, net_degs, unvisited)
+                   == boundary_vertices,
+               boost::test_tools::per_element());
+    num_checks++;
+  }
+};
+
+// Check the boundary status after each ILP pass
+class CheckedIlpRefine : public BoundaryChecker<IlpRefine>
+{
+ public:
+  using BoundaryChecker<IlpRefine>::BoundaryChecker;
+
+ protected:
+  float Pass(const HGraphPtr& hgraph,
+             const Matrix<float>& upper_block_balance,
+             const Matrix<float>& lower_block_balance,
+             Matrix<float>& block_balance,
+             NetDegrees& net_degs,
+             std::vector<float>& cur_paths_cost,
+             Partitions& solution,
+             std::vector<bool>& visited_vertices_flag) override
+  {
+    const float gain = IlpRefine::Pass(hgraph,
+                                       upper_block_balance,
+                                       lower_block_balance,
+                                       block_balance,
+                                       net_degs,
+                                       cur_paths_cost,
+                                       solution,
+                                       visited_vertices_flag);
+    CheckBoundary(hgraph, net_degs, solution);
+    return gain;
+  }
+};
+
+// Accept a move of vertex 3 to its own block, then a move of vertex 3 to
+// the other block, which is rolled back.  The boundary status is checked
+// after each step.
+class SameBlockMoveRefine : public BoundaryChecker<Refiner>
+{
+ public:
+  using BoundaryChecker<Refiner>::BoundaryChecker;
+
+ protected:
+  float Pass(const HGraphPtr& hgraph,
+             const Matrix<float>& upper_block_balance,
+             const Matrix<float>& lower_block_balance,
+             Matrix<float>& block_balance,
+             NetDegrees& net_degs,
+             std::vector<float>& cur_paths_cost,
+             Partitions& solution,
+             std::vector<bool>& visited_vertices_flag) override
+  {
+    const int v = 3;
+    const int from_pid = solution[v];
+    const int to_pid = 1 - from_pid;
+    GainValue total_gain;
+    const GainCell stay(v, from_pid, from_pid, 0.0, PathCost{});
+    AcceptVertexGain(stay,
+                     hgraph,
+                     total_gain,
+                     visited_vertices_flag,
+                     solution,
+                     cur_paths_cost,
+                     block_balance,
+                     net_degs);
+    CheckBoundary(hgraph, net_degs, solution);
+    const GainCell move(v, from_pid, to_pid, 0.0, PathCost{});
+    AcceptVertexGain(move,
+                     hgraph,
+                     total_gain,
+                     visited_vertices_flag,
+                     solution,
+                     cur_paths_cost,
+                     block_balance,
+                     net_degs);
+    CheckBoundary(hgraph, net_degs, solution);
+    RollBackVertexGain(move,
+                       hgraph,
+                       visited_vertices_flag,
+                       solution,
+                       cur_paths_cost,
+                       block_balance,
+                       net_degs);
+    CheckBoundary(hgraph, net_degs, solution);
+    return 0.0;
+  }
+};
+
+// The greedy pass scanning all the hyperedges in the increasing order of
+// their ids, with the gains calculated when the hyperedges are visited
+class ScanGreedyRefine : public Refiner
+{
+ public:
+  using Refiner::Refiner;
+
+ protected:
+  float Pass(const HGraphPtr& hgraph,
+             const Matrix<float>& upper_block_balance,
+             const Matrix<float>& lower_block_balance,
+             Matrix<float>& block_balance,
+             NetDegrees& net_degs,
+             std::vector<float>& cur_paths_cost,
+             Partitions& solution,
+             std::vector<bool>& visited_vertices_flag) override
+  {
+    GainValue total_gain;
+    int num_move = 0;
+    for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
+      if (IsCutHyperedge(e, net_degs) == false) {
+        continue;
+      }
+      num_move++;
+      if (num_move >= max_move_) {
+        break;
+      }
+      HyperedgeGain best_gain;
+      for (int to_pid = 0; to_pid < num_parts_; to_pid++) {
+        if (CheckHyperedgeMoveLegality(e,
+                                       to_pid,
+                                       hgraph,
+                                       solution,
+                                       block_balance,
+                                       upper_block_balance,
+                                       lower_block_balance)
+            == false) {
+          continue;
+        }
+        const HyperedgeGain gain = CalculateHyperedgeGain(
+            e, to_pid, hgraph, solution, cur_paths_cost, net_degs);
+        if (best_gain.GetDestinationPart() == -1
+            || gain.GetGainValue() > best_gain.GetGainValue()
+            || (gain.GetGainValue() == best_gain.GetGainValue()
+                && evaluator_->CalculateHyperedgeVertexWtSum(e, hgraph)
+                       < evaluator_->CalculateHyperedgeVertexWtSum(
+                           best_gain.GetHyperedge(), hgraph))) {
+          best_gain = gain;
+        }
+      }
+      if (best_gain.GetDestinationPart() > -1
+          && best_gain.GetGainValue() >= GainValue()) {
+        AcceptHyperedgeGain(best_gain,
+                            hgraph,
+                            total_gain,
+                            solution,
+                            cur_paths_cost,
+                            block_balance,
+                            net_degs);
+      }
+    }
+    return total_gain.GetValue();
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+// The clusters are the optimal solution, so the ILP keeps all the
+// boundary vertices in their blocks
+BOOST_AUTO_TEST_CASE(ilp_pass_keeps_vertices_in_place)
+{
+  utl::Logger logger;
+  const HGraphPtr hgraph = MakeTwoClusters(&logger);
+  const EvaluatorPtr evaluator = MakeEvaluator(hgraph, &logger);
+  const std::vector<float> base_balance(kNumParts, 1.0 / kNumParts);
+  const Matrix<float> upper_block_balance
+      = hgraph->GetUpperVertexBalance(kNumParts, 1.0, base_balance);
+  const Matrix<float> lower_block_balance
+      = hgraph->GetLowerVertexBalance(kNumParts, 1.0, base_balance);
+
+  CheckedIlpRefine refiner(kNumParts, 2, 0.0, 0.0, 100, evaluator, &logger);
+  refiner.SetIlpParams(0.0, 1, IlpSolver::AUTO);
+  Partitions solution = {0, 0, 0, 0, 1, 1, 1, 1};
+  const Partitions initial_solution = solution;
+  refiner.Refine(hgraph, upper_block_balance, lower_block_balance, solution);
+
+  BOOST_TEST(refiner.num_checks > 0);
+  BOOST_TEST(solution == initial_solution, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(same_block_move)
+{
+  utl::Logger logger;
+  const HGraphPtr hgraph = MakeTwoClusters(&logger);
+  const EvaluatorPtr evaluator = MakeEvaluator(hgraph, &logger);
+  const std::vector<float> base_balance(kNumParts, 1.0 / kNumParts);
+  const Matrix<float> upper_block_balance
+      = hgraph->GetUpperVertexBalance(kNumParts, 1.0, base_balance);
+  const Matrix<float> lower_block_balance
+      = hgraph->GetLowerVertexBalance(kNumParts, 1.0, base_balance);
+
+  SameBlockMoveRefine refiner(kNumParts, 1, 0.0, 0.0, 100, evaluator, &logger);
+  Partitions solution = {0, 0, 0, 0, 1, 1, 1, 1};
+  refiner.Refine(hgraph, upper_block_balance, lower_block_balance, solution);
+
+  BOOST_TEST(refiner.num_checks == 3);
+}
+
+// The greedy refinement visits the hyperedges cut by its own moves, so it
+// gives the same solution as the scan of all the hyperedges
+BOOST_AUTO_TEST_CASE(greedy_refine_visits_new_cut_hyperedges)
+{
+  utl::Logger logger;
+  const HGraphPtr hgraph = MakeRandomHypergraph(400, 600, &logger);
+  const EvaluatorPtr evaluator = MakeEvaluator(hgraph, &logger);
+  const std::vector<float> base_balance(kNumParts, 1.0 / kNumParts);
+  const Matrix<float> upper_block_balance
+      = hgraph->GetUpperVertexBalance(kNumParts, 10.0, base_balance);
+  const Matrix<float> lower_block_balance
+      = hgraph->GetLowerVertexBalance(kNumParts, 10.0, base_balance);
+  Partitions initial_solution(hgraph->GetNumVertices());
+  std::mt19937 rng(1);
+  for (int& block_id : initial_solution) {
+    block_id = static_cast<int>(rng() % kNumParts);
+  }
+
+  for (const int max_move : {20, 1000}) {
+    ScanGreedyRefine scan_refiner(
+        kNumParts, 3, 0.0, 0.0, max_move, evaluator, &logger);
+    Partitions scan_solution = initial_solution;
+    scan_refiner.Refine(
+        hgraph, upper_block_balance, lower_block_balance, scan_solution);
+    BOOST_TEST(scan_solution != initial_solution);
+
+    GreedyRefine refiner(kNumParts, 3, 0.0, 0.0, max_move, evaluator, &logger);
+    refiner.SetThreadPool(std::make_shared<ThreadPool>(4));
+    Partitions solution = initial_solution;
+    refiner.Refine(hgraph, upper_block_balance, lower_block_balance, solution);
+    BOOST_TEST(solution == scan_solution, boost::test_tools::per_element());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace par
@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Tests of the timing update of GoldenEvaluator.  The incremental update,
+// which only re-scores the paths through the hyperedges whose slack is
+// changed, must give the same timing as the full update.
+
+#define BOOST_TEST_MODULE TestTiming
+#include <boost/test/included/unit_test.hpp>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Evaluator.h"
+#include "Hypergraph.h"
+#include "Utilities.h"
+#include "utl/Logger.h"
+
+namespace par {
+
+namespace tt = boost::test_tools;
+
+constexpr int kNumVertices = 13;
+constexpr float kExtraDelay = 0.2;
+
+// Two register-to-register chains 0 -> 7 and 0 -> 12 sharing the cells
+// 1 and 3.  The first vertex of each hyperedge is its driver.  Each
+// hyperedge is its own timing arc.
+static HGraphPtr MakeTimingGraph(utl::Logger* logger)
+{
+  const Matrix<int> hyperedges = {{0, 1},
+                                  {1, 2, 8},
+                                  {2, 3},
+                                  {3, 4, 9},
+                                  {4, 5},
+                                  {5, 6},
+                                  {6, 7},
+                                  {8, 9},
+                                  {9, 10},
+                                  {10, 11},
+                                  {11, 12},
+                                  {7, 12}};
+  const int num_hyperedges = hyperedges.size();
+  std::vector<VertexType> vertex_types(kNumVertices, COMB_STD_CELL);
+  vertex_types[0] = PORT;
+  vertex_types[7] = SEQ_STD_CELL;
+  vertex_types[12] = PORT;
+  const std::vector<float> slacks
+      = {0.3, 0.5, 0.4, 0.6, 0.35, 0.9, 0.45, 0.7, 0.25, 0.8, 0.55, 0.95};
+  std::vector<CsrOffset> arc_ptr(num_hyperedges + 1);
+  std::vector<int> arc_ind(num_hyperedges);
+  for (int e = 0; e < num_hyperedges; e++) {
+    arc_ptr[e + 1] = e + 1;
+    arc_ind[e] = e;
+  }
+  const std::vector<TimingPath> timing_paths
+      = {TimingPath({0, 1, 2, 3, 4, 5, 6, 7}, {0, 1, 2, 3, 4, 5, 6}, 0.3),
+         TimingPath({0, 1, 8, 9, 10, 11, 12}, {0, 1, 7, 8, 9, 10}, 0.25),
+         TimingPath({3, 9, 10, 11, 12}, {3, 8, 9, 10}, 0.25),
+         TimingPath({7, 12}, {11}, 0.95)};
+  const Matrix<float> vertex_weights(kNumVertices, std::vector<float>(1, 1.0));
+  const Matrix<float> hyperedge_weights(num_hyperedges,
+                                        std::vector<float>(1, 1.0));
+  return std::make_shared<Hypergraph>(1,
+                                      1,
+                                      0,
+                                      hyperedges,
+                                      vertex_weights,
+                                      hyperedge_weights,
+                                      std::vector<int>{},
+                                      std::vector<int>{},
+                                      Matrix<float>{},
+                                      vertex_types,
+                                      slacks,
+                                      std::move(arc_ptr),
+                                      std::move(arc_ind),
+                                      timing_paths,
+                                      logger);
+}
+
+static EvaluatorPtr MakeEvaluator(const HGraphPtr& timing_graph,
+                                  utl::Logger* logger)
+{
+  return std::make_shared<GoldenEvaluator>(2,
+                                           std::vector<float>{1.0},
+                                           std::vector<float>{1.0},
+                                           std::vector<float>{},
+                                           1.0,
+                                           1.0,
+                                           0.0,
+                                           2.0,
+                                           kExtraDelay,
+                                           timing_graph,
+                                           logger);
+}
+
+static void CheckSameTiming(const HGraphPtr& hgraph, const HGraphPtr& expected)
+{
+  for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
+    BOOST_TEST(hgraph->GetHyperedgeTimingAttr(e)
+               == expected->GetHyperedgeTimingAttr(e));
+    BOOST_TEST(hgraph->GetHyperedgeTimingCost(e)
+                   == expected->GetHyperedgeTimingCost(e),
+               tt::tolerance(1e-5f));
+  }
+  for (int path_id = 0; path_id < hgraph->GetNumTimingPaths(); path_id++) {
+    BOOST_TEST(hgraph->PathTimingSlack(path_id)
+               == expected->PathTimingSlack(path_id));
+    BOOST_TEST(hgraph->PathTimingCost(path_id)
+               == expected->PathTimingCost(path_id));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(incremental_update_matches_full_update)
+{
+  utl::Logger logger;
+  const HGraphPtr timing_graph = MakeTimingGraph(&logger);
+  const EvaluatorPtr evaluator = MakeEvaluator(timing_graph, &logger);
+  const HGraphPtr full_hgraph = std::make_shared<Hypergraph>(*timing_graph);
+  const HGraphPtr hgraph = std::make_shared<Hypergraph>(*timing_graph);
+
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> block_dist(0, 1);
+  std::uniform_int_distribution<int> vertex_dist(0, kNumVertices - 1);
+  std::vector<int> pre_solution(kNumVertices, 0);
+  evaluator->UpdateTiming(hgraph, pre_solution);
+  int num_changes = 0;
+  for (int i = 0; i < 50; i++) {
+    // a few vertices move at each step, as in the refinement
+    std::vector<int> solution = pre_solution;
+    solution[vertex_dist(rng)] = block_dist(rng);
+    solution[vertex_dist(rng)] = block_dist(rng);
+    const std::vector<float> pre_slacks = hgraph->GetHyperedgeTimingAttr();
+    evaluator->UpdateTiming(hgraph, pre_solution, solution);
+    evaluator->UpdateTiming(full_hgraph, solution);
+    CheckSameTiming(hgraph, full_hgraph);
+    if (hgraph->GetHyperedgeTimingAttr() != pre_slacks) {
+      num_changes++;
+    }
+    pre_solution = std::move(solution);
+  }
+  BOOST_TEST(num_changes > 0);
+
+  // the original slacks of the timing graph are never updated
+  const HGraphPtr original = MakeTimingGraph(&logger);
+  evaluator->UpdateTiming(timing_graph, pre_solution);
+  for (int e = 0; e < timing_graph->GetNumHyperedges(); e++) {
+    BOOST_TEST(timing_graph->GetHyperedgeTimingAttr(e)
+               == original->GetHyperedgeTimingAttr(e));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace par
@@ -117,22 +117,21 @@ void PdnGen::buildGrids(bool trim)
 
   // get special shapes
   Grid::makeInitialShapes(block, all_shapes, logger_);
+  ShapeValueMap special_obs;
   for (const auto& [layer, layer_shapes] : all_shapes) {
-    auto& layer_obs = block_obs[layer];
+    auto& layer_obs = special_obs[layer];
     for (const auto& [box, shape] : layer_shapes) {
-      layer_obs.insert({shape->getObstructionBox(), shape});
+      layer_obs.emplace_back(shape->getObstructionBox(), shape);
     }
   }
+  Shape::bulkInsert(block_obs, special_obs);
 
   for (auto* grid : grids) {
     debugPrint(
         logger_, utl::PDN, "Make", 2, "Build start grid - {}", grid->getName());
     grid->makeShapes(all_shapes, block_obs);
     for (const auto& [layer, shapes] : grid->getShapes()) {
-      auto& all_shapes_layer = all_shapes[layer];
-      for (auto& shape : shapes) {
-        all_shapes_layer.insert(shape);
-      }
+      all_shapes[layer].insert(shapes.begin(), shapes.end());
     }
     grid->getObstructions(block_obs);
     debugPrint(
@@ -682,17 +681,19 @@ void PdnGen::writeToDb(bool add_pins, const std::string& report_file) const
 
   // collect all the SWires from the block
   auto* block = db_->getChip()->getBlock();
-  ShapeTreeMap obstructions;
+  ShapeValueMap obstruction_values;
   for (auto* net : block->getNets()) {
-    ShapeTreeMap net_shapes;
+    ShapeValueMap net_shapes;
     Shape::populateMapFromDb(net, net_shapes);
-    for (const auto& [layer, net_obs_layer] : net_shapes) {
-      auto& obs_layer = obstructions[layer];
-      for (const auto& [box, shape] : net_obs_layer) {
-        obs_layer.insert({shape->getObstructionBox(), shape});
+    for (const auto& [layer, net_layer_shapes] : net_shapes) {
+      auto& obs_layer = obstruction_values[layer];
+      for (const auto& [box, shape] : net_layer_shapes) {
+        obs_layer.emplace_back(shape->getObstructionBox(), shape);
       }
     }
   }
+  ShapeTreeMap obstructions;
+  Shape::bulkInsert(obstructions, obstruction_values);
 
   for (auto* domain : domains) {
     for (const auto& grid : domain->getGrids()) {
@@ -454,11 +454,28 @@ void Connect::makeVia(odb::dbSWire* wire,
     return;
   }
 
-  const ViaIndex via_index
-      = std::make_pair(intersection.dx(), intersection.dy());
-  auto& via = vias_[via_index];
+  // Shapes that cannot be modified require the via to fit within them, so
+  // the via depends on their full extent and not only on the size of the
+  // intersection.  Those vias are cached by the geometry around the via
+  // center instead.
+  const bool lower_fixed
+      = !lower->isModifiable() || lower->hasTermConnections();
+  const bool upper_fixed
+      = !upper->isModifiable() || upper->hasTermConnections();
+  std::unique_ptr<DbGenerateStackedVia>* cached_via;
+  if (lower_fixed || upper_fixed) {
+    const odb::dbTransform to_center({-x, -y});
+    FixedViaIndex fixed_index{lower_rect, upper_rect, lower_fixed, upper_fixed};
+    to_center.apply(std::get<0>(fixed_index));
+    to_center.apply(std::get<1>(fixed_index));
+    cached_via = &fixed_vias_[fixed_index];
+  } else {
+    const ViaIndex via_index
+        = std::make_pair(intersection.dx(), intersection.dy());
+    cached_via = &vias_[via_index];
+  }
+  auto& via = *cached_via;
 
-  bool skip_caching = false;
   // make the via stack if one is not available for the given size
   if (via == nullptr) {
     std::vector<ViaLayerRects> stack_rects;
@@ -490,9 +507,8 @@ void Connect::makeVia(odb::dbSWire* wire,
 
       ViaGenerator::Constraint lower_constraint{false, false, true};
       if (lower->getLayer() == l0) {
-        if (!lower->isModifiable() || lower->hasTermConnections()) {
+        if (lower_fixed) {
           // lower is not modifiable to all sides must fit
-          skip_caching = true;
           lower_constraint.must_fit_x = true;
           lower_constraint.must_fit_y = true;
           lower_constraint.intersection_only = false;
@@ -503,9 +519,8 @@ void Connect::makeVia(odb::dbSWire* wire,
       }
       ViaGenerator::Constraint upper_constraint{false, false, true};
       if (upper->getLayer() == l1) {
-        if (!upper->isModifiable() || upper->hasTermConnections()) {
+        if (upper_fixed) {
           // upper is not modifiable to all sides must fit
-          skip_caching = true;
           upper_constraint.must_fit_x = true;
           upper_constraint.must_fit_y = true;
           upper_constraint.intersection_only = false;
@@ -546,10 +561,6 @@ void Connect::makeVia(odb::dbSWire* wire,
   shapes
       = via->generate(wire->getBlock(), wire, type, x, y, grid_->getLogger());
 
-  if (skip_caching) {
-    via = nullptr;
-  }
-
   if (shapes.bottom.empty() && shapes.top.empty()) {
     addFailedVia(failedViaReason::RECHECK, intersection, wire->getNet());
   }
@@ -849,6 +860,7 @@ int Connect::getSplitCut(odb::dbTechLayer* layer) const
 void Connect::clearShapes()
 {
   vias_.clear();
+  fixed_vias_.clear();
   failed_vias_.clear();
 }
 
@@ -883,13 +895,19 @@ void Connect::printViaReport() const
   }
 
   ViaReport report;
-  for (const auto& [via_index, via] : vias_) {
+  auto add_to_report = [&report](const auto& via) {
     if (via == nullptr) {
-      continue;
+      return;
     }
     for (const auto& [via_name, count] : via->getViaReport()) {
       report[via_name] += count;
     }
+  };
+  for (const auto& [via_index, via] : vias_) {
+    add_to_report(via);
+  }
+  for (const auto& [via_index, via] : fixed_vias_) {
+    add_to_report(via);
   }
 
   debugPrint(logger,
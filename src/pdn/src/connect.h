@@ -35,6 +35,7 @@
 #include <fstream>
 #include <map>
 #include <set>
+#include <tuple>
 #include <vector>
 
 #include "shape.h"
@@ -141,6 +142,11 @@ class Connect
   // intersection, and the value points of the associated via stack.
   using ViaIndex = std::pair<int, int>;
   std::map<ViaIndex, std::unique_ptr<DbGenerateStackedVia>> vias_;
+  // vias touching a shape that cannot be modified, where the key is the
+  // lower and upper shapes relative to the via center and whether each is
+  // fixed.
+  using FixedViaIndex = std::tuple<odb::Rect, odb::Rect, bool, bool>;
+  std::map<FixedViaIndex, std::unique_ptr<DbGenerateStackedVia>> fixed_vias_;
   std::vector<odb::dbTechViaGenerateRule*> generate_via_rules_;
   std::vector<odb::dbTechVia*> tech_vias_;
 
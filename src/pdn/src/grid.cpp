@@ -32,6 +32,7 @@
 
 #include "grid.h"
 
+#include <algorithm>
 #include <boost/geometry.hpp>
 
 #include "connect.h"
@@ -44,6 +45,7 @@
 #include "straps.h"
 #include "techlayer.h"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 namespace pdn {
 
@@ -474,6 +476,35 @@ void Grid::report() const
   }
 }
 
+void Grid::findIntersections(Connect* connect,
+                             const ShapeValue& lower,
+                             const ShapeTree& upper_shapes,
+                             std::vector<ViaPtr>& intersections)
+{
+  const auto& [lower_box, lower_shape] = lower;
+  auto* lower_net = lower_shape->getNet();
+  // check for intersections in higher layer shapes
+  for (auto it = upper_shapes.qbegin(
+           bgi::intersects(lower_box)
+           && bgi::satisfies([lower_net](const auto& other) {
+                // not the same net, so ignore
+                return lower_net == other.second->getNet();
+              }));
+       it != upper_shapes.qend();
+       it++) {
+    const auto& upper_shape = it->second;
+    if (!lower_shape->getRect().overlaps(upper_shape->getRect())) {
+      // no overlap, so ignore
+      continue;
+    }
+
+    const odb::Rect via_rect
+        = lower_shape->getRect().intersect(upper_shape->getRect());
+    auto* via = new Via(connect, lower_net, via_rect, lower_shape, upper_shape);
+    intersections.push_back(ViaPtr(via));
+  }
+}
+
 void Grid::getIntersections(std::vector<ViaPtr>& shape_intersections,
                             const ShapeTreeMap& search_shapes) const
 {
@@ -518,33 +549,35 @@ void Grid::getIntersections(std::vector<ViaPtr>& shape_intersections,
                upper_layer->getName(),
                upper_shapes.size());
 
-    // loop over lower layer shapes
-    for (const auto& [lower_box, lower_shape] : lower_shapes) {
-      auto* lower_net = lower_shape->getNet();
-      // check for intersections in higher layer shapes
-      for (auto it = upper_shapes.qbegin(
-               bgi::intersects(lower_box)
-               && bgi::satisfies([lower_net](const auto& other) {
-                    // not the same net, so ignore
-                    return lower_net == other.second->getNet();
-                  }));
-           it != upper_shapes.qend();
-           it++) {
-        const auto& upper_shape = it->second;
-        if (!lower_shape->getRect().overlaps(upper_shape->getRect())) {
-          // no overlap, so ignore
-          continue;
-        }
-
-        const odb::Rect via_rect
-            = lower_shape->getRect().intersect(upper_shape->getRect());
-        auto* via = new Via(connect.get(),
-                            lower_shape->getNet(),
-                            via_rect,
-                            lower_shape,
-                            upper_shape);
-        shape_intersections.push_back(ViaPtr(via));
-      }
+    // Search the lower layer shapes in chunks in parallel.  The rtrees are
+    // only read here.  Each chunk keeps its own results, and they are
+    // appended in chunk order so the vias come out in the same order as a
+    // serial search.
+    const std::vector<ShapeValue> lower_values(lower_shapes.begin(),
+                                               lower_shapes.end());
+    const int num_chunks
+        = std::min(static_cast<int>(lower_values.size()),
+                   utl::ThreadPool::global()->getThreadCount() * 4);
+    const int chunk_size
+        = (lower_values.size() + num_chunks - 1) / std::max(1, num_chunks);
+    std::vector<std::vector<ViaPtr>> chunk_intersections(num_chunks);
+    utl::ThreadPool::global()->parallelFor(
+        num_chunks,
+        [&](const int chunk) {
+          const int end = std::min(static_cast<int>(lower_values.size()),
+                                   (chunk + 1) * chunk_size);
+          for (int i = chunk * chunk_size; i < end; i++) {
+            findIntersections(connect.get(),
+                              lower_values[i],
+                              upper_shapes,
+                              chunk_intersections[chunk]);
+          }
+        },
+        utl::PDN);
+    for (auto& intersections : chunk_intersections) {
+      shape_intersections.insert(shape_intersections.end(),
+                                 intersections.begin(),
+                                 intersections.end());
     }
   }
   debugPrint(getLogger(),
@@ -955,6 +988,7 @@ void Grid::makeInitialObstructions(odb::dbBlock* block,
                                    utl::Logger* logger)
 {
   debugPrint(logger, utl::PDN, "Make", 2, "Get initial obstructions - begin");
+  ShapeValueMap values;
   // routing obs
   for (auto* ob : block->getObstructions()) {
     if (ob->isSlotObstruction() || ob->isFillObstruction()) {
@@ -970,13 +1004,14 @@ void Grid::makeInitialObstructions(odb::dbBlock* block,
     if (box->getTechLayer() == nullptr) {
       for (auto* layer : block->getDb()->getTech()->getLayers()) {
         auto shape = std::make_shared<Shape>(layer, obs_rect, Shape::BLOCK_OBS);
-        obs[shape->getLayer()].insert({shape->getObstructionBox(), shape});
+        values[layer].emplace_back(shape->getObstructionBox(), shape);
       }
     } else {
       auto shape = std::make_shared<Shape>(
           box->getTechLayer(), obs_rect, Shape::BLOCK_OBS);
 
-      obs[shape->getLayer()].insert({shape->getObstructionBox(), shape});
+      values[shape->getLayer()].emplace_back(shape->getObstructionBox(),
+                                             shape);
     }
   }
 
@@ -1017,9 +1052,11 @@ void Grid::makeInitialObstructions(odb::dbBlock* block,
 
     for (const auto& [layer, shapes] :
          InstanceGrid::getInstanceObstructions(inst)) {
-      obs[layer].insert(shapes.begin(), shapes.end());
+      auto& layer_values = values[layer];
+      layer_values.insert(layer_values.end(), shapes.begin(), shapes.end());
     }
   }
+  Shape::bulkInsert(obs, values);
   debugPrint(logger, utl::PDN, "Make", 2, "Get initial obstructions - end");
 }
 
@@ -1028,9 +1065,11 @@ void Grid::makeInitialShapes(odb::dbBlock* block,
                              utl::Logger* logger)
 {
   debugPrint(logger, utl::PDN, "Make", 2, "Get initial shapes - start");
+  ShapeValueMap values;
   for (auto* net : block->getNets()) {
-    Shape::populateMapFromDb(net, shapes);
+    Shape::populateMapFromDb(net, values);
   }
+  Shape::bulkInsert(shapes, values);
   debugPrint(logger, utl::PDN, "Make", 2, "Get initial shapes - end");
 }
 
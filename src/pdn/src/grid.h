@@ -204,6 +204,11 @@ class Grid
   // find all intersections in the shapes which may become vias
   virtual void getIntersections(std::vector<ViaPtr>& intersections,
                                 const ShapeTreeMap& shapes) const;
+  // find the intersections of one lower layer shape with the upper shapes
+  static void findIntersections(Connect* connect,
+                                const ShapeValue& lower,
+                                const ShapeTree& upper_shapes,
+                                std::vector<ViaPtr>& intersections);
 
   virtual void cleanupShapes() {}
 
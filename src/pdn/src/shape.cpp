@@ -421,6 +421,26 @@ void Shape::addBPinToDb(const odb::Rect& rect) const
 }
 
 void Shape::populateMapFromDb(odb::dbNet* net, ShapeTreeMap& map)
+{
+  ShapeValueMap values;
+  populateMapFromDb(net, values);
+  bulkInsert(map, values);
+}
+
+void Shape::bulkInsert(ShapeTreeMap& map, ShapeValueMap& values)
+{
+  for (auto& [layer, layer_values] : values) {
+    auto& tree = map[layer];
+    if (tree.empty()) {
+      tree = ShapeTree(layer_values.begin(), layer_values.end());
+    } else {
+      tree.insert(layer_values.begin(), layer_values.end());
+    }
+  }
+  values.clear();
+}
+
+void Shape::populateMapFromDb(odb::dbNet* net, ShapeValueMap& values)
 {
   for (auto* swire : net->getSWires()) {
     for (auto* box : swire->getWires()) {
@@ -440,7 +460,7 @@ void Shape::populateMapFromDb(odb::dbNet* net, ShapeTreeMap& map)
         shape->setShapeType(Shape::OBS);
       }
       shape->generateObstruction();
-      map[layer].insert({shape->getRectBox(), shape});
+      values[layer].emplace_back(shape->getRectBox(), shape);
     }
   }
 }
@@ -77,6 +77,7 @@ using ViaValue = std::pair<Box, ViaPtr>;
 using ShapeTree = bgi::rtree<ShapeValue, bgi::quadratic<16>>;
 using ViaTree = bgi::rtree<ViaValue, bgi::quadratic<16>>;
 using ShapeTreeMap = std::map<odb::dbTechLayer*, ShapeTree>;
+using ShapeValueMap = std::map<odb::dbTechLayer*, std::vector<ShapeValue>>;
 
 class Grid;
 class GridComponent;
@@ -221,6 +222,10 @@ class Shape
                  bool make_rect_as_pin) const;
   // copy existing shapes into the map
   static void populateMapFromDb(odb::dbNet* net, ShapeTreeMap& map);
+  static void populateMapFromDb(odb::dbNet* net, ShapeValueMap& values);
+  // add the values to the trees, bulk loading the trees that are empty
+  // since packed trees are faster to build and to query
+  static void bulkInsert(ShapeTreeMap& map, ShapeValueMap& values);
 
   static Box rectToBox(const odb::Rect& rect);
 
@@ -179,6 +179,9 @@ class IOPlacer
   void createTopLayerPinPattern();
   void initNetlistAndCore(const std::set<int>& hor_layer_idx,
                           const std::set<int>& ver_layer_idx);
+  void initIncrementalPins();
+  bool isPinInsideConstraints(odb::dbBTerm* bterm, const Rect& die_area);
+  bool isPinFixed(odb::dbBTerm* bterm) const;
   void initIOLists();
   void initParms();
   std::vector<int> getValidSlots(int first, int last, bool top_layer);
@@ -296,6 +299,8 @@ class IOPlacer
   std::vector<PinGroup> pin_groups_;
   MirroredPins mirrored_pins_;
   FallbackPins fallback_pins_;
+  // placed pins kept in their position by an incremental run
+  std::set<odb::dbBTerm*> kept_pins_;
 
   Logger* logger_ = nullptr;
   std::unique_ptr<Parameters> parms_;
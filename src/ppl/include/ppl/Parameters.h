@@ -112,6 +112,12 @@ class Parameters
   }
   std::string getPinPlacementFile() const { return pin_placement_file_; }
 
+  void setIncremental(bool incremental) { incremental_ = incremental; }
+  bool getIncremental() const { return incremental_; }
+
+  void setNumThreads(int num_threads) { num_threads_ = num_threads; }
+  int getNumThreads() const { return num_threads_; }
+
  private:
   bool report_hpwl_ = false;
   int num_slots_ = -1;
@@ -128,6 +134,8 @@ class Parameters
   int min_dist_ = 0;
   bool distance_in_tracks_ = false;
   std::string pin_placement_file_;
+  bool incremental_ = false;
+  int num_threads_ = 1;
 };
 
 }  // namespace ppl
@@ -49,6 +49,7 @@
 #include "ppl/AbstractIOPlacerRenderer.h"
 #include "utl/Logger.h"
 #include "utl/algorithms.h"
+#include "utl/trace.h"
 
 namespace ppl {
 
@@ -96,6 +97,7 @@ void IOPlacer::clear()
   excluded_intervals_.clear();
   netlist_->clear();
   pin_groups_.clear();
+  kept_pins_.clear();
   *parms_ = Parameters();
 }
 
@@ -131,6 +133,132 @@ void IOPlacer::initNetlistAndCore(const std::set<int>& hor_layer_idx,
   populateIOPlacer(hor_layer_idx, ver_layer_idx);
 }
 
+// An incremental run keeps the pins that are already placed inside their
+// constraints and blocks their slots. Only new pins, pins that are out of
+// their constraint region, and the groups and mirrored pairs they belong
+// to are placed.
+void IOPlacer::initIncrementalPins()
+{
+  kept_pins_.clear();
+  if (!parms_->getIncremental()) {
+    return;
+  }
+
+  std::set<odb::dbBTerm*> mirrored_terms;
+  for (const auto& [term1, term2] : mirrored_pins_) {
+    mirrored_terms.insert(term1);
+    mirrored_terms.insert(term2);
+  }
+
+  const Rect die_area = getBlock()->getDieArea();
+  for (odb::dbBTerm* bterm : getBlock()->getBTerms()) {
+    if (bterm->getFirstPinPlacementStatus() != odb::dbPlacementStatus::PLACED
+        || mirrored_terms.find(bterm) != mirrored_terms.end()
+        || !isPinInsideConstraints(bterm, die_area)) {
+      continue;
+    }
+    kept_pins_.insert(bterm);
+  }
+
+  // groups are kept or placed as a whole
+  for (const auto& [pins, order] : pin_groups_) {
+    const bool keep_group
+        = std::all_of(pins.begin(), pins.end(), [this](odb::dbBTerm* bterm) {
+            return kept_pins_.find(bterm) != kept_pins_.end();
+          });
+    if (!keep_group) {
+      for (odb::dbBTerm* bterm : pins) {
+        kept_pins_.erase(bterm);
+      }
+    }
+  }
+
+  for (odb::dbBTerm* bterm : kept_pins_) {
+    for (odb::dbBPin* bpin : bterm->getBPins()) {
+      for (odb::dbBox* box : bpin->getBoxes()) {
+        odb::dbTechLayer* layer = box->getTechLayer();
+        const int layer_level = layer->getRoutingLevel();
+        // pins on the top layer grid are handled as obstructions
+        if (layer_level == top_grid_->layer) {
+          continue;
+        }
+        // sum the width of the layer to avoid overlaps in adjacent tracks
+        const int half_width = layer->getWidth();
+        for (const Interval& interval :
+             findBlockedIntervals(die_area, box->getBox())) {
+          excludeInterval(Interval(interval.getEdge(),
+                                   interval.getBegin() - half_width,
+                                   interval.getEnd() + half_width,
+                                   layer_level));
+        }
+      }
+    }
+  }
+
+  logger_->info(PPL,
+                113,
+                "Incremental mode: keeping {} placed pins.",
+                kept_pins_.size());
+}
+
+bool IOPlacer::isPinInsideConstraints(odb::dbBTerm* bterm,
+                                      const Rect& die_area)
+{
+  Direction dir = Direction::inout;
+  switch (bterm->getIoType().getValue()) {
+    case odb::dbIoType::INPUT:
+      dir = Direction::input;
+      break;
+    case odb::dbIoType::OUTPUT:
+      dir = Direction::output;
+      break;
+    default:
+      dir = Direction::inout;
+  }
+
+  const Rect pin_box = bterm->getBBox();
+  for (const Constraint& constraint : constraints_) {
+    const bool applies
+        = constraint.pin_list.find(bterm) != constraint.pin_list.end()
+          || (constraint.pin_list.empty() && constraint.direction == dir);
+    if (!applies) {
+      continue;
+    }
+
+    const Edge edge = constraint.interval.getEdge();
+    if (edge == Edge::invalid) {
+      if (!constraint.box.contains(pin_box)) {
+        return false;
+      }
+      continue;
+    }
+
+    bool on_edge = false;
+    int pos = 0;
+    if (edge == Edge::bottom || edge == Edge::top) {
+      on_edge = edge == Edge::bottom ? pin_box.yMin() == die_area.yMin()
+                                     : pin_box.yMax() == die_area.yMax();
+      pos = pin_box.xCenter();
+    } else {
+      on_edge = edge == Edge::left ? pin_box.xMin() == die_area.xMin()
+                                   : pin_box.xMax() == die_area.xMax();
+      pos = pin_box.yCenter();
+    }
+    if (!on_edge || pos < constraint.interval.getBegin()
+        || pos > constraint.interval.getEnd()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool IOPlacer::isPinFixed(odb::dbBTerm* bterm) const
+{
+  return bterm->getFirstPinPlacementStatus().isFixed()
+         || kept_pins_.find(bterm) != kept_pins_.end();
+}
+
 void IOPlacer::initParms()
 {
   slots_per_section_ = parms_->getSlotsPerSection();
@@ -591,6 +719,9 @@ void IOPlacer::initIOLists()
 
   int group_idx = 0;
   for (const auto& [pins, order] : pin_groups_) {
+    if (kept_pins_.find(pins.front()) != kept_pins_.end()) {
+      continue;
+    }
     netlist_io_pins_->createIOGroup(pins, order, group_idx);
     group_idx++;
   }
@@ -1612,7 +1743,7 @@ std::vector<int> IOPlacer::findPinsForConstraint(const Constraint& constraint,
   std::vector<int> pin_indices;
   const PinSet& pin_list = constraint.pin_list;
   for (odb::dbBTerm* bterm : pin_list) {
-    if (bterm->getFirstPinPlacementStatus().isFixed()) {
+    if (isPinFixed(bterm)) {
       continue;
     }
     int idx = netlist->getIoPinIdx(bterm);
@@ -1698,6 +1829,9 @@ void IOPlacer::initConstraints(bool annealing)
     }
 
     for (odb::dbBTerm* term : constraint.pin_list) {
+      if (kept_pins_.find(term) != kept_pins_.end()) {
+        continue;
+      }
       int pin_idx = netlist_io_pins_->getIoPinIdx(term);
       IOPin& io_pin = netlist_io_pins_->getIoPin(pin_idx);
       io_pin.setConstraintIdx(constraint_idx);
@@ -1881,8 +2015,12 @@ void IOPlacer::findPinAssignment(std::vector<Section>& sections,
     updateSection(sec, slots);
   }
 
-  for (auto& match : hg_vec) {
-    match.findAssignment();
+  // The sections are matched independently; only committing the
+  // assignments below touches the shared slots.
+#pragma omp parallel for num_threads(parms_->getNumThreads()) \
+    schedule(dynamic)
+  for (int i = 0; i < hg_vec.size(); i++) {
+    hg_vec[i].findAssignment();
   }
 
   if (!mirrored_pins_.empty()) {
@@ -1908,7 +2046,9 @@ void IOPlacer::updateSlots()
 
 void IOPlacer::run(bool random_mode)
 {
+  utl::TraceSpan span("ppl", "place_pins");
   initParms();
+  initIncrementalPins();
 
   initNetlistAndCore(hor_layers_, ver_layers_);
   getBlockedRegionsFromMacros();
@@ -2049,6 +2189,7 @@ void IOPlacer::setAnnealingDebugNoPauseMode(const bool no_pause_mode)
 void IOPlacer::runAnnealing(bool random)
 {
   initParms();
+  initIncrementalPins();
 
   initNetlistAndCore(hor_layers_, ver_layers_);
   getBlockedRegionsFromMacros();
@@ -2485,7 +2626,8 @@ void IOPlacer::filterObstructedSlotsForTopLayer()
   // Get already placed pins
   for (odb::dbBTerm* term : getBlock()->getBTerms()) {
     for (odb::dbBPin* pin : term->getBPins()) {
-      if (pin->getPlacementStatus().isFixed()) {
+      if (pin->getPlacementStatus().isFixed()
+          || kept_pins_.find(term) != kept_pins_.end()) {
         for (odb::dbBox* box : pin->getBoxes()) {
           if (box->getTechLayer()->getRoutingLevel() == top_grid_->layer) {
             odb::Rect obstruction_rect = box->getBox();
@@ -2586,7 +2728,7 @@ void IOPlacer::initNetlist()
   odb::dbSet<odb::dbBTerm> bterms = getBlock()->getBTerms();
 
   for (odb::dbBTerm* b_term : bterms) {
-    if (b_term->getFirstPinPlacementStatus().isFixed()) {
+    if (isPinFixed(b_term)) {
       continue;
     }
     odb::dbNet* net = b_term->getNet();
@@ -2645,6 +2787,9 @@ void IOPlacer::initNetlist()
 
   int group_idx = 0;
   for (const auto& [pins, order] : pin_groups_) {
+    if (kept_pins_.find(pins.front()) != kept_pins_.end()) {
+      continue;
+    }
     int group_created = netlist_->createIOGroup(pins, order, group_idx);
     if (group_created != pins.size()) {
       logger_->error(PPL, 94, "Cannot create group of size {}.", pins.size());
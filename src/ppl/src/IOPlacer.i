@@ -253,6 +253,18 @@ set_rand_seed(double seed)
   getIOPlacer()->getParameters()->setRandSeed(seed);
 }
 
+void
+set_incremental(bool incremental)
+{
+  getIOPlacer()->getParameters()->setIncremental(incremental);
+}
+
+void
+set_num_threads(int threads)
+{
+  getIOPlacer()->getParameters()->setNumThreads(threads);
+}
+
 void
 set_hor_thick_multiplier(float length)
 {
@@ -427,6 +427,7 @@ sta::define_cmd_args "place_pins" {[-hor_layers h_layers]\
                                   [-exclude region]\
                                   [-group_pins pin_list]\
                                   [-annealing] \
+                                  [-incremental] \
                                   [-write_pin_placement file_name]
                                  }
 
@@ -436,7 +437,7 @@ proc place_pins { args } {
   sta::parse_key_args "place_pins" args \
   keys {-hor_layers -ver_layers -random_seed -corner_avoidance \
         -min_distance -exclude -group_pins -write_pin_placement} \
-  flags {-random -min_distance_in_tracks -annealing}
+  flags {-random -min_distance_in_tracks -annealing -incremental}
 
   sta::check_argc_eq0 "place_pins" $args
 
@@ -606,6 +607,9 @@ proc place_pins { args } {
     ppl::set_pin_placement_file $keys(-write_pin_placement)
   }
 
+  ppl::set_incremental [info exists flags(-incremental)]
+  ppl::set_num_threads [ord::thread_count]
+
   if { [info exists flags(-annealing)] } {
     ppl::run_annealing [info exists flags(-random)]
   } else {
@@ -54,6 +54,15 @@ void Netlist::addIONet(const IOPin& io_pin,
   io_pins_.push_back(io_pin);
   inst_pins_.insert(inst_pins_.end(), inst_pins.begin(), inst_pins.end());
   net_pointer_.push_back(inst_pins_.size());
+
+  // The instance pins don't move during pin placement, so the HPWL of an
+  // IO net at any slot only needs their bounding box.
+  Rect sinks_bbox;
+  sinks_bbox.mergeInit();
+  for (const InstancePin& inst_pin : inst_pins) {
+    sinks_bbox.merge(Rect(inst_pin.getPos(), inst_pin.getPos()));
+  }
+  sinks_bbox_.push_back(sinks_bbox);
 }
 
 int Netlist::createIOGroup(const std::vector<odb::dbBTerm*>& pin_list,
@@ -105,21 +114,12 @@ int Netlist::numIOPins()
 
 Rect Netlist::getBB(int idx, const Point& slot_pos)
 {
-  int net_start = net_pointer_[idx];
-  int net_end = net_pointer_[idx + 1];
+  const Rect& sinks_bbox = sinks_bbox_[idx];
 
-  int min_x = slot_pos.x();
-  int min_y = slot_pos.y();
-  int max_x = slot_pos.x();
-  int max_y = slot_pos.y();
-
-  for (int idx = net_start; idx < net_end; ++idx) {
-    Point pos = inst_pins_[idx].getPos();
-    min_x = std::min(min_x, pos.x());
-    max_x = std::max(max_x, pos.x());
-    min_y = std::min(min_y, pos.y());
-    max_y = std::max(max_y, pos.y());
-  }
+  int min_x = std::min(slot_pos.x(), sinks_bbox.xMin());
+  int min_y = std::min(slot_pos.y(), sinks_bbox.yMin());
+  int max_x = std::max(slot_pos.x(), sinks_bbox.xMax());
+  int max_y = std::max(slot_pos.y(), sinks_bbox.yMax());
 
   Point upper_bounds = Point(max_x, max_y);
   Point lower_bounds = Point(min_x, min_y);
@@ -130,21 +130,12 @@ Rect Netlist::getBB(int idx, const Point& slot_pos)
 
 int Netlist::computeIONetHPWL(int idx, const Point& slot_pos)
 {
-  int net_start = net_pointer_[idx];
-  int net_end = net_pointer_[idx + 1];
-
-  int min_x = slot_pos.x();
-  int min_y = slot_pos.y();
-  int max_x = slot_pos.x();
-  int max_y = slot_pos.y();
+  const Rect& sinks_bbox = sinks_bbox_[idx];
 
-  for (int idx = net_start; idx < net_end; ++idx) {
-    Point pos = inst_pins_[idx].getPos();
-    min_x = std::min(min_x, pos.x());
-    max_x = std::max(max_x, pos.x());
-    min_y = std::min(min_y, pos.y());
-    max_y = std::max(max_y, pos.y());
-  }
+  int min_x = std::min(slot_pos.x(), sinks_bbox.xMin());
+  int min_y = std::min(slot_pos.y(), sinks_bbox.yMin());
+  int max_x = std::max(slot_pos.x(), sinks_bbox.xMax());
+  int max_y = std::max(slot_pos.y(), sinks_bbox.yMax());
 
   int x = max_x - min_x;
   int y = max_y - min_y;
@@ -181,6 +172,8 @@ void Netlist::clear()
 {
   inst_pins_.clear();
   net_pointer_.clear();
+  net_pointer_.push_back(0);
+  sinks_bbox_.clear();
   io_pins_.clear();
   io_groups_.clear();
   _db_pin_idx_map.clear();
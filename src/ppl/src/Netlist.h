@@ -209,6 +209,8 @@ class Netlist
  private:
   std::vector<InstancePin> inst_pins_;
   std::vector<int> net_pointer_;
+  // bounding box of the instance pins of each IO net, without the IO pin
+  std::vector<odb::Rect> sinks_bbox_;
   std::vector<IOPin> io_pins_;
   std::vector<PinGroupByIndex> io_groups_;
   std::map<odb::dbBTerm*, int> _db_pin_idx_map;
@@ -37,9 +37,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <memory>
 #include <optional>
 #include <string>
+#include <tuple>
+#include <vector>
 
 namespace odb {
 class dbDatabase;
+class dbInst;
 class Point;
 class dbNet;
 class dbTechLayer;
@@ -61,11 +64,22 @@ class IRSolver;
 class IRDropDataSource;
 class DebugGui;
 
+// Linear solver for the grid equations.  AUTO uses the iterative solver
+// on grids large enough that LU fill-in dominates memory and runtime.
+enum class SolverType
+{
+  AUTO,
+  DIRECT,
+  ITERATIVE
+};
+
 class PDNSim
 {
  public:
   using IRDropByPoint = std::map<odb::Point, double>;
   using IRDropByLayer = std::map<odb::dbTechLayer*, IRDropByPoint>;
+  // Solved voltage of each grid node keyed by (layer, x, y).
+  using NodeVoltages = std::map<std::tuple<int, int, int>, double>;
 
   PDNSim();
   ~PDNSim();
@@ -85,12 +99,28 @@ class PDNSim
     node_density_factor_ = node_density_factor;
   }
   void setCorner(sta::Corner* corner) { corner_ = corner; }
+  void setSolver(SolverType type, double tolerance, int threads)
+  {
+    solver_type_ = type;
+    solver_tolerance_ = tolerance;
+    solver_threads_ = threads;
+  }
 
   void setNetVoltage(odb::dbNet* net, float voltage);
+  // Activity scenarios solved by the next analyzePowerGrid.  Each file
+  // lists "instance power" lines overriding the STA power of instances.
+  void addPowerScenario(const std::string& file)
+  {
+    power_scenarios_.push_back(file);
+  }
+  void clearPowerScenarios() { power_scenarios_.clear(); }
+  // With incremental the solve starts from the voltages of the previous
+  // incremental analysis of the net, which is close after small PDN edits.
   void analyzePowerGrid(const std::string& voltage_file,
                         bool enable_em,
                         const std::string& em_file,
-                        const std::string& error_file);
+                        const std::string& error_file,
+                        bool incremental = false);
   void writeSpice(const std::string& file);
   void getIRDropMap(IRDropByLayer& ir_drop);
   void getIRDropForLayer(odb::dbTechLayer* layer, IRDropByPoint& ir_drop);
@@ -104,6 +134,15 @@ class PDNSim
   std::unique_ptr<IRSolver> getIRSolver(bool require_voltage);
 
   void saveIRDrop(IRSolver* ir_solver);
+  std::map<odb::dbInst*, float> readPowerScenario(
+      const std::string& file) const;
+  // Reports the solution of ir_solver and returns the worst IR drop.
+  double reportIRDrop(IRSolver* ir_solver,
+                      const std::string& corner_name,
+                      const std::string& scenario,
+                      const std::string& voltage_file,
+                      bool enable_em,
+                      const std::string& em_file);
 
   odb::dbDatabase* db_ = nullptr;
   sta::dbSta* sta_ = nullptr;
@@ -118,6 +157,11 @@ class PDNSim
   IRDropByLayer ir_drop_;
   float node_density_ = -1;
   int node_density_factor_ = 0;
+  SolverType solver_type_ = SolverType::AUTO;
+  double solver_tolerance_ = 1e-10;
+  int solver_threads_ = 1;
+  std::vector<std::string> power_scenarios_;
+  std::map<odb::dbNet*, NodeVoltages> last_voltages_;
   float min_resolution_ = -1;
   std::unique_ptr<DebugGui> debug_gui_;
   std::unique_ptr<IRDropDataSource> heatmap_;
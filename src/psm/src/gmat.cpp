@@ -33,6 +33,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "gmat.h"
 
+#include <algorithm>
+#include <cfloat>
 #include <iostream>
 #include <vector>
 
@@ -46,7 +48,7 @@ using std::vector;
 
 //! Constructor for creating the G matrix
 GMat::GMat(int num_layers, utl::Logger* logger, odb::dbTech* tech)
-    : layer_maps_(num_layers + 1, NodeMap())
+    : layer_maps_(num_layers + 1, NodeMap()), layer_lookup_(num_layers + 1)
 {
   // as it start from 0 and everywhere we use layer
   logger_ = logger;
@@ -195,12 +197,12 @@ Node* GMat::getNode(int x, int y, int layer, bool nearest /*=false*/)
   }
   const NodeMap& layer_map = layer_maps_[layer];
   if (nearest == false) {
-    const auto x_itr = layer_map.find(x);
-    if (x_itr != layer_map.end()) {
-      const auto y_itr = x_itr->second.find(y);
-      if (y_itr != x_itr->second.end()) {
-        return y_itr->second;
-      }
+    const auto& lookup = layer_lookup_[layer];
+    const auto node_itr = lookup.find(nodeKey(x, y));
+    if (node_itr != lookup.end()) {
+      return node_itr->second;
+    }
+    if (layer_map.find(x) != layer_map.end()) {
       logger_->error(utl::PSM, 46, "Node location lookup error for y.");
     } else {
       logger_->error(utl::PSM, 47, "Node location lookup error for x.");
@@ -248,6 +250,7 @@ void GMat::insertNode(Node* node)
   Point nodeLoc = node->getLoc();
   NodeMap& layer_map = layer_maps_[layer];
   layer_map[nodeLoc.getX()][nodeLoc.getY()] = node;
+  layer_lookup_[layer][nodeKey(nodeLoc.getX(), nodeLoc.getY())] = node;
   G_mat_nodes_.push_back(node);
   n_nodes_++;
 }
@@ -261,22 +264,10 @@ void GMat::insertNode(Node* node)
 */
 Node* GMat::setNode(const Point& loc, int layer)
 {
-  NodeMap& layer_map = layer_maps_[layer];
-  if (layer_map.empty()) {
-    Node* node = new Node(loc, layer);
-    insertNode(node);
-    return node;
-  }
-  NodeMap::iterator x_itr = layer_map.find(loc.getX());
-  if (x_itr != layer_map.end()) {
-    map<int, Node*>::iterator y_itr = x_itr->second.find(loc.getY());
-    if (y_itr != x_itr->second.end()) {
-      Node* node = y_itr->second;
-      return node;
-    }
-    Node* node = new Node(loc, layer);
-    insertNode(node);
-    return node;
+  const auto& lookup = layer_lookup_[layer];
+  const auto node_itr = lookup.find(nodeKey(loc.getX(), loc.getY()));
+  if (node_itr != lookup.end()) {
+    return node_itr->second;
   }
   Node* node = new Node(loc, layer);
   insertNode(node);
@@ -342,8 +333,7 @@ void GMat::initializeGmatDok(int num)
   } else {
     G_mat_dok_.num_cols = n_nodes_ + num;
     G_mat_dok_.num_rows = n_nodes_ + num;
-    A_mat_dok_.num_cols = n_nodes_ + num;
-    A_mat_dok_.num_rows = n_nodes_ + num;
+    G_mat_dok_.columns.assign(n_nodes_ + num, DokColumn());
   }
 }
 
@@ -511,49 +501,54 @@ void GMat::addSource(int loc, int source_number)
 //! Function which converts the DOK matrix into CSC format in a sparse method
 /*!
  */
-bool GMat::generateCSCMatrix()
+bool GMat::generateCSCMatrix(const int num_threads)
 {
-  G_mat_csc_.num_cols = G_mat_dok_.num_cols;
-  G_mat_csc_.num_rows = G_mat_dok_.num_rows;
-  G_mat_csc_.nnz = 0;
-
-  for (NodeIdx col = 0; col < G_mat_csc_.num_cols; ++col) {
-    G_mat_csc_.col_ptr.push_back(G_mat_csc_.nnz);
-    map<GMatLoc, double>::iterator it;
-    map<GMatLoc, double>::iterator it_lower
-        = G_mat_dok_.values.lower_bound(make_pair(col, 0));
-    map<GMatLoc, double>::iterator it_upper
-        = G_mat_dok_.values.upper_bound(make_pair(col, G_mat_csc_.num_rows));
-    for (it = it_lower; it != it_upper; ++it) {
-      G_mat_csc_.values.push_back(it->second);           // push back value
-      G_mat_csc_.row_idx.push_back((it->first).second);  // push back row idx
-      G_mat_csc_.nnz++;
-    }
-  }
-  G_mat_csc_.col_ptr.push_back(G_mat_csc_.nnz);
+  fillCSCMatrix(G_mat_csc_, false, num_threads);
+  return true;
+}
+
+//! Function which generates the A matrix, the sparsity pattern of G
+bool GMat::generateACSCMatrix(const int num_threads)
+{
+  fillCSCMatrix(A_mat_csc_, true, num_threads);
   return true;
 }
-bool GMat::generateACSCMatrix()
+
+//! Function which fills a CSC matrix from the DOK columns in two passes
+/*!
+ * The first pass turns the column sizes into column offsets so that the
+ * second pass can write every column in place, in parallel.
+     \param csc Matrix to fill
+     \param pattern_only Store 1 for every entry instead of its conductance
+     \param num_threads Threads of the second pass
+     \return nothing
+*/
+void GMat::fillCSCMatrix(CscMatrix& csc,
+                         const bool pattern_only,
+                         const int num_threads)
 {
-  A_mat_csc_.num_cols = A_mat_dok_.num_cols;
-  A_mat_csc_.num_rows = A_mat_dok_.num_rows;
-  A_mat_csc_.nnz = 0;
-
-  for (NodeIdx col = 0; col < A_mat_csc_.num_cols; ++col) {
-    A_mat_csc_.col_ptr.push_back(A_mat_csc_.nnz);
-    map<GMatLoc, double>::iterator it;
-    map<GMatLoc, double>::iterator it_lower
-        = A_mat_dok_.values.lower_bound(make_pair(col, 0));
-    map<GMatLoc, double>::iterator it_upper
-        = A_mat_dok_.values.upper_bound(make_pair(col, A_mat_csc_.num_rows));
-    for (it = it_lower; it != it_upper; ++it) {
-      A_mat_csc_.values.push_back(it->second);           // push back value
-      A_mat_csc_.row_idx.push_back((it->first).second);  // push back row idx
-      A_mat_csc_.nnz++;
+  const NodeIdx num_cols = G_mat_dok_.num_cols;
+  csc.num_cols = num_cols;
+  csc.num_rows = G_mat_dok_.num_rows;
+
+  csc.col_ptr.resize(num_cols + 1);
+  csc.col_ptr[0] = 0;
+  for (NodeIdx col = 0; col < num_cols; ++col) {
+    csc.col_ptr[col + 1] = csc.col_ptr[col] + G_mat_dok_.columns[col].size();
+  }
+  csc.nnz = csc.col_ptr[num_cols];
+  csc.row_idx.resize(csc.nnz);
+  csc.values.resize(csc.nnz);
+
+#pragma omp parallel for num_threads(num_threads) schedule(static)
+  for (NodeIdx col = 0; col < num_cols; ++col) {
+    NodeIdx idx = csc.col_ptr[col];
+    for (const auto& [row, value] : G_mat_dok_.columns[col]) {
+      csc.row_idx[idx] = row;
+      csc.values[idx] = pattern_only ? 1.0 : value;
+      ++idx;
     }
   }
-  A_mat_csc_.col_ptr.push_back(A_mat_csc_.nnz);
-  return true;
 }
 
 //! Function which returns the value of the conductance row and column in G
@@ -572,9 +567,10 @@ double GMat::getConductance(NodeIdx row, NodeIdx col)
                    "Index out of bound for getting G matrix conductance. ",
                    "Ensure object is initialized to the correct size first.");
   }
-  GMatLoc key = make_pair(col, row);
-  map<GMatLoc, double>::iterator it = G_mat_dok_.values.find(key);
-  if (it != G_mat_dok_.values.end()) {
+  const DokColumn& column = G_mat_dok_.columns[col];
+  const auto it = std::lower_bound(
+      column.begin(), column.end(), make_pair(row, -DBL_MAX));
+  if (it != column.end() && it->first == row) {
     return it->second;
   }
   return 0;
@@ -598,9 +594,21 @@ void GMat::updateConductance(NodeIdx row, NodeIdx col, double cond)
                    "Index out of bound for getting G matrix conductance. ",
                    "Ensure object is initialized to the correct size first.");
   }
-  GMatLoc key = make_pair(col, row);
-  G_mat_dok_.values[key] = cond;
-  A_mat_dok_.values[key] = 1;
+  DokColumn& column = G_mat_dok_.columns[col];
+  const auto it = std::lower_bound(
+      column.begin(), column.end(), make_pair(row, -DBL_MAX));
+  if (it != column.end() && it->first == row) {
+    it->second = cond;
+  } else {
+    column.emplace(it, row, cond);
+  }
+}
+
+//! Function which packs a location into a key for the node lookup
+uint64_t GMat::nodeKey(const int x, const int y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32)
+         | static_cast<uint32_t>(y);
 }
 
 //! Function to find the nearest node to a given location in Y direction
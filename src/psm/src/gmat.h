@@ -33,6 +33,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "node.h"
 #include "odb/db.h"
 #include "utl/Logger.h"
@@ -45,14 +50,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace psm {
 using NodeMap = std::map<int, std::map<int, Node*>>;
 
-using GMatLoc = std::pair<NodeIdx, NodeIdx>;
+//! Entries of one column of the DOK matrix as < row_num, value >, by row
+using DokColumn = std::vector<std::pair<NodeIdx, double>>;
 
 //! Data structure for the Dictionary of Keys Matrix
+/*!
+ * Entries are bucketed by column. A column only holds its node, the node's
+ * neighbors and any source, so a short sorted vector is cheaper than a tree
+ * and the CSC matrices can be filled column by column.
+ */
 struct DokMatrix
 {
   NodeIdx num_rows;
   NodeIdx num_cols;
-  std::map<GMatLoc, double> values;  // pair < col_num, row_num >
+  std::vector<DokColumn> columns;
 };
 
 //! Data structure for the Compressed Sparse Column Matrix
@@ -135,9 +146,9 @@ class GMat
   //! Function to add the voltage source based on source location
   void addSource(int loc, int source_number);
   //! Function which generates the compressed sparse column matrix
-  bool generateCSCMatrix();
+  bool generateCSCMatrix(int num_threads);
   //! Function which generates the compressed sparse column matrix for A
-  bool generateACSCMatrix();
+  bool generateACSCMatrix(int num_threads);
   //! Function to return a vector which contains a  pointer to all the nodes
   std::vector<Node*> getAllNodes();
   //! Function to return a pointer to the G matrix in DOK format
@@ -149,6 +160,10 @@ class GMat
   //! Function to add a conductance value at the specified location of the
   //! matrix
   void updateConductance(NodeIdx row, NodeIdx col, double cond);
+  //! Function to fill a CSC matrix from the G matrix DOK entries
+  void fillCSCMatrix(CscMatrix& csc, bool pattern_only, int num_threads);
+  //! Key of a location in the per layer node lookup
+  static uint64_t nodeKey(int x, int y);
   //! Function to find the nearest node to a particular location
   Node* nearestYNode(NodeMap::const_iterator x_itr, int y);
   //! Function to find conductivity of a stripe based on width,length, and pitch
@@ -164,13 +179,13 @@ class GMat
   DokMatrix G_mat_dok_;
   //! Compressed sparse column matrix for superLU
   CscMatrix G_mat_csc_;
-  //! Dictionary of keys for A matrix
-  DokMatrix A_mat_dok_;
   //! Compressed sparse column matrix for A
   CscMatrix A_mat_csc_;
   //! Vector of pointers to all nodes in the G matrix
   std::vector<Node*> G_mat_nodes_;
   //! Vector of maps to all nodes
   std::vector<NodeMap> layer_maps_;
+  //! Vector of hashes for exact location lookup of nodes, per layer
+  std::vector<std::unordered_map<uint64_t, Node*>> layer_lookup_;
 };
 }  // namespace psm
@@ -131,6 +131,9 @@ bool IRDropDataSource::populateMap()
 
   auto& ir_drop = ir_drops[layer_];
   for (const auto& [point, drop] : ir_drop) {
+    if (isPopulateCancelled()) {
+      return false;
+    }
     addToMap({point, point}, drop);
   }
 
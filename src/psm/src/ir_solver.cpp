@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "ir_solver.h"
 
+#include <Eigen/IterativeLinearSolvers>
 #include <Eigen/Sparse>
 #include <Eigen/SparseLU>
 #include <cmath>
@@ -88,12 +89,19 @@ using std::stringstream;
 using std::to_string;
 using std::vector;
 
+using Eigen::ConjugateGradient;
+using Eigen::IncompleteCholesky;
 using Eigen::Map;
 using Eigen::SparseLU;
 using Eigen::SparseMatrix;
 using Eigen::Success;
+using Eigen::Triplet;
 using Eigen::VectorXd;
 
+// Grids with at least this many nodes use the iterative solver unless a
+// solver is requested explicitly.
+static constexpr int iterative_solver_min_nodes = 1000000;
+
 IRSolver::IRSolver(odb::dbDatabase* db,
                    sta::dbSta* sta,
                    rsz::Resizer* resizer,
@@ -160,15 +168,38 @@ const vector<double>& IRSolver::getJ() const
   return J_;
 }
 
-//! Function to solve for voltage using SparseLU
-void IRSolver::solveIR()
+void IRSolver::setSolver(SolverType type, double tolerance, int threads)
+{
+  solver_type_ = type;
+  solver_tolerance_ = tolerance;
+  solver_threads_ = threads;
+}
+
+//! Factorization of G kept between solves of different right hand sides
+struct IRSolver::Factorization
+{
+  bool iterative = false;
+  //! LU factors of the full G matrix
+  SparseLU<SparseMatrix<double>> lu;
+  //! Source column pinning each node, or -1 for free nodes
+  vector<int> fixed_col;
+  //! Index of each free node in the reduced system
+  vector<int> free_idx;
+  //! Conductances from free nodes (first) to pinned nodes (second)
+  vector<Triplet<double>> fixed_coupling;
+  //! Conductance matrix of the free nodes
+  SparseMatrix<double> A;
+  ConjugateGradient<SparseMatrix<double>,
+                    Eigen::Lower | Eigen::Upper,
+                    IncompleteCholesky<double>>
+      cg;
+  //! Previous solution of the free nodes, used as the next initial guess
+  VectorXd guess;
+};
+
+//! Function to factorize G using SparseLU
+void IRSolver::factorizeDirect()
 {
-  if (!connection_) {
-    logger_->warn(utl::PSM,
-                  8,
-                  "Powergrid is not connected to all instances, therefore the "
-                  "IR Solver may not be accurate. LVS may also fail.");
-  }
   CscMatrix* Gmat = Gmat_->getGMat();
   // fill A
   double* values = &(Gmat->values[0]);
@@ -180,9 +211,8 @@ void IRSolver::solveIR()
                               col_ptr,  // read-write
                               row_idx,
                               values);
-  vector<double> J = getJ();
-  Map<VectorXd> b(J.data(), J.size());
-  SparseLU<SparseMatrix<double>> solver;
+  factorization_->iterative = false;
+  SparseLU<SparseMatrix<double>>& solver = factorization_->lu;
   debugPrint(logger_, utl::PSM, "IR Solver", 1, "Factorizing the G matrix");
   solver.compute(A);
   if (solver.info() != Success) {
@@ -193,9 +223,17 @@ void IRSolver::solveIR()
         "LU factorization of the G Matrix failed. SparseLU solver message: {}.",
         solver.lastErrorMessage());
   }
+}
+
+//! Function to solve for voltage using the LU factors of G
+void IRSolver::solveDirect(VectorXd& x)
+{
+  vector<double> J = getJ();
+  Map<VectorXd> b(J.data(), J.size());
+  SparseLU<SparseMatrix<double>>& solver = factorization_->lu;
   debugPrint(
       logger_, utl::PSM, "IR Solver", 1, "Solving system of equations GV=J");
-  VectorXd x = solver.solve(b);
+  x = solver.solve(b);
   if (solver.info() != Success) {
     // solving failed
     logger_->error(utl::PSM, 12, "Solving V = inv(G)*J failed.");
@@ -206,6 +244,169 @@ void IRSolver::solveIR()
                1,
                "Solving system of equations GV=J complete");
   }
+}
+
+//! Function to prepare G for conjugate gradients
+/*
+ * The voltage source rows of G only pin their node to the source voltage.
+ * Eliminating those nodes leaves the conductance matrix of the remaining
+ * nodes, which is symmetric positive definite, so it can be solved with
+ * incomplete Cholesky preconditioned CG without factorizing G.
+ */
+bool IRSolver::factorizeIterative()
+{
+  const CscMatrix* Gmat = Gmat_->getGMat();
+  const int num_nodes = Gmat_->getNumNodes();
+  Factorization& fact = *factorization_;
+  fact.iterative = true;
+
+  vector<int>& fixed_col = fact.fixed_col;
+  fixed_col.assign(num_nodes, -1);
+  for (int col = num_nodes; col < Gmat->num_cols; ++col) {
+    for (int k = Gmat->col_ptr[col]; k < Gmat->col_ptr[col + 1]; ++k) {
+      const int row = Gmat->row_idx[k];
+      if (row < num_nodes) {
+        fixed_col[row] = col;
+      }
+    }
+  }
+
+  vector<int>& free_idx = fact.free_idx;
+  free_idx.assign(num_nodes, -1);
+  int num_free = 0;
+  for (int node = 0; node < num_nodes; ++node) {
+    if (fixed_col[node] < 0) {
+      free_idx[node] = num_free++;
+    }
+  }
+
+  vector<Triplet<double>> triplets;
+  triplets.reserve(Gmat->nnz);
+  fact.fixed_coupling.clear();
+  for (int col = 0; col < num_nodes; ++col) {
+    for (int k = Gmat->col_ptr[col]; k < Gmat->col_ptr[col + 1]; ++k) {
+      const int row = Gmat->row_idx[k];
+      if (row >= num_nodes || fixed_col[row] >= 0) {
+        continue;
+      }
+      const double value = Gmat->values[k];
+      if (fixed_col[col] >= 0) {
+        fact.fixed_coupling.emplace_back(free_idx[row], col, value);
+      } else {
+        triplets.emplace_back(free_idx[row], free_idx[col], value);
+      }
+    }
+  }
+  fact.A.resize(num_free, num_free);
+  fact.A.setFromTriplets(triplets.begin(), triplets.end());
+  triplets.clear();
+  triplets.shrink_to_fit();
+
+  // Lower|Upper lets Eigen run the matrix-vector products multi-threaded.
+  Eigen::setNbThreads(solver_threads_);
+  fact.cg.setTolerance(solver_tolerance_);
+  debugPrint(logger_,
+             utl::PSM,
+             "IR Solver",
+             1,
+             "Preconditioning {} free nodes of the G matrix",
+             num_free);
+  fact.cg.compute(fact.A);
+  fact.guess.resize(0);
+  if (!initial_voltages_.empty()) {
+    fact.guess.resize(num_free);
+    for (int node = 0; node < num_nodes; ++node) {
+      if (free_idx[node] >= 0) {
+        fact.guess(free_idx[node]) = initial_voltages_[node];
+      }
+    }
+  }
+  return fact.cg.info() == Success;
+}
+
+//! Function to solve for voltage using conjugate gradients
+/*
+ * Starts from the solution of the previous right hand side, if any, which
+ * is usually close when only the currents changed.
+ */
+bool IRSolver::solveIterative(VectorXd& x)
+{
+  const vector<double>& J = getJ();
+  const int num_nodes = Gmat_->getNumNodes();
+  Factorization& fact = *factorization_;
+
+  VectorXd b(fact.A.rows());
+  for (int node = 0; node < num_nodes; ++node) {
+    if (fact.fixed_col[node] < 0) {
+      b(fact.free_idx[node]) = J[node];
+    }
+  }
+  for (const Triplet<double>& coupling : fact.fixed_coupling) {
+    b(coupling.row()) -= coupling.value() * J[fact.fixed_col[coupling.col()]];
+  }
+
+  const VectorXd y = fact.guess.size() == b.size()
+                         ? VectorXd(fact.cg.solveWithGuess(b, fact.guess))
+                         : VectorXd(fact.cg.solve(b));
+  debugPrint(logger_,
+             utl::PSM,
+             "IR Solver",
+             1,
+             "CG finished after {} iterations, estimated error {}",
+             fact.cg.iterations(),
+             fact.cg.error());
+  if (fact.cg.info() != Success) {
+    return false;
+  }
+  fact.guess = y;
+
+  x.resize(Gmat_->getGMat()->num_rows);
+  x.setZero();
+  for (int node = 0; node < num_nodes; ++node) {
+    const int col = fact.fixed_col[node];
+    x(node) = col >= 0 ? J[col] : y(fact.free_idx[node]);
+  }
+  return true;
+}
+
+void IRSolver::solveIR()
+{
+  if (!connection_) {
+    logger_->warn(utl::PSM,
+                  8,
+                  "Powergrid is not connected to all instances, therefore the "
+                  "IR Solver may not be accurate. LVS may also fail.");
+  }
+
+  auto fall_back = [this]() {
+    logger_->warn(utl::PSM,
+                  95,
+                  "Iterative solver did not converge, falling back to the "
+                  "direct solver.");
+    factorizeDirect();
+  };
+  if (!factorization_) {
+    bool iterative = solver_type_ == SolverType::ITERATIVE;
+    if (solver_type_ == SolverType::AUTO) {
+      // Only the iterative solver benefits from initial voltages.
+      iterative = Gmat_->getNumNodes() >= iterative_solver_min_nodes
+                  || !initial_voltages_.empty();
+    }
+    factorization_ = std::make_unique<Factorization>();
+    if (!iterative) {
+      factorizeDirect();
+    } else if (!factorizeIterative()) {
+      fall_back();
+    }
+  }
+
+  VectorXd x;
+  if (factorization_->iterative && !solveIterative(x)) {
+    fall_back();
+  }
+  if (!factorization_->iterative) {
+    solveDirect(x);
+  }
 
   const int num_nodes = Gmat_->getNumNodes();
   int node_num = 0;
@@ -235,47 +436,47 @@ void IRSolver::solveIR()
     max_cur_ = 0;
     double sum_cur = 0;
     Point node_loc;
-    for (auto [loc, value] : Gmat_dok->values) {
-      const NodeIdx col = loc.first;
-      const NodeIdx row = loc.second;
-      if (col <= row) {
-        continue;  // ignore lower half and diagonal as matrix is symmetric
-      }
-      const double cond = value;  // get cond value
-      if (abs(cond) < 1e-15) {    // ignore if an empty cell
-        continue;
-      }
-      const string net_name = net_->getName();
-      if (col < num_nodes) {  // resistances
-        const double resistance = -1 / cond;
-
-        const Node* node1 = Gmat_->getNode(col);
-        const Node* node2 = Gmat_->getNode(row);
-        node_loc = node1->getLoc();
-        const int x1 = node_loc.getX();
-        const int y1 = node_loc.getY();
-        const int l1 = node1->getLayerNum();
-        const string node1_name = net_name + "_" + to_string(x1) + "_"
-                                  + to_string(y1) + "_" + to_string(l1);
-
-        node_loc = node2->getLoc();
-        int x2 = node_loc.getX();
-        int y2 = node_loc.getY();
-        int l2 = node2->getLayerNum();
-        string node2_name = net_name + "_" + to_string(x2) + "_" + to_string(y2)
-                            + "_" + to_string(l2);
-
-        const string segment_name = "seg_" + to_string(resistance_number);
-
-        const double v1 = node1->getVoltage();
-        const double v2 = node2->getVoltage();
-        double seg_cur = (v1 - v2) / resistance;
-        sum_cur += abs(seg_cur);
-        seg_cur = abs(seg_cur);
-        if (seg_cur > max_cur_) {
-          max_cur_ = seg_cur;
+    for (NodeIdx col = 0; col < Gmat_dok->num_cols; ++col) {
+      for (const auto& [row, value] : Gmat_dok->columns[col]) {
+        if (col <= row) {
+          continue;  // ignore lower half and diagonal as matrix is symmetric
+        }
+        const double cond = value;  // get cond value
+        if (abs(cond) < 1e-15) {    // ignore if an empty cell
+          continue;
+        }
+        const string net_name = net_->getName();
+        if (col < num_nodes) {  // resistances
+          const double resistance = -1 / cond;
+
+          const Node* node1 = Gmat_->getNode(col);
+          const Node* node2 = Gmat_->getNode(row);
+          node_loc = node1->getLoc();
+          const int x1 = node_loc.getX();
+          const int y1 = node_loc.getY();
+          const int l1 = node1->getLayerNum();
+          const string node1_name = net_name + "_" + to_string(x1) + "_"
+                                    + to_string(y1) + "_" + to_string(l1);
+
+          node_loc = node2->getLoc();
+          int x2 = node_loc.getX();
+          int y2 = node_loc.getY();
+          int l2 = node2->getLayerNum();
+          string node2_name = net_name + "_" + to_string(x2) + "_"
+                              + to_string(y2) + "_" + to_string(l2);
+
+          const string segment_name = "seg_" + to_string(resistance_number);
+
+          const double v1 = node1->getVoltage();
+          const double v2 = node2->getVoltage();
+          double seg_cur = (v1 - v2) / resistance;
+          sum_cur += abs(seg_cur);
+          seg_cur = abs(seg_cur);
+          if (seg_cur > max_cur_) {
+            max_cur_ = seg_cur;
+          }
+          resistance_number++;
         }
-        resistance_number++;
       }
     }  // for gmat values
     avg_cur_ = sum_cur / resistance_number;
@@ -284,6 +485,34 @@ void IRSolver::solveIR()
   }  // enable em
 }
 
+void IRSolver::setInitialVoltages(const PDNSim::NodeVoltages& voltages)
+{
+  const int num_nodes = Gmat_->getNumNodes();
+  initial_voltages_.assign(num_nodes, getSupplyVoltageSrc());
+  for (int i = 0; i < num_nodes; ++i) {
+    const Node* node = Gmat_->getNode(i);
+    const Point loc = node->getLoc();
+    const auto itr = voltages.find(
+        std::make_tuple(node->getLayerNum(), loc.getX(), loc.getY()));
+    if (itr != voltages.end()) {
+      initial_voltages_[i] = itr->second;
+    }
+  }
+}
+
+PDNSim::NodeVoltages IRSolver::getNodeVoltages() const
+{
+  PDNSim::NodeVoltages voltages;
+  const int num_nodes = Gmat_->getNumNodes();
+  for (int i = 0; i < num_nodes; ++i) {
+    const Node* node = Gmat_->getNode(i);
+    const Point loc = node->getLoc();
+    voltages[std::make_tuple(node->getLayerNum(), loc.getX(), loc.getY())]
+        = node->getVoltage();
+  }
+  return voltages;
+}
+
 void IRSolver::writeVoltageFile(const std::string& file) const
 {
   ofstream ir_report;
@@ -333,44 +562,44 @@ void IRSolver::writeEMFile(const std::string& file) const
 
   const int num_nodes = Gmat_->getNumNodes();
   Point node_loc;
-  for (auto [loc, value] : Gmat_dok->values) {
-    const NodeIdx col = loc.first;
-    const NodeIdx row = loc.second;
-    if (col <= row) {
-      continue;  // ignore lower half and diagonal as matrix is symmetric
-    }
-    const double cond = value;  // get cond value
-    if (abs(cond) < 1e-15) {    // ignore if an empty cell
-      continue;
-    }
-    const string net_name = net_->getName();
-    if (col < num_nodes) {  // resistances
-      const double resistance = -1 / cond;
+  for (NodeIdx col = 0; col < Gmat_dok->num_cols; ++col) {
+    for (const auto& [row, value] : Gmat_dok->columns[col]) {
+      if (col <= row) {
+        continue;  // ignore lower half and diagonal as matrix is symmetric
+      }
+      const double cond = value;  // get cond value
+      if (abs(cond) < 1e-15) {    // ignore if an empty cell
+        continue;
+      }
+      const string net_name = net_->getName();
+      if (col < num_nodes) {  // resistances
+        const double resistance = -1 / cond;
 
-      const Node* node1 = Gmat_->getNode(col);
-      const Node* node2 = Gmat_->getNode(row);
-      node_loc = node1->getLoc();
-      const int x1 = node_loc.getX();
-      const int y1 = node_loc.getY();
-      const int l1 = node1->getLayerNum();
-      const string node1_name = net_name + "_" + to_string(x1) + "_"
-                                + to_string(y1) + "_" + to_string(l1);
+        const Node* node1 = Gmat_->getNode(col);
+        const Node* node2 = Gmat_->getNode(row);
+        node_loc = node1->getLoc();
+        const int x1 = node_loc.getX();
+        const int y1 = node_loc.getY();
+        const int l1 = node1->getLayerNum();
+        const string node1_name = net_name + "_" + to_string(x1) + "_"
+                                  + to_string(y1) + "_" + to_string(l1);
 
-      node_loc = node2->getLoc();
-      int x2 = node_loc.getX();
-      int y2 = node_loc.getY();
-      int l2 = node2->getLayerNum();
-      string node2_name = net_name + "_" + to_string(x2) + "_" + to_string(y2)
-                          + "_" + to_string(l2);
+        node_loc = node2->getLoc();
+        int x2 = node_loc.getX();
+        int y2 = node_loc.getY();
+        int l2 = node2->getLayerNum();
+        string node2_name = net_name + "_" + to_string(x2) + "_" + to_string(y2)
+                            + "_" + to_string(l2);
 
-      const string segment_name = "seg_" + to_string(resistance_number);
+        const string segment_name = "seg_" + to_string(resistance_number);
 
-      const double v1 = node1->getVoltage();
-      const double v2 = node2->getVoltage();
-      double seg_cur = (v1 - v2) / resistance;
-      em_report << segment_name << ", " << setprecision(3) << seg_cur << ", "
-                << node1_name << ", " << node2_name << endl;
-      resistance_number++;
+        const double v1 = node1->getVoltage();
+        const double v2 = node2->getVoltage();
+        double seg_cur = (v1 - v2) / resistance;
+        em_report << segment_name << ", " << setprecision(3) << seg_cur << ", "
+                  << node1_name << ", " << node2_name << endl;
+        resistance_number++;
+      }
     }
   }
 }
@@ -656,10 +885,8 @@ bool IRSolver::createSourcesFromPads()
 //! Function to create a J vector from the current map
 bool IRSolver::createJ()
 {  // take current_map as an input?
-  const int num_nodes = Gmat_->getNumNodes();
-  J_.resize(num_nodes, 0);
-
-  for (auto [inst, power] : getPower()) {
+  inst_power_ = getPower();
+  for (auto [inst, power] : inst_power_) {
     if (!inst->isPlaced()) {
       logger_->warn(utl::PSM,
                     71,
@@ -715,9 +942,9 @@ bool IRSolver::createJ()
       }
       // Distribute the power across all nodes within the bounding box
       for (auto node_J : nodes_J) {
-        node_J->addCurrentSrc(power / num_nodes);
         node_J->addInstance(inst);
       }
+      inst_nodes_[inst].assign(nodes_J.begin(), nodes_J.end());
       // For normal instances we only attach the current source to one node
     } else {
       Node* node_J = Gmat_->getNode(x, y, bottom_layer_, true);
@@ -736,10 +963,38 @@ bool IRSolver::createJ()
                       y);
       }
       // Both these lines will change in the future for multiple power domains
-      node_J->addCurrentSrc(power);
       node_J->addInstance(inst);
+      inst_nodes_[inst] = {node_J};
     }
   }
+  setCurrents(inst_power_);
+  return true;
+}
+
+//! Function to set the node currents and the J vector from instance power
+/*
+ * Only the node entries of J are written, the source entries appended by
+ * addSources are kept.
+ */
+void IRSolver::setCurrents(const vector<pair<odb::dbInst*, float>>& power)
+{
+  const int num_nodes = Gmat_->getNumNodes();
+  for (int i = 0; i < num_nodes; ++i) {
+    Gmat_->getNode(i)->setCurrent(0);
+  }
+  for (auto [inst, inst_power] : power) {
+    const auto nodes_itr = inst_nodes_.find(inst);
+    if (nodes_itr == inst_nodes_.end()) {
+      continue;
+    }
+    const vector<Node*>& nodes = nodes_itr->second;
+    for (Node* node : nodes) {
+      node->addCurrentSrc(inst_power / nodes.size());
+    }
+  }
+  if (J_.empty()) {
+    J_.resize(num_nodes, 0);
+  }
   // Creating the J matrix
   for (int i = 0; i < num_nodes; ++i) {
     const Node* node_J = Gmat_->getNode(i);
@@ -750,7 +1005,22 @@ bool IRSolver::createJ()
     }
   }
   debugPrint(logger_, utl::PSM, "IR Solver", 1, "Created J vector");
-  return true;
+}
+
+//! Function to load the currents of an activity scenario into J
+/*
+     \param inst_power Power of the instances that differ from STA
+*/
+void IRSolver::setScenario(const map<odb::dbInst*, float>& inst_power)
+{
+  vector<pair<odb::dbInst*, float>> power = inst_power_;
+  for (auto& [inst, value] : power) {
+    const auto itr = inst_power.find(inst);
+    if (itr != inst_power.end()) {
+      value = itr->second;
+    }
+  }
+  setCurrents(power);
 }
 
 //! Function to find and store the upper and lower PDN layers and return a list
@@ -1799,62 +2069,62 @@ void IRSolver::writeSpiceFile(const std::string& file) const
   int voltage_number = 0;
   int current_number = 0;
 
-  for (const auto& [loc, cond] : Gmat->values) {
-    const NodeIdx col = loc.first;
-    const NodeIdx row = loc.second;
-    if (col <= row) {
-      continue;  // ignore lower half and diagonal as matrix is symmetric
-    }
-    if (abs(cond) < 1e-15) {  // ignore if an empty cell
-      continue;
-    }
+  for (NodeIdx col = 0; col < Gmat->num_cols; ++col) {
+    for (const auto& [row, cond] : Gmat->columns[col]) {
+      if (col <= row) {
+        continue;  // ignore lower half and diagonal as matrix is symmetric
+      }
+      if (abs(cond) < 1e-15) {  // ignore if an empty cell
+        continue;
+      }
 
-    const string net_name = net_->getName();
-    if (col < num_nodes) {  // resistances
-      const double resistance = -1 / cond;
-
-      const Node* node1 = Gmat_->getNode(col);
-      const Node* node2 = Gmat_->getNode(row);
-      const Point node_loc1 = node1->getLoc();
-      const int x1 = node_loc1.getX();
-      const int y1 = node_loc1.getY();
-      const int l1 = node1->getLayerNum();
-      const string node1_name = net_name + "_" + to_string(x1) + "_"
-                                + to_string(y1) + "_" + to_string(l1);
-
-      const Point node_loc2 = node2->getLoc();
-      const int x2 = node_loc2.getX();
-      const int y2 = node_loc2.getY();
-      const int l2 = node2->getLayerNum();
-      const string node2_name = net_name + "_" + to_string(x2) + "_"
-                                + to_string(y2) + "_" + to_string(l2);
-
-      const string resistance_name = "R" + to_string(resistance_number);
-      resistance_number++;
-
-      pdnsim_spice_file << resistance_name << " " << node1_name << " "
-                        << node2_name << " " << to_string(resistance) << endl;
-
-      const double current = node1->getCurrent();
-      const string current_name = "I" + to_string(current_number);
-      if (abs(current) > 1e-18) {
-        pdnsim_spice_file << current_name << " " << node1_name << " " << 0
-                          << " " << current << endl;
-        current_number++;
+      const string net_name = net_->getName();
+      if (col < num_nodes) {  // resistances
+        const double resistance = -1 / cond;
+
+        const Node* node1 = Gmat_->getNode(col);
+        const Node* node2 = Gmat_->getNode(row);
+        const Point node_loc1 = node1->getLoc();
+        const int x1 = node_loc1.getX();
+        const int y1 = node_loc1.getY();
+        const int l1 = node1->getLayerNum();
+        const string node1_name = net_name + "_" + to_string(x1) + "_"
+                                  + to_string(y1) + "_" + to_string(l1);
+
+        const Point node_loc2 = node2->getLoc();
+        const int x2 = node_loc2.getX();
+        const int y2 = node_loc2.getY();
+        const int l2 = node2->getLayerNum();
+        const string node2_name = net_name + "_" + to_string(x2) + "_"
+                                  + to_string(y2) + "_" + to_string(l2);
+
+        const string resistance_name = "R" + to_string(resistance_number);
+        resistance_number++;
+
+        pdnsim_spice_file << resistance_name << " " << node1_name << " "
+                          << node2_name << " " << to_string(resistance) << endl;
+
+        const double current = node1->getCurrent();
+        const string current_name = "I" + to_string(current_number);
+        if (abs(current) > 1e-18) {
+          pdnsim_spice_file << current_name << " " << node1_name << " " << 0
+                            << " " << current << endl;
+          current_number++;
+        }
+      } else {                                    // voltage
+        const Node* node1 = Gmat_->getNode(row);  // VDD location
+        const Point node_loc = node1->getLoc();
+        const double voltage_value = J[col];
+        const int x1 = node_loc.getX();
+        const int y1 = node_loc.getY();
+        const int l1 = node1->getLayerNum();
+        const string node1_name = net_name + "_" + to_string(x1) + "_"
+                                  + to_string(y1) + "_" + to_string(l1);
+        const string voltage_name = "V" + to_string(voltage_number);
+        voltage_number++;
+        pdnsim_spice_file << voltage_name << " " << node1_name << " 0 "
+                          << to_string(voltage_value) << endl;
       }
-    } else {                                    // voltage
-      const Node* node1 = Gmat_->getNode(row);  // VDD location
-      const Point node_loc = node1->getLoc();
-      const double voltage_value = J[col];
-      const int x1 = node_loc.getX();
-      const int y1 = node_loc.getY();
-      const int l1 = node1->getLayerNum();
-      const string node1_name = net_name + "_" + to_string(x1) + "_"
-                                + to_string(y1) + "_" + to_string(l1);
-      const string voltage_name = "V" + to_string(voltage_number);
-      voltage_number++;
-      pdnsim_spice_file << voltage_name << " " << node1_name << " 0 "
-                        << to_string(voltage_value) << endl;
     }
   }
 
@@ -1893,10 +2163,10 @@ bool IRSolver::build(const std::string& error_file, bool connectivity_only)
     res = addSources();
   }
   if (res && !connectivity_only) {
-    res = Gmat_->generateCSCMatrix();
+    res = Gmat_->generateCSCMatrix(solver_threads_);
   }
   if (res) {
-    res = Gmat_->generateACSCMatrix();
+    res = Gmat_->generateACSCMatrix(solver_threads_);
   }
   if (res) {
     connection_ = checkConnectivity(error_file, connectivity_only);
@@ -32,10 +32,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 
+#include <Eigen/Core>
+#include <map>
+#include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "gmat.h"
 #include "odb/db.h"
+#include "psm/pdnsim.h"
 #include "utl/Logger.h"
 
 namespace sta {
@@ -98,8 +104,22 @@ class IRSolver
   GMat* getGMat();
   //! Returns current map represented as a 1D vector
   const std::vector<double>& getJ() const;
+  //! Selects the linear solver used by solveIR
+  void setSolver(SolverType type, double tolerance, int threads);
   //! Function to solve for IR drop
+  /*
+   * G is factorized on the first call only, so later calls after
+   * setScenario solve the new right hand side against the same G.
+   */
   void solveIR();
+  //! Replaces the instance currents in J with the STA power overridden by
+  //! the given per instance power, keeping G and its factorization
+  void setScenario(const std::map<odb::dbInst*, float>& inst_power);
+  //! Seeds the iterative solver with the voltages of a previous solution;
+  //! nodes that did not exist then start at the supply voltage
+  void setInitialVoltages(const PDNSim::NodeVoltages& voltages);
+  //! Returns the solved voltage of every node
+  PDNSim::NodeVoltages getNodeVoltages() const;
   //! Function to get the power value from OpenSTA
   std::vector<std::pair<odb::dbInst*, float>> getPower();
 
@@ -141,6 +161,8 @@ class IRSolver
   void createDefaultSources();
   //! Function to create a J vector from the current map
   bool createJ();
+  //! Function to set the node currents and J from the power of instances
+  void setCurrents(const std::vector<std::pair<odb::dbInst*, float>>& power);
   //! Function to create a G matrix using the nodes
   bool createGmat(bool connection_only = false);
   //! Function to find and store the upper and lower PDN layers and return a
@@ -168,6 +190,16 @@ class IRSolver
   bool checkConnectivity(const std::string& error_file = "",
                          bool connection_only = false);
   bool checkValidR(double R) const;
+  //! Factorizes the full G matrix for the direct solver
+  void factorizeDirect();
+  //! Reduces G to its free nodes and builds the preconditioner for the
+  //! iterative solver; returns false if preconditioning fails
+  bool factorizeIterative();
+  //! Solves GV=J with the LU factors of G
+  void solveDirect(Eigen::VectorXd& x);
+  //! Solves GV=J by preconditioned conjugate gradients; returns false if
+  //! the iteration does not converge
+  bool solveIterative(Eigen::VectorXd& x);
 
   double getResistance(odb::dbTechLayer* layer) const;
 
@@ -237,9 +269,22 @@ class IRSolver
 
   bool connection_{false};
 
+  SolverType solver_type_{SolverType::AUTO};
+  double solver_tolerance_{1e-10};
+  int solver_threads_{1};
+
   sta::Corner* corner_;
   //! Current vector 1D
   std::vector<double> J_;
+  //! Power of each instance as reported by STA
+  std::vector<std::pair<odb::dbInst*, float>> inst_power_;
+  //! Nodes the current of each instance is spread over
+  std::map<odb::dbInst*, std::vector<Node*>, InstCompare> inst_nodes_;
+  //! Initial guess of the iterative solver for each node
+  std::vector<double> initial_voltages_;
+  //! Factorization of G kept between solves
+  struct Factorization;
+  std::unique_ptr<Factorization> factorization_;
   //! source locations and values
   std::vector<SourceData> sources_;
   //! Locations of the source in the G matrix
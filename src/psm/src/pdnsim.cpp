@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <tcl.h>
 
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -56,6 +57,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace psm {
 
+// Inserts the scenario name before the extension of an output file.
+static std::string scenarioFileName(const std::string& file,
+                                    const std::string& scenario)
+{
+  if (file.empty()) {
+    return file;
+  }
+  std::filesystem::path path(file);
+  const std::string ext = path.extension().string();
+  path.replace_filename(path.stem().string() + "_" + scenario + ext);
+  return path.string();
+}
+
 PDNSim::PDNSim() = default;
 
 PDNSim::~PDNSim() = default;
@@ -103,19 +117,21 @@ std::unique_ptr<IRSolver> PDNSim::getIRSolver(bool require_voltage)
 
   std::optional<float> voltage = getNetVoltage(net_, require_voltage);
 
-  return std::make_unique<IRSolver>(db_,
-                                    sta_,
-                                    resizer_,
-                                    logger_,
-                                    net_,
-                                    voltage,
-                                    vsrc_loc_,
-                                    require_voltage,
-                                    bump_pitch_x_,
-                                    bump_pitch_y_,
-                                    node_density_,
-                                    node_density_factor_,
-                                    corner_);
+  auto ir_solver = std::make_unique<IRSolver>(db_,
+                                              sta_,
+                                              resizer_,
+                                              logger_,
+                                              net_,
+                                              voltage,
+                                              vsrc_loc_,
+                                              require_voltage,
+                                              bump_pitch_x_,
+                                              bump_pitch_y_,
+                                              node_density_,
+                                              node_density_factor_,
+                                              corner_);
+  ir_solver->setSolver(solver_type_, solver_tolerance_, solver_threads_);
+  return ir_solver;
 }
 
 void PDNSim::writeSpice(const std::string& file)
@@ -158,7 +174,8 @@ void PDNSim::saveIRDrop(psm::IRSolver* ir_solver)
 void PDNSim::analyzePowerGrid(const std::string& voltage_file,
                               bool enable_em,
                               const std::string& em_file,
-                              const std::string& error_file)
+                              const std::string& error_file,
+                              bool incremental)
 {
   auto irsolve_h = getIRSolver(enable_em);
 
@@ -167,26 +184,75 @@ void PDNSim::analyzePowerGrid(const std::string& voltage_file,
     logger_->error(
         utl::PSM, 78, "IR drop setup failed.  Analysis can't proceed.");
   }
+  if (incremental) {
+    const auto last = last_voltages_.find(net_);
+    if (last != last_voltages_.end()) {
+      irsolve_h->setInitialVoltages(last->second);
+    }
+  }
   const std::string corner_name
       = corner_ != nullptr ? corner_->name() : "default";
+  if (power_scenarios_.empty()) {
+    irsolve_h->solveIR();
+    reportIRDrop(
+        irsolve_h.get(), corner_name, "", voltage_file, enable_em, em_file);
+    saveIRDrop(irsolve_h.get());
+  } else {
+    // Only J changes between scenarios, so G is factorized once and each
+    // scenario is a new right hand side.  The heatmap shows the worst one.
+    double worst_drop = -1;
+    for (const std::string& file : power_scenarios_) {
+      const std::string scenario = std::filesystem::path(file).stem().string();
+      irsolve_h->setScenario(readPowerScenario(file));
+      irsolve_h->solveIR();
+      const double drop
+          = reportIRDrop(irsolve_h.get(),
+                         corner_name,
+                         scenario,
+                         scenarioFileName(voltage_file, scenario),
+                         enable_em,
+                         scenarioFileName(em_file, scenario));
+      if (drop > worst_drop) {
+        worst_drop = drop;
+        saveIRDrop(irsolve_h.get());
+      }
+    }
+  }
+  if (incremental) {
+    last_voltages_[net_] = irsolve_h->getNodeVoltages();
+  }
+  min_resolution_ = irsolve_h->getMinimumResolution();
+  heatmap_->update();
+}
+
+double PDNSim::reportIRDrop(IRSolver* ir_solver,
+                            const std::string& corner_name,
+                            const std::string& scenario,
+                            const std::string& voltage_file,
+                            bool enable_em,
+                            const std::string& em_file)
+{
   const std::string metric_suffix
-      = fmt::format("__net:{}__corner:{}", net_->getName(), corner_name);
-  irsolve_h->solveIR();
+      = fmt::format("__net:{}__corner:{}", net_->getName(), corner_name)
+        + (scenario.empty() ? "" : fmt::format("__scenario:{}", scenario));
   logger_->report("########## IR report #################");
   logger_->report("Corner: {}", corner_name);
+  if (!scenario.empty()) {
+    logger_->report("Scenario: {}", scenario);
+  }
   logger_->report("Worstcase voltage: {:3.2e} V",
-                  irsolve_h->getWorstCaseVoltage());
+                  ir_solver->getWorstCaseVoltage());
   const double avg_drop
-      = std::abs(irsolve_h->getSupplyVoltageSrc() - irsolve_h->getAvgVoltage());
-  const double worst_drop = std::abs(irsolve_h->getSupplyVoltageSrc()
-                                     - irsolve_h->getWorstCaseVoltage());
+      = std::abs(ir_solver->getSupplyVoltageSrc() - ir_solver->getAvgVoltage());
+  const double worst_drop = std::abs(ir_solver->getSupplyVoltageSrc()
+                                     - ir_solver->getWorstCaseVoltage());
   logger_->report("Average IR drop  : {:3.2e} V", avg_drop);
   logger_->report("Worstcase IR drop: {:3.2e} V", worst_drop);
   logger_->report("######################################");
 
   logger_->metric(
       fmt::format("design_powergrid__voltage__worst{}", metric_suffix),
-      irsolve_h->getWorstCaseVoltage());
+      ir_solver->getWorstCaseVoltage());
   logger_->metric(
       fmt::format("design_powergrid__drop__average{}", metric_suffix),
       avg_drop);
@@ -194,31 +260,66 @@ void PDNSim::analyzePowerGrid(const std::string& voltage_file,
                   worst_drop);
 
   if (!voltage_file.empty()) {
-    irsolve_h->writeVoltageFile(voltage_file);
+    ir_solver->writeVoltageFile(voltage_file);
   }
 
   if (enable_em) {
     logger_->report("########## EM analysis ###############");
-    logger_->report("Maximum current: {:3.2e} A", irsolve_h->getMaxCurrent());
-    logger_->report("Average current: {:3.2e} A", irsolve_h->getAvgCurrent());
-    logger_->report("Number of resistors: {}", irsolve_h->getNumResistors());
+    logger_->report("Maximum current: {:3.2e} A", ir_solver->getMaxCurrent());
+    logger_->report("Average current: {:3.2e} A", ir_solver->getAvgCurrent());
+    logger_->report("Number of resistors: {}", ir_solver->getNumResistors());
     logger_->report("######################################");
 
     logger_->metric(
         fmt::format("design_powergrid__current__average{}", metric_suffix),
-        irsolve_h->getAvgCurrent());
+        ir_solver->getAvgCurrent());
     logger_->metric(
         fmt::format("design_powergrid__current__max{}", metric_suffix),
-        irsolve_h->getMaxCurrent());
+        ir_solver->getMaxCurrent());
 
     if (!em_file.empty()) {
-      irsolve_h->writeEMFile(em_file);
+      ir_solver->writeEMFile(em_file);
     }
   }
 
-  saveIRDrop(irsolve_h.get());
-  min_resolution_ = irsolve_h->getMinimumResolution();
-  heatmap_->update();
+  return worst_drop;
+}
+
+std::map<odb::dbInst*, float> PDNSim::readPowerScenario(
+    const std::string& file) const
+{
+  std::ifstream scenario_file(file);
+  if (!scenario_file) {
+    logger_->error(utl::PSM, 97, "Unable to open power scenario {}.", file);
+  }
+  odb::dbBlock* block = db_->getChip()->getBlock();
+  std::map<odb::dbInst*, float> inst_power;
+  std::string line;
+  int line_num = 0;
+  while (std::getline(scenario_file, line)) {
+    line_num++;
+    std::istringstream fields(line);
+    std::string name;
+    float power;
+    if (!(fields >> name) || name[0] == '#') {
+      continue;
+    }
+    if (!(fields >> power)) {
+      logger_->error(utl::PSM,
+                     98,
+                     "{}:{}: expected an instance name and its power.",
+                     file,
+                     line_num);
+    }
+    odb::dbInst* inst = block->findInst(name.c_str());
+    if (inst == nullptr) {
+      logger_->warn(
+          utl::PSM, 99, "{}:{}: instance {} not found.", file, line_num, name);
+      continue;
+    }
+    inst_power[inst] = power;
+  }
+  return inst_power;
 }
 
 bool PDNSim::checkConnectivity(const std::string& error_file)
@@ -103,10 +103,24 @@ set_net_voltage_cmd(odb::dbNet* net, float voltage)
 }
 
 void 
-analyze_power_grid_cmd(const char* voltage_file, bool enable_em, const char* em_file, const char* error_file)
+analyze_power_grid_cmd(const char* voltage_file, bool enable_em, const char* em_file, const char* error_file, bool incremental)
 {
   PDNSim* pdnsim = getPDNSim();
-  pdnsim->analyzePowerGrid(voltage_file, enable_em, em_file, error_file);
+  pdnsim->analyzePowerGrid(voltage_file, enable_em, em_file, error_file, incremental);
+}
+
+void
+clear_power_scenarios_cmd()
+{
+  PDNSim* pdnsim = getPDNSim();
+  pdnsim->clearPowerScenarios();
+}
+
+void
+add_power_scenario_cmd(const char* file)
+{
+  PDNSim* pdnsim = getPDNSim();
+  pdnsim->addPowerScenario(file);
 }
 
 bool
@@ -135,5 +149,17 @@ void set_corner(Corner* corner)
   pdnsim->setCorner(corner);
 }
 
+void set_solver_cmd(const char* type, double tolerance, int threads)
+{
+  PDNSim* pdnsim = getPDNSim();
+  psm::SolverType solver_type = psm::SolverType::AUTO;
+  if (strcmp(type, "direct") == 0) {
+    solver_type = psm::SolverType::DIRECT;
+  } else if (strcmp(type, "iterative") == 0) {
+    solver_type = psm::SolverType::ITERATIVE;
+  }
+  pdnsim->setSolver(solver_type, tolerance, threads);
+}
+
 %} // inline
 
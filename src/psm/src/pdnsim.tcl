@@ -45,11 +45,17 @@ sta::define_cmd_args "analyze_power_grid" {
   [-node_density val_node_density]
   [-node_density_factor val_node_density_factor]
   [-corner corner]
+  [-solver auto|direct|iterative]
+  [-solver_tolerance tolerance]
+  [-threads count]
+  [-scenarios scenario_files]
+  [-incremental]
   }
 
 proc analyze_power_grid { args } {
   sta::parse_key_args "analyze_power_grid" args \
-    keys {-vsrc -outfile -error_file -em_outfile -net -dx -dy -node_density -node_density_factor -corner} flags {-enable_em}
+    keys {-vsrc -outfile -error_file -em_outfile -net -dx -dy -node_density -node_density_factor -corner \
+          -solver -solver_tolerance -threads -scenarios} flags {-enable_em -incremental}
   if { [info exists keys(-vsrc)] } {
     psm::import_vsrc_cfg_cmd $keys(-vsrc)
   }
@@ -81,6 +87,32 @@ proc analyze_power_grid { args } {
     set val_node_density $keys(-node_density_factor)
     psm::set_node_density_factor $val_node_density
   }
+  set solver "auto"
+  if { [info exists keys(-solver)] } {
+    set solver $keys(-solver)
+    if { [lsearch -exact {auto direct iterative} $solver] == -1 } {
+      utl::error PSM 96 "-solver must be auto, direct or iterative."
+    }
+  }
+  set solver_tolerance 1e-10
+  if { [info exists keys(-solver_tolerance)] } {
+    set solver_tolerance $keys(-solver_tolerance)
+    sta::check_positive_float "-solver_tolerance" $solver_tolerance
+  }
+  set threads [ord::thread_count]
+  if { [info exists keys(-threads)] } {
+    set threads $keys(-threads)
+    sta::check_positive_integer "-threads" $threads
+  }
+  psm::set_solver_cmd $solver $solver_tolerance $threads
+
+  psm::clear_power_scenarios_cmd
+  if { [info exists keys(-scenarios)] } {
+    foreach scenario_file $keys(-scenarios) {
+      psm::add_power_scenario_cmd $scenario_file
+    }
+  }
+
   set voltage_file ""
   if { [info exists keys(-outfile)] } {
     set voltage_file $keys(-outfile)
@@ -98,7 +130,8 @@ proc analyze_power_grid { args } {
     }
   }
   if { [ord::db_has_rows] } {
-    psm::analyze_power_grid_cmd $voltage_file $enable_em $em_file $error_file
+    set incremental [info exists flags(-incremental)]
+    psm::analyze_power_grid_cmd $voltage_file $enable_em $em_file $error_file $incremental
   } else {
     utl::error PSM 56 "No rows defined in design. Floorplan not defined. Use initialize_floorplan to add rows."
   }
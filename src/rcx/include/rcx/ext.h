@@ -117,9 +117,11 @@ class Ext
     int context_depth = 5;
     int cc_model = 10;
     bool lef_res = false;
+    bool incremental = false;
   };
 
   void extract(ExtractOptions options);
+  void set_num_threads(int threads);
 
   void define_process_corner(int ext_model_index, const std::string& name);
   void define_derived_corner(const std::string& name,
@@ -136,6 +138,7 @@ class Ext
   {
     const char* nets = nullptr;
     int net_id = 0;
+    bool incremental = false;
     const char* ext_corner_name = nullptr;
     const int corner = -1;
     const int debug = 0;
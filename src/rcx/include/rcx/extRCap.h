@@ -32,7 +32,9 @@
 
 #pragma once
 
+#include <filesystem>
 #include <map>
+#include <vector>
 
 #include "db.h"
 #include "dbExtControl.h"
@@ -587,6 +589,12 @@ class extRCModel
 
   void setRuleFileName(char* name) { _ruleFileName = name; }
   char* getRuleFileName() { return _ruleFileName; }
+  // True when this model was read from the unchanged file `name` with the
+  // same corner selection and db unit scaling.
+  bool isLoadedFrom(const char* name,
+                    uint cornerCnt,
+                    const uint* cornerTable,
+                    double dbFactor) const;
   uint getMaxCnt(int met)
   {
     return _modelTable[_tmpDataRate]->_capOverUnder[met]->_metCnt;
@@ -626,6 +634,10 @@ class extRCModel
   AthPool<extDistRC>* _rcPoolPtr;
   extProcess* _process;
   char* _ruleFileName;
+  std::filesystem::file_time_type _ruleFileTime;
+  double _ruleDbFactor = 0.0;
+  std::vector<uint> _ruleCorners;
+  bool _ruleAllCorners = false;
   char* _wireFileName;
   char* _wireDirName;
   char* _topDir;
@@ -1238,6 +1250,16 @@ class extCorner
   extCorner* _extCornerPtr;
 };
 
+// Non-via wire shape decoded once for the band sweep of couplingFlow.
+struct extWireShape
+{
+  odb::Rect rect;
+  odb::dbTechLayer* layer;
+  uint id;       // net id of a wire, sbox id of a special wire
+  uint shapeId;  // 0 for special wires
+  bool plane;    // added to the GS planes in both directions
+};
+
 class extMain
 {
  public:
@@ -1473,6 +1495,23 @@ class extMain
                        double ccThres,
                        int contextDepth,
                        const char* extRules);
+  uint makeBlockRCsegs(std::vector<odb::dbNet*>& inets,
+                       uint cc_up,
+                       uint ccFlag,
+                       double resBound,
+                       bool mergeViaRes,
+                       double ccThres,
+                       int contextDepth,
+                       const char* extRules);
+  // Re-extracts only the nets whose wires changed since the last
+  // extraction; their coupling neighbours are recorded for write_spef.
+  uint makeIncrementalRCsegs(uint cc_up,
+                             uint ccFlag,
+                             double resBound,
+                             bool mergeViaRes,
+                             double ccThres,
+                             int contextDepth,
+                             const char* extRules);
 
   uint getShortSrcJid(uint jid);
   void make1stRSeg(odb::dbNet* net,
@@ -1573,7 +1612,8 @@ class extMain
                  bool noBackSlash,
                  int corner,
                  const char* corner_name,
-                 bool parallel);
+                 bool parallel,
+                 bool incremental = false);
   uint writeNetSPEF(odb::dbNet* net, double resBound, uint debug);
   uint makeITermCapNode(uint id, odb::dbNet* net);
   uint makeBTermCapNode(uint id, odb::dbNet* net);
@@ -1668,6 +1708,13 @@ class extMain
 
   uint getNetBbox(odb::dbNet* net, odb::Rect* maxRect[2]);
 
+  void collectWireShapes();
+  uint addBandShapes(uint dir,
+                     const int* bb_ll,
+                     const int* bb_ur,
+                     uint pwrtype,
+                     uint sigtype);
+
   static odb::dbRSeg* getRseg(odb::dbNet* net, uint shapeId, Logger* logger);
 
   uint write_spef_nets(bool flatten, bool parallel);
@@ -2041,6 +2088,9 @@ class extMain
   int _remote;
   bool _extracted;
   bool _allNet;
+  // Nets touched by the last incremental extraction: the changed nets
+  // followed by their coupling neighbours.
+  std::vector<odb::dbNet*> _incrementalNets;
 
   bool _getBandWire;
   bool _printBandInfo;
@@ -2102,6 +2152,12 @@ class extMain
 
   odb::gs* _geomSeq;
 
+  // Shapes of all power nets then all signal nets, in block order, and per
+  // direction the indices of the shapes along it sorted by their low edge.
+  std::vector<extWireShape> _wireShapes;
+  uint _powerShapeCnt = 0;
+  std::vector<uint> _wireShapeOrder[2];
+
   AthPool<odb::SEQ>* _seqPool;
 
   Ath__array1D<odb::SEQ*>*** _dgContextArray;
@@ -2230,6 +2286,7 @@ class extMain
 
  public:
   bool _lef_res;
+  int _num_threads;  // threads reading the wires of the nets
   std::string _tmpLenStats;
   int _last_node_xy[2];
   bool _wireInfra;
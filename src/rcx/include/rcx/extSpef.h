@@ -463,6 +463,7 @@ class extSpef
   uint _minNetNode;
 
   bool _gzipFlag;
+  bool _outGzip;  // _outFP is a gzip pipe
   bool _stopAfterNameMap;
   float _upperCalibLimit;
   float _lowerCalibLimit;
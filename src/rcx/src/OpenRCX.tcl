@@ -61,6 +61,7 @@ sta::define_cmd_args "extract_parasitics" {
     [-cc_model track]
     [-context_depth depth]
     [-no_merge_via_res]
+    [-incremental]
 }
 
 proc extract_parasitics { args } {
@@ -72,7 +73,7 @@ proc extract_parasitics { args } {
         -debug_net_id
         -context_depth
         -cc_model } \
-      flags { -lef_res }
+      flags { -lef_res -no_merge_via_res -incremental }
 
   set ext_model_file ""
   if { [info exists keys(-ext_model_file)] } {
@@ -99,6 +100,7 @@ proc extract_parasitics { args } {
 
   set lef_res [info exists flags(-lef_res)]
   set no_merge_via_res [info exists flags(-no_merge_via_res)]
+  set incremental [info exists flags(-incremental)]
 
   set cc_model 10
   if { [info exists keys(-cc_model)] } {
@@ -116,20 +118,22 @@ proc extract_parasitics { args } {
     set debug_net_id $keys(-debug_net_id)
   }
 
+  rcx::set_num_threads [ord::thread_count]
   rcx::extract $ext_model_file $corner_cnt $max_res \
       $coupling_threshold $cc_model \
-      $depth $debug_net_id $lef_res $no_merge_via_res
+      $depth $debug_net_id $lef_res $no_merge_via_res $incremental
 }
 
 sta::define_cmd_args "write_spef" { 
   [-net_id net_id]
-  [-nets nets] filename }
+  [-nets nets]
+  [-incremental] filename }
 
 proc write_spef { args } {
   sta::parse_key_args "write_spef" args keys \
       { -net_id 
         -nets } \
-      flags { -coordinates }
+      flags { -coordinates -incremental }
   sta::check_argc_eq1 "write_spef" $args
 
   set spef_file $args
@@ -145,8 +149,9 @@ proc write_spef { args } {
   }
 
   set coordinates [info exists flags(-coordinates)]
+  set incremental [info exists flags(-incremental)]
 
-  rcx::write_spef $spef_file $nets $net_id $coordinates
+  rcx::write_spef $spef_file $nets $net_id $coordinates $incremental
 }
 
 sta::define_cmd_args "adjust_rc" {
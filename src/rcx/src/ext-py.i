@@ -55,7 +55,10 @@ void extract(const char* ext_model_file,
              int context_depth,
              const char* debug_net_id,
              bool lef_res,
-             bool no_merge_via_res);
+             bool no_merge_via_res,
+             bool incremental);
+
+void set_num_threads(int threads);
 
 void write_spef(const char* file, const char* nets, int net_id,
                 bool write_coordinates);
@@ -30,6 +30,8 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 // POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
+
 #include "rcx/ext.h"
 
 #include "odb/wOrder.h"
@@ -238,19 +240,34 @@ void Ext::extract(ExtractOptions opts)
   _ext->set_debug_nets(opts.debug_net);
   _ext->_lef_res = opts.lef_res;
 
-  _ext->makeBlockRCsegs(opts.net,
-                        opts.cc_up,
-                        opts.cc_model,
-                        opts.max_res,
-                        !opts.no_merge_via_res,
-                        opts.coupling_threshold,
-                        opts.context_depth,
-                        opts.ext_model_file);
+  if (opts.incremental) {
+    _ext->makeIncrementalRCsegs(opts.cc_up,
+                                opts.cc_model,
+                                opts.max_res,
+                                !opts.no_merge_via_res,
+                                opts.coupling_threshold,
+                                opts.context_depth,
+                                opts.ext_model_file);
+  } else {
+    _ext->makeBlockRCsegs(opts.net,
+                          opts.cc_up,
+                          opts.cc_model,
+                          opts.max_res,
+                          !opts.no_merge_via_res,
+                          opts.coupling_threshold,
+                          opts.context_depth,
+                          opts.ext_model_file);
+  }
 
   logger_->info(
       RCX, 15, "Finished extracting {}.", _ext->getBlock()->getName().c_str());
 }
 
+void Ext::set_num_threads(int threads)
+{
+  _ext->_num_threads = std::max(threads, 1);
+}
+
 void Ext::adjust_rc(float res_factor, float cc_factor, float gndc_factor)
 {
   _ext->adjustRC(res_factor, cc_factor, gndc_factor);
@@ -301,7 +318,8 @@ void Ext::write_spef(const SpefOptions& opts)
                   opts.no_backslash,
                   opts.corner,
                   name,
-                  opts.parallel);
+                  opts.parallel,
+                  opts.incremental);
 
   logger_->info(RCX, 17, "Finished writing SPEF ...");
 }
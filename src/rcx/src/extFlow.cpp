@@ -30,6 +30,7 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 // POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -1141,33 +1142,134 @@ uint extMain::fill_gs4(int dir,
 
   const int gs_dir = dir;
 
-  uint pcnt = 0;
-  dbSet<dbNet> nets = _block->getNets();
-  dbSet<dbNet>::iterator net_itr;
+  uint cnt = 0;
+  for (const extWireShape& shape : _wireShapes) {
+    Rect r = shape.rect;
+    cnt += addShapeOnGS(
+        nullptr, 0, r, shape.plane, shape.layer, rotatedGs, !dir, gs_dir);
+  }
+  return cnt;
+}
 
-  for (net_itr = nets.begin(); net_itr != nets.end(); ++net_itr) {
-    dbNet* net = *net_itr;
+static int lowEdge(const Rect& r, uint dir)
+{
+  return dir == 0 ? r.xMin() : r.yMin();
+}
 
-    if (!((net->getSigType().isSupply()))) {
-      continue;
+// Decodes the wires of all nets once, instead of once per band and
+// direction. Nets are read in parallel; the per chunk results are joined
+// in block order so the sweep adds shapes in the same order as before.
+void extMain::collectWireShapes()
+{
+  dbSet<dbNet> nets = _block->getNets();
+  const std::vector<dbSetRange<dbNet>> ranges
+      = splitSet(nets, 4 * _num_threads);
+  std::vector<std::vector<extWireShape>> power(ranges.size());
+  std::vector<std::vector<extWireShape>> signal(ranges.size());
+
+#pragma omp parallel for num_threads(_num_threads) schedule(dynamic)
+  for (int ii = 0; ii < (int) ranges.size(); ii++) {
+    for (dbNet* net : ranges[ii]) {
+      if (net->getSigType().isSupply()) {
+        for (dbSWire* swire : net->getSWires()) {
+          for (dbSBox* s : swire->getWires()) {
+            if (s->isVia()) {
+              continue;
+            }
+            power[ii].push_back(
+                {s->getBox(), s->getTechLayer(), s->getId(), 0, true});
+          }
+        }
+        continue;
+      }
+      dbWire* wire = net->getWire();
+      if (wire == nullptr) {
+        continue;
+      }
+      const bool plane = net->getSigType() == dbSigType::ANALOG;
+      dbWireShapeItr shapes;
+      dbShape s;
+      for (shapes.begin(wire); shapes.next(s);) {
+        if (s.isVia()) {
+          continue;
+        }
+        signal[ii].push_back({s.getBox(),
+                              s.getTechLayer(),
+                              net->getId(),
+                              (uint) shapes.getShapeId(),
+                              plane});
+      }
     }
-
-    pcnt += addNetSboxesGs(net, rotatedGs, !dir, gs_dir);
   }
 
-  uint scnt = 0;
-
-  for (net_itr = nets.begin(); net_itr != nets.end(); ++net_itr) {
-    dbNet* net = *net_itr;
+  _wireShapes.clear();
+  for (const std::vector<extWireShape>& shapes : power) {
+    _wireShapes.insert(_wireShapes.end(), shapes.begin(), shapes.end());
+  }
+  _powerShapeCnt = _wireShapes.size();
+  for (const std::vector<extWireShape>& shapes : signal) {
+    _wireShapes.insert(_wireShapes.end(), shapes.begin(), shapes.end());
+  }
 
-    if ((net->getSigType().isSupply())) {
-      continue;
+  for (uint dir = 0; dir < 2; dir++) {
+    std::vector<uint>& order = _wireShapeOrder[dir];
+    order.clear();
+    for (uint ii = 0; ii < _wireShapes.size(); ii++) {
+      if (matchDir(dir, _wireShapes[ii].rect)) {
+        order.push_back(ii);
+      }
     }
+    std::stable_sort(order.begin(), order.end(), [&](uint a, uint b) {
+      return lowEdge(_wireShapes[a].rect, dir)
+             < lowEdge(_wireShapes[b].rect, dir);
+    });
+  }
+}
 
-    scnt += addNetShapesGs(net, rotatedGs, !dir, gs_dir);
+// Same as addPowerNets followed by addSignalNets, from the shapes gathered
+// by collectWireShapes: only the shapes starting in the band are visited.
+uint extMain::addBandShapes(uint dir,
+                            const int* bb_ll,
+                            const int* bb_ur,
+                            uint pwrtype,
+                            uint sigtype)
+{
+  const std::vector<uint>& order = _wireShapeOrder[dir];
+  auto below = [&](uint idx, int xy) {
+    return lowEdge(_wireShapes[idx].rect, dir) < xy;
+  };
+  auto lo = std::lower_bound(order.begin(), order.end(), bb_ll[dir], below);
+  auto hi = std::lower_bound(lo, order.end(), bb_ur[dir], below);
+  std::vector<uint> band(lo, hi);
+  std::sort(band.begin(), band.end());
+
+  for (uint idx : band) {
+    const extWireShape& shape = _wireShapes[idx];
+    const Rect& r = shape.rect;
+    const uint level = shape.layer->getRoutingLevel();
+    if (idx < _powerShapeCnt) {
+      _search->addBox(r.xMin(),
+                      r.yMin(),
+                      r.xMax(),
+                      r.yMax(),
+                      level,
+                      shape.id,
+                      0,
+                      pwrtype);
+    } else {
+      _search->addBox(r.xMin(),
+                      r.yMin(),
+                      r.xMax(),
+                      r.yMax(),
+                      level,
+                      shape.id,
+                      shape.shapeId,
+                      sigtype);
+    }
   }
+  _search->adjustOverlapMakerEnd();
 
-  return pcnt + scnt;
+  return band.size();
 }
 
 uint extMain::couplingFlow(Rect& extRect,
@@ -1235,6 +1337,8 @@ uint extMain::couplingFlow(Rect& extRect,
 
   _seqPool = m->_seqPool;
 
+  collectWireShapes();
+
   uint maxWidth = 0;
   uint totPowerWireCnt = powerWireCounter(maxWidth);
   uint totWireCnt = signalWireCounter(maxWidth);
@@ -1323,9 +1427,8 @@ uint extMain::couplingFlow(Rect& extRect,
       // add wires onto search such that    loX<=loX<=hiX
       hi_sdb[dir] = hiXY;
 
-      uint processWireCnt = 0;
-      processWireCnt += addPowerNets(dir, lo_sdb, hi_sdb, pwrtype);
-      processWireCnt += addSignalNets(dir, lo_sdb, hi_sdb, sigtype);
+      uint processWireCnt
+          = addBandShapes(dir, lo_sdb, hi_sdb, pwrtype, sigtype);
 
       uint extractedWireCnt = 0;
       int extractLimit = hiXY - ccDist * maxPitch;
@@ -1378,6 +1481,11 @@ uint extMain::couplingFlow(Rect& extRect,
   delete _geomSeq;
   _geomSeq = nullptr;
 
+  _wireShapes.clear();
+  _wireShapes.shrink_to_fit();
+  _wireShapeOrder[0].clear();
+  _wireShapeOrder[1].clear();
+
   for (uint jj = 0; jj < layerCnt; jj++) {
     delete[] limitArray[jj];
   }
@@ -30,6 +30,7 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 // POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -4064,9 +4065,46 @@ bool extRCModel::readRules(char* name,
       parser.parseNextLine();
     }
   }
+
+  std::error_code ec;
+  _ruleFileTime = std::filesystem::last_write_time(name, ec);
+  _ruleDbFactor = dbFactor;
+  _ruleCorners.clear();
+  _ruleAllCorners = (cornerCnt == 0);
+  if (cornerCnt > 0) {
+    _ruleCorners.assign(cornerTable, cornerTable + cornerCnt);
+  } else {
+    for (uint ii = 0; ii < _modelCnt; ii++) {
+      _ruleCorners.push_back(ii);
+    }
+  }
   return true;
 }
 
+bool extRCModel::isLoadedFrom(const char* name,
+                              uint cornerCnt,
+                              const uint* cornerTable,
+                              double dbFactor) const
+{
+  if (_ruleFileName == nullptr || strcmp(_ruleFileName, name) != 0) {
+    return false;
+  }
+  if (_ruleDbFactor != dbFactor) {
+    return false;
+  }
+  // Without a corner selection every model in the file is loaded.
+  if (cornerCnt == 0 ? !_ruleAllCorners
+                     : !std::equal(cornerTable,
+                                   cornerTable + cornerCnt,
+                                   _ruleCorners.begin(),
+                                   _ruleCorners.end())) {
+    return false;
+  }
+  std::error_code ec;
+  const auto time = std::filesystem::last_write_time(name, ec);
+  return !ec && time == _ruleFileTime;
+}
+
 double extRCModel::measureResistance(extMeasure* m,
                                      double ro,
                                      double top_widthR,
@@ -146,6 +146,7 @@ extSpef::extSpef(odb::dbTech* tech,
   _tmpCapId = 1;
 
   _gzipFlag = false;
+  _outGzip = false;
   _stopAfterNameMap = false;
   _stopBeforeDnets = false;
   _calib = false;
@@ -1461,9 +1462,13 @@ bool extSpef::setOutSpef(char* filename)
 
   strcpy(_outFile, filename);
 
-  if (_gzipFlag) {
+  // A .gz file name asks for compression as well as the gzip flag does.
+  const size_t len = strlen(filename);
+  const bool gzName = len > 3 && strcmp(filename + len - 3, ".gz") == 0;
+  _outGzip = _gzipFlag || gzName;
+  if (_outGzip) {
     char cmd[2048];
-    sprintf(cmd, "gzip -1 > %s.gz", filename);
+    sprintf(cmd, gzName ? "gzip -1 > %s" : "gzip -1 > %s.gz", filename);
     _outFP = popen(cmd, "w");
   } else {
     _outFP = fopen(filename, "w");
@@ -1473,6 +1478,9 @@ bool extSpef::setOutSpef(char* filename)
     fprintf(stderr, "Cannot open file %s with permissions \"w\"", filename);
     return false;
   }
+  // SPEF is written a few bytes per fprintf; a large buffer keeps that
+  // from turning into one write call per line.
+  setvbuf(_outFP, nullptr, _IOFBF, 1 << 22);
   return true;
 }
 
@@ -1482,7 +1490,7 @@ bool extSpef::closeOutFile()
     return false;
   }
 
-  if (_gzipFlag) {
+  if (_outGzip) {
     pclose(_outFP);
   } else {
     fclose(_outFP);
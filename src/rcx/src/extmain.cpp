@@ -173,6 +173,7 @@ extMain::extMain()
       _junct2iterm(nullptr)
 {
   _debug_net_id = 0;
+  _num_threads = 1;
   _previous_percent_extracted = 0;
 
   _modelTable = new Ath__array1D<extRCModel*>(8);
@@ -1666,9 +1666,6 @@ bool extMain::setCorners(const char* rulesFileName)
       dbFactor = dbunit * 0.001;
     }
 
-    extRCModel* m = new extRCModel("MINTYPMAX", logger_);
-    _modelTable->add(m);
-
     uint cornerTable[10];
     uint extDbCnt = 0;
 
@@ -1683,27 +1680,44 @@ bool extMain::setCorners(const char* rulesFileName)
       }
     }
 
-    logger_->info(
-        RCX, 435, "Reading extraction model file {} ...", rulesFileName);
-
-    FILE* rules_file = fopen(rulesFileName, "r");
-    if (rules_file == nullptr) {
-      logger_->error(
-          RCX, 468, "Can't open extraction model file {}", rulesFileName);
-    }
-    fclose(rules_file);
+    // Parsing the model file dominates short extraction runs; keep the
+    // parsed model while the file and corner selection are unchanged.
+    extRCModel* loaded = getRCmodel(0);
+    if (loaded != nullptr
+        && loaded->isLoadedFrom(
+            rulesFileName, extDbCnt, cornerTable, dbFactor)) {
+      logger_->info(
+          RCX, 501, "Reusing extraction model file {}", rulesFileName);
+    } else {
+      logger_->info(
+          RCX, 435, "Reading extraction model file {} ...", rulesFileName);
 
-    if (!(m->readRules((char*) rulesFileName,
-                       false,
-                       true,
-                       true,
-                       true,
-                       true,
-                       extDbCnt,
-                       cornerTable,
-                       dbFactor))) {
-      delete m;
-      return false;
+      FILE* rules_file = fopen(rulesFileName, "r");
+      if (rules_file == nullptr) {
+        logger_->error(
+            RCX, 468, "Can't open extraction model file {}", rulesFileName);
+      }
+      fclose(rules_file);
+
+      extRCModel* m = new extRCModel("MINTYPMAX", logger_);
+      if (!(m->readRules((char*) rulesFileName,
+                         false,
+                         true,
+                         true,
+                         true,
+                         true,
+                         extDbCnt,
+                         cornerTable,
+                         dbFactor))) {
+        delete m;
+        return false;
+      }
+      if (loaded == nullptr) {
+        _modelTable->add(m);
+      } else {
+        _modelTable->set(0, m);
+        delete loaded;
+      }
     }
 
     int modelCnt = getRCmodel(0)->getModelCnt();
@@ -1797,12 +1811,98 @@ uint extMain::makeBlockRCsegs(const char* netNames,
                               double ccThres,
                               int contextDepth,
                               const char* extRules)
+{
+  std::vector<dbNet*> inets;
+  ((dbBlock*) _block)->findSomeNet(netNames, inets);
+  return makeBlockRCsegs(inets,
+                         cc_up,
+                         ccFlag,
+                         resBound,
+                         mergeViaRes,
+                         ccThres,
+                         contextDepth,
+                         extRules);
+}
+
+uint extMain::makeIncrementalRCsegs(uint cc_up,
+                                    uint ccFlag,
+                                    double resBound,
+                                    bool mergeViaRes,
+                                    double ccThres,
+                                    int contextDepth,
+                                    const char* extRules)
+{
+  _incrementalNets.clear();
+
+  int numOfNet, numOfRSeg, numOfCapNode, numOfCCSeg;
+  _block->getExtCount(numOfNet, numOfRSeg, numOfCapNode, numOfCCSeg);
+  if (numOfRSeg == 0) {
+    logger_->info(
+        RCX, 498, "No previous extraction, extracting all nets instead.");
+    std::vector<dbNet*> all;
+    return makeBlockRCsegs(all,
+                           cc_up,
+                           ccFlag,
+                           resBound,
+                           mergeViaRes,
+                           ccThres,
+                           contextDepth,
+                           extRules);
+  }
+
+  std::vector<dbNet*> updated;
+  _block->getWireUpdatedNets(updated);
+  std::vector<dbNet*> changed;
+  for (dbNet* net : updated) {
+    const dbSigType type = net->getSigType();
+    if ((type != dbSigType::POWER) && (type != dbSigType::GROUND)) {
+      changed.push_back(net);
+    }
+  }
+  std::vector<dbNet*> halo;
+  _block->getCcHaloNets(changed, halo);
+
+  logger_->info(RCX,
+                499,
+                "Incremental extraction of {} changed nets with {} coupled "
+                "neighbours.",
+                changed.size(),
+                halo.size());
+  if (changed.empty()) {
+    return 0;
+  }
+
+  // A dbCCSeg is shared by both of its nets, so dropping the parasitics of
+  // the changed nets also drops their couplings on the neighbour side. The
+  // partial flow below then rebuilds them from the changed nets outward.
+  _block->destroyParasitics(changed);
+  const uint cnt = makeBlockRCsegs(changed,
+                                   cc_up,
+                                   ccFlag,
+                                   resBound,
+                                   mergeViaRes,
+                                   ccThres,
+                                   contextDepth,
+                                   extRules);
+
+  _incrementalNets = changed;
+  _incrementalNets.insert(_incrementalNets.end(), halo.begin(), halo.end());
+  return cnt;
+}
+
+uint extMain::makeBlockRCsegs(std::vector<dbNet*>& inets,
+                              uint cc_up,
+                              uint ccFlag,
+                              double resBound,
+                              bool mergeViaRes,
+                              double ccThres,
+                              int contextDepth,
+                              const char* extRules)
 {
   uint debugNetId = 0;
 
   _diagFlow = true;
 
-  std::vector<dbNet*> inets;
   if ((_prevControl->_ruleFileName.empty()) && (getRCmodel(0) == nullptr)
       && (extRules == nullptr)) {
     logger_->warn(RCX,
@@ -1836,7 +1936,7 @@ uint extMain::makeBlockRCsegs(const char* netNames,
   }
   _foreign = false;  // extract after read_spef
 
-  _allNet = !((dbBlock*) _block)->findSomeNet(netNames, inets);
+  _allNet = inets.empty();
 
   if (_ccContextDepth) {
     initContextArray();
@@ -2228,7 +2328,8 @@ uint extMain::writeSPEF(char* filename,
                         bool noBackSlash,
                         int corner,
                         const char* corner_name,
-                        bool parallel)
+                        bool parallel,
+                        bool incremental)
 {
   if (_block == nullptr) {
     logger_->info(
@@ -2253,15 +2354,18 @@ uint extMain::writeSPEF(char* filename,
         "Can't execute write_spef command. There's no extraction data.");
     return 0;
   }
+  if (incremental && _incrementalNets.empty()) {
+    logger_->info(
+        RCX, 500, "No incremental extraction to write, skipping write_spef.");
+    return 0;
+  }
   if (_extRun == 0) {
     getPrevControl();
     getExtractedCorners();
   }
   _spef->preserveFlag(_foreign);
 
-  if (gzFlag) {
-    _spef->setGzipFlag(gzFlag);
-  }
+  _spef->setGzipFlag(gzFlag);
 
   _spef->setDesign((char*) _block->getName().c_str());
 
@@ -2277,7 +2381,11 @@ uint extMain::writeSPEF(char* filename,
     _spef->_db_ext_corner = n;
 
     std::vector<dbNet*> inets;
-    ((dbBlock*) _block)->findSomeNet(netNames, inets);
+    if (incremental) {
+      inets = _incrementalNets;
+    } else {
+      ((dbBlock*) _block)->findSomeNet(netNames, inets);
+    }
     cnt = _spef->writeBlock(nodeCoord,
                             capUnit,
                             resUnit,
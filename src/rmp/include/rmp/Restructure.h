@@ -36,7 +36,9 @@
 #pragma once
 
 #include <functional>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "db_sta/dbSta.hh"
 #include "rsz/Resizer.hh"
@@ -100,6 +102,12 @@ class Restructure
   void deleteComponents();
   void getBlob(unsigned max_depth);
   void runABC();
+  std::vector<std::vector<odb::dbInst*>> findCones();
+  std::vector<std::set<odb::dbInst*>> makeJobs(
+      const std::vector<std::vector<odb::dbInst*>>& cones,
+      int max_jobs);
+  std::vector<bool> runAbcScripts(const std::vector<std::string>& scripts,
+                                  int max_procs);
   void postABC(float worst_slack);
   bool writeAbcScript(std::string file_name);
   void writeOptCommands(std::ofstream& script);
@@ -64,6 +64,8 @@ using utl::Logger;
 
 namespace rmp {
 
+class BlifParser;
+
 class Blif
 {
  public:
@@ -77,7 +79,10 @@ class Blif
   void addReplaceableInstance(odb::dbInst* inst);
   bool writeBlif(const char* file_name, bool write_arrival_requireds = false);
   bool readBlif(const char* file_name, odb::dbBlock* block);
+  // Replaces the instances to optimize with an already parsed netlist.
+  bool readBlif(const BlifParser& blif, odb::dbBlock* block);
   bool inspectBlif(const char* file_name, int& num_instances);
+  bool parseBlif(const char* file_name, BlifParser& blif);
   float getRequiredTime(sta::Pin* term, bool is_rise);
   float getArrivalTime(sta::Pin* term, bool is_rise);
   void addArrival(sta::Pin* pin, std::string netName);
@@ -93,6 +98,8 @@ class Blif
   std::string const1_cell_port_;
   std::map<std::string, std::pair<float, float>> requireds_;
   std::map<std::string, std::pair<float, float>> arrivals_;
+  // Makes the names of the nets and instances read back unique per Blif.
+  int id_;
   static int call_id_;
 };
 
@@ -40,8 +40,13 @@
 #include <time.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <numeric>
 #include <sstream>
 
 #include "base/abc/abc.h"
@@ -51,6 +56,7 @@
 #include "odb/db.h"
 #include "ord/OpenRoad.hh"
 #include "rmp/blif.h"
+#include "rmp/blifParser.h"
 #include "sta/Graph.hh"
 #include "sta/Liberty.hh"
 #include "sta/Network.hh"
@@ -63,6 +69,7 @@
 #include "sta/Search.hh"
 #include "sta/Sta.hh"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 using utl::RMP;
 using namespace abc;
@@ -155,8 +162,6 @@ void Restructure::getBlob(unsigned max_depth)
 
 void Restructure::runABC()
 {
-  input_blif_file_name_ = work_dir_name_ + std::string(block_->getConstName())
-                          + "_crit_path.blif";
   std::vector<std::string> files_to_remove;
 
   debugPrint(logger_,
@@ -166,16 +171,8 @@ void Restructure::runABC()
              "Constants before remap {}",
              countConsts(block_));
 
-  Blif blif_(logger_, open_sta_, locell_, loport_, hicell_, hiport_);
-  blif_.setReplaceableInstances(path_insts_);
-  blif_.writeBlif(input_blif_file_name_.c_str(), !is_area_mode_);
-  debugPrint(
-      logger_, RMP, "remap", 1, "Writing blif file {}", input_blif_file_name_);
-  files_to_remove.emplace_back(input_blif_file_name_);
-
   // abc optimization
   std::vector<Mode> modes;
-  std::vector<pid_t> child_proc;
 
   if (is_area_mode_) {
     // Area Mode
@@ -185,103 +182,146 @@ void Restructure::runABC()
     modes = {Mode::DELAY_1, Mode::DELAY_2, Mode::DELAY_3, Mode::DELAY_4};
   }
 
-  child_proc.resize(modes.size(), 0);
-
-  std::string best_blif;
-  int best_inst_count = std::numeric_limits<int>::max();
-  float best_delay_gain = std::numeric_limits<float>::max();
-
-  debugPrint(
-      logger_, RMP, "remap", 1, "Running ABC with {} modes.", modes.size());
-
-  for (size_t curr_mode_idx = 0; curr_mode_idx < modes.size();
-       curr_mode_idx++) {
-    output_blif_file_name_
-        = work_dir_name_ + std::string(block_->getConstName())
-          + std::to_string(curr_mode_idx) + "_crit_path_out.blif";
-
-    opt_mode_ = modes[curr_mode_idx];
-
-    const std::string abc_script_file
-        = work_dir_name_ + std::to_string(curr_mode_idx) + "ord_abc_script.tcl";
-    if (logfile_ == "")
-      logfile_ = work_dir_name_ + "abc.log";
-
+  // Independent cones are bundled into one job per thread.  Every job is
+  // run through ABC once per mode.
+  const int num_threads = utl::ThreadPool::global()->getThreadCount();
+  const std::vector<std::vector<odb::dbInst*>> cones = findCones();
+  std::vector<std::set<odb::dbInst*>> jobs = makeJobs(cones, num_threads);
+  debugPrint(logger_,
+             RMP,
+             "remap",
+             1,
+             "Restructuring {} independent cones in {} jobs.",
+             cones.size(),
+             jobs.size());
+
+  const std::string block_name = block_->getConstName();
+  auto output_blif_name = [&](int job, int mode) {
+    return work_dir_name_ + block_name + std::to_string(job) + "_"
+           + std::to_string(mode) + "_crit_path_out.blif";
+  };
+  if (logfile_ == "")
+    logfile_ = work_dir_name_ + "abc.log";
+
+  std::vector<std::unique_ptr<Blif>> blifs;
+  std::vector<std::string> scripts;
+  for (int job = 0; job < jobs.size(); job++) {
+    input_blif_file_name_ = work_dir_name_ + block_name + std::to_string(job)
+                            + "_crit_path.blif";
+
+    auto blif = std::make_unique<Blif>(
+        logger_, open_sta_, locell_, loport_, hicell_, hiport_);
+    blif->setReplaceableInstances(jobs[job]);
+    blif->writeBlif(input_blif_file_name_.c_str(), !is_area_mode_);
     debugPrint(logger_,
                RMP,
                "remap",
                1,
-               "Writing ABC script file {}.",
-               abc_script_file);
-
-    if (writeAbcScript(abc_script_file)) {
-      // call linked abc
-      Abc_Start();
-      Abc_Frame_t* abc_frame = Abc_FrameGetGlobalFrame();
-      const std::string command = "source " + abc_script_file;
-      child_proc[curr_mode_idx]
-          = Cmd_CommandExecute(abc_frame, command.c_str());
-      if (child_proc[curr_mode_idx]) {
-        logger_->error(RMP, 26, "Error executing ABC command {}.", command);
-        return;
+               "Writing blif file {}",
+               input_blif_file_name_);
+    files_to_remove.emplace_back(input_blif_file_name_);
+    blifs.push_back(std::move(blif));
+
+    for (size_t curr_mode_idx = 0; curr_mode_idx < modes.size();
+         curr_mode_idx++) {
+      output_blif_file_name_ = output_blif_name(job, curr_mode_idx);
+
+      opt_mode_ = modes[curr_mode_idx];
+
+      const std::string abc_script_file
+          = work_dir_name_ + std::to_string(job) + "_"
+            + std::to_string(curr_mode_idx) + "ord_abc_script.tcl";
+
+      debugPrint(logger_,
+                 RMP,
+                 "remap",
+                 1,
+                 "Writing ABC script file {}.",
+                 abc_script_file);
+
+      if (writeAbcScript(abc_script_file)) {
+        scripts.push_back(abc_script_file);
+        files_to_remove.emplace_back(abc_script_file);
+      } else {
+        scripts.emplace_back();
       }
-      Abc_Stop();
-      // exit linked abc
-      files_to_remove.emplace_back(abc_script_file);
     }
-  }  // end modes
+  }
 
-  // Inspect ABC results to choose blif with least instance count
-  for (int curr_mode_idx = 0; curr_mode_idx < modes.size(); curr_mode_idx++) {
-    // Skip failed ABC runs
-    if (child_proc[curr_mode_idx] != 0) {
-      continue;
-    }
+  debugPrint(logger_,
+             RMP,
+             "remap",
+             1,
+             "Running ABC with {} modes on {} jobs.",
+             modes.size(),
+             jobs.size());
+
+  const std::vector<bool> succeeded = runAbcScripts(scripts, num_threads);
+
+  int num_read = 0;
+  for (int job = 0; job < jobs.size(); job++) {
+    std::unique_ptr<BlifParser> best_blif;
+    std::string best_blif_name;
+    int best_inst_count = std::numeric_limits<int>::max();
+
+    // Inspect ABC results to choose blif with least instance count
+    for (int curr_mode_idx = 0; curr_mode_idx < modes.size();
+         curr_mode_idx++) {
+      // Skip failed ABC runs
+      if (!succeeded[job * modes.size() + curr_mode_idx]) {
+        continue;
+      }
 
-    output_blif_file_name_
-        = work_dir_name_ + std::string(block_->getConstName())
-          + std::to_string(curr_mode_idx) + "_crit_path_out.blif";
-    const std::string abc_log_name = logfile_ + std::to_string(curr_mode_idx);
-
-    int level_gain = 0;
-    float delay = std::numeric_limits<float>::max();
-    int num_instances = 0;
-    bool success = readAbcLog(abc_log_name, level_gain, delay);
-    if (success) {
-      success
-          = blif_.inspectBlif(output_blif_file_name_.c_str(), num_instances);
-      logger_->report(
-          "Optimized to {} instances in iteration {} with max path depth "
-          "decrease of {}, delay of {}.",
-          num_instances,
-          curr_mode_idx,
-          level_gain,
-          delay);
+      output_blif_file_name_ = output_blif_name(job, curr_mode_idx);
+      const std::string abc_log_name = logfile_ + std::to_string(job) + "_"
+                                       + std::to_string(curr_mode_idx);
 
+      int level_gain = 0;
+      float delay = std::numeric_limits<float>::max();
+      auto blif = std::make_unique<BlifParser>();
+      bool success = readAbcLog(abc_log_name, level_gain, delay);
       if (success) {
-        if (is_area_mode_) {
-          if (num_instances < best_inst_count) {
-            best_inst_count = num_instances;
-            best_blif = output_blif_file_name_;
-          }
-        } else {
-          // Using only DELAY_4 for delay based gain since other modes not
-          // showing good gains
-          if (modes[curr_mode_idx] == Mode::DELAY_4) {
-            best_delay_gain = delay;
-            best_blif = output_blif_file_name_;
+        success = blifs[job]->parseBlif(output_blif_file_name_.c_str(), *blif);
+        const int num_instances = blif->getGates().size();
+        logger_->report(
+            "Optimized to {} instances in iteration {} with max path depth "
+            "decrease of {}, delay of {}.",
+            num_instances,
+            curr_mode_idx,
+            level_gain,
+            delay);
+
+        if (success) {
+          if (is_area_mode_) {
+            if (num_instances < best_inst_count) {
+              best_inst_count = num_instances;
+              best_blif = std::move(blif);
+              best_blif_name = output_blif_file_name_;
+            }
+          } else {
+            // Using only DELAY_4 for delay based gain since other modes not
+            // showing good gains
+            if (modes[curr_mode_idx] == Mode::DELAY_4
+                && delay < std::numeric_limits<float>::max()) {
+              best_blif = std::move(blif);
+              best_blif_name = output_blif_file_name_;
+            }
           }
         }
       }
+      files_to_remove.emplace_back(output_blif_file_name_);
+    }
+
+    if (best_blif) {
+      // read back netlist
+      debugPrint(
+          logger_, RMP, "remap", 1, "Reading blif file {}.", best_blif_name);
+      blifs[job]->readBlif(*best_blif, block_);
+      num_read++;
     }
-    files_to_remove.emplace_back(output_blif_file_name_);
   }
 
-  if (best_inst_count < std::numeric_limits<int>::max()
-      || best_delay_gain < std::numeric_limits<float>::max()) {
-    // read back netlist
-    debugPrint(logger_, RMP, "remap", 1, "Reading blif file {}.", best_blif);
-    blif_.readBlif(best_blif.c_str(), block_);
+  if (num_read > 0) {
     debugPrint(logger_,
                utl::RMP,
                "remap",
@@ -299,6 +339,171 @@ void Restructure::runABC()
   }
 }
 
+// Split the extracted logic into cones.  A net driven from inside the
+// logic keeps its driver and loads in the same cone, so cones only share
+// nets driven from outside and can be restructured independently.
+std::vector<std::vector<odb::dbInst*>> Restructure::findCones()
+{
+  std::vector<odb::dbInst*> insts(path_insts_.begin(), path_insts_.end());
+  std::sort(insts.begin(), insts.end(), [](odb::dbInst* a, odb::dbInst* b) {
+    return a->getId() < b->getId();
+  });
+  std::map<odb::dbInst*, int> inst_index;
+  for (int i = 0; i < insts.size(); i++) {
+    inst_index[insts[i]] = i;
+  }
+
+  // Union-find over the instances
+  std::vector<int> parent(insts.size());
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find = [&parent](int i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+
+  for (int i = 0; i < insts.size(); i++) {
+    for (odb::dbITerm* iterm : insts[i]->getITerms()) {
+      odb::dbNet* net = iterm->getNet();
+      if (!net || net->getSigType().isSupply()
+          || iterm->getIoType() == odb::dbIoType::INPUT) {
+        continue;
+      }
+      for (odb::dbITerm* load : net->getITerms()) {
+        auto it = inst_index.find(load->getInst());
+        if (it != inst_index.end()) {
+          parent[find(it->second)] = find(i);
+        }
+      }
+    }
+  }
+
+  std::vector<std::vector<odb::dbInst*>> cones;
+  std::map<int, int> cone_index;
+  for (int i = 0; i < insts.size(); i++) {
+    auto [it, inserted] = cone_index.emplace(find(i), cones.size());
+    if (inserted) {
+      cones.emplace_back();
+    }
+    cones[it->second].push_back(insts[i]);
+  }
+  return cones;
+}
+
+// Bundle the cones into at most max_jobs jobs of about the same size.
+std::vector<std::set<odb::dbInst*>> Restructure::makeJobs(
+    const std::vector<std::vector<odb::dbInst*>>& cones,
+    int max_jobs)
+{
+  std::vector<int> order(cones.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&cones](int a, int b) {
+    return cones[a].size() > cones[b].size();
+  });
+
+  const int num_jobs = std::min<int>(std::max(max_jobs, 1), cones.size());
+  std::vector<std::set<odb::dbInst*>> jobs(num_jobs);
+  for (int cone : order) {
+    // Largest first into the smallest job
+    auto job = std::min_element(
+        jobs.begin(), jobs.end(), [](const auto& a, const auto& b) {
+          return a.size() < b.size();
+        });
+    job->insert(cones[cone].begin(), cones[cone].end());
+  }
+  return jobs;
+}
+
+// Run the ABC scripts, returning which ones succeeded.  ABC keeps its
+// state in a global frame so concurrent runs each get their own child
+// process; with one thread they are run in this process.
+std::vector<bool> Restructure::runAbcScripts(
+    const std::vector<std::string>& scripts,
+    int max_procs)
+{
+  std::vector<bool> succeeded(scripts.size(), false);
+
+  auto run_script = [](const std::string& script) {
+    // call linked abc
+    Abc_Start();
+    Abc_Frame_t* abc_frame = Abc_FrameGetGlobalFrame();
+    const std::string command = "source " + script;
+    const int status = Cmd_CommandExecute(abc_frame, command.c_str());
+    Abc_Stop();
+    // exit linked abc
+    return status;
+  };
+
+  if (max_procs <= 1) {
+    for (size_t i = 0; i < scripts.size(); i++) {
+      if (scripts[i].empty()) {
+        continue;
+      }
+      if (run_script(scripts[i])) {
+        logger_->error(
+            RMP, 26, "Error executing ABC command source {}.", scripts[i]);
+      }
+      succeeded[i] = true;
+    }
+    return succeeded;
+  }
+
+  // Don't let the children repeat buffered output; this also drains the
+  // async log writer so nothing is pending in its queue at the fork.
+  logger_->flush();
+  std::fflush(nullptr);
+
+  std::map<pid_t, size_t> running;
+  auto wait_one = [&]() {
+    auto it = running.begin();
+    int status = 0;
+    waitpid(it->first, &status, 0);
+    const size_t i = it->second;
+    running.erase(it);
+    succeeded[i] = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    if (!succeeded[i]) {
+      logger_->warn(
+          RMP, 37, "Error executing ABC command source {}.", scripts[i]);
+    }
+  };
+
+  for (size_t i = 0; i < scripts.size(); i++) {
+    if (scripts[i].empty()) {
+      continue;
+    }
+    while (running.size() >= static_cast<size_t>(max_procs)) {
+      wait_one();
+    }
+    // Forking while the thread pool and the async log writer run is safe
+    // here because the child only runs ABC and then leaves with _exit:
+    // - only the forking thread exists in the child, and the child never
+    //   touches the pool, the logger or any lock they may hold;
+    // - ABC only uses its own global frame, its files, malloc and stdio,
+    //   which glibc resets in the child with its fork handlers;
+    // - _exit skips the destructors and atexit handlers of the parent's
+    //   objects (the pool, the log writer), so none of them run twice.
+    const pid_t pid = fork();
+    if (pid == 0) {
+      _exit(run_script(scripts[i]) ? 1 : 0);
+    }
+    if (pid < 0) {
+      // Couldn't fork so run it here once the children are done
+      while (!running.empty()) {
+        wait_one();
+      }
+      succeeded[i] = run_script(scripts[i]) == 0;
+      continue;
+    }
+    running[pid] = i;
+  }
+  while (!running.empty()) {
+    wait_one();
+  }
+  return succeeded;
+}
+
 void Restructure::postABC(float worst_slack)
 {
   // Leave the parasitics up to date.
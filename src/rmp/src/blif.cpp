@@ -77,7 +77,9 @@ Blif::Blif(Logger* logger,
 {
   logger_ = logger;
   open_sta_ = sta;
-  call_id_++;
+  // Each Blif takes its own id when it is made, since several can be
+  // created before any of them is read back.
+  id_ = ++call_id_;
 }
 
 void Blif::setReplaceableInstances(std::set<odb::dbInst*>& insts)
@@ -374,7 +376,7 @@ void preprocessString(std::string& s)
   }
 }
 
-bool Blif::inspectBlif(const char* file_name, int& numInstances)
+bool Blif::parseBlif(const char* file_name, BlifParser& blif)
 {
   std::ifstream f(file_name);
   if (f.bad()) {
@@ -388,9 +390,14 @@ bool Blif::inspectBlif(const char* file_name, int& numInstances)
   // Remove Comment Lines from Blif
   preprocessString(fileString);
 
+  return blif.parse(fileString);
+}
+
+bool Blif::inspectBlif(const char* file_name, int& numInstances)
+{
   BlifParser blif;
 
-  bool isValid = blif.parse(fileString);
+  bool isValid = parseBlif(file_name, blif);
 
   if (isValid)
     numInstances = blif.getGates().size();
@@ -422,6 +429,11 @@ bool Blif::readBlif(const char* file_name, odb::dbBlock* block)
     return false;
   }
 
+  return readBlif(blif, block);
+}
+
+bool Blif::readBlif(const BlifParser& blif, odb::dbBlock* block)
+{
   // Remove and disconnect old instances
   logger_->info(RMP,
                 5,
@@ -451,7 +463,7 @@ bool Blif::readBlif(const char* file_name, odb::dbBlock* block)
   }
 
   // Create and connect new instances
-  auto gates = blif.getGates();
+  const auto& gates = blif.getGates();
   logger_->info(RMP, 7, "Inserting {} new instances.", gates.size());
   std::map<std::string, int> instIds;
 
@@ -480,8 +492,10 @@ bool Blif::readBlif(const char* file_name, odb::dbBlock* block)
       odb::dbNet* net = block->findNet(constNetName.c_str());
       if (net == NULL) {
         std::string net_name_modified
-            = std::string("or_") + std::to_string(call_id_) + constNetName;
-        net = odb::dbNet::create(block, net_name_modified.c_str());
+            = std::string("or_") + std::to_string(id_) + constNetName;
+        net = block->findNet(net_name_modified.c_str());
+        if (!net)
+          net = odb::dbNet::create(block, net_name_modified.c_str());
       }
 
       // Add tie cells
@@ -491,7 +505,7 @@ bool Blif::readBlif(const char* file_name, odb::dbBlock* block)
           = (masterName == "_const0_") ? const0_cell_port_ : const1_cell_port_;
       instIds[constMaster]
           = (instIds[constMaster]) ? instIds[constMaster] + 1 : 1;
-      std::string instName = constMaster + "_" + std::to_string(call_id_)
+      std::string instName = constMaster + "_" + std::to_string(id_)
                              + std::to_string(instIds[constMaster]);
       for (auto&& lib : block->getDb()->getLibs()) {
         master = lib->findMaster(constMaster.c_str());
@@ -502,7 +516,7 @@ bool Blif::readBlif(const char* file_name, odb::dbBlock* block)
       if (master != NULL) {
         while (block->findInst(instName.c_str())) {
           instIds[constMaster]++;
-          instName = constMaster + "_" + std::to_string(call_id_)
+          instName = constMaster + "_" + std::to_string(id_)
                      + std::to_string(instIds[constMaster]);
         }
         auto newInst = odb::dbInst::create(block, master, instName.c_str());
@@ -522,11 +536,11 @@ bool Blif::readBlif(const char* file_name, odb::dbBlock* block)
     }
 
     instIds[masterName] = (instIds[masterName]) ? instIds[masterName] + 1 : 1;
-    std::string instName = masterName + "_" + std::to_string(call_id_) + "_"
+    std::string instName = masterName + "_" + std::to_string(id_) + "_"
                            + std::to_string(instIds[masterName]);
     while (block->findInst(instName.c_str())) {
       instIds[masterName]++;
-      instName = masterName + "_" + std::to_string(call_id_) + "_"
+      instName = masterName + "_" + std::to_string(id_) + "_"
                  + std::to_string(instIds[masterName]);
     }
 
@@ -580,7 +594,7 @@ bool Blif::readBlif(const char* file_name, odb::dbBlock* block)
       odb::dbNet* net = block->findNet(netName.c_str());
       if (net == NULL) {
         std::string net_name_modified
-            = std::string("or_") + std::to_string(call_id_) + netName;
+            = std::string("or_") + std::to_string(id_) + netName;
         net = block->findNet(net_name_modified.c_str());
         if (!net)
           net = odb::dbNet::create(block, net_name_modified.c_str());
@@ -36,8 +36,10 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 
 #include "utl/Logger.h"
 #include "db_sta/dbSta.hh"
@@ -123,6 +125,7 @@ using InstanceTuple = std::tuple<Instance *, Instance *>;
 
 class AbstractSteinerRenderer;
 class SteinerTree;
+struct SteinerTreePlan;
 using SteinerPt =  int;
 
 class BufferedNet;
@@ -143,6 +146,19 @@ public:
 };
 
 typedef Map<LibertyCell*, float> CellTargetLoadMap;
+
+// Usable cell of an equivalence class and its target load.
+struct EquivCellLoad
+{
+  LibertyCell *cell;
+  float target_load;
+  // Position in the equiv cells to break ties like a linear scan.
+  int equiv_index;
+};
+// Sorted by increasing target load, one cell per target load.
+typedef vector<EquivCellLoad> EquivCellLadder;
+typedef std::unordered_map<const LibertyCellSeq*,
+                           EquivCellLadder> EquivCellLadderMap;
 typedef array<Slew, RiseFall::index_count> TgtSlews;
 
 enum class ParasiticsSrc { none, placement, global_routing };
@@ -232,7 +248,8 @@ public:
                    int max_passes,
                    bool verbose,
                    bool skip_pin_swap,
-                   bool skip_gate_cloning);
+                   bool skip_gate_cloning,
+                   int batch_size);
   // For testing.
   void repairSetup(const Pin *end_pin);
   // Rebuffer one net (for testing).
@@ -247,7 +264,8 @@ public:
                   // Max buffer count as percent of design instance count.
                   float max_buffer_percent,
                   int max_passes,
-                  bool verbose);
+                  bool verbose,
+                  int batch_size);
   void repairHold(const Pin *end_pin,
                   double setup_margin,
                   double hold_margin,
@@ -324,7 +342,9 @@ public:
   //  restore resized gates
   // resizeSlackPreamble must be called before the first findResizeSlacks.
   void resizeSlackPreamble();
-  void findResizeSlacks();
+  // With incremental, only the nets passed to parasiticsInvalid since the
+  // previous pass are re-estimated and the STA update stays incremental.
+  void findResizeSlacks(bool incremental = false);
   // Return nets with worst slack.
   NetSeq &resizeWorstSlackNets();
   // Return net slack, if any (indicated by the bool).
@@ -360,6 +380,7 @@ protected:
   void findBuffers();
   bool isLinkCell(LibertyCell *cell);
   void findTargetLoads();
+  void makeEquivCellLadders();
 
   //==============================
   // APIs for gate cloning
@@ -497,6 +518,10 @@ protected:
   void ensureWireParasitic(const Pin *drvr_pin);
   void ensureWireParasitic(const Pin *drvr_pin,
                            const Net *net);
+  void estimateWireParasitics(const vector<const Net*> &nets);
+  // False for supply, ideal clock and special nets.
+  bool hasWireParasitic(const Pin *drvr_pin,
+                        const Net *net) const;
   void estimateWireParasiticSteiner(const Pin *drvr_pin,
                                     const Net *net);
   float totalLoad(SteinerTree *tree) const;
@@ -534,8 +559,15 @@ protected:
   LibertyCell *findTargetCell(LibertyCell *cell,
                               float load_cap,
                               bool revisiting_inst);
+  LibertyCell *closestTargetLoadCell(LibertyCell *cell,
+                                     float load_cap,
+                                     const EquivCellLadder &ladder);
   // Returns nullptr if net has less than 2 pins or any pin is not placed.
   SteinerTree *makeSteinerTree(const Pin *drvr_pin);
+  // Build the steiner trees of the drvr_pins nets concurrently.
+  // makeSteinerTree uses them as long as the net pins do not move.
+  void planSteinerTrees(const vector<const Pin*> &drvr_pins);
+  void clearSteinerTreePlans();
   BufferedNetPtr makeBufferedNet(const Pin *drvr_pin,
                                  const Corner *corner);
   BufferedNetPtr makeBufferedNetSteiner(const Pin *drvr_pin,
@@ -617,6 +649,8 @@ protected:
 
   ParasiticsSrc parasitics_src_;
   UnorderedSet<const Net*, NetHash> parasitics_invalid_;
+  std::unordered_map<const Pin*, std::unique_ptr<SteinerTreePlan>>
+    steiner_tree_plans_;
 
   double design_area_;
   const MinMax *min_;
@@ -625,6 +659,8 @@ protected:
   LibertyCell *buffer_lowest_drive_;
 
   CellTargetLoadMap *target_load_map_;
+  // Rebuilt by resizePreamble because makeEquivCells remakes the classes.
+  EquivCellLadderMap equiv_cell_ladders_;
   VertexSeq level_drvr_vertices_;
   bool level_drvr_vertices_valid_;
   TgtSlews tgt_slews_;
@@ -661,6 +697,8 @@ protected:
   static constexpr float tgt_slew_load_cap_factor = 10.0;
   // Prim/Dijkstra gets out of hand with bigger nets.
   static constexpr int max_steiner_pin_count_ = 100000;
+  // Nets whose steiner trees are built together when estimating.
+  static constexpr size_t estimate_batch_ = 4096;
 
   friend class BufferedNet;
   friend class GateCloner;
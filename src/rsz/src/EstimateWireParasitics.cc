@@ -248,13 +248,17 @@ void
 Resizer::updateParasitics()
 {
   switch (parasitics_src_) {
-  case ParasiticsSrc::placement:
-    for (const Net *net : parasitics_invalid_)
-      estimateWireParasitic(net);
+  case ParasiticsSrc::placement: {
+    vector<const Net*> nets(parasitics_invalid_.begin(),
+                            parasitics_invalid_.end());
+    estimateWireParasitics(nets);
     parasitics_invalid_.clear();
     break;
+  }
   case ParasiticsSrc::global_routing: {
-    incr_groute_->updateRoutes();
+    // Nets moved out of congestion get new routes too.
+    for (odb::dbNet *db_net : incr_groute_->updateRoutes())
+      parasitics_invalid_.insert(db_network_->dbToSta(db_net));
     for (const Net *net : parasitics_invalid_)
       global_router_->estimateRC(db_network_->staToDb(net));
     parasitics_invalid_.clear();
@@ -298,7 +302,8 @@ Resizer::ensureWireParasitic(const Pin *drvr_pin,
     case ParasiticsSrc::global_routing: {
       grt::IncrementalGRoute incr_groute(global_router_, block_);
       global_router_->addDirtyNet(db_network_->staToDb(net));
-      incr_groute.updateRoutes();
+      for (odb::dbNet *db_net : incr_groute.updateRoutes())
+        parasitics_invalid_.insert(db_network_->dbToSta(db_net));
       global_router_->estimateRC(db_network_->staToDb(net));
       parasitics_invalid_.erase(net);
       break;
@@ -320,18 +325,56 @@ Resizer::estimateWireParasitics()
     // Make separate parasitics for each corner, same for min/max.
     sta_->setParasiticAnalysisPts(true, false);
 
+    vector<const Net*> nets;
     NetIterator *net_iter = network_->netIterator(network_->topInstance());
-    while (net_iter->hasNext()) {
-      Net *net = net_iter->next();
-      estimateWireParasitic(net);
-    }
+    while (net_iter->hasNext())
+      nets.push_back(net_iter->next());
     delete net_iter;
+    estimateWireParasitics(nets);
 
     parasitics_src_ = ParasiticsSrc::placement;
     parasitics_invalid_.clear();
   }
 }
 
+// The steiner trees of each batch of nets are built concurrently by
+// planSteinerTrees.  The parasitics are then made one net at a time in
+// net order because the sta parasitics are not thread safe.
+void
+Resizer::estimateWireParasitics(const vector<const Net*> &nets)
+{
+  // Plans of a caller that is part way through them are left alone
+  // and the nets are estimated one at a time.
+  const bool plan_trees = steiner_tree_plans_.empty();
+  vector<const Pin*> drvr_pins;
+  vector<const Net*> drvr_nets;
+  for (const Net *net : nets) {
+    PinSet *drivers = network_->drivers(net);
+    if (drivers && !drivers->empty()) {
+      PinSet::Iterator drvr_iter(drivers);
+      drvr_pins.push_back(drvr_iter.next());
+      drvr_nets.push_back(net);
+    }
+  }
+  const size_t drvr_count = drvr_pins.size();
+  for (size_t start = 0; start < drvr_count; start += estimate_batch_) {
+    const size_t end = std::min(start + estimate_batch_, drvr_count);
+    if (plan_trees) {
+      vector<const Pin*> plan_drvr_pins;
+      for (size_t i = start; i < end; i++) {
+        if (hasWireParasitic(drvr_pins[i], drvr_nets[i])
+            && !isPadNet(drvr_nets[i]))
+          plan_drvr_pins.push_back(drvr_pins[i]);
+      }
+      planSteinerTrees(plan_drvr_pins);
+    }
+    for (size_t i = start; i < end; i++)
+      estimateWireParasitic(drvr_pins[i], drvr_nets[i]);
+  }
+  if (plan_trees)
+    clearSteinerTreePlans();
+}
+
 void
 Resizer::estimateWireParasitic(const Net *net)
 {
@@ -347,10 +390,7 @@ void
 Resizer::estimateWireParasitic(const Pin *drvr_pin,
                                const Net *net)
 {
-  if (!network_->isPower(net)
-      && !network_->isGround(net)
-      && !sta_->isIdealClock(drvr_pin)
-      && !db_network_->staToDb(net)->isSpecial()) {
+  if (hasWireParasitic(drvr_pin, net)) {
     if (isPadNet(net))
       // When an input port drives a pad instance with huge input
       // cap the elmore delay is gigantic. Annotate with zero
@@ -361,6 +401,16 @@ Resizer::estimateWireParasitic(const Pin *drvr_pin,
   }
 }
 
+bool
+Resizer::hasWireParasitic(const Pin *drvr_pin,
+                          const Net *net) const
+{
+  return !network_->isPower(net)
+    && !network_->isGround(net)
+    && !sta_->isIdealClock(drvr_pin)
+    && !db_network_->staToDb(net)->isSpecial();
+}
+
 bool
 Resizer::isPadNet(const Net *net) const
 {
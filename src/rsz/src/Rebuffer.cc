@@ -37,6 +37,10 @@
 #include "BufferedNet.hh"
 #include "rsz/Resizer.hh"
 
+#include <cmath>
+#include <functional>
+#include <limits>
+
 #include "db_sta/dbNetwork.hh"
 
 #include "sta/Units.hh"
@@ -70,6 +74,7 @@ using sta::fuzzyLessEqual;
 using sta::fuzzyEqual;
 using sta::fuzzyInf;
 using sta::INF;
+using sta::delayInf;
 
 // Return inserted buffer count.
 int
@@ -94,6 +99,22 @@ RepairSetup::rebuffer(const Pin *drvr_pin)
       // net from the port.
       && !hasTopLevelOutputPort(net)) {
     corner_ = sta_->cmdCorner();
+    sta_->findRequireds();
+    RebufferCacheEntry entry = rebufferCacheEntry(drvr_pin, net);
+    auto cached = rebuffer_cache_.find(drvr_pin);
+    if (cached != rebuffer_cache_.end()
+        && sameRebufferNet(cached->second, entry)) {
+      // Nothing the choice depends on has changed since it was made.
+      debugPrint(logger_, RSZ, "rebuffer", 2, "driver {} cached",
+                 sdc_network_->pathName(drvr_pin));
+      BufferedNetPtr choice = cached->second.choice;
+      if (choice) {
+        inserted_buffer_count = rebufferTopDown(choice, net, 1);
+        if (inserted_buffer_count > 0)
+          rebuffer_net_count_++;
+      }
+      return inserted_buffer_count;
+    }
     BufferedNetPtr bnet = resizer_->makeBufferedNet(drvr_pin, corner_);
     if (bnet) {
       bool debug = (drvr_pin == resizer_->debug_pin_);
@@ -101,7 +122,6 @@ RepairSetup::rebuffer(const Pin *drvr_pin)
         logger_->setDebugLevel(RSZ, "rebuffer", 3);
       debugPrint(logger_, RSZ, "rebuffer", 2, "driver {}",
                  sdc_network_->pathName(drvr_pin));
-      sta_->findRequireds();
       BufferedNetSeq Z = rebufferBottomUp(bnet, 1);
       Required best_slack_penalized = -INF;
       BufferedNetPtr best_option = nullptr;
@@ -121,6 +141,8 @@ RepairSetup::rebuffer(const Pin *drvr_pin)
           i++;
         }
       }
+      entry.choice = best_option;
+      rebuffer_cache_[drvr_pin] = std::move(entry);
       if (best_option) {
         debugPrint(logger_, RSZ, "rebuffer", 2, "best option {}", best_index);
         inserted_buffer_count = rebufferTopDown(best_option, net, 1);
@@ -141,6 +163,47 @@ RepairSetup::rebuffer(const Pin *drvr_pin)
   return inserted_buffer_count;
 }
 
+RebufferCacheEntry
+RepairSetup::rebufferCacheEntry(const Pin *drvr_pin,
+                                const Net *net)
+{
+  RebufferCacheEntry entry;
+  entry.drvr_port = drvr_port_;
+  entry.drvr_location = db_network_->location(drvr_pin);
+  entry.corner = corner_;
+  NetConnectedPinIterator *pin_iter = network_->connectedPinIterator(net);
+  while (pin_iter->hasNext()) {
+    const Pin *pin = pin_iter->next();
+    if (pin != drvr_pin && network_->isLoad(pin)) {
+      Vertex *vertex = graph_->pinLoadVertex(pin);
+      Required required = sta_->vertexRequired(vertex, max_);
+      int64_t required_quanta = delayInf(required)
+        ? std::numeric_limits<int64_t>::max()
+        : std::llround(required / rebuffer_cache_required_quantum_);
+      entry.loads.push_back({pin,
+                             network_->libertyPort(pin),
+                             db_network_->location(pin),
+                             required_quanta});
+    }
+  }
+  delete pin_iter;
+  sort(entry.loads.begin(), entry.loads.end(),
+       [](const RebufferLoad &load1, const RebufferLoad &load2) {
+         return std::less<const Pin*>()(load1.pin, load2.pin);
+       });
+  return entry;
+}
+
+bool
+RepairSetup::sameRebufferNet(const RebufferCacheEntry &entry1,
+                             const RebufferCacheEntry &entry2) const
+{
+  return entry1.drvr_port == entry2.drvr_port
+    && entry1.drvr_location == entry2.drvr_location
+    && entry1.corner == entry2.corner
+    && entry1.loads == entry2.loads;
+}
+
 Slack
 RepairSetup::slackPenalized(BufferedNetPtr bnet)
 {
@@ -171,7 +171,19 @@ RepairDesign::repairDesign(double max_wire_length, // zero for none (meters)
     printProgress(print_iteration, false, false, repaired_net_count);
   }
   int max_length = resizer_->metersToDbu(max_wire_length);
-  for (int i = resizer_->level_drvr_vertices_.size() - 1; i >= 0; i--) {
+  // Plan the steiner trees of the next batch of drivers concurrently
+  // against the current placement; repairNet below is the serial commit
+  // and rebuilds a tree only when repairs moved the pins of its net.
+  const bool plan_trees
+    = resizer_->parasitics_src_ == ParasiticsSrc::placement;
+  const int drvr_count = resizer_->level_drvr_vertices_.size();
+  for (int i = drvr_count - 1; i >= 0; i--) {
+    if (plan_trees && (drvr_count - 1 - i) % steiner_plan_batch_ == 0) {
+      vector<const Pin*> drvr_pins;
+      for (int j = i; j >= 0 && j > i - steiner_plan_batch_; j--)
+        drvr_pins.push_back(resizer_->level_drvr_vertices_[j]->pin());
+      resizer_->planSteinerTrees(drvr_pins);
+    }
     print_iteration++;
     if (verbose) {
       printProgress(print_iteration, false, false, repaired_net_count);
@@ -197,6 +209,7 @@ RepairDesign::repairDesign(double max_wire_length, // zero for none (meters)
       logger_->setDebugLevel(RSZ, "repair_net", 0);
     }
   }
+  resizer_->clearSteinerTreePlans();
   resizer_->updateParasitics();
   if (verbose) {
     printProgress(print_iteration, true, true, repaired_net_count);
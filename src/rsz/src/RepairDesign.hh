@@ -250,6 +250,8 @@ protected:
   static constexpr float elmore_skew_factor_ = 1.39;
   static constexpr int min_print_interval_ = 10;
   static constexpr int max_print_interval_ = 100;
+  // Driver nets whose steiner trees are planned concurrently at a time.
+  static constexpr int steiner_plan_batch_ = 4096;
 };
 
 }  // namespace rsz
@@ -37,6 +37,8 @@
 #include "rsz/Resizer.hh"
 #include "RepairDesign.hh"
 
+#include <unordered_set>
+
 #include "utl/Logger.h"
 #include "db_sta/dbNetwork.hh"
 
@@ -119,7 +121,8 @@ RepairHold::repairHold(double setup_margin,
                        // Max buffer count as percent of design instance count.
                        float max_buffer_percent,
                        int max_passes,
-                       bool verbose)
+                       bool verbose,
+                       int batch_size)
 {
   init();
   sta_->checkSlewLimitPreamble();
@@ -137,7 +140,7 @@ RepairHold::repairHold(double setup_margin,
   resizer_->incrementalParasiticsBegin();
   repairHold(ends1, buffer_cell, setup_margin, hold_margin,
              allow_setup_violations, max_buffer_count, max_passes,
-             verbose);
+             verbose, batch_size);
 
   // Leave the parasitices up to date.
   resizer_->updateParasitics();
@@ -167,7 +170,7 @@ RepairHold::repairHold(const Pin *end_pin,
   resizer_->incrementalParasiticsBegin();
   repairHold(ends, buffer_cell, setup_margin, hold_margin,
              allow_setup_violations, max_buffer_count, max_passes,
-             false);
+             false, 0);
   // Leave the parasitices up to date.
   resizer_->updateParasitics();
   resizer_->incrementalParasiticsEnd();
@@ -262,7 +265,8 @@ RepairHold::repairHold(VertexSeq &ends,
                        bool allow_setup_violations,
                        int max_buffer_count,
                        int max_passes,
-                       bool verbose)
+                       bool verbose,
+                       int batch_size)
 {
   // Find endpoints with hold violations.
   VertexSeq hold_failures;
@@ -291,9 +295,17 @@ RepairHold::repairHold(VertexSeq &ends,
                  delayAsString(worst_slack, sta_, 3),
                  delayAsString(sta_->worstSlack(max_), sta_, 3));
       int hold_buffer_count_before = inserted_buffer_count_;
-      repairHoldPass(hold_failures, buffer_cell,
-                     setup_margin, hold_margin,
-                     allow_setup_violations, max_buffer_count);
+      if (batch_size > 0
+          && !repairHoldBatch(hold_failures, buffer_cell,
+                              setup_margin, hold_margin,
+                              allow_setup_violations, max_buffer_count,
+                              batch_size))
+        // Finish with one buffer at a time.
+        batch_size = 0;
+      if (batch_size == 0)
+        repairHoldPass(hold_failures, buffer_cell,
+                       setup_margin, hold_margin,
+                       allow_setup_violations, max_buffer_count);
       debugPrint(logger_, RSZ, "repair_hold", 1, "inserted {}",
                  inserted_buffer_count_ - hold_buffer_count_before);
       sta_->findRequireds();
@@ -368,6 +380,103 @@ RepairHold::repairHoldPass(VertexSeq &hold_failures,
   }
 }
 
+// Buffer up to batch_size endpoints whose worst hold paths share no
+// driver with a worse endpoint's path. The buffers are chosen from the
+// current timing, inserted together and checked with one setup timing
+// update. Returns false, with the batch undone, if nothing was planned or
+// the batch fails the slew and setup checks repairEndHold applies to each
+// buffer.
+bool
+RepairHold::repairHoldBatch(VertexSeq &hold_failures,
+                            LibertyCell *buffer_cell,
+                            double setup_margin,
+                            double hold_margin,
+                            bool allow_setup_violations,
+                            int max_buffer_count,
+                            int batch_size)
+{
+  resizer_->updateParasitics();
+  sort(hold_failures, [=] (Vertex *end1,
+                           Vertex *end2) {
+    return sta_->vertexSlack(end1, min_) < sta_->vertexSlack(end2, min_);
+  });
+  vector<HoldDelay> hold_delays;
+  std::unordered_set<Vertex*> claimed_drvrs;
+  for (Vertex *end_vertex : hold_failures) {
+    if (static_cast<int>(hold_delays.size()) >= batch_size
+        || inserted_buffer_count_ + static_cast<int>(hold_delays.size())
+           >= max_buffer_count)
+      break;
+    PathRef end_path = sta_->vertexWorstSlackPath(end_vertex, min_);
+    if (end_path.isNull())
+      continue;
+    PathExpanded expanded(&end_path, sta_);
+    int path_length = expanded.size();
+    if (path_length <= 1)
+      continue;
+    // Endpoints sharing fan-in with a worse one are left for a later
+    // batch, when its buffer is in the timing.
+    vector<Vertex*> path_drvrs;
+    bool shared = false;
+    for (int i = expanded.startIndex(); i < path_length; i++) {
+      Vertex *path_vertex = expanded.path(i)->vertex(sta_);
+      if (path_vertex->isDriver(network_)) {
+        if (claimed_drvrs.find(path_vertex) != claimed_drvrs.end()) {
+          shared = true;
+          break;
+        }
+        path_drvrs.push_back(path_vertex);
+      }
+    }
+    if (shared)
+      continue;
+    claimed_drvrs.insert(path_drvrs.begin(), path_drvrs.end());
+    for (int i = expanded.startIndex(); i < path_length; i++) {
+      HoldDelay hold_delay;
+      if (findHoldDelay(end_vertex, expanded, i, buffer_cell,
+                        setup_margin, hold_margin, allow_setup_violations,
+                        hold_delay)) {
+        hold_delays.push_back(hold_delay);
+        break;
+      }
+    }
+  }
+  if (hold_delays.empty())
+    return false;
+
+  resizer_->journalBegin();
+  Slack setup_slack_before = sta_->worstSlack(max_);
+  vector<Slew> slews_before;
+  for (const HoldDelay &hold_delay : hold_delays)
+    slews_before.push_back(sta_->vertexSlew(hold_delay.drvr, max_));
+  for (HoldDelay &hold_delay : hold_delays)
+    makeHoldDelay(hold_delay.drvr, hold_delay.load_pins,
+                  hold_delay.loads_have_out_port,
+                  buffer_cell, hold_delay.loc);
+
+  bool slews_ok = true;
+  for (size_t i = 0; i < hold_delays.size(); i++) {
+    Slew slew_after = sta_->vertexSlew(hold_delays[i].drvr, max_);
+    if (slews_before[i] > 0 && slew_after / slews_before[i] > 1.20) {
+      slews_ok = false;
+      break;
+    }
+  }
+  Slack setup_slack_after = sta_->worstSlack(max_);
+  bool ok = slews_ok
+    && (allow_setup_violations
+        || !(fuzzyLess(setup_slack_after, setup_slack_before)
+             && setup_slack_after < setup_margin));
+  debugPrint(logger_, RSZ, "repair_hold", 1, "batch of {} buffers {}",
+             hold_delays.size(),
+             ok ? "kept" : "undone");
+  if (!ok)
+    resizer_->journalRestore(resize_count_, inserted_buffer_count_,
+                             cloned_gate_count_);
+  resizer_->journalEnd();
+  return ok;
+}
+
 void
 RepairHold::repairEndHold(Vertex *end_vertex,
                           LibertyCell *buffer_cell,
@@ -383,110 +492,139 @@ RepairHold::repairEndHold(Vertex *end_vertex,
                delayAsString(end_path.slack(sta_), sta_),
                delayAsString(sta_->vertexSlack(end_vertex, max_), sta_));
     PathExpanded expanded(&end_path, sta_);
-    sta::SearchPredNonLatch2 pred(sta_);
     int path_length = expanded.size();
     if (path_length > 1) {
       for (int i = expanded.startIndex(); i < path_length; i++) {
-        PathRef *path = expanded.path(i);
-        Vertex *path_vertex = path->vertex(sta_);
-        Pin *path_pin = path_vertex->pin();
-        Net *path_net = network_->isTopLevelPort(path_pin)
-          ? network_->net(network_->term(path_pin))
-          : network_->net(path_pin);
-        dbNet* db_path_net = db_network_->staToDb(path_net);
-        if (path_vertex->isDriver(network_)
-            && !resizer_->dontTouch(path_net)
-            && !db_path_net->isConnectedByAbutment()) {
-          PinSeq load_pins;
-          Slacks slacks;
-          mergeInit(slacks);
-          float excluded_cap = 0.0;
-          bool loads_have_out_port = false;
-          VertexOutEdgeIterator edge_iter(path_vertex, graph_);
-          while (edge_iter.hasNext()) {
-            Edge *edge = edge_iter.next();
-            Vertex *fanout = edge->to(graph_);
-            if (pred.searchTo(fanout)
-                && pred.searchThru(edge)) {
-              Slack fanout_hold_slack = sta_->vertexSlack(fanout, min_);
-              Pin *load_pin = fanout->pin();
-              if (fanout_hold_slack < hold_margin) {
-                load_pins.push_back(load_pin);
-                Slacks fanout_slacks;
-                sta_->vertexSlacks(fanout, fanout_slacks);
-                mergeInto(fanout_slacks, slacks);
-                if (network_->direction(load_pin)->isAnyOutput()
-                    && network_->isTopLevelPort(load_pin))
-                  loads_have_out_port = true;
-              }
-              else {
-                LibertyPort *load_port = network_->libertyPort(load_pin);
-                if (load_port)
-                  excluded_cap += load_port->capacitance();
-              }
-            }
-          }
-          if (!load_pins.empty()) {
-            debugPrint(logger_, RSZ,
-                       "repair_hold", 3, " {} hold_slack={}/{} setup_slack={}/{} fanouts={}",
-                       path_vertex->name(network_),
-                       delayAsString(slacks[rise_index_][min_index_], sta_),
-                       delayAsString(slacks[fall_index_][min_index_], sta_),
-                       delayAsString(slacks[rise_index_][max_index_], sta_),
-                       delayAsString(slacks[fall_index_][max_index_], sta_),
-                       load_pins.size());
-            const DcalcAnalysisPt *dcalc_ap = sta_->cmdCorner()->findDcalcAnalysisPt(max_);
-            float load_cap = graph_delay_calc_->loadCap(end_vertex->pin(), dcalc_ap)
-              - excluded_cap;
-            ArcDelay buffer_delays[RiseFall::index_count];
-            Slew buffer_slews[RiseFall::index_count];
-            resizer_->bufferDelays(buffer_cell, load_cap, dcalc_ap,
-                                   buffer_delays, buffer_slews);
-            // setup_slack > -hold_slack
-            if (allow_setup_violations
-                || (slacks[rise_index_][max_index_] - setup_margin
-                    > -(slacks[rise_index_][min_index_] - hold_margin)
-                    && slacks[fall_index_][max_index_] - setup_margin
-                    > -(slacks[fall_index_][min_index_] - hold_margin)
-                    // enough slack to insert the buffer
-                    // setup_slack > buffer_delay
-                    && (slacks[rise_index_][max_index_] - setup_margin)
-                    > buffer_delays[rise_index_]
-                    && (slacks[fall_index_][max_index_] - setup_margin)
-                    > buffer_delays[fall_index_])) {
-              Vertex *path_load = expanded.path(i + 1)->vertex(sta_);
-              Point path_load_loc = db_network_->location(path_load->pin());
-              Point drvr_loc = db_network_->location(path_vertex->pin());
-              Point buffer_loc((drvr_loc.x() + path_load_loc.x()) / 2,
-                               (drvr_loc.y() + path_load_loc.y()) / 2);
-              // Despite checking for setup slack to insert the bufffer,
-              // increased slews downstream can increase delays and
-              // reduce setup slack in ways that are too expensive to
-              // predict. Use the journal to back out the change if
-              // the hold buffer blows through the setup margin.
-              resizer_->journalBegin();
-              Slack setup_slack_before = sta_->worstSlack(max_);
-              Slew slew_before = sta_->vertexSlew(path_vertex, max_);
-              makeHoldDelay(path_vertex, load_pins, loads_have_out_port,
-                            buffer_cell, buffer_loc);
-              Slew slew_after = sta_->vertexSlew(path_vertex, max_);
-              Slack setup_slack_after = sta_->worstSlack(max_);
-              float slew_factor = (slew_before> 0)?slew_after/slew_before:1.0;
-
-              if (slew_factor > 1.20 ||
-                  (!allow_setup_violations
-                  && fuzzyLess(setup_slack_after, setup_slack_before)
-                  && setup_slack_after < setup_margin)) {
-                resizer_->journalRestore(
-                    resize_count_, inserted_buffer_count_, cloned_gate_count_);
-              }
-              resizer_->journalEnd();
-            }
+        HoldDelay hold_delay;
+        if (findHoldDelay(end_vertex, expanded, i, buffer_cell,
+                          setup_margin, hold_margin, allow_setup_violations,
+                          hold_delay)) {
+          Vertex *path_vertex = hold_delay.drvr;
+          // Despite checking for setup slack to insert the bufffer,
+          // increased slews downstream can increase delays and
+          // reduce setup slack in ways that are too expensive to
+          // predict. Use the journal to back out the change if
+          // the hold buffer blows through the setup margin.
+          resizer_->journalBegin();
+          Slack setup_slack_before = sta_->worstSlack(max_);
+          Slew slew_before = sta_->vertexSlew(path_vertex, max_);
+          makeHoldDelay(path_vertex, hold_delay.load_pins,
+                        hold_delay.loads_have_out_port,
+                        buffer_cell, hold_delay.loc);
+          Slew slew_after = sta_->vertexSlew(path_vertex, max_);
+          Slack setup_slack_after = sta_->worstSlack(max_);
+          float slew_factor = (slew_before> 0)?slew_after/slew_before:1.0;
+
+          if (slew_factor > 1.20 ||
+              (!allow_setup_violations
+              && fuzzyLess(setup_slack_after, setup_slack_before)
+              && setup_slack_after < setup_margin)) {
+            resizer_->journalRestore(
+                resize_count_, inserted_buffer_count_, cloned_gate_count_);
           }
+          resizer_->journalEnd();
+        }
+      }
+    }
+  }
+}
+
+// Find the failing loads of the driver at path_index of an end_vertex
+// path and where to buffer them, if a hold buffer there fits in the
+// setup slack.
+bool
+RepairHold::findHoldDelay(Vertex *end_vertex,
+                          PathExpanded &expanded,
+                          int path_index,
+                          LibertyCell *buffer_cell,
+                          double setup_margin,
+                          double hold_margin,
+                          bool allow_setup_violations,
+                          // Return value.
+                          HoldDelay &hold_delay)
+{
+  sta::SearchPredNonLatch2 pred(sta_);
+  PathRef *path = expanded.path(path_index);
+  Vertex *path_vertex = path->vertex(sta_);
+  Pin *path_pin = path_vertex->pin();
+  Net *path_net = network_->isTopLevelPort(path_pin)
+    ? network_->net(network_->term(path_pin))
+    : network_->net(path_pin);
+  dbNet* db_path_net = db_network_->staToDb(path_net);
+  if (path_vertex->isDriver(network_)
+      && !resizer_->dontTouch(path_net)
+      && !db_path_net->isConnectedByAbutment()) {
+    PinSeq load_pins;
+    Slacks slacks;
+    mergeInit(slacks);
+    float excluded_cap = 0.0;
+    bool loads_have_out_port = false;
+    VertexOutEdgeIterator edge_iter(path_vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      Vertex *fanout = edge->to(graph_);
+      if (pred.searchTo(fanout)
+          && pred.searchThru(edge)) {
+        Slack fanout_hold_slack = sta_->vertexSlack(fanout, min_);
+        Pin *load_pin = fanout->pin();
+        if (fanout_hold_slack < hold_margin) {
+          load_pins.push_back(load_pin);
+          Slacks fanout_slacks;
+          sta_->vertexSlacks(fanout, fanout_slacks);
+          mergeInto(fanout_slacks, slacks);
+          if (network_->direction(load_pin)->isAnyOutput()
+              && network_->isTopLevelPort(load_pin))
+            loads_have_out_port = true;
+        }
+        else {
+          LibertyPort *load_port = network_->libertyPort(load_pin);
+          if (load_port)
+            excluded_cap += load_port->capacitance();
         }
       }
     }
+    if (!load_pins.empty()) {
+      debugPrint(logger_, RSZ, "repair_hold", 3,
+                 " {} hold_slack={}/{} setup_slack={}/{} fanouts={}",
+                 path_vertex->name(network_),
+                 delayAsString(slacks[rise_index_][min_index_], sta_),
+                 delayAsString(slacks[fall_index_][min_index_], sta_),
+                 delayAsString(slacks[rise_index_][max_index_], sta_),
+                 delayAsString(slacks[fall_index_][max_index_], sta_),
+                 load_pins.size());
+      const DcalcAnalysisPt *dcalc_ap
+        = sta_->cmdCorner()->findDcalcAnalysisPt(max_);
+      float load_cap = graph_delay_calc_->loadCap(end_vertex->pin(), dcalc_ap)
+        - excluded_cap;
+      ArcDelay buffer_delays[RiseFall::index_count];
+      Slew buffer_slews[RiseFall::index_count];
+      resizer_->bufferDelays(buffer_cell, load_cap, dcalc_ap,
+                             buffer_delays, buffer_slews);
+      // setup_slack > -hold_slack
+      if (allow_setup_violations
+          || (slacks[rise_index_][max_index_] - setup_margin
+              > -(slacks[rise_index_][min_index_] - hold_margin)
+              && slacks[fall_index_][max_index_] - setup_margin
+              > -(slacks[fall_index_][min_index_] - hold_margin)
+              // enough slack to insert the buffer
+              // setup_slack > buffer_delay
+              && (slacks[rise_index_][max_index_] - setup_margin)
+              > buffer_delays[rise_index_]
+              && (slacks[fall_index_][max_index_] - setup_margin)
+              > buffer_delays[fall_index_])) {
+        Vertex *path_load = expanded.path(path_index + 1)->vertex(sta_);
+        Point path_load_loc = db_network_->location(path_load->pin());
+        Point drvr_loc = db_network_->location(path_vertex->pin());
+        hold_delay.drvr = path_vertex;
+        hold_delay.load_pins = load_pins;
+        hold_delay.loads_have_out_port = loads_have_out_port;
+        hold_delay.loc = Point((drvr_loc.x() + path_load_loc.x()) / 2,
+                               (drvr_loc.y() + path_load_loc.y()) / 2);
+        return true;
+      }
+    }
   }
+  return false;
 }
 
 void
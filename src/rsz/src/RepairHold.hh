@@ -41,6 +41,10 @@
 #include "sta/StaState.hh"
 #include "sta/MinMax.hh"
 
+namespace sta {
+class PathExpanded;
+}
+
 namespace rsz {
 
 class Resizer;
@@ -61,9 +65,19 @@ using sta::Delay;
 using sta::Vertex;
 using sta::PinSeq;
 using sta::VertexSeq;
+using sta::PathExpanded;
 
 typedef Slack Slacks[RiseFall::index_count][MinMax::index_count];
 
+// Hold buffer to insert between a driver and its failing loads.
+struct HoldDelay
+{
+  Vertex *drvr;
+  PinSeq load_pins;
+  bool loads_have_out_port;
+  Point loc;
+};
+
 class RepairHold : StaState
 {
 public:
@@ -74,7 +88,9 @@ public:
                   // Max buffer count as percent of design instance count.
                   float max_buffer_percent,
                   int max_passes,
-                  bool verbose);
+                  bool verbose,
+                  // Independent endpoints repaired per batch (0 = off).
+                  int batch_size);
   void repairHold(const Pin *end_pin,
                   double setup_margin,
                   double hold_margin,
@@ -102,19 +118,36 @@ private:
                   bool allow_setup_violations,
                   int max_buffer_count,
                   int max_passes,
-                  bool verbose);
+                  bool verbose,
+                  int batch_size);
   void repairHoldPass(VertexSeq &ends,
                       LibertyCell *buffer_cell,
                       double setup_margin,
                       double hold_margin,
                       bool allow_setup_violations,
                       int max_buffer_count);
+  bool repairHoldBatch(VertexSeq &hold_failures,
+                       LibertyCell *buffer_cell,
+                       double setup_margin,
+                       double hold_margin,
+                       bool allow_setup_violations,
+                       int max_buffer_count,
+                       int batch_size);
   void repairEndHold(Vertex *worst_vertex,
                      LibertyCell *buffer_cell,
                      double setup_margin,
                      double hold_margin,
                      bool allow_setup_violations,
                      int max_buffer_count);
+  bool findHoldDelay(Vertex *end_vertex,
+                     PathExpanded &expanded,
+                     int path_index,
+                     LibertyCell *buffer_cell,
+                     double setup_margin,
+                     double hold_margin,
+                     bool allow_setup_violations,
+                     // Return value.
+                     HoldDelay &hold_delay);
   void makeHoldDelay(Vertex *drvr,
                      PinSeq &load_pins,
                      bool loads_have_out_port,
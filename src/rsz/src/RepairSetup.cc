@@ -93,6 +93,7 @@ RepairSetup::RepairSetup(Resizer* resizer)
       rebuffer_net_count_(0),
       cloned_gate_count_(0),
       swap_pin_count_(0),
+      batch_resize_count_(0),
       min_(MinMax::min()),
       max_(MinMax::max())
 {
@@ -105,6 +106,7 @@ RepairSetup::init()
   sta_ = resizer_->sta_;
   db_network_ = resizer_->db_network_;
   copyState(sta_);
+  rebuffer_cache_.clear();
 }
 
 void
@@ -113,7 +115,8 @@ RepairSetup::repairSetup(float setup_slack_margin,
                          int max_passes,
                          bool verbose,
                          bool skip_pin_swap,
-                         bool skip_gate_cloning)
+                         bool skip_gate_cloning,
+                         int batch_size)
 {
   init();
   constexpr int digits = 3;
@@ -121,23 +124,11 @@ RepairSetup::repairSetup(float setup_slack_margin,
   split_load_buffer_count_ = 0;
   resize_count_ = 0;
   cloned_gate_count_ = 0;
+  batch_resize_count_ = 0;
   resizer_->buffer_moved_into_core_ = false;
 
-  // Sort failing endpoints by slack.
   VertexSet *endpoints = sta_->endpoints();
-  VertexSeq violating_ends;
-  // logger_->setDebugLevel(RSZ, "repair_setup", 2);
-  // Should check here whether we can figure out the clock domain for each
-  // vertex. This may be the place where we can do some round robin fun to
-  // individually control each clock domain instead of just fixating on fixing one.
-  for (Vertex *end : *endpoints) {
-    Slack end_slack = sta_->vertexSlack(end, max_);
-    if (end_slack < setup_slack_margin)
-      violating_ends.push_back(end);
-  }
-  sort(violating_ends, [=](Vertex *end1, Vertex *end2) {
-    return sta_->vertexSlack(end1, max_) < sta_->vertexSlack(end2, max_);
-  });
+  VertexSeq violating_ends = findViolatingEnds(setup_slack_margin);
   debugPrint(logger_, RSZ, "repair_setup", 1, "Violating endpoints {}/{} {}%",
              violating_ends.size(),
              endpoints->size(),
@@ -152,12 +143,17 @@ RepairSetup::repairSetup(float setup_slack_margin,
     return;
   }
 
+  resizer_->incrementalParasiticsBegin();
+  if (batch_size > 1) {
+    repairSetupBatched(setup_slack_margin, batch_size, max_passes);
+    violating_ends = findViolatingEnds(setup_slack_margin);
+  }
+
   int end_index = 0;
   int max_end_count = violating_ends.size() * repair_tns_end_percent;
   // Always repair the worst endpoint, even if tns percent is zero.
   max_end_count = max(max_end_count, 1);
   swap_pin_inst_set_.clear(); // Make sure we do not swap the same pin twice.
-  resizer_->incrementalParasiticsBegin();
   int print_iteration = 0;
   if (verbose) {
     printProgress(print_iteration, false, false);
@@ -296,6 +292,175 @@ RepairSetup::repairSetup(float setup_slack_margin,
   }
 }
 
+// Failing endpoints sorted by slack.
+VertexSeq
+RepairSetup::findViolatingEnds(float setup_slack_margin)
+{
+  VertexSeq violating_ends;
+  // logger_->setDebugLevel(RSZ, "repair_setup", 2);
+  // Should check here whether we can figure out the clock domain for each
+  // vertex. This may be the place where we can do some round robin fun to
+  // individually control each clock domain instead of just fixating on
+  // fixing one.
+  for (Vertex *end : *sta_->endpoints()) {
+    Slack end_slack = sta_->vertexSlack(end, max_);
+    if (end_slack < setup_slack_margin)
+      violating_ends.push_back(end);
+  }
+  sort(violating_ends, [=](Vertex *end1, Vertex *end2) {
+    return sta_->vertexSlack(end1, max_) < sta_->vertexSlack(end2, max_);
+  });
+  return violating_ends;
+}
+
+// Batched resizing ahead of the serial repair loop. Each round collects
+// upsize candidates from the worst paths of batch_size violating endpoints
+// and ranks them by the Liberty gate delay improvement, without querying
+// STA. The best candidates whose instances share no net with one already
+// taken are committed together, followed by a single timing update. The
+// first round that does not improve TNS without hurting WNS is undone and
+// hands off to the serial loop.
+void
+RepairSetup::repairSetupBatched(float setup_slack_margin,
+                                int batch_size,
+                                int max_passes)
+{
+  for (int pass = 1; pass <= max_passes; pass++) {
+    resizer_->updateParasitics();
+    sta_->findRequireds();
+    VertexSeq violating_ends = findViolatingEnds(setup_slack_margin);
+    if (violating_ends.empty())
+      break;
+    Slack prev_worst_slack = sta_->worstSlack(max_);
+    Slack prev_tns = sta_->totalNegativeSlack(max_);
+
+    vector<SetupMove> moves;
+    int end_count = min(batch_size, static_cast<int>(violating_ends.size()));
+    for (int i = 0; i < end_count; i++) {
+      PathRef end_path = sta_->vertexWorstSlackPath(violating_ends[i], max_);
+      findUpsizeMoves(end_path, moves);
+    }
+    std::stable_sort(moves.begin(), moves.end(),
+                     [](const SetupMove &move1, const SetupMove &move2) {
+                       return move1.gain > move2.gain;
+                     });
+
+    resizer_->journalBegin();
+    std::unordered_set<const Net*> claimed_nets;
+    int move_count = 0;
+    for (const SetupMove &move : moves) {
+      if (claimMoveNets(move.inst, claimed_nets)
+          && resizer_->replaceCell(move.inst, move.cell, true)) {
+        resize_count_++;
+        move_count++;
+      }
+    }
+    if (move_count == 0)
+      break;
+
+    resizer_->updateParasitics();
+    sta_->findRequireds();
+    Slack worst_slack = sta_->worstSlack(max_);
+    Slack tns = sta_->totalNegativeSlack(max_);
+    bool better = fuzzyGreater(tns, prev_tns)
+      && fuzzyGreaterEqual(worst_slack, prev_worst_slack);
+    debugPrint(logger_, RSZ, "repair_setup", 1,
+               "batch {} resized {} worst_slack = {} tns = {} {}",
+               pass,
+               move_count,
+               delayAsString(worst_slack, sta_, 3),
+               delayAsString(tns, sta_, 3),
+               better ? "" : "undo");
+    if (!better) {
+      resizer_->journalRestore(resize_count_, inserted_buffer_count_,
+                               cloned_gate_count_);
+      break;
+    }
+    batch_resize_count_ += move_count;
+    if (resizer_->overMaxArea())
+      break;
+  }
+  // Leave the parasitics up to date for the serial loop.
+  resizer_->updateParasitics();
+  sta_->findRequireds();
+  if (batch_resize_count_ > 0) {
+    logger_->info(RSZ, 96, "Resized {} instances in batches.",
+                  batch_resize_count_);
+  }
+}
+
+// Upsize candidates for the drivers on path, with the same cell choice
+// as upsizeDrvr.
+void
+RepairSetup::findUpsizeMoves(PathRef &path,
+                             vector<SetupMove> &moves)
+{
+  PathExpanded expanded(&path, sta_);
+  const DcalcAnalysisPt *dcalc_ap = path.dcalcAnalysisPt(sta_);
+  int lib_ap = dcalc_ap->libertyIndex();
+  for (int i = max(expanded.startIndex(), 1); i < expanded.size(); i++) {
+    const Pin *drvr_pin = expanded.path(i)->pin(sta_);
+    if (!network_->isDriver(drvr_pin)
+        || network_->isTopLevelPort(drvr_pin))
+      continue;
+    Instance *drvr = network_->instance(drvr_pin);
+    LibertyPort *drvr_port = network_->libertyPort(drvr_pin);
+    LibertyPort *in_port
+      = network_->libertyPort(expanded.path(i - 1)->pin(sta_));
+    if (resizer_->dontTouch(drvr) || drvr_port == nullptr
+        || in_port == nullptr)
+      continue;
+    float prev_drive = 0.0;
+    if (i >= 2) {
+      LibertyPort *prev_drvr_port
+        = network_->libertyPort(expanded.path(i - 2)->pin(sta_));
+      if (prev_drvr_port) {
+        prev_drive = prev_drvr_port->driveResistance();
+      }
+    }
+    float load_cap = graph_delay_calc_->loadCap(drvr_pin, dcalc_ap);
+    LibertyCell *upsize = upsizeCell(in_port, drvr_port, load_cap,
+                                     prev_drive, dcalc_ap, false);
+    if (upsize) {
+      LibertyCell *upsize_corner = upsize->cornerCell(lib_ap);
+      LibertyPort *upsize_drvr
+        = upsize_corner->findLibertyPort(drvr_port->name());
+      LibertyPort *upsize_input
+        = upsize_corner->findLibertyPort(in_port->name());
+      Delay delay = resizer_->gateDelay(drvr_port, load_cap, dcalc_ap)
+        + prev_drive * in_port->cornerPort(lib_ap)->capacitance();
+      Delay upsize_delay = resizer_->gateDelay(upsize_drvr, load_cap, dcalc_ap)
+        + prev_drive * upsize_input->capacitance();
+      moves.push_back({drvr, upsize, delay - upsize_delay});
+    }
+  }
+}
+
+// Claim the nets on the pins of inst for a batched move. Moves that share
+// a net change each other's load or input slew, so only the first one
+// is taken.
+bool
+RepairSetup::claimMoveNets(const Instance *inst,
+                           std::unordered_set<const Net*> &claimed_nets)
+{
+  vector<const Net*> nets;
+  InstancePinIterator *pin_iter = network_->pinIterator(inst);
+  while (pin_iter->hasNext()) {
+    const Pin *pin = pin_iter->next();
+    const Net *net = network_->net(pin);
+    if (net && !network_->isPower(net) && !network_->isGround(net)) {
+      if (claimed_nets.find(net) != claimed_nets.end()) {
+        delete pin_iter;
+        return false;
+      }
+      nets.push_back(net);
+    }
+  }
+  delete pin_iter;
+  claimed_nets.insert(nets.begin(), nets.end());
+  return true;
+}
+
 // For testing.
 void
 RepairSetup::repairSetup(const Pin *end_pin)
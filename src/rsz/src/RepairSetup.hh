@@ -34,6 +34,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #pragma once
+#include <cstdint>
+#include <unordered_map>
 #include <unordered_set>
 #include "db_sta/dbNetwork.hh"
 #include "db_sta/dbSta.hh"
@@ -70,12 +72,51 @@ using sta::TimingArc;
 using sta::DcalcAnalysisPt;
 using sta::Vertex;
 using sta::Corner;
+using sta::Instance;
+using sta::VertexSeq;
+using sta::Delay;
 
 class BufferedNet;
 enum class BufferedNetType;
 typedef std::shared_ptr<BufferedNet> BufferedNetPtr;
 typedef vector<BufferedNetPtr> BufferedNetSeq;
 
+// Load of a rebuffered net as seen by the rebuffer cache.
+struct RebufferLoad
+{
+  const Pin *pin;
+  const LibertyPort *port;
+  Point location;
+  // Required time in rebuffer_cache_required_quantum_ units.
+  int64_t required;
+
+  bool operator==(const RebufferLoad &load) const
+  {
+    return pin == load.pin && port == load.port
+      && location == load.location && required == load.required;
+  }
+};
+
+// Rebuffer choice for a driver and the net state it was made for.
+struct RebufferCacheEntry
+{
+  const LibertyPort *drvr_port;
+  Point drvr_location;
+  const Corner *corner;
+  vector<RebufferLoad> loads;
+  // Best option found by rebufferBottomUp; null if there was none.
+  BufferedNetPtr choice;
+};
+
+// Resize of one path driver proposed by the batched setup repair.
+struct SetupMove
+{
+  Instance *inst;
+  LibertyCell *cell;
+  // Liberty estimate of the gate delay improvement.
+  Delay gain;
+};
+
 class RepairSetup : StaState
 {
 public:
@@ -87,7 +128,10 @@ public:
                    int max_passes,
                    bool verbose,
                    bool skip_pin_swap,
-                   bool skip_gate_cloning);
+                   bool skip_gate_cloning,
+                   // Endpoints whose paths are resized together between
+                   // STA updates before the serial repair (0 = off).
+                   int batch_size);
   // For testing.
   void repairSetup(const Pin *end_pin);
   // Rebuffer one net (for testing).
@@ -96,6 +140,14 @@ public:
 
 private:
   void init();
+  VertexSeq findViolatingEnds(float setup_slack_margin);
+  void repairSetupBatched(float setup_slack_margin,
+                          int batch_size,
+                          int max_passes);
+  void findUpsizeMoves(PathRef &path,
+                       vector<SetupMove> &moves);
+  bool claimMoveNets(const Instance *inst,
+                     std::unordered_set<const Net*> &claimed_nets);
   bool repairSetup(PathRef &path,
                    Slack path_slack,
                    bool skip_pin_swap,
@@ -131,6 +183,10 @@ private:
   bool hasTopLevelOutputPort(Net *net);
 
   int rebuffer(const Pin *drvr_pin);
+  RebufferCacheEntry rebufferCacheEntry(const Pin *drvr_pin,
+                                        const Net *net);
+  bool sameRebufferNet(const RebufferCacheEntry &entry1,
+                       const RebufferCacheEntry &entry2) const;
   BufferedNetSeq rebufferBottomUp(BufferedNetPtr bnet,
                                   int level);
   int rebufferTopDown(BufferedNetPtr choice,
@@ -170,10 +226,16 @@ private:
 
   sta::UnorderedMap<LibertyCell *, sta::LibertyPortSet> equiv_pin_map_;
 
+  int batch_resize_count_;
+  // Rebuffer choices by driver pin. An entry is only used while its net
+  // still matches, so edits to the net invalidate it.
+  std::unordered_map<const Pin*, RebufferCacheEntry> rebuffer_cache_;
+
   static constexpr int decreasing_slack_max_passes_ = 50;
   static constexpr int rebuffer_max_fanout_ = 20;
   static constexpr int split_load_min_fanout_ = 8;
   static constexpr double rebuffer_buffer_penalty_ = .01;
+  static constexpr double rebuffer_cache_required_quantum_ = 1e-12;
   static constexpr int print_interval_ = 10;
 };
 
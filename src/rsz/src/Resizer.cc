@@ -35,6 +35,7 @@
 
 #include "rsz/Resizer.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <optional>
@@ -45,6 +46,7 @@
 #include "RepairDesign.hh"
 #include "RepairHold.hh"
 #include "RepairSetup.hh"
+#include "SteinerTree.hh"
 #include "db_sta/dbNetwork.hh"
 #include "sta/ArcDelayCalc.hh"
 #include "sta/Bfs.hh"
@@ -472,28 +474,20 @@ Resizer::bufferInputs()
 bool
 Resizer::hasPins(Net *net)
 {
-  NetPinIterator *pin_iter = db_network_->pinIterator(net);
-  bool has_pins = pin_iter->hasNext();
-  delete pin_iter;
+  bool has_pins = false;
+  db_network_->visitPins(net, [&has_pins](Pin*) { has_pins = true; });
   return has_pins;
 }
 
 void Resizer::getPins(Net* net, PinVector &pins) const
 {
-  auto pin_iter = network_->pinIterator(net);
-  while (pin_iter->hasNext()) {
-    pins.emplace_back(pin_iter->next());
-  }
-  delete pin_iter;
+  db_network_->visitPins(net, [&pins](Pin* pin) { pins.emplace_back(pin); });
 }
 
 void Resizer::getPins(Instance *inst, PinVector &pins) const
 {
-  auto pin_iter = network_->pinIterator(inst);
-  while (pin_iter->hasNext()) {
-    pins.emplace_back(pin_iter->next());
-  }
-  delete pin_iter;
+  db_network_->visitPins(inst,
+                         [&pins](Pin* pin) { pins.emplace_back(pin); });
 }
 
 Instance *
@@ -888,6 +882,7 @@ Resizer::resizePreamble()
   makeEquivCells();
   findBuffers();
   findTargetLoads();
+  makeEquivCellLadders();
 }
 
 void
@@ -944,6 +939,39 @@ Resizer::resizeToTargetSlew(const Pin *drvr_pin)
   return 0;
 }
 
+// Same choice as the findTargetCell scan for cells that are not
+// buffers/inverters: the candidate closest to load_cap if it is strictly
+// closer than cell. Only the rungs on either side of load_cap can be.
+LibertyCell *
+Resizer::closestTargetLoadCell(LibertyCell *cell,
+                               float load_cap,
+                               const EquivCellLadder &ladder)
+{
+  LibertyCell *best_cell = cell;
+  float best_dist = targetLoadDist(load_cap, (*target_load_map_)[cell]);
+  int best_index = -1;
+  auto upper = std::lower_bound(ladder.begin(), ladder.end(), load_cap,
+                                [](const EquivCellLoad &cell_load,
+                                   float load) {
+                                  return cell_load.target_load < load;
+                                });
+  auto consider = [&](const EquivCellLoad &cell_load) {
+    float dist = targetLoadDist(load_cap, cell_load.target_load);
+    if (dist < best_dist
+        || (best_index >= 0 && dist == best_dist
+            && cell_load.equiv_index < best_index)) {
+      best_cell = cell_load.cell;
+      best_dist = dist;
+      best_index = cell_load.equiv_index;
+    }
+  };
+  if (upper != ladder.begin())
+    consider(*(upper - 1));
+  if (upper != ladder.end())
+    consider(*upper);
+  return best_cell;
+}
+
 bool
 Resizer::isLogicStdCell(const Instance *inst)
 {
@@ -960,6 +988,13 @@ Resizer::findTargetCell(LibertyCell *cell,
   LibertyCellSeq *equiv_cells = sta_->equivCells(cell);
   if (equiv_cells) {
     bool is_buf_inv = cell->isBuffer() || cell->isInverter();
+    // Buffers/inverters also compare delays and revisits only upsize,
+    // so those still scan the class.
+    if (!is_buf_inv && !revisiting_inst) {
+      auto ladder_iter = equiv_cell_ladders_.find(equiv_cells);
+      if (ladder_iter != equiv_cell_ladders_.end())
+        return closestTargetLoadCell(cell, load_cap, ladder_iter->second);
+    }
     float target_load = (*target_load_map_)[cell];
     float best_load = target_load;
     float best_dist = targetLoadDist(load_cap, target_load);
@@ -1134,10 +1169,15 @@ Resizer::resizeSlackPreamble()
 // Run repair_design to repair long wires and max slew, capacitance and fanout
 // violations. Find the slacks, and then undo all changes to the netlist.
 void
-Resizer::findResizeSlacks()
+Resizer::findResizeSlacks(bool incremental)
 {
   journalBegin();
-  estimateWireParasitics();
+  if (incremental && parasitics_src_ == ParasiticsSrc::placement)
+    // Nets moved by the placer and nets touched by the previous
+    // journalRestore.
+    updateParasitics();
+  else
+    estimateWireParasitics();
   int repaired_net_count, slew_violations, cap_violations;
   int fanout_violations, length_violations;
   repair_design_->repairDesign(max_wire_length_, 0.0, 0.0, false,
@@ -1486,6 +1526,50 @@ Resizer::findTargetLoads()
   }
 }
 
+// Precompute the target load ladder of each equivalence class so
+// findTargetCell is a binary search instead of a scan with target load,
+// dont use and link cell lookups for every candidate.
+void
+Resizer::makeEquivCellLadders()
+{
+  equiv_cell_ladders_.clear();
+  LibertyLibraryIterator *lib_iter = network_->libertyLibraryIterator();
+  while (lib_iter->hasNext()) {
+    LibertyLibrary *lib = lib_iter->next();
+    LibertyCellIterator cell_iter(lib);
+    while (cell_iter.hasNext()) {
+      LibertyCell *cell = cell_iter.next();
+      LibertyCellSeq *equiv_cells = sta_->equivCells(cell);
+      if (equiv_cells == nullptr
+          || equiv_cell_ladders_.find(equiv_cells)
+             != equiv_cell_ladders_.end())
+        continue;
+      EquivCellLadder &ladder = equiv_cell_ladders_[equiv_cells];
+      int equiv_index = 0;
+      for (LibertyCell *equiv : *equiv_cells) {
+        if (!dontUse(equiv) && isLinkCell(equiv))
+          ladder.push_back({equiv, (*target_load_map_)[equiv], equiv_index});
+        equiv_index++;
+      }
+      std::stable_sort(ladder.begin(), ladder.end(),
+                       [](const EquivCellLoad &cell_load1,
+                          const EquivCellLoad &cell_load2) {
+                         return cell_load1.target_load
+                           < cell_load2.target_load;
+                       });
+      // The scan keeps the first of equally distant cells.
+      ladder.erase(std::unique(ladder.begin(), ladder.end(),
+                               [](const EquivCellLoad &cell_load1,
+                                  const EquivCellLoad &cell_load2) {
+                                 return cell_load1.target_load
+                                   == cell_load2.target_load;
+                               }),
+                   ladder.end());
+    }
+  }
+  delete lib_iter;
+}
+
 float
 Resizer::targetLoadCap(LibertyCell *cell)
 {
@@ -2593,7 +2677,8 @@ Resizer::repairSetup(double setup_margin,
                      int max_passes,
                      bool verbose,
                      bool skip_pin_swap,
-                     bool skip_gate_cloning)
+                     bool skip_gate_cloning,
+                     int batch_size)
 {
   resizePreamble();
   if (parasitics_src_ == ParasiticsSrc::global_routing) {
@@ -2601,7 +2686,8 @@ Resizer::repairSetup(double setup_margin,
   }
   repair_setup_->repairSetup(setup_margin, repair_tns_end_percent,
                              max_passes, verbose,
-                             skip_pin_swap, skip_gate_cloning);
+                             skip_pin_swap, skip_gate_cloning,
+                             batch_size);
 }
 
 void
@@ -2627,7 +2713,8 @@ Resizer::repairHold(double setup_margin,
                     // Max buffer count as percent of design instance count.
                     float max_buffer_percent,
                     int max_passes,
-                    bool verbose)
+                    bool verbose,
+                    int batch_size)
 {
   resizePreamble();
   if (parasitics_src_ == ParasiticsSrc::global_routing) {
@@ -2636,7 +2723,7 @@ Resizer::repairHold(double setup_margin,
   repair_hold_->repairHold(setup_margin, hold_margin,
                            allow_setup_violations,
                            max_buffer_percent, max_passes,
-                           verbose);
+                           verbose, batch_size);
 }
 
 void
@@ -501,13 +501,15 @@ repair_setup(double setup_margin,
              double repair_tns_end_percent,
              int max_passes,
              bool verbose,
-             bool skip_pin_swap, bool skip_gate_cloning)
+             bool skip_pin_swap, bool skip_gate_cloning,
+             int batch_size)
 {
   ensureLinked();
   Resizer *resizer = getResizer();
   resizer->repairSetup(setup_margin, repair_tns_end_percent,
                        max_passes, verbose,
-                       skip_pin_swap, skip_gate_cloning);
+                       skip_pin_swap, skip_gate_cloning,
+                       batch_size);
 }
 
 void
@@ -524,14 +526,15 @@ repair_hold(double setup_margin,
             bool allow_setup_violations,
             float max_buffer_percent,
             int max_passes,
-            bool verbose)
+            bool verbose,
+            int batch_size)
 {
   ensureLinked();
   Resizer *resizer = getResizer();
   resizer->repairHold(setup_margin, hold_margin,
                       allow_setup_violations,
                       max_buffer_percent, max_passes,
-                      verbose);
+                      verbose, batch_size);
 }
 
 void
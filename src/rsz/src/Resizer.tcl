@@ -396,6 +396,8 @@ sta::define_cmd_args "repair_timing" {[-setup] [-hold] [-recover_power percent_o
                                         [-skip_pin_swap]\
                                         [-skip_gate_cloning)]\
                                         [-repair_tns tns_end_percent]\
+                                        [-setup_batch_size endpoint_count]\
+                                        [-hold_batch_size endpoint_count]\
                                         [-max_buffer_percent buffer_percent]\
                                         [-max_utilization util] \
                                         [-verbose]}
@@ -404,7 +406,8 @@ proc repair_timing { args } {
   sta::parse_key_args "repair_timing" args \
     keys {-setup_margin -hold_margin -slack_margin \
             -libraries -max_utilization -max_buffer_percent \
-            -recover_power -repair_tns -max_passes} \
+            -recover_power -repair_tns -setup_batch_size -hold_batch_size \
+            -max_passes} \
     flags {-setup -hold -allow_setup_violations -skip_pin_swap -skip_gate_cloning -verbose}
 
   set setup [info exists flags(-setup)]
@@ -455,6 +458,18 @@ proc repair_timing { args } {
     set recover_power_percent [expr $recover_power_percent / 100.0]
   }
 
+  set setup_batch_size 0
+  if { [info exists keys(-setup_batch_size)] } {
+    set setup_batch_size $keys(-setup_batch_size)
+    sta::check_positive_integer "-setup_batch_size" $setup_batch_size
+  }
+
+  set hold_batch_size 0
+  if { [info exists keys(-hold_batch_size)] } {
+    set hold_batch_size $keys(-hold_batch_size)
+    sta::check_positive_integer "-hold_batch_size" $hold_batch_size
+  }
+
   set verbose 0
   if { [info exists flags(-verbose)] } {
     set verbose 1
@@ -472,12 +487,12 @@ proc repair_timing { args } {
       if { $setup } {
     rsz::repair_setup $setup_margin $repair_tns_end_percent $max_passes \
       $verbose \
-      $skip_pin_swap $skip_gate_cloning
+      $skip_pin_swap $skip_gate_cloning $setup_batch_size
     }
       if { $hold } {
     rsz::repair_hold $setup_margin $hold_margin \
       $allow_setup_violations $max_buffer_percent $max_passes \
-      $verbose	  
+      $verbose $hold_batch_size
     }
   }
 }
@@ -60,6 +60,9 @@ connectedPins(const Net *net,
               Network *network,
               // Return value.
               PinSeq &pins);
+static void
+sortPinsByLocation(PinSeq &pins,
+                   dbNetwork *db_network);
 
 SteinerPt SteinerTree::null_pt = -1;
 
@@ -78,13 +81,7 @@ Resizer::makeSteinerTree(const Pin *drvr_pin)
   // Find all the connected pins
   connectedPins(net, network_, pins);
   // Sort pins by location because connectedPins order is not deterministic.
-  sort(pins, [=](const Pin *pin1, const Pin *pin2) {
-      Point loc1 = db_network_->location(pin1);
-      Point loc2 = db_network_->location(pin2);
-      return loc1.getX() < loc2.getX()
-        || (loc1.getX() == loc2.getX()
-            && loc1.getY() < loc2.getY());
-  });
+  sortPinsByLocation(pins, db_network_);
   int pin_count = pins.size();
   bool is_placed = true;
   // Warn if there are too many pins (>10000)
@@ -115,9 +112,17 @@ Resizer::makeSteinerTree(const Pin *drvr_pin)
       tree->locAddPin(loc, pin);
     }
     if (is_placed) {
-      stt::Tree ftree = stt_builder_->makeSteinerTree(db_network_->staToDb(net),
-                                                      x, y, drvr_idx);
-      
+      stt::Tree ftree;
+      auto plan = steiner_tree_plans_.find(drvr_pin);
+      if (plan != steiner_tree_plans_.end()
+          && plan->second->pins.drvr_index == drvr_idx
+          && plan->second->pins.x == x
+          && plan->second->pins.y == y)
+        ftree = plan->second->tree;
+      else
+        ftree = stt_builder_->makeSteinerTree(db_network_->staToDb(net),
+                                              x, y, drvr_idx);
+
       tree->setTree(ftree, db_network_);
       tree->createSteinerPtToPinMap();
       return tree;
@@ -127,6 +132,74 @@ Resizer::makeSteinerTree(const Pin *drvr_pin)
   return nullptr;
 }
 
+void
+Resizer::planSteinerTrees(const vector<const Pin*> &drvr_pins)
+{
+  steiner_tree_plans_.clear();
+  // Collecting the pins goes through the network so it stays serial;
+  // flute does the heavy lifting and runs concurrently.
+  vector<const Pin*> plan_drvr_pins;
+  vector<stt::NetPins> nets;
+  for (const Pin *drvr_pin : drvr_pins) {
+    Net *net = network_->isTopLevelPort(drvr_pin)
+      ? network_->net(network_->term(drvr_pin))
+      : network_->net(drvr_pin);
+    if (net == nullptr)
+      continue;
+    PinSeq pins;
+    connectedPins(net, network_, pins);
+    int pin_count = pins.size();
+    if (pin_count < 2 || pin_count > max_steiner_pin_count_)
+      continue;
+    sortPinsByLocation(pins, db_network_);
+    stt::NetPins net_pins;
+    net_pins.drvr_index = 0;
+    bool is_placed = true;
+    for (int i = 0; i < pin_count; i++) {
+      const Pin *pin = pins[i];
+      if (pin == drvr_pin)
+        net_pins.drvr_index = i;
+      Point loc = db_network_->location(pin);
+      net_pins.x.push_back(loc.x());
+      net_pins.y.push_back(loc.y());
+      is_placed &= db_network_->isPlaced(pin);
+    }
+    if (is_placed) {
+      net_pins.alpha = stt_builder_->getNetAlpha(db_network_->staToDb(net));
+      plan_drvr_pins.push_back(drvr_pin);
+      nets.push_back(std::move(net_pins));
+    }
+  }
+
+  vector<stt::Tree> trees = stt_builder_->makeSteinerTrees(nets,
+                                                           threadCount());
+  for (size_t i = 0; i < plan_drvr_pins.size(); i++) {
+    auto plan = std::make_unique<SteinerTreePlan>();
+    plan->pins = std::move(nets[i]);
+    plan->tree = std::move(trees[i]);
+    steiner_tree_plans_[plan_drvr_pins[i]] = std::move(plan);
+  }
+}
+
+void
+Resizer::clearSteinerTreePlans()
+{
+  steiner_tree_plans_.clear();
+}
+
+static void
+sortPinsByLocation(PinSeq &pins,
+                   dbNetwork *db_network)
+{
+  sort(pins, [=](const Pin *pin1, const Pin *pin2) {
+      Point loc1 = db_network->location(pin1);
+      Point loc2 = db_network->location(pin2);
+      return loc1.getX() < loc2.getX()
+        || (loc1.getX() == loc2.getX()
+            && loc1.getY() < loc2.getY());
+  });
+}
+
 static void
 connectedPins(const Net *net,
               Network *network,
@@ -164,4 +164,11 @@ protected:
   friend class GateCloner;
 };
 
+// Flute input and tree of a driver net built by Resizer::planSteinerTrees.
+struct SteinerTreePlan
+{
+  stt::NetPins pins;
+  stt::Tree tree;
+};
+
 } // namespace
@@ -75,6 +75,15 @@ struct Tree
   int branchCount() const { return branch.size(); }
 };
 
+// Pins of a net given to makeSteinerTrees.
+struct NetPins
+{
+  std::vector<int> x;
+  std::vector<int> y;
+  int drvr_index;
+  float alpha;
+};
+
 class SteinerTreeBuilder
 {
  public:
@@ -94,6 +103,10 @@ class SteinerTreeBuilder
                        const std::vector<int>& x,
                        const std::vector<int>& y,
                        int drvr_index);
+  // Builds the trees of many nets concurrently. trees[i] is the tree
+  // makeSteinerTree(x, y, drvr_index, alpha) returns for nets[i].
+  std::vector<Tree> makeSteinerTrees(const std::vector<NetPins>& nets,
+                                     int num_threads);
   // API only for FastRoute, that requires the use of flutes in its
   // internal flute implementation
   Tree makeSteinerTree(const std::vector<int>& x,
@@ -104,6 +117,8 @@ class SteinerTreeBuilder
   float getAlpha() const { return alpha_; }
   void setAlpha(float alpha);
   float getAlpha(const odb::dbNet* net) const;
+  // Alpha makeSteinerTree(net, x, y, drvr_index) uses for net.
+  float getNetAlpha(odb::dbNet* net);
   void setNetAlpha(const odb::dbNet* net, float alpha);
   void setMinFanoutAlpha(int min_fanout, float alpha);
   void setMinHPWLAlpha(int min_hpwl, float alpha);
@@ -41,6 +41,7 @@
 #include "odb/db.h"
 #include "stt/flute.h"
 #include "stt/pd.h"
+#include "utl/exception.h"
 
 namespace stt {
 
@@ -74,6 +75,11 @@ Tree SteinerTreeBuilder::makeSteinerTree(odb::dbNet* net,
                                          const std::vector<int>& x,
                                          const std::vector<int>& y,
                                          const int drvr_index)
+{
+  return makeSteinerTree(x, y, drvr_index, getNetAlpha(net));
+}
+
+float SteinerTreeBuilder::getNetAlpha(odb::dbNet* net)
 {
   float net_alpha = alpha_;
   int min_fanout = min_fanout_alpha_.first;
@@ -91,7 +97,7 @@ Tree SteinerTreeBuilder::makeSteinerTree(odb::dbNet* net,
     }
   }
 
-  return makeSteinerTree(x, y, drvr_index, net_alpha);
+  return net_alpha;
 }
 
 Tree SteinerTreeBuilder::makeSteinerTree(const std::vector<int>& x,
@@ -109,6 +115,28 @@ Tree SteinerTreeBuilder::makeSteinerTree(const std::vector<int>& x,
   return flt::flute(x, y, flute_accuracy);
 }
 
+// flute and primDijkstra keep no state between calls, so the nets can be
+// built independently.
+std::vector<Tree> SteinerTreeBuilder::makeSteinerTrees(
+    const std::vector<NetPins>& nets,
+    int num_threads)
+{
+  std::vector<Tree> trees(nets.size());
+  utl::ThreadException exception;
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 16)
+  for (int i = 0; i < (int) nets.size(); i++) {
+    try {
+      const NetPins& net = nets[i];
+      trees[i] = makeSteinerTree(net.x, net.y, net.drvr_index, net.alpha);
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+
+  return trees;
+}
+
 Tree SteinerTreeBuilder::makeSteinerTree(const std::vector<int>& x,
                                          const std::vector<int>& y,
                                          const std::vector<int>& s,
@@ -33,12 +33,15 @@
 #include "stt/flute.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
 #include <climits>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
 #include <string>
 
 // Use flute LUT file reader.
@@ -200,12 +203,27 @@ static void readLUTfiles(LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
 
 ////////////////////////////////////////////////////////////////
 
+// Position in the decoded LUT strings where the next degree to build
+// starts, so raising the LUT degree does not decode and parse the lower
+// degrees again.
+struct LUTCursor
+{
+  int next_d = 4;
+  size_t pwv_pos = 0;
+  size_t prt_pos = 0;
+};
+
 static void readLUT();
 static void makeLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln);
 static void deleteLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln);
-static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln);
+static void initLUT(int to_d,
+                    LUT_TYPE LUT,
+                    NUMSOLN_TYPE numsoln,
+                    LUTCursor& cursor);
 static void ensureLUT(int d);
-static std::string base64_decode(std::string const& encoded_string);
+static std::string base64_decode(std::string const& encoded_string,
+                                 size_t start,
+                                 size_t skip);
 #if LUT_SOURCE == LUT_VAR_CHECK
 static void checkLUT(LUT_TYPE LUT1,
                      NUMSOLN_TYPE numsoln1,
@@ -215,7 +233,12 @@ static void checkLUT(LUT_TYPE LUT1,
 
 // LUTs are initialized to this order at startup.
 static constexpr int lut_initial_d = 8;
-static int lut_valid_d = 0;
+// Degree the LUTs are built up to. It is only raised, under lut_mutex,
+// once the entries it covers are complete so concurrent flute calls
+// below that degree can read the LUTs without locking.
+static std::atomic<int> lut_valid_d = 0;
+static std::mutex lut_mutex;
+static LUTCursor lut_cursor;
 
 extern std::string post9;
 extern std::string powv9;
@@ -230,7 +253,8 @@ static void readLUT()
 
 #elif LUT_SOURCE == LUT_VAR
   // Only init to d=8 on startup because d=9 is big and slow.
-  initLUT(lut_initial_d, LUT, numsoln);
+  initLUT(lut_initial_d, LUT, numsoln, lut_cursor);
+  lut_valid_d = lut_initial_d;
 
 #elif LUT_SOURCE == LUT_VAR_CHECK
   readLUTfiles(LUT, numsoln);
@@ -238,7 +262,8 @@ static void readLUT()
   LUT_TYPE LUT_;
   NUMSOLN_TYPE numsoln_;
   makeLUT(LUT_, numsoln_);
-  initLUT(FLUTE_D, LUT_, numsoln_);
+  LUTCursor cursor;
+  initLUT(FLUTE_D, LUT_, numsoln_, cursor);
   checkLUT(LUT, numsoln, LUT_, numsoln_);
 #endif
 }
@@ -281,31 +306,52 @@ static unsigned char charNum(unsigned char c)
   return 0;
 }
 
-// Init LUTs from base64 encoded string variables.
-static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
+// Base64 encodes 3 bytes in 4 characters, so decoding can resume at the
+// group holding byte pos of the decoded string.
+static std::string decodeFrom(const std::string& encoded, size_t pos)
 {
-  std::string pwv_string = base64_decode(powv9);
+  return base64_decode(encoded, pos / 3 * 4, pos % 3);
+}
+
+// Parses the decimal number at str like sscanf("%d%n") does, without
+// scanning the remaining (very long) string first.
+static int parseInt(const char*& str)
+{
+  char* end;
+  const int value = strtol(str, &end, 10);
+  str = end;
+  return value;
+}
+
+// Init LUTs of degrees cursor.next_d to to_d from base64 encoded string
+// variables and advance the cursor past them.
+static void initLUT(int to_d,
+                    LUT_TYPE LUT,
+                    NUMSOLN_TYPE numsoln,
+                    LUTCursor& cursor)
+{
+  const std::string pwv_string = decodeFrom(powv9, cursor.pwv_pos);
   const char* pwv = pwv_string.c_str();
 
 #if FLUTE_ROUTING == 1
-  std::string prt_string = base64_decode(post9);
+  const std::string prt_string = decodeFrom(post9, cursor.prt_pos);
   const char* prt = prt_string.c_str();
 #endif
 
-  for (int d = 4; d <= to_d; d++) {
-    int char_cnt;
-    sscanf(pwv, "d=%d%n", &d, &char_cnt);
-    pwv += char_cnt + 1;
+  for (int d = cursor.next_d; d <= to_d; d++) {
+    pwv += 2;  // "d="
+    d = parseInt(pwv);
+    pwv++;  // '\n'
 #if FLUTE_ROUTING == 1
-    sscanf(prt, "d=%d%n", &d, &char_cnt);
-    prt += char_cnt + 1;
+    prt += 2;  // "d="
+    d = parseInt(prt);
+    prt++;  // '\n'
 #endif
     for (int k = 0; k < numgrp[d]; k++) {
       int ns = charNum(*pwv++);
       if (ns == 0) {  // same as some previous group
-        int kk;
-        sscanf(pwv, "%d%n", &kk, &char_cnt);
-        pwv += char_cnt + 1;
+        const int kk = parseInt(pwv);
+        pwv++;  // '\n'
         numsoln[d][k] = numsoln[d][kk];
         LUT[d][k] = LUT[d][kk];
       } else {
@@ -353,16 +399,26 @@ static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
       }
     }
   }
-  lut_valid_d = to_d;
+
+  cursor.next_d = std::max(cursor.next_d, to_d + 1);
+  cursor.pwv_pos += pwv - pwv_string.c_str();
+#if FLUTE_ROUTING == 1
+  cursor.prt_pos += prt - prt_string.c_str();
+#endif
 }
 
 static void ensureLUT(int d)
 {
+  if (std::min(d, FLUTE_D) <= lut_valid_d) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(lut_mutex);
   if (LUT == nullptr) {
     readLUT();
   }
   if (d > lut_valid_d && d <= FLUTE_D) {
-    initLUT(FLUTE_D, LUT, numsoln);
+    initLUT(FLUTE_D, LUT, numsoln, lut_cursor);
+    lut_valid_d = FLUTE_D;
   }
 }
 
@@ -441,14 +497,27 @@ static inline bool is_base64(unsigned char c)
   return (isalnum(c) || (c == '+') || (c == '/'));
 }
 
-static std::string base64_decode(std::string const& encoded_string)
+// Modified to decode from character start (a multiple of 4), dropping the
+// first skip decoded bytes, and to look characters up in a table.
+static std::string base64_decode(std::string const& encoded_string,
+                                 size_t start,
+                                 size_t skip)
 {
-  int in_len = encoded_string.size();
+  static const std::array<unsigned char, 256> char_values = [] {
+    std::array<unsigned char, 256> values{};
+    for (size_t i = 0; i < base64_chars.size(); i++) {
+      values[static_cast<unsigned char>(base64_chars[i])] = i;
+    }
+    return values;
+  }();
+
+  int in_len = encoded_string.size() - std::min(start, encoded_string.size());
   int i = 0;
   int j = 0;
-  int in_ = 0;
-  char char_array_4[4], char_array_3[3];
+  size_t in_ = start;
+  unsigned char char_array_4[4], char_array_3[3];
   std::string ret;
+  ret.reserve(in_len / 4 * 3);
 
   while (in_len-- && (encoded_string[in_] != '=')
          && is_base64(encoded_string[in_])) {
@@ -456,7 +525,7 @@ static std::string base64_decode(std::string const& encoded_string)
     in_++;
     if (i == 4) {
       for (i = 0; i < 4; i++) {
-        char_array_4[i] = base64_chars.find(char_array_4[i]);
+        char_array_4[i] = char_values[char_array_4[i]];
       }
 
       char_array_3[0]
@@ -478,7 +547,7 @@ static std::string base64_decode(std::string const& encoded_string)
     }
 
     for (j = 0; j < 4; j++) {
-      char_array_4[j] = base64_chars.find(char_array_4[j]);
+      char_array_4[j] = char_values[char_array_4[j]];
     }
 
     char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
@@ -491,6 +560,7 @@ static std::string base64_decode(std::string const& encoded_string)
     }
   }
 
+  ret.erase(0, std::min(skip, ret.size()));
   return ret;
 }
 
@@ -34,6 +34,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <boost/polygon/polygon.hpp>
+#include <utility>
+#include <vector>
 
 #include "odb/db.h"
 
@@ -153,24 +155,31 @@ class Tapcell
   using Polygon = boost::polygon::polygon_90_data<int>;
   using Polygon90 = boost::polygon::polygon_90_with_holes_data<int>;
   using CornerMap = std::map<odb::dbRow*, std::set<odb::dbInst*>>;
+  // Disjoint [begin, end) x ranges sorted by position
+  using Intervals = std::vector<std::pair<int, int>>;
 
   std::vector<odb::dbBox*> findBlockages();
-  bool checkSymmetry(odb::dbMaster* master, const odb::dbOrientType& ori);
+  bool checkSymmetry(odb::dbMaster* master,
+                     const odb::dbOrientType& ori) const;
   odb::dbInst* makeInstance(odb::dbBlock* block,
                             odb::dbMaster* master,
                             const odb::dbOrientType& orientation,
                             int x,
                             int y,
                             const std::string& prefix);
-  bool checkIfFilled(int x,
-                     int width,
-                     const odb::dbOrientType& orient,
-                     const std::set<odb::dbInst*>& row_insts);
+  static bool checkIfFilled(int x,
+                            int width,
+                            const odb::dbOrientType& orient,
+                            const Intervals& row_blockages);
+  // The x ranges of the fixed instances inside each row
+  std::vector<Intervals> findRowBlockages(
+      const std::vector<odb::dbRow*>& rows) const;
   int placeTapcells(odb::dbMaster* tapcell_master, int dist);
-  int placeTapcells(odb::dbMaster* tapcell_master,
-                    int dist,
-                    odb::dbRow* row,
-                    bool is_edge);
+  std::vector<int> findTapcellLocations(odb::dbMaster* tapcell_master,
+                                        int dist,
+                                        odb::dbRow* row,
+                                        bool is_edge,
+                                        Intervals& row_blockages) const;
 
   int defaultDistance() const;
 
@@ -35,6 +35,7 @@
 
 #include "tap/tapcell.h"
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <utility>
@@ -44,6 +45,7 @@
 #include "ord/OpenRoad.hh"
 #include "sta/StaMain.hh"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 #include "utl/algorithms.h"
 
 namespace tap {
@@ -156,29 +158,101 @@ int Tapcell::placeTapcells(odb::dbMaster* tapcell_master, const int dist)
     edge_rows.insert(rows.begin(), rows.end());
   }
 
+  odb::dbBlock* block = db_->getChip()->getBlock();
+  const std::vector<odb::dbRow*> rows(block->getRows().begin(),
+                                      block->getRows().end());
+  std::vector<Intervals> row_blockages = findRowBlockages(rows);
+
+  // The rows are independent so their locations are found in parallel.
+  // The instances are made afterwards, in row order, so their names don't
+  // depend on the threads.
+  std::vector<std::vector<int>> row_locations(rows.size());
+  utl::ThreadPool::global()->parallelFor(
+      rows.size(),
+      [&](const int i) {
+        auto* row = rows[i];
+        const bool is_edge = edge_rows.find(row) != edge_rows.end();
+        row_locations[i] = findTapcellLocations(
+            tapcell_master, dist, row, is_edge, row_blockages[i]);
+      },
+      utl::TAP);
+
   int inst = 0;
-  for (auto* row : db_->getChip()->getBlock()->getRows()) {
-    const bool is_edge = edge_rows.find(row) != edge_rows.end();
-    inst += placeTapcells(tapcell_master, dist, row, is_edge);
+  for (size_t i = 0; i < rows.size(); i++) {
+    auto* row = rows[i];
+    const std::string prefix
+        = fmt::format("{}TAPCELL_{}_", tap_prefix_, row->getName());
+    for (const int x : row_locations[i]) {
+      makeInstance(block,
+                   tapcell_master,
+                   row->getOrient(),
+                   x,
+                   row->getBBox().yMin(),
+                   prefix);
+      inst++;
+    }
   }
   logger_->info(utl::TAP, 5, "Inserted {} tapcells.", inst);
   return inst;
 }
 
-int Tapcell::placeTapcells(odb::dbMaster* tapcell_master,
-                           int dist,
-                           odb::dbRow* row,
-                           bool is_edge)
+std::vector<Tapcell::Intervals> Tapcell::findRowBlockages(
+    const std::vector<odb::dbRow*>& rows) const
+{
+  std::vector<odb::Rect> fixed;
+  for (auto* inst : db_->getChip()->getBlock()->getInsts()) {
+    if (inst->isFixed()) {
+      fixed.push_back(inst->getBBox()->getBox());
+    }
+  }
+  std::sort(fixed.begin(), fixed.end(), [](const auto& l, const auto& r) {
+    return l.yMin() < r.yMin();
+  });
+
+  std::vector<Intervals> blockages(rows.size());
+  for (size_t i = 0; i < rows.size(); i++) {
+    const odb::Rect row_bb = rows[i]->getBBox();
+    auto first = std::lower_bound(
+        fixed.begin(), fixed.end(), row_bb.yMin(), [](const auto& rect, int y) {
+          return rect.yMin() < y;
+        });
+    Intervals row_intervals;
+    for (auto it = first; it != fixed.end() && it->yMin() <= row_bb.yMax();
+         it++) {
+      if (row_bb.contains(*it)) {
+        row_intervals.emplace_back(it->xMin(), it->xMax());
+      }
+    }
+
+    // merge the overlapping ranges
+    std::sort(row_intervals.begin(), row_intervals.end());
+    Intervals& merged = blockages[i];
+    for (const auto& interval : row_intervals) {
+      if (!merged.empty() && interval.first < merged.back().second) {
+        merged.back().second = std::max(merged.back().second, interval.second);
+      } else {
+        merged.push_back(interval);
+      }
+    }
+  }
+  return blockages;
+}
+
+std::vector<int> Tapcell::findTapcellLocations(odb::dbMaster* tapcell_master,
+                                               int dist,
+                                               odb::dbRow* row,
+                                               bool is_edge,
+                                               Intervals& row_blockages) const
 {
+  std::vector<int> locations;
   if (row->getSite()->getName() != tapcell_master->getSite()->getName()) {
-    return 0;
+    return locations;
   }
   if (!checkSymmetry(tapcell_master, row->getOrient())) {
-    return 0;
+    return locations;
   }
 
   const int tap_width = tapcell_master->getWidth();
-  int insts = 0;
 
   int offset = 0;
   int pitch_mult = 2;
@@ -195,48 +269,39 @@ int Tapcell::placeTapcells(odb::dbMaster* tapcell_master,
   }
 
   const odb::Rect row_bb = row->getBBox();
-
-  std::set<odb::dbInst*> row_insts;
-  for (auto* inst : db_->getChip()->getBlock()->getInsts()) {
-    if (!inst->isFixed()) {
-      continue;
-    }
-
-    if (row_bb.contains(inst->getBBox()->getBox())) {
-      row_insts.insert(inst);
-    }
-  }
-
   const int llx = row_bb.xMin();
   const int urx = row_bb.xMax();
 
   const int site_width = row->getSite()->getWidth();
+  const odb::dbOrientType ori = row->getOrient();
   for (int x = llx + offset; x < urx; x += pitch) {
     x = odb::makeSiteLoc(x, site_width, true, llx);
     // Check if site is filled
-    const odb::dbOrientType ori = row->getOrient();
-    bool overlap = checkIfFilled(x, tap_width, ori, row_insts);
-    if (!overlap) {
-      const int lly = row_bb.yMin();
-      auto* inst = makeInstance(
-          db_->getChip()->getBlock(),
-          tapcell_master,
-          ori,
-          x,
-          lly,
-          fmt::format("{}TAPCELL_{}_", tap_prefix_, row->getName()));
-      row_insts.insert(inst);
-      insts++;
+    if (checkIfFilled(x, tap_width, ori, row_blockages)) {
+      continue;
+    }
+    if (x < 0 || row_bb.yMin() < 0) {
+      // makeInstance skips these
+      continue;
+    }
+    locations.push_back(x);
+    // the new tapcell blocks the following ones
+    std::pair<int, int> tap(x, x + tap_width);
+    if (ori == odb::dbOrientType::MY || ori == odb::dbOrientType::R180) {
+      tap = {x - tap_width, x};
     }
+    row_blockages.insert(
+        std::lower_bound(row_blockages.begin(), row_blockages.end(), tap),
+        tap);
   }
 
-  return insts;
+  return locations;
 }
 
 bool Tapcell::checkIfFilled(const int x,
                             const int width,
                             const odb::dbOrientType& orient,
-                            const std::set<odb::dbInst*>& row_insts)
+                            const Intervals& row_blockages)
 {
   int x_start;
   int x_end;
@@ -248,13 +313,13 @@ bool Tapcell::checkIfFilled(const int x,
     x_end = x + width;
   }
 
-  for (const auto& inst : row_insts) {
-    const odb::Rect inst_bb = inst->getBBox()->getBox();
-    if (x_end > inst_bb.xMin() && x_start < inst_bb.xMax()) {
-      return true;
-    }
-  }
-  return false;
+  // first range ending after x_start
+  auto it = std::upper_bound(
+      row_blockages.begin(),
+      row_blockages.end(),
+      x_start,
+      [](int x, const std::pair<int, int>& range) { return x < range.second; });
+  return it != row_blockages.end() && it->first < x_end;
 }
 
 vector<odb::dbBox*> Tapcell::findBlockages()
@@ -334,7 +399,8 @@ int Tapcell::removeCells(const std::string& prefix)
   return removed;
 }
 
-bool Tapcell::checkSymmetry(odb::dbMaster* master, const odb::dbOrientType& ori)
+bool Tapcell::checkSymmetry(odb::dbMaster* master,
+                            const odb::dbOrientType& ori) const
 {
   const bool symmetry_x = master->getSymmetryX();
   const bool symmetry_y = master->getSymmetryY();
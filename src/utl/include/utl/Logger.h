@@ -46,6 +46,7 @@
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Metrics.h"
@@ -55,6 +56,8 @@
 
 namespace utl {
 
+class AsyncSink;
+
 // Keep this sorted
 #define FOREACH_TOOL(X) \
   X(ANT)                \
@@ -116,7 +119,7 @@ class Logger
   template <typename... Args>
   inline void report(const std::string& message, const Args&... args)
   {
-    logger_->log(spdlog::level::level_enum::off, FMT_RUNTIME(message), args...);
+    write(spdlog::level::level_enum::off, message, args...);
   }
 
   // Do NOT call this directly, use the debugPrint macro  instead (defined
@@ -128,13 +131,18 @@ class Logger
                     const Args&... args)
   {
     // Message counters do NOT apply to debug messages.
-    logger_->log(spdlog::level::level_enum::debug,
-                 FMT_RUNTIME("[{} {}-{}] " + message),
-                 level_names[spdlog::level::level_enum::debug],
-                 tool_names_[tool],
-                 group,
-                 args...);
-    logger_->flush();
+    if (debug_rate_limit_ > 0 && !debugRateAllowed(tool, group)) {
+      return;
+    }
+    write(spdlog::level::level_enum::debug,
+          "[{} {}-{}] " + message,
+          level_names[spdlog::level::level_enum::debug],
+          tool_names_[tool],
+          group,
+          args...);
+    if (!async_sink_) {
+      logger_->flush();
+    }
   }
 
   template <typename... Args>
@@ -162,6 +170,7 @@ class Logger
                                               const Args&... args)
   {
     log(tool, spdlog::level::err, id, message, args...);
+    flush();
     char tool_id[32];
     sprintf(tool_id, "%s-%04d", tool_names_[tool], id);
     std::runtime_error except(tool_id);
@@ -176,6 +185,7 @@ class Logger
                                           const Args&... args)
   {
     log(tool, spdlog::level::level_enum::critical, id, message, args...);
+    flush();
     exit(EXIT_FAILURE);
   }
 
@@ -222,6 +232,31 @@ class Logger
   void suppressMessage(ToolId tool, int id);
   void unsuppressMessage(ToolId tool, int id);
 
+  // Writes messages from a background thread so logging threads don't
+  // wait on the sinks.  error() and critical() still flush before
+  // returning control.
+  void setAsync(bool enable);
+  // Blocks until every message logged so far has reached the sinks.
+  void flush();
+  // Limits each debug group to this many messages per second and thread,
+  // reporting how many were dropped.  Zero disables the limit.
+  void setDebugRateLimit(int messages_per_second)
+  {
+    debug_rate_limit_ = messages_per_second;
+  }
+
+  // Messages of concurrent tasks can be printed in a deterministic order.
+  // While a buffer is set for the calling thread, the messages it logs are
+  // kept in the buffer, except the errors, and printBuffer() prints them
+  // later from any thread.
+  using MessageBuffer
+      = std::vector<std::pair<spdlog::level::level_enum, std::string>>;
+  static void setThreadBuffer(MessageBuffer* buffer)
+  {
+    thread_buffer_ = buffer;
+  }
+  void printBuffer(MessageBuffer& buffer);
+
   void addSink(spdlog::sink_ptr sink);
   void removeSink(spdlog::sink_ptr sink);
   void addMetricsSink(const char* metrics_filename);
@@ -231,6 +266,14 @@ class Logger
   void clearMetricsStage();
   void pushMetricsStage(std::string_view format);
   std::string popMetricsStage();
+  // Logs the process memory and the memory counters as metrics of the
+  // current stage.
+  void memoryMetrics();
+  // Logs the utilization of the global thread pool, per tool, as metrics
+  // of the current stage.
+  void schedulerMetrics();
+  // Logs memory metrics whenever a metrics stage ends.
+  void setMemoryMetrics(bool enable) { memory_metrics_ = enable; }
 
  private:
   std::vector<std::string> metrics_sinks_;
@@ -248,27 +291,42 @@ class Logger
     auto& counter = message_counters_[tool][id];
     auto count = counter++;
     if (count < max_message_print) {
-      logger_->log(level,
-                   FMT_RUNTIME("[{} {}-{:04d}] " + message),
-                   level_names[level],
-                   tool_names_[tool],
-                   id,
-                   args...);
+      write(level,
+            "[{} {}-{:04d}] " + message,
+            level_names[level],
+            tool_names_[tool],
+            id,
+            args...);
       return;
     }
 
     if (count == max_message_print) {
-      logger_->log(level,
-                   "[{} {}-{:04d}] message limit reached, "
-                   "this message will no longer print",
-                   level_names[level],
-                   tool_names_[tool],
-                   id);
+      write(level,
+            "[{} {}-{:04d}] message limit reached, "
+            "this message will no longer print",
+            level_names[level],
+            tool_names_[tool],
+            id);
     } else {
       counter--;  // to avoid counter overflow
     }
   }
 
+  // Errors are never buffered, as they are followed by an exception or exit
+  template <typename... Args>
+  inline void write(spdlog::level::level_enum level,
+                    const std::string& message,
+                    const Args&... args)
+  {
+    if (thread_buffer_ != nullptr && level != spdlog::level::err
+        && level != spdlog::level::critical) {
+      thread_buffer_->emplace_back(
+          level, fmt::format(FMT_RUNTIME(message), args...));
+      return;
+    }
+    logger_->log(level, FMT_RUNTIME(message), args...);
+  }
+
   inline void log_metric(const std::string metric, const std::string value)
   {
     std::string key;
@@ -281,6 +339,7 @@ class Logger
 
   void flushMetrics();
   void finalizeMetrics();
+  bool debugRateAllowed(ToolId tool, const std::string& group);
 
   // Allows for lookup by a compatible key (ie string_view)
   // to avoid constructing a key (string) just for lookup
@@ -302,6 +361,10 @@ class Logger
   std::vector<spdlog::sink_ptr> sinks_;
   std::shared_ptr<spdlog::logger> logger_;
   std::stack<std::string> metrics_stages_;
+  bool memory_metrics_ = false;
+  std::shared_ptr<AsyncSink> async_sink_;
+  int debug_rate_limit_ = 0;
+  static thread_local MessageBuffer* thread_buffer_;
 
   // This matrix is pre-allocated so it can be safely updated
   // from multiple threads without locks.
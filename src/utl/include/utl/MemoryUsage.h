@@ -0,0 +1,139 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace utl {
+
+// Resident set size of the process in bytes, or 0 where it is unknown.
+size_t getCurrentRSS();
+size_t getPeakRSS();
+
+// Counts the bytes held by one subsystem (odb tables, routing grids, ...)
+// so the memory of a flow can be attributed to the data structures holding
+// it.  Counters are meant to be static objects named like metrics, e.g.
+// "odb__tables".
+class MemoryCounter
+{
+ public:
+  explicit MemoryCounter(const char* name);
+  ~MemoryCounter();
+
+  MemoryCounter(const MemoryCounter&) = delete;
+  MemoryCounter& operator=(const MemoryCounter&) = delete;
+
+  void add(int64_t bytes)
+  {
+    const int64_t current
+        = bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    int64_t peak = peak_.load(std::memory_order_relaxed);
+    while (current > peak
+           && !peak_.compare_exchange_weak(
+               peak, current, std::memory_order_relaxed)) {
+    }
+  }
+  void sub(int64_t bytes)
+  {
+    bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+
+  const char* getName() const { return name_; }
+  int64_t getBytes() const { return bytes_.load(std::memory_order_relaxed); }
+  int64_t getPeakBytes() const
+  {
+    return peak_.load(std::memory_order_relaxed);
+  }
+
+  static void forEach(const std::function<void(const MemoryCounter&)>& func);
+
+ private:
+  const char* name_;
+  std::atomic<int64_t> bytes_{0};
+  std::atomic<int64_t> peak_{0};
+};
+
+// Holds bytes against a counter for as long as it lives.  Copies hold their
+// own charge, so it can be a member of copyable classes.
+class MemoryCharge
+{
+ public:
+  MemoryCharge() = default;
+  MemoryCharge(MemoryCounter& counter, int64_t bytes) { set(counter, bytes); }
+  MemoryCharge(const MemoryCharge& other)
+  {
+    if (other.counter_ != nullptr) {
+      set(*other.counter_, other.bytes_);
+    }
+  }
+  MemoryCharge& operator=(const MemoryCharge& other)
+  {
+    if (this != &other) {
+      release();
+      if (other.counter_ != nullptr) {
+        set(*other.counter_, other.bytes_);
+      }
+    }
+    return *this;
+  }
+  ~MemoryCharge() { release(); }
+
+  // Replaces the current charge.
+  void set(MemoryCounter& counter, int64_t bytes)
+  {
+    release();
+    counter_ = &counter;
+    bytes_ = bytes;
+    counter_->add(bytes_);
+  }
+  void release()
+  {
+    if (counter_ != nullptr) {
+      counter_->sub(bytes_);
+      counter_ = nullptr;
+      bytes_ = 0;
+    }
+  }
+
+ private:
+  MemoryCounter* counter_ = nullptr;
+  int64_t bytes_ = 0;
+};
+
+}  // namespace utl
@@ -0,0 +1,180 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "utl/Logger.h"
+
+namespace utl {
+
+// A work-stealing thread pool meant to be shared by all the tools so that
+// running several of them at once (e.g. from Python threads) doesn't
+// oversubscribe the machine.  Each worker owns a queue and idle workers
+// steal from the others.  Threads waiting for their tasks help run queued
+// work, so tasks may themselves use the pool (nested parallelism).
+//
+// global() is sized from OpenRoad::setThreadCount.
+class ThreadPool
+{
+ public:
+  // num_threads <= 0 means the number of hardware threads.  The calling
+  // thread participates in the work so one less worker is started.
+  explicit ThreadPool(int num_threads = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  static std::shared_ptr<ThreadPool> global();
+  // Replaces the global pool.  Users holding the previous one keep it
+  // until they release it.
+  static void setGlobalThreadCount(int num_threads);
+
+  // Number of threads working on a parallelFor, including the caller.
+  int getThreadCount() const { return static_cast<int>(workers_.size()) + 1; }
+
+  // Runs task(0) ... task(num_tasks - 1) and waits for all of them.  At
+  // most max_threads threads work on them (0 for no limit).  The first
+  // exception raised by a task is rethrown in the calling thread.
+  void parallelFor(int num_tasks,
+                   const std::function<void(int)>& task,
+                   ToolId tool = UKN,
+                   int max_threads = 0);
+  // Runs task(begin, end) on contiguous chunks of [0, num_items), serially
+  // if there are less than min_num_items items.
+  void parallelForChunks(int num_items,
+                         int min_num_items,
+                         const std::function<void(int, int)>& task,
+                         ToolId tool = UKN);
+
+  struct ToolStats
+  {
+    int64_t tasks = 0;
+    double busy_seconds = 0;
+  };
+  ToolStats getStats(ToolId tool) const;
+  // Busy time of all the threads over the time they were available since
+  // the last resetStats, in [0, 1].
+  double getUtilization() const;
+  void resetStats();
+
+ private:
+  struct Counter
+  {
+    std::atomic<int> pending{0};
+    std::exception_ptr exception = nullptr;
+    std::mutex mutex;
+    std::condition_variable done;
+  };
+  using CounterPtr = std::shared_ptr<Counter>;
+
+  // A batch of tasks sharing one function.  Whoever picks up a handle to
+  // the batch keeps running its tasks until none is left.
+  struct Batch
+  {
+    std::function<void(int)> owned_task;
+    const std::function<void(int)>* task = nullptr;
+    int num_tasks = 0;
+    std::atomic<int> next_task{0};
+    ToolId tool = UKN;
+    CounterPtr counter;
+  };
+  using BatchPtr = std::shared_ptr<Batch>;
+
+  struct WorkQueue
+  {
+    std::mutex mutex;
+    std::deque<BatchPtr> jobs;
+  };
+
+  void submit(const BatchPtr& batch, int num_jobs);
+  void workerLoop(int worker_id);
+  // Pops from the worker's own queue or steals from the others.
+  bool popJob(int worker_id, BatchPtr& job);
+  void runTasks(Batch& batch);
+  // Waits for the counter to drop to zero while running queued jobs.
+  void wait(Counter& counter);
+
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;  // protects stop_ and the wake up of workers
+  std::condition_variable wake_up_;
+  std::atomic<int> pending_jobs_{0};
+  std::atomic<unsigned int> next_queue_{0};
+  bool stop_ = false;
+
+  std::array<std::atomic<int64_t>, ToolId::SIZE> tasks_;
+  std::array<std::atomic<int64_t>, ToolId::SIZE> busy_ns_;
+  std::atomic<std::chrono::steady_clock::rep> stats_start_;
+
+  friend class TaskGroup;
+};
+
+// Runs independent tasks on a pool.  wait() (or the destructor) returns
+// once all of them have finished.
+class TaskGroup
+{
+ public:
+  explicit TaskGroup(ToolId tool = UKN,
+                     std::shared_ptr<ThreadPool> pool = ThreadPool::global());
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  void run(std::function<void()> task);
+  // Rethrows the first exception raised by a task.
+  void wait();
+
+ private:
+  std::shared_ptr<ThreadPool> pool_;
+  ToolId tool_;
+  ThreadPool::CounterPtr counter_;
+};
+
+}  // namespace utl
@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace utl {
+
+// Collects spans (named, timed regions of code) from every thread so one
+// trace shows where a whole flow spends its time.  Each thread records into
+// its own ring buffer that keeps the most recent spans.  Recording is off by
+// default, in which case a span costs a single relaxed atomic load.
+class Tracer
+{
+ public:
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+  static void setEnabled(bool enabled);
+  // Drops all the spans recorded so far.
+  static void clear();
+  // Writes the recorded spans in the Chrome trace event JSON format, which
+  // both chrome://tracing and Perfetto read.
+  static bool writeChromeTrace(const std::string& filename);
+
+  // Nanoseconds since the tracer was first used.
+  static int64_t now();
+  // category and name must stay valid for the life of the program.
+  static void record(const char* category,
+                     const char* name,
+                     int64_t start,
+                     int64_t end);
+  // Returns a copy of name that stays valid for the life of the program.
+  static const char* intern(std::string_view name);
+
+ private:
+  static std::atomic_bool enabled_;
+};
+
+// Records the time from its construction to its destruction (or end()) as a
+// span of the calling thread.  Spans nest by time within a thread.
+class TraceSpan
+{
+ public:
+  // category and name must stay valid for the life of the program, which is
+  // the case for string literals.
+  TraceSpan(const char* category, const char* name)
+  {
+    if (Tracer::enabled()) {
+      begin(category, name);
+    }
+  }
+  // The name is copied, for names built at runtime.
+  TraceSpan(const char* category, std::string_view name)
+  {
+    if (Tracer::enabled()) {
+      begin(category, Tracer::intern(name));
+    }
+  }
+  ~TraceSpan() { end(); }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+  // Ends the span before the end of its scope.
+  void end()
+  {
+    if (name_ != nullptr) {
+      Tracer::record(category_, name_, start_, Tracer::now());
+      name_ = nullptr;
+    }
+  }
+
+ private:
+  void begin(const char* category, const char* name)
+  {
+    category_ = category;
+    name_ = name;
+    start_ = Tracer::now();
+  }
+
+  const char* category_ = nullptr;
+  const char* name_ = nullptr;
+  int64_t start_ = 0;
+};
+
+}  // namespace utl
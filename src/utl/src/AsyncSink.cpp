@@ -0,0 +1,236 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "AsyncSink.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+namespace utl {
+
+namespace {
+
+// Loggers are usually never destroyed, so the sinks alive at exit are
+// flushed from a static destructor to not lose the last messages.
+struct LiveSinks
+{
+  std::mutex mutex;
+  std::vector<AsyncSink*> sinks;
+
+  ~LiveSinks()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (AsyncSink* sink : sinks) {
+      sink->flush();
+    }
+  }
+};
+
+LiveSinks& liveSinks()
+{
+  static LiveSinks live_sinks;
+  return live_sinks;
+}
+
+size_t roundUpToPowerOfTwo(size_t value)
+{
+  size_t result = 2;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+}  // namespace
+
+AsyncSink::AsyncSink(const std::vector<spdlog::sink_ptr>& sinks,
+                     size_t capacity)
+    : mask_(roundUpToPowerOfTwo(capacity) - 1),
+      cells_(new Cell[mask_ + 1]),
+      sinks_(sinks)
+{
+  for (size_t i = 0; i <= mask_; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  writer_ = std::thread(&AsyncSink::run, this);
+
+  LiveSinks& live = liveSinks();
+  std::lock_guard<std::mutex> lock(live.mutex);
+  live.sinks.push_back(this);
+}
+
+AsyncSink::~AsyncSink()
+{
+  {
+    LiveSinks& live = liveSinks();
+    std::lock_guard<std::mutex> lock(live.mutex);
+    live.sinks.erase(std::remove(live.sinks.begin(), live.sinks.end(), this),
+                     live.sinks.end());
+  }
+  stop_ = true;
+  wakeWriter();
+  writer_.join();
+}
+
+// Bounded multi-producer queue after Dmitry Vyukov's design: each cell's
+// sequence tells whether it is free for the producer at a given position or
+// holds a message for the consumer at that position.
+bool AsyncSink::tryPush(const spdlog::details::log_msg& msg)
+{
+  size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  Cell* cell;
+  while (true) {
+    cell = &cells_[pos & mask_];
+    const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    const intptr_t diff
+        = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(
+              pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return false;  // full
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+  cell->msg = spdlog::details::log_msg_buffer(msg);
+  cell->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+bool AsyncSink::tryPop(spdlog::details::log_msg_buffer& msg)
+{
+  Cell& cell = cells_[dequeue_pos_ & mask_];
+  if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+    return false;
+  }
+  msg = std::move(cell.msg);
+  cell.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+  ++dequeue_pos_;
+  return true;
+}
+
+void AsyncSink::wakeWriter()
+{
+  if (sleeping_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wake_.notify_one();
+  }
+}
+
+void AsyncSink::log(const spdlog::details::log_msg& msg)
+{
+  while (!tryPush(msg)) {
+    wakeWriter();
+    std::this_thread::yield();
+  }
+  wakeWriter();
+}
+
+void AsyncSink::flush()
+{
+  if (std::this_thread::get_id() == writer_.get_id()) {
+    return;
+  }
+  const size_t target = enqueue_pos_.load(std::memory_order_acquire);
+  std::unique_lock<std::mutex> lock(mutex_);
+  wake_.notify_one();
+  written_cv_.wait(lock, [this, target] { return written_ >= target; });
+}
+
+void AsyncSink::set_pattern(const std::string& pattern)
+{
+  std::lock_guard<std::mutex> lock(sinks_mutex_);
+  for (auto& sink : sinks_) {
+    sink->set_pattern(pattern);
+  }
+}
+
+void AsyncSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter)
+{
+  std::lock_guard<std::mutex> lock(sinks_mutex_);
+  for (auto& sink : sinks_) {
+    sink->set_formatter(formatter->clone());
+  }
+}
+
+void AsyncSink::setSinks(const std::vector<spdlog::sink_ptr>& sinks)
+{
+  std::lock_guard<std::mutex> lock(sinks_mutex_);
+  sinks_ = sinks;
+}
+
+void AsyncSink::run()
+{
+  spdlog::details::log_msg_buffer msg;
+  while (true) {
+    size_t count = 0;
+    {
+      std::lock_guard<std::mutex> lock(sinks_mutex_);
+      while (tryPop(msg)) {
+        for (auto& sink : sinks_) {
+          if (sink->should_log(msg.level)) {
+            sink->log(msg);
+          }
+        }
+        ++count;
+      }
+      if (count > 0) {
+        for (auto& sink : sinks_) {
+          sink->flush();
+        }
+      }
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (count > 0) {
+      written_ += count;
+      written_cv_.notify_all();
+      continue;
+    }
+    if (stop_ && dequeue_pos_ == enqueue_pos_.load()) {
+      break;
+    }
+    sleeping_ = true;
+    // The timeout covers a message pushed between the empty pop above and
+    // the writer going to sleep.
+    wake_.wait_for(lock, std::chrono::milliseconds(10));
+    sleeping_ = false;
+  }
+}
+
+}  // namespace utl
@@ -0,0 +1,98 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "spdlog/details/log_msg_buffer.h"
+#include "spdlog/sinks/sink.h"
+
+namespace utl {
+
+// An spdlog sink that hands messages to a dedicated writer thread through a
+// bounded lock-free queue, so threads that log don't serialize on the I/O of
+// the real sinks.  Messages keep the time and thread id of the caller.  When
+// the queue is full callers wait for room rather than dropping messages.
+// flush() returns only once every message logged before it is written.
+class AsyncSink : public spdlog::sinks::sink
+{
+ public:
+  AsyncSink(const std::vector<spdlog::sink_ptr>& sinks, size_t capacity);
+  ~AsyncSink() override;
+
+  void log(const spdlog::details::log_msg& msg) override;
+  void flush() override;
+  void set_pattern(const std::string& pattern) override;
+  void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+  void setSinks(const std::vector<spdlog::sink_ptr>& sinks);
+
+ private:
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    spdlog::details::log_msg_buffer msg;
+  };
+
+  bool tryPush(const spdlog::details::log_msg& msg);
+  bool tryPop(spdlog::details::log_msg_buffer& msg);
+  void wakeWriter();
+  void run();
+
+  const size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+  std::atomic<size_t> enqueue_pos_{0};
+  size_t dequeue_pos_ = 0;  // only used by the writer
+
+  std::mutex sinks_mutex_;
+  std::vector<spdlog::sink_ptr> sinks_;
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable written_cv_;
+  std::atomic<size_t> written_{0};
+  std::atomic_bool sleeping_{false};
+  std::atomic_bool stop_{false};
+  std::thread writer_;
+};
+
+}  // namespace utl
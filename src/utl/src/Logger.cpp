@@ -35,17 +35,25 @@
 
 #include "utl/Logger.h"
 
+#include <algorithm>
 #include <atomic>
+#include <cctype>
+#include <chrono>
 #include <fstream>
 #include <mutex>
+#include <utility>
 
+#include "AsyncSink.h"
 #include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include "spdlog/spdlog.h"
+#include "utl/MemoryUsage.h"
+#include "utl/ThreadPool.h"
 
 namespace utl {
 
 int Logger::max_message_print = 1000;
+thread_local Logger::MessageBuffer* Logger::thread_buffer_ = nullptr;
 
 Logger::Logger(const char* log_filename, const char* metrics_filename)
     : debug_on_(false)
@@ -78,6 +86,9 @@ Logger::Logger(const char* log_filename, const char* metrics_filename)
 Logger::~Logger()
 {
   finalizeMetrics();
+  if (async_sink_) {
+    setAsync(false);
+  }
 }
 
 void Logger::addMetricsSink(const char* metrics_filename)
@@ -125,9 +136,71 @@ void Logger::setDebugLevel(ToolId tool, const char* group, int level)
   }
 }
 
+void Logger::setAsync(bool enable)
+{
+  if (enable == (async_sink_ != nullptr)) {
+    return;
+  }
+  if (enable) {
+    constexpr size_t queue_size = 8192;
+    async_sink_ = std::make_shared<AsyncSink>(sinks_, queue_size);
+    logger_->sinks() = {async_sink_};
+  } else {
+    async_sink_->flush();
+    logger_->sinks() = sinks_;
+    async_sink_.reset();  // joins the writer thread
+  }
+}
+
+void Logger::flush()
+{
+  logger_->flush();
+}
+
+void Logger::printBuffer(MessageBuffer& buffer)
+{
+  for (const auto& [level, message] : buffer) {
+    logger_->log(level, "{}", message);
+  }
+  buffer.clear();
+}
+
+bool Logger::debugRateAllowed(ToolId tool, const std::string& group)
+{
+  struct Window
+  {
+    std::chrono::steady_clock::time_point start;
+    int count = 0;
+  };
+  // Per thread so that the hot debug path takes no lock.
+  thread_local std::map<std::pair<ToolId, std::string>, Window> windows;
+
+  const auto now = std::chrono::steady_clock::now();
+  Window& window = windows[{tool, group}];
+  if (now - window.start >= std::chrono::seconds(1)) {
+    const int dropped = window.count - debug_rate_limit_;
+    if (dropped > 0) {
+      logger_->log(spdlog::level::level_enum::debug,
+                   "[{} {}-{}] {} messages dropped by the rate limit",
+                   level_names[spdlog::level::level_enum::debug],
+                   tool_names_[tool],
+                   group,
+                   dropped);
+    }
+    window.start = now;
+    window.count = 0;
+  }
+  return ++window.count <= debug_rate_limit_;
+}
+
 void Logger::addSink(spdlog::sink_ptr sink)
 {
   sinks_.push_back(sink);
+  if (async_sink_) {
+    sink->set_pattern(pattern_);
+    async_sink_->setSinks(sinks_);
+    return;
+  }
   logger_->sinks().push_back(sink);
   logger_->set_pattern(pattern_);  // updates the new sink
 }
@@ -139,6 +212,11 @@ void Logger::removeSink(spdlog::sink_ptr sink)
   if (sinks_find != sinks_.end()) {
     sinks_.erase(sinks_find);
   }
+  if (async_sink_) {
+    async_sink_->flush();
+    async_sink_->setSinks(sinks_);
+    return;
+  }
   // remove from spdlog list of sinks
   auto& logger_sinks = logger_->sinks();
   auto logger_find = std::find(logger_sinks.begin(), logger_sinks.end(), sink);
@@ -149,6 +227,9 @@ void Logger::removeSink(spdlog::sink_ptr sink)
 
 void Logger::setMetricsStage(std::string_view format)
 {
+  if (memory_metrics_ && !metrics_stages_.empty()) {
+    memoryMetrics();
+  }
   if (metrics_stages_.empty())
     metrics_stages_.push(std::string(format));
   else
@@ -157,6 +238,9 @@ void Logger::setMetricsStage(std::string_view format)
 
 void Logger::clearMetricsStage()
 {
+  if (memory_metrics_ && !metrics_stages_.empty()) {
+    memoryMetrics();
+  }
   std::stack<std::string> new_stack;
   metrics_stages_.swap(new_stack);
 }
@@ -169,6 +253,9 @@ void Logger::pushMetricsStage(std::string_view format)
 std::string Logger::popMetricsStage()
 {
   if (!metrics_stages_.empty()) {
+    if (memory_metrics_) {
+      memoryMetrics();
+    }
     std::string stage = metrics_stages_.top();
     metrics_stages_.pop();
     return stage;
@@ -177,6 +264,35 @@ std::string Logger::popMetricsStage()
   }
 }
 
+void Logger::memoryMetrics()
+{
+  constexpr double mb = 1024.0 * 1024.0;
+  metric("memory__rss_mb", getCurrentRSS() / mb);
+  metric("memory__peak_rss_mb", getPeakRSS() / mb);
+  MemoryCounter::forEach([this](const MemoryCounter& counter) {
+    const std::string name = counter.getName();
+    metric("memory__" + name + "__mb", counter.getBytes() / mb);
+    metric("memory__" + name + "__peak_mb", counter.getPeakBytes() / mb);
+  });
+}
+
+void Logger::schedulerMetrics()
+{
+  auto pool = ThreadPool::global();
+  metric("scheduler__threads", pool->getThreadCount());
+  metric("scheduler__utilization", pool->getUtilization());
+  for (int tool = 0; tool < ToolId::SIZE; ++tool) {
+    const auto stats = pool->getStats(static_cast<ToolId>(tool));
+    if (stats.tasks == 0) {
+      continue;
+    }
+    std::string name = tool_names_[tool];
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    metric("scheduler__" + name + "__tasks", stats.tasks);
+    metric("scheduler__" + name + "__busy_seconds", stats.busy_seconds);
+  }
+}
+
 void Logger::flushMetrics()
 {
   const std::string json = MetricsEntry::assembleJSON(metrics_entries_);
@@ -36,6 +36,7 @@
 #include "LoggerCommon.h"
 
 #include "utl/Logger.h"
+#include "utl/trace.h"
 
 namespace ord {
 // Defined in OpenRoad.i
@@ -130,6 +131,36 @@ std::string pop_metrics_stage()
   return logger->popMetricsStage();
 }
 
+void report_memory_metrics()
+{
+  Logger* logger = getLogger();
+  logger->memoryMetrics();
+}
+
+void set_memory_metrics(bool enable)
+{
+  Logger* logger = getLogger();
+  logger->setMemoryMetrics(enable);
+}
+
+void report_scheduler_metrics()
+{
+  Logger* logger = getLogger();
+  logger->schedulerMetrics();
+}
+
+void set_async_logging(bool enable)
+{
+  Logger* logger = getLogger();
+  logger->setAsync(enable);
+}
+
+void set_debug_rate_limit(int messages_per_second)
+{
+  Logger* logger = getLogger();
+  logger->setDebugRateLimit(messages_per_second);
+}
+
 void suppress_message(utl::ToolId tool, int id)
 {
   Logger* logger = getLogger();
@@ -142,4 +173,22 @@ void unsuppress_message(utl::ToolId tool, int id)
   logger->unsuppressMessage(tool, id);
 }
 
+void set_tracing(bool enable)
+{
+  Tracer::setEnabled(enable);
+}
+
+void clear_trace()
+{
+  Tracer::clear();
+}
+
+void write_trace(const char* filename)
+{
+  if (!Tracer::writeChromeTrace(filename)) {
+    Logger* logger = getLogger();
+    logger->error(UTL, 10, "Unable to write trace to {}.", filename);
+  }
+}
+
 }  // namespace utl
@@ -51,7 +51,15 @@ void set_metrics_stage(const char* fmt);
 void clear_metrics_stage();
 void push_metrics_stage(const char* fmt);
 std::string pop_metrics_stage();
+void report_memory_metrics();
+void set_memory_metrics(bool enable);
+void report_scheduler_metrics();
+void set_async_logging(bool enable);
+void set_debug_rate_limit(int messages_per_second);
 void suppress_message(utl::ToolId tool, int id);
 void unsuppress_message(utl::ToolId tool, int id);
+void set_tracing(bool enable);
+void clear_trace();
+void write_trace(const char* filename);
 
 }  // namespace utl
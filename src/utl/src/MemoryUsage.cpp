@@ -0,0 +1,132 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "utl/MemoryUsage.h"
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#if defined(__APPLE__) && defined(__MACH__)
+#include <mach/mach.h>
+#endif
+
+namespace utl {
+
+size_t getPeakRSS()
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#if defined(__APPLE__) && defined(__MACH__)
+  return usage.ru_maxrss;
+#else
+  return usage.ru_maxrss * 1024L;
+#endif
+}
+
+size_t getCurrentRSS()
+{
+#if defined(__APPLE__) && defined(__MACH__)
+  mach_task_basic_info info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(),
+                MACH_TASK_BASIC_INFO,
+                reinterpret_cast<task_info_t>(&info),
+                &count)
+      != KERN_SUCCESS) {
+    return 0;
+  }
+  return info.resident_size;
+#else
+  FILE* file = fopen("/proc/self/statm", "r");
+  if (file == nullptr) {
+    return 0;
+  }
+  long pages = 0;
+  const bool ok = fscanf(file, "%*s%ld", &pages) == 1;
+  fclose(file);
+  return ok ? pages * sysconf(_SC_PAGESIZE) : 0;
+#endif
+}
+
+namespace {
+
+struct CounterRegistry
+{
+  std::mutex mutex;
+  std::vector<const MemoryCounter*> counters;
+};
+
+CounterRegistry& counterRegistry()
+{
+  static CounterRegistry registry;
+  return registry;
+}
+
+}  // namespace
+
+MemoryCounter::MemoryCounter(const char* name) : name_(name)
+{
+  CounterRegistry& registry = counterRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.counters.push_back(this);
+}
+
+MemoryCounter::~MemoryCounter()
+{
+  CounterRegistry& registry = counterRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto& counters = registry.counters;
+  counters.erase(std::remove(counters.begin(), counters.end(), this),
+                 counters.end());
+}
+
+void MemoryCounter::forEach(
+    const std::function<void(const MemoryCounter&)>& func)
+{
+  CounterRegistry& registry = counterRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (const MemoryCounter* counter : registry.counters) {
+    func(*counter);
+  }
+}
+
+}  // namespace utl
@@ -0,0 +1,345 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "utl/ThreadPool.h"
+
+#include <algorithm>
+
+namespace utl {
+
+namespace {
+
+// The worker index of the current thread in its pool, so that nested work
+// goes to the worker's own queue.
+thread_local const void* current_pool = nullptr;
+thread_local int current_worker = -1;
+
+std::mutex global_mutex;
+std::shared_ptr<ThreadPool> global_pool;
+
+std::chrono::steady_clock::rep nowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(int num_threads)
+{
+  if (num_threads <= 0) {
+    num_threads = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  num_threads = std::max(num_threads - 1, 0);
+  resetStats();
+  queues_.reserve(num_threads);
+  for (int i = 0; i < num_threads; i++) {
+    queues_.push_back(std::make_unique<WorkQueue>());
+  }
+  workers_.reserve(num_threads);
+  for (int i = 0; i < num_threads; i++) {
+    workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_up_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::global()
+{
+  std::lock_guard<std::mutex> lock(global_mutex);
+  if (global_pool == nullptr) {
+    global_pool = std::make_shared<ThreadPool>();
+  }
+  return global_pool;
+}
+
+void ThreadPool::setGlobalThreadCount(const int num_threads)
+{
+  std::shared_ptr<ThreadPool> previous;
+  std::lock_guard<std::mutex> lock(global_mutex);
+  if (global_pool != nullptr && global_pool->getThreadCount() == num_threads) {
+    return;
+  }
+  previous = std::move(global_pool);
+  global_pool = std::make_shared<ThreadPool>(num_threads);
+}
+
+void ThreadPool::submit(const BatchPtr& batch, const int num_jobs)
+{
+  for (int i = 0; i < num_jobs; i++) {
+    const unsigned int queue_id
+        = (current_pool == this) ? current_worker
+                                 : next_queue_++ % queues_.size();
+    std::lock_guard<std::mutex> lock(queues_[queue_id]->mutex);
+    queues_[queue_id]->jobs.push_back(batch);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_jobs_ += num_jobs;
+  }
+  if (num_jobs == 1) {
+    wake_up_.notify_one();
+  } else {
+    wake_up_.notify_all();
+  }
+}
+
+void ThreadPool::parallelFor(const int num_tasks,
+                             const std::function<void(int)>& task,
+                             const ToolId tool,
+                             const int max_threads)
+{
+  if (num_tasks <= 0) {
+    return;
+  }
+  int num_jobs = std::min(num_tasks - 1, static_cast<int>(workers_.size()));
+  if (max_threads > 0) {
+    num_jobs = std::min(num_jobs, max_threads - 1);
+  }
+
+  auto batch = std::make_shared<Batch>();
+  batch->task = &task;
+  batch->num_tasks = num_tasks;
+  batch->tool = tool;
+  batch->counter = std::make_shared<Counter>();
+  batch->counter->pending = num_tasks;
+  if (num_jobs > 0) {
+    submit(batch, num_jobs);
+  }
+
+  // The calling thread takes one share of the work.
+  runTasks(*batch);
+  wait(*batch->counter);
+  // The remaining handles in the queues are no-ops since next_task is past
+  // num_tasks.  They don't touch task, which goes out of scope here.
+  if (batch->counter->exception != nullptr) {
+    std::rethrow_exception(batch->counter->exception);
+  }
+}
+
+void ThreadPool::parallelForChunks(const int num_items,
+                                   const int min_num_items,
+                                   const std::function<void(int, int)>& task,
+                                   const ToolId tool)
+{
+  if (workers_.empty() || num_items < min_num_items) {
+    task(0, num_items);
+    return;
+  }
+  // a few chunks per thread to balance the workload
+  const int num_tasks = getThreadCount() * 4;
+  const int chunk_size = (num_items + num_tasks - 1) / num_tasks;
+  parallelFor(
+      num_tasks,
+      [&](const int task_id) {
+        const int begin = task_id * chunk_size;
+        const int end = std::min(begin + chunk_size, num_items);
+        if (begin < end) {
+          task(begin, end);
+        }
+      },
+      tool);
+}
+
+void ThreadPool::workerLoop(const int worker_id)
+{
+  current_pool = this;
+  current_worker = worker_id;
+  while (true) {
+    BatchPtr job = nullptr;
+    if (popJob(worker_id, job)) {
+      runTasks(*job);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    wake_up_.wait(lock,
+                  [this]() { return stop_ || pending_jobs_.load() > 0; });
+    if (stop_) {
+      return;
+    }
+  }
+}
+
+bool ThreadPool::popJob(const int worker_id, BatchPtr& job)
+{
+  const int num_queues = static_cast<int>(queues_.size());
+  // pop from the front of its own queue first,
+  // then steal from the back of other queues
+  for (int i = 0; i < num_queues; i++) {
+    auto& queue = queues_[(worker_id + i) % num_queues];
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (queue->jobs.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      job = std::move(queue->jobs.front());
+      queue->jobs.pop_front();
+    } else {
+      job = std::move(queue->jobs.back());
+      queue->jobs.pop_back();
+    }
+    pending_jobs_--;
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::runTasks(Batch& batch)
+{
+  Counter& counter = *batch.counter;
+  while (true) {
+    const int task_id = batch.next_task.fetch_add(1);
+    if (task_id >= batch.num_tasks) {
+      return;
+    }
+    const auto start = nowNs();
+    try {
+      (*batch.task)(task_id);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(counter.mutex);
+      if (counter.exception == nullptr) {
+        counter.exception = std::current_exception();
+      }
+    }
+    tasks_[batch.tool]++;
+    busy_ns_[batch.tool] += nowNs() - start;
+    if (counter.pending.fetch_sub(1) == 1) {
+      std::lock_guard<std::mutex> lock(counter.mutex);
+      counter.done.notify_all();
+    }
+  }
+}
+
+void ThreadPool::wait(Counter& counter)
+{
+  const int worker_id = (current_pool == this) ? current_worker : 0;
+  while (counter.pending.load() > 0) {
+    BatchPtr job = nullptr;
+    if (!queues_.empty() && popJob(worker_id, job)) {
+      runTasks(*job);
+      continue;
+    }
+    // Nothing left to help with: the remaining tasks are running.  Poll
+    // as a task finishing elsewhere may queue more work for this group.
+    std::unique_lock<std::mutex> lock(counter.mutex);
+    counter.done.wait_for(lock, std::chrono::milliseconds(1), [&counter]() {
+      return counter.pending.load() == 0;
+    });
+  }
+}
+
+ThreadPool::ToolStats ThreadPool::getStats(const ToolId tool) const
+{
+  ToolStats stats;
+  stats.tasks = tasks_[tool].load();
+  stats.busy_seconds = busy_ns_[tool].load() * 1e-9;
+  return stats;
+}
+
+double ThreadPool::getUtilization() const
+{
+  int64_t busy_ns = 0;
+  for (auto& busy : busy_ns_) {
+    busy_ns += busy.load();
+  }
+  const double available
+      = static_cast<double>(nowNs() - stats_start_.load()) * getThreadCount();
+  return available > 0 ? std::min(1.0, busy_ns / available) : 0.0;
+}
+
+void ThreadPool::resetStats()
+{
+  for (auto& tasks : tasks_) {
+    tasks = 0;
+  }
+  for (auto& busy : busy_ns_) {
+    busy = 0;
+  }
+  stats_start_ = nowNs();
+}
+
+TaskGroup::TaskGroup(const ToolId tool, std::shared_ptr<ThreadPool> pool)
+    : pool_(std::move(pool)),
+      tool_(tool),
+      counter_(std::make_shared<ThreadPool::Counter>())
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+  pool_->wait(*counter_);
+}
+
+void TaskGroup::run(std::function<void()> task)
+{
+  auto batch = std::make_shared<ThreadPool::Batch>();
+  batch->owned_task = [task = std::move(task)](int) { task(); };
+  batch->task = &batch->owned_task;
+  batch->num_tasks = 1;
+  batch->tool = tool_;
+  batch->counter = counter_;
+  counter_->pending++;
+  if (pool_->workers_.empty()) {
+    pool_->runTasks(*batch);
+  } else {
+    pool_->submit(batch, 1);
+  }
+}
+
+void TaskGroup::wait()
+{
+  pool_->wait(*counter_);
+  std::exception_ptr exception;
+  {
+    std::lock_guard<std::mutex> lock(counter_->mutex);
+    std::swap(exception, counter_->exception);
+  }
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
+}
+
+}  // namespace utl
@@ -0,0 +1,203 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "utl/trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace utl {
+
+namespace {
+
+// Spans kept per thread; older spans are overwritten once it is full.
+constexpr size_t buffer_capacity = 1 << 14;
+
+struct TraceEvent
+{
+  const char* category;
+  const char* name;
+  int64_t start;
+  int64_t end;
+};
+
+// The buffer is only written by its thread.  The mutex is uncontended except
+// while the trace is being cleared or written.
+struct ThreadBuffer
+{
+  explicit ThreadBuffer(int tid) : tid(tid) {}
+
+  std::mutex mutex;
+  const int tid;
+  std::vector<TraceEvent> events;
+  size_t recorded = 0;
+};
+
+struct Registry
+{
+  std::mutex mutex;
+  // Buffers outlive their threads so spans of finished threads are kept.
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  std::unordered_set<std::string> names;
+  const std::chrono::steady_clock::time_point epoch
+      = std::chrono::steady_clock::now();
+};
+
+Registry& registry()
+{
+  static Registry registry;
+  return registry;
+}
+
+ThreadBuffer& threadBuffer()
+{
+  thread_local std::shared_ptr<ThreadBuffer> buffer;
+  if (!buffer) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    buffer = std::make_shared<ThreadBuffer>(reg.buffers.size() + 1);
+    reg.buffers.push_back(buffer);
+  }
+  return *buffer;
+}
+
+void writeJsonString(std::ostream& out, const char* str)
+{
+  out << '"';
+  for (const char* c = str; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') {
+      out << '\\' << *c;
+    } else if (static_cast<unsigned char>(*c) < 0x20) {
+      out << ' ';
+    } else {
+      out << *c;
+    }
+  }
+  out << '"';
+}
+
+}  // namespace
+
+std::atomic_bool Tracer::enabled_ = false;
+
+void Tracer::setEnabled(bool enabled)
+{
+  // Starts the clock before the first span.
+  registry();
+  enabled_ = enabled;
+}
+
+int64_t Tracer::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - registry().epoch)
+      .count();
+}
+
+const char* Tracer::intern(std::string_view name)
+{
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  return reg.names.emplace(name).first->c_str();
+}
+
+void Tracer::record(const char* category,
+                    const char* name,
+                    int64_t start,
+                    int64_t end)
+{
+  ThreadBuffer& buffer = threadBuffer();
+  std::lock_guard<std::mutex> lock(buffer.mutex);
+  if (buffer.events.empty()) {
+    buffer.events.resize(buffer_capacity);
+  }
+  buffer.events[buffer.recorded++ % buffer_capacity]
+      = {category, name, start, end};
+}
+
+void Tracer::clear()
+{
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  std::vector<std::shared_ptr<ThreadBuffer>> live;
+  for (auto& buffer : reg.buffers) {
+    // Only the registry holds the buffers of finished threads.
+    if (buffer.use_count() > 1) {
+      std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+      buffer->recorded = 0;
+      live.push_back(buffer);
+    }
+  }
+  reg.buffers.swap(live);
+}
+
+bool Tracer::writeChromeTrace(const std::string& filename)
+{
+  std::ofstream out(filename);
+  if (!out) {
+    return false;
+  }
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  out << std::fixed << std::setprecision(3);
+  out << "{\"traceEvents\":[";
+  bool first = true;
+  for (auto& buffer : reg.buffers) {
+    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+    const size_t count = std::min(buffer->recorded, buffer_capacity);
+    for (size_t i = buffer->recorded - count; i < buffer->recorded; ++i) {
+      const TraceEvent& event = buffer->events[i % buffer_capacity];
+      out << (first ? "\n" : ",\n") << "{\"name\":";
+      writeJsonString(out, event.name);
+      out << ",\"cat\":";
+      writeJsonString(out, event.category);
+      // Chrome trace times are in microseconds.
+      out << ",\"ph\":\"X\",\"ts\":" << event.start / 1e3
+          << ",\"dur\":" << (event.end - event.start) / 1e3
+          << ",\"pid\":1,\"tid\":" << buffer->tid << "}";
+      first = false;
+    }
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return static_cast<bool>(out);
+}
+
+}  // namespace utl
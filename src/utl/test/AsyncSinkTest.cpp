@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_MODULE AsyncSinkTest
+
+#ifdef HAS_BOOST_UNIT_TEST_LIBRARY
+// Shared library version
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#else
+// Header only version
+#include <boost/test/included/unit_test.hpp>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AsyncSink.h"
+#include "spdlog/sinks/base_sink.h"
+
+namespace utl {
+
+// Records the payloads it receives.  While it is closed, the writer thread
+// of the AsyncSink waits in sink_it_, so the queue fills up.
+class RecordingSink : public spdlog::sinks::base_sink<std::mutex>
+{
+ public:
+  std::vector<std::string> messages;
+
+  void open()
+  {
+    std::lock_guard<std::mutex> lock(gate_mutex_);
+    open_ = true;
+    gate_.notify_all();
+  }
+
+  void close()
+  {
+    std::lock_guard<std::mutex> lock(gate_mutex_);
+    open_ = false;
+  }
+
+ protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override
+  {
+    std::unique_lock<std::mutex> lock(gate_mutex_);
+    gate_.wait(lock, [this] { return open_; });
+    messages.emplace_back(msg.payload.data(), msg.payload.size());
+  }
+
+  void flush_() override {}
+
+ private:
+  std::mutex gate_mutex_;
+  std::condition_variable gate_;
+  bool open_ = true;
+};
+
+static void logMessage(AsyncSink& sink, const std::string& payload)
+{
+  const spdlog::details::log_msg msg(
+      "test", spdlog::level::info, spdlog::string_view_t(payload));
+  sink.log(msg);
+}
+
+BOOST_AUTO_TEST_CASE(messages_keep_their_order)
+{
+  auto recorder = std::make_shared<RecordingSink>();
+  AsyncSink sink({recorder}, 8);
+  for (int i = 0; i < 1000; i++) {
+    logMessage(sink, std::to_string(i));
+  }
+  sink.flush();
+  BOOST_TEST(recorder->messages.size() == 1000);
+  for (int i = 0; i < static_cast<int>(recorder->messages.size()); i++) {
+    BOOST_TEST(recorder->messages[i] == std::to_string(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(messages_of_each_thread_keep_their_order)
+{
+  constexpr int kThreads = 4;
+  constexpr int kMessages = 1000;
+  auto recorder = std::make_shared<RecordingSink>();
+  AsyncSink sink({recorder}, 16);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&sink, t] {
+      for (int i = 0; i < kMessages; i++) {
+        logMessage(sink, std::to_string(t) + " " + std::to_string(i));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  sink.flush();
+
+  BOOST_TEST(recorder->messages.size() == kThreads * kMessages);
+  std::vector<int> next(kThreads, 0);
+  for (const std::string& message : recorder->messages) {
+    const size_t space = message.find(' ');
+    const int t = std::stoi(message.substr(0, space));
+    const int i = std::stoi(message.substr(space + 1));
+    BOOST_TEST(i == next[t]);
+    next[t] = i + 1;
+  }
+}
+
+// Destroying the sink without a flush still writes every message
+BOOST_AUTO_TEST_CASE(shutdown_writes_pending_messages)
+{
+  auto recorder = std::make_shared<RecordingSink>();
+  std::thread opener;
+  {
+    AsyncSink sink({recorder}, 1024);
+    recorder->close();
+    for (int i = 0; i < 100; i++) {
+      logMessage(sink, std::to_string(i));
+    }
+    opener = std::thread([recorder] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      recorder->open();
+    });
+  }
+  opener.join();
+  BOOST_TEST(recorder->messages.size() == 100);
+  for (int i = 0; i < static_cast<int>(recorder->messages.size()); i++) {
+    BOOST_TEST(recorder->messages[i] == std::to_string(i));
+  }
+}
+
+// With the writer stuck, a full queue blocks the caller instead of
+// dropping messages
+BOOST_AUTO_TEST_CASE(full_queue_blocks_the_caller)
+{
+  constexpr int kCapacity = 4;
+  constexpr int kMessages = 20;
+  auto recorder = std::make_shared<RecordingSink>();
+  AsyncSink sink({recorder}, kCapacity);
+  recorder->close();
+
+  std::atomic<int> logged{0};
+  std::thread producer([&] {
+    for (int i = 0; i < kMessages; i++) {
+      logMessage(sink, std::to_string(i));
+      logged++;
+    }
+  });
+
+  // The writer holds one message in the closed sink and the queue holds
+  // kCapacity more
+  const auto deadline
+      = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (logged < kCapacity + 1
+         && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  BOOST_TEST(logged == kCapacity + 1);
+
+  recorder->open();
+  producer.join();
+  sink.flush();
+  BOOST_TEST(logged == kMessages);
+  BOOST_TEST(recorder->messages.size() == kMessages);
+  for (int i = 0; i < static_cast<int>(recorder->messages.size()); i++) {
+    BOOST_TEST(recorder->messages[i] == std::to_string(i));
+  }
+}
+
+}  // namespace utl
@@ -0,0 +1,138 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_MODULE ThreadPoolTest
+
+#ifdef HAS_BOOST_UNIT_TEST_LIBRARY
+// Shared library version
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#else
+// Header only version
+#include <boost/test/included/unit_test.hpp>
+#endif
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "utl/ThreadPool.h"
+
+namespace utl {
+
+BOOST_AUTO_TEST_CASE(parallel_for_runs_every_task)
+{
+  ThreadPool pool(4);
+  BOOST_TEST(pool.getThreadCount() == 4);
+  std::vector<int> hits(1000, 0);
+  pool.parallelFor(
+      hits.size(), [&](int i) { hits[i]++; }, PAR);
+  for (int hit : hits) {
+    BOOST_TEST(hit == 1);
+  }
+  BOOST_TEST(pool.getStats(PAR).tasks == 1000);
+  BOOST_TEST(pool.getStats(DRT).tasks == 0);
+}
+
+BOOST_AUTO_TEST_CASE(chunks_cover_the_range)
+{
+  ThreadPool pool(3);
+  std::atomic<int> sum{0};
+  pool.parallelForChunks(1001, 10, [&](int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      sum += i;
+    }
+  });
+  BOOST_TEST(sum == 1000 * 1001 / 2);
+}
+
+BOOST_AUTO_TEST_CASE(nested_parallelism)
+{
+  // More outer tasks than threads, each waiting on inner tasks, must not
+  // deadlock.
+  ThreadPool pool(2);
+  std::atomic<int> count{0};
+  pool.parallelFor(8, [&](int) {
+    pool.parallelFor(8, [&](int) { count++; });
+  });
+  BOOST_TEST(count == 64);
+}
+
+BOOST_AUTO_TEST_CASE(task_group)
+{
+  auto pool = std::make_shared<ThreadPool>(4);
+  std::atomic<int> count{0};
+  {
+    TaskGroup group(MPL, pool);
+    for (int i = 0; i < 16; i++) {
+      group.run([&] {
+        TaskGroup inner(MPL, pool);
+        inner.run([&] { count++; });
+        inner.run([&] { count++; });
+      });
+    }
+    group.wait();
+    BOOST_TEST(count == 32);
+  }
+  BOOST_TEST(pool->getStats(MPL).tasks == 48);
+}
+
+BOOST_AUTO_TEST_CASE(exceptions_reach_the_caller)
+{
+  ThreadPool pool(4);
+  BOOST_CHECK_THROW(pool.parallelFor(10,
+                                     [](int i) {
+                                       if (i == 7) {
+                                         throw std::runtime_error("task");
+                                       }
+                                     }),
+                    std::runtime_error);
+
+  TaskGroup group(UKN, std::make_shared<ThreadPool>(2));
+  group.run([] { throw std::runtime_error("group"); });
+  BOOST_CHECK_THROW(group.wait(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(global_pool)
+{
+  ThreadPool::setGlobalThreadCount(3);
+  auto pool = ThreadPool::global();
+  BOOST_TEST(pool->getThreadCount() == 3);
+  ThreadPool::setGlobalThreadCount(2);
+  BOOST_TEST(ThreadPool::global()->getThreadCount() == 2);
+  // The previous pool stays usable by its holders.
+  std::atomic<int> count{0};
+  pool->parallelFor(4, [&](int) { count++; });
+  BOOST_TEST(count == 4);
+}
+
+}  // namespace utl
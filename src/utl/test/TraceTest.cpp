@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_MODULE TraceTest
+
+#ifdef HAS_BOOST_UNIT_TEST_LIBRARY
+// Shared library version
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#else
+// Header only version
+#include <boost/test/included/unit_test.hpp>
+#endif
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "utl/trace.h"
+
+namespace utl {
+
+namespace {
+
+std::string writeTrace()
+{
+  const std::string path
+      = (std::filesystem::temp_directory_path() / "TraceTest.json").string();
+  BOOST_TEST(Tracer::writeChromeTrace(path));
+  std::ifstream in(path);
+  std::stringstream contents;
+  contents << in.rdbuf();
+  std::filesystem::remove(path);
+  return contents.str();
+}
+
+int countOf(const std::string& haystack, const std::string& needle)
+{
+  int count = 0;
+  for (auto pos = haystack.find(needle); pos != std::string::npos;
+       pos = haystack.find(needle, pos + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(disabled_records_nothing)
+{
+  Tracer::setEnabled(false);
+  Tracer::clear();
+  {
+    TraceSpan span("test", "ignored");
+  }
+  BOOST_TEST(countOf(writeTrace(), "\"ignored\"") == 0);
+}
+
+BOOST_AUTO_TEST_CASE(spans_from_threads)
+{
+  Tracer::setEnabled(true);
+  Tracer::clear();
+  {
+    TraceSpan outer("test", "outer");
+    std::thread worker([] {
+      TraceSpan inner("test", std::string("inner_") + "thread");
+    });
+    worker.join();
+    TraceSpan ended("test", "ended");
+    ended.end();
+  }
+  Tracer::setEnabled(false);
+
+  const std::string trace = writeTrace();
+  BOOST_TEST(countOf(trace, "\"outer\"") == 1);
+  BOOST_TEST(countOf(trace, "\"inner_thread\"") == 1);
+  BOOST_TEST(countOf(trace, "\"ended\"") == 1);
+  BOOST_TEST(countOf(trace, "\"ph\":\"X\"") == 3);
+  BOOST_TEST(countOf(trace, "\"tid\":") == 3);
+
+  Tracer::clear();
+  BOOST_TEST(countOf(writeTrace(), "\"ph\":\"X\"") == 0);
+}
+
+}  // namespace utl
+
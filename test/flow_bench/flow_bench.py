@@ -0,0 +1,475 @@
+#!/usr/bin/env python3
+############################################################################
+##
+## Copyright (c) 2023, The Regents of the University of California
+## All rights reserved.
+##
+## BSD 3-Clause License
+##
+## Redistribution and use in source and binary forms, with or without
+## modification, are permitted provided that the following conditions are met:
+##
+## * Redistributions of source code must retain the above copyright notice, this
+##   list of conditions and the following disclaimer.
+##
+## * Redistributions in binary form must reproduce the above copyright notice,
+##   this list of conditions and the following disclaimer in the documentation
+##   and/or other materials provided with the distribution.
+##
+## * Neither the name of the copyright holder nor the names of its
+##   contributors may be used to endorse or promote products derived from
+##   this software without specific prior written permission.
+##
+## THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+## AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+## IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+## ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+## LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+## CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+## SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+## INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+## CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+## ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+## POSSIBILITY OF SUCH DAMAGE.
+##
+############################################################################
+
+"""Flow benchmark of OpenROAD.
+
+Runs the main stages of the flow on a set of designs and records the wall
+time, peak memory and thread scaling of every stage, such that the results of
+two commits can be compared.
+
+Each stage runs in its own openroad process (see flow_bench.tcl), reading the
+database written by the previous stage.  The runtime of a stage is measured
+inside openroad around the stage command, so reading and writing the
+database is not included.  The peak RSS of the process and the utl memory
+counters (odb tables, grt grids, par hypergraphs, drt design) are logged
+through the utl metrics of each stage.
+
+Designs are synthetic Nangate45 netlists generated with a fixed seed (given
+by instance count with -sizes) or existing netlists given with -design.
+Every stage is repeated for each thread count of -threads; the database
+written with the first thread count feeds the next stage.
+
+The results are written as JSON, one record per design, stage and thread
+count.  With -baseline, the results are compared with an earlier run and
+the stages that got slower or bigger by more than -tolerance are reported;
+the exit code is then 1 if there is any regression.
+
+Usage:
+  flow_bench.py -openroad path/to/openroad
+                [-platform dir] [-work_dir dir] [-o results.json]
+                [-sizes 10k,100k] [-design name,netlist.v,top[,sdc]]...
+                [-stages stage,...] [-threads 1,8] [-seed s]
+                [-drt_iters n] [-trace]
+                [-baseline results.json] [-tolerance percent]
+"""
+
+import argparse
+import json
+import os
+import random
+import subprocess
+import sys
+
+STAGES = [
+    "triton_part_design",
+    "global_placement",
+    "detailed_placement",
+    "global_route",
+    "detailed_route",
+    "analyze_power_grid",
+]
+
+# Stages that produce the database of the next stage.  triton_part_design
+# and analyze_power_grid only read their input.
+CHAINED_STAGES = {
+    "floorplan",
+    "global_placement",
+    "detailed_placement",
+    "global_route",
+    "detailed_route",
+}
+
+# The input of each stage.
+STAGE_INPUT = {
+    "triton_part_design": "floorplan",
+    "global_placement": "floorplan",
+    "detailed_placement": "global_placement",
+    "global_route": "detailed_placement",
+    "detailed_route": "global_route",
+    "analyze_power_grid": "detailed_route",
+}
+
+# Metrics compared against the baseline.
+COMPARED_METRICS = ["runtime__wall_s", "memory__peak_rss_mb"]
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+
+
+def parse_size(text):
+    text = text.strip().lower()
+    scale = 1
+    if text.endswith("k"):
+        scale = 1000
+        text = text[:-1]
+    elif text.endswith("m"):
+        scale = 1000000
+        text = text[:-1]
+    return int(float(text) * scale)
+
+
+def size_name(size):
+    if size % 1000000 == 0:
+        return "%dm" % (size // 1000000)
+    if size % 1000 == 0:
+        return "%dk" % (size // 1000)
+    return str(size)
+
+
+# Nangate45 cells of the synthetic netlists: (name, inputs, output).
+GATES = [
+    ("INV_X1", ["A"], "ZN"),
+    ("BUF_X1", ["A"], "Z"),
+    ("NAND2_X1", ["A1", "A2"], "ZN"),
+    ("NOR2_X1", ["A1", "A2"], "ZN"),
+    ("AOI21_X1", ["A", "B1", "B2"], "ZN"),
+    ("OAI21_X1", ["A", "B1", "B2"], "ZN"),
+]
+FLOP_FRACTION = 0.1
+# Most gate inputs come from the recent gates, which gives the netlist the
+# locality of a real design; the rest are global nets.
+LOCAL_WINDOW = 64
+GLOBAL_FRACTION = 0.02
+
+
+def write_synthetic_design(size, seed, verilog_file, sdc_file):
+    """Writes a Nangate45 netlist with size instances.
+
+    Gates only read nets driven by earlier instances or by flops, so there
+    are no combinational loops.  The output is a function of size and seed
+    only.
+    """
+    rng = random.Random(seed * 1000003 + size)
+    num_inputs = max(8, int(size**0.5) // 4)
+    num_outputs = num_inputs
+    top = "flow_bench_%s" % size_name(size)
+
+    with open(verilog_file, "w") as out:
+        out.write("module %s (clk" % top)
+        for i in range(num_inputs):
+            out.write(", in%d" % i)
+        for i in range(num_outputs):
+            out.write(", out%d" % i)
+        out.write(");\n")
+        out.write(" input clk;\n")
+        for i in range(num_inputs):
+            out.write(" input in%d;\n" % i)
+        for i in range(num_outputs):
+            out.write(" output out%d;\n" % i)
+
+        # Net n<i> is driven by instance u<i>.
+        for i in range(size):
+            out.write(" wire n%d;\n" % i)
+
+        flops = []
+
+        def pick_input(i):
+            if i == 0 or rng.random() < GLOBAL_FRACTION:
+                if flops and rng.random() < 0.5:
+                    return "n%d" % rng.choice(flops)
+                return "in%d" % rng.randrange(num_inputs)
+            return "n%d" % rng.randrange(max(0, i - LOCAL_WINDOW), i)
+
+        for i in range(size):
+            if rng.random() < FLOP_FRACTION:
+                data = pick_input(i)
+                out.write(
+                    " DFF_X1 u%d (.D(%s), .CK(clk), .Q(n%d));\n" % (i, data, i)
+                )
+                flops.append(i)
+                continue
+            name, inputs, output = GATES[rng.randrange(len(GATES))]
+            pins = ", ".join(".%s(%s)" % (pin, pick_input(i)) for pin in inputs)
+            out.write(" %s u%d (%s, .%s(n%d));\n" % (name, i, pins, output, i))
+
+        for i in range(num_outputs):
+            out.write(" assign out%d = n%d;\n" % (i, size - 1 - i))
+        out.write("endmodule\n")
+
+    with open(sdc_file, "w") as out:
+        out.write("create_clock -name clk -period 2.0 [get_ports clk]\n")
+        out.write("set_input_delay 0.2 -clock clk [all_inputs]\n")
+        out.write("set_output_delay 0.2 -clock clk [all_outputs]\n")
+
+    return top
+
+
+class Design:
+    def __init__(self, name, verilog, top, sdc, size):
+        self.name = name
+        self.verilog = verilog
+        self.top = top
+        self.sdc = sdc
+        self.size = size
+
+
+def make_designs(args):
+    designs = []
+    if args.sizes:
+        for text in args.sizes.split(","):
+            size = parse_size(text)
+            name = "synthetic_%s" % size_name(size)
+            design_dir = os.path.join(args.work_dir, name)
+            os.makedirs(design_dir, exist_ok=True)
+            verilog = os.path.join(design_dir, "%s_%d.v" % (name, args.seed))
+            sdc = os.path.join(design_dir, "%s.sdc" % name)
+            top = "flow_bench_%s" % size_name(size)
+            if not os.path.exists(verilog):
+                print("Generating %s" % verilog, flush=True)
+                tmp = verilog + ".tmp"
+                write_synthetic_design(size, args.seed, tmp, sdc)
+                os.replace(tmp, verilog)
+            designs.append(Design(name, verilog, top, sdc, size))
+    for text in args.design:
+        fields = text.split(",")
+        if len(fields) not in (3, 4):
+            sys.exit("-design expects name,netlist.v,top[,sdc]: %s" % text)
+        name, verilog, top = fields[:3]
+        design_dir = os.path.join(args.work_dir, name)
+        os.makedirs(design_dir, exist_ok=True)
+        if len(fields) == 4:
+            sdc = os.path.abspath(fields[3])
+        else:
+            sdc = os.path.join(design_dir, "%s.sdc" % name)
+            with open(sdc, "w") as out:
+                out.write("\n")
+        designs.append(Design(name, os.path.abspath(verilog), top, sdc, None))
+    return designs
+
+
+def run_stage(args, design, stage, threads, input_db, output_db):
+    """Runs one stage in its own openroad process and returns its record."""
+    design_dir = os.path.join(args.work_dir, design.name)
+    run_name = "%s_t%d" % (stage, threads)
+    metrics_file = os.path.join(design_dir, run_name + ".json")
+    log_file = os.path.join(design_dir, run_name + ".log")
+
+    env = dict(os.environ)
+    env.update(
+        {
+            "FLOW_BENCH_STAGE": stage,
+            "FLOW_BENCH_PLATFORM": args.platform,
+            "FLOW_BENCH_VERILOG": design.verilog,
+            "FLOW_BENCH_TOP": design.top,
+            "FLOW_BENCH_SDC": design.sdc,
+            "FLOW_BENCH_INPUT": input_db or "",
+            "FLOW_BENCH_OUTPUT": output_db or "",
+            "FLOW_BENCH_METRICS": metrics_file,
+            "FLOW_BENCH_THREADS": str(threads),
+            "FLOW_BENCH_WORK_DIR": design_dir,
+            "FLOW_BENCH_DRT_ITERS": str(args.drt_iters),
+            "FLOW_BENCH_TRACE": (
+                os.path.join(design_dir, run_name + ".trace.json")
+                if args.trace
+                else ""
+            ),
+        }
+    )
+    command = [
+        args.openroad,
+        "-no_init",
+        "-no_splash",
+        "-exit",
+        os.path.join(SCRIPT_DIR, "flow_bench.tcl"),
+    ]
+    print("%s %s threads=%d" % (design.name, stage, threads), flush=True)
+    with open(log_file, "w") as log:
+        process = subprocess.Popen(
+            command, stdout=log, stderr=subprocess.STDOUT, env=env
+        )
+        # wait4 gives the resource usage of this process alone.
+        _, status, usage = os.wait4(process.pid, 0)
+        process.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else 1
+
+    record = {
+        "design": design.name,
+        "instances": design.size,
+        "stage": stage,
+        "threads": threads,
+        "status": "pass" if process.returncode == 0 else "fail",
+        "process__cpu_s": usage.ru_utime + usage.ru_stime,
+        "process__max_rss_mb": usage.ru_maxrss / 1024.0,
+        "log": log_file,
+    }
+    if process.returncode != 0:
+        print("  failed, see %s" % log_file, flush=True)
+        return record
+
+    with open(metrics_file) as metrics:
+        prefix = "flow__%s__" % stage
+        for key, value in json.load(metrics).items():
+            if key.startswith(prefix):
+                record[key[len(prefix) :]] = value
+    print(
+        "  %.2f s, peak %.1f MB"
+        % (record.get("runtime__wall_s", 0), record.get("memory__peak_rss_mb", 0)),
+        flush=True,
+    )
+    return record
+
+
+def run_design(args, design, stages, thread_counts):
+    design_dir = os.path.join(args.work_dir, design.name)
+
+    def db_path(stage):
+        return os.path.join(design_dir, stage + ".odb")
+
+    records = []
+    # A stage whose input is missing (failed or not run) is skipped, and so
+    # are the stages that depend on it.
+    needed = set(STAGE_INPUT[stage] for stage in stages)
+    for stage in ["floorplan"] + STAGES:
+        if stage != "floorplan" and stage not in stages and stage not in needed:
+            continue
+        input_db = None if stage == "floorplan" else db_path(STAGE_INPUT[stage])
+        if input_db is not None and not os.path.exists(input_db):
+            print("%s %s skipped, no %s" % (design.name, stage, input_db))
+            continue
+        measured = stage in stages
+        counts = thread_counts if measured else thread_counts[:1]
+        for i, threads in enumerate(counts):
+            output_db = None
+            if i == 0 and stage in CHAINED_STAGES:
+                output_db = db_path(stage)
+                if os.path.exists(output_db):
+                    os.remove(output_db)
+            record = run_stage(args, design, stage, threads, input_db, output_db)
+            if measured:
+                records.append(record)
+    return records
+
+
+def add_scaling(records):
+    """Adds the speedup over the first thread count of each stage."""
+    base = {}
+    for record in records:
+        key = (record["design"], record["stage"])
+        runtime = record.get("runtime__wall_s")
+        if runtime is None:
+            continue
+        if key not in base:
+            base[key] = runtime
+        if runtime > 0:
+            record["speedup"] = base[key] / runtime
+
+
+def compare(records, baseline_file, tolerance):
+    with open(baseline_file) as baseline_json:
+        baseline = {
+            (r["design"], r["stage"], r["threads"]): r
+            for r in json.load(baseline_json)["results"]
+        }
+    regressions = 0
+    for record in records:
+        key = (record["design"], record["stage"], record["threads"])
+        old = baseline.get(key)
+        if old is None:
+            continue
+        for metric in COMPARED_METRICS:
+            if metric not in record or metric not in old or old[metric] <= 0:
+                continue
+            change = 100.0 * (record[metric] - old[metric]) / old[metric]
+            record[metric + "__change_pct"] = change
+            if change > tolerance:
+                regressions += 1
+                print(
+                    "Regression: %s %s threads=%d %s %.3f -> %.3f (%+.1f%%)"
+                    % (
+                        record["design"],
+                        record["stage"],
+                        record["threads"],
+                        metric,
+                        old[metric],
+                        record[metric],
+                        change,
+                    )
+                )
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Per stage runtime and memory benchmark of the flow"
+    )
+    parser.add_argument("-openroad", required=True, help="openroad executable")
+    parser.add_argument(
+        "-platform",
+        default=os.path.join(SCRIPT_DIR, "..", "Nangate45"),
+        help="directory with Nangate45.lef and Nangate45_typ.lib",
+    )
+    parser.add_argument("-work_dir", default="flow_bench_work")
+    parser.add_argument("-o", dest="output", default="flow_bench.json")
+    parser.add_argument(
+        "-sizes",
+        default="10k,100k",
+        help="instance counts of the synthetic designs, e.g. 10k,1m,10m",
+    )
+    parser.add_argument(
+        "-design",
+        action="append",
+        default=[],
+        help="name,netlist.v,top[,sdc] of an existing Nangate45 design",
+    )
+    parser.add_argument("-stages", default=",".join(STAGES))
+    parser.add_argument("-threads", default="1,%d" % (os.cpu_count() or 1))
+    parser.add_argument("-seed", type=int, default=0)
+    parser.add_argument("-drt_iters", type=int, default=1)
+    parser.add_argument(
+        "-trace", action="store_true", help="write a Chrome trace per stage"
+    )
+    parser.add_argument("-baseline", help="results of an earlier run")
+    parser.add_argument(
+        "-tolerance",
+        type=float,
+        default=10.0,
+        help="percent of change reported as a regression",
+    )
+    args = parser.parse_args()
+
+    args.openroad = os.path.abspath(args.openroad)
+    args.platform = os.path.abspath(args.platform)
+    args.work_dir = os.path.abspath(args.work_dir)
+    stages = [stage for stage in args.stages.split(",") if stage]
+    for stage in stages:
+        if stage not in STAGES:
+            sys.exit("Unknown stage %s, expected one of %s" % (stage, STAGES))
+    thread_counts = []
+    for text in args.threads.split(","):
+        if int(text) not in thread_counts:
+            thread_counts.append(int(text))
+
+    records = []
+    for design in make_designs(args):
+        records += run_design(args, design, stages, thread_counts)
+    add_scaling(records)
+
+    regressions = 0
+    if args.baseline:
+        regressions = compare(records, args.baseline, args.tolerance)
+
+    with open(args.output, "w") as out:
+        json.dump(
+            {"seed": args.seed, "drt_iters": args.drt_iters, "results": records},
+            out,
+            indent=2,
+        )
+    print("Wrote %s" % args.output)
+
+    failures = sum(1 for record in records if record["status"] != "pass")
+    return 1 if regressions or failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,166 @@
+############################################################################
+##
+## Copyright (c) 2023, The Regents of the University of California
+## All rights reserved.
+##
+## BSD 3-Clause License
+##
+## Redistribution and use in source and binary forms, with or without
+## modification, are permitted provided that the following conditions are met:
+##
+## * Redistributions of source code must retain the above copyright notice, this
+##   list of conditions and the following disclaimer.
+##
+## * Redistributions in binary form must reproduce the above copyright notice,
+##   this list of conditions and the following disclaimer in the documentation
+##   and/or other materials provided with the distribution.
+##
+## * Neither the name of the copyright holder nor the names of its
+##   contributors may be used to endorse or promote products derived from
+##   this software without specific prior written permission.
+##
+## THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+## AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+## IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+## ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+## LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+## CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+## SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+## INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+## CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+## ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+## POSSIBILITY OF SUCH DAMAGE.
+##
+############################################################################
+
+# Runs a single stage of the flow benchmark and logs its runtime and memory
+# as metrics.  flow_bench.py runs one openroad process per stage so the peak
+# memory of each stage is measured on its own.  The stage reads the database
+# written by the previous stage and writes its own for the next one.
+#
+# Inputs are passed through the environment:
+#   FLOW_BENCH_STAGE     floorplan, triton_part_design, global_placement,
+#                        detailed_placement, global_route, detailed_route or
+#                        analyze_power_grid
+#   FLOW_BENCH_PLATFORM  directory with Nangate45.lef and Nangate45_typ.lib
+#   FLOW_BENCH_VERILOG   netlist read by the floorplan stage
+#   FLOW_BENCH_TOP       top module of the netlist
+#   FLOW_BENCH_SDC       constraints read by every stage
+#   FLOW_BENCH_INPUT     database written by the previous stage
+#   FLOW_BENCH_OUTPUT    database to write (optional)
+#   FLOW_BENCH_METRICS   metrics file to write
+#   FLOW_BENCH_THREADS   thread count of the stage
+#   FLOW_BENCH_WORK_DIR  directory for the files a stage writes on the side
+#   FLOW_BENCH_DRT_ITERS detailed routing iterations (default 1)
+#   FLOW_BENCH_TRACE     Chrome trace file to write (optional)
+
+proc flow_bench_env { name { default "" } } {
+  if { [info exists ::env($name)] && $::env($name) != "" } {
+    return $::env($name)
+  }
+  if { $default == "" } {
+    utl::error ORD 60 "flow_bench: $name is not set."
+  }
+  return $default
+}
+
+proc flow_bench_floorplan { } {
+  initialize_floorplan -utilization 40 \
+    -aspect_ratio 1 \
+    -core_space 2 \
+    -sites FreePDK45_38x28_10R_NP_162NW_34O
+  make_tracks
+  place_pins -hor_layers metal3 -ver_layers metal2 -random
+  tapcell -distance 120 \
+    -tapcell_master TAPCELL_X1 \
+    -endcap_master TAPCELL_X1
+
+  add_global_connection -net VDD -pin_pattern {^VDD$} -power
+  add_global_connection -net VSS -pin_pattern {^VSS$} -ground
+  set_voltage_domain -power VDD -ground VSS
+  define_pdn_grid -name grid -pins metal7
+  add_pdn_stripe -layer metal1 -width 0.17 -followpins
+  add_pdn_stripe -layer metal4 -width 0.48 -pitch 56.0 -offset 2
+  add_pdn_stripe -layer metal7 -width 1.40 -pitch 40.0 -offset 2
+  add_pdn_connect -layers {metal1 metal4}
+  add_pdn_connect -layers {metal4 metal7}
+  pdngen
+}
+
+proc flow_bench_run_stage { stage work_dir } {
+  switch $stage {
+    floorplan {
+      flow_bench_floorplan
+    }
+    triton_part_design {
+      triton_part_design -num_parts 2 \
+        -solution_file [file join $work_dir "partition.sol"]
+    }
+    global_placement {
+      global_placement -skip_io
+    }
+    detailed_placement {
+      detailed_placement
+    }
+    global_route {
+      set_routing_layers -signal metal2-metal10
+      global_route -allow_congestion -parallel_maze_route
+    }
+    detailed_route {
+      detailed_route -droute_end_iter [flow_bench_env FLOW_BENCH_DRT_ITERS 1] \
+        -output_drc [file join $work_dir "detailed_route.rpt"]
+    }
+    analyze_power_grid {
+      analyze_power_grid -net VDD
+    }
+    default {
+      utl::error ORD 61 "flow_bench: unknown stage $stage."
+    }
+  }
+}
+
+set stage [flow_bench_env FLOW_BENCH_STAGE]
+set platform [flow_bench_env FLOW_BENCH_PLATFORM]
+set threads [flow_bench_env FLOW_BENCH_THREADS 1]
+set work_dir [flow_bench_env FLOW_BENCH_WORK_DIR]
+set metrics_file [flow_bench_env FLOW_BENCH_METRICS]
+set trace_file [flow_bench_env FLOW_BENCH_TRACE none]
+
+if { $stage == "floorplan" } {
+  read_lef [file join $platform "Nangate45.lef"]
+  read_liberty [file join $platform "Nangate45_typ.lib"]
+  read_verilog [flow_bench_env FLOW_BENCH_VERILOG]
+  link_design [flow_bench_env FLOW_BENCH_TOP]
+} else {
+  read_db [flow_bench_env FLOW_BENCH_INPUT]
+  read_liberty [file join $platform "Nangate45_typ.lib"]
+}
+read_sdc [flow_bench_env FLOW_BENCH_SDC]
+
+set_thread_count $threads
+if { $trace_file != "none" } {
+  utl::set_tracing 1
+}
+
+utl::open_metrics $metrics_file
+utl::push_metrics_stage "flow__${stage}__{}"
+
+set start [clock microseconds]
+flow_bench_run_stage $stage $work_dir
+set runtime [expr ([clock microseconds] - $start) / 1e6]
+
+utl::metric_float "runtime__wall_s" $runtime
+utl::metric_integer "threads" $threads
+utl::report_memory_metrics
+utl::report_scheduler_metrics
+utl::pop_metrics_stage
+utl::close_metrics $metrics_file
+
+if { $trace_file != "none" } {
+  utl::write_trace $trace_file
+}
+
+set output_db [flow_bench_env FLOW_BENCH_OUTPUT none]
+if { $output_db != "none" } {
+  write_db $output_db
+}